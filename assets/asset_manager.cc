@@ -59,6 +59,39 @@ std::deque<std::unique_ptr<AssetResolver>> AssetManager::TakeResolvers() {
   return std::move(resolvers_);
 }
 
+void AssetManager::StartRecordingAccesses() {
+  std::scoped_lock lock(recording_mutex_);
+  is_recording_ = true;
+}
+
+std::vector<std::string> AssetManager::StopRecordingAccesses() {
+  std::scoped_lock lock(recording_mutex_);
+  is_recording_ = false;
+  recorded_asset_name_set_.clear();
+  std::vector<std::string> asset_names;
+  asset_names.swap(recorded_asset_names_);
+  return asset_names;
+}
+
+void AssetManager::RecordAccess(const std::string& asset_name) const {
+  std::scoped_lock lock(recording_mutex_);
+  if (is_recording_ && recorded_asset_name_set_.insert(asset_name).second) {
+    recorded_asset_names_.push_back(asset_name);
+  }
+}
+
+size_t AssetManager::PrefetchAssets(
+    const std::vector<std::string>& asset_names) const {
+  TRACE_EVENT0("flutter", "AssetManager::PrefetchAssets");
+  size_t prefetched = 0;
+  for (const auto& asset_name : asset_names) {
+    if (Prefetch(asset_name)) {
+      prefetched++;
+    }
+  }
+  return prefetched;
+}
+
 // |AssetResolver|
 std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
     const std::string& asset_name) const {
@@ -70,6 +103,7 @@ std::unique_ptr<fml::Mapping> AssetManager::GetAsMapping(
   for (const auto& resolver : resolvers_) {
     auto mapping = resolver->GetAsMapping(asset_name);
     if (mapping != nullptr) {
+      RecordAccess(asset_name);
       return mapping;
     }
   }
@@ -96,6 +130,19 @@ std::vector<std::unique_ptr<fml::Mapping>> AssetManager::GetAsMappings(
   return mappings;
 }
 
+// |AssetResolver|
+bool AssetManager::Prefetch(const std::string& asset_name) const {
+  if (asset_name.empty()) {
+    return false;
+  }
+  for (const auto& resolver : resolvers_) {
+    if (resolver->Prefetch(asset_name)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // |AssetResolver|
 bool AssetManager::IsValid() const {
   return !resolvers_.empty();
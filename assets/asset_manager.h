@@ -7,9 +7,12 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
-#include <optional>
 #include "flutter/assets/asset_resolver.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
@@ -70,6 +73,32 @@ class AssetManager final : public AssetResolver {
 
   std::deque<std::unique_ptr<AssetResolver>> TakeResolvers();
 
+  //--------------------------------------------------------------------------
+  /// @brief      Starts recording the names of the assets loaded through
+  ///             `GetAsMapping`, so that they can be prefetched the next
+  ///             time the application launches.
+  ///
+  void StartRecordingAccesses();
+
+  //--------------------------------------------------------------------------
+  /// @brief      Stops recording the names of the assets loaded.
+  ///
+  /// @return     The names of the assets found since recording started, in
+  ///             the order they were first loaded.
+  ///
+  std::vector<std::string> StopRecordingAccesses();
+
+  //--------------------------------------------------------------------------
+  /// @brief      Prefetches assets from the first resolver that has each of
+  ///             them. This blocks on storage, so it must only be called on
+  ///             background threads.
+  ///
+  /// @param[in]  asset_names  The names of the assets to prefetch.
+  ///
+  /// @return     The number of assets prefetched.
+  ///
+  size_t PrefetchAssets(const std::vector<std::string>& asset_names) const;
+
   // |AssetResolver|
   bool IsValid() const override;
 
@@ -88,9 +117,20 @@ class AssetManager final : public AssetResolver {
       const std::string& asset_pattern,
       const std::optional<std::string>& subdir) const override;
 
+  // |AssetResolver|
+  bool Prefetch(const std::string& asset_name) const override;
+
  private:
   std::deque<std::unique_ptr<AssetResolver>> resolvers_;
 
+  // Assets are loaded on several threads.
+  mutable std::mutex recording_mutex_;
+  bool is_recording_ = false;
+  mutable std::vector<std::string> recorded_asset_names_;
+  mutable std::unordered_set<std::string> recorded_asset_name_set_;
+
+  void RecordAccess(const std::string& asset_name) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManager);
 };
 
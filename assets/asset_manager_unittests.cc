@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/asset_manager.h"
+#include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::unique_ptr<AssetManager> CreateAssetManager(
+    fml::ScopedTemporaryDirectory& directory,
+    const std::vector<std::string>& asset_names) {
+  for (const auto& asset_name : asset_names) {
+    fml::DataMapping data(asset_name);
+    EXPECT_TRUE(
+        fml::WriteAtomically(directory.fd(), asset_name.c_str(), data));
+  }
+  auto asset_manager = std::make_unique<AssetManager>();
+  asset_manager->PushBack(std::make_unique<DirectoryAssetBundle>(
+      fml::OpenDirectory(directory.path().c_str(), false,
+                         fml::FilePermission::kRead),
+      false));
+  return asset_manager;
+}
+
+TEST(AssetManagerTest, RecordsAssetsLoadedWhileRecording) {
+  fml::ScopedTemporaryDirectory directory;
+  auto asset_manager = CreateAssetManager(directory, {"a", "b", "c"});
+
+  ASSERT_NE(asset_manager->GetAsMapping("a"), nullptr);
+  asset_manager->StartRecordingAccesses();
+  ASSERT_NE(asset_manager->GetAsMapping("c"), nullptr);
+  ASSERT_NE(asset_manager->GetAsMapping("a"), nullptr);
+  ASSERT_NE(asset_manager->GetAsMapping("c"), nullptr);
+  ASSERT_EQ(asset_manager->GetAsMapping("missing"), nullptr);
+  ASSERT_EQ(asset_manager->StopRecordingAccesses(),
+            (std::vector<std::string>{"c", "a"}));
+
+  ASSERT_NE(asset_manager->GetAsMapping("b"), nullptr);
+  ASSERT_TRUE(asset_manager->StopRecordingAccesses().empty());
+}
+
+TEST(AssetManagerTest, PrefetchesAssetsThatResolve) {
+  fml::ScopedTemporaryDirectory directory;
+  auto asset_manager = CreateAssetManager(directory, {"a", "b"});
+
+  ASSERT_EQ(asset_manager->PrefetchAssets({"a", "missing", "b", ""}), 2u);
+  ASSERT_TRUE(asset_manager->Prefetch("a"));
+  ASSERT_FALSE(asset_manager->Prefetch("missing"));
+  ASSERT_FALSE(AssetManager().Prefetch("a"));
+}
+
+}  // namespace testing
+}  // namespace flutter
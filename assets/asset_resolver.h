@@ -26,7 +26,8 @@ class AssetResolver {
   enum AssetResolverType {
     kAssetManager,
     kApkAssetProvider,
-    kDirectoryAssetBundle
+    kDirectoryAssetBundle,
+    kPackedAssetBundle,
   };
 
   virtual bool IsValid() const = 0;
@@ -81,6 +82,18 @@ class AssetResolver {
     return {};
   };
 
+  //--------------------------------------------------------------------------
+  /// @brief      Reads an asset into memory ahead of it being loaded, if this
+  ///             resolver can. This blocks on storage, so it is only called
+  ///             on background threads.
+  ///
+  /// @param[in]  asset_name  The name of the asset to prefetch.
+  ///
+  /// @return     Returns whether this resolver has the asset, in which case
+  ///             the resolvers after it aren't asked to prefetch it.
+  ///
+  virtual bool Prefetch(const std::string& asset_name) const { return false; }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(AssetResolver);
 };
@@ -14,6 +14,10 @@
 
 namespace flutter {
 
+// Assets that are at least this large are read from storage as soon as they
+// are mapped.
+static constexpr size_t kPrefetchedAssetSize = 256 * 1024;
+
 DirectoryAssetBundle::DirectoryAssetBundle(
     fml::UniqueFD descriptor,
     bool is_valid_after_asset_manager_change)
@@ -57,9 +61,31 @@ std::unique_ptr<fml::Mapping> DirectoryAssetBundle::GetAsMapping(
     return nullptr;
   }
 
+  // Large assets, such as fonts and images, are usually decoded as a whole
+  // right after they are loaded.
+  if (mapping->GetSize() >= kPrefetchedAssetSize) {
+    mapping->Advise(fml::FileMapping::Advice::kWillNeed);
+  }
+
   return mapping;
 }
 
+bool DirectoryAssetBundle::Prefetch(const std::string& asset_name) const {
+  if (!is_valid_) {
+    return false;
+  }
+
+  fml::FileMapping mapping(fml::OpenFile(descriptor_, asset_name.c_str(),
+                                         false, fml::FilePermission::kRead));
+  if (!mapping.IsValid()) {
+    return false;
+  }
+
+  mapping.Advise(fml::FileMapping::Advice::kWillNeed);
+  mapping.TouchPages();
+  return true;
+}
+
 std::vector<std::unique_ptr<fml::Mapping>> DirectoryAssetBundle::GetAsMappings(
     const std::string& asset_pattern,
     const std::optional<std::string>& subdir) const {
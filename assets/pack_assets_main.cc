@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Packs an assets directory into the archive read by PackedAssetBundle.
+//
+// Usage: pack_assets --assets-dir=<directory>
+//
+// The archive is written to the assets directory, which keeps the assets so
+// that those that aren't found in the archive still resolve.
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+// Adds the files in |directory| to |assets|, named by their path from the
+// assets directory.
+static bool AddAssets(
+    const fml::UniqueFD& directory,
+    const std::string& prefix,
+    std::map<std::string, std::unique_ptr<fml::Mapping>>& assets) {
+  return fml::VisitFiles(
+      directory, [&](const fml::UniqueFD& parent, const std::string& name) {
+        std::string path = prefix.empty() ? name : prefix + "/" + name;
+        if (path == PackedAssetBundle::kArchiveFileName) {
+          return true;
+        }
+        fml::UniqueFD file = fml::OpenFileReadOnly(parent, name.c_str());
+        if (fml::IsDirectory(file)) {
+          return AddAssets(file, path, assets);
+        }
+        auto mapping = std::make_unique<fml::FileMapping>(file);
+        if (!mapping->IsValid()) {
+          std::cerr << "Could not read asset " << path << "." << std::endl;
+          return false;
+        }
+        assets[path] = std::move(mapping);
+        return true;
+      });
+}
+
+static bool Main(const fml::CommandLine& command_line) {
+  std::string assets_dir;
+  if (!command_line.GetOptionValue("assets-dir", &assets_dir)) {
+    std::cerr << "Usage: pack_assets --assets-dir=<directory>" << std::endl;
+    return false;
+  }
+
+  fml::UniqueFD directory = fml::OpenDirectory(
+      assets_dir.c_str(), false, fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    std::cerr << "Could not open " << assets_dir << "." << std::endl;
+    return false;
+  }
+
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+  if (!AddAssets(directory, "", assets)) {
+    return false;
+  }
+
+  auto archive = PackedAssetBundle::Pack(assets);
+  if (!fml::WriteAtomically(directory, PackedAssetBundle::kArchiveFileName,
+                            *archive)) {
+    std::cerr << "Could not write the archive." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
+
+int main(int argc, char const* argv[]) {
+  bool success = flutter::Main(fml::CommandLineFromArgcArgv(argc, argv));
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,361 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/assets/packed_asset_bundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// The archive starts with a header, followed by the displacement of each
+// bucket of the hash, the entries in the order of their slots, the names and
+// the data of the assets. All offsets are from the start of the archive and
+// all integers are little endian.
+namespace {
+
+constexpr char kMagic[8] = {'F', 'L', 'T', 'P', 'A', 'K', '0', '1'};
+
+// The data of each asset starts at a multiple of this.
+constexpr size_t kDataAlignment = 16;
+
+struct Header {
+  char magic[8];
+  uint32_t entry_count;
+  uint32_t bucket_count;
+};
+
+static_assert(sizeof(Header) == 16);
+
+size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// FNV-1a, with the seed replacing the offset basis when it isn't zero. The
+// result is mixed like MurmurHash3 does, as the low bits of FNV-1a change with
+// the seed in the same way for every name.
+uint32_t Hash(std::string_view name, uint32_t seed) {
+  uint32_t hash = seed == 0 ? 2166136261u : seed;
+  for (char c : name) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+// Whether [offset, offset + size) lies within a buffer of the given size.
+bool IsInBounds(uint64_t offset, uint64_t size, size_t buffer_size) {
+  return offset <= buffer_size && size <= buffer_size - offset;
+}
+
+}  // namespace
+
+struct PackedAssetBundle::Entry {
+  uint64_t name_offset;
+  uint64_t name_size;
+  uint64_t data_offset;
+  uint64_t data_size;
+};
+
+std::unique_ptr<PackedAssetBundle> PackedAssetBundle::Open(
+    const fml::UniqueFD& directory,
+    bool is_valid_after_asset_manager_change) {
+  if (!directory.is_valid()) {
+    return nullptr;
+  }
+  fml::UniqueFD file = fml::OpenFileReadOnly(directory, kArchiveFileName);
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = std::make_shared<fml::FileMapping>(file);
+  if (!mapping->IsValid()) {
+    return nullptr;
+  }
+  auto bundle = std::make_unique<PackedAssetBundle>(
+      std::move(mapping), is_valid_after_asset_manager_change);
+  if (!bundle->IsValid()) {
+    FML_LOG(ERROR) << "Asset archive " << kArchiveFileName << " is invalid.";
+    return nullptr;
+  }
+  return bundle;
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::Pack(
+    const std::map<std::string, std::unique_ptr<fml::Mapping>>& assets) {
+  const uint32_t entry_count = assets.size();
+  const uint32_t bucket_count = std::max<uint32_t>(entry_count, 1u);
+
+  std::vector<std::string_view> names;
+  for (const auto& [name, mapping] : assets) {
+    names.push_back(name);
+  }
+
+  // Hash and displace: the names are hashed into buckets, and the buckets
+  // with the most names are placed first, each with the first displacement
+  // that puts all its names into free slots. Buckets of one name take a free
+  // slot directly, stored as a negative displacement.
+  std::vector<std::vector<uint32_t>> buckets(bucket_count);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    buckets[Hash(names[i], 0) % bucket_count].push_back(i);
+  }
+  std::vector<uint32_t> bucket_order(bucket_count);
+  for (uint32_t i = 0; i < bucket_count; i++) {
+    bucket_order[i] = i;
+  }
+  std::stable_sort(bucket_order.begin(), bucket_order.end(),
+                   [&buckets](uint32_t a, uint32_t b) {
+                     return buckets[a].size() > buckets[b].size();
+                   });
+
+  std::vector<int32_t> displacements(bucket_count, 0);
+  std::vector<int64_t> slots(entry_count, -1);
+  size_t order_index = 0;
+  for (; order_index < bucket_count; order_index++) {
+    const auto& bucket = buckets[bucket_order[order_index]];
+    if (bucket.size() <= 1) {
+      break;
+    }
+    for (uint32_t displacement = 1;; displacement++) {
+      std::vector<uint32_t> bucket_slots;
+      for (uint32_t name_index : bucket) {
+        uint32_t slot = Hash(names[name_index], displacement) % entry_count;
+        if (slots[slot] >= 0 ||
+            std::find(bucket_slots.begin(), bucket_slots.end(), slot) !=
+                bucket_slots.end()) {
+          break;
+        }
+        bucket_slots.push_back(slot);
+      }
+      if (bucket_slots.size() == bucket.size()) {
+        for (size_t i = 0; i < bucket.size(); i++) {
+          slots[bucket_slots[i]] = bucket[i];
+        }
+        displacements[bucket_order[order_index]] = displacement;
+        break;
+      }
+    }
+  }
+  uint32_t free_slot = 0;
+  for (; order_index < bucket_count; order_index++) {
+    const auto& bucket = buckets[bucket_order[order_index]];
+    if (bucket.empty()) {
+      break;
+    }
+    while (slots[free_slot] >= 0) {
+      free_slot++;
+    }
+    slots[free_slot] = bucket[0];
+    displacements[bucket_order[order_index]] =
+        -static_cast<int32_t>(free_slot) - 1;
+  }
+
+  const size_t displacements_offset = sizeof(Header);
+  const size_t entries_offset = AlignUp(
+      displacements_offset + bucket_count * sizeof(int32_t), alignof(Entry));
+  const size_t names_offset = entries_offset + entry_count * sizeof(Entry);
+
+  std::vector<Entry> entries(entry_count);
+  size_t offset = names_offset;
+  for (uint32_t slot = 0; slot < entry_count; slot++) {
+    entries[slot].name_offset = offset;
+    entries[slot].name_size = names[slots[slot]].size();
+    offset += names[slots[slot]].size();
+  }
+  std::vector<const fml::Mapping*> mappings;
+  for (const auto& [name, mapping] : assets) {
+    mappings.push_back(mapping.get());
+  }
+  for (uint32_t slot = 0; slot < entry_count; slot++) {
+    offset = AlignUp(offset, kDataAlignment);
+    entries[slot].data_offset = offset;
+    entries[slot].data_size = mappings[slots[slot]]->GetSize();
+    offset += mappings[slots[slot]]->GetSize();
+  }
+
+  std::vector<uint8_t> archive(offset, 0);
+  Header header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.entry_count = entry_count;
+  header.bucket_count = bucket_count;
+  memcpy(archive.data(), &header, sizeof(header));
+  memcpy(archive.data() + displacements_offset, displacements.data(),
+         bucket_count * sizeof(int32_t));
+  if (entry_count > 0) {
+    memcpy(archive.data() + entries_offset, entries.data(),
+           entry_count * sizeof(Entry));
+  }
+  for (uint32_t slot = 0; slot < entry_count; slot++) {
+    const auto& name = names[slots[slot]];
+    memcpy(archive.data() + entries[slot].name_offset, name.data(),
+           name.size());
+    const auto* mapping = mappings[slots[slot]];
+    if (mapping->GetSize() > 0) {
+      memcpy(archive.data() + entries[slot].data_offset,
+             mapping->GetMapping(), mapping->GetSize());
+    }
+  }
+  return std::make_unique<fml::DataMapping>(std::move(archive));
+}
+
+PackedAssetBundle::PackedAssetBundle(std::shared_ptr<fml::Mapping> archive,
+                                     bool is_valid_after_asset_manager_change)
+    : archive_(std::move(archive)),
+      is_valid_after_asset_manager_change_(
+          is_valid_after_asset_manager_change) {
+  if (!archive_ || archive_->GetMapping() == nullptr ||
+      archive_->GetSize() < sizeof(Header)) {
+    return;
+  }
+  const uint8_t* data = archive_->GetMapping();
+  const size_t size = archive_->GetSize();
+
+  Header header;
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.bucket_count == 0) {
+    return;
+  }
+
+  const size_t displacements_offset = sizeof(Header);
+  const uint64_t entries_offset =
+      AlignUp(displacements_offset +
+                  static_cast<uint64_t>(header.bucket_count) * sizeof(int32_t),
+              alignof(Entry));
+  if (!IsInBounds(entries_offset,
+                  static_cast<uint64_t>(header.entry_count) * sizeof(Entry),
+                  size) ||
+      reinterpret_cast<uintptr_t>(data) % alignof(Entry) != 0) {
+    return;
+  }
+  const auto* displacements =
+      reinterpret_cast<const int32_t*>(data + displacements_offset);
+  const auto* entries = reinterpret_cast<const Entry*>(data + entries_offset);
+
+  // Validating the archive once lets lookups trust it.
+  for (uint32_t i = 0; i < header.bucket_count; i++) {
+    if (displacements[i] < 0 &&
+        -static_cast<int64_t>(displacements[i]) - 1 >= header.entry_count) {
+      return;
+    }
+  }
+  for (uint32_t i = 0; i < header.entry_count; i++) {
+    if (!IsInBounds(entries[i].name_offset, entries[i].name_size, size) ||
+        !IsInBounds(entries[i].data_offset, entries[i].data_size, size)) {
+      return;
+    }
+  }
+
+  entry_count_ = header.entry_count;
+  bucket_count_ = header.bucket_count;
+  displacements_ = displacements;
+  entries_ = entries;
+  is_valid_ = true;
+}
+
+PackedAssetBundle::~PackedAssetBundle() = default;
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValid() const {
+  return is_valid_;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::IsValidAfterAssetManagerChange() const {
+  return is_valid_after_asset_manager_change_;
+}
+
+// |AssetResolver|
+AssetResolver::AssetResolverType PackedAssetBundle::GetType() const {
+  return AssetResolver::AssetResolverType::kPackedAssetBundle;
+}
+
+std::string_view PackedAssetBundle::GetName(const Entry& entry) const {
+  return std::string_view(
+      reinterpret_cast<const char*>(archive_->GetMapping() + entry.name_offset),
+      entry.name_size);
+}
+
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetData(
+    const Entry& entry) const {
+  // The mapping holds on to the archive, so it outlives the bundle.
+  return std::make_unique<fml::NonOwnedMapping>(
+      archive_->GetMapping() + entry.data_offset, entry.data_size,
+      [archive = archive_](const uint8_t* data, size_t size) {});
+}
+
+// |AssetResolver|
+std::unique_ptr<fml::Mapping> PackedAssetBundle::GetAsMapping(
+    const std::string& asset_name) const {
+  if (!is_valid_ || entry_count_ == 0) {
+    return nullptr;
+  }
+
+  int32_t displacement = displacements_[Hash(asset_name, 0) % bucket_count_];
+  uint32_t slot =
+      displacement < 0
+          ? static_cast<uint32_t>(-static_cast<int64_t>(displacement) - 1)
+          : Hash(asset_name, displacement) % entry_count_;
+  const Entry& entry = entries_[slot];
+  if (GetName(entry) != asset_name) {
+    return nullptr;
+  }
+  return GetData(entry);
+}
+
+// |AssetResolver|
+std::vector<std::unique_ptr<fml::Mapping>> PackedAssetBundle::GetAsMappings(
+    const std::string& asset_pattern,
+    const std::optional<std::string>& subdir) const {
+  std::vector<std::unique_ptr<fml::Mapping>> mappings;
+  if (!is_valid_) {
+    return mappings;
+  }
+  TRACE_EVENT0("flutter", "PackedAssetBundle::GetAsMappings");
+
+  // Like a directory, names are matched without their directory, which must
+  // be the subdirectory if one is given.
+  std::regex asset_regex(asset_pattern);
+  for (uint32_t i = 0; i < entry_count_; i++) {
+    std::string_view name = GetName(entries_[i]);
+    size_t separator = name.rfind('/');
+    std::string_view directory =
+        separator == std::string_view::npos ? std::string_view()
+                                            : name.substr(0, separator);
+    std::string_view file_name = separator == std::string_view::npos
+                                     ? name
+                                     : name.substr(separator + 1);
+    if (subdir && directory != subdir.value()) {
+      continue;
+    }
+    if (std::regex_match(file_name.begin(), file_name.end(), asset_regex)) {
+      mappings.push_back(GetData(entries_[i]));
+    }
+  }
+  return mappings;
+}
+
+// |AssetResolver|
+bool PackedAssetBundle::Prefetch(const std::string& asset_name) const {
+  auto mapping = GetAsMapping(asset_name);
+  if (!mapping) {
+    return false;
+  }
+  // The archive is mapped with the default readahead, which faulting in the
+  // pages of the asset benefits from.
+  mapping->TouchPages();
+  return true;
+}
+
+}  // namespace flutter
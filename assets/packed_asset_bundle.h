@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+#define FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "flutter/assets/asset_resolver.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Resolves assets from a single archive that is mapped once, so
+///             that looking up an asset costs neither a system call nor a
+///             file system lookup.
+///
+///             The archive is indexed by a minimal perfect hash of the asset
+///             names, built when the archive is packed. A lookup hashes the
+///             name twice and compares it with the one entry it can be. The
+///             mappings returned point into the archive and keep it mapped.
+///
+class PackedAssetBundle : public AssetResolver {
+ public:
+  /// The name of the archive in the assets directory.
+  static constexpr char kArchiveFileName[] = "assets.flutterpak";
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the archive in an assets directory.
+  ///
+  /// @return     The bundle, or nullptr if the directory has no valid archive.
+  ///
+  static std::unique_ptr<PackedAssetBundle> Open(
+      const fml::UniqueFD& directory,
+      bool is_valid_after_asset_manager_change);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Packs assets into an archive, named by their paths relative
+  ///             to the assets directory.
+  ///
+  static std::unique_ptr<fml::Mapping> Pack(
+      const std::map<std::string, std::unique_ptr<fml::Mapping>>& assets);
+
+  PackedAssetBundle(std::shared_ptr<fml::Mapping> archive,
+                    bool is_valid_after_asset_manager_change);
+
+  ~PackedAssetBundle() override;
+
+  // |AssetResolver|
+  bool IsValid() const override;
+
+  // |AssetResolver|
+  bool IsValidAfterAssetManagerChange() const override;
+
+  // |AssetResolver|
+  AssetResolver::AssetResolverType GetType() const override;
+
+  // |AssetResolver|
+  std::unique_ptr<fml::Mapping> GetAsMapping(
+      const std::string& asset_name) const override;
+
+  // |AssetResolver|
+  std::vector<std::unique_ptr<fml::Mapping>> GetAsMappings(
+      const std::string& asset_pattern,
+      const std::optional<std::string>& subdir) const override;
+
+  // |AssetResolver|
+  bool Prefetch(const std::string& asset_name) const override;
+
+ private:
+  struct Entry;
+
+  const std::shared_ptr<fml::Mapping> archive_;
+  const bool is_valid_after_asset_manager_change_;
+  uint32_t entry_count_ = 0;
+  uint32_t bucket_count_ = 0;
+  const int32_t* displacements_ = nullptr;
+  const Entry* entries_ = nullptr;
+  bool is_valid_ = false;
+
+  std::string_view GetName(const Entry& entry) const;
+
+  std::unique_ptr<fml::Mapping> GetData(const Entry& entry) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PackedAssetBundle);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_ASSETS_PACKED_ASSET_BUNDLE_H_
@@ -0,0 +1,155 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flutter/assets/packed_asset_bundle.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::unique_ptr<fml::Mapping> CreateMapping(const std::string& data) {
+  return std::make_unique<fml::DataMapping>(data);
+}
+
+static std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+static std::unique_ptr<PackedAssetBundle> CreateBundle(
+    const std::map<std::string, std::unique_ptr<fml::Mapping>>& assets) {
+  std::shared_ptr<fml::Mapping> archive = PackedAssetBundle::Pack(assets);
+  return std::make_unique<PackedAssetBundle>(archive, false);
+}
+
+TEST(PackedAssetBundleTest, ResolvesEveryPackedAsset) {
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+  for (int i = 0; i < 1000; i++) {
+    assets["assets/icons/icon_" + std::to_string(i) + ".png"] =
+        CreateMapping("icon " + std::to_string(i));
+  }
+  assets["empty"] = CreateMapping("");
+
+  auto bundle = CreateBundle(assets);
+  ASSERT_TRUE(bundle->IsValid());
+  ASSERT_EQ(bundle->GetType(),
+            AssetResolver::AssetResolverType::kPackedAssetBundle);
+
+  for (int i = 0; i < 1000; i++) {
+    auto mapping = bundle->GetAsMapping("assets/icons/icon_" +
+                                        std::to_string(i) + ".png");
+    ASSERT_NE(mapping, nullptr);
+    ASSERT_EQ(ToString(*mapping), "icon " + std::to_string(i));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(mapping->GetMapping()) % 16, 0u);
+  }
+  auto empty = bundle->GetAsMapping("empty");
+  ASSERT_NE(empty, nullptr);
+  ASSERT_EQ(empty->GetSize(), 0u);
+
+  ASSERT_EQ(bundle->GetAsMapping("assets/icons/icon_1000.png"), nullptr);
+  ASSERT_EQ(bundle->GetAsMapping("assets/icons"), nullptr);
+  ASSERT_EQ(bundle->GetAsMapping(""), nullptr);
+}
+
+TEST(PackedAssetBundleTest, ResolvesArchivesOfAnySize) {
+  for (int count = 1; count <= 64; count++) {
+    std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+    for (int i = 0; i < count; i++) {
+      assets[std::to_string(i)] = CreateMapping(std::to_string(i));
+    }
+    auto bundle = CreateBundle(assets);
+    ASSERT_TRUE(bundle->IsValid());
+    for (int i = 0; i < count; i++) {
+      auto mapping = bundle->GetAsMapping(std::to_string(i));
+      ASSERT_NE(mapping, nullptr) << i << " of " << count;
+      ASSERT_EQ(ToString(*mapping), std::to_string(i));
+    }
+  }
+}
+
+TEST(PackedAssetBundleTest, MappingsOutliveBundle) {
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+  assets["font.ttf"] = CreateMapping("font");
+  auto bundle = CreateBundle(assets);
+  auto mapping = bundle->GetAsMapping("font.ttf");
+  bundle.reset();
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(ToString(*mapping), "font");
+}
+
+TEST(PackedAssetBundleTest, MatchesFileNamesInSubdirectory) {
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+  assets["shaders/a.frag"] = CreateMapping("a");
+  assets["shaders/b.frag"] = CreateMapping("b");
+  assets["shaders/nested/c.frag"] = CreateMapping("c");
+  assets["d.frag"] = CreateMapping("d");
+  assets["e.txt"] = CreateMapping("e");
+  auto bundle = CreateBundle(assets);
+
+  auto to_strings = [](std::vector<std::unique_ptr<fml::Mapping>> mappings) {
+    std::vector<std::string> strings;
+    for (const auto& mapping : mappings) {
+      strings.push_back(ToString(*mapping));
+    }
+    std::sort(strings.begin(), strings.end());
+    return strings;
+  };
+  ASSERT_EQ(to_strings(bundle->GetAsMappings(".*\\.frag", std::nullopt)),
+            (std::vector<std::string>{"a", "b", "c", "d"}));
+  ASSERT_EQ(to_strings(bundle->GetAsMappings(".*\\.frag", "shaders")),
+            (std::vector<std::string>{"a", "b"}));
+  ASSERT_TRUE(bundle->GetAsMappings(".*", "missing").empty());
+}
+
+TEST(PackedAssetBundleTest, RejectsInvalidArchives) {
+  ASSERT_FALSE(PackedAssetBundle(nullptr, false).IsValid());
+  ASSERT_FALSE(
+      PackedAssetBundle(std::make_shared<fml::DataMapping>("not an archive"),
+                        false)
+          .IsValid());
+
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+  assets["image.png"] = CreateMapping("image");
+  auto archive = PackedAssetBundle::Pack(assets);
+  std::vector<uint8_t> truncated(archive->GetMapping(),
+                                 archive->GetMapping() + 40);
+  ASSERT_FALSE(PackedAssetBundle(
+                   std::make_shared<fml::DataMapping>(std::move(truncated)),
+                   false)
+                   .IsValid());
+
+  // An archive without assets is valid but resolves nothing.
+  auto empty = CreateBundle({});
+  ASSERT_TRUE(empty->IsValid());
+  ASSERT_EQ(empty->GetAsMapping("image.png"), nullptr);
+}
+
+TEST(PackedAssetBundleTest, OpensArchiveOfDirectory) {
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_EQ(PackedAssetBundle::Open(directory.fd(), false), nullptr);
+
+  std::map<std::string, std::unique_ptr<fml::Mapping>> assets;
+  assets["translations/en.json"] = CreateMapping("{}");
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(),
+                                   PackedAssetBundle::kArchiveFileName,
+                                   *PackedAssetBundle::Pack(assets)));
+
+  auto bundle = PackedAssetBundle::Open(directory.fd(), true);
+  ASSERT_NE(bundle, nullptr);
+  ASSERT_TRUE(bundle->IsValidAfterAssetManagerChange());
+  auto mapping = bundle->GetAsMapping("translations/en.json");
+  ASSERT_NE(mapping, nullptr);
+  ASSERT_EQ(ToString(*mapping), "{}");
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace benchmarking {
+
+namespace {
+
+// Plain types, so that they can be used by allocations made before the
+// static initializers of this file run and after its destructors do.
+thread_local AllocationSubsystem* current_subsystem = nullptr;
+std::atomic<size_t> total_allocations = 0;
+std::atomic<size_t> total_bytes = 0;
+
+}  // namespace
+
+void RecordAllocation(size_t bytes) {
+  total_allocations.fetch_add(1, std::memory_order_relaxed);
+  total_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  if (auto subsystem = current_subsystem) {
+    subsystem->allocations_.fetch_add(1, std::memory_order_relaxed);
+    subsystem->bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+
+AllocationSubsystem::AllocationSubsystem(const char* name) : name_(name) {}
+
+AllocationCounts AllocationSubsystem::GetCounts() const {
+  return {allocations_.load(std::memory_order_relaxed),
+          bytes_.load(std::memory_order_relaxed)};
+}
+
+void AllocationSubsystem::ReportCounts(::benchmark::State& state,
+                                       const AllocationCounts& start) const {
+  auto counts = GetCounts() - start;
+  state.counters[std::string(name_) + ".allocs"] = ::benchmark::Counter(
+      counts.allocations, ::benchmark::Counter::kAvgIterations);
+  state.counters[std::string(name_) + ".bytes"] = ::benchmark::Counter(
+      counts.bytes, ::benchmark::Counter::kAvgIterations);
+}
+
+AllocationCounts AllocationSubsystem::GetTotalCounts() {
+  return {total_allocations.load(std::memory_order_relaxed),
+          total_bytes.load(std::memory_order_relaxed)};
+}
+
+ScopedAllocationSubsystem::ScopedAllocationSubsystem(
+    AllocationSubsystem& subsystem)
+    : previous_(current_subsystem) {
+  current_subsystem = &subsystem;
+}
+
+ScopedAllocationSubsystem::~ScopedAllocationSubsystem() {
+  current_subsystem = previous_;
+}
+
+}  // namespace benchmarking
+
+static void* CountedAllocate(size_t size) {
+  benchmarking::RecordAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size) {
+  void* pointer = CountedAllocate(size);
+  if (!pointer) {
+    std::abort();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  void* pointer = CountedAllocate(size);
+  if (!pointer) {
+    std::abort();
+  }
+  return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  std::free(pointer);
+}
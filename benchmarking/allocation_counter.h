@@ -0,0 +1,82 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_BENCHMARKING_ALLOCATION_COUNTER_H_
+#define FLUTTER_BENCHMARKING_ALLOCATION_COUNTER_H_
+
+#include <atomic>
+#include <cstddef>
+
+#include "benchmark/benchmark.h"
+
+// Replaces the global operator new and delete of the executable that links
+// this in, so that the heap allocations made on each thread are counted and
+// attributed to the subsystem that thread is in, as marked by
+// |ScopedAllocationSubsystem|.
+//
+// Only one target of an executable may replace the global allocation
+// functions, so this should only be linked into benchmarks that are about
+// allocations.
+
+namespace benchmarking {
+
+struct AllocationCounts {
+  size_t allocations = 0;
+  size_t bytes = 0;
+
+  AllocationCounts operator-(const AllocationCounts& other) const {
+    return {allocations - other.allocations, bytes - other.bytes};
+  }
+};
+
+class AllocationSubsystem {
+ public:
+  // The name must outlive the subsystem, which usually has static storage.
+  explicit AllocationSubsystem(const char* name);
+
+  const char* name() const { return name_; }
+
+  // The allocations made while this was the subsystem of the allocating
+  // thread, since it was created.
+  AllocationCounts GetCounts() const;
+
+  // Adds the counts made since |start| to the counters of the benchmark as
+  // <name>.allocs and <name>.bytes, averaged over the iterations.
+  void ReportCounts(::benchmark::State& state,
+                    const AllocationCounts& start) const;
+
+  // The allocations made on any thread, in any subsystem or none.
+  static AllocationCounts GetTotalCounts();
+
+ private:
+  friend void RecordAllocation(size_t bytes);
+
+  const char* name_;
+  std::atomic<size_t> allocations_ = 0;
+  std::atomic<size_t> bytes_ = 0;
+
+  AllocationSubsystem(const AllocationSubsystem&) = delete;
+  AllocationSubsystem& operator=(const AllocationSubsystem&) = delete;
+};
+
+// Attributes the allocations of the current thread to |subsystem| until this
+// is destroyed. Scopes nest, with each allocation counted only by the
+// innermost one.
+class ScopedAllocationSubsystem {
+ public:
+  explicit ScopedAllocationSubsystem(AllocationSubsystem& subsystem);
+
+  ~ScopedAllocationSubsystem();
+
+ private:
+  AllocationSubsystem* const previous_;
+
+  ScopedAllocationSubsystem(const ScopedAllocationSubsystem&) = delete;
+  ScopedAllocationSubsystem& operator=(const ScopedAllocationSubsystem&) =
+      delete;
+};
+
+}  // namespace benchmarking
+
+#endif  // FLUTTER_BENCHMARKING_ALLOCATION_COUNTER_H_
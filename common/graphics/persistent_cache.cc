@@ -4,10 +4,12 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <algorithm>
 #include <future>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <utility>
 
 #include "flutter/fml/base32.h"
@@ -85,8 +87,11 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  GetWorkerTaskRunner()->PostTask([&removed, cache_directory = cache_directory_,
+                                   cache_pack = cache_pack_,
+                                   sksl_cache_pack = sksl_cache_pack_]() {
+    cache_pack->Clear();
+    sksl_cache_pack->Clear();
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -221,8 +226,26 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
+  std::unordered_set<std::string> packed_names;
+  sksl_cache_pack_->Visit([&](const std::string& name,
+                              const fml::Mapping& object) {
+    SkSLCache cache = ParseCacheObject(object, name, true);
+    if (cache.key != nullptr && cache.value != nullptr) {
+      result.push_back(cache);
+      packed_names.insert(name);
+    } else {
+      FML_LOG(ERROR) << "Failed to load: " << name;
+    }
+  });
+
+  fml::FileVisitor visitor = [&result, &packed_names](
+                                 const fml::UniqueFD& directory,
+                                 const std::string& filename) {
+    // The pack is loaded above, as are the files that it replaces.
+    if (filename.rfind(PersistentCachePack::kFileName, 0) == 0 ||
+        packed_names.count(filename) > 0) {
+      return true;
+    }
     SkSLCache cache = LoadFile(directory, filename, true);
     if (cache.key != nullptr && cache.value != nullptr) {
       result.push_back(cache);
@@ -279,7 +302,12 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      cache_pack_(
+          std::make_shared<PersistentCachePack>(cache_directory_, read_only)),
+      sksl_cache_pack_(
+          std::make_shared<PersistentCachePack>(sksl_cache_directory_,
+                                                read_only)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -296,33 +324,39 @@ PersistentCache::SkSLCache PersistentCache::LoadFile(
     const fml::UniqueFD& dir,
     const std::string& file_name,
     bool need_key) {
-  SkSLCache result;
   auto file = fml::OpenFileReadOnly(dir, file_name.c_str());
   if (!file.is_valid()) {
-    return result;
+    return {};
   }
-  auto mapping = std::make_unique<fml::FileMapping>(file);
-  if (mapping->GetSize() < sizeof(CacheObjectHeader)) {
+  return ParseCacheObject(fml::FileMapping(file), file_name, need_key);
+}
+
+PersistentCache::SkSLCache PersistentCache::ParseCacheObject(
+    const fml::Mapping& mapping,
+    const std::string& file_name,
+    bool need_key) {
+  SkSLCache result;
+  if (mapping.GetSize() < sizeof(CacheObjectHeader)) {
     return result;
   }
   const CacheObjectHeader* header =
-      reinterpret_cast<const CacheObjectHeader*>(mapping->GetMapping());
+      reinterpret_cast<const CacheObjectHeader*>(mapping.GetMapping());
   if (header->signature != CacheObjectHeader::kSignature ||
       header->version != CacheObjectHeader::kVersion1) {
     FML_LOG(INFO) << "Persistent cache header is corrupt: " << file_name;
     return result;
   }
-  if (mapping->GetSize() < sizeof(CacheObjectHeader) + header->key_size) {
+  if (mapping.GetSize() < sizeof(CacheObjectHeader) + header->key_size) {
     FML_LOG(INFO) << "Persistent cache size is corrupt: " << file_name;
     return result;
   }
   if (need_key) {
     result.key = SkData::MakeWithCopy(
-        mapping->GetMapping() + sizeof(CacheObjectHeader), header->key_size);
+        mapping.GetMapping() + sizeof(CacheObjectHeader), header->key_size);
   }
   size_t value_offset = sizeof(CacheObjectHeader) + header->key_size;
-  result.value = SkData::MakeWithCopy(mapping->GetMapping() + value_offset,
-                                      mapping->GetSize() - value_offset);
+  result.value = SkData::MakeWithCopy(mapping.GetMapping() + value_offset,
+                                      mapping.GetSize() - value_offset);
   return result;
 }
 
@@ -336,8 +370,12 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (file_name.empty()) {
     return nullptr;
   }
-  auto result =
-      PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
+  sk_sp<SkData> result;
+  if (auto object = cache_pack_->Load(file_name)) {
+    result = ParseCacheObject(*object, file_name, false).value;
+  } else {
+    result = LoadFile(*cache_directory_, file_name, false).value;
+  }
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
@@ -418,9 +456,8 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+  auto& cache_pack = cache_sksl_ ? sksl_cache_pack_ : cache_pack_;
+  cache_pack->Store(file_name, std::move(mapping), GetWorkerTaskRunner());
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
@@ -441,6 +478,70 @@ void PersistentCache::DumpSkp(const SkData& data) {
                        std::move(file_name), std::move(mapping));
 }
 
+std::vector<std::string> PersistentCache::LoadAssetPrefetchManifest() const {
+  std::vector<std::string> asset_names;
+  if (!IsValid()) {
+    return asset_names;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(*cache_directory_,
+                                                  kAssetPrefetchManifestName);
+  if (!mapping) {
+    return asset_names;
+  }
+
+  // The manifest lists one asset name per line.
+  std::string_view manifest(
+      reinterpret_cast<const char*>(mapping->GetMapping()), mapping->GetSize());
+  while (!manifest.empty()) {
+    size_t end = std::min(manifest.find('\n'), manifest.size());
+    if (end > 0) {
+      asset_names.emplace_back(manifest.substr(0, end));
+    }
+    manifest.remove_prefix(std::min(end + 1, manifest.size()));
+  }
+  return asset_names;
+}
+
+void PersistentCache::StoreAssetPrefetchManifest(
+    const std::vector<std::string>& asset_names) {
+  if (is_read_only_ || !IsValid()) {
+    return;
+  }
+
+  std::string manifest;
+  for (const auto& asset_name : asset_names) {
+    if (asset_name.find('\n') == std::string::npos) {
+      manifest += asset_name + '\n';
+    }
+  }
+  if (manifest.empty()) {
+    // Empty files can't be written atomically.
+    fml::UnlinkFile(*cache_directory_, kAssetPrefetchManifestName);
+    return;
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kAssetPrefetchManifestName,
+                       std::make_unique<fml::DataMapping>(manifest));
+}
+
+std::unique_ptr<fml::Mapping> PersistentCache::LoadImpellerPipelineManifest()
+    const {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  return fml::FileMapping::CreateReadOnly(*cache_directory_,
+                                          kImpellerPipelineManifestName);
+}
+
+void PersistentCache::StoreImpellerPipelineManifest(
+    std::unique_ptr<fml::Mapping> manifest) {
+  if (is_read_only_ || !IsValid() || !manifest) {
+    return;
+  }
+  PersistentCacheStore(GetWorkerTaskRunner(), cache_directory_,
+                       kImpellerPipelineManifestName, std::move(manifest));
+}
+
 void PersistentCache::AddWorkerTaskRunner(
     const fml::RefPtr<fml::TaskRunner>& task_runner) {
   std::scoped_lock lock(worker_task_runners_mutex_);
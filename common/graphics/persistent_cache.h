@@ -8,8 +8,11 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
@@ -111,6 +114,21 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   ///
   size_t PrecompileKnownSkSLs(GrDirectContext* context) const;
 
+  // The names of the assets loaded shortly after the previous launch of the
+  // application, in the order they were first loaded.
+  std::vector<std::string> LoadAssetPrefetchManifest() const;
+
+  // Replaces the asset names returned by |LoadAssetPrefetchManifest| from the
+  // next launch on.
+  void StoreAssetPrefetchManifest(const std::vector<std::string>& asset_names);
+
+  // The manifest of the Impeller pipeline variants drawn in previous runs, or
+  // nullptr if there is none.
+  std::unique_ptr<fml::Mapping> LoadImpellerPipelineManifest() const;
+
+  // Replaces the manifest returned by |LoadImpellerPipelineManifest|.
+  void StoreImpellerPipelineManifest(std::unique_ptr<fml::Mapping> manifest);
+
   // Return mappings for all skp's accessible through the AssetManager
   std::vector<std::unique_ptr<fml::Mapping>> GetSkpsFromAssetManager() const;
 
@@ -129,6 +147,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
 
   static constexpr char kSkSLSubdirName[] = "sksl";
   static constexpr char kAssetFileName[] = "io.flutter.shaders.json";
+  static constexpr char kAssetPrefetchManifestName[] =
+      "io.flutter.asset_prefetch_manifest";
+  static constexpr char kImpellerPipelineManifestName[] =
+      "io.flutter.impeller_pipeline_manifest";
 
  private:
   static std::string cache_base_path_;
@@ -151,6 +173,11 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  // New objects of the directories are stored in their packs. Objects that
+  // aren't in the packs are still loaded from files of their own, which older
+  // engines wrote.
+  const std::shared_ptr<PersistentCachePack> cache_pack_;
+  const std::shared_ptr<PersistentCachePack> sksl_cache_pack_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
@@ -161,6 +188,10 @@ class PersistentCache : public GrContextOptions::PersistentCache {
                             const std::string& file_name,
                             bool need_key);
 
+  static SkSLCache ParseCacheObject(const fml::Mapping& mapping,
+                                    const std::string& file_name,
+                                    bool need_key);
+
   bool IsValid() const;
 
   explicit PersistentCache(bool read_only = false);
@@ -0,0 +1,201 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_pack.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// The file starts with this, followed by the objects. Each object is its
+// RecordHeader, its name, and its contents.
+constexpr char kMagic[8] = {'F', 'L', 'T', 'C', 'P', 'K', '0', '1'};
+
+struct RecordHeader {
+  uint32_t name_size;
+  uint32_t object_size;
+};
+
+void AppendRecord(std::vector<uint8_t>& pack,
+                  const std::string& name,
+                  const uint8_t* object,
+                  size_t object_size) {
+  RecordHeader header = {static_cast<uint32_t>(name.size()),
+                         static_cast<uint32_t>(object_size)};
+  const uint8_t* header_bytes = reinterpret_cast<const uint8_t*>(&header);
+  pack.insert(pack.end(), header_bytes, header_bytes + sizeof(header));
+  pack.insert(pack.end(), name.begin(), name.end());
+  if (object_size > 0) {
+    pack.insert(pack.end(), object, object + object_size);
+  }
+}
+
+}  // namespace
+
+PersistentCachePack::PersistentCachePack(
+    std::shared_ptr<fml::UniqueFD> directory,
+    bool read_only)
+    : directory_(std::move(directory)), read_only_(read_only) {
+  std::scoped_lock lock(mutex_);
+  MapFile();
+}
+
+PersistentCachePack::~PersistentCachePack() {
+  std::scoped_lock lock(mutex_);
+  WriteLocked();
+}
+
+void PersistentCachePack::MapFile() {
+  TRACE_EVENT0("flutter", "PersistentCachePack::MapFile");
+  mapping_.reset();
+  entries_.clear();
+  if (!directory_ || !directory_->is_valid()) {
+    return;
+  }
+  mapping_ = fml::FileMapping::CreateReadOnly(*directory_, kFileName);
+  if (!mapping_ || mapping_->GetSize() < sizeof(kMagic) ||
+      ::memcmp(mapping_->GetMapping(), kMagic, sizeof(kMagic)) != 0) {
+    mapping_.reset();
+    return;
+  }
+
+  const uint8_t* bytes = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+  size_t offset = sizeof(kMagic);
+  while (offset < size) {
+    RecordHeader header;
+    if (size - offset < sizeof(header)) {
+      FML_LOG(WARNING) << "Persistent cache pack is truncated.";
+      break;
+    }
+    ::memcpy(&header, bytes + offset, sizeof(header));
+    offset += sizeof(header);
+    if (size - offset <
+        static_cast<size_t>(header.name_size) + header.object_size) {
+      FML_LOG(WARNING) << "Persistent cache pack is truncated.";
+      break;
+    }
+    std::string name(reinterpret_cast<const char*>(bytes + offset),
+                     header.name_size);
+    offset += header.name_size;
+    entries_[std::move(name)] = {offset, header.object_size};
+    offset += header.object_size;
+  }
+}
+
+std::unique_ptr<fml::Mapping> PersistentCachePack::Load(
+    const std::string& name) const {
+  std::scoped_lock lock(mutex_);
+  if (auto found = pending_.find(name); found != pending_.end()) {
+    const uint8_t* object = found->second->GetMapping();
+    return std::make_unique<fml::DataMapping>(std::vector<uint8_t>(
+        object, object + found->second->GetSize()));
+  }
+  if (auto found = entries_.find(name); found != entries_.end()) {
+    const uint8_t* object = mapping_->GetMapping() + found->second.offset;
+    return std::make_unique<fml::DataMapping>(
+        std::vector<uint8_t>(object, object + found->second.size));
+  }
+  return nullptr;
+}
+
+void PersistentCachePack::Visit(
+    const std::function<void(const std::string& name,
+                             const fml::Mapping& object)>& visitor) const {
+  std::scoped_lock lock(mutex_);
+  for (const auto& [name, object] : pending_) {
+    visitor(name, *object);
+  }
+  for (const auto& [name, entry] : entries_) {
+    if (pending_.find(name) != pending_.end()) {
+      continue;
+    }
+    fml::NonOwnedMapping object(mapping_->GetMapping() + entry.offset,
+                                entry.size);
+    visitor(name, object);
+  }
+}
+
+void PersistentCachePack::Store(const std::string& name,
+                                std::unique_ptr<fml::Mapping> object,
+                                const fml::RefPtr<fml::TaskRunner>& worker) {
+  if (!object) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  pending_[name] = std::move(object);
+  if (read_only_ || write_scheduled_) {
+    return;
+  }
+  if (!worker) {
+    WriteLocked();
+    return;
+  }
+  write_scheduled_ = true;
+  worker->PostDelayedTask(
+      [weak_pack = weak_from_this()]() {
+        if (auto pack = weak_pack.lock()) {
+          pack->Write();
+        }
+      },
+      kWriteDelay);
+}
+
+bool PersistentCachePack::Write() {
+  std::scoped_lock lock(mutex_);
+  return WriteLocked();
+}
+
+bool PersistentCachePack::WriteLocked() {
+  write_scheduled_ = false;
+  if (pending_.empty() || read_only_) {
+    return true;
+  }
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PersistentCachePack::Write");
+
+  std::vector<uint8_t> pack(kMagic, kMagic + sizeof(kMagic));
+  for (const auto& [name, entry] : entries_) {
+    if (pending_.find(name) == pending_.end()) {
+      AppendRecord(pack, name, mapping_->GetMapping() + entry.offset,
+                   entry.size);
+    }
+  }
+  for (const auto& [name, object] : pending_) {
+    AppendRecord(pack, name, object->GetMapping(), object->GetSize());
+  }
+
+  // Some platforms can't replace a file while it is mapped.
+  mapping_.reset();
+  entries_.clear();
+  bool written = fml::WriteAtomically(*directory_, kFileName,
+                                      fml::DataMapping(std::move(pack)));
+  if (!written) {
+    FML_LOG(WARNING) << "Could not write the persistent cache pack.";
+  }
+  MapFile();
+  if (written) {
+    pending_.clear();
+  }
+  return written;
+}
+
+void PersistentCachePack::Clear() {
+  std::scoped_lock lock(mutex_);
+  mapping_.reset();
+  entries_.clear();
+  pending_.clear();
+}
+
+}  // namespace flutter
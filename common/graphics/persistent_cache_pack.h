@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The objects of a persistent cache directory, kept in a single
+///             file instead of a file each.
+///
+///             The whole file is mapped once when the pack is created, and
+///             indexed in memory. Stored objects are visible to loads right
+///             away, and are written to the file in batches, so that a burst
+///             of stores such as the shader compiles of a first run costs a
+///             single write.
+///
+///             The pack is thread-safe.
+///
+class PersistentCachePack
+    : public std::enable_shared_from_this<PersistentCachePack> {
+ public:
+  /// The name of the file of the pack in its directory.
+  static constexpr char kFileName[] = "io.flutter.persistent_cache_pack";
+
+  /// How long after an object is stored that the pack is written, so that
+  /// the objects stored meanwhile are written along with it.
+  static constexpr fml::TimeDelta kWriteDelay = fml::TimeDelta::FromSeconds(3);
+
+  PersistentCachePack(std::shared_ptr<fml::UniqueFD> directory, bool read_only);
+
+  /// Writes the objects not written yet.
+  ~PersistentCachePack();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies an object of the pack.
+  ///
+  /// @return     The object, or nullptr if the pack doesn't have it.
+  ///
+  std::unique_ptr<fml::Mapping> Load(const std::string& name) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Calls the visitor with each object of the pack. The objects
+  ///             are only valid during the call.
+  ///
+  void Visit(const std::function<void(const std::string& name,
+                                      const fml::Mapping& object)>& visitor)
+      const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds or replaces an object of the pack, and schedules a
+  ///             write of the pack on the worker if there isn't one yet.
+  ///             Without a worker, the pack is written on this thread.
+  ///
+  void Store(const std::string& name,
+             std::unique_ptr<fml::Mapping> object,
+             const fml::RefPtr<fml::TaskRunner>& worker);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the objects stored since the last write, together
+  ///             with the objects already in the file.
+  ///
+  /// @return     Whether the pack is written. It is kept in memory to be
+  ///             written again later if not.
+  ///
+  bool Write();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all of the objects of the pack, such as before its
+  ///             directory is purged. This doesn't remove the file.
+  ///
+  void Clear();
+
+ private:
+  struct Entry {
+    size_t offset;
+    size_t size;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const bool read_only_;
+  mutable std::mutex mutex_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  // The objects of |mapping_|, by name.
+  std::unordered_map<std::string, Entry> entries_;
+  // The objects stored since the last write. They take precedence over the
+  // objects of |mapping_| of the same name.
+  std::map<std::string, std::shared_ptr<fml::Mapping>> pending_;
+  bool write_scheduled_ = false;
+
+  // Maps the file of the pack and indexes its objects. Objects after the
+  // first one that is corrupt are ignored.
+  void MapFile();
+
+  bool WriteLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCachePack);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
@@ -37,7 +37,18 @@ class FrameTiming {
       kVsyncStart,  kBuildStart,   kBuildFinish,
       kRasterStart, kRasterFinish, kRasterFinishWallTime};
 
-  static constexpr int kStatisticsCount = kCount + 5;
+  static constexpr int kStatisticsCount = kCount + 6;
+
+  // The steps of rasterizing a frame, between |kRasterStart| and
+  // |kRasterFinish|. Their durations are only reported to the embedder and
+  // the service protocol, not to the framework.
+  enum RasterPhase {
+    kDiff,
+    kPreroll,
+    kPaint,
+    kSubmit,
+    kRasterPhaseCount
+  };
 
   fml::TimePoint Get(Phase phase) const { return data_[phase]; }
   fml::TimePoint Set(Phase phase, fml::TimePoint value) {
@@ -59,6 +70,18 @@ class FrameTiming {
     picture_cache_count_ = picture_cache_count;
     picture_cache_bytes_ = picture_cache_bytes;
   }
+  // The number of frames that were built before this one but were replaced
+  // by it before they could be rasterized.
+  uint64_t GetDiscardedFrameCount() const { return discarded_frame_count_; }
+  void SetDiscardedFrameCount(size_t discarded_frame_count) {
+    discarded_frame_count_ = discarded_frame_count;
+  }
+  fml::TimeDelta GetRasterPhaseDuration(RasterPhase phase) const {
+    return raster_phase_durations_[phase];
+  }
+  void SetRasterPhaseDuration(RasterPhase phase, fml::TimeDelta duration) {
+    raster_phase_durations_[phase] = duration;
+  }
 
  private:
   fml::TimePoint data_[kCount];
@@ -67,6 +90,8 @@ class FrameTiming {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  size_t discarded_frame_count_ = 0;
+  fml::TimeDelta raster_phase_durations_[kRasterPhaseCount];
 };
 
 using TaskObserverAdd =
@@ -145,8 +170,14 @@ struct Settings {
   std::optional<std::vector<std::string>> trace_skia_allowlist;
   bool trace_startup = false;
   bool trace_systrace = false;
+  // Whether the most recent trace events of each thread are kept in ring
+  // buffers that can be dumped to diagnose jank after it happened.
+  bool trace_to_ring_buffer = false;
   bool enable_timeline_event_handler = true;
   bool dump_skp_on_shader_compilation = false;
+  // If not empty, the directory that each rasterized frame is written to as
+  // an SKP, named by its number, to be replayed by frame_replay_benchmarks.
+  std::string frame_capture_path;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
   bool endless_trace_buffer = false;
@@ -212,6 +243,24 @@ struct Settings {
   // not supported on the platform.
   bool enable_impeller = false;
 
+  // The present mode of the swapchain used by the Impeller Vulkan backend.
+  // One of "fifo", "fifo_relaxed", or "mailbox". Unsupported modes fall back
+  // to "fifo".
+  std::string impeller_vulkan_present_mode = "fifo";
+
+  // The number of swapchain images requested by the Impeller Vulkan backend,
+  // or 0 to use one more than the minimum the surface requires.
+  uint32_t impeller_vulkan_swapchain_image_count = 0;
+
+  // Whether the Impeller Vulkan backend paces presents to the refresh cycle
+  // of the display, on devices that support VK_GOOGLE_display_timing.
+  bool impeller_vulkan_pace_presents = false;
+
+  // Whether Impeller reorders the entities of a pass that don't overlap to
+  // group the ones drawn with the same pipeline and texture, see
+  // |impeller::ContentContext::SetEntityBatchingEnabled|.
+  bool impeller_enable_entity_batching = false;
+
   // Data set by platform-specific embedders for use in font initialization.
   uint32_t font_initialization_data = 0;
 
@@ -310,6 +359,121 @@ struct Settings {
   // Max bytes threshold of resource cache, or 0 for unlimited.
   size_t resource_cache_max_bytes_threshold = 0;
 
+  // Render the raster cache images of DisplayLists on the IO thread instead
+  // of in the frame that decides to cache them. The DisplayLists are drawn
+  // directly until their images are available. DisplayLists that draw images
+  // are still cached in the frame, since their images may be textures of the
+  // raster thread's context.
+  bool enable_async_raster_cache_generation = false;
+
+  // Pack the small raster cache images of the Skia backend into shared
+  // texture pages.
+  bool enable_raster_cache_atlasing = false;
+
+  // Preroll large independent layer subtrees on the concurrent worker
+  // threads of the VM instead of only on the raster thread.
+  bool enable_concurrent_preroll = false;
+
+  // Skip the preroll of layer subtrees that the framework retained from the
+  // previous frame when nothing that affects their preroll has changed.
+  bool enable_retained_layer_preroll = false;
+
+  // Keep the raster cache images of DisplayLists in the caches directory so
+  // that they can be reused instead of rendered on the next launch, using
+  // at most |raster_cache_disk_store_max_bytes| of disk.
+  bool enable_raster_cache_disk_store = false;
+  size_t raster_cache_disk_store_max_bytes = 64 * 1024 * 1024;
+
+  // Outline the areas of each frame that are repainted because of partial
+  // repaint, colored by the reason they were damaged, along with the
+  // percentage of the frame that is damaged. The same statistics are always
+  // recorded to the timeline.
+  bool visualize_frame_damage = false;
+
+  // Render expensive effects, such as large blurs, at a reduced quality and
+  // draw raster cache images rendered for a different scale while the
+  // previous frames took longer than the frame budget to rasterize, until
+  // there is enough headroom to restore the full quality.
+  bool enable_adaptive_raster_quality = false;
+
+  // Keep only one frame in flight, and begin building each frame as late
+  // after vsync as the recent build and raster times allow, while frames
+  // are cheap enough to be built and rasterized within one vsync interval.
+  // This removes a frame of latency, see |FramePacer|.
+  bool enable_adaptive_frame_pacing = false;
+
+  // When the raster thread falls behind, replace the frames that are still
+  // waiting to be rasterized with the latest frame instead of rasterizing
+  // every frame in order. The replaced frames are counted by the
+  // |FrameTiming| of the frame that replaced them.
+  bool rasterize_latest_frame_only = false;
+
+  // Dispatch pointer events once per frame, coalescing the hover and move
+  // events of each pointer and predicting its position, see
+  // |ResamplingPointerDataDispatcher|.
+  bool enable_pointer_resampling = false;
+
+  // Don't rasterize or present layer trees that are diffed to render the
+  // same pixels as the last layer tree, such as the frames of an animation
+  // that is hidden. The frames are reported as rasterized.
+  bool skip_unchanged_frames = false;
+
+  // On devices with cores of different speeds, pin the UI and raster threads
+  // to the fastest cores, and keep the IO and worker threads off of them.
+  bool pin_threads_to_cpu_cores = false;
+
+  // Report the build and raster durations of each frame to the performance
+  // hint API of the platform, where there is one, so that the clocks of the
+  // CPU are raised before an expensive frame misses its deadline.
+  bool enable_performance_hints = false;
+
+  // Complete Picture.toImage and Scene.toImage with an image that stays on
+  // the GPU once its commands are recorded, instead of waiting for the GPU
+  // and copying the pixels back. The commands are submitted together with
+  // the next frame, or when the pixels are read.
+  bool enable_pipelined_snapshots = false;
+
+  // Hand out the same image for codecs instantiated from the same bytes at
+  // the same target size, even from different buffers, keeping at most this
+  // many bytes of recently decoded images and their bytes alive, see
+  // |DecodedImageCache|. 0 disables the cache.
+  size_t decoded_image_cache_max_bytes = 0;
+
+  // Decode this many frames of animated images on the worker threads ahead
+  // of the frames the framework asks for, see |MultiFrameCodec|. 0 decodes
+  // each frame when it's asked for.
+  size_t animated_image_decode_ahead_frames = 0;
+
+  // The most bytes of frames each animated image keeps decoded ahead. Short
+  // animations whose frames all fit keep every frame, and aren't decoded
+  // again when they loop.
+  size_t animated_image_frame_cache_max_bytes = 8 * 1024 * 1024;
+
+  // Decode full sized images with the decoders of the platform into memory
+  // that the GPU samples from directly, instead of decoding them on the CPU
+  // and uploading the pixels. Currently only used for JPEGs on Android API
+  // 30+ with the Skia OpenGL backend. Images the platform can't decode this
+  // way are decoded as usual.
+  bool enable_hardware_image_decoding = false;
+
+  // Render the Flutter UI above platform views into surface controls that
+  // the compositor can place on hardware planes of their own, instead of into
+  // overlay surfaces of the view hierarchy. Currently only used on Android
+  // API 34+ with the Skia OpenGL backend, and only in frames where the
+  // overlays don't overlap platform views above their own.
+  bool enable_surface_control_overlays = false;
+
+  // Prefetch the assets the application loaded shortly after its previous
+  // launch on a worker thread when the engine runs, and record the assets
+  // loaded for the next launch. The list is kept in the persistent cache
+  // directory.
+  bool enable_asset_prefetch = false;
+
+  // How long after the engine runs the assets loaded are recorded for when
+  // |enable_asset_prefetch| is set.
+  std::chrono::milliseconds asset_prefetch_recording_duration =
+      std::chrono::seconds(5);
+
   /// The minimum number of samples to require in multipsampled anti-aliasing.
   ///
   /// Setting this value to 0 or 1 disables MSAA.
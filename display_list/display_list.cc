@@ -2,11 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_canvas_dispatcher.h"
+#include "flutter/display_list/display_list_flags.h"
 #include "flutter/display_list/display_list_ops.h"
 #include "flutter/fml/trace_event.h"
 
@@ -57,6 +61,58 @@ uint32_t DisplayList::next_unique_id() {
   return id;
 }
 
+// Compares a single pair of ops for the purposes of |DiffOps| and of
+// |AttributeDeferrer|.
+static bool OpsAreEqual(const DLOp* opA, const DLOp* opB) {
+  if (opA->type != opB->type || opA->size != opB->size) {
+    return false;
+  }
+  DisplayListCompare result;
+  switch (opA->type) {
+#define DL_OP_EQUALS(name)                              \
+  case DisplayListOpType::k##name:                      \
+    result = static_cast<const name##Op*>(opA)->equals( \
+        static_cast<const name##Op*>(opB));             \
+    break;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_EQUALS)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_EQUALS(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_EQUALS
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+  if (result == DisplayListCompare::kUseBulkCompare) {
+    return memcmp(opA, opB, opA->size) == 0;
+  }
+  return result == DisplayListCompare::kEqual;
+}
+
+// Whether the op only renders within its own bounds and does not modify
+// the state (attributes, transform, clip or layers) used by later ops.
+static bool IsRenderingOp(const DLOp* op) {
+  switch (op->type) {
+#define DL_OP_IS_RENDERING(name)   \
+  case DisplayListOpType::k##name: \
+    return std::is_base_of_v<DrawOpBase, name##Op>;
+
+    FOR_EACH_DISPLAY_LIST_OP(DL_OP_IS_RENDERING)
+#ifdef IMPELLER_ENABLE_3D
+    DL_OP_IS_RENDERING(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_IS_RENDERING
+
+    default:
+      FML_DCHECK(false);
+      return false;
+  }
+}
+
 class Culler {
  public:
   virtual ~Culler() = default;
@@ -134,6 +190,321 @@ class VectorCuller final : public Culler {
   std::vector<int>::const_iterator end_;
 };
 
+// Collects runs of consecutive DrawRect or DrawCircle ops for dispatchers
+// that accept batched draws. Consecutive rendering ops of the same type
+// necessarily share the same attributes since any change to the attributes
+// would have been recorded as an op in between them. The storage for the
+// gathered primitives is reused for every run within a single dispatch.
+class DrawRunBatcher {
+ public:
+  static bool IsBatchable(DisplayListOpType type) {
+    return type == DisplayListOpType::kDrawRect ||
+           type == DisplayListOpType::kDrawCircle;
+  }
+
+  // Dispatches the run that starts with |op|, whose storage ends at |ptr|,
+  // and returns the storage location of the first op following the run.
+  uint8_t* DispatchRun(DispatchContext& context,
+                       Culler& culler,
+                       const DLOp* op,
+                       uint8_t* ptr,
+                       uint8_t* end) {
+    const DisplayListOpType type = op->type;
+    rects_.clear();
+    centers_.clear();
+    radii_.clear();
+    while (true) {
+      Add(context, op);
+      culler.update(context);
+      if (ptr >= end) {
+        break;
+      }
+      auto next = reinterpret_cast<const DLOp*>(ptr);
+      if (next->type != type) {
+        break;
+      }
+      op = next;
+      ptr += op->size;
+      FML_DCHECK(ptr <= end);
+    }
+    if (type == DisplayListOpType::kDrawRect) {
+      if (rects_.size() == 1) {
+        context.dispatcher.drawRect(rects_[0]);
+      } else if (!rects_.empty()) {
+        context.dispatcher.drawRects(rects_.data(), rects_.size());
+      }
+    } else {
+      if (centers_.size() == 1) {
+        context.dispatcher.drawCircle(centers_[0], radii_[0]);
+      } else if (!centers_.empty()) {
+        context.dispatcher.drawCircles(centers_.data(), radii_.data(),
+                                       centers_.size());
+      }
+    }
+    return ptr;
+  }
+
+ private:
+  void Add(const DispatchContext& context, const DLOp* op) {
+    if (op->type == DisplayListOpType::kDrawRect) {
+      auto rect_op = static_cast<const DrawRectOp*>(op);
+      if (rect_op->op_needed(context)) {
+        rects_.push_back(rect_op->rect);
+      }
+    } else {
+      auto circle_op = static_cast<const DrawCircleOp*>(op);
+      if (circle_op->op_needed(context)) {
+        centers_.push_back(circle_op->center);
+        radii_.push_back(circle_op->radius);
+      }
+    }
+  }
+
+  std::vector<SkRect> rects_;
+  std::vector<SkPoint> centers_;
+  std::vector<SkScalar> radii_;
+};
+
+// Holds back the attribute ops of a DisplayList for dispatchers that want
+// deferred attributes. The op that last set each attribute is remembered
+// along with the op that was last delivered for it and right before an op
+// that renders with attributes is dispatched, the attributes that it honors
+// according to its DisplayListAttributeFlags and that have changed since
+// they were last delivered are flushed to the dispatcher.
+class AttributeDeferrer {
+ public:
+  // Returns true if |op| is an attribute op, in which case it is deferred.
+  bool Defer(const DLOp* op) {
+    int attribute = AttributeOf(op->type);
+    if (attribute < 0) {
+      return false;
+    }
+    pending_[attribute] = op;
+    dirty_ |= 1 << attribute;
+    return true;
+  }
+
+  bool has_pending() const { return dirty_ != 0; }
+
+  // Delivers the pending attributes honored by |op|, which is about to be
+  // dispatched.
+  void Flush(DispatchContext& context, const DLOp* op) {
+    uint32_t needed = dirty_ & AttributesUsedBy(op);
+    for (int attribute = 0; needed != 0; attribute++, needed >>= 1) {
+      if ((needed & 1) == 0) {
+        continue;
+      }
+      const DLOp* pending = pending_[attribute];
+      dirty_ &= ~(1 << attribute);
+      if (delivered_[attribute] != nullptr &&
+          OpsAreEqual(pending, delivered_[attribute])) {
+        continue;
+      }
+      delivered_[attribute] = pending;
+      DispatchAttribute(context, pending);
+    }
+  }
+
+ private:
+  enum Attribute {
+    kAntiAlias,
+    kDither,
+    kInvertColors,
+    kStrokeCap,
+    kStrokeJoin,
+    kStyle,
+    kStrokeWidth,
+    kStrokeMiter,
+    kColor,
+    kBlendMode,
+    kPathEffect,
+    kColorFilter,
+    kColorSource,
+    kImageFilter,
+    kMaskFilter,
+    kAttributeCount,
+  };
+
+  static constexpr uint32_t kStrokeAttributes =
+      (1 << kStrokeCap) | (1 << kStrokeJoin) | (1 << kStrokeWidth) |
+      (1 << kStrokeMiter);
+
+  static int AttributeOf(DisplayListOpType type) {
+    switch (type) {
+      case DisplayListOpType::kSetAntiAlias:
+        return kAntiAlias;
+      case DisplayListOpType::kSetDither:
+        return kDither;
+      case DisplayListOpType::kSetInvertColors:
+        return kInvertColors;
+      case DisplayListOpType::kSetStrokeCap:
+        return kStrokeCap;
+      case DisplayListOpType::kSetStrokeJoin:
+        return kStrokeJoin;
+      case DisplayListOpType::kSetStyle:
+        return kStyle;
+      case DisplayListOpType::kSetStrokeWidth:
+        return kStrokeWidth;
+      case DisplayListOpType::kSetStrokeMiter:
+        return kStrokeMiter;
+      case DisplayListOpType::kSetColor:
+        return kColor;
+      case DisplayListOpType::kSetBlendMode:
+        return kBlendMode;
+      case DisplayListOpType::kSetPodPathEffect:
+      case DisplayListOpType::kClearPathEffect:
+        return kPathEffect;
+      case DisplayListOpType::kClearColorFilter:
+      case DisplayListOpType::kSetPodColorFilter:
+        return kColorFilter;
+      case DisplayListOpType::kClearColorSource:
+      case DisplayListOpType::kSetPodColorSource:
+      case DisplayListOpType::kSetImageColorSource:
+      case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+      case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+        return kColorSource;
+      case DisplayListOpType::kClearImageFilter:
+      case DisplayListOpType::kSetPodImageFilter:
+      case DisplayListOpType::kSetSharedImageFilter:
+        return kImageFilter;
+      case DisplayListOpType::kClearMaskFilter:
+      case DisplayListOpType::kSetPodMaskFilter:
+        return kMaskFilter;
+      default:
+        return -1;
+    }
+  }
+
+  static const DisplayListAttributeFlags* FlagsOf(const DLOp* op) {
+    switch (op->type) {
+      case DisplayListOpType::kSaveLayer:
+      case DisplayListOpType::kSaveLayerBounds:
+      case DisplayListOpType::kSaveLayerBackdrop:
+      case DisplayListOpType::kSaveLayerBackdropBounds:
+        return static_cast<const SaveOpBase*>(op)
+                       ->options.renders_with_attributes()
+                   ? &DisplayListOpFlags::kSaveLayerWithPaintFlags
+                   : nullptr;
+      case DisplayListOpType::kDrawPaint:
+        return &DisplayListOpFlags::kDrawPaintFlags;
+      case DisplayListOpType::kDrawLine:
+        return &DisplayListOpFlags::kDrawLineFlags;
+      case DisplayListOpType::kDrawRect:
+        return &DisplayListOpFlags::kDrawRectFlags;
+      case DisplayListOpType::kDrawOval:
+        return &DisplayListOpFlags::kDrawOvalFlags;
+      case DisplayListOpType::kDrawCircle:
+        return &DisplayListOpFlags::kDrawCircleFlags;
+      case DisplayListOpType::kDrawRRect:
+        return &DisplayListOpFlags::kDrawRRectFlags;
+      case DisplayListOpType::kDrawDRRect:
+        return &DisplayListOpFlags::kDrawDRRectFlags;
+      case DisplayListOpType::kDrawArc:
+        return static_cast<const DrawArcOp*>(op)->center
+                   ? &DisplayListOpFlags::kDrawArcWithCenterFlags
+                   : &DisplayListOpFlags::kDrawArcNoCenterFlags;
+      case DisplayListOpType::kDrawPath:
+        return &DisplayListOpFlags::kDrawPathFlags;
+      case DisplayListOpType::kDrawPoints:
+        return &DisplayListOpFlags::kDrawPointsAsPointsFlags;
+      case DisplayListOpType::kDrawLines:
+        return &DisplayListOpFlags::kDrawPointsAsLinesFlags;
+      case DisplayListOpType::kDrawPolygon:
+        return &DisplayListOpFlags::kDrawPointsAsPolygonFlags;
+      case DisplayListOpType::kDrawVertices:
+        return &DisplayListOpFlags::kDrawVerticesFlags;
+      case DisplayListOpType::kDrawImageWithAttr:
+        return &DisplayListOpFlags::kDrawImageWithPaintFlags;
+      case DisplayListOpType::kDrawImageRect:
+        return static_cast<const DrawImageRectOp*>(op)->render_with_attributes
+                   ? &DisplayListOpFlags::kDrawImageRectWithPaintFlags
+                   : nullptr;
+      case DisplayListOpType::kDrawImageNineWithAttr:
+        return &DisplayListOpFlags::kDrawImageNineWithPaintFlags;
+      case DisplayListOpType::kDrawAtlas:
+      case DisplayListOpType::kDrawAtlasCulled:
+        return static_cast<const DrawAtlasBaseOp*>(op)->render_with_attributes
+                   ? &DisplayListOpFlags::kDrawAtlasWithPaintFlags
+                   : nullptr;
+      case DisplayListOpType::kDrawTextBlob:
+        return &DisplayListOpFlags::kDrawTextBlobFlags;
+      default:
+        // All other ops either do not render or ignore the attributes.
+        return nullptr;
+    }
+  }
+
+  static uint32_t AttributesUsedBy(const DLOp* op) {
+    const DisplayListAttributeFlags* flags = FlagsOf(op);
+    if (flags == nullptr || flags->ignores_paint()) {
+      return 0;
+    }
+    uint32_t used = 0;
+    if (flags->applies_anti_alias()) {
+      used |= 1 << kAntiAlias;
+    }
+    if (flags->applies_dither()) {
+      used |= 1 << kDither;
+    }
+    if (flags->applies_alpha_or_color()) {
+      used |= 1 << kColor;
+    }
+    if (flags->applies_blend()) {
+      used |= 1 << kBlendMode;
+    }
+    if (flags->applies_shader()) {
+      used |= 1 << kColorSource;
+    }
+    if (flags->applies_color_filter()) {
+      used |= (1 << kColorFilter) | (1 << kInvertColors);
+    }
+    if (flags->applies_image_filter()) {
+      used |= 1 << kImageFilter;
+    }
+    if (flags->applies_mask_filter()) {
+      used |= 1 << kMaskFilter;
+    }
+    if (flags->applies_path_effect()) {
+      used |= 1 << kPathEffect;
+    }
+    if (flags->applies_style()) {
+      used |= 1 << kStyle;
+    }
+    if (flags->is_stroked()) {
+      used |= kStrokeAttributes;
+    }
+    return used;
+  }
+
+  static void DispatchAttribute(DispatchContext& context, const DLOp* op) {
+    switch (op->type) {
+#define DL_OP_DISPATCH(name)                             \
+  case DisplayListOpType::k##name:                       \
+    static_cast<const name##Op*>(op)->dispatch(context); \
+    break;
+
+      FOR_EACH_DISPLAY_LIST_OP(DL_OP_DISPATCH)
+#ifdef IMPELLER_ENABLE_3D
+      DL_OP_DISPATCH(SetSceneColorSource)
+#endif  // IMPELLER_ENABLE_3D
+
+#undef DL_OP_DISPATCH
+
+      default:
+        FML_DCHECK(false);
+        break;
+    }
+  }
+
+  static_assert(kAttributeCount <= 32);
+
+  const DLOp* pending_[kAttributeCount] = {};
+  const DLOp* delivered_[kAttributeCount] = {};
+  uint32_t dirty_ = 0;
+};
+
 void DisplayList::Dispatch(Dispatcher& ctx) const {
   uint8_t* ptr = storage_.get();
   Dispatch(ctx, ptr, ptr + byte_count_, NopCuller::instance);
@@ -173,10 +544,36 @@ void DisplayList::Dispatch(Dispatcher& dispatcher,
   if (!culler.init(context)) {
     return;
   }
+  std::unique_ptr<DrawRunBatcher> batcher;
+  if (dispatcher.wantsBatchedDraws()) {
+    batcher = std::make_unique<DrawRunBatcher>();
+  }
+  std::unique_ptr<AttributeDeferrer> deferrer;
+  if (dispatcher.wantsDeferredAttributes()) {
+    deferrer = std::make_unique<AttributeDeferrer>();
+  }
   while (ptr < end) {
     auto op = reinterpret_cast<const DLOp*>(ptr);
     ptr += op->size;
     FML_DCHECK(ptr <= end);
+    if (deferrer) {
+      if (deferrer->Defer(op)) {
+        culler.update(context);
+        continue;
+      }
+      // Culled rendering ops do not need their attributes, but the ops of
+      // a batched run are culled individually after this point.
+      if (deferrer->has_pending() &&
+          (context.cur_index >= context.next_render_index ||
+           !IsRenderingOp(op) ||
+           (batcher && DrawRunBatcher::IsBatchable(op->type)))) {
+        deferrer->Flush(context, op);
+      }
+    }
+    if (batcher && DrawRunBatcher::IsBatchable(op->type)) {
+      ptr = batcher->DispatchRun(context, culler, op, ptr, end);
+      continue;
+    }
     switch (op->type) {
 #define DL_OP_DISPATCH(name)                             \
   case DisplayListOpType::k##name:                       \
@@ -294,6 +691,155 @@ static bool CompareOps(uint8_t* ptrA,
   return true;
 }
 
+static void CollectOps(uint8_t* ptr,
+                       uint8_t* end,
+                       std::vector<const DLOp*>& ops) {
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    ops.push_back(op);
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+  }
+}
+
+static bool HasBackdropOps(const std::vector<const DLOp*>& ops, size_t start) {
+  for (size_t i = start; i < ops.size(); i++) {
+    if (ops[i]->type == DisplayListOpType::kSaveLayerBackdrop ||
+        ops[i]->type == DisplayListOpType::kSaveLayerBackdropBounds) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void CollectDamage(const DlRTree& rtree,
+                          size_t start,
+                          size_t end,
+                          std::vector<SkRect>* damage) {
+  // The ids of the RTree leaves are the indices of the ops that produced
+  // them.
+  for (int i = 0; i < rtree.leaf_count(); i++) {
+    int id = rtree.id(i);
+    if (id >= 0 && static_cast<size_t>(id) >= start &&
+        static_cast<size_t>(id) < end) {
+      damage->push_back(rtree.bounds(i));
+    }
+  }
+}
+
+bool DisplayList::DiffOps(const DisplayList& old_list,
+                          std::vector<SkRect>* damage) const {
+  if (!has_rtree() || !old_list.has_rtree()) {
+    return false;
+  }
+  if (this == &old_list || storage_.get() == old_list.storage_.get()) {
+    return true;
+  }
+
+  std::vector<const DLOp*> ops;
+  std::vector<const DLOp*> old_ops;
+  ops.reserve(op_count_);
+  old_ops.reserve(old_list.op_count_);
+  CollectOps(storage_.get(), storage_.get() + byte_count_, ops);
+  CollectOps(old_list.storage_.get(),
+             old_list.storage_.get() + old_list.byte_count_, old_ops);
+
+  const size_t common = std::min(ops.size(), old_ops.size());
+  size_t prefix = 0;
+  while (prefix < common && OpsAreEqual(ops[prefix], old_ops[prefix])) {
+    prefix++;
+  }
+  if (prefix == ops.size() && prefix == old_ops.size()) {
+    return true;
+  }
+
+  // A backdrop filter reads back content that may have been damaged
+  // anywhere below it, so its output cannot be bounded by its own ops.
+  if (HasBackdropOps(ops, prefix) || HasBackdropOps(old_ops, prefix)) {
+    return false;
+  }
+
+  size_t suffix = 0;
+  while (suffix < common - prefix &&
+         OpsAreEqual(ops[ops.size() - 1 - suffix],
+                     old_ops[old_ops.size() - 1 - suffix])) {
+    suffix++;
+  }
+
+  // The suffix can only be trusted to render the same way if the ops that
+  // were changed did not modify any state that the suffix depends on.
+  for (size_t i = prefix; suffix > 0 && i < ops.size() - suffix; i++) {
+    if (!IsRenderingOp(ops[i])) {
+      suffix = 0;
+    }
+  }
+  for (size_t i = prefix; suffix > 0 && i < old_ops.size() - suffix; i++) {
+    if (!IsRenderingOp(old_ops[i])) {
+      suffix = 0;
+    }
+  }
+
+  CollectDamage(*rtree_, prefix, ops.size() - suffix, damage);
+  CollectDamage(*old_list.rtree_, prefix, old_ops.size() - suffix, damage);
+  return true;
+}
+
+bool DisplayList::ReadsBackdrop() const {
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    switch (op->type) {
+      case DisplayListOpType::kSaveLayerBackdrop:
+      case DisplayListOpType::kSaveLayerBackdropBounds:
+        return true;
+      case DisplayListOpType::kDrawDisplayList:
+        if (static_cast<const DrawDisplayListOp*>(op)
+                ->display_list->ReadsBackdrop()) {
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+  }
+  return false;
+}
+
+bool DisplayList::DrawsImages() const {
+  uint8_t* ptr = storage_.get();
+  uint8_t* end = ptr + byte_count_;
+  while (ptr < end) {
+    auto op = reinterpret_cast<const DLOp*>(ptr);
+    switch (op->type) {
+      case DisplayListOpType::kDrawImage:
+      case DisplayListOpType::kDrawImageWithAttr:
+      case DisplayListOpType::kDrawImageRect:
+      case DisplayListOpType::kDrawImageNine:
+      case DisplayListOpType::kDrawImageNineWithAttr:
+      case DisplayListOpType::kDrawAtlas:
+      case DisplayListOpType::kDrawAtlasCulled:
+      case DisplayListOpType::kSetImageColorSource:
+      // The samplers of a runtime effect may be images.
+      case DisplayListOpType::kSetRuntimeEffectColorSource:
+        return true;
+      case DisplayListOpType::kDrawDisplayList:
+        if (static_cast<const DrawDisplayListOp*>(op)
+                ->display_list->DrawsImages()) {
+          return true;
+        }
+        break;
+      default:
+        break;
+    }
+    ptr += op->size;
+    FML_DCHECK(ptr <= end);
+  }
+  return false;
+}
+
 void DisplayList::RenderTo(DisplayListBuilder* builder) const {
   if (!builder) {
     return;
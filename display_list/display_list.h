@@ -5,13 +5,17 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <cstring>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/display_list/display_list_rtree.h"
 #include "flutter/display_list/display_list_sampling_options.h"
+#include "flutter/display_list/display_list_storage_pool.h"
 #include "flutter/display_list/types.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -208,24 +212,55 @@ class SaveLayerOptions {
   };
 };
 
-// Manages a buffer allocated with malloc.
+// Manages a buffer obtained from the DisplayListStoragePool. The buffer
+// is returned to the pool when the storage is destroyed so that it can be
+// reused by the next DisplayListBuilder.
 class DisplayListStorage {
  public:
   DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
+  DisplayListStorage(DisplayListStorage&& other)
+      : ptr_(other.ptr_), capacity_(other.capacity_) {
+    other.ptr_ = nullptr;
+    other.capacity_ = 0;
+  }
+
+  ~DisplayListStorage() {
+    DisplayListStoragePool::Instance().Release(ptr_, capacity_);
+  }
 
-  uint8_t* get() const { return ptr_.get(); }
+  uint8_t* get() const { return ptr_; }
+  size_t capacity() const { return capacity_; }
 
+  // Ensures that the buffer holds at least |count| bytes while preserving
+  // its existing contents. The buffer is never shrunk, other than being
+  // released when |count| is 0, to avoid copying the ops of a finished
+  // DisplayList into a tighter allocation.
   void realloc(size_t count) {
-    ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
-    FML_CHECK(ptr_);
+    auto& pool = DisplayListStoragePool::Instance();
+    if (count == 0) {
+      pool.Release(ptr_, capacity_);
+      ptr_ = nullptr;
+      capacity_ = 0;
+      return;
+    }
+    if (count <= capacity_) {
+      return;
+    }
+    size_t capacity;
+    uint8_t* ptr = pool.Acquire(count, &capacity);
+    if (ptr_) {
+      memcpy(ptr, ptr_, capacity_);
+      pool.Release(ptr_, capacity_);
+    }
+    ptr_ = ptr;
+    capacity_ = capacity;
   }
 
  private:
-  struct FreeDeleter {
-    void operator()(uint8_t* p) { std::free(p); }
-  };
-  std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  uint8_t* ptr_ = nullptr;
+  size_t capacity_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
 };
 
 class Culler;
@@ -271,6 +306,31 @@ class DisplayList : public SkRefCnt {
     return Equals(other.get());
   }
 
+  /// Computes the areas in which this DisplayList may render differently
+  /// from |old_list| and appends them to |damage|.
+  ///
+  /// The ops of both lists are compared to find the longest common prefix
+  /// and suffix and the RTree bounds of the ops that are left in between,
+  /// from either list, are reported as damaged. Ops following a changed
+  /// transform, clip or attribute are all considered damaged.
+  ///
+  /// Returns false if the damage could not be narrowed down, either because
+  /// one of the lists has no RTree or because one of them contains ops whose
+  /// output depends on content outside of their bounds (a backdrop filter),
+  /// in which case the entire bounds of both lists must be considered
+  /// damaged.
+  bool DiffOps(const DisplayList& old_list, std::vector<SkRect>* damage) const;
+
+  /// Returns true if an op of this DisplayList, or of a DisplayList that it
+  /// draws, reads back the content rendered below it (a backdrop filter),
+  /// so that it cannot be rendered in parts that don't see each other.
+  bool ReadsBackdrop() const;
+
+  /// Returns true if an op of this DisplayList, or of a DisplayList that it
+  /// draws, draws or shades with an image, which may only be usable by the
+  /// GPU context that created it.
+  bool DrawsImages() const;
+
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
 
   static void DisposeOps(uint8_t* ptr, uint8_t* end);
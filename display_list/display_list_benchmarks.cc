@@ -4,6 +4,9 @@
 
 #include "flutter/display_list/display_list_benchmarks.h"
 #include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_complexity_gl.h"
+#include "flutter/display_list/display_list_complexity_impeller.h"
+#include "flutter/display_list/display_list_complexity_metal.h"
 #include "flutter/display_list/display_list_flags.h"
 
 #include "third_party/skia/include/core/SkPoint.h"
@@ -54,6 +57,22 @@ void AnnotateAttributes(unsigned attributes,
   }
 }
 
+// Reports the scores that each of the complexity calculators assign to the
+// benchmarked DisplayList. A score of 100 is meant to represent roughly
+// 0.0005ms, so combined with the measured time these counters form the
+// calibration table for the calculators (see DlImpellerCostTable).
+void AnnotateComplexity(benchmark::State& state,
+                        const DisplayList* display_list) {
+  state.counters["GLComplexity"] =
+      DisplayListGLComplexityCalculator::GetInstance()->Compute(display_list);
+  state.counters["MetalComplexity"] =
+      DisplayListMetalComplexityCalculator::GetInstance()->Compute(
+          display_list);
+  state.counters["ImpellerComplexity"] =
+      DisplayListImpellerComplexityCalculator::GetInstance()->Compute(
+          display_list);
+}
+
 // Constants chosen to produce benchmark results in the region of 1-50ms
 constexpr size_t kLinesToDraw = 10000;
 constexpr size_t kRectsToDraw = 5000;
@@ -93,6 +112,7 @@ void BM_DrawLine(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -142,6 +162,7 @@ void BM_DrawRect(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -188,6 +209,7 @@ void BM_DrawOval(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -236,6 +258,7 @@ void BM_DrawCircle(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -314,6 +337,7 @@ void BM_DrawRRect(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -396,6 +420,7 @@ void BM_DrawDRRect(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -449,6 +474,7 @@ void BM_DrawArc(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -652,6 +678,7 @@ void BM_DrawPath(benchmark::State& state,
 
   builder.drawPath(path);
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -798,6 +825,7 @@ void BM_DrawVertices(benchmark::State& state,
   state.SetComplexityN(total_vertex_count);
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -903,6 +931,7 @@ void BM_DrawPoints(benchmark::State& state,
   builder.drawPoints(mode, points.size(), points.data());
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -981,6 +1010,7 @@ void BM_DrawImage(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1068,6 +1098,7 @@ void BM_DrawImageRect(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1156,6 +1187,7 @@ void BM_DrawImageNine(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1202,6 +1234,7 @@ void BM_DrawTextBlob(benchmark::State& state,
   }
 
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   for ([[maybe_unused]] auto _ : state) {
     display_list->RenderTo(canvas);
@@ -1266,6 +1299,7 @@ void BM_DrawShadow(benchmark::State& state,
   // ever used in conjunction with elevation.
   builder.drawShadow(path, SK_ColorBLUE, elevation, transparent_occluder, 1.0f);
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
@@ -1320,6 +1354,7 @@ void BM_SaveLayer(benchmark::State& state,
     }
   }
   auto display_list = builder.Build();
+  AnnotateComplexity(state, display_list.get());
 
   // We only want to time the actual rasterization.
   for ([[maybe_unused]] auto _ : state) {
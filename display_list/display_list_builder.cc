@@ -72,12 +72,111 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   storage_.realloc(bytes);
+  layer_stack_.back().resolve_last_op();
   bool compatible = layer_stack_.back().is_group_opacity_compatible();
+  // The bounds of the ops must not carry over if the builder is reused.
+  layer_stack_.back() = LayerInfo();
   return sk_sp<DisplayList>(new DisplayList(std::move(storage_), bytes, count,
                                             nested_bytes, nested_count,
                                             bounds(), compatible, rtree()));
 }
 
+// Ops which touch are treated as overlapping since anti-aliasing would
+// blend the shared edge pixels of both of them.
+static bool BoundsOverlap(const SkRect& a, const SkRect& b) {
+  return a.fLeft <= b.fRight && b.fLeft <= a.fRight &&  //
+         a.fTop <= b.fBottom && b.fTop <= a.fBottom;
+}
+
+void DisplayListBuilder::LayerInfo::add_compatible_op(int op_index) {
+  if (cannot_inherit_opacity_) {
+    return;
+  }
+  if (op_index != last_op_index_) {
+    resolve_last_op();
+    last_op_index_ = op_index;
+  }
+  last_op_is_compatible_ = true;
+  has_compatible_op_ = true;
+}
+
+void DisplayListBuilder::LayerInfo::add_op_bounds(int op_index,
+                                                  const SkRect& bounds) {
+  bounds_.join(bounds);
+  if (cannot_inherit_opacity_) {
+    return;
+  }
+  if (op_index != last_op_index_) {
+    resolve_last_op();
+    last_op_index_ = op_index;
+  }
+  last_op_bounds_.push_back(bounds);
+}
+
+void DisplayListBuilder::LayerInfo::resolve_last_op() {
+  if (last_op_is_compatible_ && !cannot_inherit_opacity_) {
+    // The bounds of a single op may overlap each other, such as the rects
+    // of a nested DisplayList, so they are only checked against the ops
+    // that came before.
+    for (const SkRect& bounds : last_op_bounds_) {
+      if (overlaps_compatible_ops(bounds)) {
+        mark_incompatible();
+        break;
+      }
+    }
+    if (compatible_op_bounds_.size() + last_op_bounds_.size() >
+        kMaxCompatibleOps) {
+      mark_incompatible();
+    }
+    if (!cannot_inherit_opacity_) {
+      for (const SkRect& bounds : last_op_bounds_) {
+        compatible_op_bounds_.push_back(bounds);
+        compatible_ops_union_.join(bounds);
+      }
+    }
+  }
+  last_op_index_ = -1;
+  last_op_is_compatible_ = false;
+  last_op_bounds_.clear();
+}
+
+void DisplayListBuilder::LayerInfo::add_compatible_ops(
+    const LayerInfo& nested) {
+  bounds_.join(nested.bounds_);
+  if (nested.cannot_inherit_opacity_) {
+    mark_incompatible();
+    return;
+  }
+  if (!nested.has_compatible_op_ || cannot_inherit_opacity_) {
+    return;
+  }
+  resolve_last_op();
+  has_compatible_op_ = true;
+  for (const SkRect& bounds : nested.compatible_op_bounds_) {
+    if (overlaps_compatible_ops(bounds) ||
+        compatible_op_bounds_.size() >= kMaxCompatibleOps) {
+      mark_incompatible();
+      return;
+    }
+    compatible_op_bounds_.push_back(bounds);
+    compatible_ops_union_.join(bounds);
+  }
+}
+
+bool DisplayListBuilder::LayerInfo::overlaps_compatible_ops(
+    const SkRect& bounds) const {
+  if (compatible_op_bounds_.empty() ||
+      !BoundsOverlap(compatible_ops_union_, bounds)) {
+    return false;
+  }
+  for (const SkRect& op_bounds : compatible_op_bounds_) {
+    if (BoundsOverlap(op_bounds, bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 DisplayListBuilder::DisplayListBuilder(const SkRect& cull_rect,
                                        bool prepare_rtree)
     : tracker_(cull_rect, SkMatrix::I()) {
@@ -397,7 +496,8 @@ void DisplayListBuilder::Restore() {
     }
     // Grab the current layer info before we push the restore
     // on the stack.
-    LayerInfo layer_info = layer_stack_.back();
+    LayerInfo layer_info = std::move(layer_stack_.back());
+    layer_info.resolve_last_op();
 
     tracker_.restore();
     layer_stack_.pop_back();
@@ -425,6 +525,15 @@ void DisplayListBuilder::Restore() {
       accumulator()->restore();
     }
 
+    if (layer_info.has_layer()) {
+      // All of the contents of the layer are rendered into the enclosing
+      // layer by its saveLayer op.
+      current_layer_->add_op_bounds(
+          layer_info.layer_op_index_,
+          is_unbounded || filter ? tracker_.device_cull_rect()
+                                 : layer_info.bounds());
+    }
+
     if (is_unbounded) {
       AccumulateUnbounded();
     }
@@ -451,11 +560,7 @@ void DisplayListBuilder::Restore() {
     } else {
       // For regular save() ops there was no protecting layer so we have to
       // accumulate the values into the enclosing layer.
-      if (layer_info.cannot_inherit_opacity()) {
-        current_layer_->mark_incompatible();
-      } else if (layer_info.has_compatible_op()) {
-        current_layer_->add_compatible_op();
-      }
+      current_layer_->add_compatible_ops(layer_info);
     }
   }
 }
@@ -502,6 +607,7 @@ void DisplayListBuilder::saveLayer(const SkRect* bounds,
   tracker_.save();
   accumulator()->save();
   current_layer_ = &layer_stack_.back();
+  current_layer_->layer_op_index_ = op_index_ - 1;
   if (options.renders_with_attributes()) {
     // |current_opacity_compatibility_| does not take an ImageFilter into
     // account because an individual primitive with an ImageFilter can apply
@@ -1098,12 +1204,13 @@ void DisplayListBuilder::DrawDisplayList(const sk_sp<DisplayList> display_list,
     case BoundsAccumulatorType::kRTree:
       auto rtree = display_list->rtree();
       if (rtree) {
-        std::list<SkRect> rects = rtree->searchAndConsolidateRects(bounds);
-        for (const SkRect& rect : rects) {
-          // TODO (https://github.com/flutter/flutter/issues/114919): Attributes
-          // are not necessarily `kDrawDisplayListFlags`.
-          AccumulateOpBounds(rect, kDrawDisplayListFlags);
-        }
+        std::vector<SkRect> rects;
+        rtree->searchAndConsolidateRects(bounds, &rects);
+        // TODO (https://github.com/flutter/flutter/issues/114919): Attributes
+        // are not necessarily `kDrawDisplayListFlags`.
+        static_assert(kDrawDisplayListFlags.ignores_paint(),
+                      "rects are accumulated without AdjustBoundsForPaint");
+        AccumulateBounds(rects);
       } else {
         AccumulateOpBounds(bounds, kDrawDisplayListFlags);
       }
@@ -1217,6 +1324,7 @@ bool DisplayListBuilder::AdjustBoundsForPaint(SkRect& bounds,
 
 void DisplayListBuilder::AccumulateUnbounded() {
   accumulator()->accumulate(tracker_.device_cull_rect(), op_index_ - 1);
+  current_layer_->add_op_bounds(op_index_ - 1, tracker_.device_cull_rect());
 }
 
 void DisplayListBuilder::AccumulateOpBounds(SkRect& bounds,
@@ -1231,6 +1339,17 @@ void DisplayListBuilder::AccumulateBounds(SkRect& bounds) {
   tracker_.mapRect(&bounds);
   if (bounds.intersect(tracker_.device_cull_rect())) {
     accumulator()->accumulate(bounds, op_index_ - 1);
+    current_layer_->add_op_bounds(op_index_ - 1, bounds);
+  }
+}
+void DisplayListBuilder::AccumulateBounds(std::vector<SkRect>& rects) {
+  tracker_.mapRects(rects.data(), rects.data(), rects.size());
+  const SkRect cull_rect = tracker_.device_cull_rect();
+  for (SkRect& rect : rects) {
+    if (rect.intersect(cull_rect)) {
+      accumulator()->accumulate(rect, op_index_ - 1);
+      current_layer_->add_op_bounds(op_index_ - 1, rect);
+    }
   }
 }
 
@@ -452,23 +452,35 @@ class DisplayListBuilder final : public virtual DlCanvas,
       return !cannot_inherit_opacity_;
     }
 
-    void mark_incompatible() { cannot_inherit_opacity_ = true; }
-
-    // For now this only allows a single compatible op to mark the
-    // layer as being compatible with group opacity. If we start
-    // computing bounds of ops in the Builder methods then we
-    // can upgrade this to checking for overlapping ops.
-    // See https://github.com/flutter/flutter/issues/93899
-    void add_compatible_op() {
-      if (!cannot_inherit_opacity_) {
-        if (has_compatible_op_) {
-          cannot_inherit_opacity_ = true;
-        } else {
-          has_compatible_op_ = true;
-        }
-      }
+    void mark_incompatible() {
+      cannot_inherit_opacity_ = true;
+      last_op_bounds_.clear();
+      compatible_op_bounds_.clear();
     }
 
+    // Records that the op at |op_index| can apply an inherited opacity.
+    // The layer remains compatible with group opacity as long as none of
+    // its compatible ops overlap, which is checked once the bounds of the
+    // op have been recorded with |add_op_bounds|, either before or after
+    // this call. See https://github.com/flutter/flutter/issues/93899
+    void add_compatible_op(int op_index);
+
+    // Records device space bounds that the op at |op_index| renders into.
+    void add_op_bounds(int op_index, const SkRect& bounds);
+
+    // Checks the bounds of the most recently recorded op against those of
+    // the previous compatible ops. Called before the compatibility of the
+    // layer is queried since the bounds of an op may arrive after its
+    // compatibility.
+    void resolve_last_op();
+
+    // Transfers the compatible ops of a nested layer that has no saveLayer
+    // of its own, and so renders its ops directly into this layer.
+    void add_compatible_ops(const LayerInfo& nested);
+
+    // The union of the bounds of all of the ops recorded in this layer.
+    const SkRect& bounds() const { return bounds_; }
+
     // The filter to apply to the layer bounds when it is restored
     std::shared_ptr<const DlImageFilter> filter() { return filter_; }
 
@@ -501,6 +513,12 @@ class DisplayListBuilder final : public virtual DlCanvas,
     bool is_unbounded() const { return is_unbounded_; }
 
    private:
+    // Beyond this many compatible ops the layer is considered incompatible
+    // rather than spending more time on checking them for overlaps.
+    static constexpr size_t kMaxCompatibleOps = 64;
+
+    bool overlaps_compatible_ops(const SkRect& bounds) const;
+
     size_t save_offset_;
     bool has_layer_;
     bool cannot_inherit_opacity_;
@@ -509,6 +527,22 @@ class DisplayListBuilder final : public virtual DlCanvas,
     bool is_unbounded_;
     bool has_deferred_save_op_ = false;
 
+    // The op index of the saveLayer call for this layer, which is the op
+    // that renders all of the contents of the layer into the enclosing
+    // layer.
+    int layer_op_index_ = -1;
+
+    // The most recently recorded op, whose bounds are not checked against
+    // |compatible_op_bounds_| until all of them are known.
+    int last_op_index_ = -1;
+    bool last_op_is_compatible_ = false;
+    std::vector<SkRect> last_op_bounds_;
+
+    // The bounds of the compatible ops seen so far, none of which overlap.
+    std::vector<SkRect> compatible_op_bounds_;
+    SkRect compatible_ops_union_ = SkRect::MakeEmpty();
+    SkRect bounds_ = SkRect::MakeEmpty();
+
     friend class DisplayListBuilder;
   };
 
@@ -543,7 +577,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // that has determined its compatibility as indicated by |compatible|.
   void UpdateLayerOpacityCompatibility(bool compatible) {
     if (compatible) {
-      current_layer_->add_compatible_op();
+      current_layer_->add_compatible_op(op_index_ - 1);
     } else {
       current_layer_->mark_incompatible();
     }
@@ -652,6 +686,11 @@ class DisplayListBuilder final : public virtual DlCanvas,
   // and clipping against the current clip.
   void AccumulateBounds(SkRect& bounds);
 
+  // Records each of the given bounds, transforming them all by the current
+  // matrix in a single batch and then clipping against the current clip.
+  // The rects are modified in place.
+  void AccumulateBounds(std::vector<SkRect>& rects);
+
   DlPaint current_;
 };
 
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/display_list_storage_pool.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
 
 namespace flutter {
@@ -51,11 +52,32 @@ bool NeedPrepareRTree(DisplayListBuilderBenchmarkType type) {
          type == DisplayListBuilderBenchmarkType::kBoundsAndRtree;
 }
 
+// Reports the number of op buffers that had to be allocated from the
+// system per iteration. Since the buffers of the DisplayLists built in
+// previous iterations are recycled, this is close to 0 in steady state.
+class StorageAllocationCounter {
+ public:
+  explicit StorageAllocationCounter(benchmark::State& state)
+      : state_(state),
+        start_(DisplayListStoragePool::Instance().allocation_count()) {}
+
+  ~StorageAllocationCounter() {
+    size_t count = DisplayListStoragePool::Instance().allocation_count();
+    state_.counters["StorageAllocations"] = benchmark::Counter(
+        count - start_, benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  const size_t start_;
+};
+
 }  // namespace
 
 static void BM_DisplayListBuilderDefault(benchmark::State& state,
                                          DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  StorageAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     InvokeAllRenderingOps(builder);
@@ -67,6 +89,7 @@ static void BM_DisplayListBuilderWithScaleAndTranslate(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  StorageAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     builder.scale(3.5, 3.5);
@@ -80,6 +103,7 @@ static void BM_DisplayListBuilderWithPerspective(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  StorageAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     builder.transformFullPerspective(0, 1, 0, 12, 1, 0, 0, 33, 3, 2, 5, 29, 0,
@@ -94,6 +118,7 @@ static void BM_DisplayListBuilderWithClipRect(
     DisplayListBuilderBenchmarkType type) {
   SkRect clip_bounds = SkRect::MakeLTRB(6.5, 7.3, 90.2, 85.7);
   bool prepare_rtree = NeedPrepareRTree(type);
+  StorageAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     builder.clipRect(clip_bounds, DlCanvas::ClipOp::kIntersect, true);
@@ -106,6 +131,7 @@ static void BM_DisplayListBuilderWithSaveLayer(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
   bool prepare_rtree = NeedPrepareRTree(type);
+  StorageAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     for (auto& group : allRenderingOps) {
@@ -127,6 +153,7 @@ static void BM_DisplayListBuilderWithSaveLayerAndImageFilter(
   layer_paint.setImageFilter(&testing::kTestBlurImageFilter1);
   SkRect layer_bounds = SkRect::MakeLTRB(6.5, 7.3, 35.2, 42.7);
   bool prepare_rtree = NeedPrepareRTree(type);
+  StorageAllocationCounter allocation_counter(state);
   while (state.KeepRunning()) {
     DisplayListBuilder builder(prepare_rtree);
     for (auto& group : allRenderingOps) {
@@ -3,8 +3,12 @@
 // found in the LICENSE file.
 
 #include "flutter/display_list/display_list_complexity.h"
+
+#include <mutex>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_complexity_gl.h"
+#include "flutter/display_list/display_list_complexity_impeller.h"
 #include "flutter/display_list/display_list_complexity_metal.h"
 
 namespace flutter {
@@ -14,9 +18,12 @@ DisplayListNaiveComplexityCalculator*
 
 DisplayListComplexityCalculator*
 DisplayListNaiveComplexityCalculator::GetInstance() {
-  if (instance_ == nullptr) {
+  // Like the other calculators, this may first be requested from several of
+  // the threads that preroll layer subtrees concurrently.
+  static std::once_flag once;
+  std::call_once(once, [] {
     instance_ = new DisplayListNaiveComplexityCalculator();
-  }
+  });
   return instance_;
 }
 
@@ -32,6 +39,11 @@ DisplayListComplexityCalculator* DisplayListComplexityCalculator::GetForBackend(
   }
 }
 
+DisplayListComplexityCalculator*
+DisplayListComplexityCalculator::GetForImpeller() {
+  return DisplayListImpellerComplexityCalculator::GetInstance();
+}
+
 DisplayListComplexityCalculator*
 DisplayListComplexityCalculator::GetForSoftware() {
   return DisplayListNaiveComplexityCalculator::GetInstance();
@@ -15,6 +15,7 @@ class DisplayListComplexityCalculator {
  public:
   static DisplayListComplexityCalculator* GetForSoftware();
   static DisplayListComplexityCalculator* GetForBackend(GrBackendApi backend);
+  static DisplayListComplexityCalculator* GetForImpeller();
 
   virtual ~DisplayListComplexityCalculator() = default;
 
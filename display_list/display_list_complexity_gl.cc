@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/display_list_complexity_gl.h"
 
+#include <mutex>
+
 // The numbers and weightings used in this file stem from taking the
 // data from the DisplayListBenchmarks suite run on an Pixel 4 and
 // applying very rough analysis on them to identify the approximate
@@ -19,9 +21,9 @@ DisplayListGLComplexityCalculator*
 
 DisplayListGLComplexityCalculator*
 DisplayListGLComplexityCalculator::GetInstance() {
-  if (instance_ == nullptr) {
-    instance_ = new DisplayListGLComplexityCalculator();
-  }
+  static std::once_flag once;
+  std::call_once(once,
+                 [] { instance_ = new DisplayListGLComplexityCalculator(); });
   return instance_;
 }
 
@@ -0,0 +1,313 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_complexity_impeller.h"
+
+#include <mutex>
+
+// Unlike the Metal and OpenGL calculators, the weightings used by this
+// calculator live in a table that can be replaced at runtime.
+//
+// The default table was seeded from the weightings in
+// display_list_complexity_metal.cc, as Impeller on iOS renders to the same
+// hardware. They are a starting point only and should be replaced with
+// numbers gathered from the DisplayListBenchmarks suite on the target
+// devices, see DlImpellerCostTable for the process.
+
+namespace flutter {
+
+unsigned int DlComplexityCost::Cost(float units) const {
+  float cost = fixed + per_unit * units;
+  if (cost <= 0.0f) {
+    return 0u;
+  }
+  if (cost >= static_cast<float>(std::numeric_limits<unsigned int>::max())) {
+    return std::numeric_limits<unsigned int>::max();
+  }
+  return static_cast<unsigned int>(cost);
+}
+
+DlImpellerCostTable DlImpellerCostTable::Default() {
+  DlImpellerCostTable table;
+  table.line = {100.0f, 4.0f / 9.0f};
+  table.fill_rect = {0.0f, 1.0f / 225.0f};
+  table.stroke_rect = {0.0f, 8.0f / 13.0f};
+  table.fill_oval = {0.0f, 1.0f / 80.0f};
+  table.stroke_oval = {0.0f, 2.5f};
+  table.fill_circle = {200.0f, 2.0f / 65.0f};
+  table.stroke_circle = {280.0f, 40.0f / 7.0f};
+  table.fill_rrect = {60.0f, 1.0f / 175.0f};
+  table.stroke_rrect = {80.0f, 1.0f / 625.0f};
+  table.fill_drrect = {150.0f, 1.0f / 35.0f};
+  table.stroke_drrect = {175.0f, 5.0f / 3.0f};
+  table.fill_arc = {445.0f, 1.0f / 900.0f};
+  table.stroke_arc = {200.0f / 3.0f, 10.0f / 27.0f};
+  table.fill_path = {200000.0f, 100.0f};
+  table.stroke_path = {200000.0f, 100.0f};
+  table.points = {150000.0f, 90.0f};
+  table.vertices = {200000.0f, 50.0f};
+  table.image = {1200.0f, 4.0f / 170.0f};
+  table.image_upload = {1000.0f, 4.0f / 145.0f};
+  table.image_nine = {1200.0f, 1.0f / 20.0f};
+  table.text_blob = {150000.0f, 2500.0f / 3.0f};
+  table.shadow = {0.0f, 20000.0f};
+  table.save_layer = {200000.0f, 100000.0f};
+  return table;
+}
+
+DisplayListImpellerComplexityCalculator*
+    DisplayListImpellerComplexityCalculator::instance_ = nullptr;
+
+DisplayListImpellerComplexityCalculator*
+DisplayListImpellerComplexityCalculator::GetInstance() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    instance_ = new DisplayListImpellerComplexityCalculator();
+  });
+  return instance_;
+}
+
+unsigned int
+DisplayListImpellerComplexityCalculator::ImpellerHelper::BatchedComplexity() {
+  unsigned int save_layer_complexity =
+      save_layer_count_ == 0 ? 0 : costs_.save_layer.Cost(save_layer_count_);
+  unsigned int draw_text_blob_complexity =
+      draw_text_blob_count_ == 0 ? 0
+                                 : costs_.text_blob.Cost(draw_text_blob_count_);
+
+  if (std::numeric_limits<unsigned int>::max() - save_layer_complexity <
+      draw_text_blob_complexity) {
+    return std::numeric_limits<unsigned int>::max();
+  }
+  return save_layer_complexity + draw_text_blob_complexity;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::saveLayer(
+    const SkRect* bounds,
+    const SaveLayerOptions options,
+    const DlImageFilter* backdrop) {
+  if (IsComplex()) {
+    return;
+  }
+  if (backdrop) {
+    // Flutter does not offer this operation so this value can only ever be
+    // non-null for a frame-wide builder which is not currently evaluated for
+    // complexity.
+    AccumulateComplexity(Ceiling());
+  }
+  save_layer_count_++;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawLine(
+    const SkPoint& p0,
+    const SkPoint& p1) {
+  if (IsComplex()) {
+    return;
+  }
+  // Use an approximation for the distance to avoid floating point or
+  // sqrt() calls.
+  SkScalar distance = abs(p0.x() - p1.x()) + abs(p0.y() - p1.y());
+  AccumulateComplexity(costs_.line.Cost(distance));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawRect(
+    const SkRect& rect) {
+  if (IsComplex()) {
+    return;
+  }
+  if (IsFilled()) {
+    AccumulateComplexity(costs_.fill_rect.Cost(rect.width() * rect.height()));
+  } else {
+    AccumulateComplexity(
+        costs_.stroke_rect.Cost((rect.width() + rect.height()) / 2));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawOval(
+    const SkRect& bounds) {
+  if (IsComplex()) {
+    return;
+  }
+  if (IsFilled()) {
+    AccumulateComplexity(
+        costs_.fill_oval.Cost(bounds.width() * bounds.height()));
+  } else {
+    AccumulateComplexity(
+        costs_.stroke_oval.Cost((bounds.width() + bounds.height()) / 2));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawCircle(
+    const SkPoint& center,
+    SkScalar radius) {
+  if (IsComplex()) {
+    return;
+  }
+  if (IsFilled()) {
+    AccumulateComplexity(costs_.fill_circle.Cost(radius * radius));
+  } else {
+    AccumulateComplexity(costs_.stroke_circle.Cost(radius));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawRRect(
+    const SkRRect& rrect) {
+  if (IsComplex()) {
+    return;
+  }
+  if (IsFilled()) {
+    AccumulateComplexity(
+        costs_.fill_rrect.Cost(rrect.width() * rrect.height()));
+  } else {
+    AccumulateComplexity(
+        costs_.stroke_rrect.Cost(rrect.width() * rrect.height()));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawDRRect(
+    const SkRRect& outer,
+    const SkRRect& inner) {
+  if (IsComplex()) {
+    return;
+  }
+  if (IsFilled()) {
+    AccumulateComplexity(
+        costs_.fill_drrect.Cost(outer.width() * outer.height()));
+  } else {
+    AccumulateComplexity(
+        costs_.stroke_drrect.Cost((outer.width() + outer.height()) / 2));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawPath(
+    const SkPath& path) {
+  if (IsComplex()) {
+    return;
+  }
+  // Paths are tessellated on the CPU, cubics are subdivided into roughly
+  // twice as many segments as the other verbs.
+  unsigned int verbs = CalculatePathComplexity(path, 1, 1, 1, 2);
+  if (IsFilled()) {
+    AccumulateComplexity(costs_.fill_path.Cost(verbs));
+  } else {
+    AccumulateComplexity(costs_.stroke_path.Cost(verbs));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawArc(
+    const SkRect& oval_bounds,
+    SkScalar start_degrees,
+    SkScalar sweep_degrees,
+    bool use_center) {
+  if (IsComplex()) {
+    return;
+  }
+  if (IsFilled()) {
+    AccumulateComplexity(
+        costs_.fill_arc.Cost(oval_bounds.width() * oval_bounds.height()));
+  } else {
+    AccumulateComplexity(costs_.stroke_arc.Cost(
+        (oval_bounds.width() + oval_bounds.height()) / 2));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawPoints(
+    DlCanvas::PointMode mode,
+    uint32_t count,
+    const SkPoint points[]) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateComplexity(costs_.points.Cost(count));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawVertices(
+    const DlVertices* vertices,
+    DlBlendMode mode) {
+  if (IsComplex()) {
+    return;
+  }
+  AccumulateComplexity(costs_.vertices.Cost(vertices->vertex_count()));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawImage(
+    const sk_sp<DlImage> image,
+    const SkPoint point,
+    DlImageSampling sampling,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  SkISize dimensions = image->dimensions();
+  ImageRect(dimensions, image->isTextureBacked(), render_with_attributes,
+            SkCanvas::SrcRectConstraint::kFast_SrcRectConstraint);
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::ImageRect(
+    const SkISize& size,
+    bool texture_backed,
+    bool render_with_attributes,
+    SkCanvas::SrcRectConstraint constraint) {
+  if (IsComplex()) {
+    return;
+  }
+  float area = static_cast<float>(size.width()) * size.height();
+  if (texture_backed) {
+    AccumulateComplexity(costs_.image.Cost(area));
+  } else {
+    AccumulateComplexity(costs_.image_upload.Cost(area));
+  }
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawImageNine(
+    const sk_sp<DlImage> image,
+    const SkIRect& center,
+    const SkRect& dst,
+    DlFilterMode filter,
+    bool render_with_attributes) {
+  if (IsComplex()) {
+    return;
+  }
+  SkISize dimensions = image->dimensions();
+  AccumulateComplexity(costs_.image_nine.Cost(
+      static_cast<float>(dimensions.width()) * dimensions.height()));
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawDisplayList(
+    const sk_sp<DisplayList> display_list) {
+  if (IsComplex()) {
+    return;
+  }
+  ImpellerHelper helper(Ceiling() - CurrentComplexityScore(), costs_);
+  display_list->Dispatch(helper);
+  AccumulateComplexity(helper.ComplexityScore());
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawTextBlob(
+    const sk_sp<SkTextBlob> blob,
+    SkScalar x,
+    SkScalar y) {
+  if (IsComplex()) {
+    return;
+  }
+  // Glyphs are rendered from a shared atlas, so most of the cost is paid
+  // once per list. Increment draw_text_blob_count_ and calculate the cost at
+  // the end.
+  draw_text_blob_count_++;
+}
+
+void DisplayListImpellerComplexityCalculator::ImpellerHelper::drawShadow(
+    const SkPath& path,
+    const DlColor color,
+    const SkScalar elevation,
+    bool transparent_occluder,
+    SkScalar dpr) {
+  if (IsComplex()) {
+    return;
+  }
+  unsigned int verbs = CalculatePathComplexity(path, 1, 1, 1, 2);
+  AccumulateComplexity(costs_.shadow.Cost(verbs));
+}
+
+}  // namespace flutter
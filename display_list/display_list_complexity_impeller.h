@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_IMPELLER_H_
+#define FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_IMPELLER_H_
+
+#include "flutter/display_list/display_list_complexity_helper.h"
+
+namespace flutter {
+
+// The cost of a single op expressed as a straight line (y = mx + c) in
+// complexity score units, where x is a measure of the op such as a length,
+// an area or a count.
+//
+// See the comments in display_list_complexity_helper.h for the meaning of
+// the score units.
+struct DlComplexityCost {
+  float fixed;
+  float per_unit;
+
+  unsigned int Cost(float units) const;
+};
+
+// The calibration table consumed by the
+// DisplayListImpellerComplexityCalculator.
+//
+// The measure used for each op (the x in y = mx + c) is noted next to each
+// entry. The coefficients can be recalibrated for a particular device by
+// running the display_list_benchmarks suite on it and fitting a straight line
+// through the real time per draw call of each benchmark against the measure
+// of the benchmark's argument, then normalising the result so that 0.0005ms
+// corresponds to a score of 100 (i.e. m and c in ms multiplied by 200,000).
+// The benchmarks report the scores computed by each calculator alongside the
+// measured times to make it easy to see which entries are out of line.
+//
+// Impeller renders with MSAA, so anti-aliasing does not affect these costs.
+struct DlImpellerCostTable {
+  DlComplexityCost line;           // Approximate length of the line.
+  DlComplexityCost fill_rect;      // Area.
+  DlComplexityCost stroke_rect;    // Average of the width and height.
+  DlComplexityCost fill_oval;      // Area of the bounds.
+  DlComplexityCost stroke_oval;    // Average of the width and height.
+  DlComplexityCost fill_circle;    // Radius squared.
+  DlComplexityCost stroke_circle;  // Radius.
+  DlComplexityCost fill_rrect;     // Area of the bounds.
+  DlComplexityCost stroke_rrect;   // Area of the bounds.
+  DlComplexityCost fill_drrect;    // Area of the outer bounds.
+  DlComplexityCost stroke_drrect;  // Average of the outer width and height.
+  DlComplexityCost fill_arc;       // Area of the oval bounds.
+  DlComplexityCost stroke_arc;     // Average of the oval width and height.
+  DlComplexityCost fill_path;      // Verb count, cubics counting double.
+  DlComplexityCost stroke_path;    // Verb count, cubics counting double.
+  DlComplexityCost points;         // Point count.
+  DlComplexityCost vertices;       // Vertex count.
+  DlComplexityCost image;          // Area of a texture backed image.
+  DlComplexityCost image_upload;   // Area of an image that must be uploaded.
+  DlComplexityCost image_nine;     // Area of the image.
+  DlComplexityCost text_blob;      // Number of text blobs in the list.
+  DlComplexityCost shadow;         // Verb count, cubics counting double.
+  DlComplexityCost save_layer;     // Number of save layers in the list.
+
+  // The table used until a device specific table is provided with
+  // |DisplayListImpellerComplexityCalculator::SetCostTable|.
+  static DlImpellerCostTable Default();
+};
+
+class DisplayListImpellerComplexityCalculator
+    : public DisplayListComplexityCalculator {
+ public:
+  static DisplayListImpellerComplexityCalculator* GetInstance();
+
+  unsigned int Compute(const DisplayList* display_list) override {
+    ImpellerHelper helper(ceiling_, costs_);
+    display_list->Dispatch(helper);
+    return helper.ComplexityScore();
+  }
+
+  bool ShouldBeCached(unsigned int complexity_score) override {
+    // Set cache threshold at 1ms
+    return complexity_score > 200000u;
+  }
+
+  void SetComplexityCeiling(unsigned int ceiling) override {
+    ceiling_ = ceiling;
+  }
+
+  // Replaces the costs used to compute complexity scores, typically with a
+  // table calibrated on the device the engine is running on.
+  void SetCostTable(const DlImpellerCostTable& costs) { costs_ = costs; }
+
+  const DlImpellerCostTable& cost_table() const { return costs_; }
+
+ private:
+  class ImpellerHelper : public ComplexityCalculatorHelper {
+   public:
+    ImpellerHelper(unsigned int ceiling, const DlImpellerCostTable& costs)
+        : ComplexityCalculatorHelper(ceiling),
+          costs_(costs),
+          save_layer_count_(0),
+          draw_text_blob_count_(0) {}
+
+    void saveLayer(const SkRect* bounds,
+                   const SaveLayerOptions options,
+                   const DlImageFilter* backdrop) override;
+
+    void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+    void drawRect(const SkRect& rect) override;
+    void drawOval(const SkRect& bounds) override;
+    void drawCircle(const SkPoint& center, SkScalar radius) override;
+    void drawRRect(const SkRRect& rrect) override;
+    void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+    void drawPath(const SkPath& path) override;
+    void drawArc(const SkRect& oval_bounds,
+                 SkScalar start_degrees,
+                 SkScalar sweep_degrees,
+                 bool use_center) override;
+    void drawPoints(DlCanvas::PointMode mode,
+                    uint32_t count,
+                    const SkPoint points[]) override;
+    void drawVertices(const DlVertices* vertices, DlBlendMode mode) override;
+    void drawImage(const sk_sp<DlImage> image,
+                   const SkPoint point,
+                   DlImageSampling sampling,
+                   bool render_with_attributes) override;
+    void drawImageNine(const sk_sp<DlImage> image,
+                       const SkIRect& center,
+                       const SkRect& dst,
+                       DlFilterMode filter,
+                       bool render_with_attributes) override;
+    void drawDisplayList(const sk_sp<DisplayList> display_list) override;
+    void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                      SkScalar x,
+                      SkScalar y) override;
+    void drawShadow(const SkPath& path,
+                    const DlColor color,
+                    const SkScalar elevation,
+                    bool transparent_occluder,
+                    SkScalar dpr) override;
+
+   protected:
+    void ImageRect(const SkISize& size,
+                   bool texture_backed,
+                   bool render_with_attributes,
+                   SkCanvas::SrcRectConstraint constraint) override;
+
+    unsigned int BatchedComplexity() override;
+
+   private:
+    bool IsFilled() { return Style() == SkPaint::Style::kFill_Style; }
+
+    const DlImpellerCostTable& costs_;
+    unsigned int save_layer_count_;
+    unsigned int draw_text_blob_count_;
+  };
+
+  DisplayListImpellerComplexityCalculator()
+      : ceiling_(std::numeric_limits<unsigned int>::max()),
+        costs_(DlImpellerCostTable::Default()) {}
+  static DisplayListImpellerComplexityCalculator* instance_;
+
+  unsigned int ceiling_;
+  DlImpellerCostTable costs_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_DISPLAY_LIST_COMPLEXITY_IMPELLER_H_
@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/display_list_complexity_metal.h"
 
+#include <mutex>
+
 // The numbers and weightings used in this file stem from taking the
 // data from the DisplayListBenchmarks suite run on an iPhone 12 and
 // applying very rough analysis on them to identify the approximate
@@ -19,9 +21,10 @@ DisplayListMetalComplexityCalculator*
 
 DisplayListMetalComplexityCalculator*
 DisplayListMetalComplexityCalculator::GetInstance() {
-  if (instance_ == nullptr) {
+  static std::once_flag once;
+  std::call_once(once, [] {
     instance_ = new DisplayListMetalComplexityCalculator();
-  }
+  });
   return instance_;
 }
 
@@ -6,6 +6,7 @@
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_complexity.h"
 #include "flutter/display_list/display_list_complexity_gl.h"
+#include "flutter/display_list/display_list_complexity_impeller.h"
 #include "flutter/display_list/display_list_complexity_metal.h"
 #include "flutter/display_list/display_list_sampling_options.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
@@ -20,10 +21,19 @@ namespace {
 std::vector<DisplayListComplexityCalculator*> Calculators() {
   return {DisplayListMetalComplexityCalculator::GetInstance(),
           DisplayListGLComplexityCalculator::GetInstance(),
+          DisplayListImpellerComplexityCalculator::GetInstance(),
           DisplayListNaiveComplexityCalculator::GetInstance()};
 }
 
 std::vector<DisplayListComplexityCalculator*> AccumulatorCalculators() {
+  return {DisplayListMetalComplexityCalculator::GetInstance(),
+          DisplayListGLComplexityCalculator::GetInstance(),
+          DisplayListImpellerComplexityCalculator::GetInstance()};
+}
+
+// Impeller renders with MSAA and its costs do not depend on anti-aliasing or
+// the stroke width.
+std::vector<DisplayListComplexityCalculator*> SkiaAccumulatorCalculators() {
   return {DisplayListMetalComplexityCalculator::GetInstance(),
           DisplayListGLComplexityCalculator::GetInstance()};
 }
@@ -84,7 +94,7 @@ TEST(DisplayListComplexity, AntiAliasing) {
   builder_aa.drawLine(SkPoint::Make(0, 0), SkPoint::Make(100, 100));
   auto display_list_aa = builder_aa.Build();
 
-  auto calculators = AccumulatorCalculators();
+  auto calculators = SkiaAccumulatorCalculators();
   for (auto calculator : calculators) {
     ASSERT_NE(calculator->Compute(display_list_no_aa.get()),
               calculator->Compute(display_list_aa.get()));
@@ -102,7 +112,7 @@ TEST(DisplayListComplexity, StrokeWidth) {
   builder_stroke_1.drawLine(SkPoint::Make(0, 0), SkPoint::Make(100, 100));
   auto display_list_stroke_1 = builder_stroke_1.Build();
 
-  auto calculators = AccumulatorCalculators();
+  auto calculators = SkiaAccumulatorCalculators();
   for (auto calculator : calculators) {
     ASSERT_NE(calculator->Compute(display_list_stroke_0.get()),
               calculator->Compute(display_list_stroke_1.get()));
@@ -432,5 +442,34 @@ TEST(DisplayListComplexity, DrawAtlas) {
   }
 }
 
+TEST(DisplayListComplexity, ImpellerUsesCostTable) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80));
+  auto display_list = builder.Build();
+
+  auto calculator = DisplayListImpellerComplexityCalculator::GetInstance();
+  DlImpellerCostTable original = calculator->cost_table();
+
+  DlImpellerCostTable costs = DlImpellerCostTable::Default();
+  costs.fill_rect = {1000.0f, 1.0f};
+  calculator->SetCostTable(costs);
+  EXPECT_EQ(calculator->Compute(display_list.get()), 1000u + 80u * 80u);
+
+  costs.fill_rect = {0.0f, 0.0f};
+  calculator->SetCostTable(costs);
+  EXPECT_EQ(calculator->Compute(display_list.get()), 0u);
+
+  calculator->SetCostTable(original);
+}
+
+TEST(DisplayListComplexity, ImpellerCostSaturates) {
+  DlComplexityCost cost = {-10.0f, 1.0f};
+  EXPECT_EQ(cost.Cost(5.0f), 0u);
+  EXPECT_EQ(cost.Cost(15.0f), 5u);
+
+  DlComplexityCost huge = {0.0f, 1e10f};
+  EXPECT_EQ(huge.Cost(10.0f), std::numeric_limits<unsigned int>::max());
+}
+
 }  // namespace testing
 }  // namespace flutter
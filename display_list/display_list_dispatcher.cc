@@ -6,6 +6,18 @@
 
 namespace flutter {
 
-//
+void Dispatcher::drawRects(const SkRect rects[], int count) {
+  for (int i = 0; i < count; i++) {
+    drawRect(rects[i]);
+  }
+}
+
+void Dispatcher::drawCircles(const SkPoint centers[],
+                             const SkScalar radii[],
+                             int count) {
+  for (int i = 0; i < count; i++) {
+    drawCircle(centers[i], radii[i]);
+  }
+}
 
 }  // namespace flutter
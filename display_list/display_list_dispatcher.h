@@ -248,6 +248,33 @@ class Dispatcher {
                           const SkScalar elevation,
                           bool transparent_occluder,
                           SkScalar dpr) = 0;
+
+  // Dispatchers that can render a run of identical primitives more
+  // efficiently than one call at a time can opt in to receiving batches
+  // by returning true from |wantsBatchedDraws|. DisplayList::Dispatch
+  // will then deliver each run of consecutive DrawRect or DrawCircle ops,
+  // which by construction all share the same attributes, through a single
+  // call to |drawRects| or |drawCircles|. The default implementations
+  // simply forward each primitive to |drawRect| or |drawCircle|.
+  virtual bool wantsBatchedDraws() const { return false; }
+  virtual void drawRects(const SkRect rects[], int count);
+  virtual void drawCircles(const SkPoint centers[],
+                           const SkScalar radii[],
+                           int count);
+
+  // Dispatchers for which each attribute change is costly can opt in to
+  // receiving only the attributes that are used by the rendering ops by
+  // returning true from |wantsDeferredAttributes|. DisplayList::Dispatch
+  // will then hold back each attribute op until it reaches a rendering op
+  // (or a saveLayer that renders with attributes) that honors that attribute
+  // according to its DisplayListAttributeFlags and will only deliver the
+  // latest value of each attribute that changed since it was last delivered.
+  //
+  // A dispatcher that opts in must start each dispatch with the default
+  // attributes and must not consult any attribute that a rendering op does
+  // not honor, for instance the paint of a drawImage that does not render
+  // with attributes.
+  virtual bool wantsDeferredAttributes() const { return false; }
 };
 
 }  // namespace flutter
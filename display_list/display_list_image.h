@@ -14,6 +14,7 @@
 #include "third_party/skia/include/core/SkImage.h"
 
 namespace impeller {
+class Image;
 class Texture;
 }  // namespace impeller
 
@@ -54,6 +55,22 @@ class DlImage : public SkRefCnt {
   ///
   virtual std::shared_ptr<impeller::Texture> impeller_texture() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      If this display list image is meant to be used by the Impeller
+  ///             backend and holds the planes of a YUV video frame, an
+  ///             Impeller image that samples the planes directly. Null
+  ///             otherwise.
+  ///
+  ///             Drawing this image instead of |impeller_texture()| saves
+  ///             converting the frame to an RGB texture first, which those
+  ///             images only do the first time their texture is asked for.
+  ///
+  /// @return     An Impeller YUV image instance or null.
+  ///
+  virtual std::shared_ptr<impeller::Image> impeller_yuv_image() const {
+    return nullptr;
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      If the pixel format of this image ignores alpha, this returns
   ///             true. This method might conservatively return false when it
@@ -115,6 +132,11 @@ class DlImage : public SkRefCnt {
     if (this == other) {
       return true;
     }
+    auto yuv_image = impeller_yuv_image();
+    if (yuv_image || other->impeller_yuv_image()) {
+      // Compared without converting the YUV images to RGB textures.
+      return yuv_image == other->impeller_yuv_image();
+    }
     return skia_image() == other->skia_image() &&
            impeller_texture() == other->impeller_texture();
   }
@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/display_list_matrix_clip_tracker.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkPath.h"
@@ -42,6 +44,9 @@ class Data4x4 : public DisplayListMatrixClipTracker::Data {
   bool mapRect(const SkRect& rect, SkRect* mapped) const override {
     return m44_.asM33().mapRect(mapped, rect);
   }
+  void mapRects(const SkRect src[], SkRect dst[], int count) const override {
+    mapRectsWith(m44_.asM33(), src, dst, count);
+  }
   bool canBeInverted() const override { return m44_.asM33().invert(nullptr); }
 
  protected:
@@ -84,6 +89,9 @@ class Data3x3 : public DisplayListMatrixClipTracker::Data {
   bool mapRect(const SkRect& rect, SkRect* mapped) const override {
     return matrix_.mapRect(mapped, rect);
   }
+  void mapRects(const SkRect src[], SkRect dst[], int count) const override {
+    mapRectsWith(matrix_, src, dst, count);
+  }
   bool canBeInverted() const override { return matrix_.invert(nullptr); }
 
  protected:
@@ -255,6 +263,33 @@ void DisplayListMatrixClipTracker::clipPath(const SkPath& path,
   current_->clipBounds(bounds, op, is_aa);
 }
 
+void DisplayListMatrixClipTracker::Data::mapRectsWith(const SkMatrix& matrix,
+                                                      const SkRect src[],
+                                                      SkRect dst[],
+                                                      int count) {
+  if (!matrix.isScaleTranslate()) {
+    for (int i = 0; i < count; i++) {
+      matrix.mapRect(&dst[i], src[i]);
+    }
+    return;
+  }
+  const SkScalar sx = matrix.getScaleX();
+  const SkScalar sy = matrix.getScaleY();
+  const SkScalar tx = matrix.getTranslateX();
+  const SkScalar ty = matrix.getTranslateY();
+  // The loop body has no branches and no calls so that the compiler can
+  // vectorize it for the target (SSE or NEON). The min/max sort the edges
+  // when the scale is negative, as SkMatrix::mapRect would.
+  for (int i = 0; i < count; i++) {
+    const SkScalar x0 = src[i].fLeft * sx + tx;
+    const SkScalar x1 = src[i].fRight * sx + tx;
+    const SkScalar y0 = src[i].fTop * sy + ty;
+    const SkScalar y1 = src[i].fBottom * sy + ty;
+    dst[i].setLTRB(std::min(x0, x1), std::min(y0, y1),  //
+                   std::max(x0, x1), std::max(y0, y1));
+  }
+}
+
 bool DisplayListMatrixClipTracker::Data::content_culled(
     const SkRect& content_bounds) const {
   if (cull_rect_.isEmpty() || content_bounds.isEmpty()) {
@@ -64,6 +64,14 @@ class DisplayListMatrixClipTracker {
   void setTransform(const SkM44& m44);
   void setIdentity() { current_->setIdentity(); }
   bool mapRect(SkRect* rect) const { return current_->mapRect(*rect, rect); }
+  // Maps |count| rects through the current matrix, equivalent to calling
+  // mapRect on each of them. |src| and |dst| may be the same array.
+  //
+  // Matrices that only scale and translate are handled with a single
+  // branch-free loop over the rects rather than a dispatch per rect.
+  void mapRects(const SkRect src[], SkRect dst[], int count) const {
+    current_->mapRects(src, dst, count);
+  }
 
   void clipRect(const SkRect& rect, ClipOp op, bool is_aa) {
     current_->clipBounds(rect, op, is_aa);
@@ -95,6 +103,9 @@ class DisplayListMatrixClipTracker {
     virtual void setTransform(const SkM44& m44) = 0;
     virtual void setIdentity() = 0;
     virtual bool mapRect(const SkRect& rect, SkRect* mapped) const = 0;
+    virtual void mapRects(const SkRect src[],
+                          SkRect dst[],
+                          int count) const = 0;
     virtual bool canBeInverted() const = 0;
 
     virtual void clipBounds(const SkRect& clip, ClipOp op, bool is_aa);
@@ -104,6 +115,11 @@ class DisplayListMatrixClipTracker {
 
     virtual bool has_perspective() const = 0;
 
+    static void mapRectsWith(const SkMatrix& matrix,
+                             const SkRect src[],
+                             SkRect dst[],
+                             int count);
+
     SkRect cull_rect_;
   };
   friend class Data3x3;
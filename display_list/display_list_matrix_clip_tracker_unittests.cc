@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list_matrix_clip_tracker.h"
 #include "gtest/gtest.h"
 #include "third_party/skia/include/core/SkPath.h"
@@ -348,5 +350,75 @@ TEST(DisplayListMatrixClipTracker, DiffClipPathWithInvertFillType) {
   ASSERT_EQ(tracker.device_cull_rect(), clip_bounds);
 }
 
+static void TestMapRects(const DisplayListMatrixClipTracker& tracker) {
+  const SkRect rects[] = {
+      SkRect::MakeLTRB(0, 0, 10, 10),
+      SkRect::MakeLTRB(-5, 3, 7, 12),
+      SkRect::MakeLTRB(20.5, 30.25, 21, 31),
+      SkRect::MakeEmpty(),
+  };
+  const int count = sizeof(rects) / sizeof(rects[0]);
+
+  SkRect mapped[count];
+  tracker.mapRects(rects, mapped, count);
+  for (int i = 0; i < count; i++) {
+    SkRect expected = rects[i];
+    tracker.mapRect(&expected);
+    ASSERT_FLOAT_EQ(mapped[i].fLeft, expected.fLeft) << "rect " << i;
+    ASSERT_FLOAT_EQ(mapped[i].fTop, expected.fTop) << "rect " << i;
+    ASSERT_FLOAT_EQ(mapped[i].fRight, expected.fRight) << "rect " << i;
+    ASSERT_FLOAT_EQ(mapped[i].fBottom, expected.fBottom) << "rect " << i;
+  }
+
+  SkRect in_place[count];
+  std::copy(rects, rects + count, in_place);
+  tracker.mapRects(in_place, in_place, count);
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(in_place[i], mapped[i]) << "rect " << i;
+  }
+}
+
+TEST(DisplayListMatrixClipTracker, MapRectsScaleTranslate) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+  DisplayListMatrixClipTracker tracker(cull_rect, SkMatrix::I());
+  TestMapRects(tracker);
+
+  tracker.translate(5, 7);
+  TestMapRects(tracker);
+
+  tracker.scale(2, 3);
+  TestMapRects(tracker);
+
+  tracker.scale(-1, 0.5);
+  TestMapRects(tracker);
+}
+
+TEST(DisplayListMatrixClipTracker, MapRectsGeneralMatrix) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+  DisplayListMatrixClipTracker tracker(cull_rect, SkMatrix::I());
+  tracker.translate(5, 7);
+  tracker.rotate(30);
+  TestMapRects(tracker);
+
+  tracker.skew(0.25, 0);
+  TestMapRects(tracker);
+}
+
+TEST(DisplayListMatrixClipTracker, MapRects4x4) {
+  const SkRect cull_rect = SkRect::MakeLTRB(20, 20, 60, 60);
+  // clang-format off
+  const SkM44 m44 = SkM44(4, 0, 0.5, 3,
+                          0, 4, 0.5, 2,
+                          0, 0, 4.0, 0,
+                          0, 0, 0.0, 1);
+  // clang-format on
+  DisplayListMatrixClipTracker tracker(cull_rect, m44);
+  ASSERT_TRUE(tracker.using_4x4_matrix());
+  TestMapRects(tracker);
+
+  tracker.rotate(45);
+  TestMapRects(tracker);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -600,7 +600,7 @@ DEFINE_CLIP_SHAPE_OP(RRect, Difference)
   struct Clip##clipop##PathOp final : TransformClipOpBase {                \
     static const auto kType = DisplayListOpType::kClip##clipop##Path;      \
                                                                            \
-    Clip##clipop##PathOp(SkPath path, bool is_aa)                          \
+    Clip##clipop##PathOp(const SkPath& path, bool is_aa)                   \
         : is_aa(is_aa), path(path) {}                                      \
                                                                            \
     const bool is_aa;                                                      \
@@ -686,7 +686,7 @@ DEFINE_DRAW_1ARG_OP(RRect, SkRRect, rrect)
 struct DrawPathOp final : DrawOpBase {
   static const auto kType = DisplayListOpType::kDrawPath;
 
-  explicit DrawPathOp(SkPath path) : path(path) {}
+  explicit DrawPathOp(const SkPath& path) : path(path) {}
 
   const SkPath path;
 
@@ -781,20 +781,33 @@ DEFINE_DRAW_POINTS_OP(Polygon, kPolygon);
 // Note that the DlVertices object ends with an array of 16-bit
 // indices so the alignment can be up to 6 bytes off leading to
 // up to 6 bytes of overhead
+// The DlVertices object holds a reference to the resource that a backend
+// cached for it, so it is destroyed along with the op and compared by value
+// rather than in bulk.
 struct DrawVerticesOp final : DrawOpBase {
   static const auto kType = DisplayListOpType::kDrawVertices;
 
   DrawVerticesOp(DlBlendMode mode) : mode(mode) {}
 
+  ~DrawVerticesOp() { vertices()->~DlVertices(); }
+
   const DlBlendMode mode;
 
+  const DlVertices* vertices() const {
+    return reinterpret_cast<const DlVertices*>(this + 1);
+  }
+
   void dispatch(DispatchContext& ctx) const {
     if (op_needed(ctx)) {
-      const DlVertices* vertices =
-          reinterpret_cast<const DlVertices*>(this + 1);
-      ctx.dispatcher.drawVertices(vertices, mode);
+      ctx.dispatcher.drawVertices(vertices(), mode);
     }
   }
+
+  DisplayListCompare equals(const DrawVerticesOp* other) const {
+    return mode == other->mode && *vertices() == *other->vertices()
+               ? DisplayListCompare::kEqual
+               : DisplayListCompare::kNotEqual;
+  }
 };
 
 // 4 byte header + 40 byte payload uses 44 bytes but is rounded up to 48 bytes
@@ -0,0 +1,925 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_optimizer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_dispatcher.h"
+#include "flutter/display_list/display_list_matrix_clip_tracker.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+enum class OpKind {
+  kAttribute,
+  kSave,
+  kSaveLayer,
+  kRestore,
+  kTranslate,
+  kScale,
+  kTransform,
+  kClip,
+  kDraw,
+};
+
+struct OpInfo {
+  explicit OpInfo(OpKind kind) : kind(kind) {}
+
+  OpKind kind;
+  bool dead = false;
+  // Opacity folded into this rendering op from a collapsed SaveLayer.
+  SkScalar opacity = SK_Scalar1;
+  // For Save and SaveLayer ops, the index of the matching Restore once it
+  // has been seen, otherwise -1.
+  int restore_index = -1;
+  // True if the op renders into a SaveLayer rather than directly into the
+  // surface of the DisplayList.
+  bool in_layer = false;
+};
+
+// The first pass over the DisplayList. It records the structure of the
+// op stream and decides which ops are dead and which SaveLayers can be
+// collapsed. Every op in the DisplayList results in exactly one call to
+// this dispatcher (no culling is used), so the position of each call is
+// the index of the op in the stream.
+class AnalysisDispatcher final : public Dispatcher {
+ public:
+  explicit AnalysisDispatcher(const DlRTree* rtree)
+      : tracker_(DisplayListBuilder::kMaxCullRect, SkMatrix::I()) {
+    if (rtree) {
+      for (int i = 0; i < rtree->leaf_count(); i++) {
+        int id = rtree->id(i);
+        if (id < 0) {
+          continue;
+        }
+        if (static_cast<size_t>(id) >= op_bounds_.size()) {
+          op_bounds_.resize(id + 1, SkRect::MakeEmpty());
+        }
+        op_bounds_[id].join(rtree->bounds(i));
+      }
+    }
+  }
+
+  std::vector<OpInfo>& ops() { return ops_; }
+  unsigned int collapsed_layers() const { return collapsed_layers_; }
+  unsigned int culled_ops() const { return culled_ops_; }
+  unsigned int mergeable_transforms() const { return mergeable_transforms_; }
+
+  void setAntiAlias(bool aa) override { Attribute(); }
+  void setDither(bool dither) override { Attribute(); }
+  void setInvertColors(bool invert) override {
+    invert_colors_ = invert;
+    Attribute();
+  }
+  void setStrokeCap(DlStrokeCap cap) override { Attribute(); }
+  void setStrokeJoin(DlStrokeJoin join) override { Attribute(); }
+  void setStyle(DlDrawStyle style) override {
+    style_ = style;
+    Attribute();
+  }
+  void setStrokeWidth(float width) override { Attribute(); }
+  void setStrokeMiter(float limit) override { Attribute(); }
+  void setColor(DlColor color) override {
+    color_ = color;
+    Attribute();
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    blend_mode_ = mode;
+    Attribute();
+  }
+  void setColorSource(const DlColorSource* source) override {
+    has_color_source_ = source != nullptr;
+    Attribute();
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    has_color_filter_ = filter != nullptr;
+    Attribute();
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    has_path_effect_ = effect != nullptr;
+    Attribute();
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    has_mask_filter_ = filter != nullptr;
+    Attribute();
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    has_image_filter_ = filter != nullptr;
+    Attribute();
+  }
+
+  void save() override {
+    Structural();
+    layers_.emplace_back(Push(OpKind::kSave));
+    tracker_.save();
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    Structural();
+    bool collapsible = bounds == nullptr && backdrop == nullptr &&
+                       options.renders_with_attributes() &&
+                       options.can_distribute_opacity() &&
+                       blend_mode_ == DlBlendMode::kSrcOver &&
+                       !has_color_filter_ && !has_image_filter_ &&
+                       !invert_colors_;
+    layers_.emplace_back(Push(OpKind::kSaveLayer));
+    layers_.back().is_layer = true;
+    layers_.back().collapsible = collapsible;
+    layers_.back().opacity = color_.getAlphaF();
+    layer_depth_++;
+    tracker_.save();
+  }
+  void restore() override {
+    int index = Push(OpKind::kRestore);
+    if (layers_.empty()) {
+      return;
+    }
+    LayerState layer = layers_.back();
+    layers_.pop_back();
+    tracker_.restore();
+    if (layer.has_clip) {
+      active_clips_--;
+    }
+    ops_[layer.op_index].restore_index = index;
+    if (layer.is_layer) {
+      layer_depth_--;
+      if (layer.collapsible && layer.draw_count <= 1) {
+        ops_[layer.op_index].dead = true;
+        ops_[index].dead = true;
+        if (layer.draw_count == 1) {
+          ops_[layer.draw_index].opacity *= layer.opacity;
+        }
+        collapsed_layers_++;
+      }
+    }
+    last_transform_ = -1;
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    Transform(OpKind::kTranslate);
+    tracker_.translate(tx, ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    Transform(OpKind::kScale);
+    tracker_.scale(sx, sy);
+  }
+  void rotate(SkScalar degrees) override {
+    Transform(OpKind::kTransform);
+    tracker_.rotate(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    Transform(OpKind::kTransform);
+    tracker_.skew(sx, sy);
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    Transform(OpKind::kTransform);
+    tracker_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    Transform(OpKind::kTransform);
+    tracker_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                      myx, myy, myz, myt,
+                                      mzx, mzy, mzz, mzt,
+                                      mwx, mwy, mwz, mwt);
+  }
+  // clang-format on
+  void transformReset() override {
+    Transform(OpKind::kTransform);
+    tracker_.setIdentity();
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    Clip();
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    Clip();
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    Clip();
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    int index = Draw(false);
+    bool covers = mode == DlBlendMode::kSrc || mode == DlBlendMode::kClear ||
+                  (mode == DlBlendMode::kSrcOver && color.isOpaque());
+    if (covers && CanOcclude()) {
+      CullAllBefore(index);
+    }
+  }
+  void drawPaint() override {
+    int index = Draw(true);
+    if (PaintIsOpaque() && CanOcclude()) {
+      CullAllBefore(index);
+    }
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override { Draw(true); }
+  void drawRect(const SkRect& rect) override {
+    int index = Draw(true);
+    if (style_ == DlDrawStyle::kFill && !has_path_effect_ && PaintIsOpaque() &&
+        CanOcclude() && !op_bounds_.empty()) {
+      SkRect device_rect = rect;
+      if (tracker_.mapRect(&device_rect)) {
+        CullContainedBefore(index, device_rect);
+      }
+    }
+  }
+  void drawOval(const SkRect& bounds) override { Draw(true); }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Draw(true);
+  }
+  void drawRRect(const SkRRect& rrect) override { Draw(true); }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Draw(true);
+  }
+  void drawPath(const SkPath& path) override { Draw(true); }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Draw(true);
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    Draw(true);
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    Draw(false);
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    Draw(render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    Draw(render_with_attributes);
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    Draw(render_with_attributes);
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    Draw(false);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    Draw(false);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Draw(true);
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Draw(false);
+  }
+
+ private:
+  struct LayerState {
+    explicit LayerState(int op_index) : op_index(op_index) {}
+
+    int op_index;
+    bool is_layer = false;
+    bool collapsible = false;
+    SkScalar opacity = SK_Scalar1;
+    bool has_clip = false;
+    int draw_count = 0;
+    int draw_index = -1;
+  };
+
+  int Push(OpKind kind) {
+    ops_.emplace_back(kind);
+    ops_.back().in_layer = layer_depth_ > 0;
+    return ops_.size() - 1;
+  }
+
+  void Attribute() { Push(OpKind::kAttribute); }
+
+  // Any op other than an attribute or a single rendering op prevents the
+  // enclosing SaveLayer from being collapsed.
+  void Structural() {
+    if (!layers_.empty()) {
+      layers_.back().collapsible = false;
+    }
+    last_transform_ = -1;
+  }
+
+  void Transform(OpKind kind) {
+    int previous = last_transform_;
+    Structural();
+    int index = Push(kind);
+    if (kind != OpKind::kTransform && previous >= 0 &&
+        ops_[previous].kind == kind) {
+      mergeable_transforms_++;
+    }
+    last_transform_ = index;
+  }
+
+  void Clip() {
+    Structural();
+    Push(OpKind::kClip);
+    if (layers_.empty()) {
+      root_has_clip_ = true;
+    } else if (!layers_.back().has_clip) {
+      layers_.back().has_clip = true;
+      active_clips_++;
+    }
+  }
+
+  int Draw(bool honors_paint_alpha) {
+    int index = Push(OpKind::kDraw);
+    if (!layers_.empty()) {
+      LayerState& layer = layers_.back();
+      if (!honors_paint_alpha) {
+        layer.collapsible = false;
+      }
+      layer.draw_count++;
+      layer.draw_index = index;
+    }
+    last_transform_ = -1;
+    return index;
+  }
+
+  bool PaintIsOpaque() const {
+    return color_.isOpaque() && blend_mode_ == DlBlendMode::kSrcOver &&
+           !has_color_source_ && !has_color_filter_ && !has_mask_filter_ &&
+           !has_image_filter_ && !invert_colors_;
+  }
+
+  // An op can only hide the ops before it if it renders directly into the
+  // surface of the DisplayList and its output is not restricted by a clip.
+  bool CanOcclude() const {
+    return layer_depth_ == 0 && active_clips_ == 0 && !root_has_clip_;
+  }
+
+  void MarkDead(int index) {
+    if (!ops_[index].dead) {
+      ops_[index].dead = true;
+      culled_ops_++;
+    }
+  }
+
+  // Everything rendered before |index| is overwritten. Drawing ops and
+  // completed save blocks are dead, while attributes and the transforms
+  // of the still open save blocks are still needed by later ops.
+  void CullAllBefore(int index) {
+    int i = cull_start_;
+    while (i < index) {
+      OpInfo& op = ops_[i];
+      switch (op.kind) {
+        case OpKind::kDraw:
+          MarkDead(i);
+          break;
+        case OpKind::kSave:
+        case OpKind::kSaveLayer:
+          if (op.restore_index >= 0) {
+            for (int j = i; j <= op.restore_index; j++) {
+              if (ops_[j].kind != OpKind::kAttribute) {
+                MarkDead(j);
+              }
+            }
+            i = op.restore_index;
+          }
+          break;
+        default:
+          break;
+      }
+      i++;
+    }
+    cull_start_ = index;
+  }
+
+  // Drops the rendering ops before |index| whose bounds lie entirely
+  // within the pixels fully covered by |device_rect|.
+  void CullContainedBefore(int index, const SkRect& device_rect) {
+    SkIRect covered = device_rect.roundIn();
+    if (covered.isEmpty()) {
+      return;
+    }
+    size_t end = std::min(static_cast<size_t>(index), op_bounds_.size());
+    for (size_t i = cull_start_; i < end; i++) {
+      OpInfo& op = ops_[i];
+      if (op.kind != OpKind::kDraw || op.dead || op.in_layer ||
+          op_bounds_[i].isEmpty()) {
+        continue;
+      }
+      if (covered.contains(op_bounds_[i].roundOut())) {
+        MarkDead(i);
+      }
+    }
+  }
+
+  std::vector<OpInfo> ops_;
+  std::vector<LayerState> layers_;
+  std::vector<SkRect> op_bounds_;
+  DisplayListMatrixClipTracker tracker_;
+
+  int layer_depth_ = 0;
+  int active_clips_ = 0;
+  bool root_has_clip_ = false;
+  int cull_start_ = 0;
+  int last_transform_ = -1;
+
+  DlColor color_ = DlColor::kBlack();
+  DlBlendMode blend_mode_ = DlBlendMode::kSrcOver;
+  DlDrawStyle style_ = DlDrawStyle::kFill;
+  bool invert_colors_ = false;
+  bool has_color_source_ = false;
+  bool has_color_filter_ = false;
+  bool has_path_effect_ = false;
+  bool has_mask_filter_ = false;
+  bool has_image_filter_ = false;
+
+  unsigned int collapsed_layers_ = 0;
+  unsigned int culled_ops_ = 0;
+  unsigned int mergeable_transforms_ = 0;
+};
+
+// The second pass over the DisplayList. It forwards the live ops to a
+// DisplayListBuilder, merging runs of translate and scale ops and applying
+// the opacity of collapsed SaveLayers to their single child.
+class EmitDispatcher final : public Dispatcher {
+ public:
+  EmitDispatcher(const std::vector<OpInfo>& ops, DisplayListBuilder& builder)
+      : ops_(ops), builder_(builder) {}
+
+  unsigned int merged_transforms() const { return merged_transforms_; }
+  unsigned int dropped_transforms() const { return dropped_transforms_; }
+
+  void Finish() {
+    // Transforms at the end of the list have no effect on any op.
+    DropPendingTransform();
+  }
+
+  void setAntiAlias(bool aa) override {
+    if (Live()) {
+      builder_.setAntiAlias(aa);
+    }
+  }
+  void setDither(bool dither) override {
+    if (Live()) {
+      builder_.setDither(dither);
+    }
+  }
+  void setInvertColors(bool invert) override {
+    if (Live()) {
+      builder_.setInvertColors(invert);
+    }
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    if (Live()) {
+      builder_.setStrokeCap(cap);
+    }
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    if (Live()) {
+      builder_.setStrokeJoin(join);
+    }
+  }
+  void setStyle(DlDrawStyle style) override {
+    if (Live()) {
+      builder_.setStyle(style);
+    }
+  }
+  void setStrokeWidth(float width) override {
+    if (Live()) {
+      builder_.setStrokeWidth(width);
+    }
+  }
+  void setStrokeMiter(float limit) override {
+    if (Live()) {
+      builder_.setStrokeMiter(limit);
+    }
+  }
+  void setColor(DlColor color) override {
+    // The color is only forwarded when it is needed by a live op so that
+    // colors modulated by a collapsed SaveLayer do not need to be reset.
+    if (Live()) {
+      color_ = color;
+    }
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    if (Live()) {
+      builder_.setBlendMode(mode);
+    }
+  }
+  void setColorSource(const DlColorSource* source) override {
+    if (Live()) {
+      builder_.setColorSource(source);
+    }
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    if (Live()) {
+      builder_.setColorFilter(filter);
+    }
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    if (Live()) {
+      builder_.setPathEffect(effect);
+    }
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    if (Live()) {
+      builder_.setMaskFilter(filter);
+    }
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    if (Live()) {
+      builder_.setImageFilter(filter);
+    }
+  }
+
+  void save() override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.save();
+    }
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    if (Live()) {
+      FlushPendingTransform();
+      SyncColor();
+      builder_.saveLayer(bounds, options, backdrop);
+    }
+  }
+  void restore() override {
+    if (Live()) {
+      // A transform immediately followed by a restore is discarded.
+      DropPendingTransform();
+      builder_.restore();
+    }
+  }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    if (Live()) {
+      if (pending_ != OpKind::kTranslate) {
+        FlushPendingTransform();
+        pending_ = OpKind::kTranslate;
+        pending_x_ = tx;
+        pending_y_ = ty;
+      } else {
+        pending_x_ += tx;
+        pending_y_ += ty;
+        merged_transforms_++;
+      }
+    }
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    if (Live()) {
+      if (pending_ != OpKind::kScale) {
+        FlushPendingTransform();
+        pending_ = OpKind::kScale;
+        pending_x_ = sx;
+        pending_y_ = sy;
+      } else {
+        pending_x_ *= sx;
+        pending_y_ *= sy;
+        merged_transforms_++;
+      }
+    }
+  }
+  void rotate(SkScalar degrees) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.rotate(degrees);
+    }
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.skew(sx, sy);
+    }
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+    }
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.transformFullPerspective(mxx, mxy, mxz, mxt,
+                                        myx, myy, myz, myt,
+                                        mzx, mzy, mzz, mzt,
+                                        mwx, mwy, mwz, mwt);
+    }
+  }
+  // clang-format on
+  void transformReset() override {
+    if (Live()) {
+      // Any pending transform is overridden by the reset.
+      DropPendingTransform();
+      builder_.transformReset();
+    }
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.clipRect(rect, clip_op, is_aa);
+    }
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.clipRRect(rrect, clip_op, is_aa);
+    }
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    if (Live()) {
+      FlushPendingTransform();
+      builder_.clipPath(path, clip_op, is_aa);
+    }
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    if (LiveDraw()) {
+      builder_.drawColor(color, mode);
+    }
+  }
+  void drawPaint() override {
+    if (LiveDraw()) {
+      builder_.drawPaint();
+    }
+  }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    if (LiveDraw()) {
+      builder_.drawLine(p0, p1);
+    }
+  }
+  void drawRect(const SkRect& rect) override {
+    if (LiveDraw()) {
+      builder_.drawRect(rect);
+    }
+  }
+  void drawOval(const SkRect& bounds) override {
+    if (LiveDraw()) {
+      builder_.drawOval(bounds);
+    }
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    if (LiveDraw()) {
+      builder_.drawCircle(center, radius);
+    }
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    if (LiveDraw()) {
+      builder_.drawRRect(rrect);
+    }
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    if (LiveDraw()) {
+      builder_.drawDRRect(outer, inner);
+    }
+  }
+  void drawPath(const SkPath& path) override {
+    if (LiveDraw()) {
+      builder_.drawPath(path);
+    }
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    if (LiveDraw()) {
+      builder_.drawArc(oval_bounds, start_degrees, sweep_degrees, use_center);
+    }
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    if (LiveDraw()) {
+      builder_.drawPoints(mode, count, points);
+    }
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    if (LiveDraw()) {
+      builder_.drawVertices(vertices, mode);
+    }
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    if (LiveDraw()) {
+      builder_.drawImage(image, point, sampling, render_with_attributes);
+    }
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    if (LiveDraw()) {
+      builder_.drawImageRect(image, src, dst, sampling,
+                             render_with_attributes, constraint);
+    }
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    if (LiveDraw()) {
+      builder_.drawImageNine(image, center, dst, filter,
+                             render_with_attributes);
+    }
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    if (LiveDraw()) {
+      builder_.drawAtlas(atlas, xform, tex, colors, count, mode, sampling,
+                         cull_rect, render_with_attributes);
+    }
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    if (LiveDraw()) {
+      builder_.drawDisplayList(display_list);
+    }
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    if (LiveDraw()) {
+      builder_.drawTextBlob(blob, x, y);
+    }
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    if (LiveDraw()) {
+      builder_.drawShadow(path, color, elevation, transparent_occluder, dpr);
+    }
+  }
+
+ private:
+  // Advances to the next op and returns whether it should be emitted.
+  bool Live() {
+    FML_DCHECK(index_ < ops_.size());
+    current_ = &ops_[index_++];
+    return !current_->dead;
+  }
+
+  bool LiveDraw() {
+    if (!Live()) {
+      return false;
+    }
+    FlushPendingTransform();
+    SyncColor();
+    return true;
+  }
+
+  // Forwards the current color, modulated by any opacity folded into the
+  // current op, to the builder. The builder ignores redundant colors.
+  void SyncColor() {
+    if (current_->opacity < SK_Scalar1) {
+      builder_.setColor(color_.modulateOpacity(current_->opacity));
+    } else {
+      builder_.setColor(color_);
+    }
+  }
+
+  void FlushPendingTransform() {
+    switch (pending_) {
+      case OpKind::kTranslate:
+        builder_.translate(pending_x_, pending_y_);
+        break;
+      case OpKind::kScale:
+        builder_.scale(pending_x_, pending_y_);
+        break;
+      default:
+        break;
+    }
+    pending_ = OpKind::kAttribute;
+  }
+
+  void DropPendingTransform() {
+    if (pending_ != OpKind::kAttribute) {
+      dropped_transforms_++;
+    }
+    pending_ = OpKind::kAttribute;
+  }
+
+  const std::vector<OpInfo>& ops_;
+  DisplayListBuilder& builder_;
+  size_t index_ = 0;
+  const OpInfo* current_ = nullptr;
+
+  DlColor color_ = DlColor::kBlack();
+
+  // kAttribute indicates that there is no pending transform.
+  OpKind pending_ = OpKind::kAttribute;
+  SkScalar pending_x_ = 0;
+  SkScalar pending_y_ = 0;
+
+  unsigned int merged_transforms_ = 0;
+  unsigned int dropped_transforms_ = 0;
+};
+
+// Whether a translate or scale op is immediately followed by a restore or
+// by the end of the list, either of which discards it.
+bool HasDiscardedTransform(const std::vector<OpInfo>& ops) {
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (ops[i].kind != OpKind::kTranslate && ops[i].kind != OpKind::kScale) {
+      continue;
+    }
+    if (i + 1 == ops.size() || ops[i + 1].kind == OpKind::kRestore) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+sk_sp<DisplayList> DisplayListOptimizer::Optimize(
+    const sk_sp<DisplayList>& display_list,
+    Stats* stats) {
+  TRACE_EVENT0("flutter", "DisplayListOptimizer::Optimize");
+  if (!display_list) {
+    return nullptr;
+  }
+  if (stats) {
+    *stats = Stats();
+    stats->ops_before = stats->ops_after = display_list->op_count();
+    stats->bytes_before = stats->bytes_after = display_list->bytes(false);
+  }
+
+  AnalysisDispatcher analysis(display_list->rtree().get());
+  display_list->Dispatch(analysis);
+  if (analysis.collapsed_layers() == 0 && analysis.culled_ops() == 0 &&
+      analysis.mergeable_transforms() == 0 &&
+      !HasDiscardedTransform(analysis.ops())) {
+    return display_list;
+  }
+
+  DisplayListBuilder builder(display_list->has_rtree());
+  EmitDispatcher emitter(analysis.ops(), builder);
+  display_list->Dispatch(emitter);
+  emitter.Finish();
+  sk_sp<DisplayList> optimized = builder.Build();
+
+  if (stats) {
+    stats->ops_after = optimized->op_count();
+    stats->bytes_after = optimized->bytes(false);
+    stats->merged_transforms = emitter.merged_transforms();
+    stats->dropped_transforms = emitter.dropped_transforms();
+    stats->collapsed_layers = analysis.collapsed_layers();
+    stats->culled_ops = analysis.culled_ops();
+  }
+  return optimized;
+}
+
+}  // namespace flutter
@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OPTIMIZER_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OPTIMIZER_H_
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A peephole optimization pass that rewrites the op stream of a
+///             DisplayList into an equivalent, usually smaller, DisplayList.
+///
+/// The following rewrites are performed:
+///
+/// - Consecutive translate (or scale) ops are merged into a single op and
+///   transforms that are immediately discarded by a restore are dropped.
+/// - A SaveLayer that renders with a simple alpha and contains a single
+///   rendering op that honors the paint alpha is removed and its opacity is
+///   folded into the color of that op. The Save and Restore ops that are
+///   left without any transform or clip by the other rewrites are elided
+///   by the DisplayListBuilder as the list is re-recorded.
+/// - Rendering ops that are completely covered by a later opaque DrawPaint
+///   or DrawColor (or, if the DisplayList has an RTree, by a later opaque
+///   DrawRect) are dropped.
+///
+/// The optimizer never changes the rendered output, it only removes work.
+/// A DisplayList that has no optimization opportunities is returned as is.
+///
+class DisplayListOptimizer {
+ public:
+  struct Stats {
+    unsigned int ops_before = 0;
+    unsigned int ops_after = 0;
+    size_t bytes_before = 0;
+    size_t bytes_after = 0;
+
+    unsigned int merged_transforms = 0;
+    unsigned int dropped_transforms = 0;
+    unsigned int collapsed_layers = 0;
+    unsigned int culled_ops = 0;
+
+    unsigned int ops_removed() const { return ops_before - ops_after; }
+    size_t bytes_removed() const { return bytes_before - bytes_after; }
+  };
+
+  /// Returns an optimized equivalent of |display_list| and, if |stats| is
+  /// non-null, fills it in with a summary of the work that was removed.
+  static sk_sp<DisplayList> Optimize(const sk_sp<DisplayList>& display_list,
+                                     Stats* stats = nullptr);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DisplayListOptimizer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_OPTIMIZER_H_
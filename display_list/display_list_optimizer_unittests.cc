@@ -0,0 +1,256 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_color_filter.h"
+#include "flutter/display_list/display_list_optimizer.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/display_list_testing.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<testing::DisplayListInvocationGroup> allGroups =
+    CreateAllGroups();
+
+TEST(DisplayListOptimizer, NullDisplayListReturnsNull) {
+  EXPECT_EQ(DisplayListOptimizer::Optimize(nullptr), nullptr);
+}
+
+TEST(DisplayListOptimizer, SingleOpDisplayListsAreNotGrown) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = group.variants[i].Build();
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + ")";
+
+      sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl);
+      ASSERT_NE(optimized, nullptr) << desc;
+      EXPECT_LE(optimized->op_count(), dl->op_count()) << desc;
+      EXPECT_EQ(optimized->bounds(), dl->bounds()) << desc;
+    }
+  }
+}
+
+TEST(DisplayListOptimizer, UnoptimizableDisplayListIsReturnedAsIs) {
+  DisplayListBuilder builder;
+  builder.translate(10, 10);
+  builder.drawRect({0, 0, 10, 10});
+  builder.scale(2, 2);
+  builder.drawOval({0, 0, 10, 10});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  EXPECT_EQ(DisplayListOptimizer::Optimize(dl, &stats), dl);
+  EXPECT_EQ(stats.ops_before, dl->op_count());
+  EXPECT_EQ(stats.ops_removed(), 0u);
+  EXPECT_EQ(stats.bytes_removed(), 0u);
+}
+
+TEST(DisplayListOptimizer, ConsecutiveTranslatesAreMerged) {
+  DisplayListBuilder builder;
+  builder.translate(10, 10);
+  builder.setColor(DlColor::kRed());
+  builder.translate(5, 15);
+  builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.translate(15, 25);
+  expected_builder.setColor(DlColor::kRed());
+  expected_builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl, &stats);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+  EXPECT_EQ(stats.merged_transforms, 1u);
+  EXPECT_EQ(stats.ops_removed(), 1u);
+  EXPECT_EQ(stats.bytes_before, dl->bytes(false));
+  EXPECT_EQ(stats.bytes_after, optimized->bytes(false));
+}
+
+TEST(DisplayListOptimizer, ConsecutiveScalesAreMerged) {
+  DisplayListBuilder builder;
+  builder.scale(2, 3);
+  builder.scale(4, 5);
+  builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.scale(8, 15);
+  expected_builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+}
+
+TEST(DisplayListOptimizer, TransformDiscardedByRestoreIsDropped) {
+  DisplayListBuilder builder;
+  builder.save();
+  builder.clipRect({0, 0, 50, 50}, ClipOp::kIntersect, false);
+  builder.drawRect({0, 0, 10, 10});
+  builder.translate(10, 10);
+  builder.restore();
+  builder.drawOval({0, 0, 10, 10});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.save();
+  expected_builder.clipRect({0, 0, 50, 50}, ClipOp::kIntersect, false);
+  expected_builder.drawRect({0, 0, 10, 10});
+  expected_builder.restore();
+  expected_builder.drawOval({0, 0, 10, 10});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl, &stats);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+  EXPECT_EQ(stats.dropped_transforms, 1u);
+}
+
+TEST(DisplayListOptimizer, SaveLayerWithSingleOpIsCollapsed) {
+  DlColor layer_color = DlColor::kBlack().withAlpha(0x7f);
+  DisplayListBuilder builder;
+  builder.setColor(layer_color);
+  builder.saveLayer(nullptr, true);
+  builder.setColor(DlColor::kRed());
+  builder.drawRect({0, 0, 10, 10});
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+  ASSERT_TRUE(dl->can_apply_group_opacity());
+
+  DisplayListBuilder expected_builder;
+  expected_builder.setColor(
+      DlColor::kRed().modulateOpacity(layer_color.getAlphaF()));
+  expected_builder.drawRect({0, 0, 10, 10});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl, &stats);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+  EXPECT_EQ(stats.collapsed_layers, 1u);
+}
+
+TEST(DisplayListOptimizer, SaveLayerWithMultipleOpsIsNotCollapsed) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kBlack().withAlpha(0x7f));
+  builder.saveLayer(nullptr, true);
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({20, 20, 30, 30});
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  EXPECT_EQ(DisplayListOptimizer::Optimize(dl), dl);
+}
+
+TEST(DisplayListOptimizer, SaveLayerWithColorFilterIsNotCollapsed) {
+  DlBlendColorFilter filter(DlColor::kBlue(), DlBlendMode::kSrcIn);
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kBlack().withAlpha(0x7f));
+  builder.setColorFilter(&filter);
+  builder.saveLayer(nullptr, true);
+  builder.setColorFilter(nullptr);
+  builder.drawRect({0, 0, 10, 10});
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  EXPECT_EQ(DisplayListOptimizer::Optimize(dl), dl);
+}
+
+TEST(DisplayListOptimizer, OpaqueDrawPaintCullsPreviousOps) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.save();
+  builder.translate(5, 5);
+  builder.drawOval({0, 0, 10, 10});
+  builder.restore();
+  builder.setColor(DlColor::kGreen());
+  builder.drawPaint();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.setColor(DlColor::kGreen());
+  expected_builder.drawPaint();
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl, &stats);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+  EXPECT_EQ(stats.culled_ops, 5u);
+}
+
+TEST(DisplayListOptimizer, SrcDrawColorCullsPreviousOps) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawColor(DlColor::kTransparent(), DlBlendMode::kSrc);
+  builder.drawOval({0, 0, 10, 10});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.drawColor(DlColor::kTransparent(), DlBlendMode::kSrc);
+  expected_builder.drawOval({0, 0, 10, 10});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+}
+
+TEST(DisplayListOptimizer, TranslucentDrawPaintDoesNotCull) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.setColor(DlColor::kGreen().withAlpha(0x7f));
+  builder.drawPaint();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  EXPECT_EQ(DisplayListOptimizer::Optimize(dl), dl);
+}
+
+TEST(DisplayListOptimizer, ClippedDrawPaintDoesNotCull) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.save();
+  builder.clipRect({0, 0, 5, 5}, ClipOp::kIntersect, false);
+  builder.drawPaint();
+  builder.restore();
+  sk_sp<DisplayList> dl = builder.Build();
+
+  EXPECT_EQ(DisplayListOptimizer::Optimize(dl), dl);
+}
+
+TEST(DisplayListOptimizer, OpaqueRectCullsContainedOpsWithRTree) {
+  DisplayListBuilder builder(true);
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawOval({50, 50, 60, 60});
+  builder.drawRect({0, 0, 30, 30});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListBuilder expected_builder(true);
+  expected_builder.drawOval({50, 50, 60, 60});
+  expected_builder.drawRect({0, 0, 30, 30});
+  sk_sp<DisplayList> expected = expected_builder.Build();
+
+  DisplayListOptimizer::Stats stats;
+  sk_sp<DisplayList> optimized = DisplayListOptimizer::Optimize(dl, &stats);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(optimized, expected));
+  EXPECT_TRUE(optimized->has_rtree());
+  EXPECT_EQ(stats.culled_ops, 1u);
+}
+
+TEST(DisplayListOptimizer, OpaqueRectDoesNotCullWithoutRTree) {
+  DisplayListBuilder builder(false);
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawRect({0, 0, 30, 30});
+  sk_sp<DisplayList> dl = builder.Build();
+
+  EXPECT_EQ(DisplayListOptimizer::Optimize(dl), dl);
+}
+
+}  // namespace testing
+}  // namespace flutter
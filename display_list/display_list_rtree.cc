@@ -35,15 +35,7 @@ DlRTree::DlRTree(const SkRect rects[],
 
   // Count the total number of nodes (leaf and internal) up front
   // so we can resize the vector just once.
-  uint32_t total_node_count = leaf_count;
-  uint32_t gen_count = leaf_count;
-  while (gen_count > 1) {
-    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
-    total_node_count += family_count;
-    gen_count = family_count;
-  }
-
-  nodes_.resize(total_node_count);
+  nodes_.resize(CountNodes(0, leaf_count));
 
   // Now place only the tracked rectangles into the nodes array
   // in the first leaf_count_ entries.
@@ -78,6 +70,38 @@ DlRTree::DlRTree(const SkRect rects[],
   // to what Skia found in their empirical browser tests.
   // ---
 
+  BuildGenerations(0, leaf_count);
+}
+
+DlRTree::DlRTree(std::vector<Node> nodes,
+                 int leaf_count,
+                 uint32_t gen_count,
+                 int invalid_id)
+    : nodes_(std::move(nodes)),
+      leaf_count_(leaf_count),
+      invalid_id_(invalid_id) {
+  if (gen_count == 0) {
+    FML_DCHECK(leaf_count <= 1);
+    FML_DCHECK(nodes_.size() == static_cast<size_t>(leaf_count));
+    return;
+  }
+  nodes_.resize(CountNodes(leaf_count, gen_count));
+  BuildGenerations(leaf_count, gen_count);
+}
+
+uint32_t DlRTree::CountNodes(uint32_t gen_start, uint32_t gen_count) {
+  uint32_t total_node_count = gen_start + gen_count;
+  while (gen_count > 1) {
+    uint32_t family_count = (gen_count + kMaxChildren - 1u) / kMaxChildren;
+    total_node_count += family_count;
+    gen_count = family_count;
+  }
+  return total_node_count;
+}
+
+void DlRTree::BuildGenerations(uint32_t gen_start, uint32_t gen_count) {
+  uint32_t total_node_count = nodes_.size();
+
   // Continually process the previous level (generation) of nodes,
   // combining them into a new generation of parent groups each grouping
   // at most |kMaxChildren| children and joining their bounds into its
@@ -85,8 +109,6 @@ DlRTree::DlRTree(const SkRect rects[],
   // Each generation will end up reduced by a factor of up to kMaxChildren
   // until there is just one node left, which is the root node of
   // the R-Tree.
-  uint32_t gen_start = 0;
-  gen_count = leaf_count;
   while (gen_count > 1) {
     uint32_t gen_end = gen_start + gen_count;
 
@@ -159,6 +181,46 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
   }
 }
 
+void DlRTree::searchAndConsolidateRects(const SkRect& query,
+                                        std::vector<SkRect>* results,
+                                        std::vector<int>* scratch) const {
+  FML_DCHECK(results != nullptr);
+  results->clear();
+  std::vector<int> local_scratch;
+  std::vector<int>& indices = scratch ? *scratch : local_scratch;
+  indices.clear();
+  search(query, &indices);
+
+  // This is the same consolidation as the std::list version below, but
+  // operating in place on the elements of the vector.
+  for (int index : indices) {
+    const SkRect& current_record_rect = bounds(index);
+    size_t first_intersecting = results->size();
+    for (size_t i = 0; i < results->size(); i++) {
+      if (SkRect::Intersects((*results)[i], current_record_rect)) {
+        first_intersecting = i;
+        (*results)[i].join(current_record_rect);
+        break;
+      }
+    }
+    if (first_intersecting == results->size()) {
+      results->push_back(current_record_rect);
+      continue;
+    }
+    // Fold any later results that now intersect the grown rect into it.
+    SkRect& joined = (*results)[first_intersecting];
+    size_t dest = first_intersecting + 1;
+    for (size_t i = first_intersecting + 1; i < results->size(); i++) {
+      if (SkRect::Intersects((*results)[i], joined)) {
+        joined.join((*results)[i]);
+      } else {
+        (*results)[dest++] = (*results)[i];
+      }
+    }
+    results->resize(dest);
+  }
+}
+
 std::list<SkRect> DlRTree::searchAndConsolidateRects(
     const SkRect& query) const {
   // Get the indexes for the operations that intersect with the query rect.
@@ -219,4 +281,45 @@ void DlRTree::search(const Node& parent,
   }
 }
 
+DlRTreeBuilder::DlRTreeBuilder(bool predicate(int id), int invalid_id)
+    : predicate_(predicate), invalid_id_(invalid_id) {}
+
+void DlRTreeBuilder::Add(const SkRect& rect, int id) {
+  if (rect.isEmpty() || !predicate_(id)) {
+    return;
+  }
+  uint32_t leaf_index = leaves_.size();
+  Node& leaf = leaves_.emplace_back();
+  leaf.bounds = rect;
+  leaf.id = id;
+  // Consecutive leaves are packed into parents of |kMaxChildren| as they
+  // arrive. Only the last parent can be partially filled.
+  if (leaf_index % DlRTree::kMaxChildren == 0) {
+    Node& parent = parents_.emplace_back();
+    parent.bounds = rect;
+    parent.child.index = leaf_index;
+    parent.child.count = 1;
+  } else {
+    Node& parent = parents_.back();
+    parent.bounds.join(rect);
+    parent.child.count++;
+  }
+  bounds_.join(rect);
+}
+
+sk_sp<DlRTree> DlRTreeBuilder::Build() const {
+  uint32_t leaf_count = leaves_.size();
+  if (leaf_count <= 1) {
+    // A single leaf is its own root.
+    return sk_sp<DlRTree>(new DlRTree(leaves_, leaf_count, 0, invalid_id_));
+  }
+  uint32_t gen_count = parents_.size();
+  std::vector<Node> nodes;
+  nodes.reserve(DlRTree::CountNodes(leaf_count, gen_count));
+  nodes.insert(nodes.end(), leaves_.begin(), leaves_.end());
+  nodes.insert(nodes.end(), parents_.begin(), parents_.end());
+  return sk_sp<DlRTree>(
+      new DlRTree(std::move(nodes), leaf_count, gen_count, invalid_id_));
+}
+
 }  // namespace flutter
@@ -115,9 +115,37 @@ class DlRTree : public SkRefCnt {
   /// exclusive.
   std::list<SkRect> searchAndConsolidateRects(const SkRect& query) const;
 
+  /// Same as |searchAndConsolidateRects(query)|, but stores the results
+  /// in |results| (replacing its contents) so that callers performing
+  /// repeated queries can reuse the storage of the vector. An optional
+  /// |scratch| vector can be provided to hold the intermediate search
+  /// results.
+  void searchAndConsolidateRects(const SkRect& query,
+                                 std::vector<SkRect>* results,
+                                 std::vector<int>* scratch = nullptr) const;
+
  private:
+  friend class DlRTreeBuilder;
+
   static constexpr SkRect empty_ = SkRect::MakeEmpty();
 
+  // Construct an R-Tree from a vector whose first |leaf_count| nodes are
+  // the leaves and whose next |gen_count| nodes are the parents of those
+  // leaves. The remaining nodes, if any, are overwritten.
+  DlRTree(std::vector<Node> nodes,
+          int leaf_count,
+          uint32_t gen_count,
+          int invalid_id);
+
+  // Returns the total number of nodes needed for a tree whose generation
+  // starting at |gen_start| has |gen_count| nodes.
+  static uint32_t CountNodes(uint32_t gen_start, uint32_t gen_count);
+
+  // Builds the generations of internal nodes above the generation of
+  // |gen_count| nodes starting at |gen_start| until there is just one
+  // root node left.
+  void BuildGenerations(uint32_t gen_start, uint32_t gen_count);
+
   void search(const Node& parent,
               const SkRect& query,
               std::vector<int>* results) const;
@@ -127,6 +155,42 @@ class DlRTree : public SkRefCnt {
   int invalid_id_;
 };
 
+/// Incrementally assembles a DlRTree from rectangles that are added one at
+/// a time, in order, such as the bounds of the rendering operations being
+/// recorded by a DisplayListBuilder.
+///
+/// The leaf nodes and the first generation of internal nodes are packed as
+/// the rectangles arrive so that |Build| only has to construct the much
+/// smaller upper generations of the tree. Rectangles that are empty or
+/// whose IDs are rejected by the predicate are dropped as they are added.
+class DlRTreeBuilder {
+ public:
+  explicit DlRTreeBuilder(
+      bool predicate(int id) = [](int) { return true; },
+      int invalid_id = -1);
+
+  void Add(const SkRect& rect, int id);
+
+  /// The number of rectangles retained so far.
+  int leaf_count() const { return leaves_.size(); }
+
+  /// The union of the bounds of all retained rectangles.
+  const SkRect& bounds() const { return bounds_; }
+
+  /// Constructs the R-Tree for the rectangles retained so far. The builder
+  /// can continue to be used afterwards.
+  sk_sp<DlRTree> Build() const;
+
+ private:
+  using Node = DlRTree::Node;
+
+  bool (*predicate_)(int id);
+  const int invalid_id_;
+  std::vector<Node> leaves_;
+  std::vector<Node> parents_;
+  SkRect bounds_ = SkRect::MakeEmpty();
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_DISPLAY_LIST_RTREE_H_
@@ -300,5 +300,86 @@ TEST(DisplayListRTree, OverlappingRects) {
   EXPECT_EQ(list.front(), SkRect::MakeLTRB(0, 0, 70, 70));
 }
 
+TEST(DisplayListRTree, VectorConsolidationMatchesList) {
+  SkRect rects[] = {
+      {0, 0, 10, 10},   {5, 5, 15, 15},   {40, 0, 50, 10},
+      {100, 0, 110, 10}, {8, 8, 45, 9},   {200, 200, 210, 210},
+  };
+  DlRTree tree(rects, 6);
+  std::vector<SkRect> results;
+  std::vector<int> scratch;
+  SkRect queries[] = {
+      {0, 0, 300, 300},
+      {0, 0, 20, 20},
+      {90, 0, 300, 300},
+      {500, 500, 600, 600},
+  };
+  for (const SkRect& query : queries) {
+    auto list = tree.searchAndConsolidateRects(query);
+    tree.searchAndConsolidateRects(query, &results, &scratch);
+    ASSERT_EQ(results.size(), list.size());
+    size_t i = 0;
+    for (const SkRect& rect : list) {
+      EXPECT_EQ(results[i++], rect);
+    }
+  }
+}
+
+TEST(DisplayListRTree, BuilderMatchesConstructor) {
+  for (int count = 0; count < 300; count += (count < 30 ? 1 : 17)) {
+    std::vector<SkRect> rects;
+    std::vector<int> ids;
+    DlRTreeBuilder builder([](int id) { return id % 5 != 0; });
+    for (int i = 0; i < count; i++) {
+      SkScalar x = (i % 20) * 10;
+      SkScalar y = (i / 20) * 10;
+      // Every 7th rect is empty and should be dropped.
+      SkRect rect = (i % 7 == 3) ? SkRect::MakeXYWH(x, y, 0, 5)
+                                 : SkRect::MakeXYWH(x, y, 15, 15);
+      rects.push_back(rect);
+      ids.push_back(i);
+      builder.Add(rect, i);
+    }
+    DlRTree tree(rects.data(), count, ids.data(),
+                 [](int id) { return id % 5 != 0; });
+    auto built = builder.Build();
+    ASSERT_EQ(built->leaf_count(), tree.leaf_count()) << count;
+    EXPECT_EQ(builder.leaf_count(), tree.leaf_count()) << count;
+
+    SkRect queries[] = {
+        {-1000, -1000, 1000, 1000},
+        {0, 0, 1, 1},
+        {25, 25, 75, 75},
+        {190, 0, 200, 200},
+    };
+    for (const SkRect& query : queries) {
+      std::vector<int> expected;
+      std::vector<int> actual;
+      tree.search(query, &expected);
+      built->search(query, &actual);
+      ASSERT_EQ(actual.size(), expected.size()) << count;
+      for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(built->id(actual[i]), tree.id(expected[i])) << count;
+        EXPECT_EQ(built->bounds(actual[i]), tree.bounds(expected[i])) << count;
+      }
+    }
+  }
+}
+
+TEST(DisplayListRTree, BuilderCanBuildRepeatedly) {
+  DlRTreeBuilder builder;
+  builder.Add(SkRect::MakeLTRB(0, 0, 10, 10), 0);
+  auto first = builder.Build();
+  EXPECT_EQ(first->leaf_count(), 1);
+  EXPECT_EQ(first->node_count(), 1);
+
+  builder.Add(SkRect::MakeLTRB(20, 20, 30, 30), 1);
+  auto second = builder.Build();
+  EXPECT_EQ(first->leaf_count(), 1);
+  EXPECT_EQ(second->leaf_count(), 2);
+  EXPECT_EQ(second->node_count(), 3);
+  EXPECT_EQ(builder.bounds(), SkRect::MakeLTRB(0, 0, 30, 30));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,1468 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_serialization.h"
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_dispatcher.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+// Adding, removing or reordering ops changes the record type values written
+// into the stream, so the serialization version must be bumped along with
+// the expected op count below.
+#define DL_OP_COUNT(name) +1
+static constexpr int kSerializedOpCount =
+    0 FOR_EACH_DISPLAY_LIST_OP(DL_OP_COUNT);
+#undef DL_OP_COUNT
+static_assert(kSerializedOpCount == 67,
+              "DisplayList op set changed, bump DisplayListSerializer::kVersion"
+              " and update the expected op count");
+
+namespace {
+
+// All records and the header are padded to this alignment so that array
+// payloads can be dispatched directly out of the mapping.
+constexpr size_t kRecordAlignment = 4;
+
+constexpr uint32_t kFlagCanApplyGroupOpacity = 1 << 0;
+
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t op_count;
+  uint32_t flags;
+  SkRect bounds;
+  uint32_t ops_size;
+  uint32_t reserved;
+};
+static_assert(sizeof(SerializedHeader) % kRecordAlignment == 0);
+
+// Each record starts with a 4 byte header holding the op type in the low
+// 8 bits and the total record size (including the header) in the high 24
+// bits, mirroring the layout of DLOp.
+constexpr uint32_t kMaxRecordSize = (1 << 24) - 1;
+
+// The flags byte written in front of the vertex arrays of a DrawVertices
+// record.
+constexpr uint32_t kVerticesHasTextureCoordinates = 1 << 0;
+constexpr uint32_t kVerticesHasColors = 1 << 1;
+
+class Encoder {
+ public:
+  explicit Encoder(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+  void BeginRecord(DisplayListOpType type) {
+    FML_DCHECK(record_start_ == kNoRecord);
+    record_start_ = buffer_.size();
+    record_type_ = type;
+    Write<uint32_t>(0);
+  }
+
+  void EndRecord() {
+    FML_DCHECK(record_start_ != kNoRecord);
+    Pad();
+    size_t size = buffer_.size() - record_start_;
+    FML_CHECK(size <= kMaxRecordSize);
+    uint32_t header = static_cast<uint32_t>(record_type_) |
+                      (static_cast<uint32_t>(size) << 8);
+    memcpy(buffer_.data() + record_start_, &header, sizeof(header));
+    record_start_ = kNoRecord;
+    op_count_++;
+  }
+
+  void Record(DisplayListOpType type) {
+    BeginRecord(type);
+    EndRecord();
+  }
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteArray(const T* values, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(alignof(T) <= kRecordAlignment);
+    WriteBytes(values, sizeof(T) * count);
+    Pad();
+  }
+
+  void WriteBool(bool value) { Write<uint32_t>(value ? 1 : 0); }
+
+  void WriteRRect(const SkRRect& rrect) {
+    uint8_t storage[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(storage);
+    WriteBytes(storage, sizeof(storage));
+    Pad();
+  }
+
+  void WritePath(const SkPath& path) {
+    size_t size = path.writeToMemory(nullptr);
+    Write<uint32_t>(static_cast<uint32_t>(size));
+    size_t offset = buffer_.size();
+    buffer_.resize(offset + size);
+    path.writeToMemory(buffer_.data() + offset);
+    Pad();
+  }
+
+  void WriteMatrix(const SkMatrix* matrix) {
+    WriteBool(matrix != nullptr);
+    if (matrix) {
+      SkScalar values[9];
+      matrix->get9(values);
+      WriteArray(values, 9);
+    }
+  }
+
+  template <typename T, typename R>
+  void WriteRef(std::vector<T>& table, R&& ref) {
+    Write<uint32_t>(static_cast<uint32_t>(table.size()));
+    table.emplace_back(std::forward<R>(ref));
+  }
+
+  unsigned int op_count() const { return op_count_; }
+
+ private:
+  static constexpr size_t kNoRecord = ~static_cast<size_t>(0);
+
+  void WriteBytes(const void* data, size_t size) {
+    if (size == 0) {
+      return;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+
+  void Pad() {
+    size_t remainder = buffer_.size() % kRecordAlignment;
+    if (remainder != 0) {
+      buffer_.resize(buffer_.size() + kRecordAlignment - remainder, 0);
+    }
+  }
+
+  std::vector<uint8_t>& buffer_;
+  size_t record_start_ = kNoRecord;
+  DisplayListOpType record_type_ = DisplayListOpType::kSave;
+  unsigned int op_count_ = 0;
+};
+
+class Decoder {
+ public:
+  Decoder(const uint8_t* ptr, size_t size) : ptr_(ptr), end_(ptr + size) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    memcpy(value, ptr_, sizeof(T));
+    ptr_ += sizeof(T);
+    return true;
+  }
+
+  // Returns a pointer directly into the encoded data, no copy is made.
+  template <typename T>
+  const T* ReadArray(size_t count) {
+    static_assert(alignof(T) <= kRecordAlignment);
+    if (count > remaining() / sizeof(T)) {
+      return nullptr;
+    }
+    const T* values = reinterpret_cast<const T*>(ptr_);
+    ptr_ += sizeof(T) * count;
+    return Align() ? values : nullptr;
+  }
+
+  bool ReadBool(bool* value) {
+    uint32_t encoded;
+    if (!Read(&encoded) || encoded > 1) {
+      return false;
+    }
+    *value = encoded != 0;
+    return true;
+  }
+
+  bool ReadRRect(SkRRect* rrect) {
+    if (remaining() < SkRRect::kSizeInMemory ||
+        rrect->readFromMemory(ptr_, SkRRect::kSizeInMemory) == 0) {
+      return false;
+    }
+    ptr_ += SkRRect::kSizeInMemory;
+    return Align();
+  }
+
+  bool ReadPath(SkPath* path) {
+    uint32_t size;
+    if (!Read(&size) || size > remaining() ||
+        path->readFromMemory(ptr_, size) != size) {
+      return false;
+    }
+    ptr_ += size;
+    return Align();
+  }
+
+  bool ReadMatrix(SkMatrix* matrix, bool* has_matrix) {
+    if (!ReadBool(has_matrix)) {
+      return false;
+    }
+    if (*has_matrix) {
+      const SkScalar* values = ReadArray<SkScalar>(9);
+      if (!values) {
+        return false;
+      }
+      matrix->set9(values);
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool ReadRef(const std::vector<T>& table, const T** ref) {
+    uint32_t index;
+    if (!Read(&index) || index >= table.size()) {
+      return false;
+    }
+    *ref = &table[index];
+    return true;
+  }
+
+ private:
+  size_t remaining() const { return end_ - ptr_; }
+
+  bool Align() {
+    size_t remainder = reinterpret_cast<uintptr_t>(ptr_) % kRecordAlignment;
+    if (remainder != 0) {
+      size_t padding = kRecordAlignment - remainder;
+      if (padding > remaining()) {
+        return false;
+      }
+      ptr_ += padding;
+    }
+    return true;
+  }
+
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+};
+
+// A Dispatcher that encodes every call it receives into a record.
+class SerializingDispatcher final : public Dispatcher {
+ public:
+  SerializingDispatcher(std::vector<uint8_t>& buffer,
+                        DisplayListSideTable& table)
+      : encoder_(buffer), table_(table) {}
+
+  unsigned int op_count() const { return encoder_.op_count(); }
+
+  void setAntiAlias(bool aa) override {
+    WriteBoolOp(DisplayListOpType::kSetAntiAlias, aa);
+  }
+  void setDither(bool dither) override {
+    WriteBoolOp(DisplayListOpType::kSetDither, dither);
+  }
+  void setInvertColors(bool invert) override {
+    WriteBoolOp(DisplayListOpType::kSetInvertColors, invert);
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    WriteValueOp(DisplayListOpType::kSetStrokeCap, cap);
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    WriteValueOp(DisplayListOpType::kSetStrokeJoin, join);
+  }
+  void setStyle(DlDrawStyle style) override {
+    WriteValueOp(DisplayListOpType::kSetStyle, style);
+  }
+  void setStrokeWidth(float width) override {
+    WriteValueOp(DisplayListOpType::kSetStrokeWidth, width);
+  }
+  void setStrokeMiter(float limit) override {
+    WriteValueOp(DisplayListOpType::kSetStrokeMiter, limit);
+  }
+  void setColor(DlColor color) override {
+    WriteValueOp(DisplayListOpType::kSetColor, color);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    WriteValueOp(DisplayListOpType::kSetBlendMode, mode);
+  }
+
+  void setColorSource(const DlColorSource* source) override {
+    if (source == nullptr) {
+      encoder_.Record(DisplayListOpType::kClearColorSource);
+      return;
+    }
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+      case DlColorSourceType::kLinearGradient:
+      case DlColorSourceType::kRadialGradient:
+      case DlColorSourceType::kConicalGradient:
+      case DlColorSourceType::kSweepGradient:
+        encoder_.BeginRecord(DisplayListOpType::kSetPodColorSource);
+        WriteColorSource(source);
+        encoder_.EndRecord();
+        break;
+      case DlColorSourceType::kImage:
+        WriteRefOp(DisplayListOpType::kSetImageColorSource,
+                   table_.color_sources, source->shared());
+        break;
+      case DlColorSourceType::kRuntimeEffect:
+        WriteRefOp(DisplayListOpType::kSetRuntimeEffectColorSource,
+                   table_.color_sources, source->shared());
+        break;
+#ifdef IMPELLER_ENABLE_3D
+      case DlColorSourceType::kScene:
+        WriteRefOp(DisplayListOpType::kSetSceneColorSource,
+                   table_.color_sources, source->shared());
+        break;
+#endif  // IMPELLER_ENABLE_3D
+    }
+  }
+
+  void setColorFilter(const DlColorFilter* filter) override {
+    if (filter == nullptr) {
+      encoder_.Record(DisplayListOpType::kClearColorFilter);
+      return;
+    }
+    encoder_.BeginRecord(DisplayListOpType::kSetPodColorFilter);
+    encoder_.Write(filter->type());
+    switch (filter->type()) {
+      case DlColorFilterType::kBlend: {
+        const DlBlendColorFilter* blend = filter->asBlend();
+        encoder_.Write(blend->color());
+        encoder_.Write(blend->mode());
+        break;
+      }
+      case DlColorFilterType::kMatrix: {
+        float matrix[20];
+        filter->asMatrix()->get_matrix(matrix);
+        encoder_.WriteArray(matrix, 20);
+        break;
+      }
+      case DlColorFilterType::kSrgbToLinearGamma:
+      case DlColorFilterType::kLinearToSrgbGamma:
+        break;
+    }
+    encoder_.EndRecord();
+  }
+
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    if (filter == nullptr) {
+      encoder_.Record(DisplayListOpType::kClearMaskFilter);
+      return;
+    }
+    encoder_.BeginRecord(DisplayListOpType::kSetPodMaskFilter);
+    encoder_.Write(filter->type());
+    switch (filter->type()) {
+      case DlMaskFilterType::kBlur: {
+        const DlBlurMaskFilter* blur = filter->asBlur();
+        encoder_.Write(blur->style());
+        encoder_.Write(blur->sigma());
+        encoder_.WriteBool(blur->respectCTM());
+        break;
+      }
+    }
+    encoder_.EndRecord();
+  }
+
+  void setPathEffect(const DlPathEffect* effect) override {
+    if (effect == nullptr) {
+      encoder_.Record(DisplayListOpType::kClearPathEffect);
+      return;
+    }
+    WriteRefOp(DisplayListOpType::kSetPodPathEffect, table_.path_effects,
+               effect->shared());
+  }
+
+  void setImageFilter(const DlImageFilter* filter) override {
+    if (filter == nullptr) {
+      encoder_.Record(DisplayListOpType::kClearImageFilter);
+      return;
+    }
+    WriteRefOp(DisplayListOpType::kSetSharedImageFilter, table_.image_filters,
+               filter->shared());
+  }
+
+  void save() override { encoder_.Record(DisplayListOpType::kSave); }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    DisplayListOpType type;
+    if (backdrop) {
+      type = bounds ? DisplayListOpType::kSaveLayerBackdropBounds
+                    : DisplayListOpType::kSaveLayerBackdrop;
+    } else {
+      type = bounds ? DisplayListOpType::kSaveLayerBounds
+                    : DisplayListOpType::kSaveLayer;
+    }
+    encoder_.BeginRecord(type);
+    encoder_.WriteBool(options.renders_with_attributes());
+    if (bounds) {
+      encoder_.Write(*bounds);
+    }
+    if (backdrop) {
+      encoder_.WriteRef(table_.image_filters, backdrop->shared());
+    }
+    encoder_.EndRecord();
+  }
+  void restore() override { encoder_.Record(DisplayListOpType::kRestore); }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    WritePointOp(DisplayListOpType::kTranslate, {tx, ty});
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    WritePointOp(DisplayListOpType::kScale, {sx, sy});
+  }
+  void rotate(SkScalar degrees) override {
+    WriteValueOp(DisplayListOpType::kRotate, degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    WritePointOp(DisplayListOpType::kSkew, {sx, sy});
+  }
+
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    const SkScalar values[] = {mxx, mxy, mxt, myx, myy, myt};
+    encoder_.BeginRecord(DisplayListOpType::kTransform2DAffine);
+    encoder_.WriteArray(values, 6);
+    encoder_.EndRecord();
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    const SkScalar values[] = {mxx, mxy, mxz, mxt,
+                               myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt,
+                               mwx, mwy, mwz, mwt};
+    encoder_.BeginRecord(DisplayListOpType::kTransformFullPerspective);
+    encoder_.WriteArray(values, 16);
+    encoder_.EndRecord();
+  }
+  // clang-format on
+  void transformReset() override {
+    encoder_.Record(DisplayListOpType::kTransformReset);
+  }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    encoder_.BeginRecord(clip_op == ClipOp::kIntersect
+                             ? DisplayListOpType::kClipIntersectRect
+                             : DisplayListOpType::kClipDifferenceRect);
+    encoder_.WriteBool(is_aa);
+    encoder_.Write(rect);
+    encoder_.EndRecord();
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    encoder_.BeginRecord(clip_op == ClipOp::kIntersect
+                             ? DisplayListOpType::kClipIntersectRRect
+                             : DisplayListOpType::kClipDifferenceRRect);
+    encoder_.WriteBool(is_aa);
+    encoder_.WriteRRect(rrect);
+    encoder_.EndRecord();
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    encoder_.BeginRecord(clip_op == ClipOp::kIntersect
+                             ? DisplayListOpType::kClipIntersectPath
+                             : DisplayListOpType::kClipDifferencePath);
+    encoder_.WriteBool(is_aa);
+    encoder_.WritePath(path);
+    encoder_.EndRecord();
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawColor);
+    encoder_.Write(color);
+    encoder_.Write(mode);
+    encoder_.EndRecord();
+  }
+  void drawPaint() override { encoder_.Record(DisplayListOpType::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawLine);
+    encoder_.Write(p0);
+    encoder_.Write(p1);
+    encoder_.EndRecord();
+  }
+  void drawRect(const SkRect& rect) override {
+    WriteValueOp(DisplayListOpType::kDrawRect, rect);
+  }
+  void drawOval(const SkRect& bounds) override {
+    WriteValueOp(DisplayListOpType::kDrawOval, bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawCircle);
+    encoder_.Write(center);
+    encoder_.Write(radius);
+    encoder_.EndRecord();
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawRRect);
+    encoder_.WriteRRect(rrect);
+    encoder_.EndRecord();
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawDRRect);
+    encoder_.WriteRRect(outer);
+    encoder_.WriteRRect(inner);
+    encoder_.EndRecord();
+  }
+  void drawPath(const SkPath& path) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawPath);
+    encoder_.WritePath(path);
+    encoder_.EndRecord();
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawArc);
+    encoder_.Write(oval_bounds);
+    encoder_.Write(start_degrees);
+    encoder_.Write(sweep_degrees);
+    encoder_.WriteBool(use_center);
+    encoder_.EndRecord();
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    switch (mode) {
+      case PointMode::kPoints:
+        encoder_.BeginRecord(DisplayListOpType::kDrawPoints);
+        break;
+      case PointMode::kLines:
+        encoder_.BeginRecord(DisplayListOpType::kDrawLines);
+        break;
+      case PointMode::kPolygon:
+        encoder_.BeginRecord(DisplayListOpType::kDrawPolygon);
+        break;
+    }
+    encoder_.Write(count);
+    encoder_.WriteArray(points, count);
+    encoder_.EndRecord();
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    uint32_t flags = 0;
+    if (vertices->texture_coordinates()) {
+      flags |= kVerticesHasTextureCoordinates;
+    }
+    if (vertices->colors()) {
+      flags |= kVerticesHasColors;
+    }
+    encoder_.BeginRecord(DisplayListOpType::kDrawVertices);
+    encoder_.Write(mode);
+    encoder_.Write(vertices->mode());
+    encoder_.Write(flags);
+    encoder_.Write<int32_t>(vertices->vertex_count());
+    encoder_.Write<int32_t>(vertices->index_count());
+    encoder_.WriteArray(vertices->vertices(), vertices->vertex_count());
+    if (vertices->texture_coordinates()) {
+      encoder_.WriteArray(vertices->texture_coordinates(),
+                          vertices->vertex_count());
+    }
+    if (vertices->colors()) {
+      encoder_.WriteArray(vertices->colors(), vertices->vertex_count());
+    }
+    if (vertices->index_count() > 0) {
+      encoder_.WriteArray(vertices->indices(), vertices->index_count());
+    }
+    encoder_.EndRecord();
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    encoder_.BeginRecord(render_with_attributes
+                             ? DisplayListOpType::kDrawImageWithAttr
+                             : DisplayListOpType::kDrawImage);
+    encoder_.WriteRef(table_.images, image);
+    encoder_.Write(point);
+    encoder_.Write(sampling);
+    encoder_.EndRecord();
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SkCanvas::SrcRectConstraint constraint) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawImageRect);
+    encoder_.WriteRef(table_.images, image);
+    encoder_.Write(src);
+    encoder_.Write(dst);
+    encoder_.Write(sampling);
+    encoder_.WriteBool(render_with_attributes);
+    encoder_.Write(constraint);
+    encoder_.EndRecord();
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    encoder_.BeginRecord(render_with_attributes
+                             ? DisplayListOpType::kDrawImageNineWithAttr
+                             : DisplayListOpType::kDrawImageNine);
+    encoder_.WriteRef(table_.images, image);
+    encoder_.Write(center);
+    encoder_.Write(dst);
+    encoder_.Write(filter);
+    encoder_.EndRecord();
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    encoder_.BeginRecord(cull_rect ? DisplayListOpType::kDrawAtlasCulled
+                                   : DisplayListOpType::kDrawAtlas);
+    encoder_.WriteRef(table_.images, atlas);
+    encoder_.Write<int32_t>(count);
+    encoder_.Write(mode);
+    encoder_.Write(sampling);
+    encoder_.WriteBool(colors != nullptr);
+    encoder_.WriteBool(render_with_attributes);
+    if (cull_rect) {
+      encoder_.Write(*cull_rect);
+    }
+    encoder_.WriteArray(xform, count);
+    encoder_.WriteArray(tex, count);
+    if (colors) {
+      encoder_.WriteArray(colors, count);
+    }
+    encoder_.EndRecord();
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list) override {
+    WriteRefOp(DisplayListOpType::kDrawDisplayList, table_.display_lists,
+               display_list);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    encoder_.BeginRecord(DisplayListOpType::kDrawTextBlob);
+    encoder_.WriteRef(table_.text_blobs, blob);
+    encoder_.Write(x);
+    encoder_.Write(y);
+    encoder_.EndRecord();
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    encoder_.BeginRecord(transparent_occluder
+                             ? DisplayListOpType::kDrawShadowTransparentOccluder
+                             : DisplayListOpType::kDrawShadow);
+    encoder_.Write(color);
+    encoder_.Write(elevation);
+    encoder_.Write(dpr);
+    encoder_.WritePath(path);
+    encoder_.EndRecord();
+  }
+
+ private:
+  void WriteBoolOp(DisplayListOpType type, bool value) {
+    encoder_.BeginRecord(type);
+    encoder_.WriteBool(value);
+    encoder_.EndRecord();
+  }
+
+  template <typename T>
+  void WriteValueOp(DisplayListOpType type, const T& value) {
+    encoder_.BeginRecord(type);
+    encoder_.Write(value);
+    encoder_.EndRecord();
+  }
+
+  void WritePointOp(DisplayListOpType type, const SkPoint& point) {
+    WriteValueOp(type, point);
+  }
+
+  template <typename T, typename R>
+  void WriteRefOp(DisplayListOpType type, std::vector<T>& table, R&& ref) {
+    encoder_.BeginRecord(type);
+    encoder_.WriteRef(table, std::forward<R>(ref));
+    encoder_.EndRecord();
+  }
+
+  void WriteGradient(const DlGradientColorSourceBase* gradient) {
+    encoder_.Write(gradient->tile_mode());
+    encoder_.WriteMatrix(gradient->matrix_ptr());
+    encoder_.Write<uint32_t>(gradient->stop_count());
+    encoder_.WriteArray(gradient->colors(), gradient->stop_count());
+    encoder_.WriteArray(gradient->stops(), gradient->stop_count());
+  }
+
+  void WriteColorSource(const DlColorSource* source) {
+    encoder_.Write(source->type());
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+        encoder_.Write(source->asColor()->color());
+        break;
+      case DlColorSourceType::kLinearGradient: {
+        const DlLinearGradientColorSource* linear = source->asLinearGradient();
+        encoder_.Write(linear->start_point());
+        encoder_.Write(linear->end_point());
+        WriteGradient(linear);
+        break;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        const DlRadialGradientColorSource* radial = source->asRadialGradient();
+        encoder_.Write(radial->center());
+        encoder_.Write(radial->radius());
+        WriteGradient(radial);
+        break;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        const DlConicalGradientColorSource* conical =
+            source->asConicalGradient();
+        encoder_.Write(conical->start_center());
+        encoder_.Write(conical->start_radius());
+        encoder_.Write(conical->end_center());
+        encoder_.Write(conical->end_radius());
+        WriteGradient(conical);
+        break;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        const DlSweepGradientColorSource* sweep = source->asSweepGradient();
+        encoder_.Write(sweep->center());
+        encoder_.Write(sweep->start());
+        encoder_.Write(sweep->end());
+        WriteGradient(sweep);
+        break;
+      }
+      default:
+        FML_DCHECK(false);
+        break;
+    }
+  }
+
+  Encoder encoder_;
+  DisplayListSideTable& table_;
+};
+
+struct GradientParams {
+  DlTileMode tile_mode;
+  SkMatrix matrix;
+  bool has_matrix;
+  uint32_t stop_count;
+  const DlColor* colors;
+  const float* stops;
+
+  const SkMatrix* matrix_ptr() const { return has_matrix ? &matrix : nullptr; }
+};
+
+bool ReadGradient(Decoder& decoder, GradientParams* params) {
+  return decoder.Read(&params->tile_mode) &&
+         decoder.ReadMatrix(&params->matrix, &params->has_matrix) &&
+         decoder.Read(&params->stop_count) &&
+         (params->colors = decoder.ReadArray<DlColor>(params->stop_count)) &&
+         (params->stops = decoder.ReadArray<float>(params->stop_count));
+}
+
+bool DispatchColorSource(Decoder& decoder, Dispatcher& dispatcher) {
+  DlColorSourceType type;
+  if (!decoder.Read(&type)) {
+    return false;
+  }
+  GradientParams gradient;
+  std::shared_ptr<DlColorSource> source;
+  switch (type) {
+    case DlColorSourceType::kColor: {
+      DlColor color;
+      if (!decoder.Read(&color)) {
+        return false;
+      }
+      DlColorColorSource color_source(color);
+      dispatcher.setColorSource(&color_source);
+      return true;
+    }
+    case DlColorSourceType::kLinearGradient: {
+      SkPoint start, end;
+      if (!decoder.Read(&start) || !decoder.Read(&end) ||
+          !ReadGradient(decoder, &gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeLinear(
+          start, end, gradient.stop_count, gradient.colors, gradient.stops,
+          gradient.tile_mode, gradient.matrix_ptr());
+      break;
+    }
+    case DlColorSourceType::kRadialGradient: {
+      SkPoint center;
+      SkScalar radius;
+      if (!decoder.Read(&center) || !decoder.Read(&radius) ||
+          !ReadGradient(decoder, &gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeRadial(
+          center, radius, gradient.stop_count, gradient.colors, gradient.stops,
+          gradient.tile_mode, gradient.matrix_ptr());
+      break;
+    }
+    case DlColorSourceType::kConicalGradient: {
+      SkPoint start_center, end_center;
+      SkScalar start_radius, end_radius;
+      if (!decoder.Read(&start_center) || !decoder.Read(&start_radius) ||
+          !decoder.Read(&end_center) || !decoder.Read(&end_radius) ||
+          !ReadGradient(decoder, &gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeConical(
+          start_center, start_radius, end_center, end_radius,
+          gradient.stop_count, gradient.colors, gradient.stops,
+          gradient.tile_mode, gradient.matrix_ptr());
+      break;
+    }
+    case DlColorSourceType::kSweepGradient: {
+      SkPoint center;
+      SkScalar start, end;
+      if (!decoder.Read(&center) || !decoder.Read(&start) ||
+          !decoder.Read(&end) || !ReadGradient(decoder, &gradient)) {
+        return false;
+      }
+      source = DlColorSource::MakeSweep(
+          center, start, end, gradient.stop_count, gradient.colors,
+          gradient.stops, gradient.tile_mode, gradient.matrix_ptr());
+      break;
+    }
+    default:
+      return false;
+  }
+  if (!source) {
+    return false;
+  }
+  dispatcher.setColorSource(source.get());
+  return true;
+}
+
+bool DispatchColorFilter(Decoder& decoder, Dispatcher& dispatcher) {
+  DlColorFilterType type;
+  if (!decoder.Read(&type)) {
+    return false;
+  }
+  switch (type) {
+    case DlColorFilterType::kBlend: {
+      DlColor color;
+      DlBlendMode mode;
+      if (!decoder.Read(&color) || !decoder.Read(&mode)) {
+        return false;
+      }
+      DlBlendColorFilter filter(color, mode);
+      dispatcher.setColorFilter(&filter);
+      return true;
+    }
+    case DlColorFilterType::kMatrix: {
+      const float* matrix = decoder.ReadArray<float>(20);
+      if (!matrix) {
+        return false;
+      }
+      DlMatrixColorFilter filter(matrix);
+      dispatcher.setColorFilter(&filter);
+      return true;
+    }
+    case DlColorFilterType::kSrgbToLinearGamma:
+      dispatcher.setColorFilter(DlSrgbToLinearGammaColorFilter::instance.get());
+      return true;
+    case DlColorFilterType::kLinearToSrgbGamma:
+      dispatcher.setColorFilter(DlLinearToSrgbGammaColorFilter::instance.get());
+      return true;
+  }
+  return false;
+}
+
+bool DispatchMaskFilter(Decoder& decoder, Dispatcher& dispatcher) {
+  DlMaskFilterType type;
+  if (!decoder.Read(&type)) {
+    return false;
+  }
+  switch (type) {
+    case DlMaskFilterType::kBlur: {
+      SkBlurStyle style;
+      SkScalar sigma;
+      bool respect_ctm;
+      if (!decoder.Read(&style) || !decoder.Read(&sigma) ||
+          !decoder.ReadBool(&respect_ctm)) {
+        return false;
+      }
+      DlBlurMaskFilter filter(style, sigma, respect_ctm);
+      dispatcher.setMaskFilter(&filter);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DispatchRecord(DisplayListOpType type,
+                    Decoder& decoder,
+                    const DisplayListSideTable& table,
+                    Dispatcher& dispatcher) {
+  switch (type) {
+#define DL_DISPATCH_VALUE(name, value_type, method) \
+  case DisplayListOpType::k##name: {                \
+    value_type value;                               \
+    if (!decoder.Read(&value))                      \
+      return false;                                 \
+    dispatcher.method(value);                       \
+    return true;                                    \
+  }
+
+    case DisplayListOpType::kSetAntiAlias: {
+      bool value;
+      if (!decoder.ReadBool(&value)) {
+        return false;
+      }
+      dispatcher.setAntiAlias(value);
+      return true;
+    }
+    case DisplayListOpType::kSetDither: {
+      bool value;
+      if (!decoder.ReadBool(&value)) {
+        return false;
+      }
+      dispatcher.setDither(value);
+      return true;
+    }
+    case DisplayListOpType::kSetInvertColors: {
+      bool value;
+      if (!decoder.ReadBool(&value)) {
+        return false;
+      }
+      dispatcher.setInvertColors(value);
+      return true;
+    }
+
+      DL_DISPATCH_VALUE(SetStrokeCap, DlStrokeCap, setStrokeCap)
+      DL_DISPATCH_VALUE(SetStrokeJoin, DlStrokeJoin, setStrokeJoin)
+      DL_DISPATCH_VALUE(SetStyle, DlDrawStyle, setStyle)
+      DL_DISPATCH_VALUE(SetStrokeWidth, float, setStrokeWidth)
+      DL_DISPATCH_VALUE(SetStrokeMiter, float, setStrokeMiter)
+      DL_DISPATCH_VALUE(SetColor, DlColor, setColor)
+      DL_DISPATCH_VALUE(SetBlendMode, DlBlendMode, setBlendMode)
+      DL_DISPATCH_VALUE(Rotate, SkScalar, rotate)
+      DL_DISPATCH_VALUE(DrawRect, SkRect, drawRect)
+      DL_DISPATCH_VALUE(DrawOval, SkRect, drawOval)
+#undef DL_DISPATCH_VALUE
+
+    case DisplayListOpType::kClearPathEffect:
+      dispatcher.setPathEffect(nullptr);
+      return true;
+    case DisplayListOpType::kSetPodPathEffect: {
+      const std::shared_ptr<const DlPathEffect>* effect;
+      if (!decoder.ReadRef(table.path_effects, &effect)) {
+        return false;
+      }
+      dispatcher.setPathEffect(effect->get());
+      return true;
+    }
+
+    case DisplayListOpType::kClearColorFilter:
+      dispatcher.setColorFilter(nullptr);
+      return true;
+    case DisplayListOpType::kSetPodColorFilter:
+      return DispatchColorFilter(decoder, dispatcher);
+
+    case DisplayListOpType::kClearColorSource:
+      dispatcher.setColorSource(nullptr);
+      return true;
+    case DisplayListOpType::kSetPodColorSource:
+      return DispatchColorSource(decoder, dispatcher);
+    case DisplayListOpType::kSetImageColorSource:
+    case DisplayListOpType::kSetRuntimeEffectColorSource:
+#ifdef IMPELLER_ENABLE_3D
+    case DisplayListOpType::kSetSceneColorSource:
+#endif  // IMPELLER_ENABLE_3D
+    {
+      const std::shared_ptr<const DlColorSource>* source;
+      if (!decoder.ReadRef(table.color_sources, &source)) {
+        return false;
+      }
+      dispatcher.setColorSource(source->get());
+      return true;
+    }
+
+    case DisplayListOpType::kClearImageFilter:
+      dispatcher.setImageFilter(nullptr);
+      return true;
+    case DisplayListOpType::kSetPodImageFilter:
+    case DisplayListOpType::kSetSharedImageFilter: {
+      const std::shared_ptr<const DlImageFilter>* filter;
+      if (!decoder.ReadRef(table.image_filters, &filter)) {
+        return false;
+      }
+      dispatcher.setImageFilter(filter->get());
+      return true;
+    }
+
+    case DisplayListOpType::kClearMaskFilter:
+      dispatcher.setMaskFilter(nullptr);
+      return true;
+    case DisplayListOpType::kSetPodMaskFilter:
+      return DispatchMaskFilter(decoder, dispatcher);
+
+    case DisplayListOpType::kSave:
+      dispatcher.save();
+      return true;
+    case DisplayListOpType::kSaveLayer:
+    case DisplayListOpType::kSaveLayerBounds:
+    case DisplayListOpType::kSaveLayerBackdrop:
+    case DisplayListOpType::kSaveLayerBackdropBounds: {
+      bool with_attributes;
+      if (!decoder.ReadBool(&with_attributes)) {
+        return false;
+      }
+      SkRect bounds;
+      bool has_bounds = (type == DisplayListOpType::kSaveLayerBounds ||
+                         type == DisplayListOpType::kSaveLayerBackdropBounds);
+      if (has_bounds && !decoder.Read(&bounds)) {
+        return false;
+      }
+      const std::shared_ptr<const DlImageFilter>* backdrop = nullptr;
+      bool has_backdrop =
+          (type == DisplayListOpType::kSaveLayerBackdrop ||
+           type == DisplayListOpType::kSaveLayerBackdropBounds);
+      if (has_backdrop && !decoder.ReadRef(table.image_filters, &backdrop)) {
+        return false;
+      }
+      dispatcher.saveLayer(has_bounds ? &bounds : nullptr,
+                           with_attributes ? SaveLayerOptions::kWithAttributes
+                                           : SaveLayerOptions::kNoAttributes,
+                           backdrop ? backdrop->get() : nullptr);
+      return true;
+    }
+    case DisplayListOpType::kRestore:
+      dispatcher.restore();
+      return true;
+
+    case DisplayListOpType::kTranslate:
+    case DisplayListOpType::kScale:
+    case DisplayListOpType::kSkew: {
+      SkPoint value;
+      if (!decoder.Read(&value)) {
+        return false;
+      }
+      if (type == DisplayListOpType::kTranslate) {
+        dispatcher.translate(value.fX, value.fY);
+      } else if (type == DisplayListOpType::kScale) {
+        dispatcher.scale(value.fX, value.fY);
+      } else {
+        dispatcher.skew(value.fX, value.fY);
+      }
+      return true;
+    }
+    case DisplayListOpType::kTransform2DAffine: {
+      const SkScalar* m = decoder.ReadArray<SkScalar>(6);
+      if (!m) {
+        return false;
+      }
+      dispatcher.transform2DAffine(m[0], m[1], m[2],  //
+                                   m[3], m[4], m[5]);
+      return true;
+    }
+    case DisplayListOpType::kTransformFullPerspective: {
+      const SkScalar* m = decoder.ReadArray<SkScalar>(16);
+      if (!m) {
+        return false;
+      }
+      dispatcher.transformFullPerspective(m[0], m[1], m[2], m[3],     //
+                                          m[4], m[5], m[6], m[7],     //
+                                          m[8], m[9], m[10], m[11],   //
+                                          m[12], m[13], m[14], m[15]);
+      return true;
+    }
+    case DisplayListOpType::kTransformReset:
+      dispatcher.transformReset();
+      return true;
+
+    case DisplayListOpType::kClipIntersectRect:
+    case DisplayListOpType::kClipDifferenceRect: {
+      bool is_aa;
+      SkRect rect;
+      if (!decoder.ReadBool(&is_aa) || !decoder.Read(&rect)) {
+        return false;
+      }
+      dispatcher.clipRect(rect,
+                          type == DisplayListOpType::kClipIntersectRect
+                              ? DlCanvas::ClipOp::kIntersect
+                              : DlCanvas::ClipOp::kDifference,
+                          is_aa);
+      return true;
+    }
+    case DisplayListOpType::kClipIntersectRRect:
+    case DisplayListOpType::kClipDifferenceRRect: {
+      bool is_aa;
+      SkRRect rrect;
+      if (!decoder.ReadBool(&is_aa) || !decoder.ReadRRect(&rrect)) {
+        return false;
+      }
+      dispatcher.clipRRect(rrect,
+                           type == DisplayListOpType::kClipIntersectRRect
+                               ? DlCanvas::ClipOp::kIntersect
+                               : DlCanvas::ClipOp::kDifference,
+                           is_aa);
+      return true;
+    }
+    case DisplayListOpType::kClipIntersectPath:
+    case DisplayListOpType::kClipDifferencePath: {
+      bool is_aa;
+      SkPath path;
+      if (!decoder.ReadBool(&is_aa) || !decoder.ReadPath(&path)) {
+        return false;
+      }
+      dispatcher.clipPath(path,
+                          type == DisplayListOpType::kClipIntersectPath
+                              ? DlCanvas::ClipOp::kIntersect
+                              : DlCanvas::ClipOp::kDifference,
+                          is_aa);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawPaint:
+      dispatcher.drawPaint();
+      return true;
+    case DisplayListOpType::kDrawColor: {
+      DlColor color;
+      DlBlendMode mode;
+      if (!decoder.Read(&color) || !decoder.Read(&mode)) {
+        return false;
+      }
+      dispatcher.drawColor(color, mode);
+      return true;
+    }
+    case DisplayListOpType::kDrawLine: {
+      SkPoint p0, p1;
+      if (!decoder.Read(&p0) || !decoder.Read(&p1)) {
+        return false;
+      }
+      dispatcher.drawLine(p0, p1);
+      return true;
+    }
+    case DisplayListOpType::kDrawCircle: {
+      SkPoint center;
+      SkScalar radius;
+      if (!decoder.Read(&center) || !decoder.Read(&radius)) {
+        return false;
+      }
+      dispatcher.drawCircle(center, radius);
+      return true;
+    }
+    case DisplayListOpType::kDrawRRect: {
+      SkRRect rrect;
+      if (!decoder.ReadRRect(&rrect)) {
+        return false;
+      }
+      dispatcher.drawRRect(rrect);
+      return true;
+    }
+    case DisplayListOpType::kDrawDRRect: {
+      SkRRect outer, inner;
+      if (!decoder.ReadRRect(&outer) || !decoder.ReadRRect(&inner)) {
+        return false;
+      }
+      dispatcher.drawDRRect(outer, inner);
+      return true;
+    }
+    case DisplayListOpType::kDrawArc: {
+      SkRect bounds;
+      SkScalar start, sweep;
+      bool use_center;
+      if (!decoder.Read(&bounds) || !decoder.Read(&start) ||
+          !decoder.Read(&sweep) || !decoder.ReadBool(&use_center)) {
+        return false;
+      }
+      dispatcher.drawArc(bounds, start, sweep, use_center);
+      return true;
+    }
+    case DisplayListOpType::kDrawPath: {
+      SkPath path;
+      if (!decoder.ReadPath(&path)) {
+        return false;
+      }
+      dispatcher.drawPath(path);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawPoints:
+    case DisplayListOpType::kDrawLines:
+    case DisplayListOpType::kDrawPolygon: {
+      uint32_t count;
+      if (!decoder.Read(&count) ||
+          count > static_cast<uint32_t>(Dispatcher::kMaxDrawPointsCount)) {
+        return false;
+      }
+      const SkPoint* points = decoder.ReadArray<SkPoint>(count);
+      if (!points) {
+        return false;
+      }
+      DlCanvas::PointMode mode = DlCanvas::PointMode::kPoints;
+      if (type == DisplayListOpType::kDrawLines) {
+        mode = DlCanvas::PointMode::kLines;
+      } else if (type == DisplayListOpType::kDrawPolygon) {
+        mode = DlCanvas::PointMode::kPolygon;
+      }
+      dispatcher.drawPoints(mode, count, points);
+      return true;
+    }
+    case DisplayListOpType::kDrawVertices: {
+      DlBlendMode mode;
+      DlVertexMode vertex_mode;
+      uint32_t flags;
+      int32_t vertex_count, index_count;
+      if (!decoder.Read(&mode) || !decoder.Read(&vertex_mode) ||
+          !decoder.Read(&flags) || !decoder.Read(&vertex_count) ||
+          !decoder.Read(&index_count) || vertex_count < 0 || index_count < 0) {
+        return false;
+      }
+      const SkPoint* vertices = decoder.ReadArray<SkPoint>(vertex_count);
+      const SkPoint* texture_coordinates = nullptr;
+      const DlColor* colors = nullptr;
+      const uint16_t* indices = nullptr;
+      if (!vertices) {
+        return false;
+      }
+      if (flags & kVerticesHasTextureCoordinates) {
+        texture_coordinates = decoder.ReadArray<SkPoint>(vertex_count);
+        if (!texture_coordinates) {
+          return false;
+        }
+      }
+      if (flags & kVerticesHasColors) {
+        colors = decoder.ReadArray<DlColor>(vertex_count);
+        if (!colors) {
+          return false;
+        }
+      }
+      if (index_count > 0) {
+        indices = decoder.ReadArray<uint16_t>(index_count);
+        if (!indices) {
+          return false;
+        }
+      }
+      auto dl_vertices =
+          DlVertices::Make(vertex_mode, vertex_count, vertices,
+                           texture_coordinates, colors, index_count, indices);
+      dispatcher.drawVertices(dl_vertices.get(), mode);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawImage:
+    case DisplayListOpType::kDrawImageWithAttr: {
+      const sk_sp<DlImage>* image;
+      SkPoint point;
+      DlImageSampling sampling;
+      if (!decoder.ReadRef(table.images, &image) || !decoder.Read(&point) ||
+          !decoder.Read(&sampling)) {
+        return false;
+      }
+      dispatcher.drawImage(*image, point, sampling,
+                           type == DisplayListOpType::kDrawImageWithAttr);
+      return true;
+    }
+    case DisplayListOpType::kDrawImageRect: {
+      const sk_sp<DlImage>* image;
+      SkRect src, dst;
+      DlImageSampling sampling;
+      bool render_with_attributes;
+      SkCanvas::SrcRectConstraint constraint;
+      if (!decoder.ReadRef(table.images, &image) || !decoder.Read(&src) ||
+          !decoder.Read(&dst) || !decoder.Read(&sampling) ||
+          !decoder.ReadBool(&render_with_attributes) ||
+          !decoder.Read(&constraint)) {
+        return false;
+      }
+      dispatcher.drawImageRect(*image, src, dst, sampling,
+                               render_with_attributes, constraint);
+      return true;
+    }
+    case DisplayListOpType::kDrawImageNine:
+    case DisplayListOpType::kDrawImageNineWithAttr: {
+      const sk_sp<DlImage>* image;
+      SkIRect center;
+      SkRect dst;
+      DlFilterMode filter;
+      if (!decoder.ReadRef(table.images, &image) || !decoder.Read(&center) ||
+          !decoder.Read(&dst) || !decoder.Read(&filter)) {
+        return false;
+      }
+      dispatcher.drawImageNine(
+          *image, center, dst, filter,
+          type == DisplayListOpType::kDrawImageNineWithAttr);
+      return true;
+    }
+    case DisplayListOpType::kDrawAtlas:
+    case DisplayListOpType::kDrawAtlasCulled: {
+      const sk_sp<DlImage>* atlas;
+      int32_t count;
+      DlBlendMode mode;
+      DlImageSampling sampling;
+      bool has_colors, render_with_attributes;
+      if (!decoder.ReadRef(table.images, &atlas) || !decoder.Read(&count) ||
+          count < 0 || !decoder.Read(&mode) || !decoder.Read(&sampling) ||
+          !decoder.ReadBool(&has_colors) ||
+          !decoder.ReadBool(&render_with_attributes)) {
+        return false;
+      }
+      SkRect cull_rect;
+      bool has_cull = type == DisplayListOpType::kDrawAtlasCulled;
+      if (has_cull && !decoder.Read(&cull_rect)) {
+        return false;
+      }
+      const SkRSXform* xform = decoder.ReadArray<SkRSXform>(count);
+      const SkRect* tex = decoder.ReadArray<SkRect>(count);
+      const DlColor* colors =
+          has_colors ? decoder.ReadArray<DlColor>(count) : nullptr;
+      if (!xform || !tex || (has_colors && !colors)) {
+        return false;
+      }
+      dispatcher.drawAtlas(*atlas, xform, tex, colors, count, mode, sampling,
+                           has_cull ? &cull_rect : nullptr,
+                           render_with_attributes);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawDisplayList: {
+      const sk_sp<DisplayList>* display_list;
+      if (!decoder.ReadRef(table.display_lists, &display_list)) {
+        return false;
+      }
+      dispatcher.drawDisplayList(*display_list);
+      return true;
+    }
+    case DisplayListOpType::kDrawTextBlob: {
+      const sk_sp<SkTextBlob>* blob;
+      SkScalar x, y;
+      if (!decoder.ReadRef(table.text_blobs, &blob) || !decoder.Read(&x) ||
+          !decoder.Read(&y)) {
+        return false;
+      }
+      dispatcher.drawTextBlob(*blob, x, y);
+      return true;
+    }
+
+    case DisplayListOpType::kDrawShadow:
+    case DisplayListOpType::kDrawShadowTransparentOccluder: {
+      DlColor color;
+      SkScalar elevation, dpr;
+      SkPath path;
+      if (!decoder.Read(&color) || !decoder.Read(&elevation) ||
+          !decoder.Read(&dpr) || !decoder.ReadPath(&path)) {
+        return false;
+      }
+      dispatcher.drawShadow(
+          path, color, elevation,
+          type == DisplayListOpType::kDrawShadowTransparentOccluder, dpr);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::vector<uint8_t> DisplayListSerializer::Serialize(
+    const DisplayList& display_list,
+    DisplayListSideTable& side_table) {
+  TRACE_EVENT0("flutter", "DisplayListSerializer::Serialize");
+  std::vector<uint8_t> buffer(sizeof(SerializedHeader));
+  buffer.reserve(sizeof(SerializedHeader) + display_list.bytes(false));
+
+  SerializingDispatcher dispatcher(buffer, side_table);
+  display_list.Dispatch(dispatcher);
+
+  SerializedHeader header = {
+      .magic = kMagic,
+      .version = kVersion,
+      .op_count = dispatcher.op_count(),
+      .flags = display_list.can_apply_group_opacity()
+                   ? kFlagCanApplyGroupOpacity
+                   : 0u,
+      .bounds = display_list.bounds(),
+      .ops_size =
+          static_cast<uint32_t>(buffer.size() - sizeof(SerializedHeader)),
+      .reserved = 0,
+  };
+  memcpy(buffer.data(), &header, sizeof(header));
+  return buffer;
+}
+
+DisplayListDeserializer::DisplayListDeserializer(
+    std::shared_ptr<const fml::Mapping> data,
+    std::shared_ptr<const DisplayListSideTable> table)
+    : data_(std::move(data)), table_(std::move(table)) {
+  if (!data_ || !table_ || data_->GetMapping() == nullptr ||
+      data_->GetSize() < sizeof(SerializedHeader)) {
+    return;
+  }
+  const uint8_t* base = data_->GetMapping();
+  if (reinterpret_cast<uintptr_t>(base) % kRecordAlignment != 0) {
+    FML_LOG(ERROR) << "Serialized DisplayList mapping is not aligned";
+    return;
+  }
+  SerializedHeader header;
+  memcpy(&header, base, sizeof(header));
+  if (header.magic != DisplayListSerializer::kMagic ||
+      header.version != DisplayListSerializer::kVersion ||
+      header.ops_size > data_->GetSize() - sizeof(SerializedHeader)) {
+    return;
+  }
+  valid_ = true;
+  bounds_ = header.bounds;
+  op_count_ = header.op_count;
+  can_apply_group_opacity_ = (header.flags & kFlagCanApplyGroupOpacity) != 0;
+  ops_ = base + sizeof(SerializedHeader);
+  ops_size_ = header.ops_size;
+}
+
+DisplayListDeserializer::~DisplayListDeserializer() = default;
+
+bool DisplayListDeserializer::Dispatch(Dispatcher& dispatcher) const {
+  if (!valid_) {
+    return false;
+  }
+  const uint8_t* ptr = ops_;
+  const uint8_t* end = ops_ + ops_size_;
+  while (ptr < end) {
+    uint32_t header;
+    if (static_cast<size_t>(end - ptr) < sizeof(header)) {
+      return false;
+    }
+    memcpy(&header, ptr, sizeof(header));
+    uint32_t type = header & 0xFF;
+    size_t size = header >> 8;
+    if (size < sizeof(header) || size > static_cast<size_t>(end - ptr)) {
+      return false;
+    }
+    Decoder decoder(ptr + sizeof(header), size - sizeof(header));
+    if (!DispatchRecord(static_cast<DisplayListOpType>(type), decoder, *table_,
+                        dispatcher)) {
+      FML_LOG(ERROR) << "Malformed serialized DisplayList record of type "
+                     << type;
+      return false;
+    }
+    ptr += size;
+  }
+  return true;
+}
+
+sk_sp<DisplayList> DisplayListDeserializer::Build() const {
+  if (!valid_) {
+    return nullptr;
+  }
+  DisplayListBuilder builder;
+  if (!Dispatch(builder.asDispatcher())) {
+    return nullptr;
+  }
+  return builder.Build();
+}
+
+}  // namespace flutter
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_SERIALIZATION_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_color_source.h"
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/display_list/display_list_image_filter.h"
+#include "flutter/display_list/display_list_path_effect.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+
+// The DisplayList serialization mechanism encodes the op stream of a
+// DisplayList into a relocatable, versioned byte buffer that can be
+// copied between isolates, handed across a process boundary, or written
+// to disk and later mmapped and dispatched directly.
+//
+// The encoded buffer contains only plain data (numbers, geometry, colors,
+// paths and inline arrays) and no pointers. Objects that cannot be
+// expressed as plain data (images, runtime effects, image filters, path
+// effects, text blobs and nested DisplayLists) are stored in an
+// out-of-line |DisplayListSideTable| and are referenced from the buffer
+// by index. A side table is only meaningful together with the buffer that
+// was encoded against it; transporting its contents across a process
+// boundary is the responsibility of the embedder.
+//
+// Array payloads (points, atlas transforms, colors, vertex data) are
+// dispatched straight out of the mapping without being copied, which
+// requires the mapping to be at least 4-byte aligned (any mmapped file or
+// heap allocation satisfies this).
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The out-of-line references used by a serialized DisplayList.
+///
+class DisplayListSideTable {
+ public:
+  DisplayListSideTable() = default;
+
+  std::vector<sk_sp<DlImage>> images;
+  std::vector<std::shared_ptr<const DlColorSource>> color_sources;
+  std::vector<std::shared_ptr<const DlImageFilter>> image_filters;
+  std::vector<std::shared_ptr<const DlPathEffect>> path_effects;
+  std::vector<sk_sp<SkTextBlob>> text_blobs;
+  std::vector<sk_sp<DisplayList>> display_lists;
+
+  size_t entry_count() const {
+    return images.size() + color_sources.size() + image_filters.size() +
+           path_effects.size() + text_blobs.size() + display_lists.size();
+  }
+
+ private:
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListSideTable);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes a DisplayList into the relocatable binary format.
+///
+class DisplayListSerializer {
+ public:
+  // "DLST" in little endian byte order.
+  static constexpr uint32_t kMagic = 0x54534C44;
+
+  // The version must be bumped whenever the encoding of any record or the
+  // set of ops in FOR_EACH_DISPLAY_LIST_OP changes.
+  static constexpr uint32_t kVersion = 1;
+
+  /// Encodes the ops of |display_list| and appends any out-of-line
+  /// references they hold to |side_table|.
+  static std::vector<uint8_t> Serialize(const DisplayList& display_list,
+                                        DisplayListSideTable& side_table);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DisplayListSerializer);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Validates and dispatches a buffer produced by the
+///             DisplayListSerializer without re-recording it.
+///
+/// The deserializer does not take a copy of the encoded data, it retains
+/// the mapping and the side table and decodes the records on the fly each
+/// time it is dispatched.
+///
+class DisplayListDeserializer {
+ public:
+  DisplayListDeserializer(std::shared_ptr<const fml::Mapping> data,
+                          std::shared_ptr<const DisplayListSideTable> table);
+
+  ~DisplayListDeserializer();
+
+  /// Whether the header was recognized and matches the current version.
+  /// A valid header does not guarantee that each record is well formed,
+  /// malformed records are detected (and rejected) during dispatch.
+  bool is_valid() const { return valid_; }
+
+  const SkRect& bounds() const { return bounds_; }
+  unsigned int op_count() const { return op_count_; }
+  bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
+
+  /// Dispatches the encoded ops to |dispatcher|. Returns false if the
+  /// buffer was invalid or a malformed record was encountered, in which
+  /// case only the ops preceding the malformed record were dispatched.
+  bool Dispatch(Dispatcher& dispatcher) const;
+
+  /// Re-records the encoded ops into a new DisplayList for callers that
+  /// need a DisplayList object. Returns nullptr if the buffer is invalid.
+  sk_sp<DisplayList> Build() const;
+
+ private:
+  const std::shared_ptr<const fml::Mapping> data_;
+  const std::shared_ptr<const DisplayListSideTable> table_;
+
+  bool valid_ = false;
+  SkRect bounds_ = SkRect::MakeEmpty();
+  unsigned int op_count_ = 0;
+  bool can_apply_group_opacity_ = false;
+  const uint8_t* ops_ = nullptr;
+  size_t ops_size_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListDeserializer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_SERIALIZATION_H_
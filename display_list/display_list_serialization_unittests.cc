@@ -0,0 +1,131 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_serialization.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/testing/display_list_testing.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<testing::DisplayListInvocationGroup> allGroups =
+    CreateAllGroups();
+
+static std::shared_ptr<fml::Mapping> MakeMapping(std::vector<uint8_t> data) {
+  return std::make_shared<fml::DataMapping>(std::move(data));
+}
+
+TEST(DisplayListSerialization, EmptyDisplayListRoundTrips) {
+  sk_sp<DisplayList> empty = DisplayListBuilder().Build();
+  auto table = std::make_shared<DisplayListSideTable>();
+  auto data = DisplayListSerializer::Serialize(*empty, *table);
+
+  DisplayListDeserializer deserializer(MakeMapping(std::move(data)), table);
+  ASSERT_TRUE(deserializer.is_valid());
+  EXPECT_EQ(deserializer.op_count(), 0u);
+  EXPECT_EQ(table->entry_count(), 0u);
+
+  sk_sp<DisplayList> copy = deserializer.Build();
+  ASSERT_NE(copy, nullptr);
+  EXPECT_TRUE(DisplayListsEQ_Verbose(empty, copy));
+}
+
+TEST(DisplayListSerialization, SingleOpDisplayListsRoundTrip) {
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      sk_sp<DisplayList> dl = group.variants[i].Build();
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + ")";
+
+      auto table = std::make_shared<DisplayListSideTable>();
+      auto data = DisplayListSerializer::Serialize(*dl, *table);
+      DisplayListDeserializer deserializer(MakeMapping(std::move(data)),
+                                           table);
+      ASSERT_TRUE(deserializer.is_valid()) << desc;
+      EXPECT_EQ(deserializer.bounds(), dl->bounds()) << desc;
+      EXPECT_EQ(deserializer.can_apply_group_opacity(),
+                dl->can_apply_group_opacity())
+          << desc;
+
+      sk_sp<DisplayList> copy = deserializer.Build();
+      ASSERT_NE(copy, nullptr) << desc;
+      EXPECT_TRUE(DisplayListsEQ_Verbose(dl, copy)) << desc;
+    }
+  }
+}
+
+TEST(DisplayListSerialization, DispatchDoesNotRequireDisplayList) {
+  DisplayListBuilder builder;
+  builder.DrawRect({10, 10, 20, 20}, DlPaint(DlColor::kRed()));
+  builder.DrawCircle({50, 50}, 10, DlPaint(DlColor::kBlue()));
+  sk_sp<DisplayList> dl = builder.Build();
+
+  auto table = std::make_shared<DisplayListSideTable>();
+  auto data = DisplayListSerializer::Serialize(*dl, *table);
+  DisplayListDeserializer deserializer(MakeMapping(std::move(data)), table);
+  ASSERT_TRUE(deserializer.is_valid());
+
+  DisplayListBuilder replay;
+  ASSERT_TRUE(deserializer.Dispatch(replay.asDispatcher()));
+  EXPECT_TRUE(DisplayListsEQ_Verbose(dl, replay.Build()));
+}
+
+TEST(DisplayListSerialization, ImagesAreStoredInSideTable) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, {10, 10}, DlImageSampling::kLinear, nullptr);
+  builder.DrawImage(TestImage2, {20, 20}, DlImageSampling::kLinear, nullptr);
+  sk_sp<DisplayList> dl = builder.Build();
+
+  DisplayListSideTable table;
+  DisplayListSerializer::Serialize(*dl, table);
+  ASSERT_EQ(table.images.size(), 2u);
+  EXPECT_EQ(table.images[0], TestImage1);
+  EXPECT_EQ(table.images[1], TestImage2);
+  EXPECT_EQ(table.entry_count(), 2u);
+}
+
+TEST(DisplayListSerialization, BadMagicIsRejected) {
+  DisplayListBuilder builder;
+  builder.DrawRect({10, 10, 20, 20}, DlPaint());
+  auto table = std::make_shared<DisplayListSideTable>();
+  auto data = DisplayListSerializer::Serialize(*builder.Build(), *table);
+  data[0] ^= 0xFF;
+
+  DisplayListDeserializer deserializer(MakeMapping(std::move(data)), table);
+  EXPECT_FALSE(deserializer.is_valid());
+  EXPECT_EQ(deserializer.Build(), nullptr);
+}
+
+TEST(DisplayListSerialization, TruncatedDataIsRejected) {
+  DisplayListBuilder builder;
+  builder.DrawRect({10, 10, 20, 20}, DlPaint());
+  auto table = std::make_shared<DisplayListSideTable>();
+  auto data = DisplayListSerializer::Serialize(*builder.Build(), *table);
+  data.resize(data.size() - 4);
+
+  DisplayListDeserializer deserializer(MakeMapping(std::move(data)), table);
+  EXPECT_FALSE(deserializer.is_valid());
+}
+
+TEST(DisplayListSerialization, MissingSideTableEntryIsRejected) {
+  DisplayListBuilder builder;
+  builder.DrawImage(TestImage1, {10, 10}, DlImageSampling::kLinear, nullptr);
+  DisplayListSideTable table;
+  auto data = DisplayListSerializer::Serialize(*builder.Build(), table);
+
+  DisplayListDeserializer deserializer(
+      MakeMapping(std::move(data)), std::make_shared<DisplayListSideTable>());
+  ASSERT_TRUE(deserializer.is_valid());
+  DisplayListBuilder replay;
+  EXPECT_FALSE(deserializer.Dispatch(replay.asDispatcher()));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,121 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_storage_pool.h"
+
+#include <cstdlib>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+DisplayListStoragePool& DisplayListStoragePool::Instance() {
+  // Intentionally leaked so that DisplayLists destroyed during static
+  // destruction can still return their storage.
+  static DisplayListStoragePool* instance = new DisplayListStoragePool();
+  return *instance;
+}
+
+DisplayListStoragePool::DisplayListStoragePool(size_t max_retained_bytes)
+    : max_retained_bytes_(max_retained_bytes) {}
+
+DisplayListStoragePool::~DisplayListStoragePool() {
+  Trim();
+}
+
+size_t DisplayListStoragePool::BucketIndex(size_t size) {
+  FML_DCHECK(size <= kMaxBlockSize);
+  size_t bucket = 0;
+  while (BucketCapacity(bucket) < size) {
+    bucket++;
+  }
+  return bucket;
+}
+
+uint8_t* DisplayListStoragePool::Acquire(size_t size, size_t* capacity) {
+  if (size > kMaxBlockSize) {
+    *capacity = (size + kMinBlockSize - 1) & ~(kMinBlockSize - 1);
+  } else {
+    size_t bucket = BucketIndex(size);
+    *capacity = BucketCapacity(bucket);
+    std::scoped_lock lock(mutex_);
+    auto& free_list = buckets_[bucket];
+    if (!free_list.empty()) {
+      uint8_t* block = free_list.back();
+      free_list.pop_back();
+      retained_bytes_ -= *capacity;
+      reuse_count_++;
+      return block;
+    }
+  }
+  uint8_t* block = static_cast<uint8_t*>(std::malloc(*capacity));
+  FML_CHECK(block);
+  std::scoped_lock lock(mutex_);
+  allocation_count_++;
+  return block;
+}
+
+void DisplayListStoragePool::Release(uint8_t* block, size_t capacity) {
+  if (!block) {
+    return;
+  }
+  if (capacity <= kMaxBlockSize) {
+    size_t bucket = BucketIndex(capacity);
+    FML_DCHECK(BucketCapacity(bucket) == capacity);
+    std::scoped_lock lock(mutex_);
+    if (retained_bytes_ + capacity <= max_retained_bytes_) {
+      buckets_[bucket].push_back(block);
+      retained_bytes_ += capacity;
+      return;
+    }
+  }
+  std::free(block);
+}
+
+void DisplayListStoragePool::SetMaxRetainedBytes(size_t max_retained_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_retained_bytes_ = max_retained_bytes;
+  TrimLocked(max_retained_bytes);
+}
+
+void DisplayListStoragePool::Trim() {
+  std::scoped_lock lock(mutex_);
+  TrimLocked(0);
+}
+
+void DisplayListStoragePool::TrimLocked(size_t max_retained_bytes) {
+  // Free the largest blocks first since they are the least likely to be
+  // reused.
+  for (size_t i = kBucketCount; i > 0 && retained_bytes_ > max_retained_bytes;
+       i--) {
+    auto& free_list = buckets_[i - 1];
+    while (!free_list.empty() && retained_bytes_ > max_retained_bytes) {
+      std::free(free_list.back());
+      free_list.pop_back();
+      retained_bytes_ -= BucketCapacity(i - 1);
+    }
+  }
+}
+
+size_t DisplayListStoragePool::max_retained_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return max_retained_bytes_;
+}
+
+size_t DisplayListStoragePool::retained_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return retained_bytes_;
+}
+
+size_t DisplayListStoragePool::allocation_count() const {
+  std::scoped_lock lock(mutex_);
+  return allocation_count_;
+}
+
+size_t DisplayListStoragePool::reuse_count() const {
+  std::scoped_lock lock(mutex_);
+  return reuse_count_;
+}
+
+}  // namespace flutter
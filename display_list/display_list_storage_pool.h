@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_STORAGE_POOL_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_STORAGE_POOL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A free-list of the op buffers used by DisplayListBuilder and
+///             DisplayList so that the storage of DisplayLists that are
+///             recorded every frame can be recycled rather than going
+///             through malloc and free each time.
+///
+/// Blocks are bucketed into power of two size classes between
+/// |kMinBlockSize| and |kMaxBlockSize|. Blocks larger than |kMaxBlockSize|
+/// are allocated at (page rounded) size and are never retained. The
+/// total number of bytes held in the free-lists is bounded by
+/// |max_retained_bytes|, blocks released beyond that bound are freed.
+///
+/// DisplayLists are typically recorded on the UI thread and destroyed on
+/// the raster thread, so the pool is shared between threads and all of
+/// its methods are thread-safe.
+///
+class DisplayListStoragePool {
+ public:
+  static constexpr size_t kMinBlockSize = 4096;
+  static constexpr size_t kMaxBlockSize = 1 << 20;
+  static constexpr size_t kDefaultMaxRetainedBytes = 4 << 20;
+
+  /// The pool used for the storage of all DisplayLists.
+  static DisplayListStoragePool& Instance();
+
+  explicit DisplayListStoragePool(
+      size_t max_retained_bytes = kDefaultMaxRetainedBytes);
+
+  ~DisplayListStoragePool();
+
+  /// Returns a block of at least |size| bytes and stores its actual size
+  /// in |capacity|. The contents of the block are undefined.
+  uint8_t* Acquire(size_t size, size_t* capacity);
+
+  /// Returns a block obtained from |Acquire| to the pool. |capacity| must
+  /// be the capacity reported when the block was acquired.
+  void Release(uint8_t* block, size_t capacity);
+
+  /// Sets the upper bound on the number of bytes retained in the
+  /// free-lists, freeing retained blocks as necessary to honor it.
+  /// A bound of 0 disables recycling.
+  void SetMaxRetainedBytes(size_t max_retained_bytes);
+
+  /// Frees all retained blocks.
+  void Trim();
+
+  size_t max_retained_bytes() const;
+  size_t retained_bytes() const;
+
+  /// The number of blocks that were newly allocated from the system and
+  /// the number of blocks that were satisfied from the free-lists.
+  size_t allocation_count() const;
+  size_t reuse_count() const;
+
+ private:
+  // One bucket for each power of two from kMinBlockSize to kMaxBlockSize.
+  static constexpr size_t kBucketCount = 9;
+  static_assert(kMinBlockSize << (kBucketCount - 1) == kMaxBlockSize);
+
+  static size_t BucketCapacity(size_t bucket) {
+    return kMinBlockSize << bucket;
+  }
+
+  // Returns the index of the smallest bucket that holds |size| bytes,
+  // which must be no larger than kMaxBlockSize.
+  static size_t BucketIndex(size_t size);
+
+  void TrimLocked(size_t max_retained_bytes);
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<uint8_t*>, kBucketCount> buckets_;
+  size_t max_retained_bytes_;
+  size_t retained_bytes_ = 0;
+  size_t allocation_count_ = 0;
+  size_t reuse_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStoragePool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_STORAGE_POOL_H_
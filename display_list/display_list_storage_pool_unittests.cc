@@ -0,0 +1,106 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_storage_pool.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(DisplayListStoragePool, AcquireRoundsUpToSizeClass) {
+  DisplayListStoragePool pool;
+  size_t capacity;
+
+  uint8_t* block = pool.Acquire(1, &capacity);
+  EXPECT_EQ(capacity, DisplayListStoragePool::kMinBlockSize);
+  pool.Release(block, capacity);
+
+  block = pool.Acquire(5000, &capacity);
+  EXPECT_EQ(capacity, 8192u);
+  pool.Release(block, capacity);
+
+  block = pool.Acquire(DisplayListStoragePool::kMaxBlockSize + 1, &capacity);
+  EXPECT_EQ(capacity, DisplayListStoragePool::kMaxBlockSize +
+                          DisplayListStoragePool::kMinBlockSize);
+  pool.Release(block, capacity);
+}
+
+TEST(DisplayListStoragePool, ReleasedBlocksAreReused) {
+  DisplayListStoragePool pool;
+  size_t capacity;
+
+  uint8_t* block = pool.Acquire(100, &capacity);
+  EXPECT_EQ(pool.allocation_count(), 1u);
+  pool.Release(block, capacity);
+  EXPECT_EQ(pool.retained_bytes(), capacity);
+
+  size_t reused_capacity;
+  uint8_t* reused = pool.Acquire(200, &reused_capacity);
+  EXPECT_EQ(reused, block);
+  EXPECT_EQ(reused_capacity, capacity);
+  EXPECT_EQ(pool.allocation_count(), 1u);
+  EXPECT_EQ(pool.reuse_count(), 1u);
+  EXPECT_EQ(pool.retained_bytes(), 0u);
+  pool.Release(reused, reused_capacity);
+}
+
+TEST(DisplayListStoragePool, LargeBlocksAreNotRetained) {
+  DisplayListStoragePool pool;
+  size_t capacity;
+
+  uint8_t* block =
+      pool.Acquire(DisplayListStoragePool::kMaxBlockSize * 2, &capacity);
+  pool.Release(block, capacity);
+  EXPECT_EQ(pool.retained_bytes(), 0u);
+}
+
+TEST(DisplayListStoragePool, RetainedBytesAreBounded) {
+  DisplayListStoragePool pool(8192);
+  size_t capacity;
+
+  uint8_t* block1 = pool.Acquire(4096, &capacity);
+  uint8_t* block2 = pool.Acquire(4096, &capacity);
+  uint8_t* block3 = pool.Acquire(4096, &capacity);
+  pool.Release(block1, capacity);
+  pool.Release(block2, capacity);
+  pool.Release(block3, capacity);
+  EXPECT_EQ(pool.retained_bytes(), 8192u);
+
+  pool.SetMaxRetainedBytes(4096);
+  EXPECT_EQ(pool.retained_bytes(), 4096u);
+
+  pool.Trim();
+  EXPECT_EQ(pool.retained_bytes(), 0u);
+
+  pool.SetMaxRetainedBytes(0);
+  block1 = pool.Acquire(4096, &capacity);
+  pool.Release(block1, capacity);
+  EXPECT_EQ(pool.retained_bytes(), 0u);
+}
+
+TEST(DisplayListStoragePool, DisplayListStorageIsRecycled) {
+  auto& pool = DisplayListStoragePool::Instance();
+  auto build = []() {
+    DisplayListBuilder builder;
+    for (int i = 0; i < 100; i++) {
+      builder.drawRect(SkRect::MakeXYWH(i, i, 10, 10));
+    }
+    return builder.Build();
+  };
+
+  // Prime the pool with the storage of a discarded DisplayList.
+  build().reset();
+
+  size_t allocations = pool.allocation_count();
+  for (int i = 0; i < 10; i++) {
+    auto display_list = build();
+    EXPECT_EQ(display_list->op_count(), 100u);
+  }
+  EXPECT_EQ(pool.allocation_count(), allocations);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list_tiler.h"
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+static void RecordTile(const DisplayList& display_list,
+                       DisplayListTiler::Tile& tile) {
+  TRACE_EVENT0("flutter", "DisplayListTiler::RecordTile");
+  SkRect cull_rect = SkRect::Make(tile.bounds);
+  DisplayListBuilder builder(cull_rect, display_list.has_rtree());
+  display_list.RenderTo(&builder);
+  tile.display_list = builder.Build();
+}
+
+std::vector<DisplayListTiler::Tile> DisplayListTiler::RecordTiles(
+    const sk_sp<DisplayList>& display_list,
+    const SkIRect& cull_rect,
+    const SkISize& tile_size,
+    const std::shared_ptr<fml::BasicTaskRunner>& task_runner) {
+  TRACE_EVENT0("flutter", "DisplayListTiler::RecordTiles");
+  std::vector<Tile> tiles;
+  if (!display_list || cull_rect.isEmpty() || tile_size.isEmpty()) {
+    return tiles;
+  }
+  FML_DCHECK(display_list->has_rtree());
+
+  for (int32_t y = cull_rect.fTop; y < cull_rect.fBottom;
+       y += tile_size.fHeight) {
+    for (int32_t x = cull_rect.fLeft; x < cull_rect.fRight;
+         x += tile_size.fWidth) {
+      SkIRect bounds = SkIRect::MakeXYWH(x, y, tile_size.fWidth,
+                                         tile_size.fHeight);
+      if (!bounds.intersect(cull_rect)) {
+        continue;
+      }
+      tiles.push_back({bounds, nullptr});
+    }
+  }
+
+  if (!task_runner || tiles.size() == 1) {
+    for (Tile& tile : tiles) {
+      RecordTile(*display_list, tile);
+    }
+    return tiles;
+  }
+
+  // Each task writes only to its own tile and the DisplayList is immutable,
+  // so the tasks do not need any synchronization besides the latch.
+  fml::CountDownLatch latch(tiles.size());
+  for (Tile& tile : tiles) {
+    task_runner->PostTask([&display_list, &tile, &latch]() {
+      RecordTile(*display_list, tile);
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+  return tiles;
+}
+
+}  // namespace flutter
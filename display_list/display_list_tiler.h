@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_TILER_H_
+#define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_TILER_H_
+
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Splits a DisplayList into per-tile DisplayLists so that the
+///             tiles can be rasterized independently (and in parallel) by
+///             tile-based or software backends.
+///
+/// Each tile is recorded by dispatching the source DisplayList with the
+/// bounds of the tile as the cull rect, so only the ops whose bounds in
+/// the RTree of the source DisplayList intersect the tile are recorded.
+/// The source DisplayList should therefore have been built with an RTree,
+/// otherwise every op is recorded into every tile.
+///
+class DisplayListTiler {
+ public:
+  struct Tile {
+    SkIRect bounds;
+    sk_sp<DisplayList> display_list;
+  };
+
+  /// Partitions |cull_rect| into a row-major grid of tiles no larger than
+  /// |tile_size| and records the ops of |display_list| that intersect each
+  /// of them.
+  ///
+  /// If |task_runner| is non-null, the tiles are recorded concurrently as
+  /// tasks posted to it (typically the task runner of a
+  /// fml::ConcurrentMessageLoop) and the call blocks until all of them
+  /// have completed. The task runner must not be serviced by the calling
+  /// thread. Otherwise the tiles are recorded on the calling thread.
+  static std::vector<Tile> RecordTiles(
+      const sk_sp<DisplayList>& display_list,
+      const SkIRect& cull_rect,
+      const SkISize& tile_size,
+      const std::shared_ptr<fml::BasicTaskRunner>& task_runner = nullptr);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(DisplayListTiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_DISPLAY_LIST_TILER_H_
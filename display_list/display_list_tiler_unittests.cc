@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/display_list_tiler.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/display_list_testing.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+static sk_sp<DisplayList> MakeQuadrantDisplayList() {
+  DisplayListBuilder builder(true);
+  builder.drawRect({10, 10, 40, 40});
+  builder.setColor(DlColor::kRed());
+  builder.drawRect({60, 10, 90, 40});
+  builder.setColor(DlColor::kGreen());
+  builder.drawRect({10, 60, 40, 90});
+  builder.setColor(DlColor::kBlue());
+  builder.drawRect({60, 60, 90, 90});
+  return builder.Build();
+}
+
+TEST(DisplayListTiler, EmptyInputsProduceNoTiles) {
+  auto display_list = MakeQuadrantDisplayList();
+  EXPECT_TRUE(DisplayListTiler::RecordTiles(nullptr, {0, 0, 100, 100},
+                                            {50, 50})
+                  .empty());
+  EXPECT_TRUE(DisplayListTiler::RecordTiles(display_list, SkIRect::MakeEmpty(),
+                                            {50, 50})
+                  .empty());
+  EXPECT_TRUE(
+      DisplayListTiler::RecordTiles(display_list, {0, 0, 100, 100}, {0, 50})
+          .empty());
+}
+
+TEST(DisplayListTiler, TilesCoverCullRectInRowMajorOrder) {
+  auto tiles = DisplayListTiler::RecordTiles(MakeQuadrantDisplayList(),
+                                             {0, 0, 100, 70}, {40, 40});
+  ASSERT_EQ(tiles.size(), 6u);
+  EXPECT_EQ(tiles[0].bounds, SkIRect::MakeLTRB(0, 0, 40, 40));
+  EXPECT_EQ(tiles[1].bounds, SkIRect::MakeLTRB(40, 0, 80, 40));
+  EXPECT_EQ(tiles[2].bounds, SkIRect::MakeLTRB(80, 0, 100, 40));
+  EXPECT_EQ(tiles[3].bounds, SkIRect::MakeLTRB(0, 40, 40, 70));
+  EXPECT_EQ(tiles[4].bounds, SkIRect::MakeLTRB(40, 40, 80, 70));
+  EXPECT_EQ(tiles[5].bounds, SkIRect::MakeLTRB(80, 40, 100, 70));
+}
+
+TEST(DisplayListTiler, TilesOnlyRecordIntersectingOps) {
+  auto tiles = DisplayListTiler::RecordTiles(MakeQuadrantDisplayList(),
+                                             {0, 0, 100, 100}, {50, 50});
+  ASSERT_EQ(tiles.size(), 4u);
+
+  // Attribute ops are always dispatched, only rendering ops are culled.
+  DisplayListBuilder expected_builder;
+  expected_builder.setColor(DlColor::kRed());
+  expected_builder.setColor(DlColor::kGreen());
+  expected_builder.drawRect({10, 60, 40, 90});
+  auto expected = expected_builder.Build();
+
+  for (auto& tile : tiles) {
+    ASSERT_NE(tile.display_list, nullptr);
+    SkRect tile_bounds = SkRect::Make(tile.bounds);
+    EXPECT_TRUE(tile_bounds.contains(tile.display_list->bounds()));
+  }
+  EXPECT_TRUE(DisplayListsEQ_Verbose(tiles[2].display_list, expected));
+}
+
+TEST(DisplayListTiler, ConcurrentRecordingMatchesSerialRecording) {
+  DisplayListBuilder builder(true);
+  for (int y = 0; y < 400; y += 10) {
+    for (int x = 0; x < 400; x += 10) {
+      builder.setColor(DlColor(0xff000000 | (x << 8) | y));
+      builder.drawRect(SkRect::MakeXYWH(x, y, 8, 8));
+    }
+  }
+  auto display_list = builder.Build();
+
+  auto serial =
+      DisplayListTiler::RecordTiles(display_list, {0, 0, 400, 400}, {64, 64});
+
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  auto concurrent = DisplayListTiler::RecordTiles(
+      display_list, {0, 0, 400, 400}, {64, 64}, loop->GetTaskRunner());
+  loop->Terminate();
+
+  ASSERT_EQ(serial.size(), concurrent.size());
+  for (size_t i = 0; i < serial.size(); i++) {
+    EXPECT_EQ(serial[i].bounds, concurrent[i].bounds);
+    EXPECT_TRUE(DisplayListsEQ_Verbose(serial[i].display_list,
+                                       concurrent[i].display_list));
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
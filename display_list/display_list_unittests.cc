@@ -662,6 +662,63 @@ TEST(DisplayList, OverlappingOpsDoNotSupportGroupOpacity) {
   EXPECT_FALSE(display_list->can_apply_group_opacity());
 }
 
+TEST(DisplayList, NonOverlappingOpsSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  for (int y = 0; y < 3; y++) {
+    for (int x = 0; x < 3; x++) {
+      builder.drawRect(SkRect::MakeXYWH(x * 40, y * 40, 30, 30));
+    }
+  }
+  auto display_list = builder.Build();
+  EXPECT_TRUE(display_list->can_apply_group_opacity());
+}
+
+TEST(DisplayList, TouchingOpsDoNotSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.drawRect(SkRect::MakeXYWH(0, 0, 30, 30));
+  builder.drawRect(SkRect::MakeXYWH(30, 0, 30, 30));
+  auto display_list = builder.Build();
+  EXPECT_FALSE(display_list->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NonOverlappingOpsInSaveSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.save();
+  builder.translate(20, 0);
+  builder.drawRect({0, 0, 10, 10});
+  builder.restore();
+  builder.drawRect({40, 0, 50, 10});
+  EXPECT_TRUE(builder.Build()->can_apply_group_opacity());
+
+  DisplayListBuilder overlapping_builder;
+  overlapping_builder.drawRect({0, 0, 10, 10});
+  overlapping_builder.save();
+  overlapping_builder.translate(5, 0);
+  overlapping_builder.drawRect({0, 0, 10, 10});
+  overlapping_builder.restore();
+  EXPECT_FALSE(overlapping_builder.Build()->can_apply_group_opacity());
+}
+
+TEST(DisplayList, NonOverlappingSaveLayersSupportGroupOpacity) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.saveLayer(nullptr, true);
+  // The ops inside of the layer overlap each other, but not the ops
+  // outside of the layer.
+  builder.drawRect({20, 0, 30, 10});
+  builder.drawRect({25, 0, 35, 10});
+  builder.restore();
+  EXPECT_TRUE(builder.Build()->can_apply_group_opacity());
+
+  DisplayListBuilder overlapping_builder;
+  overlapping_builder.drawRect({0, 0, 10, 10});
+  overlapping_builder.saveLayer(nullptr, true);
+  overlapping_builder.drawRect({5, 0, 15, 10});
+  overlapping_builder.restore();
+  EXPECT_FALSE(overlapping_builder.Build()->can_apply_group_opacity());
+}
+
 TEST(DisplayList, SaveLayerFalseSupportsGroupOpacityWithOverlappingChidren) {
   DisplayListBuilder builder;
   builder.saveLayer(nullptr, false);
@@ -2415,5 +2472,411 @@ TEST(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   ASSERT_FALSE(display_list->can_apply_group_opacity());
 }
 
+class PathRecorder : public virtual Dispatcher,
+                     public IgnoreAttributeDispatchHelper,
+                     public IgnoreClipDispatchHelper,
+                     public IgnoreTransformDispatchHelper,
+                     public IgnoreDrawDispatchHelper {
+ public:
+  void drawPath(const SkPath& path) override { paths_.push_back(path); }
+
+  const std::vector<SkPath>& paths() const { return paths_; }
+
+ private:
+  std::vector<SkPath> paths_;
+};
+
+TEST(DisplayList, RecordedPathsShareDataWithTheirSource) {
+  SkPath path;
+  path.moveTo(0, 0);
+  path.cubicTo(10, 0, 20, 10, 20, 20);
+  path.lineTo(0, 20);
+  path.close();
+
+  DisplayListBuilder builder;
+  builder.drawPath(path);
+  auto first_frame = builder.Build();
+  builder.drawPath(path);
+  auto second_frame = builder.Build();
+
+  PathRecorder first_recorder;
+  first_frame->Dispatch(first_recorder);
+  PathRecorder second_recorder;
+  second_frame->Dispatch(second_recorder);
+  ASSERT_EQ(first_recorder.paths().size(), 1u);
+  ASSERT_EQ(second_recorder.paths().size(), 1u);
+
+  // Unchanged paths keep their generation ID, which the path caches of the
+  // backends are keyed on, across display lists.
+  EXPECT_EQ(first_recorder.paths()[0].getGenerationID(),
+            path.getGenerationID());
+  EXPECT_EQ(second_recorder.paths()[0].getGenerationID(),
+            path.getGenerationID());
+
+  // Changing the source afterwards leaves the recorded path as it was.
+  path.lineTo(100, 100);
+  PathRecorder after_change_recorder;
+  first_frame->Dispatch(after_change_recorder);
+  ASSERT_EQ(after_change_recorder.paths().size(), 1u);
+  EXPECT_NE(after_change_recorder.paths()[0].getGenerationID(),
+            path.getGenerationID());
+  EXPECT_EQ(after_change_recorder.paths()[0].countPoints(), 5);
+}
+
+class VerticesRecorder : public virtual Dispatcher,
+                         public IgnoreAttributeDispatchHelper,
+                         public IgnoreClipDispatchHelper,
+                         public IgnoreTransformDispatchHelper,
+                         public IgnoreDrawDispatchHelper {
+ public:
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    vertices_.push_back(vertices);
+  }
+
+  const std::vector<const DlVertices*>& vertices() const { return vertices_; }
+
+ private:
+  std::vector<const DlVertices*> vertices_;
+};
+
+TEST(DisplayList, RecordedVerticesShareCachedResourceWithTheirSource) {
+  class TestResource : public DlVertices::CachedResource {};
+
+  SkPoint coords[3] = {{0, 0}, {10, 0}, {0, 10}};
+  auto vertices = DlVertices::Make(DlVertexMode::kTriangles, 3, coords,
+                                   nullptr, nullptr);
+
+  DisplayListBuilder builder;
+  builder.DrawVertices(vertices.get(), DlBlendMode::kSrcOver, DlPaint());
+  auto first_frame = builder.Build();
+  builder.DrawVertices(vertices.get(), DlBlendMode::kSrcOver, DlPaint());
+  auto second_frame = builder.Build();
+  EXPECT_TRUE(first_frame->Equals(second_frame));
+
+  VerticesRecorder first_recorder;
+  first_frame->Dispatch(first_recorder);
+  VerticesRecorder second_recorder;
+  second_frame->Dispatch(second_recorder);
+  ASSERT_EQ(first_recorder.vertices().size(), 1u);
+  ASSERT_EQ(second_recorder.vertices().size(), 1u);
+
+  // A resource cached while rendering the first frame is found by the second
+  // frame, which recorded the same vertices.
+  auto resource = std::make_shared<TestResource>();
+  first_recorder.vertices()[0]->set_cached_resource(resource);
+  EXPECT_EQ(vertices->cached_resource(), resource);
+  EXPECT_EQ(second_recorder.vertices()[0]->cached_resource(), resource);
+
+  // The resource is released along with the vertices and the display lists.
+  std::weak_ptr<TestResource> weak_resource = resource;
+  resource.reset();
+  vertices.reset();
+  first_frame.reset();
+  EXPECT_FALSE(weak_resource.expired());
+  second_frame.reset();
+  EXPECT_TRUE(weak_resource.expired());
+}
+
+class BatchedDrawRecorder : public virtual Dispatcher,
+                            public IgnoreAttributeDispatchHelper,
+                            public IgnoreClipDispatchHelper,
+                            public IgnoreTransformDispatchHelper,
+                            public IgnoreDrawDispatchHelper {
+ public:
+  bool wantsBatchedDraws() const override { return true; }
+
+  void drawRect(const SkRect& rect) override { calls_.push_back(1); }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    calls_.push_back(-1);
+  }
+  void drawRects(const SkRect rects[], int count) override {
+    calls_.push_back(count);
+  }
+  void drawCircles(const SkPoint centers[],
+                   const SkScalar radii[],
+                   int count) override {
+    calls_.push_back(-count);
+  }
+
+  // Rect batches are recorded as their size and circle batches as the
+  // negative of their size.
+  const std::vector<int>& calls() const { return calls_; }
+
+ private:
+  std::vector<int> calls_;
+};
+
+TEST(DisplayList, ConsecutiveRectsAndCirclesAreBatched) {
+  DisplayListBuilder builder;
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({20, 0, 30, 10});
+  builder.drawRect({40, 0, 50, 10});
+  builder.drawCircle({5, 25}, 5);
+  builder.drawCircle({25, 25}, 5);
+  builder.setColor(DlColor::kRed());
+  builder.drawCircle({45, 25}, 5);
+  builder.drawRect({0, 40, 10, 50});
+  auto display_list = builder.Build();
+
+  BatchedDrawRecorder recorder;
+  display_list->Dispatch(recorder);
+  EXPECT_EQ(recorder.calls(), std::vector<int>({3, -2, -1, 1}));
+}
+
+TEST(DisplayList, BatchedRectsHonorCulling) {
+  DisplayListBuilder builder(true);
+  builder.drawRect({0, 0, 10, 10});
+  builder.drawRect({20, 0, 30, 10});
+  builder.drawRect({40, 0, 50, 10});
+  builder.drawRect({60, 0, 70, 10});
+  auto display_list = builder.Build();
+
+  BatchedDrawRecorder recorder;
+  display_list->Dispatch(recorder, SkRect::MakeLTRB(15, 0, 55, 10));
+  EXPECT_EQ(recorder.calls(), std::vector<int>({2}));
+}
+
+TEST(DisplayList, DefaultBatchedDrawsForwardEachPrimitive) {
+  DisplayListBuilder builder;
+  SkRect rects[] = {{0, 0, 10, 10}, {20, 0, 30, 10}};
+  SkPoint centers[] = {{5, 25}, {25, 25}};
+  SkScalar radii[] = {5, 6};
+  builder.asDispatcher().drawRects(rects, 2);
+  builder.asDispatcher().drawCircles(centers, radii, 2);
+  auto display_list = builder.Build();
+
+  DisplayListBuilder expected_builder;
+  expected_builder.drawRect(rects[0]);
+  expected_builder.drawRect(rects[1]);
+  expected_builder.drawCircle(centers[0], radii[0]);
+  expected_builder.drawCircle(centers[1], radii[1]);
+  auto expected = expected_builder.Build();
+
+  EXPECT_TRUE(DisplayListsEQ_Verbose(display_list, expected));
+}
+
+TEST(DisplayList, DiffOpsRequiresRTree) {
+  DisplayListBuilder builder1(false);
+  builder1.drawRect({10, 10, 20, 20});
+  auto dl1 = builder1.Build();
+  DisplayListBuilder builder2(true);
+  builder2.drawRect({10, 10, 20, 20});
+  auto dl2 = builder2.Build();
+
+  std::vector<SkRect> damage;
+  EXPECT_FALSE(dl1->DiffOps(*dl2, &damage));
+  EXPECT_FALSE(dl2->DiffOps(*dl1, &damage));
+  EXPECT_TRUE(damage.empty());
+}
+
+TEST(DisplayList, DiffOpsOfEqualListsHasNoDamage) {
+  auto build = [] {
+    DisplayListBuilder builder(true);
+    builder.drawRect({10, 10, 20, 20});
+    builder.setColor(DlColor::kRed());
+    builder.drawOval({30, 30, 40, 40});
+    return builder.Build();
+  };
+  auto dl1 = build();
+  auto dl2 = build();
+
+  std::vector<SkRect> damage;
+  EXPECT_TRUE(dl1->DiffOps(*dl2, &damage));
+  EXPECT_TRUE(damage.empty());
+}
+
+TEST(DisplayList, DiffOpsDamagesChangedRenderingOps) {
+  auto build = [](const SkRect& middle) {
+    DisplayListBuilder builder(true);
+    builder.drawRect({10, 10, 20, 20});
+    builder.drawRect(middle);
+    builder.drawRect({50, 50, 60, 60});
+    return builder.Build();
+  };
+  auto dl1 = build({30, 30, 35, 35});
+  auto dl2 = build({32, 32, 40, 40});
+
+  std::vector<SkRect> damage;
+  EXPECT_TRUE(dl2->DiffOps(*dl1, &damage));
+  ASSERT_EQ(damage.size(), 2u);
+  EXPECT_EQ(damage[0], SkRect::MakeLTRB(32, 32, 40, 40));
+  EXPECT_EQ(damage[1], SkRect::MakeLTRB(30, 30, 35, 35));
+}
+
+TEST(DisplayList, DiffOpsDamagesOpsAfterChangedTransform) {
+  auto build = [](SkScalar tx) {
+    DisplayListBuilder builder(true);
+    builder.drawRect({10, 10, 20, 20});
+    builder.translate(tx, 0);
+    builder.drawRect({50, 50, 60, 60});
+    return builder.Build();
+  };
+  auto dl1 = build(5);
+  auto dl2 = build(10);
+
+  std::vector<SkRect> damage;
+  EXPECT_TRUE(dl2->DiffOps(*dl1, &damage));
+  ASSERT_EQ(damage.size(), 2u);
+  EXPECT_EQ(damage[0], SkRect::MakeLTRB(60, 50, 70, 60));
+  EXPECT_EQ(damage[1], SkRect::MakeLTRB(55, 50, 65, 60));
+}
+
+TEST(DisplayList, DiffOpsFailsWithBackdropFilter) {
+  DlBlurImageFilter backdrop(2, 2, DlTileMode::kDecal);
+  auto build = [&backdrop](const SkRect& rect) {
+    DisplayListBuilder builder(true);
+    builder.drawRect(rect);
+    builder.saveLayer(nullptr, SaveLayerOptions::kNoAttributes, &backdrop);
+    builder.drawRect({50, 50, 60, 60});
+    builder.restore();
+    return builder.Build();
+  };
+  auto dl1 = build({10, 10, 20, 20});
+  auto dl2 = build({10, 10, 30, 30});
+
+  std::vector<SkRect> damage;
+  EXPECT_FALSE(dl2->DiffOps(*dl1, &damage));
+}
+
+TEST(DisplayList, ReadsBackdropOfNestedDisplayLists) {
+  DlBlurImageFilter backdrop(2, 2, DlTileMode::kDecal);
+  DisplayListBuilder nested_builder;
+  nested_builder.saveLayer(nullptr, SaveLayerOptions::kNoAttributes,
+                           &backdrop);
+  nested_builder.drawRect({10, 10, 20, 20});
+  nested_builder.restore();
+  auto nested = nested_builder.Build();
+  EXPECT_TRUE(nested->ReadsBackdrop());
+
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  EXPECT_FALSE(builder.Build()->ReadsBackdrop());
+
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawDisplayList(nested);
+  EXPECT_TRUE(builder.Build()->ReadsBackdrop());
+}
+
+TEST(DisplayList, DrawsImagesOfNestedDisplayLists) {
+  DisplayListBuilder nested_builder;
+  nested_builder.drawImage(TestImage1, {10, 10}, kNearestSampling, false);
+  auto nested = nested_builder.Build();
+  EXPECT_TRUE(nested->DrawsImages());
+
+  DisplayListBuilder builder;
+  builder.drawRect({10, 10, 20, 20});
+  EXPECT_FALSE(builder.Build()->DrawsImages());
+
+  builder.drawRect({10, 10, 20, 20});
+  builder.drawDisplayList(nested);
+  EXPECT_TRUE(builder.Build()->DrawsImages());
+
+  DlImageColorSource image_source(TestImage1, DlTileMode::kClamp,
+                                  DlTileMode::kClamp, kNearestSampling);
+  builder.setColorSource(&image_source);
+  builder.drawRect({10, 10, 20, 20});
+  EXPECT_TRUE(builder.Build()->DrawsImages());
+}
+
+class DeferredAttributeRecorder : public virtual Dispatcher,
+                                  public IgnoreAttributeDispatchHelper,
+                                  public IgnoreClipDispatchHelper,
+                                  public IgnoreTransformDispatchHelper,
+                                  public IgnoreDrawDispatchHelper {
+ public:
+  explicit DeferredAttributeRecorder(bool deferred) : deferred_(deferred) {}
+
+  bool wantsDeferredAttributes() const override { return deferred_; }
+
+  void setColor(DlColor color) override {
+    calls_.push_back("setColor");
+    color_ = color;
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    calls_.push_back("setBlendMode");
+  }
+  void setStrokeWidth(SkScalar width) override {
+    calls_.push_back("setStrokeWidth");
+  }
+  void saveLayer(const SkRect* bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    calls_.push_back("saveLayer");
+  }
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    calls_.push_back("drawColor");
+  }
+  void drawRect(const SkRect& rect) override {
+    calls_.push_back("drawRect");
+    rect_colors_.push_back(color_);
+  }
+
+  const std::vector<std::string>& calls() const { return calls_; }
+  const std::vector<DlColor>& rect_colors() const { return rect_colors_; }
+
+ private:
+  const bool deferred_;
+  DlColor color_ = DlColor::kBlack();
+  std::vector<std::string> calls_;
+  std::vector<DlColor> rect_colors_;
+};
+
+TEST(DisplayList, DeferredAttributesAreOnlyDeliveredWhenUsed) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kRed());
+  builder.drawColor(DlColor::kBlue(), DlBlendMode::kSrcOver);
+  builder.drawRect({0, 0, 10, 10});
+  auto display_list = builder.Build();
+
+  DeferredAttributeRecorder eager(false);
+  display_list->Dispatch(eager);
+  EXPECT_EQ(eager.calls(), std::vector<std::string>(
+                               {"setColor", "drawColor", "drawRect"}));
+
+  DeferredAttributeRecorder deferred(true);
+  display_list->Dispatch(deferred);
+  EXPECT_EQ(deferred.calls(), std::vector<std::string>(
+                                  {"drawColor", "setColor", "drawRect"}));
+  EXPECT_EQ(deferred.rect_colors(), std::vector<DlColor>({DlColor::kRed()}));
+}
+
+TEST(DisplayList, DeferredAttributesAreConsolidated) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kRed());
+  builder.setStrokeWidth(5);
+  builder.setColor(DlColor::kBlue());
+  builder.drawRect({0, 0, 10, 10});
+  builder.setBlendMode(DlBlendMode::kSrc);
+  builder.drawRect({20, 0, 30, 10});
+  builder.setBlendMode(DlBlendMode::kMultiply);
+  builder.setBlendMode(DlBlendMode::kSrc);
+  builder.drawRect({40, 0, 50, 10});
+  auto display_list = builder.Build();
+
+  DeferredAttributeRecorder deferred(true);
+  display_list->Dispatch(deferred);
+  EXPECT_EQ(deferred.calls(),
+            std::vector<std::string>({"setStrokeWidth", "setColor", "drawRect",
+                                      "setBlendMode", "drawRect", "drawRect"}));
+  EXPECT_EQ(deferred.rect_colors(),
+            std::vector<DlColor>(
+                {DlColor::kBlue(), DlColor::kBlue(), DlColor::kBlue()}));
+}
+
+TEST(DisplayList, DeferredAttributesAreDeliveredToSaveLayerWithAttributes) {
+  DisplayListBuilder builder;
+  builder.setColor(DlColor::kRed().withAlpha(0x7f));
+  builder.saveLayer(nullptr, false);
+  builder.restore();
+  builder.saveLayer(nullptr, true);
+  builder.restore();
+  auto display_list = builder.Build();
+
+  DeferredAttributeRecorder deferred(true);
+  display_list->Dispatch(deferred);
+  EXPECT_EQ(deferred.calls(), std::vector<std::string>(
+                                  {"saveLayer", "setColor", "saveLayer"}));
+}
+
 }  // namespace testing
 }  // namespace flutter
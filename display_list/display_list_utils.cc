@@ -173,8 +173,12 @@ SkRect RectBoundsAccumulator::AccumulationRect::bounds() const {
 
 void RTreeBoundsAccumulator::accumulate(const SkRect& r, int index) {
   if (r.fLeft < r.fRight && r.fTop < r.fBottom) {
-    rects_.push_back(r);
-    rect_indices_.push_back(index);
+    if (saved_offsets_.empty()) {
+      committed_.Add(r, index);
+    } else {
+      rects_.push_back(r);
+      rect_indices_.push_back(index);
+    }
   }
 }
 void RTreeBoundsAccumulator::save() {
@@ -186,6 +190,7 @@ void RTreeBoundsAccumulator::restore() {
   }
 
   saved_offsets_.pop_back();
+  CommitPending();
 }
 bool RTreeBoundsAccumulator::restore(
     std::function<bool(const SkRect& original, SkRect& modified)> map,
@@ -211,22 +216,29 @@ bool RTreeBoundsAccumulator::restore(
   }
   rects_.resize(previous_size);
   rect_indices_.resize(previous_size);
+  CommitPending();
   return success;
 }
 
+void RTreeBoundsAccumulator::CommitPending() {
+  if (!saved_offsets_.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < rects_.size(); i++) {
+    committed_.Add(rects_[i], rect_indices_[i]);
+  }
+  rects_.clear();
+  rect_indices_.clear();
+}
+
 SkRect RTreeBoundsAccumulator::bounds() const {
   FML_DCHECK(saved_offsets_.empty());
-  RectBoundsAccumulator accumulator;
-  for (auto& rect : rects_) {
-    accumulator.accumulate(rect, 0);
-  }
-  return accumulator.bounds();
+  return committed_.bounds();
 }
 
 sk_sp<DlRTree> RTreeBoundsAccumulator::rtree() const {
   FML_DCHECK(saved_offsets_.empty());
-  return sk_make_sp<DlRTree>(rects_.data(), rects_.size(), rect_indices_.data(),
-                             [](int id) { return id >= 0; });
+  return committed_.Build();
 }
 
 }  // namespace flutter
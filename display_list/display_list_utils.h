@@ -355,6 +355,15 @@ class RTreeBoundsAccumulator final : public virtual BoundsAccumulator {
   }
 
  private:
+  // Moves the rects that are no longer subject to being modified by the
+  // restore of an enclosing save into the RTree builder.
+  void CommitPending();
+
+  // Rects outside of any save are final and are packed into the RTree
+  // builder as they are accumulated, so that |rtree| only needs to build
+  // the upper levels of the tree. The rects inside a save are kept in
+  // |rects_| until their outermost save has been restored.
+  DlRTreeBuilder committed_{[](int id) { return id >= 0; }};
   std::vector<SkRect> rects_;
   std::vector<int> rect_indices_;
   std::vector<size_t> saved_offsets_;
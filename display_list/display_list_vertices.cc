@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/display_list_vertices.h"
 
+#include <mutex>
+
 #include "flutter/display_list/display_list_utils.h"
 #include "flutter/fml/logging.h"
 
@@ -11,7 +13,13 @@ namespace flutter {
 
 using Flags = DlVertices::Builder::Flags;
 
-static void DlVerticesDeleter(void* p) {
+struct DlVertices::CachedResourceSlot {
+  std::mutex mutex;
+  std::shared_ptr<CachedResource> resource;
+};
+
+static void DlVerticesDeleter(DlVertices* p) {
+  p->~DlVertices();
   // Some of our target environments would prefer a sized delete,
   // but other target environments do not have that operator.
   // Use an unsized delete until we get better agreement in the
@@ -138,7 +146,9 @@ DlVertices::DlVertices(const DlVertices* other)
                  other->colors(),
                  other->index_count_,
                  other->indices(),
-                 &other->bounds_) {}
+                 &other->bounds_) {
+  cached_resource_slot_ = other->cached_resource_slot_;
+}
 
 DlVertices::DlVertices(DlVertexMode mode,
                        int unchecked_vertex_count,
@@ -146,7 +156,8 @@ DlVertices::DlVertices(DlVertexMode mode,
                        int unchecked_index_count)
     : mode_(mode),
       vertex_count_(std::max(unchecked_vertex_count, 0)),
-      index_count_(std::max(unchecked_index_count, 0)) {
+      index_count_(std::max(unchecked_index_count, 0)),
+      cached_resource_slot_(std::make_shared<CachedResourceSlot>()) {
   char* pod = reinterpret_cast<char*>(this);
   size_t offset = sizeof(DlVertices);
 
@@ -183,6 +194,24 @@ sk_sp<SkVertices> DlVertices::skia_object() const {
                               indices());
 }
 
+std::shared_ptr<DlVertices::CachedResource> DlVertices::cached_resource()
+    const {
+  if (!cached_resource_slot_) {
+    return nullptr;
+  }
+  std::scoped_lock lock(cached_resource_slot_->mutex);
+  return cached_resource_slot_->resource;
+}
+
+void DlVertices::set_cached_resource(
+    std::shared_ptr<CachedResource> resource) const {
+  if (!cached_resource_slot_) {
+    return;
+  }
+  std::scoped_lock lock(cached_resource_slot_->mutex);
+  cached_resource_slot_->resource = std::move(resource);
+}
+
 bool DlVertices::operator==(DlVertices const& other) const {
   auto lists_equal = [](auto* a, auto* b, int count) {
     if (a == nullptr || b == nullptr) {
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_VERTICES_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_VERTICES_H_
 
+#include <memory>
+
 #include "flutter/display_list/display_list_color.h"
 #include "flutter/display_list/types.h"
 
@@ -75,6 +77,22 @@ inline DlVertexMode ToDl(SkVertices::VertexMode sk_mode) {
 ///
 class DlVertices {
  public:
+  //--------------------------------------------------------------------------
+  /// @brief     Resources that a backend derives from the data of a
+  ///            |DlVertices| object, such as the vertex buffers uploaded to
+  ///            the device, and caches on it with |set_cached_resource()|.
+  ///
+  /// The data of a |DlVertices| object never changes, so the backend can reuse
+  /// the resource every time it renders the same vertices instead of
+  /// converting and uploading them again. The copies of a |DlVertices| object
+  /// that a DisplayList records share the cached resource of the original, so
+  /// that a mesh which is recorded into a new DisplayList every frame is still
+  /// only uploaded once.
+  class CachedResource {
+   public:
+    virtual ~CachedResource() = default;
+  };
+
   /// @brief     A utility class to build up a |DlVertices| object
   ///            one set of data at a time.
   class Builder {
@@ -236,6 +254,19 @@ class DlVertices {
   // Returns an equivalent sk_sp<SkVertices> analog to this object.
   sk_sp<SkVertices> skia_object() const;
 
+  /// Returns the resource that a backend cached on this object and all of
+  /// its copies, or null if none was cached.
+  ///
+  /// This method is thread-safe.
+  std::shared_ptr<CachedResource> cached_resource() const;
+
+  /// Caches a resource derived from the data of this object on it and all of
+  /// its copies, replacing any resource that was cached before. The resource
+  /// is released when the last of them is destroyed.
+  ///
+  /// This method is thread-safe.
+  void set_cached_resource(std::shared_ptr<CachedResource> resource) const;
+
   bool operator==(DlVertices const& other) const;
 
   bool operator!=(DlVertices const& other) const { return !(*this == other); }
@@ -267,6 +298,8 @@ class DlVertices {
   // in the display list buffer.
   explicit DlVertices(const DlVertices* other);
 
+  struct CachedResourceSlot;
+
   DlVertexMode mode_;
 
   int vertex_count_;
@@ -279,6 +312,9 @@ class DlVertices {
 
   SkRect bounds_;
 
+  // Shared by the object and all of its copies.
+  std::shared_ptr<CachedResourceSlot> cached_resource_slot_;
+
   const void* pod(int offset) const {
     if (offset <= 0) {
       return nullptr;
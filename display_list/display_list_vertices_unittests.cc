@@ -982,5 +982,30 @@ TEST(DisplayListVertices, TestNotEquals) {
   }
 }
 
+TEST(DisplayListVertices, CachedResource) {
+  class TestResource : public DlVertices::CachedResource {};
+
+  SkPoint coords[3] = {{2, 3}, {5, 7}, {11, 13}};
+  std::shared_ptr<const DlVertices> vertices = DlVertices::Make(
+      DlVertexMode::kTriangles, 3, coords, nullptr, nullptr);
+  EXPECT_EQ(vertices->cached_resource(), nullptr);
+
+  auto resource = std::make_shared<TestResource>();
+  vertices->set_cached_resource(resource);
+  EXPECT_EQ(vertices->cached_resource(), resource);
+
+  // Vertices with the same data are still separate objects.
+  std::shared_ptr<const DlVertices> vertices2 = DlVertices::Make(
+      DlVertexMode::kTriangles, 3, coords, nullptr, nullptr);
+  EXPECT_EQ(*vertices, *vertices2);
+  EXPECT_EQ(vertices2->cached_resource(), nullptr);
+
+  std::weak_ptr<TestResource> weak_resource = resource;
+  resource.reset();
+  EXPECT_FALSE(weak_resource.expired());
+  vertices.reset();
+  EXPECT_TRUE(weak_resource.expired());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,159 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays the frames captured by an engine run with --capture-frames-to on
+// each of the available backends, in the order they were drawn.
+//
+// Usage: frame_replay_benchmarks --frames-dir=<directory> [benchmark flags]
+//
+// Each iteration rasterizes the whole sequence of frames, so that the caches
+// warm up as they would have in the captured run. For each frame the
+// benchmark reports the CPU time spent recording its draw calls, and the time
+// spent waiting for the backend to finish drawing them, as the counters
+// <frame>.cpu_ms and <frame>.gpu_ms.
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/testing/dl_test_surface_provider.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_point.h"
+#include "third_party/benchmark/include/benchmark/benchmark.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct CapturedFrame {
+  std::string name;
+  sk_sp<SkPicture> picture;
+};
+
+std::vector<CapturedFrame> LoadFrames(const std::string& frames_dir) {
+  std::vector<CapturedFrame> frames;
+  fml::UniqueFD directory = fml::OpenDirectory(frames_dir.c_str(), false,
+                                               fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    std::cerr << "Could not open " << frames_dir << "." << std::endl;
+    return frames;
+  }
+  fml::VisitFiles(directory, [&](const fml::UniqueFD& parent,
+                                 const std::string& name) {
+    if (name.size() < 4 || name.compare(name.size() - 4, 4, ".skp") != 0) {
+      return true;
+    }
+    auto mapping = fml::FileMapping::CreateReadOnly(parent, name);
+    if (!mapping) {
+      std::cerr << "Could not read " << name << "." << std::endl;
+      return true;
+    }
+    auto picture = SkPicture::MakeFromData(mapping->GetMapping(),
+                                           mapping->GetSize());
+    if (!picture) {
+      std::cerr << "Could not decode " << name << "." << std::endl;
+      return true;
+    }
+    frames.push_back({name.substr(0, name.size() - 4), std::move(picture)});
+    return true;
+  });
+  std::sort(frames.begin(), frames.end(),
+            [](const CapturedFrame& a, const CapturedFrame& b) {
+              return a.name < b.name;
+            });
+  return frames;
+}
+
+void BM_FrameReplay(benchmark::State& state,
+                    DlSurfaceProvider::BackendType backend_type,
+                    const std::vector<CapturedFrame>& frames) {
+  auto surface_provider = DlSurfaceProvider::Create(backend_type);
+  SkRect bounds = SkRect::MakeEmpty();
+  for (const auto& frame : frames) {
+    bounds.join(frame.picture->cullRect());
+  }
+  if (bounds.isEmpty() ||
+      !surface_provider->InitializeSurface(bounds.right(), bounds.bottom())) {
+    state.SkipWithError("Could not create a surface for the frames.");
+    return;
+  }
+  auto surface = surface_provider->GetPrimarySurface()->sk_surface();
+  auto canvas = surface->getCanvas();
+
+  std::vector<fml::TimeDelta> cpu_times(frames.size());
+  std::vector<fml::TimeDelta> gpu_times(frames.size());
+  for ([[maybe_unused]] auto _ : state) {
+    for (size_t i = 0; i < frames.size(); i++) {
+      fml::TimePoint start = fml::TimePoint::Now();
+      canvas->clear(SK_ColorTRANSPARENT);
+      frames[i].picture->playback(canvas);
+      fml::TimePoint recorded = fml::TimePoint::Now();
+      surface->flushAndSubmit(true);
+      cpu_times[i] = cpu_times[i] + (recorded - start);
+      gpu_times[i] = gpu_times[i] + (fml::TimePoint::Now() - recorded);
+    }
+  }
+
+  state.counters["FrameCount"] = frames.size();
+  for (size_t i = 0; i < frames.size(); i++) {
+    state.counters[frames[i].name + ".cpu_ms"] =
+        benchmark::Counter(cpu_times[i].ToMillisecondsF(),
+                           benchmark::Counter::kAvgIterations);
+    state.counters[frames[i].name + ".gpu_ms"] =
+        benchmark::Counter(gpu_times[i].ToMillisecondsF(),
+                           benchmark::Counter::kAvgIterations);
+  }
+}
+
+void RegisterBenchmarks(const std::vector<CapturedFrame>& frames) {
+  const DlSurfaceProvider::BackendType backends[] = {
+      DlSurfaceProvider::kSoftware_Backend,
+      DlSurfaceProvider::kOpenGL_Backend,
+      DlSurfaceProvider::kMetal_Backend,
+  };
+  for (auto backend : backends) {
+    auto provider = DlSurfaceProvider::Create(backend);
+    if (!provider) {
+      continue;
+    }
+    benchmark::RegisterBenchmark(
+        ("BM_FrameReplay/" + provider->backend_name()).c_str(),
+        [backend, &frames](benchmark::State& state) {
+          BM_FrameReplay(state, backend, frames);
+        })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+  }
+}
+
+}  // namespace
+
+}  // namespace testing
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  fml::CommandLine command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  std::string frames_dir;
+  if (!command_line.GetOptionValue("frames-dir", &frames_dir)) {
+    std::cerr << "Usage: frame_replay_benchmarks --frames-dir=<directory>"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  auto frames = flutter::testing::LoadFrames(frames_dir);
+  if (frames.empty()) {
+    std::cerr << "No frames were found in " << frames_dir << "." << std::endl;
+    return EXIT_FAILURE;
+  }
+  flutter::testing::RegisterBenchmarks(frames);
+  benchmark::RunSpecifiedBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -4,50 +4,148 @@
 
 #include "flutter/flow/compositor_context.h"
 
+#include <iomanip>
 #include <optional>
+#include <sstream>
 #include <utility>
 #include "flutter/flow/layers/layer_tree.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
 
 namespace flutter {
 
+bool FrameDamage::CanReuseDiff(const LayerTree& layer_tree,
+                               bool has_raster_cache) const {
+  return diff_ && diff_->layer_tree == &layer_tree &&
+         diff_->prev_layer_tree == prev_layer_tree_ &&
+         diff_->has_raster_cache == has_raster_cache &&
+         diff_->records_damage_rects == visualize_damage_ &&
+         diff_->max_damage_rects == max_damage_rects_;
+}
+
 std::optional<SkRect> FrameDamage::ComputeClipRect(
     flutter::LayerTree& layer_tree,
     bool has_raster_cache) {
   if (layer_tree.root_layer()) {
-    PaintRegionMap empty_paint_region_map;
-    DiffContext context(layer_tree.frame_size(),
-                        layer_tree.device_pixel_ratio(),
-                        layer_tree.paint_region_map(),
-                        prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
-                                         : empty_paint_region_map,
-                        has_raster_cache);
-    context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
-                                         layer_tree.frame_size().height()));
-    {
-      DiffContext::AutoSubtreeRestore subtree(&context);
-      const Layer* prev_root_layer = nullptr;
-      if (!prev_layer_tree_ ||
-          prev_layer_tree_->frame_size() != layer_tree.frame_size()) {
-        // If there is no previous layer tree assume the entire frame must be
-        // repainted.
-        context.MarkSubtreeDirty(SkRect::MakeIWH(
-            layer_tree.frame_size().width(), layer_tree.frame_size().height()));
-      } else {
-        prev_root_layer = prev_layer_tree_->root_layer();
+    if (!CanReuseDiff(layer_tree, has_raster_cache)) {
+      diff_ = std::make_unique<Diff>();
+      diff_->context = std::make_unique<DiffContext>(
+          layer_tree.frame_size(), layer_tree.device_pixel_ratio(),
+          layer_tree.paint_region_map(),
+          prev_layer_tree_ ? prev_layer_tree_->paint_region_map()
+                           : diff_->empty_paint_region_map,
+          has_raster_cache);
+      diff_->layer_tree = &layer_tree;
+      diff_->prev_layer_tree = prev_layer_tree_;
+      diff_->has_raster_cache = has_raster_cache;
+      diff_->records_damage_rects = visualize_damage_;
+      diff_->max_damage_rects = max_damage_rects_;
+      DiffContext& context = *diff_->context;
+      context.statistics().set_records_damage_rects(visualize_damage_);
+      context.set_max_damage_rects(max_damage_rects_);
+      context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
+                                           layer_tree.frame_size().height()));
+      {
+        DiffContext::AutoSubtreeRestore subtree(&context);
+        const Layer* prev_root_layer = nullptr;
+        if (!prev_layer_tree_ ||
+            prev_layer_tree_->frame_size() != layer_tree.frame_size()) {
+          // If there is no previous layer tree assume the entire frame must be
+          // repainted.
+          context.MarkSubtreeDirty(
+              SkRect::MakeIWH(layer_tree.frame_size().width(),
+                              layer_tree.frame_size().height()),
+              DamageReason::kNoPreviousFrame);
+        } else {
+          prev_root_layer = prev_layer_tree_->root_layer();
+        }
+        layer_tree.root_layer()->Diff(&context, prev_root_layer);
       }
-      layer_tree.root_layer()->Diff(&context, prev_root_layer);
     }
 
+    const DiffContext& context = *diff_->context;
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
                               vertical_clip_alignment_);
+    statistics_ = context.statistics();
+    statistics_->SetFrameDamage(damage_->frame_damage, layer_tree.frame_size());
+    statistics_->LogStatistics();
+
+    if (visualize_damage_) {
+      // The outlines drawn over the previous frame are part of its pixels,
+      // not of its layer tree, so they are only removed if repainted.
+      damage_->frame_damage.join(previous_visualized_damage_);
+      damage_->buffer_damage.join(previous_visualized_damage_);
+      damage_->frame_damage_rects = {damage_->frame_damage};
+      damage_->buffer_damage_rects = {damage_->buffer_damage};
+    }
     return SkRect::Make(damage_->buffer_damage);
   } else {
     return std::nullopt;
   }
 }
 
+SkIRect FrameDamage::GetVisualizedDamage() const {
+  SkRect bounds = SkRect::MakeEmpty();
+  if (visualize_damage_ && statistics_) {
+    for (const auto& damage_rect : statistics_->damage_rects()) {
+      bounds.join(damage_rect.rect);
+    }
+  }
+  return bounds.roundOut();
+}
+
+void FrameDamage::VisualizeDamage(DlCanvas* canvas) const {
+  if (!visualize_damage_ || !statistics_ || !canvas) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "FrameDamage::VisualizeDamage");
+  DlPaint paint;
+  paint.setDrawStyle(DlDrawStyle::kStroke);
+  paint.setStrokeWidth(2);
+  for (const auto& damage_rect : statistics_->damage_rects()) {
+    switch (damage_rect.reason) {
+      case DamageReason::kNoPreviousFrame:
+        paint.setColor(DlColor::kWhite());
+        break;
+      case DamageReason::kNewLayer:
+        paint.setColor(DlColor::kGreen());
+        break;
+      case DamageReason::kRemovedLayer:
+        paint.setColor(DlColor::kRed());
+        break;
+      case DamageReason::kLayerChanged:
+        paint.setColor(DlColor::kYellow());
+        break;
+      case DamageReason::kContentChanged:
+        paint.setColor(DlColor::kCyan());
+        break;
+    }
+    // Keep the stroke inside of the damaged area.
+    canvas->DrawRect(damage_rect.rect.makeInset(1, 1), paint);
+  }
+
+  SkIRect bounds = GetVisualizedDamage();
+  if (bounds.isEmpty()) {
+    return;
+  }
+  std::stringstream stream;
+  stream.setf(std::ios::fixed | std::ios::showpoint);
+  stream << std::setprecision(1) << "damage "
+         << statistics_->damage_percentage() << "%, "
+         << statistics_->diffed_layers() << " layers diffed, "
+         << statistics_->retained_layers() << " retained";
+  std::string text = stream.str();
+  SkFont font;
+  font.setSize(12);
+  DlPaint text_paint(DlColor::kWhite());
+  canvas->DrawTextBlob(SkTextBlob::MakeFromText(text.c_str(), text.size(),
+                                                font, SkTextEncoding::kUTF8),
+                       bounds.left() + 4, bounds.top() + 14, text_paint);
+}
+
 CompositorContext::CompositorContext()
     : texture_registry_(std::make_shared<TextureRegistry>()),
       raster_time_(fixed_refresh_rate_updater_),
@@ -60,6 +158,18 @@ CompositorContext::CompositorContext(Stopwatch::RefreshRateUpdater& updater)
 
 CompositorContext::~CompositorContext() = default;
 
+bool CompositorContext::ShouldSampleLayerTimings() {
+  if (layer_timing_sample_interval_ == 0u) {
+    return false;
+  }
+  if (frames_until_layer_timing_sample_ > 0u) {
+    frames_until_layer_timing_sample_--;
+    return false;
+  }
+  frames_until_layer_timing_sample_ = layer_timing_sample_interval_ - 1u;
+  return true;
+}
+
 void CompositorContext::BeginFrame(ScopedFrame& frame,
                                    bool enable_instrumentation) {
   if (enable_instrumentation) {
@@ -125,13 +235,22 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     FrameDamage* frame_damage) {
   TRACE_EVENT0("flutter", "CompositorContext::ScopedFrame::Raster");
 
+  for (auto& duration : raster_phase_durations_) {
+    duration = fml::TimeDelta::Zero();
+  }
+
+  fml::TimePoint diff_start = fml::TimePoint::Now();
   std::optional<SkRect> clip_rect =
       frame_damage
           ? frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache)
           : std::nullopt;
 
+  fml::TimePoint preroll_start = fml::TimePoint::Now();
+  raster_phase_durations_[FrameTiming::kDiff] = preroll_start - diff_start;
   bool root_needs_readback = layer_tree.Preroll(
       *this, ignore_raster_cache, clip_rect ? *clip_rect : kGiantRect);
+  fml::TimePoint paint_start = fml::TimePoint::Now();
+  raster_phase_durations_[FrameTiming::kPreroll] = paint_start - preroll_start;
   bool needs_save_layer = root_needs_readback && !surface_supports_readback();
   PostPrerollResult post_preroll_result = PostPrerollResult::kSuccess;
   if (view_embedder_ && raster_thread_merger_) {
@@ -153,6 +272,16 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (canvas()) {
     if (clip_rect) {
       canvas()->ClipRect(*clip_rect);
+      // Nothing outside of the rects needs to be repainted, which can save
+      // a lot of fill rate when they are far apart.
+      std::vector<SkIRect> damage_rects = frame_damage->GetBufferDamageRects();
+      if (damage_rects.size() > 1) {
+        SkPath path;
+        for (const SkIRect& rect : damage_rects) {
+          path.addRect(SkRect::Make(rect));
+        }
+        canvas()->ClipPath(path);
+      }
     }
 
     if (needs_save_layer) {
@@ -165,6 +294,11 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
     canvas()->Clear(DlColor::kTransparent());
   }
   layer_tree.Paint(*this, ignore_raster_cache);
+  if (frame_damage) {
+    frame_damage->VisualizeDamage(canvas());
+  }
+  raster_phase_durations_[FrameTiming::kPaint] =
+      fml::TimePoint::Now() - paint_start;
   // The canvas()->Restore() is taken care of by the DlAutoCanvasRestore
   return RasterStatus::kSuccess;
 }
@@ -6,9 +6,12 @@
 #define FLUTTER_FLOW_COMPOSITOR_CONTEXT_H_
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "flutter/common/graphics/texture.h"
+#include "flutter/common/settings.h"
 #include "flutter/flow/diff_context.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/instrumentation.h"
@@ -16,6 +19,7 @@
 #include "flutter/flow/raster_cache.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/raster_thread_merger.h"
+#include "flutter/fml/task_runner.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
@@ -54,6 +58,9 @@ enum class RasterStatus {
   // Drawing was yielded to allow the correct thread to draw as a result of the
   // RasterThreadMerger.
   kYielded,
+  // The layer tree would have rendered the same pixels as the last one, so
+  // nothing was rasterized or presented.
+  kSkipped,
 };
 
 class FrameDamage {
@@ -76,6 +83,12 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Specifies how many disjoint rects the damage may be split into, see
+  // DiffContext::set_max_damage_rects.
+  void SetMaxDamageRects(size_t max_damage_rects) {
+    max_damage_rects_ = max_damage_rects;
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
@@ -84,6 +97,11 @@ class FrameDamage {
   std::optional<SkRect> ComputeClipRect(flutter::LayerTree& layer_tree,
                                         bool has_raster_cache);
 
+  // Takes the diff computed by the last ComputeClipRect of |other|, which
+  // ComputeClipRect uses instead of diffing the layer trees again if it
+  // diffs the same layer trees with the same options.
+  void ReuseDiff(FrameDamage& other) { diff_ = std::move(other.diff_); }
+
   // See Damage::frame_damage.
   std::optional<SkIRect> GetFrameDamage() const {
     return damage_ ? std::make_optional(damage_->frame_damage) : std::nullopt;
@@ -94,12 +112,61 @@ class FrameDamage {
     return damage_ ? std::make_optional(damage_->buffer_damage) : std::nullopt;
   }
 
+  // See Damage::frame_damage_rects.
+  std::vector<SkIRect> GetFrameDamageRects() const {
+    return damage_ ? damage_->frame_damage_rects : std::vector<SkIRect>();
+  }
+
+  // See Damage::buffer_damage_rects.
+  std::vector<SkIRect> GetBufferDamageRects() const {
+    return damage_ ? damage_->buffer_damage_rects : std::vector<SkIRect>();
+  }
+
+  // The statistics of the diff performed by ComputeClipRect, if any.
+  const DiffContext::Statistics* GetStatistics() const {
+    return statistics_ ? &statistics_.value() : nullptr;
+  }
+
+  // Outlines the damage rects of the frame, colored by the reason they were
+  // damaged, when VisualizeDamage is called. |previous_visualized_damage|
+  // is the area outlined in the previous frame, which is repainted so that
+  // the outlines do not stay on screen.
+  void EnableDamageVisualization(const SkIRect& previous_visualized_damage) {
+    visualize_damage_ = true;
+    previous_visualized_damage_ = previous_visualized_damage;
+  }
+
+  // The area that VisualizeDamage draws into.
+  SkIRect GetVisualizedDamage() const;
+
+  // Draws the damage rects and a summary of the statistics, if damage
+  // visualization is enabled.
+  void VisualizeDamage(DlCanvas* canvas) const;
+
  private:
+  struct Diff {
+    // The map that the context diffs against without a previous layer tree.
+    PaintRegionMap empty_paint_region_map;
+    std::unique_ptr<DiffContext> context;
+    const LayerTree* layer_tree = nullptr;
+    const LayerTree* prev_layer_tree = nullptr;
+    bool has_raster_cache = false;
+    bool records_damage_rects = false;
+    size_t max_damage_rects = 1;
+  };
+
+  bool CanReuseDiff(const LayerTree& layer_tree, bool has_raster_cache) const;
+
   SkIRect additional_damage_ = SkIRect::MakeEmpty();
+  std::unique_ptr<Diff> diff_;
   std::optional<Damage> damage_;
+  std::optional<DiffContext::Statistics> statistics_;
+  bool visualize_damage_ = false;
+  SkIRect previous_visualized_damage_ = SkIRect::MakeEmpty();
   const LayerTree* prev_layer_tree_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
+  size_t max_damage_rects_ = 1;
 };
 
 class CompositorContext {
@@ -143,6 +210,13 @@ class CompositorContext {
                                 bool ignore_raster_cache,
                                 FrameDamage* frame_damage);
 
+    // How long the diff, preroll and paint steps of the last call to
+    // |Raster| took. The other phases are not measured here.
+    fml::TimeDelta GetRasterPhaseDuration(
+        FrameTiming::RasterPhase phase) const {
+      return raster_phase_durations_[phase];
+    }
+
    private:
     CompositorContext& context_;
     GrDirectContext* gr_context_;
@@ -154,6 +228,7 @@ class CompositorContext {
     const bool instrumentation_enabled_;
     const bool surface_supports_readback_;
     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
+    fml::TimeDelta raster_phase_durations_[FrameTiming::kRasterPhaseCount];
 
     FML_DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
   };
@@ -191,12 +266,83 @@ class CompositorContext {
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
 
+  // Samples how long painting the leaf layers of one in every |interval|
+  // frames takes, along with their bounds but without the snapshots of
+  // |snapshot_store|, so that it is cheap enough for production sessions.
+  // 0 disables the sampling.
+  void set_layer_timing_sample_interval(uint32_t interval) {
+    layer_timing_sample_interval_ = interval;
+    frames_until_layer_timing_sample_ = 0u;
+  }
+
+  uint32_t layer_timing_sample_interval() const {
+    return layer_timing_sample_interval_;
+  }
+
+  // Returns whether the frame that is about to be painted is sampled, see
+  // |set_layer_timing_sample_interval|. Counts the frame either way.
+  bool ShouldSampleLayerTimings();
+
+  // The layer timings of the last frame that was sampled.
+  LayerSnapshotStore& layer_timing_store() { return layer_timing_store_; }
+
+  // Sets the task runner used to preroll large layer subtrees concurrently,
+  // see |PrerollContext::concurrent_task_runner|. Null disables concurrent
+  // preroll.
+  void set_preroll_task_runner(
+      std::shared_ptr<fml::BasicTaskRunner> task_runner) {
+    preroll_task_runner_ = std::move(task_runner);
+  }
+
+  fml::BasicTaskRunner* preroll_task_runner() const {
+    return preroll_task_runner_.get();
+  }
+
+  // Whether retained layers can reuse the results of their earlier preroll,
+  // see |PrerollContext::reuse_retained_preroll|.
+  void set_reuse_retained_preroll(bool reuse) {
+    reuse_retained_preroll_ = reuse;
+  }
+
+  bool reuse_retained_preroll() const { return reuse_retained_preroll_; }
+
+  // Whether frames render expensive effects at a reduced quality and serve
+  // stale raster cache entries, see |RasterQualityPolicy|.
+  void set_reduce_raster_quality(bool reduce) {
+    reduce_raster_quality_ = reduce;
+    raster_cache_.SetServeStaleEntries(reduce);
+  }
+
+  bool reduce_raster_quality() const { return reduce_raster_quality_; }
+
+  // The GPU memory used by the renderer as of the last frame, if the
+  // renderer accounts for it, see |PaintContext::gpu_memory_usage|.
+  void set_gpu_memory_usage(std::optional<GpuMemoryUsage> usage) {
+    gpu_memory_usage_ = usage;
+  }
+
+  const GpuMemoryUsage* gpu_memory_usage() const {
+    return gpu_memory_usage_ ? &gpu_memory_usage_.value() : nullptr;
+  }
+
+  // The statistics of the past frames, see
+  // |PaintContext::frame_statistics|.
+  FrameStatisticsHistory& frame_statistics() { return frame_statistics_; }
+
  private:
   RasterCache raster_cache_;
   std::shared_ptr<TextureRegistry> texture_registry_;
   Stopwatch raster_time_;
   Stopwatch ui_time_;
   LayerSnapshotStore layer_snapshot_store_;
+  LayerSnapshotStore layer_timing_store_;
+  uint32_t layer_timing_sample_interval_ = 0u;
+  uint32_t frames_until_layer_timing_sample_ = 0u;
+  std::shared_ptr<fml::BasicTaskRunner> preroll_task_runner_;
+  bool reuse_retained_preroll_ = false;
+  bool reduce_raster_quality_ = false;
+  std::optional<GpuMemoryUsage> gpu_memory_usage_;
+  FrameStatisticsHistory frame_statistics_;
 
   /// Only used by default constructor of `CompositorContext`.
   FixedRefreshRateUpdater fixed_refresh_rate_updater_;
@@ -7,6 +7,67 @@
 
 namespace flutter {
 
+namespace {
+
+int64_t Area(const SkIRect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+// Returns the area of the bounds of both rects that is covered by neither of
+// them, which is repainted needlessly if the rects are merged.
+int64_t MergeCost(const SkIRect& a, const SkIRect& b) {
+  SkIRect bounds = a;
+  bounds.join(b);
+  SkIRect intersection;
+  int64_t overlap = intersection.intersect(a, b) ? Area(intersection) : 0;
+  return Area(bounds) - Area(a) - Area(b) + overlap;
+}
+
+// Adds |rect| to the disjoint rects in |rects|. Rects that |rect| overlaps
+// or that it can be merged with at no cost are merged into it, and then the
+// cheapest pairs are merged until there are no more than |max_rects|.
+void AddDamageRect(std::vector<SkIRect>& rects,
+                   SkIRect rect,
+                   size_t max_rects) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  for (size_t i = 0; i < rects.size();) {
+    if (SkIRect::Intersects(rects[i], rect) || MergeCost(rects[i], rect) == 0) {
+      // The merged rect may now overlap rects that were already checked.
+      rect.join(rects[i]);
+      rects.erase(rects.begin() + i);
+      i = 0;
+    } else {
+      ++i;
+    }
+  }
+  rects.push_back(rect);
+
+  if (rects.size() > max_rects) {
+    size_t best_i = 0;
+    size_t best_j = 1;
+    int64_t best_cost = MergeCost(rects[0], rects[1]);
+    for (size_t i = 0; i < rects.size(); ++i) {
+      for (size_t j = i + 1; j < rects.size(); ++j) {
+        int64_t cost = MergeCost(rects[i], rects[j]);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_i = i;
+          best_j = j;
+        }
+      }
+    }
+    SkIRect merged = rects[best_i];
+    merged.join(rects[best_j]);
+    rects.erase(rects.begin() + best_j);
+    rects.erase(rects.begin() + best_i);
+    AddDamageRect(rects, merged, max_rects);
+  }
+}
+
+}  // namespace
+
 DiffContext::DiffContext(SkISize frame_size,
                          double frame_device_pixel_ratio,
                          PaintRegionMap& this_frame_paint_region_map,
@@ -49,6 +110,7 @@ void DiffContext::EndSubtree() {
 
 DiffContext::State::State()
     : dirty(false),
+      dirty_reason(DamageReason::kLayerChanged),
       rect_index(0),
       integral_transform(false),
       clip_tracker_save_count(0),
@@ -136,12 +198,56 @@ Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
   res.buffer_damage.intersect(frame_clip);
   res.frame_damage.intersect(frame_clip);
 
-  if (horizontal_clip_alignment > 1 || vertical_clip_alignment > 1) {
+  bool align = horizontal_clip_alignment > 1 || vertical_clip_alignment > 1;
+  if (align) {
     AlignRect(res.buffer_damage, horizontal_clip_alignment,
               vertical_clip_alignment);
     AlignRect(res.frame_damage, horizontal_clip_alignment,
               vertical_clip_alignment);
   }
+
+  if (max_damage_rects_ == 1) {
+    if (!res.frame_damage.isEmpty()) {
+      res.frame_damage_rects.push_back(res.frame_damage);
+    }
+    if (!res.buffer_damage.isEmpty()) {
+      res.buffer_damage_rects.push_back(res.buffer_damage);
+    }
+    return res;
+  }
+
+  // Only the readbacks that overlap one of the rects need to be repainted,
+  // which may be fewer than the ones that overlap the bounds of all rects.
+  auto add_readbacks = [&](std::vector<SkIRect>& rects) {
+    for (const auto& r : readbacks_) {
+      if (std::any_of(rects.begin(), rects.end(), [&](const SkIRect& rect) {
+            return SkIRect::Intersects(rect, r.rect);
+          })) {
+        AddDamageRect(rects, r.rect, max_damage_rects_);
+      }
+    }
+  };
+  std::vector<SkIRect> frame_rects = damage_rects_;
+  add_readbacks(frame_rects);
+  std::vector<SkIRect> buffer_rects = frame_rects;
+  AddDamageRect(buffer_rects, accumulated_buffer_damage, max_damage_rects_);
+  add_readbacks(buffer_rects);
+
+  // Clipping and alignment may make rects overlap, so they are added again.
+  auto finish_rects = [&](const std::vector<SkIRect>& rects,
+                          std::vector<SkIRect>& result) {
+    for (SkIRect rect : rects) {
+      if (!rect.intersect(frame_clip)) {
+        continue;
+      }
+      if (align) {
+        AlignRect(rect, horizontal_clip_alignment, vertical_clip_alignment);
+      }
+      AddDamageRect(result, rect, max_damage_rects_);
+    }
+  };
+  finish_rects(frame_rects, res.frame_damage_rects);
+  finish_rects(buffer_rects, res.buffer_damage_rects);
   return res;
 }
 
@@ -164,39 +270,60 @@ SkRect DiffContext::GetCullRect() const {
   return clip_tracker_.local_cull_rect();
 }
 
-void DiffContext::MarkSubtreeDirty(const PaintRegion& previous_paint_region) {
+void DiffContext::MarkSubtreeDirty(const PaintRegion& previous_paint_region,
+                                   DamageReason reason) {
   FML_DCHECK(!IsSubtreeDirty());
   if (previous_paint_region.is_valid()) {
-    AddDamage(previous_paint_region);
+    for (const auto& r : previous_paint_region) {
+      AddDamage(r, reason);
+    }
   }
   state_.dirty = true;
+  state_.dirty_reason = reason;
 }
 
-void DiffContext::MarkSubtreeDirty(const SkRect& previous_paint_region) {
+void DiffContext::MarkSubtreeDirty(const SkRect& previous_paint_region,
+                                   DamageReason reason) {
   FML_DCHECK(!IsSubtreeDirty());
-  AddDamage(previous_paint_region);
+  AddDamage(previous_paint_region, reason);
   state_.dirty = true;
+  state_.dirty_reason = reason;
 }
 
-void DiffContext::AddLayerBounds(const SkRect& rect) {
+bool DiffContext::MapLayerRect(const SkRect& rect, SkRect& mapped_rect) {
   // During painting we cull based on non-overriden transform and then
   // override the transform right before paint. Do the same thing here to get
   // identical paint rect.
-  auto transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-  if (transformed_rect.intersects(clip_tracker_.device_cull_rect())) {
-    if (state_.integral_transform) {
-      clip_tracker_.save();
-      MakeCurrentTransformIntegral();
-      transformed_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
-      clip_tracker_.restore();
-    }
+  mapped_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
+  if (!mapped_rect.intersects(clip_tracker_.device_cull_rect())) {
+    return false;
+  }
+  if (state_.integral_transform) {
+    clip_tracker_.save();
+    MakeCurrentTransformIntegral();
+    mapped_rect = ApplyFilterBoundsAdjustment(MapRect(rect));
+    clip_tracker_.restore();
+  }
+  return true;
+}
+
+void DiffContext::AddLayerBounds(const SkRect& rect) {
+  SkRect transformed_rect;
+  if (MapLayerRect(rect, transformed_rect)) {
     rects_->push_back(transformed_rect);
     if (IsSubtreeDirty()) {
-      AddDamage(transformed_rect);
+      AddDamage(transformed_rect, state_.dirty_reason);
     }
   }
 }
 
+void DiffContext::AddLayerDamage(const SkRect& rect) {
+  SkRect transformed_rect;
+  if (MapLayerRect(rect, transformed_rect)) {
+    AddDamage(transformed_rect, DamageReason::kContentChanged);
+  }
+}
+
 void DiffContext::MarkSubtreeHasTextureLayer() {
   // Set the has_texture flag on current state and all parent states. That
   // way we'll know that we can't skip diff for retained layers because
@@ -236,12 +363,16 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    AddDamage(r, DamageReason::kRemovedLayer);
   }
 }
 
-void DiffContext::AddDamage(const SkRect& rect) {
+void DiffContext::AddDamage(const SkRect& rect, DamageReason reason) {
   damage_.join(rect);
+  if (max_damage_rects_ > 1) {
+    AddDamageRect(damage_rects_, rect.roundOut(), max_damage_rects_);
+  }
+  statistics_.AddDamage(rect, reason);
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -260,6 +391,57 @@ PaintRegion DiffContext::GetOldLayerPaintRegion(const Layer* layer) const {
   }
 }
 
+void DiffContext::Statistics::AddDamage(const SkRect& rect,
+                                        DamageReason reason) {
+  switch (reason) {
+    case DamageReason::kNoPreviousFrame:
+      ++no_previous_frame_damage_;
+      break;
+    case DamageReason::kNewLayer:
+      ++new_layer_damage_;
+      break;
+    case DamageReason::kRemovedLayer:
+      ++removed_layer_damage_;
+      break;
+    case DamageReason::kLayerChanged:
+      ++layer_changed_damage_;
+      break;
+    case DamageReason::kContentChanged:
+      ++content_changed_damage_;
+      break;
+  }
+  if (records_damage_rects_) {
+    damage_rects_.push_back({rect, reason});
+  }
+}
+
+int DiffContext::Statistics::damage_count(DamageReason reason) const {
+  switch (reason) {
+    case DamageReason::kNoPreviousFrame:
+      return no_previous_frame_damage_;
+    case DamageReason::kNewLayer:
+      return new_layer_damage_;
+    case DamageReason::kRemovedLayer:
+      return removed_layer_damage_;
+    case DamageReason::kLayerChanged:
+      return layer_changed_damage_;
+    case DamageReason::kContentChanged:
+      return content_changed_damage_;
+  }
+  return 0;
+}
+
+void DiffContext::Statistics::SetFrameDamage(const SkIRect& frame_damage,
+                                             const SkISize& frame_size) {
+  if (frame_size.isEmpty()) {
+    damage_percentage_ = 0;
+    return;
+  }
+  damage_percentage_ = 100.0 * frame_damage.width() * frame_damage.height() /
+                       (static_cast<double>(frame_size.width()) *
+                        frame_size.height());
+}
+
 void DiffContext::Statistics::LogStatistics() {
 #if !FLUTTER_RELEASE
   FML_TRACE_COUNTER("flutter", "DiffContext", reinterpret_cast<int64_t>(this),
@@ -269,6 +451,17 @@ void DiffContext::Statistics::LogStatistics() {
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
                     different_instance_but_equal_pictures_);
+  FML_TRACE_COUNTER("flutter", "DiffContextLayers",
+                    reinterpret_cast<int64_t>(this), "DiffedLayers",
+                    diffed_layers_, "RetainedLayers", retained_layers_,
+                    "RetainedLayersNotReused", retained_layers_not_reused_);
+  FML_TRACE_COUNTER("flutter", "DiffContextDamage",
+                    reinterpret_cast<int64_t>(this), "DamagePercentage",
+                    static_cast<int64_t>(damage_percentage_ + 0.5),
+                    "NoPreviousFrame", no_previous_frame_damage_, "NewLayer",
+                    new_layer_damage_, "RemovedLayer", removed_layer_damage_,
+                    "LayerChanged", layer_changed_damage_, "ContentChanged",
+                    content_changed_damage_);
 #endif  // !FLUTTER_RELEASE
 }
 
@@ -34,6 +34,32 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // Disjoint rects within frame_damage and buffer_damage that cover all of
+  // the damage, so that two small changes far apart do not need the area
+  // between them to be repainted. There is only ever one rect, equal to
+  // frame_damage and buffer_damage, unless more were allowed with
+  // DiffContext::set_max_damage_rects.
+  std::vector<SkIRect> frame_damage_rects;
+  std::vector<SkIRect> buffer_damage_rects;
+};
+
+// The reasons for which DiffContext adds damage.
+enum class DamageReason {
+  // There is no previous frame that the layer tree can be diffed with.
+  kNoPreviousFrame,
+  // The layer does not replace a layer of the previous frame, for example
+  // because it was inserted or because the DisplayList of a DisplayListLayer
+  // is not equal to the previous one.
+  kNewLayer,
+  // The layer of the previous frame was removed or replaced.
+  kRemovedLayer,
+  // The layer replaces a layer of the previous frame but its properties,
+  // such as a transform or opacity, are different.
+  kLayerChanged,
+  // The layer replaces a layer of the previous frame and only parts of its
+  // content are different.
+  kContentChanged,
 };
 
 // Layer Unique Id to PaintRegion
@@ -99,9 +125,14 @@ class DiffContext {
   //
   // Each paint region added to dirty subtree (through AddPaintRegion) is also
   // added to damage.
+  //
+  // reason is recorded in statistics() for all of the damage added by the
+  // dirty subtree.
   void MarkSubtreeDirty(
-      const PaintRegion& previous_paint_region = PaintRegion());
-  void MarkSubtreeDirty(const SkRect& previous_paint_region);
+      const PaintRegion& previous_paint_region = PaintRegion(),
+      DamageReason reason = DamageReason::kLayerChanged);
+  void MarkSubtreeDirty(const SkRect& previous_paint_region,
+                        DamageReason reason = DamageReason::kLayerChanged);
 
   bool IsSubtreeDirty() const { return state_.dirty; }
 
@@ -113,6 +144,11 @@ class DiffContext {
   // coordinates.
   void AddLayerBounds(const SkRect& rect);
 
+  // Add rect to current damage without adding it to the paint region; rect is
+  // in "local" (layer) coordinates. Used by layers that are not dirty but can
+  // determine which parts of their content changed since the last frame.
+  void AddLayerDamage(const SkRect& rect);
+
   // Add entire paint region of retained layer for current subtree. This can
   // only be used in subtrees that are not dirty, otherwise ancestor transforms
   // or clips may result in different paint region.
@@ -143,6 +179,15 @@ class DiffContext {
 
   double frame_device_pixel_ratio() const { return frame_device_pixel_ratio_; };
 
+  // Sets the number of rects that ComputeDamage may return in
+  // Damage::frame_damage_rects and Damage::buffer_damage_rects. The rects
+  // that are closest to each other are merged until there are no more than
+  // this many. Defaults to 1. Must be called before diffing.
+  void set_max_damage_rects(size_t max_damage_rects) {
+    FML_DCHECK(max_damage_rects > 0);
+    max_damage_rects_ = max_damage_rects;
+  }
+
   // Adds the region to current damage. Used for removed layers, where instead
   // of diffing the layer its paint region is direcly added to damage.
   void AddDamage(const PaintRegion& damage);
@@ -164,6 +209,12 @@ class DiffContext {
 
   class Statistics {
    public:
+    // A rect added to the damage, in screen coordinates.
+    struct DamageRect {
+      SkRect rect;
+      DamageReason reason;
+    };
+
     // Picture replaced by different picture
     void AddNewPicture() { ++new_pictures_; }
 
@@ -183,6 +234,45 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Layer that was diffed with the layer it replaces, or as a new layer
+    void AddDiffedLayer() { ++diffed_layers_; }
+
+    // Retained layer whose paint region was reused without diffing it
+    void AddRetainedLayer() { ++retained_layers_; }
+
+    // Retained layer that still had to be diffed because its subtree does
+    // readback or contains a texture
+    void AddRetainedLayerNotReused() { ++retained_layers_not_reused_; }
+
+    // Rect added to the damage for the given reason
+    void AddDamage(const SkRect& rect, DamageReason reason);
+
+    // Sets the final damage of the frame, which is used to compute the
+    // percentage of the frame that is damaged.
+    void SetFrameDamage(const SkIRect& frame_damage, const SkISize& frame_size);
+
+    // Whether the rects added to the damage are recorded in damage_rects().
+    // This is off by default as it is only needed to visualize the damage.
+    void set_records_damage_rects(bool records) {
+      records_damage_rects_ = records;
+    }
+
+    int diffed_layers() const { return diffed_layers_; }
+    int retained_layers() const { return retained_layers_; }
+    int retained_layers_not_reused() const {
+      return retained_layers_not_reused_;
+    }
+
+    // The number of rects added to the damage for the given reason.
+    int damage_count(DamageReason reason) const;
+
+    // The percentage of the frame area covered by the frame damage.
+    double damage_percentage() const { return damage_percentage_; }
+
+    const std::vector<DamageRect>& damage_rects() const {
+      return damage_rects_;
+    }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -192,9 +282,21 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int diffed_layers_ = 0;
+    int retained_layers_ = 0;
+    int retained_layers_not_reused_ = 0;
+    int no_previous_frame_damage_ = 0;
+    int new_layer_damage_ = 0;
+    int removed_layer_damage_ = 0;
+    int layer_changed_damage_ = 0;
+    int content_changed_damage_ = 0;
+    double damage_percentage_ = 0;
+    bool records_damage_rects_ = false;
+    std::vector<DamageRect> damage_rects_;
   };
 
   Statistics& statistics() { return statistics_; }
+  const Statistics& statistics() const { return statistics_; }
 
   SkRect MapRect(const SkRect& rect);
 
@@ -204,6 +306,9 @@ class DiffContext {
 
     bool dirty;
 
+    // The reason recorded for the damage of a dirty subtree.
+    DamageReason dirty_reason;
+
     size_t rect_index;
 
     // In order to replicate paint process closely, DiffContext needs to take
@@ -243,12 +348,19 @@ class DiffContext {
   SkRect ApplyFilterBoundsAdjustment(SkRect rect) const;
 
   SkRect damage_ = SkRect::MakeEmpty();
+  // The damage as disjoint rects, see |Damage::frame_damage_rects|.
+  std::vector<SkIRect> damage_rects_;
+  size_t max_damage_rects_ = 1;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
   bool has_raster_cache_;
 
-  void AddDamage(const SkRect& rect);
+  void AddDamage(const SkRect& rect, DamageReason reason);
+
+  // Maps rect from "local" (layer) coordinates to the rect that will be
+  // painted, returns false if the rect is culled.
+  bool MapLayerRect(const SkRect& rect, SkRect& mapped_rect);
 
   void AlignRect(SkIRect& rect,
                  int horizontal_alignment,
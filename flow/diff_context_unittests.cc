@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/testing/diff_context_test.h"
 
 namespace flutter {
@@ -32,5 +34,136 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, DamageIsSplitIntoDisjointRects) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(0, 0, 10, 10), 1)));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(5, 5, 20, 20), 1)));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 900, 1000, 1000), 1)));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 0, 1000, 10), 1)));
+
+  // With a single rect the damage covers most of the frame.
+  auto damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 0, 0,
+                              true, 1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 1000, 1000));
+  EXPECT_EQ(damage.frame_damage_rects,
+            std::vector<SkIRect>{SkIRect::MakeLTRB(0, 0, 1000, 1000)});
+
+  // Overlapping rects are merged, the others are kept apart.
+  damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 0, 0, true,
+                         4);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(0, 0, 1000, 1000));
+  std::vector<SkIRect> expected = {
+      SkIRect::MakeLTRB(0, 0, 20, 20),
+      SkIRect::MakeLTRB(900, 900, 1000, 1000),
+      SkIRect::MakeLTRB(900, 0, 1000, 10),
+  };
+  EXPECT_EQ(damage.frame_damage_rects, expected);
+  EXPECT_EQ(damage.buffer_damage_rects, expected);
+
+  // Past the maximum, the rects that are cheapest to merge are merged.
+  damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 0, 0, true,
+                         2);
+  expected = {
+      SkIRect::MakeLTRB(900, 900, 1000, 1000),
+      SkIRect::MakeLTRB(0, 0, 1000, 20),
+  };
+  EXPECT_EQ(damage.frame_damage_rects, expected);
+
+  // Additional damage only applies to the buffer damage.
+  damage = DiffLayerTree(t1, MockLayerTree(),
+                         SkIRect::MakeLTRB(500, 500, 510, 510), 0, 0, true, 4);
+  EXPECT_EQ(damage.frame_damage_rects.size(), 3u);
+  EXPECT_EQ(damage.buffer_damage_rects.size(), 4u);
+  EXPECT_EQ(damage.buffer_damage_rects.back(),
+            SkIRect::MakeLTRB(500, 500, 510, 510));
+
+  // Rects that overlap after alignment are merged.
+  damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 1000, 16,
+                         true, 4);
+  expected = {
+      SkIRect::MakeLTRB(0, 896, 1000, 1000),
+      SkIRect::MakeLTRB(0, 0, 1000, 32),
+  };
+  EXPECT_EQ(damage.frame_damage_rects, expected);
+}
+
+TEST_F(DiffContextTest, StatisticsRecordDamageReasons) {
+  MockLayerTree t1;
+  auto retained = CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(0, 0, 100, 100), 1));
+  t1.root()->Add(retained);
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(200, 200, 300, 300), 1)));
+  DiffLayerTree(t1, MockLayerTree());
+
+  MockLayerTree t2;
+  t2.root()->Add(retained);
+  t2.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(200, 200, 300, 300), 2)));
+
+  DiffContext dc(t2.size(), 1, t2.paint_region_map(), t1.paint_region_map(),
+                 true);
+  dc.statistics().set_records_damage_rects(true);
+  dc.PushCullRect(SkRect::MakeIWH(t2.size().width(), t2.size().height()));
+  t2.root()->Diff(&dc, t1.root());
+  auto damage = dc.ComputeDamage(SkIRect::MakeEmpty());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 200, 300, 300));
+
+  DiffContext::Statistics statistics = dc.statistics();
+  EXPECT_EQ(statistics.retained_layers(), 1);
+  EXPECT_EQ(statistics.retained_layers_not_reused(), 0);
+  EXPECT_EQ(statistics.diffed_layers(), 1);
+  EXPECT_EQ(statistics.damage_count(DamageReason::kNewLayer), 1);
+  EXPECT_EQ(statistics.damage_count(DamageReason::kRemovedLayer), 1);
+  EXPECT_EQ(statistics.damage_count(DamageReason::kLayerChanged), 0);
+  ASSERT_EQ(statistics.damage_rects().size(), 2u);
+  EXPECT_EQ(statistics.damage_rects()[0].reason, DamageReason::kRemovedLayer);
+  EXPECT_EQ(statistics.damage_rects()[1].reason, DamageReason::kNewLayer);
+  EXPECT_EQ(statistics.damage_rects()[1].rect,
+            SkRect::MakeLTRB(200, 200, 300, 300));
+
+  statistics.SetFrameDamage(damage.frame_damage, t2.size());
+  EXPECT_DOUBLE_EQ(statistics.damage_percentage(), 1.0);
+}
+
+TEST_F(DiffContextTest, FrameDamageReusesTheDiffOfTheSameLayerTrees) {
+  LayerTree t1(SkISize::Make(100, 100), 1.0f);
+  t1.set_root_layer(CreateContainerLayer(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(0, 0, 10, 10), 1))));
+  FrameDamage first_damage;
+  first_damage.ComputeClipRect(t1, false);
+
+  LayerTree t2(SkISize::Make(100, 100), 1.0f);
+  t2.set_root_layer(CreateContainerLayer(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(20, 20, 30, 30), 1))));
+  FrameDamage checked_damage;
+  checked_damage.SetPreviousLayerTree(&t1);
+  checked_damage.ComputeClipRect(t2, false);
+  EXPECT_EQ(checked_damage.GetFrameDamage(),
+            SkIRect::MakeLTRB(0, 0, 30, 30));
+
+  // The layers are not diffed again, so the changed root layer isn't seen.
+  t2.set_root_layer(CreateContainerLayer(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(0, 0, 10, 10), 1))));
+  FrameDamage frame_damage;
+  frame_damage.SetPreviousLayerTree(&t1);
+  frame_damage.AddAdditionalDamage(SkIRect::MakeLTRB(50, 50, 60, 60));
+  frame_damage.ReuseDiff(checked_damage);
+  frame_damage.ComputeClipRect(t2, false);
+  EXPECT_EQ(frame_damage.GetFrameDamage(), SkIRect::MakeLTRB(0, 0, 30, 30));
+  EXPECT_EQ(frame_damage.GetBufferDamage(), SkIRect::MakeLTRB(0, 0, 60, 60));
+
+  // Diffs with other options are not reused.
+  FrameDamage other_damage;
+  other_damage.SetPreviousLayerTree(&t1);
+  other_damage.ReuseDiff(frame_damage);
+  other_damage.ComputeClipRect(t2, true);
+  EXPECT_EQ(other_damage.GetFrameDamage(), SkIRect::MakeEmpty());
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -30,6 +30,10 @@ void DisplayListEmbedderViewSlice::render_into(DlCanvas* canvas) {
   canvas->DrawDisplayList(display_list_);
 }
 
+sk_sp<DisplayList> DisplayListEmbedderViewSlice::display_list() const {
+  return display_list_;
+}
+
 void ExternalViewEmbedder::SubmitFrame(GrDirectContext* context,
                                        std::unique_ptr<SurfaceFrame> frame) {
   frame->Submit();
@@ -98,6 +102,87 @@ const std::vector<std::shared_ptr<Mutator>>::const_iterator MutatorsStack::End()
   return vector_.end();
 };
 
+MutatorsStack MutatorsStack::Flattened() const {
+  MutatorsStack flattened;
+  // The transform of the mutators visited since the last one that was added
+  // to |flattened|. It's only added when a mutator that depends on it is.
+  SkMatrix pending_transform;
+  // Whether the top of |flattened| is a clip rect in the current coordinates,
+  // which a following clip rect can be intersected with.
+  bool top_is_clip_rect = false;
+
+  auto flush_transform = [&]() {
+    if (!pending_transform.isIdentity()) {
+      flattened.PushTransform(pending_transform);
+      pending_transform.reset();
+      top_is_clip_rect = false;
+    }
+  };
+
+  for (const auto& mutator : vector_) {
+    switch (mutator->GetType()) {
+      case kTransform:
+        pending_transform.preConcat(mutator->GetMatrix());
+        break;
+      case kClipRect: {
+        if (!pending_transform.rectStaysRect()) {
+          flush_transform();
+        }
+        SkRect rect = pending_transform.mapRect(mutator->GetRect());
+        if (top_is_clip_rect) {
+          if (!rect.intersect(flattened.vector_.back()->GetRect())) {
+            rect.setEmpty();
+          }
+          flattened.Pop();
+        }
+        flattened.PushClipRect(rect);
+        top_is_clip_rect = true;
+        break;
+      }
+      case kOpacity:
+        // Opacity applies the same way in any coordinates.
+        flattened.vector_.push_back(mutator);
+        top_is_clip_rect = false;
+        break;
+      case kClipRRect:
+      case kClipPath:
+      case kBackdropFilter:
+        flush_transform();
+        flattened.vector_.push_back(mutator);
+        top_is_clip_rect = false;
+        break;
+    }
+  }
+  flush_transform();
+  return flattened;
+}
+
+const MutatorsStack& MutatorsStackFlattener::Flatten(
+    int64_t view_id,
+    const MutatorsStack& mutators) {
+  auto found = entries_.find(view_id);
+  if (found != entries_.end() && found->second.mutators == mutators) {
+    found->second.used = true;
+    return found->second.flattened;
+  }
+  Entry& entry = entries_[view_id];
+  entry.mutators = mutators;
+  entry.flattened = mutators.Flattened();
+  entry.used = true;
+  return entry.flattened;
+}
+
+void MutatorsStackFlattener::EndFrame() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.used) {
+      it->second.used = false;
+      ++it;
+    } else {
+      it = entries_.erase(it);
+    }
+  }
+}
+
 bool ExternalViewEmbedder::SupportsDynamicThreadMerging() {
   return false;
 }
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 #define FLUTTER_FLOW_EMBEDDED_VIEWS_H_
 
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/display_list/display_list_builder.h"
@@ -216,6 +218,16 @@ class MutatorsStack {
   bool is_empty() const { return vector_.empty(); }
   size_t stack_count() const { return vector_.size(); }
 
+  // Returns a stack that mutates an embedded view the same way as this one,
+  // with fewer mutators for the platforms to apply.
+  //
+  // Consecutive transforms are composed into one, and identity transforms are
+  // dropped. Clip rects under transforms that keep rects rects are mapped
+  // through them instead, and clip rects that follow each other are
+  // intersected into one. Opacities are kept where they are, and the other
+  // clips and backdrop filters split the transforms around them.
+  MutatorsStack Flattened() const;
+
   bool operator==(const MutatorsStack& other) const {
     if (vector_.size() != other.vector_.size()) {
       return false;
@@ -252,6 +264,35 @@ class MutatorsStack {
   std::vector<std::shared_ptr<Mutator>> vector_;
 };  // MutatorsStack
 
+// Keeps the flattened mutators stacks of the embedded views of the last
+// frame, so that the stacks of the views whose mutators didn't change aren't
+// flattened again.
+//
+// For use on a single thread, usually the raster thread.
+class MutatorsStackFlattener {
+ public:
+  MutatorsStackFlattener() = default;
+
+  // Returns the flattened version of `mutators`, see
+  // `MutatorsStack::Flattened`. The result is valid until the next call to
+  // `EndFrame`.
+  const MutatorsStack& Flatten(int64_t view_id, const MutatorsStack& mutators);
+
+  // Forgets the views that weren't flattened since the last call.
+  void EndFrame();
+
+ private:
+  struct Entry {
+    MutatorsStack mutators;
+    MutatorsStack flattened;
+    bool used = true;
+  };
+
+  std::unordered_map<int64_t, Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MutatorsStackFlattener);
+};
+
 class EmbeddedViewParams {
  public:
   EmbeddedViewParams() = default;
@@ -338,6 +379,9 @@ class EmbedderViewSlice {
   virtual std::list<SkRect> searchNonOverlappingDrawnRects(
       const SkRect& query) const = 0;
   virtual void render_into(DlCanvas* canvas) = 0;
+  // The recording once |end_recording| has been called, which callers may
+  // compare to the recording of the previous frame.
+  virtual sk_sp<DisplayList> display_list() const = 0;
 };
 
 class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
@@ -350,6 +394,7 @@ class DisplayListEmbedderViewSlice : public EmbedderViewSlice {
   std::list<SkRect> searchNonOverlappingDrawnRects(
       const SkRect& query) const override;
   void render_into(DlCanvas* canvas) override;
+  sk_sp<DisplayList> display_list() const override;
 
  private:
   std::unique_ptr<DisplayListBuilder> builder_;
@@ -434,6 +479,33 @@ class ExternalViewEmbedder {
   // |RasterThreadMerger| instance.
   virtual bool SupportsDynamicThreadMerging();
 
+  // Whether the embedder composes platform views without merging the raster
+  // thread into the platform thread.
+  //
+  // Such embedders render the overlays of the platform views on the raster
+  // thread, and record the platform thread side of each frame, such as moving
+  // the platform views and presenting the overlays, in a
+  // |PlatformViewTransactionQueue| that they commit at the end of
+  // |SubmitFrame|. The platform views then move in the same platform frame as
+  // the surfaces drawn for them, and the raster thread only waits on the
+  // platform thread when it needs surfaces that are still being presented.
+  //
+  // Returning `true` takes precedence over |SupportsDynamicThreadMerging|:
+  // no |RasterThreadMerger| is created, and the `raster_thread_merger` passed
+  // to |BeginFrame|, |PostPrerollAction| and |EndFrame| is null.
+  virtual bool SupportsAsyncComposition() { return false; }
+
+  // Whether the embedder can repaint only the damaged parts of the surfaces
+  // it renders into. If so, the frame is recorded in full, and the damage
+  // found by diffing the layer tree against the previous one is passed to
+  // |SetFrameDamage| before |SubmitFrame|.
+  virtual bool SupportsPartialRepaint() { return false; }
+
+  // The disjoint rects of the frame that changed since the previous frame, in
+  // frame coordinates, or nullopt if the whole frame changed.
+  virtual void SetFrameDamage(
+      std::optional<std::vector<SkIRect>> frame_damage_rects) {}
+
   // Called when the rasterizer is being torn down.
   // This method provides a way to release resources associated with the current
   // embedder.
@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_damage_history.h"
+
+namespace flutter {
+
+FrameDamageHistory::FrameDamageHistory() = default;
+
+FrameDamageHistory::~FrameDamageHistory() = default;
+
+std::optional<SkIRect> FrameDamageHistory::GetExistingDamage(
+    size_t buffer_age,
+    const SkISize& frame_size) const {
+  // The frame the buffer holds must have been presented at the same size.
+  if (buffer_age == 0u || frame_size != frame_size_ ||
+      buffer_age > damage_.size()) {
+    return std::nullopt;
+  }
+  SkIRect existing_damage = SkIRect::MakeEmpty();
+  for (auto i = damage_.rbegin(); i != damage_.rbegin() + (buffer_age - 1u);
+       ++i) {
+    existing_damage.join(*i);
+  }
+  return existing_damage;
+}
+
+void FrameDamageHistory::AddFrameDamage(
+    const std::optional<SkIRect>& frame_damage,
+    const SkISize& frame_size) {
+  if (frame_size != frame_size_) {
+    // The buffers are reallocated when the frame size changes.
+    Reset();
+    frame_size_ = frame_size;
+  }
+  damage_.push_back(frame_damage.value_or(SkIRect::MakeSize(frame_size)));
+  if (damage_.size() > kMaxHistorySize) {
+    damage_.pop_front();
+  }
+}
+
+void FrameDamageHistory::Reset() {
+  frame_size_ = SkISize::MakeEmpty();
+  damage_.clear();
+}
+
+}  // namespace flutter
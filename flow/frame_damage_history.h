@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_FRAME_DAMAGE_HISTORY_H_
+#define FLUTTER_FLOW_FRAME_DAMAGE_HISTORY_H_
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+// The damage of the last few frames presented to a surface, which gives the
+// existing damage of a buffer that retains the frame it was last presented
+// with from the age of the buffer, as with EGL_EXT_buffer_age.
+//
+// Buffer age 0 means the contents of the buffer are undefined. Buffer age n
+// means the buffer holds the frame presented n frames ago, so it lags behind
+// by the damage of the n - 1 frames presented since.
+class FrameDamageHistory {
+ public:
+  // The most frames whose damage is kept. Buffers older than this are
+  // repainted in full. Some devices use quad buffering.
+  static constexpr size_t kMaxHistorySize = 10u;
+
+  FrameDamageHistory();
+
+  ~FrameDamageHistory();
+
+  // Returns the area of a buffer of |buffer_age| that lags behind the last
+  // frame presented, or std::nullopt if the buffer must be repainted in full,
+  // e.g. because its contents are undefined or the frame size changed.
+  std::optional<SkIRect> GetExistingDamage(size_t buffer_age,
+                                           const SkISize& frame_size) const;
+
+  // Records the damage of a frame that was presented, the area that differs
+  // from the previous frame. No damage means the whole frame changed.
+  void AddFrameDamage(const std::optional<SkIRect>& frame_damage,
+                      const SkISize& frame_size);
+
+  // Forgets the damage of all frames, so that all buffers are repainted in
+  // full.
+  void Reset();
+
+ private:
+  SkISize frame_size_ = SkISize::MakeEmpty();
+  // The damage of the frames presented, oldest first.
+  std::deque<SkIRect> damage_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameDamageHistory);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_FRAME_DAMAGE_HISTORY_H_
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/frame_damage_history.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(FrameDamageHistory, BuffersOfUnknownAgeAreRepaintedInFull) {
+  FrameDamageHistory history;
+  const SkISize size = SkISize::Make(100, 100);
+  EXPECT_EQ(history.GetExistingDamage(1u, size), std::nullopt);
+
+  history.AddFrameDamage(SkIRect::MakeXYWH(10, 10, 10, 10), size);
+  EXPECT_EQ(history.GetExistingDamage(0u, size), std::nullopt);
+  // Only one frame was presented, so no buffer can be older than that.
+  EXPECT_EQ(history.GetExistingDamage(3u, size), std::nullopt);
+}
+
+TEST(FrameDamageHistory, ExistingDamageJoinsTheFramesSinceTheBuffer) {
+  FrameDamageHistory history;
+  const SkISize size = SkISize::Make(100, 100);
+  history.AddFrameDamage(SkIRect::MakeXYWH(0, 0, 10, 10), size);
+  history.AddFrameDamage(SkIRect::MakeXYWH(20, 20, 10, 10), size);
+  history.AddFrameDamage(SkIRect::MakeXYWH(40, 40, 10, 10), size);
+
+  // The buffer of the last frame is up to date.
+  EXPECT_EQ(history.GetExistingDamage(1u, size), SkIRect::MakeEmpty());
+  EXPECT_EQ(history.GetExistingDamage(2u, size),
+            SkIRect::MakeXYWH(40, 40, 10, 10));
+  EXPECT_EQ(history.GetExistingDamage(3u, size),
+            SkIRect::MakeLTRB(20, 20, 50, 50));
+}
+
+TEST(FrameDamageHistory, FullFramesAndResizesInvalidateOlderBuffers) {
+  FrameDamageHistory history;
+  const SkISize size = SkISize::Make(100, 100);
+  history.AddFrameDamage(SkIRect::MakeXYWH(0, 0, 10, 10), size);
+  history.AddFrameDamage(std::nullopt, size);
+  EXPECT_EQ(history.GetExistingDamage(2u, size), SkIRect::MakeSize(size));
+
+  const SkISize new_size = SkISize::Make(200, 100);
+  EXPECT_EQ(history.GetExistingDamage(1u, new_size), std::nullopt);
+  history.AddFrameDamage(SkIRect::MakeXYWH(0, 0, 10, 10), new_size);
+  EXPECT_EQ(history.GetExistingDamage(2u, new_size), std::nullopt);
+  EXPECT_EQ(history.GetExistingDamage(1u, new_size), SkIRect::MakeEmpty());
+}
+
+TEST(FrameDamageHistory, KeepsALimitedNumberOfFrames) {
+  FrameDamageHistory history;
+  const SkISize size = SkISize::Make(100, 100);
+  for (size_t i = 0; i < FrameDamageHistory::kMaxHistorySize + 1u; i++) {
+    history.AddFrameDamage(SkIRect::MakeXYWH(0, 0, 1, 1), size);
+  }
+  EXPECT_EQ(
+      history.GetExistingDamage(FrameDamageHistory::kMaxHistorySize, size),
+      SkIRect::MakeXYWH(0, 0, 1, 1));
+  EXPECT_EQ(history.GetExistingDamage(
+                FrameDamageHistory::kMaxHistorySize + 1u, size),
+            std::nullopt);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -101,6 +101,11 @@ size_t FrameTimingsRecorder::GetPictureCacheBytes() const {
   return picture_cache_bytes_;
 }
 
+size_t FrameTimingsRecorder::GetDiscardedFrameCount() const {
+  std::scoped_lock state_lock(state_mutex_);
+  return discarded_frame_count_;
+}
+
 void FrameTimingsRecorder::RecordVsync(fml::TimePoint vsync_start,
                                        fml::TimePoint vsync_target) {
   std::scoped_lock state_lock(state_mutex_);
@@ -124,6 +129,12 @@ void FrameTimingsRecorder::RecordBuildEnd(fml::TimePoint build_end) {
   build_end_ = build_end;
 }
 
+void FrameTimingsRecorder::RecordDiscardedFrames(size_t count) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ >= State::kBuildEnd);
+  discarded_frame_count_ += count;
+}
+
 void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kBuildEnd);
@@ -131,6 +142,13 @@ void FrameTimingsRecorder::RecordRasterStart(fml::TimePoint raster_start) {
   raster_start_ = raster_start;
 }
 
+void FrameTimingsRecorder::RecordRasterPhase(FrameTiming::RasterPhase phase,
+                                             fml::TimeDelta duration) {
+  std::scoped_lock state_lock(state_mutex_);
+  FML_DCHECK(state_ == State::kRasterStart);
+  raster_phase_durations_[phase] = duration;
+}
+
 FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   std::scoped_lock state_lock(state_mutex_);
   FML_DCHECK(state_ == State::kRasterStart);
@@ -157,6 +175,12 @@ FrameTiming FrameTimingsRecorder::RecordRasterEnd(const RasterCache* cache) {
   timing_.SetFrameNumber(GetFrameNumber());
   timing_.SetRasterCacheStatistics(layer_cache_count_, layer_cache_bytes_,
                                    picture_cache_count_, picture_cache_bytes_);
+  timing_.SetDiscardedFrameCount(discarded_frame_count_);
+  for (int phase = 0; phase < FrameTiming::kRasterPhaseCount; phase++) {
+    timing_.SetRasterPhaseDuration(
+        static_cast<FrameTiming::RasterPhase>(phase),
+        raster_phase_durations_[phase]);
+  }
   return timing_;
 }
 
@@ -185,6 +209,7 @@ std::unique_ptr<FrameTimingsRecorder> FrameTimingsRecorder::CloneUntil(
 
   if (state >= State::kBuildEnd) {
     recorder->build_end_ = build_end_;
+    recorder->discarded_frame_count_ = discarded_frame_count_;
   }
 
   if (state >= State::kRasterStart) {
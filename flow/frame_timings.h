@@ -83,6 +83,10 @@ class FrameTimingsRecorder {
   /// Total Bytes in all picture cache entries
   size_t GetPictureCacheBytes() const;
 
+  /// Count of the frames that were replaced by this frame before they could
+  /// be rasterized.
+  size_t GetDiscardedFrameCount() const;
+
   /// Records a vsync event.
   void RecordVsync(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
 
@@ -92,9 +96,18 @@ class FrameTimingsRecorder {
   /// Records a build end event.
   void RecordBuildEnd(fml::TimePoint build_end);
 
+  /// Records that |count| frames built before this one were discarded in its
+  /// favor. Must be called after the build end event.
+  void RecordDiscardedFrames(size_t count);
+
   /// Records a raster start event.
   void RecordRasterStart(fml::TimePoint raster_start);
 
+  /// Records how long a step of the rasterization took. Must be called
+  /// between the raster start and raster end events.
+  void RecordRasterPhase(FrameTiming::RasterPhase phase,
+                         fml::TimeDelta duration);
+
   /// Clones the recorder until (and including) the specified state.
   std::unique_ptr<FrameTimingsRecorder> CloneUntil(State state);
 
@@ -134,6 +147,8 @@ class FrameTimingsRecorder {
   size_t layer_cache_bytes_;
   size_t picture_cache_count_;
   size_t picture_cache_bytes_;
+  size_t discarded_frame_count_ = 0;
+  fml::TimeDelta raster_phase_durations_[FrameTiming::kRasterPhaseCount];
 
   // Set when `RecordRasterEnd` is called. Cannot be reset once set.
   FrameTiming timing_;
@@ -247,6 +247,63 @@ void Stopwatch::Visualize(DlCanvas* canvas, const SkRect& rect) const {
                     DlImageSampling::kNearestNeighbor);
 }
 
+SampleHistory::SampleHistory() : samples_(kMaxSamples, 0.0) {}
+
+SampleHistory::~SampleHistory() = default;
+
+void SampleHistory::AddSample(double sample) {
+  samples_[next_sample_] = sample;
+  next_sample_ = (next_sample_ + 1) % kMaxSamples;
+  sample_count_ = std::min(sample_count_ + 1, kMaxSamples);
+}
+
+double SampleHistory::LastSample() const {
+  return samples_[(next_sample_ + kMaxSamples - 1) % kMaxSamples];
+}
+
+double SampleHistory::MaxSample() const {
+  return *std::max_element(samples_.begin(), samples_.end());
+}
+
+double SampleHistory::AverageSample() const {
+  if (sample_count_ == 0) {
+    return 0.0;
+  }
+  double sum = 0.0;
+  for (double sample : samples_) {
+    sum += sample;
+  }
+  // The samples that were never written are zero.
+  return sum / sample_count_;
+}
+
+void SampleHistory::Visualize(DlCanvas* canvas,
+                              const SkRect& rect,
+                              double min_range,
+                              DlColor color) const {
+  canvas->DrawRect(rect, DlPaint(0x99FFFFFF));
+  const double range = std::max(min_range, MaxSample());
+  if (range <= 0.0) {
+    return;
+  }
+
+  // The oldest sample is drawn on the left, so that the graph scrolls.
+  const SkScalar sample_width = rect.width() / kMaxSamples;
+  SkPath path;
+  path.setIsVolatile(true);
+  path.moveTo(rect.left(), rect.bottom());
+  for (size_t i = 0; i < kMaxSamples; i++) {
+    const double sample = samples_[(next_sample_ + i) % kMaxSamples];
+    const SkScalar sample_y = rect.bottom() - rect.height() * (sample / range);
+    const SkScalar sample_x = rect.left() + sample_width * i;
+    path.lineTo(sample_x, sample_y);
+    path.lineTo(sample_x + sample_width, sample_y);
+  }
+  path.lineTo(rect.right(), rect.bottom());
+  path.close();
+  canvas->DrawPath(path, DlPaint(color));
+}
+
 fml::Milliseconds Stopwatch::GetFrameBudget() const {
   return refresh_rate_updater_.GetFrameBudget();
 }
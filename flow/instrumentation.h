@@ -91,6 +91,65 @@ class FixedRefreshRateStopwatch : public Stopwatch {
   FixedRefreshRateUpdater fixed_delegate_;
 };
 
+/// The most recent per-frame samples of a value other than a frame time, such
+/// as a count or a number of bytes, for the performance overlay to graph.
+class SampleHistory {
+ public:
+  SampleHistory();
+
+  ~SampleHistory();
+
+  bool HasSamples() const { return sample_count_ > 0; }
+
+  void AddSample(double sample);
+
+  double LastSample() const;
+
+  double MaxSample() const;
+
+  double AverageSample() const;
+
+  /// Draws the samples as a bar graph filling |rect|, scaled so that the
+  /// larger of |min_range| and the largest sample reaches the top. The graph
+  /// is drawn with one rect and one path however many samples there are.
+  void Visualize(DlCanvas* canvas,
+                 const SkRect& rect,
+                 double min_range,
+                 DlColor color) const;
+
+ private:
+  std::vector<double> samples_;
+  // The index the next sample is written to.
+  size_t next_sample_ = 0;
+  size_t sample_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SampleHistory);
+};
+
+/// The GPU memory held by the allocations of a renderer that accounts for
+/// them, as shown by the performance overlay.
+struct GpuMemoryUsage {
+  /// The bytes of the allocations that are alive.
+  size_t live_bytes = 0u;
+  /// The most bytes that were alive at once during the last frame.
+  size_t frame_peak_bytes = 0u;
+  /// The most bytes that were alive at once since the renderer was created.
+  size_t peak_bytes = 0u;
+};
+
+/// The histories of the per-frame statistics besides the frame times that the
+/// performance overlay graphs. The statistics that the renderer doesn't
+/// report have no samples.
+struct FrameStatisticsHistory {
+  SampleHistory gpu_time_ms;
+  /// The percentage of the raster cache entries drawn that had an image.
+  SampleHistory raster_cache_hit_percent;
+  SampleHistory raster_cache_bytes;
+  SampleHistory glyph_atlas_uploads;
+  SampleHistory pipeline_compiles;
+  SampleHistory offscreen_passes;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_FLOW_INSTRUMENTATION_H_
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/instrumentation.h"
+#include "flutter/display_list/display_list_builder.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -42,5 +43,40 @@ TEST(Instrumentation, GetFrameBudgetFromUpdaterTest) {
   EXPECT_EQ(frame_budget_90fps, actual_frame_budget);
 }
 
+TEST(Instrumentation, SampleHistoryAveragesRecordedSamples) {
+  SampleHistory history;
+  EXPECT_FALSE(history.HasSamples());
+  EXPECT_EQ(history.AverageSample(), 0.0);
+
+  history.AddSample(2.0);
+  history.AddSample(6.0);
+  EXPECT_TRUE(history.HasSamples());
+  EXPECT_EQ(history.LastSample(), 6.0);
+  EXPECT_EQ(history.MaxSample(), 6.0);
+  EXPECT_EQ(history.AverageSample(), 4.0);
+}
+
+TEST(Instrumentation, SampleHistoryKeepsMostRecentSamples) {
+  SampleHistory history;
+  history.AddSample(100.0);
+  for (size_t i = 0; i < 1000; i++) {
+    history.AddSample(1.0);
+  }
+  EXPECT_EQ(history.LastSample(), 1.0);
+  EXPECT_EQ(history.MaxSample(), 1.0);
+  EXPECT_EQ(history.AverageSample(), 1.0);
+}
+
+TEST(Instrumentation, SampleHistoryVisualizesWithTwoOps) {
+  SampleHistory history;
+  for (size_t i = 0; i < 1000; i++) {
+    history.AddSample(i % 7);
+  }
+  DisplayListBuilder builder;
+  history.Visualize(&builder, SkRect::MakeWH(100, 20), 1.0,
+                    DlColor(0xAA0000FF));
+  EXPECT_EQ(builder.Build()->op_count(), 2u);
+}
+
 }  // namespace testing
 }  // namespace flutter
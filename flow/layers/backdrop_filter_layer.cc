@@ -4,6 +4,8 @@
 
 #include "flutter/flow/layers/backdrop_filter_layer.h"
 
+#include "flutter/flow/raster_quality_policy.h"
+
 namespace flutter {
 
 BackdropFilterLayer::BackdropFilterLayer(
@@ -57,7 +59,12 @@ void BackdropFilterLayer::Paint(PaintContext& context) const {
   FML_DCHECK(needs_painting(context));
 
   auto mutator = context.state_stack.save();
-  mutator.applyBackdropFilter(paint_bounds(), filter_, blend_mode_);
+  mutator.applyBackdropFilter(
+      paint_bounds(),
+      context.reduce_expensive_effects
+          ? RasterQualityPolicy::ReduceFilterCost(filter_)
+          : filter_,
+      blend_mode_);
 
   PaintChildren(context);
 }
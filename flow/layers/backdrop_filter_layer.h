@@ -21,6 +21,9 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+  // The filter is pushed to the platform views visited before this layer.
+  bool can_preroll_concurrently() const override { return false; }
+
  private:
   std::shared_ptr<const DlImageFilter> filter_;
   DlBlendMode blend_mode_;
@@ -4,10 +4,87 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include <atomic>
 #include <optional>
 
+#include "flutter/fml/synchronization/waitable_event.h"
+
 namespace flutter {
 
+namespace {
+
+// Returns the number of layers in the subtree of |layer|, or 0 if any of
+// them cannot be prerolled concurrently with the rest of the tree.
+size_t CountConcurrentPrerollLayers(const Layer* layer) {
+  if (!layer->can_preroll_concurrently()) {
+    return 0;
+  }
+  size_t count = 1;
+  if (const ContainerLayer* container = layer->as_container_layer()) {
+    for (auto& child : container->layers()) {
+      size_t child_count = CountConcurrentPrerollLayers(child.get());
+      if (child_count == 0) {
+        return 0;
+      }
+      count += child_count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+// The preroll of a child subtree that has been handed to the concurrent task
+// runner. Whichever of the worker and the thread prerolling the parent
+// claims it first performs the preroll, so the parent never waits for a
+// busy worker to start on a child it could have prerolled itself.
+struct ContainerLayer::ConcurrentPreroll {
+  std::atomic<bool> claimed{false};
+  fml::ManualResetWaitableEvent done;
+
+  // The results of the preroll that are merged into the parent context.
+  bool has_platform_view = false;
+  bool has_texture_layer = false;
+  bool surface_needs_readback = false;
+  int renderable_state_flags = 0;
+  std::vector<RasterCacheItem*> raster_cached_entries;
+
+  // Prerolls |layer| as if it was prerolled with |parent|, with the cull
+  // rect and transform that |parent| had when the child was handed off.
+  void Run(Layer* layer,
+           const PrerollContext& parent,
+           const SkRect& device_cull_rect,
+           const SkM44& matrix) {
+    TRACE_EVENT0("flutter", "ContainerLayer::ConcurrentPreroll");
+    LayerStateStack state_stack;
+    state_stack.set_preroll_delegate(device_cull_rect, matrix);
+    PrerollContext context = {
+        // clang-format off
+        .raster_cache                  = parent.raster_cache,
+        .gr_context                    = parent.gr_context,
+        .view_embedder                 = nullptr,
+        .state_stack                   = state_stack,
+        .dst_color_space               = parent.dst_color_space,
+        .surface_needs_readback        = false,
+        .raster_time                   = parent.raster_time,
+        .ui_time                       = parent.ui_time,
+        .texture_registry              = parent.texture_registry,
+        .frame_device_pixel_ratio      = parent.frame_device_pixel_ratio,
+        .raster_cached_entries         = parent.raster_cached_entries
+                                             ? &raster_cached_entries
+                                             : nullptr,
+        .display_list_enabled          = parent.display_list_enabled,
+        .reuse_retained_preroll        = parent.reuse_retained_preroll,
+        // clang-format on
+    };
+    layer->Preroll(&context);
+    has_platform_view = context.has_platform_view;
+    has_texture_layer = context.has_texture_layer;
+    surface_needs_readback = context.surface_needs_readback;
+    renderable_state_flags = context.renderable_state_flags;
+  }
+};
+
 ContainerLayer::ContainerLayer() : child_paint_bounds_(SkRect::MakeEmpty()) {}
 
 void ContainerLayer::Diff(DiffContext* context, const Layer* old_layer) {
@@ -28,6 +105,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
   if (context->IsSubtreeDirty()) {
     for (auto& layer : layers_) {
+      context->statistics().AddDiffedLayer();
       layer->Diff(context, nullptr);
     }
     return;
@@ -64,8 +142,29 @@ void ContainerLayer::DiffChildren(DiffContext* context,
     --old_children_bottom;
   }
 
+  // If the same number of layers was replaced, each replacing layer may be
+  // able to diff against the layer it replaced and only damage the parts of
+  // its content that changed, instead of damaging the paint regions of both.
+  std::vector<const Layer*> incremental_old_layers;
+  if (new_children_bottom >= new_children_top &&
+      new_children_bottom - new_children_top ==
+          old_children_bottom - old_children_top) {
+    incremental_old_layers.resize(new_children_bottom - new_children_top + 1);
+    for (int i = new_children_top; i <= new_children_bottom; ++i) {
+      auto prev_layer = prev_layers[old_children_top + i - new_children_top];
+      if (layers_[i]->CanDiffIncrementally(context, prev_layer.get())) {
+        incremental_old_layers[i - new_children_top] = prev_layer.get();
+      }
+    }
+  }
+
   // old layers that don't match
   for (int i = old_children_top; i <= old_children_bottom; ++i) {
+    size_t incremental_index = i - old_children_top;
+    if (incremental_index < incremental_old_layers.size() &&
+        incremental_old_layers[incremental_index] != nullptr) {
+      continue;
+    }
     auto layer = prev_layers[i];
     context->AddDamage(context->GetOldLayerPaintRegion(layer.get()));
   }
@@ -86,17 +185,27 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // subtree. Layers that do readback must be able to register readback
         // inside Diff
         context->AddExistingPaintRegion(paint_region);
+        context->statistics().AddRetainedLayer();
 
         // While we don't need to diff retained layers, we still need to
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
       } else {
+        if (layer == prev_layer) {
+          context->statistics().AddRetainedLayerNotReused();
+        }
+        context->statistics().AddDiffedLayer();
         layer->Diff(context, prev_layer.get());
       }
+    } else if (!incremental_old_layers.empty() &&
+               incremental_old_layers[i - new_children_top] != nullptr) {
+      context->statistics().AddDiffedLayer();
+      layers_[i]->Diff(context, incremental_old_layers[i - new_children_top]);
     } else {
       DiffContext::AutoSubtreeRestore subtree(context);
-      context->MarkSubtreeDirty();
+      context->MarkSubtreeDirty(PaintRegion(), DamageReason::kNewLayer);
+      context->statistics().AddDiffedLayer();
       auto layer = layers_[i];
       layer->Diff(context, nullptr);
     }
@@ -105,6 +214,7 @@ void ContainerLayer::DiffChildren(DiffContext* context,
 
 void ContainerLayer::Add(std::shared_ptr<Layer> layer) {
   layers_.emplace_back(std::move(layer));
+  MarkDirty();
 }
 
 void ContainerLayer::Preroll(PrerollContext* context) {
@@ -126,6 +236,30 @@ static bool safe_intersection_test(const SkRect* rect1, const SkRect& rect2) {
   return rect1->intersects(rect2);
 }
 
+// The number of previous siblings whose paint bounds are tested against
+// each child. Children beyond that are only tested against the union of
+// the paint bounds of their previous siblings.
+static constexpr size_t kMaxSiblingBoundsTested = 64;
+
+// Returns true if |bounds| overlaps the paint bounds of any of the previous
+// siblings, whose union is |union_bounds|.
+static bool overlaps_siblings(const std::vector<SkRect>& sibling_bounds,
+                              const SkRect& union_bounds,
+                              const SkRect& bounds) {
+  if (!safe_intersection_test(&union_bounds, bounds)) {
+    return false;
+  }
+  if (sibling_bounds.size() >= kMaxSiblingBoundsTested) {
+    return true;
+  }
+  for (const SkRect& sibling : sibling_bounds) {
+    if (safe_intersection_test(&sibling, bounds)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void ContainerLayer::PrerollChildren(PrerollContext* context,
                                      SkRect* child_paint_bounds) {
   // Platform views have no children, so context->has_platform_view should
@@ -133,11 +267,41 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
   FML_DCHECK(!context->has_platform_view);
   FML_DCHECK(!context->has_texture_layer);
 
+  if (CanReuseRetainedPreroll(context)) {
+    TRACE_EVENT0("flutter", "ContainerLayer::ReuseRetainedPreroll");
+    child_paint_bounds->join(child_paint_bounds_);
+    context->has_texture_layer = retained_preroll_.has_texture_layer;
+    context->surface_needs_readback = context->surface_needs_readback ||
+                                      retained_preroll_.surface_needs_readback;
+    context->renderable_state_flags = children_renderable_state_flags_;
+    return;
+  }
+  retained_preroll_.valid = false;
+  // Track the readback of the children separately so that it can be
+  // replayed when the preroll is reused.
+  bool prev_surface_needs_readback = context->surface_needs_readback;
+  context->surface_needs_readback = false;
+  size_t prev_raster_cached_entries =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+  bool children_are_retainable = true;
+
   bool child_has_platform_view = false;
   bool child_has_texture_layer = false;
-  bool all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  int all_renderable_state_flags = LayerStateStack::kCallerCanApplyAnything;
+  // The paint bounds of the previous children are tested individually so
+  // that children laid out in a grid or other 2D arrangement can inherit
+  // state as long as none of them overlap.
+  std::vector<SkRect> sibling_bounds;
+  if (!child_paint_bounds->isEmpty()) {
+    sibling_bounds.push_back(*child_paint_bounds);
+  }
 
-  for (auto& layer : layers_) {
+  std::vector<std::shared_ptr<ConcurrentPreroll>> concurrent_prerolls =
+      StartConcurrentPreroll(context);
+
+  for (size_t i = 0; i < layers_.size(); i++) {
+    auto& layer = layers_[i];
     // Reset context->has_platform_view and context->has_texture_layer to false
     // so that layers aren't treated as if they have a platform view or texture
     // layer based on one being previously found in a sibling tree.
@@ -148,14 +312,20 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
     // opt-in to applying state attributes during its |Preroll|
     context->renderable_state_flags = 0;
 
-    layer->Preroll(context);
+    if (!concurrent_prerolls.empty() && concurrent_prerolls[i]) {
+      FinishConcurrentPreroll(context, layer.get(), *concurrent_prerolls[i]);
+    } else {
+      layer->Preroll(context);
+    }
 
     all_renderable_state_flags &= context->renderable_state_flags;
-    if (safe_intersection_test(child_paint_bounds, layer->paint_bounds())) {
-      // This will allow inheritance by a linear sequence of non-overlapping
-      // children, but will fail with a grid or other arbitrary 2D layout.
-      // See https://github.com/flutter/flutter/issues/93899
-      all_renderable_state_flags = 0;
+    if (all_renderable_state_flags != 0) {
+      if (overlaps_siblings(sibling_bounds, *child_paint_bounds,
+                            layer->paint_bounds())) {
+        all_renderable_state_flags = 0;
+      } else if (sibling_bounds.size() < kMaxSiblingBoundsTested) {
+        sibling_bounds.push_back(layer->paint_bounds());
+      }
     }
     child_paint_bounds->join(layer->paint_bounds());
 
@@ -163,14 +333,133 @@ void ContainerLayer::PrerollChildren(PrerollContext* context,
         child_has_platform_view || context->has_platform_view;
     child_has_texture_layer =
         child_has_texture_layer || context->has_texture_layer;
+
+    // Layers that cannot be prerolled concurrently have effects outside of
+    // their subtree, so their preroll cannot be skipped either.
+    const ContainerLayer* container = layer->as_container_layer();
+    children_are_retainable =
+        children_are_retainable && layer->can_preroll_concurrently() &&
+        (!container || container->retained_preroll_.valid);
   }
 
+  bool children_need_readback = context->surface_needs_readback;
+  context->surface_needs_readback =
+      prev_surface_needs_readback || children_need_readback;
   context->has_platform_view = child_has_platform_view;
   context->has_texture_layer = child_has_texture_layer;
   context->renderable_state_flags = all_renderable_state_flags;
   set_subtree_has_platform_view(child_has_platform_view);
   set_children_renderable_state_flags(all_renderable_state_flags);
   set_child_paint_bounds(*child_paint_bounds);
+
+  // Raster cache entries must be marked as seen in every frame and their
+  // state decides how the layers are painted, so subtrees that have any
+  // are always prerolled again.
+  size_t raster_cached_entries =
+      context->raster_cached_entries ? context->raster_cached_entries->size()
+                                     : 0;
+  if (context->reuse_retained_preroll && children_are_retainable &&
+      !child_has_platform_view &&
+      raster_cached_entries == prev_raster_cached_entries) {
+    RetainedPreroll& retained = retained_preroll_;
+    retained.valid = true;
+    retained.matrix = context->state_stack.transform_4x4();
+    retained.device_cull_rect = context->state_stack.device_cull_rect();
+    retained.has_raster_cache = context->raster_cache != nullptr;
+    retained.gr_context = context->gr_context;
+    retained.dst_color_space = sk_ref_sp(context->dst_color_space);
+    retained.frame_device_pixel_ratio = context->frame_device_pixel_ratio;
+    retained.display_list_enabled = context->display_list_enabled;
+    retained.has_texture_layer = child_has_texture_layer;
+    retained.surface_needs_readback = children_need_readback;
+  }
+}
+
+bool ContainerLayer::CanReuseRetainedPreroll(
+    const PrerollContext* context) const {
+  const RetainedPreroll& retained = retained_preroll_;
+  return context->reuse_retained_preroll && retained.valid &&
+         retained.matrix == context->state_stack.transform_4x4() &&
+         retained.device_cull_rect ==
+             context->state_stack.device_cull_rect() &&
+         retained.has_raster_cache == (context->raster_cache != nullptr) &&
+         retained.gr_context == context->gr_context &&
+         SkColorSpace::Equals(retained.dst_color_space.get(),
+                              context->dst_color_space) &&
+         retained.frame_device_pixel_ratio ==
+             context->frame_device_pixel_ratio &&
+         retained.display_list_enabled == context->display_list_enabled;
+}
+
+std::vector<std::shared_ptr<ContainerLayer::ConcurrentPreroll>>
+ContainerLayer::StartConcurrentPreroll(PrerollContext* context) {
+  std::vector<std::shared_ptr<ConcurrentPreroll>> prerolls;
+  if (!context->concurrent_task_runner || layers_.size() < 2) {
+    return prerolls;
+  }
+
+  // Only children that are large enough to outweigh the cost of handing
+  // them to another thread are prerolled concurrently, and only if there
+  // is more than one of them to overlap.
+  std::vector<size_t> concurrent_children;
+  for (size_t i = 0; i < layers_.size(); i++) {
+    if (CountConcurrentPrerollLayers(layers_[i].get()) >=
+        kMinConcurrentPrerollLayers) {
+      concurrent_children.push_back(i);
+    }
+  }
+  if (concurrent_children.size() < 2) {
+    return prerolls;
+  }
+
+  // The children never modify the cull rect and transform that they are
+  // prerolled with, so those of the parent can be captured up front.
+  SkRect device_cull_rect = context->state_stack.device_cull_rect();
+  SkM44 matrix = context->state_stack.transform_4x4();
+
+  prerolls.resize(layers_.size());
+  for (size_t i : concurrent_children) {
+    auto preroll = std::make_shared<ConcurrentPreroll>();
+    prerolls[i] = preroll;
+    // The parent waits for the prerolls that a worker has claimed before it
+    // returns, so the layer and context are alive whenever they are used.
+    context->concurrent_task_runner->PostTask(
+        [preroll, layer = layers_[i].get(), context, device_cull_rect,
+         matrix]() {
+          if (preroll->claimed.exchange(true)) {
+            return;
+          }
+          preroll->Run(layer, *context, device_cull_rect, matrix);
+          preroll->done.Signal();
+        });
+  }
+  return prerolls;
+}
+
+void ContainerLayer::FinishConcurrentPreroll(PrerollContext* context,
+                                             Layer* layer,
+                                             ConcurrentPreroll& preroll) {
+  if (preroll.claimed.exchange(true)) {
+    TRACE_EVENT0("flutter", "ContainerLayer::WaitForConcurrentPreroll");
+    preroll.done.Wait();
+  } else {
+    preroll.Run(layer, *context, context->state_stack.device_cull_rect(),
+                context->state_stack.transform_4x4());
+  }
+
+  context->has_platform_view = preroll.has_platform_view;
+  context->has_texture_layer = preroll.has_texture_layer;
+  context->surface_needs_readback =
+      context->surface_needs_readback || preroll.surface_needs_readback;
+  context->renderable_state_flags = preroll.renderable_state_flags;
+  // The entries are merged in the order of the children so that they are in
+  // the same order as if the children had been prerolled in sequence.
+  if (context->raster_cached_entries) {
+    context->raster_cached_entries->insert(
+        context->raster_cached_entries->end(),
+        preroll.raster_cached_entries.begin(),
+        preroll.raster_cached_entries.end());
+  }
 }
 
 void ContainerLayer::PaintChildren(PaintContext& context) const {
@@ -5,14 +5,21 @@
 #ifndef FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 #define FLUTTER_FLOW_LAYERS_CONTAINER_LAYER_H_
 
+#include <memory>
 #include <vector>
 
 #include "flutter/flow/layers/layer.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkM44.h"
 
 namespace flutter {
 
 class ContainerLayer : public Layer {
  public:
+  // The number of layers a child subtree must have to be prerolled on the
+  // |PrerollContext::concurrent_task_runner|.
+  static constexpr size_t kMinConcurrentPrerollLayers = 16;
+
   ContainerLayer();
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
@@ -37,6 +44,17 @@ class ContainerLayer : public Layer {
     child_paint_bounds_ = bounds;
   }
 
+  // Forgets the results of the last preroll of the children, which are
+  // otherwise reused when the layer is retained and prerolled again with
+  // the same inputs, see |PrerollContext::reuse_retained_preroll|. Adding a
+  // child marks the layer dirty, other changes to the children must be
+  // followed by a call to this method.
+  void MarkDirty() { retained_preroll_.valid = false; }
+
+  // Returns true if the next preroll of the children with |context| can
+  // reuse the results of the last one.
+  bool CanReuseRetainedPreroll(const PrerollContext* context) const;
+
   int children_renderable_state_flags() const {
     return children_renderable_state_flags_;
   }
@@ -48,9 +66,42 @@ class ContainerLayer : public Layer {
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
  private:
+  struct ConcurrentPreroll;
+
+  // The inputs that the children were last prerolled with, and the results
+  // of that preroll that are not kept in the layer itself.
+  struct RetainedPreroll {
+    bool valid = false;
+    SkM44 matrix;
+    SkRect device_cull_rect;
+    bool has_raster_cache = false;
+    GrDirectContext* gr_context = nullptr;
+    sk_sp<SkColorSpace> dst_color_space;
+    float frame_device_pixel_ratio = 1.0f;
+    bool display_list_enabled = false;
+
+    bool has_texture_layer = false;
+    bool surface_needs_readback = false;
+  };
+
+  // Hands the children that are worth prerolling on another thread to the
+  // concurrent task runner of |context|. Returns an empty vector if there
+  // are none, or otherwise a vector with an entry for each child that is
+  // only set for the children that were handed off.
+  std::vector<std::shared_ptr<ConcurrentPreroll>> StartConcurrentPreroll(
+      PrerollContext* context);
+
+  // Completes the preroll of a child that was handed off, either by waiting
+  // for the worker that took it or by prerolling it here, and merges its
+  // results into |context|.
+  void FinishConcurrentPreroll(PrerollContext* context,
+                               Layer* layer,
+                               ConcurrentPreroll& preroll);
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
+  RetainedPreroll retained_preroll_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContainerLayer);
 };
@@ -4,11 +4,14 @@
 
 #include "flutter/flow/layers/container_layer.h"
 
+#include "flutter/flow/layers/image_filter_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/testing/mock_canvas.h"
 #include "gtest/gtest.h"
@@ -507,6 +510,51 @@ TEST_F(ContainerLayerTest, OpacityInheritance) {
   EXPECT_EQ(context->renderable_state_flags, 0);
 }
 
+TEST_F(ContainerLayerTest, OpacityInheritanceWithGridLayout) {
+  auto container = std::make_shared<ContainerLayer>();
+  for (int y = 0; y < 3; y++) {
+    for (int x = 0; x < 3; x++) {
+      auto path = SkPath().addRect(SkRect::MakeXYWH(x * 20, y * 20, 10, 10));
+      container->Add(MockLayer::MakeOpacityCompatible(path));
+    }
+  }
+
+  // The union of the previous children overlaps most of the children, but
+  // none of the children overlap each other.
+  PrerollContext* context = preroll_context();
+  container->Preroll(context);
+  EXPECT_EQ(context->renderable_state_flags,
+            LayerStateStack::kCallerCanApplyOpacity);
+
+  auto path = SkPath().addRect({25, 25, 30, 30});
+  container->Add(MockLayer::MakeOpacityCompatible(path));
+
+  // The last child only overlaps the center child of the grid
+  container->Preroll(context);
+  EXPECT_EQ(context->renderable_state_flags, 0);
+}
+
+TEST_F(ContainerLayerTest, ColorFilterInheritanceFromChildren) {
+  auto dl_image_filter = std::make_shared<DlMatrixImageFilter>(
+      SkMatrix(), DlImageSampling::kMipmapLinear);
+  auto container = std::make_shared<ContainerLayer>();
+  for (int i = 0; i < 2; i++) {
+    auto path = SkPath().addRect(SkRect::MakeXYWH(i * 20, 0, 10, 10));
+    auto image_filter_layer =
+        std::make_shared<ImageFilterLayer>(dl_image_filter);
+    image_filter_layer->Add(MockLayer::Make(path));
+    container->Add(image_filter_layer);
+  }
+
+  // All of the flags that the children can apply are passed through, not
+  // just the opacity.
+  PrerollContext* context = preroll_context();
+  container->Preroll(context);
+  EXPECT_EQ(context->renderable_state_flags,
+            LayerStateStack::kCallerCanApplyOpacity |
+                LayerStateStack::kCallerCanApplyColorFilter);
+}
+
 TEST_F(ContainerLayerTest, CollectionCacheableLayer) {
   SkPath child_path;
   child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
@@ -745,5 +793,161 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+namespace {
+
+// Builds a tree with three subtrees that are large enough to be prerolled
+// concurrently, between two leaves that are always prerolled in sequence.
+std::shared_ptr<ContainerLayer> MakeConcurrentPrerollTree(
+    std::vector<std::shared_ptr<MockLayer>>& leaves) {
+  auto root = std::make_shared<ContainerLayer>();
+  SkPath first_path;
+  first_path.addRect(SkRect::MakeXYWH(0, 0, 5, 5));
+  leaves.push_back(std::make_shared<MockCacheableLayer>(first_path));
+  root->Add(leaves.back());
+  for (int subtree = 0; subtree < 3; subtree++) {
+    auto transform = std::make_shared<TransformLayer>(
+        SkMatrix::Scale(subtree + 1, subtree + 1));
+    for (size_t i = 0; i < ContainerLayer::kMinConcurrentPrerollLayers; i++) {
+      SkPath path;
+      path.addRect(SkRect::MakeXYWH(i * 10, subtree * 10 + 10, 5, 5));
+      std::shared_ptr<MockLayer> leaf =
+          i % 4 == 0 ? std::make_shared<MockCacheableLayer>(path)
+                     : std::make_shared<MockLayer>(path);
+      leaves.push_back(leaf);
+      transform->Add(leaf);
+    }
+    root->Add(transform);
+  }
+  leaves[5]->set_fake_reads_surface(true);
+  leaves[40]->set_fake_has_texture_layer(true);
+  SkPath last_path;
+  last_path.addRect(SkRect::MakeXYWH(0, 100, 5, 5));
+  leaves.push_back(std::make_shared<MockCacheableLayer>(last_path));
+  root->Add(leaves.back());
+  return root;
+}
+
+// Returns the index in |leaves| of the layer owning each raster cache item.
+std::vector<size_t> RasterCacheItemOwners(
+    const std::vector<RasterCacheItem*>& items,
+    const std::vector<std::shared_ptr<MockLayer>>& leaves) {
+  std::vector<size_t> owners;
+  for (RasterCacheItem* item : items) {
+    for (size_t i = 0; i < leaves.size(); i++) {
+      auto* cacheable = static_cast<MockCacheableLayer*>(leaves[i].get());
+      if (i % 4 == 1 || i == 0 || i == leaves.size() - 1) {
+        if (cacheable->raster_cache_item() == item) {
+          owners.push_back(i);
+        }
+      }
+    }
+  }
+  return owners;
+}
+
+}  // namespace
+
+TEST_F(ContainerLayerTest, ConcurrentPrerollMatchesSerialPreroll) {
+  use_mock_raster_cache();
+
+  std::vector<std::shared_ptr<MockLayer>> serial_leaves;
+  auto serial_root = MakeConcurrentPrerollTree(serial_leaves);
+  serial_root->Preroll(preroll_context());
+  bool serial_needs_readback = preroll_context()->surface_needs_readback;
+  bool serial_has_texture_layer = preroll_context()->has_texture_layer;
+  std::vector<size_t> serial_owners =
+      RasterCacheItemOwners(cacheable_items(), serial_leaves);
+  ASSERT_EQ(serial_owners.size(), 14u);
+
+  preroll_context()->surface_needs_readback = false;
+  preroll_context()->has_texture_layer = false;
+  cacheable_items().clear();
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto task_runner = loop->GetTaskRunner();
+  preroll_context()->concurrent_task_runner = task_runner.get();
+  std::vector<std::shared_ptr<MockLayer>> leaves;
+  auto root = MakeConcurrentPrerollTree(leaves);
+  root->Preroll(preroll_context());
+
+  EXPECT_EQ(root->paint_bounds(), serial_root->paint_bounds());
+  EXPECT_EQ(root->children_renderable_state_flags(),
+            serial_root->children_renderable_state_flags());
+  EXPECT_EQ(preroll_context()->surface_needs_readback, serial_needs_readback);
+  EXPECT_TRUE(preroll_context()->surface_needs_readback);
+  EXPECT_EQ(preroll_context()->has_texture_layer, serial_has_texture_layer);
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+  EXPECT_EQ(RasterCacheItemOwners(cacheable_items(), leaves), serial_owners);
+  for (size_t i = 0; i < leaves.size(); i++) {
+    EXPECT_EQ(leaves[i]->parent_matrix(), serial_leaves[i]->parent_matrix())
+        << "leaf " << i;
+    EXPECT_EQ(leaves[i]->parent_cull_rect(),
+              serial_leaves[i]->parent_cull_rect())
+        << "leaf " << i;
+  }
+  loop->Terminate();
+}
+
+TEST_F(ContainerLayerTest, RetainedPrerollIsReusedUntilDirty) {
+  preroll_context()->reuse_retained_preroll = true;
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto mock_layer = std::make_shared<MockLayer>(child_path);
+  auto container = std::make_shared<ContainerLayer>();
+  container->Add(mock_layer);
+  auto root = std::make_shared<ContainerLayer>();
+  root->Add(container);
+  EXPECT_FALSE(root->CanReuseRetainedPreroll(preroll_context()));
+
+  root->Preroll(preroll_context());
+  EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+  EXPECT_FALSE(preroll_context()->has_texture_layer);
+  EXPECT_TRUE(root->CanReuseRetainedPreroll(preroll_context()));
+  EXPECT_TRUE(container->CanReuseRetainedPreroll(preroll_context()));
+
+  // The children are not prerolled again, so the change is not seen.
+  mock_layer->set_fake_has_texture_layer(true);
+  root->Preroll(preroll_context());
+  EXPECT_EQ(root->paint_bounds(), child_path.getBounds());
+  EXPECT_FALSE(preroll_context()->has_texture_layer);
+
+  // A different transform is a different input.
+  {
+    auto mutator = preroll_context()->state_stack.save();
+    mutator.translate(10, 10);
+    EXPECT_FALSE(root->CanReuseRetainedPreroll(preroll_context()));
+  }
+  EXPECT_TRUE(root->CanReuseRetainedPreroll(preroll_context()));
+
+  container->MarkDirty();
+  root->MarkDirty();
+  EXPECT_FALSE(root->CanReuseRetainedPreroll(preroll_context()));
+  root->Preroll(preroll_context());
+  EXPECT_TRUE(preroll_context()->has_texture_layer);
+}
+
+TEST_F(ContainerLayerTest, RetainedPrerollIsNotReusedWithRasterCacheEntries) {
+  use_mock_raster_cache();
+  preroll_context()->reuse_retained_preroll = true;
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockCacheableLayer>(child_path));
+
+  layer->Preroll(preroll_context());
+  EXPECT_EQ(cacheable_items().size(), 1u);
+  EXPECT_FALSE(layer->CanReuseRetainedPreroll(preroll_context()));
+}
+
+TEST_F(ContainerLayerTest, RetainedPrerollIsNotReusedUnlessEnabled) {
+  SkPath child_path;
+  child_path.addRect(5.0f, 6.0f, 20.5f, 21.5f);
+  auto layer = std::make_shared<ContainerLayer>();
+  layer->Add(std::make_shared<MockLayer>(child_path));
+
+  layer->Preroll(preroll_context());
+  EXPECT_FALSE(layer->CanReuseRetainedPreroll(preroll_context()));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #include "flutter/flow/layers/display_list_layer.h"
 
 #include <utility>
+#include <vector>
 
 #include "flutter/display_list/display_list_builder.h"
 #include "flutter/display_list/display_list_flags.h"
@@ -39,22 +40,56 @@ bool DisplayListLayer::IsReplacing(DiffContext* context,
          Compare(context->statistics(), this, old_layer);
 }
 
+bool DisplayListLayer::CanDiffIncrementally(DiffContext* context,
+                                            const Layer* layer) const {
+  // Display lists that were recorded with an RTree can be compared op by op
+  // to damage only the bounds of the ops that changed.
+  auto old_layer = layer->as_display_list_layer();
+  if (old_layer == nullptr || offset_ != old_layer->offset_) {
+    return false;
+  }
+  auto dl = display_list();
+  auto old_dl = old_layer->display_list();
+  return dl->has_rtree() && old_dl->has_rtree() &&
+         dl->bytes() <= kMaxBytesToCompare &&
+         old_dl->bytes() <= kMaxBytesToCompare;
+}
+
 void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
   DiffContext::AutoSubtreeRestore subtree(context);
+  const DisplayListLayer* prev = nullptr;
   if (!context->IsSubtreeDirty()) {
-#ifndef NDEBUG
     FML_DCHECK(old_layer);
-    auto prev = old_layer->as_display_list_layer();
-    DiffContext::Statistics dummy_statistics;
-    // IsReplacing has already determined that the display list is same
-    FML_DCHECK(prev->offset_ == offset_ &&
-               Compare(dummy_statistics, this, prev));
-#endif
+    prev = old_layer->as_display_list_layer();
+    // Either IsReplacing has already determined that the display list is
+    // same, or CanDiffIncrementally has determined that the display lists
+    // can be diffed op by op
+    FML_DCHECK(prev && prev->offset_ == offset_);
   }
   context->PushTransform(SkMatrix::Translate(offset_.x(), offset_.y()));
   if (context->has_raster_cache()) {
     context->WillPaintWithIntegralTransform();
   }
+  if (prev && prev->display_list() != display_list() &&
+      display_list()->has_rtree() && prev->display_list()->has_rtree()) {
+    std::vector<SkRect> damage;
+    if (display_list()->DiffOps(*prev->display_list(), &damage)) {
+      for (const auto& rect : damage) {
+        context->AddLayerDamage(rect);
+      }
+    } else {
+      context->AddLayerDamage(prev->display_list()->bounds());
+      context->AddLayerDamage(display_list()->bounds());
+    }
+  }
+#ifndef NDEBUG
+  if (prev &&
+      !(display_list()->has_rtree() && prev->display_list()->has_rtree())) {
+    DiffContext::Statistics dummy_statistics;
+    // IsReplacing has already determined that the display list is same
+    FML_DCHECK(Compare(dummy_statistics, this, prev));
+  }
+#endif
   context->AddLayerBounds(display_list()->bounds());
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
@@ -160,6 +195,18 @@ void DisplayListLayer::Paint(PaintContext& context) const {
   }
 
   auto display_list = display_list_.skia_object();
+  if (context.enable_leaf_layer_timing) {
+    // Only the time it takes to paint the layer into the frame, which
+    // doesn't include the work of the GPU that is deferred to the flush.
+    const auto start_time = fml::TimePoint::Now();
+    context.canvas->DrawDisplayList(display_list, opacity);
+    const fml::TimeDelta paint_time = fml::TimePoint::Now() - start_time;
+    const SkRect device_bounds = RasterCacheUtil::GetDeviceBounds(
+        display_list->bounds(), context.canvas->GetTransform());
+    context.layer_snapshot_store->Add(
+        LayerSnapshotData(unique_id(), paint_time, nullptr, device_bounds));
+    return;
+  }
   context.canvas->DrawDisplayList(display_list, opacity);
 }
 
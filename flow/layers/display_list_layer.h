@@ -30,6 +30,9 @@ class DisplayListLayer : public Layer {
 
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
 
+  bool CanDiffIncrementally(DiffContext* context,
+                            const Layer* layer) const override;
+
   void Diff(DiffContext* context, const Layer* old_layer) override;
 
   const DisplayListLayer* as_display_list_layer() const override {
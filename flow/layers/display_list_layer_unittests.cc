@@ -382,6 +382,71 @@ TEST_F(DisplayListLayerDiffTest, DisplayListCompare) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(20, 20, 70, 70));
 }
 
+TEST_F(DisplayListLayerDiffTest, DisplayListWithRTreeDamagesChangedOps) {
+  auto build = [](DlColor color) {
+    DisplayListBuilder builder(true);
+    builder.drawRect(SkRect::MakeLTRB(10, 10, 60, 60));
+    builder.setColor(color);
+    builder.drawRect(SkRect::MakeLTRB(100, 100, 120, 120));
+    return builder.Build();
+  };
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(build(DlColor::kRed())));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 120, 120));
+
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(build(DlColor::kGreen())));
+
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 100, 120, 120));
+
+  MockLayerTree tree3;
+  tree3.root()->Add(CreateDisplayListLayer(build(DlColor::kGreen())));
+
+  damage = DiffLayerTree(tree3, tree2);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+}
+
+TEST_F(DisplayListLayerDiffTest, DisplayListWithRTreeDamagesRemovedOps) {
+  DisplayListBuilder builder1(true);
+  builder1.drawRect(SkRect::MakeLTRB(10, 10, 60, 60));
+  builder1.drawRect(SkRect::MakeLTRB(100, 100, 120, 120));
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(builder1.Build()));
+
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 120, 120));
+
+  DisplayListBuilder builder2(true);
+  builder2.drawRect(SkRect::MakeLTRB(10, 10, 60, 60));
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(builder2.Build()));
+
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(100, 100, 120, 120));
+}
+
+TEST_F(DisplayListLayerDiffTest, DisplayListWithRTreeAndNewOffset) {
+  auto build = [] {
+    DisplayListBuilder builder(true);
+    builder.drawRect(SkRect::MakeLTRB(10, 10, 60, 60));
+    return builder.Build();
+  };
+
+  MockLayerTree tree1;
+  tree1.root()->Add(CreateDisplayListLayer(build()));
+  auto damage = DiffLayerTree(tree1, MockLayerTree());
+
+  MockLayerTree tree2;
+  tree2.root()->Add(CreateDisplayListLayer(build(), SkPoint::Make(10, 10)));
+
+  damage = DiffLayerTree(tree2, tree1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 70, 70));
+}
+
 TEST_F(DisplayListLayerTest, LayerTreeSnapshotsWhenEnabled) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
@@ -401,6 +466,44 @@ TEST_F(DisplayListLayerTest, LayerTreeSnapshotsWhenEnabled) {
   EXPECT_EQ(1u, snapshot_store.Size());
 }
 
+TEST_F(DisplayListLayerTest, LayerTimingsHaveNoSnapshots) {
+  const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
+  const SkMatrix layer_offset_matrix =
+      SkMatrix::Translate(layer_offset.fX, layer_offset.fY);
+  const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
+  DisplayListBuilder builder;
+  builder.drawRect(picture_bounds);
+  auto display_list = builder.Build();
+  auto layer = std::make_shared<DisplayListLayer>(
+      layer_offset, SkiaGPUObject(display_list, unref_queue()), false, false);
+
+  layer->Preroll(preroll_context());
+
+  paint_context().enable_leaf_layer_timing = true;
+  paint_context().layer_snapshot_store = &layer_snapshot_store();
+  layer->Paint(paint_context());
+  paint_context().enable_leaf_layer_timing = false;
+  paint_context().layer_snapshot_store = nullptr;
+
+  auto& snapshot_store = layer_snapshot_store();
+  ASSERT_EQ(1u, snapshot_store.Size());
+  const auto& timing = *snapshot_store.begin();
+  EXPECT_EQ(static_cast<uint64_t>(timing.GetLayerUniqueId()),
+            layer->unique_id());
+  EXPECT_EQ(timing.GetSnapshot(), nullptr);
+  EXPECT_EQ(timing.GetBounds(), picture_bounds.makeOffset(layer_offset.fX,
+                                                          layer_offset.fY));
+  // The layer paints as it does without timing.
+  auto expected_draw_calls = std::vector(
+      {MockCanvas::DrawCall{0, MockCanvas::SaveData{1}},
+       MockCanvas::DrawCall{
+           1, MockCanvas::ConcatMatrixData{SkM44(layer_offset_matrix)}},
+       MockCanvas::DrawCall{1,
+                            MockCanvas::DrawDisplayListData{display_list, 1}},
+       MockCanvas::DrawCall{1, MockCanvas::RestoreData{0}}});
+  EXPECT_EQ(mock_canvas().draw_calls(), expected_draw_calls);
+}
+
 TEST_F(DisplayListLayerTest, NoLayerTreeSnapshotsWhenDisabledByDefault) {
   const SkPoint layer_offset = SkPoint::Make(1.5f, -0.5f);
   const SkRect picture_bounds = SkRect::MakeLTRB(5.0f, 6.0f, 20.5f, 21.5f);
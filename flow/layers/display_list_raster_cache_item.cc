@@ -132,7 +132,10 @@ bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
   if (!context.raster_cache || !canvas) {
     return false;
   }
-  if (cache_state_ == CacheState::kCurrent) {
+  // Entries that are not current in this frame may still be served while
+  // the raster cache prefers stale images to rendering content again.
+  if (cache_state_ == CacheState::kCurrent ||
+      context.raster_cache->serves_stale_entries()) {
     return context.raster_cache->Draw(key_id_, *canvas, paint);
   }
   return false;
@@ -161,12 +164,23 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .matrix             = transformation_matrix_,
       .logical_rect       = bounds,
       .flow_type          = flow_type,
+      .display_list       = display_list_,
       // clang-format on
   };
-  return context.raster_cache->UpdateCacheEntry(
-      GetId().value(), r_context,
-      [display_list = display_list_](DlCanvas* canvas) {
-        canvas->DrawDisplayList(display_list);
-      });
+  // The DisplayList is immutable, so it can be rendered on the async
+  // generation thread while this frame draws it directly.
+  auto render_function = [display_list = display_list_](DlCanvas* canvas) {
+    canvas->DrawDisplayList(display_list);
+  };
+  // Images may be textures of the GPU context of the raster thread, which the
+  // CPU surfaces of the async generation can't draw, so display lists that
+  // draw images are always cached in the frame.
+  if (context.raster_cache->async_generation_enabled() &&
+      !display_list_->DrawsImages()) {
+    return context.raster_cache->UpdateCacheEntryAsync(
+        GetId().value(), r_context, std::move(render_function));
+  }
+  return context.raster_cache->UpdateCacheEntry(GetId().value(), r_context,
+                                                render_function);
 }
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #include "flutter/display_list/display_list_comparable.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/flow/raster_quality_policy.h"
 
 namespace flutter {
 
@@ -132,7 +133,10 @@ void ImageFilterLayer::Paint(PaintContext& context) const {
   }
 
   // Now apply the image filter and then try rendering the children.
-  mutator.applyImageFilter(child_paint_bounds(), filter_);
+  mutator.applyImageFilter(child_paint_bounds(),
+                           context.reduce_expensive_effects
+                               ? RasterQualityPolicy::ReduceFilterCost(filter_)
+                               : filter_);
 
   PaintChildren(context);
 }
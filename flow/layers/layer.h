@@ -23,6 +23,7 @@
 #include "flutter/fml/compiler_specific.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColor.h"
@@ -88,6 +89,18 @@ struct PrerollContext {
   // the embedders that must decide between creating SkPicture or
   // DisplayList objects for the inter-view slices of the layer tree.
   bool display_list_enabled = false;
+
+  // When set, large subtrees that can be prerolled independently of their
+  // siblings are prerolled on this task runner, see
+  // |ContainerLayer::PrerollChildren|. It is never set in the contexts
+  // used to preroll those subtrees, so that they do not fan out again.
+  fml::BasicTaskRunner* concurrent_task_runner = nullptr;
+
+  // Set if the layers of the tree are not modified once they have been
+  // prerolled, so that a |ContainerLayer| which is retained from an earlier
+  // frame and prerolled with the same inputs can reuse the results of its
+  // previous preroll rather than prerolling its children again.
+  bool reuse_retained_preroll = false;
 };
 
 struct PaintContext {
@@ -119,7 +132,24 @@ struct PaintContext {
   // only when leaf layer tracing is enabled.
   LayerSnapshotStore* layer_snapshot_store = nullptr;
   bool enable_leaf_layer_tracing = false;
+  // Set when only the paint durations and bounds of the leaf layers are
+  // added to |layer_snapshot_store|, without snapshots. See
+  // |CompositorContext::set_layer_timing_sample_interval|.
+  bool enable_leaf_layer_timing = false;
   impeller::AiksContext* aiks_context;
+
+  // Set while the previous frames missed their budget, in which case layers
+  // render expensive effects at a reduced quality, see
+  // |RasterQualityPolicy|.
+  bool reduce_expensive_effects = false;
+
+  // The GPU memory used by the renderer as of the last frame, or null if the
+  // renderer doesn't account for it.
+  const GpuMemoryUsage* gpu_memory_usage = nullptr;
+
+  // The statistics of the past frames that the performance overlay graphs,
+  // or null if they aren't recorded.
+  const FrameStatisticsHistory* frame_statistics = nullptr;
 };
 
 // Represents a single composited layer. Created on the UI thread but then
@@ -154,6 +184,16 @@ class Layer {
     return original_layer_id_ == old_layer->original_layer_id_;
   }
 
+  // Used when this layer replaces old layer in the same position of the tree
+  // but IsReplacing returned false. If this method returns true, the layer is
+  // diffed against the old layer without marking its subtree dirty and is
+  // responsible for adding damage for everything that changed, including the
+  // parts of the old layer paint region that it no longer covers.
+  virtual bool CanDiffIncrementally(DiffContext* context,
+                                    const Layer* old_layer) const {
+    return false;
+  }
+
   // Performs diff with given layer
   virtual void Diff(DiffContext* context, const Layer* old_layer) {}
 
@@ -198,6 +238,12 @@ class Layer {
 
   virtual void PaintChildren(PaintContext& context) const { FML_DCHECK(false); }
 
+  // Returns false if the layer must be prerolled on the thread that prerolls
+  // the frame, for example because it calls into the ExternalViewEmbedder.
+  // Subtrees containing such a layer are never prerolled concurrently with
+  // their siblings.
+  virtual bool can_preroll_concurrently() const { return true; }
+
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
   void set_subtree_has_platform_view(bool value) {
     subtree_has_platform_view_ = value;
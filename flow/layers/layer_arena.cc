@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+// The header of a chunk, which its allocations follow. Each allocation is
+// preceded by a pointer to its chunk.
+struct LayerArena::Chunk {
+  // The number of allocations that weren't freed, plus one while the chunk
+  // is the one an arena allocates from.
+  std::atomic<size_t> ref_count{1u};
+};
+
+LayerArena::LayerArena() = default;
+
+LayerArena::~LayerArena() {
+  if (chunk_) {
+    Unref(chunk_);
+  }
+}
+
+LayerArena::Chunk* LayerArena::CreateChunk(size_t capacity) {
+  return new (::operator new(sizeof(Chunk) + capacity)) Chunk();
+}
+
+void LayerArena::Unref(Chunk* chunk) {
+  if (chunk->ref_count.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+    chunk->~Chunk();
+    ::operator delete(chunk);
+  }
+}
+
+void* LayerArena::Place(Chunk* chunk,
+                        uint8_t*& cursor,
+                        size_t size,
+                        size_t alignment) {
+  uintptr_t start = reinterpret_cast<uintptr_t>(cursor) + sizeof(Chunk*);
+  uintptr_t aligned = (start + alignment - 1u) & ~(alignment - 1u);
+  *reinterpret_cast<Chunk**>(aligned - sizeof(Chunk*)) = chunk;
+  cursor = reinterpret_cast<uint8_t*>(aligned + size);
+  return reinterpret_cast<void*>(aligned);
+}
+
+void* LayerArena::Allocate(size_t size, size_t alignment) {
+  FML_DCHECK(alignment != 0u && (alignment & (alignment - 1u)) == 0u);
+  FML_DCHECK(alignment <= alignof(std::max_align_t));
+  alignment = std::max(alignment, alignof(Chunk*));
+  // The most space that the allocation, its header and padding take.
+  const size_t needed = size + sizeof(Chunk*) + alignment - 1u;
+
+  if (needed > kChunkSize / 4u) {
+    Chunk* chunk = CreateChunk(needed);
+    chunk_count_++;
+    uint8_t* cursor = reinterpret_cast<uint8_t*>(chunk + 1);
+    return Place(chunk, cursor, size, alignment);
+  }
+
+  if (!chunk_ || needed > remaining_) {
+    if (chunk_) {
+      Unref(chunk_);
+    }
+    chunk_ = CreateChunk(kChunkSize);
+    chunk_count_++;
+    cursor_ = reinterpret_cast<uint8_t*>(chunk_ + 1);
+    remaining_ = kChunkSize;
+  }
+
+  chunk_->ref_count.fetch_add(1u, std::memory_order_relaxed);
+  uint8_t* start = cursor_;
+  void* allocation = Place(chunk_, cursor_, size, alignment);
+  remaining_ -= cursor_ - start;
+  return allocation;
+}
+
+void LayerArena::Free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  Unref(*reinterpret_cast<Chunk**>(reinterpret_cast<uintptr_t>(ptr) -
+                                   sizeof(Chunk*)));
+}
+
+}  // namespace flutter
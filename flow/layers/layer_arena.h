@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+#define FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A bump allocator for the layers of a frame.
+//
+// The layers that a SceneBuilder creates for a frame are allocated on the UI
+// thread and usually destroyed together on the raster thread, once the next
+// frame replaces their layer tree. Allocating them, along with their
+// reference counts, from a few large chunks rather than one by one avoids
+// thousands of small allocations and frees that contend for the allocator
+// between the two threads every frame.
+//
+// The layers are still reference counted, so that engine layers can retain
+// them for later frames. Freeing a layer doesn't return its memory to the
+// arena. Instead, each chunk is released wholesale once all of the layers
+// allocated from it are destroyed and the arena has moved on to another
+// chunk or was destroyed itself.
+//
+// Allocating is not thread-safe, but the layers and the arena may be
+// destroyed on any thread and in any order.
+class LayerArena {
+ public:
+  // The size of the chunks. Allocations larger than a quarter of a chunk get
+  // a chunk of their own.
+  static constexpr size_t kChunkSize = 16u * 1024u;
+
+  LayerArena();
+
+  ~LayerArena();
+
+  // Allocates a T, such as a layer, that is constructed with |args|.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> Make(Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(this),
+                                   std::forward<Args>(args)...);
+  }
+
+  // Returns |size| bytes aligned to |alignment|, which must be a power of two
+  // no larger than alignof(std::max_align_t).
+  void* Allocate(size_t size, size_t alignment);
+
+  // Frees memory returned by |Allocate| of any arena.
+  static void Free(void* ptr);
+
+  // The number of chunks that were allocated by this arena.
+  size_t chunk_count() const { return chunk_count_; }
+
+  // A standard allocator of the memory of an arena, which must outlive the
+  // allocations but not the deallocations.
+  template <typename T>
+  class Allocator {
+   public:
+    using value_type = T;
+
+    explicit Allocator(LayerArena* arena) : arena_(arena) {}
+
+    template <typename U>
+    Allocator(const Allocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t n) {
+      return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) { LayerArena::Free(ptr); }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return arena_ != other.arena_;
+    }
+
+   private:
+    template <typename U>
+    friend class Allocator;
+
+    LayerArena* arena_;
+  };
+
+ private:
+  struct Chunk;
+
+  // The chunk that is allocated from, which the arena holds a reference to.
+  Chunk* chunk_ = nullptr;
+  // The start of the free space of the chunk and its size.
+  uint8_t* cursor_ = nullptr;
+  size_t remaining_ = 0u;
+  size_t chunk_count_ = 0u;
+
+  static Chunk* CreateChunk(size_t capacity);
+
+  // Places an allocation at |cursor| in |chunk| and returns it. |cursor|
+  // moves past it.
+  static void* Place(Chunk* chunk,
+                     uint8_t*& cursor,
+                     size_t size,
+                     size_t alignment);
+
+  static void Unref(Chunk* chunk);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LayerArena);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_LAYERS_LAYER_ARENA_H_
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/layers/layer_arena.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Counts the live instances, like a layer that its parent holds on to.
+class Counted {
+ public:
+  explicit Counted(int* count) : count_(count) { (*count_)++; }
+
+  ~Counted() { (*count_)--; }
+
+ private:
+  int* count_;
+};
+
+struct alignas(16) Aligned {
+  double values[2];
+};
+
+}  // namespace
+
+TEST(LayerArenaTest, AllocationsAreAligned) {
+  LayerArena arena;
+  for (size_t alignment = 1u; alignment <= alignof(std::max_align_t);
+       alignment *= 2u) {
+    for (size_t size = 1u; size < 40u; size += 13u) {
+      void* ptr = arena.Allocate(size, alignment);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+      LayerArena::Free(ptr);
+    }
+  }
+  auto aligned = arena.Make<Aligned>();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.get()) % 16u, 0u);
+}
+
+TEST(LayerArenaTest, AllocationsShareChunks) {
+  int count = 0;
+  std::vector<std::shared_ptr<Counted>> objects;
+  {
+    LayerArena arena;
+    for (int i = 0; i < 100; i++) {
+      objects.push_back(arena.Make<Counted>(&count));
+    }
+    EXPECT_EQ(arena.chunk_count(), 1u);
+
+    std::vector<uint8_t*> bytes;
+    for (size_t i = 0; i < LayerArena::kChunkSize / 64u; i++) {
+      bytes.push_back(static_cast<uint8_t*>(arena.Allocate(64u, 1u)));
+      // The allocations don't overlap.
+      bytes.back()[63] = 1u;
+    }
+    EXPECT_GT(arena.chunk_count(), 1u);
+    for (auto* ptr : bytes) {
+      LayerArena::Free(ptr);
+    }
+  }
+  // The objects outlive the arena.
+  EXPECT_EQ(count, 100);
+  objects.erase(objects.begin(), objects.begin() + 50);
+  EXPECT_EQ(count, 50);
+  objects.clear();
+  EXPECT_EQ(count, 0);
+}
+
+TEST(LayerArenaTest, LargeAllocationsGetTheirOwnChunk) {
+  LayerArena arena;
+  auto* small = static_cast<uint8_t*>(arena.Allocate(16u, 8u));
+  EXPECT_EQ(arena.chunk_count(), 1u);
+  auto* large = static_cast<uint8_t*>(
+      arena.Allocate(LayerArena::kChunkSize * 2u, 8u));
+  EXPECT_EQ(arena.chunk_count(), 2u);
+  large[LayerArena::kChunkSize * 2u - 1u] = 1u;
+  // Allocations continue in the first chunk.
+  auto* next = static_cast<uint8_t*>(arena.Allocate(16u, 8u));
+  EXPECT_EQ(arena.chunk_count(), 2u);
+  EXPECT_GT(next, small);
+  EXPECT_LT(next, small + LayerArena::kChunkSize);
+  LayerArena::Free(small);
+  LayerArena::Free(large);
+  LayerArena::Free(next);
+}
+
+TEST(LayerArenaTest, ObjectsCanBeDestroyedOnAnotherThread) {
+  int count = 0;
+  std::vector<std::shared_ptr<Counted>> objects;
+  {
+    LayerArena arena;
+    for (int i = 0; i < 1000; i++) {
+      objects.push_back(arena.Make<Counted>(&count));
+    }
+  }
+  std::thread thread([objects = std::move(objects)]() mutable {
+    objects.clear();
+  });
+  thread.join();
+  EXPECT_EQ(count, 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -179,7 +179,10 @@ bool LayerRasterCacheItem::Draw(const PaintContext& context,
   }
   switch (cache_state_) {
     case RasterCacheItem::kNone:
-      return false;
+      // Only the image of the whole layer can stand in for it, the image of
+      // its children would skip the effect of the layer itself.
+      return context.raster_cache->serves_stale_entries() &&
+             context.raster_cache->Draw(key_id_, *canvas, paint);
     case RasterCacheItem::kCurrent: {
       return context.raster_cache->Draw(key_id_, *canvas, paint);
     }
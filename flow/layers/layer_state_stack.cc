@@ -137,6 +137,8 @@ class PrerollDelegate : public LayerStateStack::Delegate {
  public:
   PrerollDelegate(const SkRect& cull_rect, const SkMatrix& matrix)
       : tracker_(cull_rect, matrix) {}
+  PrerollDelegate(const SkRect& cull_rect, const SkM44& matrix)
+      : tracker_(cull_rect, matrix) {}
 
   void decommission() override {}
 
@@ -642,6 +644,12 @@ void LayerStateStack::set_preroll_delegate(const SkRect& cull_rect,
   delegate_ = std::make_shared<PrerollDelegate>(cull_rect, matrix);
   reapply_all();
 }
+void LayerStateStack::set_preroll_delegate(const SkRect& cull_rect,
+                                           const SkM44& matrix) {
+  clear_delegate();
+  delegate_ = std::make_shared<PrerollDelegate>(cull_rect, matrix);
+  reapply_all();
+}
 
 void LayerStateStack::reapply_all() {
   // We use a local RenderingAttributes instance so that it can track the
@@ -124,6 +124,7 @@ class LayerStateStack {
   // that only one delegate - either a DlCanvas or a preroll accumulator -
   // is present at any one time.
   void set_preroll_delegate(const SkRect& cull_rect, const SkMatrix& matrix);
+  void set_preroll_delegate(const SkRect& cull_rect, const SkM44& matrix);
   void set_preroll_delegate(const SkRect& cull_rect);
   void set_preroll_delegate(const SkMatrix& matrix);
 
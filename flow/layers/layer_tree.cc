@@ -67,6 +67,8 @@ bool LayerTree::Preroll(CompositorContext::ScopedFrame& frame,
       .frame_device_pixel_ratio      = device_pixel_ratio_,
       .raster_cached_entries         = &raster_cache_items_,
       .display_list_enabled          = frame.display_list_builder() != nullptr,
+      .concurrent_task_runner        = frame.context().preroll_task_runner(),
+      .reuse_retained_preroll        = frame.context().reuse_retained_preroll(),
       // clang-format on
   };
 
@@ -122,9 +124,14 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
 
   // clear the previous snapshots.
   LayerSnapshotStore* snapshot_store = nullptr;
+  bool enable_leaf_layer_timing = false;
   if (enable_leaf_layer_tracing_) {
     frame.context().snapshot_store().Clear();
     snapshot_store = &frame.context().snapshot_store();
+  } else if (frame.context().ShouldSampleLayerTimings()) {
+    frame.context().layer_timing_store().Clear();
+    snapshot_store = &frame.context().layer_timing_store();
+    enable_leaf_layer_timing = true;
   }
 
   SkColorSpace* color_space = GetColorSpace(frame.canvas());
@@ -144,7 +151,11 @@ void LayerTree::Paint(CompositorContext::ScopedFrame& frame,
       .frame_device_pixel_ratio      = device_pixel_ratio_,
       .layer_snapshot_store          = snapshot_store,
       .enable_leaf_layer_tracing     = enable_leaf_layer_tracing_,
+      .enable_leaf_layer_timing      = enable_leaf_layer_timing,
       .aiks_context                  = frame.aiks_context(),
+      .reduce_expensive_effects      = frame.context().reduce_raster_quality(),
+      .gpu_memory_usage              = frame.context().gpu_memory_usage(),
+      .frame_statistics              = &frame.context().frame_statistics(),
       // clang-format on
   };
 
@@ -255,6 +255,7 @@ TEST_F(LayerTreeTest, PaintContextInitialization) {
     EXPECT_EQ(context.frame_device_pixel_ratio, 1.0f);
 
     EXPECT_EQ(context.enable_leaf_layer_tracing, false);
+    EXPECT_EQ(context.enable_leaf_layer_timing, false);
     EXPECT_EQ(context.layer_snapshot_store, nullptr);
   };
 
@@ -268,5 +269,21 @@ TEST_F(LayerTreeTest, PaintContextInitialization) {
   expect_defaults(context);
 }
 
+TEST(CompositorContextTest, SamplesLayerTimingsOfOneInEveryIntervalFrames) {
+  CompositorContext compositor_context;
+  EXPECT_FALSE(compositor_context.ShouldSampleLayerTimings());
+
+  compositor_context.set_layer_timing_sample_interval(3u);
+  std::vector<bool> sampled;
+  for (int i = 0; i < 7; i++) {
+    sampled.push_back(compositor_context.ShouldSampleLayerTimings());
+  }
+  EXPECT_EQ(sampled, (std::vector<bool>{true, false, false, true, false, false,
+                                        true}));
+
+  compositor_context.set_layer_timing_sample_interval(0u);
+  EXPECT_FALSE(compositor_context.ShouldSampleLayerTimings());
+}
+
 }  // namespace testing
 }  // namespace flutter
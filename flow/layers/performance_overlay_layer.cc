@@ -7,6 +7,9 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <vector>
+
+#include "flutter/display_list/display_list_builder.h"
 
 #include "third_party/skia/include/core/SkFont.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
@@ -41,17 +44,87 @@ void VisualizeStopWatch(DlCanvas* canvas,
   }
 }
 
+SkFont MakeStatisticsFont(const std::string& font_path) {
+  SkFont font;
+  if (font_path != "") {
+    font = SkFont(SkTypeface::MakeFromFile(font_path.c_str()));
+  }
+  font.setSize(15);
+  return font;
+}
+
+struct SampleHistoryGraph {
+  const SampleHistory& history;
+  const char* label;
+  const char* unit;
+  // The value that fills the graph when no sample is larger.
+  double min_range;
+  DlColor color;
+};
+
+/// Draws a row of graphs of the statistics of the renderer that have samples,
+/// side by side. They are recorded into a single DisplayList so that they
+/// cost the canvas a single draw call, however many there are.
+void VisualizeFrameStatistics(DlCanvas* canvas,
+                              const FrameStatisticsHistory& statistics,
+                              const SkRect& rect,
+                              const std::string& font_path) {
+  const SampleHistoryGraph graphs[] = {
+      {statistics.gpu_time_ms, "GPU", "ms", 16.0, DlColor(0xAA0000FF)},
+      {statistics.raster_cache_hit_percent, "Cache hits", "%", 100.0,
+       DlColor(0xAA00AA00)},
+      {statistics.raster_cache_bytes, "Cache", "MB", 1.0, DlColor(0xAA00AA00)},
+      {statistics.glyph_atlas_uploads, "Glyph uploads", "", 1.0,
+       DlColor(0xAAAA00AA)},
+      {statistics.pipeline_compiles, "Pipelines", "", 1.0,
+       DlColor(0xAAFF0000)},
+      {statistics.offscreen_passes, "Offscreen", "", 1.0, DlColor(0xAA0088FF)},
+  };
+  std::vector<const SampleHistoryGraph*> visible;
+  for (const auto& graph : graphs) {
+    if (graph.history.HasSamples()) {
+      visible.push_back(&graph);
+    }
+  }
+  if (visible.empty()) {
+    return;
+  }
+
+  const SkScalar spacing = 4;
+  const SkScalar graph_width =
+      (rect.width() - spacing * (visible.size() - 1)) / visible.size();
+  SkFont font = MakeStatisticsFont(font_path);
+  font.setSize(12);
+  DlPaint text_paint(0xFF888888);
+  DisplayListBuilder builder(rect);
+  for (size_t i = 0; i < visible.size(); i++) {
+    const auto& graph = *visible[i];
+    SkRect graph_rect =
+        SkRect::MakeXYWH(rect.x() + (graph_width + spacing) * i, rect.y(),
+                         graph_width, rect.height());
+    graph.history.Visualize(&builder, graph_rect, graph.min_range,
+                            graph.color);
+
+    std::stringstream stream;
+    stream.setf(std::ios::fixed | std::ios::showpoint);
+    stream << std::setprecision(1);
+    stream << graph.label << " " << graph.history.AverageSample()
+           << graph.unit;
+    auto text = stream.str();
+    builder.DrawTextBlob(SkTextBlob::MakeFromText(text.c_str(), text.size(),
+                                                  font, SkTextEncoding::kUTF8),
+                         graph_rect.x() + 4, graph_rect.y() + 14, text_paint);
+  }
+  canvas->DrawDisplayList(builder.Build());
+}
+
 }  // namespace
 
 sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
     const Stopwatch& stopwatch,
     const std::string& label_prefix,
     const std::string& font_path) {
-  SkFont font;
-  if (font_path != "") {
-    font = SkFont(SkTypeface::MakeFromFile(font_path.c_str()));
-  }
-  font.setSize(15);
+  SkFont font = MakeStatisticsFont(font_path);
 
   double max_ms_per_frame = stopwatch.MaxDelta().ToMillisecondsF();
   double average_ms_per_frame = stopwatch.AverageDelta().ToMillisecondsF();
@@ -66,6 +139,23 @@ sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeStatisticsText(
                                   SkTextEncoding::kUTF8);
 }
 
+sk_sp<SkTextBlob> PerformanceOverlayLayer::MakeGpuMemoryText(
+    const GpuMemoryUsage& usage,
+    const std::string& font_path) {
+  SkFont font = MakeStatisticsFont(font_path);
+
+  const double kBytesPerMB = 1024.0 * 1024.0;
+  std::stringstream stream;
+  stream.setf(std::ios::fixed | std::ios::showpoint);
+  stream << std::setprecision(1);
+  stream << "GPU memory  "
+         << "live " << usage.live_bytes / kBytesPerMB << " MB, "
+         << "frame peak " << usage.frame_peak_bytes / kBytesPerMB << " MB";
+  auto text = stream.str();
+  return SkTextBlob::MakeFromText(text.c_str(), text.size(), font,
+                                  SkTextEncoding::kUTF8);
+}
+
 PerformanceOverlayLayer::PerformanceOverlayLayer(uint64_t options,
                                                  const char* font_path)
     : options_(options) {
@@ -96,7 +186,12 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
   SkScalar x = paint_bounds().x() + padding;
   SkScalar y = paint_bounds().y() + padding;
   SkScalar width = paint_bounds().width() - (padding * 2);
-  SkScalar height = paint_bounds().height() / 2;
+  // The graphs of the renderer statistics get a row of their own below the
+  // frame times.
+  const bool visualize_renderer_statistics =
+      (options_ & kVisualizeRendererStatistics) && context.frame_statistics;
+  SkScalar height =
+      paint_bounds().height() / (visualize_renderer_statistics ? 3 : 2);
   auto mutator = context.state_stack.save();
 
   VisualizeStopWatch(
@@ -107,6 +202,22 @@ void PerformanceOverlayLayer::Paint(PaintContext& context) const {
   VisualizeStopWatch(context.canvas, context.ui_time, x, y + height, width,
                      height - padding, options_ & kVisualizeEngineStatistics,
                      options_ & kDisplayEngineStatistics, "UI", font_path_);
+
+  // Only renderers that account for their allocations report their usage.
+  if ((options_ & kDisplayGpuMemoryStatistics) && context.gpu_memory_usage) {
+    const int label_x = 8;   // distance from x
+    const int label_y = 20;  // distance from y
+    auto text = MakeGpuMemoryText(*context.gpu_memory_usage, font_path_);
+    DlPaint paint(0xFF888888);
+    context.canvas->DrawTextBlob(text, x + label_x, y + label_y, paint);
+  }
+
+  if (visualize_renderer_statistics) {
+    VisualizeFrameStatistics(
+        context.canvas, *context.frame_statistics,
+        SkRect::MakeXYWH(x, y + height * 2, width, height - padding),
+        font_path_);
+  }
 }
 
 }  // namespace flutter
@@ -19,6 +19,8 @@ const int kDisplayRasterizerStatistics = 1 << 0;
 const int kVisualizeRasterizerStatistics = 1 << 1;
 const int kDisplayEngineStatistics = 1 << 2;
 const int kVisualizeEngineStatistics = 1 << 3;
+const int kDisplayGpuMemoryStatistics = 1 << 4;
+const int kVisualizeRendererStatistics = 1 << 5;
 
 class PerformanceOverlayLayer : public Layer {
  public:
@@ -26,6 +28,9 @@ class PerformanceOverlayLayer : public Layer {
                                               const std::string& label_prefix,
                                               const std::string& font_path);
 
+  static sk_sp<SkTextBlob> MakeGpuMemoryText(const GpuMemoryUsage& usage,
+                                             const std::string& font_path);
+
   bool IsReplacing(DiffContext* context, const Layer* layer) const override {
     return layer->as_performance_overlay_layer() != nullptr;
   }
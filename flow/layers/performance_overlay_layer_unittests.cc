@@ -193,6 +193,66 @@ TEST_F(PerformanceOverlayLayerTest, SimpleRasterizerStatistics) {
                                             text_position}}}));
 }
 
+TEST_F(PerformanceOverlayLayerTest, GpuMemoryStatistics) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 64.0f);
+  const uint64_t overlay_opts = kDisplayGpuMemoryStatistics;
+  auto layer = std::make_shared<PerformanceOverlayLayer>(overlay_opts);
+  layer->set_paint_bounds(layer_bounds);
+  layer->Preroll(preroll_context());
+
+  // Nothing is drawn for renderers that don't account for their memory.
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
+
+  GpuMemoryUsage usage = {
+      .live_bytes = 3u * 1024u * 1024u,
+      .frame_peak_bytes = 4u * 1024u * 1024u,
+      .peak_bytes = 5u * 1024u * 1024u,
+  };
+  paint_context().gpu_memory_usage = &usage;
+  layer->Paint(paint_context());
+  paint_context().gpu_memory_usage = nullptr;
+
+  auto overlay_text = PerformanceOverlayLayer::MakeGpuMemoryText(usage, "");
+  auto overlay_text_data = overlay_text->serialize(SkSerialProcs{});
+  DlPaint text_paint(0xFF888888);
+  SkPoint text_position = SkPoint::Make(16.0f, 28.0f);
+
+#if defined(OS_FUCHSIA)
+  GTEST_SKIP() << "Expectation requires a valid default font manager";
+#endif  // OS_FUCHSIA
+  EXPECT_EQ(mock_canvas().draw_calls(),
+            std::vector({MockCanvas::DrawCall{
+                0, MockCanvas::DrawTextData{overlay_text_data, text_paint,
+                                            text_position}}}));
+}
+
+TEST_F(PerformanceOverlayLayerTest, RendererStatisticsAreDrawnInOneCall) {
+  const SkRect layer_bounds = SkRect::MakeLTRB(0.0f, 0.0f, 64.0f, 64.0f);
+  const uint64_t overlay_opts = kVisualizeRendererStatistics;
+  auto layer = std::make_shared<PerformanceOverlayLayer>(overlay_opts);
+  layer->set_paint_bounds(layer_bounds);
+  layer->Preroll(preroll_context());
+
+  // Only the statistics with samples are graphed, and there are none yet.
+  FrameStatisticsHistory statistics;
+  paint_context().frame_statistics = &statistics;
+  layer->Paint(paint_context());
+  EXPECT_EQ(mock_canvas().draw_calls(), std::vector<MockCanvas::DrawCall>());
+
+  statistics.gpu_time_ms.AddSample(4.0);
+  statistics.pipeline_compiles.AddSample(2.0);
+  layer->Paint(paint_context());
+  paint_context().frame_statistics = nullptr;
+
+  ASSERT_EQ(mock_canvas().draw_calls().size(), 1u);
+  auto data = std::get_if<MockCanvas::DrawDisplayListData>(
+      &mock_canvas().draw_calls()[0].data);
+  ASSERT_NE(data, nullptr);
+  // Each graph is a background, its samples and a label.
+  EXPECT_EQ(data->display_list->op_count(), 6u);
+}
+
 TEST_F(PerformanceOverlayLayerTest, MarkAsDirtyWhenResized) {
   // Regression test for https://github.com/flutter/flutter/issues/54188
 
@@ -16,9 +16,14 @@ class PlatformViewLayer : public Layer {
  public:
   PlatformViewLayer(const SkPoint& offset, const SkSize& size, int64_t view_id);
 
+  void Diff(DiffContext* context, const Layer* old_layer) override;
   void Preroll(PrerollContext* context) override;
   void Paint(PaintContext& context) const override;
 
+  // Platform views are prerolled with the ExternalViewEmbedder, in the order
+  // in which they are encountered.
+  bool can_preroll_concurrently() const override { return false; }
+
  private:
   SkPoint offset_;
   SkSize size_;
@@ -310,5 +310,77 @@ TEST(Mutator, UnEquality) {
   ASSERT_TRUE(mutator3 != other_mutator3);
 }
 
+TEST(MutatorsStack, FlattenedComposesTransforms) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(10, 20));
+  stack.PushTransform(SkMatrix());
+  stack.PushTransform(SkMatrix::Scale(2, 3));
+
+  std::vector<Mutator> expected = {
+      Mutator(SkMatrix::Translate(10, 20) * SkMatrix::Scale(2, 3)),
+  };
+  ASSERT_TRUE(stack.Flattened() == expected);
+}
+
+TEST(MutatorsStack, FlattenedMapsClipRectsThroughAxisAlignedTransforms) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(10, 20));
+  stack.PushClipRect(SkRect::MakeLTRB(0, 0, 100, 100));
+  stack.PushTransform(SkMatrix::Scale(2, 2));
+  stack.PushClipRect(SkRect::MakeLTRB(10, 10, 100, 100));
+  stack.PushOpacity(128);
+
+  // The clips are in the coordinates above the transforms, and intersected.
+  std::vector<Mutator> expected = {
+      Mutator(SkRect::MakeLTRB(30, 40, 110, 120)),
+      Mutator(128),
+      Mutator(SkMatrix::Translate(10, 20) * SkMatrix::Scale(2, 2)),
+  };
+  ASSERT_TRUE(stack.Flattened() == expected);
+}
+
+TEST(MutatorsStack, FlattenedKeepsTransformsBeforeOtherClips) {
+  SkMatrix rotate = SkMatrix::RotateDeg(45);
+  SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeLTRB(0, 0, 10, 10), 2, 2);
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(10, 20));
+  stack.PushTransform(rotate);
+  stack.PushClipRect(SkRect::MakeLTRB(0, 0, 100, 100));
+  stack.PushClipRect(SkRect::MakeLTRB(50, 50, 150, 150));
+  stack.PushClipRRect(rrect);
+  stack.PushTransform(SkMatrix::Translate(1, 2));
+
+  std::vector<Mutator> expected = {
+      Mutator(SkMatrix::Translate(10, 20) * rotate),
+      Mutator(SkRect::MakeLTRB(50, 50, 100, 100)),
+      Mutator(rrect),
+      Mutator(SkMatrix::Translate(1, 2)),
+  };
+  ASSERT_TRUE(stack.Flattened() == expected);
+}
+
+TEST(MutatorsStackFlattener, ReusesStacksThatDidNotChange) {
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(10, 20));
+  stack.PushTransform(SkMatrix::Scale(2, 3));
+
+  MutatorsStackFlattener flattener;
+  const MutatorsStack* flattened = &flattener.Flatten(1, stack);
+  ASSERT_TRUE(*flattened == stack.Flattened());
+  flattener.EndFrame();
+
+  ASSERT_EQ(&flattener.Flatten(1, MutatorsStack(stack)), flattened);
+  flattener.EndFrame();
+
+  stack.PushClipRect(SkRect::MakeLTRB(0, 0, 10, 10));
+  ASSERT_TRUE(flattener.Flatten(1, stack) == stack.Flattened());
+  flattener.EndFrame();
+
+  // Views that aren't flattened in a frame are forgotten.
+  flattener.EndFrame();
+  const MutatorsStack& reflattened = flattener.Flatten(1, stack);
+  ASSERT_TRUE(reflattened == stack.Flattened());
+}
+
 }  // namespace testing
 }  // namespace flutter
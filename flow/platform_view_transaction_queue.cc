@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/platform_view_transaction_queue.h"
+
+#include <chrono>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+PlatformViewTransactionQueue::PlatformViewTransactionQueue(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner)
+    : platform_task_runner_(std::move(platform_task_runner)),
+      state_(std::make_shared<State>()) {
+  FML_DCHECK(platform_task_runner_);
+}
+
+PlatformViewTransactionQueue::~PlatformViewTransactionQueue() = default;
+
+void PlatformViewTransactionQueue::AddChange(fml::closure change) {
+  changes_.push_back(std::move(change));
+}
+
+bool PlatformViewTransactionQueue::HasChanges() const {
+  return !changes_.empty();
+}
+
+void PlatformViewTransactionQueue::Cancel() {
+  changes_.clear();
+}
+
+void PlatformViewTransactionQueue::Commit() {
+  if (changes_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PlatformViewTransactionQueue::Commit");
+  {
+    std::scoped_lock lock(state_->mutex);
+    state_->pending_transactions++;
+  }
+  auto apply = [state = state_, changes = std::move(changes_)]() {
+    TRACE_EVENT0("flutter", "PlatformViewTransactionQueue::Apply");
+    for (const auto& change : changes) {
+      change();
+    }
+    {
+      std::scoped_lock lock(state->mutex);
+      state->pending_transactions--;
+    }
+    state->applied.notify_all();
+  };
+  changes_.clear();
+  if (platform_task_runner_->RunsTasksOnCurrentThread()) {
+    apply();
+  } else {
+    platform_task_runner_->PostTask(std::move(apply));
+  }
+}
+
+bool PlatformViewTransactionQueue::WaitUntilApplied(fml::TimeDelta timeout) {
+  TRACE_EVENT0("flutter", "PlatformViewTransactionQueue::WaitUntilApplied");
+  std::unique_lock lock(state_->mutex);
+  return state_->applied.wait_for(
+      lock, std::chrono::microseconds(timeout.ToMicroseconds()),
+      [this]() { return state_->pending_transactions == 0; });
+}
+
+size_t PlatformViewTransactionQueue::GetPendingTransactionCount() const {
+  std::scoped_lock lock(state_->mutex);
+  return state_->pending_transactions;
+}
+
+}  // namespace flutter
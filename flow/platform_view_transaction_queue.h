@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_PLATFORM_VIEW_TRANSACTION_QUEUE_H_
+#define FLUTTER_FLOW_PLATFORM_VIEW_TRANSACTION_QUEUE_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Carries the changes to the platform views of each frame from the
+///             raster thread to the platform thread, for the external view
+///             embedders that support async composition.
+///
+///             While a frame is submitted, the embedder adds to the queue the
+///             work that must happen on the platform thread, such as moving
+///             the platform views and presenting the overlay surfaces rendered
+///             around them, and commits it at the end of the frame. The
+///             changes of a frame are applied together by a single task on
+///             the platform thread, so that the platform views move in the
+///             same platform frame as the surfaces that were drawn for them.
+///
+///             Before rendering into surfaces that the platform thread may
+///             still present, the embedder waits for the transactions that
+///             were committed to be applied. That fence is the only point
+///             where the raster thread waits on the platform thread.
+///
+///             The changes are added and committed on the raster thread.
+///
+class PlatformViewTransactionQueue {
+ public:
+  explicit PlatformViewTransactionQueue(
+      fml::RefPtr<fml::TaskRunner> platform_task_runner);
+
+  ~PlatformViewTransactionQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds a change to the transaction of the current frame. It is
+  ///             run on the platform thread once the transaction is
+  ///             committed, after the changes added before it.
+  ///
+  void AddChange(fml::closure change);
+
+  //----------------------------------------------------------------------------
+  /// @return     Whether the transaction of the current frame has changes.
+  ///
+  bool HasChanges() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the changes of the current frame, for frames that are
+  ///             cancelled or resubmitted.
+  ///
+  void Cancel();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Applies the changes of the current frame on the platform
+  ///             thread, and starts the transaction of the next frame.
+  ///
+  ///             The changes are applied right away when called on the
+  ///             platform thread, and nothing happens if there are none.
+  ///
+  void Commit();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Blocks until the transactions committed so far were
+  ///             applied by the platform thread.
+  ///
+  /// @return     Whether they were applied before the timeout.
+  ///
+  bool WaitUntilApplied(fml::TimeDelta timeout);
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of transactions committed but not yet applied.
+  ///
+  size_t GetPendingTransactionCount() const;
+
+ private:
+  struct State {
+    mutable std::mutex mutex;
+    std::condition_variable applied;
+    size_t pending_transactions = 0;
+  };
+
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  // Shared with the tasks that apply the transactions, which may outlive the
+  // queue.
+  const std::shared_ptr<State> state_;
+  std::vector<fml::closure> changes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlatformViewTransactionQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_PLATFORM_VIEW_TRANSACTION_QUEUE_H_
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/platform_view_transaction_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(PlatformViewTransactionQueueTest, AppliesChangesInOrderOnPlatformThread) {
+  fml::Thread platform_thread("platform");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+  PlatformViewTransactionQueue queue(platform_task_runner);
+
+  std::vector<int> applied;
+  bool applied_on_platform_thread = true;
+  for (int i = 0; i < 3; i++) {
+    queue.AddChange([&, i]() {
+      applied_on_platform_thread &=
+          platform_task_runner->RunsTasksOnCurrentThread();
+      applied.push_back(i);
+    });
+  }
+  EXPECT_TRUE(queue.HasChanges());
+
+  queue.Commit();
+  EXPECT_FALSE(queue.HasChanges());
+  ASSERT_TRUE(queue.WaitUntilApplied(fml::TimeDelta::FromSeconds(10)));
+  EXPECT_EQ(queue.GetPendingTransactionCount(), 0u);
+  EXPECT_TRUE(applied_on_platform_thread);
+  EXPECT_EQ(applied, std::vector<int>({0, 1, 2}));
+}
+
+TEST(PlatformViewTransactionQueueTest, WaitsForPendingTransactions) {
+  fml::Thread platform_thread("platform");
+  PlatformViewTransactionQueue queue(platform_thread.GetTaskRunner());
+
+  // Keep the platform thread busy so that the transaction stays pending.
+  fml::AutoResetWaitableEvent release_platform_thread;
+  platform_thread.GetTaskRunner()->PostTask(
+      [&]() { release_platform_thread.Wait(); });
+
+  bool applied = false;
+  queue.AddChange([&]() { applied = true; });
+  queue.Commit();
+  EXPECT_EQ(queue.GetPendingTransactionCount(), 1u);
+  EXPECT_FALSE(queue.WaitUntilApplied(fml::TimeDelta::FromMilliseconds(1)));
+
+  release_platform_thread.Signal();
+  ASSERT_TRUE(queue.WaitUntilApplied(fml::TimeDelta::FromSeconds(10)));
+  EXPECT_TRUE(applied);
+}
+
+TEST(PlatformViewTransactionQueueTest, CommitOnPlatformThreadAppliesRightAway) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  PlatformViewTransactionQueue queue(
+      fml::MessageLoop::GetCurrent().GetTaskRunner());
+
+  bool applied = false;
+  queue.AddChange([&]() { applied = true; });
+  queue.Commit();
+  EXPECT_TRUE(applied);
+  EXPECT_EQ(queue.GetPendingTransactionCount(), 0u);
+}
+
+TEST(PlatformViewTransactionQueueTest, CancelDropsChanges) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  PlatformViewTransactionQueue queue(
+      fml::MessageLoop::GetCurrent().GetTaskRunner());
+
+  bool applied = false;
+  queue.AddChange([&]() { applied = true; });
+  queue.Cancel();
+  EXPECT_FALSE(queue.HasChanges());
+  queue.Commit();
+  EXPECT_FALSE(applied);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,18 +4,26 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <vector>
 
 #include "flutter/common/constants.h"
+#include "flutter/display_list/display_list_builder.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/raster_cache_atlas.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/core/SkPicture.h"
 #include "third_party/skia/include/core/SkSurface.h"
@@ -42,31 +50,106 @@ void RasterCacheResult::draw(DlCanvas& canvas, const DlPaint* paint) const {
                    DlImageSampling::kNearestNeighbor, paint);
 }
 
+void RasterCacheResult::draw_stale(DlCanvas& canvas,
+                                   const DlPaint* paint) const {
+  flow_.Step();
+  canvas.DrawImageRect(image_, logical_rect_, DlImageSampling::kLinear, paint);
+}
+
 RasterCache::RasterCache(size_t access_threshold,
                          size_t display_list_cache_limit_per_frame)
     : access_threshold_(access_threshold),
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame),
       checkerboard_images_(false) {}
 
-/// @note Procedure doesn't copy all closures.
-std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
-    const RasterCache::Context& context,
+namespace {
+
+// A cache entry whose image lives in a slot of a RasterCacheAtlas page.
+class RasterCacheAtlasResult : public RasterCacheResult {
+ public:
+  RasterCacheAtlasResult(RasterCacheAtlas::Slot slot,
+                         const SkRect& logical_rect,
+                         const char* type)
+      : RasterCacheResult(nullptr, logical_rect, type),
+        slot_(std::move(slot)) {}
+
+  ~RasterCacheAtlasResult() override { slot_.page->ReleaseSlot(); }
+
+  void draw(DlCanvas& canvas, const DlPaint* paint) const override {
+    DlAutoCanvasRestore auto_restore(&canvas, true);
+
+    auto matrix = RasterCacheUtil::GetIntegralTransCTM(canvas.GetTransform());
+    SkRect bounds =
+        RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect_, matrix);
+    FML_DCHECK(std::abs(bounds.width() - slot_.rect.width()) <= 1 &&
+               std::abs(bounds.height() - slot_.rect.height()) <= 1);
+    canvas.TransformReset();
+    flow_.Step();
+    SkRect dst = SkRect::MakeXYWH(bounds.fLeft, bounds.fTop,
+                                  slot_.rect.width(), slot_.rect.height());
+    canvas.DrawImageRect(slot_.page->image(), slot_.rect, dst,
+                         DlImageSampling::kNearestNeighbor, paint, true);
+  }
+
+  void draw_stale(DlCanvas& canvas, const DlPaint* paint) const override {
+    flow_.Step();
+    canvas.DrawImageRect(slot_.page->image(), slot_.rect, logical_rect_,
+                         DlImageSampling::kLinear, paint, true);
+  }
+
+  SkISize image_dimensions() const override { return slot_.rect.size(); }
+
+  // The whole page is held for as long as any of its slots are, so its
+  // bytes are split between the entries that hold them. Together they
+  // account for the page against the byte limit of the cache.
+  int64_t image_bytes() const override {
+    return slot_.page->bytes() /
+           static_cast<int64_t>(slot_.page->held_slot_count());
+  }
+
+ private:
+  RasterCacheAtlas::Slot slot_;
+};
+
+}  // namespace
+
+static void RenderContents(
+    DlCanvas& canvas,
+    const SkMatrix& matrix,
+    const SkRect& logical_rect,
+    bool checkerboard,
     const std::function<void(DlCanvas*)>& draw_function,
-    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
-    const {
-  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+    const std::function<void(DlCanvas*, const SkRect& rect)>&
+        draw_checkerboard) {
+  canvas.Transform(matrix);
+  draw_function(&canvas);
+
+  if (checkerboard) {
+    draw_checkerboard(&canvas, logical_rect);
+  }
+}
+
+static sk_sp<SkImage> RasterizeImage(
+    GrDirectContext* gr_context,
+    const SkColorSpace* dst_color_space,
+    const SkMatrix& ctm,
+    const SkRect& logical_rect,
+    bool checkerboard,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>&
+        draw_checkerboard) {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(ctm);
   SkRect dest_rect =
-      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+      RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect, matrix);
 
   const SkImageInfo image_info =
       SkImageInfo::MakeN32Premul(dest_rect.width(), dest_rect.height(),
-                                 sk_ref_sp(context.dst_color_space));
+                                 sk_ref_sp(dst_color_space));
 
   sk_sp<SkSurface> surface =
-      context.gr_context
-          ? SkSurface::MakeRenderTarget(context.gr_context,
-                                        skgpu::Budgeted::kYes, image_info)
-          : SkSurface::MakeRaster(image_info);
+      gr_context ? SkSurface::MakeRenderTarget(
+                       gr_context, skgpu::Budgeted::kYes, image_info)
+                 : SkSurface::MakeRaster(image_info);
 
   if (!surface) {
     return nullptr;
@@ -75,16 +158,98 @@ std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
   DlSkCanvasAdapter canvas(surface->getCanvas());
   canvas.Clear(DlColor::kTransparent());
   canvas.Translate(-dest_rect.left(), -dest_rect.top());
-  canvas.Transform(matrix);
-  draw_function(&canvas);
+  RenderContents(canvas, matrix, logical_rect, checkerboard, draw_function,
+                 draw_checkerboard);
 
-  if (checkerboard_images_) {
-    draw_checkerboard(&canvas, context.logical_rect);
+  return surface->makeImageSnapshot();
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeIntoAtlas(
+    const RasterCache::Context& context,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  SkISize size = SkISize::Make(dest_rect.width(), dest_rect.height());
+  if (!atlas_->CanHold(size)) {
+    return nullptr;
   }
+  std::optional<RasterCacheAtlas::Slot> slot =
+      atlas_->Allocate(context.gr_context, context.dst_color_space, size);
+  if (!slot.has_value()) {
+    return nullptr;
+  }
+
+  DlSkCanvasAdapter canvas(slot->page->canvas());
+  DlAutoCanvasRestore auto_restore(&canvas, true);
+  canvas.ClipRect(SkRect::Make(slot->rect), DlCanvas::ClipOp::kIntersect,
+                  false);
+  canvas.Clear(DlColor::kTransparent());
+  canvas.Translate(slot->rect.fLeft - dest_rect.left(),
+                   slot->rect.fTop - dest_rect.top());
+  RenderContents(canvas, matrix, context.logical_rect, checkerboard_images_,
+                 draw_function, draw_checkerboard);
 
-  auto image = DlImage::Make(surface->makeImageSnapshot());
-  return std::make_unique<RasterCacheResult>(image, context.logical_rect,
-                                             context.flow_type);
+  return std::make_unique<RasterCacheAtlasResult>(
+      std::move(slot.value()), context.logical_rect, context.flow_type);
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::RasterizeDisplayList(
+    const RasterCache::Context& context,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  SkISize size = SkISize::Make(dest_rect.width(), dest_rect.height());
+  if (size.isEmpty()) {
+    return nullptr;
+  }
+
+  DisplayListBuilder builder(SkRect::Make(size));
+  builder.Clear(DlColor::kTransparent());
+  builder.Translate(-dest_rect.left(), -dest_rect.top());
+  RenderContents(builder, matrix, context.logical_rect, checkerboard_images_,
+                 draw_function, draw_checkerboard);
+
+  sk_sp<DlImage> image = display_list_rasterizer_(builder.Build(), size);
+  // The rasterizer may scale down images that are too large for it, which
+  // can't be drawn in place of the contents.
+  if (!image || image->dimensions() != size) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(
+      std::move(image), context.logical_rect, context.flow_type);
+}
+
+/// @note Procedure doesn't copy all closures.
+std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
+    const RasterCache::Context& context,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>& draw_checkerboard)
+    const {
+  if (display_list_rasterizer_) {
+    return RasterizeDisplayList(context, draw_function, draw_checkerboard);
+  }
+  if (atlas_) {
+    std::unique_ptr<RasterCacheResult> result =
+        RasterizeIntoAtlas(context, draw_function, draw_checkerboard);
+    if (result) {
+      return result;
+    }
+  }
+  sk_sp<SkImage> image = RasterizeImage(
+      context.gr_context, context.dst_color_space, context.matrix,
+      context.logical_rect, checkerboard_images_, draw_function,
+      draw_checkerboard);
+  if (!image) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(
+      DlImage::Make(std::move(image)), context.logical_rect, context.flow_type);
 }
 
 bool RasterCache::UpdateCacheEntry(
@@ -95,7 +260,18 @@ bool RasterCache::UpdateCacheEntry(
   Entry& entry = cache_[key];
   if (!entry.image) {
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
-    entry.image = Rasterize(raster_cache_context, render_function, func);
+    std::optional<uint64_t> disk_key = GetDiskStoreKey(raster_cache_context);
+    fml::TimePoint start = fml::TimePoint::Now();
+    if (disk_key.has_value()) {
+      entry.image = LoadFromDiskStore(disk_key.value(), raster_cache_context);
+    }
+    if (!entry.image) {
+      entry.image = Rasterize(raster_cache_context, render_function, func);
+      if (entry.image && disk_key.has_value()) {
+        WriteToDiskStore(disk_key.value(), raster_cache_context);
+      }
+    }
+    entry.raster_time = fml::TimePoint::Now() - start;
     if (entry.image != nullptr) {
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
@@ -111,13 +287,199 @@ bool RasterCache::UpdateCacheEntry(
   return entry.image != nullptr;
 }
 
+void RasterCache::EnableAtlasing(int page_size, int max_entry_size) {
+  atlas_ = std::make_unique<RasterCacheAtlas>(page_size, max_entry_size);
+}
+
+void RasterCache::EnableDiskStore(
+    std::shared_ptr<RasterCacheDiskStore> disk_store,
+    fml::RefPtr<fml::TaskRunner> worker_task_runner) {
+  FML_DCHECK(disk_store);
+  FML_DCHECK(worker_task_runner);
+  disk_store_ = std::move(disk_store);
+  disk_store_task_runner_ = std::move(worker_task_runner);
+}
+
+std::optional<uint64_t> RasterCache::GetDiskStoreKey(
+    const RasterCache::Context& context) const {
+  // Checkerboarded images are a debugging aid and are not worth keeping.
+  if (!disk_store_ || !context.display_list || checkerboard_images_ ||
+      display_list_rasterizer_) {
+    return std::nullopt;
+  }
+  return RasterCacheDiskStore::ComputeKey(*context.display_list,
+                                          context.matrix,
+                                          context.dst_color_space);
+}
+
+std::unique_ptr<RasterCacheResult> RasterCache::LoadFromDiskStore(
+    uint64_t disk_key,
+    const RasterCache::Context& context) const {
+  std::optional<RasterCacheDiskStore::Image> stored =
+      disk_store_->Load(disk_key);
+  if (!stored.has_value()) {
+    return nullptr;
+  }
+
+  // The bounds of the DisplayList are not part of the key, so an image of
+  // the wrong size would mean that it was stored for different content.
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  if (stored->dimensions !=
+      SkISize::Make(dest_rect.width(), dest_rect.height())) {
+    return nullptr;
+  }
+
+  TRACE_EVENT0("flutter", "RasterCache::DecodeFromDiskStore");
+  sk_sp<SkImage> image = SkImage::MakeFromEncoded(std::move(stored->encoded));
+  if (image) {
+    image = image->makeRasterImage();
+  }
+  if (image && context.gr_context) {
+    image = image->makeTextureImage(context.gr_context);
+  }
+  if (!image || image->dimensions() != stored->dimensions) {
+    return nullptr;
+  }
+  return std::make_unique<RasterCacheResult>(
+      DlImage::Make(std::move(image)), context.logical_rect, context.flow_type);
+}
+
+void RasterCache::WriteToDiskStore(uint64_t disk_key,
+                                   const RasterCache::Context& context) const {
+  if (disk_store_->Contains(disk_key)) {
+    return;
+  }
+  // Reading back the image that was just rendered would stall the raster
+  // thread on the GPU, so the worker renders it again in CPU memory.
+  disk_store_task_runner_->PostTask(
+      [disk_store = disk_store_, disk_key,
+       display_list = context.display_list,
+       color_space = sk_ref_sp(context.dst_color_space),
+       matrix = context.matrix, logical_rect = context.logical_rect]() {
+        TRACE_EVENT0("flutter", "RasterCache::WriteToDiskStore");
+        sk_sp<SkImage> image = RasterizeImage(
+            nullptr, color_space.get(), matrix, logical_rect, false,
+            [&display_list](DlCanvas* canvas) {
+              canvas->DrawDisplayList(display_list);
+            },
+            DrawCheckerboard);
+        if (!image) {
+          return;
+        }
+        sk_sp<SkData> encoded =
+            image->encodeToData(SkEncodedImageFormat::kPNG, 0);
+        if (!encoded) {
+          return;
+        }
+        disk_store->Store(disk_key, {image->dimensions(), std::move(encoded)});
+      });
+}
+
+void RasterCache::EnableAsyncGeneration(
+    fml::RefPtr<fml::TaskRunner> task_runner,
+    AsyncImageUploader uploader) {
+  FML_DCHECK(task_runner);
+  FML_DCHECK(uploader);
+  async_task_runner_ = std::move(task_runner);
+  async_uploader_ = std::move(uploader);
+  async_results_ = std::make_shared<AsyncResults>();
+}
+
+bool RasterCache::UpdateCacheEntryAsync(
+    const RasterCacheKeyID& id,
+    const Context& raster_cache_context,
+    std::function<void(DlCanvas*)> render_function) const {
+  FML_DCHECK(async_generation_enabled());
+  RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
+  Entry& entry = cache_[key];
+  if (entry.image || entry.generating) {
+    return entry.image != nullptr;
+  }
+  if (id.type() == RasterCacheKeyType::kDisplayList) {
+    display_list_cached_this_frame_++;
+  }
+  std::optional<uint64_t> disk_key = GetDiskStoreKey(raster_cache_context);
+  if (disk_key.has_value()) {
+    entry.image = LoadFromDiskStore(disk_key.value(), raster_cache_context);
+    if (entry.image) {
+      return true;
+    }
+    if (disk_store_->Contains(disk_key.value())) {
+      disk_key.reset();
+    }
+  }
+  entry.generating = true;
+  async_task_runner_->PostTask(
+      [results = async_results_, uploader = async_uploader_, key,
+       disk_store = disk_key.has_value() ? disk_store_ : nullptr, disk_key,
+       render_function = std::move(render_function),
+       color_space = sk_ref_sp(raster_cache_context.dst_color_space),
+       matrix = raster_cache_context.matrix,
+       logical_rect = raster_cache_context.logical_rect,
+       flow_type = raster_cache_context.flow_type,
+       checkerboard = checkerboard_images_]() {
+        TRACE_EVENT0("flutter", "RasterCache::GenerateAsync");
+        fml::TimePoint start = fml::TimePoint::Now();
+        sk_sp<SkImage> image =
+            RasterizeImage(nullptr, color_space.get(), matrix, logical_rect,
+                           checkerboard, render_function, DrawCheckerboard);
+        // The image is already in CPU memory, so it is encoded here rather
+        // than rendered again by the disk store worker.
+        if (image && disk_store) {
+          sk_sp<SkData> encoded =
+              image->encodeToData(SkEncodedImageFormat::kPNG, 0);
+          if (encoded) {
+            disk_store->Store(disk_key.value(),
+                              {image->dimensions(), std::move(encoded)});
+          }
+        }
+        sk_sp<DlImage> uploaded = image ? uploader(std::move(image)) : nullptr;
+        fml::TimeDelta raster_time = fml::TimePoint::Now() - start;
+
+        std::scoped_lock lock(results->mutex);
+        results->results.push_back(
+            {key,
+             uploaded ? std::make_unique<RasterCacheResult>(
+                            std::move(uploaded), logical_rect, flow_type)
+                      : nullptr,
+             raster_time});
+      });
+  return false;
+}
+
+void RasterCache::CollectAsyncResults() {
+  if (!async_results_) {
+    return;
+  }
+  std::vector<AsyncResult> results;
+  {
+    std::scoped_lock lock(async_results_->mutex);
+    results.swap(async_results_->results);
+  }
+  for (auto& result : results) {
+    auto it = cache_.find(result.key);
+    // The entry may have been evicted while its image was being generated.
+    if (it == cache_.end() || !it->second.generating) {
+      continue;
+    }
+    Entry& entry = it->second;
+    entry.generating = false;
+    entry.image = std::move(result.image);
+    entry.raster_time = result.raster_time;
+  }
+}
+
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
                                              const SkMatrix& matrix,
                                              bool visible) const {
   RasterCacheKey key = RasterCacheKey(id, matrix);
+  std::scoped_lock lock(mark_seen_mutex_);
   Entry& entry = cache_[key];
   entry.encountered_this_frame = true;
   entry.visible_this_frame = visible;
+  entry.unused_frames = 0;
   if (visible || entry.accesses_since_visible > 0) {
     entry.accesses_since_visible++;
   }
@@ -146,35 +508,80 @@ bool RasterCache::HasEntry(const RasterCacheKeyID& id,
 bool RasterCache::Draw(const RasterCacheKeyID& id,
                        DlCanvas& canvas,
                        const DlPaint* paint) const {
-  auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
-  if (it == cache_.end()) {
-    return false;
+  RasterCacheKey key(id, canvas.GetTransform());
+  auto it = cache_.find(key);
+  if (it != cache_.end() && it->second.image) {
+    Entry& entry = it->second;
+    entry.image->draw(canvas, paint);
+    entry.draw_count++;
+    return true;
   }
 
-  Entry& entry = it->second;
+  return serve_stale_entries_ && DrawStale(key, canvas, paint);
+}
 
-  if (entry.image) {
-    entry.image->draw(canvas, paint);
-    return true;
+bool RasterCache::DrawStale(const RasterCacheKey& key,
+                            DlCanvas& canvas,
+                            const DlPaint* paint) const {
+  const SkMatrix& matrix = key.matrix();
+  if (!matrix.isScaleTranslate()) {
+    return false;
   }
 
-  return false;
+  // Entries are hashed by their id alone, so all of the entries for the id
+  // are in the same bucket.
+  Entry* best = nullptr;
+  SkScalar best_difference = 0;
+  size_t bucket = cache_.bucket(key);
+  for (auto it = cache_.begin(bucket); it != cache_.end(bucket); ++it) {
+    const SkMatrix& entry_matrix = it->first.matrix();
+    if (it->first.id() != key.id() || !it->second.image ||
+        !entry_matrix.isScaleTranslate()) {
+      continue;
+    }
+    SkScalar scale_x = matrix.getScaleX() / entry_matrix.getScaleX();
+    SkScalar scale_y = matrix.getScaleY() / entry_matrix.getScaleY();
+    if (scale_x < 0.5f || scale_x > 2.0f || scale_y < 0.5f || scale_y > 2.0f) {
+      continue;
+    }
+    SkScalar difference =
+        std::abs(std::log(scale_x)) + std::abs(std::log(scale_y));
+    if (!best || difference < best_difference) {
+      best = &it->second;
+      best_difference = difference;
+    }
+  }
+  if (!best) {
+    return false;
+  }
+
+  best->image->draw_stale(canvas, paint);
+  best->draw_count++;
+  return true;
 }
 
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
+  CollectAsyncResults();
 }
 
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
+    FML_DCHECK(entry.encountered_this_frame || entry.unused_frames > 0);
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
     if (entry.image) {
-      RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
+    } else if (entry.encountered_this_frame) {
+      metrics.uncached_count++;
     }
     entry.encountered_this_frame = false;
   }
@@ -185,7 +592,16 @@ void RasterCache::EvictUnusedCacheEntries() {
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (entry.encountered_this_frame) {
+      continue;
+    }
+    if (!entry.image) {
+      dead.push_back(it);
+      continue;
+    }
+    // Stale entries are kept for as long as they are served.
+    if (++entry.unused_frames > eviction_policy_.max_unused_frames &&
+        !serve_stale_entries_) {
       dead.push_back(it);
     }
   }
@@ -198,6 +614,52 @@ void RasterCache::EvictUnusedCacheEntries() {
     }
     cache_.erase(it);
   }
+
+  EvictOverByteLimit();
+}
+
+void RasterCache::EvictOverByteLimit() {
+  if (eviction_policy_.byte_limit == 0) {
+    return;
+  }
+
+  size_t total_bytes = 0;
+  std::vector<RasterCacheKey::Map<Entry>::iterator> unused;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    Entry& entry = it->second;
+    if (entry.image) {
+      total_bytes += entry.image->image_bytes();
+      if (!entry.encountered_this_frame) {
+        unused.push_back(it);
+      }
+    }
+  }
+  if (total_bytes <= eviction_policy_.byte_limit) {
+    return;
+  }
+
+  std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) {
+    return a->second.ValuePerByte() < b->second.ValuePerByte();
+  });
+  for (auto it : unused) {
+    if (total_bytes <= eviction_policy_.byte_limit) {
+      break;
+    }
+    size_t bytes = it->second.image->image_bytes();
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += bytes;
+    total_bytes -= bytes;
+    cache_.erase(it);
+  }
+}
+
+double RasterCache::Entry::ValuePerByte() const {
+  int64_t bytes = image ? image->image_bytes() : 0;
+  if (bytes <= 0) {
+    return 0.0;
+  }
+  return raster_time.ToMicrosecondsF() * (draw_count + 1) / bytes;
 }
 
 void RasterCache::EndFrame() {
@@ -207,6 +669,9 @@ void RasterCache::EndFrame() {
 
 void RasterCache::Clear() {
   cache_.clear();
+  if (atlas_) {
+    atlas_->Clear();
+  }
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -5,14 +5,22 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/raster_cache_atlas.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/flow/raster_cache_key.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/trace_event.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkRect.h"
@@ -35,6 +43,12 @@ class RasterCacheResult {
 
   virtual void draw(DlCanvas& canvas, const DlPaint* paint) const;
 
+  // Draws the image into the logical rect of the entry under the current
+  // transform of the canvas, which may differ from the transform that the
+  // image was rendered for. The image is filtered rather than drawn pixel
+  // for pixel, so it looks softer than an image rendered for the transform.
+  virtual void draw_stale(DlCanvas& canvas, const DlPaint* paint) const;
+
   virtual SkISize image_dimensions() const {
     return image_ ? image_->dimensions() : SkISize::Make(0, 0);
   };
@@ -43,7 +57,7 @@ class RasterCacheResult {
     return image_ ? image_->GetApproximateByteSize() : 0;
   };
 
- private:
+ protected:
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
   fml::tracing::TraceFlow flow_;
@@ -75,15 +89,60 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were not used in this frame
+   * but were kept alive by the |RasterCacheEvictionPolicy|.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images that were not used in this frame but were
+   * kept alive by the |RasterCacheEvictionPolicy|.
+   */
+  size_t retained_bytes = 0;
+
+  /**
+   * The number of cache entries encountered in this frame that had no image
+   * yet, so their content was rendered instead.
+   */
+  size_t uncached_count = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
+};
+
+/**
+ * Controls how long the RasterCache holds on to images that are not used.
+ *
+ * The default policy evicts every entry that is not encountered in a frame,
+ * which makes content that leaves the screen for a single frame (such as
+ * the items of a scrolling list) be rasterized again when it returns.
+ */
+struct RasterCacheEvictionPolicy {
+  /**
+   * The number of consecutive frames in which an entry with an image may go
+   * unused before it is evicted. Entries without an image are always evicted
+   * in the first frame that does not encounter them.
+   */
+  size_t max_unused_frames = 0;
+
+  /**
+   * The maximum number of bytes of cached images, or 0 for no limit.
+   *
+   * When the limit is exceeded, the unused entries are evicted in order of
+   * increasing value until the cache fits, where the value of an entry is
+   * the time it took to rasterize, multiplied by the number of times it was
+   * drawn, per byte of its image. Entries used in the current frame are never
+   * evicted, so the limit can be exceeded by the images of a single frame.
+   */
+  size_t byte_limit = 0;
 };
 
 /**
@@ -109,6 +168,16 @@ struct RasterCacheMetrics {
  *       `RasterCache::Draw` will be used to draw those cache images.
  *   - RasterCache::EndFrame:
  *       Computes used counts and memory then reports cache metrics.
+ *
+ * When async generation is enabled with |EnableAsyncGeneration|, the images
+ * of DisplayList entries are rendered on another thread instead. They are
+ * picked up by the |RasterCache::BeginFrame| that follows their completion
+ * and the DisplayLists are drawn directly until then.
+ *
+ * When a disk store is enabled with |EnableDiskStore|, the images of
+ * DisplayList entries are also written to disk and the images of new entries
+ * are looked up there before they are rendered, so that they survive
+ * application restarts.
  */
 class RasterCache {
  public:
@@ -118,12 +187,24 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // The DisplayList that the entry renders, if any, used to key the
+    // entry in the disk store.
+    sk_sp<DisplayList> display_list = nullptr;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
     const bool has_image;
   };
 
+  // Turns an image rendered into CPU memory by async generation into the
+  // image that will be drawn on the raster thread, typically by uploading it
+  // with a context that shares resources with the raster thread's context.
+  // Called on the async generation task runner.
+  using AsyncImageUploader = std::function<sk_sp<DlImage>(sk_sp<SkImage>)>;
+
+  using DisplayListRasterizer =
+      std::function<sk_sp<DlImage>(sk_sp<DisplayList>, const SkISize&)>;
+
   std::unique_ptr<RasterCacheResult> Rasterize(
       const RasterCache::Context& context,
       const std::function<void(DlCanvas*)>& draw_function,
@@ -158,6 +239,26 @@ class RasterCache {
 
   void SetCheckboardCacheImages(bool checkerboard);
 
+  // While set, entries with images are kept even when they are not used,
+  // and an entry rendered at a different scale is drawn when there is no
+  // entry for the current transform. This avoids rendering content again
+  // while it is animated, at the cost of sharpness.
+  //
+  // See |RasterQualityPolicy|.
+  void SetServeStaleEntries(bool serve_stale) {
+    serve_stale_entries_ = serve_stale;
+  }
+
+  bool serves_stale_entries() const { return serve_stale_entries_; }
+
+  void SetEvictionPolicy(const RasterCacheEvictionPolicy& policy) {
+    eviction_policy_ = policy;
+  }
+
+  const RasterCacheEvictionPolicy& eviction_policy() const {
+    return eviction_policy_;
+  }
+
   const RasterCacheMetrics& picture_metrics() const { return picture_metrics_; }
   const RasterCacheMetrics& layer_metrics() const { return layer_metrics_; }
 
@@ -222,6 +323,9 @@ class RasterCache {
    * increased if it is visible, or if it was ever visible.
    * @return the number of times the entry has been hit since it was created.
    * For a new entry that will be 1 if it is visible, or zero if non-visible.
+   *
+   * This may be called concurrently from the subtrees that are prerolled
+   * in parallel, see |PrerollContext::concurrent_task_runner|.
    */
   CacheInfo MarkSeen(const RasterCacheKeyID& id,
                      const SkMatrix& matrix,
@@ -238,16 +342,140 @@ class RasterCache {
       const Context& raster_cache_context,
       const std::function<void(DlCanvas*)>& render_function) const;
 
+  /**
+   * @brief Renders the images of DisplayList entries on |task_runner|
+   * rather than in the frame that decides to cache them.
+   *
+   * The rendering is performed in CPU memory and then passed to |uploader|
+   * on the same task runner.
+   */
+  void EnableAsyncGeneration(fml::RefPtr<fml::TaskRunner> task_runner,
+                             AsyncImageUploader uploader);
+
+  /**
+   * @brief Packs the images of entries that are no larger than
+   * |max_entry_size| in either dimension into shared |page_size| square
+   * textures, saving a texture and a texture bind for each of them.
+   */
+  void EnableAtlasing(int page_size = 1024, int max_entry_size = 128);
+
+  bool atlasing_enabled() const { return atlas_ != nullptr; }
+
+  /**
+   * @brief Keeps the images of DisplayList entries in |disk_store| across
+   * application restarts.
+   *
+   * Images found in the store are decoded on the raster thread in place of
+   * rendering them. New images are encoded and written to the store on
+   * |worker_task_runner|.
+   */
+  void EnableDiskStore(std::shared_ptr<RasterCacheDiskStore> disk_store,
+                       fml::RefPtr<fml::TaskRunner> worker_task_runner);
+
+  bool disk_store_enabled() const { return disk_store_ != nullptr; }
+
+  bool async_generation_enabled() const {
+    return async_task_runner_ != nullptr && !display_list_rasterizer_;
+  }
+
+  /**
+   * @brief Renders the images of entries with |rasterizer| rather than into
+   * Skia surfaces, for backends such as Impeller that render textures of
+   * their own. The contents of an entry are recorded into a DisplayList that
+   * is passed to |rasterizer| along with the size of the image to render.
+   *
+   * Atlasing, the disk store and async generation are not used while a
+   * rasterizer is set, since they render and decode images with Skia.
+   * Passing nullptr restores rendering with Skia.
+   */
+  void SetDisplayListRasterizer(DisplayListRasterizer rasterizer) {
+    display_list_rasterizer_ = std::move(rasterizer);
+  }
+
+  /**
+   * @brief Requests the image of the entry to be rendered with async
+   * generation, which must be enabled.
+   *
+   * The |render_function| is invoked on the async generation task runner
+   * and so must only capture objects that are safe to use from that thread,
+   * such as a DisplayList.
+   *
+   * @return true if the entry already has an image and false while it is
+   * pending, in which case the caller should draw the content directly.
+   */
+  bool UpdateCacheEntryAsync(
+      const RasterCacheKeyID& id,
+      const Context& raster_cache_context,
+      std::function<void(DlCanvas*)> render_function) const;
+
  private:
   struct Entry {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    size_t unused_frames = 0;
+    size_t draw_count = 0;
+    bool generating = false;
+    fml::TimeDelta raster_time;
     std::unique_ptr<RasterCacheResult> image;
+
+    // The raster time saved per byte of image each time the entry is drawn,
+    // used to order entries for eviction when over the byte limit.
+    double ValuePerByte() const;
   };
 
+  // The images completed by async generation, waiting to be swapped into
+  // their entries. Shared with the generation tasks, which may outlive the
+  // cache.
+  struct AsyncResult {
+    RasterCacheKey key;
+    std::unique_ptr<RasterCacheResult> image;
+    fml::TimeDelta raster_time;
+  };
+  struct AsyncResults {
+    std::mutex mutex;
+    std::vector<AsyncResult> results;
+  };
+
+  std::unique_ptr<RasterCacheResult> RasterizeDisplayList(
+      const RasterCache::Context& context,
+      const std::function<void(DlCanvas*)>& draw_function,
+      const std::function<void(DlCanvas*, const SkRect& rect)>&
+          draw_checkerboard) const;
+
+  std::unique_ptr<RasterCacheResult> RasterizeIntoAtlas(
+      const RasterCache::Context& context,
+      const std::function<void(DlCanvas*)>& draw_function,
+      const std::function<void(DlCanvas*, const SkRect& rect)>&
+          draw_checkerboard) const;
+
+  // Returns the key of the entry in the disk store, or an empty optional if
+  // the entry should not be stored.
+  std::optional<uint64_t> GetDiskStoreKey(
+      const RasterCache::Context& context) const;
+
+  // Returns the image stored for the entry in the disk store, if any.
+  std::unique_ptr<RasterCacheResult> LoadFromDiskStore(
+      uint64_t disk_key,
+      const RasterCache::Context& context) const;
+
+  // Renders the DisplayList of the entry again in CPU memory on the disk
+  // store worker, and writes the encoded image into the disk store.
+  void WriteToDiskStore(uint64_t disk_key,
+                        const RasterCache::Context& context) const;
+
   void UpdateMetrics();
 
+  // Draws the entry for |key| that was rendered at the scale closest to
+  // that of its matrix, if there is one within a factor of 2.
+  bool DrawStale(const RasterCacheKey& key,
+                 DlCanvas& canvas,
+                 const DlPaint* paint) const;
+
+  void EvictOverByteLimit();
+
+  void CollectAsyncResults();
+
   RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
 
   const size_t access_threshold_;
@@ -256,7 +484,19 @@ class RasterCache {
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
+  // Guards |cache_| in |MarkSeen|, the only method that is called during
+  // Preroll.
+  mutable std::mutex mark_seen_mutex_;
   bool checkerboard_images_;
+  bool serve_stale_entries_ = false;
+  RasterCacheEvictionPolicy eviction_policy_;
+  std::unique_ptr<RasterCacheAtlas> atlas_;
+  fml::RefPtr<fml::TaskRunner> async_task_runner_;
+  AsyncImageUploader async_uploader_;
+  std::shared_ptr<AsyncResults> async_results_;
+  std::shared_ptr<RasterCacheDiskStore> disk_store_;
+  fml::RefPtr<fml::TaskRunner> disk_store_task_runner_;
+  DisplayListRasterizer display_list_rasterizer_;
 
   void TraceStatsToTimeline() const;
 
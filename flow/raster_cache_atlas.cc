@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+
+namespace flutter {
+
+RasterCacheAtlas::Page::Page(sk_sp<SkSurface> surface, int size)
+    : surface_(std::move(surface)), size_(size) {}
+
+SkCanvas* RasterCacheAtlas::Page::canvas() {
+  // The caller is about to render into the page.
+  image_.reset();
+  return surface_->getCanvas();
+}
+
+const sk_sp<DlImage>& RasterCacheAtlas::Page::image() {
+  if (!image_) {
+    image_ = DlImage::Make(surface_->makeImageSnapshot());
+  }
+  return image_;
+}
+
+int64_t RasterCacheAtlas::Page::bytes() const {
+  return static_cast<int64_t>(size_) * size_ *
+         SkColorTypeBytesPerPixel(kN32_SkColorType);
+}
+
+void RasterCacheAtlas::Page::ReleaseSlot() {
+  FML_DCHECK(held_slot_count_ > 0);
+  held_slot_count_--;
+}
+
+std::optional<SkIRect> RasterCacheAtlas::Page::Allocate(const SkISize& size) {
+  const int width = size.width() + kSlotPadding;
+  const int height = size.height() + kSlotPadding;
+
+  // Use the shortest shelf that the slot fits on to limit the space wasted
+  // above the slot.
+  Shelf* best = nullptr;
+  for (Shelf& shelf : shelves_) {
+    if (shelf.height >= height && shelf.x + width <= size_ &&
+        (!best || shelf.height < best->height)) {
+      best = &shelf;
+    }
+  }
+  if (!best) {
+    if (next_shelf_y_ + height > size_ || width > size_) {
+      return std::nullopt;
+    }
+    shelves_.push_back({next_shelf_y_, height, 0});
+    next_shelf_y_ += height;
+    best = &shelves_.back();
+  }
+
+  SkIRect rect = SkIRect::MakeXYWH(best->x, best->y, size.width(),  //
+                                   size.height());
+  best->x += width;
+  held_slot_count_++;
+  return rect;
+}
+
+RasterCacheAtlas::RasterCacheAtlas(int page_size, int max_entry_size)
+    : page_size_(page_size), max_entry_size_(max_entry_size) {
+  FML_DCHECK(max_entry_size_ + kSlotPadding <= page_size_);
+}
+
+bool RasterCacheAtlas::CanHold(const SkISize& size) const {
+  return !size.isEmpty() && size.width() <= max_entry_size_ &&
+         size.height() <= max_entry_size_;
+}
+
+std::optional<RasterCacheAtlas::Slot> RasterCacheAtlas::Allocate(
+    GrDirectContext* gr_context,
+    const SkColorSpace* color_space,
+    const SkISize& size) {
+  if (!CanHold(size)) {
+    return std::nullopt;
+  }
+
+  // The pages can only be drawn to the context and in the color space that
+  // they were created for.
+  if (gr_context != gr_context_ ||
+      !SkColorSpace::Equals(color_space, color_space_.get())) {
+    Clear();
+    gr_context_ = gr_context;
+    color_space_ = sk_ref_sp(color_space);
+  }
+
+  pages_.erase(std::remove_if(pages_.begin(), pages_.end(),
+                              [](const std::weak_ptr<Page>& page) {
+                                return page.expired();
+                              }),
+               pages_.end());
+
+  for (auto& weak_page : pages_) {
+    std::shared_ptr<Page> page = weak_page.lock();
+    std::optional<SkIRect> rect = page->Allocate(size);
+    if (rect.has_value()) {
+      return Slot{std::move(page), rect.value()};
+    }
+  }
+
+  const SkImageInfo image_info =
+      SkImageInfo::MakeN32Premul(page_size_, page_size_, color_space_);
+  sk_sp<SkSurface> surface =
+      gr_context_ ? SkSurface::MakeRenderTarget(
+                        gr_context_, skgpu::Budgeted::kYes, image_info)
+                  : SkSurface::MakeRaster(image_info);
+  if (!surface) {
+    return std::nullopt;
+  }
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+
+  std::shared_ptr<Page> page(new Page(std::move(surface), page_size_));
+  std::optional<SkIRect> rect = page->Allocate(size);
+  FML_DCHECK(rect.has_value());
+  pages_.push_back(page);
+  return Slot{std::move(page), rect.value()};
+}
+
+size_t RasterCacheAtlas::page_count() const {
+  return std::count_if(
+      pages_.begin(), pages_.end(),
+      [](const std::weak_ptr<Page>& page) { return !page.expired(); });
+}
+
+void RasterCacheAtlas::Clear() {
+  pages_.clear();
+}
+
+}  // namespace flutter
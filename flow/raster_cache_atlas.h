@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+#define FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+class GrDirectContext;
+
+namespace flutter {
+
+/**
+ * Packs the images of small raster cache entries into shared pages so that
+ * they do not each need a texture of their own.
+ *
+ * Each page is a surface that is divided into horizontal shelves, and the
+ * slots on a shelf are allocated from left to right. The space of a slot is
+ * not reused when the entry holding it is evicted, instead a page is
+ * released as a whole once none of its slots are held any longer.
+ */
+class RasterCacheAtlas {
+ public:
+  class Page {
+   public:
+    // Returns the canvas used to render into the slots of this page.
+    SkCanvas* canvas();
+
+    // Returns an image of the current contents of the page.
+    const sk_sp<DlImage>& image();
+
+    int size() const { return size_; }
+
+    // The bytes of the pixels of the page.
+    int64_t bytes() const;
+
+    // The number of slots allocated from the page that are still held.
+    size_t held_slot_count() const { return held_slot_count_; }
+
+    // Called when the entry holding a slot of the page releases it.
+    void ReleaseSlot();
+
+   private:
+    struct Shelf {
+      int y;
+      int height;
+      int x;
+    };
+
+    Page(sk_sp<SkSurface> surface, int size);
+
+    std::optional<SkIRect> Allocate(const SkISize& size);
+
+    const sk_sp<SkSurface> surface_;
+    const int size_;
+    std::vector<Shelf> shelves_;
+    int next_shelf_y_ = 0;
+    size_t held_slot_count_ = 0;
+    sk_sp<DlImage> image_;
+
+    friend class RasterCacheAtlas;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Page);
+  };
+
+  struct Slot {
+    std::shared_ptr<Page> page;
+    SkIRect rect;
+  };
+
+  // The space left between slots so that sampling at the edge of one slot
+  // can never read from its neighbors.
+  static constexpr int kSlotPadding = 1;
+
+  RasterCacheAtlas(int page_size, int max_entry_size);
+
+  int page_size() const { return page_size_; }
+  int max_entry_size() const { return max_entry_size_; }
+
+  // Returns true if entries of the given size are small enough to be placed
+  // in the atlas.
+  bool CanHold(const SkISize& size) const;
+
+  // Finds space for an entry of the given size in one of the pages that are
+  // held, or in a new page rendered with |gr_context| or in CPU memory if it
+  // is null. Returns an empty optional if the size cannot be held or no
+  // surface could be created for a new page.
+  std::optional<Slot> Allocate(GrDirectContext* gr_context,
+                               const SkColorSpace* color_space,
+                               const SkISize& size);
+
+  // The number of pages that are still held by the slots allocated from
+  // them.
+  size_t page_count() const;
+
+  // Forgets all of the pages. Pages that are still held by slots are only
+  // released when those slots are.
+  void Clear();
+
+ private:
+  const int page_size_;
+  const int max_entry_size_;
+  GrDirectContext* gr_context_ = nullptr;
+  sk_sp<SkColorSpace> color_space_;
+  std::vector<std::weak_ptr<Page>> pages_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlas);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
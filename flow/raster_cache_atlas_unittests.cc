@@ -0,0 +1,95 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(RasterCacheAtlas, CanHoldOnlySmallEntries) {
+  RasterCacheAtlas atlas(256, 64);
+  EXPECT_TRUE(atlas.CanHold(SkISize::Make(64, 64)));
+  EXPECT_TRUE(atlas.CanHold(SkISize::Make(1, 10)));
+  EXPECT_FALSE(atlas.CanHold(SkISize::Make(65, 10)));
+  EXPECT_FALSE(atlas.CanHold(SkISize::Make(10, 65)));
+  EXPECT_FALSE(atlas.CanHold(SkISize::Make(0, 10)));
+
+  EXPECT_FALSE(
+      atlas.Allocate(nullptr, nullptr, SkISize::Make(65, 65)).has_value());
+  EXPECT_EQ(atlas.page_count(), 0u);
+}
+
+TEST(RasterCacheAtlas, SlotsDoNotOverlap) {
+  RasterCacheAtlas atlas(256, 64);
+  std::vector<RasterCacheAtlas::Slot> slots;
+  const SkISize sizes[] = {{64, 64}, {20, 30}, {30, 20}, {64, 10},
+                           {10, 64}, {50, 50}, {1, 1},   {33, 17}};
+  for (const SkISize& size : sizes) {
+    auto slot = atlas.Allocate(nullptr, nullptr, size);
+    ASSERT_TRUE(slot.has_value());
+    EXPECT_EQ(slot->rect.size(), size);
+    EXPECT_TRUE(SkIRect::MakeWH(256, 256).contains(slot->rect));
+    slots.push_back(slot.value());
+  }
+  EXPECT_EQ(atlas.page_count(), 1u);
+
+  for (size_t i = 0; i < slots.size(); i++) {
+    SkIRect padded = slots[i].rect.makeOutset(
+        RasterCacheAtlas::kSlotPadding, RasterCacheAtlas::kSlotPadding);
+    for (size_t j = i + 1; j < slots.size(); j++) {
+      EXPECT_FALSE(SkIRect::Intersects(padded, slots[j].rect))
+          << "slot " << i << " overlaps slot " << j;
+    }
+  }
+}
+
+TEST(RasterCacheAtlas, FullPageStartsNewPage) {
+  RasterCacheAtlas atlas(128, 63);
+  std::vector<RasterCacheAtlas::Slot> slots;
+  // Four padded 63x63 entries fill a 128x128 page.
+  for (int i = 0; i < 4; i++) {
+    auto slot = atlas.Allocate(nullptr, nullptr, SkISize::Make(63, 63));
+    ASSERT_TRUE(slot.has_value());
+    slots.push_back(slot.value());
+  }
+  EXPECT_EQ(atlas.page_count(), 1u);
+
+  auto slot = atlas.Allocate(nullptr, nullptr, SkISize::Make(63, 63));
+  ASSERT_TRUE(slot.has_value());
+  EXPECT_NE(slot->page, slots[0].page);
+  EXPECT_EQ(atlas.page_count(), 2u);
+}
+
+TEST(RasterCacheAtlas, PageIsReleasedWithItsSlots) {
+  RasterCacheAtlas atlas(256, 64);
+  {
+    auto slot1 = atlas.Allocate(nullptr, nullptr, SkISize::Make(10, 10));
+    auto slot2 = atlas.Allocate(nullptr, nullptr, SkISize::Make(10, 10));
+    ASSERT_TRUE(slot1.has_value());
+    ASSERT_TRUE(slot2.has_value());
+    EXPECT_EQ(slot1->page, slot2->page);
+    EXPECT_EQ(atlas.page_count(), 1u);
+  }
+  EXPECT_EQ(atlas.page_count(), 0u);
+}
+
+TEST(RasterCacheAtlas, PageImageReflectsRendering) {
+  RasterCacheAtlas atlas(64, 32);
+  auto slot = atlas.Allocate(nullptr, nullptr, SkISize::Make(10, 10));
+  ASSERT_TRUE(slot.has_value());
+  auto image = slot->page->image();
+  ASSERT_NE(image, nullptr);
+  EXPECT_EQ(image->dimensions(), SkISize::Make(64, 64));
+  // The same image is returned until the page is rendered to again.
+  EXPECT_EQ(slot->page->image(), image);
+  slot->page->canvas();
+  EXPECT_NE(slot->page->image(), image);
+}
+
+}  // namespace testing
+}  // namespace flutter
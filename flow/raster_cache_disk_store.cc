@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_disk_store.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "flutter/display_list/display_list_serialization.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// A 64 bit FNV-1a hash, which unlike std::hash is stable across platforms
+// and standard library versions.
+class StableHash {
+ public:
+  void Add(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 0x100000001b3ull;
+    }
+  }
+
+  uint64_t hash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+}  // namespace
+
+RasterCacheDiskStore::RasterCacheDiskStore(fml::UniqueFD directory,
+                                           size_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {
+  if (!IsValid()) {
+    return;
+  }
+  std::vector<FileInfo> existing;
+  fml::VisitFiles(directory_, [&existing](const fml::UniqueFD& directory,
+                                          const std::string& filename) {
+    uint64_t key;
+    if (sscanf(filename.c_str(), "%016" SCNx64, &key) != 1 ||
+        FileName(key) != filename) {
+      return true;
+    }
+    fml::FileMapping mapping(fml::OpenFileReadOnly(directory, filename.c_str()));
+    existing.push_back({key, mapping.GetSize()});
+    return true;
+  });
+  // The order of the previous run is not known, so files are considered to
+  // have been used in the order they are found.
+  std::scoped_lock lock(mutex_);
+  for (const FileInfo& info : existing) {
+    files_.push_back(info);
+    total_bytes_ += info.size;
+  }
+}
+
+RasterCacheDiskStore::~RasterCacheDiskStore() = default;
+
+size_t RasterCacheDiskStore::total_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return total_bytes_;
+}
+
+std::optional<uint64_t> RasterCacheDiskStore::ComputeKey(
+    const DisplayList& display_list,
+    const SkMatrix& matrix,
+    const SkColorSpace* color_space) {
+  DisplayListSideTable side_table;
+  std::vector<uint8_t> ops =
+      DisplayListSerializer::Serialize(display_list, side_table);
+  if (side_table.entry_count() > 0) {
+    // The contents of the out-of-line objects are not part of the encoding.
+    return std::nullopt;
+  }
+
+  StableHash hash;
+  hash.Add(ops.data(), ops.size());
+
+  // The translation is applied when the image is drawn, as in
+  // RasterCacheKey.
+  SkScalar values[9];
+  matrix.get9(values);
+  values[SkMatrix::kMTransX] = 0;
+  values[SkMatrix::kMTransY] = 0;
+  hash.Add(values, sizeof(values));
+
+  if (color_space) {
+    sk_sp<SkData> data = color_space->serialize();
+    hash.Add(data->data(), data->size());
+  }
+
+  return hash.hash();
+}
+
+bool RasterCacheDiskStore::Contains(uint64_t key) const {
+  std::scoped_lock lock(mutex_);
+  for (const FileInfo& info : files_) {
+    if (info.key == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<RasterCacheDiskStore::Image> RasterCacheDiskStore::Load(
+    uint64_t key) {
+  TRACE_EVENT0("flutter", "RasterCacheDiskStore::Load");
+  std::scoped_lock lock(mutex_);
+  if (!Touch(key)) {
+    return std::nullopt;
+  }
+
+  std::string file_name = FileName(key);
+  fml::FileMapping mapping(
+      fml::OpenFileReadOnly(directory_, file_name.c_str()));
+  ImageHeader header;
+  if (mapping.GetSize() <= sizeof(ImageHeader)) {
+    Remove(key);
+    return std::nullopt;
+  }
+  memcpy(&header, mapping.GetMapping(), sizeof(ImageHeader));
+  if (header.signature != ImageHeader::kSignature ||
+      header.version != ImageHeader::kVersion || header.width <= 0 ||
+      header.height <= 0) {
+    FML_LOG(INFO) << "Raster cache disk store file is stale or corrupt: "
+                  << file_name;
+    Remove(key);
+    return std::nullopt;
+  }
+
+  return Image{
+      SkISize::Make(header.width, header.height),
+      SkData::MakeWithCopy(mapping.GetMapping() + sizeof(ImageHeader),
+                           mapping.GetSize() - sizeof(ImageHeader)),
+  };
+}
+
+bool RasterCacheDiskStore::Store(uint64_t key, const Image& image) {
+  TRACE_EVENT0("flutter", "RasterCacheDiskStore::Store");
+  if (!IsValid() || !image.encoded) {
+    return false;
+  }
+  size_t size = sizeof(ImageHeader) + image.encoded->size();
+  if (size > max_bytes_) {
+    return false;
+  }
+
+  std::vector<uint8_t> buffer(size);
+  ImageHeader header;
+  header.width = image.dimensions.width();
+  header.height = image.dimensions.height();
+  memcpy(buffer.data(), &header, sizeof(ImageHeader));
+  memcpy(buffer.data() + sizeof(ImageHeader), image.encoded->data(),
+         image.encoded->size());
+
+  std::scoped_lock lock(mutex_);
+  Remove(key);
+  std::string file_name = FileName(key);
+  fml::DataMapping mapping(std::move(buffer));
+  if (!fml::WriteAtomically(directory_, file_name.c_str(), mapping)) {
+    FML_LOG(WARNING) << "Could not write raster cache image to disk.";
+    return false;
+  }
+  files_.push_back({key, size});
+  total_bytes_ += size;
+
+  while (total_bytes_ > max_bytes_) {
+    Remove(files_.front().key);
+  }
+  return true;
+}
+
+std::string RasterCacheDiskStore::FileName(uint64_t key) {
+  char name[17];
+  snprintf(name, sizeof(name), "%016" PRIx64, key);
+  return name;
+}
+
+bool RasterCacheDiskStore::Touch(uint64_t key) {
+  for (auto it = files_.begin(); it != files_.end(); ++it) {
+    if (it->key == key) {
+      files_.splice(files_.end(), files_, it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void RasterCacheDiskStore::Remove(uint64_t key) {
+  for (auto it = files_.begin(); it != files_.end(); ++it) {
+    if (it->key == key) {
+      fml::UnlinkFile(directory_, FileName(key).c_str());
+      total_bytes_ -= it->size;
+      files_.erase(it);
+      return;
+    }
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
+#define FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+/// A disk backed tier for the RasterCache that keeps the encoded images of
+/// DisplayList entries across application restarts.
+///
+/// Images are keyed by a hash of the serialized DisplayList, the matrix it
+/// is rendered with and the destination color space, so only DisplayLists
+/// that can be serialized without out-of-line references (images, text
+/// blobs, nested DisplayLists and the like) can be stored. The files are
+/// stamped with a version that is bumped whenever the key or the file
+/// format change, and the least recently used files are deleted to keep
+/// the total size of the store under a limit.
+///
+/// It is thread-safe for reading and writing from multiple threads.
+class RasterCacheDiskStore {
+ public:
+  // Header written into the files used to store cached images.
+  struct ImageHeader {
+    // "RCDS" in little endian byte order.
+    static constexpr uint32_t kSignature = 0x53444352;
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion;
+    int32_t width = 0;
+    int32_t height = 0;
+  };
+
+  struct Image {
+    SkISize dimensions;
+    sk_sp<SkData> encoded;
+  };
+
+  /// Uses the files in |directory|, which must be readable and writable,
+  /// keeping their total size under |max_bytes|.
+  RasterCacheDiskStore(fml::UniqueFD directory, size_t max_bytes);
+
+  ~RasterCacheDiskStore();
+
+  bool IsValid() const { return directory_.is_valid(); }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /// The total size of the files currently in the store.
+  size_t total_bytes() const;
+
+  /// Computes the key under which the image of |display_list| rendered with
+  /// |matrix| into |color_space| is stored, or returns an empty optional if
+  /// the DisplayList cannot be stored.
+  static std::optional<uint64_t> ComputeKey(const DisplayList& display_list,
+                                            const SkMatrix& matrix,
+                                            const SkColorSpace* color_space);
+
+  bool Contains(uint64_t key) const;
+
+  /// Returns the image stored under |key|, if any. Files that are corrupt
+  /// or were written with a different version are deleted.
+  std::optional<Image> Load(uint64_t key);
+
+  /// Writes the encoded image under |key|, deleting the least recently used
+  /// files if the store grows too large. Performs file IO and so should be
+  /// called on a worker thread.
+  bool Store(uint64_t key, const Image& image);
+
+ private:
+  struct FileInfo {
+    uint64_t key;
+    size_t size;
+  };
+
+  static std::string FileName(uint64_t key);
+
+  // Moves the file to the most recently used end of |files_|, returning
+  // false if it is not in the store. Called with |mutex_| held.
+  bool Touch(uint64_t key);
+
+  // Deletes the file and forgets about it. Called with |mutex_| held.
+  void Remove(uint64_t key);
+
+  const fml::UniqueFD directory_;
+  const size_t max_bytes_;
+
+  mutable std::mutex mutex_;
+  // The files in the store, least recently used first.
+  std::list<FileInfo> files_;
+  size_t total_bytes_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheDiskStore);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_DISK_STORE_H_
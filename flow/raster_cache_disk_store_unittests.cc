@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_disk_store.h"
+
+#include <cstring>
+
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::UniqueFD OpenStoreDirectory(const fml::ScopedTemporaryDirectory& dir) {
+  return fml::OpenDirectory(dir.path().c_str(), false,
+                            fml::FilePermission::kReadWrite);
+}
+
+RasterCacheDiskStore::Image MakeImage(int width, int height, size_t size) {
+  std::vector<uint8_t> bytes(size, 0xab);
+  return {SkISize::Make(width, height),
+          SkData::MakeWithCopy(bytes.data(), bytes.size())};
+}
+
+}  // namespace
+
+TEST(RasterCacheDiskStore, StoredImageCanBeLoaded) {
+  fml::ScopedTemporaryDirectory dir;
+  RasterCacheDiskStore store(OpenStoreDirectory(dir), 1024 * 1024);
+  ASSERT_TRUE(store.IsValid());
+  EXPECT_FALSE(store.Contains(1));
+  EXPECT_FALSE(store.Load(1).has_value());
+
+  ASSERT_TRUE(store.Store(1, MakeImage(20, 10, 100)));
+  EXPECT_TRUE(store.Contains(1));
+  EXPECT_EQ(store.total_bytes(),
+            sizeof(RasterCacheDiskStore::ImageHeader) + 100);
+
+  auto image = store.Load(1);
+  ASSERT_TRUE(image.has_value());
+  EXPECT_EQ(image->dimensions, SkISize::Make(20, 10));
+  ASSERT_EQ(image->encoded->size(), 100u);
+  EXPECT_EQ(image->encoded->bytes()[0], 0xab);
+}
+
+TEST(RasterCacheDiskStore, ReopenedStoreFindsExistingFiles) {
+  fml::ScopedTemporaryDirectory dir;
+  {
+    RasterCacheDiskStore store(OpenStoreDirectory(dir), 1024 * 1024);
+    ASSERT_TRUE(store.Store(0x1234, MakeImage(20, 10, 100)));
+  }
+  // Files that are not named by a key are ignored.
+  fml::DataMapping other(std::vector<uint8_t>(10, 0));
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "other_file", other));
+
+  RasterCacheDiskStore store(OpenStoreDirectory(dir), 1024 * 1024);
+  EXPECT_TRUE(store.Contains(0x1234));
+  EXPECT_EQ(store.total_bytes(),
+            sizeof(RasterCacheDiskStore::ImageHeader) + 100);
+  EXPECT_TRUE(store.Load(0x1234).has_value());
+}
+
+TEST(RasterCacheDiskStore, FilesWithOtherVersionsAreDeleted) {
+  fml::ScopedTemporaryDirectory dir;
+  RasterCacheDiskStore::ImageHeader header;
+  header.version = RasterCacheDiskStore::ImageHeader::kVersion + 1;
+  header.width = 20;
+  header.height = 10;
+  std::vector<uint8_t> bytes(sizeof(header) + 100, 0);
+  memcpy(bytes.data(), &header, sizeof(header));
+  fml::DataMapping mapping(std::move(bytes));
+  ASSERT_TRUE(fml::WriteAtomically(dir.fd(), "0000000000000001", mapping));
+
+  RasterCacheDiskStore store(OpenStoreDirectory(dir), 1024 * 1024);
+  EXPECT_TRUE(store.Contains(1));
+  EXPECT_FALSE(store.Load(1).has_value());
+  EXPECT_FALSE(store.Contains(1));
+  EXPECT_EQ(store.total_bytes(), 0u);
+  EXPECT_FALSE(fml::FileExists(dir.fd(), "0000000000000001"));
+}
+
+TEST(RasterCacheDiskStore, LeastRecentlyUsedFilesAreEvicted) {
+  fml::ScopedTemporaryDirectory dir;
+  const size_t file_size = sizeof(RasterCacheDiskStore::ImageHeader) + 100;
+  RasterCacheDiskStore store(OpenStoreDirectory(dir), file_size * 2);
+
+  ASSERT_TRUE(store.Store(1, MakeImage(20, 10, 100)));
+  ASSERT_TRUE(store.Store(2, MakeImage(20, 10, 100)));
+  // Loading the first file makes the second the least recently used.
+  ASSERT_TRUE(store.Load(1).has_value());
+  ASSERT_TRUE(store.Store(3, MakeImage(20, 10, 100)));
+
+  EXPECT_TRUE(store.Contains(1));
+  EXPECT_FALSE(store.Contains(2));
+  EXPECT_TRUE(store.Contains(3));
+  EXPECT_EQ(store.total_bytes(), file_size * 2);
+
+  // Images larger than the whole store are not written at all.
+  EXPECT_FALSE(store.Store(4, MakeImage(20, 10, file_size * 2)));
+  EXPECT_TRUE(store.Contains(1));
+  EXPECT_TRUE(store.Contains(3));
+}
+
+TEST(RasterCacheDiskStore, KeyDependsOnContentMatrixAndColorSpace) {
+  auto display_list = GetSampleDisplayList();
+  auto same_display_list = GetSampleDisplayList();
+  ASSERT_NE(display_list->unique_id(), same_display_list->unique_id());
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+
+  auto key = RasterCacheDiskStore::ComputeKey(*display_list, matrix, nullptr);
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(
+      RasterCacheDiskStore::ComputeKey(*same_display_list, matrix, nullptr),
+      key);
+
+  // Translation is applied when the image is drawn.
+  SkMatrix translated = SkMatrix::Translate(10, 20);
+  translated.preConcat(matrix);
+  EXPECT_EQ(RasterCacheDiskStore::ComputeKey(*display_list, translated, nullptr),
+            key);
+
+  EXPECT_NE(RasterCacheDiskStore::ComputeKey(*display_list, SkMatrix::I(),
+                                             nullptr),
+            key);
+  EXPECT_NE(RasterCacheDiskStore::ComputeKey(
+                *display_list, matrix, SkColorSpace::MakeSRGBLinear().get()),
+            key);
+
+  DisplayListBuilder builder(SkRect::MakeWH(150, 100));
+  builder.setColor(SK_ColorBLUE);
+  builder.drawRect(SkRect::MakeXYWH(10, 10, 80, 80));
+  EXPECT_NE(RasterCacheDiskStore::ComputeKey(*builder.Build(), matrix, nullptr),
+            key);
+}
+
+TEST(RasterCacheDiskStore, DisplayListsWithReferencesHaveNoKey) {
+  EXPECT_FALSE(RasterCacheDiskStore::ComputeKey(*GetSampleNestedDisplayList(),
+                                                SkMatrix::I(), nullptr)
+                   .has_value());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -12,9 +12,13 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
 #include "flutter/flow/testing/skia_gpu_object_layer_test.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/message_loop_impl.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/testing/assertions_skia.h"
 #include "gtest/gtest.h"
 #include "include/core/SkMatrix.h"
@@ -69,6 +73,7 @@ TEST(RasterCache, MetricsOmitUnpopulatedEntries) {
   cache.EndFrame();
   ASSERT_EQ(cache.picture_metrics().total_count(), 0u);
   ASSERT_EQ(cache.picture_metrics().total_bytes(), 0u);
+  ASSERT_EQ(cache.picture_metrics().uncached_count, 1u);
   cache.BeginFrame();
 
   // 2nd access.
@@ -79,6 +84,7 @@ TEST(RasterCache, MetricsOmitUnpopulatedEntries) {
   cache.EndFrame();
   ASSERT_EQ(cache.picture_metrics().total_count(), 0u);
   ASSERT_EQ(cache.picture_metrics().total_bytes(), 0u);
+  ASSERT_EQ(cache.picture_metrics().uncached_count, 1u);
   cache.BeginFrame();
 
   // Now Prepare should cache it.
@@ -88,6 +94,7 @@ TEST(RasterCache, MetricsOmitUnpopulatedEntries) {
 
   cache.EndFrame();
   ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+  ASSERT_EQ(cache.picture_metrics().uncached_count, 0u);
   // 80w * 80h * 4bpp + image object overhead
   ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
 }
@@ -183,6 +190,55 @@ TEST(RasterCache, SetCheckboardCacheImages) {
   ASSERT_TRUE(did_draw_checkerboard);
 }
 
+TEST(RasterCache, DisplayListRasterizerRendersImages) {
+  flutter::RasterCache cache(1);
+  SkMatrix matrix = SkMatrix::Scale(2, 2);
+  auto display_list = GetSampleDisplayList();
+
+  sk_sp<DisplayList> rasterized;
+  SkISize rasterized_size;
+  cache.SetDisplayListRasterizer(
+      [&](sk_sp<DisplayList> display_list, const SkISize& size) {
+        rasterized = std::move(display_list);
+        rasterized_size = size;
+        return MakeTestImage(size.width(), size.height(), 5);
+      });
+
+  RasterCache::Context r_context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = display_list->bounds(),
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      // clang-format on
+  };
+  auto result = cache.Rasterize(
+      r_context,
+      [&display_list](DlCanvas* canvas) {
+        canvas->DrawDisplayList(display_list);
+      },
+      [](DlCanvas* canvas, const SkRect&) {});
+
+  SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+      display_list->bounds(), matrix);
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(rasterized);
+  EXPECT_EQ(rasterized_size,
+            SkISize::Make(dest_rect.width(), dest_rect.height()));
+  EXPECT_EQ(result->image_dimensions(), rasterized_size);
+  EXPECT_EQ(rasterized->bounds(), SkRect::Make(rasterized_size));
+
+  // Images of the wrong size are not used.
+  cache.SetDisplayListRasterizer(
+      [](sk_sp<DisplayList> display_list, const SkISize& size) {
+        return MakeTestImage(size.width() / 2, size.height() / 2, 5);
+      });
+  EXPECT_FALSE(cache.Rasterize(
+      r_context, [](DlCanvas* canvas) {},
+      [](DlCanvas* canvas, const SkRect&) {}));
+}
+
 TEST(RasterCache, AccessThresholdOfZeroDisablesCachingForSkPicture) {
   size_t threshold = 0;
   flutter::RasterCache cache(threshold);
@@ -433,6 +489,489 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, EvictionPolicyRetainsUnusedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  RasterCacheEvictionPolicy policy;
+  policy.max_unused_frames = 2;
+  cache.SetEvictionPolicy(policy);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  // Populate both entries, taking 2 frames to cross the access threshold.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    RasterCacheItemTryToRasterCache(display_list_item_2, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+
+  // Only the first item is used, the second is retained.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 2u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 51248u);
+
+  // Neither item is used, both are retained.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 2u);
+
+  // The second item has now gone unused for 3 frames and is evicted.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+
+  // The first item returns and is drawn from the retained image.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 0u);
+}
+
+TEST(RasterCache, StaleEntriesAreServedForOtherScales) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+
+  SkMatrix matrix = SkMatrix::I();
+  SkMatrix scaled_matrix = SkMatrix::Scale(1.5, 1.5);
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+
+  // The entry for the identity matrix is kept and drawn in place of an
+  // entry for the new scale.
+  cache.SetServeStaleEntries(true);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, scaled_matrix);
+  cache.EvictUnusedCacheEntries();
+  DisplayListBuilder scaled_canvas;
+  scaled_canvas.Scale(1.5, 1.5);
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &scaled_canvas, &paint));
+  // Scales that are too far off are not served.
+  DisplayListBuilder far_scaled_canvas;
+  far_scaled_canvas.Scale(3, 3);
+  ASSERT_FALSE(
+      display_list_item.Draw(paint_context, &far_scaled_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 0u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+
+  // Unused entries are evicted again once stale entries are not served.
+  cache.SetServeStaleEntries(false);
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item, preroll_context, scaled_matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+}
+
+TEST(RasterCache, EvictionPolicyByteLimitEvictsUnusedEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  RasterCacheEvictionPolicy policy;
+  policy.max_unused_frames = 10;
+  policy.byte_limit = 30000;
+  cache.SetEvictionPolicy(policy);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  // Populate both entries, taking 2 frames to cross the access threshold.
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    RasterCacheItemTryToRasterCache(display_list_item_1, paint_context);
+    RasterCacheItemTryToRasterCache(display_list_item_2, paint_context);
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+
+  // Entries used in the frame are kept even though they exceed the limit.
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 2u);
+
+  // Retaining the unused item would exceed the limit so it is evicted.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().eviction_bytes, 25624u);
+
+  // A single unused item fits within the limit and is retained.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+}
+
+namespace {
+// A task runner that holds on to its tasks until they are run explicitly,
+// standing in for the IO thread used by async raster cache generation.
+class QueuedTaskRunner : public fml::TaskRunner {
+ public:
+  static fml::RefPtr<QueuedTaskRunner> Create() {
+    return fml::AdoptRef(new QueuedTaskRunner());
+  }
+
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t RunAll() {
+    std::vector<fml::closure> tasks;
+    tasks.swap(tasks_);
+    for (auto& task : tasks) {
+      task();
+    }
+    return tasks.size();
+  }
+
+ private:
+  QueuedTaskRunner() : TaskRunner(fml::RefPtr<fml::MessageLoopImpl>()) {}
+
+  std::vector<fml::closure> tasks_;
+};
+}  // namespace
+
+TEST(RasterCache, AsyncGenerationSwapsInImageOnLaterFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto task_runner = QueuedTaskRunner::Create();
+  int upload_count = 0;
+  cache.EnableAsyncGeneration(task_runner,
+                              [&upload_count](sk_sp<SkImage> image) {
+                                upload_count++;
+                                return DlImage::Make(std::move(image));
+                              });
+  ASSERT_TRUE(cache.async_generation_enabled());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // 1st access, below the threshold.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+  ASSERT_EQ(task_runner->RunAll(), 0u);
+
+  // 2nd access, the generation is requested but the item is drawn directly.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  // Asking again while the image is pending does not generate it twice.
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+
+  ASSERT_EQ(task_runner->RunAll(), 1u);
+  ASSERT_EQ(upload_count, 1);
+  // The image is not swapped in until the next frame begins.
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+
+  // 3rd access, the generated image is used.
+  cache.BeginFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(task_runner->RunAll(), 0u);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 1u);
+}
+
+TEST(RasterCache, AsyncGenerationCachesDisplayListsWithImagesInTheFrame) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  auto task_runner = QueuedTaskRunner::Create();
+  cache.EnableAsyncGeneration(task_runner, [](sk_sp<SkImage> image) {
+    return DlImage::Make(std::move(image));
+  });
+
+  SkMatrix matrix = SkMatrix::I();
+  DisplayListBuilder builder;
+  builder.drawDisplayList(GetSampleDisplayList());
+  builder.drawImage(MakeTestImage(10, 10, 5), {10, 10}, kNearestSampling,
+                    false);
+  auto display_list = builder.Build();
+  ASSERT_TRUE(display_list->DrawsImages());
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  // 1st access, below the threshold.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+
+  // 2nd access, the image is rendered in the frame rather than on the task
+  // runner, which can't draw the images of the raster thread.
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(task_runner->RunAll(), 0u);
+}
+
+TEST(RasterCache, DiskStoreImageIsUsedByNewCache) {
+  fml::ScopedTemporaryDirectory dir;
+  auto disk_store = std::make_shared<RasterCacheDiskStore>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite),
+      1024 * 1024);
+  auto worker = QueuedTaskRunner::Create();
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list = GetSampleDisplayList();
+  SkRect logical_rect = display_list->bounds();
+  RasterCache::Context r_context = {
+      // clang-format off
+      .gr_context         = nullptr,
+      .dst_color_space    = nullptr,
+      .matrix             = matrix,
+      .logical_rect       = logical_rect,
+      .flow_type          = "RasterCacheFlow::DisplayList",
+      .display_list       = display_list,
+      // clang-format on
+  };
+  int render_count = 0;
+  auto render_function = [&render_count, &display_list](DlCanvas* canvas) {
+    render_count++;
+    canvas->DrawDisplayList(display_list);
+  };
+  RasterCacheKeyID id(display_list->unique_id(),
+                      RasterCacheKeyType::kDisplayList);
+
+  {
+    flutter::RasterCache cache(1);
+    cache.EnableDiskStore(disk_store, worker);
+    cache.BeginFrame();
+    ASSERT_TRUE(cache.UpdateCacheEntry(id, r_context, render_function));
+    cache.EndFrame();
+    ASSERT_EQ(render_count, 1);
+    ASSERT_EQ(worker->RunAll(), 1u);
+  }
+  ASSERT_GT(disk_store->total_bytes(), 0u);
+
+  // A new cache, as after a restart, decodes the image instead of rendering.
+  flutter::RasterCache cache(1);
+  cache.EnableDiskStore(disk_store, worker);
+  cache.BeginFrame();
+  ASSERT_TRUE(cache.UpdateCacheEntry(id, r_context, render_function));
+  cache.EndFrame();
+  ASSERT_EQ(render_count, 1);
+  ASSERT_EQ(worker->RunAll(), 0u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+}
+
+TEST(RasterCache, AtlasedEntriesAreDrawn) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.EnableAtlasing(256, 128);
+  ASSERT_TRUE(cache.atlasing_enabled());
+
+  SkMatrix matrix = SkMatrix::I();
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  for (int i = 0; i < 2; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    ASSERT_EQ(
+        RasterCacheItemTryToRasterCache(display_list_item_1, paint_context),
+        i == 1);
+    ASSERT_EQ(
+        RasterCacheItemTryToRasterCache(display_list_item_2, paint_context),
+        i == 1);
+    ASSERT_EQ(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint),
+              i == 1);
+    ASSERT_EQ(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint),
+              i == 1);
+    cache.EndFrame();
+  }
+
+  // Both entries share a page, and together account for all of its pixels.
+  size_t page_bytes = 256 * 256 * 4;
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), page_bytes);
+  ASSERT_EQ(cache.picture_metrics().total_count(), 2u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_quality_policy.h"
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+RasterQualityPolicy::RasterQualityPolicy(size_t frames_to_reduce,
+                                         size_t frames_to_restore,
+                                         double restore_budget_fraction)
+    : frames_to_reduce_(frames_to_reduce),
+      frames_to_restore_(frames_to_restore),
+      restore_budget_fraction_(restore_budget_fraction) {
+  FML_DCHECK(frames_to_reduce_ > 0 && frames_to_restore_ > 0);
+  FML_DCHECK(restore_budget_fraction_ > 0 && restore_budget_fraction_ <= 1);
+}
+
+void RasterQualityPolicy::RecordFrame(fml::TimeDelta raster_duration,
+                                      fml::Milliseconds frame_budget) {
+  const double raster_millis = raster_duration.ToMillisecondsF();
+  if (reduces_quality_) {
+    if (raster_millis < frame_budget.count() * restore_budget_fraction_) {
+      frame_count_++;
+    } else {
+      frame_count_ = 0;
+    }
+    if (frame_count_ >= frames_to_restore_) {
+      TRACE_EVENT_INSTANT0("flutter", "RasterQualityRestored");
+      reduces_quality_ = false;
+      frame_count_ = 0;
+    }
+  } else {
+    if (raster_millis > frame_budget.count()) {
+      frame_count_++;
+    } else {
+      frame_count_ = 0;
+    }
+    if (frame_count_ >= frames_to_reduce_) {
+      TRACE_EVENT_INSTANT0("flutter", "RasterQualityReduced");
+      reduces_quality_ = true;
+      frame_count_ = 0;
+    }
+  }
+}
+
+std::shared_ptr<const DlImageFilter> RasterQualityPolicy::ReduceFilterCost(
+    const std::shared_ptr<const DlImageFilter>& filter) {
+  const DlBlurImageFilter* blur = filter ? filter->asBlur() : nullptr;
+  if (!blur || (blur->sigma_x() < kMinReducedBlurSigma &&
+                blur->sigma_y() < kMinReducedBlurSigma)) {
+    return filter;
+  }
+  auto down = std::make_shared<DlMatrixImageFilter>(SkMatrix::Scale(0.5, 0.5),
+                                                    DlImageSampling::kLinear);
+  auto reduced_blur = std::make_shared<DlBlurImageFilter>(
+      blur->sigma_x() * 0.5f, blur->sigma_y() * 0.5f, blur->tile_mode());
+  auto up = std::make_shared<DlMatrixImageFilter>(SkMatrix::Scale(2, 2),
+                                                  DlImageSampling::kLinear);
+  return std::make_shared<DlComposeImageFilter>(
+      up, std::make_shared<DlComposeImageFilter>(reduced_blur, down));
+}
+
+}  // namespace flutter
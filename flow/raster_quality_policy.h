@@ -0,0 +1,63 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_QUALITY_POLICY_H_
+#define FLUTTER_FLOW_RASTER_QUALITY_POLICY_H_
+
+#include <memory>
+
+#include "flutter/display_list/display_list_image_filter.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Decides when expensive effects are rendered at a reduced quality so that
+/// frames which would otherwise miss their budget can still be presented in
+/// time, based on how long the previous frames took to rasterize.
+///
+/// Quality is reduced once |frames_to_reduce| consecutive frames took longer
+/// than the frame budget to rasterize. It is restored once
+/// |frames_to_restore| consecutive frames then took less than
+/// |restore_budget_fraction| of the budget, which leaves enough headroom for
+/// the full quality effects so that the policy does not switch back and
+/// forth between every few frames.
+class RasterQualityPolicy {
+ public:
+  // Blurs with a smaller sigma than this are cheap enough that reducing
+  // their resolution would cost more in quality than it saves in time.
+  static constexpr SkScalar kMinReducedBlurSigma = 4.0f;
+
+  explicit RasterQualityPolicy(size_t frames_to_reduce = 3,
+                               size_t frames_to_restore = 30,
+                               double restore_budget_fraction = 0.75);
+
+  void RecordFrame(fml::TimeDelta raster_duration,
+                   fml::Milliseconds frame_budget);
+
+  bool reduces_quality() const { return reduces_quality_; }
+
+  /// Returns a filter that renders a softer version of |filter| at a reduced
+  /// cost, or |filter| itself if there is no cheaper version of it.
+  ///
+  /// Blurs are rendered at half of the resolution with half of the sigma
+  /// and then scaled back up, which costs about a quarter as much.
+  static std::shared_ptr<const DlImageFilter> ReduceFilterCost(
+      const std::shared_ptr<const DlImageFilter>& filter);
+
+ private:
+  const size_t frames_to_reduce_;
+  const size_t frames_to_restore_;
+  const double restore_budget_fraction_;
+
+  bool reduces_quality_ = false;
+  // The number of consecutive frames that would change |reduces_quality_|.
+  size_t frame_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterQualityPolicy);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_QUALITY_POLICY_H_
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_quality_policy.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+const fml::Milliseconds kBudget = fml::Milliseconds(16);
+const fml::TimeDelta kOverBudget = fml::TimeDelta::FromMilliseconds(20);
+const fml::TimeDelta kWithinBudget = fml::TimeDelta::FromMilliseconds(14);
+const fml::TimeDelta kWithHeadroom = fml::TimeDelta::FromMilliseconds(8);
+
+}  // namespace
+
+TEST(RasterQualityPolicy, ReducesQualityAfterConsecutiveSlowFrames) {
+  RasterQualityPolicy policy(3, 2, 0.75);
+  EXPECT_FALSE(policy.reduces_quality());
+
+  policy.RecordFrame(kOverBudget, kBudget);
+  policy.RecordFrame(kOverBudget, kBudget);
+  // A frame within the budget starts the count again.
+  policy.RecordFrame(kWithinBudget, kBudget);
+  policy.RecordFrame(kOverBudget, kBudget);
+  policy.RecordFrame(kOverBudget, kBudget);
+  EXPECT_FALSE(policy.reduces_quality());
+
+  policy.RecordFrame(kOverBudget, kBudget);
+  EXPECT_TRUE(policy.reduces_quality());
+}
+
+TEST(RasterQualityPolicy, RestoresQualityWithHeadroom) {
+  RasterQualityPolicy policy(1, 2, 0.75);
+  policy.RecordFrame(kOverBudget, kBudget);
+  ASSERT_TRUE(policy.reduces_quality());
+
+  // Frames that only just fit the budget do not restore the quality.
+  for (int i = 0; i < 5; i++) {
+    policy.RecordFrame(kWithinBudget, kBudget);
+  }
+  EXPECT_TRUE(policy.reduces_quality());
+
+  policy.RecordFrame(kWithHeadroom, kBudget);
+  EXPECT_TRUE(policy.reduces_quality());
+  policy.RecordFrame(kWithHeadroom, kBudget);
+  EXPECT_FALSE(policy.reduces_quality());
+}
+
+TEST(RasterQualityPolicy, ReducesCostOfLargeBlurs) {
+  auto blur = std::make_shared<DlBlurImageFilter>(10, 10, DlTileMode::kClamp);
+  auto reduced = RasterQualityPolicy::ReduceFilterCost(blur);
+  ASSERT_NE(reduced, nullptr);
+  const DlComposeImageFilter* compose = reduced->asCompose();
+  ASSERT_NE(compose, nullptr);
+  ASSERT_NE(compose->outer()->asMatrix(), nullptr);
+  EXPECT_EQ(compose->outer()->asMatrix()->matrix(), SkMatrix::Scale(2, 2));
+  const DlComposeImageFilter* inner = compose->inner()->asCompose();
+  ASSERT_NE(inner, nullptr);
+  ASSERT_NE(inner->outer()->asBlur(), nullptr);
+  EXPECT_EQ(inner->outer()->asBlur()->sigma_x(), 5);
+  EXPECT_EQ(inner->outer()->asBlur()->sigma_y(), 5);
+  ASSERT_NE(inner->inner()->asMatrix(), nullptr);
+  EXPECT_EQ(inner->inner()->asMatrix()->matrix(), SkMatrix::Scale(0.5, 0.5));
+}
+
+TEST(RasterQualityPolicy, KeepsOtherFilters) {
+  std::shared_ptr<const DlImageFilter> small_blur =
+      std::make_shared<DlBlurImageFilter>(2, 2, DlTileMode::kClamp);
+  EXPECT_EQ(RasterQualityPolicy::ReduceFilterCost(small_blur), small_blur);
+
+  std::shared_ptr<const DlImageFilter> dilate =
+      std::make_shared<DlDilateImageFilter>(10, 10);
+  EXPECT_EQ(RasterQualityPolicy::ReduceFilterCost(dilate), dilate);
+
+  EXPECT_EQ(RasterQualityPolicy::ReduceFilterCost(nullptr), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
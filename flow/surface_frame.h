@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/display_list/display_list_builder.h"
@@ -42,6 +43,11 @@ class SurfaceFrame {
     int vertical_clip_alignment = 1;
     int horizontal_clip_alignment = 1;
 
+    // The number of disjoint rects that the damage passed in SubmitInfo may
+    // be split into. Targets that can only present or restrict rendering to
+    // a single rect should leave this at 1.
+    size_t max_damage_rects = 1;
+
     // This is the area of framebuffer that lags behind the front buffer.
     //
     // Correctly providing exiting_damage is necessary for supporting double and
@@ -61,7 +67,8 @@ class SurfaceFrame {
                const SubmitCallback& submit_callback,
                SkISize frame_size,
                std::unique_ptr<GLContextResult> context_result = nullptr,
-               bool display_list_fallback = false);
+               bool display_list_fallback = false,
+               bool display_list_rtree = false);
 
   struct SubmitInfo {
     // The frame damage for frame n is the difference between frame n and
@@ -77,9 +84,20 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_partial_update
     std::optional<SkIRect> buffer_damage;
 
+    // Disjoint rects within frame_damage and buffer_damage that cover all of
+    // the damage. There are at most FramebufferInfo::max_damage_rects of
+    // them.
+    std::vector<SkIRect> frame_damage_rects;
+    std::vector<SkIRect> buffer_damage_rects;
+
     // Time at which this frame is scheduled to be presented. This is a hint
     // that can be passed to the platform to drop queued frames.
     std::optional<fml::TimePoint> presentation_time;
+
+    // The vsync target time of this frame. Unlike `presentation_time`, this
+    // is set even if the time has passed, for surfaces that stream frames
+    // rather than present them.
+    fml::TimePoint frame_target_time;
   };
 
   bool Submit();
@@ -11,6 +11,15 @@
 
 namespace fml {
 
+namespace {
+
+// The loop whose worker is running on the current thread, if any.
+thread_local ConcurrentMessageLoop* tls_current_loop = nullptr;
+// The index of that worker.
+thread_local size_t tls_worker_index = 0u;
+
+}  // namespace
+
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
     size_t worker_count) {
   return std::shared_ptr<ConcurrentMessageLoop>{
@@ -20,22 +29,27 @@ std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
 ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
     : worker_count_(std::max<size_t>(worker_count, 1ul)) {
   for (size_t i = 0; i < worker_count_; ++i) {
-    workers_.emplace_back([i, this]() {
+    auto worker = std::make_unique<Worker>();
+    // Any odd seed works for the xorshift generator.
+    worker->random_state = static_cast<uint32_t>(2 * i + 1);
+    workers_.emplace_back(std::move(worker));
+  }
+
+  // The workers must all exist before the first thread looks for tasks to
+  // steal.
+  for (size_t i = 0; i < worker_count_; ++i) {
+    threads_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      WorkerMain(i);
     });
   }
-
-  for (const auto& worker : workers_) {
-    worker_thread_ids_.emplace_back(worker.get_id());
-  }
 }
 
 ConcurrentMessageLoop::~ConcurrentMessageLoop() {
   Terminate();
-  for (auto& worker : workers_) {
-    worker.join();
+  for (auto& thread : threads_) {
+    thread.join();
   }
 }
 
@@ -52,75 +66,171 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
-  std::unique_lock lock(tasks_mutex_);
-
   // Don't just drop tasks on the floor in case of shutdown.
   if (shutdown_) {
     FML_DLOG(WARNING)
         << "Tried to post a task to shutdown concurrent message "
            "loop. The task will be executed on the callers thread.";
-    lock.unlock();
     task();
     return;
   }
 
-  tasks_.push(task);
-
-  // Unlock the mutex before notifying the condition variable because that mutex
-  // has to be acquired on the other thread anyway. Waiting in this scope till
-  // it is acquired there is a pessimization.
-  lock.unlock();
+  // Workers keep the tasks they post to themselves, as those are likely to
+  // use the data the worker just touched.
+  bool is_worker_thread = tls_current_loop == this;
+  size_t worker_index = is_worker_thread
+                            ? tls_worker_index
+                            : next_worker_index_.fetch_add(
+                                  1u, std::memory_order_relaxed) %
+                                  worker_count_;
+  {
+    Worker& worker = *workers_[worker_index];
+    std::scoped_lock lock(worker.mutex);
+    if (is_worker_thread) {
+      worker.tasks.push_back(task);
+    } else {
+      worker.injected_tasks.push_back(task);
+    }
+    ++pending_task_count_;
+  }
 
-  tasks_condition_.notify_one();
+  // A worker about to park checks the pending tasks after counting itself as
+  // parked, so either it sees this task or this sees it parked.
+  if (parked_worker_count_ > 0) {
+    WakeParkedWorker(worker_index);
+  }
 }
 
-void ConcurrentMessageLoop::WorkerMain() {
-  while (true) {
-    std::unique_lock lock(tasks_mutex_);
-    tasks_condition_.wait(lock, [&]() {
-      return !tasks_.empty() || shutdown_ || HasThreadTasksLocked();
-    });
+void ConcurrentMessageLoop::WorkerMain(size_t worker_index) {
+  tls_current_loop = this;
+  tls_worker_index = worker_index;
+  Worker& worker = *workers_[worker_index];
 
-    // Shutdown cannot be read with the task mutex unlocked.
-    bool shutdown_now = shutdown_;
-    fml::closure task;
+  while (true) {
     std::vector<fml::closure> thread_tasks;
-
-    if (!tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop();
+    {
+      std::scoped_lock lock(worker.mutex);
+      std::swap(thread_tasks, worker.thread_tasks);
     }
-
-    if (HasThreadTasksLocked()) {
-      thread_tasks = GetThreadTasksLocked();
-      FML_DCHECK(!HasThreadTasksLocked());
+    for (const auto& thread_task : thread_tasks) {
+      thread_task();
     }
 
-    // Don't hold onto the mutex while tasks are being executed as they could
-    // themselves try to post more tasks to the message loop.
-    lock.unlock();
+    if (shutdown_) {
+      break;
+    }
 
-    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
-    // Execute the primary task we woke up for.
+    fml::closure task = PopTask(worker_index);
+    if (!task) {
+      task = StealTask(worker_index);
+    }
     if (task) {
       task();
+      continue;
     }
 
-    // Execute any thread tasks.
-    for (const auto& thread_task : thread_tasks) {
-      thread_task();
+    Park(worker);
+  }
+
+  tls_current_loop = nullptr;
+}
+
+fml::closure ConcurrentMessageLoop::PopTask(size_t worker_index) {
+  Worker& worker = *workers_[worker_index];
+  std::scoped_lock lock(worker.mutex);
+  fml::closure task;
+  if (!worker.injected_tasks.empty()) {
+    task = std::move(worker.injected_tasks.front());
+    worker.injected_tasks.pop_front();
+  } else if (!worker.tasks.empty()) {
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+  } else {
+    return nullptr;
+  }
+  --pending_task_count_;
+  return task;
+}
+
+fml::closure ConcurrentMessageLoop::StealTask(size_t worker_index) {
+  if (pending_task_count_ == 0 || worker_count_ == 1) {
+    return nullptr;
+  }
+  // Starting at a random victim keeps idle workers from all contending for
+  // the mutex of the same one.
+  uint32_t& random_state = workers_[worker_index]->random_state;
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  size_t first_victim = random_state % worker_count_;
+  for (size_t i = 0; i < worker_count_; ++i) {
+    size_t victim_index = (first_victim + i) % worker_count_;
+    if (victim_index == worker_index) {
+      continue;
     }
+    Worker& victim = *workers_[victim_index];
+    std::scoped_lock lock(victim.mutex);
+    // The oldest outside task is the one that has waited the longest, and
+    // the oldest task of the victim itself is the one it would run last.
+    std::deque<fml::closure>& tasks = victim.injected_tasks.empty()
+                                          ? victim.tasks
+                                          : victim.injected_tasks;
+    if (tasks.empty()) {
+      continue;
+    }
+    fml::closure task = std::move(tasks.front());
+    tasks.pop_front();
+    --pending_task_count_;
+    return task;
+  }
+  return nullptr;
+}
 
-    if (shutdown_now) {
-      break;
+void ConcurrentMessageLoop::Park(Worker& worker) {
+  std::unique_lock lock(worker.mutex);
+  worker.parked = true;
+  ++parked_worker_count_;
+  // Tasks may have been posted since this worker last looked for them.
+  if (pending_task_count_ > 0 || shutdown_ || !worker.thread_tasks.empty()) {
+    UnparkLocked(worker);
+    return;
+  }
+  worker.wake_condition.wait(lock, [&worker]() { return !worker.parked; });
+  TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+}
+
+bool ConcurrentMessageLoop::UnparkLocked(Worker& worker) {
+  if (!worker.parked) {
+    return false;
+  }
+  worker.parked = false;
+  --parked_worker_count_;
+  return true;
+}
+
+void ConcurrentMessageLoop::WakeParkedWorker(size_t worker_index) {
+  for (size_t i = 0; i < worker_count_; ++i) {
+    Worker& worker = *workers_[(worker_index + i) % worker_count_];
+    std::unique_lock lock(worker.mutex);
+    if (UnparkLocked(worker)) {
+      // Unlock the mutex before notifying the condition variable because that
+      // mutex has to be acquired on the other thread anyway.
+      lock.unlock();
+      worker.wake_condition.notify_one();
+      return;
     }
   }
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
   shutdown_ = true;
-  tasks_condition_.notify_all();
+  for (auto& worker : workers_) {
+    std::unique_lock lock(worker->mutex);
+    if (UnparkLocked(*worker)) {
+      lock.unlock();
+      worker->wake_condition.notify_one();
+    }
+  }
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -128,24 +238,14 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     return;
   }
 
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    thread_tasks_[worker_thread_id].emplace_back(task);
+  for (auto& worker : workers_) {
+    std::unique_lock lock(worker->mutex);
+    worker->thread_tasks.emplace_back(task);
+    if (UnparkLocked(*worker)) {
+      lock.unlock();
+      worker->wake_condition.notify_one();
+    }
   }
-  tasks_condition_.notify_all();
-}
-
-bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
-  return thread_tasks_.count(std::this_thread::get_id()) > 0;
-}
-
-std::vector<fml::closure> ConcurrentMessageLoop::GetThreadTasksLocked() {
-  auto found = thread_tasks_.find(std::this_thread::get_id());
-  FML_DCHECK(found != thread_tasks_.end());
-  std::vector<fml::closure> pending_tasks;
-  std::swap(pending_tasks, found->second);
-  thread_tasks_.erase(found);
-  return pending_tasks;
 }
 
 ConcurrentTaskRunner::ConcurrentTaskRunner(
@@ -171,13 +271,7 @@ void ConcurrentTaskRunner::PostTask(const fml::closure& task) {
 }
 
 bool ConcurrentMessageLoop::RunsTasksOnCurrentThread() {
-  std::scoped_lock lock(tasks_mutex_);
-  for (const auto& worker_thread_id : worker_thread_ids_) {
-    if (worker_thread_id == std::this_thread::get_id()) {
-      return true;
-    }
-  }
-  return false;
+  return tls_current_loop == this;
 }
 
 }  // namespace fml
@@ -5,10 +5,13 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
-#include <map>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
@@ -18,6 +21,18 @@ namespace fml {
 
 class ConcurrentTaskRunner;
 
+//------------------------------------------------------------------------------
+/// @brief      A pool of worker threads that run the tasks posted to its task
+///             runners concurrently.
+///
+///             Tasks posted from outside of the loop are distributed over the
+///             workers round-robin, and each worker runs those in the order
+///             they were posted. Tasks posted by a worker are pushed to a deque
+///             of its own, where it runs the most recently posted ones first
+///             once it has no outside tasks left. Workers that run out of
+///             tasks steal the oldest tasks of the other workers, starting at
+///             a random one, before parking until new tasks are posted.
+///
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
@@ -39,24 +54,50 @@ class ConcurrentMessageLoop
  private:
   friend ConcurrentTaskRunner;
 
+  struct Worker {
+    // Guards all of the fields below. Only held briefly to push or pop tasks,
+    // never while running them.
+    std::mutex mutex;
+    // Tasks posted from outside of the loop, run first-in first-out so that
+    // none of them are starved by tasks posted later.
+    std::deque<fml::closure> injected_tasks;
+    // Tasks posted by the worker itself, run last-in first-out.
+    std::deque<fml::closure> tasks;
+    // Tasks posted with |PostTaskToAllWorkers| that only this worker may run.
+    std::vector<fml::closure> thread_tasks;
+    std::condition_variable wake_condition;
+    bool parked = false;
+    // Only used by the thread of the worker to pick victims to steal from.
+    uint32_t random_state = 0u;
+  };
+
   size_t worker_count_ = 0;
-  std::vector<std::thread> workers_;
-  std::mutex tasks_mutex_;
-  std::condition_variable tasks_condition_;
-  std::queue<fml::closure> tasks_;
-  std::vector<std::thread::id> worker_thread_ids_;
-  std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  // The number of tasks in the deques of all workers.
+  std::atomic<size_t> pending_task_count_ = 0u;
+  std::atomic<size_t> parked_worker_count_ = 0u;
+  std::atomic<size_t> next_worker_index_ = 0u;
+  std::atomic<bool> shutdown_ = false;
 
   explicit ConcurrentMessageLoop(size_t worker_count);
 
-  void WorkerMain();
+  void WorkerMain(size_t worker_index);
 
   void PostTask(const fml::closure& task);
 
-  bool HasThreadTasksLocked() const;
+  fml::closure PopTask(size_t worker_index);
+
+  fml::closure StealTask(size_t worker_index);
+
+  void Park(Worker& worker);
+
+  // Wakes the first parked worker at or after |worker_index|, if any.
+  void WakeParkedWorker(size_t worker_index);
 
-  std::vector<fml::closure> GetThreadTasksLocked();
+  // Returns whether the worker was parked. The caller must notify its wake
+  // condition once the mutex of the worker is unlocked.
+  bool UnparkLocked(Worker& worker);
 
   FML_DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageLoop);
 };
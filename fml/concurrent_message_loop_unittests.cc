@@ -0,0 +1,123 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/testing/testing.h"
+
+namespace fml {
+namespace testing {
+
+static constexpr TimeDelta kTimeout = TimeDelta::FromSeconds(10);
+
+TEST(ConcurrentMessageLoopTest, RunsTasksPostedFromOutsideInOrder) {
+  auto loop = ConcurrentMessageLoop::Create(1u);
+  auto runner = loop->GetTaskRunner();
+
+  // Keeps the only worker busy until all of the tasks have been posted.
+  ManualResetWaitableEvent release;
+  runner->PostTask([&release]() { release.Wait(); });
+
+  std::mutex mutex;
+  std::vector<int> order;
+  for (int i = 0; i < 100; ++i) {
+    runner->PostTask([&mutex, &order, i]() {
+      std::scoped_lock lock(mutex);
+      order.push_back(i);
+    });
+  }
+  ManualResetWaitableEvent done;
+  runner->PostTask([&done]() { done.Signal(); });
+
+  release.Signal();
+  ASSERT_FALSE(done.WaitWithTimeout(kTimeout));
+
+  std::scoped_lock lock(mutex);
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(ConcurrentMessageLoopTest, RunsTasksPostedByAWorkerMostRecentFirst) {
+  auto loop = ConcurrentMessageLoop::Create(1u);
+  auto runner = loop->GetTaskRunner();
+
+  std::vector<int> order;
+  ManualResetWaitableEvent done;
+  runner->PostTask([runner, &order, &done]() {
+    // Posted first so that it runs last.
+    runner->PostTask([&done]() { done.Signal(); });
+    for (int i = 0; i < 3; ++i) {
+      runner->PostTask([&order, i]() { order.push_back(i); });
+    }
+  });
+
+  ASSERT_FALSE(done.WaitWithTimeout(kTimeout));
+  EXPECT_EQ(order, (std::vector<int>{2, 1, 0}));
+}
+
+TEST(ConcurrentMessageLoopTest, TasksPostedFromOutsideAreNotStarved) {
+  auto loop = ConcurrentMessageLoop::Create(1u);
+  auto runner = loop->GetTaskRunner();
+
+  std::atomic<bool> outside_task_ran = false;
+  std::atomic<size_t> reposts = 0u;
+  ManualResetWaitableEvent done;
+  std::function<void()> repost = [&]() {
+    // Bounded so that the test fails instead of hanging.
+    if (outside_task_ran || ++reposts == 100000u) {
+      done.Signal();
+      return;
+    }
+    runner->PostTask(repost);
+  };
+  runner->PostTask(repost);
+  runner->PostTask([&outside_task_ran]() { outside_task_ran = true; });
+
+  ASSERT_FALSE(done.WaitWithTimeout(kTimeout));
+  EXPECT_TRUE(outside_task_ran);
+  EXPECT_LT(reposts, 100000u);
+}
+
+TEST(ConcurrentMessageLoopTest, IdleWorkersStealTasksOfBusyWorkers) {
+  auto loop = ConcurrentMessageLoop::Create(2u);
+  auto runner = loop->GetTaskRunner();
+
+  const size_t task_count = 10u;
+  std::atomic<size_t> ran_count = 0u;
+  std::atomic<size_t> ran_on_busy_worker_count = 0u;
+  ManualResetWaitableEvent done;
+  ManualResetWaitableEvent stolen;
+  runner->PostTask([&]() {
+    std::thread::id busy_worker = std::this_thread::get_id();
+    for (size_t i = 0; i < task_count; ++i) {
+      runner->PostTask([&, busy_worker]() {
+        if (std::this_thread::get_id() == busy_worker) {
+          ++ran_on_busy_worker_count;
+        }
+        if (++ran_count == task_count) {
+          stolen.Signal();
+        }
+      });
+    }
+    // Only the other worker can run the tasks while this one blocks.
+    stolen.WaitWithTimeout(kTimeout);
+    done.Signal();
+  });
+
+  ASSERT_FALSE(done.WaitWithTimeout(kTimeout));
+  EXPECT_EQ(ran_count, task_count);
+  EXPECT_EQ(ran_on_busy_worker_count, 0u);
+}
+
+}  // namespace testing
+}  // namespace fml
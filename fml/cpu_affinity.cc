@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/logging.h"
+
+#if defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+#include <sched.h>
+#endif
+
+namespace fml {
+
+CPUSpeedTracker::CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data) {
+  if (data.empty()) {
+    return;
+  }
+  std::sort(data.begin(), data.end(),
+            [](const CpuIndexAndSpeed& a, const CpuIndexAndSpeed& b) {
+              return a.index < b.index;
+            });
+  int64_t min_speed = data.front().speed;
+  int64_t max_speed = data.front().speed;
+  for (const auto& cpu : data) {
+    min_speed = std::min(min_speed, cpu.speed);
+    max_speed = std::max(max_speed, cpu.speed);
+  }
+  if (min_speed == max_speed) {
+    return;
+  }
+  valid_ = true;
+  for (const auto& cpu : data) {
+    if (cpu.speed == max_speed) {
+      performance_.push_back(cpu.index);
+    } else {
+      not_performance_.push_back(cpu.index);
+      if (cpu.speed == min_speed) {
+        efficiency_.push_back(cpu.index);
+      }
+    }
+  }
+}
+
+bool CPUSpeedTracker::IsValid() const {
+  return valid_;
+}
+
+const std::vector<size_t>& CPUSpeedTracker::GetIndices(
+    CpuAffinity affinity) const {
+  switch (affinity) {
+    case CpuAffinity::kPerformance:
+      return performance_;
+    case CpuAffinity::kEfficiency:
+      return efficiency_;
+    case CpuAffinity::kNotPerformance:
+      return not_performance_;
+  }
+  FML_UNREACHABLE();
+}
+
+#if defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+
+namespace {
+
+std::optional<int64_t> ReadIntFromFile(const std::string& path) {
+  std::ifstream file(path);
+  int64_t value = 0;
+  if (!(file >> value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// The speeds of the cores don't change while the process runs, so they are
+// only read once.
+const CPUSpeedTracker& GetCPUSpeedTracker() {
+  static const CPUSpeedTracker tracker([] {
+    std::vector<CpuIndexAndSpeed> data;
+    auto count = std::thread::hardware_concurrency();
+    for (size_t i = 0; i < count; i++) {
+      auto speed = ReadIntFromFile("/sys/devices/system/cpu/cpu" +
+                                   std::to_string(i) +
+                                   "/cpufreq/cpuinfo_max_freq");
+      if (!speed.has_value()) {
+        // Without the speed of every core, the speeds can't be compared.
+        return std::vector<CpuIndexAndSpeed>{};
+      }
+      data.push_back({.index = i, .speed = speed.value()});
+    }
+    return data;
+  }());
+  return tracker;
+}
+
+}  // namespace
+
+bool RequestAffinity(CpuAffinity affinity) {
+  const auto& tracker = GetCPUSpeedTracker();
+  if (!tracker.IsValid()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto index : tracker.GetIndices(affinity)) {
+    CPU_SET(index, &set);
+  }
+  if (::sched_setaffinity(0, sizeof(set), &set) != 0) {
+    FML_LOG(ERROR) << "Failed to set the CPU affinity of the thread.";
+    return false;
+  }
+  return true;
+}
+
+#else
+
+bool RequestAffinity(CpuAffinity /*affinity*/) {
+  return false;
+}
+
+#endif
+
+}  // namespace fml
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_CPU_AFFINITY_H_
+#define FLUTTER_FML_CPU_AFFINITY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fml {
+
+/// The set of cores that a thread may be scheduled on.
+enum class CpuAffinity {
+  /// The fastest cores of the device.
+  kPerformance,
+  /// The slowest cores of the device.
+  kEfficiency,
+  /// All but the fastest cores of the device.
+  kNotPerformance,
+};
+
+/// The index of a core and its maximum frequency.
+struct CpuIndexAndSpeed {
+  size_t index;
+  int64_t speed;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Sorts the cores of a device into performance and efficiency
+///             cores by their maximum frequencies.
+///
+///             On devices whose cores all run at the same speed there is no
+///             distinction to make, and the tracker is invalid.
+///
+class CPUSpeedTracker {
+ public:
+  explicit CPUSpeedTracker(std::vector<CpuIndexAndSpeed> data);
+
+  /// Whether the cores run at more than one speed.
+  bool IsValid() const;
+
+  /// The indices of the cores with the affinity, sorted in ascending order.
+  const std::vector<size_t>& GetIndices(CpuAffinity affinity) const;
+
+ private:
+  bool valid_ = false;
+  std::vector<size_t> efficiency_;
+  std::vector<size_t> performance_;
+  std::vector<size_t> not_performance_;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Pins the current thread to the cores with the affinity.
+///
+///             Only Android and Linux report the speeds of the cores. On
+///             other platforms, and on devices whose cores all run at the
+///             same speed, this leaves the affinity of the thread alone.
+///
+/// @return     Whether the affinity of the thread was set.
+///
+bool RequestAffinity(CpuAffinity affinity);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_CPU_AFFINITY_H_
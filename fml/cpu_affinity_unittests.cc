@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/cpu_affinity.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(CpuAffinity, NonUniformSpeeds) {
+  std::vector<CpuIndexAndSpeed> speeds = {{.index = 0, .speed = 1},
+                                          {.index = 1, .speed = 2},
+                                          {.index = 2, .speed = 3}};
+  CPUSpeedTracker tracker(speeds);
+
+  ASSERT_TRUE(tracker.IsValid());
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kEfficiency),
+            std::vector<size_t>{0u});
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            std::vector<size_t>{2u});
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            (std::vector<size_t>{0u, 1u}));
+}
+
+TEST(CpuAffinity, GroupsCoresOfTheSameSpeed) {
+  std::vector<CpuIndexAndSpeed> speeds = {{.index = 3, .speed = 2},
+                                          {.index = 2, .speed = 2},
+                                          {.index = 1, .speed = 1},
+                                          {.index = 0, .speed = 1}};
+  CPUSpeedTracker tracker(speeds);
+
+  ASSERT_TRUE(tracker.IsValid());
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kEfficiency),
+            (std::vector<size_t>{0u, 1u}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kPerformance),
+            (std::vector<size_t>{2u, 3u}));
+  ASSERT_EQ(tracker.GetIndices(CpuAffinity::kNotPerformance),
+            (std::vector<size_t>{0u, 1u}));
+}
+
+TEST(CpuAffinity, UniformSpeedsAreInvalid) {
+  std::vector<CpuIndexAndSpeed> speeds = {{.index = 0, .speed = 1},
+                                          {.index = 1, .speed = 1}};
+  CPUSpeedTracker tracker(speeds);
+
+  ASSERT_FALSE(tracker.IsValid());
+  ASSERT_TRUE(tracker.GetIndices(CpuAffinity::kPerformance).empty());
+}
+
+TEST(CpuAffinity, NoSpeedsAreInvalid) {
+  CPUSpeedTracker tracker({});
+
+  ASSERT_FALSE(tracker.IsValid());
+}
+
+}  // namespace testing
+}  // namespace fml
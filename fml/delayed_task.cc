@@ -6,25 +6,38 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace fml {
 
 DelayedTask::DelayedTask(size_t order,
-                         const fml::closure& task,
+                         fml::UniqueClosure task,
                          fml::TimePoint target_time,
-                         fml::TaskSourceGrade task_source_grade)
+                         fml::TaskSourceGrade task_source_grade,
+                         fml::TaskPriority priority,
+                         fml::TimePoint deadline)
     : order_(order),
-      task_(task),
+      task_(std::move(task)),
       target_time_(target_time),
-      task_source_grade_(task_source_grade) {}
+      task_source_grade_(task_source_grade),
+      priority_(priority),
+      deadline_(deadline) {}
 
 DelayedTask::~DelayedTask() = default;
 
-DelayedTask::DelayedTask(const DelayedTask& other) = default;
+DelayedTask::DelayedTask(DelayedTask&& other) = default;
+
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) = default;
 
-const fml::closure& DelayedTask::GetTask() const {
+const fml::UniqueClosure& DelayedTask::GetTask() const {
   return task_;
 }
 
+fml::UniqueClosure DelayedTask::TakeTask() {
+  return std::move(task_);
+}
+
 fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
@@ -33,6 +46,38 @@ fml::TaskSourceGrade DelayedTask::GetTaskSourceGrade() const {
   return task_source_grade_;
 }
 
+fml::TaskPriority DelayedTask::GetPriority() const {
+  return priority_;
+}
+
+fml::TimePoint DelayedTask::GetDeadline() const {
+  return deadline_;
+}
+
+fml::TaskPriority DelayedTask::GetEffectivePriority(fml::TimePoint now) const {
+  if (deadline_ <= now) {
+    return fml::TaskPriority::kFrameCritical;
+  }
+  return priority_;
+}
+
+bool DelayedTask::RunsBefore(const DelayedTask& other,
+                             fml::TimePoint now) const {
+  const bool is_due = target_time_ <= now;
+  const bool other_is_due = other.target_time_ <= now;
+  if (is_due != other_is_due) {
+    return is_due;
+  }
+  if (is_due) {
+    const auto priority = GetEffectivePriority(now);
+    const auto other_priority = other.GetEffectivePriority(now);
+    if (priority != other_priority) {
+      return priority < other_priority;
+    }
+  }
+  return other > *this;
+}
+
 bool DelayedTask::operator>(const DelayedTask& other) const {
   if (target_time_ == other.target_time_) {
     return order_ > other.order_;
@@ -40,4 +85,11 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+DelayedTask DelayedTaskQueue::Pop() {
+  std::pop_heap(c.begin(), c.end(), comp);
+  DelayedTask task = std::move(c.back());
+  c.pop_back();
+  return task;
+}
+
 }  // namespace fml
@@ -7,41 +7,77 @@
 
 #include <queue>
 
-#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_source_grade.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_closure.h"
 
 namespace fml {
 
+/// A task of a task queue. Tasks are move-only, so that they can be moved
+/// through the queues without copying or allocating.
 class DelayedTask {
  public:
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::UniqueClosure task,
               fml::TimePoint target_time,
-              fml::TaskSourceGrade task_source_grade);
+              fml::TaskSourceGrade task_source_grade,
+              fml::TaskPriority priority = fml::TaskPriority::kNormal,
+              fml::TimePoint deadline = fml::TimePoint::Max());
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  const fml::UniqueClosure& GetTask() const;
+
+  /// Moves the closure out of the task, leaving it empty.
+  fml::UniqueClosure TakeTask();
 
   fml::TimePoint GetTargetTime() const;
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
 
+  fml::TaskPriority GetPriority() const;
+
+  fml::TimePoint GetDeadline() const;
+
+  /// The priority of the task at |now|. Tasks whose deadline has passed are
+  /// frame critical, so that lower priority tasks cannot be starved.
+  fml::TaskPriority GetEffectivePriority(fml::TimePoint now) const;
+
+  /// Whether this task should run before |other| at |now|. Tasks that are due
+  /// run before tasks that aren't, due tasks run in the order of their
+  /// effective priorities, and tasks are otherwise ordered by target time.
+  bool RunsBefore(const DelayedTask& other, fml::TimePoint now) const;
+
+  /// Orders tasks by target time, and by the order they were posted in.
   bool operator>(const DelayedTask& other) const;
 
  private:
   size_t order_;
-  fml::closure task_;
+  fml::UniqueClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+  fml::TaskPriority priority_;
+  fml::TimePoint deadline_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTask);
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A heap of tasks ordered by `DelayedTask::operator>`. Unlike
+/// `std::priority_queue`, the top task can be moved out of the heap.
+class DelayedTaskQueue
+    : public std::priority_queue<DelayedTask,
+                                 std::deque<DelayedTask>,
+                                 std::greater<DelayedTask>> {
+ public:
+  /// Removes the top task and returns it.
+  DelayedTask Pop();
+};
 
 }  // namespace fml
 
@@ -9,14 +9,55 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/trace_event.h"
+
 namespace fml {
 
+// Mapping
+
+void Mapping::TouchPages() const {
+  // Pages are at least this large on all supported platforms.
+  constexpr size_t kPageSize = 4096u;
+  const volatile uint8_t* bytes = GetMapping();
+  if (bytes == nullptr) {
+    return;
+  }
+  uint8_t checksum = 0u;
+  for (size_t offset = 0; offset < GetSize(); offset += kPageSize) {
+    checksum ^= bytes[offset];
+  }
+  (void)checksum;
+}
+
 // FileMapping
 
 uint8_t* FileMapping::GetMutableMapping() {
   return mutable_mapping_;
 }
 
+bool FileMapping::Prefetch(const fml::UniqueFD& fd,
+                           const fml::RefPtr<fml::TaskRunner>& task_runner) {
+  if (!fd.is_valid() || !task_runner) {
+    return false;
+  }
+  fml::UniqueFD duplicate = fml::Duplicate(fd.get());
+  if (!duplicate.is_valid()) {
+    return false;
+  }
+  auto shared_fd = std::make_shared<fml::UniqueFD>(std::move(duplicate));
+  task_runner->PostTask([shared_fd]() {
+    TRACE_EVENT0("flutter", "FileMapping::Prefetch");
+    FileMapping mapping(*shared_fd);
+    if (!mapping.IsValid() || mapping.GetSize() == 0) {
+      return;
+    }
+    mapping.Advise(Advice::kWillNeed);
+    mapping.TouchPages();
+  });
+  return true;
+}
+
 std::unique_ptr<FileMapping> FileMapping::CreateReadOnly(
     const std::string& path) {
   return CreateReadOnly(OpenFile(path.c_str(), false, FilePermission::kRead),
@@ -13,11 +13,14 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/unique_fd.h"
 
 namespace fml {
 
+class TaskRunner;
+
 class Mapping {
  public:
   Mapping();
@@ -32,6 +35,10 @@ class Mapping {
   // Generally true for file-mapped memory and false for anonymous memory.
   virtual bool IsDontNeedSafe() const = 0;
 
+  // Reads one byte of each page of the mapping, so that reading it later on
+  // doesn't wait for page faults. Call this off of the critical path.
+  void TouchPages() const;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(Mapping);
 };
@@ -44,6 +51,23 @@ class FileMapping final : public Mapping {
     kExecute,
   };
 
+  /// Hints to the kernel about how a mapping is going to be accessed. See
+  /// `Advise`.
+  enum class Advice {
+    /// The default readahead.
+    kNormal,
+    /// The mapping is read from start to end. Reads ahead aggressively.
+    kSequential,
+    /// The mapping is read in no particular order. Disables readahead.
+    kRandom,
+    /// The whole mapping is going to be read soon. Starts reading it from
+    /// storage without waiting for the reads to complete.
+    kWillNeed,
+    /// Back the mapping with huge pages, where the kernel supports it for
+    /// file mappings.
+    kHugePages,
+  };
+
   explicit FileMapping(const fml::UniqueFD& fd,
                        std::initializer_list<Protection> protection = {
                            Protection::kRead});
@@ -63,6 +87,22 @@ class FileMapping final : public Mapping {
       const fml::UniqueFD& base_fd,
       const std::string& sub_path = "");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Reads the file into the page cache on the task runner, so
+  ///             that page faults on mappings of the file don't wait for
+  ///             storage later on. The file is mapped again on the task
+  ///             runner, so the caller may close the descriptor and destroy
+  ///             its own mappings of the file at any time.
+  ///
+  /// @param[in]  fd           The file to prefetch.
+  /// @param[in]  task_runner  The task runner to read the file on, which
+  ///                          should not be the platform or UI task runner.
+  ///
+  /// @return     Whether the prefetch was posted.
+  ///
+  static bool Prefetch(const fml::UniqueFD& fd,
+                       const fml::RefPtr<fml::TaskRunner>& task_runner);
+
   // |Mapping|
   size_t GetSize() const override;
 
@@ -76,6 +116,16 @@ class FileMapping final : public Mapping {
 
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Advises the kernel of how the mapping is going to be
+  ///             accessed. Advice only affects performance, never the
+  ///             contents of the mapping.
+  ///
+  /// @return     Whether the advice was taken. This is false on platforms
+  ///             that don't support the advice, and for empty mappings.
+  ///
+  bool Advise(Advice advice) const;
+
  private:
   bool valid_ = false;
   size_t size_ = 0;
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/testing/testing.h"
 
 namespace fml {
@@ -67,4 +70,65 @@ TEST(MallocMapping, CopySizeZero) {
   ASSERT_EQ(0u, mapping.GetSize());
 }
 
+TEST(MallocMapping, TouchPagesDoesNotChangeContents) {
+  std::string contents(3 * 4096 + 7, 'y');
+  MallocMapping mapping = MallocMapping::Copy(
+      contents.data(), contents.data() + contents.size());
+  mapping.TouchPages();
+  ASSERT_EQ(contents, std::string(reinterpret_cast<const char*>(
+                                      mapping.GetMapping()),
+                                  mapping.GetSize()));
+
+  MallocMapping empty;
+  empty.TouchPages();
+}
+
+TEST(FileMapping, AdviseDoesNotChangeContents) {
+  ScopedTemporaryDirectory dir;
+  DataMapping data(std::string(64 * 1024, 'x'));
+  ASSERT_TRUE(WriteAtomically(dir.fd(), "advised", data));
+
+  auto mapping = FileMapping::CreateReadOnly(dir.fd(), "advised");
+  ASSERT_TRUE(mapping);
+  for (auto advice :
+       {FileMapping::Advice::kSequential, FileMapping::Advice::kRandom,
+        FileMapping::Advice::kWillNeed, FileMapping::Advice::kHugePages,
+        FileMapping::Advice::kNormal}) {
+    mapping->Advise(advice);
+  }
+#if FML_OS_LINUX || FML_OS_ANDROID || FML_OS_MACOSX || FML_OS_IOS
+  ASSERT_TRUE(mapping->Advise(FileMapping::Advice::kWillNeed));
+#endif
+  ASSERT_EQ(mapping->GetSize(), data.GetSize());
+  ASSERT_EQ(0, memcmp(mapping->GetMapping(), data.GetMapping(),
+                      data.GetSize()));
+}
+
+TEST(FileMapping, AdviseFailsForEmptyMappings) {
+  ScopedTemporaryDirectory dir;
+  ASSERT_TRUE(
+      OpenFile(dir.fd(), "empty", true, FilePermission::kReadWrite).is_valid());
+  auto mapping = FileMapping::CreateReadOnly(dir.fd(), "empty");
+  ASSERT_TRUE(mapping);
+  ASSERT_FALSE(mapping->Advise(FileMapping::Advice::kWillNeed));
+}
+
+TEST(FileMapping, PrefetchReadsTheFileOnTheTaskRunner) {
+  ScopedTemporaryDirectory dir;
+  ASSERT_TRUE(WriteAtomically(dir.fd(), "prefetched",
+                              DataMapping(std::string(64 * 1024, 'x'))));
+  fml::Thread thread("prefetch");
+  {
+    fml::UniqueFD fd = OpenFile(dir.fd(), "prefetched", false,
+                                FilePermission::kRead);
+    ASSERT_TRUE(FileMapping::Prefetch(fd, thread.GetTaskRunner()));
+    // The descriptor may be closed while the prefetch is pending.
+  }
+  fml::AutoResetWaitableEvent latch;
+  thread.GetTaskRunner()->PostTask([&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  ASSERT_FALSE(FileMapping::Prefetch(fml::UniqueFD(), thread.GetTaskRunner()));
+}
+
 }  // namespace fml
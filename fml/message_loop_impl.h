@@ -39,7 +39,10 @@ class MessageLoopImpl : public Wakeable,
 
   virtual void Terminate() = 0;
 
-  void PostTask(const fml::closure& task, fml::TimePoint target_time);
+  void PostTask(const fml::closure& task,
+                fml::TimePoint target_time,
+                fml::TaskPriority priority = fml::TaskPriority::kNormal,
+                fml::TimePoint deadline = fml::TimePoint::Max());
 
   void AddTaskObserver(intptr_t key, const fml::closure& callback);
 
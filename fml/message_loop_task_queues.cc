@@ -10,6 +10,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <utility>
 
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_source.h"
@@ -35,6 +36,53 @@ class TaskSourceGradeHolder {
 FML_THREAD_LOCAL ThreadLocalUniquePtr<TaskSourceGradeHolder>
     tls_task_source_grade;
 
+TaskQueueIngress::TaskQueueIngress() = default;
+
+TaskQueueIngress::~TaskQueueIngress() {
+  Node* node = head_.load();
+  while (node) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+void TaskQueueIngress::Push(DelayedTask task, bool wakes_loop) {
+  const fml::TimePoint target_time = task.GetTargetTime();
+  Node* node = new Node{std::move(task), head_.load(std::memory_order_relaxed)};
+  while (!head_.compare_exchange_weak(node->next, node,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+  if (!wakes_loop) {
+    return;
+  }
+  fml::TimePoint wake_time = wake_time_.load();
+  while (target_time < wake_time &&
+         !wake_time_.compare_exchange_weak(wake_time, target_time)) {
+  }
+  has_wake_time_ = true;
+}
+
+void TaskQueueIngress::DrainInto(TaskSource& task_source) {
+  Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+  has_wake_time_ = false;
+  wake_time_ = fml::TimePoint::Max();
+  while (node) {
+    task_source.RegisterTask(std::move(node->task));
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+std::optional<fml::TimePoint> TaskQueueIngress::GetWakeTime() const {
+  if (!has_wake_time_) {
+    return std::nullopt;
+  }
+  return wake_time_.load();
+}
+
 TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
     : subsumed_by(_kUnmerged), created_for(created_for_arg) {
   wakeable = NULL;
@@ -48,7 +96,7 @@ MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
   ++task_queue_id_counter_;
   queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
@@ -56,7 +104,9 @@ TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues()
-    : task_queue_id_counter_(0), order_(0) {
+    : queue_mutex_(fml::SharedMutex::Create()),
+      task_queue_id_counter_(0),
+      order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
 }
@@ -64,7 +114,7 @@ MessageLoopTaskQueues::MessageLoopTaskQueues()
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
@@ -76,10 +126,11 @@ void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == _kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
+  DrainIngressUnlocked(queue_id);
   queue_entry->task_source->ShutDown();
   for (auto& subsumed : subsumed_set) {
     queue_entries_.at(subsumed)->task_source->ShutDown();
@@ -92,37 +143,53 @@ TaskSourceGrade MessageLoopTaskQueues::GetCurrentTaskSourceGrade() {
 
 void MessageLoopTaskQueues::RegisterTask(
     TaskQueueId queue_id,
-    const fml::closure& task,
+    fml::UniqueClosure task,
     fml::TimePoint target_time,
-    fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+    fml::TaskSourceGrade task_source_grade,
+    fml::TaskPriority priority,
+    fml::TimePoint deadline) {
+  // Registering tasks only reads the entries and pushes to the ingress of the
+  // queue, so threads registering tasks don't contend with each other.
+  fml::SharedLock lock(*queue_mutex_);
   size_t order = order_++;
   const auto& queue_entry = queue_entries_.at(queue_id);
-  queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+  // Paused Dart micro tasks don't wake the loop until they are resumed.
+  const bool wakes_loop =
+      task_source_grade != fml::TaskSourceGrade::kDartMicroTasks ||
+      !queue_entry->task_source->IsSecondaryPaused();
+  queue_entry->ingress.Push(
+      {order, std::move(task), target_time, task_source_grade, priority,
+       deadline},
+      wakes_loop);
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != _kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
   }
 
+  // The wake time computed by the last thread to wake the loop includes the
+  // tasks pushed by all threads before it.
+  std::scoped_lock wake_lock(queue_entries_.at(loop_to_wake)->wake_mutex);
   // This can happen when the secondary tasks are paused.
-  if (HasPendingTasksUnlocked(loop_to_wake)) {
-    WakeUpUnlocked(loop_to_wake, GetNextWakeTimeUnlocked(loop_to_wake));
+  if (auto wake_time = GetNextWakeTimeWithIngressUnlocked(loop_to_wake)) {
+    WakeUpUnlocked(loop_to_wake, wake_time.value());
   }
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
+  DrainIngressUnlocked(queue_id);
   return HasPendingTasksUnlocked(queue_id);
 }
 
-fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
-                                                     fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+fml::UniqueClosure MessageLoopTaskQueues::GetNextTaskToRun(
+    TaskQueueId queue_id,
+    fml::TimePoint from_time) {
+  fml::UniqueLock lock(*queue_mutex_);
+  DrainIngressUnlocked(queue_id);
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
+  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id, from_time);
 
   if (!HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, fml::TimePoint::Max());
@@ -133,10 +200,12 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
-  fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
+  // The top task refers to the heap entry that is about to be popped.
   const auto task_source_grade = top.task.GetTaskSourceGrade();
+  fml::UniqueClosure invocation =
+      queue_entries_.at(top.task_queue_id)
+          ->task_source->PopTask(task_source_grade, top.task.GetPriority())
+          .TakeTask();
   tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
   return invocation;
 }
@@ -149,11 +218,12 @@ void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   const auto& queue_entry = queue_entries_.at(queue_id);
   if (queue_entry->subsumed_by != _kUnmerged) {
     return 0;
   }
+  DrainIngressUnlocked(queue_id);
 
   size_t total_tasks = 0;
   total_tasks += queue_entry->task_source->GetNumPendingTasks();
@@ -169,20 +239,20 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
   queue_entries_.at(queue_id)->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   queue_entries_.at(queue_id)->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_mutex_);
   std::vector<fml::closure> observers;
 
   if (queue_entries_.at(queue_id)->subsumed_by != _kUnmerged) {
@@ -205,7 +275,7 @@ std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
       << "Wakeable can only be set once.";
   queue_entries_.at(queue_id)->wakeable = wakeable;
@@ -215,7 +285,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   auto& owner_entry = queue_entries_.at(owner);
   auto& subsumed_entry = queue_entries_.at(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
@@ -252,6 +322,8 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
     return false;
   }
   // All checking is OK, set merged state.
+  DrainIngressUnlocked(owner);
+  DrainIngressUnlocked(subsumed);
   owner_entry->owner_of.insert(subsumed);
   subsumed_entry->subsumed_by = owner;
 
@@ -263,7 +335,7 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   const auto& owner_entry = queue_entries_.at(owner);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
@@ -291,6 +363,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
     return false;
   }
 
+  DrainIngressUnlocked(owner);
   queue_entries_.at(subsumed)->subsumed_by = _kUnmerged;
   owner_entry->owner_of.erase(subsumed);
 
@@ -307,7 +380,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_mutex_);
   if (owner == _kUnmerged || subsumed == _kUnmerged) {
     return false;
   }
@@ -317,17 +390,18 @@ bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
+  fml::SharedLock lock(*queue_mutex_);
   return queue_entries_.at(owner)->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
   queue_entries_.at(queue_id)->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
+  fml::UniqueLock lock(*queue_mutex_);
+  DrainIngressUnlocked(queue_id);
   queue_entries_.at(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
@@ -356,28 +430,64 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
       });
 }
 
+void MessageLoopTaskQueues::DrainIngressUnlocked(TaskQueueId queue_id) const {
+  const auto& entry = queue_entries_.at(queue_id);
+  entry->ingress.DrainInto(*entry->task_source);
+  for (TaskQueueId subsumed : entry->owner_of) {
+    const auto& subsumed_entry = queue_entries_.at(subsumed);
+    subsumed_entry->ingress.DrainInto(*subsumed_entry->task_source);
+  }
+}
+
+std::optional<fml::TimePoint>
+MessageLoopTaskQueues::GetNextWakeTimeWithIngressUnlocked(
+    TaskQueueId queue_id) const {
+  std::optional<fml::TimePoint> wake_time;
+  if (HasPendingTasksUnlocked(queue_id)) {
+    wake_time = GetNextWakeTimeUnlocked(queue_id);
+  }
+  auto update_wake_time = [&wake_time](const TaskQueueIngress& ingress) {
+    auto ingress_wake_time = ingress.GetWakeTime();
+    if (ingress_wake_time.has_value() &&
+        (!wake_time.has_value() || ingress_wake_time < wake_time)) {
+      wake_time = ingress_wake_time;
+    }
+  };
+  const auto& entry = queue_entries_.at(queue_id);
+  update_wake_time(entry->ingress);
+  for (TaskQueueId subsumed : entry->owner_of) {
+    update_wake_time(queue_entries_.at(subsumed)->ingress);
+  }
+  return wake_time;
+}
+
 fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
     TaskQueueId queue_id) const {
-  return PeekNextTaskUnlocked(queue_id).task.GetTargetTime();
+  // If any task is due, the next task is one of the due tasks, and the loop
+  // wakes immediately. Otherwise it is the task with the earliest target time.
+  return PeekNextTaskUnlocked(queue_id, fml::TimePoint::Now())
+      .task.GetTargetTime();
 }
 
 TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
+    TaskQueueId owner,
+    fml::TimePoint now) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
   const auto& entry = queue_entries_.at(owner);
   if (entry->owner_of.empty()) {
     FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+    return entry->task_source->Top(now);
   }
 
   // Use optional for the memory of TopTask object.
   std::optional<TaskSource::TopTask> top_task;
 
   std::function<void(const TaskSource*)> top_task_updater =
-      [&top_task](const TaskSource* source) {
+      [&top_task, now](const TaskSource* source) {
         if (source && !source->IsEmpty()) {
-          TaskSource::TopTask other_task = source->Top();
-          if (!top_task.has_value() || top_task->task > other_task.task) {
+          TaskSource::TopTask other_task = source->Top(now);
+          if (!top_task.has_value() ||
+              other_task.task.RunsBefore(top_task->task, now)) {
             top_task.emplace(other_task);
           }
         }
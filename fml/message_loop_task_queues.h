@@ -5,9 +5,11 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -16,14 +18,56 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source.h"
+#include "flutter/fml/unique_closure.h"
 #include "flutter/fml/wakeable.h"
 
 namespace fml {
 
 static const TaskQueueId _kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 
+/// The tasks registered with a TaskQueue that have not been moved to its
+/// \p TaskSource yet.
+///
+/// Any number of threads may push tasks concurrently without taking a lock.
+/// The tasks are moved to the task source by the thread that holds the lock of
+/// \p fml::MessageLoopTaskQueues exclusively, usually the thread of the loop
+/// looking for the next task to run.
+class TaskQueueIngress {
+ public:
+  TaskQueueIngress();
+
+  ~TaskQueueIngress();
+
+  /// Pushes the task. If |wakes_loop| is false, the task is not considered by
+  /// |GetWakeTime|.
+  void Push(DelayedTask task, bool wakes_loop);
+
+  /// Moves the pushed tasks to |task_source|. Must not be called concurrently
+  /// with |Push| or with itself.
+  void DrainInto(TaskSource& task_source);
+
+  /// The earliest target time of the pushed tasks that wake the loop, or
+  /// std::nullopt if there are none.
+  std::optional<fml::TimePoint> GetWakeTime() const;
+
+ private:
+  struct Node {
+    DelayedTask task;
+    Node* next;
+  };
+
+  // The most recently pushed task. Tasks are ordered by their target time and
+  // order when they are drained, so the order of the list doesn't matter.
+  std::atomic<Node*> head_ = nullptr;
+  std::atomic<bool> has_wake_time_ = false;
+  std::atomic<fml::TimePoint> wake_time_ = fml::TimePoint::Max();
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskQueueIngress);
+};
+
 /// A collection of tasks and observers associated with one TaskQueue.
 ///
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
@@ -35,6 +79,11 @@ class TaskQueueEntry {
   Wakeable* wakeable;
   TaskObservers task_observers;
   std::unique_ptr<TaskSource> task_source;
+  TaskQueueIngress ingress;
+
+  /// Serializes the wake ups of this TaskQueue by the threads registering
+  /// tasks, which only hold the lock of \p fml::MessageLoopTaskQueues shared.
+  std::mutex wake_mutex;
 
   /// Set of the TaskQueueIds which is owned by this TaskQueue. If the set is
   /// empty, this TaskQueue does not own any other TaskQueues.
@@ -78,14 +127,17 @@ class MessageLoopTaskQueues {
   // Tasks methods.
 
   void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
+                    fml::UniqueClosure task,
                     fml::TimePoint target_time,
                     fml::TaskSourceGrade task_source_grade =
-                        fml::TaskSourceGrade::kUnspecified);
+                        fml::TaskSourceGrade::kUnspecified,
+                    fml::TaskPriority priority = fml::TaskPriority::kNormal,
+                    fml::TimePoint deadline = fml::TimePoint::Max());
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::UniqueClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                      fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
@@ -148,11 +200,25 @@ class MessageLoopTaskQueues {
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  // Moves the tasks in the ingress of the queue and the queues it owns to
+  // their task sources. Requires the lock to be held exclusively. Doesn't
+  // change which tasks are pending, so is allowed in const methods.
+  void DrainIngressUnlocked(TaskQueueId queue_id) const;
+
+  // The time to wake the loop of |queue_id| at, including the tasks that are
+  // still in the ingress queues, or std::nullopt if it has no pending tasks.
+  // Only requires the lock to be held shared.
+  std::optional<fml::TimePoint> GetNextWakeTimeWithIngressUnlocked(
+      TaskQueueId queue_id) const;
+
+  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner,
+                                           fml::TimePoint now) const;
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
+  // Held shared while registering tasks, which only pushes them to the
+  // ingress of their queue, and exclusively for everything else.
+  std::unique_ptr<fml::SharedMutex> queue_mutex_;
   std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   size_t task_queue_id_counter_;
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 
 namespace fml {
@@ -44,7 +45,7 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
         const auto now = fml::TimePoint::Now();
         int num_invocations = 0;
         for (;;) {
-          fml::closure invocation =
+          fml::UniqueClosure invocation =
               task_queue->GetNextTaskToRun(TaskQueueId(task_runner_id), now);
           if (!invocation) {
             break;
@@ -66,5 +67,51 @@ static void BM_RegisterAndGetTasks(benchmark::State& state) {  // NOLINT
 
 BENCHMARK(BM_RegisterAndGetTasks);
 
+// Posts tasks from several threads outside of the loop, each of which posts
+// more tasks from the worker that runs it, like image decodes that fan out
+// into smaller pieces of work.
+static void BM_ConcurrentMessageLoopThroughput(  // NOLINT
+    benchmark::State& state) {
+  const size_t worker_count = static_cast<size_t>(state.range(0));
+  const int num_posting_threads = 4;
+  const int num_tasks_per_thread = 250;
+  const int num_subtasks_per_task = 4;
+  const int total_tasks =
+      num_posting_threads * num_tasks_per_thread * (1 + num_subtasks_per_task);
+
+  auto loop = fml::ConcurrentMessageLoop::Create(worker_count);
+  auto task_runner = loop->GetTaskRunner();
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(total_tasks);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_posting_threads; i++) {
+      threads.emplace_back([&task_runner, &tasks_done]() {
+        for (int j = 0; j < num_tasks_per_thread; j++) {
+          task_runner->PostTask([&task_runner, &tasks_done]() {
+            for (int k = 0; k < num_subtasks_per_task; k++) {
+              task_runner->PostTask(
+                  [&tasks_done]() { tasks_done.CountDown(); });
+            }
+            tasks_done.CountDown();
+          });
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    tasks_done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * total_tasks);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopThroughput)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
 }  // namespace benchmarking
 }  // namespace fml
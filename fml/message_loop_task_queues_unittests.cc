@@ -8,8 +8,10 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -108,7 +110,7 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::UniqueClosure invocation = task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -148,7 +150,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -158,6 +161,72 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   }
 }
 
+TEST(MessageLoopTaskQueue, DueFrameCriticalTasksRunFirstOnMergedQueues) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queue->CreateTaskQueue();
+  auto raster_queue = task_queue->CreateTaskQueue();
+  int test_val = 0;
+
+  task_queue->RegisterTask(
+      platform_queue, [&test_val]() { test_val = 2; }, fml::TimePoint::Now(),
+      fml::TaskSourceGrade::kUnspecified, fml::TaskPriority::kHousekeeping);
+  task_queue->RegisterTask(
+      platform_queue, [&test_val]() { test_val = 1; }, fml::TimePoint::Now());
+  task_queue->RegisterTask(
+      raster_queue, [&test_val]() { test_val = 0; }, fml::TimePoint::Now(),
+      fml::TaskSourceGrade::kUnspecified, fml::TaskPriority::kFrameCritical);
+
+  task_queue->Merge(platform_queue, raster_queue);
+  ASSERT_TRUE(task_queue->Owns(platform_queue, raster_queue));
+  const auto now = fml::TimePoint::Now();
+  int expected_value = 0;
+  while (true) {
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
+    if (!invocation) {
+      break;
+    }
+    invocation();
+    ASSERT_EQ(test_val, expected_value);
+    expected_value++;
+  }
+  ASSERT_EQ(expected_value, 3);
+}
+
+TEST(MessageLoopTaskQueue, NormalPriorityTasksRunInTheOrderTheyWerePosted) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto raster_queue = task_queue->CreateTaskQueue();
+  std::vector<std::string> order;
+
+  // The shell posts the rasterizer setup, the frames to draw and the
+  // rasterizer teardown this way, and relies on them running in this order.
+  const auto posted = ChronoTicksSinceEpoch();
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back("setup"); }, posted);
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back("draw"); }, posted);
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back("draw last"); }, posted);
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back("teardown"); }, posted);
+  task_queue->RegisterTask(
+      raster_queue, [&order]() { order.push_back("report timings"); },
+      posted, fml::TaskSourceGrade::kUnspecified,
+      fml::TaskPriority::kHousekeeping);
+
+  const auto now = ChronoTicksSinceEpoch();
+  while (true) {
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
+    if (!invocation) {
+      break;
+    }
+    invocation();
+  }
+  EXPECT_EQ(order, (std::vector<std::string>{"setup", "draw", "draw last",
+                                             "teardown", "report timings"}));
+}
+
 TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
@@ -191,7 +260,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -210,7 +280,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -220,14 +291,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -107,4 +107,37 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Advise(Advice advice) const {
+  if (mapping_ == nullptr) {
+    return false;
+  }
+#if FML_OS_LINUX || FML_OS_ANDROID || FML_OS_MACOSX || FML_OS_IOS
+  int posix_advice = MADV_NORMAL;
+  switch (advice) {
+    case Advice::kNormal:
+      posix_advice = MADV_NORMAL;
+      break;
+    case Advice::kSequential:
+      posix_advice = MADV_SEQUENTIAL;
+      break;
+    case Advice::kRandom:
+      posix_advice = MADV_RANDOM;
+      break;
+    case Advice::kWillNeed:
+      posix_advice = MADV_WILLNEED;
+      break;
+    case Advice::kHugePages:
+#if defined(MADV_HUGEPAGE)
+      posix_advice = MADV_HUGEPAGE;
+      break;
+#else
+      return false;
+#endif
+  }
+  return ::madvise(mapping_, size_, posix_advice) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace fml
@@ -123,4 +123,8 @@ bool FileMapping::IsValid() const {
   return valid_;
 }
 
+bool FileMapping::Advise(Advice advice) const {
+  return false;
+}
+
 }  // namespace fml
@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SHARDED_MAP_H_
+#define FLUTTER_FML_SHARDED_MAP_H_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/synchronization/shared_mutex.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A hash map that may be used from any number of threads.
+///
+///             The entries are split into shards by the hash of their keys,
+///             and each shard has its own reader biased lock. Lookups only
+///             take the lock of their shard shared, so they neither wait for
+///             each other nor for writers to other shards.
+///
+///             Values are only accessed under the lock of their shard, by
+///             copying them out or from within a visitor. Visitors must not
+///             access the map.
+///
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class ShardedMap {
+ public:
+  static constexpr size_t kShardCount = 16u;
+
+  ShardedMap() {
+    for (auto& shard : shards_) {
+      shard.mutex.reset(SharedMutex::CreateReaderBiased());
+    }
+  }
+
+  ~ShardedMap() = default;
+
+  /// Returns a copy of the value of the key, or std::nullopt if there is
+  /// none.
+  std::optional<Value> Find(const Key& key) const {
+    const Shard& shard = GetShard(key);
+    SharedLock lock(*shard.mutex);
+    auto found = shard.entries.find(key);
+    if (found == shard.entries.end()) {
+      return std::nullopt;
+    }
+    return found->second;
+  }
+
+  /// Calls |visitor| with a reference to the value of the key, while the
+  /// shard is locked shared. Returns false if there is no such key.
+  template <typename Visitor>
+  bool VisitShared(const Key& key, Visitor&& visitor) const {
+    const Shard& shard = GetShard(key);
+    SharedLock lock(*shard.mutex);
+    auto found = shard.entries.find(key);
+    if (found == shard.entries.end()) {
+      return false;
+    }
+    visitor(found->second);
+    return true;
+  }
+
+  /// Calls |visitor| with a mutable reference to the value of the key, while
+  /// the shard is locked exclusively. Returns false if there is no such key.
+  template <typename Visitor>
+  bool Visit(const Key& key, Visitor&& visitor) {
+    Shard& shard = GetShard(key);
+    UniqueLock lock(*shard.mutex);
+    auto found = shard.entries.find(key);
+    if (found == shard.entries.end()) {
+      return false;
+    }
+    visitor(found->second);
+    return true;
+  }
+
+  /// Inserts the value if the key isn't in the map. Returns whether it was
+  /// inserted.
+  bool Insert(const Key& key, Value value) {
+    Shard& shard = GetShard(key);
+    UniqueLock lock(*shard.mutex);
+    return shard.entries.try_emplace(key, std::move(value)).second;
+  }
+
+  void InsertOrAssign(const Key& key, Value value) {
+    Shard& shard = GetShard(key);
+    UniqueLock lock(*shard.mutex);
+    shard.entries.insert_or_assign(key, std::move(value));
+  }
+
+  /// Returns whether the key was in the map.
+  bool Erase(const Key& key) {
+    Shard& shard = GetShard(key);
+    UniqueLock lock(*shard.mutex);
+    return shard.entries.erase(key) > 0u;
+  }
+
+  /// Calls |visitor| with the key and a mutable reference to the value of
+  /// each entry, locking one shard exclusively at a time. Entries that the
+  /// visitor returns false for are erased. Entries that are inserted
+  /// concurrently may or may not be visited.
+  template <typename Visitor>
+  void ForEach(Visitor&& visitor) {
+    for (auto& shard : shards_) {
+      UniqueLock lock(*shard.mutex);
+      for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+        if (visitor(it->first, it->second)) {
+          ++it;
+        } else {
+          it = shard.entries.erase(it);
+        }
+      }
+    }
+  }
+
+  /// The number of entries. Only exact if the map isn't being modified
+  /// concurrently.
+  size_t Size() const {
+    size_t size = 0u;
+    for (const auto& shard : shards_) {
+      SharedLock lock(*shard.mutex);
+      size += shard.entries.size();
+    }
+    return size;
+  }
+
+ private:
+  struct Shard {
+    std::unique_ptr<SharedMutex> mutex;
+    std::unordered_map<Key, Value, Hash, Equal> entries;
+  };
+
+  static size_t GetShardIndex(const Key& key) {
+    // Mix the bits, as hashes such as those of integers are often the
+    // identity.
+    size_t hash = Hash{}(key);
+    hash ^= hash >> 17;
+    hash *= 0xed5ad4bbu;
+    hash ^= hash >> 11;
+    return hash % kShardCount;
+  }
+
+  Shard& GetShard(const Key& key) { return shards_[GetShardIndex(key)]; }
+
+  const Shard& GetShard(const Key& key) const {
+    return shards_[GetShardIndex(key)];
+  }
+
+  std::array<Shard, kShardCount> shards_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShardedMap);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SHARDED_MAP_H_
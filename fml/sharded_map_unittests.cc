@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/sharded_map.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(ShardedMapTest, InsertFindAndErase) {
+  ShardedMap<std::string, int> map;
+  EXPECT_FALSE(map.Find("one").has_value());
+  EXPECT_TRUE(map.Insert("one", 1));
+  EXPECT_FALSE(map.Insert("one", 2));
+  EXPECT_EQ(map.Find("one"), 1);
+  map.InsertOrAssign("one", 3);
+  EXPECT_EQ(map.Find("one"), 3);
+  EXPECT_EQ(map.Size(), 1u);
+  EXPECT_TRUE(map.Erase("one"));
+  EXPECT_FALSE(map.Erase("one"));
+  EXPECT_EQ(map.Size(), 0u);
+}
+
+TEST(ShardedMapTest, VisitsValues) {
+  ShardedMap<int, int> map;
+  map.Insert(1, 10);
+  EXPECT_TRUE(map.Visit(1, [](int& value) { value++; }));
+  int seen = 0;
+  EXPECT_TRUE(map.VisitShared(1, [&seen](const int& value) { seen = value; }));
+  EXPECT_EQ(seen, 11);
+  EXPECT_FALSE(map.Visit(2, [](int& value) { FAIL(); }));
+}
+
+TEST(ShardedMapTest, ForEachErasesRejectedEntries) {
+  ShardedMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.Insert(i, i);
+  }
+  int visited = 0;
+  map.ForEach([&visited](const int& key, int& value) {
+    visited++;
+    value *= 2;
+    return key % 2 == 0;
+  });
+  EXPECT_EQ(visited, 100);
+  EXPECT_EQ(map.Size(), 50u);
+  EXPECT_EQ(map.Find(4), 8);
+  EXPECT_FALSE(map.Find(5).has_value());
+}
+
+TEST(ShardedMapTest, ConcurrentInsertsAndLookups) {
+  ShardedMap<int, int> map;
+  constexpr int kKeysPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&map, t]() {
+      for (int i = 0; i < kKeysPerThread; i++) {
+        int key = t * kKeysPerThread + i;
+        map.Insert(key, key);
+        EXPECT_EQ(map.Find(key), key);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(map.Size(), 4u * kKeysPerThread);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -11,6 +11,13 @@ namespace fml {
 class SharedMutex {
  public:
   static SharedMutex* Create();
+
+  // Creates a reader/writer lock for data that is read far more often than it
+  // is written. Readers on different threads don't write to the same cache
+  // lines, so they don't slow each other down. Writers are more expensive,
+  // and are preferred over readers.
+  static SharedMutex* CreateReaderBiased();
+
   virtual ~SharedMutex() = default;
 
   virtual void Lock() = 0;
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/shared_mutex_reader_biased.h"
+
+#include <thread>
+
+namespace fml {
+
+SharedMutex* SharedMutex::CreateReaderBiased() {
+  return new SharedMutexReaderBiased();
+}
+
+SharedMutexReaderBiased::SharedMutexReaderBiased() = default;
+
+size_t SharedMutexReaderBiased::GetCurrentThreadSlot() {
+  // Threads are assigned slots round robin, so that the threads that run at
+  // the same time rarely share a slot.
+  static std::atomic<size_t> next_slot = 0u;
+  thread_local size_t slot = next_slot++ % kReaderSlotCount;
+  return slot;
+}
+
+void SharedMutexReaderBiased::Lock() {
+  writer_mutex_.lock();
+  writer_active_.store(true, std::memory_order_seq_cst);
+  for (auto& slot : reader_slots_) {
+    while (slot.readers.load(std::memory_order_seq_cst) != 0u) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void SharedMutexReaderBiased::LockShared() {
+  auto& slot = reader_slots_[GetCurrentThreadSlot()];
+  for (;;) {
+    slot.readers.fetch_add(1u, std::memory_order_seq_cst);
+    if (!writer_active_.load(std::memory_order_seq_cst)) {
+      return;
+    }
+    // Let the writer in, and wait for it to finish.
+    slot.readers.fetch_sub(1u, std::memory_order_release);
+    std::scoped_lock wait_for_writer(writer_mutex_);
+  }
+}
+
+void SharedMutexReaderBiased::Unlock() {
+  writer_active_.store(false, std::memory_order_release);
+  writer_mutex_.unlock();
+}
+
+void SharedMutexReaderBiased::UnlockShared() {
+  reader_slots_[GetCurrentThreadSlot()].readers.fetch_sub(
+      1u, std::memory_order_release);
+}
+
+}  // namespace fml
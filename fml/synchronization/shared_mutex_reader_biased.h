@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_SYNCHRONIZATION_SHARED_MUTEX_READER_BIASED_H_
+#define FLUTTER_FML_SYNCHRONIZATION_SHARED_MUTEX_READER_BIASED_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+#include "flutter/fml/synchronization/shared_mutex.h"
+
+namespace fml {
+
+// A reader/writer lock that counts the readers of each thread in one of
+// several counters, each on its own cache line. A writer announces itself,
+// then waits for all of the counters to drop to zero. Readers that see a
+// writer back off and wait for it to finish.
+class SharedMutexReaderBiased : public SharedMutex {
+ public:
+  static constexpr size_t kReaderSlotCount = 16u;
+
+  virtual void Lock();
+  virtual void LockShared();
+  virtual void Unlock();
+  virtual void UnlockShared();
+
+ private:
+  friend SharedMutex* SharedMutex::CreateReaderBiased();
+  SharedMutexReaderBiased();
+
+  struct alignas(64) ReaderSlot {
+    std::atomic<size_t> readers = 0u;
+  };
+
+  static size_t GetCurrentThreadSlot();
+
+  std::array<ReaderSlot, kReaderSlotCount> reader_slots_;
+  std::atomic<bool> writer_active_ = false;
+  // Held by the writer, and by the readers waiting for it.
+  std::mutex writer_mutex_;
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_SYNCHRONIZATION_SHARED_MUTEX_READER_BIASED_H_
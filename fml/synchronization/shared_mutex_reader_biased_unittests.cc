@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/synchronization/shared_mutex.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(SharedMutexReaderBiasedTest, ReadersShareTheLock) {
+  std::unique_ptr<SharedMutex> mutex(SharedMutex::CreateReaderBiased());
+  SharedLock first(*mutex);
+  std::thread thread([&mutex]() { SharedLock second(*mutex); });
+  thread.join();
+}
+
+TEST(SharedMutexReaderBiasedTest, WritersExcludeReadersAndWriters) {
+  std::unique_ptr<SharedMutex> mutex(SharedMutex::CreateReaderBiased());
+  constexpr int kIterations = 1000;
+  // Only modified by writers, so readers must always see an even value.
+  int value = 0;
+  std::atomic<bool> saw_odd_value = false;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kIterations; j++) {
+        UniqueLock lock(*mutex);
+        value++;
+        value++;
+      }
+    });
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kIterations; j++) {
+        SharedLock lock(*mutex);
+        if (value % 2 != 0) {
+          saw_odd_value = true;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(saw_odd_value);
+  EXPECT_EQ(value, 4 * 2 * kIterations);
+}
+
+}  // namespace testing
+}  // namespace fml
@@ -0,0 +1,40 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_PRIORITY_H_
+#define FLUTTER_FML_TASK_PRIORITY_H_
+
+#include <cstddef>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+/**
+ * How urgently a task should run once its target time has passed. Of the
+ * tasks that are due on a `MessageLoopTaskQueues` queue, the ones with the
+ * highest priority run first, and tasks of the same priority run in the order
+ * of their target times.
+ */
+enum class TaskPriority {
+  /// Work that a frame is waiting on, such as beginning or drawing it.
+  kFrameCritical,
+  /// The absence of a specialized `TaskPriority`.
+  kNormal,
+  /// Work that may be delayed until the frame critical work is done, such as
+  /// idle notifications and reporting timings.
+  kHousekeeping,
+};
+
+constexpr size_t kTaskPriorityCount =
+    static_cast<size_t>(TaskPriority::kHousekeeping) + 1;
+
+/// How long after their target time housekeeping tasks are posted to run at
+/// the latest, after which they are treated as frame critical.
+constexpr TimeDelta kHousekeepingTaskMaxDelay =
+    TimeDelta::FromMilliseconds(100);
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_PRIORITY_H_
@@ -35,6 +35,13 @@ void TaskRunner::PostDelayedTask(const fml::closure& task,
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
 }
 
+void TaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                      fml::TaskPriority priority,
+                                      fml::TimePoint target_time,
+                                      fml::TimePoint deadline) {
+  loop_->PostTask(task, target_time, priority, deadline);
+}
+
 TaskQueueId TaskRunner::GetTaskQueueId() {
   FML_DCHECK(loop_);
   return loop_->GetTaskQueueId();
@@ -10,6 +10,7 @@
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
@@ -49,6 +50,17 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// tens of milliseconds.
   virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
 
+  /// Schedules \p task to be run on the MessageLoop once \p target_time has
+  /// passed. Of the tasks that are due, the ones with the highest \p priority
+  /// run first. Once \p deadline has passed the task is treated as
+  /// \p TaskPriority::kFrameCritical, so that it cannot be starved.
+  /// \see fml::TaskPriority
+  virtual void PostTaskWithPriority(
+      const fml::closure& task,
+      fml::TaskPriority priority,
+      fml::TimePoint target_time,
+      fml::TimePoint deadline = fml::TimePoint::Max());
+
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
   virtual bool RunsTasksOnCurrentThread();
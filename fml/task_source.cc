@@ -6,6 +6,8 @@
 
 #include "flutter/fml/task_source.h"
 
+#include <utility>
+
 namespace fml {
 
 TaskSource::TaskSource(TaskQueueId task_queue_id)
@@ -16,42 +18,47 @@ TaskSource::~TaskSource() {
 }
 
 void TaskSource::ShutDown() {
-  primary_task_queue_ = {};
-  secondary_task_queue_ = {};
+  primary_task_queues_ = {};
+  secondary_task_queues_ = {};
 }
 
-void TaskSource::RegisterTask(const DelayedTask& task) {
+void TaskSource::RegisterTask(DelayedTask task) {
+  const size_t priority = static_cast<size_t>(task.GetPriority());
   switch (task.GetTaskSourceGrade()) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
+      primary_task_queues_[priority].push(std::move(task));
       break;
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
+      primary_task_queues_[priority].push(std::move(task));
       break;
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.push(task);
+      secondary_task_queues_[priority].push(std::move(task));
       break;
   }
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
+DelayedTask TaskSource::PopTask(TaskSourceGrade grade, TaskPriority priority) {
+  const size_t index = static_cast<size_t>(priority);
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queues_[index].Pop();
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queues_[index].Pop();
     case TaskSourceGrade::kDartMicroTasks:
-      secondary_task_queue_.pop();
-      break;
+      return secondary_task_queues_[index].Pop();
   }
+  FML_UNREACHABLE();
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size = 0;
+  for (const auto& queue : primary_task_queues_) {
+    size += queue.size();
+  }
   if (secondary_pause_requests_ == 0) {
-    size += secondary_task_queue_.size();
+    for (const auto& queue : secondary_task_queues_) {
+      size += queue.size();
+    }
   }
   return size;
 }
@@ -60,35 +67,26 @@ bool TaskSource::IsEmpty() const {
   return GetNumPendingTasks() == 0;
 }
 
-TaskSource::TopTask TaskSource::Top() const {
+TaskSource::TopTask TaskSource::Top(fml::TimePoint now) const {
   FML_CHECK(!IsEmpty());
-  if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = primary_top,
-    };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = secondary_top,
-    };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
+  const DelayedTask* top_task = nullptr;
+  auto update_top_task = [&top_task, now](const PrioritizedTaskQueues& queues) {
+    for (const auto& queue : queues) {
+      if (!queue.empty() &&
+          (!top_task || queue.top().RunsBefore(*top_task, now))) {
+        top_task = &queue.top();
+      }
     }
+  };
+  update_top_task(primary_task_queues_);
+  if (secondary_pause_requests_ == 0) {
+    update_top_task(secondary_task_queues_);
   }
+  FML_CHECK(top_task);
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *top_task,
+  };
 }
 
 void TaskSource::PauseSecondary() {
@@ -100,4 +98,8 @@ void TaskSource::ResumeSecondary() {
   FML_DCHECK(secondary_pause_requests_ >= 0);
 }
 
+bool TaskSource::IsSecondaryPaused() const {
+  return secondary_pause_requests_ > 0;
+}
+
 }  // namespace fml
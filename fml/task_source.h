@@ -5,7 +5,10 @@
 #ifndef FLUTTER_FML_TASK_SOURCE_H_
 #define FLUTTER_FML_TASK_SOURCE_H_
 
+#include <array>
+
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
 
@@ -18,7 +21,8 @@ class MessageLoopTaskQueues;
  * wrapper around a primary and secondary task heap with the difference between
  * them being that the secondary task heap can be paused and resumed by the task
  * dispatcher. `TaskSourceGrade` determines what task heap the task is assigned
- * to.
+ * to. Each heap is split by `TaskPriority`, so that a due task of a higher
+ * priority is never stuck behind the tasks of a lower one.
  *
  * Registering Tasks
  * -----------------
@@ -49,10 +53,12 @@ class TaskSource {
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade` and the
+  /// `TaskPriority`, and returns the task that was on top of it.
+  DelayedTask PopTask(TaskSourceGrade grade,
+                      TaskPriority priority = TaskPriority::kNormal);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -61,9 +67,11 @@ class TaskSource {
   /// Returns true if `GetNumPendingTasks` is zero.
   bool IsEmpty() const;
 
-  /// Returns the top task based on scheduled time, taking into account whether
-  /// the secondary heap has been paused or not.
-  TopTask Top() const;
+  /// Returns the task that should run first at `now`, taking into account
+  /// whether the secondary heap has been paused or not. Of the tasks that are
+  /// due at `now` this is the one with the highest priority, otherwise it is
+  /// the one scheduled first. See `DelayedTask::RunsBefore`.
+  TopTask Top(fml::TimePoint now) const;
 
   /// Pause providing tasks from secondary task heap.
   void PauseSecondary();
@@ -71,10 +79,16 @@ class TaskSource {
   /// Resume providing tasks from secondary task heap.
   void ResumeSecondary();
 
+  /// Returns true if providing tasks from secondary task heap is paused.
+  bool IsSecondaryPaused() const;
+
  private:
+  using PrioritizedTaskQueues =
+      std::array<fml::DelayedTaskQueue, kTaskPriorityCount>;
+
   const fml::TaskQueueId task_queue_id_;
-  fml::DelayedTaskQueue primary_task_queue_;
-  fml::DelayedTaskQueue secondary_task_queue_;
+  PrioritizedTaskQueues primary_task_queues_;
+  PrioritizedTaskQueues secondary_task_queues_;
   int secondary_pause_requests_ = 0;
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
@@ -42,10 +42,10 @@ TEST(TaskSourceTests, SimpleOrdering) {
   task_source.RegisterTask({2, [&] { value = 7; },
                             time_stamp + fml::TimeDelta::FromMilliseconds(1),
                             TaskSourceGrade::kUnspecified});
-  task_source.Top().task.GetTask()();
+  task_source.Top(fml::TimePoint::Now()).task.GetTask()();
   task_source.PopTask(TaskSourceGrade::kUnspecified);
   ASSERT_EQ(value, 1);
-  task_source.Top().task.GetTask()();
+  task_source.Top(fml::TimePoint::Now()).task.GetTask()();
   task_source.PopTask(TaskSourceGrade::kUnspecified);
   ASSERT_EQ(value, 7);
 }
@@ -59,12 +59,12 @@ TEST(TaskSourceTests, SimpleOrderingMultiTaskHeaps) {
   task_source.RegisterTask({2, [&] { value = 7; },
                             time_stamp + fml::TimeDelta::FromMilliseconds(1),
                             TaskSourceGrade::kUserInteraction});
-  auto top_task = task_source.Top();
+  auto top_task = task_source.Top(fml::TimePoint::Now());
   top_task.task.GetTask()();
   task_source.PopTask(top_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 1);
 
-  auto second_task = task_source.Top();
+  auto second_task = task_source.Top(fml::TimePoint::Now());
   second_task.task.GetTask()();
   task_source.PopTask(second_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 7);
@@ -82,7 +82,7 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
 
   task_source.PauseSecondary();
 
-  auto top_task = task_source.Top();
+  auto top_task = task_source.Top(fml::TimePoint::Now());
   top_task.task.GetTask()();
   task_source.PopTask(top_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 7);
@@ -91,11 +91,66 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
 
   task_source.ResumeSecondary();
 
-  auto second_task = task_source.Top();
+  auto second_task = task_source.Top(fml::TimePoint::Now());
   second_task.task.GetTask()();
   task_source.PopTask(second_task.task.GetTaskSourceGrade());
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, DueTasksRunInPriorityOrder) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto now = time_stamp + fml::TimeDelta::FromMilliseconds(10);
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 1; }, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kHousekeeping});
+  task_source.RegisterTask({2, [&] { value = 2; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUnspecified});
+  task_source.RegisterTask({3, [&] { value = 3; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(2),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kFrameCritical});
+  // Not due yet, so it doesn't run before the due tasks.
+  task_source.RegisterTask({4, [&] { value = 4; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(20),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kFrameCritical});
+
+  for (int expected_value : {3, 2, 1}) {
+    auto top_task = task_source.Top(now);
+    top_task.task.GetTask()();
+    task_source.PopTask(top_task.task.GetTaskSourceGrade(),
+                        top_task.task.GetPriority());
+    ASSERT_EQ(value, expected_value);
+  }
+
+  auto last_task = task_source.Top(now);
+  ASSERT_EQ(last_task.task.GetTargetTime(),
+            time_stamp + fml::TimeDelta::FromMilliseconds(20));
+}
+
+TEST(TaskSourceTests, TasksPastTheirDeadlineAreFrameCritical) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto now = time_stamp + fml::TimeDelta::FromMilliseconds(10);
+  int value = 0;
+  task_source.RegisterTask({1, [&] { value = 1; },
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kFrameCritical});
+  task_source.RegisterTask(
+      {2, [&] { value = 2; }, time_stamp, TaskSourceGrade::kUnspecified,
+       TaskPriority::kHousekeeping,
+       time_stamp + fml::TimeDelta::FromMilliseconds(5)});
+
+  auto top_task = task_source.Top(now);
+  ASSERT_EQ(top_task.task.GetEffectivePriority(now),
+            TaskPriority::kFrameCritical);
+  top_task.task.GetTask()();
+  ASSERT_EQ(value, 2);
+}
+
 }  // namespace testing
 }  // namespace fml
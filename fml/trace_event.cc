@@ -11,6 +11,7 @@
 #include "flutter/fml/ascii_trie.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_ring_buffer.h"
 
 namespace fml {
 namespace tracing {
@@ -34,6 +35,10 @@ inline void FlutterTimelineEvent(const char* label,
                                  intptr_t argument_count,
                                  const char** argument_names,
                                  const char** argument_values) {
+  if (TraceRingBufferIsEnabled()) {
+    TraceRingBufferRecord(label, timestamp0, timestamp1_or_async_id, type,
+                          argument_count, argument_names, argument_values);
+  }
   TimelineEventHandler handler =
       gTimelineEventHandler.load(std::memory_order_relaxed);
   if (handler && gAllowlist.Query(label)) {
@@ -0,0 +1,350 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+namespace tracing {
+
+namespace {
+
+struct RingEvent {
+  int64_t timestamp_micros = 0;
+  int64_t timestamp1_or_id = 0;
+  uint32_t name_id = 0u;
+  // Zero if the event has no arguments.
+  uint32_t argument_name_id = 0u;
+  uint8_t type = 0u;
+  char argument_value[kTraceRingBufferArgumentSize] = {};
+};
+
+// Interned names are never freed, so that the pointers cached by the threads
+// stay valid.
+class NameTable {
+ public:
+  // Ids start at one, zero means no name.
+  uint32_t Intern(const char* name, const char** interned_name) {
+    std::string_view view(name);
+    std::scoped_lock lock(mutex_);
+    auto found = ids_.find(view);
+    if (found != ids_.end()) {
+      *interned_name = names_[found->second - 1].get();
+      return found->second;
+    }
+    auto copy = std::make_unique<char[]>(view.size() + 1);
+    std::memcpy(copy.get(), view.data(), view.size());
+    copy[view.size()] = '\0';
+    *interned_name = copy.get();
+    names_.emplace_back(std::move(copy));
+    uint32_t id = static_cast<uint32_t>(names_.size());
+    ids_[std::string_view(*interned_name, view.size())] = id;
+    return id;
+  }
+
+  std::vector<const char*> GetNames() const {
+    std::scoped_lock lock(mutex_);
+    std::vector<const char*> names;
+    names.reserve(names_.size());
+    for (const auto& name : names_) {
+      names.push_back(name.get());
+    }
+    return names;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<char[]>> names_;
+  std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+// Written by one thread and read by any thread. The writer never waits for
+// readers. Readers detect the events that were overwritten while they were
+// being copied and drop them.
+class ThreadRing {
+ public:
+  explicit ThreadRing(int64_t thread_id) : thread_id_(thread_id) {}
+
+  int64_t GetThreadId() const { return thread_id_; }
+
+  void Append(const RingEvent& event) {
+    const uint64_t index = write_count_.load(std::memory_order_relaxed);
+    events_[index % kSlotCount] = event;
+    write_count_.store(index + 1, std::memory_order_release);
+  }
+
+  void CopyEvents(std::vector<RingEvent>& events) const {
+    const uint64_t end = write_count_.load(std::memory_order_acquire);
+    const uint64_t begin = std::max(
+        FirstRetainedIndex(end), clear_count_.load(std::memory_order_relaxed));
+    std::vector<RingEvent> copied;
+    for (uint64_t index = begin; index < end; ++index) {
+      copied.push_back(events_[index % kSlotCount]);
+    }
+    // The writer may have lapped the copy, and may be writing the slot after
+    // the last event it has published.
+    const uint64_t end_after_copy =
+        write_count_.load(std::memory_order_acquire);
+    const uint64_t first_intact =
+        end_after_copy + 1 > kSlotCount ? end_after_copy + 1 - kSlotCount : 0u;
+    for (uint64_t index = begin; index < end; ++index) {
+      if (index >= first_intact) {
+        events.push_back(copied[index - begin]);
+      }
+    }
+  }
+
+  void Clear() {
+    clear_count_.store(write_count_.load(std::memory_order_acquire),
+                       std::memory_order_relaxed);
+  }
+
+  // Interned names of the thread, keyed by the pointers they were traced with.
+  // Only used by the writer.
+  std::unordered_map<const char*, std::pair<uint32_t, const char*>>
+      name_cache;
+
+ private:
+  // One more than the capacity, for the slot that is being written.
+  static constexpr uint64_t kSlotCount = kTraceRingBufferCapacity + 1u;
+
+  static uint64_t FirstRetainedIndex(uint64_t end) {
+    return end > kTraceRingBufferCapacity ? end - kTraceRingBufferCapacity
+                                          : 0u;
+  }
+
+  const int64_t thread_id_;
+  std::array<RingEvent, kSlotCount> events_;
+  std::atomic<uint64_t> write_count_ = 0u;
+  std::atomic<uint64_t> clear_count_ = 0u;
+};
+
+std::atomic_bool gRingBufferEnabled = false;
+
+NameTable& GetNameTable() {
+  static NameTable* table = new NameTable();
+  return *table;
+}
+
+std::mutex& GetRingsMutex() {
+  static std::mutex* mutex = new std::mutex();
+  return *mutex;
+}
+
+std::vector<std::shared_ptr<ThreadRing>>& GetRings() {
+  static auto* rings = new std::vector<std::shared_ptr<ThreadRing>>();
+  return *rings;
+}
+
+// Registers the ring of a thread on its first event, and unregisters it when
+// the thread exits.
+class ThreadRingRegistration {
+ public:
+  ThreadRingRegistration() {
+    static std::atomic<int64_t> last_thread_id = 0;
+    ring_ = std::make_shared<ThreadRing>(++last_thread_id);
+    std::scoped_lock lock(GetRingsMutex());
+    GetRings().push_back(ring_);
+  }
+
+  ~ThreadRingRegistration() {
+    std::scoped_lock lock(GetRingsMutex());
+    auto& rings = GetRings();
+    rings.erase(std::remove(rings.begin(), rings.end(), ring_), rings.end());
+  }
+
+  ThreadRing& GetRing() { return *ring_; }
+
+ private:
+  std::shared_ptr<ThreadRing> ring_;
+};
+
+ThreadRing& GetCurrentThreadRing() {
+  thread_local ThreadRingRegistration registration;
+  return registration.GetRing();
+}
+
+uint32_t InternName(ThreadRing& ring, const char* name) {
+  auto found = ring.name_cache.find(name);
+  // Names that aren't literals may reuse the storage of other names.
+  if (found != ring.name_cache.end() &&
+      std::strcmp(found->second.second, name) == 0) {
+    return found->second.first;
+  }
+  const char* interned_name = nullptr;
+  uint32_t id = GetNameTable().Intern(name, &interned_name);
+  ring.name_cache[name] = {id, interned_name};
+  return id;
+}
+
+const char* GetPhase(uint8_t type) {
+  switch (static_cast<Dart_Timeline_Event_Type>(type)) {
+    case Dart_Timeline_Event_Begin:
+      return "B";
+    case Dart_Timeline_Event_End:
+      return "E";
+    case Dart_Timeline_Event_Instant:
+      return "i";
+    case Dart_Timeline_Event_Duration:
+      return "X";
+    case Dart_Timeline_Event_Async_Begin:
+      return "b";
+    case Dart_Timeline_Event_Async_End:
+      return "e";
+    case Dart_Timeline_Event_Async_Instant:
+      return "n";
+    case Dart_Timeline_Event_Counter:
+      return "C";
+    case Dart_Timeline_Event_Flow_Begin:
+      return "s";
+    case Dart_Timeline_Event_Flow_Step:
+      return "t";
+    case Dart_Timeline_Event_Flow_End:
+      return "f";
+    default:
+      return "i";
+  }
+}
+
+void WriteJSONString(std::ostream& stream, const char* string) {
+  stream << '"';
+  for (const char* c = string; *c != '\0'; ++c) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          stream << ' ';
+        } else {
+          stream << *c;
+        }
+    }
+  }
+  stream << '"';
+}
+
+}  // namespace
+
+void TraceRingBufferSetEnabled(bool enabled) {
+  gRingBufferEnabled = enabled;
+}
+
+bool TraceRingBufferIsEnabled() {
+  return gRingBufferEnabled.load(std::memory_order_relaxed);
+}
+
+void TraceRingBufferRecord(const char* name,
+                           int64_t timestamp_micros,
+                           int64_t timestamp1_or_id,
+                           Dart_Timeline_Event_Type type,
+                           intptr_t argument_count,
+                           const char** argument_names,
+                           const char** argument_values) {
+  if (name == nullptr) {
+    return;
+  }
+  ThreadRing& ring = GetCurrentThreadRing();
+  RingEvent event;
+  // The timeline clock isn't set until the Dart VM is.
+  event.timestamp_micros =
+      timestamp_micros >= 0
+          ? timestamp_micros
+          : fml::TimePoint::Now().ToEpochDelta().ToMicroseconds();
+  event.timestamp1_or_id = timestamp1_or_id;
+  event.name_id = InternName(ring, name);
+  event.type = static_cast<uint8_t>(type);
+  if (argument_count > 0 && argument_names[0] && argument_values[0]) {
+    event.argument_name_id = InternName(ring, argument_names[0]);
+    std::strncpy(event.argument_value, argument_values[0],
+                 kTraceRingBufferArgumentSize - 1);
+  }
+  ring.Append(event);
+}
+
+std::string TraceRingBufferDump() {
+  std::vector<std::pair<int64_t, std::vector<RingEvent>>> thread_events;
+  {
+    std::scoped_lock lock(GetRingsMutex());
+    for (const auto& ring : GetRings()) {
+      thread_events.emplace_back(ring->GetThreadId(),
+                                 std::vector<RingEvent>{});
+      ring->CopyEvents(thread_events.back().second);
+    }
+  }
+  // Copied after the events, so that all of their names are present.
+  const std::vector<const char*> names = GetNameTable().GetNames();
+  auto get_name = [&names](uint32_t id) {
+    return id > 0 && id <= names.size() ? names[id - 1] : "";
+  };
+
+  std::ostringstream stream;
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& [thread_id, events] : thread_events) {
+    for (const auto& event : events) {
+      stream << (first ? "" : ",") << "{\"name\":";
+      first = false;
+      WriteJSONString(stream, get_name(event.name_id));
+      stream << ",\"cat\":\"flutter\",\"ph\":\"" << GetPhase(event.type)
+             << "\",\"ts\":" << event.timestamp_micros
+             << ",\"pid\":0,\"tid\":" << thread_id;
+      switch (static_cast<Dart_Timeline_Event_Type>(event.type)) {
+        case Dart_Timeline_Event_Duration:
+          stream << ",\"dur\":"
+                 << std::max<int64_t>(
+                        event.timestamp1_or_id - event.timestamp_micros, 0);
+          break;
+        case Dart_Timeline_Event_Async_Begin:
+        case Dart_Timeline_Event_Async_End:
+        case Dart_Timeline_Event_Async_Instant:
+        case Dart_Timeline_Event_Flow_Begin:
+        case Dart_Timeline_Event_Flow_Step:
+        case Dart_Timeline_Event_Flow_End:
+          stream << ",\"id\":" << event.timestamp1_or_id;
+          break;
+        case Dart_Timeline_Event_Instant:
+          stream << ",\"s\":\"t\"";
+          break;
+        default:
+          break;
+      }
+      if (event.argument_name_id != 0) {
+        stream << ",\"args\":{";
+        WriteJSONString(stream, get_name(event.argument_name_id));
+        stream << ":";
+        WriteJSONString(stream, event.argument_value);
+        stream << "}";
+      }
+      stream << "}";
+    }
+  }
+  stream << "]}";
+  return stream.str();
+}
+
+void TraceRingBufferClear() {
+  std::scoped_lock lock(GetRingsMutex());
+  for (const auto& ring : GetRings()) {
+    ring->Clear();
+  }
+}
+
+}  // namespace tracing
+}  // namespace fml
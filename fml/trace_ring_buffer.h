@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TRACE_RING_BUFFER_H_
+#define FLUTTER_FML_TRACE_RING_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "third_party/dart/runtime/include/dart_tools_api.h"
+
+namespace fml {
+namespace tracing {
+
+//------------------------------------------------------------------------------
+/// A recorder of the most recent trace events of each thread that is cheap
+/// enough to be left on in production.
+///
+/// While enabled, every event that goes through the `fml/trace_event.h`
+/// macros is also appended to a fixed size ring buffer of the thread that
+/// traced it, whether or not the timeline is recording. Events are compact
+/// binary records: the names are interned, and only the first argument is
+/// kept, truncated to a few bytes. Appending takes no locks, except the first
+/// time a thread traces an event with a given name.
+///
+/// The ring buffers can be dumped at any time, for instance once a janky
+/// frame is detected, as a trace in the JSON trace event format that Perfetto
+/// and chrome://tracing load.
+///
+/// Events are only recorded in builds that have the trace macros enabled,
+/// see `FLUTTER_TIMELINE_ENABLED`.
+///
+
+/// The number of events of each thread that are kept.
+constexpr size_t kTraceRingBufferCapacity = 1024u;
+
+/// The size of the truncated argument values, including the terminator.
+constexpr size_t kTraceRingBufferArgumentSize = 24u;
+
+void TraceRingBufferSetEnabled(bool enabled);
+
+bool TraceRingBufferIsEnabled();
+
+/// Appends an event to the ring buffer of the current thread. The arguments
+/// match those of the timeline event handler. Only the first argument is
+/// recorded.
+void TraceRingBufferRecord(const char* name,
+                           int64_t timestamp_micros,
+                           int64_t timestamp1_or_id,
+                           Dart_Timeline_Event_Type type,
+                           intptr_t argument_count,
+                           const char** argument_names,
+                           const char** argument_values);
+
+/// Returns the events in the ring buffers of all live threads as a JSON
+/// object with a "traceEvents" array, oldest first on each thread.
+std::string TraceRingBufferDump();
+
+/// Drops the events in the ring buffers of all threads.
+void TraceRingBufferClear();
+
+}  // namespace tracing
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TRACE_RING_BUFFER_H_
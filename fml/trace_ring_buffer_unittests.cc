@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/trace_ring_buffer.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace tracing {
+namespace testing {
+
+namespace {
+
+size_t CountOccurrences(const std::string& string, const std::string& part) {
+  size_t count = 0u;
+  for (size_t position = string.find(part); position != std::string::npos;
+       position = string.find(part, position + part.size())) {
+    ++count;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(TraceRingBufferTest, DumpsRecordedEvents) {
+  TraceRingBufferClear();
+  const char* names[] = {"frame"};
+  const char* values[] = {"42"};
+  TraceRingBufferRecord("Begin \"quoted\"", 10, 0, Dart_Timeline_Event_Begin,
+                        1, names, values);
+  TraceRingBufferRecord("Duration", 10, 25, Dart_Timeline_Event_Duration, 0,
+                        nullptr, nullptr);
+  TraceRingBufferRecord("Async", 12, 7, Dart_Timeline_Event_Async_Begin, 0,
+                        nullptr, nullptr);
+
+  std::string dump = TraceRingBufferDump();
+  EXPECT_EQ(dump.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(dump.find("\"name\":\"Begin \\\"quoted\\\"\",\"cat\":\"flutter\","
+                      "\"ph\":\"B\",\"ts\":10"),
+            std::string::npos);
+  EXPECT_NE(dump.find("\"args\":{\"frame\":\"42\"}"), std::string::npos);
+  EXPECT_NE(dump.find("\"ph\":\"X\",\"ts\":10"), std::string::npos);
+  EXPECT_NE(dump.find("\"dur\":15"), std::string::npos);
+  EXPECT_NE(dump.find("\"ph\":\"b\",\"ts\":12"), std::string::npos);
+  EXPECT_NE(dump.find("\"id\":7"), std::string::npos);
+
+  TraceRingBufferClear();
+  EXPECT_EQ(CountOccurrences(TraceRingBufferDump(), "\"name\""), 0u);
+}
+
+TEST(TraceRingBufferTest, KeepsOnlyTheMostRecentEvents) {
+  TraceRingBufferClear();
+  for (size_t i = 0; i < kTraceRingBufferCapacity + 10; ++i) {
+    TraceRingBufferRecord(i < 10 ? "Old" : "New", i, 0,
+                          Dart_Timeline_Event_Instant, 0, nullptr, nullptr);
+  }
+  std::string dump = TraceRingBufferDump();
+  EXPECT_EQ(CountOccurrences(dump, "\"name\":\"Old\""), 0u);
+  EXPECT_EQ(CountOccurrences(dump, "\"name\":\"New\""),
+            kTraceRingBufferCapacity);
+  TraceRingBufferClear();
+}
+
+TEST(TraceRingBufferTest, TruncatesArgumentValues) {
+  TraceRingBufferClear();
+  const std::string long_value(kTraceRingBufferArgumentSize * 2, 'a');
+  const char* names[] = {"value"};
+  const char* values[] = {long_value.c_str()};
+  TraceRingBufferRecord("Event", 1, 0, Dart_Timeline_Event_Instant, 1, names,
+                        values);
+  std::string truncated(kTraceRingBufferArgumentSize - 1, 'a');
+  EXPECT_NE(TraceRingBufferDump().find("{\"value\":\"" + truncated + "\"}"),
+            std::string::npos);
+  TraceRingBufferClear();
+}
+
+TEST(TraceRingBufferTest, DropsTheEventsOfExitedThreads) {
+  TraceRingBufferClear();
+  std::thread thread([] {
+    TraceRingBufferRecord("Thread", 1, 0, Dart_Timeline_Event_Instant, 0,
+                          nullptr, nullptr);
+    EXPECT_EQ(CountOccurrences(TraceRingBufferDump(), "\"name\":\"Thread\""),
+              1u);
+  });
+  thread.join();
+  EXPECT_EQ(CountOccurrences(TraceRingBufferDump(), "\"name\":\"Thread\""),
+            0u);
+}
+
+TEST(TraceRingBufferTest, NamesInDifferentStorageAreDistinguished) {
+  TraceRingBufferClear();
+  char name[8] = "First";
+  TraceRingBufferRecord(name, 1, 0, Dart_Timeline_Event_Instant, 0, nullptr,
+                        nullptr);
+  std::snprintf(name, sizeof(name), "Second");
+  TraceRingBufferRecord(name, 2, 0, Dart_Timeline_Event_Instant, 0, nullptr,
+                        nullptr);
+  std::string dump = TraceRingBufferDump();
+  EXPECT_EQ(CountOccurrences(dump, "\"name\":\"First\""), 1u);
+  EXPECT_EQ(CountOccurrences(dump, "\"name\":\"Second\""), 1u);
+  TraceRingBufferClear();
+}
+
+}  // namespace testing
+}  // namespace tracing
+}  // namespace fml
@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_UNIQUE_CLOSURE_H_
+#define FLUTTER_FML_UNIQUE_CLOSURE_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      A move-only closure that stores small callables inline.
+///
+///             Unlike `fml::closure`, moving a `UniqueClosure` never copies
+///             the target, and callables of up to `kInlineStorageSize` bytes
+///             are stored without a heap allocation. This makes it suitable
+///             for tasks that are moved through queues and heaps before they
+///             are run. Since it is move-only, it may also hold move-only
+///             callables without wrapping them in `fml::MakeCopyable`.
+///
+///             An `fml::closure` converts to a `UniqueClosure` that holds it,
+///             and an empty `fml::closure` converts to an empty one.
+///
+class UniqueClosure {
+ public:
+  /// Callables that are no larger than this, and that can be moved without
+  /// throwing, are stored inline.
+  static constexpr size_t kInlineStorageSize = 56u;
+
+  UniqueClosure() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(std::nullptr_t) {}
+
+  template <typename Callable,
+            typename Target = std::decay_t<Callable>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Target, UniqueClosure> &&
+                std::is_invocable_r_v<void, Target&>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(Callable&& callable) {
+    if constexpr (std::is_same_v<Target, fml::closure> ||
+                  std::is_pointer_v<Target>) {
+      if (!callable) {
+        return;
+      }
+    }
+    if constexpr (IsStoredInline<Target>()) {
+      new (storage_) Target(std::forward<Callable>(callable));
+    } else {
+      new (storage_) Target*(new Target(std::forward<Callable>(callable)));
+    }
+    ops_ = &kOps<Target>;
+  }
+
+  UniqueClosure(UniqueClosure&& other) noexcept { MoveFrom(other); }
+
+  UniqueClosure& operator=(UniqueClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~UniqueClosure() { Reset(); }
+
+  /// Invokes the callable. Must not be called on an empty closure.
+  void operator()() const {
+    ops_->invoke(const_cast<unsigned char*>(storage_));
+  }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  /// Destroys the callable, leaving the closure empty.
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    // Moves the callable to the uninitialized |to|, and destroys |from|.
+    void (*relocate)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Target>
+  static constexpr bool IsStoredInline() {
+    return sizeof(Target) <= kInlineStorageSize &&
+           alignof(Target) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Target>;
+  }
+
+  template <typename Target>
+  static Target& GetTarget(void* storage) {
+    if constexpr (IsStoredInline<Target>()) {
+      return *std::launder(reinterpret_cast<Target*>(storage));
+    } else {
+      return **std::launder(reinterpret_cast<Target**>(storage));
+    }
+  }
+
+  template <typename Target>
+  static void Relocate(void* from, void* to) {
+    if constexpr (IsStoredInline<Target>()) {
+      Target& target = GetTarget<Target>(from);
+      new (to) Target(std::move(target));
+      target.~Target();
+    } else {
+      new (to) Target*(&GetTarget<Target>(from));
+    }
+  }
+
+  template <typename Target>
+  static void Destroy(void* storage) {
+    if constexpr (IsStoredInline<Target>()) {
+      GetTarget<Target>(storage).~Target();
+    } else {
+      delete &GetTarget<Target>(storage);
+    }
+  }
+
+  template <typename Target>
+  static constexpr Ops kOps = {
+      [](void* storage) { GetTarget<Target>(storage)(); },
+      &Relocate<Target>,
+      &Destroy<Target>,
+  };
+
+  void MoveFrom(UniqueClosure& other) {
+    if (other.ops_) {
+      other.ops_->relocate(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineStorageSize];
+  const Ops* ops_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(UniqueClosure);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_UNIQUE_CLOSURE_H_
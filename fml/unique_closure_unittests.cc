@@ -0,0 +1,91 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/unique_closure.h"
+
+#include <array>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace testing {
+
+TEST(UniqueClosureTest, DefaultIsEmpty) {
+  UniqueClosure closure;
+  EXPECT_FALSE(closure);
+  UniqueClosure null_closure = nullptr;
+  EXPECT_FALSE(null_closure);
+}
+
+TEST(UniqueClosureTest, EmptyStdFunctionIsEmpty) {
+  fml::closure empty;
+  UniqueClosure closure = empty;
+  EXPECT_FALSE(closure);
+}
+
+TEST(UniqueClosureTest, InvokesSmallCallables) {
+  int value = 0;
+  UniqueClosure closure = [&value]() { value++; };
+  ASSERT_TRUE(closure);
+  closure();
+  closure();
+  EXPECT_EQ(value, 2);
+}
+
+TEST(UniqueClosureTest, InvokesLargeCallables) {
+  std::array<int, 64> values = {};
+  values[63] = 7;
+  int result = 0;
+  UniqueClosure closure = [values, &result]() { result = values[63]; };
+  UniqueClosure moved = std::move(closure);
+  EXPECT_FALSE(closure);  // NOLINT(bugprone-use-after-move)
+  moved();
+  EXPECT_EQ(result, 7);
+}
+
+TEST(UniqueClosureTest, InvokesStdFunctions) {
+  int value = 0;
+  fml::closure function = [&value]() { value = 3; };
+  UniqueClosure closure = function;
+  closure();
+  EXPECT_EQ(value, 3);
+}
+
+TEST(UniqueClosureTest, HoldsMoveOnlyCallables) {
+  auto pointer = std::make_unique<int>(5);
+  int result = 0;
+  UniqueClosure closure = [pointer = std::move(pointer), &result]() {
+    result = *pointer;
+  };
+  UniqueClosure moved;
+  moved = std::move(closure);
+  moved();
+  EXPECT_EQ(result, 5);
+}
+
+TEST(UniqueClosureTest, DestroysTheCallableOnce) {
+  auto counter = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_counter = counter;
+  {
+    UniqueClosure closure = [counter = std::move(counter)]() { (*counter)++; };
+    UniqueClosure first = std::move(closure);
+    UniqueClosure second = std::move(first);
+    second();
+    EXPECT_FALSE(weak_counter.expired());
+  }
+  EXPECT_TRUE(weak_counter.expired());
+}
+
+TEST(UniqueClosureTest, ResetDestroysTheCallable) {
+  auto counter = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_counter = counter;
+  UniqueClosure closure = [counter = std::move(counter)]() {};
+  closure.Reset();
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(weak_counter.expired());
+}
+
+}  // namespace testing
+}  // namespace fml
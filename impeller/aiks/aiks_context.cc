@@ -5,6 +5,11 @@
 #include "impeller/aiks/aiks_context.h"
 
 #include "impeller/aiks/picture.h"
+#include "impeller/base/validation.h"
+#include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/render_target.h"
 
 namespace impeller {
 
@@ -36,16 +41,154 @@ ContentContext& AiksContext::GetContentContext() const {
   return *content_context_;
 }
 
-bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
+bool AiksContext::Render(const Picture& picture,
+                         RenderTarget& render_target,
+                         bool reset_host_buffer) {
   if (!IsValid()) {
     return false;
   }
 
   if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+    // Offscreen textures that are not used again during this frame are
+    // released once it is rendered.
+    auto render_target_cache = content_context_->GetRenderTargetCache();
+    render_target_cache->Start();
+    bool result = picture.pass->Render(*content_context_, render_target);
+    render_target_cache->End();
+    if (reset_host_buffer) {
+      // The commands of the frame have been encoded, so their transient data
+      // has been uploaded.
+      content_context_->GetTransientsBuffer()->Reset();
+    }
+    return result;
   }
 
   return true;
 }
 
+bool AiksContext::CanRenderRegion(const RenderTarget& render_target) const {
+  if (!IsValid()) {
+    return false;
+  }
+  auto color0 = render_target.GetColorAttachments().find(0u);
+  if (color0 == render_target.GetColorAttachments().end()) {
+    return false;
+  }
+  return !color0->second.resolve_texture ||
+         context_->GetDeviceCapabilities().SupportsTextureToTextureBlits();
+}
+
+bool AiksContext::RenderRegion(const Picture& picture,
+                               RenderTarget& render_target,
+                               IRect region,
+                               bool reset_host_buffer) {
+  const auto target_rect = IRect::MakeSize(render_target.GetRenderTargetSize());
+  if (region.Contains(target_rect)) {
+    return Render(picture, render_target, reset_host_buffer);
+  }
+
+  if (!CanRenderRegion(render_target)) {
+    VALIDATION_LOG << "Cannot render a region of the render target.";
+    return false;
+  }
+
+  auto target_region = region.Intersection(target_rect);
+  if (!picture.pass || !target_region.has_value()) {
+    if (reset_host_buffer) {
+      content_context_->GetTransientsBuffer()->Reset();
+    }
+    return true;
+  }
+  region = target_region.value();
+
+  auto render_target_cache = content_context_->GetRenderTargetCache();
+  render_target_cache->Start();
+  bool result = RenderRegionIntoTarget(picture, render_target, region);
+  render_target_cache->End();
+  if (reset_host_buffer) {
+    content_context_->GetTransientsBuffer()->Reset();
+  }
+  return result;
+}
+
+bool AiksContext::RenderRegionIntoTarget(const Picture& picture,
+                                         const RenderTarget& render_target,
+                                         IRect region) {
+  const bool multisampled =
+      !!render_target.GetColorAttachments().find(0u)->second.resolve_texture;
+  auto allocator = content_context_->GetRenderTargetCache();
+  auto color_format = render_target.GetRenderTargetPixelFormat();
+  RenderTarget region_target =
+      multisampled
+          ? RenderTarget::CreateOffscreenMSAA(
+                *context_, *allocator, region.size, "Region MSAA",
+                RenderTarget::kDefaultColorAttachmentConfigMSAA,
+                RenderTarget::kDefaultStencilAttachmentConfig, color_format)
+          : RenderTarget::CreateOffscreen(
+                *context_, *allocator, region.size, "Region",
+                RenderTarget::kDefaultColorAttachmentConfig,
+                RenderTarget::kDefaultStencilAttachmentConfig, color_format);
+  if (!region_target.IsValid()) {
+    VALIDATION_LOG << "Could not create the render target of the region.";
+    return false;
+  }
+
+  if (!picture.pass->Render(*content_context_, region_target,
+                            Point(region.origin))) {
+    return false;
+  }
+
+  auto command_buffer = context_->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("Region Command Buffer");
+
+  if (multisampled) {
+    // The resolve texture keeps the contents of the previous frames that
+    // were presented with it.
+    auto blit_pass = command_buffer->CreateBlitPass();
+    if (!blit_pass ||
+        !blit_pass->AddCopy(region_target.GetRenderTargetTexture(),
+                            render_target.GetRenderTargetTexture(),
+                            std::nullopt, region.origin, "Region Copy") ||
+        !blit_pass->EncodeCommands(context_->GetResourceAllocator())) {
+      return false;
+    }
+  } else {
+    // Draw the region over the loaded contents of the render target, which
+    // may not be a valid blit destination, e.g. the default framebuffer.
+    RenderTarget target = render_target;
+    auto color0 = target.GetColorAttachments().find(0u)->second;
+    color0.load_action = LoadAction::kLoad;
+    color0.store_action = StoreAction::kStore;
+    target.SetColorAttachment(color0, 0u);
+    if (auto stencil = target.GetStencilAttachment(); stencil.has_value()) {
+      stencil->load_action = LoadAction::kClear;
+      stencil->store_action = StoreAction::kDontCare;
+      target.SetStencilAttachment(stencil.value());
+    }
+
+    auto render_pass = command_buffer->CreateRenderPass(target);
+    if (!render_pass) {
+      return false;
+    }
+    render_pass->SetLabel("Region Render Pass");
+
+    auto contents = TextureContents::MakeRect(Rect(region));
+    contents->SetTexture(region_target.GetRenderTargetTexture());
+    contents->SetSourceRect(Rect::MakeSize(region.size));
+
+    Entity entity;
+    entity.SetContents(contents);
+    entity.SetBlendMode(BlendMode::kSource);
+    if (!entity.Render(*content_context_, *render_pass) ||
+        !render_pass->EncodeCommands()) {
+      return false;
+    }
+  }
+
+  return command_buffer->SubmitCommands();
+}
+
 }  // namespace impeller
@@ -28,13 +28,64 @@ class AiksContext {
 
   ContentContext& GetContentContext() const;
 
-  bool Render(const Picture& picture, RenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      Render the picture into the render target.
+  ///
+  /// @param[in]  picture            The picture.
+  /// @param[in]  render_target      The render target.
+  /// @param[in]  reset_host_buffer  Whether this ends the frame, so that the
+  ///                                transient data of the content context
+  ///                                is recycled. This should only be set by
+  ///                                the render of a surface, once per frame.
+  ///
+  /// @return     If the picture was rendered.
+  ///
+  bool Render(const Picture& picture,
+              RenderTarget& render_target,
+              bool reset_host_buffer = false);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render a region of the picture into the same region of the
+  ///             render target, and leave the rest of the color texture of
+  ///             the render target as it was.
+  ///
+  ///             The region is rendered into an offscreen target of its size
+  ///             and then copied into the render target, since the samples of
+  ///             a multisampled render target aren't retained. A region that
+  ///             covers the whole render target is rendered with `Render`.
+  ///
+  /// @param[in]  picture            The picture.
+  /// @param[in]  render_target      The render target. Only regions of render
+  ///                                targets for which `CanRenderRegion`
+  ///                                returns true can be rendered.
+  /// @param[in]  region             The region, in the coordinates of the
+  ///                                render target.
+  /// @param[in]  reset_host_buffer  See `Render`.
+  ///
+  /// @return     If the region of the picture was rendered.
+  ///
+  bool RenderRegion(const Picture& picture,
+                    RenderTarget& render_target,
+                    IRect region,
+                    bool reset_host_buffer = false);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether a region of |render_target| can be rendered with
+  ///             `RenderRegion`. Regions of multisampled render targets are
+  ///             copied into their resolve textures, which requires texture
+  ///             to texture blits.
+  ///
+  bool CanRenderRegion(const RenderTarget& render_target) const;
 
  private:
   std::shared_ptr<Context> context_;
   std::unique_ptr<ContentContext> content_context_;
   bool is_valid_ = false;
 
+  bool RenderRegionIntoTarget(const Picture& picture,
+                              const RenderTarget& render_target,
+                              IRect region);
+
   FML_DISALLOW_COPY_AND_ASSIGN(AiksContext);
 };
 
@@ -17,12 +17,12 @@ AiksPlayground::~AiksPlayground() = default;
 bool AiksPlayground::OpenPlaygroundHere(const Picture& picture) {
   return OpenPlaygroundHere(
       [&picture](AiksContext& renderer, RenderTarget& render_target) -> bool {
-        return renderer.Render(picture, render_target);
+        return renderer.Render(picture, render_target, true);
       });
 }
 
 bool AiksPlayground::OpenPlaygroundHere(AiksPlaygroundCallback callback) {
-  if (!Playground::is_enabled()) {
+  if (!Playground::ShouldRender()) {
     return true;
   }
 
@@ -39,6 +39,11 @@ bool AiksPlayground::OpenPlaygroundHere(AiksPlaygroundCallback callback) {
           wireframe = !wireframe;
           renderer.GetContentContext().SetWireframe(wireframe);
         }
+        static bool overdraw_heatmap = false;
+        if (ImGui::IsKeyPressed(ImGuiKey_O)) {
+          overdraw_heatmap = !overdraw_heatmap;
+          renderer.GetContentContext().SetOverdrawHeatmap(overdraw_heatmap);
+        }
         return callback(renderer, render_target);
       });
 }
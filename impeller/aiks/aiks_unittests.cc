@@ -15,9 +15,11 @@
 #include "impeller/aiks/aiks_playground.h"
 #include "impeller/aiks/canvas.h"
 #include "impeller/aiks/image.h"
+#include "impeller/aiks/paint_pass_delegate.h"
 #include "impeller/entity/contents/color_source_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/scene_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/constants.h"
@@ -1948,5 +1950,84 @@ TEST_P(AiksTest, PaintWithFilters) {
   ASSERT_FALSE(paint.HasColorFilter());
 }
 
+TEST_P(AiksTest, CanRenderRegionOfPicture) {
+  Canvas canvas;
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 200, 200), {.color = Color::Red()});
+  canvas.DrawCircle({150, 150}, 50, {.color = Color::Blue()});
+  auto picture = canvas.EndRecordingAsPicture();
+
+  AiksContext renderer(GetContext());
+  ASSERT_TRUE(renderer.IsValid());
+  auto render_target =
+      RenderTarget::CreateOffscreenMSAA(*GetContext(), {400, 300});
+  ASSERT_TRUE(render_target.IsValid());
+  ASSERT_TRUE(renderer.CanRenderRegion(render_target));
+
+  // Regions within, overlapping, and covering the render target.
+  ASSERT_TRUE(renderer.Render(picture, render_target));
+  ASSERT_TRUE(renderer.RenderRegion(picture, render_target,
+                                    IRect::MakeXYWH(100, 100, 100, 50)));
+  ASSERT_TRUE(renderer.RenderRegion(picture, render_target,
+                                    IRect::MakeXYWH(350, 250, 100, 100)));
+  ASSERT_TRUE(renderer.RenderRegion(picture, render_target,
+                                    IRect::MakeXYWH(0, 0, 400, 300)));
+}
+
+static std::shared_ptr<SolidColorContents> AddRectEntity(EntityPass& pass) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)));
+  contents->SetColor(Color::Red());
+  Entity entity;
+  entity.SetContents(contents);
+  pass.AddEntity(entity);
+  return contents;
+}
+
+TEST(PaintPassDelegateTest, LayerWithSingleEntityCollapsesIntoParent) {
+  EntityPass pass;
+  auto contents = AddRectEntity(pass);
+
+  Paint paint;
+  paint.color = Color::Black().WithAlpha(0.5);
+  paint.blend_mode = BlendMode::kPlus;
+  PaintPassDelegate delegate(paint, std::nullopt);
+  ASSERT_TRUE(delegate.CanCollapseIntoParentPass(&pass));
+  ASSERT_EQ(contents->GetColor().alpha, 0.5);
+
+  // The layer opacity is only applied once, however often the pass renders.
+  ASSERT_TRUE(delegate.CanCollapseIntoParentPass(&pass));
+  ASSERT_EQ(contents->GetColor().alpha, 0.5);
+
+  pass.IterateAllEntities([](Entity& entity) {
+    EXPECT_EQ(entity.GetBlendMode(), BlendMode::kPlus);
+    return true;
+  });
+}
+
+TEST(PaintPassDelegateTest, LayerWithSeveralEntitiesDoesNotCollapse) {
+  EntityPass pass;
+  auto contents = AddRectEntity(pass);
+  AddRectEntity(pass);
+
+  Paint paint;
+  paint.color = Color::Black().WithAlpha(0.5);
+  PaintPassDelegate delegate(paint, std::nullopt);
+  ASSERT_FALSE(delegate.CanCollapseIntoParentPass(&pass));
+  ASSERT_EQ(contents->GetColor().alpha, 1.0);
+}
+
+TEST(PaintPassDelegateTest, LayerWithFiltersDoesNotCollapse) {
+  EntityPass pass;
+  AddRectEntity(pass);
+
+  Paint paint;
+  paint.color_filter = [](FilterInput::Ref input) {
+    return ColorFilterContents::MakeBlend(BlendMode::kSourceOver,
+                                          {std::move(input)}, Color::Blue());
+  };
+  PaintPassDelegate delegate(paint, std::nullopt);
+  ASSERT_FALSE(delegate.CanCollapseIntoParentPass(&pass));
+}
+
 }  // namespace testing
 }  // namespace impeller
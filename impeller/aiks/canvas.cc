@@ -68,14 +68,16 @@ void Canvas::Save() {
 void Canvas::Save(
     bool create_subpass,
     BlendMode blend_mode,
-    std::optional<EntityPass::BackdropFilterProc> backdrop_filter) {
+    std::optional<EntityPass::BackdropFilterProc> backdrop_filter,
+    std::optional<uint64_t> backdrop_filter_reuse_key) {
   auto entry = CanvasStackEntry{};
   entry.xformation = xformation_stack_.back().xformation;
   entry.stencil_depth = xformation_stack_.back().stencil_depth;
   if (create_subpass) {
     entry.is_subpass = true;
     auto subpass = std::make_unique<EntityPass>();
-    subpass->SetBackdropFilter(std::move(backdrop_filter));
+    subpass->SetBackdropFilter(std::move(backdrop_filter),
+                               backdrop_filter_reuse_key);
     subpass->SetBlendMode(blend_mode);
     current_pass_ = GetCurrentPass().AddSubpass(std::move(subpass));
     current_pass_->SetTransformation(xformation_stack_.back().xformation);
@@ -237,7 +239,20 @@ void Canvas::DrawRRect(Rect rect, Scalar corner_radius, const Paint& paint) {
   if (AttemptDrawBlurredRRect(rect, corner_radius, paint)) {
     return;
   }
-  DrawPath(PathBuilder{}.AddRoundedRect(rect, corner_radius).TakePath(), paint);
+  if (paint.style == Paint::Style::kStroke) {
+    DrawPath(PathBuilder{}.AddRoundedRect(rect, corner_radius).TakePath(),
+             paint);
+    return;
+  }
+
+  Entity entity;
+  entity.SetTransformation(GetCurrentTransformation());
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetBlendMode(paint.blend_mode);
+  entity.SetContents(paint.WithFilters(paint.CreateContentsForGeometry(
+      Geometry::MakeRRect(rect, Size(corner_radius, corner_radius)))));
+
+  GetCurrentPass().AddEntity(entity);
 }
 
 void Canvas::DrawCircle(Point center, Scalar radius, const Paint& paint) {
@@ -246,12 +261,33 @@ void Canvas::DrawCircle(Point center, Scalar radius, const Paint& paint) {
                               paint)) {
     return;
   }
-  DrawPath(PathBuilder{}.AddCircle(center, radius).TakePath(), paint);
+  if (paint.style == Paint::Style::kStroke) {
+    DrawPath(PathBuilder{}.AddCircle(center, radius).TakePath(), paint);
+    return;
+  }
+
+  Entity entity;
+  entity.SetTransformation(GetCurrentTransformation());
+  entity.SetStencilDepth(GetStencilDepth());
+  entity.SetBlendMode(paint.blend_mode);
+  entity.SetContents(paint.WithFilters(
+      paint.CreateContentsForGeometry(Geometry::MakeCircle(center, radius))));
+
+  GetCurrentPass().AddEntity(entity);
 }
 
 void Canvas::ClipPath(const Path& path, Entity::ClipOperation clip_op) {
+  ClipGeometry(Geometry::MakeFillPath(path), clip_op);
+}
+
+void Canvas::ClipRect(const Rect& rect, Entity::ClipOperation clip_op) {
+  ClipGeometry(Geometry::MakeRect(rect), clip_op);
+}
+
+void Canvas::ClipGeometry(std::unique_ptr<Geometry> geometry,
+                          Entity::ClipOperation clip_op) {
   auto contents = std::make_shared<ClipContents>();
-  contents->SetGeometry(Geometry::MakeFillPath(path));
+  contents->SetGeometry(std::move(geometry));
   contents->SetClipOperation(clip_op);
 
   Entity entity;
@@ -323,6 +359,7 @@ void Canvas::DrawImageRect(const std::shared_ptr<Image>& image,
 
   auto contents = TextureContents::MakeRect(dest);
   contents->SetTexture(image->GetTexture());
+  contents->SetYUVTexture(image->GetUVTexture(), image->GetYUVColorSpace());
   contents->SetSourceRect(source);
   contents->SetSamplerDescriptor(std::move(sampler));
   contents->SetOpacity(paint.color.alpha);
@@ -359,8 +396,9 @@ size_t Canvas::GetStencilDepth() const {
 void Canvas::SaveLayer(
     const Paint& paint,
     std::optional<Rect> bounds,
-    const std::optional<Paint::ImageFilterProc>& backdrop_filter) {
-  Save(true, paint.blend_mode, backdrop_filter);
+    const std::optional<Paint::ImageFilterProc>& backdrop_filter,
+    std::optional<uint64_t> backdrop_filter_reuse_key) {
+  Save(true, paint.blend_mode, backdrop_filter, backdrop_filter_reuse_key);
 
   auto& new_layer_pass = GetCurrentPass();
   new_layer_pass.SetDelegate(
@@ -372,14 +410,40 @@ void Canvas::SaveLayer(
     // the size of the render target that would have been allocated will be
     // absent. Explicitly add back a clip to reproduce that behavior. Since
     // clips never require a render target switch, this is a cheap operation.
-    ClipPath(PathBuilder{}.AddRect(bounds.value()).TakePath());
+    ClipRect(bounds.value());
+  }
+}
+
+/// Text at least this large on screen, in pixels, is drawn from a signed
+/// distance field, which stays sharp when the text is scaled.
+static constexpr Scalar kSignedDistanceFieldMinTextSize = 48.0f;
+
+static bool ShouldUseSignedDistanceField(const TextFrame& text_frame,
+                                         const Matrix& transform) {
+  // Distance fields only store coverage, so glyphs with color need bitmaps.
+  if (text_frame.HasColor()) {
+    return false;
+  }
+  // Bitmap glyphs are rasterized axis-aligned and blur when they are rotated,
+  // skewed or in perspective.
+  if (!transform.IsTranslationScaleOnly()) {
+    return true;
+  }
+  for (const auto& run : text_frame.GetRuns()) {
+    const auto& metrics = run.GetFont().GetMetrics();
+    if (metrics.point_size * metrics.scale >= kSignedDistanceFieldMinTextSize) {
+      return true;
+    }
   }
+  return false;
 }
 
 void Canvas::DrawTextFrame(const TextFrame& text_frame,
                            Point position,
                            const Paint& paint) {
-  lazy_glyph_atlas_->AddTextFrame(text_frame);
+  const bool use_signed_distance_field =
+      ShouldUseSignedDistanceField(text_frame, GetCurrentTransformation());
+  lazy_glyph_atlas_->AddTextFrame(text_frame, use_signed_distance_field);
 
   Entity entity;
   entity.SetStencilDepth(GetStencilDepth());
@@ -388,6 +452,7 @@ void Canvas::DrawTextFrame(const TextFrame& text_frame,
   auto text_contents = std::make_shared<TextContents>();
   text_contents->SetTextFrame(text_frame);
   text_contents->SetGlyphAtlas(lazy_glyph_atlas_);
+  text_contents->SetUseSignedDistanceField(use_signed_distance_field);
 
   if (paint.color_source.has_value()) {
     auto& source = paint.color_source.value();
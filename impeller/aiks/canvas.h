@@ -35,9 +35,14 @@ class Canvas {
 
   void Save();
 
+  /// Layers whose backdrop filters have the same |backdrop_filter_reuse_key|
+  /// must apply the same filter, which allows them to share the filtered
+  /// backdrop. See |EntityPass::SetBackdropFilter|.
   void SaveLayer(const Paint& paint,
                  std::optional<Rect> bounds = std::nullopt,
                  const std::optional<Paint::ImageFilterProc>& backdrop_filter =
+                     std::nullopt,
+                 std::optional<uint64_t> backdrop_filter_reuse_key =
                      std::nullopt);
 
   bool Restore();
@@ -91,6 +96,10 @@ class Canvas {
       const Path& path,
       Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
 
+  void ClipRect(
+      const Rect& rect,
+      Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
+
   void DrawPicture(Picture picture);
 
   void DrawTextFrame(const TextFrame& text_frame,
@@ -129,7 +138,11 @@ class Canvas {
   void Save(bool create_subpass,
             BlendMode = BlendMode::kSourceOver,
             std::optional<EntityPass::BackdropFilterProc> backdrop_filter =
-                std::nullopt);
+                std::nullopt,
+            std::optional<uint64_t> backdrop_filter_reuse_key = std::nullopt);
+
+  void ClipGeometry(std::unique_ptr<Geometry> geometry,
+                    Entity::ClipOperation clip_op);
 
   void RestoreClip();
 
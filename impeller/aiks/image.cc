@@ -8,6 +8,13 @@ namespace impeller {
 
 Image::Image(std::shared_ptr<Texture> texture) : texture_(std::move(texture)) {}
 
+Image::Image(std::shared_ptr<Texture> y_texture,
+             std::shared_ptr<Texture> uv_texture,
+             YUVColorSpace yuv_color_space)
+    : texture_(std::move(y_texture)),
+      uv_texture_(std::move(uv_texture)),
+      yuv_color_space_(yuv_color_space) {}
+
 Image::~Image() = default;
 
 ISize Image::GetSize() const {
@@ -18,4 +25,12 @@ std::shared_ptr<Texture> Image::GetTexture() const {
   return texture_;
 }
 
+std::shared_ptr<Texture> Image::GetUVTexture() const {
+  return uv_texture_;
+}
+
+YUVColorSpace Image::GetYUVColorSpace() const {
+  return yuv_color_space_;
+}
+
 }  // namespace impeller
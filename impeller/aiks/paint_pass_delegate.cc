@@ -6,6 +6,7 @@
 
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/entity_pass.h"
 #include "impeller/geometry/path_builder.h"
 
 namespace impeller {
@@ -27,8 +28,11 @@ bool PaintPassDelegate::CanElide() {
 }
 
 // |EntityPassDelgate|
-bool PaintPassDelegate::CanCollapseIntoParentPass() {
-  return false;
+bool PaintPassDelegate::CanCollapseIntoParentPass(EntityPass* entity_pass) {
+  if (!can_collapse_.has_value()) {
+    can_collapse_ = InlineSingleEntity(entity_pass);
+  }
+  return can_collapse_.value();
 }
 
 // |EntityPassDelgate|
@@ -44,4 +48,75 @@ std::shared_ptr<Contents> PaintPassDelegate::CreateContentsForSubpassTarget(
                                             effect_transform);
 }
 
+// |EntityPassDelgate|
+bool PaintPassDelegate::NeedsExtendedRange() {
+  return paint_.image_filter.has_value() || paint_.color_filter.has_value();
+}
+
+/// Whether compositing a layer with `blend_mode` looks the same as rendering
+/// its contents with `blend_mode` directly, which is the case when the
+/// parent is left unchanged where the layer is transparent.
+static bool CanApplyLayerBlendModeToEntity(BlendMode blend_mode) {
+  switch (blend_mode) {
+    case BlendMode::kSourceOver:
+    case BlendMode::kDestinationOver:
+    case BlendMode::kSourceATop:
+    case BlendMode::kPlus:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool PaintPassDelegate::InlineSingleEntity(EntityPass* entity_pass) const {
+  // Filters are applied to the whole layer at once.
+  if (paint_.image_filter.has_value() || paint_.color_filter.has_value() ||
+      !CanApplyLayerBlendModeToEntity(paint_.blend_mode) ||
+      entity_pass->GetSubpassesDepth() > 1) {
+    return false;
+  }
+
+  // Clips render the same way in the parent pass, which is also clipped to
+  // the bounds of the layer by the canvas.
+  Entity* drawn_entity = nullptr;
+  bool has_single_entity = true;
+  entity_pass->IterateAllEntities([&](Entity& entity) {
+    if (!entity.GetContents() ||
+        entity.GetStencilCoverage(std::nullopt).type !=
+            Contents::StencilCoverage::Type::kNone) {
+      return true;
+    }
+    if (drawn_entity) {
+      has_single_entity = false;
+      return false;
+    }
+    drawn_entity = &entity;
+    return true;
+  });
+  if (!has_single_entity) {
+    return false;
+  }
+  if (!drawn_entity) {
+    return true;
+  }
+
+  // Both of these render the contents as they are into the transparent
+  // layer.
+  if (drawn_entity->GetBlendMode() != BlendMode::kSourceOver &&
+      drawn_entity->GetBlendMode() != BlendMode::kSource) {
+    return false;
+  }
+  const auto& contents = drawn_entity->GetContents();
+  const Scalar opacity = paint_.color.alpha;
+  if (opacity < 1 && !contents->CanInheritOpacity(*drawn_entity)) {
+    return false;
+  }
+
+  if (opacity < 1) {
+    contents->SetInheritedOpacity(opacity);
+  }
+  drawn_entity->SetBlendMode(paint_.blend_mode);
+  return true;
+}
+
 }  // namespace impeller
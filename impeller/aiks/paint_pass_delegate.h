@@ -26,16 +26,27 @@ class PaintPassDelegate final : public EntityPassDelegate {
   bool CanElide() override;
 
   // |EntityPassDelgate|
-  bool CanCollapseIntoParentPass() override;
+  bool CanCollapseIntoParentPass(EntityPass* entity_pass) override;
 
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
       const Matrix& effect_transform) override;
 
+  // |EntityPassDelgate|
+  bool NeedsExtendedRange() override;
+
  private:
+  /// @brief  If `entity_pass` only draws a single entity, and the paint of the
+  ///         layer can be applied to that entity instead, apply it and return
+  ///         true.
+  bool InlineSingleEntity(EntityPass* entity_pass) const;
+
   const Paint paint_;
   const std::optional<Rect> coverage_;
+  // Whether the pass collapses into its parent, computed when the pass is
+  // first rendered since the entity is adjusted at that point.
+  std::optional<bool> can_collapse_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(PaintPassDelegate);
 };
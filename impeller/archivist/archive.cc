@@ -42,9 +42,9 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  auto statement = registration->CreateInsertStatement();
+  auto statement = registration->AcquireInsertStatement();
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!statement) {
     /*
      *  Must be able to reset the statement for a new write
      */
@@ -59,14 +59,14 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
    *  for its members to be references. It does not manage the lifetimes of
    *  anything.
    */
-  ArchiveLocation item(*this, statement, *registration, primary_key);
+  ArchiveLocation item(*this, *statement, *registration, primary_key);
 
   /*
    *  If the item provides its own primary key, we need to bind it now.
    * Otherwise, one will be automatically assigned to it.
    */
   if (primary_key.has_value() &&
-      !statement.WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+      !statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
                             primary_key.value())) {
     return std::nullopt;
   }
@@ -75,7 +75,7 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
     return std::nullopt;
   }
 
-  if (statement.Execute() != ArchiveStatement::Result::kDone) {
+  if (statement->Execute() != ArchiveStatement::Result::kDone) {
     return std::nullopt;
   }
 
@@ -95,6 +95,28 @@ std::optional<int64_t /* row id */> Archive::ArchiveInstance(
   return lastInsert;
 }
 
+bool Archive::ArchiveInstances(const ArchiveDef& definition,
+                               const std::vector<const Archivable*>& items) {
+  if (!IsValid()) {
+    return false;
+  }
+
+  /*
+   *  The writes of each item join this transaction instead of committing
+   *  their own. So the whole batch is committed at once, or not at all.
+   */
+  auto transaction = database_->CreateTransaction(transaction_count_);
+
+  for (const auto* item : items) {
+    if (!ArchiveInstance(definition, *item).has_value()) {
+      return false;
+    }
+  }
+
+  transaction.MarkWritesAsReadyForCommit();
+  return true;
+}
+
 bool Archive::UnarchiveInstance(const ArchiveDef& definition,
                                 PrimaryKey name,
                                 Archivable& archivable) {
@@ -122,9 +144,9 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
 
   const bool isQueryingSingle = primary_key.has_value();
 
-  auto statement = registration->CreateQueryStatement(isQueryingSingle);
+  auto statement = registration->AcquireQueryStatement(isQueryingSingle);
 
-  if (!statement.IsValid() || !statement.Reset()) {
+  if (!statement) {
     return 0;
   }
 
@@ -133,13 +155,13 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
      *  If a single statement is being queried for, bind the primary key as a
      * statement argument.
      */
-    if (!statement.WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
-                              primary_key.value())) {
+    if (!statement->WriteValue(ArchiveClassRegistration::kPrimaryKeyIndex,
+                               primary_key.value())) {
       return 0;
     }
   }
 
-  if (statement.GetColumnCount() !=
+  if (statement->GetColumnCount() !=
       registration->GetMemberCount() + 1 /* primary key */) {
     return 0;
   }
@@ -152,13 +174,13 @@ size_t Archive::UnarchiveInstances(const ArchiveDef& definition,
 
   size_t itemsRead = 0;
 
-  while (statement.Execute() == ArchiveStatement::Result::kRow) {
+  while (statement->Execute() == ArchiveStatement::Result::kRow) {
     itemsRead++;
 
     /*
      *  Prepare a fresh archive item for the given statement
      */
-    ArchiveLocation item(*this, statement, *registration, primary_key);
+    ArchiveLocation item(*this, *statement, *registration, primary_key);
 
     if (!stepper(item)) {
       break;
@@ -34,6 +34,25 @@ class Archive {
     return ArchiveInstance(def, archivable).has_value();
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Write all of the items in a single transaction. Either all of
+  ///             them are written, or none are.
+  ///
+  ///             This is much faster than writing the same items one at a
+  ///             time, since each transaction commits to storage.
+  ///
+  template <class T,
+            class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
+  [[nodiscard]] bool Write(const std::vector<T>& archivables) {
+    const ArchiveDef& def = T::kArchiveDefinition;
+    std::vector<const Archivable*> items;
+    items.reserve(archivables.size());
+    for (const auto& archivable : archivables) {
+      items.push_back(&archivable);
+    }
+    return ArchiveInstances(def, items);
+  }
+
   template <class T,
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] bool Read(PrimaryKey name, T& archivable) {
@@ -43,6 +62,15 @@ class Archive {
 
   using UnarchiveStep = std::function<bool(ArchiveLocation&)>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Step through the instances of a class in the order of their
+  ///             primary keys. Rows are read one at a time as the stepper
+  ///             asks for them, so none are held in memory past its call.
+  ///
+  /// @param[in]  stepper  Called with each instance. Return false to stop.
+  ///
+  /// @return     The number of instances stepped through.
+  ///
   template <class T,
             class = std::enable_if_t<std::is_base_of<Archivable, T>::value>>
   [[nodiscard]] size_t Read(UnarchiveStep stepper) {
@@ -60,6 +88,9 @@ class Archive {
       const ArchiveDef& definition,
       const Archivable& archivable);
 
+  bool ArchiveInstances(const ArchiveDef& definition,
+                        const std::vector<const Archivable*>& items);
+
   bool UnarchiveInstance(const ArchiveDef& definition,
                          PrimaryKey name,
                          Archivable& archivable);
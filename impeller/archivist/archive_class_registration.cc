@@ -72,18 +72,19 @@ bool ArchiveClassRegistration::CreateTable() {
 
   auto statement = database_.CreateStatement(stream.str());
 
-  if (!statement.IsValid()) {
+  if (!statement->IsValid()) {
     return false;
   }
 
-  if (!statement.Reset()) {
+  if (!statement->Reset()) {
     return false;
   }
 
-  return statement.Execute() == ArchiveStatement::Result::kDone;
+  return statement->Execute() == ArchiveStatement::Result::kDone;
 }
 
-ArchiveStatement ArchiveClassRegistration::CreateQueryStatement(
+std::unique_ptr<ArchiveStatement>
+ArchiveClassRegistration::CreateQueryStatement(
     bool single) const {
   std::stringstream stream;
   stream << "SELECT " << kArchivePrimaryKeyColumnName << ", ";
@@ -106,7 +107,8 @@ ArchiveStatement ArchiveClassRegistration::CreateQueryStatement(
   return database_.CreateStatement(stream.str());
 }
 
-ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
+std::unique_ptr<ArchiveStatement>
+ArchiveClassRegistration::CreateInsertStatement() const {
   std::stringstream stream;
   stream << "INSERT OR REPLACE INTO " << definition_.table_name
          << " VALUES ( ?, ";
@@ -121,4 +123,44 @@ ArchiveStatement ArchiveClassRegistration::CreateInsertStatement() const {
   return database_.CreateStatement(stream.str());
 }
 
+ArchiveClassRegistration::CachedStatement
+ArchiveClassRegistration::AcquireStatement(
+    StatementPool& pool,
+    const std::function<std::unique_ptr<ArchiveStatement>()>& create) const {
+  std::unique_ptr<ArchiveStatement> statement;
+  if (pool.empty()) {
+    statement = create();
+  } else {
+    statement = std::move(pool.back());
+    pool.pop_back();
+  }
+
+  if (!statement->IsValid() || !statement->Reset()) {
+    return nullptr;
+  }
+
+  /*
+   *  Reset the statement as soon as it is released so that a query doesn't
+   *  hold on to its read transaction while it sits in the pool.
+   */
+  return CachedStatement(statement.release(),
+                         [&pool](ArchiveStatement* released) {
+                           released->Reset();
+                           pool.emplace_back(released);
+                         });
+}
+
+ArchiveClassRegistration::CachedStatement
+ArchiveClassRegistration::AcquireInsertStatement() const {
+  return AcquireStatement(insert_statements_,
+                          [this]() { return CreateInsertStatement(); });
+}
+
+ArchiveClassRegistration::CachedStatement
+ArchiveClassRegistration::AcquireQueryStatement(bool single) const {
+  return AcquireStatement(
+      single ? single_query_statements_ : query_statements_,
+      [this, single]() { return CreateQueryStatement(single); });
+}
+
 }  // namespace impeller
@@ -2,8 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <functional>
 #include <map>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/archivist/archive.h"
@@ -23,12 +26,36 @@ class ArchiveClassRegistration {
 
   size_t GetMemberCount() const;
 
-  ArchiveStatement CreateInsertStatement() const;
-
-  ArchiveStatement CreateQueryStatement(bool single) const;
+  //----------------------------------------------------------------------------
+  /// A statement borrowed from the registration. It is reset and returned to
+  /// the registration for reuse when released.
+  ///
+  using CachedStatement =
+      std::unique_ptr<ArchiveStatement, std::function<void(ArchiveStatement*)>>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a reset statement that inserts or replaces an instance of
+  ///             the class.
+  ///
+  ///             Statements are prepared once and reused. Writes of nested
+  ///             instances of the same class get statements of their own
+  ///             while the outer one is still borrowed.
+  ///
+  /// @return     The statement, or nullptr if it could not be prepared.
+  ///
+  CachedStatement AcquireInsertStatement() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a reset statement that queries either the instance with a
+  ///             primary key or all instances of the class.
+  ///
+  /// @see        `AcquireInsertStatement`
+  ///
+  CachedStatement AcquireQueryStatement(bool single) const;
 
  private:
   using MemberColumnMap = std::map<std::string, size_t>;
+  using StatementPool = std::vector<std::unique_ptr<ArchiveStatement>>;
 
   friend class ArchiveDatabase;
 
@@ -36,10 +63,21 @@ class ArchiveClassRegistration {
 
   bool CreateTable();
 
+  std::unique_ptr<ArchiveStatement> CreateInsertStatement() const;
+
+  std::unique_ptr<ArchiveStatement> CreateQueryStatement(bool single) const;
+
+  CachedStatement AcquireStatement(
+      StatementPool& pool,
+      const std::function<std::unique_ptr<ArchiveStatement>()>& create) const;
+
   ArchiveDatabase& database_;
   const ArchiveDef definition_;
   MemberColumnMap column_map_;
   bool is_valid_ = false;
+  mutable StatementPool insert_statements_;
+  mutable StatementPool single_query_statements_;
+  mutable StatementPool query_statements_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveClassRegistration);
 };
@@ -57,6 +57,22 @@ ArchiveDatabase::ArchiveDatabase(const std::string& filename)
     return;
   }
 
+  /*
+   *  With a write-ahead log, a commit appends to the log instead of rewriting
+   *  the pages of the database, and only the checkpoints need to sync. Readers
+   *  don't block on the writer either. A database that can't use one (such as
+   *  an in-memory database) keeps its default journal.
+   */
+  for (const auto* pragma :
+       {"PRAGMA journal_mode = WAL;", "PRAGMA synchronous = NORMAL;"}) {
+    ArchiveStatement statement(handle_->Get(), pragma);
+    if (!statement.IsValid() ||
+        statement.Execute() == ArchiveStatement::Result::kFailure) {
+      VALIDATION_LOG << "Could not apply archive database setting: " << pragma;
+    }
+    statement.Reset();
+  }
+
   begin_transaction_stmt_ = std::unique_ptr<ArchiveStatement>(
       new ArchiveStatement(handle_->Get(), "BEGIN TRANSACTION;"));
 
@@ -125,9 +141,10 @@ const ArchiveClassRegistration* ArchiveDatabase::GetRegistrationForDefinition(
                     : nullptr;
 }
 
-ArchiveStatement ArchiveDatabase::CreateStatement(
+std::unique_ptr<ArchiveStatement> ArchiveDatabase::CreateStatement(
     const std::string& statementString) const {
-  return ArchiveStatement{handle_ ? handle_->Get() : nullptr, statementString};
+  return std::unique_ptr<ArchiveStatement>(new ArchiveStatement(
+      handle_ ? handle_->Get() : nullptr, statementString));
 }
 
 ArchiveTransaction ArchiveDatabase::CreateTransaction(
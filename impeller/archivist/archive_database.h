@@ -46,7 +46,8 @@ class ArchiveDatabase {
 
   friend class ArchiveClassRegistration;
 
-  ArchiveStatement CreateStatement(const std::string& statementString) const;
+  std::unique_ptr<ArchiveStatement> CreateStatement(
+      const std::string& statementString) const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ArchiveDatabase);
 };
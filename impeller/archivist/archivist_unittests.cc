@@ -196,5 +196,50 @@ TEST_F(ArchiveTest, CanReadWriteVectorOfArchivables) {
   ASSERT_TRUE(read_success);
 }
 
+TEST_F(ArchiveTest, CanWriteBatchOfArchivables) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  std::vector<Sample> samples;
+  for (size_t i = 0; i < 500u; i++) {
+    samples.emplace_back(Sample{i});
+  }
+  ASSERT_TRUE(archive.Write(samples));
+
+  for (const auto& sample : samples) {
+    Sample other_sample;
+    ASSERT_TRUE(archive.Read(sample.GetPrimaryKey(), other_sample));
+    ASSERT_EQ(sample.GetSomeData(), other_sample.GetSomeData());
+  }
+}
+
+TEST_F(ArchiveTest, CanStepThroughArchivablesInOrder) {
+  Archive archive(GetArchiveFileName().c_str());
+  ASSERT_TRUE(archive.IsValid());
+
+  std::vector<Sample> samples;
+  for (size_t i = 0; i < 20u; i++) {
+    samples.emplace_back(Sample{100 + i});
+  }
+  ASSERT_TRUE(archive.Write(samples));
+
+  uint64_t expected = 100;
+  ASSERT_EQ(archive.Read<Sample>([&](ArchiveLocation& location) -> bool {
+    Sample sample;
+    if (!sample.Read(location)) {
+      return false;
+    }
+    // Reads nested in the step use statements of their own.
+    Sample same_sample;
+    if (!archive.Read(samples[expected - 100].GetPrimaryKey(), same_sample) ||
+        same_sample.GetSomeData() != sample.GetSomeData()) {
+      return false;
+    }
+    EXPECT_EQ(sample.GetSomeData(), expected++);
+    return sample.GetSomeData() < 109;
+  }),
+            10u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -58,6 +58,10 @@ uint32_t Allocation::NextPowerOfTwoSize(uint32_t x) {
 bool Allocation::ReserveNPOT(size_t reserved) {
   // Reserve at least one page of data.
   reserved = std::max<size_t>(4096u, reserved);
+  if (reserved <= reserved_) {
+    // Growable allocations keep their memory when they are truncated.
+    return true;
+  }
   return Reserve(NextPowerOfTwoSize(reserved));
 }
 
@@ -0,0 +1,98 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/compiler/compilation_stamp.h"
+
+#include <sstream>
+#include <string_view>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
+
+namespace impeller {
+namespace compiler {
+
+static std::string_view ToStringView(const fml::Mapping& mapping) {
+  return std::string_view(reinterpret_cast<const char*>(mapping.GetMapping()),
+                          mapping.GetSize());
+}
+
+// Outputs of an older compiler are out of date, even if the inputs are not.
+static size_t GetCompilerHash() {
+  static const size_t kCompilerHash = []() -> size_t {
+    auto [found, path] = fml::paths::GetExecutablePath();
+    if (!found) {
+      return 0u;
+    }
+    auto executable = fml::FileMapping::CreateReadOnly(path);
+    if (!executable) {
+      return 0u;
+    }
+    return std::hash<std::string_view>{}(ToStringView(*executable));
+  }();
+  return kCompilerHash;
+}
+
+std::string CompilationStamp::GetFileName(const std::string& spirv_file_name) {
+  return spirv_file_name + ".stamp";
+}
+
+std::optional<std::string> CompilationStamp::ComputeHash(
+    const fml::UniqueFD& working_directory,
+    const fml::CommandLine& command_line,
+    const std::vector<std::string>& file_names) {
+  size_t hash = fml::HashCombine(GetCompilerHash());
+  for (const auto& option : command_line.options()) {
+    fml::HashCombineSeed(hash, std::string_view{option.name},
+                         std::string_view{option.value});
+  }
+  for (const auto& file_name : file_names) {
+    auto file = fml::FileMapping::CreateReadOnly(working_directory, file_name);
+    if (!file) {
+      return std::nullopt;
+    }
+    fml::HashCombineSeed(hash, std::string_view{file_name},
+                         ToStringView(*file));
+  }
+  std::stringstream stream;
+  stream << std::hex << hash;
+  return stream.str();
+}
+
+std::optional<CompilationStamp> CompilationStamp::Read(
+    const fml::UniqueFD& working_directory,
+    const std::string& file_name) {
+  auto file = fml::FileMapping::CreateReadOnly(working_directory, file_name);
+  if (!file) {
+    return std::nullopt;
+  }
+  std::stringstream stream{std::string{ToStringView(*file)}};
+  CompilationStamp stamp;
+  if (!std::getline(stream, stamp.hash) || stamp.hash.empty()) {
+    return std::nullopt;
+  }
+  std::string included_file_name;
+  while (std::getline(stream, included_file_name)) {
+    if (!included_file_name.empty()) {
+      stamp.included_file_names.push_back(std::move(included_file_name));
+    }
+  }
+  return stamp;
+}
+
+bool CompilationStamp::Write(const fml::UniqueFD& working_directory,
+                             const std::string& file_name) const {
+  std::stringstream stream;
+  stream << hash << std::endl;
+  for (const auto& included_file_name : included_file_names) {
+    stream << included_file_name << std::endl;
+  }
+  return fml::WriteAtomically(working_directory, file_name.c_str(),
+                              fml::DataMapping(stream.str()));
+}
+
+}  // namespace compiler
+}  // namespace impeller
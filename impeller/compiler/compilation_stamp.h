@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/unique_fd.h"
+
+namespace impeller {
+namespace compiler {
+
+//------------------------------------------------------------------------------
+/// @brief      Records the inputs of a shader compilation, so that a later
+///             compilation with the same inputs can be skipped.
+///
+///             The stamp keeps a hash of the compiler, its arguments, the
+///             source file, and every file that the source included. It also
+///             keeps the names of the included files, so that they can be
+///             hashed again without compiling the source.
+///
+struct CompilationStamp {
+  std::string hash;
+  std::vector<std::string> included_file_names;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the name of the stamp of the compilation that writes the
+  ///             given SPIRV file.
+  ///
+  static std::string GetFileName(const std::string& spirv_file_name);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hash the inputs of a compilation.
+  ///
+  /// @param[in]  working_directory  The directory the file names are relative
+  ///                                to.
+  /// @param[in]  command_line       The arguments of the compilation.
+  /// @param[in]  file_names         The source file and the files it
+  ///                                includes.
+  ///
+  /// @return     The hash, or std::nullopt if one of the files can't be read.
+  ///
+  static std::optional<std::string> ComputeHash(
+      const fml::UniqueFD& working_directory,
+      const fml::CommandLine& command_line,
+      const std::vector<std::string>& file_names);
+
+  static std::optional<CompilationStamp> Read(
+      const fml::UniqueFD& working_directory,
+      const std::string& file_name);
+
+  bool Write(const fml::UniqueFD& working_directory,
+             const std::string& file_name) const;
+};
+
+}  // namespace compiler
+}  // namespace impeller
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "impeller/compiler/compilation_stamp.h"
+
+namespace impeller {
+namespace compiler {
+namespace testing {
+
+static fml::CommandLine MakeCommandLine(const char* input) {
+  std::vector<std::string> options = {"--opengl-es", input,
+                                      "--spirv=output.spirv"};
+  return fml::CommandLineFromIteratorsWithArgv0("impellerc", options.begin(),
+                                                options.end());
+}
+
+TEST(CompilationStampTest, HashChangesWithInputs) {
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), "shader.frag",
+                                   fml::DataMapping("void main() {}")));
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), "include.glsl",
+                                   fml::DataMapping("// Nothing yet.")));
+
+  auto command_line = MakeCommandLine("--input=shader.frag");
+  std::vector<std::string> inputs = {"shader.frag", "include.glsl"};
+  auto hash =
+      CompilationStamp::ComputeHash(directory.fd(), command_line, inputs);
+  ASSERT_TRUE(hash.has_value());
+  ASSERT_EQ(CompilationStamp::ComputeHash(directory.fd(), command_line, inputs),
+            hash);
+
+  ASSERT_NE(CompilationStamp::ComputeHash(
+                directory.fd(), MakeCommandLine("--input=other.frag"), inputs),
+            hash);
+
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), "include.glsl",
+                                   fml::DataMapping("// Something.")));
+  ASSERT_NE(CompilationStamp::ComputeHash(directory.fd(), command_line, inputs),
+            hash);
+
+  ASSERT_FALSE(CompilationStamp::ComputeHash(directory.fd(), command_line,
+                                             {"shader.frag", "missing.glsl"})
+                   .has_value());
+}
+
+TEST(CompilationStampTest, CanReadWrittenStamp) {
+  fml::ScopedTemporaryDirectory directory;
+  ASSERT_FALSE(
+      CompilationStamp::Read(directory.fd(), "output.spirv.stamp").has_value());
+
+  CompilationStamp stamp;
+  stamp.hash = "1234abcd";
+  stamp.included_file_names = {"./types.glsl", "shader_lib/impeller/a.glsl"};
+  ASSERT_TRUE(stamp.Write(directory.fd(), "output.spirv.stamp"));
+
+  auto read = CompilationStamp::Read(directory.fd(), "output.spirv.stamp");
+  ASSERT_TRUE(read.has_value());
+  ASSERT_EQ(read->hash, stamp.hash);
+  ASSERT_EQ(read->included_file_names, stamp.included_file_names);
+}
+
+}  // namespace testing
+}  // namespace compiler
+}  // namespace impeller
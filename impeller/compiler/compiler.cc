@@ -127,6 +127,17 @@ static CompilerBackend CreateGLSLCompiler(const spirv_cross::ParsedIR& ir,
     sl_options.es = false;
   }
   gl_compiler->set_common_options(sl_options);
+
+  // Subpass inputs read the color attachment at the fragment with
+  // EXT_shader_framebuffer_fetch. Contexts only use the shaders that read
+  // subpass inputs when the extension is available.
+  for (const auto& subpass_input :
+       gl_compiler->get_shader_resources().subpass_inputs) {
+    gl_compiler->remap_ext_framebuffer_fetch(
+        gl_compiler->get_decoration(subpass_input.id,
+                                    spv::DecorationInputAttachmentIndex),
+        0u, true);
+  }
   return CompilerBackend(gl_compiler);
 }
 
@@ -431,7 +442,8 @@ Compiler::Compiler(const fml::Mapping& source_mapping,
       options_.working_directory, options_.include_dirs,
       [&included_file_names](auto included_name) {
         included_file_names.emplace_back(std::move(included_name));
-      }));
+      },
+      options_.include_cache));
 
   shaderc::Compiler spv_compiler;
   if (!spv_compiler.IsValid()) {
@@ -123,6 +123,24 @@ TEST_P(CompilerTest, UniformsHaveBindingAndSet) {
   ASSERT_EQ(vert_uniform_binding.binding, 17u);
 }
 
+TEST_P(CompilerTest, SubpassInputsReadTheFramebufferOnGLES) {
+  if (GetParam() != TargetPlatform::kOpenGLES) {
+    GTEST_SKIP_("Only GLES reads subpass inputs with framebuffer fetch.");
+  }
+  ASSERT_TRUE(CanCompileAndReflect("sample_framebuffer_fetch.frag",
+                                   SourceType::kFragmentShader));
+
+  auto shader = GetShaderFile("sample_framebuffer_fetch.frag", GetParam());
+  ASSERT_TRUE(shader);
+  std::string source(reinterpret_cast<const char*>(shader->GetMapping()),
+                     shader->GetSize());
+  // The framebuffer blend shaders are compiled at the default GLES version,
+  // which is one that devices load and that malioc analyzes.
+  EXPECT_NE(source.find("#version 100"), std::string::npos);
+  EXPECT_NE(source.find("GL_EXT_shader_framebuffer_fetch"), std::string::npos);
+  EXPECT_NE(source.find("gl_LastFragData"), std::string::npos);
+}
+
 #define INSTANTIATE_TARGET_PLATFORM_TEST_SUITE_P(suite_name)              \
   INSTANTIATE_TEST_SUITE_P(                                               \
       suite_name, CompilerTest,                                           \
@@ -2,8 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <sstream>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
@@ -11,7 +18,9 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/base/strings.h"
+#include "impeller/compiler/compilation_stamp.h"
 #include "impeller/compiler/compiler.h"
+#include "impeller/compiler/includer.h"
 #include "impeller/compiler/source_options.h"
 #include "impeller/compiler/switches.h"
 #include "impeller/compiler/types.h"
@@ -36,24 +45,87 @@ static bool SetPermissiveAccess(const std::filesystem::path& p) {
   return true;
 }
 
-bool Main(const fml::CommandLine& command_line) {
-  fml::InstallCrashHandler();
-  if (command_line.HasOption("help")) {
-    Switches::PrintHelp(std::cout);
-    return true;
+// The files written by a compilation with these switches.
+static std::vector<std::string> GetOutputFileNames(const Switches& switches) {
+  std::vector<std::string> outputs = {switches.spirv_file_name};
+  if (TargetPlatformNeedsSL(switches.target_platform)) {
+    outputs.push_back(switches.sl_file_name);
+  }
+  if (TargetPlatformNeedsReflection(switches.target_platform)) {
+    for (const auto& output :
+         {switches.reflection_json_name, switches.reflection_header_name,
+          switches.reflection_cc_name}) {
+      if (!output.empty()) {
+        outputs.push_back(output);
+      }
+    }
   }
+  if (!switches.depfile_path.empty()) {
+    outputs.push_back(switches.depfile_path);
+  }
+  return outputs;
+}
 
+// Whether the outputs of the compilation with these switches were written by
+// a compilation of the same inputs.
+static bool IsUpToDate(const fml::CommandLine& command_line,
+                       const Switches& switches) {
+  for (const auto& output : GetOutputFileNames(switches)) {
+    if (!fml::FileExists(*switches.working_directory, output.c_str())) {
+      return false;
+    }
+  }
+  auto stamp = CompilationStamp::Read(
+      *switches.working_directory,
+      CompilationStamp::GetFileName(switches.spirv_file_name));
+  if (!stamp.has_value()) {
+    return false;
+  }
+  std::vector<std::string> inputs = stamp->included_file_names;
+  inputs.push_back(switches.source_file_name);
+  auto hash = CompilationStamp::ComputeHash(*switches.working_directory,
+                                            command_line, inputs);
+  return hash.has_value() && hash.value() == stamp->hash;
+}
+
+static bool WriteStamp(const fml::CommandLine& command_line,
+                       const Switches& switches,
+                       const Compiler& compiler) {
+  CompilationStamp stamp;
+  stamp.included_file_names = compiler.GetIncludedFileNames();
+  std::vector<std::string> inputs = stamp.included_file_names;
+  inputs.push_back(switches.source_file_name);
+  auto hash = CompilationStamp::ComputeHash(*switches.working_directory,
+                                            command_line, inputs);
+  if (!hash.has_value()) {
+    return false;
+  }
+  stamp.hash = std::move(hash.value());
+  auto stamp_file_name = std::filesystem::absolute(
+      std::filesystem::current_path() /
+      CompilationStamp::GetFileName(switches.spirv_file_name));
+  return stamp.Write(*switches.working_directory,
+                     Utf8FromPath(stamp_file_name));
+}
+
+static bool CompileShader(const fml::CommandLine& command_line,
+                          const std::shared_ptr<IncludeCache>& include_cache,
+                          std::ostream& errors) {
   Switches switches(command_line);
-  if (!switches.AreValid(std::cerr)) {
-    std::cerr << "Invalid flags specified." << std::endl;
-    Switches::PrintHelp(std::cerr);
+  if (!switches.AreValid(errors)) {
+    errors << "Invalid flags specified." << std::endl;
+    Switches::PrintHelp(errors);
     return false;
   }
 
+  if (switches.incremental && IsUpToDate(command_line, switches)) {
+    return true;
+  }
+
   auto source_file_mapping =
       fml::FileMapping::CreateReadOnly(switches.source_file_name);
   if (!source_file_mapping) {
-    std::cerr << "Could not open input file." << std::endl;
+    errors << "Could not open input file." << std::endl;
     return false;
   }
 
@@ -68,6 +140,7 @@ bool Main(const fml::CommandLine& command_line) {
   options.working_directory = switches.working_directory;
   options.file_name = switches.source_file_name;
   options.include_dirs = switches.include_directories;
+  options.include_cache = include_cache;
   options.defines = switches.defines;
   options.entry_point_name = EntryPointFunctionNameFromSourceName(
       switches.source_file_name, options.type, options.source_language,
@@ -96,8 +169,8 @@ bool Main(const fml::CommandLine& command_line) {
     Compiler sksl_compiler =
         Compiler(*source_file_mapping, sksl_options, sksl_reflector_options);
     if (!sksl_compiler.IsValid()) {
-      std::cerr << "Compilation to SkSL failed." << std::endl;
-      std::cerr << sksl_compiler.GetErrorMessages() << std::endl;
+      errors << "Compilation to SkSL failed." << std::endl;
+      errors << sksl_compiler.GetErrorMessages() << std::endl;
       return false;
     }
     sksl_mapping = sksl_compiler.GetSLShaderSource();
@@ -105,8 +178,8 @@ bool Main(const fml::CommandLine& command_line) {
 
   Compiler compiler(*source_file_mapping, options, reflector_options);
   if (!compiler.IsValid()) {
-    std::cerr << "Compilation failed." << std::endl;
-    std::cerr << compiler.GetErrorMessages() << std::endl;
+    errors << "Compilation failed." << std::endl;
+    errors << compiler.GetErrorMessages() << std::endl;
     return false;
   }
 
@@ -115,8 +188,8 @@ bool Main(const fml::CommandLine& command_line) {
   if (!fml::WriteAtomically(*switches.working_directory,
                             Utf8FromPath(spriv_file_name).c_str(),
                             *compiler.GetSPIRVAssembly())) {
-    std::cerr << "Could not write file to " << switches.spirv_file_name
-              << std::endl;
+    errors << "Could not write file to " << switches.spirv_file_name
+           << std::endl;
     return false;
   }
 
@@ -127,12 +200,12 @@ bool Main(const fml::CommandLine& command_line) {
     if (is_runtime_stage_data) {
       auto reflector = compiler.GetReflector();
       if (reflector == nullptr) {
-        std::cerr << "Could not create reflector." << std::endl;
+        errors << "Could not create reflector." << std::endl;
         return false;
       }
       auto stage_data = reflector->GetRuntimeStageData();
       if (!stage_data) {
-        std::cerr << "Runtime stage information was nil." << std::endl;
+        errors << "Runtime stage information was nil." << std::endl;
         return false;
       }
       if (sksl_mapping) {
@@ -142,15 +215,15 @@ bool Main(const fml::CommandLine& command_line) {
                                     ? stage_data->CreateJsonMapping()
                                     : stage_data->CreateMapping();
       if (!stage_data_mapping) {
-        std::cerr << "Runtime stage data could not be created." << std::endl;
+        errors << "Runtime stage data could not be created." << std::endl;
         return false;
       }
       if (!fml::WriteAtomically(*switches.working_directory,         //
                                 Utf8FromPath(sl_file_name).c_str(),  //
                                 *stage_data_mapping                  //
                                 )) {
-        std::cerr << "Could not write file to " << switches.sl_file_name
-                  << std::endl;
+        errors << "Could not write file to " << switches.sl_file_name
+               << std::endl;
         return false;
       }
       // Tools that consume the runtime stage data expect the access mode to
@@ -162,8 +235,8 @@ bool Main(const fml::CommandLine& command_line) {
       if (!fml::WriteAtomically(*switches.working_directory,
                                 Utf8FromPath(sl_file_name).c_str(),
                                 *compiler.GetSLShaderSource())) {
-        std::cerr << "Could not write file to " << switches.sl_file_name
-                  << std::endl;
+        errors << "Could not write file to " << switches.sl_file_name
+               << std::endl;
         return false;
       }
     }
@@ -177,8 +250,8 @@ bool Main(const fml::CommandLine& command_line) {
               *switches.working_directory,
               Utf8FromPath(reflection_json_name).c_str(),
               *compiler.GetReflector()->GetReflectionJSON())) {
-        std::cerr << "Could not write reflection json to "
-                  << switches.reflection_json_name << std::endl;
+        errors << "Could not write reflection json to "
+               << switches.reflection_json_name << std::endl;
         return false;
       }
     }
@@ -191,8 +264,8 @@ bool Main(const fml::CommandLine& command_line) {
               *switches.working_directory,
               Utf8FromPath(reflection_header_name).c_str(),
               *compiler.GetReflector()->GetReflectionHeader())) {
-        std::cerr << "Could not write reflection header to "
-                  << switches.reflection_header_name << std::endl;
+        errors << "Could not write reflection header to "
+               << switches.reflection_header_name << std::endl;
         return false;
       }
     }
@@ -204,8 +277,8 @@ bool Main(const fml::CommandLine& command_line) {
       if (!fml::WriteAtomically(*switches.working_directory,
                                 Utf8FromPath(reflection_cc_name).c_str(),
                                 *compiler.GetReflector()->GetReflectionCC())) {
-        std::cerr << "Could not write reflection CC to "
-                  << switches.reflection_cc_name << std::endl;
+        errors << "Could not write reflection CC to "
+               << switches.reflection_cc_name << std::endl;
         return false;
       }
     }
@@ -233,15 +306,116 @@ bool Main(const fml::CommandLine& command_line) {
     if (!fml::WriteAtomically(*switches.working_directory,
                               Utf8FromPath(depfile_path).c_str(),
                               *compiler.CreateDepfileContents({result_file}))) {
-      std::cerr << "Could not write depfile to " << switches.depfile_path
-                << std::endl;
+      errors << "Could not write depfile to " << switches.depfile_path
+             << std::endl;
       return false;
     }
   }
 
+  if (switches.incremental && !WriteStamp(command_line, switches, compiler)) {
+    // The outputs are still good. They will just be compiled again next
+    // time.
+    errors << "Could not write the compilation stamp of "
+           << switches.source_file_name << std::endl;
+  }
+
   return true;
 }
 
+
+// Compiles each line of the batch file as the arguments of a shader, together
+// with the other arguments of the command line. The shaders are compiled in
+// parallel, and share the files that they include.
+static bool CompileBatch(const fml::CommandLine& command_line) {
+  std::string batch_file_name;
+  command_line.GetOptionValue("batch", &batch_file_name);
+  auto batch_file = fml::FileMapping::CreateReadOnly(batch_file_name);
+  if (!batch_file) {
+    std::cerr << "Could not open batch file " << batch_file_name << std::endl;
+    return false;
+  }
+
+  std::vector<fml::CommandLine::Option> common_options;
+  for (const auto& option : command_line.options()) {
+    if (option.name != "batch" && option.name != "jobs") {
+      common_options.push_back(option);
+    }
+  }
+
+  std::vector<fml::CommandLine> shaders;
+  std::stringstream batch{std::string{
+      reinterpret_cast<const char*>(batch_file->GetMapping()),
+      batch_file->GetSize()}};
+  std::string line;
+  while (std::getline(batch, line)) {
+    std::stringstream line_stream{line};
+    std::vector<std::string> arguments{
+        std::istream_iterator<std::string>{line_stream},
+        std::istream_iterator<std::string>{}};
+    if (arguments.empty() || arguments.front().front() == '#') {
+      continue;
+    }
+    // Options of the line come last, so they take precedence.
+    auto options = common_options;
+    auto line_command_line =
+        fml::CommandLineFromIterators(arguments.begin(), arguments.end());
+    options.insert(options.end(), line_command_line.options().begin(),
+                   line_command_line.options().end());
+    shaders.emplace_back(command_line.argv0(), options,
+                         std::vector<std::string>{});
+  }
+
+  size_t jobs = std::max(std::thread::hardware_concurrency(), 1u);
+  std::string jobs_value;
+  if (command_line.GetOptionValue("jobs", &jobs_value)) {
+    jobs = std::max(std::stoi(jobs_value), 1);
+  }
+  jobs = std::min(jobs, shaders.size());
+
+  auto include_cache = std::make_shared<IncludeCache>();
+  std::atomic_size_t next_shader = 0;
+  std::atomic_bool success = true;
+  std::mutex errors_mutex;
+  auto compile_shaders = [&]() {
+    for (size_t index = next_shader++; index < shaders.size();
+         index = next_shader++) {
+      std::stringstream errors;
+      if (!CompileShader(shaders[index], include_cache, errors)) {
+        success = false;
+        std::scoped_lock lock(errors_mutex);
+        std::cerr << "Compilation of "
+                  << shaders[index].GetOptionValueWithDefault("input", "")
+                  << " failed." << std::endl
+                  << errors.str();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < jobs; i++) {
+    workers.emplace_back(compile_shaders);
+  }
+  compile_shaders();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return success;
+}
+
+bool Main(const fml::CommandLine& command_line) {
+  fml::InstallCrashHandler();
+  if (command_line.HasOption("help")) {
+    Switches::PrintHelp(std::cout);
+    return true;
+  }
+
+  if (command_line.HasOption("batch")) {
+    return CompileBatch(command_line);
+  }
+
+  return CompileShader(command_line, nullptr, std::cerr);
+}
+
 }  // namespace compiler
 }  // namespace impeller
 
@@ -11,17 +11,38 @@
 namespace impeller {
 namespace compiler {
 
+IncludeCache::IncludeCache() = default;
+
+IncludeCache::~IncludeCache() = default;
+
+std::shared_ptr<const fml::Mapping> IncludeCache::GetFile(
+    const IncludeDir& dir,
+    const std::string& path) {
+  auto key = fml::paths::JoinPaths({dir.name, path});
+  std::scoped_lock lock(mutex_);
+  auto found = files_.find(key);
+  if (found != files_.end()) {
+    return found->second;
+  }
+  std::shared_ptr<const fml::Mapping> file =
+      fml::FileMapping::CreateReadOnly(*dir.dir, path);
+  files_[std::move(key)] = file;
+  return file;
+}
+
 Includer::Includer(std::shared_ptr<fml::UniqueFD> working_directory,
                    std::vector<IncludeDir> include_dirs,
-                   std::function<void(std::string)> on_file_included)
+                   std::function<void(std::string)> on_file_included,
+                   std::shared_ptr<IncludeCache> cache)
     : working_directory_(std::move(working_directory)),
       include_dirs_(std::move(include_dirs)),
-      on_file_included_(std::move(on_file_included)) {}
+      on_file_included_(std::move(on_file_included)),
+      cache_(std::move(cache)) {}
 
 // |shaderc::CompileOptions::IncluderInterface|
 Includer::~Includer() = default;
 
-std::unique_ptr<fml::FileMapping> Includer::TryOpenMapping(
+std::shared_ptr<const fml::Mapping> Includer::TryOpenMapping(
     const IncludeDir& dir,
     const char* requested_source) {
   if (!dir.dir || !dir.dir->is_valid()) {
@@ -37,8 +58,13 @@ std::unique_ptr<fml::FileMapping> Includer::TryOpenMapping(
     return nullptr;
   }
 
-  auto mapping = fml::FileMapping::CreateReadOnly(*dir.dir, requested_source);
-  if (!mapping || !mapping->IsValid()) {
+  std::shared_ptr<const fml::Mapping> mapping;
+  if (cache_) {
+    mapping = cache_->GetFile(dir, source);
+  } else {
+    mapping = fml::FileMapping::CreateReadOnly(*dir.dir, requested_source);
+  }
+  if (!mapping) {
     return nullptr;
   }
 
@@ -47,7 +73,7 @@ std::unique_ptr<fml::FileMapping> Includer::TryOpenMapping(
   return mapping;
 }
 
-std::unique_ptr<fml::FileMapping> Includer::FindFirstMapping(
+std::shared_ptr<const fml::Mapping> Includer::FindFirstMapping(
     const char* requested_source) {
   // Always try the working directory first no matter what the include
   // directories are.
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "flutter/fml/macros.h"
@@ -16,17 +19,50 @@ namespace compiler {
 
 struct IncluderData {
   std::string file_name;
-  std::unique_ptr<fml::Mapping> mapping;
+  std::shared_ptr<const fml::Mapping> mapping;
 
-  IncluderData(std::string p_file_name, std::unique_ptr<fml::Mapping> p_mapping)
+  IncluderData(std::string p_file_name,
+               std::shared_ptr<const fml::Mapping> p_mapping)
       : file_name(std::move(p_file_name)), mapping(std::move(p_mapping)) {}
 };
 
+//------------------------------------------------------------------------------
+/// @brief      The included files read by the includers of many compilations,
+///             such as the compilations of a batch. Each file is only read
+///             once, however many shaders include it.
+///
+///             The cache is thread-safe.
+///
+class IncludeCache {
+ public:
+  IncludeCache();
+
+  ~IncludeCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the file at a path of an include directory, reading it on
+  ///             the first request.
+  ///
+  /// @return     The file, or nullptr if the directory doesn't have it.
+  ///
+  std::shared_ptr<const fml::Mapping> GetFile(const IncludeDir& dir,
+                                              const std::string& path);
+
+ private:
+  std::mutex mutex_;
+  // Missing files are remembered as nullptr, so that the lookups of the
+  // include directories that don't have a file aren't repeated either.
+  std::map<std::string, std::shared_ptr<const fml::Mapping>> files_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IncludeCache);
+};
+
 class Includer final : public shaderc::CompileOptions::IncluderInterface {
  public:
   Includer(std::shared_ptr<fml::UniqueFD> working_directory,
            std::vector<IncludeDir> include_dirs,
-           std::function<void(std::string)> on_file_included);
+           std::function<void(std::string)> on_file_included,
+           std::shared_ptr<IncludeCache> cache = nullptr);
 
   // |shaderc::CompileOptions::IncluderInterface|
   ~Includer() override;
@@ -44,12 +80,13 @@ class Includer final : public shaderc::CompileOptions::IncluderInterface {
   std::shared_ptr<fml::UniqueFD> working_directory_;
   std::vector<IncludeDir> include_dirs_;
   std::function<void(std::string)> on_file_included_;
+  std::shared_ptr<IncludeCache> cache_;
 
-  std::unique_ptr<fml::FileMapping> TryOpenMapping(
+  std::shared_ptr<const fml::Mapping> TryOpenMapping(
       const IncludeDir& dir,
       const char* requested_source);
 
-  std::unique_ptr<fml::FileMapping> FindFirstMapping(
+  std::shared_ptr<const fml::Mapping> FindFirstMapping(
       const char* requested_source);
 
   FML_DISALLOW_COPY_AND_ASSIGN(Includer);
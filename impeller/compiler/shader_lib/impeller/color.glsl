@@ -26,4 +26,13 @@ vec4 IPPremultiply(vec4 color) {
   return vec4(color.rgb * color.a, color.a);
 }
 
+/// Transform a premultiplied color with a 4x5 color matrix, whose 4x4 part is
+/// |color_m| and whose fifth column is |color_v|, clamping the result.
+///
+/// Returns the transformed color, premultiplied.
+vec4 IPApplyColorMatrix(vec4 color, mat4 color_m, vec4 color_v) {
+  vec4 result = clamp(color_m * IPUnpremultiply(color) + color_v, 0.0, 1.0);
+  return IPPremultiply(result);
+}
+
 #endif
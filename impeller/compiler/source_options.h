@@ -16,12 +16,17 @@
 namespace impeller {
 namespace compiler {
 
+class IncludeCache;
+
 struct SourceOptions {
   SourceType type = SourceType::kUnknown;
   TargetPlatform target_platform = TargetPlatform::kUnknown;
   SourceLanguage source_language = SourceLanguage::kUnknown;
   std::shared_ptr<fml::UniqueFD> working_directory;
   std::vector<IncludeDir> include_dirs;
+  // Shared by the compilations of a batch. Each compilation reads its
+  // included files itself without one.
+  std::shared_ptr<IncludeCache> include_cache;
   std::string file_name = "main.glsl";
   std::string entry_point_name = "main";
   uint32_t gles_language_version = 100;
@@ -74,6 +74,15 @@ void Switches::PrintHelp(std::ostream& stream) {
   stream << "[optional] --remap-samplers (force metal sampler index to match "
             "declared order)"
          << std::endl;
+  stream << "[optional] --incremental (skip the compilation if its inputs "
+            "haven't changed since the last one)"
+         << std::endl;
+  stream << "[optional] --batch=<batch_file> (compile each line of the file "
+            "as the arguments of a shader, with the other arguments)"
+         << std::endl;
+  stream << "[optional] --jobs=<number> (shaders of a batch compiled in "
+            "parallel; default: the number of cores)"
+         << std::endl;
 }
 
 Switches::Switches() = default;
@@ -134,7 +143,8 @@ Switches::Switches(const fml::CommandLine& command_line)
       metal_version(
           command_line.GetOptionValueWithDefault("metal-version", "1.2")),
       entry_point(
-          command_line.GetOptionValueWithDefault("entry-point", "main")) {
+          command_line.GetOptionValueWithDefault("entry-point", "main")),
+      incremental(command_line.HasOption("incremental")) {
   auto language =
       command_line.GetOptionValueWithDefault("source-language", "glsl");
   std::transform(language.begin(), language.end(), language.begin(),
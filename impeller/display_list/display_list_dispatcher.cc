@@ -37,7 +37,7 @@
 #include "impeller/geometry/scalar.h"
 #include "impeller/geometry/sigma.h"
 #include "impeller/renderer/formats.h"
-#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/backends/skia/text_frame_cache_skia.h"
 
 #include "third_party/skia/include/core/SkColor.h"
 
@@ -639,6 +639,121 @@ void DisplayListDispatcher::setMaskFilter(const flutter::DlMaskFilter* filter) {
   }
 }
 
+/// Blurs with a sigma at least this large are approximated with the dual
+/// filter, whose error is too small to see at these sizes while the exact
+/// kernel samples dozens of texels for every pixel.
+static constexpr Scalar kDualFilterMinSigma = 16.0f;
+
+static Paint::ImageFilterProc ToBlurFilterProc(
+    const flutter::DlBlurImageFilter* blur,
+    std::optional<FilterContents::ColorMatrix> color_matrix) {
+  auto sigma_x = Sigma(blur->sigma_x());
+  auto sigma_y = Sigma(blur->sigma_y());
+  auto tile_mode = ToTileMode(blur->tile_mode());
+  auto quality = std::max(sigma_x.sigma, sigma_y.sigma) >= kDualFilterMinSigma
+                     ? FilterContents::BlurQuality::kDualFilter
+                     : FilterContents::BlurQuality::kExact;
+
+  return [sigma_x, sigma_y, tile_mode, quality, color_matrix](
+             const FilterInput::Ref& input, const Matrix& effect_transform,
+             bool is_subpass) {
+    return FilterContents::MakeGaussianBlur(
+        input, sigma_x, sigma_y, FilterContents::BlurStyle::kNormal, tile_mode,
+        effect_transform, quality, color_matrix);
+  };
+}
+
+static std::optional<FilterContents::ColorMatrix> ToColorMatrix(
+    const flutter::DlImageFilter* filter) {
+  auto color_filter_image_filter = filter->asColorFilter();
+  if (!color_filter_image_filter ||
+      !color_filter_image_filter->color_filter()) {
+    return std::nullopt;
+  }
+  auto dl_matrix = color_filter_image_filter->color_filter()->asMatrix();
+  if (!dl_matrix) {
+    return std::nullopt;
+  }
+  FilterContents::ColorMatrix color_matrix;
+  dl_matrix->get_matrix(color_matrix.array);
+  return color_matrix;
+}
+
+/// Appends the filters of a tree of compose filters in the order they apply.
+static void FlattenImageFilter(
+    const flutter::DlImageFilter* filter,
+    std::vector<const flutter::DlImageFilter*>& filters) {
+  if (filter == nullptr) {
+    return;
+  }
+  if (auto compose = filter->asCompose()) {
+    FlattenImageFilter(compose->inner().get(), filters);
+    FlattenImageFilter(compose->outer().get(), filters);
+    return;
+  }
+  filters.push_back(filter);
+}
+
+/// A filter of a chain, along with the color matrices that follow it.
+struct ImageFilterStep {
+  /// The filter, or nullptr if the step only applies its color matrix.
+  const flutter::DlImageFilter* filter = nullptr;
+  std::optional<FilterContents::ColorMatrix> color_matrix;
+};
+
+/// Merges each color matrix filter of a chain into the step before it when
+/// the result is the same, which saves the color matrix a pass of its own.
+/// Color matrices are composed with each other, and applied by the last
+/// pass of the blurs that they follow.
+static std::vector<ImageFilterStep> FuseImageFilters(
+    const std::vector<const flutter::DlImageFilter*>& filters) {
+  std::vector<ImageFilterStep> steps;
+  for (auto filter : filters) {
+    auto color_matrix = ToColorMatrix(filter);
+    if (!color_matrix.has_value()) {
+      steps.push_back({.filter = filter});
+      continue;
+    }
+    if (!steps.empty() &&
+        (steps.back().filter == nullptr ||
+         steps.back().filter->type() == flutter::DlImageFilterType::kBlur)) {
+      auto& step = steps.back();
+      if (!step.color_matrix.has_value()) {
+        step.color_matrix = color_matrix;
+        continue;
+      }
+      auto composed = FilterContents::ColorMatrix::Compose(
+          color_matrix.value(), step.color_matrix.value());
+      if (composed.has_value()) {
+        step.color_matrix = composed;
+        continue;
+      }
+    }
+    steps.push_back({.color_matrix = color_matrix});
+  }
+  return steps;
+}
+
+static std::optional<Paint::ImageFilterProc> ToImageFilterProc(
+    const flutter::DlImageFilter* filter);
+
+static std::optional<Paint::ImageFilterProc> ToImageFilterStepProc(
+    const ImageFilterStep& step) {
+  if (step.filter == nullptr) {
+    return [color_matrix = step.color_matrix.value()](
+               FilterInput::Ref input, const Matrix& effect_transform,
+               bool is_subpass) {
+      return ColorFilterContents::MakeColorMatrix(std::move(input),
+                                                  color_matrix);
+    };
+  }
+  if (step.color_matrix.has_value()) {
+    FML_DCHECK(step.filter->asBlur());
+    return ToBlurFilterProc(step.filter->asBlur(), step.color_matrix);
+  }
+  return ToImageFilterProc(step.filter);
+}
+
 static std::optional<Paint::ImageFilterProc> ToImageFilterProc(
     const flutter::DlImageFilter* filter) {
   if (filter == nullptr) {
@@ -647,20 +762,7 @@ static std::optional<Paint::ImageFilterProc> ToImageFilterProc(
 
   switch (filter->type()) {
     case flutter::DlImageFilterType::kBlur: {
-      auto blur = filter->asBlur();
-      auto sigma_x = Sigma(blur->sigma_x());
-      auto sigma_y = Sigma(blur->sigma_y());
-      auto tile_mode = ToTileMode(blur->tile_mode());
-
-      return [sigma_x, sigma_y, tile_mode](const FilterInput::Ref& input,
-                                           const Matrix& effect_transform,
-                                           bool is_subpass) {
-        return FilterContents::MakeGaussianBlur(
-            input, sigma_x, sigma_y, FilterContents::BlurStyle::kNormal,
-            tile_mode, effect_transform);
-      };
-
-      break;
+      return ToBlurFilterProc(filter->asBlur(), std::nullopt);
     }
     case flutter::DlImageFilterType::kDilate: {
       auto dilate = filter->asDilate();
@@ -709,27 +811,30 @@ static std::optional<Paint::ImageFilterProc> ToImageFilterProc(
       break;
     }
     case flutter::DlImageFilterType::kComposeFilter: {
-      auto compose = filter->asCompose();
-      FML_DCHECK(compose);
-      auto outer = compose->outer();
-      auto inner = compose->inner();
-      auto outer_proc = ToImageFilterProc(outer.get());
-      auto inner_proc = ToImageFilterProc(inner.get());
-      if (!outer_proc.has_value()) {
-        return inner_proc;
+      std::vector<const flutter::DlImageFilter*> filters;
+      FlattenImageFilter(filter, filters);
+      std::vector<Paint::ImageFilterProc> procs;
+      for (const auto& step : FuseImageFilters(filters)) {
+        auto proc = ToImageFilterStepProc(step);
+        if (proc.has_value()) {
+          procs.push_back(std::move(proc.value()));
+        }
+      }
+      if (procs.empty()) {
+        return std::nullopt;
       }
-      if (!inner_proc.has_value()) {
-        return outer_proc;
+      if (procs.size() == 1) {
+        return procs.front();
       }
-      FML_DCHECK(outer_proc.has_value() && inner_proc.has_value());
-      return [outer_filter = outer_proc.value(),
-              inner_filter = inner_proc.value()](FilterInput::Ref input,
-                                                 const Matrix& effect_transform,
-                                                 bool is_subpass) {
+      return [procs = std::move(procs)](FilterInput::Ref input,
+                                        const Matrix& effect_transform,
+                                        bool is_subpass) {
         auto contents =
-            inner_filter(std::move(input), effect_transform, is_subpass);
-        contents = outer_filter(FilterInput::Make(contents), effect_transform,
-                                is_subpass);
+            procs.front()(std::move(input), effect_transform, is_subpass);
+        for (size_t i = 1; i < procs.size(); i++) {
+          contents = procs[i](FilterInput::Make(contents), effect_transform,
+                              is_subpass);
+        }
         return contents;
       };
       break;
@@ -804,7 +909,22 @@ void DisplayListDispatcher::saveLayer(const SkRect* bounds,
                                       const flutter::SaveLayerOptions options,
                                       const flutter::DlImageFilter* backdrop) {
   auto paint = options.renders_with_attributes() ? paint_ : Paint{};
-  canvas_.SaveLayer(paint, ToRect(bounds), ToImageFilterProc(backdrop));
+  canvas_.SaveLayer(paint, ToRect(bounds), ToImageFilterProc(backdrop),
+                    GetBackdropFilterReuseKey(backdrop));
+}
+
+std::optional<uint64_t> DisplayListDispatcher::GetBackdropFilterReuseKey(
+    const flutter::DlImageFilter* backdrop) {
+  if (backdrop == nullptr) {
+    return std::nullopt;
+  }
+  for (size_t i = 0; i < backdrop_filters_.size(); i++) {
+    if (*backdrop_filters_[i] == *backdrop) {
+      return i;
+    }
+  }
+  backdrop_filters_.push_back(backdrop->shared());
+  return backdrop_filters_.size() - 1;
 }
 
 // |flutter::Dispatcher|
@@ -903,8 +1023,7 @@ static Entity::ClipOperation ToClipOperation(
 void DisplayListDispatcher::clipRect(const SkRect& rect,
                                      ClipOp clip_op,
                                      bool is_aa) {
-  auto path = PathBuilder{}.AddRect(ToRect(rect)).TakePath();
-  canvas_.ClipPath(path, ToClipOperation(clip_op));
+  canvas_.ClipRect(ToRect(rect), ToClipOperation(clip_op));
 }
 
 static PathBuilder::RoundingRadii ToRoundingRadii(const SkRRect& rrect) {
@@ -926,7 +1045,10 @@ static Path ToPath(const SkPath& path) {
     };
   };
 
+  // Closing a contour adds a line and a new contour, and segments store their
+  // first point as well, so the path needs about twice as many points.
   PathBuilder builder;
+  builder.Reserve(path.countVerbs() + 1, path.countPoints() * 2 + 1);
   PathData data;
   auto verb = SkPath::Verb::kDone_Verb;
   do {
@@ -990,7 +1112,14 @@ static Path ToPath(const SkPath& path) {
       fill_type = FillType::kNonZero;
       break;
   }
-  return builder.TakePath(fill_type);
+  auto result = builder.TakePath(fill_type);
+  // Paths that are not volatile are expected to be drawn again in later
+  // frames, so their vertices are cached by the generation ID that SkPaths
+  // with the same points and verbs share.
+  if (!path.isVolatile()) {
+    result.SetCacheKey(path.getGenerationID());
+  }
+  return result;
 }
 
 static Path ToPath(const SkRRect& rrect) {
@@ -1055,6 +1184,51 @@ void DisplayListDispatcher::drawCircle(const SkPoint& center, SkScalar radius) {
   canvas_.DrawCircle(ToPoint(center), radius, paint_);
 }
 
+// Whether rendering the union of several primitives as a single path
+// produces the same output as rendering each primitive on its own. This
+// holds as long as the pixels covered by more than one primitive end up
+// with the same value no matter how many times they are drawn, i.e. the
+// paint is opaque, blends with SrcOver and has no per-draw filters.
+static bool CanMergeGeometry(const Paint& paint) {
+  return paint.color.alpha >= 1.0f &&
+         paint.blend_mode == BlendMode::kSourceOver &&
+         paint.color_source_type == Paint::ColorSourceType::kColor &&
+         !paint.color_filter.has_value() && !paint.image_filter.has_value() &&
+         !paint.mask_blur_descriptor.has_value() && !paint.invert_colors;
+}
+
+// |flutter::Dispatcher|
+void DisplayListDispatcher::drawRects(const SkRect rects[], int count) {
+  if (!CanMergeGeometry(paint_)) {
+    for (int i = 0; i < count; i++) {
+      canvas_.DrawRect(ToRect(rects[i]), paint_);
+    }
+    return;
+  }
+  PathBuilder builder;
+  for (int i = 0; i < count; i++) {
+    builder.AddRect(ToRect(rects[i]));
+  }
+  canvas_.DrawPath(builder.TakePath(), paint_);
+}
+
+// |flutter::Dispatcher|
+void DisplayListDispatcher::drawCircles(const SkPoint centers[],
+                                        const SkScalar radii[],
+                                        int count) {
+  if (!CanMergeGeometry(paint_)) {
+    for (int i = 0; i < count; i++) {
+      canvas_.DrawCircle(ToPoint(centers[i]), radii[i], paint_);
+    }
+    return;
+  }
+  PathBuilder builder;
+  for (int i = 0; i < count; i++) {
+    builder.AddCircle(ToPoint(centers[i]), radii[i]);
+  }
+  canvas_.DrawPath(builder.TakePath(), paint_);
+}
+
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawRRect(const SkRRect& rrect) {
   if (rrect.isSimple()) {
@@ -1144,15 +1318,16 @@ void DisplayListDispatcher::drawImage(const sk_sp<flutter::DlImage> image,
     return;
   }
 
-  auto texture = image->impeller_texture();
-  if (!texture) {
+  // The size is taken from the image rather than from its texture, which
+  // YUV images would have to convert first.
+  const auto size = image->dimensions();
+  if (size.isEmpty()) {
     return;
   }
 
-  const auto size = texture->GetSize();
-  const auto src = SkRect::MakeWH(size.width, size.height);
+  const auto src = SkRect::MakeWH(size.width(), size.height());
   const auto dest =
-      SkRect::MakeXYWH(point.fX, point.fY, size.width, size.height);
+      SkRect::MakeXYWH(point.fX, point.fY, size.width(), size.height());
 
   drawImageRect(
       image,                   // image
@@ -1172,12 +1347,17 @@ void DisplayListDispatcher::drawImageRect(
     flutter::DlImageSampling sampling,
     bool render_with_attributes,
     SkCanvas::SrcRectConstraint constraint) {
+  // YUV images are drawn from their planes, without converting them to RGB.
+  auto impeller_image = image->impeller_yuv_image();
+  if (!impeller_image) {
+    impeller_image = std::make_shared<Image>(image->impeller_texture());
+  }
   canvas_.DrawImageRect(
-      std::make_shared<Image>(image->impeller_texture()),  // image
-      ToRect(src),                                         // source rect
-      ToRect(dst),                                         // destination rect
-      render_with_attributes ? paint_ : Paint(),           // paint
-      ToSamplerDescriptor(sampling)                        // sampling
+      impeller_image,                             // image
+      ToRect(src),                                // source rect
+      ToRect(dst),                                // destination rect
+      render_with_attributes ? paint_ : Paint(),  // paint
+      ToSamplerDescriptor(sampling)               // sampling
   );
 }
 
@@ -1188,10 +1368,11 @@ void DisplayListDispatcher::drawImageNine(const sk_sp<flutter::DlImage> image,
                                           flutter::DlFilterMode filter,
                                           bool render_with_attributes) {
   NinePatchConverter converter = {};
+  Paint paint = render_with_attributes ? paint_ : Paint();
   converter.DrawNinePatch(
       std::make_shared<Image>(image->impeller_texture()),
       Rect::MakeLTRB(center.fLeft, center.fTop, center.fRight, center.fBottom),
-      ToRect(dst), ToSamplerDescriptor(filter), &canvas_, &paint_);
+      ToRect(dst), ToSamplerDescriptor(filter), &canvas_, &paint);
 }
 
 // |flutter::Dispatcher|
@@ -1207,7 +1388,8 @@ void DisplayListDispatcher::drawAtlas(const sk_sp<flutter::DlImage> atlas,
   canvas_.DrawAtlas(std::make_shared<Image>(atlas->impeller_texture()),
                     ToRSXForms(xform, count), ToRects(tex, count),
                     ToColors(colors, count), ToBlendMode(mode),
-                    ToSamplerDescriptor(sampling), ToRect(cull_rect), paint_);
+                    ToSamplerDescriptor(sampling), ToRect(cull_rect),
+                    render_with_attributes ? paint_ : Paint());
 }
 
 // |flutter::Dispatcher|
@@ -1224,14 +1406,21 @@ void DisplayListDispatcher::drawDisplayList(
   canvas_.RestoreToCount(saveCount);
 }
 
+// The text frames of recently drawn text blobs, shared by all dispatchers so
+// that text that is drawn again in the next frame isn't converted again.
+static TextFrameCacheSkia& GetTextFrameCache() {
+  static TextFrameCacheSkia* cache = new TextFrameCacheSkia();
+  return *cache;
+}
+
 // |flutter::Dispatcher|
 void DisplayListDispatcher::drawTextBlob(const sk_sp<SkTextBlob> blob,
                                          SkScalar x,
                                          SkScalar y) {
   Scalar scale = canvas_.GetCurrentTransformation().GetMaxBasisLength();
-  canvas_.DrawTextFrame(TextFrameFromTextBlob(blob, scale),  //
-                        impeller::Point{x, y},               //
-                        paint_                               //
+  canvas_.DrawTextFrame(GetTextFrameCache().GetTextFrame(blob, scale),  //
+                        impeller::Point{x, y},                          //
+                        paint_                                          //
   );
 }
 
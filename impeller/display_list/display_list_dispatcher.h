@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "display_list/display_list_path_effect.h"
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/display_list_blend_mode.h"
@@ -217,10 +221,30 @@ class DisplayListDispatcher final : public flutter::Dispatcher {
                   bool transparent_occluder,
                   SkScalar dpr) override;
 
+  // |flutter::Dispatcher|
+  bool wantsBatchedDraws() const override { return true; }
+
+  // |flutter::Dispatcher|
+  bool wantsDeferredAttributes() const override { return true; }
+
+  // |flutter::Dispatcher|
+  void drawRects(const SkRect rects[], int count) override;
+
+  // |flutter::Dispatcher|
+  void drawCircles(const SkPoint centers[],
+                   const SkScalar radii[],
+                   int count) override;
+
  private:
+  std::optional<uint64_t> GetBackdropFilterReuseKey(
+      const flutter::DlImageFilter* backdrop);
+
   Paint paint_;
   Canvas canvas_;
   Matrix initial_matrix_;
+  // The distinct backdrop filters seen so far, whose indices are used as the
+  // keys that let equal backdrop filters share their filtered backdrop.
+  std::vector<std::shared_ptr<flutter::DlImageFilter>> backdrop_filters_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DisplayListDispatcher);
 };
@@ -5,10 +5,101 @@
 #include "impeller/display_list/display_list_image_impeller.h"
 
 #include "impeller/aiks/aiks_context.h"
+#include "impeller/aiks/image.h"
+#include "impeller/base/thread.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 
 namespace impeller {
 
+namespace {
+
+class DlYUVImageImpeller final : public flutter::DlImage {
+ public:
+  DlYUVImageImpeller(AiksContext* aiks_context,
+                     std::shared_ptr<Texture> y_texture,
+                     std::shared_ptr<Texture> uv_texture,
+                     YUVColorSpace yuv_color_space)
+      : aiks_context_(aiks_context),
+        yuv_image_(std::make_shared<Image>(std::move(y_texture),
+                                           std::move(uv_texture),
+                                           yuv_color_space)) {}
+
+  // |DlImage|
+  ~DlYUVImageImpeller() override = default;
+
+  // |DlImage|
+  sk_sp<SkImage> skia_image() const override { return nullptr; }
+
+  // |DlImage|
+  std::shared_ptr<Texture> impeller_texture() const override {
+    Lock lock(mutex_);
+    if (!rgb_texture_) {
+      rgb_texture_ = ConvertToRGB();
+    }
+    return rgb_texture_;
+  }
+
+  // |DlImage|
+  std::shared_ptr<Image> impeller_yuv_image() const override {
+    return yuv_image_;
+  }
+
+  // |DlImage|
+  bool isOpaque() const override {
+    // Impeller doesn't currently implement opaque alpha types.
+    return false;
+  }
+
+  // |DlImage|
+  bool isTextureBacked() const override { return true; }
+
+  // |DlImage|
+  SkISize dimensions() const override {
+    const auto size = yuv_image_->GetSize();
+    return SkISize::Make(size.width, size.height);
+  }
+
+  // |DlImage|
+  size_t GetApproximateByteSize() const override {
+    auto size = sizeof(*this) +
+                yuv_image_->GetTexture()
+                    ->GetTextureDescriptor()
+                    .GetByteSizeOfBaseMipLevel() +
+                yuv_image_->GetUVTexture()
+                    ->GetTextureDescriptor()
+                    .GetByteSizeOfBaseMipLevel();
+    Lock lock(mutex_);
+    if (rgb_texture_) {
+      size += rgb_texture_->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    }
+    return size;
+  }
+
+ private:
+  AiksContext* const aiks_context_;
+  const std::shared_ptr<Image> yuv_image_;
+  mutable Mutex mutex_;
+  mutable std::shared_ptr<Texture> rgb_texture_ IPLR_GUARDED_BY(mutex_);
+
+  std::shared_ptr<Texture> ConvertToRGB() const {
+    auto yuv_to_rgb_filter_contents = FilterContents::MakeYUVToRGBFilter(
+        yuv_image_->GetTexture(), yuv_image_->GetUVTexture(),
+        yuv_image_->GetYUVColorSpace());
+    impeller::Entity entity;
+    entity.SetBlendMode(impeller::BlendMode::kSource);
+    auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
+        aiks_context_->GetContentContext(), entity);
+    if (!snapshot.has_value()) {
+      return nullptr;
+    }
+    return snapshot->texture;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlYUVImageImpeller);
+};
+
+}  // namespace
+
 sk_sp<DlImageImpeller> DlImageImpeller::Make(std::shared_ptr<Texture> texture,
                                              OwningContext owning_context) {
   if (!texture) {
@@ -18,7 +109,7 @@ sk_sp<DlImageImpeller> DlImageImpeller::Make(std::shared_ptr<Texture> texture,
       new DlImageImpeller(std::move(texture), owning_context));
 }
 
-sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
+sk_sp<flutter::DlImage> DlImageImpeller::MakeFromYUVTextures(
     AiksContext* aiks_context,
     std::shared_ptr<Texture> y_texture,
     std::shared_ptr<Texture> uv_texture,
@@ -26,13 +117,9 @@ sk_sp<DlImageImpeller> DlImageImpeller::MakeFromYUVTextures(
   if (!aiks_context || !y_texture || !uv_texture) {
     return nullptr;
   }
-  auto yuv_to_rgb_filter_contents = FilterContents::MakeYUVToRGBFilter(
-      std::move(y_texture), std::move(uv_texture), yuv_color_space);
-  impeller::Entity entity;
-  entity.SetBlendMode(impeller::BlendMode::kSource);
-  auto snapshot = yuv_to_rgb_filter_contents->RenderToSnapshot(
-      aiks_context->GetContentContext(), entity);
-  return impeller::DlImageImpeller::Make(snapshot->texture);
+  return sk_make_sp<DlYUVImageImpeller>(aiks_context, std::move(y_texture),
+                                        std::move(uv_texture),
+                                        yuv_color_space);
 }
 
 DlImageImpeller::DlImageImpeller(std::shared_ptr<Texture> texture,
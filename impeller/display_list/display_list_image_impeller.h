@@ -18,7 +18,16 @@ class DlImageImpeller final : public flutter::DlImage {
       std::shared_ptr<Texture> texture,
       OwningContext owning_context = OwningContext::kIO);
 
-  static sk_sp<DlImageImpeller> MakeFromYUVTextures(
+  //----------------------------------------------------------------------------
+  /// @brief      Makes an image of the planes of a YUV video frame, which
+  ///             draws the planes directly through |impeller_yuv_image()|.
+  ///
+  ///             The planes are only converted to an RGB texture with the
+  ///             context the first time |impeller_texture()| is called, for
+  ///             the uses that can't sample them directly, such as image
+  ///             shaders and filters. The image must not outlive the context.
+  ///
+  static sk_sp<flutter::DlImage> MakeFromYUVTextures(
       AiksContext* aiks_context,
       std::shared_ptr<Texture> y_texture,
       std::shared_ptr<Texture> uv_texture,
@@ -27,7 +27,7 @@ bool DisplayListPlayground::OpenPlaygroundHere(
 
 bool DisplayListPlayground::OpenPlaygroundHere(
     DisplayListPlaygroundCallback callback) {
-  if (!Playground::is_enabled()) {
+  if (!Playground::ShouldRender()) {
     return true;
   }
 
@@ -43,7 +43,7 @@ bool DisplayListPlayground::OpenPlaygroundHere(
         list->Dispatch(dispatcher);
         auto picture = dispatcher.EndRecordingAsPicture();
 
-        return context.Render(picture, render_target);
+        return context.Render(picture, render_target, true);
       });
 }
 
@@ -728,6 +728,46 @@ TEST_P(DisplayListTest, CanDrawBackdropFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(DisplayListTest, CanDrawSeveralPanesWithTheSameBackdropFilter) {
+  auto texture = CreateTextureForFixture("embarcadero.jpg");
+
+  auto callback = [&]() {
+    static float sigma = 20;
+    static bool overlap = false;
+
+    ImGui::Begin("Controls", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::SliderFloat("Sigma", &sigma, 0, 100);
+    ImGui::TextWrapped(
+        "Panes that don't overlap share one filtered backdrop. Overlapping "
+        "panes must blur the panes behind them.");
+    ImGui::Checkbox("Overlap panes", &overlap);
+    ImGui::End();
+
+    flutter::DisplayListBuilder builder;
+    builder.scale(GetContentScale().x, GetContentScale().y);
+    builder.drawImage(DlImageImpeller::Make(texture), SkPoint::Make(100, 100),
+                      flutter::DlImageSampling::kNearestNeighbor, true);
+
+    auto filter =
+        flutter::DlBlurImageFilter(sigma, sigma, flutter::DlTileMode::kClamp);
+    for (int i = 0; i < 3; i++) {
+      auto left = 150 + i * (overlap ? 100 : 250);
+      auto pane = SkRect::MakeXYWH(left, 200 + i * 50, 200, 300);
+      builder.save();
+      builder.clipRect(pane, flutter::DlCanvas::ClipOp::kIntersect, true);
+      builder.SaveLayer(nullptr, nullptr, &filter);
+      builder.setColor(flutter::DlColor::kWhite().withAlpha(60));
+      builder.drawRect(pane);
+      builder.restore();
+      builder.restore();
+    }
+
+    return builder.Build();
+  };
+
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
 TEST_P(DisplayListTest, CanDrawNinePatchImage) {
   // Image is drawn with corners to scale and center pieces stretched to fit.
   auto texture = CreateTextureForFixture("embarcadero.jpg");
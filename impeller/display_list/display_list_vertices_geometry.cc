@@ -4,6 +4,7 @@
 
 #include "impeller/display_list/display_list_vertices_geometry.h"
 
+#include "impeller/base/thread.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/position_color.vert.h"
@@ -11,6 +12,7 @@
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/geometry/point.h"
+#include "impeller/renderer/context.h"
 #include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "third_party/skia/include/core/SkPoint.h"
@@ -58,6 +60,82 @@ static std::vector<uint16_t> fromFanIndices(
 
 /////// Vertices Geometry ///////
 
+struct DLVerticesGeometry::Upload {
+  std::shared_ptr<DeviceBuffer> buffer;
+  size_t vertex_bytes = 0u;
+  size_t index_count = 0u;
+};
+
+// The buffers uploaded for a vertices object, for the context they were
+// allocated by. Each kind of vertex data is uploaded the first time it is
+// needed.
+class DLVerticesGeometry::Resource final
+    : public flutter::DlVertices::CachedResource {
+ public:
+  explicit Resource(const std::shared_ptr<Context>& context)
+      : context_(context) {}
+
+  // |flutter::DlVertices::CachedResource|
+  ~Resource() override = default;
+
+  bool IsForContext(const std::shared_ptr<Context>& context) const {
+    return context_.lock() == context;
+  }
+
+  std::optional<Upload> GetPositions() const {
+    Lock lock(mutex_);
+    return positions_;
+  }
+
+  void SetPositions(Upload upload) {
+    Lock lock(mutex_);
+    positions_ = std::move(upload);
+  }
+
+  std::optional<Upload> GetPositionColors() const {
+    Lock lock(mutex_);
+    return position_colors_;
+  }
+
+  void SetPositionColors(Upload upload) {
+    Lock lock(mutex_);
+    position_colors_ = std::move(upload);
+  }
+
+  // The texture coordinates are mapped into the coverage of the texture, so
+  // they are only reused for the same mapping.
+  std::optional<Upload> GetPositionUVs(Rect texture_coverage,
+                                       const Matrix& effect_transform) const {
+    Lock lock(mutex_);
+    if (!position_uvs_.has_value() ||
+        !(uv_texture_coverage_ == texture_coverage) ||
+        uv_effect_transform_ != effect_transform) {
+      return std::nullopt;
+    }
+    return position_uvs_;
+  }
+
+  void SetPositionUVs(Upload upload,
+                      Rect texture_coverage,
+                      const Matrix& effect_transform) {
+    Lock lock(mutex_);
+    position_uvs_ = std::move(upload);
+    uv_texture_coverage_ = texture_coverage;
+    uv_effect_transform_ = effect_transform;
+  }
+
+ private:
+  const std::weak_ptr<Context> context_;
+  mutable Mutex mutex_;
+  std::optional<Upload> positions_ IPLR_GUARDED_BY(mutex_);
+  std::optional<Upload> position_colors_ IPLR_GUARDED_BY(mutex_);
+  std::optional<Upload> position_uvs_ IPLR_GUARDED_BY(mutex_);
+  Rect uv_texture_coverage_ IPLR_GUARDED_BY(mutex_);
+  Matrix uv_effect_transform_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Resource);
+};
+
 // static
 std::shared_ptr<VerticesGeometry> DLVerticesGeometry::MakeVertices(
     const flutter::DlVertices* vertices) {
@@ -65,28 +143,77 @@ std::shared_ptr<VerticesGeometry> DLVerticesGeometry::MakeVertices(
 }
 
 DLVerticesGeometry::DLVerticesGeometry(const flutter::DlVertices* vertices)
-    : vertices_(vertices) {
-  NormalizeIndices();
-}
+    : vertices_(vertices) {}
 
 DLVerticesGeometry::~DLVerticesGeometry() = default;
 
-void DLVerticesGeometry::NormalizeIndices() {
+std::vector<uint16_t> DLVerticesGeometry::GetNormalizedIndices() const {
   // Convert triangle fan if present.
   if (vertices_->mode() == flutter::DlVertexMode::kTriangleFan) {
-    normalized_indices_ = fromFanIndices(vertices_);
-    return;
+    return fromFanIndices(vertices_);
   }
 
+  std::vector<uint16_t> indices;
   auto index_count = vertices_->index_count();
   auto vertex_count = vertices_->vertex_count();
   if (index_count != 0 || vertex_count == 0) {
-    return;
+    return indices;
   }
-  normalized_indices_.reserve(vertex_count);
+  indices.reserve(vertex_count);
   for (auto i = 0; i < vertex_count; i++) {
-    normalized_indices_.push_back(i);
+    indices.push_back(i);
+  }
+  return indices;
+}
+
+std::shared_ptr<DLVerticesGeometry::Resource> DLVerticesGeometry::GetResource(
+    const ContentContext& renderer) const {
+  auto context = renderer.GetContext();
+  // Impeller is the only backend that caches resources on vertices objects.
+  auto resource =
+      std::static_pointer_cast<Resource>(vertices_->cached_resource());
+  if (resource && resource->IsForContext(context)) {
+    return resource;
   }
+  resource = std::make_shared<Resource>(context);
+  vertices_->set_cached_resource(resource);
+  return resource;
+}
+
+std::optional<DLVerticesGeometry::Upload> DLVerticesGeometry::UploadVertexData(
+    const ContentContext& renderer,
+    const void* vertex_data,
+    size_t vertex_bytes) const {
+  auto normalized_indices = GetNormalizedIndices();
+  auto index_count = normalized_indices.empty() ? vertices_->index_count()
+                                                : normalized_indices.size();
+  auto* dl_indices = normalized_indices.empty() ? vertices_->indices()
+                                                : normalized_indices.data();
+  size_t index_bytes = index_count * sizeof(uint16_t);
+
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.size = vertex_bytes + index_bytes;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+
+  auto buffer =
+      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  if (!buffer) {
+    return std::nullopt;
+  }
+
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(vertex_data),
+                              Range{0, vertex_bytes}, 0)) {
+    return std::nullopt;
+  }
+  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(dl_indices),
+                              Range{0, index_bytes}, vertex_bytes)) {
+    return std::nullopt;
+  }
+  return Upload{
+      .buffer = std::move(buffer),
+      .vertex_bytes = vertex_bytes,
+      .index_count = index_count,
+  };
 }
 
 static PrimitiveType GetPrimitiveType(const flutter::DlVertices* vertices) {
@@ -133,49 +260,20 @@ bool DLVerticesGeometry::HasTextureCoordinates() const {
   return vertices_->texture_coordinates() != nullptr;
 }
 
-GeometryResult DLVerticesGeometry::GetPositionBuffer(
-    const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) {
-  auto index_count = normalized_indices_.size() == 0
-                         ? vertices_->index_count()
-                         : normalized_indices_.size();
-  auto vertex_count = vertices_->vertex_count();
-  auto* dl_indices = normalized_indices_.size() == 0
-                         ? vertices_->indices()
-                         : normalized_indices_.data();
-  auto* dl_vertices = vertices_->vertices();
-
-  size_t total_vtx_bytes = vertex_count * sizeof(float) * 2;
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<const uint8_t*>(dl_vertices),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(dl_indices)),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
+GeometryResult DLVerticesGeometry::MakeResult(const Upload& upload,
+                                              const Entity& entity,
+                                              RenderPass& pass) const {
+  size_t index_bytes = upload.index_count * sizeof(uint16_t);
   return GeometryResult{
       .type = GetPrimitiveType(vertices_),
       .vertex_buffer =
           {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
+              .vertex_buffer = {.buffer = upload.buffer,
+                                .range = Range{0, upload.vertex_bytes}},
+              .index_buffer = {.buffer = upload.buffer,
                                .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .index_count = index_count,
+                                   Range{upload.vertex_bytes, index_bytes}},
+              .index_count = upload.index_count,
               .index_type = IndexType::k16bit,
           },
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
@@ -184,19 +282,38 @@ GeometryResult DLVerticesGeometry::GetPositionBuffer(
   };
 }
 
+GeometryResult DLVerticesGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  auto resource = GetResource(renderer);
+  auto upload = resource->GetPositions();
+  if (!upload.has_value()) {
+    // SkPoint has the layout of the position attribute, so the vertices are
+    // uploaded as they are.
+    upload = UploadVertexData(renderer, vertices_->vertices(),
+                              vertices_->vertex_count() * sizeof(float) * 2);
+    if (!upload.has_value()) {
+      return {};
+    }
+    resource->SetPositions(upload.value());
+  }
+  return MakeResult(upload.value(), entity, pass);
+}
+
 GeometryResult DLVerticesGeometry::GetPositionColorBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
   using VS = GeometryColorPipeline::VertexShader;
 
-  auto index_count = normalized_indices_.size() == 0
-                         ? vertices_->index_count()
-                         : normalized_indices_.size();
+  auto resource = GetResource(renderer);
+  auto upload = resource->GetPositionColors();
+  if (upload.has_value()) {
+    return MakeResult(upload.value(), entity, pass);
+  }
+
   auto vertex_count = vertices_->vertex_count();
-  auto* dl_indices = normalized_indices_.size() == 0
-                         ? vertices_->indices()
-                         : normalized_indices_.data();
   auto* dl_vertices = vertices_->vertices();
   auto* dl_colors = vertices_->colors();
 
@@ -215,42 +332,13 @@ GeometryResult DLVerticesGeometry::GetPositionColorBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
-    return {};
-  }
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(dl_indices)),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
+  upload = UploadVertexData(renderer, vertex_data.data(),
+                            vertex_data.size() * sizeof(VS::PerVertexData));
+  if (!upload.has_value()) {
     return {};
   }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(vertices_),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .index_count = index_count,
-              .index_type = IndexType::k16bit,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  resource->SetPositionColors(upload.value());
+  return MakeResult(upload.value(), entity, pass);
 }
 
 GeometryResult DLVerticesGeometry::GetPositionUVBuffer(
@@ -261,13 +349,13 @@ GeometryResult DLVerticesGeometry::GetPositionUVBuffer(
     RenderPass& pass) {
   using VS = TexturePipeline::VertexShader;
 
-  auto index_count = normalized_indices_.size() == 0
-                         ? vertices_->index_count()
-                         : normalized_indices_.size();
+  auto resource = GetResource(renderer);
+  auto upload = resource->GetPositionUVs(texture_coverage, effect_transform);
+  if (upload.has_value()) {
+    return MakeResult(upload.value(), entity, pass);
+  }
+
   auto vertex_count = vertices_->vertex_count();
-  auto* dl_indices = normalized_indices_.size() == 0
-                         ? vertices_->indices()
-                         : normalized_indices_.data();
   auto* dl_vertices = vertices_->vertices();
   auto* dl_texture_coordinates = vertices_->texture_coordinates();
 
@@ -292,42 +380,13 @@ GeometryResult DLVerticesGeometry::GetPositionUVBuffer(
     }
   }
 
-  size_t total_vtx_bytes = vertex_data.size() * sizeof(VS::PerVertexData);
-  size_t total_idx_bytes = index_count * sizeof(uint16_t);
-
-  DeviceBufferDescriptor buffer_desc;
-  buffer_desc.size = total_vtx_bytes + total_idx_bytes;
-  buffer_desc.storage_mode = StorageMode::kHostVisible;
-
-  auto buffer =
-      renderer.GetContext()->GetResourceAllocator()->CreateBuffer(buffer_desc);
-
-  if (!buffer->CopyHostBuffer(reinterpret_cast<uint8_t*>(vertex_data.data()),
-                              Range{0, total_vtx_bytes}, 0)) {
+  upload = UploadVertexData(renderer, vertex_data.data(),
+                            vertex_data.size() * sizeof(VS::PerVertexData));
+  if (!upload.has_value()) {
     return {};
   }
-  if (!buffer->CopyHostBuffer(
-          reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(dl_indices)),
-          Range{0, total_idx_bytes}, total_vtx_bytes)) {
-    return {};
-  }
-
-  return GeometryResult{
-      .type = GetPrimitiveType(vertices_),
-      .vertex_buffer =
-          {
-              .vertex_buffer = {.buffer = buffer,
-                                .range = Range{0, total_vtx_bytes}},
-              .index_buffer = {.buffer = buffer,
-                               .range =
-                                   Range{total_vtx_bytes, total_idx_bytes}},
-              .index_count = index_count,
-              .index_type = IndexType::k16bit,
-          },
-      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
-      .prevent_overdraw = false,
-  };
+  resource->SetPositionUVs(upload.value(), texture_coverage, effect_transform);
+  return MakeResult(upload.value(), entity, pass);
 }
 
 GeometryVertexType DLVerticesGeometry::GetVertexType() const {
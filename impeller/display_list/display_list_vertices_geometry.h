@@ -17,6 +17,10 @@
 namespace impeller {
 
 /// @brief A geometry that is created from a vertices object.
+///
+///        The vertex buffers uploaded for the vertices are cached on the
+///        vertices object, so that a mesh which doesn't change is converted
+///        and uploaded once rather than every frame.
 class DLVerticesGeometry : public VerticesGeometry {
  public:
   explicit DLVerticesGeometry(const flutter::DlVertices* vertices);
@@ -59,10 +63,22 @@ class DLVerticesGeometry : public VerticesGeometry {
   std::optional<Rect> GetTextureCoordinateCoverge() const override;
 
  private:
-  void NormalizeIndices();
+  struct Upload;
+  class Resource;
+
+  std::vector<uint16_t> GetNormalizedIndices() const;
+
+  std::shared_ptr<Resource> GetResource(const ContentContext& renderer) const;
+
+  std::optional<Upload> UploadVertexData(const ContentContext& renderer,
+                                         const void* vertex_data,
+                                         size_t vertex_bytes) const;
+
+  GeometryResult MakeResult(const Upload& upload,
+                            const Entity& entity,
+                            RenderPass& pass) const;
 
   const flutter::DlVertices* vertices_;
-  std::vector<uint16_t> normalized_indices_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DLVerticesGeometry);
 };
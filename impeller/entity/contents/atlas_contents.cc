@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -192,6 +193,9 @@ bool AtlasContents::Render(const ContentContext& renderer,
       alpha_ <= 0.0) {
     return true;
   }
+  if (sampler_descriptor_.mip_filter != MipFilter::kNone) {
+    renderer.GenerateMipmapsIfNeeded(texture_);
+  }
 
   // Ensure that we use the actual computed bounds and not a cull-rect
   // approximation of them.
@@ -264,6 +268,68 @@ bool AtlasContents::Render(const ContentContext& renderer,
   return child_contents.Render(renderer, entity, pass);
 }
 
+// Instanced rendering
+// ---------------------------------------------------------
+
+// The data of one instance of the atlas pipelines. Matches the `Sprite`
+// struct of atlas_texture_fill.vert and atlas_color_fill.vert.
+struct AtlasSpriteData {
+  Vector4 basis;
+  Vector4 offset_and_size;
+  Vector4 texture_origin;
+  Color color;
+};
+
+static_assert(sizeof(AtlasSpriteData) == 64u);
+
+static bool CanRenderInstanced(const ContentContext& renderer,
+                               const std::vector<Matrix>& transforms) {
+  // The sprites are transformed in 2D by the vertex shader.
+  return renderer.SupportsInstancedAtlas() &&
+         std::all_of(transforms.begin(), transforms.end(),
+                     [](const Matrix& transform) {
+                       return transform.IsAffine();
+                     });
+}
+
+static BufferView CreateSpriteData(const std::vector<Rect>& texture_coords,
+                                   const std::vector<Matrix>& transforms,
+                                   const std::vector<Color>* colors,
+                                   HostBuffer& host_buffer) {
+  std::vector<AtlasSpriteData> sprites;
+  sprites.reserve(texture_coords.size());
+  for (size_t i = 0; i < texture_coords.size(); i++) {
+    const auto& m = transforms[i];
+    const auto& sample_rect = texture_coords[i];
+    sprites.push_back({
+        .basis = Vector4(m.m[0], m.m[1], m.m[4], m.m[5]),
+        .offset_and_size = Vector4(m.m[12], m.m[13], sample_rect.size.width,
+                                   sample_rect.size.height),
+        .texture_origin = Vector4(sample_rect.origin),
+        .color = colors ? (*colors)[i].Premultiply() : Color(),
+    });
+  }
+  return host_buffer.Emplace(sprites.data(),
+                             sprites.size() * sizeof(AtlasSpriteData),
+                             DefaultUniformAlignment());
+}
+
+/// A quad from (0, 0) to (1, 1) that is drawn once for each sprite.
+template <class VertexShader>
+static VertexBuffer CreateUnitQuad(HostBuffer& host_buffer) {
+  VertexBufferBuilder<typename VertexShader::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {Point(0, 0)},
+      {Point(1, 0)},
+      {Point(0, 1)},
+      {Point(1, 1)},
+  });
+  for (auto index : {0, 1, 2, 1, 2, 3}) {
+    vertex_builder.AppendIndex(index);
+  }
+  return vertex_builder.CreateVertexBuffer(host_buffer);
+}
+
 // AtlasTextureContents
 // ---------------------------------------------------------
 
@@ -305,17 +371,23 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   using FS = TextureFillFragmentShader;
 
   auto texture = texture_.value_or(parent_.GetTexture());
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
-  if (subatlas_.has_value()) {
-    auto subatlas = subatlas_.value();
-    texture_coords = use_destination_ ? subatlas->result_texture_coords
-                                      : subatlas->sub_texture_coords;
-    transforms = use_destination_ ? subatlas->result_transforms
-                                  : subatlas->sub_transforms;
-  } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
+  const auto& subatlas = subatlas_.value_or(nullptr);
+  const std::vector<Rect>& texture_coords =
+      !subatlas          ? parent_.GetTextureCoordinates()
+      : use_destination_ ? subatlas->result_texture_coords
+                         : subatlas->sub_texture_coords;
+  const std::vector<Matrix>& transforms =
+      !subatlas          ? parent_.GetTransforms()
+      : use_destination_ ? subatlas->result_transforms
+                         : subatlas->sub_transforms;
+
+  if (texture_coords.empty()) {
+    return true;
+  }
+
+  if (CanRenderInstanced(renderer, transforms)) {
+    return RenderInstanced(renderer, entity, pass, texture, texture_coords,
+                           transforms);
   }
 
   const Size texture_size(texture->GetSize());
@@ -370,6 +442,45 @@ bool AtlasTextureContents::Render(const ContentContext& renderer,
   return pass.AddCommand(std::move(cmd));
 }
 
+bool AtlasTextureContents::RenderInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const std::shared_ptr<Texture>& texture,
+    const std::vector<Rect>& texture_coords,
+    const std::vector<Matrix>& transforms) const {
+  using VS = AtlasTexturePipeline::VertexShader;
+  using FS = AtlasTexturePipeline::FragmentShader;
+
+  Command cmd;
+  cmd.label = "AtlasTextureInstanced";
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+  frame_info.texture_size = Point(Size(texture->GetSize()));
+  frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = alpha_;
+
+  auto options = OptionsFromPassAndEntity(pass, entity);
+  cmd.pipeline = renderer.GetAtlasTexturePipeline(options);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(CreateUnitQuad<VS>(host_buffer));
+  cmd.instance_count = texture_coords.size();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  VS::BindSpriteData(cmd, CreateSpriteData(texture_coords, transforms,
+                                           nullptr, host_buffer));
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  FS::BindTextureSampler(cmd, texture,
+                         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                             parent_.GetSamplerDescriptor()));
+  return pass.AddCommand(std::move(cmd));
+}
+
 // AtlasColorContents
 // ---------------------------------------------------------
 
@@ -402,18 +513,21 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   using VS = GeometryColorPipeline::VertexShader;
   using FS = GeometryColorPipeline::FragmentShader;
 
-  std::vector<Rect> texture_coords;
-  std::vector<Matrix> transforms;
-  std::vector<Color> colors;
-  if (subatlas_.has_value()) {
-    auto subatlas = subatlas_.value();
-    texture_coords = subatlas->sub_texture_coords;
-    colors = subatlas->sub_colors;
-    transforms = subatlas->sub_transforms;
-  } else {
-    texture_coords = parent_.GetTextureCoordinates();
-    transforms = parent_.GetTransforms();
-    colors = parent_.GetColors();
+  const auto& subatlas = subatlas_.value_or(nullptr);
+  const std::vector<Rect>& texture_coords =
+      subatlas ? subatlas->sub_texture_coords : parent_.GetTextureCoordinates();
+  const std::vector<Matrix>& transforms =
+      subatlas ? subatlas->sub_transforms : parent_.GetTransforms();
+  const std::vector<Color>& colors =
+      subatlas ? subatlas->sub_colors : parent_.GetColors();
+
+  if (texture_coords.empty()) {
+    return true;
+  }
+
+  if (CanRenderInstanced(renderer, transforms)) {
+    return RenderInstanced(renderer, entity, pass, texture_coords, transforms,
+                           colors);
   }
 
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
@@ -459,4 +573,39 @@ bool AtlasColorContents::Render(const ContentContext& renderer,
   return pass.AddCommand(std::move(cmd));
 }
 
+bool AtlasColorContents::RenderInstanced(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    const std::vector<Rect>& texture_coords,
+    const std::vector<Matrix>& transforms,
+    const std::vector<Color>& colors) const {
+  using VS = AtlasColorPipeline::VertexShader;
+  using FS = AtlasColorPipeline::FragmentShader;
+
+  Command cmd;
+  cmd.label = "AtlasColorsInstanced";
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation();
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = alpha_;
+
+  auto opts = OptionsFromPassAndEntity(pass, entity);
+  opts.blend_mode = BlendMode::kSourceOver;
+  cmd.pipeline = renderer.GetAtlasColorPipeline(opts);
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(CreateUnitQuad<VS>(host_buffer));
+  cmd.instance_count = texture_coords.size();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+  VS::BindSpriteData(cmd, CreateSpriteData(texture_coords, transforms,
+                                           &colors, host_buffer));
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  return pass.AddCommand(std::move(cmd));
+}
+
 }  // namespace impeller
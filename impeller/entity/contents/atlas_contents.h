@@ -115,6 +115,16 @@ class AtlasTextureContents final : public Contents {
   void SetSubAtlas(const std::shared_ptr<SubAtlasResult>& subatlas);
 
  private:
+  /// @brief  Draws the sprites as instances of a quad, with the transform and
+  ///         texture rect of each sprite in a storage buffer instead of
+  ///         expanding them into vertices on the CPU.
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass,
+                       const std::shared_ptr<Texture>& texture,
+                       const std::vector<Rect>& texture_coords,
+                       const std::vector<Matrix>& transforms) const;
+
   const AtlasContents& parent_;
   Scalar alpha_ = 1.0;
   Rect coverage_;
@@ -146,6 +156,15 @@ class AtlasColorContents final : public Contents {
   void SetSubAtlas(const std::shared_ptr<SubAtlasResult>& subatlas);
 
  private:
+  /// @brief  Draws the colors of the sprites as instances of a quad, like
+  ///         `AtlasTextureContents::RenderInstanced`.
+  bool RenderInstanced(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass,
+                       const std::vector<Rect>& texture_coords,
+                       const std::vector<Matrix>& transforms,
+                       const std::vector<Color>& colors) const;
+
   const AtlasContents& parent_;
   Scalar alpha_ = 1.0;
   Rect coverage_;
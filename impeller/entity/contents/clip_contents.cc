@@ -30,6 +30,18 @@ void ClipContents::SetClipOperation(Entity::ClipOperation clip_op) {
   clip_op_ = clip_op;
 }
 
+std::optional<Rect> ClipContents::GetClipRect(const Entity& entity) const {
+  if (clip_op_ != Entity::ClipOperation::kIntersect || !geometry_) {
+    return std::nullopt;
+  }
+  auto coverage = geometry_->GetCoverage(entity.GetTransformation());
+  if (!coverage.has_value() ||
+      !geometry_->CoversArea(entity.GetTransformation(), coverage.value())) {
+    return std::nullopt;
+  }
+  return coverage;
+}
+
 std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
@@ -207,4 +219,14 @@ bool ClipRestoreContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool ClipContents::NeedsExtendedRange(const Entity& entity) const {
+  // Clips only write to the stencil.
+  return false;
+}
+
+bool ClipRestoreContents::NeedsExtendedRange(const Entity& entity) const {
+  // Clips only write to the stencil.
+  return false;
+}
+
 };  // namespace impeller
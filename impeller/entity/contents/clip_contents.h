@@ -25,6 +25,11 @@ class ClipContents final : public Contents {
 
   void SetClipOperation(Entity::ClipOperation clip_op);
 
+  /// @brief  The rectangle that the clip intersects the current clip with,
+  ///         in the space of the render target, or `std::nullopt` if the
+  ///         clip isn't an intersection with a rectangle there.
+  std::optional<Rect> GetClipRect(const Entity& entity) const;
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -42,6 +47,9 @@ class ClipContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
  private:
   std::unique_ptr<Geometry> geometry_;
   Entity::ClipOperation clip_op_ = Entity::ClipOperation::kIntersect;
@@ -78,6 +86,9 @@ class ClipRestoreContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
  private:
   std::optional<Rect> restore_coverage_;
 
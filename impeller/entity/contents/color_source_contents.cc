@@ -51,4 +51,12 @@ bool ColorSourceContents::ShouldRender(
   return Contents::ShouldRender(entity, stencil_coverage);
 }
 
+bool ColorSourceContents::CanInheritOpacity(const Entity& entity) const {
+  return geometry_ && geometry_->CoversPixelsOnce();
+}
+
+void ColorSourceContents::SetInheritedOpacity(Scalar opacity) {
+  SetAlpha(GetAlpha() * opacity);
+}
+
 }  // namespace impeller
@@ -7,9 +7,17 @@
 #include <memory>
 #include <sstream>
 
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/entity/pipeline_manifest_flatbuffers.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/shadow_cache.h"
+#include "impeller/entity/tessellation_cache.h"
+#include "impeller/renderer/blit_pass.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_pipeline_builder.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
@@ -162,15 +170,31 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
 
 ContentContext::ContentContext(std::shared_ptr<Context> context)
     : context_(std::move(context)),
-      tessellator_(std::make_shared<Tessellator>()),
-      glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
+      glyph_atlas_contexts_(
+          {{GlyphAtlas::Type::kSignedDistanceField,
+            std::make_shared<GlyphAtlasContext>()},
+           {GlyphAtlas::Type::kAlphaBitmap,
+            std::make_shared<GlyphAtlasContext>()},
+           {GlyphAtlas::Type::kColorBitmap,
+            std::make_shared<GlyphAtlasContext>()}}),
+      shadow_cache_(std::make_shared<ShadowCache>()),
+      gradient_cache_(std::make_shared<GradientCache>()),
+      tessellation_cache_(std::make_shared<TessellationCache>()),
       scene_context_(std::make_shared<scene::SceneContext>(context_)) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
+  render_target_cache_ =
+      std::make_shared<RenderTargetCache>(context_->GetResourceAllocator());
+  transients_buffer_ = HostBuffer::Create();
+  transients_buffer_->SetLabel("ContentContext Transients");
 
   solid_fill_pipelines_[{}] =
       CreateDefaultPipeline<SolidFillPipeline>(*context_);
+  solid_fill_coverage_pipelines_[{}] =
+      CreateDefaultPipeline<SolidFillCoveragePipeline>(*context_);
+  stroke_extrusion_pipelines_[{}] =
+      CreateDefaultPipeline<StrokeExtrusionPipeline>(*context_);
   linear_gradient_fill_pipelines_[{}] =
       CreateDefaultPipeline<LinearGradientFillPipeline>(*context_);
   radial_gradient_fill_pipelines_[{}] =
@@ -183,6 +207,38 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
     sweep_gradient_ssbo_fill_pipelines_[{}] =
         CreateDefaultPipeline<SweepGradientSSBOFillPipeline>(*context_);
   }
+  if (SupportsInstancedAtlas()) {
+    atlas_texture_pipelines_[{}] =
+        CreateDefaultPipeline<AtlasTexturePipeline>(*context_);
+    atlas_color_pipelines_[{}] =
+        CreateDefaultPipeline<AtlasColorPipeline>(*context_);
+    glyph_atlas_instanced_pipelines_[{}] =
+        CreateDefaultPipeline<GlyphAtlasInstancedPipeline>(*context_);
+    glyph_atlas_sdf_instanced_pipelines_[{}] =
+        CreateDefaultPipeline<GlyphAtlasSdfInstancedPipeline>(*context_);
+  }
+  if (context_->GetDeviceCapabilities().SupportsCompute()) {
+    pixel_buffer_pipelines_[{}] =
+        CreateDefaultPipeline<PixelBufferPipeline>(*context_);
+    auto texture_pipeline_desc =
+        ComputePipelineBuilder<SeparableFilterTextureComputeShader>::
+            MakeDefaultPipelineDescriptor(*context_);
+    separable_filter_texture_pipeline_ = context_->GetPipelineLibrary()
+                                          ->GetPipeline(texture_pipeline_desc)
+                                          .Get();
+    auto buffer_pipeline_desc =
+        ComputePipelineBuilder<SeparableFilterBufferComputeShader>::
+            MakeDefaultPipelineDescriptor(*context_);
+    separable_filter_buffer_pipeline_ = context_->GetPipelineLibrary()
+                                          ->GetPipeline(buffer_pipeline_desc)
+                                          .Get();
+    auto path_coverage_pipeline_desc =
+        ComputePipelineBuilder<PathCoverageComputeShader>::
+            MakeDefaultPipelineDescriptor(*context_);
+    path_coverage_pipeline_ = context_->GetPipelineLibrary()
+                                  ->GetPipeline(path_coverage_pipeline_desc)
+                                  .Get();
+  }
   if (context_->GetDeviceCapabilities().SupportsFramebufferFetch()) {
     framebuffer_blend_color_pipelines_[{}] =
         CreateDefaultPipeline<FramebufferBlendColorPipeline>(*context_);
@@ -256,10 +312,16 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
       CreateDefaultPipeline<PositionUVPipeline>(*context_);
   tiled_texture_pipelines_[{}] =
       CreateDefaultPipeline<TiledTexturePipeline>(*context_);
+  position_uv_no_decal_pipelines_[{}] =
+      CreateDefaultPipeline<PositionUVNoDecalPipeline>(*context_);
+  tiled_texture_no_decal_pipelines_[{}] =
+      CreateDefaultPipeline<TiledTextureNoDecalPipeline>(*context_);
   gaussian_blur_pipelines_[{}] =
       CreateDefaultPipeline<GaussianBlurPipeline>(*context_);
   gaussian_blur_decal_pipelines_[{}] =
       CreateDefaultPipeline<GaussianBlurDecalPipeline>(*context_);
+  dual_filter_blur_pipelines_[{}] =
+      CreateDefaultPipeline<DualFilterBlurPipeline>(*context_);
   border_mask_blur_pipelines_[{}] =
       CreateDefaultPipeline<BorderMaskBlurPipeline>(*context_);
   morphology_filter_pipelines_[{}] =
@@ -278,6 +340,8 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
       CreateDefaultPipeline<GeometryColorPipeline>(*context_);
   yuv_to_rgb_filter_pipelines_[{}] =
       CreateDefaultPipeline<YUVToRGBFilterPipeline>(*context_);
+  yuv_texture_pipelines_[{}] =
+      CreateDefaultPipeline<YUVTexturePipeline>(*context_);
 
   if (solid_fill_pipelines_[{}]->GetDescriptor().has_value()) {
     auto clip_pipeline_descriptor =
@@ -318,11 +382,13 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   if (context->GetDeviceCapabilities().SupportsOffscreenMSAA() &&
       msaa_enabled) {
     subpass_target = RenderTarget::CreateOffscreenMSAA(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *GetRenderTargetCache(), texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfigMSAA, std::nullopt);
   } else {
     subpass_target = RenderTarget::CreateOffscreen(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *GetRenderTargetCache(), texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfig, std::nullopt);
   }
   auto subpass_texture = subpass_target.GetRenderTargetTexture();
@@ -362,18 +428,124 @@ std::shared_ptr<scene::SceneContext> ContentContext::GetSceneContext() const {
 }
 
 std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
-  return tessellator_;
+  return Tessellator::GetForCurrentThread();
+}
+
+std::shared_ptr<RenderTargetAllocator> ContentContext::GetRenderTargetCache()
+    const {
+  return render_target_cache_;
+}
+
+std::shared_ptr<HostBuffer> ContentContext::GetTransientsBuffer() const {
+  return transients_buffer_;
+}
+
+std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext(
+    GlyphAtlas::Type type) const {
+  auto found = glyph_atlas_contexts_.find(type);
+  if (found == glyph_atlas_contexts_.end()) {
+    return nullptr;
+  }
+  return found->second;
+}
+
+std::shared_ptr<ShadowCache> ContentContext::GetShadowCache() const {
+  return shadow_cache_;
+}
+
+std::shared_ptr<GradientCache> ContentContext::GetGradientCache() const {
+  return gradient_cache_;
+}
+
+bool ContentContext::GenerateMipmapsIfNeeded(
+    const std::shared_ptr<Texture>& texture) const {
+  if (!texture || texture->GetMipCount() <= 1u) {
+    return false;
+  }
+  if (!texture->NeedsMipmapGeneration()) {
+    return true;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::GenerateMipmapsIfNeeded");
+  auto command_buffer = context_->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("Mipmap Command Buffer");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  blit_pass->SetLabel("Mipmap Blit Pass");
+  if (!blit_pass->GenerateMipmap(texture) ||
+      !blit_pass->EncodeCommands(context_->GetResourceAllocator())) {
+    return false;
+  }
+  return command_buffer->SubmitCommands();
 }
 
-std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext()
+std::shared_ptr<TessellationCache> ContentContext::GetTessellationCache()
     const {
-  return glyph_atlas_context_;
+  return tessellation_cache_;
+}
+
+size_t ContentContext::GetCachedResourceBytes() const {
+  size_t byte_size = shadow_cache_->GetByteSize() +
+                     gradient_cache_->GetByteSize() +
+                     tessellation_cache_->GetByteSize();
+  if (render_target_cache_) {
+    byte_size += render_target_cache_->CachedTextureBytes();
+  }
+  return byte_size;
+}
+
+void ContentContext::ReleaseCachedResources() {
+  shadow_cache_->Clear();
+  gradient_cache_->Clear();
+  tessellation_cache_->Clear();
+  if (render_target_cache_) {
+    render_target_cache_->Clear();
+  }
+}
+
+std::shared_ptr<Pipeline<PipelineDescriptor>>
+ContentContext::GetCachedRuntimeEffectPipeline(
+    const std::string& unique_entrypoint_name,
+    const ContentContextOptions& options,
+    const RuntimeEffectPipelineCreateCallback& create_callback) const {
+  RuntimeEffectPipelineKey key{unique_entrypoint_name, options};
+  auto it = runtime_effect_pipelines_.find(key);
+  if (it != runtime_effect_pipelines_.end()) {
+    return it->second;
+  }
+  auto pipeline = create_callback();
+  if (pipeline) {
+    runtime_effect_pipelines_[std::move(key)] = pipeline;
+  }
+  return pipeline;
+}
+
+void ContentContext::ClearCachedRuntimeEffectPipeline(
+    const std::string& unique_entrypoint_name) const {
+  for (auto it = runtime_effect_pipelines_.begin();
+       it != runtime_effect_pipelines_.end();) {
+    if (it->first.unique_entrypoint_name == unique_entrypoint_name) {
+      it = runtime_effect_pipelines_.erase(it);
+    } else {
+      it++;
+    }
+  }
 }
 
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
 
+bool ContentContext::SupportsInstancedAtlas() const {
+  const auto& capabilities = GetDeviceCapabilities();
+  return capabilities.SupportsSSBO() &&
+         capabilities.SupportsInstancedRendering();
+}
+
 const IDeviceCapabilities& ContentContext::GetDeviceCapabilities() const {
   return context_->GetDeviceCapabilities();
 }
@@ -382,4 +554,156 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetOverdrawHeatmap(bool overdraw_heatmap) {
+  overdraw_heatmap_ = overdraw_heatmap;
+}
+
+bool ContentContext::IsOverdrawHeatmapEnabled() const {
+  return overdraw_heatmap_;
+}
+
+void ContentContext::SetOverdrawSummary(OverdrawSummary summary) {
+  overdraw_summary_ = summary;
+}
+
+std::optional<OverdrawSummary> ContentContext::GetOverdrawSummary() const {
+  return overdraw_summary_;
+}
+
+void ContentContext::SetEntityBatchingEnabled(bool enabled) {
+  entity_batching_enabled_ = enabled;
+}
+
+bool ContentContext::IsEntityBatchingEnabled() const {
+  return entity_batching_enabled_;
+}
+
+void ContentContext::PrewarmPipelineVariants(
+    const std::vector<PipelineVariant>& variants) const {
+  if (!IsValid() || variants.empty()) {
+    return;
+  }
+  PrewarmVariants(solid_fill_pipelines_, variants);
+  PrewarmVariants(solid_fill_coverage_pipelines_, variants);
+  PrewarmVariants(stroke_extrusion_pipelines_, variants);
+  PrewarmVariants(linear_gradient_fill_pipelines_, variants);
+  PrewarmVariants(radial_gradient_fill_pipelines_, variants);
+  PrewarmVariants(sweep_gradient_fill_pipelines_, variants);
+  PrewarmVariants(linear_gradient_ssbo_fill_pipelines_, variants);
+  PrewarmVariants(radial_gradient_ssbo_fill_pipelines_, variants);
+  PrewarmVariants(sweep_gradient_ssbo_fill_pipelines_, variants);
+  PrewarmVariants(pixel_buffer_pipelines_, variants);
+  PrewarmVariants(rrect_blur_pipelines_, variants);
+  PrewarmVariants(texture_blend_pipelines_, variants);
+  PrewarmVariants(texture_pipelines_, variants);
+  PrewarmVariants(position_uv_pipelines_, variants);
+  PrewarmVariants(tiled_texture_pipelines_, variants);
+  PrewarmVariants(position_uv_no_decal_pipelines_, variants);
+  PrewarmVariants(tiled_texture_no_decal_pipelines_, variants);
+  PrewarmVariants(gaussian_blur_pipelines_, variants);
+  PrewarmVariants(gaussian_blur_decal_pipelines_, variants);
+  PrewarmVariants(dual_filter_blur_pipelines_, variants);
+  PrewarmVariants(border_mask_blur_pipelines_, variants);
+  PrewarmVariants(morphology_filter_pipelines_, variants);
+  PrewarmVariants(color_matrix_color_filter_pipelines_, variants);
+  PrewarmVariants(linear_to_srgb_filter_pipelines_, variants);
+  PrewarmVariants(srgb_to_linear_filter_pipelines_, variants);
+  PrewarmVariants(clip_pipelines_, variants);
+  PrewarmVariants(glyph_atlas_pipelines_, variants);
+  PrewarmVariants(glyph_atlas_sdf_pipelines_, variants);
+  PrewarmVariants(glyph_atlas_instanced_pipelines_, variants);
+  PrewarmVariants(glyph_atlas_sdf_instanced_pipelines_, variants);
+  PrewarmVariants(geometry_color_pipelines_, variants);
+  PrewarmVariants(atlas_texture_pipelines_, variants);
+  PrewarmVariants(atlas_color_pipelines_, variants);
+  PrewarmVariants(yuv_to_rgb_filter_pipelines_, variants);
+  PrewarmVariants(yuv_texture_pipelines_, variants);
+  PrewarmVariants(blend_color_pipelines_, variants);
+  PrewarmVariants(blend_colorburn_pipelines_, variants);
+  PrewarmVariants(blend_colordodge_pipelines_, variants);
+  PrewarmVariants(blend_darken_pipelines_, variants);
+  PrewarmVariants(blend_difference_pipelines_, variants);
+  PrewarmVariants(blend_exclusion_pipelines_, variants);
+  PrewarmVariants(blend_hardlight_pipelines_, variants);
+  PrewarmVariants(blend_hue_pipelines_, variants);
+  PrewarmVariants(blend_lighten_pipelines_, variants);
+  PrewarmVariants(blend_luminosity_pipelines_, variants);
+  PrewarmVariants(blend_multiply_pipelines_, variants);
+  PrewarmVariants(blend_overlay_pipelines_, variants);
+  PrewarmVariants(blend_saturation_pipelines_, variants);
+  PrewarmVariants(blend_screen_pipelines_, variants);
+  PrewarmVariants(blend_softlight_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_color_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_colorburn_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_colordodge_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_darken_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_difference_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_exclusion_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_hardlight_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_hue_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_lighten_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_luminosity_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_multiply_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_overlay_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_saturation_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_screen_pipelines_, variants);
+  PrewarmVariants(framebuffer_blend_softlight_pipelines_, variants);
+}
+
+std::vector<ContentContext::PipelineVariant>
+ContentContext::GetRequestedPipelineVariants() const {
+  return requested_variants_;
+}
+
+size_t ContentContext::GetRequestedPipelineVariantCount() const {
+  return requested_variants_.size();
+}
+
+std::unique_ptr<fml::Mapping> ContentContext::SerializePipelineVariants(
+    const std::vector<PipelineVariant>& variants) {
+  auto builder = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  std::vector<flatbuffers::Offset<fb::PipelineVariant>> fb_variants;
+  fb_variants.reserve(variants.size());
+  for (const auto& variant : variants) {
+    fb_variants.push_back(fb::CreatePipelineVariant(
+        *builder, builder->CreateString(variant.pipeline_label),
+        variant.options.ToKey()));
+  }
+  builder->Finish(
+      fb::CreatePipelineManifest(*builder, builder->CreateVector(fb_variants)),
+      fb::PipelineManifestIdentifier());
+  return std::make_unique<fml::NonOwnedMapping>(builder->GetBufferPointer(),
+                                                builder->GetSize(),
+                                                [builder](auto, auto) {});
+}
+
+std::vector<ContentContext::PipelineVariant>
+ContentContext::DeserializePipelineVariants(const fml::Mapping& manifest) {
+  std::vector<PipelineVariant> variants;
+  if (manifest.GetMapping() == nullptr ||
+      !fb::PipelineManifestBufferHasIdentifier(manifest.GetMapping())) {
+    return variants;
+  }
+  flatbuffers::Verifier verifier(manifest.GetMapping(), manifest.GetSize());
+  if (!fb::VerifyPipelineManifestBuffer(verifier)) {
+    VALIDATION_LOG << "Pipeline manifest is corrupt.";
+    return variants;
+  }
+  auto fb_variants = fb::GetPipelineManifest(manifest.GetMapping())->variants();
+  if (!fb_variants) {
+    return variants;
+  }
+  for (const auto* fb_variant : *fb_variants) {
+    // Bits beyond those of the options are never set by `ToKey`.
+    if (fb_variant->options() >> 51 != 0) {
+      continue;
+    }
+    variants.push_back(
+        {fb_variant->pipeline_label() ? fb_variant->pipeline_label()->str()
+                                      : std::string(),
+         ContentContextOptions::FromKey(fb_variant->options())});
+  }
+  return variants;
+}
+
 }  // namespace impeller
@@ -4,13 +4,18 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/base/validation.h"
 #include "impeller/entity/blend.frag.h"
 #include "impeller/entity/blend.vert.h"
@@ -18,6 +23,7 @@
 #include "impeller/entity/border_mask_blur.vert.h"
 #include "impeller/entity/color_matrix_color_filter.frag.h"
 #include "impeller/entity/color_matrix_color_filter.vert.h"
+#include "impeller/entity/dual_filter_blur.frag.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/gaussian_blur.frag.h"
 #include "impeller/entity/gaussian_blur.vert.h"
@@ -37,6 +43,9 @@
 #include "impeller/entity/rrect_blur.vert.h"
 #include "impeller/entity/solid_fill.frag.h"
 #include "impeller/entity/solid_fill.vert.h"
+#include "impeller/entity/solid_fill_coverage.frag.h"
+#include "impeller/entity/solid_fill_coverage.vert.h"
+#include "impeller/entity/stroke_extrusion.vert.h"
 #include "impeller/entity/srgb_to_linear_filter.frag.h"
 #include "impeller/entity/srgb_to_linear_filter.vert.h"
 #include "impeller/entity/sweep_gradient_fill.frag.h"
@@ -44,11 +53,14 @@
 #include "impeller/entity/texture_fill.vert.h"
 #include "impeller/entity/tiled_texture_fill.frag.h"
 #include "impeller/entity/tiled_texture_fill.vert.h"
+#include "impeller/entity/tiled_texture_fill_no_decal.frag.h"
 #include "impeller/entity/vertices.frag.h"
+#include "impeller/entity/yuv_texture_fill.frag.h"
 #include "impeller/entity/yuv_to_rgb_filter.frag.h"
 #include "impeller/entity/yuv_to_rgb_filter.vert.h"
 #include "impeller/renderer/device_capabilities.h"
 #include "impeller/renderer/formats.h"
+#include "impeller/renderer/host_buffer.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/scene/scene_context.h"
 
@@ -57,9 +69,17 @@
 #include "impeller/scene/scene_context.h"
 #include "impeller/typographer/glyph_atlas.h"
 
+#include "impeller/entity/atlas_color_fill.vert.h"
+#include "impeller/entity/atlas_texture_fill.vert.h"
+#include "impeller/entity/glyph_atlas_instanced.vert.h"
 #include "impeller/entity/linear_gradient_ssbo_fill.frag.h"
+#include "impeller/entity/pixel_buffer.frag.h"
 #include "impeller/entity/radial_gradient_ssbo_fill.frag.h"
+#include "impeller/entity/path_coverage.comp.h"
+#include "impeller/entity/separable_filter_buffer.comp.h"
+#include "impeller/entity/separable_filter_texture.comp.h"
 #include "impeller/entity/sweep_gradient_ssbo_fill.frag.h"
+#include "impeller/renderer/compute_pipeline_descriptor.h"
 
 #include "impeller/entity/advanced_blend.vert.h"
 #include "impeller/entity/advanced_blend_color.frag.h"
@@ -101,6 +121,11 @@ using LinearGradientFillPipeline =
     RenderPipelineT<GradientFillVertexShader, LinearGradientFillFragmentShader>;
 using SolidFillPipeline =
     RenderPipelineT<SolidFillVertexShader, SolidFillFragmentShader>;
+using SolidFillCoveragePipeline =
+    RenderPipelineT<SolidFillCoverageVertexShader,
+                    SolidFillCoverageFragmentShader>;
+using StrokeExtrusionPipeline =
+    RenderPipelineT<StrokeExtrusionVertexShader, SolidFillFragmentShader>;
 using RadialGradientFillPipeline =
     RenderPipelineT<GradientFillVertexShader, RadialGradientFillFragmentShader>;
 using SweepGradientFillPipeline =
@@ -111,9 +136,15 @@ using LinearGradientSSBOFillPipeline =
 using RadialGradientSSBOFillPipeline =
     RenderPipelineT<GradientFillVertexShader,
                     RadialGradientSsboFillFragmentShader>;
+using PixelBufferPipeline =
+    RenderPipelineT<TextureFillVertexShader, PixelBufferFragmentShader>;
 using SweepGradientSSBOFillPipeline =
     RenderPipelineT<GradientFillVertexShader,
                     SweepGradientSsboFillFragmentShader>;
+using AtlasTexturePipeline =
+    RenderPipelineT<AtlasTextureFillVertexShader, TextureFillFragmentShader>;
+using AtlasColorPipeline =
+    RenderPipelineT<AtlasColorFillVertexShader, VerticesFragmentShader>;
 using BlendPipeline = RenderPipelineT<BlendVertexShader, BlendFragmentShader>;
 using RRectBlurPipeline =
     RenderPipelineT<RrectBlurVertexShader, RrectBlurFragmentShader>;
@@ -124,10 +155,20 @@ using PositionUVPipeline =
     RenderPipelineT<TextureFillVertexShader, TiledTextureFillFragmentShader>;
 using TiledTexturePipeline = RenderPipelineT<TiledTextureFillVertexShader,
                                              TiledTextureFillFragmentShader>;
+// Variants of the two above for the tile modes that the sampler applies by
+// itself, which skip the emulation of decal tiling.
+using PositionUVNoDecalPipeline =
+    RenderPipelineT<TextureFillVertexShader,
+                    TiledTextureFillNoDecalFragmentShader>;
+using TiledTextureNoDecalPipeline =
+    RenderPipelineT<TiledTextureFillVertexShader,
+                    TiledTextureFillNoDecalFragmentShader>;
 using GaussianBlurPipeline =
     RenderPipelineT<GaussianBlurVertexShader, GaussianBlurFragmentShader>;
 using GaussianBlurDecalPipeline =
     RenderPipelineT<GaussianBlurVertexShader, GaussianBlurDecalFragmentShader>;
+using DualFilterBlurPipeline =
+    RenderPipelineT<TextureFillVertexShader, DualFilterBlurFragmentShader>;
 using BorderMaskBlurPipeline =
     RenderPipelineT<BorderMaskBlurVertexShader, BorderMaskBlurFragmentShader>;
 using MorphologyFilterPipeline =
@@ -146,6 +187,11 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasSdfPipeline =
     RenderPipelineT<GlyphAtlasSdfVertexShader, GlyphAtlasSdfFragmentShader>;
+using GlyphAtlasInstancedPipeline =
+    RenderPipelineT<GlyphAtlasInstancedVertexShader, GlyphAtlasFragmentShader>;
+using GlyphAtlasSdfInstancedPipeline =
+    RenderPipelineT<GlyphAtlasInstancedVertexShader,
+                    GlyphAtlasSdfFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
 // to redirect writing to the stencil instead of color attachments.
 using ClipPipeline =
@@ -155,6 +201,9 @@ using GeometryColorPipeline =
     RenderPipelineT<PositionColorVertexShader, VerticesFragmentShader>;
 using YUVToRGBFilterPipeline =
     RenderPipelineT<YuvToRgbFilterVertexShader, YuvToRgbFilterFragmentShader>;
+// Samples the planes of a YUV texture directly, converting them to RGB.
+using YUVTexturePipeline =
+    RenderPipelineT<TextureFillVertexShader, YuvTextureFillFragmentShader>;
 
 // Advanced blends
 using BlendColorPipeline = RenderPipelineT<AdvancedBlendVertexShader,
@@ -265,27 +314,55 @@ struct ContentContextOptions {
   bool has_stencil_attachment = true;
   bool wireframe = false;
 
+  /// @brief  A key that is unique to the options, so that looking up the
+  ///         pipeline variants of each draw only hashes and compares a
+  ///         single integer.
+  ///
+  ///         Each of the enums is given 8 bits, which all of their values
+  ///         fit in.
+  constexpr uint64_t ToKey() const {
+    return static_cast<uint64_t>(sample_count) |
+           static_cast<uint64_t>(blend_mode) << 8 |
+           static_cast<uint64_t>(stencil_compare) << 16 |
+           static_cast<uint64_t>(stencil_operation) << 24 |
+           static_cast<uint64_t>(primitive_type) << 32 |
+           static_cast<uint64_t>(color_attachment_pixel_format.has_value()
+                                     ? color_attachment_pixel_format.value()
+                                     : PixelFormat::kUnknown)
+               << 40 |
+           static_cast<uint64_t>(color_attachment_pixel_format.has_value())
+               << 48 |
+           static_cast<uint64_t>(has_stencil_attachment) << 49 |
+           static_cast<uint64_t>(wireframe) << 50;
+  }
+
+  /// @brief  The options that `ToKey` returns the key of.
+  static constexpr ContentContextOptions FromKey(uint64_t key) {
+    ContentContextOptions opts;
+    opts.sample_count = static_cast<SampleCount>(key & 0xff);
+    opts.blend_mode = static_cast<BlendMode>(key >> 8 & 0xff);
+    opts.stencil_compare = static_cast<CompareFunction>(key >> 16 & 0xff);
+    opts.stencil_operation = static_cast<StencilOperation>(key >> 24 & 0xff);
+    opts.primitive_type = static_cast<PrimitiveType>(key >> 32 & 0xff);
+    if (key >> 48 & 1) {
+      opts.color_attachment_pixel_format =
+          static_cast<PixelFormat>(key >> 40 & 0xff);
+    }
+    opts.has_stencil_attachment = key >> 49 & 1;
+    opts.wireframe = key >> 50 & 1;
+    return opts;
+  }
+
   struct Hash {
     constexpr std::size_t operator()(const ContentContextOptions& o) const {
-      return fml::HashCombine(o.sample_count, o.blend_mode, o.stencil_compare,
-                              o.stencil_operation, o.primitive_type,
-                              o.color_attachment_pixel_format,
-                              o.has_stencil_attachment, o.wireframe);
+      return o.ToKey();
     }
   };
 
   struct Equal {
     constexpr bool operator()(const ContentContextOptions& lhs,
                               const ContentContextOptions& rhs) const {
-      return lhs.sample_count == rhs.sample_count &&
-             lhs.blend_mode == rhs.blend_mode &&
-             lhs.stencil_compare == rhs.stencil_compare &&
-             lhs.stencil_operation == rhs.stencil_operation &&
-             lhs.primitive_type == rhs.primitive_type &&
-             lhs.color_attachment_pixel_format ==
-                 rhs.color_attachment_pixel_format &&
-             lhs.has_stencil_attachment == rhs.has_stencil_attachment &&
-             lhs.wireframe == rhs.wireframe;
+      return lhs.ToKey() == rhs.ToKey();
     }
   };
 
@@ -293,6 +370,22 @@ struct ContentContextOptions {
 };
 
 class Tessellator;
+class RenderTargetAllocator;
+class RenderTargetCache;
+class GradientCache;
+class ShadowCache;
+class TessellationCache;
+
+/// @brief  How much the last entity pass rendered with the overdraw heatmap
+///         enabled drew over each pixel of its target.
+struct OverdrawSummary {
+  /// The area drawn by all of the entities, including the ones in subpasses,
+  /// divided by the area of the target.
+  Scalar average_overdraw = 0;
+  size_t subpass_count = 0u;
+  /// The area of the offscreen textures of all of the subpasses.
+  size_t offscreen_pixel_count = 0u;
+};
 
 class ContentContext {
  public:
@@ -304,8 +397,18 @@ class ContentContext {
 
   std::shared_ptr<scene::SceneContext> GetSceneContext() const;
 
+  /// @brief  The tessellator of the calling thread. It must not be shared
+  ///         with other threads.
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  /// @brief  The allocator used for the offscreen render targets of entity
+  ///         passes and subpasses, which reuses their textures across frames.
+  std::shared_ptr<RenderTargetAllocator> GetRenderTargetCache() const;
+
+  /// @brief  The host buffer that the render passes of entity passes emplace
+  ///         their transient data onto. It is reset once per frame.
+  std::shared_ptr<HostBuffer> GetTransientsBuffer() const;
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetLinearGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(linear_gradient_fill_pipelines_, opts);
@@ -329,6 +432,54 @@ class ContentContext {
     return GetPipeline(sweep_gradient_ssbo_fill_pipelines_, opts);
   }
 
+  /// @brief  Draws the sprites of an atlas as instances of a quad. Only
+  ///         available when the device supports SSBOs and instancing.
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetAtlasTexturePipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(SupportsInstancedAtlas());
+    return GetPipeline(atlas_texture_pipelines_, opts);
+  }
+
+  /// @brief  Draws the colors of the sprites of an atlas as instances of a
+  ///         quad. Only available when the device supports SSBOs and
+  ///         instancing.
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetAtlasColorPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(SupportsInstancedAtlas());
+    return GetPipeline(atlas_color_pipelines_, opts);
+  }
+
+  /// @brief  Whether the atlas pipelines are available.
+  bool SupportsInstancedAtlas() const;
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetPixelBufferPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(GetDeviceCapabilities().SupportsCompute());
+    return GetPipeline(pixel_buffer_pipelines_, opts);
+  }
+
+  /// @brief  The first pass of a separable filter, which reads a texture.
+  ///         Only available when the device supports compute.
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+  GetSeparableFilterTexturePipeline() const {
+    return separable_filter_texture_pipeline_;
+  }
+
+  /// @brief  The second pass of a separable filter, which reads the pixels
+  ///         written by the first pass. Only available when the device
+  ///         supports compute.
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+  GetSeparableFilterBufferPipeline() const {
+    return separable_filter_buffer_pipeline_;
+  }
+
+  /// @brief  Computes the coverage of a filled path. Only available when the
+  ///         device supports compute.
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>> GetPathCoveragePipeline()
+      const {
+    return path_coverage_pipeline_;
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetRadialGradientFillPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(radial_gradient_fill_pipelines_, opts);
@@ -349,6 +500,16 @@ class ContentContext {
     return GetPipeline(solid_fill_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetSolidFillCoveragePipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(solid_fill_coverage_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetStrokeExtrusionPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(stroke_extrusion_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBlendPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(texture_blend_pipelines_, opts);
@@ -369,6 +530,16 @@ class ContentContext {
     return GetPipeline(tiled_texture_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetPositionUVNoDecalPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(position_uv_no_decal_pipelines_, opts);
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetTiledTextureNoDecalPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(tiled_texture_no_decal_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGaussianBlurPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(gaussian_blur_pipelines_, opts);
@@ -379,6 +550,11 @@ class ContentContext {
     return GetPipeline(gaussian_blur_decal_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetDualFilterBlurPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(dual_filter_blur_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBorderMaskBlurPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(border_mask_blur_pipelines_, opts);
@@ -419,6 +595,23 @@ class ContentContext {
     return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
   }
 
+  /// @brief  Draws glyphs as instances of a quad. Only available when the
+  ///         device supports SSBOs and instancing.
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasInstancedPipeline(
+      ContentContextOptions opts) const {
+    FML_DCHECK(SupportsInstancedAtlas());
+    return GetPipeline(glyph_atlas_instanced_pipelines_, opts);
+  }
+
+  /// @brief  Draws glyphs from a signed-distance field atlas as instances of
+  ///         a quad. Only available when the device supports SSBOs and
+  ///         instancing.
+  std::shared_ptr<Pipeline<PipelineDescriptor>>
+  GetGlyphAtlasSdfInstancedPipeline(ContentContextOptions opts) const {
+    FML_DCHECK(SupportsInstancedAtlas());
+    return GetPipeline(glyph_atlas_sdf_instanced_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -429,6 +622,11 @@ class ContentContext {
     return GetPipeline(yuv_to_rgb_filter_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetYUVTexturePipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(yuv_texture_pipelines_, opts);
+  }
+
   // Advanced blends.
 
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetBlendColorPipeline(
@@ -599,12 +797,126 @@ class ContentContext {
 
   std::shared_ptr<Context> GetContext() const;
 
-  std::shared_ptr<GlyphAtlasContext> GetGlyphAtlasContext() const;
+  /// @brief  The glyph atlas of the type that is kept across frames. Each type
+  ///         has its own, so drawing text of several types in a frame
+  ///         doesn't rebuild the atlases.
+  std::shared_ptr<GlyphAtlasContext> GetGlyphAtlasContext(
+      GlyphAtlas::Type type) const;
+
+  /// @brief  The textures of rounded rect shadows that are kept across frames.
+  std::shared_ptr<ShadowCache> GetShadowCache() const;
+
+  /// @brief  The color ramp textures of gradients that are kept across
+  ///         frames.
+  std::shared_ptr<GradientCache> GetGradientCache() const;
+
+  /// @brief  Generates the mip levels of `texture` from its base level if
+  ///         they weren't generated yet, so that it can be sampled with a mip
+  ///         filter. The blit is submitted right away, ahead of the command
+  ///         buffers of the passes that sample the texture.
+  ///
+  /// @return Whether the mip levels of the texture are ready to be sampled.
+  bool GenerateMipmapsIfNeeded(const std::shared_ptr<Texture>& texture) const;
+
+  /// @brief  The vertices of filled paths that are kept across frames.
+  std::shared_ptr<TessellationCache> GetTessellationCache() const;
+
+  /// @brief  The approximate size of the textures and buffers that are kept
+  ///         across frames by the render target, shadow, gradient and
+  ///         tessellation caches.
+  size_t GetCachedResourceBytes() const;
+
+  /// @brief  Releases the textures and buffers kept across frames by the
+  ///         render target, shadow, gradient and tessellation caches. They are
+  ///         recreated as they are needed again, so this should only be
+  ///         done when the system is low on memory.
+  void ReleaseCachedResources();
+
+  using RuntimeEffectPipelineCreateCallback =
+      std::function<std::shared_ptr<Pipeline<PipelineDescriptor>>()>;
+
+  /// @brief  Gets the pipeline of a runtime effect fragment function with the
+  ///         given options, calling `create_callback` to create it only if it
+  ///         isn't cached yet. Failures to create a pipeline aren't cached.
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetCachedRuntimeEffectPipeline(
+      const std::string& unique_entrypoint_name,
+      const ContentContextOptions& options,
+      const RuntimeEffectPipelineCreateCallback& create_callback) const;
+
+  /// @brief  Forgets the cached pipelines of a runtime effect fragment
+  ///         function, such as when it is replaced by a hot reload.
+  void ClearCachedRuntimeEffectPipeline(
+      const std::string& unique_entrypoint_name) const;
 
   const IDeviceCapabilities& GetDeviceCapabilities() const;
 
   void SetWireframe(bool wireframe);
 
+  /// @brief  Whether entity passes render a heatmap of how many entities draw
+  ///         over each pixel instead of their contents. Each entity adds red
+  ///         over its coverage, and each offscreen subpass adds blue, so the
+  ///         brighter a pixel the more often it is drawn.
+  void SetOverdrawHeatmap(bool overdraw_heatmap);
+
+  bool IsOverdrawHeatmapEnabled() const;
+
+  /// @brief  Records the overdraw of the pass last rendered as a heatmap.
+  void SetOverdrawSummary(OverdrawSummary summary);
+
+  /// @return The overdraw of the pass last rendered as a heatmap, if any
+  ///         was.
+  std::optional<OverdrawSummary> GetOverdrawSummary() const;
+
+  /// @brief  Whether entity passes may reorder entities that don't overlap
+  ///         to group the ones rendered with the same pipeline and texture,
+  ///         and merge adjacent solid color fills into a single draw.
+  void SetEntityBatchingEnabled(bool enabled);
+
+  bool IsEntityBatchingEnabled() const;
+
+  /// @brief  A variant of one of the pipelines, or of all of them.
+  struct PipelineVariant {
+    /// @brief  The label of the pipeline the variant is created from, or an
+    ///         empty string for every pipeline.
+    std::string pipeline_label;
+    ContentContextOptions options;
+  };
+
+  /// @brief  Starts compiling the given pipeline variants so that the first
+  ///         draws that use them don't have to wait for the whole compile.
+  ///
+  ///         The variants are compiled on the workers of the backend and
+  ///         this call doesn't wait for them. A draw that needs a variant
+  ///         that is still compiling waits only for the rest of the compile.
+  ///         Variants of pipelines that the device doesn't support are
+  ///         ignored.
+  ///
+  ///         The result of `GetRequestedPipelineVariants` from a previous
+  ///         run is a good manifest of what to prewarm. Like the getters of
+  ///         the pipelines, this must be called on the raster thread.
+  void PrewarmPipelineVariants(
+      const std::vector<PipelineVariant>& variants) const;
+
+  /// @brief  The variants requested by draws so far, in the order they were
+  ///         first requested, excluding the prototypes that are created
+  ///         with the context.
+  std::vector<PipelineVariant> GetRequestedPipelineVariants() const;
+
+  /// @brief  The number of variants that `GetRequestedPipelineVariants`
+  ///         returns, without copying them.
+  size_t GetRequestedPipelineVariantCount() const;
+
+  /// @brief  Encodes pipeline variants into a manifest that can be kept
+  ///         across runs of the same engine.
+  static std::unique_ptr<fml::Mapping> SerializePipelineVariants(
+      const std::vector<PipelineVariant>& variants);
+
+  /// @brief  Decodes the pipeline variants of a manifest created by
+  ///         `SerializePipelineVariants`. Manifests that aren't valid have
+  ///         no variants.
+  static std::vector<PipelineVariant> DeserializePipelineVariants(
+      const fml::Mapping& manifest);
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -628,6 +940,8 @@ class ContentContext {
   // variants requested from that are lazily created and cached in the variants
   // map.
   mutable Variants<SolidFillPipeline> solid_fill_pipelines_;
+  mutable Variants<SolidFillCoveragePipeline> solid_fill_coverage_pipelines_;
+  mutable Variants<StrokeExtrusionPipeline> stroke_extrusion_pipelines_;
   mutable Variants<LinearGradientFillPipeline> linear_gradient_fill_pipelines_;
   mutable Variants<RadialGradientFillPipeline> radial_gradient_fill_pipelines_;
   mutable Variants<SweepGradientFillPipeline> sweep_gradient_fill_pipelines_;
@@ -637,13 +951,23 @@ class ContentContext {
       radial_gradient_ssbo_fill_pipelines_;
   mutable Variants<SweepGradientSSBOFillPipeline>
       sweep_gradient_ssbo_fill_pipelines_;
+  mutable Variants<PixelBufferPipeline> pixel_buffer_pipelines_;
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+      separable_filter_texture_pipeline_;
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>>
+      separable_filter_buffer_pipeline_;
+  std::shared_ptr<Pipeline<ComputePipelineDescriptor>> path_coverage_pipeline_;
   mutable Variants<RRectBlurPipeline> rrect_blur_pipelines_;
   mutable Variants<BlendPipeline> texture_blend_pipelines_;
   mutable Variants<TexturePipeline> texture_pipelines_;
   mutable Variants<PositionUVPipeline> position_uv_pipelines_;
   mutable Variants<TiledTexturePipeline> tiled_texture_pipelines_;
+  mutable Variants<PositionUVNoDecalPipeline> position_uv_no_decal_pipelines_;
+  mutable Variants<TiledTextureNoDecalPipeline>
+      tiled_texture_no_decal_pipelines_;
   mutable Variants<GaussianBlurPipeline> gaussian_blur_pipelines_;
   mutable Variants<GaussianBlurDecalPipeline> gaussian_blur_decal_pipelines_;
+  mutable Variants<DualFilterBlurPipeline> dual_filter_blur_pipelines_;
   mutable Variants<BorderMaskBlurPipeline> border_mask_blur_pipelines_;
   mutable Variants<MorphologyFilterPipeline> morphology_filter_pipelines_;
   mutable Variants<ColorMatrixColorFilterPipeline>
@@ -653,8 +977,15 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
+  mutable Variants<GlyphAtlasInstancedPipeline>
+      glyph_atlas_instanced_pipelines_;
+  mutable Variants<GlyphAtlasSdfInstancedPipeline>
+      glyph_atlas_sdf_instanced_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
+  mutable Variants<AtlasTexturePipeline> atlas_texture_pipelines_;
+  mutable Variants<AtlasColorPipeline> atlas_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
+  mutable Variants<YUVTexturePipeline> yuv_texture_pipelines_;
   // Advanced blends.
   mutable Variants<BlendColorPipeline> blend_color_pipelines_;
   mutable Variants<BlendColorBurnPipeline> blend_colorburn_pipelines_;
@@ -716,6 +1047,11 @@ class ContentContext {
     }
 
     if (auto found = container.find(opts); found != container.end()) {
+      // Prewarmed variants are recorded by their first draw.
+      if (!prewarmed_variants_.empty() &&
+          prewarmed_variants_.erase(found->second.get()) > 0) {
+        RecordRequestedVariant(container, opts);
+      }
       return found->second->WaitAndGet();
     }
 
@@ -724,23 +1060,107 @@ class ContentContext {
     // The prototype must always be initialized in the constructor.
     FML_CHECK(prototype != container.end());
 
-    auto variant_future = prototype->second->WaitAndGet()->CreateVariant(
-        [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
-          opts.ApplyToPipelineDescriptor(desc);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
-        });
+    auto variant_pipeline = CreateVariant(container, opts)->WaitAndGet();
+    RecordRequestedVariant(container, opts);
+    return variant_pipeline;
+  }
+
+  // Creates the variant without waiting for it to compile. The prototype of
+  // the container must exist.
+  template <class TypedPipeline>
+  TypedPipeline* CreateVariant(Variants<TypedPipeline>& container,
+                               const ContentContextOptions& opts) const {
+    auto variant_future =
+        container.find({})->second->WaitAndGet()->CreateVariant(
+            [&opts,
+             variants_count = container.size()](PipelineDescriptor& desc) {
+              opts.ApplyToPipelineDescriptor(desc);
+              desc.SetLabel(
+                  SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
+            });
     auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
+    auto variant_ptr = variant.get();
     container[opts] = std::move(variant);
-    return variant_pipeline;
+    return variant_ptr;
+  }
+
+  template <class TypedPipeline>
+  void PrewarmVariants(Variants<TypedPipeline>& container,
+                       const std::vector<PipelineVariant>& variants) const {
+    auto prototype = container.find({});
+    if (prototype == container.end() ||
+        !prototype->second->GetDescriptor().has_value()) {
+      return;
+    }
+    const std::string label = prototype->second->GetDescriptor()->GetLabel();
+    for (const auto& variant : variants) {
+      if (!variant.pipeline_label.empty() && variant.pipeline_label != label) {
+        continue;
+      }
+      auto opts = variant.options;
+      if (wireframe_) {
+        opts.wireframe = true;
+      }
+      if (container.find(opts) != container.end()) {
+        continue;
+      }
+      prewarmed_variants_.insert(CreateVariant(container, opts));
+    }
   }
 
+  template <class TypedPipeline>
+  void RecordRequestedVariant(Variants<TypedPipeline>& container,
+                              const ContentContextOptions& opts) const {
+    const auto& prototype_desc = container.find({})->second->GetDescriptor();
+    if (prototype_desc.has_value()) {
+      requested_variants_.push_back({prototype_desc->GetLabel(), opts});
+    }
+  }
+
+  struct RuntimeEffectPipelineKey {
+    std::string unique_entrypoint_name;
+    ContentContextOptions options;
+
+    struct Hash {
+      std::size_t operator()(const RuntimeEffectPipelineKey& key) const {
+        return fml::HashCombine(
+            std::hash<std::string>{}(key.unique_entrypoint_name),
+            ContentContextOptions::Hash{}(key.options));
+      }
+    };
+
+    struct Equal {
+      bool operator()(const RuntimeEffectPipelineKey& lhs,
+                      const RuntimeEffectPipelineKey& rhs) const {
+        return lhs.unique_entrypoint_name == rhs.unique_entrypoint_name &&
+               ContentContextOptions::Equal{}(lhs.options, rhs.options);
+      }
+    };
+  };
+
+  mutable std::unordered_map<RuntimeEffectPipelineKey,
+                             std::shared_ptr<Pipeline<PipelineDescriptor>>,
+                             RuntimeEffectPipelineKey::Hash,
+                             RuntimeEffectPipelineKey::Equal>
+      runtime_effect_pipelines_;
+
   bool is_valid_ = false;
-  std::shared_ptr<Tessellator> tessellator_;
-  std::shared_ptr<GlyphAtlasContext> glyph_atlas_context_;
+  std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlasContext>>
+      glyph_atlas_contexts_;
+  std::shared_ptr<ShadowCache> shadow_cache_;
+  std::shared_ptr<GradientCache> gradient_cache_;
+  std::shared_ptr<TessellationCache> tessellation_cache_;
   std::shared_ptr<scene::SceneContext> scene_context_;
+  std::shared_ptr<RenderTargetCache> render_target_cache_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
   bool wireframe_ = false;
+  bool overdraw_heatmap_ = false;
+  std::optional<OverdrawSummary> overdraw_summary_;
+  bool entity_batching_enabled_ = false;
+  // The variants created by `PrewarmPipelineVariants` that no draw has
+  // requested yet.
+  mutable std::unordered_set<const void*> prewarmed_variants_;
+  mutable std::vector<PipelineVariant> requested_variants_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
@@ -7,6 +7,7 @@
 
 #include "fml/logging.h"
 #include "impeller/base/strings.h"
+#include "impeller/base/validation.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/renderer/command_buffer.h"
@@ -75,9 +76,13 @@ Contents::StencilCoverage Contents::GetStencilCoverage(
 std::optional<Snapshot> Contents::RenderToSnapshot(
     const ContentContext& renderer,
     const Entity& entity,
+    std::optional<Rect> coverage_limit,
     const std::optional<SamplerDescriptor>& sampler_descriptor,
     bool msaa_enabled) const {
   auto coverage = GetCoverage(entity);
+  if (coverage.has_value() && coverage_limit.has_value()) {
+    coverage = coverage->Intersection(coverage_limit.value());
+  }
   if (!coverage.has_value()) {
     return std::nullopt;
   }
@@ -129,4 +134,35 @@ bool Contents::ShouldRender(const Entity& entity,
   return stencil_coverage->IntersectsWithRect(coverage.value());
 }
 
+bool Contents::CoversArea(const Entity& entity, const Rect& rect) const {
+  return false;
+}
+
+bool Contents::IsAntialiasedWithoutMultisampling(const Entity& entity) const {
+  return false;
+}
+
+bool Contents::NeedsExtendedRange(const Entity& entity) const {
+  return true;
+}
+
+bool Contents::CanInheritOpacity(const Entity& entity) const {
+  return false;
+}
+
+void Contents::SetInheritedOpacity(Scalar opacity) {
+  VALIDATION_LOG << "Contents::SetInheritedOpacity must only be called when "
+                    "Contents::CanInheritOpacity returns true.";
+}
+
+std::optional<Contents::BatchKey> Contents::GetBatchKey() const {
+  return std::nullopt;
+}
+
+std::shared_ptr<Contents> Contents::MergeWith(const ContentContext& renderer,
+                                              const Entity& entity,
+                                              const Entity& next) const {
+  return nullptr;
+}
+
 }  // namespace impeller
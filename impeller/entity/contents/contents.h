@@ -41,6 +41,18 @@ class Contents {
     std::optional<Rect> coverage = std::nullopt;
   };
 
+  /// @brief  Identifies the pipeline and the texture that are bound to render
+  ///         a contents. `pipeline` is a tag that is unique to the kind of
+  ///         contents.
+  struct BatchKey {
+    const void* pipeline = nullptr;
+    const Texture* texture = nullptr;
+
+    constexpr bool operator==(const BatchKey& other) const {
+      return pipeline == other.pipeline && texture == other.texture;
+    }
+  };
+
   /// @brief  Create an entity that renders a given snapshot.
   static std::optional<Entity> EntityFromSnapshot(
       const std::optional<Snapshot>& snapshot,
@@ -65,16 +77,69 @@ class Contents {
   /// @brief Render this contents to a snapshot, respecting the entity's
   ///        transform, path, stencil depth, and blend mode.
   ///        The result texture size is always the size of
-  ///        `GetCoverage(entity)`.
+  ///        `GetCoverage(entity)`, intersected with `coverage_limit` when
+  ///        one is given. Callers that only sample part of the snapshot
+  ///        pass that part as the limit to avoid rendering the rest.
   virtual std::optional<Snapshot> RenderToSnapshot(
       const ContentContext& renderer,
       const Entity& entity,
+      std::optional<Rect> coverage_limit = std::nullopt,
       const std::optional<SamplerDescriptor>& sampler_descriptor = std::nullopt,
       bool msaa_enabled = true) const;
 
   virtual bool ShouldRender(const Entity& entity,
                             const std::optional<Rect>& stencil_coverage) const;
 
+  /// @brief  Whether rendering this contents with `entity` overwrites every
+  ///         pixel of `rect` with an opaque color, regardless of what was
+  ///         rendered before. Returns false if this cannot be cheaply
+  ///         determined.
+  virtual bool CoversArea(const Entity& entity, const Rect& rect) const;
+
+  /// @brief  Whether rendering this contents with `entity` antialiases its
+  ///         edges without relying on the multisampling of the render target.
+  ///         An `EntityPass` whose entities all do so is rendered without
+  ///         multisampling.
+  virtual bool IsAntialiasedWithoutMultisampling(const Entity& entity) const;
+
+  /// @brief  Whether rendering this contents with `entity` may write colors
+  ///         outside of [0, 1] that a render target with an 8-bit format
+  ///         would clamp. An `EntityPass` whose entities all don't is
+  ///         rendered to an 8-bit texture even if the surface has an
+  ///         extended range format. Returns true if this cannot be cheaply
+  ///         determined.
+  virtual bool NeedsExtendedRange(const Entity& entity) const;
+
+  /// @brief  Whether the opacity of a layer that only contains this contents
+  ///         can be applied with `SetInheritedOpacity` rather than by
+  ///         rendering the layer offscreen. This requires that no pixel is
+  ///         rendered to more than once.
+  virtual bool CanInheritOpacity(const Entity& entity) const;
+
+  /// @brief  Multiply the opacity that this contents is rendered with by
+  ///         `opacity`. Must only be called if `CanInheritOpacity` returns
+  ///         true.
+  virtual void SetInheritedOpacity(Scalar opacity);
+
+  /// @brief  Return the batch key of this contents, if it can be reordered
+  ///         with other entities that don't overlap it.
+  ///
+  ///         Entities whose contents have equal batch keys, and that have the
+  ///         same blend mode and stencil depth, may be grouped together by an
+  ///         `EntityPass` so that they are rendered with fewer pipeline and
+  ///         binding changes. Contents that only render within their
+  ///         coverage and don't write to the stencil buffer may return a key.
+  virtual std::optional<BatchKey> GetBatchKey() const;
+
+  /// @brief  Return contents that render `entity`, whose contents is this
+  ///         one, followed by `next` in a single draw call, or `nullptr` if
+  ///         they cannot be merged. `next` has contents with the same batch
+  ///         key, blend mode and stencil depth. The returned contents are
+  ///         rendered with an identity transformation.
+  virtual std::shared_ptr<Contents> MergeWith(const ContentContext& renderer,
+                                              const Entity& entity,
+                                              const Entity& next) const;
+
   /// @brief  Return the color source's intrinsic size, if available.
   ///
   /// For example, a gradient has a size based on its end and beginning points,
@@ -53,7 +53,9 @@ static std::optional<Entity> AdvancedBlend(
     return std::nullopt;
   }
 
-  auto dst_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  // Blends only sample their inputs where they are drawn, so the inputs are
+  // not needed outside of the coverage.
+  auto dst_snapshot = inputs[0]->GetSnapshot(renderer, entity, coverage);
   if (!dst_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -66,7 +68,7 @@ static std::optional<Entity> AdvancedBlend(
   std::optional<Snapshot> src_snapshot;
   std::array<Point, 4> src_uvs;
   if (!foreground_color.has_value()) {
-    src_snapshot = inputs[1]->GetSnapshot(renderer, entity);
+    src_snapshot = inputs[1]->GetSnapshot(renderer, entity, coverage);
     if (!src_snapshot.has_value()) {
       if (!dst_snapshot.has_value()) {
         return std::nullopt;
@@ -180,7 +182,7 @@ static std::optional<Entity> PipelineBlend(
   using VS = BlendPipeline::VertexShader;
   using FS = BlendPipeline::FragmentShader;
 
-  auto dst_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto dst_snapshot = inputs[0]->GetSnapshot(renderer, entity, coverage);
 
   ContentContext::SubpassCallback callback = [&](const ContentContext& renderer,
                                                  RenderPass& pass) {
@@ -246,7 +248,8 @@ static std::optional<Entity> PipelineBlend(
 
       for (auto texture_i = inputs.begin() + 1; texture_i < inputs.end();
            texture_i++) {
-        auto src_input = texture_i->get()->GetSnapshot(renderer, entity);
+        auto src_input =
+            texture_i->get()->GetSnapshot(renderer, entity, coverage);
         if (!add_blend_command(src_input)) {
           return true;
         }
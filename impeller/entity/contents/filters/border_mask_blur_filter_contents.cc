@@ -64,7 +64,9 @@ std::optional<Entity> BorderMaskBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -156,4 +158,22 @@ std::optional<Rect> BorderMaskBlurFilterContents::GetFilterCoverage(
               Size(extent.x, extent.y));
 }
 
+std::optional<Rect> BorderMaskBlurFilterContents::GetFilterSourceCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+
+  auto transform = inputs[0]->GetTransform(entity) * effect_transform;
+  auto transformed_blur_vector =
+      transform.TransformDirection(Vector2(Radius{sigma_x_}.radius, 0)).Abs() +
+      transform.TransformDirection(Vector2(0, Radius{sigma_y_}.radius)).Abs();
+  auto extent = output_limit.size + transformed_blur_vector * 2;
+  return Rect(output_limit.origin - transformed_blur_vector,
+              Size(extent.x, extent.y));
+}
+
 }  // namespace impeller
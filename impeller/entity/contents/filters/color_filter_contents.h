@@ -40,6 +40,13 @@ class ColorFilterContents : public FilterContents {
   std::optional<Scalar> GetAlpha() const;
 
  private:
+  // |FilterContents|
+  std::optional<Rect> GetFilterSourceCoverage(
+      const FilterInput::Vector& inputs,
+      const Entity& entity,
+      const Matrix& effect_transform,
+      const Rect& output_limit) const override;
+
   bool absorb_opacity_ = false;
   std::optional<Scalar> alpha_;
 
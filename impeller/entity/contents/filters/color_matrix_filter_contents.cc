@@ -40,7 +40,9 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -77,16 +79,8 @@ std::optional<Entity> ColorMatrixFilterContents::RenderFilter(
         input_snapshot->texture->GetYCoordScale();
 
     FS::FragInfo frag_info;
-    const float* matrix = matrix_.array;
-    frag_info.color_v = Vector4(matrix[4], matrix[9], matrix[14], matrix[19]);
-    // clang-format off
-    frag_info.color_m = Matrix(
-        matrix[0], matrix[5], matrix[10], matrix[15],
-        matrix[1], matrix[6], matrix[11], matrix[16],
-        matrix[2], matrix[7], matrix[12], matrix[17],
-        matrix[3], matrix[8], matrix[13], matrix[18]
-    );
-    // clang-format on
+    frag_info.color_v = matrix_.GetColorOffset();
+    frag_info.color_m = matrix_.GetColorTransform();
     frag_info.input_alpha = GetAbsorbOpacity() ? input_snapshot->opacity : 1.0f;
     auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
     FS::BindInputTexture(cmd, input_snapshot->texture, sampler);
@@ -0,0 +1,319 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/compute_separable_filter_contents.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_command.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+// The number of invocations in a workgroup of the compute shader, which is
+// the number of output pixels of a tile.
+static constexpr int64_t kTileSize = 128;
+
+ComputeSeparableFilterContents::ComputeSeparableFilterContents() = default;
+
+ComputeSeparableFilterContents::~ComputeSeparableFilterContents() = default;
+
+void ComputeSeparableFilterContents::SetOperation(Operation operation) {
+  operation_ = operation;
+}
+
+void ComputeSeparableFilterContents::SetSigma(Sigma sigma_x, Sigma sigma_y) {
+  sigma_x_ = sigma_x;
+  sigma_y_ = sigma_y;
+}
+
+void ComputeSeparableFilterContents::SetRadius(Radius radius_x,
+                                               Radius radius_y) {
+  radius_x_ = radius_x;
+  radius_y_ = radius_y;
+}
+
+void ComputeSeparableFilterContents::SetTileMode(Entity::TileMode tile_mode) {
+  tile_mode_ = tile_mode;
+}
+
+void ComputeSeparableFilterContents::SetColorMatrix(
+    std::optional<ColorMatrix> color_matrix) {
+  color_matrix_ = color_matrix;
+}
+
+void ComputeSeparableFilterContents::SetFallback(
+    std::shared_ptr<FilterContents> fallback) {
+  fallback_ = std::move(fallback);
+}
+
+std::optional<Rect> ComputeSeparableFilterContents::GetFilterCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform) const {
+  if (fallback_) {
+    return fallback_->GetCoverage(entity);
+  }
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+  return inputs[0]->GetCoverage(entity);
+}
+
+std::optional<Entity> ComputeSeparableFilterContents::RenderFilter(
+    const FilterInput::Vector& inputs,
+    const ContentContext& renderer,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& coverage) const {
+  using TextureCS = SeparableFilterTextureComputeShader;
+  using BufferCS = SeparableFilterBufferComputeShader;
+  using VS = PixelBufferPipeline::VertexShader;
+  using FS = PixelBufferPipeline::FragmentShader;
+
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
+  if (!input_snapshot.has_value()) {
+    return std::nullopt;
+  }
+
+  auto render_fallback = [&]() -> std::optional<Entity> {
+    if (!fallback_) {
+      return Contents::EntityFromSnapshot(input_snapshot.value(),
+                                          entity.GetBlendMode(),
+                                          entity.GetStencilDepth());
+    }
+    return fallback_->GetEntity(renderer, entity, coverage);
+  };
+
+  auto context = renderer.GetContext();
+  auto texture_pipeline = renderer.GetSeparableFilterTexturePipeline();
+  auto buffer_pipeline = renderer.GetSeparableFilterBufferPipeline();
+  if (!context->GetDeviceCapabilities().SupportsCompute() ||
+      !texture_pipeline || !buffer_pipeline) {
+    return render_fallback();
+  }
+
+  // The passes are axis aligned in the space of the input texture.
+  auto transform = entity.GetTransformation() * effect_transform.Basis();
+  const auto& snapshot_transform = input_snapshot->transform;
+  if (!transform.IsTranslationScaleOnly() ||
+      !snapshot_transform.IsTranslationScaleOnly() ||
+      ScalarNearlyZero(snapshot_transform.m[0]) ||
+      ScalarNearlyZero(snapshot_transform.m[5])) {
+    return render_fallback();
+  }
+  Vector2 scale(std::abs(transform.m[0] / snapshot_transform.m[0]),
+                std::abs(transform.m[5] / snapshot_transform.m[5]));
+
+  // The sigma and the radius of the kernel along each axis, in pixels of the
+  // input.
+  Vector2 sigma;
+  ISize radius;
+  Scalar operation;
+  Entity::TileMode tile_mode;
+  switch (operation_) {
+    case Operation::kGaussianBlur:
+      sigma = Vector2(scale.x * sigma_x_.sigma, scale.y * sigma_y_.sigma);
+      radius = ISize(std::ceil(Radius{Sigma{sigma.x}}.radius),
+                     std::ceil(Radius{Sigma{sigma.y}}.radius));
+      operation = 0;
+      tile_mode = tile_mode_;
+      break;
+    case Operation::kDilate:
+    case Operation::kErode:
+      radius = ISize(std::round(scale.x * radius_x_.radius),
+                     std::round(scale.y * radius_y_.radius));
+      operation = operation_ == Operation::kDilate ? 1 : 2;
+      // Like the fragment morphology filter, pixels outside of the input are
+      // transparent.
+      tile_mode = Entity::TileMode::kDecal;
+      break;
+  }
+  if (radius.width > kMaxRadius || radius.height > kMaxRadius) {
+    return render_fallback();
+  }
+
+  // The output grows by the radius on each side, so that blurs and
+  // dilations can spread past the edges of the input.
+  const ISize input_size = input_snapshot->texture->GetSize();
+  const ISize padding = radius;
+  const ISize horizontal_size(input_size.width + padding.width * 2,
+                              input_size.height);
+  const ISize output_size(horizontal_size.width,
+                          input_size.height + padding.height * 2);
+  if (output_size.IsEmpty()) {
+    return std::nullopt;
+  }
+
+  auto allocate_pixels = [&](ISize size) {
+    DeviceBufferDescriptor desc;
+    desc.storage_mode = StorageMode::kDevicePrivate;
+    desc.size = size.Area() * sizeof(uint32_t);
+    return context->GetResourceAllocator()->CreateBuffer(desc);
+  };
+  auto horizontal_pixels = allocate_pixels(horizontal_size);
+  auto output_pixels = allocate_pixels(output_size);
+  if (!horizontal_pixels || !output_pixels) {
+    return render_fallback();
+  }
+
+  // Both shaders declare the same FilterInfo block.
+  auto fill_filter_info = [&](auto& info, ISize in_size, ISize out_size,
+                              IPoint32 offset, IPoint32 direction,
+                              Scalar sigma, int64_t radius) {
+    info.input_size = IPoint32(in_size.width, in_size.height);
+    info.output_size = IPoint32(out_size.width, out_size.height);
+    info.input_offset = offset;
+    info.direction = direction;
+    info.operation = operation;
+    info.sigma = std::max(sigma, kEhCloseEnough);
+    info.radius = radius;
+    info.tile_mode = static_cast<Scalar>(tile_mode);
+  };
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return std::nullopt;
+  }
+  cmd_buffer->SetLabel("Separable Filter Command Buffer");
+
+  // Rows of the padded output are filtered from the input texture.
+  {
+    auto pass = cmd_buffer->CreateComputePass();
+    if (!pass || !pass->IsValid()) {
+      return std::nullopt;
+    }
+    pass->SetLabel("Separable Filter (Horizontal)");
+    pass->SetGridSize(ISize(horizontal_size.width, horizontal_size.height));
+    pass->SetThreadGroupSize(ISize(kTileSize, 1));
+
+    ComputeCommand cmd;
+    cmd.label = "Separable Filter (Horizontal)";
+    cmd.pipeline = texture_pipeline;
+    TextureCS::FilterInfo info;
+    fill_filter_info(info, input_size, horizontal_size,
+                     IPoint32(-padding.width, 0), IPoint32(1, 0), sigma.x,
+                     radius.width);
+    TextureCS::BindFilterInfo(cmd,
+                              pass->GetTransientsBuffer().EmplaceUniform(info));
+    SamplerDescriptor nearest;
+    nearest.label = "Nearest Sampler";
+    TextureCS::BindTextureSampler(
+        cmd, input_snapshot->texture,
+        context->GetSamplerLibrary()->GetSampler(nearest));
+    TextureCS::BindOutputPixels(cmd, horizontal_pixels->AsBufferView());
+    if (!pass->AddCommand(std::move(cmd)) || !pass->EncodeCommands()) {
+      return std::nullopt;
+    }
+  }
+
+  // Columns of the padded output are filtered from the rows.
+  {
+    auto pass = cmd_buffer->CreateComputePass();
+    if (!pass || !pass->IsValid()) {
+      return std::nullopt;
+    }
+    pass->SetLabel("Separable Filter (Vertical)");
+    pass->SetGridSize(ISize(output_size.height, output_size.width));
+    pass->SetThreadGroupSize(ISize(kTileSize, 1));
+
+    ComputeCommand cmd;
+    cmd.label = "Separable Filter (Vertical)";
+    cmd.pipeline = buffer_pipeline;
+    BufferCS::FilterInfo info;
+    fill_filter_info(info, horizontal_size, output_size,
+                     IPoint32(0, -padding.height), IPoint32(0, 1), sigma.y,
+                     radius.height);
+    BufferCS::BindFilterInfo(cmd,
+                             pass->GetTransientsBuffer().EmplaceUniform(info));
+    BufferCS::BindInputPixels(cmd, horizontal_pixels->AsBufferView());
+    BufferCS::BindOutputPixels(cmd, output_pixels->AsBufferView());
+    if (!pass->AddCommand(std::move(cmd)) || !pass->EncodeCommands()) {
+      return std::nullopt;
+    }
+  }
+
+  if (!cmd_buffer->SubmitCommands()) {
+    return std::nullopt;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Copy the pixels into a texture.
+  ///
+
+  ContentContext::SubpassCallback callback = [&](const ContentContext& renderer,
+                                                 RenderPass& pass) {
+    auto& host_buffer = pass.GetTransientsBuffer();
+
+    VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+    vtx_builder.AddVertices({
+        {Point(0, 0), Point(0, 0)},
+        {Point(1, 0), Point(1, 0)},
+        {Point(1, 1), Point(1, 1)},
+        {Point(0, 0), Point(0, 0)},
+        {Point(1, 1), Point(1, 1)},
+        {Point(0, 1), Point(0, 1)},
+    });
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+    frame_info.texture_sampler_y_coord_scale = 1.0;
+
+    FS::FragInfo frag_info;
+    frag_info.width = output_size.width;
+    frag_info.apply_color_matrix = color_matrix_.has_value();
+    if (color_matrix_.has_value()) {
+      frag_info.color_m = color_matrix_->GetColorTransform();
+      frag_info.color_v = color_matrix_->GetColorOffset();
+    }
+
+    Command cmd;
+    cmd.label = "Separable Filter Resolve";
+    auto options = OptionsFromPass(pass);
+    options.blend_mode = BlendMode::kSource;
+    cmd.pipeline = renderer.GetPixelBufferPipeline(options);
+    cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    FS::BindPixelData(cmd, output_pixels->AsBufferView());
+    return pass.AddCommand(std::move(cmd));
+  };
+  // The pass covers its whole target with one quad, so multisampling would
+  // only cost bandwidth.
+  auto result = renderer.MakeSubpass("Separable Filter", output_size, callback,
+                                     /*msaa_enabled=*/false);
+  if (!result) {
+    return std::nullopt;
+  }
+
+  SamplerDescriptor linear_clamp;
+  linear_clamp.min_filter = MinMagFilter::kLinear;
+  linear_clamp.mag_filter = MinMagFilter::kLinear;
+  return Contents::EntityFromSnapshot(
+      Snapshot{.texture = result,
+               .transform = snapshot_transform *
+                            Matrix::MakeTranslation(-Vector2(padding)),
+               .sampler_descriptor = linear_clamp,
+               .opacity = input_snapshot->opacity},
+      entity.GetBlendMode(), entity.GetStencilDepth());
+}
+
+}  // namespace impeller
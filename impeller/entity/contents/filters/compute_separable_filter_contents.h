@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/inputs/filter_input.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Renders a separable gaussian blur or morphology filter with
+///             two compute passes, one per axis.
+///
+///             Each workgroup of a pass loads the pixels that a tile of the
+///             output reads into shared memory once, so the cost per pixel
+///             no longer grows with the number of texture reads of the
+///             kernel. The passes write to buffers because the compute
+///             backend has no storage textures, and the result of the
+///             second pass is copied into a texture with a render pass.
+///
+///             Devices without compute support, rotated and skewed
+///             transforms, and kernels too wide for the shared tile are
+///             rendered with the fallback filter instead.
+///
+class ComputeSeparableFilterContents final : public FilterContents {
+ public:
+  enum class Operation { kGaussianBlur, kDilate, kErode };
+
+  /// @brief  The widest kernel radius, in pixels of the input, that fits in
+  ///         the shared tile of the compute shader.
+  static constexpr int kMaxRadius = 64;
+
+  ComputeSeparableFilterContents();
+
+  ~ComputeSeparableFilterContents() override;
+
+  void SetOperation(Operation operation);
+
+  /// @brief  The sigma of the blur. Only used by |Operation::kGaussianBlur|.
+  void SetSigma(Sigma sigma_x, Sigma sigma_y);
+
+  /// @brief  The radius of the morphology filter. Only used by
+  ///         |Operation::kDilate| and |Operation::kErode|.
+  void SetRadius(Radius radius_x, Radius radius_y);
+
+  void SetTileMode(Entity::TileMode tile_mode);
+
+  /// @brief  A color matrix applied to the result by the pass that copies it
+  ///         into a texture.
+  void SetColorMatrix(std::optional<ColorMatrix> color_matrix);
+
+  /// @brief  The filter that renders what the compute passes cannot. It
+  ///         must use the same inputs as this filter, and its coverage is
+  ///         used as the coverage of this filter.
+  void SetFallback(std::shared_ptr<FilterContents> fallback);
+
+ private:
+  // |FilterContents|
+  std::optional<Rect> GetFilterCoverage(
+      const FilterInput::Vector& inputs,
+      const Entity& entity,
+      const Matrix& effect_transform) const override;
+
+  // |FilterContents|
+  std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
+                                     const ContentContext& renderer,
+                                     const Entity& entity,
+                                     const Matrix& effect_transform,
+                                     const Rect& coverage) const override;
+
+  Operation operation_ = Operation::kGaussianBlur;
+  Sigma sigma_x_;
+  Sigma sigma_y_;
+  Radius radius_x_;
+  Radius radius_y_;
+  Entity::TileMode tile_mode_ = Entity::TileMode::kDecal;
+  std::optional<ColorMatrix> color_matrix_;
+  std::shared_ptr<FilterContents> fallback_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ComputeSeparableFilterContents);
+};
+
+}  // namespace impeller
@@ -0,0 +1,307 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/dual_filter_blur_filter_contents.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "impeller/base/strings.h"
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+// How far the sigma of the chain may be from the requested sigma along an
+// axis before the exact blur is used instead.
+static constexpr Scalar kSigmaTolerance = 0.25;
+
+Scalar DualFilterBlurFilterContents::ComputeSigma(size_t iterations,
+                                                  Scalar offset) {
+  // The chain is modeled by the variance that each pass adds along one axis,
+  // in pixels of the input. A bilinear sample halfway between two texels
+  // adds a quarter of the squared texel size, and offsets past a whole texel
+  // spread the weight to the next texel over.
+  Scalar variance = 0;
+  for (size_t i = 0; i < iterations; i++) {
+    // Halving from a texture with texels of size t.
+    Scalar t = static_cast<Scalar>(1u << i);
+    Scalar t2 = t * t;
+    Scalar corner = offset <= 1 ? t2 / 4 : offset * t2 - 0.75 * t2;
+    variance += t2 / 8 + corner / 2;
+
+    // Doubling from a texture with texels of size 2t.
+    Scalar s2 = 4 * t2;
+    variance += offset * offset * s2 / 3 + 3 * s2 / 16;
+  }
+  return std::sqrt(variance);
+}
+
+std::optional<DualFilterBlurFilterContents::Parameters>
+DualFilterBlurFilterContents::ComputeParameters(Vector2 sigma) {
+  Scalar max_sigma = std::max(sigma.x, sigma.y);
+  if (max_sigma < kMinSigma) {
+    return std::nullopt;
+  }
+
+  size_t iterations = 1;
+  while (iterations < kMaxIterations &&
+         ComputeSigma(iterations, kMaxOffset) < max_sigma) {
+    iterations++;
+  }
+
+  // The sigma of the chain grows with the offset, so the offset is found by
+  // bisection.
+  auto solve_offset = [iterations](Scalar target) -> std::optional<Scalar> {
+    Scalar low = kMinOffset;
+    Scalar high = kMaxOffset;
+    if (target < ComputeSigma(iterations, low) * (1 - kSigmaTolerance) ||
+        target > ComputeSigma(iterations, high) * (1 + kSigmaTolerance)) {
+      return std::nullopt;
+    }
+    for (int i = 0; i < 16; i++) {
+      Scalar mid = (low + high) / 2;
+      if (ComputeSigma(iterations, mid) < target) {
+        low = mid;
+      } else {
+        high = mid;
+      }
+    }
+    return (low + high) / 2;
+  };
+
+  auto offset_x = solve_offset(sigma.x);
+  auto offset_y = solve_offset(sigma.y);
+  if (!offset_x.has_value() || !offset_y.has_value()) {
+    return std::nullopt;
+  }
+  return Parameters{
+      .iterations = iterations,
+      .offset = Vector2(offset_x.value(), offset_y.value()),
+  };
+}
+
+DualFilterBlurFilterContents::DualFilterBlurFilterContents() = default;
+
+DualFilterBlurFilterContents::~DualFilterBlurFilterContents() = default;
+
+void DualFilterBlurFilterContents::SetSigma(Sigma sigma_x, Sigma sigma_y) {
+  sigma_x_ = sigma_x;
+  sigma_y_ = sigma_y;
+}
+
+void DualFilterBlurFilterContents::SetTileMode(Entity::TileMode tile_mode) {
+  tile_mode_ = tile_mode;
+}
+
+void DualFilterBlurFilterContents::SetFallback(
+    std::shared_ptr<FilterContents> fallback) {
+  fallback_ = std::move(fallback);
+}
+
+std::optional<Rect> DualFilterBlurFilterContents::GetFilterCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform) const {
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+
+  auto coverage = inputs[0]->GetCoverage(entity);
+  if (!coverage.has_value()) {
+    return std::nullopt;
+  }
+
+  auto transform = inputs[0]->GetTransform(entity) * effect_transform.Basis();
+  auto blur_vector =
+      transform.TransformDirection(Vector2(Radius{sigma_x_}.radius, 0)).Abs() +
+      transform.TransformDirection(Vector2(0, Radius{sigma_y_}.radius)).Abs();
+  auto extent = coverage->size + blur_vector * 2;
+  return Rect(coverage->origin - blur_vector, Size(extent.x, extent.y));
+}
+
+std::optional<Entity> DualFilterBlurFilterContents::RenderFilter(
+    const FilterInput::Vector& inputs,
+    const ContentContext& renderer,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& coverage) const {
+  using VS = DualFilterBlurPipeline::VertexShader;
+  using FS = DualFilterBlurPipeline::FragmentShader;
+
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
+  if (!input_snapshot.has_value()) {
+    return std::nullopt;
+  }
+
+  auto render_fallback = [&]() -> std::optional<Entity> {
+    if (!fallback_) {
+      return Contents::EntityFromSnapshot(input_snapshot.value(),
+                                          entity.GetBlendMode(),
+                                          entity.GetStencilDepth());
+    }
+    return fallback_->GetEntity(renderer, entity, coverage);
+  };
+
+  // The passes are axis aligned in the space of the input texture.
+  auto transform = entity.GetTransformation() * effect_transform.Basis();
+  const auto& snapshot_transform = input_snapshot->transform;
+  if (!transform.IsTranslationScaleOnly() ||
+      !snapshot_transform.IsTranslationScaleOnly() ||
+      ScalarNearlyZero(snapshot_transform.m[0]) ||
+      ScalarNearlyZero(snapshot_transform.m[5])) {
+    return render_fallback();
+  }
+
+  Vector2 sigma(
+      std::abs(transform.m[0] / snapshot_transform.m[0]) * sigma_x_.sigma,
+      std::abs(transform.m[5] / snapshot_transform.m[5]) * sigma_y_.sigma);
+  auto parameters = ComputeParameters(sigma);
+  if (!parameters.has_value()) {
+    return render_fallback();
+  }
+
+  // The input is padded by the blur radius so that the blur can spread past
+  // its edges, and the padded size is rounded up so that every level of the
+  // chain is exactly half the size of the one above it.
+  const int64_t scale = int64_t{1} << parameters->iterations;
+  auto align = [scale](int64_t size) {
+    return (size + scale - 1) / scale * scale;
+  };
+  const ISize input_size = input_snapshot->texture->GetSize();
+  const ISize padding(std::ceil(Radius{Sigma{sigma.x}}.radius),
+                      std::ceil(Radius{Sigma{sigma.y}}.radius));
+  const ISize padded_size(align(input_size.width + padding.width * 2),
+                          align(input_size.height + padding.height * 2));
+
+  auto half_size = [](ISize size) {
+    return ISize(size.width / 2, size.height / 2);
+  };
+
+  SamplerDescriptor linear_clamp;
+  linear_clamp.min_filter = MinMagFilter::kLinear;
+  linear_clamp.mag_filter = MinMagFilter::kLinear;
+
+  SamplerDescriptor input_descriptor = linear_clamp;
+  switch (tile_mode_) {
+    case Entity::TileMode::kDecal:
+    case Entity::TileMode::kClamp:
+      break;
+    case Entity::TileMode::kMirror:
+      input_descriptor.width_address_mode = SamplerAddressMode::kMirror;
+      input_descriptor.height_address_mode = SamplerAddressMode::kMirror;
+      break;
+    case Entity::TileMode::kRepeat:
+      input_descriptor.width_address_mode = SamplerAddressMode::kRepeat;
+      input_descriptor.height_address_mode = SamplerAddressMode::kRepeat;
+      break;
+  }
+
+  auto render_step = [&](const std::shared_ptr<Texture>& source,
+                         ISize size, Point uv_min, Point uv_max, bool upsample,
+                         bool decal, const SamplerDescriptor& descriptor) {
+    ContentContext::SubpassCallback callback =
+        [&](const ContentContext& renderer, RenderPass& pass) {
+          auto& host_buffer = pass.GetTransientsBuffer();
+
+          VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+          vtx_builder.AddVertices({
+              {Point(0, 0), uv_min},
+              {Point(1, 0), Point(uv_max.x, uv_min.y)},
+              {Point(1, 1), uv_max},
+              {Point(0, 0), uv_min},
+              {Point(1, 1), uv_max},
+              {Point(0, 1), Point(uv_min.x, uv_max.y)},
+          });
+
+          VS::FrameInfo frame_info;
+          frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+          frame_info.texture_sampler_y_coord_scale = source->GetYCoordScale();
+
+          FS::FragInfo frag_info;
+          frag_info.texel_offset =
+              parameters->offset / Vector2(source->GetSize());
+          frag_info.upsample = upsample ? 1.0 : 0.0;
+          frag_info.decal = decal ? 1.0 : 0.0;
+
+          Command cmd;
+          cmd.label = SPrintF("Dual Filter Blur (%s %lldx%lld)",
+                              upsample ? "Upsample" : "Downsample",
+                              static_cast<long long>(size.width),
+                              static_cast<long long>(size.height));
+          auto options = OptionsFromPass(pass);
+          options.blend_mode = BlendMode::kSource;
+          cmd.pipeline = renderer.GetDualFilterBlurPipeline(options);
+          cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+          FS::BindTextureSampler(
+              cmd, source,
+              renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                  descriptor));
+          VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+          FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+          return pass.AddCommand(std::move(cmd));
+        };
+    // Every pass covers its whole target with one quad, so multisampling
+    // would only cost bandwidth.
+    return renderer.MakeSubpass("Dual Filter Blur", size, callback,
+                                /*msaa_enabled=*/false);
+  };
+
+  // The first pass reads the padded area around the input, the rest read
+  // whole textures.
+  std::vector<std::shared_ptr<Texture>> levels;
+  levels.reserve(parameters->iterations + 1);
+  {
+    Point uv_min = -Point(padding) / Point(input_size);
+    Point uv_max = Point(padded_size - padding) / Point(input_size);
+    auto texture = render_step(
+        input_snapshot->texture, half_size(padded_size), uv_min, uv_max, false,
+        tile_mode_ == Entity::TileMode::kDecal, input_descriptor);
+    if (!texture) {
+      return std::nullopt;
+    }
+    levels.push_back(std::move(texture));
+  }
+  for (size_t i = 1; i < parameters->iterations; i++) {
+    auto texture = render_step(levels.back(),
+                               half_size(levels.back()->GetSize()), Point(0, 0),
+                               Point(1, 1), false, false, linear_clamp);
+    if (!texture) {
+      return std::nullopt;
+    }
+    levels.push_back(std::move(texture));
+  }
+  auto result = levels.back();
+  for (size_t i = parameters->iterations; i > 0; i--) {
+    auto size = i > 1 ? levels[i - 2]->GetSize() : padded_size;
+    result = render_step(result, size, Point(0, 0), Point(1, 1), true, false,
+                         linear_clamp);
+    if (!result) {
+      return std::nullopt;
+    }
+  }
+
+  return Contents::EntityFromSnapshot(
+      Snapshot{.texture = result,
+               .transform = snapshot_transform *
+                            Matrix::MakeTranslation(-Vector2(padding)),
+               .sampler_descriptor = linear_clamp,
+               .opacity = input_snapshot->opacity},
+      entity.GetBlendMode(), entity.GetStencilDepth());
+}
+
+}  // namespace impeller
@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/inputs/filter_input.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A gaussian blur that is approximated by a dual filter (Kawase
+///             style) chain of passes that progressively halve and then
+///             double the resolution of the input.
+///
+///             The number of passes grows with the log of the sigma and the
+///             passes mostly run at low resolution, so large blurs are far
+///             cheaper than with the exact separable blur. The offset of the
+///             kernel is chosen so that the variance of the chain matches
+///             the variance of the exact blur.
+///
+///             Blurs that the chain cannot approximate well (small sigmas,
+///             very different sigmas per axis, or rotated and skewed
+///             transforms) are rendered with the fallback filter instead.
+///
+class DualFilterBlurFilterContents final : public FilterContents {
+ public:
+  struct Parameters {
+    /// @brief  The number of passes that halve the resolution, which is the
+    ///         same as the number of passes that double it again.
+    size_t iterations = 0u;
+    /// @brief  The offset of the kernel along each axis, in texels of the
+    ///         texture being sampled.
+    Vector2 offset;
+  };
+
+  /// @brief  Below this sigma the exact blur is cheap enough to be used.
+  static constexpr Scalar kMinSigma = 4.0;
+  static constexpr size_t kMaxIterations = 8u;
+  static constexpr Scalar kMinOffset = 0.5;
+  static constexpr Scalar kMaxOffset = 2.0;
+
+  /// @brief  The sigma of the gaussian blur that the chain approximates,
+  ///         along one axis, in pixels of the input.
+  static Scalar ComputeSigma(size_t iterations, Scalar offset);
+
+  /// @brief  The parameters of the chain that approximates a gaussian blur
+  ///         with the given sigma, in pixels of the input, or
+  ///         `std::nullopt` if the chain cannot approximate it.
+  static std::optional<Parameters> ComputeParameters(Vector2 sigma);
+
+  DualFilterBlurFilterContents();
+
+  ~DualFilterBlurFilterContents() override;
+
+  void SetSigma(Sigma sigma_x, Sigma sigma_y);
+
+  void SetTileMode(Entity::TileMode tile_mode);
+
+  /// @brief  The filter that renders the blurs which the chain cannot
+  ///         approximate. It must use the same inputs as this filter.
+  void SetFallback(std::shared_ptr<FilterContents> fallback);
+
+ private:
+  // |FilterContents|
+  std::optional<Rect> GetFilterCoverage(
+      const FilterInput::Vector& inputs,
+      const Entity& entity,
+      const Matrix& effect_transform) const override;
+
+  // |FilterContents|
+  std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
+                                     const ContentContext& renderer,
+                                     const Entity& entity,
+                                     const Matrix& effect_transform,
+                                     const Rect& coverage) const override;
+
+  Sigma sigma_x_;
+  Sigma sigma_y_;
+  Entity::TileMode tile_mode_ = Entity::TileMode::kDecal;
+  std::shared_ptr<FilterContents> fallback_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DualFilterBlurFilterContents);
+};
+
+}  // namespace impeller
@@ -15,6 +15,8 @@
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/border_mask_blur_filter_contents.h"
+#include "impeller/entity/contents/filters/compute_separable_filter_contents.h"
+#include "impeller/entity/contents/filters/dual_filter_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/filters/local_matrix_filter_contents.h"
@@ -51,20 +53,113 @@ std::shared_ptr<FilterContents> FilterContents::MakeDirectionalGaussianBlur(
   return blur;
 }
 
+Matrix FilterContents::ColorMatrix::GetColorTransform() const {
+  // clang-format off
+  return Matrix(
+      array[0], array[5], array[10], array[15],
+      array[1], array[6], array[11], array[16],
+      array[2], array[7], array[12], array[17],
+      array[3], array[8], array[13], array[18]
+  );
+  // clang-format on
+}
+
+Vector4 FilterContents::ColorMatrix::GetColorOffset() const {
+  return Vector4(array[4], array[9], array[14], array[19]);
+}
+
+/// Whether the alpha row of the matrix only scales the alpha, which keeps
+/// transparent pixels transparent.
+static bool ScalesAlphaOnly(const FilterContents::ColorMatrix& matrix) {
+  const float* alpha_row = matrix.array + 15;
+  return alpha_row[0] == 0 && alpha_row[1] == 0 && alpha_row[2] == 0 &&
+         alpha_row[3] >= 0 && alpha_row[4] == 0;
+}
+
+std::optional<FilterContents::ColorMatrix>
+FilterContents::ColorMatrix::Compose(const ColorMatrix& outer,
+                                     const ColorMatrix& inner) {
+  if (!ScalesAlphaOnly(outer) || !ScalesAlphaOnly(inner) ||
+      inner.array[18] > 1) {
+    return std::nullopt;
+  }
+  // The inner pass must not clamp any color of its unpremultiplied inputs,
+  // whose components are all in [0, 1].
+  for (int row = 0; row < 3; row++) {
+    const float* coefficients = inner.array + row * 5;
+    Scalar min = coefficients[4];
+    Scalar max = coefficients[4];
+    for (int column = 0; column < 4; column++) {
+      min += std::min(coefficients[column], 0.0f);
+      max += std::max(coefficients[column], 0.0f);
+    }
+    if (min < 0 || max > 1) {
+      return std::nullopt;
+    }
+  }
+
+  ColorMatrix result;
+  for (int row = 0; row < 4; row++) {
+    for (int column = 0; column < 5; column++) {
+      Scalar value = column == 4 ? outer.array[row * 5 + 4] : 0;
+      for (int k = 0; k < 4; k++) {
+        value += outer.array[row * 5 + k] * inner.array[k * 5 + column];
+      }
+      result.array[row * 5 + column] = value;
+    }
+  }
+  return result;
+}
+
 std::shared_ptr<FilterContents> FilterContents::MakeGaussianBlur(
     const FilterInput::Ref& input,
     Sigma sigma_x,
     Sigma sigma_y,
     BlurStyle blur_style,
     Entity::TileMode tile_mode,
-    const Matrix& effect_transform) {
+    const Matrix& effect_transform,
+    BlurQuality quality,
+    std::optional<ColorMatrix> color_matrix) {
   auto x_blur = MakeDirectionalGaussianBlur(input, sigma_x, Point(1, 0),
                                             BlurStyle::kNormal, tile_mode,
                                             nullptr, {}, effect_transform);
-  auto y_blur = MakeDirectionalGaussianBlur(FilterInput::Make(x_blur), sigma_y,
-                                            Point(0, 1), blur_style, tile_mode,
-                                            input, sigma_x, effect_transform);
-  return y_blur;
+  auto y_blur = std::make_shared<DirectionalGaussianBlurFilterContents>();
+  y_blur->SetInputs({FilterInput::Make(x_blur)});
+  y_blur->SetSigma(sigma_y);
+  y_blur->SetDirection(Point(0, 1));
+  y_blur->SetBlurStyle(blur_style);
+  y_blur->SetTileMode(tile_mode);
+  y_blur->SetSourceOverride(input);
+  y_blur->SetSecondarySigma(sigma_x);
+  y_blur->SetEffectTransform(effect_transform);
+  y_blur->SetColorMatrix(color_matrix);
+  // Only normal blurs are rendered with compute passes or the dual filter.
+  // The other styles need the unblurred input that the fragment blur samples
+  // as its alpha mask.
+  if (blur_style != BlurStyle::kNormal) {
+    return y_blur;
+  }
+  auto compute_blur = std::make_shared<ComputeSeparableFilterContents>();
+  compute_blur->SetInputs({input});
+  compute_blur->SetOperation(
+      ComputeSeparableFilterContents::Operation::kGaussianBlur);
+  compute_blur->SetSigma(sigma_x, sigma_y);
+  compute_blur->SetTileMode(tile_mode);
+  compute_blur->SetEffectTransform(effect_transform);
+  compute_blur->SetColorMatrix(color_matrix);
+  compute_blur->SetFallback(std::move(y_blur));
+  // The passes of the dual filter have nowhere to apply a color matrix, so
+  // blurs that carry one are always rendered exactly.
+  if (quality == BlurQuality::kDualFilter && !color_matrix.has_value()) {
+    auto filter = std::make_shared<DualFilterBlurFilterContents>();
+    filter->SetInputs({input});
+    filter->SetSigma(sigma_x, sigma_y);
+    filter->SetTileMode(tile_mode);
+    filter->SetEffectTransform(effect_transform);
+    filter->SetFallback(std::move(compute_blur));
+    return filter;
+  }
+  return compute_blur;
 }
 
 std::shared_ptr<FilterContents> FilterContents::MakeBorderMaskBlur(
@@ -103,11 +198,19 @@ std::shared_ptr<FilterContents> FilterContents::MakeMorphology(
     MorphType morph_type,
     const Matrix& effect_transform) {
   auto x_morphology = MakeDirectionalMorphology(
-      std::move(input), radius_x, Point(1, 0), morph_type, effect_transform);
+      input, radius_x, Point(1, 0), morph_type, effect_transform);
   auto y_morphology =
       MakeDirectionalMorphology(FilterInput::Make(x_morphology), radius_y,
                                 Point(0, 1), morph_type, effect_transform);
-  return y_morphology;
+  auto filter = std::make_shared<ComputeSeparableFilterContents>();
+  filter->SetInputs({std::move(input)});
+  filter->SetOperation(morph_type == MorphType::kDilate
+                           ? ComputeSeparableFilterContents::Operation::kDilate
+                           : ComputeSeparableFilterContents::Operation::kErode);
+  filter->SetRadius(radius_x, radius_y);
+  filter->SetEffectTransform(effect_transform);
+  filter->SetFallback(std::move(y_morphology));
+  return filter;
 }
 
 std::shared_ptr<FilterContents> FilterContents::MakeMatrixFilter(
@@ -169,9 +272,10 @@ bool FilterContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  // Run the filter.
+  // Run the filter. Only the output within the render target can be seen.
 
-  auto maybe_entity = GetEntity(renderer, entity);
+  auto maybe_entity = GetEntity(renderer, entity,
+                                Rect::MakeSize(pass.GetRenderTargetSize()));
   if (!maybe_entity.has_value()) {
     return true;
   }
@@ -223,13 +327,34 @@ std::optional<Rect> FilterContents::GetFilterCoverage(
   return result;
 }
 
-std::optional<Entity> FilterContents::GetEntity(const ContentContext& renderer,
-                                                const Entity& entity) const {
+std::optional<Rect> FilterContents::GetFilterSourceCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  return std::nullopt;
+}
+
+std::optional<Rect> FilterContents::GetSourceCoverageLimit(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& coverage) const {
+  return GetFilterSourceCoverage(inputs, entity, effect_transform, coverage);
+}
+
+std::optional<Entity> FilterContents::GetEntity(
+    const ContentContext& renderer,
+    const Entity& entity,
+    const std::optional<Rect>& coverage_limit) const {
   Entity entity_with_local_transform = entity;
   entity_with_local_transform.SetTransformation(
       GetTransform(entity.GetTransformation()));
 
   auto coverage = GetLocalCoverage(entity_with_local_transform);
+  if (coverage.has_value() && coverage_limit.has_value()) {
+    coverage = coverage->Intersection(coverage_limit.value());
+  }
   if (!coverage.has_value() || coverage->IsEmpty()) {
     return std::nullopt;
   }
@@ -241,13 +366,16 @@ std::optional<Entity> FilterContents::GetEntity(const ContentContext& renderer,
 std::optional<Snapshot> FilterContents::RenderToSnapshot(
     const ContentContext& renderer,
     const Entity& entity,
+    std::optional<Rect> coverage_limit,
     const std::optional<SamplerDescriptor>& sampler_descriptor,
     bool msaa_enabled) const {
   // Resolve the render instruction (entity) from the filter and render it to a
   // snapshot.
-  if (std::optional<Entity> result = GetEntity(renderer, entity);
+  if (std::optional<Entity> result =
+          GetEntity(renderer, entity, coverage_limit);
       result.has_value()) {
-    return result->GetContents()->RenderToSnapshot(renderer, result.value());
+    return result->GetContents()->RenderToSnapshot(renderer, result.value(),
+                                                   coverage_limit);
   }
 
   return std::nullopt;
@@ -32,6 +32,38 @@ class FilterContents : public Contents {
   // Domain is kRGBA, we may decide to support more color modes later.
   struct ColorMatrix {
     float array[20];
+
+    /// @brief  The 4x4 part of the matrix, laid out to transform the column
+    ///         vector of an unpremultiplied color in a shader.
+    Matrix GetColorTransform() const;
+
+    /// @brief  The fifth column of the matrix, added to the transformed
+    ///         color.
+    Vector4 GetColorOffset() const;
+
+    /// @brief  Combines two color matrices into one that gives the same
+    ///         result as applying |inner| and then |outer| in separate
+    ///         passes.
+    ///
+    ///         Each pass clamps its result, and transparent pixels lose
+    ///         their color when the pass premultiplies it. So the matrices
+    ///         are only combined when |inner| can't produce a color out of
+    ///         range for any input, and both keep transparent pixels
+    ///         transparent.
+    ///
+    /// @return The combined matrix, or std::nullopt if the result of the
+    ///         separate passes can't be reproduced by a single matrix.
+    static std::optional<ColorMatrix> Compose(const ColorMatrix& outer,
+                                              const ColorMatrix& inner);
+  };
+
+  enum class BlurQuality {
+    /// A separable blur that samples the whole kernel of each pixel.
+    kExact,
+    /// A chain of passes that halve and double the resolution, which
+    /// approximates large blurs at a fraction of the cost. Blurs that the
+    /// chain cannot approximate fall back to |kExact|.
+    kDualFilter,
   };
 
   enum class MorphType { kDilate, kErode };
@@ -46,13 +78,18 @@ class FilterContents : public Contents {
       Sigma secondary_sigma = {},
       const Matrix& effect_transform = Matrix());
 
+  /// @param color_matrix  A color matrix applied to the blurred result by
+  ///                      the last pass of the blur, which saves the color
+  ///                      filter a pass of its own.
   static std::shared_ptr<FilterContents> MakeGaussianBlur(
       const FilterInput::Ref& input,
       Sigma sigma_x,
       Sigma sigma_y,
       BlurStyle blur_style = BlurStyle::kNormal,
       Entity::TileMode tile_mode = Entity::TileMode::kDecal,
-      const Matrix& effect_transform = Matrix());
+      const Matrix& effect_transform = Matrix(),
+      BlurQuality quality = BlurQuality::kExact,
+      std::optional<ColorMatrix> color_matrix = std::nullopt);
 
   static std::shared_ptr<FilterContents> MakeBorderMaskBlur(
       FilterInput::Ref input,
@@ -109,9 +146,14 @@ class FilterContents : public Contents {
   ///         filter. Note that this is in addition to the entity's transform.
   void SetEffectTransform(Matrix effect_transform);
 
-  /// @brief  Create an Entity that renders this filter's output.
-  std::optional<Entity> GetEntity(const ContentContext& renderer,
-                                  const Entity& entity) const;
+  /// @brief  Create an Entity that renders this filter's output. When a
+  ///         `coverage_limit` is given, only the output within it is
+  ///         guaranteed to be rendered, and the inputs are only rendered
+  ///         where they are needed for that part of the output.
+  std::optional<Entity> GetEntity(
+      const ContentContext& renderer,
+      const Entity& entity,
+      const std::optional<Rect>& coverage_limit = std::nullopt) const;
 
   // |Contents|
   bool Render(const ContentContext& renderer,
@@ -125,6 +167,7 @@ class FilterContents : public Contents {
   std::optional<Snapshot> RenderToSnapshot(
       const ContentContext& renderer,
       const Entity& entity,
+      std::optional<Rect> coverage_limit = std::nullopt,
       const std::optional<SamplerDescriptor>& sampler_descriptor = std::nullopt,
       bool msaa_enabled = true) const override;
 
@@ -132,12 +175,31 @@ class FilterContents : public Contents {
 
   Matrix GetTransform(const Matrix& parent_transform) const;
 
+ protected:
+  /// @brief  The part of the inputs that is sampled to render the output
+  ///         within `coverage`, or std::nullopt if all of it may be.
+  ///         `RenderFilter` implementations pass this to
+  ///         `FilterInput::GetSnapshot`.
+  std::optional<Rect> GetSourceCoverageLimit(const FilterInput::Vector& inputs,
+                                             const Entity& entity,
+                                             const Matrix& effect_transform,
+                                             const Rect& coverage) const;
+
  private:
   virtual std::optional<Rect> GetFilterCoverage(
       const FilterInput::Vector& inputs,
       const Entity& entity,
       const Matrix& effect_transform) const;
 
+  /// @brief  The inverse of `GetFilterCoverage`: the part of the inputs that
+  ///         the output within `output_limit` is rendered from. Returns
+  ///         std::nullopt, meaning all of the inputs, unless overridden.
+  virtual std::optional<Rect> GetFilterSourceCoverage(
+      const FilterInput::Vector& inputs,
+      const Entity& entity,
+      const Matrix& effect_transform,
+      const Rect& output_limit) const;
+
   /// @brief  Converts zero or more filter inputs into a render instruction.
   virtual std::optional<Entity> RenderFilter(const FilterInput::Vector& inputs,
                                              const ContentContext& renderer,
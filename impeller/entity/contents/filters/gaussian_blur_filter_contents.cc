@@ -81,6 +81,11 @@ void DirectionalGaussianBlurFilterContents::SetSourceOverride(
   source_override_ = std::move(source_override);
 }
 
+void DirectionalGaussianBlurFilterContents::SetColorMatrix(
+    std::optional<ColorMatrix> color_matrix) {
+  color_matrix_ = color_matrix;
+}
+
 std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -100,7 +105,9 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
 
   // Input 0 snapshot.
 
-  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto source_limit =
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage);
+  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity, source_limit);
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -148,7 +155,7 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   // Source override snapshot.
 
   auto source = source_override_ ? source_override_ : inputs[0];
-  auto source_snapshot = source->GetSnapshot(renderer, entity);
+  auto source_snapshot = source->GetSnapshot(renderer, entity, source_limit);
   if (!source_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -205,6 +212,11 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     frag_info.inner_blur_factor = inner_blur_factor_;
     frag_info.outer_blur_factor = outer_blur_factor_;
     frag_info.texture_size = Point(input_snapshot->GetCoverage().value().size);
+    frag_info.apply_color_matrix = color_matrix_.has_value();
+    if (color_matrix_.has_value()) {
+      frag_info.color_m = color_matrix_->GetColorTransform();
+      frag_info.color_v = color_matrix_->GetColorOffset();
+    }
 
     Command cmd;
     cmd.label = SPrintF("Gaussian Blur Filter (Radius=%.2f)",
@@ -320,4 +332,22 @@ std::optional<Rect> DirectionalGaussianBlurFilterContents::GetFilterCoverage(
               Size(extent.x, extent.y));
 }
 
+std::optional<Rect> DirectionalGaussianBlurFilterContents::GetFilterSourceCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+
+  auto transform = inputs[0]->GetTransform(entity) * effect_transform.Basis();
+  auto transformed_blur_vector =
+      transform.TransformDirection(blur_direction_ * Radius{blur_sigma_}.radius)
+          .Abs();
+  auto extent = output_limit.size + transformed_blur_vector * 2;
+  return Rect(output_limit.origin - transformed_blur_vector,
+              Size(extent.x, extent.y));
+}
+
 }  // namespace impeller
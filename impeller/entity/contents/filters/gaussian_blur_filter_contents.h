@@ -29,12 +29,24 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
 
   void SetSourceOverride(FilterInput::Ref alpha_mask);
 
+  /// @brief  A color matrix applied to the result of the blur, so that a
+  ///         color filter that follows the blur doesn't need a pass of its
+  ///         own.
+  void SetColorMatrix(std::optional<ColorMatrix> color_matrix);
+
   // |FilterContents|
   std::optional<Rect> GetFilterCoverage(
       const FilterInput::Vector& inputs,
       const Entity& entity,
       const Matrix& effect_transform) const override;
 
+  // |FilterContents|
+  std::optional<Rect> GetFilterSourceCoverage(
+      const FilterInput::Vector& inputs,
+      const Entity& entity,
+      const Matrix& effect_transform,
+      const Rect& output_limit) const override;
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
@@ -51,6 +63,7 @@ class DirectionalGaussianBlurFilterContents final : public FilterContents {
   bool inner_blur_factor_ = true;
   bool outer_blur_factor_ = true;
   FilterInput::Ref source_override_;
+  std::optional<ColorMatrix> color_matrix_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DirectionalGaussianBlurFilterContents);
 };
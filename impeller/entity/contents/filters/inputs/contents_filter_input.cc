@@ -21,10 +21,13 @@ FilterInput::Variant ContentsFilterInput::GetInput() const {
 
 std::optional<Snapshot> ContentsFilterInput::GetSnapshot(
     const ContentContext& renderer,
-    const Entity& entity) const {
-  if (!snapshot_.has_value()) {
-    snapshot_ = contents_->RenderToSnapshot(renderer, entity, std::nullopt,
-                                            msaa_enabled_);
+    const Entity& entity,
+    std::optional<Rect> coverage_limit) const {
+  if (!snapshot_.has_value() ||
+      !SnapshotCoversLimit(snapshot_coverage_limit_, coverage_limit)) {
+    snapshot_ = contents_->RenderToSnapshot(renderer, entity, coverage_limit,
+                                            std::nullopt, msaa_enabled_);
+    snapshot_coverage_limit_ = coverage_limit;
   }
   return snapshot_;
 }
@@ -22,9 +22,12 @@ FilterInput::Variant FilterContentsFilterInput::GetInput() const {
 
 std::optional<Snapshot> FilterContentsFilterInput::GetSnapshot(
     const ContentContext& renderer,
-    const Entity& entity) const {
-  if (!snapshot_.has_value()) {
-    snapshot_ = filter_->RenderToSnapshot(renderer, entity);
+    const Entity& entity,
+    std::optional<Rect> coverage_limit) const {
+  if (!snapshot_.has_value() ||
+      !SnapshotCoversLimit(snapshot_coverage_limit_, coverage_limit)) {
+    snapshot_ = filter_->RenderToSnapshot(renderer, entity, coverage_limit);
+    snapshot_coverage_limit_ = coverage_limit;
   }
   return snapshot_;
 }
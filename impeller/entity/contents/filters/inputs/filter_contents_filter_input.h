@@ -16,8 +16,10 @@ class FilterContentsFilterInput final : public FilterInput {
   Variant GetInput() const override;
 
   // |FilterInput|
-  std::optional<Snapshot> GetSnapshot(const ContentContext& renderer,
-                                      const Entity& entity) const override;
+  std::optional<Snapshot> GetSnapshot(
+      const ContentContext& renderer,
+      const Entity& entity,
+      std::optional<Rect> coverage_limit = std::nullopt) const override;
 
   // |FilterInput|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
@@ -33,6 +35,9 @@ class FilterContentsFilterInput final : public FilterInput {
 
   std::shared_ptr<FilterContents> filter_;
   mutable std::optional<Snapshot> snapshot_;
+  // The limit the snapshot was rendered with, or std::nullopt if it has all
+  // of the input.
+  mutable std::optional<Rect> snapshot_coverage_limit_;
 
   friend FilterInput;
 };
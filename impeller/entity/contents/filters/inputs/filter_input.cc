@@ -64,6 +64,16 @@ Matrix FilterInput::GetTransform(const Entity& entity) const {
   return entity.GetTransformation() * GetLocalTransform(entity);
 }
 
+bool FilterInput::SnapshotCoversLimit(
+    const std::optional<Rect>& snapshot_limit,
+    const std::optional<Rect>& coverage_limit) {
+  if (!snapshot_limit.has_value()) {
+    return true;
+  }
+  return coverage_limit.has_value() &&
+         snapshot_limit->Contains(coverage_limit.value());
+}
+
 FilterInput::~FilterInput() = default;
 
 }  // namespace impeller
@@ -45,8 +45,13 @@ class FilterInput {
 
   virtual Variant GetInput() const = 0;
 
-  virtual std::optional<Snapshot> GetSnapshot(const ContentContext& renderer,
-                                              const Entity& entity) const = 0;
+  /// @brief  Renders the input to a snapshot. When a `coverage_limit` is
+  ///         given, the snapshot may only cover the part of the input
+  ///         within it.
+  virtual std::optional<Snapshot> GetSnapshot(
+      const ContentContext& renderer,
+      const Entity& entity,
+      std::optional<Rect> coverage_limit = std::nullopt) const = 0;
 
   std::optional<Rect> GetLocalCoverage(const Entity& entity) const;
 
@@ -59,6 +64,12 @@ class FilterInput {
   /// @brief  Get the transform of this `FilterInput`. This is equivalent to
   ///         calling `entity.GetTransformation() * GetLocalTransform()`.
   virtual Matrix GetTransform(const Entity& entity) const;
+
+ protected:
+  /// @brief  Whether a snapshot rendered with `snapshot_limit` has all of
+  ///         the input that a snapshot rendered with `coverage_limit` would.
+  static bool SnapshotCoversLimit(const std::optional<Rect>& snapshot_limit,
+                                  const std::optional<Rect>& coverage_limit);
 };
 
 }  // namespace impeller
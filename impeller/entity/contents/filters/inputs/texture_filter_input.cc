@@ -20,7 +20,8 @@ FilterInput::Variant TextureFilterInput::GetInput() const {
 
 std::optional<Snapshot> TextureFilterInput::GetSnapshot(
     const ContentContext& renderer,
-    const Entity& entity) const {
+    const Entity& entity,
+    std::optional<Rect> coverage_limit) const {
   return Snapshot{.texture = texture_, .transform = GetTransform(entity)};
 }
 
@@ -30,7 +30,9 @@ std::optional<Entity> LinearToSrgbFilterContents::RenderFilter(
   using VS = LinearToSrgbFilterPipeline::VertexShader;
   using FS = LinearToSrgbFilterPipeline::FragmentShader;
 
-  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -25,9 +25,19 @@ std::optional<Entity> LocalMatrixFilterContents::RenderFilter(
     const Entity& entity,
     const Matrix& effect_transform,
     const Rect& coverage) const {
-  return Contents::EntityFromSnapshot(inputs[0]->GetSnapshot(renderer, entity),
-                                      entity.GetBlendMode(),
+  auto snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
+  return Contents::EntityFromSnapshot(snapshot, entity.GetBlendMode(),
                                       entity.GetStencilDepth());
 }
 
+std::optional<Rect> LocalMatrixFilterContents::GetFilterSourceCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  return output_limit;
+}
+
 }  // namespace impeller
@@ -21,6 +21,13 @@ class LocalMatrixFilterContents final : public FilterContents {
   Matrix GetLocalTransform(const Matrix& parent_transform) const override;
 
  private:
+  // |FilterContents|
+  std::optional<Rect> GetFilterSourceCoverage(
+      const FilterInput::Vector& inputs,
+      const Entity& entity,
+      const Matrix& effect_transform,
+      const Rect& output_limit) const override;
+
   // |FilterContents|
   std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
                                      const ContentContext& renderer,
@@ -51,7 +51,9 @@ std::optional<Entity> DirectionalMorphologyFilterContents::RenderFilter(
     return std::nullopt;
   }
 
-  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -184,4 +186,23 @@ std::optional<Rect> DirectionalMorphologyFilterContents::GetFilterCoverage(
   return Rect(origin, Size(size.x, size.y));
 }
 
+std::optional<Rect> DirectionalMorphologyFilterContents::GetFilterSourceCoverage(
+    const FilterInput::Vector& inputs,
+    const Entity& entity,
+    const Matrix& effect_transform,
+    const Rect& output_limit) const {
+  if (inputs.empty()) {
+    return std::nullopt;
+  }
+
+  // Both dilating and eroding read the input up to the radius away from each
+  // output pixel.
+  auto transform = inputs[0]->GetTransform(entity) * effect_transform.Basis();
+  auto transformed_vector =
+      transform.TransformDirection(direction_ * radius_.radius).Abs();
+  auto extent = output_limit.size + transformed_vector * 2;
+  return Rect(output_limit.origin - transformed_vector,
+              Size(extent.x, extent.y));
+}
+
 }  // namespace impeller
@@ -30,7 +30,9 @@ std::optional<Entity> SrgbToLinearFilterContents::RenderFilter(
   using VS = SrgbToLinearFilterPipeline::VertexShader;
   using FS = SrgbToLinearFilterPipeline::FragmentShader;
 
-  auto input_snapshot = inputs[0]->GetSnapshot(renderer, entity);
+  auto input_snapshot = inputs[0]->GetSnapshot(
+      renderer, entity,
+      GetSourceCoverageLimit(inputs, entity, effect_transform, coverage));
   if (!input_snapshot.has_value()) {
     return std::nullopt;
   }
@@ -28,6 +28,18 @@ constexpr Matrix kMatrixBT601FullRange = {
 };
 // clang-format on
 
+// static
+Matrix YUVToRGBFilterContents::GetYUVToRGBMatrix(
+    YUVColorSpace yuv_color_space) {
+  switch (yuv_color_space) {
+    case YUVColorSpace::kBT601LimitedRange:
+      return kMatrixBT601LimitedRange;
+    case YUVColorSpace::kBT601FullRange:
+      return kMatrixBT601FullRange;
+  }
+  FML_UNREACHABLE();
+}
+
 YUVToRGBFilterContents::YUVToRGBFilterContents() = default;
 
 YUVToRGBFilterContents::~YUVToRGBFilterContents() = default;
@@ -92,14 +104,7 @@ std::optional<Entity> YUVToRGBFilterContents::RenderFilter(
 
     FS::FragInfo frag_info;
     frag_info.yuv_color_space = static_cast<Scalar>(yuv_color_space_);
-    switch (yuv_color_space_) {
-      case YUVColorSpace::kBT601LimitedRange:
-        frag_info.matrix = kMatrixBT601LimitedRange;
-        break;
-      case YUVColorSpace::kBT601FullRange:
-        frag_info.matrix = kMatrixBT601FullRange;
-        break;
-    }
+    frag_info.matrix = GetYUVToRGBMatrix(yuv_color_space_);
 
     auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler({});
     FS::BindYTexture(cmd, y_input_snapshot->texture, sampler);
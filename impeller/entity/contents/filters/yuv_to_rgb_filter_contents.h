@@ -16,6 +16,12 @@ class YUVToRGBFilterContents final : public FilterContents {
 
   void SetYUVColorSpace(YUVColorSpace yuv_color_space);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The matrix that converts the offset YUV samples of the color
+  ///             space to RGB, as the YUV shaders expect it.
+  ///
+  static Matrix GetYUVToRGBMatrix(YUVColorSpace yuv_color_space);
+
  private:
   // |FilterContents|
   std::optional<Entity> RenderFilter(const FilterInput::Vector& input_textures,
@@ -142,4 +142,9 @@ bool FramebufferBlendContents::Render(const ContentContext& renderer,
   return pass.AddCommand(cmd);
 }
 
+bool FramebufferBlendContents::CanInheritOpacity(const Entity& entity) const {
+  // The blend is rendered with the opacity of its child contents.
+  return false;
+}
+
 }  // namespace impeller
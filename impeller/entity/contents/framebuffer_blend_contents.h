@@ -34,6 +34,9 @@ class FramebufferBlendContents final : public ColorSourceContents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CanInheritOpacity(const Entity& entity) const override;
+
   BlendMode blend_mode_;
   std::shared_ptr<Contents> child_contents_;
 
@@ -8,6 +8,7 @@
 
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/gradient_cache.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/texture.h"
@@ -42,6 +43,22 @@ std::shared_ptr<Texture> CreateGradientTexture(
   return texture;
 }
 
+std::shared_ptr<Texture> GetGradientTexture(const ContentContext& renderer,
+                                            const std::vector<Color>& colors,
+                                            const std::vector<Scalar>& stops) {
+  auto gradient_cache = renderer.GetGradientCache();
+  GradientCache::Key key{.colors = colors, .stops = stops};
+  if (auto texture = gradient_cache->Get(key)) {
+    return texture;
+  }
+  auto texture = CreateGradientTexture(CreateGradientBuffer(colors, stops),
+                                       renderer.GetContext());
+  if (texture) {
+    gradient_cache->Set(std::move(key), texture);
+  }
+  return texture;
+}
+
 std::vector<StopData> CreateGradientColors(const std::vector<Color>& colors,
                                            const std::vector<Scalar>& stops) {
   FML_DCHECK(stops.size() == colors.size());
@@ -19,6 +19,7 @@
 namespace impeller {
 
 class Context;
+class ContentContext;
 
 /**
  * @brief Create a host visible texture that contains the gradient defined
@@ -28,6 +29,14 @@ std::shared_ptr<Texture> CreateGradientTexture(
     const GradientData& gradient_data,
     const std::shared_ptr<impeller::Context>& context);
 
+/**
+ * @brief Get the texture of the gradient with the given colors and stops from
+ * the gradient cache of the renderer, creating and caching it if needed.
+ */
+std::shared_ptr<Texture> GetGradientTexture(const ContentContext& renderer,
+                                            const std::vector<Color>& colors,
+                                            const std::vector<Scalar>& stops);
+
 struct StopData {
   Color color;
   Scalar stop;
@@ -4,6 +4,8 @@
 
 #include "linear_gradient_contents.h"
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -59,9 +61,7 @@ bool LinearGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = LinearGradientFillPipeline::VertexShader;
   using FS = LinearGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = GetGradientTexture(renderer, colors_, stops_);
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -172,4 +172,10 @@ bool LinearGradientContents::RenderSSBO(const ContentContext& renderer,
   return true;
 }
 
+bool LinearGradientContents::NeedsExtendedRange(const Entity& entity) const {
+  return std::any_of(colors_.begin(), colors_.end(), [](const Color& color) {
+    return !color.IsInStandardRange();
+  });
+}
+
 }  // namespace impeller
@@ -30,6 +30,9 @@ class LinearGradientContents final : public ColorSourceContents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
   void SetEndPoints(Point start_point, Point end_point);
 
   void SetColors(std::vector<Color> colors);
@@ -4,6 +4,8 @@
 
 #include "radial_gradient_contents.h"
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -116,9 +118,7 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = RadialGradientFillPipeline::VertexShader;
   using FS = RadialGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = GetGradientTexture(renderer, colors_, stops_);
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -173,4 +173,10 @@ bool RadialGradientContents::RenderTexture(const ContentContext& renderer,
   return true;
 }
 
+bool RadialGradientContents::NeedsExtendedRange(const Entity& entity) const {
+  return std::any_of(colors_.begin(), colors_.end(), [](const Color& color) {
+    return !color.IsInStandardRange();
+  });
+}
+
 }  // namespace impeller
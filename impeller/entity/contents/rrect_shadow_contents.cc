@@ -3,13 +3,16 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/contents/rrect_shadow_contents.h"
+#include <cmath>
 #include <optional>
 
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/shadow_cache.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 #include "impeller/tessellator/tessellator.h"
 
@@ -54,6 +57,156 @@ bool RRectShadowContents::Render(const ContentContext& renderer,
     return true;
   }
 
+  if (RenderNinePatch(renderer, entity, pass)) {
+    return true;
+  }
+  return RenderBlur(renderer, entity, pass);
+}
+
+/// Shadows whose nine patch would be larger than this, along either side, are
+/// blurred directly.
+static constexpr Scalar kMaxNinePatchSize = 256;
+
+/// The corner radius and sigma of the nine patches are rounded to a quarter of
+/// a pixel, so that shadows that differ by less than that share a texture.
+static Scalar QuantizeForNinePatch(Scalar value) {
+  return std::round(value * 4) / 4;
+}
+
+bool RRectShadowContents::RenderNinePatch(const ContentContext& renderer,
+                                          const Entity& entity,
+                                          RenderPass& pass) const {
+  using VS = TexturePipeline::VertexShader;
+  using FS = TexturePipeline::FragmentShader;
+
+  // The nine patch is rendered in pixels of the render target, so it can only
+  // be stretched along the axes and has to be scaled uniformly.
+  const auto& transform = entity.GetTransformation();
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  auto scale = std::abs(transform.m[0]);
+  if (scale == 0 || !ScalarNearlyEqual(scale, std::abs(transform.m[5]))) {
+    return false;
+  }
+
+  auto positive_rect = rect_->GetPositive();
+  auto corner_radius =
+      std::min(corner_radius_, std::min(positive_rect.size.width / 2.0f,
+                                        positive_rect.size.height / 2.0f));
+  ShadowCache::Key key{
+      .corner_radius = QuantizeForNinePatch(corner_radius * scale),
+      .sigma = QuantizeForNinePatch(sigma_.sigma * scale),
+      .color = color_,
+  };
+  if (key.sigma <= 0) {
+    return false;
+  }
+
+  // The corners of the nine patch hold everything about the shadow that varies
+  // along both axes, which is the blur outside of the rounded rect, its
+  // rounded corner, and the blur inside of it. The single pixel between them
+  // is stretched to the size of the shadow.
+  auto blur_radius = key.sigma * 2;
+  Scalar corner_size = std::ceil(key.corner_radius + blur_radius * 2);
+  Scalar texture_size = corner_size * 2 + 1;
+  auto local_blur_radius = sigma_.sigma * 2;
+  auto bounds = Rect::MakeLTRB(
+      positive_rect.GetLeft() - local_blur_radius,
+      positive_rect.GetTop() - local_blur_radius,
+      positive_rect.GetRight() + local_blur_radius,
+      positive_rect.GetBottom() + local_blur_radius);
+  if (texture_size > kMaxNinePatchSize ||
+      bounds.size.width * scale < texture_size ||
+      bounds.size.height * scale < texture_size) {
+    return false;
+  }
+
+  auto shadow_cache = renderer.GetShadowCache();
+  auto texture = shadow_cache->Get(key);
+  if (!texture) {
+    texture = renderer.MakeSubpass(
+        "RRect Shadow Nine Patch", ISize(texture_size, texture_size),
+        [&key, blur_radius, texture_size](const ContentContext& renderer,
+                                          RenderPass& pass) {
+          RRectShadowContents contents;
+          contents.SetRRect(
+              Rect::MakeLTRB(blur_radius, blur_radius,
+                             texture_size - blur_radius,
+                             texture_size - blur_radius),
+              key.corner_radius);
+          contents.SetSigma(Sigma(key.sigma));
+          // The color of the key is already premultiplied.
+          contents.color_ = key.color;
+          return contents.RenderBlur(renderer, Entity(), pass);
+        },
+        /*msaa_enabled=*/false);
+    if (!texture) {
+      return false;
+    }
+    shadow_cache->Set(key, texture);
+  }
+
+  // The edges of the slices, in local space and in texture coordinates.
+  auto corner_width = corner_size / scale;
+  auto [left, top, right, bottom] = bounds.GetLTRB();
+  const Scalar xs[4] = {left, left + corner_width, right - corner_width, right};
+  const Scalar ys[4] = {top, top + corner_width, bottom - corner_width, bottom};
+  const Scalar uvs[4] = {0, corner_size / texture_size,
+                         (corner_size + 1) / texture_size, 1};
+
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.Reserve(16);
+  vtx_builder.ReserveIndices(54);
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      vtx_builder.AppendVertex({
+          .position = Point(xs[x], ys[y]),
+          .texture_coords = Point(uvs[x], uvs[y]),
+      });
+    }
+  }
+  for (uint16_t y = 0; y < 3; y++) {
+    for (uint16_t x = 0; x < 3; x++) {
+      uint16_t top_left = y * 4 + x;
+      for (uint16_t index : {0, 1, 4, 1, 5, 4}) {
+        vtx_builder.AppendIndex(top_left + index);
+      }
+    }
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = "RRect Shadow Nine Patch";
+  cmd.pipeline =
+      renderer.GetTexturePipeline(OptionsFromPassAndEntity(pass, entity));
+  cmd.stencil_reference = entity.GetStencilDepth();
+  cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp =
+      Matrix::MakeOrthographic(pass.GetRenderTargetSize()) * transform;
+  frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  SamplerDescriptor sampler_desc;
+  sampler_desc.min_filter = MinMagFilter::kLinear;
+  sampler_desc.mag_filter = MinMagFilter::kLinear;
+  FS::BindTextureSampler(
+      cmd, texture,
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+bool RRectShadowContents::RenderBlur(const ContentContext& renderer,
+                                     const Entity& entity,
+                                     RenderPass& pass) const {
   using VS = RRectBlurPipeline::VertexShader;
   using FS = RRectBlurPipeline::FragmentShader;
 
@@ -108,4 +261,8 @@ bool RRectShadowContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool RRectShadowContents::NeedsExtendedRange(const Entity& entity) const {
+  return !color_.IsInStandardRange();
+}
+
 }  // namespace impeller
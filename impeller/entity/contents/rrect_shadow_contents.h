@@ -38,7 +38,23 @@ class RRectShadowContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
  private:
+  /// @brief  Draws the shadow by stretching a nine patch texture that is kept
+  ///         in the shadow cache of the `renderer`, rendering it first if
+  ///         needed. Returns false, without drawing anything, if the shadow
+  ///         can't be drawn this way.
+  bool RenderNinePatch(const ContentContext& renderer,
+                       const Entity& entity,
+                       RenderPass& pass) const;
+
+  /// @brief  Draws the shadow by evaluating the blur for every pixel.
+  bool RenderBlur(const ContentContext& renderer,
+                  const Entity& entity,
+                  RenderPass& pass) const;
+
   std::optional<Rect> rect_;
   Scalar corner_radius_;
   Sigma sigma_;
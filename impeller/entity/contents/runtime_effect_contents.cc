@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/runtime_effect_contents.h"
 
+#include <algorithm>
 #include <future>
 #include <memory>
 
@@ -37,16 +38,11 @@ void RuntimeEffectContents::SetTextureInputs(
   texture_inputs_ = std::move(texture_inputs);
 }
 
-bool RuntimeEffectContents::Render(const ContentContext& renderer,
-                                   const Entity& entity,
-                                   RenderPass& pass) const {
+bool RuntimeEffectContents::RegisterShader(
+    const ContentContext& renderer) const {
   auto context = renderer.GetContext();
   auto library = context->GetShaderLibrary();
 
-  //--------------------------------------------------------------------------
-  /// Get or register shader.
-  ///
-
   // TODO(113719): Register the shader function earlier.
 
   std::shared_ptr<const ShaderFunction> function = library->GetFunction(
@@ -90,6 +86,36 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
 
     runtime_stage_->SetClean();
   }
+  return true;
+}
+
+bool RuntimeEffectContents::Render(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const {
+  auto context = renderer.GetContext();
+
+  //--------------------------------------------------------------------------
+  /// Check the uniforms.
+  ///
+
+  const auto& uniforms = runtime_stage_->GetUniforms();
+  const auto& layout = runtime_stage_->GetUniformLayout();
+  if (layout.has_unsupported_uniforms) {
+    VALIDATION_LOG << "Unsupported uniform type in runtime effect "
+                   << runtime_stage_->GetEntrypoint() << ".";
+    return true;
+  }
+  if (layout.float_data_size > 0 &&
+      (!uniform_data_ || uniform_data_->size() < layout.float_data_size)) {
+    VALIDATION_LOG << "Not enough uniform data for runtime effect "
+                   << runtime_stage_->GetEntrypoint() << ".";
+    return false;
+  }
+  if (texture_inputs_.size() < layout.sampled_image_uniforms.size()) {
+    VALIDATION_LOG << "Not enough texture inputs for runtime effect "
+                   << runtime_stage_->GetEntrypoint() << ".";
+    return false;
+  }
 
   //--------------------------------------------------------------------------
   /// Resolve geometry.
@@ -102,27 +128,7 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Get or create runtime stage pipeline.
   ///
 
-  const auto& device_capabilities = context->GetDeviceCapabilities();
-  const auto color_attachment_format = context->GetColorAttachmentPixelFormat();
-  const auto stencil_attachment_format =
-      device_capabilities.GetDefaultStencilFormat();
-
   using VS = RuntimeEffectVertexShader;
-  PipelineDescriptor desc;
-  desc.SetLabel("Runtime Stage");
-  desc.AddStageEntrypoint(
-      library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
-  desc.AddStageEntrypoint(library->GetFunction(runtime_stage_->GetEntrypoint(),
-                                               ShaderStage::kFragment));
-  auto vertex_descriptor = std::make_shared<VertexDescriptor>();
-  if (!vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs)) {
-    VALIDATION_LOG << "Failed to set stage inputs for runtime effect pipeline.";
-  }
-  desc.SetVertexDescriptor(std::move(vertex_descriptor));
-  desc.SetColorAttachmentDescriptor(
-      0u, {.format = color_attachment_format, .blending_enabled = true});
-  desc.SetStencilAttachmentDescriptors({});
-  desc.SetStencilPixelFormat(stencil_attachment_format);
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
@@ -130,9 +136,46 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  options.ApplyToPipelineDescriptor(desc);
 
-  auto pipeline = context->GetPipelineLibrary()->GetPipeline(desc).Get();
+  // The pipelines of a stage that was reloaded use the old function.
+  if (runtime_stage_->IsDirty()) {
+    renderer.ClearCachedRuntimeEffectPipeline(runtime_stage_->GetEntrypoint());
+  }
+
+  auto pipeline = renderer.GetCachedRuntimeEffectPipeline(
+      runtime_stage_->GetEntrypoint(), options,
+      [&]() -> std::shared_ptr<Pipeline<PipelineDescriptor>> {
+        if (!RegisterShader(renderer)) {
+          return nullptr;
+        }
+
+        auto library = context->GetShaderLibrary();
+        const auto& device_capabilities = context->GetDeviceCapabilities();
+        const auto color_attachment_format =
+            context->GetColorAttachmentPixelFormat();
+        const auto stencil_attachment_format =
+            device_capabilities.GetDefaultStencilFormat();
+
+        PipelineDescriptor desc;
+        desc.SetLabel("Runtime Stage");
+        desc.AddStageEntrypoint(
+            library->GetFunction(VS::kEntrypointName, ShaderStage::kVertex));
+        desc.AddStageEntrypoint(library->GetFunction(
+            runtime_stage_->GetEntrypoint(), ShaderStage::kFragment));
+        auto vertex_descriptor = std::make_shared<VertexDescriptor>();
+        if (!vertex_descriptor->SetStageInputs(VS::kAllShaderStageInputs)) {
+          VALIDATION_LOG
+              << "Failed to set stage inputs for runtime effect pipeline.";
+        }
+        desc.SetVertexDescriptor(std::move(vertex_descriptor));
+        desc.SetColorAttachmentDescriptor(
+            0u, {.format = color_attachment_format, .blending_enabled = true});
+        desc.SetStencilAttachmentDescriptors({});
+        desc.SetStencilPixelFormat(stencil_attachment_format);
+        options.ApplyToPipelineDescriptor(desc);
+
+        return context->GetPipelineLibrary()->GetPipeline(desc).Get();
+      });
   if (!pipeline) {
     VALIDATION_LOG << "Failed to get or create runtime effect pipeline.";
     return false;
@@ -156,88 +199,41 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   /// Fragment stage uniforms.
   ///
 
-  size_t minimum_sampler_index = 100000000;
-  size_t buffer_index = 0;
-  size_t buffer_offset = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    ShaderMetadata metadata;
-
-    switch (uniform.type) {
-      case kSampledImage: {
-        // Sampler uniforms are ordered in the IPLR according to their
-        // declaration and the uniform location reflects the correct offset to
-        // be mapped to - except that it may include all proceeding float
-        // uniforms. For example, a float sampler that comes after 4 float
-        // uniforms may have a location of 4. To convert to the actual offset we
-        // need to find the largest location assigned to a float uniform and
-        // then subtract this from all uniform locations. This is more or less
-        // the same operation we previously performed in the shader compiler.
-        minimum_sampler_index =
-            std::min(minimum_sampler_index, uniform.location);
-        break;
-      }
-      case kFloat: {
-        size_t alignment =
-            std::max(uniform.bit_width / 8, DefaultUniformAlignment());
-        auto buffer_view = pass.GetTransientsBuffer().Emplace(
-            uniform_data_->data() + buffer_offset, uniform.GetSize(),
-            alignment);
-
-        ShaderUniformSlot uniform_slot;
-        uniform_slot.name = uniform.name.c_str();
-        uniform_slot.ext_res_0 = uniform.location;
-        cmd.BindResource(ShaderStage::kFragment, uniform_slot, metadata,
-                         buffer_view);
-        buffer_index++;
-        buffer_offset += uniform.GetSize();
-        break;
-      }
-      case kBoolean:
-      case kSignedByte:
-      case kUnsignedByte:
-      case kSignedShort:
-      case kUnsignedShort:
-      case kSignedInt:
-      case kUnsignedInt:
-      case kSignedInt64:
-      case kUnsignedInt64:
-      case kHalfFloat:
-      case kDouble:
-        VALIDATION_LOG << "Unsupported uniform type for " << uniform.name
-                       << ".";
-        return true;
-    }
+  // TODO(113715): Populate this metadata once GLES is able to handle
+  //               non-struct uniform names.
+  ShaderMetadata metadata;
+
+  for (const auto& float_uniform : layout.float_uniforms) {
+    const auto& uniform = uniforms[float_uniform.uniform_index];
+    size_t alignment =
+        std::max(uniform.bit_width / 8, DefaultUniformAlignment());
+    auto buffer_view = pass.GetTransientsBuffer().Emplace(
+        uniform_data_->data() + float_uniform.offset, uniform.GetSize(),
+        alignment);
+
+    ShaderUniformSlot uniform_slot;
+    uniform_slot.name = uniform.name.c_str();
+    uniform_slot.ext_res_0 = uniform.location;
+    cmd.BindResource(ShaderStage::kFragment, uniform_slot, metadata,
+                     buffer_view);
   }
 
-  size_t sampler_index = 0;
-  for (auto uniform : runtime_stage_->GetUniforms()) {
-    // TODO(113715): Populate this metadata once GLES is able to handle
-    //               non-struct uniform names.
-    ShaderMetadata metadata;
-
-    switch (uniform.type) {
-      case kSampledImage: {
-        FML_DCHECK(sampler_index < texture_inputs_.size());
-        auto& input = texture_inputs_[sampler_index];
-
-        auto sampler =
-            context->GetSamplerLibrary()->GetSampler(input.sampler_descriptor);
-
-        SampledImageSlot image_slot;
-        image_slot.name = uniform.name.c_str();
-        image_slot.texture_index = uniform.location - minimum_sampler_index;
-        image_slot.sampler_index = uniform.location - minimum_sampler_index;
-        cmd.BindResource(ShaderStage::kFragment, image_slot, metadata,
-                         input.texture, sampler);
-
-        sampler_index++;
-        break;
-      }
-      default:
-        continue;
-    }
+  // Sampler uniforms are ordered in the IPLR according to their declaration
+  // and their locations include all of the float uniforms before them, so
+  // the location of the first sampler is subtracted to get the slot.
+  for (size_t i = 0; i < layout.sampled_image_uniforms.size(); i++) {
+    const auto& uniform = uniforms[layout.sampled_image_uniforms[i]];
+    const auto& input = texture_inputs_[i];
+
+    auto sampler =
+        context->GetSamplerLibrary()->GetSampler(input.sampler_descriptor);
+
+    SampledImageSlot image_slot;
+    image_slot.name = uniform.name.c_str();
+    image_slot.texture_index = uniform.location - layout.sampler_base_location;
+    image_slot.sampler_index = uniform.location - layout.sampler_base_location;
+    cmd.BindResource(ShaderStage::kFragment, image_slot, metadata,
+                     input.texture, sampler);
   }
 
   pass.AddCommand(std::move(cmd));
@@ -250,4 +246,10 @@ bool RuntimeEffectContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool RuntimeEffectContents::CanInheritOpacity(const Entity& entity) const {
+  // The alpha of the color source is not applied to the output of the
+  // runtime effect.
+  return false;
+}
+
 }  // namespace impeller
@@ -30,7 +30,14 @@ class RuntimeEffectContents final : public ColorSourceContents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CanInheritOpacity(const Entity& entity) const override;
+
  private:
+  /// @brief  Registers the fragment function of the runtime stage with the
+  ///         shader library if it isn't yet, or if the stage was reloaded.
+  bool RegisterShader(const ContentContext& renderer) const;
+
   std::shared_ptr<RuntimeStage> runtime_stage_;
   std::shared_ptr<std::vector<uint8_t>> uniform_data_;
   std::vector<TextureInput> texture_inputs_;
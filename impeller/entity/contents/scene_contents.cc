@@ -80,4 +80,9 @@ bool SceneContents::Render(const ContentContext& renderer,
   return contents.Render(renderer, entity, pass);
 }
 
+bool SceneContents::CanInheritOpacity(const Entity& entity) const {
+  // The alpha of the color source is not applied to the rendered scene.
+  return false;
+}
+
 }  // namespace impeller
@@ -27,6 +27,9 @@ class SceneContents final : public ColorSourceContents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CanInheritOpacity(const Entity& entity) const override;
+
  private:
   Matrix camera_transform_;
   std::shared_ptr<scene::Node> node_;
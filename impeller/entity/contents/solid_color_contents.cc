@@ -54,11 +54,61 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   using VS = SolidFillPipeline::VertexShader;
   using FS = SolidFillPipeline::FragmentShader;
 
+  if (auto snapshot =
+          geometry_->GetSolidFillSnapshot(renderer, entity, pass, color_);
+      snapshot.has_value()) {
+    auto fill_entity = Contents::EntityFromSnapshot(
+        snapshot.value(), entity.GetBlendMode(), entity.GetStencilDepth());
+    return fill_entity.has_value() && fill_entity->Render(renderer, pass);
+  }
+
   Command cmd;
   cmd.label = "Solid Fill";
   cmd.stencil_reference = entity.GetStencilDepth();
 
-  auto geometry_result = geometry_->GetPositionBuffer(renderer, entity, pass);
+  // Multisampling already antialiases the edges of the geometry.
+  const bool use_coverage =
+      pass.GetRenderTarget().GetSampleCount() == SampleCount::kCount1 &&
+      IsAntialiasedWithoutMultisampling(entity);
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  if (!use_coverage) {
+    if (auto extrusion =
+            geometry_->GetStrokeExtrusionBuffer(renderer, entity, pass);
+        extrusion.has_value()) {
+      using ExtrusionVS = StrokeExtrusionPipeline::VertexShader;
+
+      auto options = OptionsFromPassAndEntity(pass, entity);
+      options.stencil_compare = CompareFunction::kEqual;
+      options.stencil_operation = StencilOperation::kIncrementClamp;
+      options.primitive_type = PrimitiveType::kTriangleStrip;
+      cmd.pipeline = renderer.GetStrokeExtrusionPipeline(options);
+      cmd.BindVertices(extrusion->vertex_buffer);
+
+      ExtrusionVS::FrameInfo frame_info;
+      frame_info.mvp = extrusion->transform;
+      frame_info.half_width = extrusion->half_width;
+      ExtrusionVS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+      FS::FragInfo frag_info;
+      frag_info.color = color_.Premultiply();
+      FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+      if (!pass.AddCommand(std::move(cmd))) {
+        return false;
+      }
+      // The strip overlaps itself, so the stencil is incremented to draw each
+      // pixel once and restored after.
+      auto restore = ClipRestoreContents();
+      restore.SetRestoreCoverage(GetCoverage(entity));
+      return restore.Render(renderer, entity, pass);
+    }
+  }
+
+  auto geometry_result =
+      use_coverage
+          ? geometry_->GetPositionCoverageBuffer(renderer, entity, pass)
+          : geometry_->GetPositionBuffer(renderer, entity, pass);
 
   auto options = OptionsFromPassAndEntity(pass, entity);
   if (geometry_result.prevent_overdraw) {
@@ -67,16 +117,32 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   }
 
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetSolidFillPipeline(options);
   cmd.BindVertices(geometry_result.vertex_buffer);
 
-  VS::FrameInfo frame_info;
-  frame_info.mvp = geometry_result.transform;
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  if (use_coverage) {
+    using CoverageVS = SolidFillCoveragePipeline::VertexShader;
+    using CoverageFS = SolidFillCoveragePipeline::FragmentShader;
+
+    cmd.pipeline = renderer.GetSolidFillCoveragePipeline(options);
 
-  FS::FragInfo frag_info;
-  frag_info.color = color_.Premultiply();
-  FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+    CoverageVS::FrameInfo frame_info;
+    frame_info.mvp = geometry_result.transform;
+    CoverageVS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+    CoverageFS::FragInfo frag_info;
+    frag_info.color = color_.Premultiply();
+    CoverageFS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  } else {
+    cmd.pipeline = renderer.GetSolidFillPipeline(options);
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = geometry_result.transform;
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+    FS::FragInfo frag_info;
+    frag_info.color = color_.Premultiply();
+    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  }
 
   if (!pass.AddCommand(std::move(cmd))) {
     return false;
@@ -90,6 +156,67 @@ bool SolidColorContents::Render(const ContentContext& renderer,
   return true;
 }
 
+bool SolidColorContents::CoversArea(const Entity& entity,
+                                    const Rect& rect) const {
+  return color_.IsOpaque() && geometry_ &&
+         geometry_->CoversArea(entity.GetTransformation(), rect);
+}
+
+bool SolidColorContents::IsAntialiasedWithoutMultisampling(
+    const Entity& entity) const {
+  return geometry_ &&
+         geometry_->CanAntialiasWithCoverage(entity.GetTransformation());
+}
+
+static const char kSolidFillBatchTag = 0;
+
+bool SolidColorContents::CanInheritOpacity(const Entity& entity) const {
+  return geometry_ && geometry_->CoversPixelsOnce();
+}
+
+void SolidColorContents::SetInheritedOpacity(Scalar opacity) {
+  color_ = color_.WithAlpha(color_.alpha * opacity);
+}
+
+std::optional<Contents::BatchKey> SolidColorContents::GetBatchKey() const {
+  return BatchKey{.pipeline = &kSolidFillBatchTag};
+}
+
+std::shared_ptr<Contents> SolidColorContents::MergeWith(
+    const ContentContext& renderer,
+    const Entity& entity,
+    const Entity& next) const {
+  // The batch keys are equal, so the contents of `next` are solid colors too.
+  auto next_contents =
+      static_cast<const SolidColorContents*>(next.GetContents().get());
+  // The color is a uniform, so only fills of the same color can be merged.
+  if (!(next_contents->color_ == color_) || !geometry_ ||
+      !next_contents->geometry_) {
+    return nullptr;
+  }
+  if (!entity.GetTransformation().IsAffine() ||
+      !next.GetTransformation().IsAffine()) {
+    return nullptr;
+  }
+
+  std::vector<Point> vertices;
+  std::vector<uint16_t> indices;
+  if (!geometry_->AppendFillTriangles(renderer, entity.GetTransformation(),
+                                      vertices, indices)) {
+    return nullptr;
+  }
+  if (!next_contents->geometry_->AppendFillTriangles(
+          renderer, next.GetTransformation(), vertices, indices)) {
+    return nullptr;
+  }
+
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(std::make_shared<TrianglesGeometry>(
+      std::move(vertices), std::move(indices)));
+  contents->SetColor(color_);
+  return contents;
+}
+
 std::unique_ptr<SolidColorContents> SolidColorContents::Make(const Path& path,
                                                              Color color) {
   auto contents = std::make_unique<SolidColorContents>();
@@ -98,4 +225,8 @@ std::unique_ptr<SolidColorContents> SolidColorContents::Make(const Path& path,
   return contents;
 }
 
+bool SolidColorContents::NeedsExtendedRange(const Entity& entity) const {
+  return !color_.IsInStandardRange();
+}
+
 }  // namespace impeller
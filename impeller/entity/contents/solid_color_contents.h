@@ -47,6 +47,29 @@ class SolidColorContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool CoversArea(const Entity& entity, const Rect& rect) const override;
+
+  // |Contents|
+  bool IsAntialiasedWithoutMultisampling(const Entity& entity) const override;
+
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
+  // |Contents|
+  bool CanInheritOpacity(const Entity& entity) const override;
+
+  // |Contents|
+  void SetInheritedOpacity(Scalar opacity) override;
+
+  // |Contents|
+  std::optional<BatchKey> GetBatchKey() const override;
+
+  // |Contents|
+  std::shared_ptr<Contents> MergeWith(const ContentContext& renderer,
+                                      const Entity& entity,
+                                      const Entity& next) const override;
+
  private:
   std::shared_ptr<Geometry> geometry_;
 
@@ -4,6 +4,8 @@
 
 #include "sweep_gradient_contents.h"
 
+#include <algorithm>
+
 #include "flutter/fml/logging.h"
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
@@ -122,9 +124,7 @@ bool SweepGradientContents::RenderTexture(const ContentContext& renderer,
   using VS = SweepGradientFillPipeline::VertexShader;
   using FS = SweepGradientFillPipeline::FragmentShader;
 
-  auto gradient_data = CreateGradientBuffer(colors_, stops_);
-  auto gradient_texture =
-      CreateGradientTexture(gradient_data, renderer.GetContext());
+  auto gradient_texture = GetGradientTexture(renderer, colors_, stops_);
   if (gradient_texture == nullptr) {
     return false;
   }
@@ -180,4 +180,10 @@ bool SweepGradientContents::RenderTexture(const ContentContext& renderer,
   return true;
 }
 
+bool SweepGradientContents::NeedsExtendedRange(const Entity& entity) const {
+  return std::any_of(colors_.begin(), colors_.end(), [](const Color& color) {
+    return !color.IsInStandardRange();
+  });
+}
+
 }  // namespace impeller
@@ -7,6 +7,7 @@
 #include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
@@ -26,7 +27,7 @@ TextContents::TextContents() = default;
 TextContents::~TextContents() = default;
 
 void TextContents::SetTextFrame(const TextFrame& frame) {
-  frame_ = frame;
+  frames_ = {PositionedFrame{.frame = frame}};
 }
 
 void TextContents::SetGlyphAtlas(std::shared_ptr<LazyGlyphAtlas> atlas) {
@@ -54,12 +55,83 @@ void TextContents::SetInverseMatrix(Matrix matrix) {
   inverse_matrix_ = matrix;
 }
 
+void TextContents::SetUseSignedDistanceField(bool use_signed_distance_field) {
+  use_signed_distance_field_ = use_signed_distance_field;
+}
+
 std::optional<Rect> TextContents::GetCoverage(const Entity& entity) const {
-  auto bounds = frame_.GetBounds();
+  std::optional<Rect> bounds;
+  for (const auto& positioned : frames_) {
+    auto frame_bounds = positioned.frame.GetBounds();
+    if (!frame_bounds.has_value()) {
+      continue;
+    }
+    frame_bounds = frame_bounds->Shift(positioned.offset);
+    bounds = bounds.has_value() ? bounds->Union(frame_bounds.value())
+                                : frame_bounds;
+  }
   if (!bounds.has_value()) {
     return std::nullopt;
   }
-  return bounds->TransformBounds(entity.GetTransformation());
+  return bounds->TransformBounds(entity.GetTransformation() *
+                                 batch_transform_);
+}
+
+static const char kGlyphAtlasBatchTag = 0;
+static const char kGlyphAtlasSdfBatchTag = 0;
+
+std::optional<Contents::BatchKey> TextContents::GetBatchKey() const {
+  // The atlas texture isn't known until the atlas is resolved, so text of
+  // different lazy atlases shares a key but can't be merged.
+  return BatchKey{.pipeline = use_signed_distance_field_
+                                  ? &kGlyphAtlasSdfBatchTag
+                                  : &kGlyphAtlasBatchTag};
+}
+
+std::shared_ptr<Contents> TextContents::MergeWith(
+    const ContentContext& renderer,
+    const Entity& entity,
+    const Entity& next) const {
+  // The batch keys are equal, so the contents of `next` are text too.
+  auto next_contents =
+      static_cast<const TextContents*>(next.GetContents().get());
+  // The atlas and the color are bound once for all glyphs of a draw.
+  if (next_contents->lazy_atlas_ != lazy_atlas_ ||
+      !(next_contents->color_ == color_) ||
+      next_contents->use_signed_distance_field_ !=
+          use_signed_distance_field_ ||
+      !inverse_matrix_.IsIdentity() ||
+      !next_contents->inverse_matrix_.IsIdentity()) {
+    return nullptr;
+  }
+
+  // The glyphs are rasterized for the scale of the transformation, so only
+  // draws that differ by a translation can share the glyphs and the uniform
+  // transformation.
+  auto transform = entity.GetTransformation() * batch_transform_;
+  auto next_transform =
+      next.GetTransformation() * next_contents->batch_transform_;
+  if (!transform.IsAffine() || !next_transform.IsAffine() ||
+      !(transform.Basis() == next_transform.Basis()) ||
+      transform.GetDeterminant() == 0.0f) {
+    return nullptr;
+  }
+  auto next_offset = transform.Invert() * (next_transform * Point());
+
+  auto contents = std::make_shared<TextContents>();
+  contents->frames_ = frames_;
+  contents->frames_.reserve(frames_.size() + next_contents->frames_.size());
+  for (const auto& positioned : next_contents->frames_) {
+    contents->frames_.push_back(PositionedFrame{
+        .frame = positioned.frame,
+        .offset = next_offset + positioned.offset,
+    });
+  }
+  contents->batch_transform_ = transform;
+  contents->color_ = color_;
+  contents->use_signed_distance_field_ = use_signed_distance_field_;
+  contents->lazy_atlas_ = lazy_atlas_;
+  return contents;
 }
 
 static Vector4 PositionForGlyphPosition(const Matrix& translation,
@@ -68,28 +140,15 @@ static Vector4 PositionForGlyphPosition(const Matrix& translation,
   return translation * (unit_position * destination_size);
 }
 
-template <class TPipeline>
-static bool CommonRender(
+static std::shared_ptr<const Sampler> GetGlyphAtlasSampler(
     const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass,
-    const Color& color,
-    const TextFrame& frame,
-    const Matrix& inverse_matrix,
-    std::shared_ptr<GlyphAtlas>
-        atlas,  // NOLINT(performance-unnecessary-value-param)
-    Command& cmd) {
-  using VS = typename TPipeline::VertexShader;
-  using FS = typename TPipeline::FragmentShader;
-
-  // Common vertex uniforms for all glyphs.
-  typename VS::FrameInfo frame_info;
-  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation();
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
-
+    const Matrix& transform,
+    GlyphAtlas::Type type) {
   SamplerDescriptor sampler_desc;
-  if (entity.GetTransformation().IsTranslationScaleOnly()) {
+  // Distance fields and color glyphs are interpolated, since they are rarely
+  // drawn at the scale they were rasterized at.
+  if (transform.IsTranslationScaleOnly() &&
+      type == GlyphAtlas::Type::kAlphaBitmap) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -102,18 +161,72 @@ static bool CommonRender(
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
   sampler_desc.mip_filter = MipFilter::kNone;
+  return renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+}
+
+/// Finds all glyphs of the frames that the atlas holds in the atlas, in order,
+/// and counts the glyphs on each page of the atlas. The glyphs on each page
+/// are drawn with a separate command that samples from its texture.
+static bool FindGlyphLocations(
+    const std::vector<TextContents::PositionedFrame>& frames,
+    const GlyphAtlas& atlas,
+    std::vector<GlyphAtlas::GlyphLocation>& locations,
+    std::vector<size_t>& page_glyph_counts) {
+  size_t glyph_count = 0;
+  for (const auto& positioned : frames) {
+    for (const auto& run : positioned.frame.GetRuns()) {
+      glyph_count += run.GetGlyphPositions().size();
+    }
+  }
+  locations.reserve(glyph_count);
+  page_glyph_counts.assign(atlas.GetPageCount(), 0u);
+  for (const auto& positioned : frames) {
+    for (const auto& run : positioned.frame.GetRuns()) {
+      auto font = GlyphAtlas::GetAtlasFont(atlas.GetType(), run.GetFont());
+
+      for (const auto& glyph_position : run.GetGlyphPositions()) {
+        if (!GlyphAtlas::HoldsGlyph(atlas.GetType(), glyph_position.glyph)) {
+          continue;
+        }
+        FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
+        auto location = atlas.FindFontGlyphLocation(font_glyph_pair);
+        if (!location.has_value() ||
+            location->page >= page_glyph_counts.size()) {
+          VALIDATION_LOG << "Could not find glyph position in the atlas.";
+          return false;
+        }
+        page_glyph_counts[location->page]++;
+        locations.push_back(location.value());
+      }
+    }
+  }
+  return true;
+}
+
+template <class TPipeline>
+static bool CommonRender(
+    const ContentContext& renderer,
+    RenderPass& pass,
+    const Color& color,
+    const std::vector<TextContents::PositionedFrame>& frames,
+    const Matrix& transform,
+    const Matrix& inverse_matrix,
+    const GlyphAtlas& atlas,
+    Command& cmd) {
+  using VS = typename TPipeline::VertexShader;
+  using FS = typename TPipeline::FragmentShader;
+
+  // Common vertex uniforms for all glyphs.
+  typename VS::FrameInfo frame_info;
+  frame_info.mvp =
+      Matrix::MakeOrthographic(pass.GetRenderTargetSize()) * transform;
+  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
 
   typename FS::FragInfo frag_info;
   frag_info.text_color = ToVector(color.Premultiply());
   FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
 
-  // Common fragment uniforms for all glyphs.
-  FS::BindGlyphAtlasSampler(
-      cmd,                  // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  auto sampler = GetGlyphAtlasSampler(renderer, transform, atlas.GetType());
 
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
@@ -126,82 +239,254 @@ static bool CommonRender(
                                             Point{0, 1}, Point{1, 1}};
   const std::array<uint32_t, 6> indices = {0, 1, 2, 1, 2, 3};
 
-  VertexBufferBuilder<typename VS::PerVertexData> vertex_builder;
-
-  size_t count = 0;
-  for (const auto& run : frame.GetRuns()) {
-    count += run.GetGlyphPositions().size();
+  std::vector<GlyphAtlas::GlyphLocation> locations;
+  std::vector<size_t> page_glyph_counts;
+  if (!FindGlyphLocations(frames, atlas, locations, page_glyph_counts)) {
+    return false;
   }
 
-  vertex_builder.Reserve(count * 4);
-  vertex_builder.ReserveIndices(count * 6);
+  for (size_t page = 0; page < page_glyph_counts.size(); page++) {
+    const auto count = page_glyph_counts[page];
+    if (count == 0u) {
+      continue;
+    }
+    const auto& texture = atlas.GetTexture(page);
+
+    Command page_cmd = cmd;
+    // Common fragment uniforms for all glyphs on the page.
+    FS::BindGlyphAtlasSampler(page_cmd,  // command
+                              texture,   // texture
+                              sampler    // sampler
+    );
+
+    VertexBufferBuilder<typename VS::PerVertexData> vertex_builder;
+    vertex_builder.Reserve(count * 4);
+    vertex_builder.ReserveIndices(count * 6);
+
+    uint32_t offset = 0u;
+    for (auto i = 0u; i < count; i++) {
+      for (const auto& index : indices) {
+        vertex_builder.AppendIndex(index + offset);
+      }
+      offset += 4;
+    }
+
+    auto atlas_size = Point{static_cast<Scalar>(texture->GetSize().width),
+                            static_cast<Scalar>(texture->GetSize().height)};
+
+    size_t location_index = 0u;
+    for (const auto& positioned : frames) {
+      for (const auto& run : positioned.frame.GetRuns()) {
+        for (const auto& glyph_position : run.GetGlyphPositions()) {
+          if (!GlyphAtlas::HoldsGlyph(atlas.GetType(), glyph_position.glyph)) {
+            continue;
+          }
+          const auto& location = locations[location_index++];
+          if (location.page != page) {
+            continue;
+          }
+          const auto& atlas_glyph_pos = location.position;
+
+          auto offset_glyph_position = positioned.offset +
+                                       glyph_position.position +
+                                       glyph_position.glyph.bounds.origin;
+
+          auto uv_scaler_a = atlas_glyph_pos.size / atlas_size;
+          auto uv_scaler_b =
+              (Point::Round(atlas_glyph_pos.origin) / atlas_size);
+          auto translation =
+              Matrix::MakeTranslation(Vector3(offset_glyph_position.x,
+                                              offset_glyph_position.y, 0)) *
+              inverse_matrix;
+
+          for (const auto& point : unit_points) {
+            typename VS::PerVertexData vtx;
+            auto position = PositionForGlyphPosition(
+                translation, point, glyph_position.glyph.bounds.size);
+            vtx.uv = point * uv_scaler_a + uv_scaler_b;
+            vtx.position = position;
+
+            if constexpr (std::is_same_v<TPipeline, GlyphAtlasPipeline>) {
+              vtx.has_color =
+                  glyph_position.glyph.type == Glyph::Type::kBitmap ? 1.0
+                                                                    : 0.0;
+            }
+
+            vertex_builder.AppendVertex(std::move(vtx));
+          }
+        }
+      }
+    }
+    auto vertex_buffer =
+        vertex_builder.CreateVertexBuffer(pass.GetTransientsBuffer());
+    page_cmd.BindVertices(std::move(vertex_buffer));
 
-  uint32_t offset = 0u;
-  for (auto i = 0u; i < count; i++) {
-    for (const auto& index : indices) {
-      vertex_builder.AppendIndex(index + offset);
+    if (!pass.AddCommand(std::move(page_cmd))) {
+      return false;
     }
-    offset += 4;
   }
 
-  auto atlas_size =
-      Point{static_cast<Scalar>(atlas->GetTexture()->GetSize().width),
-            static_cast<Scalar>(atlas->GetTexture()->GetSize().height)};
+  return true;
+}
 
-  for (const auto& run : frame.GetRuns()) {
-    auto font = run.GetFont();
+// Instanced rendering
+// ---------------------------------------------------------
+
+// The data of one instance of the instanced glyph atlas pipelines. Matches
+// the `Glyph` struct of glyph_atlas_instanced.vert.
+struct GlyphInstanceData {
+  Vector4 position_and_size;
+  Vector4 atlas_rect;
+  Vector4 has_color;
+};
+
+static_assert(sizeof(GlyphInstanceData) == 48u);
+
+/// A quad from (0, 0) to (1, 1) that is drawn once for each glyph.
+static VertexBuffer CreateGlyphUnitQuad(HostBuffer& host_buffer) {
+  using VS = GlyphAtlasInstancedPipeline::VertexShader;
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.AddVertices({
+      {Point(0, 0)},
+      {Point(1, 0)},
+      {Point(0, 1)},
+      {Point(1, 1)},
+  });
+  for (auto index : {0, 1, 2, 1, 2, 3}) {
+    vertex_builder.AppendIndex(index);
+  }
+  return vertex_builder.CreateVertexBuffer(host_buffer);
+}
 
-    for (const auto& glyph_position : run.GetGlyphPositions()) {
-      FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
-      auto atlas_glyph_pos = atlas->FindFontGlyphPosition(font_glyph_pair);
-      if (!atlas_glyph_pos.has_value()) {
-        VALIDATION_LOG << "Could not find glyph position in the atlas.";
-        return false;
-      }
+/// Like `CommonRender`, but the quads of the glyphs are expanded by the
+/// vertex shader from one instance per glyph, rather than on the CPU. The
+/// inverse matrix must be a translation.
+template <class TPipeline>
+static bool CommonRenderInstanced(
+    const ContentContext& renderer,
+    RenderPass& pass,
+    const Color& color,
+    const std::vector<TextContents::PositionedFrame>& frames,
+    const Matrix& transform,
+    const Matrix& inverse_matrix,
+    const GlyphAtlas& atlas,
+    Command& cmd) {
+  using VS = typename TPipeline::VertexShader;
+  using FS = typename TPipeline::FragmentShader;
 
-      auto offset_glyph_position =
-          glyph_position.position + glyph_position.glyph.bounds.origin;
-
-      auto uv_scaler_a = atlas_glyph_pos->size / atlas_size;
-      auto uv_scaler_b = (Point::Round(atlas_glyph_pos->origin) / atlas_size);
-      auto translation =
-          Matrix::MakeTranslation(
-              Vector3(offset_glyph_position.x, offset_glyph_position.y, 0)) *
-          inverse_matrix;
-
-      for (const auto& point : unit_points) {
-        typename VS::PerVertexData vtx;
-        auto position = PositionForGlyphPosition(
-            translation, point, glyph_position.glyph.bounds.size);
-        vtx.uv = point * uv_scaler_a + uv_scaler_b;
-        vtx.position = position;
-
-        if constexpr (std::is_same_v<TPipeline, GlyphAtlasPipeline>) {
-          vtx.has_color =
-              glyph_position.glyph.type == Glyph::Type::kBitmap ? 1.0 : 0.0;
-        }
+  auto& host_buffer = pass.GetTransientsBuffer();
 
-        vertex_builder.AppendVertex(std::move(vtx));
+  typename FS::FragInfo frag_info;
+  frag_info.text_color = ToVector(color.Premultiply());
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  cmd.BindVertices(CreateGlyphUnitQuad(host_buffer));
+
+  auto sampler = GetGlyphAtlasSampler(renderer, transform, atlas.GetType());
+
+  std::vector<GlyphAtlas::GlyphLocation> locations;
+  std::vector<size_t> page_glyph_counts;
+  if (!FindGlyphLocations(frames, atlas, locations, page_glyph_counts)) {
+    return false;
+  }
+
+  std::vector<std::vector<GlyphInstanceData>> page_instances(
+      page_glyph_counts.size());
+  for (size_t page = 0; page < page_glyph_counts.size(); page++) {
+    page_instances[page].reserve(page_glyph_counts[page]);
+  }
+  size_t location_index = 0u;
+  for (const auto& positioned : frames) {
+    for (const auto& run : positioned.frame.GetRuns()) {
+      for (const auto& glyph_position : run.GetGlyphPositions()) {
+        if (!GlyphAtlas::HoldsGlyph(atlas.GetType(), glyph_position.glyph)) {
+          continue;
+        }
+        const auto& location = locations[location_index++];
+        auto origin = positioned.offset + glyph_position.position +
+                      glyph_position.glyph.bounds.origin;
+        const auto& size = glyph_position.glyph.bounds.size;
+        auto atlas_origin = Point::Round(location.position.origin);
+        page_instances[location.page].push_back(GlyphInstanceData{
+            .position_and_size =
+                Vector4(origin.x, origin.y, size.width, size.height),
+            .atlas_rect = Vector4(atlas_origin.x, atlas_origin.y,
+                                  location.position.size.width,
+                                  location.position.size.height),
+            .has_color = Vector4(
+                glyph_position.glyph.type == Glyph::Type::kBitmap ? 1.0 : 0.0,
+                0, 0, 0),
+        });
       }
     }
   }
-  auto vertex_buffer =
-      vertex_builder.CreateVertexBuffer(pass.GetTransientsBuffer());
-  cmd.BindVertices(std::move(vertex_buffer));
 
-  if (!pass.AddCommand(cmd)) {
-    return false;
+  const auto mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   transform * inverse_matrix;
+  for (size_t page = 0; page < page_instances.size(); page++) {
+    const auto& instances = page_instances[page];
+    if (instances.empty()) {
+      continue;
+    }
+    const auto& texture = atlas.GetTexture(page);
+
+    Command page_cmd = cmd;
+    typename VS::FrameInfo frame_info;
+    frame_info.mvp = mvp;
+    frame_info.atlas_size = Point(Size(texture->GetSize()));
+    VS::BindFrameInfo(page_cmd, host_buffer.EmplaceUniform(frame_info));
+    VS::BindGlyphData(
+        page_cmd,
+        host_buffer.Emplace(instances.data(),
+                            instances.size() * sizeof(GlyphInstanceData),
+                            DefaultUniformAlignment()));
+    FS::BindGlyphAtlasSampler(page_cmd, texture, sampler);
+    page_cmd.instance_count = instances.size();
+
+    if (!pass.AddCommand(std::move(page_cmd))) {
+      return false;
+    }
   }
-
   return true;
 }
 
+/// Whether any glyph of the frames is stored in atlases of the type.
+static bool HasGlyphsOfType(
+    const std::vector<TextContents::PositionedFrame>& frames,
+    GlyphAtlas::Type type) {
+  for (const auto& positioned : frames) {
+    if (type == GlyphAtlas::Type::kColorBitmap) {
+      if (positioned.frame.HasColor()) {
+        return true;
+      }
+      continue;
+    }
+    for (const auto& run : positioned.frame.GetRuns()) {
+      for (const auto& glyph_position : run.GetGlyphPositions()) {
+        if (GlyphAtlas::HoldsGlyph(type, glyph_position.glyph)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/// Whether the quads of the glyphs can be expanded by the instanced vertex
+/// shader, which places the quads with a translation.
+static bool CanRenderInstanced(const ContentContext& renderer,
+                               const Matrix& inverse_matrix) {
+  return renderer.SupportsInstancedAtlas() &&
+         inverse_matrix.Basis().IsIdentity();
+}
+
 bool TextContents::RenderSdf(const ContentContext& renderer,
                              const Entity& entity,
                              RenderPass& pass) const {
   auto atlas =
       ResolveAtlas(GlyphAtlas::Type::kSignedDistanceField,
-                   renderer.GetGlyphAtlasContext(), renderer.GetContext());
+                   renderer.GetGlyphAtlasContext(
+                       GlyphAtlas::Type::kSignedDistanceField),
+                   renderer.GetContext());
 
   if (!atlas || !atlas->IsValid()) {
     VALIDATION_LOG << "Cannot render glyphs without prepared atlas.";
@@ -213,11 +498,19 @@ bool TextContents::RenderSdf(const ContentContext& renderer,
   cmd.label = "TextFrameSDF";
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
   cmd.stencil_reference = entity.GetStencilDepth();
 
-  return CommonRender<GlyphAtlasSdfPipeline>(
-      renderer, entity, pass, color_, frame_, inverse_matrix_, atlas, cmd);
+  auto transform = entity.GetTransformation() * batch_transform_;
+  if (CanRenderInstanced(renderer, inverse_matrix_)) {
+    cmd.pipeline = renderer.GetGlyphAtlasSdfInstancedPipeline(opts);
+    return CommonRenderInstanced<GlyphAtlasSdfInstancedPipeline>(
+        renderer, pass, color_, frames_, transform, inverse_matrix_, *atlas,
+        cmd);
+  }
+  cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+  return CommonRender<GlyphAtlasSdfPipeline>(renderer, pass, color_, frames_,
+                                             transform, inverse_matrix_,
+                                             *atlas, cmd);
 }
 
 bool TextContents::Render(const ContentContext& renderer,
@@ -227,32 +520,55 @@ bool TextContents::Render(const ContentContext& renderer,
     return true;
   }
 
-  // This TextContents may be for a frame that doesn't have color, but the
-  // lazy atlas for this scene already does have color.
-  // Benchmarks currently show that creating two atlases per pass regresses
-  // render time. This should get re-evaluated if we start caching atlases
-  // between frames or get significantly faster at creating atlases, because
-  // we're potentially trading memory for time here.
-  auto atlas =
-      ResolveAtlas(lazy_atlas_->HasColor() ? GlyphAtlas::Type::kColorBitmap
-                                           : GlyphAtlas::Type::kAlphaBitmap,
-                   renderer.GetGlyphAtlasContext(), renderer.GetContext());
-
-  if (!atlas || !atlas->IsValid()) {
-    VALIDATION_LOG << "Cannot render glyphs without prepared atlas.";
-    return false;
+  if (use_signed_distance_field_) {
+    return RenderSdf(renderer, entity, pass);
   }
 
-  // Information shared by all glyph draw calls.
-  Command cmd;
-  cmd.label = "TextFrame";
-  auto opts = OptionsFromPassAndEntity(pass, entity);
-  opts.primitive_type = PrimitiveType::kTriangle;
-  cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  cmd.stencil_reference = entity.GetStencilDepth();
+  // Color glyphs are drawn from their own atlas, so that the atlas of the
+  // other glyphs doesn't need to store colors.
+  for (auto type :
+       {GlyphAtlas::Type::kAlphaBitmap, GlyphAtlas::Type::kColorBitmap}) {
+    if (!HasGlyphsOfType(frames_, type)) {
+      continue;
+    }
+    auto atlas = ResolveAtlas(type, renderer.GetGlyphAtlasContext(type),
+                              renderer.GetContext());
+
+    if (!atlas || !atlas->IsValid()) {
+      VALIDATION_LOG << "Cannot render glyphs without prepared atlas.";
+      return false;
+    }
+
+    // Information shared by all glyph draw calls.
+    Command cmd;
+    cmd.label = "TextFrame";
+    auto opts = OptionsFromPassAndEntity(pass, entity);
+    opts.primitive_type = PrimitiveType::kTriangle;
+    cmd.stencil_reference = entity.GetStencilDepth();
+
+    auto transform = entity.GetTransformation() * batch_transform_;
+    bool result = false;
+    if (CanRenderInstanced(renderer, inverse_matrix_)) {
+      cmd.pipeline = renderer.GetGlyphAtlasInstancedPipeline(opts);
+      result = CommonRenderInstanced<GlyphAtlasInstancedPipeline>(
+          renderer, pass, color_, frames_, transform, inverse_matrix_, *atlas,
+          cmd);
+    } else {
+      cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+      result = CommonRender<GlyphAtlasPipeline>(renderer, pass, color_,
+                                                frames_, transform,
+                                                inverse_matrix_, *atlas, cmd);
+    }
+    if (!result) {
+      return false;
+    }
+  }
+  return true;
+}
 
-  return CommonRender<GlyphAtlasPipeline>(renderer, entity, pass, color_,
-                                          frame_, inverse_matrix_, atlas, cmd);
+bool TextContents::NeedsExtendedRange(const Entity& entity) const {
+  // The glyph atlases are 8-bit.
+  return !color_.IsInStandardRange();
 }
 
 }  // namespace impeller
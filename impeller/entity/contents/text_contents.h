@@ -22,6 +22,13 @@ class Context;
 
 class TextContents final : public Contents {
  public:
+  /// A text frame and its offset from the origin of the contents. Merged
+  /// text draws have one for each draw.
+  struct PositionedFrame {
+    TextFrame frame;
+    Point offset;
+  };
+
   TextContents();
 
   ~TextContents();
@@ -34,6 +41,17 @@ class TextContents final : public Contents {
 
   void SetInverseMatrix(Matrix matrix);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Draw the glyphs from a signed-distance field atlas instead of
+  ///             a bitmap atlas. Distance fields stay sharp across a range of
+  ///             scales, so they suit large, rotated or animated text, but
+  ///             can't represent glyphs with color.
+  ///
+  ///             The frame must have been added to the lazy glyph atlas as a
+  ///             signed-distance field frame.
+  ///
+  void SetUseSignedDistanceField(bool use_signed_distance_field);
+
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
@@ -42,14 +60,25 @@ class TextContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
-  // TODO(dnfield): remove this https://github.com/flutter/flutter/issues/111640
-  bool RenderSdf(const ContentContext& renderer,
-                 const Entity& entity,
-                 RenderPass& pass) const;
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
+  // |Contents|
+  std::optional<BatchKey> GetBatchKey() const override;
+
+  // |Contents|
+  std::shared_ptr<Contents> MergeWith(const ContentContext& renderer,
+                                      const Entity& entity,
+                                      const Entity& next) const override;
 
  private:
-  TextFrame frame_;
+  std::vector<PositionedFrame> frames_;
+  /// Applied before the transformation of the entity. Merged text draws are
+  /// rendered with an identity transformation, so this is the transformation
+  /// of the first draw.
+  Matrix batch_transform_;
   Color color_;
+  bool use_signed_distance_field_ = false;
   mutable std::shared_ptr<LazyGlyphAtlas> lazy_atlas_;
   Matrix inverse_matrix_;
 
@@ -58,6 +87,10 @@ class TextContents final : public Contents {
       std::shared_ptr<GlyphAtlasContext> atlas_context,
       std::shared_ptr<Context> context) const;
 
+  bool RenderSdf(const ContentContext& renderer,
+                 const Entity& entity,
+                 RenderPass& pass) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TextContents);
 };
 
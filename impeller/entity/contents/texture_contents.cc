@@ -4,14 +4,17 @@
 
 #include "texture_contents.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <utility>
 
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/contents/filters/yuv_to_rgb_filter_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/texture_fill.frag.h"
 #include "impeller/entity/texture_fill.vert.h"
+#include "impeller/entity/yuv_texture_fill.frag.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/path_builder.h"
 #include "impeller/renderer/formats.h"
@@ -21,6 +24,22 @@
 
 namespace impeller {
 
+/// Textures drawn at less than this fraction of the size of their source rect
+/// are sampled with a mip filter if they have mip levels.
+static constexpr Scalar kMipmapDownscaleThreshold = 0.5f;
+
+/// How much the source rect of a texture is scaled by when it is drawn into
+/// `destination` with `transform`, in the least scaled direction.
+static Scalar GetSourceRectScale(const Matrix& transform,
+                                 const Rect& destination,
+                                 const Rect& source_rect) {
+  if (source_rect.IsEmpty()) {
+    return 1.0f;
+  }
+  auto scale = destination.size / source_rect.size;
+  return transform.GetMaxBasisLength() * std::max(scale.width, scale.height);
+}
+
 TextureContents::TextureContents() = default;
 
 TextureContents::~TextureContents() = default;
@@ -49,6 +68,12 @@ std::shared_ptr<Texture> TextureContents::GetTexture() const {
   return texture_;
 }
 
+void TextureContents::SetYUVTexture(std::shared_ptr<Texture> uv_texture,
+                                    YUVColorSpace yuv_color_space) {
+  uv_texture_ = std::move(uv_texture);
+  yuv_color_space_ = yuv_color_space;
+}
+
 void TextureContents::SetOpacity(Scalar opacity) {
   opacity_ = opacity;
 }
@@ -64,9 +89,28 @@ std::optional<Rect> TextureContents::GetCoverage(const Entity& entity) const {
   return path_.GetTransformedBoundingBox(entity.GetTransformation());
 };
 
+std::optional<Contents::BatchKey> TextureContents::GetBatchKey() const {
+  if (uv_texture_) {
+    // The key can't tell the chroma planes apart.
+    return std::nullopt;
+  }
+  static const char kTextureFillBatchTag = 0;
+  return BatchKey{.pipeline = &kTextureFillBatchTag, .texture = texture_.get()};
+}
+
+bool TextureContents::CanInheritOpacity(const Entity& entity) const {
+  // The path is filled with triangles that never overlap.
+  return true;
+}
+
+void TextureContents::SetInheritedOpacity(Scalar opacity) {
+  opacity_ *= opacity;
+}
+
 std::optional<Snapshot> TextureContents::RenderToSnapshot(
     const ContentContext& renderer,
     const Entity& entity,
+    std::optional<Rect> coverage_limit,
     const std::optional<SamplerDescriptor>& sampler_descriptor,
     bool msaa_enabled) const {
   auto bounds = path_.GetBoundingBox();
@@ -75,8 +119,9 @@ std::optional<Snapshot> TextureContents::RenderToSnapshot(
   }
 
   // Passthrough textures that have simple rectangle paths and complete source
-  // rects.
-  if (is_rect_ && source_rect_ == Rect::MakeSize(texture_->GetSize()) &&
+  // rects. YUV textures are converted by rendering them.
+  if (!uv_texture_ && is_rect_ &&
+      source_rect_ == Rect::MakeSize(texture_->GetSize()) &&
       (opacity_ >= 1 - kEhCloseEnough || defer_applying_opacity_)) {
     auto scale = Vector2(bounds->size / Size(texture_->GetSize()));
     return Snapshot{
@@ -84,11 +129,15 @@ std::optional<Snapshot> TextureContents::RenderToSnapshot(
         .transform = entity.GetTransformation() *
                      Matrix::MakeTranslation(bounds->origin) *
                      Matrix::MakeScale(scale),
-        .sampler_descriptor = sampler_descriptor.value_or(sampler_descriptor_),
+        .sampler_descriptor = GetSamplerDescriptorForScale(
+            renderer, sampler_descriptor.value_or(sampler_descriptor_),
+            GetSourceRectScale(entity.GetTransformation(), bounds.value(),
+                               source_rect_)),
         .opacity = opacity_};
   }
   return Contents::RenderToSnapshot(
-      renderer, entity, sampler_descriptor.value_or(sampler_descriptor_));
+      renderer, entity, coverage_limit,
+      sampler_descriptor.value_or(sampler_descriptor_));
 }
 
 bool TextureContents::Render(const ContentContext& renderer,
@@ -164,11 +213,8 @@ bool TextureContents::Render(const ContentContext& renderer,
                    entity.GetTransformation();
   frame_info.texture_sampler_y_coord_scale = texture_->GetYCoordScale();
 
-  FS::FragInfo frag_info;
-  frag_info.alpha = opacity_;
-
   Command cmd;
-  cmd.label = "Texture Fill";
+  cmd.label = uv_texture_ ? "YUV Texture Fill" : "Texture Fill";
   if (!label_.empty()) {
     cmd.label += ": " + label_;
   }
@@ -177,14 +223,36 @@ bool TextureContents::Render(const ContentContext& renderer,
   if (!stencil_enabled_) {
     pipeline_options.stencil_compare = CompareFunction::kAlways;
   }
-  cmd.pipeline = renderer.GetTexturePipeline(pipeline_options);
   cmd.stencil_reference = entity.GetStencilDepth();
   cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
-  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
-  FS::BindTextureSampler(cmd, texture_,
-                         renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-                             sampler_descriptor_));
+
+  auto sampler = renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+      GetSamplerDescriptorForScale(
+          renderer, sampler_descriptor_,
+          GetSourceRectScale(entity.GetTransformation(), coverage_rect.value(),
+                             source_rect_)));
+  if (uv_texture_) {
+    using YUVFS = YuvTextureFillFragmentShader;
+
+    YUVFS::FragInfo frag_info;
+    frag_info.matrix =
+        YUVToRGBFilterContents::GetYUVToRGBMatrix(yuv_color_space_);
+    frag_info.yuv_color_space = static_cast<Scalar>(yuv_color_space_);
+    frag_info.alpha = opacity_;
+
+    cmd.pipeline = renderer.GetYUVTexturePipeline(pipeline_options);
+    YUVFS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    YUVFS::BindYTexture(cmd, texture_, sampler);
+    YUVFS::BindUvTexture(cmd, uv_texture_, sampler);
+  } else {
+    FS::FragInfo frag_info;
+    frag_info.alpha = opacity_;
+
+    cmd.pipeline = renderer.GetTexturePipeline(pipeline_options);
+    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    FS::BindTextureSampler(cmd, texture_, sampler);
+  }
   pass.AddCommand(std::move(cmd));
 
   return true;
@@ -206,8 +274,41 @@ const SamplerDescriptor& TextureContents::GetSamplerDescriptor() const {
   return sampler_descriptor_;
 }
 
+SamplerDescriptor TextureContents::GetSamplerDescriptorForScale(
+    const ContentContext& renderer,
+    SamplerDescriptor descriptor,
+    Scalar scale) const {
+  if (uv_texture_ || texture_->GetMipCount() <= 1u) {
+    return descriptor;
+  }
+  // Sampling a downscaled texture from its mip levels aliases less and reads
+  // less memory. Textures that are sampled without filtering are left alone.
+  if (descriptor.mip_filter == MipFilter::kNone &&
+      descriptor.min_filter == MinMagFilter::kLinear &&
+      scale < kMipmapDownscaleThreshold) {
+    descriptor.mip_filter = MipFilter::kLinear;
+    descriptor.label = "Mipmap Linear Sampler";
+  }
+  if (descriptor.mip_filter != MipFilter::kNone &&
+      !renderer.GenerateMipmapsIfNeeded(texture_)) {
+    descriptor.mip_filter = MipFilter::kNone;
+  }
+  return descriptor;
+}
+
 void TextureContents::SetDeferApplyingOpacity(bool defer_applying_opacity) {
   defer_applying_opacity_ = defer_applying_opacity;
 }
 
+bool TextureContents::NeedsExtendedRange(const Entity& entity) const {
+  if (!texture_) {
+    return false;
+  }
+  if (uv_texture_) {
+    // The conversion from YUV may produce colors out of range.
+    return true;
+  }
+  return IsExtendedRangeFormat(texture_->GetTextureDescriptor().format);
+}
+
 }  // namespace impeller
@@ -10,6 +10,7 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/entity/contents/contents.h"
+#include "impeller/geometry/color.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/sampler_descriptor.h"
 
@@ -36,6 +37,18 @@ class TextureContents final : public Contents {
 
   std::shared_ptr<Texture> GetTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Samples the texture as the luma plane of a YUV image whose
+  ///             chroma plane is |uv_texture|, converting the planes to RGB
+  ///             as they are drawn rather than in a separate pass.
+  ///
+  /// @param[in]  uv_texture       The chroma plane, or null to sample the
+  ///                              texture as RGB.
+  /// @param[in]  yuv_color_space  The color space of the planes.
+  ///
+  void SetYUVTexture(std::shared_ptr<Texture> uv_texture,
+                     YUVColorSpace yuv_color_space);
+
   void SetSamplerDescriptor(SamplerDescriptor desc);
 
   const SamplerDescriptor& GetSamplerDescriptor() const;
@@ -51,10 +64,20 @@ class TextureContents final : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  std::optional<BatchKey> GetBatchKey() const override;
+
+  // |Contents|
+  bool CanInheritOpacity(const Entity& entity) const override;
+
+  // |Contents|
+  void SetInheritedOpacity(Scalar opacity) override;
+
   // |Contents|
   std::optional<Snapshot> RenderToSnapshot(
       const ContentContext& renderer,
       const Entity& entity,
+      std::optional<Rect> coverage_limit = std::nullopt,
       const std::optional<SamplerDescriptor>& sampler_descriptor = std::nullopt,
       bool msaa_enabled = true) const override;
 
@@ -63,6 +86,9 @@ class TextureContents final : public Contents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
   void SetDeferApplyingOpacity(bool defer_applying_opacity);
 
  private:
@@ -73,11 +99,22 @@ class TextureContents final : public Contents {
   bool stencil_enabled_ = true;
 
   std::shared_ptr<Texture> texture_;
+  std::shared_ptr<Texture> uv_texture_;
+  YUVColorSpace yuv_color_space_ = YUVColorSpace::kBT601LimitedRange;
   SamplerDescriptor sampler_descriptor_ = {};
   Rect source_rect_;
   Scalar opacity_ = 1.0f;
   bool defer_applying_opacity_ = false;
 
+  /// @brief  The sampler to draw the texture with when it is scaled by
+  ///         `scale` from its source rect to device pixels. Textures drawn
+  ///         at a fraction of their size are sampled from their mip levels,
+  ///         which are generated the first time they are needed.
+  SamplerDescriptor GetSamplerDescriptorForScale(
+      const ContentContext& renderer,
+      SamplerDescriptor descriptor,
+      Scalar scale) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(TextureContents);
 };
 
@@ -9,7 +9,9 @@
 #include "impeller/entity/geometry.h"
 #include "impeller/entity/tiled_texture_fill.frag.h"
 #include "impeller/entity/tiled_texture_fill.vert.h"
+#include "impeller/entity/tiled_texture_fill_no_decal.frag.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/formats.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/sampler_library.h"
 
@@ -67,6 +69,11 @@ TiledTextureContents::CreateFilterTexture(
   return std::nullopt;
 }
 
+bool TiledTextureContents::UsesDecal() const {
+  return x_tile_mode_ == Entity::TileMode::kDecal ||
+         y_tile_mode_ == Entity::TileMode::kDecal;
+}
+
 SamplerDescriptor TiledTextureContents::CreateDescriptor() const {
   SamplerDescriptor descriptor = sampler_descriptor_;
   auto width_mode = TileModeToAddressMode(x_tile_mode_);
@@ -86,6 +93,9 @@ bool TiledTextureContents::Render(const ContentContext& renderer,
   if (texture_ == nullptr) {
     return true;
   }
+  if (sampler_descriptor_.mip_filter != MipFilter::kNone) {
+    renderer.GenerateMipmapsIfNeeded(texture_);
+  }
   // TODO(jonahwilliams): this is a special case for VerticesGeometry which
   // implements GetPositionUVBuffer. The general geometry case does not use
   // this method (see note below).
@@ -135,7 +145,9 @@ bool TiledTextureContents::Render(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetTiledTexturePipeline(options);
+  cmd.pipeline = UsesDecal()
+                     ? renderer.GetTiledTexturePipeline(options)
+                     : renderer.GetTiledTextureNoDecalPipeline(options);
 
   cmd.BindVertices(geometry_result.vertex_buffer);
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
@@ -204,7 +216,8 @@ bool TiledTextureContents::RenderVertices(const ContentContext& renderer,
     options.stencil_operation = StencilOperation::kIncrementClamp;
   }
   options.primitive_type = geometry_result.type;
-  cmd.pipeline = renderer.GetPositionUVPipeline(options);
+  cmd.pipeline = UsesDecal() ? renderer.GetPositionUVPipeline(options)
+                             : renderer.GetPositionUVNoDecalPipeline(options);
 
   cmd.BindVertices(geometry_result.vertex_buffer);
   VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
@@ -238,4 +251,10 @@ bool TiledTextureContents::RenderVertices(const ContentContext& renderer,
   return true;
 }
 
+bool TiledTextureContents::NeedsExtendedRange(const Entity& entity) const {
+  // Color filters may map the colors of the texture out of range.
+  return color_filter_.has_value() || !texture_ ||
+         IsExtendedRangeFormat(texture_->GetTextureDescriptor().format);
+}
+
 }  // namespace impeller
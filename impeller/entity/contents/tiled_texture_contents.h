@@ -31,6 +31,9 @@ class TiledTextureContents final : public ColorSourceContents {
               const Entity& entity,
               RenderPass& pass) const override;
 
+  // |Contents|
+  bool NeedsExtendedRange(const Entity& entity) const override;
+
   void SetTexture(std::shared_ptr<Texture> texture);
 
   void SetTileModes(Entity::TileMode x_tile_mode, Entity::TileMode y_tile_mode);
@@ -59,6 +62,10 @@ class TiledTextureContents final : public ColorSourceContents {
 
   SamplerDescriptor CreateDescriptor() const;
 
+  // Whether either tile mode is decal, which the shader has to emulate. The
+  // sampler applies the other tile modes by itself.
+  bool UsesDecal() const;
+
   std::shared_ptr<Texture> texture_;
   SamplerDescriptor sampler_descriptor_ = {};
   Entity::TileMode x_tile_mode_ = Entity::TileMode::kClamp;
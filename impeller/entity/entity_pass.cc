@@ -4,6 +4,8 @@
 
 #include "impeller/entity/entity_pass.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <utility>
 #include <variant>
@@ -17,6 +19,7 @@
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
@@ -144,7 +147,10 @@ EntityPass* EntityPass::AddSubpass(std::unique_ptr<EntityPass> pass) {
 
 static RenderTarget CreateRenderTarget(ContentContext& renderer,
                                        ISize size,
-                                       bool readable) {
+                                       bool readable,
+                                       bool multisampled,
+                                       std::optional<PixelFormat> color_format =
+                                           std::nullopt) {
   auto context = renderer.GetContext();
 
   /// All of the load/store actions are managed by `InlinePassContext` when
@@ -152,11 +158,13 @@ static RenderTarget CreateRenderTarget(ContentContext& renderer,
   /// What's important is the `StorageMode` of the textures, which cannot be
   /// changed for the lifetime of the textures.
 
-  if (context->GetDeviceCapabilities().SupportsOffscreenMSAA()) {
+  if (multisampled &&
+      context->GetDeviceCapabilities().SupportsOffscreenMSAA()) {
     return RenderTarget::CreateOffscreenMSAA(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfigMSAA{
             .storage_mode = StorageMode::kDeviceTransient,
             .resolve_storage_mode = StorageMode::kDevicePrivate,
@@ -168,14 +176,16 @@ static RenderTarget CreateRenderTarget(ContentContext& renderer,
                                      : StorageMode::kDeviceTransient,
             .load_action = LoadAction::kDontCare,
             .store_action = StoreAction::kDontCare,
-        }  // stencil_attachment_config
+        },            // stencil_attachment_config
+        color_format  // color_format
     );
   }
 
   return RenderTarget::CreateOffscreen(
-      *context,      // context
-      size,          // size
-      "EntityPass",  // label
+      *context,                          // context
+      *renderer.GetRenderTargetCache(),  // allocator
+      size,                              // size
+      "EntityPass",                      // label
       RenderTarget::AttachmentConfig{
           .storage_mode = StorageMode::kDevicePrivate,
           .load_action = LoadAction::kDontCare,
@@ -186,10 +196,55 @@ static RenderTarget CreateRenderTarget(ContentContext& renderer,
                                    : StorageMode::kDeviceTransient,
           .load_action = LoadAction::kDontCare,
           .store_action = StoreAction::kDontCare,
-      }  // stencil_attachment_config
+      },            // stencil_attachment_config
+      color_format  // color_format
   );
 }
 
+bool EntityPass::IsAntialiasedWithoutMultisampling() const {
+  // The backdrop of the pass is rendered into it as a texture.
+  if (backdrop_filter_proc_.has_value()) {
+    return false;
+  }
+  for (const auto& element : elements_) {
+    // Subpasses are conservatively assumed to rely on multisampling, as are
+    // advanced blends which render the contents of the entity elsewhere.
+    const auto entity = std::get_if<Entity>(&element);
+    if (!entity || !entity->GetContents() ||
+        entity->GetBlendMode() > Entity::kLastPipelineBlendMode ||
+        !entity->GetContents()->IsAntialiasedWithoutMultisampling(*entity)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EntityPass::NeedsExtendedRange() const {
+  // The backdrop of the pass is rendered into it as a texture.
+  if (backdrop_filter_proc_.has_value()) {
+    return true;
+  }
+  for (const auto& element : elements_) {
+    if (const auto subpass =
+            std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      if ((*subpass)->blend_mode_ == BlendMode::kPlus ||
+          (*subpass)->delegate_->NeedsExtendedRange() ||
+          (*subpass)->NeedsExtendedRange()) {
+        return true;
+      }
+      continue;
+    }
+    // Additive and advanced blends may exceed the range of their inputs.
+    const auto& entity = std::get<Entity>(element);
+    if (!entity.GetContents() || entity.GetBlendMode() == BlendMode::kPlus ||
+        entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+        entity.GetContents()->NeedsExtendedRange(entity)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 uint32_t EntityPass::ComputeTotalReads(ContentContext& renderer) const {
   return renderer.GetDeviceCapabilities().SupportsFramebufferFetch()
              ? filter_reads_from_pass_texture_
@@ -197,12 +252,24 @@ uint32_t EntityPass::ComputeTotalReads(ContentContext& renderer) const {
 }
 
 bool EntityPass::Render(ContentContext& renderer,
-                        const RenderTarget& render_target) const {
+                        const RenderTarget& render_target,
+                        Point origin) const {
+  if (renderer.IsOverdrawHeatmapEnabled()) {
+    return RenderOverdrawHeatmap(renderer, render_target, origin);
+  }
+
+  // Coverage is limited to the root pass, which must contain the region that
+  // is rendered.
+  const auto target_size = render_target.GetRenderTargetSize();
+  const auto root_pass_size =
+      ISize::Ceil(Size(origin.x, origin.y) + Size(target_size));
+
   if (ComputeTotalReads(renderer) > 0) {
     auto offscreen_target =
-        CreateRenderTarget(renderer, render_target.GetRenderTargetSize(), true);
-    if (!OnRender(renderer, offscreen_target.GetRenderTargetSize(),
-                  offscreen_target, Point(), Point(), 0)) {
+        CreateRenderTarget(renderer, target_size,
+                           /*readable=*/true, /*multisampled=*/true);
+    if (!OnRender(renderer, root_pass_size, offscreen_target, origin, origin,
+                  0)) {
       return false;
     }
 
@@ -249,8 +316,92 @@ bool EntityPass::Render(ContentContext& renderer,
     return true;
   }
 
-  return OnRender(renderer, render_target.GetRenderTargetSize(), render_target,
-                  Point(), Point(), 0);
+  return OnRender(renderer, root_pass_size, render_target, origin, origin, 0);
+}
+
+void EntityPass::CollectOverdrawCoverage(std::optional<Rect> coverage_crop,
+                                         OverdrawCoverage& coverage) const {
+  for (const auto& element : elements_) {
+    if (auto entity = std::get_if<Entity>(&element)) {
+      // Clips only draw to the stencil buffer.
+      const auto* contents = entity->GetContents().get();
+      if (dynamic_cast<const ClipContents*>(contents) ||
+          dynamic_cast<const ClipRestoreContents*>(contents)) {
+        continue;
+      }
+      auto entity_coverage = entity->GetCoverage();
+      if (entity_coverage.has_value() && coverage_crop.has_value()) {
+        entity_coverage = entity_coverage->Intersection(coverage_crop.value());
+      }
+      if (entity_coverage.has_value() && !entity_coverage->IsEmpty()) {
+        coverage.entities.push_back(entity_coverage.value());
+      }
+    } else if (auto subpass_ptr =
+                   std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      auto subpass = subpass_ptr->get();
+      if (subpass->delegate_->CanElide()) {
+        continue;
+      }
+      auto subpass_coverage = GetSubpassCoverage(*subpass, coverage_crop);
+      if (!subpass_coverage.has_value() || subpass_coverage->IsEmpty()) {
+        continue;
+      }
+      // Collapsed subpasses are rendered directly into this pass.
+      if (subpass->backdrop_filter_proc_.has_value() ||
+          !subpass->delegate_->CanCollapseIntoParentPass(subpass)) {
+        coverage.subpasses.push_back(subpass_coverage.value());
+      }
+      subpass->CollectOverdrawCoverage(subpass_coverage, coverage);
+    }
+  }
+}
+
+bool EntityPass::RenderOverdrawHeatmap(ContentContext& renderer,
+                                       const RenderTarget& render_target,
+                                       Point origin) const {
+  auto target_size = render_target.GetRenderTargetSize();
+  auto target_rect = Rect(origin, Size(target_size));
+  OverdrawCoverage coverage;
+  CollectOverdrawCoverage(target_rect, coverage);
+
+  // Additively blending a translucent color for each draw makes the pixels
+  // that are drawn more often brighter.
+  EntityPass heatmap;
+  auto add_rects = [&heatmap](const std::vector<Rect>& rects, Color color) {
+    for (const auto& rect : rects) {
+      Entity entity;
+      entity.SetContents(SolidColorContents::Make(
+          PathBuilder{}.AddRect(rect).TakePath(), color));
+      entity.SetBlendMode(BlendMode::kPlus);
+      heatmap.AddEntity(entity);
+    }
+  };
+  add_rects(coverage.entities, Color(0.125, 0, 0, 0.125));
+  add_rects(coverage.subpasses, Color(0, 0, 0.25, 0.25));
+
+  OverdrawSummary summary;
+  Scalar entities_area = 0;
+  for (const auto& rect : coverage.entities) {
+    entities_area += rect.size.Area();
+  }
+  if (!target_rect.IsEmpty()) {
+    summary.average_overdraw = entities_area / target_rect.size.Area();
+  }
+  summary.subpass_count = coverage.subpasses.size();
+  for (const auto& rect : coverage.subpasses) {
+    summary.offscreen_pixel_count += static_cast<size_t>(rect.size.Area());
+  }
+  renderer.SetOverdrawSummary(summary);
+  FML_TRACE_COUNTER("impeller", "EntityPass::Overdraw",
+                    reinterpret_cast<int64_t>(this), "AverageOverdrawPercent",
+                    static_cast<int64_t>(summary.average_overdraw * 100),
+                    "Subpasses", static_cast<int64_t>(summary.subpass_count),
+                    "OffscreenPixels",
+                    static_cast<int64_t>(summary.offscreen_pixel_count));
+
+  return heatmap.OnRender(
+      renderer, ISize::Ceil(Size(origin.x, origin.y) + Size(target_size)),
+      render_target, origin, origin, 0);
 }
 
 EntityPass::EntityResult EntityPass::GetEntityForElement(
@@ -260,7 +411,10 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     ISize root_pass_size,
     Point position,
     uint32_t pass_depth,
-    size_t stencil_depth_floor) const {
+    size_t stencil_depth_floor,
+    std::optional<Rect> clip_coverage,
+    BackdropFilterCache* backdrop_cache,
+    size_t elided_clip_count) const {
   Entity element_entity;
 
   //--------------------------------------------------------------------------
@@ -292,12 +446,22 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
     }
 
     if (!subpass->backdrop_filter_proc_.has_value() &&
-        subpass->delegate_->CanCollapseIntoParentPass()) {
-      // Directly render into the parent target and move on.
-      if (!subpass->OnRender(renderer, root_pass_size,
-                             pass_context.GetRenderTarget(), position, position,
-                             pass_depth, stencil_depth_, nullptr,
-                             pass_context.GetRenderPass(pass_depth))) {
+        subpass->delegate_->CanCollapseIntoParentPass(subpass)) {
+      // The elements of the subpass aren't tracked when they are rendered
+      // into the parent target, so any filtered backdrop may be stale after.
+      if (backdrop_cache) {
+        backdrop_cache->contents = nullptr;
+      }
+      // Directly render into the parent target and move on. The subpass
+      // continues from the clips of this pass, which it shares the stencil
+      // with.
+      if (!subpass->OnRender(
+              renderer, root_pass_size, pass_context.GetRenderTarget(),
+              position, position, pass_depth, stencil_depth_, nullptr,
+              pass_context.GetRenderPass(pass_depth),
+              StencilLayer{.coverage = clip_coverage,
+                           .stencil_depth = stencil_depth_,
+                           .elided_clip_count = elided_clip_count})) {
         return EntityPass::EntityResult::Failure();
       }
       return EntityPass::EntityResult::Skip();
@@ -305,17 +469,10 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
 
     std::shared_ptr<Contents> backdrop_filter_contents = nullptr;
     if (subpass->backdrop_filter_proc_.has_value()) {
-      auto texture = pass_context.GetTexture();
       // Render the backdrop texture before any of the pass elements.
-      const auto& proc = subpass->backdrop_filter_proc_.value();
       backdrop_filter_contents =
-          proc(FilterInput::Make(std::move(texture)), subpass->xformation_,
-               /*is_subpass*/ true);
-
-      // The subpass will need to read from the current pass texture when
-      // rendering the backdrop, so if there's an active pass, end it prior to
-      // rendering the subpass.
-      pass_context.EndPass();
+          GetBackdropFilterContents(*subpass, element, renderer, pass_context,
+                                    clip_coverage, backdrop_cache);
     }
 
     auto subpass_coverage =
@@ -352,10 +509,23 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
-    auto subpass_target =
-        CreateRenderTarget(renderer,                       //
-                           ISize(subpass_coverage->size),  //
-                           subpass->ComputeTotalReads(renderer) > 0);
+    // Extended range formats take twice the memory and bandwidth of 8-bit
+    // ones, and are only worth it if the subpass holds colors out of range.
+    std::optional<PixelFormat> subpass_color_format;
+    auto context = renderer.GetContext();
+    if (IsExtendedRangeFormat(context->GetColorAttachmentPixelFormat()) &&
+        !subpass->NeedsExtendedRange()) {
+      subpass_color_format =
+          context->GetDeviceCapabilities().GetDefaultColorFormat();
+    }
+
+    auto subpass_target = CreateRenderTarget(
+        renderer,                                       //
+        ISize(subpass_coverage->size),                  //
+        subpass->ComputeTotalReads(renderer) > 0,       //
+        !subpass->IsAntialiasedWithoutMultisampling(),  //
+        subpass_color_format                            //
+    );
 
     auto subpass_texture = subpass_target.GetRenderTargetTexture();
 
@@ -399,10 +569,371 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
   return EntityPass::EntityResult::Success(element_entity);
 }
 
-struct StencilLayer {
-  std::optional<Rect> coverage;
-  size_t stencil_depth;
-};
+std::shared_ptr<Contents> EntityPass::GetBackdropFilterContents(
+    const EntityPass& subpass,
+    const Element& element,
+    ContentContext& renderer,
+    InlinePassContext& pass_context,
+    std::optional<Rect> clip_coverage,
+    BackdropFilterCache* backdrop_cache) const {
+  auto texture = pass_context.GetTexture();
+  if (!texture) {
+    return nullptr;
+  }
+  const auto& proc = subpass.backdrop_filter_proc_.value();
+  const auto& reuse_key = subpass.backdrop_filter_reuse_key_;
+  const auto texture_rect = Rect::MakeSize(texture->GetSize());
+
+  auto filter = proc(FilterInput::Make(texture), subpass.xformation_,
+                     /*is_subpass*/ true);
+  if (!filter) {
+    return nullptr;
+  }
+
+  // Only the part of the filtered backdrop within the clip is ever visible.
+  auto visible_rect = texture_rect;
+  if (clip_coverage.has_value()) {
+    visible_rect =
+        visible_rect.Intersection(clip_coverage.value()).value_or(Rect());
+  }
+
+  // How far the filter moves content is also how far outside of an area of
+  // its output it reads from the backdrop.
+  auto filter_coverage = filter->GetCoverage(Entity{});
+  if (!filter_coverage.has_value() || filter_coverage->IsMaximum() ||
+      visible_rect.IsEmpty()) {
+    // The subpass will need to read from the current pass texture when
+    // rendering the backdrop, so if there's an active pass, end it prior to
+    // rendering the subpass.
+    pass_context.EndPass();
+    return filter;
+  }
+  auto reach = Vector2(
+      std::max({0.0f, texture_rect.GetLeft() - filter_coverage->GetLeft(),
+                filter_coverage->GetRight() - texture_rect.GetRight()}),
+      std::max({0.0f, texture_rect.GetTop() - filter_coverage->GetTop(),
+                filter_coverage->GetBottom() - texture_rect.GetBottom()}));
+  auto expand = [&reach](const Rect& rect) {
+    return Rect::MakeLTRB(rect.GetLeft() - reach.x, rect.GetTop() - reach.y,
+                          rect.GetRight() + reach.x,
+                          rect.GetBottom() + reach.y);
+  };
+
+  if (reuse_key.has_value() && backdrop_cache && backdrop_cache->contents &&
+      backdrop_cache->reuse_key == reuse_key.value() &&
+      backdrop_cache->effect_transform == subpass.xformation_ &&
+      backdrop_cache->coverage.Contains(visible_rect) &&
+      !(backdrop_cache->dirty_coverage.has_value() &&
+        backdrop_cache->dirty_coverage->IntersectsWithRect(
+            expand(visible_rect)))) {
+    // Nothing that this backdrop reads has changed since it was filtered for
+    // an earlier subpass.
+    return backdrop_cache->contents;
+  }
+
+  // The clips of the later subpasses aren't known yet, so the whole backdrop
+  // is filtered when it may be reused.
+  const bool keep_for_reuse = reuse_key.has_value() && backdrop_cache &&
+                              HasLaterBackdropFilter(element, *reuse_key);
+  const auto filtered_rect = keep_for_reuse ? texture_rect : visible_rect;
+
+  // The filter reads from the current pass texture, so if there's an active
+  // pass, end it prior to rendering the backdrop.
+  pass_context.EndPass();
+
+  if (!(filtered_rect == texture_rect)) {
+    auto input_rect = expand(filtered_rect).Intersection(texture_rect);
+    FML_DCHECK(input_rect.has_value());
+    auto input = TextureContents::MakeRect(input_rect.value());
+    input->SetLabel("Backdrop");
+    input->SetTexture(texture);
+    input->SetSourceRect(input_rect.value());
+    input->SetStencilEnabled(false);
+    filter = proc(FilterInput::Make(std::shared_ptr<Contents>(input),
+                                    /*msaa_enabled=*/false),
+                  subpass.xformation_, /*is_subpass*/ true);
+    if (!filter) {
+      return nullptr;
+    }
+  }
+
+  if (!keep_for_reuse) {
+    return filter;
+  }
+
+  // Render the filter now, while the backdrop it reads is still unchanged.
+  auto snapshot = filter->RenderToSnapshot(renderer, Entity{});
+  if (!snapshot.has_value() ||
+      !snapshot->transform.IsTranslationScaleOnly()) {
+    return filter;
+  }
+  auto snapshot_rect = Rect::MakeSize(snapshot->texture->GetSize());
+  auto contents = TextureContents::MakeRect(
+      snapshot_rect.TransformBounds(snapshot->transform));
+  contents->SetLabel("Filtered backdrop");
+  contents->SetTexture(snapshot->texture);
+  contents->SetSourceRect(snapshot_rect);
+  contents->SetSamplerDescriptor(snapshot->sampler_descriptor);
+  contents->SetOpacity(snapshot->opacity);
+
+  *backdrop_cache = BackdropFilterCache{
+      .reuse_key = reuse_key.value(),
+      .effect_transform = subpass.xformation_,
+      .contents = contents,
+      .coverage = filtered_rect,
+  };
+  return contents;
+}
+
+bool EntityPass::HasLaterBackdropFilter(const Element& element,
+                                        uint64_t reuse_key) const {
+  for (size_t i = &element - elements_.data() + 1; i < elements_.size(); i++) {
+    const auto subpass =
+        std::get_if<std::unique_ptr<EntityPass>>(&elements_[i]);
+    if (subpass && (*subpass)->backdrop_filter_proc_.has_value() &&
+        (*subpass)->backdrop_filter_reuse_key_ == reuse_key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// The number of opaque entities that elements are tested against for
+/// occlusion. The largest ones are kept.
+static constexpr size_t kMaxOccluders = 8u;
+
+std::vector<bool> EntityPass::ComputeOccludedElements() const {
+  TRACE_EVENT0("impeller", "EntityPass::ComputeOccludedElements");
+
+  std::vector<bool> occluded(elements_.size(), false);
+  std::vector<Rect> occluders;
+
+  // Walk the elements front to back. An opaque entity overwrites everything
+  // rendered before it within its coverage, so earlier entities that only
+  // affect pixels within that coverage can be skipped.
+  for (size_t i = elements_.size(); i > 0; i--) {
+    const auto entity = std::get_if<Entity>(&elements_[i - 1]);
+    if (!entity || !entity->GetContents()) {
+      // Subpasses may read the backdrop outside of their coverage or be
+      // collapsed into this pass along with their clips.
+      occluders.clear();
+      continue;
+    }
+    if (entity->GetStencilCoverage(Rect::MakeMaximum()).type !=
+        Contents::StencilCoverage::Type::kNone) {
+      // Clips change which pixels the later entities are rendered to.
+      occluders.clear();
+      continue;
+    }
+
+    auto coverage = entity->GetCoverage();
+    if (!coverage.has_value() || coverage->IsMaximum() ||
+        Entity::BlendModeShouldCoverWholeScreen(entity->GetBlendMode())) {
+      continue;
+    }
+
+    bool is_occluded = false;
+    for (const auto& occluder : occluders) {
+      if (occluder.Contains(coverage.value())) {
+        is_occluded = true;
+        break;
+      }
+    }
+    if (is_occluded) {
+      occluded[i - 1] = true;
+      continue;
+    }
+
+    if (entity->GetBlendMode() != BlendMode::kSourceOver ||
+        !entity->GetContents()->CoversArea(*entity, coverage.value())) {
+      continue;
+    }
+    if (occluders.size() < kMaxOccluders) {
+      occluders.push_back(coverage.value());
+      continue;
+    }
+    auto smallest = std::min_element(
+        occluders.begin(), occluders.end(), [](const Rect& a, const Rect& b) {
+          return a.size.Area() < b.size.Area();
+        });
+    if (smallest->size.Area() < coverage->size.Area()) {
+      *smallest = coverage.value();
+    }
+  }
+
+  return occluded;
+}
+
+InlinePassContext::ContentsInfo EntityPass::ComputeContentsInfo(
+    Rect target_coverage,
+    const std::vector<bool>& occluded_elements) const {
+  InlinePassContext::ContentsInfo info;
+
+  info.writes_stencil = false;
+  for (const auto& element : elements_) {
+    const auto entity = std::get_if<Entity>(&element);
+    // Subpasses may be collapsed into this pass along with their clips.
+    if (!entity || entity->GetStencilCoverage(Rect::MakeMaximum()).type !=
+                       Contents::StencilCoverage::Type::kNone) {
+      info.writes_stencil = true;
+      break;
+    }
+  }
+
+  if (backdrop_filter_proc_.has_value() || elements_.empty() ||
+      occluded_elements.front()) {
+    // Either something else is rendered first, or the first element is
+    // skipped.
+    return info;
+  }
+  const auto entity = std::get_if<Entity>(&elements_.front());
+  if (!entity || !entity->GetContents() ||
+      entity->GetStencilCoverage(Rect::MakeMaximum()).type !=
+          Contents::StencilCoverage::Type::kNone) {
+    return info;
+  }
+  if (entity->GetBlendMode() != BlendMode::kSource &&
+      entity->GetBlendMode() != BlendMode::kSourceOver) {
+    return info;
+  }
+  info.overwrites_color =
+      entity->GetContents()->CoversArea(*entity, target_coverage);
+  return info;
+}
+
+/// The number of entities that are looked at to find a batch that an entity
+/// can join, which bounds the cost of reordering long runs of entities.
+static constexpr size_t kMaxBatchLookback = 64u;
+
+static bool CanBatch(const Entity& entity) {
+  if (!entity.GetContents() || !entity.GetContents()->GetBatchKey()) {
+    return false;
+  }
+  // Advanced blends read from the pass texture, and some pipeline blends
+  // affect pixels outside of the coverage of the entity.
+  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      Entity::BlendModeShouldCoverWholeScreen(entity.GetBlendMode())) {
+    return false;
+  }
+  auto coverage = entity.GetCoverage();
+  return coverage.has_value() && coverage != Rect::MakeMaximum();
+}
+
+static bool IsSameBatch(const Entity& a, const Entity& b) {
+  return a.GetBlendMode() == b.GetBlendMode() &&
+         a.GetStencilDepth() == b.GetStencilDepth() &&
+         a.GetContents()->GetBatchKey() == b.GetContents()->GetBatchKey();
+}
+
+std::vector<EntityPass::BatchedElement> EntityPass::BatchElements(
+    ContentContext& renderer,
+    InlinePassContext& pass_context,
+    ISize root_pass_size,
+    Point position,
+    uint32_t pass_depth,
+    size_t stencil_depth_floor,
+    const std::vector<bool>& occluded_elements) const {
+  TRACE_EVENT0("impeller", "EntityPass::BatchElements");
+
+  std::vector<BatchedElement> batched;
+  batched.reserve(elements_.size());
+  // The coverage of each batched element, for the ones that can be moved.
+  std::vector<Rect> coverages;
+  coverages.reserve(elements_.size());
+  // The first element that an entity may be moved in front of.
+  size_t run_start = 0u;
+
+  for (size_t element_index = 0; element_index < elements_.size();
+       element_index++) {
+    if (occluded_elements[element_index]) {
+      continue;
+    }
+    const auto& element = elements_[element_index];
+    const auto entity = std::get_if<Entity>(&element);
+    if (!entity || !CanBatch(*entity)) {
+      batched.push_back(BatchedElement{.element = &element});
+      coverages.push_back(Rect());
+      run_start = batched.size();
+      continue;
+    }
+
+    // Resolving an entity (unlike a subpass) has no side effects.
+    auto result =
+        GetEntityForElement(element, renderer, pass_context, root_pass_size,
+                            position, pass_depth, stencil_depth_floor);
+    FML_DCHECK(result.status == EntityResult::kSuccess);
+    auto coverage = result.entity.GetCoverage().value();
+
+    // Move the entity behind the last entity of the same batch, as long as it
+    // doesn't overlap any of the entities that it is moved in front of.
+    size_t insert_index = batched.size();
+    size_t lookback_end = batched.size() > run_start + kMaxBatchLookback
+                              ? batched.size() - kMaxBatchLookback
+                              : run_start;
+    for (size_t i = batched.size(); i > lookback_end; i--) {
+      if (IsSameBatch(batched[i - 1].entity.value(), result.entity)) {
+        insert_index = i;
+        break;
+      }
+      if (coverages[i - 1].IntersectsWithRect(coverage)) {
+        break;
+      }
+    }
+    batched.insert(batched.begin() + insert_index,
+                   BatchedElement{.entity = std::move(result.entity)});
+    coverages.insert(coverages.begin() + insert_index, coverage);
+  }
+
+  // Merge adjacent entities of the same batch. The draws of a single command
+  // are blended in order, so the entities may overlap each other. Merged
+  // geometry is only antialiased by multisampling.
+  const bool multisampled =
+      pass_context.GetRenderTarget().GetSampleCount() != SampleCount::kCount1;
+  auto can_merge = [multisampled](const Entity& entity) {
+    return multisampled ||
+           !entity.GetContents()->IsAntialiasedWithoutMultisampling(entity);
+  };
+  std::vector<BatchedElement> merged;
+  merged.reserve(batched.size());
+  for (auto& batched_element : batched) {
+    if (batched_element.entity.has_value() && !merged.empty() &&
+        merged.back().entity.has_value() &&
+        IsSameBatch(merged.back().entity.value(),
+                    batched_element.entity.value()) &&
+        can_merge(merged.back().entity.value()) &&
+        can_merge(batched_element.entity.value())) {
+      auto& previous = merged.back().entity.value();
+      auto contents = previous.GetContents()->MergeWith(
+          renderer, previous, batched_element.entity.value());
+      if (contents) {
+        previous.SetContents(std::move(contents));
+        previous.SetTransformation(Matrix());
+        continue;
+      }
+    }
+    merged.push_back(std::move(batched_element));
+  }
+  return merged;
+}
+
+/// Whether the edges of the rect lie on the pixel grid, so that clipping to it
+/// with a scissor covers the same pixels as clipping with the stencil.
+static bool IsPixelAligned(const Rect& rect) {
+  constexpr Scalar kPixelAlignmentTolerance = 1.0f / 256.0f;
+  for (auto edge : rect.GetLTRB()) {
+    if (std::abs(edge - std::round(edge)) > kPixelAlignmentTolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static IRect RoundOut(const Rect& rect) {
+  return IRect::MakeLTRB(static_cast<int64_t>(std::floor(rect.GetLeft())),
+                         static_cast<int64_t>(std::floor(rect.GetTop())),
+                         static_cast<int64_t>(std::ceil(rect.GetRight())),
+                         static_cast<int64_t>(std::ceil(rect.GetBottom())));
+}
 
 bool EntityPass::OnRender(ContentContext& renderer,
                           ISize root_pass_size,
@@ -413,12 +944,29 @@ bool EntityPass::OnRender(ContentContext& renderer,
                           size_t stencil_depth_floor,
                           std::shared_ptr<Contents> backdrop_filter_contents,
                           std::optional<InlinePassContext::RenderPassResult>
-                              collapsed_parent_pass) const {
+                              collapsed_parent_pass,
+                          std::optional<StencilLayer>
+                              collapsed_parent_stencil_layer) const {
   TRACE_EVENT0("impeller", "EntityPass::OnRender");
 
+  // The stencil is only read by the elements of this pass, unless the pass
+  // is collapsed into its parent.
+  const bool owns_stencil = !collapsed_parent_pass.has_value();
+
+  const auto occluded_elements = ComputeOccludedElements();
+
   auto context = renderer.GetContext();
+  // A collapsed pass continues from the contents of its parent.
+  const auto contents_info =
+      owns_stencil
+          ? ComputeContentsInfo(
+                Rect(position, Size(render_target.GetRenderTargetSize())),
+                occluded_elements)
+          : InlinePassContext::ContentsInfo{};
   InlinePassContext pass_context(context, render_target,
-                                 ComputeTotalReads(renderer),
+                                 ComputeTotalReads(renderer), contents_info,
+                                 renderer.GetTransientsBuffer(),
+                                 /*submit_async=*/pass_depth > 0,
                                  std::move(collapsed_parent_pass));
   if (!pass_context.IsValid()) {
     return false;
@@ -427,6 +975,10 @@ bool EntityPass::OnRender(ContentContext& renderer,
   std::vector<StencilLayer> stencil_stack = {StencilLayer{
       .coverage = Rect::MakeSize(render_target.GetRenderTargetSize()),
       .stencil_depth = stencil_depth_floor}};
+  if (collapsed_parent_stencil_layer.has_value()) {
+    stencil_stack.back() = collapsed_parent_stencil_layer.value();
+    stencil_stack.back().stencil_depth = stencil_depth_floor;
+  }
 
   auto render_element = [&stencil_depth_floor, &pass_context, &pass_depth,
                          &renderer, &stencil_stack](Entity& element_entity) {
@@ -462,6 +1014,10 @@ bool EntityPass::OnRender(ContentContext& renderer,
     auto stencil_coverage =
         element_entity.GetStencilCoverage(stencil_stack.back().coverage);
 
+    // The clips that the entity is rendered within. Clips are rendered
+    // within the clips below them.
+    StencilLayer clip_layer = stencil_stack.back();
+
     switch (stencil_coverage.type) {
       case Contents::StencilCoverage::Type::kNone:
         break;
@@ -469,13 +1025,25 @@ bool EntityPass::OnRender(ContentContext& renderer,
         auto op = stencil_stack.back().coverage;
         stencil_stack.push_back(StencilLayer{
             .coverage = stencil_coverage.coverage,
-            .stencil_depth = element_entity.GetStencilDepth() + 1});
+            .stencil_depth = element_entity.GetStencilDepth() + 1,
+            .elided_clip_count = clip_layer.elided_clip_count});
 
         if (!op.has_value()) {
           // Running this append op won't impact the stencil because the whole
           // screen is already being clipped, so skip it.
           return true;
         }
+
+        // Rects that are aligned with the pixels clip exactly like a scissor
+        // does, so the scissor of the coverage is used instead of writing to
+        // the stencil.
+        auto clip_rect = static_cast<ClipContents*>(
+                             element_entity.GetContents().get())
+                             ->GetClipRect(element_entity);
+        if (clip_rect.has_value() && IsPixelAligned(clip_rect.value())) {
+          stencil_stack.back().elided_clip_count++;
+          return true;
+        }
       } break;
       case Contents::StencilCoverage::Type::kRestore: {
         if (stencil_stack.back().stencil_depth <=
@@ -495,13 +1063,26 @@ bool EntityPass::OnRender(ContentContext& renderer,
                 ? stencil_stack[restoration_depth + 1].coverage
                 : std::nullopt;
 
+        // Clips that were applied with a scissor left the stencil as it
+        // was.
+        const size_t restored_stencil_clips =
+            (stencil_stack.back().stencil_depth -
+             stencil_stack.back().elided_clip_count) -
+            (stencil_stack[restoration_depth].stencil_depth -
+             stencil_stack[restoration_depth].elided_clip_count);
+
         stencil_stack.resize(restoration_depth + 1);
+        clip_layer = stencil_stack.back();
 
         if (!stencil_stack.back().coverage.has_value()) {
           // Running this restore op won't make anything renderable, so skip it.
           return true;
         }
 
+        if (restored_stencil_clips == 0u) {
+          return true;
+        }
+
         auto restore_contents = static_cast<ClipRestoreContents*>(
             element_entity.GetContents().get());
         restore_contents->SetRestoreCoverage(restore_coverage);
@@ -510,11 +1091,24 @@ bool EntityPass::OnRender(ContentContext& renderer,
     }
 
     element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
-                                   stencil_depth_floor);
-    if (!element_entity.Render(renderer, *result.pass)) {
-      return false;
+                                   stencil_depth_floor -
+                                   clip_layer.elided_clip_count);
+
+    // Restores only reset the stencil, so they don't need the scissor.
+    std::optional<IRect> scissor;
+    if (clip_layer.elided_clip_count > 0u &&
+        stencil_coverage.type != Contents::StencilCoverage::Type::kRestore) {
+      scissor = RoundOut(clip_layer.coverage.value())
+                    .Intersection(IRect::MakeSize(
+                        result.pass->GetRenderTargetSize()));
+      if (!scissor.has_value()) {
+        return true;  // Nothing to render.
+      }
     }
-    return true;
+    result.pass->SetScissorLimit(scissor);
+    bool rendered = element_entity.Render(renderer, *result.pass);
+    result.pass->SetScissorLimit(std::nullopt);
+    return rendered;
   };
 
   if (backdrop_filter_proc_.has_value()) {
@@ -531,10 +1125,53 @@ bool EntityPass::OnRender(ContentContext& renderer,
     render_element(backdrop_entity);
   }
 
-  for (const auto& element : elements_) {
-    EntityResult result =
-        GetEntityForElement(element, renderer, pass_context, root_pass_size,
-                            position, pass_depth, stencil_depth_floor);
+  const bool batch_elements = renderer.IsEntityBatchingEnabled();
+  std::vector<BatchedElement> batched_elements;
+  if (batch_elements) {
+    batched_elements =
+        BatchElements(renderer, pass_context, root_pass_size, position,
+                      pass_depth, stencil_depth_floor, occluded_elements);
+  }
+  const size_t element_count =
+      batch_elements ? batched_elements.size() : elements_.size();
+  BackdropFilterCache backdrop_cache;
+
+  // Restoring the stencil after the last element that reads it is only
+  // needed if the stencil is shared with the parent pass.
+  size_t restore_end = element_count;
+  if (owns_stencil) {
+    while (restore_end > 0u) {
+      const Element* element = batch_elements
+                                   ? batched_elements[restore_end - 1].element
+                                   : &elements_[restore_end - 1];
+      // Batched entities are never clips.
+      const auto entity = element ? std::get_if<Entity>(element) : nullptr;
+      if (!entity || entity->GetStencilCoverage(Rect::MakeMaximum()).type !=
+                         Contents::StencilCoverage::Type::kRestore) {
+        break;
+      }
+      restore_end--;
+    }
+  }
+
+  for (size_t i = 0; i < restore_end; i++) {
+    if (!batch_elements && occluded_elements[i]) {
+      continue;
+    }
+
+    EntityResult result;
+    if (batch_elements && batched_elements[i].entity.has_value()) {
+      result = EntityResult::Success(std::move(*batched_elements[i].entity));
+    } else {
+      const Element& element =
+          batch_elements ? *batched_elements[i].element : elements_[i];
+      result = GetEntityForElement(element, renderer, pass_context,
+                                   root_pass_size, position, pass_depth,
+                                   stencil_depth_floor,
+                                   stencil_stack.back().coverage,
+                                   &backdrop_cache,
+                                   stencil_stack.back().elided_clip_count);
+    }
 
     switch (result.status) {
       case EntityResult::kSuccess:
@@ -598,6 +1235,18 @@ bool EntityPass::OnRender(ContentContext& renderer,
     if (!render_element(result.entity)) {
       return false;
     }
+
+    if (backdrop_cache.contents &&
+        result.entity.GetStencilCoverage(Rect::MakeMaximum()).type ==
+            Contents::StencilCoverage::Type::kNone) {
+      auto coverage = result.entity.GetCoverage();
+      if (coverage.has_value()) {
+        backdrop_cache.dirty_coverage =
+            backdrop_cache.dirty_coverage.has_value()
+                ? backdrop_cache.dirty_coverage->Union(coverage.value())
+                : coverage.value();
+      }
+    }
   }
 
   return true;
@@ -658,13 +1307,15 @@ void EntityPass::SetBlendMode(BlendMode blend_mode) {
   cover_whole_screen_ = Entity::BlendModeShouldCoverWholeScreen(blend_mode);
 }
 
-void EntityPass::SetBackdropFilter(std::optional<BackdropFilterProc> proc) {
+void EntityPass::SetBackdropFilter(std::optional<BackdropFilterProc> proc,
+                                   std::optional<uint64_t> reuse_key) {
   if (superpass_) {
     VALIDATION_LOG << "Backdrop filters cannot be set on EntityPasses that "
                       "have already been appended to another pass.";
   }
 
   backdrop_filter_proc_ = std::move(proc);
+  backdrop_filter_reuse_key_ = reuse_key;
 }
 
 }  // namespace impeller
@@ -48,8 +48,17 @@ class EntityPass {
 
   EntityPass* GetSuperpass() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the pass into |render_target|.
+  ///
+  /// @param[in]  origin  The position of the render target in the coordinates
+  ///                     of the pass. A non-zero origin renders only the region
+  ///                     of the pass that the render target covers, which is
+  ///                     used to only repaint the damaged part of a frame.
+  ///
   bool Render(ContentContext& renderer,
-              const RenderTarget& render_target) const;
+              const RenderTarget& render_target,
+              Point origin = Point()) const;
 
   void IterateAllEntities(const std::function<bool(Entity&)>& iterator);
 
@@ -59,7 +68,15 @@ class EntityPass {
 
   void SetBlendMode(BlendMode blend_mode);
 
-  void SetBackdropFilter(std::optional<BackdropFilterProc> proc);
+  /// @brief  Sets the filter that is applied to the parent pass contents
+  ///         behind this pass.
+  ///
+  ///         Passes whose filters have the same `reuse_key` must apply the
+  ///         same filter. Sibling passes with the same key and effect
+  ///         transform share one filtered backdrop as long as the parent
+  ///         pass hasn't been rendered to where they read from it.
+  void SetBackdropFilter(std::optional<BackdropFilterProc> proc,
+                         std::optional<uint64_t> reuse_key = std::nullopt);
 
   std::optional<Rect> GetSubpassCoverage(
       const EntityPass& subpass,
@@ -92,13 +109,119 @@ class EntityPass {
     static EntityResult Skip() { return {{}, kSkip}; }
   };
 
-  EntityResult GetEntityForElement(const EntityPass::Element& element,
-                                   ContentContext& renderer,
-                                   InlinePassContext& pass_context,
-                                   ISize root_pass_size,
-                                   Point position,
-                                   uint32_t pass_depth,
-                                   size_t stencil_depth_floor) const;
+  /// @brief  The filtered backdrop of a subpass, which is kept so that
+  ///         later sibling subpasses with the same backdrop filter can reuse
+  ///         it.
+  struct BackdropFilterCache {
+    uint64_t reuse_key = 0u;
+    Matrix effect_transform;
+    /// @brief  The filtered backdrop, in the space of the parent pass.
+    std::shared_ptr<Contents> contents;
+    /// @brief  The area of the parent pass that the filtered backdrop is
+    ///         valid for.
+    Rect coverage;
+    /// @brief  The area of the parent pass that was rendered to since the
+    ///         backdrop was filtered.
+    std::optional<Rect> dirty_coverage;
+  };
+
+  /// @brief  A clip on the stack of the clips that are applied to the
+  ///         entities of a pass.
+  struct StencilLayer {
+    /// @brief  The area that the clips on the stack so far are limited to.
+    std::optional<Rect> coverage;
+    size_t stencil_depth = 0u;
+    /// @brief  The number of clips on the stack so far that are applied
+    ///         with a scissor rather than written to the stencil. These
+    ///         don't change the stencil, so the stencil reference of an
+    ///         entity is lowered by this count.
+    size_t elided_clip_count = 0u;
+  };
+
+  EntityResult GetEntityForElement(
+      const EntityPass::Element& element,
+      ContentContext& renderer,
+      InlinePassContext& pass_context,
+      ISize root_pass_size,
+      Point position,
+      uint32_t pass_depth,
+      size_t stencil_depth_floor,
+      std::optional<Rect> clip_coverage = std::nullopt,
+      BackdropFilterCache* backdrop_cache = nullptr,
+      size_t elided_clip_count = 0u) const;
+
+  /// @brief  Filter the backdrop of `subpass`, reading only the part of the
+  ///         parent pass texture that can end up within `clip_coverage`.
+  ///         The filtered backdrop is reused from and stored in
+  ///         `backdrop_cache` when the subpass has a reuse key.
+  std::shared_ptr<Contents> GetBackdropFilterContents(
+      const EntityPass& subpass,
+      const Element& element,
+      ContentContext& renderer,
+      InlinePassContext& pass_context,
+      std::optional<Rect> clip_coverage,
+      BackdropFilterCache* backdrop_cache) const;
+
+  /// @brief  Whether a subpass after `element` has a backdrop filter with
+  ///         `reuse_key`.
+  bool HasLaterBackdropFilter(const Element& element, uint64_t reuse_key) const;
+
+  /// @brief  Find the entities that are completely hidden by opaque entities
+  ///         rendered after them, which don't need to be rendered at all.
+  ///         Returns a flag for each element.
+  std::vector<bool> ComputeOccludedElements() const;
+
+  /// @brief  Determine whether the first rendered element overwrites the
+  ///         whole target and whether any element may write to the stencil,
+  ///         which allows clearing and storing the attachments less.
+  ///
+  /// @param[in]  target_coverage   The area of the render target, in the
+  ///                               coordinate space of the elements.
+  /// @param[in]  occluded_elements The result of `ComputeOccludedElements`.
+  InlinePassContext::ContentsInfo ComputeContentsInfo(
+      Rect target_coverage,
+      const std::vector<bool>& occluded_elements) const;
+
+  struct BatchedElement {
+    /// @brief  The element to resolve when it is rendered, if `entity` is
+    ///         not set.
+    const Element* element = nullptr;
+    /// @brief  The resolved entity, which may render several merged ones.
+    std::optional<Entity> entity;
+  };
+
+  /// @brief  Resolve the entities of this pass and reorder the ones that
+  ///         don't overlap so that entities with the same batch key are
+  ///         adjacent, merging them where their contents allow it.
+  ///
+  ///         Entities without a batch key, such as clips and advanced blends,
+  ///         and subpasses are left in place and are resolved when they are
+  ///         rendered. Entities are never moved across them.
+  std::vector<BatchedElement> BatchElements(
+      ContentContext& renderer,
+      InlinePassContext& pass_context,
+      ISize root_pass_size,
+      Point position,
+      uint32_t pass_depth,
+      size_t stencil_depth_floor,
+      const std::vector<bool>& occluded_elements) const;
+
+  /// The coverage of the entities and offscreen subpasses of a pass and its
+  /// subpasses, in the coordinates of the root pass.
+  struct OverdrawCoverage {
+    std::vector<Rect> entities;
+    std::vector<Rect> subpasses;
+  };
+
+  void CollectOverdrawCoverage(std::optional<Rect> coverage_crop,
+                               OverdrawCoverage& coverage) const;
+
+  /// @brief  Renders the coverage of the elements of this pass as a heatmap
+  ///         instead of the elements themselves, see
+  ///         `ContentContext::SetOverdrawHeatmap`.
+  bool RenderOverdrawHeatmap(ContentContext& renderer,
+                             const RenderTarget& render_target,
+                             Point origin) const;
 
   bool OnRender(ContentContext& renderer,
                 ISize root_pass_size,
@@ -109,7 +232,9 @@ class EntityPass {
                 size_t stencil_depth_floor = 0,
                 std::shared_ptr<Contents> backdrop_filter_contents = nullptr,
                 std::optional<InlinePassContext::RenderPassResult>
-                    collapsed_parent_pass = std::nullopt) const;
+                    collapsed_parent_pass = std::nullopt,
+                std::optional<StencilLayer> collapsed_parent_stencil_layer =
+                    std::nullopt) const;
 
   std::vector<Element> elements_;
 
@@ -132,7 +257,17 @@ class EntityPass {
 
   uint32_t ComputeTotalReads(ContentContext& renderer) const;
 
+  /// @brief  Whether all of the elements of this pass antialias themselves,
+  ///         so that it can be rendered to a target without multisampling.
+  bool IsAntialiasedWithoutMultisampling() const;
+
+  /// @brief  Whether any of the elements of this pass may write colors
+  ///         outside of [0, 1], so that it must be rendered to a target with
+  ///         an extended range format rather than an 8-bit one.
+  bool NeedsExtendedRange() const;
+
   std::optional<BackdropFilterProc> backdrop_filter_proc_ = std::nullopt;
+  std::optional<uint64_t> backdrop_filter_reuse_key_ = std::nullopt;
 
   std::unique_ptr<EntityPassDelegate> delegate_ =
       EntityPassDelegate::MakeDefault();
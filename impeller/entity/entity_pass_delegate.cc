@@ -10,6 +10,10 @@ EntityPassDelegate::EntityPassDelegate() = default;
 
 EntityPassDelegate::~EntityPassDelegate() = default;
 
+bool EntityPassDelegate::NeedsExtendedRange() {
+  return true;
+}
+
 class DefaultEntityPassDelegate final : public EntityPassDelegate {
  public:
   DefaultEntityPassDelegate() = default;
@@ -24,7 +28,9 @@ class DefaultEntityPassDelegate final : public EntityPassDelegate {
   bool CanElide() override { return false; }
 
   // |EntityPassDelegate|
-  bool CanCollapseIntoParentPass() override { return true; }
+  bool CanCollapseIntoParentPass(EntityPass* entity_pass) override {
+    return true;
+  }
 
   // |EntityPassDelegate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
@@ -34,6 +40,9 @@ class DefaultEntityPassDelegate final : public EntityPassDelegate {
     FML_UNREACHABLE();
   }
 
+  // |EntityPassDelegate|
+  bool NeedsExtendedRange() override { return false; }
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(DefaultEntityPassDelegate);
 };
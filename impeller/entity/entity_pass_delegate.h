@@ -12,6 +12,8 @@
 
 namespace impeller {
 
+class EntityPass;
+
 class EntityPassDelegate {
  public:
   static std::unique_ptr<EntityPassDelegate> MakeDefault();
@@ -24,12 +26,22 @@ class EntityPassDelegate {
 
   virtual bool CanElide() = 0;
 
-  virtual bool CanCollapseIntoParentPass() = 0;
+  /// @brief  Whether the elements of `entity_pass`, the pass that this is the
+  ///         delegate of, can be rendered directly into the parent pass
+  ///         rather than into a texture of their own. The delegate may adjust
+  ///         the elements so that they look as if they were rendered into
+  ///         the parent with `CreateContentsForSubpassTarget`.
+  virtual bool CanCollapseIntoParentPass(EntityPass* entity_pass) = 0;
 
   virtual std::shared_ptr<Contents> CreateContentsForSubpassTarget(
       std::shared_ptr<Texture> target,
       const Matrix& effect_transform) = 0;
 
+  /// @brief  Whether the contents created by `CreateContentsForSubpassTarget`
+  ///         may write colors outside of [0, 1] even if the subpass target
+  ///         doesn't hold any, such as when filters are applied to it.
+  virtual bool NeedsExtendedRange();
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(EntityPassDelegate);
 };
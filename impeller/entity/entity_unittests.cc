@@ -18,20 +18,29 @@
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
+#include "impeller/entity/contents/filters/compute_separable_filter_contents.h"
+#include "impeller/entity/contents/filters/dual_filter_blur_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
+#include "impeller/entity/contents/gradient_generator.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/rrect_shadow_contents.h"
 #include "impeller/entity/contents/runtime_effect_contents.h"
 #include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/entity_pass_delegate.h"
 #include "impeller/entity/entity_playground.h"
 #include "impeller/entity/geometry.h"
+#include "impeller/entity/gradient_cache.h"
+#include "impeller/entity/path_coverage_rasterizer.h"
+#include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/shadow_cache.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_unittests.h"
 #include "impeller/geometry/path_builder.h"
@@ -74,7 +83,9 @@ class TestPassDelegate final : public EntityPassDelegate {
   bool CanElide() override { return false; }
 
   // |EntityPassDelgate|
-  bool CanCollapseIntoParentPass() override { return collapse_; }
+  bool CanCollapseIntoParentPass(EntityPass* entity_pass) override {
+    return collapse_;
+  }
 
   // |EntityPassDelgate|
   std::shared_ptr<Contents> CreateContentsForSubpassTarget(
@@ -149,6 +160,351 @@ TEST_P(EntityTest, EntityPassCanMergeSubpassIntoParent) {
   ASSERT_TRUE(OpenPlaygroundHere(pass));
 }
 
+TEST_P(EntityTest, EntityPassCanBatchNonOverlappingEntities) {
+  // A checkerboard of red and blue boxes, with a green box overlapping the
+  // middle of it, should appear if the reordering has worked correctly.
+
+  EntityPass pass;
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) {
+      Entity entity;
+      entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+      auto contents = std::make_unique<SolidColorContents>();
+      contents->SetGeometry(
+          Geometry::MakeRect(Rect::MakeXYWH(i * 50, j * 50, 45, 45)));
+      contents->SetColor((i + j) % 2 == 0 ? Color::Red() : Color::Blue());
+      entity.SetContents(std::move(contents));
+      pass.AddEntity(entity);
+    }
+  }
+
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+  auto contents = std::make_unique<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(100, 100, 200, 200)));
+  contents->SetColor(Color::Green().WithAlpha(0.5));
+  entity.SetContents(std::move(contents));
+  pass.AddEntity(entity);
+
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  content_context.SetEntityBatchingEnabled(true);
+  auto callback = [&](RenderTarget& render_target) -> bool {
+    return pass.Render(content_context, render_target);
+  };
+  ASSERT_TRUE(Playground::OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, ContentContextOptionsKeysAreUnique) {
+  ContentContextOptions opts;
+  ContentContextOptions other;
+  ASSERT_EQ(opts.ToKey(), other.ToKey());
+
+  other.blend_mode = BlendMode::kMultiply;
+  ASSERT_NE(opts.ToKey(), other.ToKey());
+
+  other = opts;
+  other.color_attachment_pixel_format = PixelFormat::kUnknown;
+  ASSERT_NE(opts.ToKey(), other.ToKey());
+
+  other = opts;
+  other.wireframe = true;
+  ASSERT_NE(opts.ToKey(), other.ToKey());
+
+  other = opts;
+  other.sample_count = SampleCount::kCount4;
+  other.primitive_type = PrimitiveType::kTriangleStrip;
+  ASSERT_NE(opts.ToKey(), other.ToKey());
+  ASSERT_FALSE(ContentContextOptions::Equal{}(opts, other));
+}
+
+TEST_P(EntityTest, ContentContextRecordsPrewarmedVariantsOnFirstUse) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_TRUE(content_context.GetRequestedPipelineVariants().empty());
+
+  ContentContextOptions opts{.blend_mode = BlendMode::kMultiply};
+  auto label =
+      content_context.GetSolidFillPipeline({})->GetDescriptor().GetLabel();
+  content_context.PrewarmPipelineVariants({{label, opts}});
+  // Prewarming alone doesn't count as a request.
+  ASSERT_TRUE(content_context.GetRequestedPipelineVariants().empty());
+
+  auto pipeline = content_context.GetSolidFillPipeline(opts);
+  ASSERT_TRUE(pipeline && pipeline->IsValid());
+  content_context.GetSolidFillPipeline(opts);
+  auto requested = content_context.GetRequestedPipelineVariants();
+  ASSERT_EQ(requested.size(), 1u);
+  ASSERT_EQ(requested[0].pipeline_label, label);
+  ASSERT_EQ(requested[0].options.blend_mode, BlendMode::kMultiply);
+
+  // Variants that weren't prewarmed are recorded too.
+  content_context.GetTexturePipeline(opts);
+  ASSERT_EQ(content_context.GetRequestedPipelineVariants().size(), 2u);
+}
+
+TEST_P(EntityTest, ContentContextOptionsRoundTripThroughKeys) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kScreen,
+      .stencil_compare = CompareFunction::kGreaterEqual,
+      .stencil_operation = StencilOperation::kIncrementClamp,
+      .primitive_type = PrimitiveType::kTriangleStrip,
+      .color_attachment_pixel_format = PixelFormat::kR8G8B8A8UNormInt,
+      .has_stencil_attachment = false,
+      .wireframe = true,
+  };
+  ASSERT_EQ(ContentContextOptions::FromKey(opts.ToKey()).ToKey(),
+            opts.ToKey());
+  ASSERT_FALSE(ContentContextOptions::FromKey(ContentContextOptions{}.ToKey())
+                   .color_attachment_pixel_format.has_value());
+}
+
+TEST_P(EntityTest, PipelineVariantsRoundTripThroughManifests) {
+  ContentContextOptions opts{.blend_mode = BlendMode::kMultiply,
+                             .color_attachment_pixel_format =
+                                 PixelFormat::kB8G8R8A8UNormInt};
+  std::vector<ContentContext::PipelineVariant> variants = {
+      {"Solid Fill Pipeline", opts},
+      {"", {}},
+  };
+  auto manifest = ContentContext::SerializePipelineVariants(variants);
+  ASSERT_NE(manifest, nullptr);
+
+  auto decoded = ContentContext::DeserializePipelineVariants(*manifest);
+  ASSERT_EQ(decoded.size(), 2u);
+  ASSERT_EQ(decoded[0].pipeline_label, "Solid Fill Pipeline");
+  ASSERT_EQ(decoded[0].options.ToKey(), opts.ToKey());
+  ASSERT_EQ(decoded[1].pipeline_label, "");
+  ASSERT_EQ(decoded[1].options.ToKey(), ContentContextOptions{}.ToKey());
+
+  ASSERT_TRUE(ContentContext::DeserializePipelineVariants(
+                  fml::DataMapping("not a manifest"))
+                  .empty());
+}
+
+TEST_P(EntityTest, ContentContextCachesRuntimeEffectPipelines) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  size_t create_count = 0u;
+  auto create = [&]() {
+    create_count++;
+    return content_context.GetSolidFillPipeline({});
+  };
+  ContentContextOptions opts;
+  auto pipeline =
+      content_context.GetCachedRuntimeEffectPipeline("effect", opts, create);
+  ASSERT_TRUE(pipeline);
+  ASSERT_EQ(
+      content_context.GetCachedRuntimeEffectPipeline("effect", opts, create),
+      pipeline);
+  ASSERT_EQ(create_count, 1u);
+
+  // Each entry point and variant has its own pipeline.
+  content_context.GetCachedRuntimeEffectPipeline("other", opts, create);
+  ContentContextOptions multiply_opts{.blend_mode = BlendMode::kMultiply};
+  content_context.GetCachedRuntimeEffectPipeline("effect", multiply_opts,
+                                                 create);
+  ASSERT_EQ(create_count, 3u);
+
+  content_context.ClearCachedRuntimeEffectPipeline("effect");
+  content_context.GetCachedRuntimeEffectPipeline("effect", opts, create);
+  content_context.GetCachedRuntimeEffectPipeline("other", opts, create);
+  ASSERT_EQ(create_count, 4u);
+
+  // Failures are tried again on the next draw.
+  auto fail = [&]() -> std::shared_ptr<Pipeline<PipelineDescriptor>> {
+    create_count++;
+    return nullptr;
+  };
+  content_context.GetCachedRuntimeEffectPipeline("failing", opts, fail);
+  content_context.GetCachedRuntimeEffectPipeline("failing", opts, fail);
+  ASSERT_EQ(create_count, 6u);
+}
+
+TEST_P(EntityTest, SolidColorContentsCanMergeFillsOfTheSameColor) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  auto make_entity = [](std::shared_ptr<Geometry> geometry, Color color,
+                        Matrix transform) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(std::move(geometry));
+    contents->SetColor(color);
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    entity.SetTransformation(transform);
+    return entity;
+  };
+
+  auto rect = make_entity(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)),
+                          Color::Red(), Matrix::MakeTranslation({10, 10}));
+  auto path = make_entity(
+      Geometry::MakeFillPath(
+          PathBuilder{}.AddCircle({50, 50}, 10).TakePath()),
+      Color::Red(), Matrix::MakeScale({2, 2, 1}));
+  ASSERT_EQ(rect.GetContents()->GetBatchKey(),
+            path.GetContents()->GetBatchKey());
+
+  auto merged = rect.GetContents()->MergeWith(content_context, rect, path);
+  ASSERT_NE(merged, nullptr);
+  Entity merged_entity;
+  merged_entity.SetContents(merged);
+  auto coverage = merged_entity.GetCoverage();
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(), Rect::MakeLTRB(10, 10, 120, 120));
+
+  // Merged contents can be merged again.
+  merged_entity.SetContents(
+      merged->MergeWith(content_context, merged_entity, rect));
+  ASSERT_NE(merged_entity.GetContents(), nullptr);
+
+  // The color is a uniform, so fills of other colors aren't merged.
+  auto blue = make_entity(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 10, 10)),
+                          Color::Blue(), Matrix());
+  ASSERT_EQ(rect.GetContents()->MergeWith(content_context, rect, blue),
+            nullptr);
+
+  // Neither are strokes.
+  auto stroke = make_entity(
+      Geometry::MakeStrokePath(
+          PathBuilder{}.AddLine({0, 0}, {10, 10}).TakePath(), 2),
+      Color::Red(), Matrix());
+  ASSERT_EQ(rect.GetContents()->MergeWith(content_context, rect, stroke),
+            nullptr);
+}
+
+TEST_P(EntityTest, TextContentsCanMergeTranslatedTextOfTheSameAtlas) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  SkFont font;
+  font.setSize(30);
+  auto frame = TextFrameFromTextBlob(SkTextBlob::MakeFromString("hi", font));
+  auto lazy_glyph_atlas = std::make_shared<LazyGlyphAtlas>();
+  lazy_glyph_atlas->AddTextFrame(frame);
+
+  auto make_entity = [&](const std::shared_ptr<LazyGlyphAtlas>& atlas,
+                         Matrix transform) {
+    auto contents = std::make_shared<TextContents>();
+    contents->SetTextFrame(frame);
+    contents->SetGlyphAtlas(atlas);
+    contents->SetColor(Color::Red());
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    entity.SetTransformation(transform);
+    return entity;
+  };
+
+  auto first = make_entity(lazy_glyph_atlas, Matrix::MakeTranslation({10, 0}));
+  auto second =
+      make_entity(lazy_glyph_atlas, Matrix::MakeTranslation({10, 100}));
+  ASSERT_EQ(first.GetContents()->GetBatchKey(),
+            second.GetContents()->GetBatchKey());
+
+  auto merged = first.GetContents()->MergeWith(content_context, first, second);
+  ASSERT_NE(merged, nullptr);
+  Entity merged_entity;
+  merged_entity.SetContents(merged);
+  auto coverage = merged_entity.GetCoverage();
+  ASSERT_TRUE(coverage.has_value());
+  ASSERT_RECT_NEAR(coverage.value(),
+                   first.GetCoverage()->Union(second.GetCoverage().value()));
+
+  // Merged contents can be merged again.
+  ASSERT_NE(merged->MergeWith(content_context, merged_entity, first), nullptr);
+
+  // The glyphs are rasterized for the scale of the transformation, so text
+  // drawn at another scale isn't merged.
+  auto scaled = make_entity(lazy_glyph_atlas, Matrix::MakeScale({2, 2, 1}));
+  ASSERT_EQ(first.GetContents()->MergeWith(content_context, first, scaled),
+            nullptr);
+
+  // Neither is text of another atlas.
+  auto other = make_entity(std::make_shared<LazyGlyphAtlas>(), Matrix());
+  ASSERT_EQ(first.GetContents()->MergeWith(content_context, first, other),
+            nullptr);
+}
+
+TEST_P(EntityTest, SolidColorContentsCoversAreaWhenOpaque) {
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(Rect::MakeXYWH(0, 0, 100, 100)));
+  contents->SetColor(Color::Red());
+  Entity entity;
+  entity.SetContents(contents);
+  entity.SetTransformation(Matrix::MakeTranslation({50, 50}));
+
+  ASSERT_TRUE(contents->CoversArea(entity, Rect::MakeXYWH(60, 60, 50, 50)));
+  ASSERT_TRUE(contents->CoversArea(entity, Rect::MakeXYWH(50, 50, 100, 100)));
+  ASSERT_FALSE(contents->CoversArea(entity, Rect::MakeXYWH(0, 0, 100, 100)));
+
+  // Rotated rectangles are not rectangles on screen.
+  entity.SetTransformation(Matrix::MakeRotationZ(Degrees(45)));
+  ASSERT_FALSE(contents->CoversArea(entity, Rect::MakeXYWH(10, 10, 1, 1)));
+
+  entity.SetTransformation(Matrix());
+  contents->SetColor(Color::Red().WithAlpha(0.5));
+  ASSERT_FALSE(contents->CoversArea(entity, Rect::MakeXYWH(10, 10, 1, 1)));
+
+  contents->SetColor(Color::Red());
+  contents->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 100, 100)).TakePath()));
+  ASSERT_FALSE(contents->CoversArea(entity, Rect::MakeXYWH(10, 10, 1, 1)));
+
+  contents->SetGeometry(Geometry::MakeCover());
+  ASSERT_TRUE(contents->CoversArea(entity, Rect::MakeXYWH(10, 10, 1, 1)));
+}
+
+TEST_P(EntityTest, EntityPassSkipsOccludedEntities) {
+  // A blue box with a translucent green box on top of it should appear. The
+  // red box beneath the blue box is never rendered.
+
+  EntityPass pass;
+  auto add_rect = [&](Rect rect, Color color) {
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+    auto contents = std::make_unique<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeRect(rect));
+    contents->SetColor(color);
+    entity.SetContents(std::move(contents));
+    pass.AddEntity(entity);
+  };
+  add_rect(Rect::MakeXYWH(150, 150, 100, 100), Color::Red());
+  add_rect(Rect::MakeXYWH(100, 100, 200, 200), Color::Blue());
+  add_rect(Rect::MakeXYWH(200, 200, 200, 200), Color::Green().WithAlpha(0.5));
+
+  ASSERT_TRUE(OpenPlaygroundHere(pass));
+}
+
+TEST_P(EntityTest, EntityPassSkipsClearOfOverwrittenColor) {
+  // An opaque yellow background with a blue box on top of it should appear.
+  // The background is rendered over the whole pass, so the color attachment
+  // isn't cleared first.
+
+  EntityPass pass;
+  {
+    Entity entity;
+    auto contents = std::make_unique<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeCover());
+    contents->SetColor(Color::Yellow());
+    entity.SetContents(std::move(contents));
+    pass.AddEntity(entity);
+  }
+  {
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+    auto contents = std::make_unique<SolidColorContents>();
+    contents->SetGeometry(
+        Geometry::MakeRect(Rect::MakeXYWH(100, 100, 200, 200)));
+    contents->SetColor(Color::Blue());
+    entity.SetContents(std::move(contents));
+    pass.AddEntity(entity);
+  }
+
+  ASSERT_TRUE(OpenPlaygroundHere(pass));
+}
+
 TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   // Rect is drawn entirely in negative area.
   auto pass = CreatePassWithRectPath(Rect::MakeLTRB(-200, -200, -100, -100),
@@ -946,7 +1302,8 @@ TEST_P(EntityTest, GaussianBlurFilter) {
   auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
     const char* input_type_names[] = {"Texture", "Solid Color"};
     const char* blur_type_names[] = {"Image blur", "Mask blur"};
-    const char* pass_variation_names[] = {"Two pass", "Directional"};
+    const char* pass_variation_names[] = {"Two pass", "Directional",
+                                          "Dual filter"};
     const char* blur_style_names[] = {"Normal", "Solid", "Outer", "Inner"};
     const char* tile_mode_names[] = {"Clamp", "Repeat", "Mirror", "Decal"};
     const FilterContents::BlurStyle blur_styles[] = {
@@ -991,7 +1348,7 @@ TEST_P(EntityTest, GaussianBlurFilter) {
                      pass_variation_names,
                      sizeof(pass_variation_names) / sizeof(char*));
       }
-      ImGui::SliderFloat2("Sigma", blur_amount, 0, 10);
+      ImGui::SliderFloat2("Sigma", blur_amount, 0, 100);
       ImGui::Combo("Blur style", &selected_blur_style, blur_style_names,
                    sizeof(blur_style_names) / sizeof(char*));
       ImGui::Combo("Tile mode", &selected_tile_mode, tile_mode_names,
@@ -1038,6 +1395,12 @@ TEST_P(EntityTest, GaussianBlurFilter) {
           FilterInput::Make(input), Sigma{blur_amount[0]},
           Sigma{blur_amount[1]}, blur_styles[selected_blur_style],
           tile_modes[selected_tile_mode]);
+    } else if (selected_pass_variation == 2) {
+      blur = FilterContents::MakeGaussianBlur(
+          FilterInput::Make(input), Sigma{blur_amount[0]},
+          Sigma{blur_amount[1]}, blur_styles[selected_blur_style],
+          tile_modes[selected_tile_mode], Matrix(),
+          FilterContents::BlurQuality::kDualFilter);
     } else {
       Vector2 blur_vector(blur_amount[0], blur_amount[1]);
       blur = FilterContents::MakeDirectionalGaussianBlur(
@@ -1089,6 +1452,142 @@ TEST_P(EntityTest, GaussianBlurFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, DualFilterBlurParametersMatchSigma) {
+  using Blur = DualFilterBlurFilterContents;
+
+  // Small blurs are left to the exact blur.
+  ASSERT_FALSE(Blur::ComputeParameters(Vector2(2, 2)).has_value());
+
+  size_t last_iterations = 0;
+  for (Scalar sigma = Blur::kMinSigma; sigma < 200; sigma *= 1.25) {
+    auto parameters = Blur::ComputeParameters(Vector2(sigma, sigma));
+    ASSERT_TRUE(parameters.has_value());
+    ASSERT_GE(parameters->iterations, last_iterations);
+    ASSERT_LE(parameters->iterations, Blur::kMaxIterations);
+    last_iterations = parameters->iterations;
+
+    ASSERT_GE(parameters->offset.x, Blur::kMinOffset);
+    ASSERT_LE(parameters->offset.x, Blur::kMaxOffset);
+    auto computed_sigma =
+        Blur::ComputeSigma(parameters->iterations, parameters->offset.x);
+    ASSERT_NEAR(computed_sigma, sigma, sigma * 0.01);
+  }
+
+  // Each axis gets its own offset.
+  auto parameters = Blur::ComputeParameters(Vector2(20, 15));
+  ASSERT_TRUE(parameters.has_value());
+  ASSERT_GT(parameters->offset.x, parameters->offset.y);
+
+  // Axes that are too different for one chain are left to the exact blur.
+  ASSERT_FALSE(Blur::ComputeParameters(Vector2(100, 0)).has_value());
+}
+
+TEST_P(EntityTest, DualFilterBlurFilterCoverageMatchesExactBlur) {
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetColor(Color::Red());
+  fill->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 100, 100)).TakePath()));
+
+  auto exact = FilterContents::MakeGaussianBlur(
+      FilterInput::Make(fill), Sigma{20}, Sigma{10});
+  auto dual_filter = FilterContents::MakeGaussianBlur(
+      FilterInput::Make(fill), Sigma{20}, Sigma{10},
+      FilterContents::BlurStyle::kNormal, Entity::TileMode::kDecal, Matrix(),
+      FilterContents::BlurQuality::kDualFilter);
+
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeScale(Vector2(2, 2)));
+  auto exact_coverage = exact->GetCoverage(entity);
+  auto dual_filter_coverage = dual_filter->GetCoverage(entity);
+  ASSERT_TRUE(exact_coverage.has_value());
+  ASSERT_TRUE(dual_filter_coverage.has_value());
+  ASSERT_RECT_NEAR(exact_coverage.value(), dual_filter_coverage.value());
+}
+
+TEST_P(EntityTest, ComputeSeparableFilterPadsOutputByKernelRadius) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetColor(Color::Red());
+  fill->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 100, 100)).TakePath()));
+
+  auto blur = std::make_shared<ComputeSeparableFilterContents>();
+  blur->SetInputs({FilterInput::Make(fill)});
+  blur->SetOperation(ComputeSeparableFilterContents::Operation::kGaussianBlur);
+  blur->SetSigma(Sigma{4}, Sigma{4});
+  blur->SetFallback(FilterContents::MakeGaussianBlur(FilterInput::Make(fill),
+                                                     Sigma{4}, Sigma{4}));
+
+  Entity entity;
+  auto snapshot = blur->RenderToSnapshot(content_context, entity);
+  ASSERT_TRUE(snapshot.has_value());
+  if (GetContext()->GetDeviceCapabilities().SupportsCompute()) {
+    // A sigma of 4 has a kernel radius of ceil(3.5 * 1.73) = 7 pixels.
+    ASSERT_EQ(snapshot->texture->GetSize(), ISize(114, 114));
+    ASSERT_TRUE(snapshot->GetCoverage().has_value());
+    ASSERT_RECT_NEAR(snapshot->GetCoverage().value(),
+                     Rect::MakeXYWH(-7, -7, 114, 114));
+  }
+}
+
+TEST_P(EntityTest, FilterInputSnapshotsAreCroppedToCoverageLimit) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetColor(Color::Red());
+  fill->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 100, 100)).TakePath()));
+  auto input = FilterInput::Make(fill);
+
+  Entity entity;
+  auto cropped = input->GetSnapshot(content_context, entity,
+                                    Rect::MakeLTRB(40, 40, 200, 200));
+  ASSERT_TRUE(cropped.has_value());
+  ASSERT_EQ(cropped->texture->GetSize(), ISize(60, 60));
+  ASSERT_TRUE(cropped->GetCoverage().has_value());
+  ASSERT_RECT_NEAR(cropped->GetCoverage().value(),
+                   Rect::MakeLTRB(40, 40, 100, 100));
+
+  // The cached snapshot is reused for limits that it covers...
+  auto contained = input->GetSnapshot(content_context, entity,
+                                      Rect::MakeLTRB(50, 50, 90, 90));
+  ASSERT_TRUE(contained.has_value());
+  ASSERT_EQ(contained->texture, cropped->texture);
+
+  // ...and rendered again for the ones that it does not.
+  auto full = input->GetSnapshot(content_context, entity);
+  ASSERT_TRUE(full.has_value());
+  ASSERT_EQ(full->texture->GetSize(), ISize(100, 100));
+}
+
+TEST_P(EntityTest, FilterSnapshotsAreCroppedToCoverageLimit) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  auto fill = std::make_shared<SolidColorContents>();
+  fill->SetColor(Color::Red());
+  fill->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddRect(Rect::MakeXYWH(0, 0, 100, 100)).TakePath()));
+  auto blur = FilterContents::MakeDirectionalGaussianBlur(
+      FilterInput::Make(fill), Sigma{4}, Vector2(1, 0));
+
+  Entity entity;
+  auto limit = Rect::MakeLTRB(50, -50, 200, 150);
+  auto blur_coverage = blur->GetCoverage(entity);
+  ASSERT_TRUE(blur_coverage.has_value());
+  ASSERT_GT(blur_coverage->GetRight(), 100);
+
+  // Only the output within the limit is rendered.
+  auto snapshot = blur->RenderToSnapshot(content_context, entity, limit);
+  ASSERT_TRUE(snapshot.has_value());
+  ASSERT_TRUE(snapshot->GetCoverage().has_value());
+  ASSERT_RECT_NEAR(snapshot->GetCoverage().value(),
+                   blur_coverage->Intersection(limit).value());
+}
+
 TEST_P(EntityTest, MorphologyFilter) {
   auto boston = CreateTextureForFixture("boston.jpg");
   ASSERT_TRUE(boston);
@@ -1460,6 +1959,52 @@ TEST_P(EntityTest, DrawAtlasWithOpacity) {
   ASSERT_TRUE(OpenPlaygroundHere(e));
 }
 
+TEST_P(EntityTest, DrawAtlasWithManyRotatedSprites) {
+  // Draws a grid of small rotated sprites, which are drawn as instances of a
+  // quad on devices that support it.
+  auto atlas = CreateTextureForFixture("bay_bridge.jpg");
+  auto size = atlas->GetSize();
+  std::vector<Rect> texture_coordinates;
+  std::vector<Matrix> transforms;
+  std::vector<Color> colors;
+  for (int y = 0; y < 40; y++) {
+    for (int x = 0; x < 40; x++) {
+      texture_coordinates.push_back(Rect::MakeXYWH(
+          size.width * x / 40, size.height * y / 40, 20, 20));
+      transforms.push_back(
+          Matrix::MakeTranslation({x * 25.0f + 10, y * 25.0f + 10, 0}) *
+          Matrix::MakeRotationZ(Degrees(x * 9 + y * 9)));
+      colors.push_back(Color(x / 40.0f, y / 40.0f, 1, 1));
+    }
+  }
+
+  std::shared_ptr<AtlasContents> contents = std::make_shared<AtlasContents>();
+  contents->SetTransforms(std::move(transforms));
+  contents->SetTextureCoordinates(std::move(texture_coordinates));
+  contents->SetColors(std::move(colors));
+  contents->SetTexture(atlas);
+  contents->SetBlendMode(BlendMode::kModulate);
+
+  Entity e;
+  e.SetTransformation(Matrix::MakeScale(GetContentScale()));
+  e.SetContents(contents);
+
+  ASSERT_TRUE(OpenPlaygroundHere(e));
+}
+
+TEST_P(EntityTest, InstancedAtlasDependsOnDeviceCapabilities) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  const auto& capabilities = GetContext()->GetDeviceCapabilities();
+  ASSERT_EQ(content_context.SupportsInstancedAtlas(),
+            capabilities.SupportsSSBO() &&
+                capabilities.SupportsInstancedRendering());
+  if (content_context.SupportsInstancedAtlas()) {
+    ASSERT_TRUE(content_context.GetAtlasTexturePipeline({}));
+    ASSERT_TRUE(content_context.GetAtlasColorPipeline({}));
+  }
+}
+
 TEST_P(EntityTest, DrawAtlasNoColorFullSize) {
   auto atlas = CreateTextureForFixture("bay_bridge.jpg");
   auto size = atlas->GetSize();
@@ -1639,6 +2184,401 @@ TEST_P(EntityTest, ClipContentsGetStencilCoverageIsCorrect) {
   }
 }
 
+TEST_P(EntityTest, ClipContentsGetClipRectIsOnlySetForRectIntersections) {
+  Entity entity;
+  entity.SetTransformation(Matrix::MakeTranslation({10, 20}) *
+                           Matrix::MakeScale({2, 2, 1}));
+
+  auto clip = std::make_shared<ClipContents>();
+  clip->SetClipOperation(Entity::ClipOperation::kIntersect);
+  ASSERT_FALSE(clip->GetClipRect(entity).has_value());
+
+  clip->SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(0, 0, 50, 50)));
+  auto clip_rect = clip->GetClipRect(entity);
+  ASSERT_TRUE(clip_rect.has_value());
+  ASSERT_RECT_NEAR(clip_rect.value(), Rect::MakeLTRB(10, 20, 110, 120));
+
+  // Rotated rects and paths can't be applied with a scissor.
+  entity.SetTransformation(Matrix::MakeRotationZ(Degrees(45)));
+  ASSERT_FALSE(clip->GetClipRect(entity).has_value());
+  entity.SetTransformation(Matrix());
+  clip->SetGeometry(Geometry::MakeFillPath(
+      PathBuilder{}.AddCircle({50, 50}, 50).TakePath()));
+  ASSERT_FALSE(clip->GetClipRect(entity).has_value());
+
+  clip->SetGeometry(Geometry::MakeRect(Rect::MakeLTRB(0, 0, 50, 50)));
+  clip->SetClipOperation(Entity::ClipOperation::kDifference);
+  ASSERT_FALSE(clip->GetClipRect(entity).has_value());
+}
+
+TEST_P(EntityTest, ConvexFillsAreAntialiasedWithoutMultisampling) {
+  auto rotation = Matrix::MakeRotationZ(Degrees(30));
+  auto perspective = Matrix::MakePerspective(Degrees(60), 1.0f, 1.0f, 10.0f);
+
+  auto rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 50, 50));
+  ASSERT_TRUE(rect->CanAntialiasWithCoverage(rotation));
+  ASSERT_FALSE(rect->CanAntialiasWithCoverage(perspective));
+
+  auto circle =
+      Geometry::MakeFillPath(PathBuilder{}.AddCircle({50, 50}, 50).TakePath());
+  ASSERT_TRUE(circle->CanAntialiasWithCoverage(rotation));
+  auto rrect = Geometry::MakeFillPath(
+      PathBuilder{}
+          .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 50), 10)
+          .TakePath());
+  ASSERT_TRUE(rrect->CanAntialiasWithCoverage(Matrix()));
+
+  auto concave = Geometry::MakeFillPath(PathBuilder{}
+                                            .MoveTo({0, 0})
+                                            .LineTo({100, 0})
+                                            .LineTo({50, 20})
+                                            .LineTo({50, 100})
+                                            .Close()
+                                            .TakePath());
+  ASSERT_FALSE(concave->CanAntialiasWithCoverage(Matrix()));
+
+  auto two_rects = Geometry::MakeFillPath(
+      PathBuilder{}
+          .AddRect(Rect::MakeLTRB(0, 0, 10, 10))
+          .AddRect(Rect::MakeLTRB(20, 0, 30, 10))
+          .TakePath());
+  ASSERT_FALSE(two_rects->CanAntialiasWithCoverage(Matrix()));
+
+  // A star turns in one direction only, but twice around.
+  PathBuilder star;
+  star.MoveTo({50, 0});
+  for (int i = 1; i <= 5; i++) {
+    auto angle = Radians(kPi * 2 * 2 * i / 5 - kPiOver2);
+    star.LineTo({50 + std::cos(angle.radians) * 50,
+                 50 + std::sin(angle.radians) * 50});
+  }
+  star.Close();
+  auto star_geometry = Geometry::MakeFillPath(star.TakePath());
+  ASSERT_FALSE(star_geometry->CanAntialiasWithCoverage(Matrix()));
+
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetColor(Color::Red());
+  Entity entity;
+  entity.SetContents(contents);
+  ASSERT_FALSE(contents->IsAntialiasedWithoutMultisampling(entity));
+  contents->SetGeometry(std::move(circle));
+  ASSERT_TRUE(contents->IsAntialiasedWithoutMultisampling(entity));
+  contents->SetGeometry(std::move(concave));
+  ASSERT_FALSE(contents->IsAntialiasedWithoutMultisampling(entity));
+}
+
+TEST_P(EntityTest, TexturesDrawnDownscaledGenerateTheirMipmaps) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  auto texture = CreateTextureForFixture("boston.jpg",
+                                         /*enable_mipmapping=*/true);
+  ASSERT_TRUE(texture);
+  ASSERT_TRUE(texture->NeedsMipmapGeneration());
+
+  auto render_texture = [&](Scalar scale) {
+    auto size = Size(texture->GetSize());
+    auto contents = TextureContents::MakeRect(Rect::MakeSize(size * scale));
+    contents->SetTexture(texture);
+    contents->SetSourceRect(Rect::MakeSize(size));
+    SamplerDescriptor sampler;
+    sampler.min_filter = sampler.mag_filter = MinMagFilter::kLinear;
+    contents->SetSamplerDescriptor(sampler);
+    Entity entity;
+    entity.SetContents(contents);
+    EntityPass pass;
+    pass.AddEntity(entity);
+    auto render_target = RenderTarget::CreateOffscreen(
+        *GetContext(), *content_context.GetRenderTargetCache(),
+        ISize(400, 400), "Mipmaps");
+    return pass.Render(content_context, render_target);
+  };
+
+  // Textures drawn at about their size are sampled from their base level.
+  ASSERT_TRUE(render_texture(0.75));
+  ASSERT_TRUE(texture->NeedsMipmapGeneration());
+
+  ASSERT_TRUE(render_texture(0.25));
+  ASSERT_FALSE(texture->NeedsMipmapGeneration());
+}
+
+TEST_P(EntityTest, ContentsOnlyNeedExtendedRangeForColorsOutOfRange) {
+  Entity entity;
+
+  auto solid_color = std::make_shared<SolidColorContents>();
+  solid_color->SetColor(Color::Red());
+  ASSERT_FALSE(solid_color->NeedsExtendedRange(entity));
+  solid_color->SetColor(Color(1.5, 0, 0, 1));
+  ASSERT_TRUE(solid_color->NeedsExtendedRange(entity));
+
+  auto texture = std::make_shared<TextureContents>();
+  texture->SetTexture(CreateTextureForFixture("boston.jpg"));
+  ASSERT_FALSE(texture->NeedsExtendedRange(entity));
+
+  auto tiled_texture = std::make_shared<TiledTextureContents>();
+  tiled_texture->SetTexture(CreateTextureForFixture("boston.jpg"));
+  ASSERT_FALSE(tiled_texture->NeedsExtendedRange(entity));
+
+  // Contents that don't know are assumed to need it.
+  auto filter = ColorFilterContents::MakeBlend(
+      BlendMode::kScreen,
+      FilterInput::Make({CreateTextureForFixture("boston.jpg")}));
+  ASSERT_TRUE(filter->NeedsExtendedRange(entity));
+}
+
+TEST_P(EntityTest, RRectGeometryOutlineDependsOnScale) {
+  RRectGeometry rrect(Rect::MakeLTRB(0, 0, 100, 50), Size(10, 10));
+  auto small_count = rrect.GetOutline(1).size();
+  auto large_count = rrect.GetOutline(10).size();
+  ASSERT_GT(large_count, small_count);
+  ASSERT_EQ(rrect.GetOutline(1).size(), small_count);
+
+  for (const auto& point : rrect.GetOutline(1)) {
+    ASSERT_TRUE(Rect::MakeLTRB(-0.001, -0.001, 100.001, 50.001)
+                    .Contains(point));
+  }
+
+  // The corners of the rect are cut off by the radii.
+  auto geometry =
+      Geometry::MakeRRect(Rect::MakeLTRB(0, 0, 100, 50), Size(10, 10));
+  ASSERT_TRUE(geometry->CoversArea(Matrix(), Rect::MakeLTRB(10, 0, 90, 50)));
+  ASSERT_TRUE(geometry->CoversArea(Matrix(), Rect::MakeLTRB(0, 10, 100, 40)));
+  ASSERT_FALSE(geometry->CoversArea(Matrix(), Rect::MakeLTRB(0, 0, 90, 50)));
+
+  // Radii larger than half of the rect are clamped, which makes a circle.
+  RRectGeometry circle(Rect::MakeLTRB(0, 0, 100, 100), Size(200, 200));
+  for (const auto& point : circle.GetOutline(1)) {
+    ASSERT_NEAR(point.GetDistance({50, 50}), 50, 0.001);
+  }
+}
+
+TEST_P(EntityTest, RRectShadowsOfTheSameStyleShareANinePatch) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  EntityPass pass;
+  auto add_shadow = [&pass](Rect rect, Color color, Matrix transform) {
+    auto contents = std::make_shared<RRectShadowContents>();
+    contents->SetRRect(rect, 10);
+    contents->SetSigma(Sigma(5));
+    contents->SetColor(color);
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    entity.SetTransformation(transform);
+    pass.AddEntity(entity);
+  };
+  add_shadow(Rect::MakeXYWH(10, 10, 100, 50), Color::Black(), Matrix());
+  add_shadow(Rect::MakeXYWH(10, 100, 200, 80), Color::Black(),
+             Matrix::MakeTranslation({20, 30}));
+  add_shadow(Rect::MakeXYWH(10, 200, 100, 50), Color::Red(), Matrix());
+  // Rotated shadows are blurred directly.
+  add_shadow(Rect::MakeXYWH(200, 10, 100, 50), Color::Blue(),
+             Matrix::MakeRotationZ(Degrees(30)));
+
+  auto render_target = RenderTarget::CreateOffscreen(
+      *GetContext(), *content_context.GetRenderTargetCache(), ISize(400, 400),
+      "Shadows");
+  ASSERT_TRUE(pass.Render(content_context, render_target));
+  ASSERT_EQ(content_context.GetShadowCache()->GetEntryCount(), 2u);
+}
+
+TEST_P(EntityTest, OverdrawHeatmapSummarizesCoverage) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  ASSERT_FALSE(content_context.GetOverdrawSummary().has_value());
+
+  EntityPass pass;
+  for (auto rect : {Rect::MakeXYWH(0, 0, 200, 200),
+                    Rect::MakeXYWH(100, 100, 200, 200)}) {
+    Entity entity;
+    entity.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddRect(rect).TakePath(), Color::Red()));
+    pass.AddEntity(entity);
+  }
+  // Only the subpass that isn't collapsed into its parent is offscreen.
+  pass.AddSubpass(
+      CreatePassWithRectPath(Rect::MakeXYWH(300, 0, 100, 100), std::nullopt));
+  pass.AddSubpass(CreatePassWithRectPath(Rect::MakeXYWH(300, 300, 200, 200),
+                                         std::nullopt, true));
+
+  auto render_target = RenderTarget::CreateOffscreen(
+      *GetContext(), *content_context.GetRenderTargetCache(), ISize(400, 400),
+      "Overdraw");
+  content_context.SetOverdrawHeatmap(true);
+  ASSERT_TRUE(pass.Render(content_context, render_target));
+
+  auto summary = content_context.GetOverdrawSummary();
+  ASSERT_TRUE(summary.has_value());
+  // The collapsed subpass is cropped to the target.
+  ASSERT_NEAR(summary->average_overdraw,
+              (2 * 200 * 200 + 100 * 100 + 100 * 100) / (400.0 * 400.0),
+              kEhCloseEnough);
+  ASSERT_EQ(summary->subpass_count, 1u);
+  ASSERT_EQ(summary->offscreen_pixel_count, 100u * 100u);
+}
+
+TEST_P(EntityTest, ShadowCacheReleasesLeastRecentlyUsedTextures) {
+  auto texture = CreateTextureForFixture("boston.jpg");
+  ShadowCache cache;
+  for (size_t i = 0; i < ShadowCache::kMaxEntries; i++) {
+    cache.Set({.corner_radius = static_cast<Scalar>(i)}, texture);
+  }
+  ASSERT_EQ(cache.GetEntryCount(), ShadowCache::kMaxEntries);
+
+  // Using the first entry makes the second one the least recently used.
+  ASSERT_EQ(cache.Get({.corner_radius = 0}), texture);
+  cache.Set({.corner_radius = 100}, texture);
+  ASSERT_EQ(cache.GetEntryCount(), ShadowCache::kMaxEntries);
+  ASSERT_EQ(cache.Get({.corner_radius = 0}), texture);
+  ASSERT_EQ(cache.Get({.corner_radius = 1}), nullptr);
+  ASSERT_EQ(cache.Get({.corner_radius = 100}), texture);
+}
+
+TEST_P(EntityTest, GradientTexturesAreCachedByColorsAndStops) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+
+  std::vector<Color> colors = {Color::Red(), Color::Blue()};
+  std::vector<Scalar> stops = {0.0, 1.0};
+  auto texture = GetGradientTexture(content_context, colors, stops);
+  ASSERT_TRUE(texture);
+  ASSERT_EQ(GetGradientTexture(content_context, colors, stops), texture);
+  ASSERT_EQ(content_context.GetGradientCache()->GetEntryCount(), 1u);
+
+  std::vector<Scalar> other_stops = {0.0, 0.5};
+  ASSERT_NE(GetGradientTexture(content_context, colors, other_stops), texture);
+  std::vector<Color> other_colors = {Color::Red(), Color::Green()};
+  ASSERT_NE(GetGradientTexture(content_context, other_colors, stops), texture);
+  ASSERT_EQ(content_context.GetGradientCache()->GetEntryCount(), 3u);
+
+  content_context.ReleaseCachedResources();
+  ASSERT_EQ(content_context.GetGradientCache()->GetEntryCount(), 0u);
+}
+
+TEST_P(EntityTest, FilledPathsWithCacheKeyAreTessellatedOnce) {
+  ContentContext content_context(GetContext());
+  ASSERT_TRUE(content_context.IsValid());
+  auto render_target = RenderTarget::CreateOffscreen(
+      *GetContext(), *content_context.GetRenderTargetCache(), ISize(400, 400),
+      "Paths");
+
+  // Two contours, so that the fill is tessellated rather than antialiased
+  // as a convex shape.
+  auto path = PathBuilder{}
+                  .AddRect(Rect::MakeXYWH(10, 10, 100, 100))
+                  .AddCircle({200, 200}, 50)
+                  .TakePath();
+  auto render_path = [&](const Path& path, Matrix transform) {
+    auto contents = std::make_shared<SolidColorContents>();
+    contents->SetGeometry(Geometry::MakeFillPath(path));
+    contents->SetColor(Color::Red());
+    Entity entity;
+    entity.SetContents(std::move(contents));
+    entity.SetTransformation(transform);
+    EntityPass pass;
+    pass.AddEntity(entity);
+    return pass.Render(content_context, render_target);
+  };
+
+  auto& cache = *content_context.GetTessellationCache();
+  ASSERT_TRUE(render_path(path, Matrix()));
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+
+  // Keyed paths are kept from the second time they're drawn.
+  path.SetCacheKey(1);
+  ASSERT_TRUE(render_path(path, Matrix()));
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_TRUE(render_path(path, Matrix()));
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_TRUE(render_path(path, Matrix::MakeTranslation({10, 20})));
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+
+  // Curves are flattened differently at other scales.
+  ASSERT_TRUE(render_path(path, Matrix::MakeScale({2, 2, 1})));
+  ASSERT_EQ(cache.GetEntryCount(), 1u);
+  ASSERT_TRUE(render_path(path, Matrix::MakeScale({2, 2, 1})));
+  ASSERT_EQ(cache.GetEntryCount(), 2u);
+
+  // Changing the path clears its key.
+  path.AddLinearComponent({0, 0}, {10, 10});
+  ASSERT_FALSE(path.GetCacheKey().has_value());
+}
+
+TEST_P(EntityTest, TessellationCacheReleasesLeastRecentlyUsedBuffers) {
+  TessellationCache cache(300);
+  cache.Set({.path_key = 1}, VertexBuffer{}, 100);
+  cache.Set({.path_key = 2}, VertexBuffer{}, 100);
+  cache.Set({.path_key = 3}, VertexBuffer{}, 100);
+  ASSERT_EQ(cache.GetByteSize(), 300u);
+
+  // Using the first entry makes the second one the least recently used.
+  ASSERT_TRUE(cache.Get({.path_key = 1}).has_value());
+  cache.Set({.path_key = 4}, VertexBuffer{}, 100);
+  ASSERT_EQ(cache.GetEntryCount(), 3u);
+  ASSERT_TRUE(cache.Get({.path_key = 1}).has_value());
+  ASSERT_FALSE(cache.Get({.path_key = 2}).has_value());
+  ASSERT_FALSE(cache.Get({.path_key = 1, .scale = 2}).has_value());
+
+  // Buffers larger than the whole budget are never kept.
+  cache.Set({.path_key = 5}, VertexBuffer{}, 400);
+  ASSERT_FALSE(cache.Get({.path_key = 5}).has_value());
+  ASSERT_EQ(cache.GetByteSize(), 300u);
+
+  cache.Clear();
+  ASSERT_EQ(cache.GetEntryCount(), 0u);
+  ASSERT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST_P(EntityTest, TessellationCacheKeepsKeysSeenBefore) {
+  TessellationCache cache;
+  ASSERT_FALSE(cache.ShouldKeep({.path_key = 1}));
+  ASSERT_FALSE(cache.ShouldKeep({.path_key = 1, .scale = 2}));
+  ASSERT_TRUE(cache.ShouldKeep({.path_key = 1}));
+  ASSERT_TRUE(cache.ShouldKeep({.path_key = 1, .scale = 2}));
+
+  // Only a bounded number of keys are remembered.
+  const uint64_t count = TessellationCache::kMaxSeenKeyCount;
+  for (uint64_t i = 0; i <= count; i++) {
+    ASSERT_FALSE(cache.ShouldKeep({.path_key = 100 + i}));
+  }
+  ASSERT_FALSE(cache.ShouldKeep({.path_key = 100}));
+  ASSERT_TRUE(cache.ShouldKeep({.path_key = 100 + count}));
+}
+
+TEST_P(EntityTest, PathCoverageRasterizerBinsEdgesIntoTiles) {
+  using Rasterizer = PathCoverageRasterizer;
+  auto polyline = PathBuilder{}
+                      .AddRect(Rect::MakeXYWH(4, 4, 16, 16))
+                      .TakePath()
+                      .CreatePolyline(1.0f);
+  auto tiles = Rasterizer::BinPolyline(polyline, IRect::MakeXYWH(0, 0, 32, 32));
+  ASSERT_EQ(tiles.tile_count, ISize(2, 2));
+
+  // The left and right edges each cross both tiles of their column.
+  ASSERT_EQ(tiles.positions.size(), 4u);
+  ASSERT_EQ(tiles.infos.size(), 4u);
+  for (size_t tile = 0; tile < 4; tile++) {
+    ASSERT_EQ(tiles.ranges[tile * 2], tile);
+    ASSERT_EQ(tiles.ranges[tile * 2 + 1], 1u);
+  }
+  // The samples inside of the rect are positively wound.
+  ASSERT_EQ(tiles.infos[0].winding, 1);
+  ASSERT_EQ(tiles.infos[1].winding, -1);
+  // The rect starts at y = 4, which is the 17th sample row of the first tile
+  // row.
+  ASSERT_EQ(tiles.infos[0].low_rows_mask, 0xFFFF0000u);
+  ASSERT_EQ(tiles.infos[0].high_rows_mask, 0xFFFFFFFFu);
+
+  // Only the tiles to the right of the left edge have backdrops.
+  auto backdrop = [&](size_t tile, size_t sample_row) {
+    return tiles.backdrops[tile * Rasterizer::kSampleRowsPerTile + sample_row];
+  };
+  ASSERT_EQ(backdrop(0, 20), 0);
+  ASSERT_EQ(backdrop(1, 15), 0);
+  ASSERT_EQ(backdrop(1, 16), 1);
+  ASSERT_EQ(backdrop(3, 15), 1);
+  ASSERT_EQ(backdrop(3, 16), 0);
+}
+
 TEST_P(EntityTest, RRectShadowTest) {
   auto callback = [&](ContentContext& context, RenderPass& pass) {
     static Color color = Color::Red();
@@ -1718,6 +2658,66 @@ TEST_P(EntityTest, ColorMatrixFilterCoverageIsCorrect) {
   ASSERT_RECT_NEAR(actual.value(), expected);
 }
 
+TEST_P(EntityTest, ColorMatrixComposeMatchesSeparatePasses) {
+  // Applies a color matrix to a premultiplied color the way the color matrix
+  // filter shader does.
+  auto apply = [](const FilterContents::ColorMatrix& matrix, Color color) {
+    auto unpremultiplied = color.Unpremultiply();
+    Scalar in[4] = {unpremultiplied.red, unpremultiplied.green,
+                    unpremultiplied.blue, unpremultiplied.alpha};
+    Scalar out[4];
+    for (int row = 0; row < 4; row++) {
+      out[row] = matrix.array[row * 5 + 4];
+      for (int column = 0; column < 4; column++) {
+        out[row] += matrix.array[row * 5 + column] * in[column];
+      }
+      out[row] = std::clamp(out[row], 0.0f, 1.0f);
+    }
+    return Color(out[0], out[1], out[2], out[3]).Premultiply();
+  };
+
+  // Desaturates and halves the alpha.
+  FilterContents::ColorMatrix grayscale = {
+      0.2126, 0.7152, 0.0722, 0, 0,  //
+      0.2126, 0.7152, 0.0722, 0, 0,  //
+      0.2126, 0.7152, 0.0722, 0, 0,  //
+      0,      0,      0,      0.5,    0,  //
+  };
+  // Brightens, which clamps.
+  FilterContents::ColorMatrix brighten = {
+      2, 0, 0, 0, 0.1,  //
+      0, 2, 0, 0, 0.1,  //
+      0, 0, 2, 0, 0.1,  //
+      0, 0, 0, 1, 0,    //
+  };
+
+  auto composed = FilterContents::ColorMatrix::Compose(brighten, grayscale);
+  ASSERT_TRUE(composed.has_value());
+  for (auto color : {Color::Coral(), Color::Blue().WithAlpha(0.25),
+                     Color::White(), Color::BlackTransparent()}) {
+    auto premultiplied = color.Premultiply();
+    auto expected = apply(brighten, apply(grayscale, premultiplied));
+    auto actual = apply(composed.value(), premultiplied);
+    ASSERT_COLOR_NEAR(actual, expected);
+  }
+
+  // The brightened colors are clamped before they would be desaturated.
+  ASSERT_FALSE(
+      FilterContents::ColorMatrix::Compose(grayscale, brighten).has_value());
+
+  // Alpha that doesn't only scale would make transparent pixels opaque.
+  FilterContents::ColorMatrix opaque = {
+      1, 0, 0, 0, 0,  //
+      0, 1, 0, 0, 0,  //
+      0, 0, 1, 0, 0,  //
+      0, 0, 0, 0, 1,  //
+  };
+  ASSERT_FALSE(
+      FilterContents::ColorMatrix::Compose(opaque, grayscale).has_value());
+  ASSERT_FALSE(
+      FilterContents::ColorMatrix::Compose(grayscale, opaque).has_value());
+}
+
 TEST_P(EntityTest, ColorMatrixFilterEditable) {
   auto bay_bridge = CreateTextureForFixture("bay_bridge.jpg");
   ASSERT_TRUE(bay_bridge);
@@ -2120,7 +3120,7 @@ TEST_P(EntityTest, SdfText) {
         "the quick brown fox jumped over the lazy dog (but with sdf).", font);
     auto frame = TextFrameFromTextBlob(blob);
     auto lazy_glyph_atlas = std::make_shared<LazyGlyphAtlas>();
-    lazy_glyph_atlas->AddTextFrame(frame);
+    lazy_glyph_atlas->AddTextFrame(frame, /*signed_distance_field=*/true);
 
     EXPECT_FALSE(lazy_glyph_atlas->HasColor());
 
@@ -2128,14 +3128,14 @@ TEST_P(EntityTest, SdfText) {
     text_contents->SetTextFrame(frame);
     text_contents->SetGlyphAtlas(std::move(lazy_glyph_atlas));
     text_contents->SetColor(Color(1.0, 0.0, 0.0, 1.0));
+    text_contents->SetUseSignedDistanceField(true);
     Entity entity;
     entity.SetTransformation(
         Matrix::MakeTranslation(Vector3{200.0, 200.0, 0.0}) *
         Matrix::MakeScale(GetContentScale()));
     entity.SetContents(text_contents);
 
-    // Force SDF rendering.
-    return text_contents->RenderSdf(context, entity, pass);
+    return text_contents->Render(context, entity, pass);
   };
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
@@ -2304,6 +3304,54 @@ TEST_P(EntityTest, YUVToRGBFilter) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, TextureContentsSamplesYUVPlanes) {
+  if (GetParam() == PlaygroundBackend::kOpenGLES) {
+    // TODO(114588) : Support YUV to RGB filter on OpenGLES backend.
+    GTEST_SKIP_("YUV textures are not supported on OpenGLES backend yet.");
+  }
+
+  // The planes are drawn directly on the left, and through the conversion
+  // pass on the right, which should look the same.
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    YUVColorSpace yuv_color_space_array[2]{YUVColorSpace::kBT601FullRange,
+                                           YUVColorSpace::kBT601LimitedRange};
+    for (int i = 0; i < 2; i++) {
+      auto yuv_color_space = yuv_color_space_array[i];
+      auto textures =
+          CreateTestYUVTextures(GetContext().get(), yuv_color_space);
+
+      Entity entity;
+      auto contents = TextureContents::MakeRect(Rect::MakeLTRB(0, 0, 256, 256));
+      contents->SetTexture(textures[0]);
+      contents->SetYUVTexture(textures[1], yuv_color_space);
+      contents->SetSourceRect(Rect::MakeSize(textures[0]->GetSize()));
+      entity.SetContents(contents);
+      entity.SetTransformation(
+          Matrix::MakeTranslation({100, static_cast<Scalar>(50 + 300 * i)}));
+      entity.Render(context, pass);
+
+      auto filter_contents = FilterContents::MakeYUVToRGBFilter(
+          textures[0], textures[1], yuv_color_space);
+      Entity filter_entity;
+      filter_entity.SetContents(filter_contents);
+      auto snapshot = filter_contents->RenderToSnapshot(context, filter_entity);
+
+      Entity rgb_entity;
+      auto rgb_contents =
+          TextureContents::MakeRect(Rect::MakeLTRB(0, 0, 256, 256));
+      rgb_contents->SetTexture(snapshot->texture);
+      rgb_contents->SetSourceRect(
+          Rect::MakeSize(snapshot->texture->GetSize()));
+      rgb_entity.SetContents(rgb_contents);
+      rgb_entity.SetTransformation(
+          Matrix::MakeTranslation({500, static_cast<Scalar>(50 + 300 * i)}));
+      rgb_entity.Render(context, pass);
+    }
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
 TEST_P(EntityTest, RuntimeEffect) {
   if (GetParam() != PlaygroundBackend::kMetal) {
     GTEST_SKIP_("This test only has a Metal fixture at the moment.");
@@ -2345,5 +3393,44 @@ TEST_P(EntityTest, RuntimeEffect) {
   ASSERT_TRUE(OpenPlaygroundHere(callback));
 }
 
+TEST_P(EntityTest, RenderTargetCacheReusesReleasedTextures) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+
+  cache.Start();
+  auto target = RenderTarget::CreateOffscreen(*GetContext(), cache,
+                                              ISize(100, 100), "Test");
+  ASSERT_TRUE(target.IsValid());
+  auto texture = target.GetRenderTargetTexture().get();
+  // The color and stencil textures.
+  ASSERT_EQ(cache.CachedTextureCount(), 2u);
+  cache.End();
+
+  cache.Start();
+  target = RenderTarget();
+  auto reused_target = RenderTarget::CreateOffscreen(*GetContext(), cache,
+                                                     ISize(100, 100), "Test");
+  ASSERT_EQ(reused_target.GetRenderTargetTexture().get(), texture);
+  ASSERT_EQ(cache.CachedTextureCount(), 2u);
+
+  // Textures that are still held are not handed out again.
+  auto other_target = RenderTarget::CreateOffscreen(*GetContext(), cache,
+                                                    ISize(100, 100), "Test");
+  ASSERT_NE(other_target.GetRenderTargetTexture().get(), texture);
+  ASSERT_EQ(cache.CachedTextureCount(), 4u);
+
+  // Nor are textures of other sizes.
+  reused_target = RenderTarget();
+  auto large_target = RenderTarget::CreateOffscreen(*GetContext(), cache,
+                                                    ISize(200, 200), "Test");
+  ASSERT_EQ(cache.CachedTextureCount(), 6u);
+  ASSERT_GT(cache.CachedTextureBytes(), 0u);
+  cache.End();
+
+  // Textures that are not used during a frame are released.
+  cache.Start();
+  cache.End();
+  ASSERT_EQ(cache.CachedTextureCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -3,10 +3,21 @@
 // found in the LICENSE file.
 
 #include "impeller/entity/geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
 #include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/path_coverage_rasterizer.h"
 #include "impeller/entity/position_color.vert.h"
+#include "impeller/entity/solid_fill_coverage.vert.h"
+#include "impeller/entity/tessellation_cache.h"
 #include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/context.h"
 #include "impeller/renderer/device_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/tessellator/tessellator.h"
@@ -25,6 +36,206 @@ GeometryResult Geometry::GetPositionUVBuffer(Rect texture_coverage,
   return {};
 }
 
+bool Geometry::CoversArea(const Matrix& transform, const Rect& rect) const {
+  return false;
+}
+
+bool Geometry::CoversPixelsOnce() const {
+  return false;
+}
+
+bool Geometry::AppendFillTriangles(const ContentContext& renderer,
+                                   const Matrix& transform,
+                                   std::vector<Point>& vertices,
+                                   std::vector<uint16_t>& indices) const {
+  return false;
+}
+
+bool Geometry::CanAntialiasWithCoverage(const Matrix& transform) const {
+  return false;
+}
+
+GeometryResult Geometry::GetPositionCoverageBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  return {};
+}
+
+std::optional<Snapshot> Geometry::GetSolidFillSnapshot(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    Color color) const {
+  return std::nullopt;
+}
+
+std::optional<StrokeExtrusionResult> Geometry::GetStrokeExtrusionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  return std::nullopt;
+}
+
+static bool CanAppendVertices(const std::vector<Point>& vertices,
+                              size_t count) {
+  return vertices.size() + count <=
+         static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1;
+}
+
+/// Creates the vertices of a convex polygon whose points are in the space of
+/// the render target, antialiased by ramping the coverage down from one to zero
+/// across a one pixel wide band centered on its edges.
+///
+/// The band is made of an inner polygon that is inset by half a pixel and an
+/// outer polygon that is outset by half a pixel. Returns an empty vertex
+/// buffer if the polygon has no area.
+static VertexBuffer CreateCoverageConvexPolygon(std::vector<Point> points,
+                                                HostBuffer& host_buffer) {
+  using VS = SolidFillCoverageVertexShader;
+
+  // Repeated points would have no edge normal, and the contour may end with
+  // the point that it started at.
+  auto is_same_point = [](const Point& a, const Point& b) {
+    return (a - b).GetLengthSquared() < kEhCloseEnough * kEhCloseEnough;
+  };
+  points.erase(std::unique(points.begin(), points.end(), is_same_point),
+               points.end());
+  while (points.size() > 1 && is_same_point(points.front(), points.back())) {
+    points.pop_back();
+  }
+  const size_t count = points.size();
+  if (count < 3 || count * 2 > std::numeric_limits<uint16_t>::max()) {
+    return {};
+  }
+
+  Scalar area = 0;
+  for (size_t i = 0; i < count; i++) {
+    area += points[i].Cross(points[(i + 1) % count]);
+  }
+  if (area == 0) {
+    return {};
+  }
+  // Wind the points so that the interior is to the left of each edge, which
+  // puts the outward normal of an edge on its right.
+  if (area < 0) {
+    std::reverse(points.begin(), points.end());
+  }
+
+  auto outward_normal = [&points, count](size_t from) {
+    auto edge = points[(from + 1) % count] - points[from];
+    return Vector2(edge.y, -edge.x).Normalize();
+  };
+
+  // The offset of the corners of the outer polygon is limited so that very
+  // sharp corners don't produce long spikes.
+  constexpr Scalar kMaxCornerOffset = 4.0;
+
+  VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+  vtx_builder.Reserve(count * 2);
+  vtx_builder.ReserveIndices((count - 2) * 3 + count * 6);
+  auto previous_normal = outward_normal(count - 1);
+  for (size_t i = 0; i < count; i++) {
+    auto next_normal = outward_normal(i);
+    // The offset whose distance to both of the edges meeting at the corner is
+    // one.
+    auto offset = (previous_normal + next_normal) /
+                  (1 + previous_normal.Dot(next_normal));
+    if (offset.GetLength() > kMaxCornerOffset) {
+      offset = offset.Normalize() * kMaxCornerOffset;
+    }
+    vtx_builder.AppendVertex({.position = points[i] - offset * 0.5,
+                              .coverage = 1.0});
+    vtx_builder.AppendVertex({.position = points[i] + offset * 0.5,
+                              .coverage = 0.0});
+    previous_normal = next_normal;
+  }
+
+  // The inner polygon is triangulated as a fan, its vertices have even
+  // indices.
+  for (uint16_t i = 1; i + 1 < count; i++) {
+    vtx_builder.AppendIndex(0);
+    vtx_builder.AppendIndex(i * 2);
+    vtx_builder.AppendIndex((i + 1) * 2);
+  }
+  // Each edge of the band is a quad between the inner and outer polygons.
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t inner = i * 2;
+    uint16_t next_inner = ((i + 1) % count) * 2;
+    vtx_builder.AppendIndex(inner);
+    vtx_builder.AppendIndex(inner + 1);
+    vtx_builder.AppendIndex(next_inner + 1);
+    vtx_builder.AppendIndex(inner);
+    vtx_builder.AppendIndex(next_inner + 1);
+    vtx_builder.AppendIndex(next_inner);
+  }
+  return vtx_builder.CreateVertexBuffer(host_buffer);
+}
+
+/// Whether the path is a single contour that turns in one direction only, and
+/// at most once around. Curves lie within the polygon of their control
+/// points and turn no more than it does, so the control points are included
+/// and the polyline of a convex path is always convex too.
+static bool IsConvexPath(const Path& path) {
+  std::vector<Point> points;
+  bool contour_ended = false;
+  bool is_single_contour = true;
+  auto add_point = [&](Point point) {
+    if (contour_ended) {
+      is_single_contour = false;
+    }
+    if (points.empty() || points.back() != point) {
+      points.push_back(point);
+    }
+  };
+  path.EnumerateComponents(
+      [&](size_t index, const LinearPathComponent& linear) {
+        add_point(linear.p1);
+        add_point(linear.p2);
+      },
+      [&](size_t index, const QuadraticPathComponent& quad) {
+        add_point(quad.p1);
+        add_point(quad.cp);
+        add_point(quad.p2);
+      },
+      [&](size_t index, const CubicPathComponent& cubic) {
+        add_point(cubic.p1);
+        add_point(cubic.cp1);
+        add_point(cubic.cp2);
+        add_point(cubic.p2);
+      },
+      [&](size_t index, const ContourComponent& contour) {
+        contour_ended = !points.empty();
+      });
+  if (!is_single_contour) {
+    return false;
+  }
+  while (points.size() > 1 && points.front() == points.back()) {
+    points.pop_back();
+  }
+  const size_t count = points.size();
+  if (count < 3) {
+    return false;
+  }
+
+  Scalar direction = 0;
+  Scalar total_turn = 0;
+  for (size_t i = 0; i < count; i++) {
+    auto edge = points[(i + 1) % count] - points[i];
+    auto next_edge = points[(i + 2) % count] - points[(i + 1) % count];
+    auto cross = edge.Cross(next_edge);
+    if (cross != 0) {
+      if (cross * direction < 0) {
+        return false;
+      }
+      direction = cross;
+    }
+    total_turn += std::atan2(cross, edge.Dot(next_edge));
+  }
+  // A star turns in one direction too, but more than once around.
+  return std::abs(total_turn) < kPi * 2 + kEhCloseEnough;
+}
+
 // static
 std::unique_ptr<Geometry> Geometry::MakeFillPath(const Path& path) {
   return std::make_unique<FillPathGeometry>(path);
@@ -51,38 +262,107 @@ std::unique_ptr<Geometry> Geometry::MakeRect(Rect rect) {
   return std::make_unique<RectGeometry>(rect);
 }
 
+std::unique_ptr<Geometry> Geometry::MakeRRect(Rect rect, Size corner_radii) {
+  return std::make_unique<RRectGeometry>(rect, corner_radii);
+}
+
+std::unique_ptr<Geometry> Geometry::MakeCircle(Point center, Scalar radius) {
+  Size radii(radius, radius);
+  return std::make_unique<RRectGeometry>(Rect(center - radii, radii * 2),
+                                         radii);
+}
+
 /////// Path Geometry ///////
 
 FillPathGeometry::FillPathGeometry(const Path& path) : path_(path) {}
 
 FillPathGeometry::~FillPathGeometry() = default;
 
+/// Copy the tessellated vertices of a path into device buffers that outlive
+/// the frame.
+static std::optional<VertexBuffer> CreateCachedVertexBuffer(
+    Allocator& allocator,
+    const float* vertices,
+    size_t vertices_count,
+    const uint16_t* indices,
+    size_t indices_count) {
+  auto device_vertices = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(vertices),
+      vertices_count * sizeof(float));
+  auto device_indices = allocator.CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(indices),
+      indices_count * sizeof(uint16_t));
+  if (!device_vertices || !device_indices) {
+    return std::nullopt;
+  }
+  device_vertices->SetLabel("Cached Path Vertices");
+  device_indices->SetLabel("Cached Path Indices");
+  return VertexBuffer{
+      .vertex_buffer = device_vertices->AsBufferView(),
+      .index_buffer = device_indices->AsBufferView(),
+      .index_count = indices_count,
+      .index_type = IndexType::k16bit,
+  };
+}
+
 GeometryResult FillPathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
-  VertexBuffer vertex_buffer;
-  auto& host_buffer = pass.GetTransientsBuffer();
-  auto tesselation_result = renderer.GetTessellator()->Tessellate(
-      path_.GetFillType(),
-      path_.CreatePolyline(entity.GetTransformation().GetMaxBasisLength()),
-      [&vertex_buffer, &host_buffer](
-          const float* vertices, size_t vertices_count, const uint16_t* indices,
-          size_t indices_count) {
-        vertex_buffer.vertex_buffer = host_buffer.Emplace(
-            vertices, vertices_count * sizeof(float), alignof(float));
-        vertex_buffer.index_buffer = host_buffer.Emplace(
-            indices, indices_count * sizeof(uint16_t), alignof(uint16_t));
-        vertex_buffer.index_count = indices_count;
-        vertex_buffer.index_type = IndexType::k16bit;
-        return true;
-      });
-  if (tesselation_result != Tessellator::Result::kSuccess) {
-    return {};
+  const auto scale = entity.GetTransformation().GetMaxBasisLength();
+
+  // Paths that are drawn again in later frames have a cache key, and their
+  // vertices are kept from the second time they're drawn at a scale.
+  std::optional<TessellationCache::Key> cache_key;
+  if (auto path_key = path_.GetCacheKey(); path_key.has_value()) {
+    cache_key = TessellationCache::Key{.path_key = path_key.value(),
+                                       .fill_type = path_.GetFillType(),
+                                       .scale = scale};
+  }
+  auto& cache = *renderer.GetTessellationCache();
+
+  std::optional<VertexBuffer> vertex_buffer;
+  if (cache_key.has_value()) {
+    vertex_buffer = cache.Get(cache_key.value());
+  }
+  if (!vertex_buffer.has_value()) {
+    auto& host_buffer = pass.GetTransientsBuffer();
+    auto& allocator = *renderer.GetContext()->GetResourceAllocator();
+    const bool keep =
+        cache_key.has_value() && cache.ShouldKeep(cache_key.value());
+    auto tesselation_result = renderer.GetTessellator()->Tessellate(
+        path_.GetFillType(), path_.CreatePolyline(scale),
+        [&](const float* vertices, size_t vertices_count,
+            const uint16_t* indices, size_t indices_count) {
+          if (keep) {
+            vertex_buffer = CreateCachedVertexBuffer(
+                allocator, vertices, vertices_count, indices, indices_count);
+            if (vertex_buffer.has_value()) {
+              cache.Set(cache_key.value(), vertex_buffer.value(),
+                        vertices_count * sizeof(float) +
+                            indices_count * sizeof(uint16_t));
+              return true;
+            }
+          }
+          vertex_buffer = VertexBuffer{
+              .vertex_buffer = host_buffer.Emplace(
+                  vertices, vertices_count * sizeof(float), alignof(float)),
+              .index_buffer = host_buffer.Emplace(
+                  indices, indices_count * sizeof(uint16_t),
+                  alignof(uint16_t)),
+              .index_count = indices_count,
+              .index_type = IndexType::k16bit,
+          };
+          return true;
+        });
+    if (tesselation_result != Tessellator::Result::kSuccess ||
+        !vertex_buffer.has_value()) {
+      return {};
+    }
   }
   return GeometryResult{
       .type = PrimitiveType::kTriangle,
-      .vertex_buffer = vertex_buffer,
+      .vertex_buffer = vertex_buffer.value(),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
                    entity.GetTransformation(),
       .prevent_overdraw = false,
@@ -98,6 +378,99 @@ std::optional<Rect> FillPathGeometry::GetCoverage(
   return path_.GetTransformedBoundingBox(transform);
 }
 
+bool FillPathGeometry::CoversPixelsOnce() const {
+  // The tessellated triangles of a fill never overlap.
+  return true;
+}
+
+bool FillPathGeometry::AppendFillTriangles(
+    const ContentContext& renderer,
+    const Matrix& transform,
+    std::vector<Point>& vertices,
+    std::vector<uint16_t>& indices) const {
+  auto tesselation_result = renderer.GetTessellator()->Tessellate(
+      path_.GetFillType(), path_.CreatePolyline(transform.GetMaxBasisLength()),
+      [&transform, &vertices, &indices](
+          const float* tessellated_vertices, size_t vertices_count,
+          const uint16_t* tessellated_indices, size_t indices_count) {
+        // The vertices are pairs of floats.
+        size_t point_count = vertices_count / 2;
+        if (!CanAppendVertices(vertices, point_count)) {
+          return false;
+        }
+        auto base = static_cast<uint16_t>(vertices.size());
+        for (size_t i = 0; i < point_count; i++) {
+          Point point(tessellated_vertices[i * 2],
+                      tessellated_vertices[i * 2 + 1]);
+          vertices.push_back(transform * point);
+        }
+        for (size_t i = 0; i < indices_count; i++) {
+          indices.push_back(base + tessellated_indices[i]);
+        }
+        return true;
+      });
+  return tesselation_result == Tessellator::Result::kSuccess;
+}
+
+bool FillPathGeometry::CanAntialiasWithCoverage(const Matrix& transform) const {
+  // A single convex contour has a winding number of either one or minus one
+  // inside of it, depending on its direction.
+  if (!transform.IsAffine() || (path_.GetFillType() != FillType::kNonZero &&
+                                path_.GetFillType() != FillType::kOdd)) {
+    return false;
+  }
+  if (!is_convex_.has_value()) {
+    is_convex_ = IsConvexPath(path_);
+  }
+  return is_convex_.value();
+}
+
+GeometryResult FillPathGeometry::GetPositionCoverageBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  const auto& transform = entity.GetTransformation();
+  auto polyline = path_.CreatePolyline(transform.GetMaxBasisLength());
+  transform.TransformPoints(polyline.points.data(), polyline.points.data(),
+                            polyline.points.size());
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = CreateCoverageConvexPolygon(std::move(polyline.points),
+                                                   pass.GetTransientsBuffer()),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()),
+      .prevent_overdraw = false,
+  };
+}
+
+std::optional<Snapshot> FillPathGeometry::GetSolidFillSnapshot(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass,
+    Color color) const {
+  if (path_.GetComponentCount() < PathCoverageRasterizer::kMinComponentCount) {
+    return std::nullopt;
+  }
+  const auto& transform = entity.GetTransformation();
+  const auto scale = transform.GetMaxBasisLength();
+  // Cached vertices are cheaper to draw than rasterizing the path again.
+  if (auto path_key = path_.GetCacheKey(); path_key.has_value() &&
+      renderer.GetTessellationCache()
+          ->Get(TessellationCache::Key{.path_key = path_key.value(),
+                                       .fill_type = path_.GetFillType(),
+                                       .scale = scale})
+          .has_value()) {
+    return std::nullopt;
+  }
+  auto polyline = path_.CreatePolyline(scale);
+  if (!PathCoverageRasterizer::ShouldRasterize(renderer, polyline,
+                                               transform)) {
+    return std::nullopt;
+  }
+  return PathCoverageRasterizer::Rasterize(renderer, polyline,
+                                           path_.GetFillType(), transform,
+                                           pass.GetRenderTargetSize(), color);
+}
+
 ///// Stroke Geometry //////
 
 StrokePathGeometry::StrokePathGeometry(const Path& path,
@@ -131,18 +504,19 @@ Join StrokePathGeometry::GetStrokeJoin() const {
 
 // static
 Scalar StrokePathGeometry::CreateBevelAndGetDirection(
-    VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
+    VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
     const Point& position,
     const Point& start_offset,
     const Point& end_offset) {
-  SolidFillVertexShader::PerVertexData vtx;
+  VS::PerVertexData vtx;
   vtx.position = position;
+  vtx.offset = Point();
   vtx_builder.AppendVertex(vtx);
 
   Scalar dir = start_offset.Cross(end_offset) > 0 ? -1 : 1;
-  vtx.position = position + start_offset * dir;
+  vtx.offset = start_offset * dir;
   vtx_builder.AppendVertex(vtx);
-  vtx.position = position + end_offset * dir;
+  vtx.offset = end_offset * dir;
   vtx_builder.AppendVertex(vtx);
 
   return dir;
@@ -150,7 +524,6 @@ Scalar StrokePathGeometry::CreateBevelAndGetDirection(
 
 // static
 StrokePathGeometry::JoinProc StrokePathGeometry::GetJoinProc(Join stroke_join) {
-  using VS = SolidFillVertexShader;
   StrokePathGeometry::JoinProc join_proc;
   switch (stroke_join) {
     case Join::kBevel:
@@ -187,7 +560,8 @@ StrokePathGeometry::JoinProc StrokePathGeometry::GetJoinProc(Join stroke_join) {
 
         // Outer miter point.
         VS::PerVertexData vtx;
-        vtx.position = position + miter_point * dir;
+        vtx.position = position;
+        vtx.offset = miter_point * dir;
         vtx_builder.AppendVertex(vtx);
       };
       break;
@@ -225,10 +599,11 @@ StrokePathGeometry::JoinProc StrokePathGeometry::GetJoinProc(Join stroke_join) {
                               .CreatePolyline(scale);
 
         VS::PerVertexData vtx;
+        vtx.position = position;
         for (const auto& point : arc_points) {
-          vtx.position = position + point * dir;
+          vtx.offset = point * dir;
           vtx_builder.AppendVertex(vtx);
-          vtx.position = position + (-point * dir).Reflect(middle_normal);
+          vtx.offset = (-point * dir).Reflect(middle_normal);
           vtx_builder.AppendVertex(vtx);
         }
       };
@@ -239,16 +614,16 @@ StrokePathGeometry::JoinProc StrokePathGeometry::GetJoinProc(Join stroke_join) {
 
 // static
 StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
-  using VS = SolidFillVertexShader;
   StrokePathGeometry::CapProc cap_proc;
   switch (stroke_cap) {
     case Cap::kButt:
       cap_proc = [](VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
                     const Point& position, const Point& offset, Scalar scale) {
         VS::PerVertexData vtx;
-        vtx.position = position + offset;
+        vtx.position = position;
+        vtx.offset = offset;
         vtx_builder.AppendVertex(vtx);
-        vtx.position = position - offset;
+        vtx.offset = -offset;
         vtx_builder.AppendVertex(vtx);
       };
       break;
@@ -266,14 +641,15 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
                 forward + offset * PathBuilder::kArcApproximationMagic, forward)
                 .CreatePolyline(scale);
 
-        vtx.position = position + offset;
+        vtx.position = position;
+        vtx.offset = offset;
         vtx_builder.AppendVertex(vtx);
-        vtx.position = position - offset;
+        vtx.offset = -offset;
         vtx_builder.AppendVertex(vtx);
         for (const auto& point : arc_points) {
-          vtx.position = position + point;
+          vtx.offset = point;
           vtx_builder.AppendVertex(vtx);
-          vtx.position = position + (-point).Reflect(forward_normal);
+          vtx.offset = (-point).Reflect(forward_normal);
           vtx_builder.AppendVertex(vtx);
         }
       };
@@ -285,13 +661,14 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
 
         Point forward(offset.y, -offset.x);
 
-        vtx.position = position + offset;
+        vtx.position = position;
+        vtx.offset = offset;
         vtx_builder.AppendVertex(vtx);
-        vtx.position = position - offset;
+        vtx.offset = -offset;
         vtx_builder.AppendVertex(vtx);
-        vtx.position = position + offset + forward;
+        vtx.offset = offset + forward;
         vtx_builder.AppendVertex(vtx);
-        vtx.position = position - offset + forward;
+        vtx.offset = -offset + forward;
         vtx_builder.AppendVertex(vtx);
       };
       break;
@@ -300,15 +677,15 @@ StrokePathGeometry::CapProc StrokePathGeometry::GetCapProc(Cap stroke_cap) {
 }
 
 // static
-VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
+VertexBufferBuilder<StrokePathGeometry::VS::PerVertexData>
+StrokePathGeometry::CreateStrokeExtrusionVertices(
     const Path& path,
-    HostBuffer& buffer,
-    Scalar stroke_width,
-    Scalar scaled_miter_limit,
+    Scalar miter_limit,
     Cap cap,
     const StrokePathGeometry::JoinProc& join_proc,
     const StrokePathGeometry::CapProc& cap_proc,
-    Scalar scale) {
+    Scalar scale,
+    Scalar arc_scale) {
   VertexBufferBuilder<VS::PerVertexData> vtx_builder;
   auto polyline = path.CreatePolyline(scale);
 
@@ -318,12 +695,13 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
   Point offset;
   Point previous_offset;  // Used for computing joins.
 
-  auto compute_offset = [&polyline, &offset, &previous_offset,
-                         &stroke_width](size_t point_i) {
+  // The offsets are in units of half the stroke width.
+  auto compute_offset = [&polyline, &offset,
+                         &previous_offset](size_t point_i) {
     previous_offset = offset;
     Point direction =
         (polyline.points[point_i] - polyline.points[point_i - 1]).Normalize();
-    offset = Vector2{-direction.y, direction.x} * stroke_width * 0.5;
+    offset = Vector2{-direction.y, direction.x};
   };
 
   for (size_t contour_i = 0; contour_i < polyline.contours.size();
@@ -336,8 +714,8 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
     switch (contour_end_point_i - contour_start_point_i) {
       case 1: {
         Point p = polyline.points[contour_start_point_i];
-        cap_proc(vtx_builder, p, {-stroke_width * 0.5f, 0}, scale);
-        cap_proc(vtx_builder, p, {stroke_width * 0.5f, 0}, scale);
+        cap_proc(vtx_builder, p, {-1, 0}, arc_scale);
+        cap_proc(vtx_builder, p, {1, 0}, arc_scale);
         continue;
       }
       case 0:
@@ -359,6 +737,7 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
       // contours with two zero volume triangles, which will be discarded by
       // the rasterizer).
       vtx.position = polyline.points[contour_start_point_i - 1];
+      vtx.offset = Point();
       // Append two vertices when "picking up" the pen so that the triangle
       // drawn when moving to the beginning of the new contour will have zero
       // volume.
@@ -366,6 +745,7 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
       vtx_builder.AppendVertex(vtx);
 
       vtx.position = polyline.points[contour_start_point_i];
+      vtx.offset = Point();
       // Append two vertices at the beginning of the new contour, which
       // appends  two triangles of zero area.
       vtx_builder.AppendVertex(vtx);
@@ -382,22 +762,25 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
         direction =
             Vector2(-contour.start_direction.y, contour.start_direction.x);
       }
-      auto cap_offset = direction * stroke_width * 0.5;
-      cap_proc(vtx_builder, polyline.points[contour_start_point_i], cap_offset,
-               scale);
+      cap_proc(vtx_builder, polyline.points[contour_start_point_i], direction,
+               arc_scale);
     }
 
     // Generate contour geometry.
     for (size_t point_i = contour_start_point_i + 1;
          point_i < contour_end_point_i; point_i++) {
       // Generate line rect.
-      vtx.position = polyline.points[point_i - 1] + offset;
+      vtx.position = polyline.points[point_i - 1];
+      vtx.offset = offset;
       vtx_builder.AppendVertex(vtx);
-      vtx.position = polyline.points[point_i - 1] - offset;
+      vtx.position = polyline.points[point_i - 1];
+      vtx.offset = -offset;
       vtx_builder.AppendVertex(vtx);
-      vtx.position = polyline.points[point_i] + offset;
+      vtx.position = polyline.points[point_i];
+      vtx.offset = offset;
       vtx_builder.AppendVertex(vtx);
-      vtx.position = polyline.points[point_i] - offset;
+      vtx.position = polyline.points[point_i];
+      vtx.offset = -offset;
       vtx_builder.AppendVertex(vtx);
 
       if (point_i < contour_end_point_i - 1) {
@@ -405,56 +788,147 @@ VertexBuffer StrokePathGeometry::CreateSolidStrokeVertices(
 
         // Generate join from the current line to the next line.
         join_proc(vtx_builder, polyline.points[point_i], previous_offset,
-                  offset, scaled_miter_limit, scale);
+                  offset, miter_limit, arc_scale);
       }
     }
 
     // Generate end cap or join.
     if (!polyline.contours[contour_i].is_closed) {
       auto cap_offset =
-          Vector2(-contour.end_direction.y, contour.end_direction.x) *
-          stroke_width * 0.5;
+          Vector2(-contour.end_direction.y, contour.end_direction.x);
       cap_proc(vtx_builder, polyline.points[contour_end_point_i - 1],
-               cap_offset, scale);
+               cap_offset, arc_scale);
     } else {
       join_proc(vtx_builder, polyline.points[contour_start_point_i], offset,
-                contour_first_offset, scaled_miter_limit, scale);
+                contour_first_offset, miter_limit, arc_scale);
     }
   }
 
-  return vtx_builder.CreateVertexBuffer(buffer);
+  return vtx_builder;
+}
+
+std::optional<Scalar> StrokePathGeometry::GetHalfWidth(
+    const Matrix& transform) const {
+  if (stroke_width_ < 0.0) {
+    return std::nullopt;
+  }
+  auto determinant = transform.GetDeterminant();
+  if (determinant == 0) {
+    return std::nullopt;
+  }
+
+  Scalar min_size = 1.0f / sqrt(std::abs(determinant));
+  return std::max(stroke_width_, min_size) * 0.5f;
 }
 
 GeometryResult StrokePathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) {
-  if (stroke_width_ < 0.0) {
-    return {};
-  }
-  auto determinant = entity.GetTransformation().GetDeterminant();
-  if (determinant == 0) {
+  const auto& transform = entity.GetTransformation();
+  auto half_width = GetHalfWidth(transform);
+  if (!half_width.has_value()) {
     return {};
   }
 
-  Scalar min_size = 1.0f / sqrt(std::abs(determinant));
-  Scalar stroke_width = std::max(stroke_width_, min_size);
+  const auto scale = transform.GetMaxBasisLength();
+  auto extrusion_builder = CreateStrokeExtrusionVertices(
+      path_, miter_limit_, stroke_cap_, GetJoinProc(stroke_join_),
+      GetCapProc(stroke_cap_), scale, scale * half_width.value());
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  auto vertex_buffer = CreateSolidStrokeVertices(
-      path_, host_buffer, stroke_width, miter_limit_ * stroke_width_ * 0.5,
-      stroke_cap_, GetJoinProc(stroke_join_), GetCapProc(stroke_cap_),
-      entity.GetTransformation().GetMaxBasisLength());
+  // Contents other than solid colors draw positions, so the vertices are
+  // extruded here instead of in the vertex shader.
+  VertexBufferBuilder<SolidFillVertexShader::PerVertexData> vtx_builder;
+  vtx_builder.Reserve(extrusion_builder.GetVertexCount());
+  extrusion_builder.IterateVertices([&](const VS::PerVertexData& vertex) {
+    vtx_builder.AppendVertex(
+        {.position = vertex.position + vertex.offset * half_width.value()});
+  });
 
+  auto& host_buffer = pass.GetTransientsBuffer();
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
-      .vertex_buffer = vertex_buffer,
+      .vertex_buffer = vtx_builder.CreateVertexBuffer(host_buffer),
       .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
-                   entity.GetTransformation(),
+                   transform,
       .prevent_overdraw = true,
   };
 }
 
+std::optional<StrokeExtrusionResult>
+StrokePathGeometry::GetStrokeExtrusionBuffer(const ContentContext& renderer,
+                                             const Entity& entity,
+                                             RenderPass& pass) {
+  const auto& transform = entity.GetTransformation();
+  auto half_width = GetHalfWidth(transform);
+  if (!half_width.has_value()) {
+    return std::nullopt;
+  }
+
+  // Only round joins and caps depend on the width, through the number of
+  // points they are flattened to. They are flattened for the next power of
+  // two of the half width on screen, so that the vertices of a stroke whose
+  // width animates can be reused for many frames.
+  const auto scale = transform.GetMaxBasisLength();
+  const bool has_arcs =
+      stroke_join_ == Join::kRound || stroke_cap_ == Cap::kRound;
+  int32_t arc_exponent = 0;
+  if (has_arcs) {
+    arc_exponent = std::clamp(
+        static_cast<int32_t>(std::ceil(std::log2(scale * half_width.value()))),
+        -64, 64);
+  }
+  const Scalar arc_scale = std::exp2(static_cast<Scalar>(arc_exponent));
+
+  std::optional<TessellationCache::Key> cache_key;
+  if (auto path_key = path_.GetCacheKey(); path_key.has_value()) {
+    uint32_t miter_limit_bits;
+    static_assert(sizeof(miter_limit_bits) == sizeof(miter_limit_));
+    memcpy(&miter_limit_bits, &miter_limit_, sizeof(miter_limit_bits));
+    const uint64_t stroke_style =
+        1u | (static_cast<uint64_t>(stroke_cap_) << 1) |
+        (static_cast<uint64_t>(stroke_join_) << 3) |
+        (static_cast<uint64_t>(arc_exponent + 128) << 8) |
+        (static_cast<uint64_t>(miter_limit_bits) << 32);
+    cache_key = TessellationCache::Key{.path_key = path_key.value(),
+                                       .scale = scale,
+                                       .stroke_style = stroke_style};
+  }
+  auto& cache = *renderer.GetTessellationCache();
+
+  std::optional<VertexBuffer> vertex_buffer;
+  if (cache_key.has_value()) {
+    vertex_buffer = cache.Get(cache_key.value());
+  }
+  if (!vertex_buffer.has_value()) {
+    auto vtx_builder = CreateStrokeExtrusionVertices(
+        path_, miter_limit_, stroke_cap_, GetJoinProc(stroke_join_),
+        GetCapProc(stroke_cap_), scale, arc_scale);
+    if (cache_key.has_value() && cache.ShouldKeep(cache_key.value())) {
+      vtx_builder.SetLabel("Cached Stroke");
+      auto device_buffer = vtx_builder.CreateVertexBuffer(
+          *renderer.GetContext()->GetResourceAllocator());
+      if (device_buffer) {
+        cache.Set(cache_key.value(), device_buffer,
+                  vtx_builder.GetVertexCount() *
+                      (sizeof(VS::PerVertexData) + sizeof(uint16_t)));
+        vertex_buffer = device_buffer;
+      }
+    }
+    if (!vertex_buffer.has_value()) {
+      auto& host_buffer = pass.GetTransientsBuffer();
+      vertex_buffer = vtx_builder.CreateVertexBuffer(host_buffer);
+    }
+  }
+
+  return StrokeExtrusionResult{
+      .vertex_buffer = vertex_buffer.value(),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   transform,
+      .half_width = half_width.value(),
+  };
+}
+
 GeometryVertexType StrokePathGeometry::GetVertexType() const {
   return GeometryVertexType::kPosition;
 }
@@ -487,6 +961,12 @@ std::optional<Rect> StrokePathGeometry::GetCoverage(
                    path_coverage.size.height + max_radius_xy.y * 2));
 }
 
+bool StrokePathGeometry::CoversPixelsOnce() const {
+  // The segments of a stroke overlap, but overdraw is prevented with the
+  // stencil.
+  return true;
+}
+
 /////// Cover Geometry ///////
 
 CoverGeometry::CoverGeometry() = default;
@@ -523,6 +1003,15 @@ std::optional<Rect> CoverGeometry::GetCoverage(const Matrix& transform) const {
   return Rect::MakeMaximum();
 }
 
+bool CoverGeometry::CoversArea(const Matrix& transform,
+                               const Rect& rect) const {
+  return true;
+}
+
+bool CoverGeometry::CoversPixelsOnce() const {
+  return true;
+}
+
 /////// Rect Geometry ///////
 
 RectGeometry::RectGeometry(Rect rect) : rect_(rect) {}
@@ -559,4 +1048,298 @@ std::optional<Rect> RectGeometry::GetCoverage(const Matrix& transform) const {
   return rect_.TransformBounds(transform);
 }
 
+bool RectGeometry::CoversArea(const Matrix& transform,
+                              const Rect& rect) const {
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  return rect_.TransformBounds(transform).Contains(rect);
+}
+
+bool RectGeometry::CoversPixelsOnce() const {
+  return true;
+}
+
+bool RectGeometry::AppendFillTriangles(const ContentContext& renderer,
+                                       const Matrix& transform,
+                                       std::vector<Point>& vertices,
+                                       std::vector<uint16_t>& indices) const {
+  if (!CanAppendVertices(vertices, 4)) {
+    return false;
+  }
+  auto base = static_cast<uint16_t>(vertices.size());
+  for (const auto& point : rect_.GetPoints()) {
+    vertices.push_back(transform * point);
+  }
+  // The points are ordered to be drawn as a triangle strip.
+  for (uint16_t index : {0, 1, 2, 1, 2, 3}) {
+    indices.push_back(base + index);
+  }
+  return true;
+}
+
+bool RectGeometry::CanAntialiasWithCoverage(const Matrix& transform) const {
+  return transform.IsAffine();
+}
+
+GeometryResult RectGeometry::GetPositionCoverageBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  const auto& transform = entity.GetTransformation();
+  auto points = rect_.GetPoints();
+  // The points are ordered to be drawn as a triangle strip, rather than going
+  // around the rect.
+  std::vector<Point> polygon = {transform * points[0], transform * points[1],
+                                transform * points[3], transform * points[2]};
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = CreateCoverageConvexPolygon(std::move(polygon),
+                                                   pass.GetTransientsBuffer()),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()),
+      .prevent_overdraw = false,
+  };
+}
+
+/////// RRect Geometry ///////
+
+/// The largest number of segments that a quarter of an ellipse is divided
+/// into, which allows for radii of many thousands of pixels.
+static constexpr size_t kMaxQuadrantDivisions = 360u;
+
+/// Returns the number of segments that a quarter of an ellipse with the given
+/// radius on screen is divided into, so that the segments are within the curve
+/// tolerance of the ellipse.
+static size_t ComputeQuadrantDivisions(Scalar radius) {
+  if (radius <= kDefaultCurveTolerance) {
+    return 1u;
+  }
+  // The angle of a chord of the circle whose distance to the arc is the
+  // tolerance.
+  Scalar angle = 2 * std::acos(1 - kDefaultCurveTolerance / radius);
+  auto divisions = static_cast<size_t>(std::ceil(kPiOver2 / angle));
+  return std::clamp(divisions, static_cast<size_t>(1u), kMaxQuadrantDivisions);
+}
+
+RRectGeometry::RRectGeometry(Rect rect, Size corner_radii)
+    : rect_(rect.GetPositive()),
+      // Corners larger than half of the rect would overlap each other.
+      corner_radii_(std::clamp(corner_radii.width, 0.0f, rect_.size.width / 2),
+                    std::clamp(corner_radii.height, 0.0f,
+                               rect_.size.height / 2)) {}
+
+RRectGeometry::~RRectGeometry() = default;
+
+const std::vector<Point>& RRectGeometry::GetOutline(Scalar scale) const {
+  if (!outline_.empty() && outline_scale_ == scale) {
+    return outline_;
+  }
+  outline_scale_ = scale;
+  outline_.clear();
+
+  auto [left, top, right, bottom] = rect_.GetLTRB();
+  auto rx = corner_radii_.width;
+  auto ry = corner_radii_.height;
+  if (rx <= 0 || ry <= 0) {
+    outline_ = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+    return outline_;
+  }
+
+  size_t divisions = ComputeQuadrantDivisions(std::max(rx, ry) * scale);
+  // The centers of the corners, going clockwise from the top right one.
+  const Point centers[4] = {
+      {right - rx, top + ry},
+      {right - rx, bottom - ry},
+      {left + rx, bottom - ry},
+      {left + rx, top + ry},
+  };
+  outline_.reserve((divisions + 1) * 4);
+  for (size_t quadrant = 0; quadrant < 4; quadrant++) {
+    Scalar start = kPiOver2 * quadrant - kPiOver2;
+    for (size_t i = 0; i <= divisions; i++) {
+      Scalar angle = start + kPiOver2 * i / divisions;
+      outline_.emplace_back(centers[quadrant].x + std::cos(angle) * rx,
+                            centers[quadrant].y + std::sin(angle) * ry);
+    }
+  }
+  return outline_;
+}
+
+GeometryResult RRectGeometry::GetPositionBuffer(const ContentContext& renderer,
+                                                const Entity& entity,
+                                                RenderPass& pass) {
+  const auto& outline =
+      GetOutline(entity.GetTransformation().GetMaxBasisLength());
+  // Zig zag between both sides of the outline, which is convex, to draw it as
+  // a triangle strip.
+  std::vector<uint16_t> indices;
+  indices.reserve(outline.size());
+  uint16_t first = 0;
+  uint16_t last = outline.size() - 1;
+  while (first <= last) {
+    indices.push_back(first++);
+    if (first <= last) {
+      indices.push_back(last--);
+    }
+  }
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangleStrip,
+      .vertex_buffer =
+          {
+              .vertex_buffer = host_buffer.Emplace(
+                  outline.data(), outline.size() * sizeof(Point),
+                  alignof(float)),
+              .index_buffer = host_buffer.Emplace(
+                  indices.data(), indices.size() * sizeof(uint16_t),
+                  alignof(uint16_t)),
+              .index_count = indices.size(),
+              .index_type = IndexType::k16bit,
+          },
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation(),
+      .prevent_overdraw = false,
+  };
+}
+
+GeometryVertexType RRectGeometry::GetVertexType() const {
+  return GeometryVertexType::kPosition;
+}
+
+std::optional<Rect> RRectGeometry::GetCoverage(const Matrix& transform) const {
+  return rect_.TransformBounds(transform);
+}
+
+bool RRectGeometry::CoversArea(const Matrix& transform,
+                               const Rect& rect) const {
+  if (!transform.IsTranslationScaleOnly()) {
+    return false;
+  }
+  // The rounded rect covers the rect that is inset by the corner radii along
+  // either of its axes.
+  auto [left, top, right, bottom] = rect_.GetLTRB();
+  auto rx = corner_radii_.width;
+  auto ry = corner_radii_.height;
+  return Rect::MakeLTRB(left + rx, top, right - rx, bottom)
+             .TransformBounds(transform)
+             .Contains(rect) ||
+         Rect::MakeLTRB(left, top + ry, right, bottom - ry)
+             .TransformBounds(transform)
+             .Contains(rect);
+}
+
+bool RRectGeometry::CoversPixelsOnce() const {
+  return true;
+}
+
+bool RRectGeometry::AppendFillTriangles(const ContentContext& renderer,
+                                        const Matrix& transform,
+                                        std::vector<Point>& vertices,
+                                        std::vector<uint16_t>& indices) const {
+  const auto& outline = GetOutline(transform.GetMaxBasisLength());
+  if (!CanAppendVertices(vertices, outline.size())) {
+    return false;
+  }
+  auto base = static_cast<uint16_t>(vertices.size());
+  for (const auto& point : outline) {
+    vertices.push_back(transform * point);
+  }
+  // The outline is convex, so it is filled by a fan of triangles.
+  for (uint16_t i = 1; i + 1 < outline.size(); i++) {
+    indices.push_back(base);
+    indices.push_back(base + i);
+    indices.push_back(base + i + 1);
+  }
+  return true;
+}
+
+bool RRectGeometry::CanAntialiasWithCoverage(const Matrix& transform) const {
+  return transform.IsAffine();
+}
+
+GeometryResult RRectGeometry::GetPositionCoverageBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  const auto& transform = entity.GetTransformation();
+  const auto& outline = GetOutline(transform.GetMaxBasisLength());
+  std::vector<Point> polygon;
+  polygon.reserve(outline.size());
+  for (const auto& point : outline) {
+    polygon.push_back(transform * point);
+  }
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer = CreateCoverageConvexPolygon(std::move(polygon),
+                                                   pass.GetTransientsBuffer()),
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()),
+      .prevent_overdraw = false,
+  };
+}
+
+/////// Triangles Geometry ///////
+
+TrianglesGeometry::TrianglesGeometry(std::vector<Point> vertices,
+                                     std::vector<uint16_t> indices)
+    : vertices_(std::move(vertices)),
+      indices_(std::move(indices)),
+      bounds_(Rect::MakePointBounds(vertices_.begin(), vertices_.end())) {}
+
+TrianglesGeometry::~TrianglesGeometry() = default;
+
+GeometryResult TrianglesGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) {
+  auto& host_buffer = pass.GetTransientsBuffer();
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer =
+          {
+              .vertex_buffer = host_buffer.Emplace(
+                  vertices_.data(), vertices_.size() * sizeof(Point),
+                  alignof(float)),
+              .index_buffer = host_buffer.Emplace(
+                  indices_.data(), indices_.size() * sizeof(uint16_t),
+                  alignof(uint16_t)),
+              .index_count = indices_.size(),
+              .index_type = IndexType::k16bit,
+          },
+      .transform = Matrix::MakeOrthographic(pass.GetRenderTargetSize()) *
+                   entity.GetTransformation(),
+      .prevent_overdraw = false,
+  };
+}
+
+GeometryVertexType TrianglesGeometry::GetVertexType() const {
+  return GeometryVertexType::kPosition;
+}
+
+std::optional<Rect> TrianglesGeometry::GetCoverage(
+    const Matrix& transform) const {
+  if (!bounds_.has_value()) {
+    return std::nullopt;
+  }
+  return bounds_->TransformBounds(transform);
+}
+
+bool TrianglesGeometry::AppendFillTriangles(
+    const ContentContext& renderer,
+    const Matrix& transform,
+    std::vector<Point>& vertices,
+    std::vector<uint16_t>& indices) const {
+  if (!CanAppendVertices(vertices, vertices_.size())) {
+    return false;
+  }
+  auto base = static_cast<uint16_t>(vertices.size());
+  for (const auto& vertex : vertices_) {
+    vertices.push_back(transform * vertex);
+  }
+  for (uint16_t index : indices_) {
+    indices.push_back(base + index);
+  }
+  return true;
+}
+
 }  // namespace impeller
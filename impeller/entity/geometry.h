@@ -4,13 +4,18 @@
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
 #include "impeller/entity/contents/contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/solid_fill.vert.h"
+#include "impeller/entity/stroke_extrusion.vert.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/path.h"
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/host_buffer.h"
+#include "impeller/renderer/snapshot.h"
 #include "impeller/renderer/vertex_buffer.h"
 
 namespace impeller {
@@ -24,6 +29,14 @@ struct GeometryResult {
   bool prevent_overdraw;
 };
 
+/// The vertices of a stroke before they are extruded by its width, which
+/// the stroke extrusion vertex shader does.
+struct StrokeExtrusionResult {
+  VertexBuffer vertex_buffer;
+  Matrix transform;
+  Scalar half_width;
+};
+
 enum GeometryVertexType {
   kPosition,
   kColor,
@@ -61,6 +74,12 @@ class Geometry {
 
   static std::unique_ptr<Geometry> MakeRect(Rect rect);
 
+  /// @brief  Make a geometry that fills a rect whose corners are rounded with
+  ///         the same elliptical `corner_radii`.
+  static std::unique_ptr<Geometry> MakeRRect(Rect rect, Size corner_radii);
+
+  static std::unique_ptr<Geometry> MakeCircle(Point center, Scalar radius);
+
   virtual GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                            const Entity& entity,
                                            RenderPass& pass) = 0;
@@ -74,6 +93,63 @@ class Geometry {
   virtual GeometryVertexType GetVertexType() const = 0;
 
   virtual std::optional<Rect> GetCoverage(const Matrix& transform) const = 0;
+
+  /// @brief  Determines if this geometry, transformed by `transform`, will
+  ///         completely cover `rect`. Returns false if this cannot be
+  ///         cheaply determined.
+  virtual bool CoversArea(const Matrix& transform, const Rect& rect) const;
+
+  /// @brief  Whether no pixel is rendered to more than once when this
+  ///         geometry is drawn, because either its vertices never overlap or
+  ///         it prevents overdraw. Returns false if this cannot be cheaply
+  ///         determined.
+  virtual bool CoversPixelsOnce() const;
+
+  /// @brief  Append triangles that fill this geometry, with their vertices
+  ///         transformed by `transform`, to `vertices` and `indices`.
+  ///
+  ///         Returns false, without appending anything, if the geometry
+  ///         cannot be filled with 16 bit indexed triangles, for example
+  ///         because it is a stroke or there are too many vertices.
+  virtual bool AppendFillTriangles(const ContentContext& renderer,
+                                   const Matrix& transform,
+                                   std::vector<Point>& vertices,
+                                   std::vector<uint16_t>& indices) const;
+
+  /// @brief  Whether `GetPositionCoverageBuffer` can fill this geometry when
+  ///         it is transformed by `transform`.
+  virtual bool CanAntialiasWithCoverage(const Matrix& transform) const;
+
+  /// @brief  Generate vertices that fill this geometry along with a coverage
+  ///         that ramps down from one to zero across a one pixel wide band
+  ///         centered on its edges, so that it is antialiased without
+  ///         multisampling. The vertices are in the space of the render target.
+  ///
+  ///         Must only be called if `CanAntialiasWithCoverage` returns true
+  ///         for the transformation of the entity.
+  virtual GeometryResult GetPositionCoverageBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass);
+
+  /// @brief  Fill this geometry with a solid color into a snapshot in the
+  ///         space of the render target, if that is expected to be faster
+  ///         than filling the vertices from `GetPositionBuffer`. Returns
+  ///         std::nullopt otherwise.
+  virtual std::optional<Snapshot> GetSolidFillSnapshot(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass,
+      Color color) const;
+
+  /// @brief  Generate the unextruded vertices of this geometry, if it is a
+  ///         stroke that can be extruded on the GPU. They are drawn as a
+  ///         triangle strip that may overlap itself. Returns std::nullopt
+  ///         otherwise.
+  virtual std::optional<StrokeExtrusionResult> GetStrokeExtrusionBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass);
 };
 
 /// @brief A geometry that is created from a vertices object.
@@ -109,7 +185,33 @@ class FillPathGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool CoversPixelsOnce() const override;
+
+  // |Geometry|
+  bool AppendFillTriangles(const ContentContext& renderer,
+                           const Matrix& transform,
+                           std::vector<Point>& vertices,
+                           std::vector<uint16_t>& indices) const override;
+
+  // |Geometry|
+  bool CanAntialiasWithCoverage(const Matrix& transform) const override;
+
+  // |Geometry|
+  GeometryResult GetPositionCoverageBuffer(const ContentContext& renderer,
+                                           const Entity& entity,
+                                           RenderPass& pass) override;
+
+  // |Geometry|
+  std::optional<Snapshot> GetSolidFillSnapshot(const ContentContext& renderer,
+                                               const Entity& entity,
+                                               RenderPass& pass,
+                                               Color color) const override;
+
   Path path_;
+  // Whether the path is a single convex contour, computed when it is first
+  // needed.
+  mutable std::optional<bool> is_convex_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FillPathGeometry);
 };
@@ -134,7 +236,7 @@ class StrokePathGeometry : public Geometry {
   Join GetStrokeJoin() const;
 
  private:
-  using VS = SolidFillVertexShader;
+  using VS = StrokeExtrusionVertexShader;
 
   using CapProc =
       std::function<void(VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
@@ -160,20 +262,37 @@ class StrokePathGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool CoversPixelsOnce() const override;
+
+  // |Geometry|
+  std::optional<StrokeExtrusionResult> GetStrokeExtrusionBuffer(
+      const ContentContext& renderer,
+      const Entity& entity,
+      RenderPass& pass) override;
+
+  /// Half of the width that the stroke is drawn with, which is at least half
+  /// a pixel, or std::nullopt if nothing is drawn.
+  std::optional<Scalar> GetHalfWidth(const Matrix& transform) const;
+
   static Scalar CreateBevelAndGetDirection(
-      VertexBufferBuilder<SolidFillVertexShader::PerVertexData>& vtx_builder,
+      VertexBufferBuilder<VS::PerVertexData>& vtx_builder,
       const Point& position,
       const Point& start_offset,
       const Point& end_offset);
 
-  static VertexBuffer CreateSolidStrokeVertices(const Path& path,
-                                                HostBuffer& buffer,
-                                                Scalar stroke_width,
-                                                Scalar scaled_miter_limit,
-                                                Cap cap,
-                                                const JoinProc& join_proc,
-                                                const CapProc& cap_proc,
-                                                Scalar scale);
+  /// Generates the vertices of the stroke with offsets from the points of the
+  /// polyline in units of half the stroke width. The path is flattened with
+  /// `scale`, and round joins and caps with `arc_scale`, which is the scale
+  /// of a half width.
+  static VertexBufferBuilder<VS::PerVertexData> CreateStrokeExtrusionVertices(
+      const Path& path,
+      Scalar miter_limit,
+      Cap cap,
+      const JoinProc& join_proc,
+      const CapProc& cap_proc,
+      Scalar scale,
+      Scalar arc_scale);
 
   static StrokePathGeometry::JoinProc GetJoinProc(Join stroke_join);
 
@@ -208,6 +327,12 @@ class CoverGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
+  // |Geometry|
+  bool CoversPixelsOnce() const override;
+
   FML_DISALLOW_COPY_AND_ASSIGN(CoverGeometry);
 };
 
@@ -229,9 +354,120 @@ class RectGeometry : public Geometry {
   // |Geometry|
   std::optional<Rect> GetCoverage(const Matrix& transform) const override;
 
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
+  // |Geometry|
+  bool CoversPixelsOnce() const override;
+
+  // |Geometry|
+  bool AppendFillTriangles(const ContentContext& renderer,
+                           const Matrix& transform,
+                           std::vector<Point>& vertices,
+                           std::vector<uint16_t>& indices) const override;
+
+  // |Geometry|
+  bool CanAntialiasWithCoverage(const Matrix& transform) const override;
+
+  // |Geometry|
+  GeometryResult GetPositionCoverageBuffer(const ContentContext& renderer,
+                                           const Entity& entity,
+                                           RenderPass& pass) override;
+
   Rect rect_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(RectGeometry);
 };
 
+/// @brief  A geometry that fills a rounded rect, or a circle or an oval when
+///         the corner radii are half of the size of the rect.
+///
+///         The outline of the rect is generated directly rather than being
+///         tessellated from a path, with as many points on the corners as are
+///         needed for their size on screen. The outline is kept for as long as
+///         the scale of the transformation that it is drawn with is unchanged.
+class RRectGeometry : public Geometry {
+ public:
+  RRectGeometry(Rect rect, Size corner_radii);
+
+  ~RRectGeometry();
+
+  /// @brief  Returns the outline of the rounded rect, with enough points on the
+  ///         corners that it is smooth when it is scaled by `scale`.
+  const std::vector<Point>& GetOutline(Scalar scale) const;
+
+ private:
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) override;
+
+  // |Geometry|
+  GeometryVertexType GetVertexType() const override;
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override;
+
+  // |Geometry|
+  bool CoversArea(const Matrix& transform, const Rect& rect) const override;
+
+  // |Geometry|
+  bool CoversPixelsOnce() const override;
+
+  // |Geometry|
+  bool AppendFillTriangles(const ContentContext& renderer,
+                           const Matrix& transform,
+                           std::vector<Point>& vertices,
+                           std::vector<uint16_t>& indices) const override;
+
+  // |Geometry|
+  bool CanAntialiasWithCoverage(const Matrix& transform) const override;
+
+  // |Geometry|
+  GeometryResult GetPositionCoverageBuffer(const ContentContext& renderer,
+                                           const Entity& entity,
+                                           RenderPass& pass) override;
+
+  Rect rect_;
+  Size corner_radii_;
+  mutable std::vector<Point> outline_;
+  mutable Scalar outline_scale_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RRectGeometry);
+};
+
+/// @brief  A geometry made of triangles that have already been tessellated,
+///         such as the fills that are merged by an `EntityPass`.
+class TrianglesGeometry : public Geometry {
+ public:
+  TrianglesGeometry(std::vector<Point> vertices,
+                    std::vector<uint16_t> indices);
+
+  ~TrianglesGeometry();
+
+ private:
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) override;
+
+  // |Geometry|
+  GeometryVertexType GetVertexType() const override;
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override;
+
+  // |Geometry|
+  bool AppendFillTriangles(const ContentContext& renderer,
+                           const Matrix& transform,
+                           std::vector<Point>& vertices,
+                           std::vector<uint16_t>& indices) const override;
+
+  std::vector<Point> vertices_;
+  std::vector<uint16_t> indices_;
+  std::optional<Rect> bounds_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TrianglesGeometry);
+};
+
 }  // namespace impeller
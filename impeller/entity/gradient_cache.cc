@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/gradient_cache.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+GradientCache::GradientCache() = default;
+
+GradientCache::~GradientCache() = default;
+
+std::shared_ptr<Texture> GradientCache::Get(const Key& key) {
+  auto it =
+      std::find_if(entries_.begin(), entries_.end(),
+                   [&key](const Entry& entry) { return entry.key == key; });
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  auto texture = it->texture;
+  std::rotate(it, it + 1, entries_.end());
+  return texture;
+}
+
+void GradientCache::Set(Key key, std::shared_ptr<Texture> texture) {
+  entries_.erase(
+      std::remove_if(entries_.begin(), entries_.end(),
+                     [&key](const Entry& entry) { return entry.key == key; }),
+      entries_.end());
+  if (entries_.size() >= kMaxEntries) {
+    entries_.erase(entries_.begin());
+  }
+  entries_.push_back(
+      Entry{.key = std::move(key), .texture = std::move(texture)});
+}
+
+size_t GradientCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t GradientCache::GetByteSize() const {
+  size_t byte_size = 0;
+  for (const auto& entry : entries_) {
+    if (entry.texture) {
+      byte_size +=
+          entry.texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    }
+  }
+  return byte_size;
+}
+
+void GradientCache::Clear() {
+  entries_.clear();
+}
+
+}  // namespace impeller
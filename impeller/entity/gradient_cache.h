@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the color ramp textures of recently rendered gradients,
+///             so that gradients with the same colors and stops don't upload
+///             a new texture every frame they are drawn in.
+///
+///             The tile mode, geometry and alpha of a gradient are applied by
+///             its shader, so they aren't part of the keys. The least
+///             recently used textures are released once more than
+///             `kMaxEntries` are kept.
+///
+class GradientCache {
+ public:
+  struct Key {
+    std::vector<Color> colors;
+    std::vector<Scalar> stops;
+
+    bool operator==(const Key& other) const {
+      return colors == other.colors && stops == other.stops;
+    }
+  };
+
+  static constexpr size_t kMaxEntries = 64u;
+
+  GradientCache();
+
+  ~GradientCache();
+
+  /// @brief  Returns the texture kept for `key`, or nullptr if there is none.
+  std::shared_ptr<Texture> Get(const Key& key);
+
+  void Set(Key key, std::shared_ptr<Texture> texture);
+
+  size_t GetEntryCount() const;
+
+  /// @brief  The size of the kept textures.
+  size_t GetByteSize() const;
+
+  void Clear();
+
+ private:
+  struct Entry {
+    Key key;
+    std::shared_ptr<Texture> texture;
+  };
+
+  // The entries, least recently used first.
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GradientCache);
+};
+
+}  // namespace impeller
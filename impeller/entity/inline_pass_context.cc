@@ -17,10 +17,16 @@ InlinePassContext::InlinePassContext(
     std::shared_ptr<Context> context,
     const RenderTarget& render_target,
     uint32_t pass_texture_reads,
+    ContentsInfo contents_info,
+    std::shared_ptr<HostBuffer> transients_buffer,
+    bool submit_async,
     std::optional<RenderPassResult> collapsed_parent_pass)
     : context_(std::move(context)),
       render_target_(render_target),
+      transients_buffer_(std::move(transients_buffer)),
+      submit_async_(submit_async),
       total_pass_reads_(pass_texture_reads),
+      contents_info_(contents_info),
       is_collapsed_(collapsed_parent_pass.has_value()) {
   if (collapsed_parent_pass.has_value()) {
     pass_ = collapsed_parent_pass.value().pass;
@@ -53,12 +59,18 @@ bool InlinePassContext::EndPass() {
     return true;
   }
 
-  if (!pass_->EncodeCommands()) {
-    return false;
-  }
+  if (submit_async_) {
+    if (!command_buffer_->SubmitCommandsAsync(pass_)) {
+      return false;
+    }
+  } else {
+    if (!pass_->EncodeCommands()) {
+      return false;
+    }
 
-  if (!command_buffer_->SubmitCommands()) {
-    return false;
+    if (!command_buffer_->SubmitCommands()) {
+      return false;
+    }
   }
 
   pass_ = nullptr;
@@ -104,12 +116,20 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
     result.backdrop_texture = color0.resolve_texture;
   }
 
+  // The first pass clears the color unless its contents overwrite all of it.
+  // Later passes either continue from the backdrop texture, which is drawn
+  // over the whole multisampled attachment, or from the stored color.
+  const auto first_pass_load_action = contents_info_.overwrites_color
+                                          ? LoadAction::kDontCare
+                                          : LoadAction::kClear;
   if (color0.resolve_texture) {
     color0.load_action =
-        pass_count_ > 0 ? LoadAction::kDontCare : LoadAction::kClear;
+        pass_count_ > 0 ? LoadAction::kDontCare : first_pass_load_action;
+    // Only the resolved color is read, the samples are never stored.
     color0.store_action = StoreAction::kMultisampleResolve;
   } else {
-    color0.load_action = LoadAction::kClear;
+    color0.load_action =
+        pass_count_ > 0 ? LoadAction::kLoad : first_pass_load_action;
     color0.store_action = StoreAction::kStore;
   }
 
@@ -120,15 +140,19 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
     return {};
   }
 
-  // Only clear the stencil if this is the very first pass of the
-  // layer.
+  // Only clear the stencil if this is the very first pass of the layer, or
+  // if nothing ever writes to it.
+  const bool stencil_is_continued =
+      pass_count_ > 0 && contents_info_.writes_stencil;
   stencil->load_action =
-      pass_count_ > 0 ? LoadAction::kLoad : LoadAction::kClear;
+      stencil_is_continued ? LoadAction::kLoad : LoadAction::kClear;
   // If we're on the last pass of the layer, there's no need to store the
-  // stencil because nothing needs to read it.
-  stencil->store_action = pass_count_ == total_pass_reads_
-                              ? StoreAction::kDontCare
-                              : StoreAction::kStore;
+  // stencil because nothing needs to read it. Neither does a stencil that
+  // only ever holds the clear value.
+  stencil->store_action =
+      pass_count_ == total_pass_reads_ || !contents_info_.writes_stencil
+          ? StoreAction::kDontCare
+          : StoreAction::kStore;
   render_target_.SetStencilAttachment(stencil.value());
 
   render_target_.SetColorAttachment(color0, 0);
@@ -139,6 +163,7 @@ InlinePassContext::RenderPassResult InlinePassContext::GetRenderPass(
     return {};
   }
 
+  pass_->SetTransientsBuffer(transients_buffer_);
   pass_->SetLabel(
       "EntityPass Render Pass: Depth=" + std::to_string(pass_depth) +
       " Count=" + std::to_string(pass_count_));
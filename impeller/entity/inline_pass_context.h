@@ -5,6 +5,7 @@
 #pragma once
 
 #include "impeller/renderer/context.h"
+#include "impeller/renderer/host_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
 
@@ -17,10 +18,25 @@ class InlinePassContext {
     std::shared_ptr<Texture> backdrop_texture;
   };
 
+  /// What is known about the contents rendered with the context, which is
+  /// used to pick the cheapest load and store actions of the attachments.
+  struct ContentsInfo {
+    /// Whether the first pass overwrites every pixel of the color attachment
+    /// before reading it, in which case it doesn't need to be cleared.
+    bool overwrites_color = false;
+    /// Whether the stencil attachment may be written to. If not, it never
+    /// holds anything but the clear value and is cleared by every pass
+    /// rather than being stored and loaded.
+    bool writes_stencil = true;
+  };
+
   InlinePassContext(
       std::shared_ptr<Context> context,
       const RenderTarget& render_target,
       uint32_t pass_texture_reads,
+      ContentsInfo contents_info,
+      std::shared_ptr<HostBuffer> transients_buffer,
+      bool submit_async,
       std::optional<RenderPassResult> collapsed_parent_pass = std::nullopt);
   ~InlinePassContext();
 
@@ -36,10 +52,15 @@ class InlinePassContext {
  private:
   std::shared_ptr<Context> context_;
   RenderTarget render_target_;
+  std::shared_ptr<HostBuffer> transients_buffer_;
+  // Whether the passes may be encoded on a worker thread. Only passes that
+  // nothing outside of the GPU waits on can be.
+  bool submit_async_ = false;
   std::shared_ptr<CommandBuffer> command_buffer_;
   std::shared_ptr<RenderPass> pass_;
   uint32_t pass_count_ = 0;
   uint32_t total_pass_reads_ = 0;
+  ContentsInfo contents_info_;
   // Whether this context is collapsed into a parent entity pass.
   bool is_collapsed_ = false;
 
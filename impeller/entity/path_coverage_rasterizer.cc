@@ -0,0 +1,347 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/path_coverage_rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/path_coverage.comp.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/compute_command.h"
+#include "impeller/renderer/compute_pass.h"
+#include "impeller/renderer/device_buffer.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/sampler_descriptor.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+namespace {
+
+// A segment that crosses sample rows within a tile.
+struct TileEntry {
+  size_t tile;
+  Vector4 positions;
+  PathCoverageRasterizer::Tiles::SegmentInfo info;
+};
+
+// Twice the signed area enclosed by the closed contours of the polyline.
+Scalar ComputeSignedArea(const Path::Polyline& polyline) {
+  Scalar area = 0;
+  for (size_t i = 0; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    if (end - start < 3) {
+      continue;
+    }
+    for (size_t j = start; j < end; j++) {
+      const Point& a = polyline.points[j];
+      const Point& b = polyline.points[j + 1 < end ? j + 1 : start];
+      area += a.x * b.y - b.x * a.y;
+    }
+  }
+  return area;
+}
+
+}  // namespace
+
+PathCoverageRasterizer::Tiles PathCoverageRasterizer::BinPolyline(
+    const Path::Polyline& polyline,
+    IRect bounds) {
+  Tiles tiles;
+  const int64_t columns = (bounds.size.width + kTileSize - 1) / kTileSize;
+  const int64_t rows = (bounds.size.height + kTileSize - 1) / kTileSize;
+  if (columns <= 0 || rows <= 0) {
+    return tiles;
+  }
+  tiles.tile_count = ISize(columns, rows);
+  const size_t tile_total = columns * rows;
+  tiles.ranges.resize(tile_total * 2, 0u);
+  tiles.backdrops.resize(tile_total * kSampleRowsPerTile, 0);
+
+  // Flip the windings of clockwise polylines, so that the enclosed area is
+  // positive regardless of the orientation in which the path was drawn.
+  const int32_t orientation = ComputeSignedArea(polyline) < 0 ? -1 : 1;
+  const Point origin(bounds.origin.x, bounds.origin.y);
+  const int64_t sample_rows = bounds.size.height * kSamplesPerAxis;
+
+  std::vector<TileEntry> entries;
+  auto bin_segment = [&](Point p0, Point p1) {
+    p0 = p0 - origin;
+    p1 = p1 - origin;
+    if (p0.y == p1.y) {
+      // Horizontal segments don't cross any sample rows.
+      return;
+    }
+    const int32_t winding = (p1.y < p0.y ? 1 : -1) * orientation;
+    const Scalar min_y = std::min(p0.y, p1.y);
+    const Scalar max_y = std::max(p0.y, p1.y);
+    const Scalar inverse_slope = (p1.x - p0.x) / (p1.y - p0.y);
+
+    // Sample row s is at y = (s + 0.5) / kSamplesPerAxis, and a segment
+    // crosses the rows in [min_y, max_y).
+    const int64_t first_row = std::max<int64_t>(
+        0, std::ceil(min_y * kSamplesPerAxis - 0.5f));
+    const int64_t end_row = std::min<int64_t>(
+        sample_rows, std::ceil(max_y * kSamplesPerAxis - 0.5f));
+
+    size_t entry_index = std::numeric_limits<size_t>::max();
+    for (int64_t row = first_row; row < end_row; row++) {
+      const Scalar y = (row + 0.5f) / kSamplesPerAxis;
+      if (y < min_y || y >= max_y) {
+        continue;
+      }
+      const Scalar x = p0.x + (y - p0.y) * inverse_slope;
+      const int64_t column = static_cast<int64_t>(std::floor(x / kTileSize));
+      if (column >= columns) {
+        // Crossings to the right of the bounds affect no samples.
+        continue;
+      }
+      const size_t row_base = (row / kSampleRowsPerTile) * columns;
+      const int64_t row_in_tile = row % kSampleRowsPerTile;
+      // The crossing is to the left of every sample of the tiles to the right
+      // of the one it is in.
+      const int64_t next_column = std::max<int64_t>(column + 1, 0);
+      if (next_column < columns) {
+        tiles.backdrops[(row_base + next_column) * kSampleRowsPerTile +
+                        row_in_tile] += winding;
+      }
+      if (column < 0) {
+        continue;
+      }
+      const size_t tile = row_base + column;
+      if (entry_index == std::numeric_limits<size_t>::max() ||
+          entries[entry_index].tile != tile) {
+        TileEntry entry;
+        entry.tile = tile;
+        entry.positions = Vector4(p0.x, p0.y, p1.x, p1.y);
+        entry.info.winding = winding;
+        entries.push_back(entry);
+        entry_index = entries.size() - 1;
+      }
+      auto& info = entries[entry_index].info;
+      if (row_in_tile < 32) {
+        info.low_rows_mask |= 1u << row_in_tile;
+      } else {
+        info.high_rows_mask |= 1u << (row_in_tile - 32);
+      }
+    }
+  };
+
+  for (size_t i = 0; i < polyline.contours.size(); i++) {
+    auto [start, end] = polyline.GetContourPointBounds(i);
+    if (end - start < 2) {
+      continue;
+    }
+    for (size_t j = start; j + 1 < end; j++) {
+      bin_segment(polyline.points[j], polyline.points[j + 1]);
+    }
+    // Fills are always closed.
+    bin_segment(polyline.points[end - 1], polyline.points[start]);
+  }
+
+  // Sum the crossings to the left of each tile into its backdrops.
+  for (int64_t row = 0; row < rows; row++) {
+    for (int64_t column = 1; column < columns; column++) {
+      const size_t tile = row * columns + column;
+      for (int64_t sample_row = 0; sample_row < kSampleRowsPerTile;
+           sample_row++) {
+        tiles.backdrops[tile * kSampleRowsPerTile + sample_row] +=
+            tiles.backdrops[(tile - 1) * kSampleRowsPerTile + sample_row];
+      }
+    }
+  }
+
+  // Sort the entries by tile, keeping the order of the segments within each
+  // tile.
+  for (const auto& entry : entries) {
+    tiles.ranges[entry.tile * 2 + 1]++;
+  }
+  std::vector<uint32_t> cursors(tile_total);
+  uint32_t offset = 0u;
+  for (size_t tile = 0; tile < tile_total; tile++) {
+    tiles.ranges[tile * 2] = offset;
+    cursors[tile] = offset;
+    offset += tiles.ranges[tile * 2 + 1];
+  }
+  tiles.positions.resize(entries.size());
+  tiles.infos.resize(entries.size());
+  for (const auto& entry : entries) {
+    const auto index = cursors[entry.tile]++;
+    tiles.positions[index] = entry.positions;
+    tiles.infos[index] = entry.info;
+  }
+  return tiles;
+}
+
+bool PathCoverageRasterizer::ShouldRasterize(const ContentContext& renderer,
+                                             const Path::Polyline& polyline,
+                                             const Matrix& transform) {
+  return renderer.GetDeviceCapabilities().SupportsCompute() &&
+         renderer.GetPathCoveragePipeline() && transform.IsAffine() &&
+         polyline.points.size() >= kMinPointCount;
+}
+
+std::optional<Snapshot> PathCoverageRasterizer::Rasterize(
+    const ContentContext& renderer,
+    const Path::Polyline& polyline,
+    FillType fill_type,
+    const Matrix& transform,
+    ISize target_size,
+    Color color) {
+  using CS = PathCoverageComputeShader;
+  using VS = PixelBufferPipeline::VertexShader;
+  using FS = PixelBufferPipeline::FragmentShader;
+
+  auto context = renderer.GetContext();
+  auto pipeline = renderer.GetPathCoveragePipeline();
+  if (!context->GetDeviceCapabilities().SupportsCompute() || !pipeline ||
+      !transform.IsAffine()) {
+    return std::nullopt;
+  }
+
+  Path::Polyline device_polyline;
+  device_polyline.contours = polyline.contours;
+  device_polyline.points.resize(polyline.points.size());
+  transform.TransformPoints(polyline.points.data(),
+                            device_polyline.points.data(),
+                            polyline.points.size());
+  auto device_bounds = Rect::MakePointBounds(device_polyline.points.begin(),
+                                             device_polyline.points.end());
+  if (!device_bounds.has_value()) {
+    return std::nullopt;
+  }
+  auto ltrb = device_bounds->GetLTRB();
+  auto bounds =
+      IRect::MakeLTRB(std::floor(ltrb[0]), std::floor(ltrb[1]),
+                      std::ceil(ltrb[2]), std::ceil(ltrb[3]))
+          .Intersection(IRect::MakeSize(target_size));
+  if (!bounds.has_value() || bounds->IsEmpty() ||
+      bounds->size.Area() > kMaxArea) {
+    return std::nullopt;
+  }
+  const ISize output_size = bounds->size;
+
+  auto tiles = BinPolyline(device_polyline, bounds.value());
+  if (tiles.positions.empty()) {
+    // Keep the bindings valid. No tile range refers to the entry.
+    tiles.positions.emplace_back();
+    tiles.infos.emplace_back();
+  }
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.size = output_size.Area() * sizeof(uint32_t);
+  auto output_pixels = context->GetResourceAllocator()->CreateBuffer(desc);
+  if (!output_pixels) {
+    return std::nullopt;
+  }
+
+  auto cmd_buffer = context->CreateCommandBuffer();
+  if (!cmd_buffer) {
+    return std::nullopt;
+  }
+  cmd_buffer->SetLabel("Path Coverage Command Buffer");
+
+  {
+    auto pass = cmd_buffer->CreateComputePass();
+    if (!pass || !pass->IsValid()) {
+      return std::nullopt;
+    }
+    pass->SetLabel("Path Coverage");
+    pass->SetGridSize(output_size);
+    pass->SetThreadGroupSize(ISize(kTileSize, kTileSize));
+
+    auto& host_buffer = pass->GetTransientsBuffer();
+    auto emplace_vector = [&host_buffer](const auto& data) {
+      using Element = typename std::decay_t<decltype(data)>::value_type;
+      return host_buffer.Emplace(
+          data.data(), data.size() * sizeof(Element),
+          std::max(alignof(Element), DefaultUniformAlignment()));
+    };
+
+    ComputeCommand cmd;
+    cmd.label = "Path Coverage";
+    cmd.pipeline = pipeline;
+    CS::RasterInfo info;
+    info.output_size = IPoint32(output_size.width, output_size.height);
+    info.tile_count =
+        IPoint32(tiles.tile_count.width, tiles.tile_count.height);
+    info.color = color.Premultiply();
+    info.fill_type = static_cast<Scalar>(fill_type);
+    CS::BindRasterInfo(cmd, host_buffer.EmplaceUniform(info));
+    CS::BindTileRanges(cmd, emplace_vector(tiles.ranges));
+    CS::BindSegmentPositions(cmd, emplace_vector(tiles.positions));
+    CS::BindSegmentInfos(cmd, emplace_vector(tiles.infos));
+    CS::BindBackdrops(cmd, emplace_vector(tiles.backdrops));
+    CS::BindOutputPixels(cmd, output_pixels->AsBufferView());
+    if (!pass->AddCommand(std::move(cmd)) || !pass->EncodeCommands()) {
+      return std::nullopt;
+    }
+  }
+
+  if (!cmd_buffer->SubmitCommands()) {
+    return std::nullopt;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Copy the pixels into a texture.
+  ///
+
+  ContentContext::SubpassCallback callback = [&](const ContentContext& renderer,
+                                                 RenderPass& pass) {
+    auto& host_buffer = pass.GetTransientsBuffer();
+
+    VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+    vtx_builder.AddVertices({
+        {Point(0, 0), Point(0, 0)},
+        {Point(1, 0), Point(1, 0)},
+        {Point(1, 1), Point(1, 1)},
+        {Point(0, 0), Point(0, 0)},
+        {Point(1, 1), Point(1, 1)},
+        {Point(0, 1), Point(0, 1)},
+    });
+
+    VS::FrameInfo frame_info;
+    frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+    frame_info.texture_sampler_y_coord_scale = 1.0;
+
+    FS::FragInfo frag_info;
+    frag_info.width = output_size.width;
+    frag_info.apply_color_matrix = 0;
+
+    Command cmd;
+    cmd.label = "Path Coverage Resolve";
+    auto options = OptionsFromPass(pass);
+    options.blend_mode = BlendMode::kSource;
+    cmd.pipeline = renderer.GetPixelBufferPipeline(options);
+    cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+    FS::BindPixelData(cmd, output_pixels->AsBufferView());
+    return pass.AddCommand(std::move(cmd));
+  };
+  auto texture = renderer.MakeSubpass("Path Coverage", output_size, callback,
+                                      /*msaa_enabled=*/false);
+  if (!texture) {
+    return std::nullopt;
+  }
+
+  // The texture is aligned to the pixels of the render target.
+  SamplerDescriptor nearest;
+  nearest.label = "Nearest Sampler";
+  return Snapshot{
+      .texture = texture,
+      .transform = Matrix::MakeTranslation(
+          {static_cast<Scalar>(bounds->origin.x),
+           static_cast<Scalar>(bounds->origin.y), 0}),
+      .sampler_descriptor = nearest,
+  };
+}
+
+}  // namespace impeller
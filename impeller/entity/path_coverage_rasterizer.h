@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/rect.h"
+#include "impeller/geometry/vector.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+class ContentContext;
+
+//------------------------------------------------------------------------------
+/// @brief      Fills paths with a solid color by computing their coverage in a
+///             compute shader, rather than tessellating them on the CPU.
+///
+///             The edges of the path are binned into tiles on the CPU, which
+///             takes time linear in the number of edges and the height of the
+///             path. This is much cheaper than tessellating paths with many
+///             thousands of edges, but more expensive than tessellating
+///             simple ones, so only complex paths should be rasterized this
+///             way.
+///
+class PathCoverageRasterizer {
+ public:
+  /// The width and height of a tile, in pixels. Must match the compute
+  /// shader.
+  static constexpr int64_t kTileSize = 16;
+  /// The number of samples along each axis of a pixel.
+  static constexpr int64_t kSamplesPerAxis = 4;
+  static constexpr int64_t kSampleRowsPerTile = kTileSize * kSamplesPerAxis;
+  /// The fewest points of a polyline for which rasterizing is expected to be
+  /// faster than tessellating.
+  static constexpr size_t kMinPointCount = 2048u;
+  /// Paths with fewer components are not flattened to count their points.
+  static constexpr size_t kMinComponentCount = 256u;
+  /// The largest area, in pixels, that is rasterized.
+  static constexpr int64_t kMaxArea = 4096 * 4096;
+
+  /// The segments of a polyline in each tile of its bounds, in the layout
+  /// that the compute shader reads them in.
+  struct Tiles {
+    struct SegmentInfo {
+      /// The sample rows of the tile that the segment crosses within the
+      /// tile.
+      uint32_t low_rows_mask = 0u;
+      uint32_t high_rows_mask = 0u;
+      /// +1 or -1, depending on the direction of the segment.
+      int32_t winding = 0;
+      uint32_t padding = 0u;
+    };
+
+    ISize tile_count;
+    /// The offset into the segments and the number of segments of each tile.
+    std::vector<uint32_t> ranges;
+    /// The end points of each segment, relative to the origin of the bounds.
+    std::vector<Vector4> positions;
+    std::vector<SegmentInfo> infos;
+    /// For each sample row of each tile, the winding of the samples at its
+    /// left edge.
+    std::vector<int32_t> backdrops;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Bins the segments of the closed contours of the polyline
+  ///             into the tiles of the bounds. The points of the polyline
+  ///             must be in the same space as the bounds.
+  ///
+  ///             Like the tessellator, the windings are chosen so that the
+  ///             area enclosed by the polyline is positive.
+  ///
+  static Tiles BinPolyline(const Path::Polyline& polyline, IRect bounds);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether filling the polyline with `Rasterize` is expected to
+  ///             be faster than tessellating it.
+  ///
+  static bool ShouldRasterize(const ContentContext& renderer,
+                              const Path::Polyline& polyline,
+                              const Matrix& transform);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Fills the polyline with the color.
+  ///
+  /// @param[in]  renderer      The content context.
+  /// @param[in]  polyline      The polyline, in the space of the path.
+  /// @param[in]  fill_type     The fill type of the path.
+  /// @param[in]  transform     The transformation from the space of the path
+  ///                           to the space of the render target. Must be
+  ///                           affine.
+  /// @param[in]  target_size   The size of the render target, which the
+  ///                           coverage is clipped to.
+  /// @param[in]  color         The color to fill the polyline with.
+  ///
+  /// @return     A snapshot of the fill in the space of the render target,
+  ///             or std::nullopt if it could not be rasterized.
+  ///
+  static std::optional<Snapshot> Rasterize(const ContentContext& renderer,
+                                           const Path::Polyline& polyline,
+                                           FillType fill_type,
+                                           const Matrix& transform,
+                                           ISize target_size,
+                                           Color color);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(PathCoverageRasterizer);
+};
+
+}  // namespace impeller
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+static bool IsCompatible(const TextureDescriptor& a,
+                         const TextureDescriptor& b) {
+  return a.storage_mode == b.storage_mode &&  //
+         a.type == b.type &&                  //
+         a.format == b.format &&              //
+         a.size == b.size &&                  //
+         a.mip_count == b.mip_count &&        //
+         a.usage == b.usage &&                //
+         a.sample_count == b.sample_count;
+}
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator)
+    : RenderTargetAllocator(std::move(allocator)) {}
+
+RenderTargetCache::~RenderTargetCache() = default;
+
+void RenderTargetCache::Start() {
+  for (auto& td : texture_data_) {
+    td.used_this_frame = false;
+  }
+}
+
+void RenderTargetCache::End() {
+  texture_data_.erase(
+      std::remove_if(texture_data_.begin(), texture_data_.end(),
+                     [](const TextureData& td) { return !td.used_this_frame; }),
+      texture_data_.end());
+}
+
+std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
+    const TextureDescriptor& desc) {
+  FML_DCHECK(desc.storage_mode != StorageMode::kHostVisible);
+  FML_DCHECK(desc.usage &
+             static_cast<TextureUsageMask>(TextureUsage::kRenderTarget));
+
+  for (auto& td : texture_data_) {
+    // A texture that is still referenced elsewhere may be pending use by a
+    // command buffer or held as the result of a subpass, so it can only be
+    // reused once the cache holds the last reference. Command buffers hold
+    // references to the attachments they render to until they complete.
+    if (!td.used_this_frame && td.texture.use_count() == 1 &&
+        IsCompatible(td.texture->GetTextureDescriptor(), desc)) {
+      td.used_this_frame = true;
+      return td.texture;
+    }
+  }
+
+  auto result = RenderTargetAllocator::CreateTexture(desc);
+  if (result == nullptr) {
+    return result;
+  }
+  texture_data_.push_back(TextureData{.used_this_frame = true,  //
+                                      .texture = result});
+  return result;
+}
+
+size_t RenderTargetCache::CachedTextureCount() const {
+  return texture_data_.size();
+}
+
+size_t RenderTargetCache::CachedTextureBytes() const {
+  size_t byte_size = 0;
+  for (const auto& td : texture_data_) {
+    byte_size += td.texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  }
+  return byte_size;
+}
+
+void RenderTargetCache::Clear() {
+  texture_data_.clear();
+}
+
+}  // namespace impeller
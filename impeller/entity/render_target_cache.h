@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render target allocator that reuses the textures of offscreen
+///             render targets across frames.
+///
+///             A texture is reused when a texture with an identical
+///             descriptor (size, format, sample count, storage mode and
+///             usage) is requested and nothing but the cache still holds the
+///             previous one. Textures that are not requested during a frame
+///             are released when the frame ends.
+///
+class RenderTargetCache : public RenderTargetAllocator {
+ public:
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator);
+
+  ~RenderTargetCache() override;
+
+  // |RenderTargetAllocator|
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc) override;
+
+  // |RenderTargetAllocator|
+  void Start() override;
+
+  // |RenderTargetAllocator|
+  void End() override;
+
+  /// @brief  The number of textures held by the cache.
+  size_t CachedTextureCount() const;
+
+  /// @brief  The size of the base mip levels of the textures held by the
+  ///         cache.
+  size_t CachedTextureBytes() const;
+
+  /// @brief  Releases the references of the cache to its textures. Textures
+  ///         that are still used elsewhere stay alive until they are
+  ///         released there, but are not reused.
+  void Clear();
+
+ private:
+  struct TextureData {
+    bool used_this_frame;
+    std::shared_ptr<Texture> texture;
+  };
+
+  std::vector<TextureData> texture_data_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
+};
+
+}  // namespace impeller
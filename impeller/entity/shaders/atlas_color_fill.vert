@@ -0,0 +1,38 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+}
+frame_info;
+
+// One sprite of the atlas per instance. Matches the sprites of
+// atlas_texture_fill.vert.
+struct Sprite {
+  vec4 basis;
+  vec4 offset_and_size;
+  vec4 texture_origin;
+  vec4 color;
+};
+
+layout(std140) readonly buffer SpriteData {
+  Sprite sprites[];
+}
+sprite_data;
+
+// The corner of the sprite, from (0, 0) to (1, 1).
+in vec2 unit_position;
+
+out vec4 v_color;
+
+void main() {
+  Sprite sprite = sprite_data.sprites[gl_InstanceIndex];
+  vec2 local = unit_position * sprite.offset_and_size.zw;
+  vec2 position = sprite.basis.xy * local.x + sprite.basis.zw * local.y +
+                  sprite.offset_and_size.xy;
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+  v_color = sprite.color;
+}
@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/texture.glsl>
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+  vec2 texture_size;
+  float texture_sampler_y_coord_scale;
+}
+frame_info;
+
+// One sprite of the atlas per instance.
+struct Sprite {
+  // The 2D basis vectors of the sprite transform.
+  vec4 basis;
+  // The translation of the sprite transform and the size of the sprite.
+  vec4 offset_and_size;
+  // The origin of the sprite in the texture, in texels.
+  vec4 texture_origin;
+  vec4 color;
+};
+
+layout(std140) readonly buffer SpriteData {
+  Sprite sprites[];
+}
+sprite_data;
+
+// The corner of the sprite, from (0, 0) to (1, 1).
+in vec2 unit_position;
+
+out vec2 v_texture_coords;
+
+void main() {
+  Sprite sprite = sprite_data.sprites[gl_InstanceIndex];
+  vec2 local = unit_position * sprite.offset_and_size.zw;
+  vec2 position = sprite.basis.xy * local.x + sprite.basis.zw * local.y +
+                  sprite.offset_and_size.xy;
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+  v_texture_coords = IPRemapCoords(
+      (sprite.texture_origin.xy + local) / frame_info.texture_size,
+      frame_info.texture_sampler_y_coord_scale);
+}
@@ -44,11 +44,6 @@ out vec4 frag_color;
 void main() {
   vec4 input_color = texture(input_texture, v_position) * frag_info.input_alpha;
 
-  // unpremultiply first, as filter inputs are premultiplied.
-  vec4 color = IPUnpremultiply(input_color);
-
-  color = clamp(frag_info.color_m * color + frag_info.color_v, 0.0, 1.0);
-
-  // premultiply the outputs
-  frag_color = vec4(color.rgb * color.a, color.a);
+  frag_color =
+      IPApplyColorMatrix(input_color, frag_info.color_m, frag_info.color_v);
 }
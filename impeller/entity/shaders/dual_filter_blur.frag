@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// One step of a dual filter blur ("Bandwidth-Efficient Rendering", Bjørge,
+// SIGGRAPH 2015), which is a variant of the Kawase blur.
+//
+// The blur is applied by a chain of passes that each halve the size of the
+// texture, followed by passes that each double it again. Each pass takes a
+// handful of bilinear samples, so the cost of the blur grows with the log of
+// its sigma rather than with the sigma itself.
+
+#include <impeller/texture.glsl>
+#include <impeller/types.glsl>
+
+uniform sampler2D texture_sampler;
+
+uniform FragInfo {
+  // The size of a texel of the sampled texture in texture coordinates,
+  // scaled by the offset of the kernel along each axis.
+  vec2 texel_offset;
+  // 1 when doubling the size of the texture, 0 when halving it.
+  float upsample;
+  // 1 when samples outside of the texture are transparent.
+  float decal;
+}
+frag_info;
+
+in vec2 v_texture_coords;
+
+out vec4 frag_color;
+
+vec4 SampleInput(vec2 coords) {
+  if (frag_info.decal > 0.5) {
+    return IPSampleDecal(texture_sampler, coords);
+  }
+  return texture(texture_sampler, coords);
+}
+
+void main() {
+  vec2 uv = v_texture_coords;
+  vec2 offset = frag_info.texel_offset;
+  vec2 half_offset = offset * 0.5;
+
+  if (frag_info.upsample > 0.5) {
+    vec4 sum = SampleInput(uv + vec2(-offset.x, 0.0)) +
+               SampleInput(uv + vec2(offset.x, 0.0)) +
+               SampleInput(uv + vec2(0.0, -offset.y)) +
+               SampleInput(uv + vec2(0.0, offset.y));
+    sum += 2.0 * (SampleInput(uv + vec2(-half_offset.x, -half_offset.y)) +
+                  SampleInput(uv + vec2(half_offset.x, -half_offset.y)) +
+                  SampleInput(uv + vec2(-half_offset.x, half_offset.y)) +
+                  SampleInput(uv + half_offset));
+    frag_color = sum / 12.0;
+  } else {
+    // The center of each destination texel is at the corner of four source
+    // texels, so the center sample averages all four of them.
+    vec4 sum = 4.0 * SampleInput(uv);
+    sum += SampleInput(uv + vec2(-half_offset.x, -half_offset.y)) +
+           SampleInput(uv + vec2(half_offset.x, -half_offset.y)) +
+           SampleInput(uv + vec2(-half_offset.x, half_offset.y)) +
+           SampleInput(uv + half_offset);
+    frag_color = sum / 8.0;
+  }
+}
@@ -13,6 +13,7 @@
 //     reduced in the first pass by sampling the source textures with a mip
 //     level of log2(min_radius).
 
+#include <impeller/color.glsl>
 #include <impeller/constants.glsl>
 #include <impeller/gaussian.glsl>
 #include <impeller/texture.glsl>
@@ -35,6 +36,12 @@ uniform FragInfo {
   float src_factor;
   float inner_blur_factor;
   float outer_blur_factor;
+
+  // A color matrix applied to the result when |apply_color_matrix| is 1, so
+  // that a color filter after the blur doesn't need a pass of its own.
+  float apply_color_matrix;
+  mat4 color_m;
+  vec4 color_v;
 }
 frag_info;
 
@@ -67,4 +74,8 @@ void main() {
                       frag_info.outer_blur_factor * float(src_color.a == 0);
 
   frag_color = blur_color * blur_factor + src_color * frag_info.src_factor;
+  frag_color = mix(
+      frag_color,
+      IPApplyColorMatrix(frag_color, frag_info.color_m, frag_info.color_v),
+      frag_info.apply_color_matrix);
 }
@@ -0,0 +1,42 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+uniform FrameInfo {
+  mat4 mvp;
+  vec2 atlas_size;
+}
+frame_info;
+
+// One glyph per instance.
+struct Glyph {
+  // The origin and the size of the glyph quad, in the space of the text.
+  vec4 position_and_size;
+  // The origin and the size of the glyph in the atlas, in texels.
+  vec4 atlas_rect;
+  // Whether the glyph has color, in x.
+  vec4 has_color;
+};
+
+layout(std140) readonly buffer GlyphData {
+  Glyph glyphs[];
+}
+glyph_data;
+
+// The corner of the glyph, from (0, 0) to (1, 1).
+in vec2 unit_position;
+
+out vec2 v_uv;
+out float v_has_color;
+
+void main() {
+  Glyph glyph = glyph_data.glyphs[gl_InstanceIndex];
+  vec2 position = glyph.position_and_size.xy +
+                  unit_position * glyph.position_and_size.zw;
+  gl_Position = frame_info.mvp * vec4(position, 0.0, 1.0);
+  v_uv = (glyph.atlas_rect.xy + unit_position * glyph.atlas_rect.zw) /
+         frame_info.atlas_size;
+  v_has_color = glyph.has_color.x;
+}
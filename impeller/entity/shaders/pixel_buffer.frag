@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Copies the premultiplied RGBA8 pixels written by a compute shader into the
+// render target, which must be the same size as the pixel buffer.
+
+#include <impeller/color.glsl>
+#include <impeller/types.glsl>
+
+layout(std430) readonly buffer PixelData {
+  uint pixels[];
+}
+pixel_data;
+
+uniform FragInfo {
+  int width;
+
+  // A color matrix applied to the pixels when |apply_color_matrix| is 1.
+  float apply_color_matrix;
+  mat4 color_m;
+  vec4 color_v;
+}
+frag_info;
+
+out vec4 frag_color;
+
+void main() {
+  ivec2 position = ivec2(gl_FragCoord.xy);
+  uint pixel = pixel_data.pixels[position.y * frag_info.width + position.x];
+  frag_color = unpackUnorm4x8(pixel);
+  frag_color = mix(
+      frag_color,
+      IPApplyColorMatrix(frag_color, frag_info.color_m, frag_info.color_v),
+      frag_info.apply_color_matrix);
+}
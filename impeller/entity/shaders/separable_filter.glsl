@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Applies a gaussian blur or a morphology filter along one axis of an image,
+// writing premultiplied RGBA8 pixels to a buffer.
+//
+// Each workgroup filters a tile of kTileSize consecutive pixels on one line
+// of the output. The input pixels that the tile reads are loaded into shared
+// memory once, rather than being read by every invocation that needs them.
+//
+// Includers define `vec4 LoadPixel(ivec2 position, ivec2 size)`, which is
+// only called for positions within the input.
+
+#include <impeller/gaussian.glsl>
+#include <impeller/texture.glsl>
+
+const int kTileSize = 128;
+const int kMaxRadius = 64;
+
+const float kOperationGaussianBlur = 0;
+const float kOperationDilate = 1;
+const float kOperationErode = 2;
+
+layout(local_size_x = kTileSize, local_size_y = 1) in;
+
+layout(binding = 0) writeonly buffer OutputPixels {
+  uint pixels[];
+}
+output_data;
+
+uniform FilterInfo {
+  ivec2 input_size;
+  ivec2 output_size;
+  // The position of the first output pixel in the input.
+  ivec2 input_offset;
+  // (1, 0) to filter along rows, (0, 1) to filter along columns.
+  ivec2 direction;
+  float operation;
+  float sigma;
+  int radius;
+  float tile_mode;
+}
+filter_info;
+
+shared vec4 tile_pixels[kTileSize + 2 * kMaxRadius];
+
+int TileCoordinate(int coordinate, int size) {
+  if (coordinate >= 0 && coordinate < size) {
+    return coordinate;
+  }
+  if (filter_info.tile_mode == kTileModeClamp) {
+    return clamp(coordinate, 0, size - 1);
+  }
+  if (filter_info.tile_mode == kTileModeRepeat) {
+    int repeated = coordinate % size;
+    return repeated < 0 ? repeated + size : repeated;
+  }
+  if (filter_info.tile_mode == kTileModeMirror) {
+    int period = 2 * size;
+    int mirrored = coordinate % period;
+    mirrored = mirrored < 0 ? mirrored + period : mirrored;
+    return mirrored < size ? mirrored : period - 1 - mirrored;
+  }
+  return -1;
+}
+
+vec4 LoadTiledPixel(ivec2 position) {
+  ivec2 size = filter_info.input_size;
+  position = ivec2(TileCoordinate(position.x, size.x),
+                   TileCoordinate(position.y, size.y));
+  if (position.x < 0 || position.y < 0) {
+    return vec4(0);
+  }
+  return LoadPixel(position, size);
+}
+
+void main() {
+  ivec2 direction = filter_info.direction;
+  ivec2 across = ivec2(1) - direction;
+  int radius = filter_info.radius;
+  int tile_start = int(gl_WorkGroupID.x) * kTileSize;
+  int line = int(gl_WorkGroupID.y);
+  int local_index = int(gl_LocalInvocationID.x);
+
+  for (int i = local_index; i < kTileSize + 2 * radius; i += kTileSize) {
+    ivec2 position = (tile_start + i - radius) * direction + line * across;
+    tile_pixels[i] = LoadTiledPixel(position + filter_info.input_offset);
+  }
+  barrier();
+
+  int along = tile_start + local_index;
+  if (along >= dot(filter_info.output_size, direction) ||
+      line >= dot(filter_info.output_size, across)) {
+    return;
+  }
+
+  int center = local_index + radius;
+  vec4 result;
+  if (filter_info.operation == kOperationGaussianBlur) {
+    vec4 total = vec4(0);
+    float total_weight = 0;
+    for (int i = -radius; i <= radius; i++) {
+      float weight = IPGaussian(float(i), filter_info.sigma);
+      total += weight * tile_pixels[center + i];
+      total_weight += weight;
+    }
+    result = total / total_weight;
+  } else if (filter_info.operation == kOperationDilate) {
+    result = vec4(0);
+    for (int i = -radius; i <= radius; i++) {
+      result = max(result, tile_pixels[center + i]);
+    }
+  } else {
+    result = vec4(1);
+    for (int i = -radius; i <= radius; i++) {
+      result = min(result, tile_pixels[center + i]);
+    }
+  }
+
+  ivec2 position = along * direction + line * across;
+  output_data.pixels[position.y * filter_info.output_size.x + position.x] =
+      packUnorm4x8(result);
+}
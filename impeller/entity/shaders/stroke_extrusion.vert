@@ -0,0 +1,23 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <impeller/types.glsl>
+
+// Extrudes the vertices of a stroke from the points of its polyline. The
+// offsets of the sides, joins and caps are in units of half the stroke width,
+// so the same vertices can be drawn with any width.
+
+uniform FrameInfo {
+  mat4 mvp;
+  float half_width;
+}
+frame_info;
+
+in vec2 position;
+in vec2 offset;
+
+void main() {
+  vec2 extruded = position + offset * frame_info.half_width;
+  gl_Position = frame_info.mvp * vec4(extruded, 0.0, 1.0);
+}
@@ -3,26 +3,9 @@
 // found in the LICENSE file.
 
 #include <impeller/texture.glsl>
-#include <impeller/types.glsl>
 
-uniform sampler2D texture_sampler;
-
-uniform FragInfo {
-  float x_tile_mode;
-  float y_tile_mode;
-  float alpha;
+vec4 Sample(sampler2D tex, vec2 coords, float x_tile_mode, float y_tile_mode) {
+  return IPSampleWithTileMode(tex, coords, x_tile_mode, y_tile_mode);
 }
-frag_info;
-
-in vec2 v_texture_coords;
 
-out vec4 frag_color;
-
-void main() {
-  frag_color = IPSampleWithTileMode(texture_sampler,   // sampler
-                                    v_texture_coords,  // texture coordinates
-                                    frag_info.x_tile_mode,  // x tile mode
-                                    frag_info.y_tile_mode   // y tile mode
-                                    ) *
-               frag_info.alpha;
-}
+#include "tiled_texture_fill.glsl"
@@ -0,0 +1,33 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Fills with a texture, tiled by the tile modes of FragInfo.
+//
+// The including shader defines how the texture is sampled, so that the
+// emulation of decal tiling is only compiled into the variant that needs it.
+// The other tile modes are applied by the sampler.
+
+#include <impeller/types.glsl>
+
+uniform sampler2D texture_sampler;
+
+uniform FragInfo {
+  float x_tile_mode;
+  float y_tile_mode;
+  float alpha;
+}
+frag_info;
+
+in vec2 v_texture_coords;
+
+out vec4 frag_color;
+
+void main() {
+  frag_color = Sample(texture_sampler,        // sampler
+                      v_texture_coords,       // texture coordinates
+                      frag_info.x_tile_mode,  // x tile mode
+                      frag_info.y_tile_mode   // y tile mode
+                      ) *
+               frag_info.alpha;
+}
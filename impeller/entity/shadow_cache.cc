@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/shadow_cache.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+ShadowCache::ShadowCache() = default;
+
+ShadowCache::~ShadowCache() = default;
+
+std::shared_ptr<Texture> ShadowCache::Get(const Key& key) {
+  auto it =
+      std::find_if(entries_.begin(), entries_.end(),
+                   [&key](const Entry& entry) { return entry.key == key; });
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  auto texture = it->texture;
+  std::rotate(it, it + 1, entries_.end());
+  return texture;
+}
+
+void ShadowCache::Set(const Key& key, std::shared_ptr<Texture> texture) {
+  entries_.erase(
+      std::remove_if(entries_.begin(), entries_.end(),
+                     [&key](const Entry& entry) { return entry.key == key; }),
+      entries_.end());
+  if (entries_.size() >= kMaxEntries) {
+    entries_.erase(entries_.begin());
+  }
+  entries_.push_back(Entry{.key = key, .texture = std::move(texture)});
+}
+
+size_t ShadowCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t ShadowCache::GetByteSize() const {
+  size_t byte_size = 0;
+  for (const auto& entry : entries_) {
+    if (entry.texture) {
+      byte_size +=
+          entry.texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+    }
+  }
+  return byte_size;
+}
+
+void ShadowCache::Clear() {
+  entries_.clear();
+}
+
+}  // namespace impeller
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/color.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/texture.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the textures of recently rendered rounded rect shadows,
+///             so that all of the shadows with the same corner radius, blur
+///             and color can be drawn by stretching a single nine patch.
+///
+///             The corner radius and sigma of the keys are measured in pixels
+///             of the render target. The least recently used textures are
+///             released once more than `kMaxEntries` are kept.
+///
+class ShadowCache {
+ public:
+  struct Key {
+    Scalar corner_radius = 0;
+    Scalar sigma = 0;
+    Color color;
+
+    bool operator==(const Key& other) const {
+      return corner_radius == other.corner_radius && sigma == other.sigma &&
+             color == other.color;
+    }
+  };
+
+  static constexpr size_t kMaxEntries = 32u;
+
+  ShadowCache();
+
+  ~ShadowCache();
+
+  /// @brief  Returns the texture kept for `key`, or nullptr if there is none.
+  std::shared_ptr<Texture> Get(const Key& key);
+
+  void Set(const Key& key, std::shared_ptr<Texture> texture);
+
+  size_t GetEntryCount() const;
+
+  /// @brief  The size of the base mip levels of the kept textures.
+  size_t GetByteSize() const;
+
+  void Clear();
+
+ private:
+  struct Entry {
+    Key key;
+    std::shared_ptr<Texture> texture;
+  };
+
+  // The entries, least recently used first.
+  std::vector<Entry> entries_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShadowCache);
+};
+
+}  // namespace impeller
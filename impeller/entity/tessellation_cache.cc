@@ -0,0 +1,79 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_cache.h"
+
+namespace impeller {
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+std::optional<VertexBuffer> TessellationCache::Get(const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return std::nullopt;
+  }
+  entries_.splice(entries_.end(), entries_, found->second);
+  return found->second->vertex_buffer;
+}
+
+bool TessellationCache::ShouldKeep(const Key& key) {
+  auto found = seen_index_.find(key);
+  if (found != seen_index_.end()) {
+    seen_keys_.erase(found->second);
+    seen_index_.erase(found);
+    return true;
+  }
+  if (seen_keys_.size() >= kMaxSeenKeyCount) {
+    seen_index_.erase(seen_keys_.front());
+    seen_keys_.pop_front();
+  }
+  seen_index_[key] = seen_keys_.insert(seen_keys_.end(), key);
+  return false;
+}
+
+void TessellationCache::Set(const Key& key,
+                            VertexBuffer vertex_buffer,
+                            size_t byte_size) {
+  if (auto found = index_.find(key); found != index_.end()) {
+    byte_size_ -= found->second->byte_size;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+  if (byte_size > max_bytes_) {
+    return;
+  }
+
+  while (!entries_.empty() && byte_size_ + byte_size > max_bytes_) {
+    byte_size_ -= entries_.front().byte_size;
+    index_.erase(entries_.front().key);
+    entries_.pop_front();
+  }
+
+  index_[key] = entries_.insert(
+      entries_.end(), Entry{.key = key,
+                            .vertex_buffer = std::move(vertex_buffer),
+                            .byte_size = byte_size});
+  byte_size_ += byte_size;
+}
+
+size_t TessellationCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+size_t TessellationCache::GetByteSize() const {
+  return byte_size_;
+}
+
+void TessellationCache::Clear() {
+  entries_.clear();
+  index_.clear();
+  byte_size_ = 0;
+  seen_keys_.clear();
+  seen_index_.clear();
+}
+
+}  // namespace impeller
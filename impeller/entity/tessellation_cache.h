@@ -0,0 +1,103 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/macros.h"
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/vertex_buffer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the vertex buffers that recently filled paths were
+///             tessellated into, so that paths that are drawn again in later
+///             frames don't need to be tessellated again.
+///
+///             Only paths with a cache key are kept, once their key has been
+///             seen in an earlier frame, so that paths that are only drawn
+///             once don't take up device buffers. The buffers are kept in
+///             device buffers rather than in the transients buffer of a
+///             frame, and the least recently used ones are released once
+///             they take up more than the byte budget of the cache.
+///
+class TessellationCache {
+ public:
+  struct Key {
+    uint64_t path_key = 0;
+    FillType fill_type = FillType::kNonZero;
+    /// The scale that the path was flattened with.
+    Scalar scale = 1;
+    /// For the extruded vertices of a stroke, its packed caps, joins and
+    /// miter limit. Zero for fills.
+    uint64_t stroke_style = 0;
+
+    bool operator==(const Key& other) const {
+      return path_key == other.path_key && fill_type == other.fill_type &&
+             scale == other.scale && stroke_style == other.stroke_style;
+    }
+
+    struct Hash {
+      size_t operator()(const Key& key) const {
+        return fml::HashCombine(key.path_key, key.fill_type, key.scale,
+                                key.stroke_style);
+      }
+    };
+  };
+
+  static constexpr size_t kDefaultMaxBytes = 8u * 1024u * 1024u;
+
+  /// The number of keys that are remembered as seen without being kept.
+  static constexpr size_t kMaxSeenKeyCount = 1024u;
+
+  explicit TessellationCache(size_t max_bytes = kDefaultMaxBytes);
+
+  ~TessellationCache();
+
+  /// @brief  Returns the vertex buffer kept for `key`, if there is one.
+  std::optional<VertexBuffer> Get(const Key& key);
+
+  /// @brief  Whether the vertices tessellated for `key` should be kept, which
+  ///         is only the case once the key was seen by an earlier call.
+  ///         Otherwise the key is remembered for the next call.
+  bool ShouldKeep(const Key& key);
+
+  /// @brief  Keeps `vertex_buffer`, whose buffers take up `byte_size` bytes,
+  ///         for `key`. Buffers that are larger than the whole budget are not
+  ///         kept.
+  void Set(const Key& key, VertexBuffer vertex_buffer, size_t byte_size);
+
+  size_t GetEntryCount() const;
+
+  size_t GetByteSize() const;
+
+  void Clear();
+
+ private:
+  struct Entry {
+    Key key;
+    VertexBuffer vertex_buffer;
+    size_t byte_size = 0;
+  };
+
+  const size_t max_bytes_;
+  // The entries, least recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash> index_;
+  size_t byte_size_ = 0;
+  // The keys that were seen without being kept, least recently seen first.
+  std::list<Key> seen_keys_;
+  std::unordered_map<Key, std::list<Key>::iterator, Key::Hash> seen_index_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellationCache);
+};
+
+}  // namespace impeller
@@ -760,6 +760,13 @@ struct Color {
   constexpr bool IsTransparent() const { return alpha == 0.0; }
 
   constexpr bool IsOpaque() const { return alpha == 1.0; }
+
+  /// @brief  Whether all of the components are within [0, 1], and so can be
+  ///         stored in an 8-bit format without being clamped.
+  constexpr bool IsInStandardRange() const {
+    return red >= 0.0 && red <= 1.0 && green >= 0.0 && green <= 1.0 &&
+           blue >= 0.0 && blue <= 1.0 && alpha >= 0.0 && alpha <= 1.0;
+  }
 };
 
 /**
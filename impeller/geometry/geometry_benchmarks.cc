@@ -4,8 +4,10 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "impeller/geometry/matrix.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -16,6 +18,8 @@ namespace {
 Path CreateCubic();
 /// Similar to the path above, but with all cubics replaced by quadratics.
 Path CreateQuadratic();
+/// A grid of circles and rounded rects, which are made only of curves.
+Path CreateRoundedShapes();
 }  // namespace
 
 static Tessellator tess;
@@ -48,6 +52,98 @@ BENCHMARK_CAPTURE(BM_Polyline, cubic_polyline_tess, CreateCubic(), true);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(), true);
 
+template <class... Args>
+static void BM_CurvePolyline(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto path = std::get<Path>(args_tuple);
+  auto scale = std::get<Scalar>(args_tuple);
+
+  size_t single_point_count = 0u;
+  while (state.KeepRunning()) {
+    auto polyline = path.CreatePolyline(scale);
+    single_point_count = polyline.points.size();
+    benchmark::DoNotOptimize(polyline);
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+}
+
+BENCHMARK_CAPTURE(BM_CurvePolyline,
+                  cubic_polyline_scaled,
+                  CreateCubic(),
+                  Scalar{8.0f});
+BENCHMARK_CAPTURE(BM_CurvePolyline,
+                  quad_polyline_scaled,
+                  CreateQuadratic(),
+                  Scalar{8.0f});
+BENCHMARK_CAPTURE(BM_CurvePolyline,
+                  rounded_shapes_polyline,
+                  CreateRoundedShapes(),
+                  Scalar{1.0f});
+BENCHMARK_CAPTURE(BM_CurvePolyline,
+                  rounded_shapes_polyline_scaled,
+                  CreateRoundedShapes(),
+                  Scalar{8.0f});
+
+static Matrix CreateTransform() {
+  return Matrix::MakeTranslation({10, 20, 0}) *
+         Matrix::MakeRotationZ(Radians{0.5}) * Matrix::MakeScale({2, 3, 1});
+}
+
+static void BM_MatrixMultiply(benchmark::State& state) {
+  auto a = CreateTransform();
+  auto b = Matrix::MakePerspective(Radians{1}, 1.0f, 0.1f, 100.0f);
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    auto result = a * b;
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_MatrixMultiply);
+
+static void BM_MatrixInvert(benchmark::State& state) {
+  auto matrix = Matrix::MakePerspective(Radians{1}, 1.0f, 0.1f, 100.0f) *
+                CreateTransform();
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(matrix);
+    auto result = matrix.Invert();
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK(BM_MatrixInvert);
+
+static void BM_MatrixTransformPoints(benchmark::State& state) {
+  auto transform = CreateTransform();
+  std::vector<Point> points(state.range(0));
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = Point(i, i * 0.5f);
+  }
+  std::vector<Point> result(points.size());
+  for ([[maybe_unused]] auto _ : state) {
+    transform.TransformPoints(points.data(), result.data(), points.size());
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+BENCHMARK(BM_MatrixTransformPoints)->Arg(16)->Arg(1024);
+
+static void BM_RectTransformBounds(benchmark::State& state) {
+  auto transform = CreateTransform();
+  auto rect = Rect::MakeXYWH(10, 20, 300, 400);
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(rect);
+    benchmark::DoNotOptimize(transform);
+    auto bounds = rect.TransformBounds(transform);
+    benchmark::DoNotOptimize(bounds);
+  }
+}
+
+BENCHMARK(BM_RectTransformBounds);
+
 namespace {
 Path CreateCubic() {
   return PathBuilder{}
@@ -312,5 +408,20 @@ Path CreateQuadratic() {
       .TakePath();
 }
 
+Path CreateRoundedShapes() {
+  PathBuilder builder;
+  for (int i = 0; i < 20; i++) {
+    for (int j = 0; j < 20; j++) {
+      const Point origin(i * 50.0f, j * 50.0f);
+      if ((i + j) % 2 == 0) {
+        builder.AddCircle(origin + Point(20, 20), 20);
+      } else {
+        builder.AddRoundedRect(Rect(origin, Size(40, 30)), 8);
+      }
+    }
+  }
+  return builder.TakePath();
+}
+
 }  // namespace
 }  // namespace impeller
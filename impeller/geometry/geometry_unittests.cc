@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <sstream>
+#include <vector>
 
 #include "flutter/testing/testing.h"
 #include "impeller/geometry/constants.h"
@@ -128,6 +129,53 @@ TEST(GeometryTest, InvertMatrix) {
   ASSERT_MATRIX_NEAR(inverted, result);
 }
 
+TEST(GeometryTest, InvertSingularMatrixIsIdentity) {
+  auto inverted = Matrix::MakeScale({1, 0, 1}).Invert();
+  ASSERT_MATRIX_NEAR(inverted, Matrix());
+}
+
+TEST(GeometryTest, MatrixTransformPointsMatchesScalarTransform) {
+  std::vector<Point> points;
+  for (int i = 0; i < 11; i++) {
+    points.emplace_back(i * 1.5f, i * -2.25f + 3);
+  }
+  auto affine = Matrix::MakeTranslation({10, 20, 0}) *
+                Matrix::MakeRotationZ(Radians{0.5}) *
+                Matrix::MakeScale({2, 3, 1});
+  auto perspective =
+      Matrix::MakePerspective(Radians{1}, 1.0f, 0.1f, 100.0f) * affine;
+
+  for (const auto& transform : {affine, perspective}) {
+    std::vector<Point> result(points.size());
+    transform.TransformPoints(points.data(), result.data(), points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+      ASSERT_POINT_NEAR(result[i], transform * points[i]);
+    }
+
+    // The points can be transformed in place.
+    auto in_place = points;
+    transform.TransformPoints(in_place.data(), in_place.data(),
+                              in_place.size());
+    ASSERT_EQ(in_place, result);
+  }
+}
+
+TEST(GeometryTest, RectTransformBoundsMatchesTransformedPoints) {
+  auto rect = Rect::MakeXYWH(-5, 3, 20, 8);
+  auto affine = Matrix::MakeTranslation({10, 20, 0}) *
+                Matrix::MakeRotationZ(Radians{0.5}) *
+                Matrix::MakeScale({2, 3, 1});
+  auto perspective =
+      Matrix::MakePerspective(Radians{1}, 1.0f, 0.1f, 100.0f) * affine;
+
+  for (const auto& transform : {Matrix(), affine, perspective}) {
+    auto points = rect.GetTransformedPoints(transform);
+    auto expected = Rect::MakePointBounds(points.begin(), points.end());
+    ASSERT_TRUE(expected.has_value());
+    ASSERT_RECT_NEAR(rect.TransformBounds(transform), expected.value());
+  }
+}
+
 TEST(GeometryTest, TestDecomposition) {
   auto rotated = Matrix::MakeRotationZ(Radians{kPiOver4});
 
@@ -581,6 +629,33 @@ TEST(GeometryTest, EmptyPath) {
   ASSERT_TRUE(polyline.contours.empty());
 }
 
+TEST(GeometryTest, PathCopiesAreUnchangedByLaterComponents) {
+  PathBuilder builder;
+  builder.MoveTo({0, 0}).LineTo({100, 0}).LineTo({100, 100});
+  auto path = builder.CopyPath();
+  builder.LineTo({0, 100}).Close();
+  auto copy = path;
+  path.AddCubicComponent({0, 0}, {10, 10}, {20, 20}, {30, 30});
+
+  ASSERT_EQ(copy.GetComponentCount(), 3u);
+  ASSERT_EQ(path.GetComponentCount(), 4u);
+  ASSERT_EQ(builder.GetCurrentPath().GetComponentCount(), 6u);
+
+  LinearPathComponent linear;
+  ASSERT_TRUE(copy.GetLinearComponentAtIndex(2, linear));
+  ASSERT_EQ(linear.p2, Point(100, 100));
+  CubicPathComponent cubic;
+  ASSERT_FALSE(copy.GetCubicComponentAtIndex(3, cubic));
+  ASSERT_TRUE(path.GetCubicComponentAtIndex(3, cubic));
+  ASSERT_EQ(cubic.cp2, Point(20, 20));
+
+  ContourComponent contour;
+  ASSERT_TRUE(builder.GetCurrentPath().GetContourComponentAtIndex(0, contour));
+  ASSERT_TRUE(contour.is_closed);
+  ASSERT_TRUE(copy.GetContourComponentAtIndex(0, contour));
+  ASSERT_FALSE(contour.is_closed);
+}
+
 TEST(GeometryTest, SimplePath) {
   Path path;
 
@@ -7,6 +7,8 @@
 #include <climits>
 #include <sstream>
 
+#include "impeller/geometry/simd.h"
+
 namespace impeller {
 
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
@@ -94,7 +96,137 @@ Matrix Matrix::operator+(const Matrix& o) const {
   );
 }
 
+Matrix Matrix::Multiply(const Matrix& o) const {
+#if IMPELLER_GEOMETRY_SIMD
+  // Each column of the product is the columns of this matrix weighed by the
+  // components of the same column of |o|.
+  simd::Float4 c0 = simd::Load(m);
+  simd::Float4 c1 = simd::Load(m + 4);
+  simd::Float4 c2 = simd::Load(m + 8);
+  simd::Float4 c3 = simd::Load(m + 12);
+  Matrix result;
+  for (int i = 0; i < 4; i++) {
+    const Scalar* column = o.m + i * 4;
+    simd::Float4 r = simd::Mul(c0, simd::Splat(column[0]));
+    r = simd::MulAdd(r, c1, simd::Splat(column[1]));
+    r = simd::MulAdd(r, c2, simd::Splat(column[2]));
+    r = simd::MulAdd(r, c3, simd::Splat(column[3]));
+    simd::Store(result.m + i * 4, r);
+  }
+  return result;
+#else
+  // clang-format off
+  return Matrix(
+      m[0] * o.m[0]  + m[4] * o.m[1]  + m[8]  * o.m[2]  + m[12] * o.m[3],
+      m[1] * o.m[0]  + m[5] * o.m[1]  + m[9]  * o.m[2]  + m[13] * o.m[3],
+      m[2] * o.m[0]  + m[6] * o.m[1]  + m[10] * o.m[2]  + m[14] * o.m[3],
+      m[3] * o.m[0]  + m[7] * o.m[1]  + m[11] * o.m[2]  + m[15] * o.m[3],
+      m[0] * o.m[4]  + m[4] * o.m[5]  + m[8]  * o.m[6]  + m[12] * o.m[7],
+      m[1] * o.m[4]  + m[5] * o.m[5]  + m[9]  * o.m[6]  + m[13] * o.m[7],
+      m[2] * o.m[4]  + m[6] * o.m[5]  + m[10] * o.m[6]  + m[14] * o.m[7],
+      m[3] * o.m[4]  + m[7] * o.m[5]  + m[11] * o.m[6]  + m[15] * o.m[7],
+      m[0] * o.m[8]  + m[4] * o.m[9]  + m[8]  * o.m[10] + m[12] * o.m[11],
+      m[1] * o.m[8]  + m[5] * o.m[9]  + m[9]  * o.m[10] + m[13] * o.m[11],
+      m[2] * o.m[8]  + m[6] * o.m[9]  + m[10] * o.m[10] + m[14] * o.m[11],
+      m[3] * o.m[8]  + m[7] * o.m[9]  + m[11] * o.m[10] + m[15] * o.m[11],
+      m[0] * o.m[12] + m[4] * o.m[13] + m[8]  * o.m[14] + m[12] * o.m[15],
+      m[1] * o.m[12] + m[5] * o.m[13] + m[9]  * o.m[14] + m[13] * o.m[15],
+      m[2] * o.m[12] + m[6] * o.m[13] + m[10] * o.m[14] + m[14] * o.m[15],
+      m[3] * o.m[12] + m[7] * o.m[13] + m[11] * o.m[14] + m[15] * o.m[15]);
+  // clang-format on
+#endif  // IMPELLER_GEOMETRY_SIMD
+}
+
+#if IMPELLER_GEOMETRY_SIMD
+// The 2x2 matrices of the vectorized inverse are stored as the four lanes
+// (a, b, c, d) of the matrix
+//
+//   | a b |
+//   | c d |
+
+/// a * b
+static simd::Float4 Mat2Mul(simd::Float4 a, simd::Float4 b) {
+  return simd::MulAdd(simd::Mul(a, simd::Swizzle<0, 3, 0, 3>(b)),
+                      simd::Swizzle<1, 0, 3, 2>(a),
+                      simd::Swizzle<2, 1, 2, 1>(b));
+}
+
+/// adjugate(a) * b
+static simd::Float4 Mat2AdjMul(simd::Float4 a, simd::Float4 b) {
+  return simd::Sub(
+      simd::Mul(simd::Swizzle<3, 3, 0, 0>(a), b),
+      simd::Mul(simd::Swizzle<1, 1, 2, 2>(a), simd::Swizzle<2, 3, 0, 1>(b)));
+}
+
+/// a * adjugate(b)
+static simd::Float4 Mat2MulAdj(simd::Float4 a, simd::Float4 b) {
+  return simd::Sub(
+      simd::Mul(a, simd::Swizzle<3, 0, 3, 0>(b)),
+      simd::Mul(simd::Swizzle<1, 0, 3, 2>(a), simd::Swizzle<2, 1, 2, 1>(b)));
+}
+#endif  // IMPELLER_GEOMETRY_SIMD
+
 Matrix Matrix::Invert() const {
+#if IMPELLER_GEOMETRY_SIMD
+  // Inverts the matrix blockwise, as four 2x2 matrices:
+  //
+  //   | A B |
+  //   | C D |
+  //
+  // The inverse of the transpose is the transpose of the inverse, so the
+  // columns are treated as rows without changing the result.
+  simd::Float4 c0 = simd::Load(m);
+  simd::Float4 c1 = simd::Load(m + 4);
+  simd::Float4 c2 = simd::Load(m + 8);
+  simd::Float4 c3 = simd::Load(m + 12);
+
+  simd::Float4 a = simd::Shuffle<0, 1, 0, 1>(c0, c1);
+  simd::Float4 b = simd::Shuffle<2, 3, 2, 3>(c0, c1);
+  simd::Float4 c = simd::Shuffle<0, 1, 0, 1>(c2, c3);
+  simd::Float4 d = simd::Shuffle<2, 3, 2, 3>(c2, c3);
+
+  // The determinants of A, B, C and D.
+  simd::Float4 det_sub = simd::Sub(
+      simd::Mul(simd::Shuffle<0, 2, 0, 2>(c0, c2),
+                simd::Shuffle<1, 3, 1, 3>(c1, c3)),
+      simd::Mul(simd::Shuffle<1, 3, 1, 3>(c0, c2),
+                simd::Shuffle<0, 2, 0, 2>(c1, c3)));
+  simd::Float4 det_a = simd::Swizzle<0, 0, 0, 0>(det_sub);
+  simd::Float4 det_b = simd::Swizzle<1, 1, 1, 1>(det_sub);
+  simd::Float4 det_c = simd::Swizzle<2, 2, 2, 2>(det_sub);
+  simd::Float4 det_d = simd::Swizzle<3, 3, 3, 3>(det_sub);
+
+  simd::Float4 d_c = Mat2AdjMul(d, c);
+  simd::Float4 a_b = Mat2AdjMul(a, b);
+
+  // The adjugates of the blocks of the inverse.
+  simd::Float4 x = simd::Sub(simd::Mul(det_d, a), Mat2Mul(b, d_c));
+  simd::Float4 w = simd::Sub(simd::Mul(det_a, d), Mat2Mul(c, a_b));
+  simd::Float4 y = simd::Sub(simd::Mul(det_b, c), Mat2MulAdj(d, a_b));
+  simd::Float4 z = simd::Sub(simd::Mul(det_c, b), Mat2MulAdj(a, d_c));
+
+  // |M| = |A| |D| + |B| |C| - tr(adjugate(A) B adjugate(D) C)
+  simd::Float4 det = simd::MulAdd(simd::Mul(det_a, det_d), det_b, det_c);
+  simd::Float4 trace =
+      simd::SumLanes(simd::Mul(a_b, simd::Swizzle<0, 2, 1, 3>(d_c)));
+  det = simd::Sub(det, trace);
+  if (simd::GetX(det) == 0) {
+    return {};
+  }
+
+  simd::Float4 inverse_det = simd::Div(simd::Make(1, -1, -1, 1), det);
+  x = simd::Mul(x, inverse_det);
+  y = simd::Mul(y, inverse_det);
+  z = simd::Mul(z, inverse_det);
+  w = simd::Mul(w, inverse_det);
+
+  Matrix result;
+  simd::Store(result.m, simd::Shuffle<3, 1, 3, 1>(x, y));
+  simd::Store(result.m + 4, simd::Shuffle<2, 0, 2, 0>(x, y));
+  simd::Store(result.m + 8, simd::Shuffle<3, 1, 3, 1>(z, w));
+  simd::Store(result.m + 12, simd::Shuffle<2, 0, 2, 0>(z, w));
+  return result;
+#else
   Matrix tmp{
       m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] +
           m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10],
@@ -157,6 +289,40 @@ Matrix Matrix::Invert() const {
           tmp.m[4] * det,  tmp.m[5] * det,  tmp.m[6] * det,  tmp.m[7] * det,
           tmp.m[8] * det,  tmp.m[9] * det,  tmp.m[10] * det, tmp.m[11] * det,
           tmp.m[12] * det, tmp.m[13] * det, tmp.m[14] * det, tmp.m[15] * det};
+#endif  // IMPELLER_GEOMETRY_SIMD
+}
+
+void Matrix::TransformPoints(const Point* points,
+                             Point* result,
+                             size_t count) const {
+  size_t i = 0;
+#if IMPELLER_GEOMETRY_SIMD
+  static_assert(sizeof(Point) == 2 * sizeof(Scalar));
+  // Perspective transforms divide by w, which is left to the scalar loop
+  // below for the case where it is zero.
+  if (m[3] == 0 && m[7] == 0 && m[15] == 1) {
+    simd::Float4 m0 = simd::Splat(m[0]);
+    simd::Float4 m1 = simd::Splat(m[1]);
+    simd::Float4 m4 = simd::Splat(m[4]);
+    simd::Float4 m5 = simd::Splat(m[5]);
+    simd::Float4 m12 = simd::Splat(m[12]);
+    simd::Float4 m13 = simd::Splat(m[13]);
+    for (; i + 4 <= count; i += 4) {
+      simd::Float4 x;
+      simd::Float4 y;
+      simd::LoadPoints(reinterpret_cast<const Scalar*>(points + i), x, y);
+      simd::Float4 result_x =
+          simd::Add(simd::MulAdd(simd::Mul(x, m0), y, m4), m12);
+      simd::Float4 result_y =
+          simd::Add(simd::MulAdd(simd::Mul(x, m1), y, m5), m13);
+      simd::StorePoints(reinterpret_cast<Scalar*>(result + i), result_x,
+                        result_y);
+    }
+  }
+#endif  // IMPELLER_GEOMETRY_SIMD
+  for (; i < count; i++) {
+    result[i] = *this * points[i];
+  }
 }
 
 Scalar Matrix::GetDeterminant() const {
@@ -251,27 +251,12 @@ struct Matrix {
     // clang-format on
   }
 
-  constexpr Matrix Multiply(const Matrix& o) const {
-    // clang-format off
-    return Matrix(
-        m[0] * o.m[0]  + m[4] * o.m[1]  + m[8]  * o.m[2]  + m[12] * o.m[3],
-        m[1] * o.m[0]  + m[5] * o.m[1]  + m[9]  * o.m[2]  + m[13] * o.m[3],
-        m[2] * o.m[0]  + m[6] * o.m[1]  + m[10] * o.m[2]  + m[14] * o.m[3],
-        m[3] * o.m[0]  + m[7] * o.m[1]  + m[11] * o.m[2]  + m[15] * o.m[3],
-        m[0] * o.m[4]  + m[4] * o.m[5]  + m[8]  * o.m[6]  + m[12] * o.m[7],
-        m[1] * o.m[4]  + m[5] * o.m[5]  + m[9]  * o.m[6]  + m[13] * o.m[7],
-        m[2] * o.m[4]  + m[6] * o.m[5]  + m[10] * o.m[6]  + m[14] * o.m[7],
-        m[3] * o.m[4]  + m[7] * o.m[5]  + m[11] * o.m[6]  + m[15] * o.m[7],
-        m[0] * o.m[8]  + m[4] * o.m[9]  + m[8]  * o.m[10] + m[12] * o.m[11],
-        m[1] * o.m[8]  + m[5] * o.m[9]  + m[9]  * o.m[10] + m[13] * o.m[11],
-        m[2] * o.m[8]  + m[6] * o.m[9]  + m[10] * o.m[10] + m[14] * o.m[11],
-        m[3] * o.m[8]  + m[7] * o.m[9]  + m[11] * o.m[10] + m[15] * o.m[11],
-        m[0] * o.m[12] + m[4] * o.m[13] + m[8]  * o.m[14] + m[12] * o.m[15],
-        m[1] * o.m[12] + m[5] * o.m[13] + m[9]  * o.m[14] + m[13] * o.m[15],
-        m[2] * o.m[12] + m[6] * o.m[13] + m[10] * o.m[14] + m[14] * o.m[15],
-        m[3] * o.m[12] + m[7] * o.m[13] + m[11] * o.m[14] + m[15] * o.m[15]);
-    // clang-format on
-  }
+  //----------------------------------------------------------------------------
+  /// @brief      The product of this matrix and |o|, which applies |o| first.
+  ///
+  ///             Vectorized with NEON or SSE when the target supports them.
+  ///
+  Matrix Multiply(const Matrix& o) const;
 
   constexpr Matrix Transpose() const {
     // clang-format off
@@ -284,6 +269,12 @@ struct Matrix {
     // clang-format on
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      The inverse of this matrix, or the identity matrix if it
+  ///             isn't invertible.
+  ///
+  ///             Vectorized with NEON or SSE when the target supports them.
+  ///
   Matrix Invert() const;
 
   Scalar GetDeterminant() const;
@@ -422,6 +413,20 @@ struct Matrix {
     return result * w;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Transforms each of |points| the way |operator*| does.
+  ///
+  ///             Vectorized with NEON or SSE when the target supports them,
+  ///             which makes it faster than transforming the points one at a
+  ///             time.
+  ///
+  /// @param[in]  points  The points to transform.
+  /// @param[out] result  Where the transformed points are written. It may be
+  ///                     |points| itself.
+  /// @param[in]  count   The number of points.
+  ///
+  void TransformPoints(const Point* points, Point* result, size_t count) const;
+
   constexpr Vector4 TransformDirection(const Vector4& v) const {
     return Vector4(v.x * m[0] + v.y * m[4] + v.z * m[8],
                    v.x * m[1] + v.y * m[5] + v.z * m[9],
@@ -11,7 +11,7 @@
 
 namespace impeller {
 
-Path::Path() {
+Path::Path() : data_(std::make_shared<Data>()) {
   AddContourComponent({});
 };
 
@@ -30,7 +30,13 @@ std::tuple<size_t, size_t> Path::Polyline::GetContourPointBounds(
 }
 
 size_t Path::GetComponentCount() const {
-  return components_.size();
+  return data_->verbs.size();
+}
+
+void Path::Reserve(size_t component_count, size_t point_count) {
+  auto& data = GetMutableData();
+  data.verbs.reserve(component_count);
+  data.points.reserve(point_count);
 }
 
 void Path::SetFillType(FillType fill) {
@@ -41,38 +47,75 @@ FillType Path::GetFillType() const {
   return fill_;
 }
 
+void Path::SetCacheKey(std::optional<uint64_t> cache_key) {
+  cache_key_ = cache_key;
+}
+
+std::optional<uint64_t> Path::GetCacheKey() const {
+  return cache_key_;
+}
+
+Path::Data& Path::GetMutableData() {
+  // Paths that share data are never modified, so copies of a path made
+  // before it is modified keep their components.
+  if (data_.use_count() > 1) {
+    data_ = std::make_shared<Data>(*data_);
+  }
+  return *data_;
+}
+
 Path& Path::AddLinearComponent(Point p1, Point p2) {
-  linears_.emplace_back(p1, p2);
-  components_.emplace_back(ComponentType::kLinear, linears_.size() - 1);
+  cache_key_.reset();
+  auto& data = GetMutableData();
+  data.verbs.push_back(Verb::kLinear);
+  data.points.insert(data.points.end(), {p1, p2});
+  data.has_segments = true;
   return *this;
 }
 
 Path& Path::AddQuadraticComponent(Point p1, Point cp, Point p2) {
-  quads_.emplace_back(p1, cp, p2);
-  components_.emplace_back(ComponentType::kQuadratic, quads_.size() - 1);
+  cache_key_.reset();
+  auto& data = GetMutableData();
+  data.verbs.push_back(Verb::kQuadratic);
+  data.points.insert(data.points.end(), {p1, cp, p2});
+  data.has_segments = true;
   return *this;
 }
 
 Path& Path::AddCubicComponent(Point p1, Point cp1, Point cp2, Point p2) {
-  cubics_.emplace_back(p1, cp1, cp2, p2);
-  components_.emplace_back(ComponentType::kCubic, cubics_.size() - 1);
+  cache_key_.reset();
+  auto& data = GetMutableData();
+  data.verbs.push_back(Verb::kCubic);
+  data.points.insert(data.points.end(), {p1, cp1, cp2, p2});
+  data.has_segments = true;
   return *this;
 }
 
 Path& Path::AddContourComponent(Point destination, bool is_closed) {
-  if (components_.size() > 0 &&
-      components_.back().type == ComponentType::kContour) {
+  cache_key_.reset();
+  auto& data = GetMutableData();
+  const auto verb = is_closed ? Verb::kClosedContour : Verb::kContour;
+  if (!data.verbs.empty() &&
+      GetComponentType(data.verbs.back()) == ComponentType::kContour) {
     // Never insert contiguous contours.
-    contours_.back() = ContourComponent(destination, is_closed);
+    data.verbs.back() = verb;
+    data.points.back() = destination;
   } else {
-    contours_.emplace_back(ContourComponent(destination, is_closed));
-    components_.emplace_back(ComponentType::kContour, contours_.size() - 1);
+    data.verbs.push_back(verb);
+    data.points.push_back(destination);
   }
   return *this;
 }
 
 void Path::SetContourClosed(bool is_closed) {
-  contours_.back().is_closed = is_closed;
+  cache_key_.reset();
+  auto& data = GetMutableData();
+  for (auto it = data.verbs.rbegin(); it != data.verbs.rend(); ++it) {
+    if (GetComponentType(*it) == ComponentType::kContour) {
+      *it = is_closed ? Verb::kClosedContour : Verb::kContour;
+      return;
+    }
+  }
 }
 
 void Path::EnumerateComponents(
@@ -80,267 +123,337 @@ void Path::EnumerateComponents(
     const Applier<QuadraticPathComponent>& quad_applier,
     const Applier<CubicPathComponent>& cubic_applier,
     const Applier<ContourComponent>& contour_applier) const {
-  size_t currentIndex = 0;
-  for (const auto& component : components_) {
-    switch (component.type) {
-      case ComponentType::kLinear:
+  const auto& verbs = data_->verbs;
+  const Point* points = data_->points.data();
+  for (size_t index = 0; index < verbs.size(); index++) {
+    const auto verb = verbs[index];
+    switch (verb) {
+      case Verb::kLinear:
         if (linear_applier) {
-          linear_applier(currentIndex, linears_[component.index]);
+          linear_applier(index, LinearPathComponent(points[0], points[1]));
         }
         break;
-      case ComponentType::kQuadratic:
+      case Verb::kQuadratic:
         if (quad_applier) {
-          quad_applier(currentIndex, quads_[component.index]);
+          quad_applier(index,
+                       QuadraticPathComponent(points[0], points[1], points[2]));
         }
         break;
-      case ComponentType::kCubic:
+      case Verb::kCubic:
         if (cubic_applier) {
-          cubic_applier(currentIndex, cubics_[component.index]);
+          cubic_applier(index, CubicPathComponent(points[0], points[1],
+                                                  points[2], points[3]));
         }
         break;
-      case ComponentType::kContour:
+      case Verb::kContour:
+      case Verb::kClosedContour:
         if (contour_applier) {
-          contour_applier(currentIndex, contours_[component.index]);
+          contour_applier(index, ContourComponent(
+                                     points[0], verb == Verb::kClosedContour));
         }
         break;
     }
-    currentIndex++;
+    points += GetPointCount(verb);
   }
 }
 
-bool Path::GetLinearComponentAtIndex(size_t index,
-                                     LinearPathComponent& linear) const {
-  if (index >= components_.size()) {
-    return false;
+std::optional<size_t> Path::GetPointIndex(size_t index,
+                                          ComponentType type) const {
+  const auto& verbs = data_->verbs;
+  if (index >= verbs.size() || GetComponentType(verbs[index]) != type) {
+    return std::nullopt;
   }
+  // The path builder looks up the last component, whose points are at the
+  // end, to continue smooth curves.
+  if (index == verbs.size() - 1) {
+    return data_->points.size() - GetPointCount(verbs[index]);
+  }
+  size_t point_index = 0;
+  for (size_t i = 0; i < index; i++) {
+    point_index += GetPointCount(verbs[i]);
+  }
+  return point_index;
+}
 
-  if (components_[index].type != ComponentType::kLinear) {
+bool Path::GetLinearComponentAtIndex(size_t index,
+                                     LinearPathComponent& linear) const {
+  auto point_index = GetPointIndex(index, ComponentType::kLinear);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  linear = linears_[components_[index].index];
+  const Point* points = &data_->points[point_index.value()];
+  linear = LinearPathComponent(points[0], points[1]);
   return true;
 }
 
 bool Path::GetQuadraticComponentAtIndex(
     size_t index,
     QuadraticPathComponent& quadratic) const {
-  if (index >= components_.size()) {
+  auto point_index = GetPointIndex(index, ComponentType::kQuadratic);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kQuadratic) {
-    return false;
-  }
-
-  quadratic = quads_[components_[index].index];
+  const Point* points = &data_->points[point_index.value()];
+  quadratic = QuadraticPathComponent(points[0], points[1], points[2]);
   return true;
 }
 
 bool Path::GetCubicComponentAtIndex(size_t index,
                                     CubicPathComponent& cubic) const {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kCubic) {
+  auto point_index = GetPointIndex(index, ComponentType::kCubic);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  cubic = cubics_[components_[index].index];
+  const Point* points = &data_->points[point_index.value()];
+  cubic = CubicPathComponent(points[0], points[1], points[2], points[3]);
   return true;
 }
 
 bool Path::GetContourComponentAtIndex(size_t index,
                                       ContourComponent& move) const {
-  if (index >= components_.size()) {
+  auto point_index = GetPointIndex(index, ComponentType::kContour);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kContour) {
-    return false;
-  }
-
-  move = contours_[components_[index].index];
+  move = ContourComponent(data_->points[point_index.value()],
+                          data_->verbs[index] == Verb::kClosedContour);
   return true;
 }
 
 bool Path::UpdateLinearComponentAtIndex(size_t index,
                                         const LinearPathComponent& linear) {
-  if (index >= components_.size()) {
+  auto point_index = GetPointIndex(index, ComponentType::kLinear);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kLinear) {
-    return false;
-  }
-
-  linears_[components_[index].index] = linear;
+  cache_key_.reset();
+  Point* points = &GetMutableData().points[point_index.value()];
+  points[0] = linear.p1;
+  points[1] = linear.p2;
   return true;
 }
 
 bool Path::UpdateQuadraticComponentAtIndex(
     size_t index,
     const QuadraticPathComponent& quadratic) {
-  if (index >= components_.size()) {
+  auto point_index = GetPointIndex(index, ComponentType::kQuadratic);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kQuadratic) {
-    return false;
-  }
-
-  quads_[components_[index].index] = quadratic;
+  cache_key_.reset();
+  Point* points = &GetMutableData().points[point_index.value()];
+  points[0] = quadratic.p1;
+  points[1] = quadratic.cp;
+  points[2] = quadratic.p2;
   return true;
 }
 
 bool Path::UpdateCubicComponentAtIndex(size_t index,
                                        CubicPathComponent& cubic) {
-  if (index >= components_.size()) {
-    return false;
-  }
-
-  if (components_[index].type != ComponentType::kCubic) {
+  auto point_index = GetPointIndex(index, ComponentType::kCubic);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  cubics_[components_[index].index] = cubic;
+  cache_key_.reset();
+  Point* points = &GetMutableData().points[point_index.value()];
+  points[0] = cubic.p1;
+  points[1] = cubic.cp1;
+  points[2] = cubic.cp2;
+  points[3] = cubic.p2;
   return true;
 }
 
 bool Path::UpdateContourComponentAtIndex(size_t index,
                                          const ContourComponent& move) {
-  if (index >= components_.size()) {
+  auto point_index = GetPointIndex(index, ComponentType::kContour);
+  if (!point_index.has_value()) {
     return false;
   }
 
-  if (components_[index].type != ComponentType::kContour) {
-    return false;
+  cache_key_.reset();
+  auto& data = GetMutableData();
+  data.points[point_index.value()] = move.destination;
+  data.verbs[index] = move.is_closed ? Verb::kClosedContour : Verb::kContour;
+  return true;
+}
+
+std::optional<Vector2> Path::GetStartDirection(Verb verb, const Point* points) {
+  switch (verb) {
+    case Verb::kLinear:
+      return LinearPathComponent(points[0], points[1]).GetStartDirection();
+    case Verb::kQuadratic:
+      return QuadraticPathComponent(points[0], points[1], points[2])
+          .GetStartDirection();
+    case Verb::kCubic:
+      return CubicPathComponent(points[0], points[1], points[2], points[3])
+          .GetStartDirection();
+    case Verb::kContour:
+    case Verb::kClosedContour:
+      return std::nullopt;
   }
+  return std::nullopt;
+}
 
-  contours_[components_[index].index] = move;
-  return true;
+std::optional<Vector2> Path::GetEndDirection(Verb verb, const Point* points) {
+  switch (verb) {
+    case Verb::kLinear:
+      return LinearPathComponent(points[0], points[1]).GetEndDirection();
+    case Verb::kQuadratic:
+      return QuadraticPathComponent(points[0], points[1], points[2])
+          .GetEndDirection();
+    case Verb::kCubic:
+      return CubicPathComponent(points[0], points[1], points[2], points[3])
+          .GetEndDirection();
+    case Verb::kContour:
+    case Verb::kClosedContour:
+      return std::nullopt;
+  }
+  return std::nullopt;
 }
 
 Path::Polyline Path::CreatePolyline(Scalar scale) const {
+  const auto& verbs = data_->verbs;
+  const auto& points = data_->points;
+
   Polyline polyline;
+  // Lines add one point and contours add their destination. Curves are
+  // usually flattened to a few points each, so this is close to the final
+  // size for most paths.
+  constexpr size_t kEstimatedPointsPerCurve = 8u;
+  size_t curve_count = 0;
+  for (const auto verb : verbs) {
+    if (verb == Verb::kQuadratic || verb == Verb::kCubic) {
+      curve_count++;
+    }
+  }
+  polyline.points.reserve(verbs.size() - curve_count +
+                          curve_count * kEstimatedPointsPerCurve);
 
   std::optional<Point> previous_contour_point;
-  auto collect_points = [&polyline, &previous_contour_point](
-                            const std::vector<Point>& collection) {
-    if (collection.empty()) {
+  auto collect_point = [&polyline, &previous_contour_point](Point point) {
+    if (previous_contour_point.has_value() &&
+        previous_contour_point.value() == point) {
+      // Skip over duplicate points in the same contour.
       return;
     }
-
-    for (const auto& point : collection) {
+    previous_contour_point = point;
+    polyline.points.push_back(point);
+  };
+  // Curves append their points to the polyline directly, and the duplicate
+  // points are then removed in place.
+  auto collect_curve_points = [&polyline, &previous_contour_point](
+                                  const auto& curve, Scalar scale) {
+    const size_t first = polyline.points.size();
+    curve.FillPointsForPolyline(polyline.points, scale);
+    size_t count = first;
+    for (size_t i = first; i < polyline.points.size(); i++) {
+      const auto point = polyline.points[i];
       if (previous_contour_point.has_value() &&
           previous_contour_point.value() == point) {
-        // Skip over duplicate points in the same contour.
         continue;
       }
       previous_contour_point = point;
-      polyline.points.push_back(point);
+      polyline.points[count++] = point;
     }
+    polyline.points.resize(count);
   };
 
-  auto get_path_component =
-      [this](size_t component_i) -> std::optional<const PathComponent*> {
-    if (component_i >= components_.size()) {
-      return std::nullopt;
-    }
-    const auto& component = components_[component_i];
-    switch (component.type) {
-      case ComponentType::kLinear:
-        return &linears_[component.index];
-      case ComponentType::kQuadratic:
-        return &quads_[component.index];
-      case ComponentType::kCubic:
-        return &cubics_[component.index];
-      case ComponentType::kContour:
-        return std::nullopt;
+  // The start direction of a contour is the start direction of its first
+  // segment that has one.
+  auto compute_contour_start_direction = [&verbs, &points](
+                                             size_t contour_index,
+                                             size_t point_index) {
+    point_index += GetPointCount(verbs[contour_index]);
+    for (size_t i = contour_index + 1; i < verbs.size(); i++) {
+      if (GetComponentType(verbs[i]) == ComponentType::kContour) {
+        break;
+      }
+      auto direction = GetStartDirection(verbs[i], &points[point_index]);
+      if (direction.has_value()) {
+        return direction.value();
+      }
+      point_index += GetPointCount(verbs[i]);
     }
+    return Vector2(0, -1);
   };
 
-  auto compute_contour_start_direction =
-      [&get_path_component](size_t current_path_component_index) {
-        size_t next_component_index = current_path_component_index + 1;
-        while (get_path_component(next_component_index).has_value()) {
-          auto next_component =
-              get_path_component(next_component_index).value();
-          if (next_component->GetStartDirection().has_value()) {
-            return next_component->GetStartDirection().value();
-          } else {
-            next_component_index++;
-          }
-        }
-        return Vector2(0, -1);
-      };
-
-  std::optional<size_t> previous_path_component_index;
-  auto end_contour = [&polyline, &previous_path_component_index,
-                      &get_path_component]() {
+  // The end direction of the last segment that has one, since the last
+  // segment and the segments before it in its contour.
+  bool has_segment = false;
+  bool contour_since_segment = false;
+  std::optional<Vector2> segment_end_direction;
+  auto collect_segment_end_direction = [&](Verb verb, const Point* points) {
+    if (contour_since_segment) {
+      segment_end_direction.reset();
+      contour_since_segment = false;
+    }
+    has_segment = true;
+    if (auto direction = GetEndDirection(verb, points); direction.has_value()) {
+      segment_end_direction = direction;
+    }
+  };
+  auto end_contour = [&polyline, &has_segment, &segment_end_direction]() {
     // Whenever a contour has ended, extract the exact end direction from the
     // last component.
-    if (polyline.contours.empty()) {
+    if (polyline.contours.empty() || !has_segment) {
       return;
     }
-
-    if (!previous_path_component_index.has_value()) {
-      return;
-    }
-
-    auto& contour = polyline.contours.back();
-    contour.end_direction = Vector2(0, 1);
-
-    size_t previous_index = previous_path_component_index.value();
-    while (get_path_component(previous_index).has_value()) {
-      auto previous_path_component = get_path_component(previous_index).value();
-      if (previous_path_component->GetEndDirection().has_value()) {
-        contour.end_direction =
-            previous_path_component->GetEndDirection().value();
-        break;
-      } else {
-        if (previous_index == 0) {
-          break;
-        }
-        previous_index--;
-      }
-    }
+    polyline.contours.back().end_direction =
+        segment_end_direction.value_or(Vector2(0, 1));
   };
 
-  for (size_t component_i = 0; component_i < components_.size();
-       component_i++) {
-    const auto& component = components_[component_i];
-    switch (component.type) {
-      case ComponentType::kLinear:
-        collect_points(linears_[component.index].CreatePolyline());
-        previous_path_component_index = component_i;
+  size_t point_index = 0;
+  for (size_t component_i = 0; component_i < verbs.size(); component_i++) {
+    const auto verb = verbs[component_i];
+    const Point* component_points = &points[point_index];
+    switch (verb) {
+      case Verb::kLinear:
+        collect_point(component_points[1]);
+        collect_segment_end_direction(verb, component_points);
         break;
-      case ComponentType::kQuadratic:
-        collect_points(quads_[component.index].CreatePolyline(scale));
-        previous_path_component_index = component_i;
+      case Verb::kQuadratic:
+        collect_curve_points(
+            QuadraticPathComponent(component_points[0], component_points[1],
+                                   component_points[2]),
+            scale);
+        collect_segment_end_direction(verb, component_points);
         break;
-      case ComponentType::kCubic:
-        collect_points(cubics_[component.index].CreatePolyline(scale));
-        previous_path_component_index = component_i;
+      case Verb::kCubic:
+        collect_curve_points(
+            CubicPathComponent(component_points[0], component_points[1],
+                               component_points[2], component_points[3]),
+            scale);
+        collect_segment_end_direction(verb, component_points);
         break;
-      case ComponentType::kContour:
-        if (component_i == components_.size() - 1) {
+      case Verb::kContour:
+      case Verb::kClosedContour:
+        if (component_i == verbs.size() - 1) {
           // If the last component is a contour, that means it's an empty
           // contour, so skip it.
+          point_index += GetPointCount(verb);
           continue;
         }
         end_contour();
 
-        Vector2 start_direction = compute_contour_start_direction(component_i);
-        const auto& contour = contours_[component.index];
-        polyline.contours.push_back({.start_index = polyline.points.size(),
-                                     .is_closed = contour.is_closed,
-                                     .start_direction = start_direction});
+        Vector2 start_direction =
+            compute_contour_start_direction(component_i, point_index);
+        polyline.contours.push_back(
+            {.start_index = polyline.points.size(),
+             .is_closed = verb == Verb::kClosedContour,
+             .start_direction = start_direction});
         previous_contour_point = std::nullopt;
-        collect_points({contour.destination});
+        contour_since_segment = true;
+        collect_point(component_points[0]);
         break;
     }
+    point_index += GetPointCount(verb);
     end_contour();
   }
   return polyline;
@@ -367,7 +480,7 @@ std::optional<Rect> Path::GetTransformedBoundingBox(
 }
 
 std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
-  if (linears_.empty() && quads_.empty() && cubics_.empty()) {
+  if (!data_->has_segments) {
     return std::nullopt;
   }
 
@@ -387,21 +500,32 @@ std::optional<std::pair<Point, Point>> Path::GetMinMaxCoveragePoints() const {
     }
   };
 
-  for (const auto& linear : linears_) {
-    clamp(linear.p1);
-    clamp(linear.p2);
-  }
-
-  for (const auto& quad : quads_) {
-    for (const Point& point : quad.Extrema()) {
-      clamp(point);
-    }
-  }
-
-  for (const auto& cubic : cubics_) {
-    for (const Point& point : cubic.Extrema()) {
-      clamp(point);
+  const Point* points = data_->points.data();
+  for (const auto verb : data_->verbs) {
+    switch (verb) {
+      case Verb::kLinear:
+        clamp(points[0]);
+        clamp(points[1]);
+        break;
+      case Verb::kQuadratic:
+        for (const Point& point :
+             QuadraticPathComponent(points[0], points[1], points[2])
+                 .Extrema()) {
+          clamp(point);
+        }
+        break;
+      case Verb::kCubic:
+        for (const Point& point :
+             CubicPathComponent(points[0], points[1], points[2], points[3])
+                 .Extrema()) {
+          clamp(point);
+        }
+        break;
+      case Verb::kContour:
+      case Verb::kClosedContour:
+        break;
     }
+    points += GetPointCount(verb);
   }
 
   if (!min.has_value() || !max.has_value()) {
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 #include <tuple>
@@ -35,6 +37,11 @@ enum class FillType {
 ///             Creating paths that describe complex shapes is usually done by a
 ///             path builder.
 ///
+///             The components are stored as a list of verbs and a single list
+///             of the points of all components, which is shared between
+///             copies of a path until one of them is modified. Copying a path
+///             is therefore cheap.
+///
 class Path {
  public:
   enum class ComponentType {
@@ -79,10 +86,24 @@ class Path {
 
   size_t GetComponentCount() const;
 
+  /// @brief  Reserves storage for the given number of components, of which
+  ///         `point_count` points are expected in total. Lines have two
+  ///         points, quadratics three, cubics four, and contours one.
+  void Reserve(size_t component_count, size_t point_count);
+
   void SetFillType(FillType fill);
 
   FillType GetFillType() const;
 
+  /// @brief  Sets a key that identifies the shape of this path, so that the
+  ///         vertices that it is tessellated into can be kept and reused
+  ///         for other paths with the same key. Two paths must only have the
+  ///         same key if they have the same components. The key is cleared
+  ///         whenever a component is added or updated.
+  void SetCacheKey(std::optional<uint64_t> cache_key);
+
+  std::optional<uint64_t> GetCacheKey() const;
+
   Path& AddLinearComponent(Point p1, Point p2);
 
   Path& AddQuadraticComponent(Point p1, Point cp, Point p2);
@@ -137,22 +158,73 @@ class Path {
   std::optional<std::pair<Point, Point>> GetMinMaxCoveragePoints() const;
 
  private:
-  struct ComponentIndexPair {
-    ComponentType type = ComponentType::kLinear;
-    size_t index = 0;
-
-    ComponentIndexPair() {}
+  /// The kind of a component as it is stored. Contours store whether they
+  /// are closed in their verb, like the other components store their points.
+  enum class Verb : uint8_t {
+    kLinear,
+    kQuadratic,
+    kCubic,
+    kContour,
+    kClosedContour,
+  };
 
-    ComponentIndexPair(ComponentType a_type, size_t a_index)
-        : type(a_type), index(a_index) {}
+  struct Data {
+    std::vector<Verb> verbs;
+    /// The points of each component in order, with as many points for each
+    /// verb as `GetPointCount` returns.
+    std::vector<Point> points;
+    /// Whether the path has components other than contours.
+    bool has_segments = false;
   };
 
+  static constexpr size_t GetPointCount(Verb verb) {
+    switch (verb) {
+      case Verb::kLinear:
+        return 2u;
+      case Verb::kQuadratic:
+        return 3u;
+      case Verb::kCubic:
+        return 4u;
+      case Verb::kContour:
+      case Verb::kClosedContour:
+        return 1u;
+    }
+    return 0u;
+  }
+
+  static constexpr ComponentType GetComponentType(Verb verb) {
+    switch (verb) {
+      case Verb::kLinear:
+        return ComponentType::kLinear;
+      case Verb::kQuadratic:
+        return ComponentType::kQuadratic;
+      case Verb::kCubic:
+        return ComponentType::kCubic;
+      case Verb::kContour:
+      case Verb::kClosedContour:
+        return ComponentType::kContour;
+    }
+    return ComponentType::kContour;
+  }
+
   FillType fill_ = FillType::kNonZero;
-  std::vector<ComponentIndexPair> components_;
-  std::vector<LinearPathComponent> linears_;
-  std::vector<QuadraticPathComponent> quads_;
-  std::vector<CubicPathComponent> cubics_;
-  std::vector<ContourComponent> contours_;
+  std::optional<uint64_t> cache_key_;
+  std::shared_ptr<Data> data_;
+
+  /// Returns the data of this path for modification, copying it first if it
+  /// is shared with other paths.
+  Data& GetMutableData();
+
+  /// The index of the first point of the component at `index`, or
+  /// std::nullopt if the component isn't of the given type.
+  std::optional<size_t> GetPointIndex(size_t index, ComponentType type) const;
+
+  /// The start and end directions of a component with the given points,
+  /// which are std::nullopt for contours.
+  static std::optional<Vector2> GetStartDirection(Verb verb,
+                                                  const Point* points);
+  static std::optional<Vector2> GetEndDirection(Verb verb,
+                                                const Point* points);
 };
 
 }  // namespace impeller
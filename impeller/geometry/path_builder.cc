@@ -407,6 +407,11 @@ const Path& PathBuilder::GetCurrentPath() const {
   return prototype_;
 }
 
+PathBuilder& PathBuilder::Reserve(size_t component_count, size_t point_count) {
+  prototype_.Reserve(component_count, point_count);
+  return *this;
+}
+
 PathBuilder& PathBuilder::AddPath(const Path& path) {
   auto linear = [&](size_t index, const LinearPathComponent& l) {
     prototype_.AddLinearComponent(l.p1, l.p2);
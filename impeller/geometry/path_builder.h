@@ -31,6 +31,10 @@ class PathBuilder {
 
   const Path& GetCurrentPath() const;
 
+  /// @brief  Reserves storage in the path for the given number of components
+  ///         and points. See |Path::Reserve|.
+  PathBuilder& Reserve(size_t component_count, size_t point_count);
+
   PathBuilder& MoveTo(Point point, bool relative = false);
 
   PathBuilder& Close();
@@ -4,6 +4,7 @@
 
 #include "path_component.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace impeller {
@@ -97,9 +98,10 @@ Point QuadraticPathComponent::SolveDerivative(Scalar time) const {
   };
 }
 
-static Scalar ApproximateParabolaIntegral(Scalar x) {
+static inline Scalar ApproximateParabolaIntegral(Scalar x) {
   constexpr Scalar d = 0.67;
-  return x / (1.0 - d + sqrt(sqrt(pow(d, 4) + 0.25 * x * x)));
+  constexpr Scalar d4 = d * d * d * d;
+  return x / (1.0f - d + std::sqrt(std::sqrt(d4 + 0.25f * x * x)));
 }
 
 std::vector<Point> QuadraticPathComponent::CreatePolyline(Scalar scale) const {
@@ -139,15 +141,32 @@ void QuadraticPathComponent::FillPointsForPolyline(std::vector<Point>& points,
   auto u2 = ApproximateParabolaIntegral(a2);
   auto uscale = 1 / (u2 - u0);
 
-  auto line_count = std::max(1., ceil(0.5 * val / sqrt_tolerance));
-  auto step = 1 / line_count;
-  for (size_t i = 1; i < line_count; i += 1) {
-    auto u = i * step;
-    auto a = a0 + (a2 - a0) * u;
-    auto t = (ApproximateParabolaIntegral(a) - u0) * uscale;
-    points.emplace_back(Solve(t));
+  const auto line_count =
+      static_cast<size_t>(std::max(1., ceil(0.5 * val / sqrt_tolerance)));
+  const Scalar step = 1.0f / line_count;
+
+  // The points are written in place after growing the buffer once. The
+  // parameters of the interior points don't depend on each other, so they
+  // are computed and then solved in fixed size batches of independent
+  // iterations that the compiler can vectorize.
+  const size_t first = points.size();
+  points.resize(first + line_count);
+  Point* out = points.data() + first;
+  constexpr size_t kBatchSize = 16u;
+  Scalar times[kBatchSize];
+  for (size_t batch = 1; batch < line_count; batch += kBatchSize) {
+    const size_t batch_count = std::min(kBatchSize, line_count - batch);
+    for (size_t i = 0; i < batch_count; i++) {
+      auto a = a0 + (a2 - a0) * ((batch + i) * step);
+      times[i] = (ApproximateParabolaIntegral(a) - u0) * uscale;
+    }
+    for (size_t i = 0; i < batch_count; i++) {
+      const Scalar t = times[i];
+      const Scalar mt = 1 - t;
+      out[batch - 1 + i] = p1 * (mt * mt) + cp * (2 * mt * t) + p2 * (t * t);
+    }
   }
-  points.emplace_back(p2);
+  out[line_count - 1] = p2;
 }
 
 std::vector<Point> QuadraticPathComponent::Extrema() const {
@@ -190,14 +209,20 @@ Point CubicPathComponent::SolveDerivative(Scalar time) const {
 }
 
 std::vector<Point> CubicPathComponent::CreatePolyline(Scalar scale) const {
-  auto quads = ToQuadraticPathComponents(.1);
   std::vector<Point> points;
-  for (const auto& quad : quads) {
-    quad.FillPointsForPolyline(points, scale);
-  }
+  FillPointsForPolyline(points, scale);
   return points;
 }
 
+void CubicPathComponent::FillPointsForPolyline(std::vector<Point>& points,
+                                               Scalar scale) const {
+  const auto quad_count = CountQuadraticPathComponents(.1);
+  for (size_t i = 0; i < quad_count; i++) {
+    GetQuadraticPathComponent(i, quad_count)
+        .FillPointsForPolyline(points, scale);
+  }
+}
+
 inline QuadraticPathComponent CubicPathComponent::Lower() const {
   return QuadraticPathComponent(3.0 * (cp1 - p1), 3.0 * (cp2 - cp1),
                                 3.0 * (p2 - cp2));
@@ -213,9 +238,8 @@ CubicPathComponent CubicPathComponent::Subsegment(Scalar t0, Scalar t1) const {
   return CubicPathComponent(p0, p1, p2, p3);
 }
 
-std::vector<QuadraticPathComponent>
-CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
-  std::vector<QuadraticPathComponent> quads;
+size_t CubicPathComponent::CountQuadraticPathComponents(
+    Scalar accuracy) const {
   // The maximum error, as a vector from the cubic to the best approximating
   // quadratic, is proportional to the third derivative, which is constant
   // across the segment. Thus, the error scales down as the third power of
@@ -232,16 +256,28 @@ CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
   auto p2x2 = 3.0 * cp2 - p2;
   auto p = p2x2 - p1x2;
   auto err = p.Dot(p);
-  auto quad_count = std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0)));
+  return static_cast<size_t>(
+      std::max(1., ceil(pow(err / max_hypot2, 1. / 6.0))));
+}
+
+QuadraticPathComponent CubicPathComponent::GetQuadraticPathComponent(
+    size_t index,
+    size_t quad_count) const {
+  Scalar t0 = static_cast<Scalar>(index) / quad_count;
+  Scalar t1 = static_cast<Scalar>(index + 1) / quad_count;
+  auto seg = Subsegment(t0, t1);
+  auto p1x2 = 3.0 * seg.cp1 - seg.p1;
+  auto p2x2 = 3.0 * seg.cp2 - seg.p2;
+  return QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2);
+}
 
+std::vector<QuadraticPathComponent>
+CubicPathComponent::ToQuadraticPathComponents(Scalar accuracy) const {
+  const auto quad_count = CountQuadraticPathComponents(accuracy);
+  std::vector<QuadraticPathComponent> quads;
+  quads.reserve(quad_count);
   for (size_t i = 0; i < quad_count; i++) {
-    auto t0 = i / quad_count;
-    auto t1 = (i + 1) / quad_count;
-    auto seg = Subsegment(t0, t1);
-    auto p1x2 = 3.0 * seg.cp1 - seg.p1;
-    auto p2x2 = 3.0 * seg.cp2 - seg.p2;
-    quads.emplace_back(
-        QuadraticPathComponent(seg.p1, ((p1x2 + p2x2) / 4.0), seg.p2));
+    quads.push_back(GetQuadraticPathComponent(i, quad_count));
   }
   return quads;
 }
@@ -78,6 +78,8 @@ struct QuadraticPathComponent : public PathComponent {
   // See also the implementation in kurbo: https://github.com/linebender/kurbo.
   std::vector<Point> CreatePolyline(Scalar scale) const;
 
+  /// Appends the points of `CreatePolyline` to `points`, without
+  /// allocating more than once.
   void FillPointsForPolyline(std::vector<Point>& points,
                              Scalar scale_factor) const;
 
@@ -119,11 +121,25 @@ struct CubicPathComponent : public PathComponent {
   // See the note on QuadraticPathComponent::CreatePolyline for references.
   std::vector<Point> CreatePolyline(Scalar scale) const;
 
+  /// Appends the points of `CreatePolyline` to `points`, flattening the
+  /// approximating quadratics one at a time instead of collecting them all
+  /// first.
+  void FillPointsForPolyline(std::vector<Point>& points, Scalar scale) const;
+
   std::vector<Point> Extrema() const;
 
   std::vector<QuadraticPathComponent> ToQuadraticPathComponents(
       Scalar accuracy) const;
 
+  /// The number of quadratics that `ToQuadraticPathComponents` approximates
+  /// this cubic with.
+  size_t CountQuadraticPathComponents(Scalar accuracy) const;
+
+  /// The quadratic at `index` of the `quad_count` quadratics that
+  /// approximate this cubic.
+  QuadraticPathComponent GetQuadraticPathComponent(size_t index,
+                                                   size_t quad_count) const;
+
   CubicPathComponent Subsegment(Scalar t0, Scalar t1) const;
 
   bool operator==(const CubicPathComponent& other) const {
@@ -5,8 +5,32 @@
 #include "rect.h"
 #include <sstream>
 
+#include "impeller/geometry/simd.h"
+
 namespace impeller {
 
-//
+template <>
+Rect Rect::TransformBounds(const Matrix& transform) const {
+#if IMPELLER_GEOMETRY_SIMD
+  // Perspective transforms divide by w, which is left to the scalar version
+  // for the case where it is zero.
+  const Scalar* m = transform.m;
+  if (m[3] == 0 && m[7] == 0 && m[15] == 1) {
+    auto [left, top, right, bottom] = GetLTRB();
+    simd::Float4 x = simd::Make(left, right, left, right);
+    simd::Float4 y = simd::Make(top, top, bottom, bottom);
+    simd::Float4 result_x = simd::Add(
+        simd::MulAdd(simd::Mul(x, simd::Splat(m[0])), y, simd::Splat(m[4])),
+        simd::Splat(m[12]));
+    simd::Float4 result_y = simd::Add(
+        simd::MulAdd(simd::Mul(x, simd::Splat(m[1])), y, simd::Splat(m[5])),
+        simd::Splat(m[13]));
+    return MakeLTRB(simd::MinLane(result_x), simd::MinLane(result_y),
+                    simd::MaxLane(result_x), simd::MaxLane(result_y));
+  }
+#endif  // IMPELLER_GEOMETRY_SIMD
+  auto points = GetTransformedPoints(transform);
+  return MakePointBounds(points.begin(), points.end()).value();
+}
 
 }  // namespace impeller
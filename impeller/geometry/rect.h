@@ -172,6 +172,9 @@ struct TRect {
 
   /// @brief  Creates a new bounding box that contains this transformed
   ///         rectangle.
+  ///
+  ///         The bounds of |Rect|s are computed with NEON or SSE when the
+  ///         target supports them.
   constexpr TRect TransformBounds(const Matrix& transform) const {
     auto points = GetTransformedPoints(transform);
     return TRect::MakePointBounds(points.begin(), points.end()).value();
@@ -249,6 +252,9 @@ struct TRect {
 using Rect = TRect<Scalar>;
 using IRect = TRect<int64_t>;
 
+template <>
+Rect Rect::TransformBounds(const Matrix& transform) const;
+
 }  // namespace impeller
 
 namespace std {
@@ -0,0 +1,213 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+//------------------------------------------------------------------------------
+/// Four wide vectors of floats for the kernels of the geometry classes, which
+/// map to NEON on 64-bit ARM and to SSE on x86. Other targets define neither
+/// IMPELLER_GEOMETRY_SIMD_NEON nor IMPELLER_GEOMETRY_SIMD_SSE, and the kernels
+/// fall back to their scalar versions.
+///
+/// This is an implementation detail of the geometry classes, and isn't meant
+/// to be used elsewhere.
+///
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define IMPELLER_GEOMETRY_SIMD 1
+#define IMPELLER_GEOMETRY_SIMD_NEON 1
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define IMPELLER_GEOMETRY_SIMD 1
+#define IMPELLER_GEOMETRY_SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define IMPELLER_GEOMETRY_SIMD 0
+#endif
+
+#if IMPELLER_GEOMETRY_SIMD
+
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+namespace simd {
+
+#if IMPELLER_GEOMETRY_SIMD_NEON
+using Float4 = float32x4_t;
+#else
+using Float4 = __m128;
+#endif
+
+static_assert(sizeof(Scalar) == sizeof(float));
+
+inline Float4 Load(const Scalar* values) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vld1q_f32(values);
+#else
+  return _mm_loadu_ps(values);
+#endif
+}
+
+inline void Store(Scalar* values, Float4 v) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  vst1q_f32(values, v);
+#else
+  _mm_storeu_ps(values, v);
+#endif
+}
+
+inline Float4 Splat(Scalar value) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vdupq_n_f32(value);
+#else
+  return _mm_set1_ps(value);
+#endif
+}
+
+inline Float4 Make(Scalar x, Scalar y, Scalar z, Scalar w) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return Float4{x, y, z, w};
+#else
+  return _mm_setr_ps(x, y, z, w);
+#endif
+}
+
+inline Float4 Add(Float4 a, Float4 b) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vaddq_f32(a, b);
+#else
+  return _mm_add_ps(a, b);
+#endif
+}
+
+inline Float4 Sub(Float4 a, Float4 b) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vsubq_f32(a, b);
+#else
+  return _mm_sub_ps(a, b);
+#endif
+}
+
+inline Float4 Mul(Float4 a, Float4 b) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vmulq_f32(a, b);
+#else
+  return _mm_mul_ps(a, b);
+#endif
+}
+
+inline Float4 Div(Float4 a, Float4 b) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vdivq_f32(a, b);
+#else
+  return _mm_div_ps(a, b);
+#endif
+}
+
+/// a + b * c, rounded after the multiplication like the scalar code is.
+inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vaddq_f32(a, vmulq_f32(b, c));
+#else
+  return _mm_add_ps(a, _mm_mul_ps(b, c));
+#endif
+}
+
+inline Float4 Min(Float4 a, Float4 b) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vminq_f32(a, b);
+#else
+  return _mm_min_ps(a, b);
+#endif
+}
+
+inline Float4 Max(Float4 a, Float4 b) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vmaxq_f32(a, b);
+#else
+  return _mm_max_ps(a, b);
+#endif
+}
+
+/// The lanes X and Y of |a| followed by the lanes Z and W of |b|.
+template <int X, int Y, int Z, int W>
+inline Float4 Shuffle(Float4 a, Float4 b) {
+  static_assert(X >= 0 && X < 4 && Y >= 0 && Y < 4 && Z >= 0 && Z < 4 &&
+                W >= 0 && W < 4);
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return __builtin_shufflevector(a, b, X, Y, Z + 4, W + 4);
+#else
+  return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+#endif
+}
+
+template <int X, int Y, int Z, int W>
+inline Float4 Swizzle(Float4 v) {
+  return Shuffle<X, Y, Z, W>(v, v);
+}
+
+inline Scalar GetX(Float4 v) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vgetq_lane_f32(v, 0);
+#else
+  return _mm_cvtss_f32(v);
+#endif
+}
+
+/// The sum of the lanes of |v| in every lane.
+inline Float4 SumLanes(Float4 v) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vdupq_n_f32(vaddvq_f32(v));
+#else
+  v = _mm_add_ps(v, Swizzle<1, 0, 3, 2>(v));
+  return _mm_add_ps(v, Swizzle<2, 3, 0, 1>(v));
+#endif
+}
+
+inline Scalar MinLane(Float4 v) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vminvq_f32(v);
+#else
+  v = _mm_min_ps(v, Swizzle<1, 0, 3, 2>(v));
+  return _mm_cvtss_f32(_mm_min_ps(v, Swizzle<2, 3, 0, 1>(v)));
+#endif
+}
+
+inline Scalar MaxLane(Float4 v) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  return vmaxvq_f32(v);
+#else
+  v = _mm_max_ps(v, Swizzle<1, 0, 3, 2>(v));
+  return _mm_cvtss_f32(_mm_max_ps(v, Swizzle<2, 3, 0, 1>(v)));
+#endif
+}
+
+/// Loads four interleaved points, as their x and y coordinates.
+inline void LoadPoints(const Scalar* points, Float4& x, Float4& y) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  float32x4x2_t xy = vld2q_f32(points);
+  x = xy.val[0];
+  y = xy.val[1];
+#else
+  Float4 first = _mm_loadu_ps(points);
+  Float4 second = _mm_loadu_ps(points + 4);
+  x = Shuffle<0, 2, 0, 2>(first, second);
+  y = Shuffle<1, 3, 1, 3>(first, second);
+#endif
+}
+
+/// Stores the x and y coordinates of four points interleaved.
+inline void StorePoints(Scalar* points, Float4 x, Float4 y) {
+#if IMPELLER_GEOMETRY_SIMD_NEON
+  vst2q_f32(points, (float32x4x2_t{x, y}));
+#else
+  _mm_storeu_ps(points, _mm_unpacklo_ps(x, y));
+  _mm_storeu_ps(points + 4, _mm_unpackhi_ps(x, y));
+#endif
+}
+
+}  // namespace simd
+}  // namespace impeller
+
+#endif  // IMPELLER_GEOMETRY_SIMD
@@ -0,0 +1,454 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/image/ktx2_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "impeller/base/allocation.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+namespace {
+
+constexpr uint8_t kIdentifier[] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                   0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+constexpr size_t kHeaderSize = 80u;
+constexpr size_t kLevelIndexEntrySize = 24u;
+constexpr size_t kBlockSize = 4u;
+constexpr size_t kBytesPerBlock = 16u;
+
+// VkFormat values of the supported formats.
+constexpr uint32_t kVkFormatBC3UNorm = 137u;
+constexpr uint32_t kVkFormatBC3SRGB = 138u;
+constexpr uint32_t kVkFormatETC2RGBA8UNorm = 151u;
+constexpr uint32_t kVkFormatETC2RGBA8SRGB = 152u;
+constexpr uint32_t kVkFormatASTC4x4UNorm = 157u;
+constexpr uint32_t kVkFormatASTC4x4SRGB = 158u;
+
+uint32_t ReadU32(const uint8_t* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint64_t ReadU64(const uint8_t* data) {
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+KTX2Image::Format ToFormat(uint32_t vk_format) {
+  switch (vk_format) {
+    case kVkFormatBC3UNorm:
+    case kVkFormatBC3SRGB:
+      return KTX2Image::Format::kBC3;
+    case kVkFormatETC2RGBA8UNorm:
+    case kVkFormatETC2RGBA8SRGB:
+      return KTX2Image::Format::kETC2RGBA8;
+    case kVkFormatASTC4x4UNorm:
+    case kVkFormatASTC4x4SRGB:
+      return KTX2Image::Format::kASTC4x4;
+    default:
+      return KTX2Image::Format::kInvalid;
+  }
+}
+
+uint8_t Clamp(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+// A block of 4x4 RGBA pixels, in rows.
+using Pixels = uint8_t[kBlockSize * kBlockSize][4];
+
+//------------------------------------------------------------------------------
+// BC3 (also known as DXT5).
+
+void DecodeBC3Block(const uint8_t* block, Pixels pixels) {
+  // An alpha block of two alphas and 3 bit indices...
+  int alphas[8];
+  alphas[0] = block[0];
+  alphas[1] = block[1];
+  if (alphas[0] > alphas[1]) {
+    for (int i = 1; i < 7; i++) {
+      alphas[i + 1] = ((7 - i) * alphas[0] + i * alphas[1]) / 7;
+    }
+  } else {
+    for (int i = 1; i < 5; i++) {
+      alphas[i + 1] = ((5 - i) * alphas[0] + i * alphas[1]) / 5;
+    }
+    alphas[6] = 0;
+    alphas[7] = 255;
+  }
+  uint64_t alpha_indices = 0;
+  for (int i = 0; i < 6; i++) {
+    alpha_indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+  }
+
+  // ...followed by a color block of two RGB565 colors and 2 bit indices.
+  int colors[4][3];
+  for (int i = 0; i < 2; i++) {
+    const int color = block[8 + 2 * i] | (block[9 + 2 * i] << 8);
+    const int r = (color >> 11) & 0x1f;
+    const int g = (color >> 5) & 0x3f;
+    const int b = color & 0x1f;
+    colors[i][0] = (r << 3) | (r >> 2);
+    colors[i][1] = (g << 2) | (g >> 4);
+    colors[i][2] = (b << 3) | (b >> 2);
+  }
+  for (int c = 0; c < 3; c++) {
+    colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+    colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+  }
+  const uint32_t color_indices = ReadU32(block + 12);
+
+  for (size_t i = 0; i < kBlockSize * kBlockSize; i++) {
+    const int* color = colors[(color_indices >> (2 * i)) & 0x3];
+    pixels[i][0] = color[0];
+    pixels[i][1] = color[1];
+    pixels[i][2] = color[2];
+    pixels[i][3] = alphas[(alpha_indices >> (3 * i)) & 0x7];
+  }
+}
+
+//------------------------------------------------------------------------------
+// ETC2 RGBA8, an EAC alpha block followed by an ETC2 RGB block.
+
+constexpr int kEACModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},  {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},  {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},  {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},  {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},   {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},   {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},   {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+constexpr int kETC1Modifiers[8][4] = {
+    {2, 8, -2, -8},     {5, 17, -5, -17},   {9, 29, -9, -29},
+    {13, 42, -13, -42}, {18, 60, -18, -60}, {24, 80, -24, -80},
+    {33, 106, -33, -106}, {47, 183, -47, -183},
+};
+
+constexpr int kETC2Distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+uint64_t ReadU64BigEndian(const uint8_t* data) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++) {
+    value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+int Extend4(int value) {
+  return (value << 4) | value;
+}
+
+int Extend5(int value) {
+  return (value << 3) | (value >> 2);
+}
+
+int Extend6(int value) {
+  return (value << 2) | (value >> 4);
+}
+
+int Extend7(int value) {
+  return (value << 1) | (value >> 6);
+}
+
+// The pixels of ETC blocks are indexed in columns.
+size_t ToRowIndex(size_t column_index) {
+  return (column_index % kBlockSize) * kBlockSize + column_index / kBlockSize;
+}
+
+void DecodeEACAlphaBlock(const uint8_t* block, Pixels pixels) {
+  const uint64_t bits = ReadU64BigEndian(block);
+  const int base = static_cast<int>(bits >> 56);
+  const int multiplier = static_cast<int>((bits >> 52) & 0xf);
+  const int* modifiers = kEACModifiers[(bits >> 48) & 0xf];
+  for (size_t i = 0; i < kBlockSize * kBlockSize; i++) {
+    const int index = static_cast<int>((bits >> (45 - 3 * i)) & 0x7);
+    pixels[ToRowIndex(i)][3] = Clamp(base + modifiers[index] * multiplier);
+  }
+}
+
+// Decodes the blocks with four paint colors and 2 bit indices into them.
+void DecodePaintColors(uint64_t bits, const int paint[4][3], Pixels pixels) {
+  for (size_t i = 0; i < kBlockSize * kBlockSize; i++) {
+    const int index = static_cast<int>((((bits >> (16 + i)) & 0x1) << 1) |
+                                       ((bits >> i) & 0x1));
+    for (int c = 0; c < 3; c++) {
+      pixels[ToRowIndex(i)][c] = Clamp(paint[index][c]);
+    }
+  }
+}
+
+void DecodeETC2RGBBlock(const uint8_t* block, Pixels pixels) {
+  const uint64_t bits = ReadU64BigEndian(block);
+  const uint8_t* b = block;
+  const bool differential = (bits >> 33) & 0x1;
+
+  int base[2][3];
+  if (differential) {
+    bool deltas_overflow[3];
+    for (int c = 0; c < 3; c++) {
+      const int value = static_cast<int>((bits >> (59 - 8 * c)) & 0x1f);
+      int delta = static_cast<int>((bits >> (56 - 8 * c)) & 0x7);
+      delta = delta >= 4 ? delta - 8 : delta;
+      base[0][c] = value;
+      base[1][c] = value + delta;
+      deltas_overflow[c] = base[1][c] < 0 || base[1][c] > 31;
+    }
+
+    if (deltas_overflow[0]) {
+      // T mode.
+      int colors[2][3] = {
+          {Extend4(((b[0] & 0x18) >> 1) | (b[0] & 0x3)), Extend4(b[1] >> 4),
+           Extend4(b[1] & 0xf)},
+          {Extend4(b[2] >> 4), Extend4(b[2] & 0xf), Extend4(b[3] >> 4)},
+      };
+      const int distance =
+          kETC2Distances[((b[3] >> 1) & 0x6) | (b[3] & 0x1)];
+      int paint[4][3];
+      for (int c = 0; c < 3; c++) {
+        paint[0][c] = colors[0][c];
+        paint[1][c] = colors[1][c] + distance;
+        paint[2][c] = colors[1][c];
+        paint[3][c] = colors[1][c] - distance;
+      }
+      DecodePaintColors(bits, paint, pixels);
+      return;
+    }
+
+    if (deltas_overflow[1]) {
+      // H mode.
+      int colors[2][3] = {
+          {Extend4((b[0] >> 3) & 0xf),
+           Extend4(((b[0] & 0x7) << 1) | ((b[1] >> 4) & 0x1)),
+           Extend4((b[1] & 0x8) | ((b[1] & 0x3) << 1) | (b[2] >> 7))},
+          {Extend4((b[2] >> 3) & 0xf),
+           Extend4(((b[2] & 0x7) << 1) | (b[3] >> 7)),
+           Extend4((b[3] >> 3) & 0xf)},
+      };
+      const int first = (colors[0][0] << 16) | (colors[0][1] << 8) |
+                        colors[0][2];
+      const int second = (colors[1][0] << 16) | (colors[1][1] << 8) |
+                         colors[1][2];
+      const int distance = kETC2Distances[(b[3] & 0x4) | ((b[3] & 0x1) << 1) |
+                                          (first >= second ? 1 : 0)];
+      int paint[4][3];
+      for (int c = 0; c < 3; c++) {
+        paint[0][c] = colors[0][c] + distance;
+        paint[1][c] = colors[0][c] - distance;
+        paint[2][c] = colors[1][c] + distance;
+        paint[3][c] = colors[1][c] - distance;
+      }
+      DecodePaintColors(bits, paint, pixels);
+      return;
+    }
+
+    if (deltas_overflow[2]) {
+      // Planar mode, which interpolates between the colors at the origin,
+      // at the horizontal end and at the vertical end of the block.
+      const int origin[3] = {
+          Extend6((b[0] >> 1) & 0x3f),
+          Extend7(((b[0] & 0x1) << 6) | ((b[1] >> 1) & 0x3f)),
+          Extend6(((b[1] & 0x1) << 5) | (b[2] & 0x18) | ((b[2] & 0x3) << 1) |
+                  (b[3] >> 7)),
+      };
+      const int horizontal[3] = {
+          Extend6(((b[3] >> 1) & 0x3e) | (b[3] & 0x1)),
+          Extend7((b[4] >> 1) & 0x7f),
+          Extend6(((b[4] & 0x1) << 5) | ((b[5] >> 3) & 0x1f)),
+      };
+      const int vertical[3] = {
+          Extend6(((b[5] & 0x7) << 3) | ((b[6] >> 5) & 0x7)),
+          Extend7(((b[6] & 0x1f) << 2) | ((b[7] >> 6) & 0x3)),
+          Extend6(b[7] & 0x3f),
+      };
+      for (size_t y = 0; y < kBlockSize; y++) {
+        for (size_t x = 0; x < kBlockSize; x++) {
+          for (int c = 0; c < 3; c++) {
+            pixels[y * kBlockSize + x][c] =
+                Clamp((static_cast<int>(x) * (horizontal[c] - origin[c]) +
+                       static_cast<int>(y) * (vertical[c] - origin[c]) +
+                       4 * origin[c] + 2) >>
+                      2);
+          }
+        }
+      }
+      return;
+    }
+
+    // Differential mode.
+    for (int c = 0; c < 3; c++) {
+      base[0][c] = Extend5(base[0][c]);
+      base[1][c] = Extend5(base[1][c]);
+    }
+  } else {
+    // Individual mode.
+    for (int c = 0; c < 3; c++) {
+      base[0][c] = Extend4(static_cast<int>((bits >> (60 - 8 * c)) & 0xf));
+      base[1][c] = Extend4(static_cast<int>((bits >> (56 - 8 * c)) & 0xf));
+    }
+  }
+
+  // The block is split in two halves of 2x4 pixels, or 4x2 pixels if flipped,
+  // which each have a base color and a table of modifiers.
+  const int* modifiers[2] = {kETC1Modifiers[(bits >> 37) & 0x7],
+                             kETC1Modifiers[(bits >> 34) & 0x7]};
+  const bool flipped = (bits >> 32) & 0x1;
+  for (size_t i = 0; i < kBlockSize * kBlockSize; i++) {
+    const size_t x = i / kBlockSize;
+    const size_t y = i % kBlockSize;
+    const size_t half = (flipped ? y : x) >= 2 ? 1u : 0u;
+    const int index = static_cast<int>((((bits >> (16 + i)) & 0x1) << 1) |
+                                       ((bits >> i) & 0x1));
+    for (int c = 0; c < 3; c++) {
+      pixels[y * kBlockSize + x][c] =
+          Clamp(base[half][c] + modifiers[half][index]);
+    }
+  }
+}
+
+void DecodeETC2RGBA8Block(const uint8_t* block, Pixels pixels) {
+  DecodeEACAlphaBlock(block, pixels);
+  DecodeETC2RGBBlock(block + 8, pixels);
+}
+
+}  // namespace
+
+bool KTX2Image::IsKTX2(const fml::Mapping& allocation) {
+  return allocation.GetMapping() != nullptr &&
+         allocation.GetSize() >= sizeof(kIdentifier) &&
+         std::memcmp(allocation.GetMapping(), kIdentifier,
+                     sizeof(kIdentifier)) == 0;
+}
+
+std::shared_ptr<KTX2Image> KTX2Image::Create(
+    std::shared_ptr<const fml::Mapping> allocation) {
+  if (!allocation || !IsKTX2(*allocation) ||
+      allocation->GetSize() < kHeaderSize + kLevelIndexEntrySize) {
+    return nullptr;
+  }
+  const uint8_t* data = allocation->GetMapping();
+  const size_t size = allocation->GetSize();
+
+  const auto format = ToFormat(ReadU32(data + 12));
+  const int64_t width = ReadU32(data + 20);
+  const int64_t height = ReadU32(data + 24);
+  const uint32_t depth = ReadU32(data + 28);
+  const uint32_t layer_count = ReadU32(data + 32);
+  const uint32_t face_count = ReadU32(data + 36);
+  const uint32_t level_count = std::max(ReadU32(data + 40), 1u);
+  const uint32_t supercompression_scheme = ReadU32(data + 44);
+  if (format == Format::kInvalid) {
+    VALIDATION_LOG << "Unsupported KTX2 texture format.";
+    return nullptr;
+  }
+  if (width == 0 || height == 0 || depth != 0 || layer_count > 1 ||
+      face_count != 1 || supercompression_scheme != 0) {
+    VALIDATION_LOG << "Only KTX2 containers of uncompressed 2D textures are "
+                      "supported.";
+    return nullptr;
+  }
+
+  // The first level of the level index is the base mip level.
+  const uint64_t level_offset = ReadU64(data + kHeaderSize);
+  const uint64_t level_length = ReadU64(data + kHeaderSize + 8);
+  const uint64_t expected_length = ((width + kBlockSize - 1) / kBlockSize) *
+                                   ((height + kBlockSize - 1) / kBlockSize) *
+                                   kBytesPerBlock;
+  if (level_length != expected_length || level_offset > size ||
+      level_length > size - level_offset) {
+    VALIDATION_LOG << "Invalid KTX2 base mip level.";
+    return nullptr;
+  }
+
+  auto base_mip_level = std::make_shared<fml::NonOwnedMapping>(
+      data + level_offset,         //
+      level_length,                //
+      [allocation](auto, auto) {}  //
+  );
+  return std::shared_ptr<KTX2Image>(new KTX2Image(
+      ISize{width, height}, format, level_count, std::move(base_mip_level)));
+}
+
+KTX2Image::KTX2Image(ISize size,
+                     Format format,
+                     size_t mip_count,
+                     std::shared_ptr<const fml::Mapping> base_mip_level)
+    : size_(size),
+      format_(format),
+      mip_count_(mip_count),
+      base_mip_level_(std::move(base_mip_level)) {}
+
+KTX2Image::~KTX2Image() = default;
+
+const ISize& KTX2Image::GetSize() const {
+  return size_;
+}
+
+KTX2Image::Format KTX2Image::GetFormat() const {
+  return format_;
+}
+
+size_t KTX2Image::GetMipCount() const {
+  return mip_count_;
+}
+
+const std::shared_ptr<const fml::Mapping>& KTX2Image::GetBaseMipLevel() const {
+  return base_mip_level_;
+}
+
+DecompressedImage KTX2Image::Decode() const {
+  void (*decode_block)(const uint8_t*, Pixels) = nullptr;
+  switch (format_) {
+    case Format::kETC2RGBA8:
+      decode_block = DecodeETC2RGBA8Block;
+      break;
+    case Format::kBC3:
+      decode_block = DecodeBC3Block;
+      break;
+    case Format::kASTC4x4:
+    case Format::kInvalid:
+      return {};
+  }
+
+  const size_t width = size_.width;
+  const size_t height = size_.height;
+  auto rgba_allocation = std::make_shared<Allocation>();
+  if (!rgba_allocation->Truncate(width * height * 4u, false)) {
+    return {};
+  }
+
+  const uint8_t* block = base_mip_level_->GetMapping();
+  uint8_t* dest = rgba_allocation->GetBuffer();
+  Pixels pixels;
+  for (size_t block_y = 0; block_y < height; block_y += kBlockSize) {
+    for (size_t block_x = 0; block_x < width; block_x += kBlockSize) {
+      decode_block(block, pixels);
+      block += kBytesPerBlock;
+      // The blocks at the right and bottom edges may extend past the image.
+      for (size_t y = 0; y < kBlockSize && block_y + y < height; y++) {
+        const size_t row_width = std::min(kBlockSize, width - block_x);
+        std::memcpy(dest + ((block_y + y) * width + block_x) * 4u,
+                    pixels[y * kBlockSize], row_width * 4u);
+      }
+    }
+  }
+
+  return DecompressedImage{
+      size_, DecompressedImage::Format::kRGBA,
+      std::make_shared<fml::NonOwnedMapping>(
+          rgba_allocation->GetBuffer(),      //
+          rgba_allocation->GetLength(),      //
+          [rgba_allocation](auto, auto) {})  //
+  };
+}
+
+}  // namespace impeller
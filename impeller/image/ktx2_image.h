@@ -0,0 +1,85 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "impeller/geometry/size.h"
+#include "impeller/image/decompressed_image.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A KTX2 container of a 2D texture in a block compressed format,
+///             which devices that support the format can sample from
+///             without decompressing it.
+///
+///             Only the containers without supercompression, of a single
+///             layer and face, and of the formats listed below are
+///             supported. The sRGB variants of the formats are read as the
+///             unsigned normalized formats, just like other images.
+///
+/// @see        https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+///
+class KTX2Image {
+ public:
+  enum class Format {
+    kInvalid,
+    kETC2RGBA8,
+    kASTC4x4,
+    kBC3,
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the allocation starts with the KTX2 identifier.
+  ///
+  static bool IsKTX2(const fml::Mapping& allocation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses the container in the allocation, which is referenced
+  ///             by the image. Returns nullptr if the container is invalid
+  ///             or unsupported.
+  ///
+  static std::shared_ptr<KTX2Image> Create(
+      std::shared_ptr<const fml::Mapping> allocation);
+
+  ~KTX2Image();
+
+  const ISize& GetSize() const;
+
+  Format GetFormat() const;
+
+  size_t GetMipCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The compressed blocks of the base mip level, in rows of
+  ///             blocks of 4x4 pixels.
+  ///
+  const std::shared_ptr<const fml::Mapping>& GetBaseMipLevel() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Decompresses the base mip level into unpremultiplied RGBA
+  ///             pixels, for the devices that can't sample from the format.
+  ///             Returns an invalid image for ASTC, which isn't decompressed.
+  ///
+  [[nodiscard]] DecompressedImage Decode() const;
+
+ private:
+  const ISize size_;
+  const Format format_;
+  const size_t mip_count_;
+  const std::shared_ptr<const fml::Mapping> base_mip_level_;
+
+  KTX2Image(ISize size,
+            Format format,
+            size_t mip_count,
+            std::shared_ptr<const fml::Mapping> base_mip_level);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(KTX2Image);
+};
+
+}  // namespace impeller
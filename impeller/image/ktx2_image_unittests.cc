@@ -0,0 +1,158 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/image/ktx2_image.h"
+
+namespace impeller {
+namespace testing {
+
+constexpr uint32_t kVkFormatBC3UNorm = 137u;
+constexpr uint32_t kVkFormatETC2RGBA8UNorm = 151u;
+constexpr uint32_t kVkFormatASTC4x4UNorm = 157u;
+
+static void AppendU32(std::vector<uint8_t>& data, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+static void AppendU64(std::vector<uint8_t>& data, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+static std::shared_ptr<fml::Mapping> CreateKTX2(
+    uint32_t vk_format,
+    uint32_t width,
+    uint32_t height,
+    const std::vector<uint8_t>& blocks) {
+  std::vector<uint8_t> data = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                               0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  AppendU32(data, vk_format);
+  AppendU32(data, 1u);      // type size
+  AppendU32(data, width);   // pixel width
+  AppendU32(data, height);  // pixel height
+  AppendU32(data, 0u);      // pixel depth
+  AppendU32(data, 0u);      // layer count
+  AppendU32(data, 1u);      // face count
+  AppendU32(data, 1u);      // level count
+  AppendU32(data, 0u);      // supercompression scheme
+  AppendU32(data, 0u);      // dfd byte offset
+  AppendU32(data, 0u);      // dfd byte length
+  AppendU32(data, 0u);      // kvd byte offset
+  AppendU32(data, 0u);      // kvd byte length
+  AppendU64(data, 0u);      // sgd byte offset
+  AppendU64(data, 0u);      // sgd byte length
+  AppendU64(data, data.size() + 24u);  // level byte offset
+  AppendU64(data, blocks.size());      // level byte length
+  AppendU64(data, blocks.size());      // level uncompressed byte length
+  data.insert(data.end(), blocks.begin(), blocks.end());
+  return std::make_shared<fml::DataMapping>(std::move(data));
+}
+
+static const uint8_t* GetPixel(const DecompressedImage& image,
+                               int64_t x,
+                               int64_t y) {
+  return image.GetAllocation()->GetMapping() +
+         (y * image.GetSize().width + x) * 4;
+}
+
+TEST(KTX2ImageTest, RejectsInvalidContainers) {
+  ASSERT_EQ(KTX2Image::Create(nullptr), nullptr);
+
+  std::vector<uint8_t> blocks(16u);
+  auto png = std::make_shared<fml::DataMapping>(
+      std::vector<uint8_t>{0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A});
+  ASSERT_FALSE(KTX2Image::IsKTX2(*png));
+  ASSERT_EQ(KTX2Image::Create(png), nullptr);
+
+  // Unsupported format.
+  ASSERT_EQ(KTX2Image::Create(CreateKTX2(37u, 4u, 4u, blocks)), nullptr);
+  // Level smaller than the blocks of the image.
+  ASSERT_EQ(KTX2Image::Create(CreateKTX2(kVkFormatBC3UNorm, 8u, 4u, blocks)),
+            nullptr);
+}
+
+TEST(KTX2ImageTest, ParsesBaseMipLevel) {
+  std::vector<uint8_t> blocks(32u, 0x42);
+  auto mapping = CreateKTX2(kVkFormatASTC4x4UNorm, 5u, 3u, blocks);
+  ASSERT_TRUE(KTX2Image::IsKTX2(*mapping));
+
+  auto image = KTX2Image::Create(mapping);
+  ASSERT_NE(image, nullptr);
+  ASSERT_EQ(image->GetSize(), ISize(5, 3));
+  ASSERT_EQ(image->GetFormat(), KTX2Image::Format::kASTC4x4);
+  ASSERT_EQ(image->GetMipCount(), 1u);
+  ASSERT_EQ(image->GetBaseMipLevel()->GetSize(), blocks.size());
+  ASSERT_EQ(std::memcmp(image->GetBaseMipLevel()->GetMapping(), blocks.data(),
+                        blocks.size()),
+            0);
+
+  // ASTC isn't decompressed.
+  ASSERT_FALSE(image->Decode().IsValid());
+}
+
+TEST(KTX2ImageTest, DecodesBC3Blocks) {
+  std::vector<uint8_t> blocks = {
+      // Alphas 255 and 0, the first pixel picks 0.
+      0xFF, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+      // Red and blue, the first row picks each of the four colors.
+      0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00};
+  auto image = KTX2Image::Create(CreateKTX2(kVkFormatBC3UNorm, 4u, 4u, blocks));
+  ASSERT_NE(image, nullptr);
+
+  auto decoded = image->Decode();
+  ASSERT_TRUE(decoded.IsValid());
+  ASSERT_EQ(decoded.GetSize(), ISize(4, 4));
+  ASSERT_EQ(decoded.GetFormat(), DecompressedImage::Format::kRGBA);
+
+  const uint8_t expected[4][4] = {
+      {255, 0, 0, 0},
+      {0, 0, 255, 255},
+      {170, 0, 85, 255},
+      {85, 0, 170, 255},
+  };
+  for (int x = 0; x < 4; x++) {
+    ASSERT_EQ(std::memcmp(GetPixel(decoded, x, 0), expected[x], 4), 0);
+  }
+  ASSERT_EQ(std::memcmp(GetPixel(decoded, 0, 3), expected[0], 3), 0);
+}
+
+TEST(KTX2ImageTest, DecodesETC2Blocks) {
+  std::vector<uint8_t> block = {
+      // Alpha 200 without modifiers.
+      0xC8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      // Individual mode, with grey on the left and black on the right half.
+      0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00};
+  // An image of 6x5 pixels has 2x2 blocks.
+  std::vector<uint8_t> blocks;
+  for (int i = 0; i < 4; i++) {
+    blocks.insert(blocks.end(), block.begin(), block.end());
+  }
+  auto image =
+      KTX2Image::Create(CreateKTX2(kVkFormatETC2RGBA8UNorm, 6u, 5u, blocks));
+  ASSERT_NE(image, nullptr);
+
+  auto decoded = image->Decode();
+  ASSERT_TRUE(decoded.IsValid());
+  ASSERT_EQ(decoded.GetSize(), ISize(6, 5));
+
+  const uint8_t grey[4] = {138, 138, 138, 200};
+  const uint8_t black[4] = {2, 2, 2, 200};
+  for (int64_t y = 0; y < 5; y++) {
+    for (int64_t x = 0; x < 6; x++) {
+      const uint8_t* expected = x % 4 < 2 ? grey : black;
+      ASSERT_EQ(std::memcmp(GetPixel(decoded, x, y), expected, 4), 0)
+          << "at " << x << ", " << y;
+    }
+  }
+}
+
+}  // namespace testing
+}  // namespace impeller
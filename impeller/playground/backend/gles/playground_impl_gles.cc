@@ -9,6 +9,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "impeller/entity/gles/entity_shaders_gles.h"
+#include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
 #include "impeller/fixtures/gles/fixtures_shaders_gles.h"
 #include "impeller/playground/imgui/gles/imgui_shaders_gles.h"
 #include "impeller/renderer/backend/gles/context_gles.h"
@@ -90,6 +91,9 @@ ShaderLibraryMappingsForPlayground() {
       std::make_shared<fml::NonOwnedMapping>(
           impeller_entity_shaders_gles_data,
           impeller_entity_shaders_gles_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_framebuffer_blend_shaders_gles_data,
+          impeller_framebuffer_blend_shaders_gles_length),
       std::make_shared<fml::NonOwnedMapping>(
           impeller_fixtures_shaders_gles_data,
           impeller_fixtures_shaders_gles_length),
@@ -111,8 +115,8 @@ std::shared_ptr<Context> PlaygroundImplGLES::GetContext() const {
     return nullptr;
   }
 
-  auto context =
-      ContextGLES::Create(std::move(gl), ShaderLibraryMappingsForPlayground());
+  auto context = ContextGLES::Create(
+      std::move(gl), ShaderLibraryMappingsForPlayground(), fml::UniqueFD{});
   if (!context) {
     FML_LOG(ERROR) << "Could not create context.";
     return nullptr;
@@ -20,11 +20,14 @@
 #include "impeller/image/compressed_image.h"
 #include "impeller/playground/imgui/imgui_impl_impeller.h"
 #include "impeller/playground/playground.h"
+#include "impeller/playground/playground_benchmark.h"
 #include "impeller/playground/playground_impl.h"
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/formats.h"
+#include "impeller/renderer/gpu_tracer.h"
 #include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
 #include "impeller/renderer/renderer.h"
 #include "third_party/imgui/backends/imgui_impl_glfw.h"
 #include "third_party/imgui/imgui.h"
@@ -143,6 +146,15 @@ bool Playground::ShouldOpenNewPlaygrounds() {
   return gShouldOpenNewPlaygrounds;
 }
 
+bool Playground::ShouldRender() {
+  return is_enabled() ||
+         PlaygroundBenchmarkReporter::GetHeadlessFrameCount() > 0u;
+}
+
+std::string Playground::GetBenchmarkName() const {
+  return GetWindowTitle();
+}
+
 static void PlaygroundKeyCallback(GLFWwindow* window,
                                   int key,
                                   int scancode,
@@ -178,6 +190,10 @@ void Playground::SetCursorPosition(Point pos) {
 
 bool Playground::OpenPlaygroundHere(
     const Renderer::RenderCallback& render_callback) {
+  if (PlaygroundBenchmarkReporter::GetHeadlessFrameCount() > 0u) {
+    return !render_callback || RenderHeadless(render_callback);
+  }
+
   if (!is_enabled()) {
     return true;
   }
@@ -307,6 +323,98 @@ bool Playground::OpenPlaygroundHere(
   return true;
 }
 
+bool Playground::RenderHeadless(
+    const Renderer::RenderCallback& render_callback) {
+  if (!context_ || !context_->IsValid()) {
+    return false;
+  }
+
+  // Playground callbacks expect to be able to add widgets, so they are given
+  // an ImGui frame that is never drawn.
+  IMGUI_CHECKVERSION();
+  ImGui::CreateContext();
+  fml::ScopedCleanupClosure destroy_imgui_context(
+      []() { ImGui::DestroyContext(); });
+  auto& io = ImGui::GetIO();
+  io.IniFilename = nullptr;
+  io.DisplaySize = ImVec2(GetWindowSize().width, GetWindowSize().height);
+  unsigned char* font_pixels;
+  int font_width;
+  int font_height;
+  io.Fonts->GetTexDataAsRGBA32(&font_pixels, &font_width, &font_height);
+
+  // GPU times are reported once the GPU is done with a frame, which may be
+  // after this returns, so the callback only holds on to shared state.
+  struct GPUTimes {
+    Mutex mutex;
+    std::vector<fml::TimeDelta> times IPLR_GUARDED_BY(mutex);
+  };
+  auto gpu_times = std::make_shared<GPUTimes>();
+  auto gpu_tracer = context_->GetGPUTracer();
+  if (gpu_tracer) {
+    gpu_tracer->SetFrameTimingCallback(
+        [gpu_times](uint64_t frame_number, fml::TimeDelta gpu_time,
+                    const std::vector<GPUWorkTiming>& work) {
+          Lock lock(gpu_times->mutex);
+          gpu_times->times.push_back(gpu_time);
+        });
+  }
+
+  const auto& allocator = context_->GetResourceAllocator();
+  const bool msaa = context_->GetDeviceCapabilities().SupportsOffscreenMSAA();
+  const size_t frame_count =
+      PlaygroundBenchmarkReporter::GetHeadlessFrameCount();
+  std::vector<PlaygroundFrameStats> frames;
+  frames.reserve(frame_count);
+  bool result = true;
+  for (size_t i = 0; i < frame_count && result; i++) {
+    auto render_target =
+        msaa ? RenderTarget::CreateOffscreenMSAA(*context_, GetWindowSize())
+             : RenderTarget::CreateOffscreen(*context_, GetWindowSize());
+    if (!render_target.IsValid()) {
+      result = false;
+      break;
+    }
+
+    const auto encode_stats = context_->GetEncodeStats();
+    const auto allocated_bytes = allocator->GetTotalAllocatedBytes();
+    const auto start = fml::TimePoint::Now();
+    ImGui::NewFrame();
+    result = render_callback(render_target);
+    ImGui::EndFrame();
+    const auto end = fml::TimePoint::Now();
+    if (gpu_tracer) {
+      gpu_tracer->MarkFrameEnd();
+    }
+
+    const auto frame_encode_stats = context_->GetEncodeStats();
+    frames.push_back(PlaygroundFrameStats{
+        .cpu_time = end - start,
+        .render_pass_count = frame_encode_stats.render_pass_count -
+                             encode_stats.render_pass_count,
+        .draw_count = frame_encode_stats.draw_count - encode_stats.draw_count,
+        .allocated_bytes =
+            allocator->GetTotalAllocatedBytes() - allocated_bytes,
+    });
+  }
+
+  if (gpu_tracer) {
+    gpu_tracer->SetFrameTimingCallback(nullptr);
+  }
+  if (!result) {
+    VALIDATION_LOG << "Could not render the playground headless.";
+    return false;
+  }
+  std::vector<fml::TimeDelta> frame_gpu_times;
+  {
+    Lock lock(gpu_times->mutex);
+    frame_gpu_times = gpu_times->times;
+  }
+  PlaygroundBenchmarkReporter::GetInstance().Report(GetBenchmarkName(), frames,
+                                                    frame_gpu_times);
+  return true;
+}
+
 bool Playground::OpenPlaygroundHere(SinglePassCallback pass_callback) {
   return OpenPlaygroundHere(
       [context = GetContext(), &pass_callback](RenderTarget& render_target) {
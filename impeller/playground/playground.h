@@ -39,6 +39,15 @@ class Playground {
 
   static constexpr bool is_enabled() { return is_enabled_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `OpenPlaygroundHere` renders anything, either in a
+  ///             window because playgrounds are enabled, or headless for
+  ///             benchmarking.
+  ///
+  /// @see        `PlaygroundBenchmarkReporter`
+  ///
+  static bool ShouldRender();
+
   static bool ShouldOpenNewPlaygrounds();
 
   void SetupContext(PlaygroundBackend backend);
@@ -91,6 +100,12 @@ class Playground {
 
   virtual std::string GetWindowTitle() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @return     The name the frames of the playground are reported under
+  ///             when it is rendered headless.
+  ///
+  virtual std::string GetBenchmarkName() const;
+
  private:
 #if IMPELLER_ENABLE_PLAYGROUND
   static const bool is_enabled_ = true;
@@ -112,6 +127,10 @@ class Playground {
 
   void SetWindowSize(ISize size);
 
+  // Renders the callback into an offscreen target for the number of frames
+  // set by the environment, and reports the work of each frame.
+  bool RenderHeadless(const Renderer::RenderCallback& render_callback);
+
   FML_DISALLOW_COPY_AND_ASSIGN(Playground);
 };
 
@@ -0,0 +1,153 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/playground/playground_benchmark.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+size_t PlaygroundBenchmarkReporter::GetHeadlessFrameCount() {
+  static const size_t frame_count = []() -> size_t {
+    const char* frames = std::getenv("IMPELLER_PLAYGROUND_BENCHMARK_FRAMES");
+    if (!frames) {
+      return 0u;
+    }
+    return std::strtoul(frames, nullptr, 10);
+  }();
+  return frame_count;
+}
+
+PlaygroundBenchmarkReporter& PlaygroundBenchmarkReporter::GetInstance() {
+  static PlaygroundBenchmarkReporter* reporter = []() {
+    const char* output_path = std::getenv("IMPELLER_PLAYGROUND_BENCHMARK_OUT");
+    return new PlaygroundBenchmarkReporter(
+        output_path ? output_path : "impeller_playground_benchmarks.json");
+  }();
+  return *reporter;
+}
+
+PlaygroundBenchmarkReporter::PlaygroundBenchmarkReporter(
+    std::string output_path)
+    : output_path_(std::move(output_path)) {}
+
+PlaygroundBenchmarkReporter::~PlaygroundBenchmarkReporter() = default;
+
+void PlaygroundBenchmarkReporter::Report(
+    std::string name,
+    const std::vector<PlaygroundFrameStats>& frames,
+    const std::vector<fml::TimeDelta>& gpu_times) {
+  if (frames.empty()) {
+    return;
+  }
+  Benchmark benchmark;
+  benchmark.name = std::move(name);
+  benchmark.frame_count = frames.size();
+  benchmark.first_frame_cpu_time_ms = frames.front().cpu_time.ToMillisecondsF();
+  for (const auto& frame : frames) {
+    benchmark.cpu_time_ms += frame.cpu_time.ToMillisecondsF();
+    benchmark.render_pass_count += frame.render_pass_count;
+    benchmark.draw_count += frame.draw_count;
+    benchmark.allocated_bytes += frame.allocated_bytes;
+  }
+  benchmark.cpu_time_ms /= frames.size();
+  benchmark.render_pass_count /= frames.size();
+  benchmark.draw_count /= frames.size();
+  benchmark.allocated_bytes /= frames.size();
+  benchmark.gpu_frame_count = gpu_times.size();
+  for (const auto& gpu_time : gpu_times) {
+    benchmark.gpu_time_ms += gpu_time.ToMillisecondsF();
+  }
+  if (!gpu_times.empty()) {
+    benchmark.gpu_time_ms /= gpu_times.size();
+  }
+
+  Lock lock(mutex_);
+  benchmarks_.push_back(std::move(benchmark));
+  if (output_path_.empty()) {
+    return;
+  }
+  // The whole file is rewritten each time as there is no telling which
+  // playground is the last one of the process.
+  std::ofstream output(output_path_, std::ios::trunc);
+  output << ToJSONLocked();
+  if (!output.good()) {
+    FML_LOG(ERROR) << "Could not write the playground benchmarks to "
+                   << output_path_;
+  }
+}
+
+std::string PlaygroundBenchmarkReporter::ToJSON() const {
+  Lock lock(mutex_);
+  return ToJSONLocked();
+}
+
+static std::string EscapeJSON(const std::string& string) {
+  std::stringstream stream;
+  for (char c : string) {
+    if (c == '"' || c == '\\') {
+      stream << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      stream << ' ';
+    } else {
+      stream << c;
+    }
+  }
+  return stream.str();
+}
+
+std::string PlaygroundBenchmarkReporter::ToJSONLocked() const {
+  char date[32] = {};
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S",
+                std::localtime(&now));
+
+  std::stringstream stream;
+  stream << "{\n";
+  stream << "  \"context\": {\n";
+  stream << "    \"date\": \"" << date << "\",\n";
+  stream << "    \"num_cpus\": " << std::thread::hardware_concurrency()
+         << ",\n";
+#ifdef NDEBUG
+  stream << "    \"library_build_type\": \"release\"\n";
+#else
+  stream << "    \"library_build_type\": \"debug\"\n";
+#endif  // NDEBUG
+  stream << "  },\n";
+  stream << "  \"benchmarks\": [";
+  for (size_t i = 0; i < benchmarks_.size(); i++) {
+    const auto& benchmark = benchmarks_[i];
+    stream << (i == 0 ? "\n" : ",\n");
+    stream << "    {\n";
+    stream << "      \"name\": \"" << EscapeJSON(benchmark.name) << "\",\n";
+    stream << "      \"iterations\": " << benchmark.frame_count << ",\n";
+    stream << "      \"real_time\": " << benchmark.cpu_time_ms << ",\n";
+    stream << "      \"cpu_time\": " << benchmark.cpu_time_ms << ",\n";
+    stream << "      \"time_unit\": \"ms\",\n";
+    stream << "      \"first_frame_cpu_time\": "
+           << benchmark.first_frame_cpu_time_ms << ",\n";
+    if (benchmark.gpu_frame_count > 0) {
+      stream << "      \"gpu_time\": " << benchmark.gpu_time_ms << ",\n";
+    }
+    stream << "      \"gpu_timed_frames\": " << benchmark.gpu_frame_count
+           << ",\n";
+    stream << "      \"render_passes\": " << benchmark.render_pass_count
+           << ",\n";
+    stream << "      \"draw_calls\": " << benchmark.draw_count << ",\n";
+    stream << "      \"allocated_bytes\": " << benchmark.allocated_bytes
+           << "\n";
+    stream << "    }";
+  }
+  stream << "\n  ]\n";
+  stream << "}\n";
+  return stream.str();
+}
+
+}  // namespace impeller
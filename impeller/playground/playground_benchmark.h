@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The work of a single frame of a playground rendered headless.
+///
+struct PlaygroundFrameStats {
+  /// The time spent on the CPU rendering the frame, up to and including the
+  /// submission of its command buffers.
+  fml::TimeDelta cpu_time;
+  size_t render_pass_count = 0u;
+  size_t draw_count = 0u;
+  /// The bytes of buffers and textures allocated for the frame.
+  size_t allocated_bytes = 0u;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the frames of the playgrounds rendered headless, and
+///             writes them as Google Benchmark JSON that the parsers in
+///             //flutter/testing/benchmark understand.
+///
+///             Playgrounds are rendered headless instead of in a window when
+///             the IMPELLER_PLAYGROUND_BENCHMARK_FRAMES environment variable
+///             sets the number of frames to render. The results are written
+///             to the file named by IMPELLER_PLAYGROUND_BENCHMARK_OUT, or to
+///             impeller_playground_benchmarks.json.
+///
+///             The reporter is thread-safe.
+///
+class PlaygroundBenchmarkReporter {
+ public:
+  //----------------------------------------------------------------------------
+  /// @return     The number of frames to render each playground for, or zero
+  ///             if playgrounds aren't rendered headless.
+  ///
+  static size_t GetHeadlessFrameCount();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The reporter of the process, which writes to the file named
+  ///             by the environment.
+  ///
+  static PlaygroundBenchmarkReporter& GetInstance();
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  output_path  The file the results are written to after each
+  ///                          report, or empty to only keep them in memory.
+  ///
+  explicit PlaygroundBenchmarkReporter(std::string output_path);
+
+  ~PlaygroundBenchmarkReporter();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the results of a playground.
+  ///
+  /// @param[in]  name       The name of the benchmark, usually the name of
+  ///                        the test that opened the playground.
+  /// @param[in]  frames     The stats of each frame rendered.
+  /// @param[in]  gpu_times  The GPU time of the frames the backend could time
+  ///                        by the time the last frame was rendered, which
+  ///                        may be fewer than all of them.
+  ///
+  void Report(std::string name,
+              const std::vector<PlaygroundFrameStats>& frames,
+              const std::vector<fml::TimeDelta>& gpu_times);
+
+  //----------------------------------------------------------------------------
+  /// @return     The results reported so far, as Google Benchmark JSON.
+  ///
+  std::string ToJSON() const;
+
+ private:
+  struct Benchmark {
+    std::string name;
+    size_t frame_count = 0u;
+    double cpu_time_ms = 0.0;
+    double first_frame_cpu_time_ms = 0.0;
+    size_t gpu_frame_count = 0u;
+    double gpu_time_ms = 0.0;
+    double render_pass_count = 0.0;
+    double draw_count = 0.0;
+    double allocated_bytes = 0.0;
+  };
+
+  const std::string output_path_;
+  mutable Mutex mutex_;
+  std::vector<Benchmark> benchmarks_ IPLR_GUARDED_BY(mutex_);
+
+  std::string ToJSONLocked() const IPLR_REQUIRES(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PlaygroundBenchmarkReporter);
+};
+
+}  // namespace impeller
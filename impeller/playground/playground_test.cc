@@ -61,4 +61,9 @@ std::string PlaygroundTest::GetWindowTitle() const {
   return FormatWindowTitle(flutter::testing::GetCurrentTestName());
 }
 
+// |Playground|
+std::string PlaygroundTest::GetBenchmarkName() const {
+  return flutter::testing::GetCurrentTestName();
+}
+
 }  // namespace impeller
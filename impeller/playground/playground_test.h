@@ -34,6 +34,9 @@ class PlaygroundTest : public Playground,
   // |Playground|
   std::string GetWindowTitle() const override;
 
+  // |Playground|
+  std::string GetBenchmarkName() const override;
+
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(PlaygroundTest);
 };
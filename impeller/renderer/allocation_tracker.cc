@@ -0,0 +1,111 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/allocation_tracker.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace impeller {
+
+const char* AllocationCategoryToString(AllocationCategory category) {
+  switch (category) {
+    case AllocationCategory::kRenderTarget:
+      return "RenderTarget";
+    case AllocationCategory::kTexture:
+      return "Texture";
+    case AllocationCategory::kGlyphAtlas:
+      return "GlyphAtlas";
+    case AllocationCategory::kHostBuffer:
+      return "HostBuffer";
+    case AllocationCategory::kBuffer:
+      return "Buffer";
+  }
+  FML_UNREACHABLE();
+}
+
+static void AddBytes(AllocationTracker::Stats& stats, size_t bytes) {
+  stats.live_bytes += bytes;
+  stats.frame_peak_bytes = std::max(stats.frame_peak_bytes, stats.live_bytes);
+  stats.peak_bytes = std::max(stats.peak_bytes, stats.live_bytes);
+}
+
+static void RemoveBytes(AllocationTracker::Stats& stats, size_t bytes) {
+  FML_DCHECK(stats.live_bytes >= bytes);
+  stats.live_bytes -= std::min(stats.live_bytes, bytes);
+}
+
+AllocationTracker::Record::Record(std::shared_ptr<AllocationTracker> tracker,
+                                  AllocationCategory category,
+                                  size_t bytes)
+    : tracker_(std::move(tracker)), category_(category), bytes_(bytes) {}
+
+AllocationTracker::Record::~Record() {
+  tracker_->Release(category_, bytes_);
+}
+
+std::shared_ptr<AllocationTracker> AllocationTracker::Create() {
+  return std::shared_ptr<AllocationTracker>(new AllocationTracker());
+}
+
+AllocationTracker::AllocationTracker() = default;
+
+AllocationTracker::~AllocationTracker() = default;
+
+std::unique_ptr<AllocationTracker::Record> AllocationTracker::Track(
+    AllocationCategory category,
+    size_t bytes) {
+  {
+    Lock lock(mutex_);
+    AddBytes(stats_[static_cast<size_t>(category)], bytes);
+    AddBytes(total_stats_, bytes);
+  }
+  return std::unique_ptr<Record>(
+      new Record(shared_from_this(), category, bytes));
+}
+
+void AllocationTracker::Release(AllocationCategory category, size_t bytes) {
+  Lock lock(mutex_);
+  RemoveBytes(stats_[static_cast<size_t>(category)], bytes);
+  RemoveBytes(total_stats_, bytes);
+}
+
+AllocationTracker::Stats AllocationTracker::GetStats(
+    AllocationCategory category) const {
+  Lock lock(mutex_);
+  return stats_[static_cast<size_t>(category)];
+}
+
+AllocationTracker::Stats AllocationTracker::GetTotalStats() const {
+  Lock lock(mutex_);
+  return total_stats_;
+}
+
+void AllocationTracker::EndFrame() {
+  Lock lock(mutex_);
+  // In the order of |AllocationCategory|.
+  static_assert(kCategoryCount == 5u);
+  std::array<int64_t, kCategoryCount> live;
+  for (size_t i = 0; i < kCategoryCount; i++) {
+    live[i] = static_cast<int64_t>(stats_[i].live_bytes);
+  }
+  FML_TRACE_COUNTER("impeller", "AllocationTracker::LiveBytes",
+                    reinterpret_cast<int64_t>(this), "RenderTarget",
+                    live[0], "Texture", live[1], "GlyphAtlas", live[2],
+                    "HostBuffer", live[3], "Buffer", live[4]);
+  FML_TRACE_COUNTER("impeller", "AllocationTracker::FramePeakBytes",
+                    reinterpret_cast<int64_t>(this), "Bytes",
+                    static_cast<int64_t>(total_stats_.frame_peak_bytes));
+
+  for (auto& stats : stats_) {
+    stats.last_frame_peak_bytes = stats.frame_peak_bytes;
+    stats.frame_peak_bytes = stats.live_bytes;
+  }
+  total_stats_.last_frame_peak_bytes = total_stats_.frame_peak_bytes;
+  total_stats_.frame_peak_bytes = total_stats_.live_bytes;
+}
+
+}  // namespace impeller
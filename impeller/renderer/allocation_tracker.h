@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      What the memory of an allocation is used for.
+///
+enum class AllocationCategory {
+  kRenderTarget,
+  kTexture,
+  kGlyphAtlas,
+  kHostBuffer,
+  kBuffer,
+  kLast = kBuffer,
+};
+
+const char* AllocationCategoryToString(AllocationCategory category);
+
+//------------------------------------------------------------------------------
+/// @brief      Accounts for the memory of the buffers and textures of an
+///             allocator by category, so that the live bytes of each category
+///             and their peak during each frame can be reported.
+///
+///             Each allocation holds on to a record that releases its bytes
+///             when the allocation is collected. The tracker is thread-safe.
+///
+class AllocationTracker
+    : public std::enable_shared_from_this<AllocationTracker> {
+ public:
+  static constexpr size_t kCategoryCount =
+      static_cast<size_t>(AllocationCategory::kLast) + 1u;
+
+  struct Stats {
+    /// The bytes of the allocations that are alive.
+    size_t live_bytes = 0u;
+    /// The most bytes that were alive at once during the current frame.
+    size_t frame_peak_bytes = 0u;
+    /// The most bytes that were alive at once during the last frame that
+    /// ended.
+    size_t last_frame_peak_bytes = 0u;
+    /// The most bytes that were alive at once since the tracker was created.
+    size_t peak_bytes = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bytes of an allocation, released when this is destroyed.
+  ///
+  class Record {
+   public:
+    ~Record();
+
+    AllocationCategory GetCategory() const { return category_; }
+
+    size_t GetBytes() const { return bytes_; }
+
+   private:
+    friend class AllocationTracker;
+
+    const std::shared_ptr<AllocationTracker> tracker_;
+    const AllocationCategory category_;
+    const size_t bytes_;
+
+    Record(std::shared_ptr<AllocationTracker> tracker,
+           AllocationCategory category,
+           size_t bytes);
+
+    FML_DISALLOW_COPY_AND_ASSIGN(Record);
+  };
+
+  static std::shared_ptr<AllocationTracker> Create();
+
+  ~AllocationTracker();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the bytes of an allocation to its category.
+  ///
+  /// @return     The record to keep alive for as long as the allocation.
+  ///
+  std::unique_ptr<Record> Track(AllocationCategory category, size_t bytes);
+
+  Stats GetStats(AllocationCategory category) const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The stats of all of the categories combined.
+  ///
+  Stats GetTotalStats() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Emits the live and frame peak bytes of each category as
+  ///             timeline counters, and starts tracking the peaks of the next
+  ///             frame.
+  ///
+  void EndFrame();
+
+ private:
+  mutable Mutex mutex_;
+  std::array<Stats, kCategoryCount> stats_ IPLR_GUARDED_BY(mutex_);
+  Stats total_stats_ IPLR_GUARDED_BY(mutex_);
+
+  AllocationTracker();
+
+  void Release(AllocationCategory category, size_t bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AllocationTracker);
+};
+
+}  // namespace impeller
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/allocation_tracker.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(AllocationTrackerTest, TracksLiveBytesByCategory) {
+  auto tracker = AllocationTracker::Create();
+  auto texture = tracker->Track(AllocationCategory::kTexture, 100u);
+  auto atlas = tracker->Track(AllocationCategory::kGlyphAtlas, 50u);
+
+  ASSERT_EQ(tracker->GetStats(AllocationCategory::kTexture).live_bytes, 100u);
+  ASSERT_EQ(tracker->GetStats(AllocationCategory::kGlyphAtlas).live_bytes,
+            50u);
+  ASSERT_EQ(tracker->GetStats(AllocationCategory::kBuffer).live_bytes, 0u);
+  ASSERT_EQ(tracker->GetTotalStats().live_bytes, 150u);
+
+  texture.reset();
+  ASSERT_EQ(tracker->GetStats(AllocationCategory::kTexture).live_bytes, 0u);
+  ASSERT_EQ(tracker->GetStats(AllocationCategory::kTexture).peak_bytes, 100u);
+  ASSERT_EQ(tracker->GetTotalStats().live_bytes, 50u);
+}
+
+TEST(AllocationTrackerTest, ResetsFramePeaksAtEndOfFrame) {
+  auto tracker = AllocationTracker::Create();
+  auto kept = tracker->Track(AllocationCategory::kRenderTarget, 10u);
+  tracker->Track(AllocationCategory::kRenderTarget, 90u).reset();
+
+  auto stats = tracker->GetStats(AllocationCategory::kRenderTarget);
+  ASSERT_EQ(stats.live_bytes, 10u);
+  ASSERT_EQ(stats.frame_peak_bytes, 100u);
+  ASSERT_EQ(stats.peak_bytes, 100u);
+
+  tracker->EndFrame();
+  stats = tracker->GetStats(AllocationCategory::kRenderTarget);
+  ASSERT_EQ(stats.frame_peak_bytes, 10u);
+  ASSERT_EQ(stats.last_frame_peak_bytes, 100u);
+  ASSERT_EQ(stats.peak_bytes, 100u);
+  ASSERT_EQ(tracker->GetTotalStats().frame_peak_bytes, 10u);
+  ASSERT_EQ(tracker->GetTotalStats().last_frame_peak_bytes, 100u);
+}
+
+TEST(AllocationTrackerTest, RecordsOutliveTracker) {
+  auto tracker = AllocationTracker::Create();
+  auto record = tracker->Track(AllocationCategory::kHostBuffer, 8u);
+  std::weak_ptr<AllocationTracker> weak_tracker = tracker;
+  tracker.reset();
+  ASSERT_FALSE(weak_tracker.expired());
+  record.reset();
+  ASSERT_TRUE(weak_tracker.expired());
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -41,12 +41,20 @@ std::shared_ptr<DeviceBuffer> Allocator::CreateBufferWithCopy(
 }
 
 std::shared_ptr<DeviceBuffer> Allocator::CreateBuffer(
-    const DeviceBufferDescriptor& desc) {
-  return OnCreateBuffer(desc);
+    const DeviceBufferDescriptor& desc,
+    AllocationCategory category) {
+  auto buffer = OnCreateBuffer(desc);
+  if (buffer) {
+    total_allocated_bytes_ += desc.size;
+    buffer->allocation_record_ =
+        allocation_tracker_->Track(category, desc.size);
+  }
+  return buffer;
 }
 
 std::shared_ptr<Texture> Allocator::CreateTexture(
-    const TextureDescriptor& desc) {
+    const TextureDescriptor& desc,
+    std::optional<AllocationCategory> category) {
   const auto max_size = GetMaxTextureSizeSupported();
   if (desc.size.width > max_size.width || desc.size.height > max_size.height) {
     VALIDATION_LOG
@@ -55,7 +63,30 @@ std::shared_ptr<Texture> Allocator::CreateTexture(
     return nullptr;
   }
 
-  return OnCreateTexture(desc);
+  auto texture = OnCreateTexture(desc);
+  if (texture) {
+    const size_t bytes = desc.GetByteSizeOfBaseMipLevel() *
+                         static_cast<size_t>(desc.sample_count);
+    total_allocated_bytes_ += bytes;
+    if (!category.has_value()) {
+      category = (desc.usage & static_cast<TextureUsageMask>(
+                                   TextureUsage::kRenderTarget))
+                     ? AllocationCategory::kRenderTarget
+                     : AllocationCategory::kTexture;
+    }
+    texture->allocation_record_ =
+        allocation_tracker_->Track(category.value(), bytes);
+  }
+  return texture;
+}
+
+size_t Allocator::GetTotalAllocatedBytes() const {
+  return total_allocated_bytes_.load();
+}
+
+const std::shared_ptr<AllocationTracker>& Allocator::GetAllocationTracker()
+    const {
+  return allocation_tracker_;
 }
 
 uint16_t Allocator::MinimumBytesPerRow(PixelFormat format) const {
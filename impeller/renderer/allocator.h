@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <optional>
 #include <string>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "impeller/renderer/allocation_tracker.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
 #include "impeller/renderer/texture_descriptor.h"
 
@@ -27,9 +30,17 @@ class Allocator {
   bool IsValid() const;
 
   std::shared_ptr<DeviceBuffer> CreateBuffer(
-      const DeviceBufferDescriptor& desc);
+      const DeviceBufferDescriptor& desc,
+      AllocationCategory category = AllocationCategory::kBuffer);
 
-  std::shared_ptr<Texture> CreateTexture(const TextureDescriptor& desc);
+  //------------------------------------------------------------------------------
+  /// @brief      Creates a texture, accounted for under the category. Without
+  ///             one, textures that can be rendered to are accounted for as
+  ///             render targets.
+  ///
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc,
+      std::optional<AllocationCategory> category = std::nullopt);
 
   //------------------------------------------------------------------------------
   /// @brief      Minimum value for `row_bytes` on a Texture. The row
@@ -45,6 +56,20 @@ class Allocator {
 
   virtual ISize GetMaxTextureSizeSupported() const = 0;
 
+  //------------------------------------------------------------------------------
+  /// @brief      The number of bytes of all of the buffers and textures
+  ///             allocated so far, including those that have since been
+  ///             freed. Textures count their base mip level for each sample.
+  ///             Used by benchmarks to measure the allocations of a frame.
+  ///
+  size_t GetTotalAllocatedBytes() const;
+
+  //------------------------------------------------------------------------------
+  /// @brief      The accounting of the live bytes of the buffers and textures
+  ///             of this allocator by category.
+  ///
+  const std::shared_ptr<AllocationTracker>& GetAllocationTracker() const;
+
  protected:
   Allocator();
 
@@ -55,6 +80,10 @@ class Allocator {
       const TextureDescriptor& desc) = 0;
 
  private:
+  std::atomic<size_t> total_allocated_bytes_ = 0u;
+  const std::shared_ptr<AllocationTracker> allocation_tracker_ =
+      AllocationTracker::Create();
+
   FML_DISALLOW_COPY_AND_ASSIGN(Allocator);
 };
 
@@ -98,9 +98,10 @@ bool BlitCopyTextureToTextureCommandGLES::Encode(
     draw_fbo = draw.value();
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
+  auto& state = reactor.GetStateCache();
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_STENCIL_TEST, false);
 
   gl.BlitFramebuffer(source_region.origin.x,     // srcX0
                      source_region.origin.y,     // srcY0
@@ -155,6 +156,25 @@ bool BlitCopyTextureToBufferCommandGLES::Encode(
   return true;
 };
 
+BlitCopyBufferToTextureCommandGLES::~BlitCopyBufferToTextureCommandGLES() =
+    default;
+
+std::string BlitCopyBufferToTextureCommandGLES::GetLabel() const {
+  return label;
+}
+
+bool BlitCopyBufferToTextureCommandGLES::Encode(
+    const ReactorGLES& reactor) const {
+  // Device buffers are backed by host memory in the GLES backend, so there is
+  // no need to bind the buffer.
+  const auto* data = DeviceBufferGLES::Cast(*source).GetBufferData();
+  if (!data) {
+    return false;
+  }
+  return TextureGLES::Cast(*destination)
+      .SetContentsOfRegion(data + source_offset, destination_region);
+};
+
 BlitGenerateMipmapCommandGLES::~BlitGenerateMipmapCommandGLES() = default;
 
 std::string BlitGenerateMipmapCommandGLES::GetLabel() const {
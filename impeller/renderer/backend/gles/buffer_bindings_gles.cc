@@ -51,8 +51,10 @@ bool BufferBindingsGLES::RegisterVertexStageInput(
     offset += (input.bit_width * input.vec_size) / 8;
     vertex_attrib_arrays.emplace_back(attrib);
   }
+  vertex_attrib_indices_.clear();
   for (auto& array : vertex_attrib_arrays) {
     array.stride = offset;
+    vertex_attrib_indices_.push_back(array.index);
   }
   vertex_attrib_arrays_ = std::move(vertex_attrib_arrays);
   return true;
@@ -93,6 +95,7 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   if (!gl.IsProgram(program)) {
     return false;
   }
+  program_ = program;
   GLint max_name_size = 0;
   gl.GetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_size);
 
@@ -131,9 +134,10 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+                                              StateCacheGLES& state,
                                               size_t vertex_offset) const {
+  state.SetVertexAttribArraysEnabled(vertex_attrib_indices_);
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -149,39 +153,34 @@ bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
 
 bool BufferBindingsGLES::BindUniformData(
     const ProcTableGLES& gl,
+    StateCacheGLES& state,
     Allocator& transients_allocator,
     const Bindings& vertex_bindings,
     const Bindings& fragment_bindings) const {
   for (const auto& buffer : vertex_bindings.buffers) {
-    if (!BindUniformBuffer(gl, transients_allocator, buffer.second)) {
+    if (!BindUniformBuffer(gl, state, transients_allocator, buffer.second)) {
       return false;
     }
   }
   for (const auto& buffer : fragment_bindings.buffers) {
-    if (!BindUniformBuffer(gl, transients_allocator, buffer.second)) {
+    if (!BindUniformBuffer(gl, state, transients_allocator, buffer.second)) {
       return false;
     }
   }
 
-  if (!BindTextures(gl, vertex_bindings, ShaderStage::kVertex)) {
+  if (!BindTextures(gl, state, vertex_bindings, ShaderStage::kVertex)) {
     return false;
   }
 
-  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment)) {
+  if (!BindTextures(gl, state, fragment_bindings, ShaderStage::kFragment)) {
     return false;
   }
 
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
-  }
-  return true;
-}
-
 bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
+                                           StateCacheGLES& state,
                                            Allocator& transients_allocator,
                                            const BufferResource& buffer) const {
   const auto* metadata = buffer.isa;
@@ -248,6 +247,12 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
           reinterpret_cast<const GLfloat*>(array_element_buffer.data());
     }
 
+    if (!state.ShouldUploadUniform(program_, location->second, buffer_data,
+                                   member.size * element_count)) {
+      // The program still holds this value from a previous command.
+      continue;
+    }
+
     switch (member.type) {
       case ShaderType::kFloat:
         switch (member.size) {
@@ -310,6 +315,7 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
+                                      StateCacheGLES& state,
                                       const Bindings& bindings,
                                       ShaderStage stage) const {
   size_t active_index = 0;
@@ -335,7 +341,7 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
                         "this shader stage.";
       return false;
     }
-    gl.ActiveTexture(GL_TEXTURE0 + active_index);
+    state.ActiveTexture(GL_TEXTURE0 + active_index);
 
     //--------------------------------------------------------------------------
     /// Bind the texture.
@@ -359,7 +365,11 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
     //--------------------------------------------------------------------------
     /// Set the texture uniform location.
     ///
-    gl.Uniform1i(uniform->second, active_index);
+    const GLint unit = static_cast<GLint>(active_index);
+    if (state.ShouldUploadUniform(program_, uniform->second, &unit,
+                                  sizeof(unit))) {
+      gl.Uniform1i(uniform->second, unit);
+    }
 
     //--------------------------------------------------------------------------
     /// Bump up the active index at binding.
@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/vertex_descriptor.h"
 
@@ -31,15 +32,15 @@ class BufferBindingsGLES {
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
   bool BindVertexAttributes(const ProcTableGLES& gl,
+                            StateCacheGLES& state,
                             size_t vertex_offset) const;
 
   bool BindUniformData(const ProcTableGLES& gl,
+                       StateCacheGLES& state,
                        Allocator& transients_allocator,
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings) const;
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -53,13 +54,17 @@ class BufferBindingsGLES {
     GLsizei offset = 0u;
   };
   std::vector<VertexAttribPointer> vertex_attrib_arrays_;
+  std::vector<GLuint> vertex_attrib_indices_;
+  GLuint program_ = GL_NONE;
   std::map<std::string, GLint> uniform_locations_;
 
   bool BindUniformBuffer(const ProcTableGLES& gl,
+                         StateCacheGLES& state,
                          Allocator& transients_allocator,
                          const BufferResource& buffer) const;
 
   bool BindTextures(const ProcTableGLES& gl,
+                    StateCacheGLES& state,
                     const Bindings& bindings,
                     ShaderStage stage) const;
 
@@ -11,16 +11,36 @@
 
 namespace impeller {
 
+static std::vector<PixelFormat> GetSupportedCompressedFormats(
+    const DescriptionGLES& description) {
+  std::vector<PixelFormat> formats;
+  // ETC2 is a core format since OpenGL ES 3.0.
+  if ((description.IsES() &&
+       description.GetGlVersion().IsAtLeast(Version(3, 0, 0))) ||
+      description.HasExtension("GL_ARB_ES3_compatibility")) {
+    formats.push_back(PixelFormat::kETC2R8G8B8A8UNormBlock);
+  }
+  if (description.HasExtension("GL_KHR_texture_compression_astc_ldr")) {
+    formats.push_back(PixelFormat::kASTC4x4UNormBlock);
+  }
+  if (description.HasExtension("GL_EXT_texture_compression_s3tc")) {
+    formats.push_back(PixelFormat::kBC3UNormBlock);
+  }
+  return formats;
+}
+
 std::shared_ptr<ContextGLES> ContextGLES::Create(
     std::unique_ptr<ProcTableGLES> gl,
-    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries) {
-  return std::shared_ptr<ContextGLES>(
-      new ContextGLES(std::move(gl), shader_libraries));
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+    fml::UniqueFD cache_directory) {
+  return std::shared_ptr<ContextGLES>(new ContextGLES(
+      std::move(gl), shader_libraries, std::move(cache_directory)));
 }
 
-ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
-                         const std::vector<std::shared_ptr<fml::Mapping>>&
-                             shader_libraries_mappings) {
+ContextGLES::ContextGLES(
+    std::unique_ptr<ProcTableGLES> gl,
+    const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_mappings,
+    fml::UniqueFD cache_directory) {
   reactor_ = std::make_shared<ReactorGLES>(std::move(gl));
   if (!reactor_->IsValid()) {
     VALIDATION_LOG << "Could not create valid reactor.";
@@ -40,8 +60,10 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
 
   // Create the pipeline library.
   {
-    pipeline_library_ =
-        std::shared_ptr<PipelineLibraryGLES>(new PipelineLibraryGLES(reactor_));
+    auto binary_cache = std::make_shared<ProgramBinaryCacheGLES>(
+        std::move(cache_directory), *reactor_->GetProcTable().GetDescription());
+    pipeline_library_ = std::shared_ptr<PipelineLibraryGLES>(
+        new PipelineLibraryGLES(reactor_, std::move(binary_cache)));
   }
 
   // Create allocators.
@@ -78,13 +100,20 @@ ContextGLES::ContextGLES(std::unique_ptr<ProcTableGLES> gl,
             .SetSupportsSSBO(false)
             .SetSupportsTextureToTextureBlits(
                 reactor_->GetProcTable().BlitFramebuffer.IsAvailable())
-            .SetSupportsFramebufferFetch(false)
+            .SetSupportsFramebufferFetch(
+                reactor_->GetProcTable().GetDescription()->HasExtension(
+                    "GL_EXT_shader_framebuffer_fetch"))
             .SetDefaultColorFormat(PixelFormat::kB8G8R8A8UNormInt)
             .SetDefaultStencilFormat(PixelFormat::kS8UInt)
             .SetSupportsCompute(false, false)
+            .SetSupportsInstancedRendering(false)
+            .SetSupportedCompressedFormats(GetSupportedCompressedFormats(
+                *reactor_->GetProcTable().GetDescription()))
             .Build();
   }
 
+  gpu_tracer_ = std::make_shared<GPUTracerGLES>(reactor_->GetProcTable());
+
   is_valid_ = true;
 }
 
@@ -149,6 +178,11 @@ const IDeviceCapabilities& ContextGLES::GetDeviceCapabilities() const {
   return *device_capabilities_;
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextGLES::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 // |Context|
 PixelFormat ContextGLES::GetColorAttachmentPixelFormat() const {
   return PixelFormat::kR8G8B8A8UNormInt;
@@ -5,9 +5,11 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/gles/allocator_gles.h"
 #include "impeller/renderer/backend/gles/command_buffer_gles.h"
+#include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/backend/gles/sampler_library_gles.h"
@@ -20,9 +22,14 @@ namespace impeller {
 class ContextGLES final : public Context,
                           public BackendCast<ContextGLES, Context> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context. If the cache directory is valid, linked
+  ///             program binaries are loaded from and persisted to it.
+  ///
   static std::shared_ptr<ContextGLES> Create(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory);
 
   // |Context|
   ~ContextGLES() override;
@@ -42,11 +49,13 @@ class ContextGLES final : public Context,
   std::shared_ptr<WorkQueue> work_queue_;
   std::shared_ptr<AllocatorGLES> resource_allocator_;
   std::unique_ptr<IDeviceCapabilities> device_capabilities_;
+  std::shared_ptr<GPUTracerGLES> gpu_tracer_;
   bool is_valid_ = false;
 
   ContextGLES(
       std::unique_ptr<ProcTableGLES> gl,
-      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries);
+      const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries,
+      fml::UniqueFD cache_directory);
 
   // |Context|
   bool IsValid() const override;
@@ -72,6 +81,9 @@ class ContextGLES final : public Context,
   // |Context|
   const IDeviceCapabilities& GetDeviceCapabilities() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   // |Context|
   PixelFormat GetColorAttachmentPixelFormat() const override;
 
@@ -141,6 +141,10 @@ bool DescriptionGLES::IsES() const {
   return is_es_;
 }
 
+const Version& DescriptionGLES::GetGlVersion() const {
+  return gl_version_;
+}
+
 bool DescriptionGLES::HasExtension(const std::string& ext) const {
   return extensions_.find(ext) != extensions_.end();
 }
@@ -80,7 +80,7 @@ bool DeviceBufferGLES::BindAndUploadDataIfNecessary(BindingType type) const {
   const auto target_type = ToTarget(type);
   const auto& gl = reactor_->GetProcTable();
 
-  gl.BindBuffer(target_type, buffer.value());
+  reactor_->GetStateCache().BindBuffer(target_type, buffer.value());
 
   if (upload_generation_ != generation_) {
     TRACE_EVENT1("impeller", "BufferData", "Bytes",
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+GPUTracerGLES::GPUTracerGLES(const ProcTableGLES& gl)
+    : supports_timer_queries_(gl.QueryCounterEXT.IsAvailable()) {}
+
+GPUTracerGLES::~GPUTracerGLES() = default;
+
+void GPUTracerGLES::BeginPass(const ProcTableGLES& gl, std::string label) {
+  if (!supports_timer_queries_) {
+    return;
+  }
+  Lock lock(queries_mutex_);
+  FML_DCHECK(!open_pass_.has_value());
+  CollectResults(gl);
+  if (!IsTimingEnabled()) {
+    return;
+  }
+  GLuint queries[2] = {GL_NONE, GL_NONE};
+  gl.GenQueriesEXT(2, queries);
+  gl.QueryCounterEXT(queries[0], GL_TIMESTAMP_EXT);
+  open_pass_ = PassQueries{
+      .label = std::move(label),
+      .frame_number = BeginTimedWork(),
+      .begin = queries[0],
+      .end = queries[1],
+  };
+}
+
+void GPUTracerGLES::EndPass(const ProcTableGLES& gl) {
+  if (!supports_timer_queries_) {
+    return;
+  }
+  Lock lock(queries_mutex_);
+  if (!open_pass_.has_value()) {
+    return;
+  }
+  gl.QueryCounterEXT(open_pass_->end, GL_TIMESTAMP_EXT);
+  pending_passes_.push_back(std::move(open_pass_.value()));
+  open_pass_.reset();
+}
+
+void GPUTracerGLES::CollectResults(const ProcTableGLES& gl) {
+  if (pending_passes_.empty()) {
+    return;
+  }
+  // Reading the flag clears it. If it was set, the timer was disrupted (for
+  // instance by a change of the GPU frequency) and the results of the pending
+  // queries are meaningless.
+  GLint disjoint = GL_FALSE;
+  gl.GetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+  while (!pending_passes_.empty()) {
+    auto& pass = pending_passes_.front();
+    GLuint available = GL_FALSE;
+    gl.GetQueryObjectuivEXT(pass.end, GL_QUERY_RESULT_AVAILABLE_EXT,
+                            &available);
+    if (available != GL_TRUE) {
+      // Queries complete in order, so the later ones aren't available either.
+      break;
+    }
+    std::optional<fml::TimeDelta> duration;
+    if (disjoint == GL_FALSE) {
+      GLuint64 begin_time = 0u;
+      GLuint64 end_time = 0u;
+      gl.GetQueryObjectui64vEXT(pass.begin, GL_QUERY_RESULT_EXT, &begin_time);
+      gl.GetQueryObjectui64vEXT(pass.end, GL_QUERY_RESULT_EXT, &end_time);
+      duration = fml::TimeDelta::FromNanoseconds(
+          static_cast<int64_t>(end_time - begin_time));
+    }
+    GLuint queries[2] = {pass.begin, pass.end};
+    gl.DeleteQueriesEXT(2, queries);
+    EndTimedWork(pass.frame_number, std::move(pass.label), duration);
+    pending_passes_.pop_front();
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <optional>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/backend_cast.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/gpu_tracer.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Times passes with timestamp queries from
+///             GL_EXT_disjoint_timer_query.
+///
+///             Query objects are not shared between contexts, so passes must
+///             be timed on the context that renders them. The results of
+///             earlier passes are collected whenever a new pass is timed.
+///
+class GPUTracerGLES final : public GPUTracer,
+                            public BackendCast<GPUTracerGLES, GPUTracer> {
+ public:
+  explicit GPUTracerGLES(const ProcTableGLES& gl);
+
+  // |GPUTracer|
+  ~GPUTracerGLES() override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes a timestamp before the commands of a pass, if timer
+  ///             queries are supported and timing is enabled.
+  ///
+  void BeginPass(const ProcTableGLES& gl, std::string label);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes a timestamp after the commands of the pass begun by
+  ///             the last call to `BeginPass`.
+  ///
+  void EndPass(const ProcTableGLES& gl);
+
+ private:
+  struct PassQueries {
+    std::string label;
+    uint64_t frame_number = 0u;
+    GLuint begin = GL_NONE;
+    GLuint end = GL_NONE;
+  };
+
+  const bool supports_timer_queries_;
+  Mutex queries_mutex_;
+  std::optional<PassQueries> open_pass_ IPLR_GUARDED_BY(queries_mutex_);
+  // Passes whose commands have been encoded, oldest first.
+  std::deque<PassQueries> pending_passes_ IPLR_GUARDED_BY(queries_mutex_);
+
+  // Reports the durations of the passes whose results are available.
+  void CollectResults(const ProcTableGLES& gl) IPLR_REQUIRES(queries_mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(GPUTracerGLES);
+};
+
+}  // namespace impeller
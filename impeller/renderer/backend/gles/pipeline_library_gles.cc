@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/gles/pipeline_library_gles.h"
 
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -15,8 +16,10 @@
 
 namespace impeller {
 
-PipelineLibraryGLES::PipelineLibraryGLES(ReactorGLES::Ref reactor)
-    : reactor_(std::move(reactor)) {}
+PipelineLibraryGLES::PipelineLibraryGLES(
+    ReactorGLES::Ref reactor,
+    std::shared_ptr<const ProgramBinaryCacheGLES> binary_cache)
+    : reactor_(std::move(reactor)), binary_cache_(std::move(binary_cache)) {}
 
 static std::string GetShaderInfoLog(const ProcTableGLES& gl, GLuint shader) {
   GLint log_length = 0;
@@ -73,10 +76,12 @@ static bool LinkProgram(
     const ReactorGLES& reactor,
     const std::shared_ptr<PipelineGLES>& pipeline,
     const std::shared_ptr<const ShaderFunction>& vert_function,
-    const std::shared_ptr<const ShaderFunction>& frag_function) {
+    const std::shared_ptr<const ShaderFunction>& frag_function,
+    const ProgramBinaryCacheGLES* binary_cache) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   const auto& descriptor = pipeline->GetDescriptor();
+  const auto& stage_inputs = descriptor.GetVertexDescriptor()->GetStageInputs();
 
   auto vert_mapping =
       ShaderFunctionGLES::Cast(*vert_function).GetSourceMapping();
@@ -85,6 +90,21 @@ static bool LinkProgram(
 
   const auto& gl = reactor.GetProcTable();
 
+  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
+  if (!program.has_value()) {
+    VALIDATION_LOG << "Could not get program handle from reactor.";
+    return false;
+  }
+
+  std::optional<uint64_t> binary_key;
+  if (binary_cache && binary_cache->IsValid()) {
+    binary_key = ProgramBinaryCacheGLES::ComputeKey(
+        *vert_mapping, *frag_mapping, stage_inputs);
+    if (binary_cache->LoadProgram(gl, *program, *binary_key)) {
+      return true;
+    }
+  }
+
   auto vert_shader = gl.CreateShader(GL_VERTEX_SHADER);
   auto frag_shader = gl.CreateShader(GL_FRAGMENT_SHADER);
 
@@ -128,12 +148,6 @@ static bool LinkProgram(
     return false;
   }
 
-  auto program = reactor.GetGLHandle(pipeline->GetProgramHandle());
-  if (!program.has_value()) {
-    VALIDATION_LOG << "Could not get program handle from reactor.";
-    return false;
-  }
-
   gl.AttachShader(*program, vert_shader);
   gl.AttachShader(*program, frag_shader);
 
@@ -146,8 +160,7 @@ static bool LinkProgram(
         gl.DetachShader(program, frag_shader);
       });
 
-  for (const auto& stage_input :
-       descriptor.GetVertexDescriptor()->GetStageInputs()) {
+  for (const auto& stage_input : stage_inputs) {
     gl.BindAttribLocation(*program,                                   //
                           static_cast<GLuint>(stage_input.location),  //
                           stage_input.name                            //
@@ -164,6 +177,10 @@ static bool LinkProgram(
                    << gl.GetProgramInfoLogString(*program);
     return false;
   }
+
+  if (binary_key.has_value()) {
+    binary_cache->StoreProgram(gl, *program, *binary_key);
+  }
   return true;
 }
 
@@ -201,11 +218,13 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  RecordPipelineCompile();
   auto weak_this = weak_from_this();
 
-  auto result = reactor_->AddOperation(
+  auto result = reactor_->AddResourceOperation(
       [promise, weak_this, reactor_ptr = reactor_, descriptor, vert_function,
-       frag_function](const ReactorGLES& reactor) {
+       frag_function,
+       binary_cache = binary_cache_](const ReactorGLES& reactor) {
         auto strong_this = weak_this.lock();
         if (!strong_this) {
           promise->set_value(nullptr);
@@ -221,10 +240,11 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryGLES::GetPipeline(
           VALIDATION_LOG << "Could not obtain program handle.";
           return;
         }
-        const auto link_result = LinkProgram(reactor,        //
-                                             pipeline,       //
-                                             vert_function,  //
-                                             frag_function   //
+        const auto link_result = LinkProgram(reactor,             //
+                                             pipeline,            //
+                                             vert_function,       //
+                                             frag_function,       //
+                                             binary_cache.get()   //
         );
         if (!link_result) {
           promise->set_value(nullptr);
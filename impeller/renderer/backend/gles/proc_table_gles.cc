@@ -111,6 +111,28 @@ ProcTableGLES::ProcTableGLES(Resolver resolver) {
     DiscardFramebufferEXT.Reset();
   }
 
+  // Sync objects and invalidation may be resolved but can't be used with
+  // GLES 2 contexts.
+  if (!description_->GetGlVersion().IsAtLeast(Version(3, 0, 0))) {
+    DeleteSync.Reset();
+    FenceSync.Reset();
+    InvalidateFramebuffer.Reset();
+    WaitSync.Reset();
+  }
+
+  if (!description_->HasExtension("GL_OES_get_program_binary")) {
+    GetProgramBinaryOES.Reset();
+    ProgramBinaryOES.Reset();
+  }
+
+  if (!description_->HasExtension("GL_EXT_disjoint_timer_query")) {
+    GenQueriesEXT.Reset();
+    DeleteQueriesEXT.Reset();
+    QueryCounterEXT.Reset();
+    GetQueryObjectuivEXT.Reset();
+    GetQueryObjectui64vEXT.Reset();
+  }
+
   capabilities_ = std::make_unique<CapabilitiesGLES>(*this);
 
   is_valid_ = true;
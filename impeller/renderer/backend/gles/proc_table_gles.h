@@ -101,6 +101,7 @@ struct GLProc {
   PROC(ClearStencil);                        \
   PROC(ColorMask);                           \
   PROC(CompileShader);                       \
+  PROC(CompressedTexImage2D);                \
   PROC(CreateProgram);                       \
   PROC(CreateShader);                        \
   PROC(CullFace);                            \
@@ -119,6 +120,8 @@ struct GLProc {
   PROC(DrawElements);                        \
   PROC(Enable);                              \
   PROC(EnableVertexAttribArray);             \
+  PROC(Finish);                              \
+  PROC(Flush);                               \
   PROC(FramebufferRenderbuffer);             \
   PROC(FramebufferTexture2D);                \
   PROC(FrontFace);                           \
@@ -145,6 +148,7 @@ struct GLProc {
   PROC(IsShader);                            \
   PROC(IsTexture);                           \
   PROC(LinkProgram);                         \
+  PROC(PixelStorei);                         \
   PROC(RenderbufferStorage);                 \
   PROC(Scissor);                             \
   PROC(ShaderBinary);                        \
@@ -153,6 +157,7 @@ struct GLProc {
   PROC(StencilMaskSeparate);                 \
   PROC(StencilOpSeparate);                   \
   PROC(TexImage2D);                          \
+  PROC(TexSubImage2D);                       \
   PROC(TexParameteri);                       \
   PROC(Uniform1fv);                          \
   PROC(Uniform1i);                           \
@@ -165,13 +170,25 @@ struct GLProc {
   PROC(Viewport);                            \
   PROC(ReadPixels);
 
-#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) PROC(BlitFramebuffer);
+#define FOR_EACH_IMPELLER_GLES3_PROC(PROC) \
+  PROC(BlitFramebuffer);                   \
+  PROC(DeleteSync);                        \
+  PROC(FenceSync);                         \
+  PROC(InvalidateFramebuffer);             \
+  PROC(WaitSync);
 
 #define FOR_EACH_IMPELLER_EXT_PROC(PROC) \
   PROC(DiscardFramebufferEXT);           \
   PROC(PushDebugGroupKHR);               \
   PROC(PopDebugGroupKHR);                \
-  PROC(ObjectLabelKHR);
+  PROC(ObjectLabelKHR);                  \
+  PROC(GetProgramBinaryOES);             \
+  PROC(ProgramBinaryOES);                \
+  PROC(GenQueriesEXT);                   \
+  PROC(DeleteQueriesEXT);                \
+  PROC(QueryCounterEXT);                 \
+  PROC(GetQueryObjectuivEXT);            \
+  PROC(GetQueryObjectui64vEXT);
 
 enum class DebugResourceType {
   kTexture,
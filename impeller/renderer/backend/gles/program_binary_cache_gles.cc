@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/program_binary_cache_gles.h"
+
+#include <cinttypes>
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/strings.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+namespace {
+
+// A 64 bit FNV-1a hash. Unlike std::hash, this is stable across launches.
+class StableHash {
+ public:
+  void Add(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 0x100000001b3ull;
+    }
+  }
+
+  void Add(const std::string& string) {
+    Add(string.data(), string.size() + 1u);
+  }
+
+  uint64_t GetHash() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+}  // namespace
+
+static uint64_t ComputeDriverHash(const DescriptionGLES& description) {
+  StableHash hash;
+  // Includes the vendor, renderer and version strings.
+  hash.Add(description.GetString());
+  return hash.GetHash();
+}
+
+ProgramBinaryCacheGLES::ProgramBinaryCacheGLES(
+    fml::UniqueFD directory,
+    const DescriptionGLES& description)
+    : directory_(std::move(directory)),
+      driver_hash_(ComputeDriverHash(description)) {}
+
+ProgramBinaryCacheGLES::~ProgramBinaryCacheGLES() = default;
+
+bool ProgramBinaryCacheGLES::IsValid() const {
+  return directory_.is_valid();
+}
+
+uint64_t ProgramBinaryCacheGLES::ComputeKey(
+    const fml::Mapping& vert_source,
+    const fml::Mapping& frag_source,
+    const std::vector<ShaderStageIOSlot>& inputs) {
+  StableHash hash;
+  const uint64_t vert_size = vert_source.GetSize();
+  hash.Add(&vert_size, sizeof(vert_size));
+  hash.Add(vert_source.GetMapping(), vert_source.GetSize());
+  const uint64_t frag_size = frag_source.GetSize();
+  hash.Add(&frag_size, sizeof(frag_size));
+  hash.Add(frag_source.GetMapping(), frag_source.GetSize());
+  for (const auto& input : inputs) {
+    const uint64_t location = input.location;
+    hash.Add(&location, sizeof(location));
+    hash.Add(input.name);
+  }
+  return hash.GetHash();
+}
+
+std::string ProgramBinaryCacheGLES::FileName(uint64_t key) {
+  return SPrintF("%016" PRIx64 ".glbin", key);
+}
+
+bool ProgramBinaryCacheGLES::LoadProgram(const ProcTableGLES& gl,
+                                         GLuint program,
+                                         uint64_t key) const {
+  if (!IsValid() || !gl.ProgramBinaryOES.IsAvailable()) {
+    return false;
+  }
+
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::LoadProgram");
+
+  const auto file_name = FileName(key);
+  if (!fml::FileExists(directory_, file_name.c_str())) {
+    return false;
+  }
+  auto mapping = fml::FileMapping::CreateReadOnly(directory_, file_name);
+  if (!mapping || mapping->GetSize() < sizeof(BinaryHeader)) {
+    return false;
+  }
+
+  BinaryHeader header;
+  std::memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (header.signature != BinaryHeader::kSignature ||
+      header.version != BinaryHeader::kVersion ||
+      header.driver_hash != driver_hash_ ||
+      header.binary_size != mapping->GetSize() - sizeof(header)) {
+    // Written by another driver or version of the engine. The file will be
+    // replaced once the program has been linked from source.
+    return false;
+  }
+
+  gl.ProgramBinaryOES(program,                                 //
+                      header.binary_format,                    //
+                      mapping->GetMapping() + sizeof(header),  //
+                      header.binary_size                       //
+  );
+
+  GLint link_status = GL_FALSE;
+  gl.GetProgramiv(program, GL_LINK_STATUS, &link_status);
+  // Drivers may reject binaries they produced, for instance after an update
+  // that didn't change the version strings. This is not an error.
+  return link_status == GL_TRUE;
+}
+
+bool ProgramBinaryCacheGLES::StoreProgram(const ProcTableGLES& gl,
+                                          GLuint program,
+                                          uint64_t key) const {
+  if (!IsValid() || !gl.GetProgramBinaryOES.IsAvailable()) {
+    return false;
+  }
+
+  TRACE_EVENT0("impeller", "ProgramBinaryCacheGLES::StoreProgram");
+
+  GLint binary_length = 0;
+  gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &binary_length);
+  if (binary_length <= 0) {
+    return false;
+  }
+
+  std::vector<uint8_t> data(sizeof(BinaryHeader) + binary_length);
+  GLsizei written_length = 0;
+  GLenum binary_format = GL_NONE;
+  gl.GetProgramBinaryOES(program,                             //
+                         binary_length,                       //
+                         &written_length,                     //
+                         &binary_format,                      //
+                         data.data() + sizeof(BinaryHeader)   //
+  );
+  if (written_length <= 0 || written_length > binary_length) {
+    return false;
+  }
+  data.resize(sizeof(BinaryHeader) + written_length);
+
+  BinaryHeader header;
+  header.driver_hash = driver_hash_;
+  header.binary_format = binary_format;
+  header.binary_size = static_cast<uint32_t>(written_length);
+  std::memcpy(data.data(), &header, sizeof(header));
+
+  fml::DataMapping mapping(std::move(data));
+  if (!fml::WriteAtomically(directory_, FileName(key).c_str(), mapping)) {
+    VALIDATION_LOG << "Could not write program binary to the cache.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/gles/description_gles.h"
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/shader_types.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Persists linked program binaries to a directory so that
+///             programs don't have to be compiled and linked again on
+///             subsequent launches.
+///
+///             Binaries are keyed by the shader sources and the attribute
+///             locations bound before linking. Each file is stamped with the
+///             identity of the driver that produced it, and binaries from
+///             other drivers (including other versions of the same driver)
+///             are ignored. Drivers are also free to reject binaries they
+///             previously produced, in which case the program must be
+///             compiled as usual.
+///
+///             The cache holds no mutable state and may be used from any
+///             thread the reactor performs operations on.
+///
+class ProgramBinaryCacheGLES {
+ public:
+  // Header written at the start of each cached program binary.
+  struct BinaryHeader {
+    // "IPBC" in little endian byte order.
+    static constexpr uint32_t kSignature = 0x43425049;
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion;
+    uint64_t driver_hash = 0;
+    uint32_t binary_format = 0;
+    uint32_t binary_size = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a cache that uses the files in the directory, which
+  ///             must be readable and writable.
+  ///
+  /// @param[in]  directory    The cache directory. If invalid, the cache is
+  ///                          disabled.
+  /// @param[in]  description  The description of the driver programs are
+  ///                          linked with.
+  ///
+  ProgramBinaryCacheGLES(fml::UniqueFD directory,
+                         const DescriptionGLES& description);
+
+  ~ProgramBinaryCacheGLES();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Computes the key a program linked from the given sources and
+  ///             stage inputs is stored under. The key is stable across
+  ///             launches.
+  ///
+  static uint64_t ComputeKey(const fml::Mapping& vert_source,
+                             const fml::Mapping& frag_source,
+                             const std::vector<ShaderStageIOSlot>& inputs);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Loads the binary stored under the key into the program.
+  ///
+  /// @return     If the program was successfully linked from the binary. If
+  ///             not, the program must be compiled and linked from source.
+  ///
+  bool LoadProgram(const ProcTableGLES& gl, GLuint program, uint64_t key) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stores the binary of the linked program under the key.
+  ///             Performs file IO on the calling thread.
+  ///
+  bool StoreProgram(const ProcTableGLES& gl,
+                    GLuint program,
+                    uint64_t key) const;
+
+ private:
+  const fml::UniqueFD directory_;
+  const uint64_t driver_hash_;
+
+  static std::string FileName(uint64_t key);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ProgramBinaryCacheGLES);
+};
+
+}  // namespace impeller
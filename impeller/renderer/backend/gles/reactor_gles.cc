@@ -11,6 +11,68 @@
 
 namespace impeller {
 
+namespace {
+
+struct CurrentStateCache {
+  const ReactorGLES* reactor = nullptr;
+  StateCacheGLES* cache = nullptr;
+};
+
+// The state of a context is shadowed for the duration of the outermost
+// reaction of a reactor on a thread.
+thread_local CurrentStateCache tCurrentStateCache;
+
+// Installs a state cache for the calling thread if it isn't already in a
+// reaction of the reactor.
+class ScopedReactionStateCache {
+ public:
+  explicit ScopedReactionStateCache(const ReactorGLES& reactor)
+      : previous_(tCurrentStateCache) {
+    if (previous_.reactor == &reactor) {
+      return;
+    }
+    cache_.emplace(reactor.GetProcTable());
+    tCurrentStateCache = {&reactor, &cache_.value()};
+  }
+
+  ~ScopedReactionStateCache() {
+    if (!cache_.has_value()) {
+      return;
+    }
+    cache_->Reset();
+    tCurrentStateCache = previous_;
+    // The state of the context of the other reactor may have been changed by
+    // this reaction.
+    if (previous_.cache) {
+      previous_.cache->Invalidate();
+    }
+  }
+
+ private:
+  const CurrentStateCache previous_;
+  std::optional<StateCacheGLES> cache_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ScopedReactionStateCache);
+};
+
+// Textures, buffers, renderbuffers and programs are shared between contexts
+// in a share group. Container objects like framebuffers are not.
+bool IsSharedHandleType(HandleType type) {
+  switch (type) {
+    case HandleType::kTexture:
+    case HandleType::kBuffer:
+    case HandleType::kProgram:
+    case HandleType::kRenderBuffer:
+      return true;
+    case HandleType::kUnknown:
+    case HandleType::kFrameBuffer:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace
+
 ReactorGLES::ReactorGLES(std::unique_ptr<ProcTableGLES> gl)
     : proc_table_(std::move(gl)) {
   if (!proc_table_ || !proc_table_->IsValid()) {
@@ -40,8 +102,18 @@ bool ReactorGLES::RemoveWorker(WorkerID worker) {
 }
 
 bool ReactorGLES::HasPendingOperations() const {
-  Lock ops_lock(ops_mutex_);
-  return !ops_.empty();
+  {
+    Lock ops_lock(ops_mutex_);
+    if (!ops_.empty()) {
+      return true;
+    }
+  }
+  return HasPendingResourceOperations();
+}
+
+bool ReactorGLES::HasPendingResourceOperations() const {
+  std::scoped_lock lock(resource_ops_mutex_);
+  return !resource_ops_.empty();
 }
 
 const ProcTableGLES& ReactorGLES::GetProcTable() const {
@@ -49,22 +121,37 @@ const ProcTableGLES& ReactorGLES::GetProcTable() const {
   return *proc_table_;
 }
 
+StateCacheGLES& ReactorGLES::GetStateCache() const {
+  if (tCurrentStateCache.reactor == this) {
+    return *tCurrentStateCache.cache;
+  }
+  // Nothing is known about the state outside of a reaction, so hand out a
+  // cache that doesn't elide any calls.
+  thread_local std::optional<StateCacheGLES> unknown_state;
+  unknown_state.emplace(GetProcTable());
+  return unknown_state.value();
+}
+
 std::optional<GLuint> ReactorGLES::GetGLHandle(const HandleGLES& handle) const {
-  ReaderLock handles_lock(handles_mutex_);
-  if (auto found = handles_.find(handle); found != handles_.end()) {
-    if (found->second.pending_collection) {
-      VALIDATION_LOG
-          << "Attempted to acquire a handle that was pending collection.";
-      return std::nullopt;
-    }
-    if (!found->second.name.has_value()) {
-      VALIDATION_LOG << "Attempt to acquire a handle outside of an operation.";
-      return std::nullopt;
-    }
-    return found->second.name;
+  std::optional<GLuint> name;
+  const bool found =
+      handles_.VisitShared(handle, [&name](const LiveHandle& live_handle) {
+        if (live_handle.pending_collection) {
+          VALIDATION_LOG
+              << "Attempted to acquire a handle that was pending collection.";
+          return;
+        }
+        if (!live_handle.name.has_value()) {
+          VALIDATION_LOG
+              << "Attempt to acquire a handle outside of an operation.";
+          return;
+        }
+        name = live_handle.name;
+      });
+  if (!found) {
+    VALIDATION_LOG << "Attempted to acquire an invalid GL handle.";
   }
-  VALIDATION_LOG << "Attempted to acquire an invalid GL handle.";
-  return std::nullopt;
+  return name;
 }
 
 bool ReactorGLES::AddOperation(Operation operation) {
@@ -80,6 +167,19 @@ bool ReactorGLES::AddOperation(Operation operation) {
   return true;
 }
 
+bool ReactorGLES::AddResourceOperation(Operation operation) {
+  if (!operation) {
+    return false;
+  }
+  {
+    std::scoped_lock lock(resource_ops_mutex_);
+    resource_ops_.emplace_back(std::move(operation));
+  }
+  // Attempt a reaction if able but it is not an error if this isn't possible.
+  [[maybe_unused]] auto result = React();
+  return true;
+}
+
 static std::optional<GLuint> CreateGLHandle(const ProcTableGLES& gl,
                                             HandleType type) {
   GLuint handle = GL_NONE;
@@ -137,26 +237,31 @@ HandleGLES ReactorGLES::CreateHandle(HandleType type) {
   if (new_handle.IsDead()) {
     return HandleGLES::DeadHandle();
   }
-  WriterLock handles_lock(handles_mutex_);
-  auto gl_handle = CanReactOnCurrentThread()
-                       ? CreateGLHandle(GetProcTable(), type)
-                       : std::nullopt;
-  handles_[new_handle] = LiveHandle{gl_handle};
+  const auto can_create =
+      CanReactOnCurrentThread() ||
+      (IsSharedHandleType(type) &&
+       CanPerformResourceOperationsOnCurrentThread());
+  auto gl_handle =
+      can_create ? CreateGLHandle(GetProcTable(), type) : std::nullopt;
+  handles_.InsertOrAssign(new_handle, LiveHandle{gl_handle});
   return new_handle;
 }
 
 void ReactorGLES::CollectHandle(HandleGLES handle) {
-  WriterLock handles_lock(handles_mutex_);
-  if (auto found = handles_.find(handle); found != handles_.end()) {
-    found->second.pending_collection = true;
-  }
+  handles_.Visit(handle, [](LiveHandle& live_handle) {
+    live_handle.pending_collection = true;
+  });
 }
 
 bool ReactorGLES::React() {
   if (!CanReactOnCurrentThread()) {
+    if (CanPerformResourceOperationsOnCurrentThread()) {
+      return ReactResources();
+    }
     return false;
   }
   TRACE_EVENT0("impeller", "ReactorGLES::React");
+  ScopedReactionStateCache state_cache(*this);
   while (HasPendingOperations()) {
     if (!ReactOnce()) {
       return false;
@@ -165,6 +270,56 @@ bool ReactorGLES::React() {
   return true;
 }
 
+bool ReactorGLES::ReactResources() {
+  if (!IsValid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "ReactorGLES::ReactResources");
+  decltype(resource_ops_) ops;
+  {
+    std::scoped_lock lock(resource_ops_mutex_);
+    if (resource_ops_.empty()) {
+      return true;
+    }
+    std::swap(resource_ops_, ops);
+    ++resource_reactions_in_flight_;
+  }
+
+  const auto& gl = GetProcTable();
+  GLsync fence = nullptr;
+  fml::ScopedCleanupClosure signal_reaction([&]() {
+    {
+      std::scoped_lock lock(resource_ops_mutex_);
+      if (fence) {
+        resource_fences_.push_back(fence);
+      }
+      --resource_reactions_in_flight_;
+    }
+    resource_ops_cv_.notify_all();
+  });
+
+  ScopedReactionStateCache state_cache(*this);
+  // Handles are collected by rendering reactions, after any operations that
+  // may still use them.
+  if (!ConsolidateHandles(/*shared_handles_only=*/true)) {
+    return false;
+  }
+  for (const auto& op : ops) {
+    TRACE_EVENT0("impeller", "ReactorGLES::ResourceOperation");
+    op(*this);
+  }
+
+  // Make the results visible to the rendering context. Without sync objects,
+  // wait for the commands to complete instead.
+  if (gl.FenceSync.IsAvailable()) {
+    fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl.Flush();
+  } else {
+    gl.Finish();
+  }
+  return true;
+}
+
 static DebugResourceType ToDebugResourceType(HandleType type) {
   switch (type) {
     case HandleType::kUnknown:
@@ -188,49 +343,101 @@ bool ReactorGLES::ReactOnce() {
     return false;
   }
   TRACE_EVENT0("impeller", __FUNCTION__);
-  return ConsolidateHandles() && FlushOps();
+  if (!ConsolidateHandles(/*shared_handles_only=*/false)) {
+    return false;
+  }
+  // Deleting objects unbinds them, and their names may be reused.
+  GetStateCache().Invalidate();
+  // Operations that use resources must not run ahead of the operations that
+  // create them, wherever those are performed.
+  if (!FlushResourceOps()) {
+    return false;
+  }
+  WaitForResourceReactions();
+  return FlushOps();
 }
 
-bool ReactorGLES::ConsolidateHandles() {
+bool ReactorGLES::ConsolidateHandles(bool shared_handles_only) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
-  WriterLock handles_lock(handles_mutex_);
-  std::vector<HandleGLES> handles_to_delete;
-  for (auto& handle : handles_) {
+  bool success = true;
+  // Returns whether to keep the handle.
+  handles_.ForEach([&](const HandleGLES& handle, LiveHandle& live_handle) {
+    if (!success) {
+      return true;
+    }
+    if (shared_handles_only && (live_handle.pending_collection ||
+                                !IsSharedHandleType(handle.type))) {
+      return true;
+    }
     // Collect dead handles.
-    if (handle.second.pending_collection) {
+    if (live_handle.pending_collection) {
       // This could be false if the handle was created and collected without
       // use. We still need to get rid of map entry.
-      if (handle.second.name.has_value()) {
-        CollectGLHandle(gl, handle.first.type, handle.second.name.value());
+      if (live_handle.name.has_value()) {
+        CollectGLHandle(gl, handle.type, live_handle.name.value());
       }
-      handles_to_delete.push_back(handle.first);
-      continue;
+      return false;
     }
     // Create live handles.
-    if (!handle.second.name.has_value()) {
-      auto gl_handle = CreateGLHandle(gl, handle.first.type);
+    if (!live_handle.name.has_value()) {
+      auto gl_handle = CreateGLHandle(gl, handle.type);
       if (!gl_handle) {
         VALIDATION_LOG << "Could not create GL handle.";
-        return false;
+        success = false;
+        return true;
       }
-      handle.second.name = gl_handle;
+      live_handle.name = gl_handle;
     }
     // Set pending debug labels.
-    if (handle.second.pending_debug_label.has_value()) {
-      if (gl.SetDebugLabel(ToDebugResourceType(handle.first.type),
-                           handle.second.name.value(),
-                           handle.second.pending_debug_label.value())) {
-        handle.second.pending_debug_label = std::nullopt;
+    if (live_handle.pending_debug_label.has_value()) {
+      if (gl.SetDebugLabel(ToDebugResourceType(handle.type),
+                           live_handle.name.value(),
+                           live_handle.pending_debug_label.value())) {
+        live_handle.pending_debug_label = std::nullopt;
       }
     }
+    return true;
+  });
+  return success;
+}
+
+bool ReactorGLES::FlushResourceOps() {
+  decltype(resource_ops_) ops;
+  {
+    std::scoped_lock lock(resource_ops_mutex_);
+    if (resource_ops_.empty()) {
+      return true;
+    }
+    std::swap(resource_ops_, ops);
   }
-  for (const auto& handle_to_delete : handles_to_delete) {
-    handles_.erase(handle_to_delete);
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  for (const auto& op : ops) {
+    TRACE_EVENT0("impeller", "ReactorGLES::ResourceOperation");
+    op(*this);
   }
   return true;
 }
 
+void ReactorGLES::WaitForResourceReactions() {
+  decltype(resource_fences_) fences;
+  {
+    std::unique_lock lock(resource_ops_mutex_);
+    if (resource_reactions_in_flight_ > 0u) {
+      TRACE_EVENT0("impeller", "ReactorGLES::WaitForResourceReactions");
+      resource_ops_cv_.wait(
+          lock, [&]() { return resource_reactions_in_flight_ == 0u; });
+    }
+    std::swap(resource_fences_, fences);
+  }
+  const auto& gl = GetProcTable();
+  for (auto fence : fences) {
+    // Only makes the GPU wait for the fence, the calling thread doesn't block.
+    gl.WaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+    gl.DeleteSync(fence);
+  }
+}
+
 bool ReactorGLES::FlushOps() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   // Do NOT hold the ops or handles locks while performing operations in case
@@ -254,10 +461,9 @@ void ReactorGLES::SetDebugLabel(const HandleGLES& handle, std::string label) {
   if (handle.IsDead()) {
     return;
   }
-  WriterLock handles_lock(handles_mutex_);
-  if (auto found = handles_.find(handle); found != handles_.end()) {
-    found->second.pending_debug_label = std::move(label);
-  }
+  handles_.Visit(handle, [&label](LiveHandle& live_handle) {
+    live_handle.pending_debug_label = std::move(label);
+  });
 }
 
 bool ReactorGLES::CanReactOnCurrentThread() const {
@@ -279,4 +485,17 @@ bool ReactorGLES::CanReactOnCurrentThread() const {
   return false;
 }
 
+bool ReactorGLES::CanPerformResourceOperationsOnCurrentThread() const {
+  Lock lock(workers_mutex_);
+  for (const auto& worker : workers_) {
+    auto worker_ptr = worker.second.lock();
+    if (worker_ptr &&
+        worker_ptr->CanReactorPerformResourceOperationsOnCurrentThreadNow(
+            *this)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace impeller
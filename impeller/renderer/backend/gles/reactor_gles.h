@@ -4,15 +4,19 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/sharded_map.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 
 namespace impeller {
 
@@ -26,6 +30,18 @@ class ReactorGLES {
 
     virtual bool CanReactorReactOnCurrentThreadNow(
         const ReactorGLES& reactor) const = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Whether the context current on the calling thread shares
+    ///             objects with the context the reactor renders with and may
+    ///             be used to perform resource operations concurrently with
+    ///             rendering. Only resource operations are performed on such
+    ///             threads.
+    ///
+    virtual bool CanReactorPerformResourceOperationsOnCurrentThreadNow(
+        const ReactorGLES& reactor) const {
+      return false;
+    }
   };
 
   using Ref = std::shared_ptr<ReactorGLES>;
@@ -42,6 +58,14 @@ class ReactorGLES {
 
   const ProcTableGLES& GetProcTable() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The shadowed state of the context of the current thread. Only
+  ///             valid while operations are being performed. Operations that
+  ///             change the state tracked by the cache should do so through
+  ///             the cache.
+  ///
+  StateCacheGLES& GetStateCache() const;
+
   std::optional<GLuint> GetGLHandle(const HandleGLES& handle) const;
 
   HandleGLES CreateHandle(HandleType type);
@@ -53,6 +77,19 @@ class ReactorGLES {
   using Operation = std::function<void(const ReactorGLES& reactor)>;
   [[nodiscard]] bool AddOperation(Operation operation);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an operation that only creates or fills in objects that
+  ///             are shared between contexts, such as texture uploads and
+  ///             program compilation.
+  ///
+  ///             Resource operations may be performed on threads with shared
+  ///             contexts concurrently with rendering. Operations added with
+  ///             `AddOperation` are not performed until the resource
+  ///             operations before them are complete and their results are
+  ///             visible to the rendering context.
+  ///
+  [[nodiscard]] bool AddResourceOperation(Operation operation);
+
   [[nodiscard]] bool React();
 
  private:
@@ -74,14 +111,22 @@ class ReactorGLES {
   mutable Mutex ops_mutex_;
   std::vector<Operation> ops_ IPLR_GUARDED_BY(ops_mutex_);
 
-  // Make sure the container is one where erasing items during iteration doesn't
-  // invalidate other iterators.
-  using LiveHandles = std::unordered_map<HandleGLES,
-                                         LiveHandle,
-                                         HandleGLES::Hash,
-                                         HandleGLES::Equal>;
-  mutable RWMutex handles_mutex_;
-  LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // Guards the pending resource operations, the number of reactions
+  // performing them on resource threads and the fences those reactions
+  // signal.
+  mutable std::mutex resource_ops_mutex_;
+  std::condition_variable resource_ops_cv_;
+  std::vector<Operation> resource_ops_;
+  size_t resource_reactions_in_flight_ = 0u;
+  std::vector<GLsync> resource_fences_;
+
+  // Handles are looked up from the raster and IO threads while others are
+  // created, so the map is sharded to keep lookups from waiting on writers.
+  using LiveHandles = fml::ShardedMap<HandleGLES,
+                                      LiveHandle,
+                                      HandleGLES::Hash,
+                                      HandleGLES::Equal>;
+  LiveHandles handles_;
 
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
@@ -94,9 +139,19 @@ class ReactorGLES {
 
   bool HasPendingOperations() const;
 
+  bool HasPendingResourceOperations() const;
+
   bool CanReactOnCurrentThread() const;
 
-  bool ConsolidateHandles();
+  bool CanPerformResourceOperationsOnCurrentThread() const;
+
+  bool ReactResources();
+
+  bool ConsolidateHandles(bool shared_handles_only);
+
+  bool FlushResourceOps();
+
+  void WaitForResourceReactions();
 
   bool FlushOps();
 
@@ -11,6 +11,7 @@
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/gles/device_buffer_gles.h"
 #include "impeller/renderer/backend/gles/formats_gles.h"
+#include "impeller/renderer/backend/gles/gpu_tracer_gles.h"
 #include "impeller/renderer/backend/gles/pipeline_gles.h"
 #include "impeller/renderer/backend/gles/texture_gles.h"
 
@@ -36,21 +37,21 @@ void RenderPassGLES::OnSetLabel(std::string label) {
   label_ = std::move(label);
 }
 
-void ConfigureBlending(const ProcTableGLES& gl,
+void ConfigureBlending(StateCacheGLES& state,
                        const ColorAttachmentDescriptor* color) {
   if (!color->blending_enabled) {
-    gl.Disable(GL_BLEND);
+    state.SetEnabled(GL_BLEND, false);
     return;
   }
 
-  gl.Enable(GL_BLEND);
-  gl.BlendFuncSeparate(
+  state.SetEnabled(GL_BLEND, true);
+  state.BlendFuncSeparate(
       ToBlendFactor(color->src_color_blend_factor),  // src color
       ToBlendFactor(color->dst_color_blend_factor),  // dst color
       ToBlendFactor(color->src_alpha_blend_factor),  // src alpha
       ToBlendFactor(color->dst_alpha_blend_factor)   // dst alpha
   );
-  gl.BlendEquationSeparate(
+  state.BlendEquationSeparate(
       ToBlendOperation(color->color_blend_op),  // mode color
       ToBlendOperation(color->alpha_blend_op)   // mode alpha
   );
@@ -63,49 +64,49 @@ void ConfigureBlending(const ProcTableGLES& gl,
                  : GL_FALSE;
     };
 
-    gl.ColorMask(is_set(color->write_mask, ColorWriteMask::kRed),    // red
-                 is_set(color->write_mask, ColorWriteMask::kGreen),  // green
-                 is_set(color->write_mask, ColorWriteMask::kBlue),   // blue
-                 is_set(color->write_mask, ColorWriteMask::kAlpha)   // alpha
+    state.ColorMask(is_set(color->write_mask, ColorWriteMask::kRed),    // red
+                    is_set(color->write_mask, ColorWriteMask::kGreen),  // green
+                    is_set(color->write_mask, ColorWriteMask::kBlue),   // blue
+                    is_set(color->write_mask, ColorWriteMask::kAlpha)   // alpha
     );
   }
 }
 
 void ConfigureStencil(GLenum face,
-                      const ProcTableGLES& gl,
+                      StateCacheGLES& state,
                       const StencilAttachmentDescriptor& stencil,
                       uint32_t stencil_reference) {
-  gl.StencilOpSeparate(
+  state.StencilOpSeparate(
       face,                                    // face
       ToStencilOp(stencil.stencil_failure),    // stencil fail
       ToStencilOp(stencil.depth_failure),      // depth fail
       ToStencilOp(stencil.depth_stencil_pass)  // depth stencil pass
   );
-  gl.StencilFuncSeparate(face,                                        // face
-                         ToCompareFunction(stencil.stencil_compare),  // func
-                         stencil_reference,                           // ref
-                         stencil.read_mask                            // mask
+  state.StencilFuncSeparate(face,                                        // face
+                            ToCompareFunction(stencil.stencil_compare),  // func
+                            stencil_reference,                           // ref
+                            stencil.read_mask                            // mask
   );
-  gl.StencilMaskSeparate(face, stencil.write_mask);
+  state.StencilMaskSeparate(face, stencil.write_mask);
 }
 
-void ConfigureStencil(const ProcTableGLES& gl,
+void ConfigureStencil(StateCacheGLES& state,
                       const PipelineDescriptor& pipeline,
                       uint32_t stencil_reference) {
   if (!pipeline.HasStencilAttachmentDescriptors()) {
-    gl.Disable(GL_STENCIL_TEST);
+    state.SetEnabled(GL_STENCIL_TEST, false);
     return;
   }
 
-  gl.Enable(GL_STENCIL_TEST);
+  state.SetEnabled(GL_STENCIL_TEST, true);
   const auto& front = pipeline.GetFrontStencilAttachmentDescriptor();
   const auto& back = pipeline.GetBackStencilAttachmentDescriptor();
   if (front == back) {
-    ConfigureStencil(GL_FRONT_AND_BACK, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT_AND_BACK, state, *front, stencil_reference);
   } else if (front.has_value()) {
-    ConfigureStencil(GL_FRONT, gl, *front, stencil_reference);
+    ConfigureStencil(GL_FRONT, state, *front, stencil_reference);
   } else if (back.has_value()) {
-    ConfigureStencil(GL_BACK, gl, *back, stencil_reference);
+    ConfigureStencil(GL_BACK, state, *back, stencil_reference);
   } else {
     FML_UNREACHABLE();
   }
@@ -149,6 +150,7 @@ struct RenderPassData {
   }
 
   const auto& gl = reactor.GetProcTable();
+  auto& state = reactor.GetStateCache();
 
   fml::ScopedCleanupClosure pop_pass_debug_marker(
       [&gl]() { gl.PopDebugGroup(); });
@@ -222,14 +224,16 @@ struct RenderPassData {
     clear_bits |= GL_STENCIL_BUFFER_BIT;
   }
 
-  gl.Disable(GL_SCISSOR_TEST);
-  gl.Disable(GL_DEPTH_TEST);
-  gl.Disable(GL_STENCIL_TEST);
-  gl.Disable(GL_CULL_FACE);
-  gl.Disable(GL_BLEND);
-  gl.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.SetEnabled(GL_SCISSOR_TEST, false);
+  state.SetEnabled(GL_DEPTH_TEST, false);
+  state.SetEnabled(GL_STENCIL_TEST, false);
+  state.SetEnabled(GL_CULL_FACE, false);
+  state.SetEnabled(GL_BLEND, false);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 
-  gl.Clear(clear_bits);
+  if (clear_bits != 0u) {
+    gl.Clear(clear_bits);
+  }
 
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
@@ -263,12 +267,13 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    ConfigureBlending(state, color_attachment);
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    ConfigureStencil(state, pipeline.GetDescriptor(),
+                     command.stencil_reference);
 
     //--------------------------------------------------------------------------
     /// Configure depth.
@@ -276,11 +281,11 @@ struct RenderPassData {
     if (auto depth =
             pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
         depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      state.SetEnabled(GL_DEPTH_TEST, true);
+      state.DepthFunc(ToCompareFunction(depth->depth_compare));
+      state.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
     } else {
-      gl.Disable(GL_DEPTH_TEST);
+      state.SetEnabled(GL_DEPTH_TEST, false);
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -292,11 +297,11 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.origin.x,  // x
-                target_size.height - viewport.rect.origin.y -
-                    viewport.rect.size.height,  // y
-                viewport.rect.size.width,       // width
-                viewport.rect.size.height       // height
+    state.Viewport(viewport.rect.origin.x,  // x
+                   target_size.height - viewport.rect.origin.y -
+                       viewport.rect.size.height,  // y
+                   viewport.rect.size.width,       // width
+                   viewport.rect.size.height       // height
     );
     if (pass_data.depth_attachment) {
       gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
@@ -307,15 +312,15 @@ struct RenderPassData {
     ///
     if (command.scissor.has_value()) {
       const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
+      state.SetEnabled(GL_SCISSOR_TEST, true);
+      state.Scissor(
           scissor.origin.x,                                             // x
           target_size.height - scissor.origin.y - scissor.size.height,  // y
           scissor.size.width,                                           // width
           scissor.size.height  // height
       );
     } else {
-      gl.Disable(GL_SCISSOR_TEST);
+      state.SetEnabled(GL_SCISSOR_TEST, false);
     }
 
     //--------------------------------------------------------------------------
@@ -323,15 +328,15 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetCullMode()) {
       case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
+        state.SetEnabled(GL_CULL_FACE, false);
         break;
       case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_FRONT);
         break;
       case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
+        state.SetEnabled(GL_CULL_FACE, true);
+        state.CullFace(GL_BACK);
         break;
     }
     //--------------------------------------------------------------------------
@@ -339,10 +344,10 @@ struct RenderPassData {
     ///
     switch (pipeline.GetDescriptor().GetWindingOrder()) {
       case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
+        state.FrontFace(GL_CW);
         break;
       case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
+        state.FrontFace(GL_CCW);
         break;
     }
 
@@ -393,7 +398,7 @@ struct RenderPassData {
     /// Bind vertex attribs.
     ///
     if (!vertex_desc_gles->BindVertexAttributes(
-            gl, vertex_buffer_view.range.offset)) {
+            gl, state, vertex_buffer_view.range.offset)) {
       return false;
     }
 
@@ -401,6 +406,7 @@ struct RenderPassData {
     /// Bind uniform data.
     ///
     if (!vertex_desc_gles->BindUniformData(gl,                        //
+                                           state,                     //
                                            *transients_allocator,     //
                                            command.vertex_bindings,   //
                                            command.fragment_bindings  //
@@ -430,39 +436,37 @@ struct RenderPassData {
                         index_buffer_view.range.offset))  // indices
     );
 
-    //--------------------------------------------------------------------------
-    /// Unbind vertex attribs.
-    ///
-    if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
-      return false;
-    }
-
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
+    // The program and vertex attribute arrays are left bound for the next
+    // command, and reset by the reactor once it is done reacting.
   }
 
-  if (gl.DiscardFramebufferEXT.IsAvailable()) {
-    std::vector<GLenum> attachments;
-    if (pass_data.discard_color_attachment) {
-      attachments.push_back(is_default_fbo ? GL_COLOR_EXT
-                                           : GL_COLOR_ATTACHMENT0);
-    }
-    if (pass_data.discard_depth_attachment) {
-      attachments.push_back(is_default_fbo ? GL_DEPTH_EXT
-                                           : GL_DEPTH_ATTACHMENT);
-    }
-    if (pass_data.discard_stencil_attachment) {
-      attachments.push_back(is_default_fbo ? GL_STENCIL_EXT
-                                           : GL_STENCIL_ATTACHMENT);
+  // Tell the driver that the contents of the attachments that aren't stored
+  // are no longer needed, so tiled GPUs don't write them back to memory.
+  std::vector<GLenum> attachments;
+  if (pass_data.discard_color_attachment) {
+    attachments.push_back(is_default_fbo ? GL_COLOR_EXT : GL_COLOR_ATTACHMENT0);
+  }
+  if (pass_data.discard_depth_attachment && pass_data.depth_attachment) {
+    attachments.push_back(is_default_fbo ? GL_DEPTH_EXT : GL_DEPTH_ATTACHMENT);
+  }
+  if (pass_data.discard_stencil_attachment && pass_data.stencil_attachment) {
+    attachments.push_back(is_default_fbo ? GL_STENCIL_EXT
+                                         : GL_STENCIL_ATTACHMENT);
+  }
+  if (!attachments.empty()) {
+    // The default framebuffer attachment names of GLES 3 share their values
+    // with those of the extension.
+    if (gl.InvalidateFramebuffer.IsAvailable()) {
+      gl.InvalidateFramebuffer(GL_FRAMEBUFFER,      // target
+                               attachments.size(),  // attachments to discard
+                               attachments.data()   // attachments
+      );
+    } else if (gl.DiscardFramebufferEXT.IsAvailable()) {
+      gl.DiscardFramebufferEXT(GL_FRAMEBUFFER,      // target
+                               attachments.size(),  // attachments to discard
+                               attachments.data()   // attachments
+      );
     }
-    gl.DiscardFramebufferEXT(GL_FRAMEBUFFER,      // target
-                             attachments.size(),  // attachments to discard
-                             attachments.data()   // size
-    );
   }
 
   return true;
@@ -522,10 +526,18 @@ bool RenderPassGLES::OnEncodeCommands(const Context& context) const {
 
   return reactor_->AddOperation([pass_data,
                                  allocator = context.GetResourceAllocator(),
+                                 tracer = context.GetGPUTracer(),
                                  commands = commands_](const auto& reactor) {
+    const auto& gl = reactor.GetProcTable();
+    if (tracer) {
+      GPUTracerGLES::Cast(*tracer).BeginPass(gl, pass_data->label);
+    }
     auto result =
         EncodeCommandsInReactor(*pass_data, allocator, reactor, commands);
     FML_CHECK(result) << "Must be able to encode GL commands without error.";
+    if (tracer) {
+      GPUTracerGLES::Cast(*tracer).EndPass(gl);
+    }
   });
 }
 
@@ -16,12 +16,13 @@ SamplerLibraryGLES::~SamplerLibraryGLES() = default;
 
 // |SamplerLibrary|
 std::shared_ptr<const Sampler> SamplerLibraryGLES::GetSampler(
-    SamplerDescriptor descriptor) {
-  auto found = samplers_.find(descriptor);
+    const SamplerDescriptor& descriptor) {
+  const auto key = descriptor.ToKey();
+  auto found = samplers_.find(key);
   if (found != samplers_.end()) {
     return found->second;
   }
-  return samplers_[descriptor] =
+  return samplers_[key] =
              std::shared_ptr<SamplerGLES>(new SamplerGLES(descriptor));
 }
 
@@ -24,7 +24,7 @@ class SamplerLibraryGLES final : public SamplerLibrary {
 
   // |SamplerLibrary|
   std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) override;
+      const SamplerDescriptor& descriptor) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibraryGLES);
 };
@@ -0,0 +1,266 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace impeller {
+
+StateCacheGLES::StateCacheGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateCacheGLES::~StateCacheGLES() = default;
+
+void StateCacheGLES::Invalidate() {
+  capabilities_.clear();
+  program_.reset();
+  active_texture_.reset();
+  textures_.clear();
+  buffers_.clear();
+  blend_func_.reset();
+  blend_equation_.reset();
+  color_mask_.reset();
+  front_stencil_ = {};
+  back_stencil_ = {};
+  depth_func_.reset();
+  depth_mask_.reset();
+  cull_face_.reset();
+  front_face_.reset();
+  viewport_.reset();
+  scissor_.reset();
+  uniforms_.clear();
+}
+
+void StateCacheGLES::Reset() {
+  SetVertexAttribArraysEnabled({});
+  UseProgram(0u);
+}
+
+void StateCacheGLES::SetEnabled(GLenum capability, bool enabled) {
+  auto found = capabilities_.find(capability);
+  if (found != capabilities_.end() && found->second == enabled) {
+    return;
+  }
+  if (enabled) {
+    gl_.Enable(capability);
+  } else {
+    gl_.Disable(capability);
+  }
+  capabilities_[capability] = enabled;
+}
+
+void StateCacheGLES::UseProgram(GLuint program) {
+  if (program_ == program) {
+    return;
+  }
+  gl_.UseProgram(program);
+  program_ = program;
+}
+
+void StateCacheGLES::ActiveTexture(GLenum unit) {
+  if (active_texture_ == unit) {
+    return;
+  }
+  gl_.ActiveTexture(unit);
+  active_texture_ = unit;
+}
+
+void StateCacheGLES::BindTexture(GLenum target, GLuint texture) {
+  if (!active_texture_.has_value()) {
+    // The binding can't be attributed to a unit.
+    gl_.BindTexture(target, texture);
+    return;
+  }
+  const auto key = std::make_pair(active_texture_.value(), target);
+  auto found = textures_.find(key);
+  if (found != textures_.end() && found->second == texture) {
+    return;
+  }
+  gl_.BindTexture(target, texture);
+  textures_[key] = texture;
+}
+
+void StateCacheGLES::BindBuffer(GLenum target, GLuint buffer) {
+  auto found = buffers_.find(target);
+  if (found != buffers_.end() && found->second == buffer) {
+    return;
+  }
+  gl_.BindBuffer(target, buffer);
+  buffers_[target] = buffer;
+}
+
+void StateCacheGLES::BlendFuncSeparate(GLenum src_color,
+                                       GLenum dst_color,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  const std::array<GLenum, 4> func = {src_color, dst_color, src_alpha,
+                                      dst_alpha};
+  if (blend_func_ == func) {
+    return;
+  }
+  gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+  blend_func_ = func;
+}
+
+void StateCacheGLES::BlendEquationSeparate(GLenum mode_color,
+                                           GLenum mode_alpha) {
+  const auto equation = std::make_pair(mode_color, mode_alpha);
+  if (blend_equation_ == equation) {
+    return;
+  }
+  gl_.BlendEquationSeparate(mode_color, mode_alpha);
+  blend_equation_ = equation;
+}
+
+void StateCacheGLES::ColorMask(GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha) {
+  const std::array<GLboolean, 4> mask = {red, green, blue, alpha};
+  if (color_mask_ == mask) {
+    return;
+  }
+  gl_.ColorMask(red, green, blue, alpha);
+  color_mask_ = mask;
+}
+
+std::vector<StateCacheGLES::StencilState*> StateCacheGLES::GetStencilStates(
+    GLenum face) {
+  switch (face) {
+    case GL_FRONT:
+      return {&front_stencil_};
+    case GL_BACK:
+      return {&back_stencil_};
+    default:
+      return {&front_stencil_, &back_stencil_};
+  }
+}
+
+void StateCacheGLES::StencilOpSeparate(GLenum face,
+                                       GLenum stencil_fail,
+                                       GLenum depth_fail,
+                                       GLenum depth_stencil_pass) {
+  const auto op = std::make_tuple(stencil_fail, depth_fail, depth_stencil_pass);
+  const auto states = GetStencilStates(face);
+  if (std::all_of(states.begin(), states.end(),
+                  [&op](const auto* state) { return state->op == op; })) {
+    return;
+  }
+  gl_.StencilOpSeparate(face, stencil_fail, depth_fail, depth_stencil_pass);
+  for (auto* state : states) {
+    state->op = op;
+  }
+}
+
+void StateCacheGLES::StencilFuncSeparate(GLenum face,
+                                         GLenum func,
+                                         GLint ref,
+                                         GLuint mask) {
+  const auto value = std::make_tuple(func, ref, mask);
+  const auto states = GetStencilStates(face);
+  if (std::all_of(states.begin(), states.end(), [&value](const auto* state) {
+        return state->func == value;
+      })) {
+    return;
+  }
+  gl_.StencilFuncSeparate(face, func, ref, mask);
+  for (auto* state : states) {
+    state->func = value;
+  }
+}
+
+void StateCacheGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  const auto states = GetStencilStates(face);
+  if (std::all_of(states.begin(), states.end(),
+                  [mask](const auto* state) { return state->mask == mask; })) {
+    return;
+  }
+  gl_.StencilMaskSeparate(face, mask);
+  for (auto* state : states) {
+    state->mask = mask;
+  }
+}
+
+void StateCacheGLES::DepthFunc(GLenum func) {
+  if (depth_func_ == func) {
+    return;
+  }
+  gl_.DepthFunc(func);
+  depth_func_ = func;
+}
+
+void StateCacheGLES::DepthMask(GLboolean enabled) {
+  if (depth_mask_ == enabled) {
+    return;
+  }
+  gl_.DepthMask(enabled);
+  depth_mask_ = enabled;
+}
+
+void StateCacheGLES::CullFace(GLenum face) {
+  if (cull_face_ == face) {
+    return;
+  }
+  gl_.CullFace(face);
+  cull_face_ = face;
+}
+
+void StateCacheGLES::FrontFace(GLenum mode) {
+  if (front_face_ == mode) {
+    return;
+  }
+  gl_.FrontFace(mode);
+  front_face_ = mode;
+}
+
+void StateCacheGLES::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  const std::array<GLint, 4> viewport = {x, y, width, height};
+  if (viewport_ == viewport) {
+    return;
+  }
+  gl_.Viewport(x, y, width, height);
+  viewport_ = viewport;
+}
+
+void StateCacheGLES::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  const std::array<GLint, 4> scissor = {x, y, width, height};
+  if (scissor_ == scissor) {
+    return;
+  }
+  gl_.Scissor(x, y, width, height);
+  scissor_ = scissor;
+}
+
+void StateCacheGLES::SetVertexAttribArraysEnabled(
+    const std::vector<GLuint>& indices) {
+  for (auto index : enabled_vertex_attrib_arrays_) {
+    if (std::find(indices.begin(), indices.end(), index) == indices.end()) {
+      gl_.DisableVertexAttribArray(index);
+    }
+  }
+  for (auto index : indices) {
+    if (std::find(enabled_vertex_attrib_arrays_.begin(),
+                  enabled_vertex_attrib_arrays_.end(),
+                  index) == enabled_vertex_attrib_arrays_.end()) {
+      gl_.EnableVertexAttribArray(index);
+    }
+  }
+  enabled_vertex_attrib_arrays_ = indices;
+}
+
+bool StateCacheGLES::ShouldUploadUniform(GLuint program,
+                                         GLint location,
+                                         const void* data,
+                                         size_t length) {
+  auto& value = uniforms_[std::make_pair(program, location)];
+  if (value.size() == length && std::memcmp(value.data(), data, length) == 0) {
+    return false;
+  }
+  value.resize(length);
+  std::memcpy(value.data(), data, length);
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A shadow of the state of the current GL context that elides
+///             calls which would not change it.
+///
+///             The state of the context is only known while the reactor
+///             performs operations on a thread. Values that have not been set
+///             through the cache are unknown, and setting them always calls
+///             into GL. Code that changes the state with the proc table
+///             directly must invalidate the cache.
+///
+class StateCacheGLES {
+ public:
+  explicit StateCacheGLES(const ProcTableGLES& gl);
+
+  ~StateCacheGLES();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forgets all the state, so that the next call to set each
+  ///             value calls into GL.
+  ///
+  void Invalidate();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unbinds the program and disables the vertex attribute arrays
+  ///             enabled through the cache, which is the state the context is
+  ///             expected to be left in between reactions.
+  ///
+  void Reset();
+
+  void SetEnabled(GLenum capability, bool enabled);
+
+  void UseProgram(GLuint program);
+
+  void ActiveTexture(GLenum unit);
+
+  void BindTexture(GLenum target, GLuint texture);
+
+  void BindBuffer(GLenum target, GLuint buffer);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_color, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean enabled);
+
+  void CullFace(GLenum face);
+
+  void FrontFace(GLenum mode);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enables the vertex attribute arrays at the given indices and
+  ///             disables all the others that were enabled.
+  ///
+  void SetVertexAttribArraysEnabled(const std::vector<GLuint>& indices);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the uniform at the location of the program does not
+  ///             already hold the given value. If not, the value is recorded
+  ///             as the value of the uniform, and the caller must upload it.
+  ///
+  bool ShouldUploadUniform(GLuint program,
+                           GLint location,
+                           const void* data,
+                           size_t length);
+
+ private:
+  struct StencilState {
+    std::optional<std::tuple<GLenum, GLenum, GLenum>> op;
+    std::optional<std::tuple<GLenum, GLint, GLuint>> func;
+    std::optional<GLuint> mask;
+  };
+
+  const ProcTableGLES& gl_;
+  std::map<GLenum, bool> capabilities_;
+  std::optional<GLuint> program_;
+  std::optional<GLenum> active_texture_;
+  // Keyed by the texture unit and then the target.
+  std::map<std::pair<GLenum, GLenum>, GLuint> textures_;
+  std::map<GLenum, GLuint> buffers_;
+  std::optional<std::array<GLenum, 4>> blend_func_;
+  std::optional<std::pair<GLenum, GLenum>> blend_equation_;
+  std::optional<std::array<GLboolean, 4>> color_mask_;
+  StencilState front_stencil_;
+  StencilState back_stencil_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<std::array<GLint, 4>> viewport_;
+  std::optional<std::array<GLint, 4>> scissor_;
+  // Vertex attribute arrays are left disabled between reactions, so unlike
+  // the other state, these are known.
+  std::vector<GLuint> enabled_vertex_attrib_arrays_;
+  std::map<std::pair<GLuint, GLint>, std::vector<uint8_t>> uniforms_;
+
+  std::vector<StencilState*> GetStencilStates(GLenum face);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StateCacheGLES);
+};
+
+}  // namespace impeller
@@ -86,10 +86,26 @@ void TextureGLES::SetLabel(std::string_view label) {
   reactor_->SetDebugLabel(handle_, std::string{label.data(), label.size()});
 }
 
+static std::optional<GLenum> ToCompressedInternalFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+      return GL_COMPRESSED_RGBA8_ETC2_EAC;
+    case PixelFormat::kASTC4x4UNormBlock:
+      return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+    case PixelFormat::kBC3UNormBlock:
+      return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    default:
+      return std::nullopt;
+  }
+}
+
 struct TexImage2DData {
   GLint internal_format = 0;
   GLenum external_format = GL_NONE;
   GLenum type = GL_NONE;
+  // Compressed data is uploaded with glCompressedTexImage2D and only has an
+  // internal format.
+  bool is_compressed = false;
   std::shared_ptr<const fml::Mapping> data;
 
   explicit TexImage2DData(PixelFormat pixel_format) {
@@ -125,6 +141,10 @@ struct TexImage2DData {
       case PixelFormat::kB10G10R10XRSRGB:
       case PixelFormat::kB10G10R10XR:
       case PixelFormat::kB10G10R10A10XR:
+      // Compressed textures can't be initialized without their contents.
+      case PixelFormat::kETC2R8G8B8A8UNormBlock:
+      case PixelFormat::kASTC4x4UNormBlock:
+      case PixelFormat::kBC3UNormBlock:
         return;
     }
     is_valid_ = true;
@@ -163,6 +183,14 @@ struct TexImage2DData {
         data = std::move(mapping);
         break;
       }
+      case PixelFormat::kETC2R8G8B8A8UNormBlock:
+      case PixelFormat::kASTC4x4UNormBlock:
+      case PixelFormat::kBC3UNormBlock: {
+        internal_format = ToCompressedInternalFormat(pixel_format).value();
+        is_compressed = true;
+        data = std::move(mapping);
+        break;
+      }
       case PixelFormat::kR8G8B8A8UNormIntSRGB:
       case PixelFormat::kB8G8R8A8UNormInt:
       case PixelFormat::kB8G8R8A8UNormIntSRGB:
@@ -255,11 +283,13 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     return false;
   }
 
-  ReactorGLES::Operation texture_upload = [handle = handle_,            //
-                                           data,                        //
-                                           size = tex_descriptor.size,  //
-                                           texture_type,                //
-                                           texture_target               //
+  ReactorGLES::Operation texture_upload =
+      [handle = handle_,                                         //
+       data,                                                     //
+       size = tex_descriptor.size,                               //
+       image_size = tex_descriptor.GetByteSizeOfBaseMipLevel(),  //
+       texture_type,                                             //
+       texture_target                                            //
   ](const auto& reactor) {
     auto gl_handle = reactor.GetGLHandle(handle);
     if (!gl_handle.has_value()) {
@@ -268,13 +298,25 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
       return;
     }
     const auto& gl = reactor.GetProcTable();
-    gl.BindTexture(texture_type, gl_handle.value());
+    reactor.GetStateCache().BindTexture(texture_type, gl_handle.value());
     const GLvoid* tex_data = nullptr;
     if (data->data) {
       tex_data = data->data->GetMapping();
     }
 
-    {
+    if (data->is_compressed) {
+      TRACE_EVENT1("impeller", "CompressedTexImage2DUpload", "Bytes",
+                   std::to_string(data->data->GetSize()).c_str());
+      gl.CompressedTexImage2D(texture_target,         // target
+                              0u,                     // LOD level
+                              data->internal_format,  // internal format
+                              size.width,             // width
+                              size.height,            // height
+                              0u,                     // border
+                              image_size,             // image size
+                              tex_data                // data
+      );
+    } else {
       TRACE_EVENT1("impeller", "TexImage2DUpload", "Bytes",
                    std::to_string(data->data->GetSize()).c_str());
       gl.TexImage2D(texture_target,         // target
@@ -290,7 +332,7 @@ bool TextureGLES::OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
     }
   };
 
-  contents_initialized_ = reactor_->AddOperation(texture_upload);
+  contents_initialized_ = reactor_->AddResourceOperation(texture_upload);
   return contents_initialized_;
 }
 
@@ -321,6 +363,9 @@ static std::optional<GLenum> ToRenderBufferFormat(PixelFormat format) {
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+    case PixelFormat::kASTC4x4UNormBlock:
+    case PixelFormat::kBC3UNormBlock:
       return std::nullopt;
   }
   FML_UNREACHABLE();
@@ -359,7 +404,7 @@ void TextureGLES::InitializeContentsIfNecessary() const {
         VALIDATION_LOG << "Invalid format for texture image.";
         return;
       }
-      gl.BindTexture(GL_TEXTURE_2D, handle.value());
+      reactor_->GetStateCache().BindTexture(GL_TEXTURE_2D, handle.value());
       {
         TRACE_EVENT0("impeller", "TexImage2DInitialization");
         gl.TexImage2D(GL_TEXTURE_2D,  // target
@@ -415,7 +460,7 @@ bool TextureGLES::Bind() const {
         VALIDATION_LOG << "Could not bind texture of this type.";
         return false;
       }
-      gl.BindTexture(target.value(), handle.value());
+      reactor_->GetStateCache().BindTexture(target.value(), handle.value());
     } break;
     case Type::kRenderBuffer:
       gl.BindRenderbuffer(GL_RENDERBUFFER, handle.value());
@@ -456,6 +501,49 @@ bool TextureGLES::GenerateMipmaps() const {
   return true;
 }
 
+bool TextureGLES::SetContentsOfRegion(const uint8_t* contents,
+                                      IRect region) const {
+  if (type_ != Type::kTexture ||
+      GetTextureDescriptor().type != TextureType::kTexture2D) {
+    VALIDATION_LOG << "Only the contents of 2D textures can be updated.";
+    return false;
+  }
+  if (is_wrapped_) {
+    VALIDATION_LOG << "Cannot set the contents of a wrapped texture.";
+    return false;
+  }
+
+  TexImage2DData data(GetTextureDescriptor().format);
+  if (!data.IsValid()) {
+    VALIDATION_LOG << "Invalid texture format.";
+    return false;
+  }
+
+  // Binding allocates the storage of the texture if it wasn't uploaded yet.
+  if (!Bind()) {
+    return false;
+  }
+
+  const auto& gl = reactor_->GetProcTable();
+  // Rows of single channel pixels are not 4 byte aligned.
+  gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  {
+    TRACE_EVENT0("impeller", "TexSubImage2DUpload");
+    gl.TexSubImage2D(GL_TEXTURE_2D,          // target
+                     0u,                     // LOD level
+                     region.origin.x,        // x offset
+                     region.origin.y,        // y offset
+                     region.size.width,      // width
+                     region.size.height,     // height
+                     data.external_format,   // external format
+                     data.type,              // type
+                     contents                // data
+    );
+  }
+  gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  return true;
+}
+
 TextureGLES::Type TextureGLES::GetType() const {
   return type_;
 }
@@ -6,6 +6,7 @@
 
 #include "flutter/fml/macros.h"
 #include "impeller/base/backend_cast.h"
+#include "impeller/geometry/rect.h"
 #include "impeller/renderer/backend/gles/handle_gles.h"
 #include "impeller/renderer/backend/gles/reactor_gles.h"
 #include "impeller/renderer/texture.h"
@@ -39,6 +40,14 @@ class TextureGLES final : public Texture,
 
   [[nodiscard]] bool GenerateMipmaps() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Overwrites a region of the base mip level of the texture
+  ///             with tightly packed pixels. Unlike `SetContents`, this must
+  ///             be called on the reactor thread.
+  ///
+  [[nodiscard]] bool SetContentsOfRegion(const uint8_t* contents,
+                                         IRect region) const;
+
   enum class AttachmentPoint {
     kColor0,
     kDepth,
@@ -7,6 +7,7 @@
 #include <Metal/Metal.h>
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/allocator.h"
 
 namespace impeller {
@@ -27,9 +28,17 @@ class AllocatorMTL final : public Allocator {
   bool supports_uma_ = false;
   bool is_valid_ = false;
   ISize max_texture_supported_;
+  // Offscreen render targets are sub-allocated from this heap, and the
+  // memory of those that are no longer referenced is aliased by later ones.
+  Mutex transient_heap_mutex_;
+  id<MTLHeap> transient_heap_ IPLR_GUARDED_BY(transient_heap_mutex_) =
+      nullptr;
 
   AllocatorMTL(id<MTLDevice> device, std::string label);
 
+  id<MTLTexture> CreateTextureInTransientHeap(
+      MTLTextureDescriptor* texture_desc);
+
   // |Allocator|
   bool IsValid() const;
 
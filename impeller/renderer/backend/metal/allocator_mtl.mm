@@ -6,6 +6,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
+#include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/metal/device_buffer_mtl.h"
 #include "impeller/renderer/backend/metal/formats_mtl.h"
@@ -78,6 +79,10 @@ static ISize DeviceMaxTextureSizeSupported(id<MTLDevice> device) {
   }
 }
 
+// Large enough to hold a few full screen offscreens with their MSAA
+// attachments on most devices.
+static constexpr size_t kTransientHeapSize = 64u * 1024u * 1024u;
+
 AllocatorMTL::AllocatorMTL(id<MTLDevice> device, std::string label)
     : device_(device), allocator_label_(std::move(label)) {
   if (!device_) {
@@ -194,13 +199,55 @@ std::shared_ptr<Texture> AllocatorMTL::OnCreateTexture(
 
   mtl_texture_desc.storageMode = ToMTLStorageMode(
       desc.storage_mode, supports_memoryless_targets_, supports_uma_);
-  auto texture = [device_ newTextureWithDescriptor:mtl_texture_desc];
+
+  id<MTLTexture> texture = nullptr;
+  if (desc.storage_mode == StorageMode::kDevicePrivate &&
+      (desc.usage &
+       static_cast<TextureUsageMask>(TextureUsage::kRenderTarget))) {
+    texture = CreateTextureInTransientHeap(mtl_texture_desc);
+  }
+  if (!texture) {
+    texture = [device_ newTextureWithDescriptor:mtl_texture_desc];
+  }
   if (!texture) {
     return nullptr;
   }
   return std::make_shared<TextureMTL>(desc, texture);
 }
 
+id<MTLTexture> AllocatorMTL::CreateTextureInTransientHeap(
+    MTLTextureDescriptor* texture_desc) {
+  if (@available(ios 13.0, tvos 13.0, macos 10.15, *)) {
+    Lock lock(transient_heap_mutex_);
+    if (!transient_heap_) {
+      auto heap_desc = [[MTLHeapDescriptor alloc] init];
+      heap_desc.type = MTLHeapTypeAutomatic;
+      heap_desc.storageMode = MTLStorageModePrivate;
+      heap_desc.size = kTransientHeapSize;
+      // Hazards between resources that alias each other are tracked for the
+      // whole heap, so textures released while the GPU still uses them can
+      // be aliased safely.
+      heap_desc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+      transient_heap_ = [device_ newHeapWithDescriptor:heap_desc];
+      if (!transient_heap_) {
+        return nullptr;
+      }
+      [transient_heap_
+          setLabel:@(SPrintF("%s Transient Heap", allocator_label_.c_str())
+                         .c_str())];
+    }
+    const auto size_and_align =
+        [device_ heapTextureSizeAndAlignWithDescriptor:texture_desc];
+    if ([transient_heap_ maxAvailableSizeWithAlignment:size_and_align.align] <
+        size_and_align.size) {
+      // Allocate the texture on its own instead of growing the heap.
+      return nullptr;
+    }
+    return [transient_heap_ newTextureWithDescriptor:texture_desc];
+  }
+  return nullptr;
+}
+
 uint16_t AllocatorMTL::MinimumBytesPerRow(PixelFormat format) const {
   return static_cast<uint16_t>([device_
       minimumLinearTextureAlignmentForPixelFormat:ToMTLPixelFormat(format)]);
@@ -94,6 +94,48 @@ bool BlitCopyTextureToBufferCommandMTL::Encode(
   return true;
 };
 
+BlitCopyBufferToTextureCommandMTL::~BlitCopyBufferToTextureCommandMTL() =
+    default;
+
+std::string BlitCopyBufferToTextureCommandMTL::GetLabel() const {
+  return label;
+}
+
+bool BlitCopyBufferToTextureCommandMTL::Encode(
+    id<MTLBlitCommandEncoder> encoder) const {
+  auto source_mtl = DeviceBufferMTL::Cast(*source).GetMTLBuffer();
+  if (!source_mtl) {
+    return false;
+  }
+
+  auto destination_mtl = TextureMTL::Cast(*destination).GetMTLTexture();
+  if (!destination_mtl) {
+    return false;
+  }
+
+  auto destination_origin_mtl = MTLOriginMake(destination_region.origin.x,
+                                              destination_region.origin.y, 0);
+  auto source_size_mtl = MTLSizeMake(destination_region.size.width,
+                                     destination_region.size.height, 1);
+
+  auto source_bytes_per_pixel =
+      BytesPerPixelForPixelFormat(destination->GetTextureDescriptor().format);
+  auto source_bytes_per_row = source_size_mtl.width * source_bytes_per_pixel;
+  auto source_bytes_per_image = source_size_mtl.height * source_bytes_per_row;
+
+  [encoder copyFromBuffer:source_mtl
+             sourceOffset:source_offset
+        sourceBytesPerRow:source_bytes_per_row
+      sourceBytesPerImage:source_bytes_per_image
+               sourceSize:source_size_mtl
+                toTexture:destination_mtl
+         destinationSlice:0
+         destinationLevel:0
+        destinationOrigin:destination_origin_mtl];
+
+  return true;
+};
+
 BlitGenerateMipmapCommandMTL::~BlitGenerateMipmapCommandMTL() = default;
 
 std::string BlitGenerateMipmapCommandMTL::GetLabel() const {
@@ -4,9 +4,13 @@
 
 #include "impeller/renderer/backend/metal/command_buffer_mtl.h"
 
+#include "flutter/fml/trace_event.h"
+
 #include "impeller/renderer/backend/metal/blit_pass_mtl.h"
 #include "impeller/renderer/backend/metal/compute_pass_mtl.h"
 #include "impeller/renderer/backend/metal/render_pass_mtl.h"
+#include "impeller/renderer/context.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
@@ -151,7 +155,32 @@ static CommandBuffer::Status ToCommitResult(MTLCommandBufferStatus status) {
   return CommandBufferMTL::Status::kError;
 }
 
+// Reports the time the GPU spent executing the command buffer to the tracer of
+// the context. Metal doesn't expose timestamps for individual encoders on all
+// devices, so the work is timed per command buffer.
+static void AddGPUTimingHandler(id<MTLCommandBuffer> buffer,
+                                const std::weak_ptr<const Context>& context) {
+  auto strong_context = context.lock();
+  auto tracer = strong_context ? strong_context->GetGPUTracer() : nullptr;
+  if (!tracer || !tracer->IsTimingEnabled()) {
+    return;
+  }
+  if (@available(ios 10.3, macos 10.15, *)) {
+    const auto frame_number = tracer->BeginTimedWork();
+    std::string label = buffer.label ? buffer.label.UTF8String : "";
+    [buffer addCompletedHandler:^(id<MTLCommandBuffer> completed_buffer) {
+      std::optional<fml::TimeDelta> duration;
+      if (completed_buffer.status == MTLCommandBufferStatusCompleted) {
+        duration = fml::TimeDelta::FromSecondsF(completed_buffer.GPUEndTime -
+                                                completed_buffer.GPUStartTime);
+      }
+      tracer->EndTimedWork(frame_number, label, duration);
+    }];
+  }
+}
+
 bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
+  AddGPUTimingHandler(buffer_, context_);
   if (callback) {
     [buffer_
         addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
@@ -169,6 +198,43 @@ bool CommandBufferMTL::OnSubmitCommands(CompletionCallback callback) {
   return true;
 }
 
+bool CommandBufferMTL::OnSubmitCommandsAsync(
+    std::shared_ptr<RenderPass> render_pass) {
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  auto work_queue = context->GetWorkQueue();
+  if (!work_queue) {
+    return CommandBuffer::OnSubmitCommandsAsync(std::move(render_pass));
+  }
+
+  // The host buffers of the pass are still written to on this thread.
+  if (!render_pass->BindDeviceBuffers()) {
+    return false;
+  }
+
+  AddGPUTimingHandler(buffer_, context_);
+
+  // Reserve the place of the buffer in the queue, so that the command buffers
+  // submitted after this one execute after it even if they are committed
+  // first.
+  [buffer_ enqueue];
+  id<MTLCommandBuffer> buffer = buffer_;
+  buffer_ = nil;
+
+  work_queue->PostTask([render_pass = std::move(render_pass), buffer]() {
+    TRACE_EVENT0("impeller", "CommandBufferMTL::EncodeCommandsAsync");
+    if (!render_pass->EncodeCommands()) {
+      VALIDATION_LOG << "Could not encode the render pass.";
+    }
+    // The buffer must be committed regardless, since the command buffers
+    // enqueued after it wait for it.
+    [buffer commit];
+  });
+  return true;
+}
+
 std::shared_ptr<RenderPass> CommandBufferMTL::OnCreateRenderPass(
     RenderTarget target) {
   if (!buffer_) {
@@ -5,6 +5,7 @@
 #include "impeller/renderer/backend/metal/compute_pass_mtl.h"
 
 #include <Metal/Metal.h>
+#include <algorithm>
 #include <memory>
 #include <variant>
 
@@ -245,18 +246,24 @@ bool ComputePassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     // sizes.
     // https://github.com/flutter/flutter/issues/110619
 
-    // For now, check that the sizes are uniform.
-    FML_DCHECK(grid_size == thread_group_size);
-    auto width = grid_size.width;
-    auto height = grid_size.height;
+    // For now, enough whole threadgroups are dispatched to cover the grid, and
+    // shaders are expected to discard the invocations outside of it.
+    auto width = std::max<int64_t>(thread_group_size.width, 1);
+    auto height = std::max<int64_t>(thread_group_size.height, 1);
     while (width * height >
            static_cast<int64_t>(
                pass_bindings.GetPipeline().maxTotalThreadsPerThreadgroup)) {
-      width /= 2;
-      height /= 2;
+      if (width >= height) {
+        width /= 2;
+      } else {
+        height /= 2;
+      }
     }
-    auto size = MTLSizeMake(width, height, 1);
-    [encoder dispatchThreadgroups:size threadsPerThreadgroup:size];
+    auto thread_groups =
+        MTLSizeMake((grid_size.width + width - 1) / width,
+                    (grid_size.height + height - 1) / height, 1);
+    [encoder dispatchThreadgroups:thread_groups
+            threadsPerThreadgroup:MTLSizeMake(width, height, 1)];
   }
 
   return true;
@@ -53,6 +53,10 @@ class ContextMTL final : public Context,
 
   bool SupportsFramebufferFetch() const;
 
+  bool SupportsInstancedRendering() const;
+
+  std::vector<PixelFormat> GetSupportedCompressedFormats() const;
+
   // |Context|
   bool IsValid() const override;
 
@@ -108,12 +108,23 @@ ContextMTL::ContextMTL(id<MTLDevice> device,
             .SetDefaultColorFormat(PixelFormat::kB8G8R8A8UNormInt)
             .SetDefaultStencilFormat(PixelFormat::kS8UInt)
             .SetSupportsCompute(true, supports_subgroups)
+            .SetSupportsInstancedRendering(SupportsInstancedRendering())
+            .SetSupportedCompressedFormats(GetSupportedCompressedFormats())
             .Build();
   }
 
   is_valid_ = true;
 }
 
+bool ContextMTL::SupportsInstancedRendering() const {
+  // The iOS simulator can't draw more than one instance at a time.
+#if FML_OS_IOS_SIMULATOR
+  return false;
+#else
+  return true;
+#endif  // FML_OS_IOS_SIMULATOR
+}
+
 bool ContextMTL::SupportsFramebufferFetch() const {
   // The iOS simulator lies about supporting framebuffer fetch.
 #if FML_OS_IOS_SIMULATOR
@@ -133,6 +144,25 @@ bool ContextMTL::SupportsFramebufferFetch() const {
 #endif  // FML_OS_IOS
 }
 
+std::vector<PixelFormat> ContextMTL::GetSupportedCompressedFormats() const {
+  std::vector<PixelFormat> formats;
+  // ETC2 and ASTC are supported by all Apple GPUs, and BC by the Mac GPUs.
+  // Refer to the "Texture capabilities" in the table below:
+  // https://developer.apple.com/metal/Metal-Feature-Set-Tables.pdf
+  if (@available(macOS 11.0, iOS 13, tvOS 13, *)) {
+    if ([device_ supportsFamily:MTLGPUFamilyApple2]) {
+      formats.push_back(PixelFormat::kETC2R8G8B8A8UNormBlock);
+      formats.push_back(PixelFormat::kASTC4x4UNormBlock);
+    }
+  }
+  if (@available(macOS 11.0, iOS 16.4, *)) {
+    if (device_.supportsBCTextureCompression) {
+      formats.push_back(PixelFormat::kBC3UNormBlock);
+    }
+  }
+  return formats;
+}
+
 static NSArray<id<MTLLibrary>>* MTLShaderLibraryFromFilePaths(
     id<MTLDevice> device,
     const std::vector<std::string>& libraries_paths) {
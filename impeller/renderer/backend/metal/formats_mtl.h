@@ -43,6 +43,12 @@ constexpr PixelFormat FromMTLPixelFormat(MTLPixelFormat format) {
       return PixelFormat::kB10G10R10XR;
     case MTLPixelFormatBGRA10_XR:
       return PixelFormat::kB10G10R10A10XR;
+    case MTLPixelFormatEAC_RGBA8:
+      return PixelFormat::kETC2R8G8B8A8UNormBlock;
+    case MTLPixelFormatASTC_4x4_LDR:
+      return PixelFormat::kASTC4x4UNormBlock;
+    case MTLPixelFormatBC3_RGBA:
+      return PixelFormat::kBC3UNormBlock;
     default:
       return PixelFormat::kUnknown;
   }
@@ -62,6 +68,19 @@ MTLPixelFormat SafeMTLPixelFormatBGR10_XR();
 /// Returns PixelFormat::kUnknown if MTLPixelFormatBGR10_XR isn't supported.
 MTLPixelFormat SafeMTLPixelFormatBGRA10_XR();
 
+/// Safe accessor for MTLPixelFormatEAC_RGBA8.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatEAC_RGBA8 isn't supported.
+MTLPixelFormat SafeMTLPixelFormatEAC_RGBA8();
+
+/// Safe accessor for MTLPixelFormatASTC_4x4_LDR.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatASTC_4x4_LDR isn't
+/// supported.
+MTLPixelFormat SafeMTLPixelFormatASTC_4x4_LDR();
+
+/// Safe accessor for MTLPixelFormatBC3_RGBA.
+/// Returns PixelFormat::kUnknown if MTLPixelFormatBC3_RGBA isn't supported.
+MTLPixelFormat SafeMTLPixelFormatBC3_RGBA();
+
 constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
@@ -94,6 +113,12 @@ constexpr MTLPixelFormat ToMTLPixelFormat(PixelFormat format) {
       return SafeMTLPixelFormatBGR10_XR();
     case PixelFormat::kB10G10R10A10XR:
       return SafeMTLPixelFormatBGRA10_XR();
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+      return SafeMTLPixelFormatEAC_RGBA8();
+    case PixelFormat::kASTC4x4UNormBlock:
+      return SafeMTLPixelFormatASTC_4x4_LDR();
+    case PixelFormat::kBC3UNormBlock:
+      return SafeMTLPixelFormatBC3_RGBA();
   }
   return MTLPixelFormatInvalid;
 };
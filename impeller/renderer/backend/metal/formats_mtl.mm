@@ -128,4 +128,28 @@ MTLPixelFormat SafeMTLPixelFormatBGRA10_XR() {
   }
 }
 
+MTLPixelFormat SafeMTLPixelFormatEAC_RGBA8() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatEAC_RGBA8;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
+MTLPixelFormat SafeMTLPixelFormatASTC_4x4_LDR() {
+  if (@available(iOS 8, macOS 11.0, *)) {
+    return MTLPixelFormatASTC_4x4_LDR;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
+MTLPixelFormat SafeMTLPixelFormatBC3_RGBA() {
+  if (@available(iOS 16.4, macOS 10.11, *)) {
+    return MTLPixelFormatBC3_RGBA;
+  } else {
+    return MTLPixelFormatInvalid;
+  }
+}
+
 }  // namespace impeller
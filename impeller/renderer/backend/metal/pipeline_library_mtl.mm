@@ -105,6 +105,7 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  RecordPipelineCompile();
   auto weak_this = weak_from_this();
 
   auto completion_handler =
@@ -166,6 +167,7 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryMTL::GetPipeline(
   auto pipeline_future = PipelineFuture<ComputePipelineDescriptor>{
       descriptor, promise->get_future()};
   compute_pipelines_[descriptor] = pipeline_future;
+  RecordPipelineCompile();
   auto weak_this = weak_from_this();
 
   auto completion_handler =
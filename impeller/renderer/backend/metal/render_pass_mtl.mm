@@ -332,6 +332,39 @@ struct PassBindingsCache {
     scissor_ = scissor;
   }
 
+  void SetFrontFacingWinding(MTLWinding winding) {
+    if (winding_.has_value() && winding_.value() == winding) {
+      return;
+    }
+    [encoder_ setFrontFacingWinding:winding];
+    winding_ = winding;
+  }
+
+  void SetCullMode(MTLCullMode cull_mode) {
+    if (cull_mode_.has_value() && cull_mode_.value() == cull_mode) {
+      return;
+    }
+    [encoder_ setCullMode:cull_mode];
+    cull_mode_ = cull_mode;
+  }
+
+  void SetTriangleFillMode(MTLTriangleFillMode fill_mode) {
+    if (fill_mode_.has_value() && fill_mode_.value() == fill_mode) {
+      return;
+    }
+    [encoder_ setTriangleFillMode:fill_mode];
+    fill_mode_ = fill_mode;
+  }
+
+  void SetStencilReferenceValue(uint32_t reference) {
+    if (stencil_reference_.has_value() &&
+        stencil_reference_.value() == reference) {
+      return;
+    }
+    [encoder_ setStencilReferenceValue:reference];
+    stencil_reference_ = reference;
+  }
+
  private:
   struct BufferOffsetPair {
     id<MTLBuffer> buffer = nullptr;
@@ -349,6 +382,10 @@ struct PassBindingsCache {
   std::map<ShaderStage, SamplerMap> samplers_;
   std::optional<Viewport> viewport_;
   std::optional<IRect> scissor_;
+  std::optional<MTLWinding> winding_;
+  std::optional<MTLCullMode> cull_mode_;
+  std::optional<MTLTriangleFillMode> fill_mode_;
+  std::optional<uint32_t> stencil_reference_;
 };
 
 static bool Bind(PassBindingsCache& pass,
@@ -463,14 +500,14 @@ bool RenderPassMTL::EncodeCommands(const std::shared_ptr<Allocator>& allocator,
     pass_bindings.SetScissor(
         command.scissor.value_or(IRect::MakeSize(GetRenderTargetSize())));
 
-    [encoder setFrontFacingWinding:pipeline_desc.GetWindingOrder() ==
-                                           WindingOrder::kClockwise
-                                       ? MTLWindingClockwise
-                                       : MTLWindingCounterClockwise];
-    [encoder setCullMode:ToMTLCullMode(pipeline_desc.GetCullMode())];
-    [encoder setTriangleFillMode:ToMTLTriangleFillMode(
-                                     pipeline_desc.GetPolygonMode())];
-    [encoder setStencilReferenceValue:command.stencil_reference];
+    pass_bindings.SetFrontFacingWinding(
+        pipeline_desc.GetWindingOrder() == WindingOrder::kClockwise
+            ? MTLWindingClockwise
+            : MTLWindingCounterClockwise);
+    pass_bindings.SetCullMode(ToMTLCullMode(pipeline_desc.GetCullMode()));
+    pass_bindings.SetTriangleFillMode(
+        ToMTLTriangleFillMode(pipeline_desc.GetPolygonMode()));
+    pass_bindings.SetStencilReferenceValue(command.stencil_reference);
 
     if (!bind_stage_resources(command.vertex_bindings, ShaderStage::kVertex)) {
       return false;
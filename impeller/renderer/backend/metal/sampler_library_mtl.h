@@ -33,7 +33,7 @@ class SamplerLibraryMTL final
 
   // |SamplerLibrary|
   std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) override;
+      const SamplerDescriptor& descriptor) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibraryMTL);
 };
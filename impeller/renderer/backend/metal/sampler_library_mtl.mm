@@ -14,8 +14,9 @@ SamplerLibraryMTL::SamplerLibraryMTL(id<MTLDevice> device) : device_(device) {}
 SamplerLibraryMTL::~SamplerLibraryMTL() = default;
 
 std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
-    SamplerDescriptor descriptor) {
-  auto found = samplers_.find(descriptor);
+    const SamplerDescriptor& descriptor) {
+  const auto key = descriptor.ToKey();
+  auto found = samplers_.find(key);
   if (found != samplers_.end()) {
     return found->second;
   }
@@ -43,7 +44,7 @@ std::shared_ptr<const Sampler> SamplerLibraryMTL::GetSampler(
   if (!sampler->IsValid()) {
     return nullptr;
   }
-  samplers_[descriptor] = sampler;
+  samplers_[key] = sampler;
   return sampler;
 }
 
@@ -33,7 +33,13 @@ std::shared_ptr<TextureMTL> TextureMTL::Wrapper(TextureDescriptor desc,
   return std::make_shared<TextureMTL>(desc, texture, true);
 }
 
-TextureMTL::~TextureMTL() = default;
+TextureMTL::~TextureMTL() {
+  // Let the allocator reuse the memory of textures sub-allocated from its
+  // heaps.
+  if (!is_wrapped_ && texture_.heap) {
+    [texture_ makeAliasable];
+  }
+}
 
 void TextureMTL::SetLabel(std::string_view label) {
   [texture_ setLabel:@(label.data())];
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
@@ -14,6 +15,89 @@
 
 namespace impeller {
 
+// The size of the memory blocks of the pools. Resources that are larger than
+// a block get dedicated memory of their own.
+static constexpr VkDeviceSize kPoolBlockSize = 16u * 1024u * 1024u;
+
+static constexpr vk::BufferUsageFlags kBufferUsage =
+    vk::BufferUsageFlagBits::eVertexBuffer |
+    vk::BufferUsageFlagBits::eIndexBuffer |
+    vk::BufferUsageFlagBits::eUniformBuffer |
+    vk::BufferUsageFlagBits::eTransferSrc |
+    vk::BufferUsageFlagBits::eTransferDst;
+
+static VmaPool CreatePool(VmaAllocator allocator, uint32_t memory_type_index) {
+  VmaPoolCreateInfo pool_info = {};
+  pool_info.memoryTypeIndex = memory_type_index;
+  pool_info.blockSize = kPoolBlockSize;
+  // Keep a block even when the pool is empty, which it is between frames
+  // when everything that was allocated for a frame was released.
+  pool_info.minBlockCount = 1u;
+
+  VmaPool pool = {};
+  if (::vmaCreatePool(allocator, &pool_info, &pool) != VK_SUCCESS) {
+    VALIDATION_LOG << "Could not create a memory pool.";
+    return {};
+  }
+  return pool;
+}
+
+static VmaPool CreateHostBufferPool(VmaAllocator allocator) {
+  vk::BufferCreateInfo buffer_info;
+  buffer_info.usage = kBufferUsage;
+  buffer_info.size = 1u;
+  buffer_info.sharingMode = vk::SharingMode::eExclusive;
+  auto buffer_info_native =
+      static_cast<vk::BufferCreateInfo::NativeType>(buffer_info);
+
+  VmaAllocationCreateInfo allocation_info = {};
+  allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
+  allocation_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  allocation_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+
+  uint32_t memory_type_index = 0;
+  if (::vmaFindMemoryTypeIndexForBufferInfo(allocator, &buffer_info_native,
+                                            &allocation_info,
+                                            &memory_type_index) != VK_SUCCESS) {
+    return {};
+  }
+  return CreatePool(allocator, memory_type_index);
+}
+
+static VmaPool CreateDevicePrivateImagePool(VmaAllocator allocator,
+                                            vk::ImageUsageFlags usage) {
+  // The memory types that images can be bound to mostly don't depend on
+  // their format. Images that the memory type of the pool doesn't work for
+  // are allocated without the pool.
+  vk::ImageCreateInfo image_info;
+  image_info.imageType = vk::ImageType::e2D;
+  image_info.format = vk::Format::eR8G8B8A8Unorm;
+  image_info.extent = VkExtent3D{1u, 1u, 1u};
+  image_info.samples = vk::SampleCountFlagBits::e1;
+  image_info.mipLevels = 1u;
+  image_info.arrayLayers = 1u;
+  image_info.tiling = vk::ImageTiling::eOptimal;
+  image_info.initialLayout = vk::ImageLayout::eUndefined;
+  image_info.usage = usage | vk::ImageUsageFlagBits::eTransferSrc |
+                     vk::ImageUsageFlagBits::eTransferDst;
+  image_info.sharingMode = vk::SharingMode::eExclusive;
+  auto image_info_native =
+      static_cast<vk::ImageCreateInfo::NativeType>(image_info);
+
+  VmaAllocationCreateInfo allocation_info = {};
+  allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
+  allocation_info.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+  uint32_t memory_type_index = 0;
+  if (::vmaFindMemoryTypeIndexForImageInfo(allocator, &image_info_native,
+                                           &allocation_info,
+                                           &memory_type_index) != VK_SUCCESS) {
+    return {};
+  }
+  return CreatePool(allocator, memory_type_index);
+}
+
 AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
                          uint32_t vulkan_api_version,
                          const vk::PhysicalDevice& physical_device,
@@ -89,15 +173,54 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
     return;
   }
   allocator_ = allocator;
+
+  // Resources are allocated without a pool if a pool can't be created.
+  host_buffer_pool_ = CreateHostBufferPool(allocator_);
+  render_target_pool_ = CreateDevicePrivateImagePool(
+      allocator_, vk::ImageUsageFlagBits::eColorAttachment |
+                      vk::ImageUsageFlagBits::eSampled);
+  texture_pool_ = CreateDevicePrivateImagePool(
+      allocator_, vk::ImageUsageFlagBits::eSampled);
+
   is_valid_ = true;
 }
 
 AllocatorVK::~AllocatorVK() {
   if (allocator_) {
+    for (auto pool : {host_buffer_pool_, render_target_pool_, texture_pool_}) {
+      if (pool) {
+        ::vmaDestroyPool(allocator_, pool);
+      }
+    }
     ::vmaDestroyAllocator(allocator_);
   }
 }
 
+void AllocatorVK::DidAcquireSurfaceFrame() {
+  if (!IsValid()) {
+    return;
+  }
+  frame_index_++;
+  ::vmaSetCurrentFrameIndex(allocator_, frame_index_);
+
+#if !FLUTTER_RELEASE
+  VmaBudget budgets[VK_MAX_MEMORY_HEAPS] = {};
+  ::vmaGetHeapBudgets(allocator_, budgets);
+  int64_t block_bytes = 0;
+  int64_t allocation_bytes = 0;
+  int64_t allocation_count = 0;
+  for (const auto& budget : budgets) {
+    block_bytes += budget.statistics.blockBytes;
+    allocation_bytes += budget.statistics.allocationBytes;
+    allocation_count += budget.statistics.allocationCount;
+  }
+  FML_TRACE_COUNTER("impeller", "AllocatorVK",
+                    reinterpret_cast<int64_t>(this), "BlockBytes",
+                    block_bytes, "AllocationBytes", allocation_bytes,
+                    "AllocationCount", allocation_count);
+#endif  // !FLUTTER_RELEASE
+}
+
 // |Allocator|
 bool AllocatorVK::IsValid() const {
   return is_valid_;
@@ -108,6 +231,17 @@ ISize AllocatorVK::GetMaxTextureSizeSupported() const {
   return max_texture_size_;
 }
 
+VmaPool AllocatorVK::GetTexturePool(const TextureDescriptor& desc) const {
+  if (desc.storage_mode != StorageMode::kDevicePrivate) {
+    return {};
+  }
+  if (desc.usage &
+      static_cast<TextureUsageMask>(TextureUsage::kRenderTarget)) {
+    return render_target_pool_;
+  }
+  return texture_pool_;
+}
+
 static constexpr vk::ImageUsageFlags ToVKImageUsageFlags(PixelFormat format,
                                                          TextureUsageMask usage,
                                                          StorageMode mode) {
@@ -185,7 +319,8 @@ static constexpr VkMemoryPropertyFlags ToVKMemoryPropertyFlags(
 }
 
 static VmaAllocationCreateFlags ToVmaAllocationCreateFlags(StorageMode mode,
-                                                           bool is_texture) {
+                                                           bool is_texture,
+                                                           bool is_pooled) {
   VmaAllocationCreateFlags flags = 0;
   switch (mode) {
     case StorageMode::kHostVisible:
@@ -197,7 +332,7 @@ static VmaAllocationCreateFlags ToVmaAllocationCreateFlags(StorageMode mode,
       }
       return flags;
     case StorageMode::kDevicePrivate:
-      if (is_texture) {
+      if (is_texture && !is_pooled) {
         flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
       }
       return flags;
@@ -211,6 +346,7 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
  public:
   AllocatedTextureSourceVK(const TextureDescriptor& desc,
                            VmaAllocator allocator,
+                           VmaPool pool,
                            vk::Device device) {
     vk::ImageCreateInfo image_info;
     image_info.imageType = vk::ImageType::e2D;
@@ -229,28 +365,34 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
         ToVKImageUsageFlags(desc.format, desc.usage, desc.storage_mode);
     image_info.sharingMode = vk::SharingMode::eExclusive;
 
-    VmaAllocationCreateInfo alloc_create_info = {};
-
-    alloc_create_info.usage = ToVMAMemoryUsage();
-    alloc_create_info.preferredFlags =
-        ToVKMemoryPropertyFlags(desc.storage_mode, true);
-    alloc_create_info.flags =
-        ToVmaAllocationCreateFlags(desc.storage_mode, true);
-
     auto create_info_native =
         static_cast<vk::ImageCreateInfo::NativeType>(image_info);
 
     VkImage vk_image = VK_NULL_HANDLE;
     VmaAllocation allocation = {};
     VmaAllocationInfo allocation_info = {};
+    auto create_image = [&](VmaPool pool) {
+      VmaAllocationCreateInfo alloc_create_info = {};
+      alloc_create_info.usage = ToVMAMemoryUsage();
+      alloc_create_info.preferredFlags =
+          ToVKMemoryPropertyFlags(desc.storage_mode, true);
+      alloc_create_info.flags = ToVmaAllocationCreateFlags(
+          desc.storage_mode, true, /*is_pooled=*/pool != VK_NULL_HANDLE);
+      alloc_create_info.pool = pool;
+      return vk::Result{vmaCreateImage(allocator,            //
+                                       &create_info_native,  //
+                                       &alloc_create_info,   //
+                                       &vk_image,            //
+                                       &allocation,          //
+                                       &allocation_info      //
+                                       )};
+    };
     {
-      auto result = vk::Result{vmaCreateImage(allocator,            //
-                                              &create_info_native,  //
-                                              &alloc_create_info,   //
-                                              &vk_image,            //
-                                              &allocation,          //
-                                              &allocation_info      //
-                                              )};
+      auto result = create_image(pool);
+      if (result != vk::Result::eSuccess && pool) {
+        // The memory type of the pool may not work for this image.
+        result = create_image(VK_NULL_HANDLE);
+      }
       if (result != vk::Result::eSuccess) {
         VALIDATION_LOG << "Unable to allocate Vulkan Image: "
                        << vk::to_string(result);
@@ -355,9 +497,11 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   if (!IsValid()) {
     return nullptr;
   }
-  auto source = std::make_shared<AllocatedTextureSourceVK>(desc,        //
-                                                           allocator_,  //
-                                                           device_      //
+  auto source = std::make_shared<AllocatedTextureSourceVK>(
+      desc,                 //
+      allocator_,           //
+      GetTexturePool(desc),  //
+      device_               //
   );
   if (!source->IsValid()) {
     return nullptr;
@@ -369,11 +513,7 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
 std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     const DeviceBufferDescriptor& desc) {
   vk::BufferCreateInfo buffer_info;
-  buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
-                      vk::BufferUsageFlagBits::eIndexBuffer |
-                      vk::BufferUsageFlagBits::eUniformBuffer |
-                      vk::BufferUsageFlagBits::eTransferSrc |
-                      vk::BufferUsageFlagBits::eTransferDst;
+  buffer_info.usage = kBufferUsage;
   buffer_info.size = desc.size;
   buffer_info.sharingMode = vk::SharingMode::eExclusive;
   auto buffer_info_native =
@@ -383,7 +523,13 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
   allocation_info.usage = ToVMAMemoryUsage();
   allocation_info.preferredFlags =
       ToVKMemoryPropertyFlags(desc.storage_mode, false);
-  allocation_info.flags = ToVmaAllocationCreateFlags(desc.storage_mode, false);
+  allocation_info.flags = ToVmaAllocationCreateFlags(
+      desc.storage_mode, false, /*is_pooled=*/false);
+  if (desc.storage_mode == StorageMode::kHostVisible) {
+    // All buffers have the same usage, so they can all be allocated from the
+    // memory type of the pool.
+    allocation_info.pool = host_buffer_pool_;
+  }
 
   VkBuffer buffer = {};
   VmaAllocation buffer_allocation = {};
@@ -21,11 +21,26 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   ~AllocatorVK() override;
 
+  /// @brief  Called at the start of every frame rendered to the surface, to
+  ///         age the allocations and to report their statistics.
+  void DidAcquireSurfaceFrame();
+
  private:
   friend class ContextVK;
 
   fml::RefPtr<vulkan::VulkanProcTable> vk_;
   VmaAllocator allocator_ = {};
+  // The resources that are created and released all the time are allocated
+  // from pools that keep their memory blocks around, rather than freeing
+  // memory to the driver and allocating it again in the next frame.
+  //
+  // Host visible buffers, which are mostly the transients buffers of frames.
+  VmaPool host_buffer_pool_ = {};
+  // Device private textures that are rendered to.
+  VmaPool render_target_pool_ = {};
+  // Device private textures that are only sampled, such as images.
+  VmaPool texture_pool_ = {};
+  uint32_t frame_index_ = 0u;
   std::weak_ptr<Context> context_;
   vk::Device device_;
   ISize max_texture_size_ = {4096, 4096};
@@ -53,6 +68,8 @@ class AllocatorVK final : public Allocator {
   // |Allocator|
   ISize GetMaxTextureSizeSupported() const override;
 
+  VmaPool GetTexturePool(const TextureDescriptor& desc) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AllocatorVK);
 };
 
@@ -26,6 +26,11 @@ bool BlitCopyTextureToTextureCommandVK::Encode(
     CommandEncoderVK& encoder) const {
   const auto& cmd_buffer = encoder.GetCommandBuffer();
 
+  // The command buffer completes asynchronously.
+  if (!encoder.Track(source) || !encoder.Track(destination)) {
+    return false;
+  }
+
   const auto& src = TextureVK::Cast(*source);
   const auto& dst = TextureVK::Cast(*destination);
 
@@ -77,6 +82,11 @@ std::string BlitCopyTextureToBufferCommandVK::GetLabel() const {
 bool BlitCopyTextureToBufferCommandVK::Encode(CommandEncoderVK& encoder) const {
   const auto& cmd_buffer = encoder.GetCommandBuffer();
 
+  // The command buffer completes asynchronously.
+  if (!encoder.Track(source) || !encoder.Track(destination)) {
+    return false;
+  }
+
   // cast source and destination to TextureVK
   const auto& src = TextureVK::Cast(*source);
   const auto& dst = DeviceBufferVK::Cast(*destination);
@@ -106,6 +116,52 @@ bool BlitCopyTextureToBufferCommandVK::Encode(CommandEncoderVK& encoder) const {
   return true;
 }
 
+//------------------------------------------------------------------------------
+/// BlitCopyBufferToTextureCommandVK
+///
+
+BlitCopyBufferToTextureCommandVK::~BlitCopyBufferToTextureCommandVK() = default;
+
+std::string BlitCopyBufferToTextureCommandVK::GetLabel() const {
+  return label;
+}
+
+bool BlitCopyBufferToTextureCommandVK::Encode(CommandEncoderVK& encoder) const {
+  const auto& cmd_buffer = encoder.GetCommandBuffer();
+
+  // The command buffer completes asynchronously.
+  if (!encoder.Track(source) || !encoder.Track(destination)) {
+    return false;
+  }
+
+  const auto& src = DeviceBufferVK::Cast(*source);
+  const auto& dst = TextureVK::Cast(*destination);
+
+  vk::BufferImageCopy image_copy;
+  image_copy.setBufferOffset(source_offset);
+  image_copy.setBufferRowLength(0);
+  image_copy.setBufferImageHeight(0);
+  image_copy.setImageSubresource(
+      vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1));
+  image_copy.setImageOffset(vk::Offset3D(destination_region.origin.x,
+                                         destination_region.origin.y, 0));
+  image_copy.setImageExtent(vk::Extent3D(destination_region.size.width,
+                                         destination_region.size.height, 1));
+
+  if (!dst.SetLayout(vk::ImageLayout::eTransferDstOptimal, cmd_buffer)) {
+    VALIDATION_LOG << "Could not encode layout transition.";
+    return false;
+  }
+
+  cmd_buffer.copyBufferToImage(src.GetVKBufferHandle(),               //
+                               dst.GetImage(),                        //
+                               vk::ImageLayout::eTransferDstOptimal,  //
+                               image_copy                             //
+  );
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 /// BlitGenerateMipmapCommandVK
 ///
@@ -148,6 +204,11 @@ static void InsertImageMemoryBarrier(const vk::CommandBuffer& cmd,
 }
 
 bool BlitGenerateMipmapCommandVK::Encode(CommandEncoderVK& encoder) const {
+  // The command buffer completes asynchronously.
+  if (!encoder.Track(texture)) {
+    return false;
+  }
+
   const auto& src = TextureVK::Cast(*texture);
 
   const auto size = src.GetTextureDescriptor().size;
@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/backend/vulkan/blit_pass_vk.h"
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 
@@ -40,6 +41,10 @@ bool BlitPassVK::EncodeCommands(
     return false;
   }
 
+  encoder->BeginTimedScope(label_);
+  fml::ScopedCleanupClosure end_timed_scope(
+      [&encoder]() { encoder->EndTimedScope(); });
+
   for (auto& command : commands_) {
     if (!command->Encode(*encoder)) {
       return false;
@@ -87,6 +92,25 @@ bool BlitPassVK::OnCopyTextureToBufferCommand(
   return true;
 }
 
+// |BlitPass|
+bool BlitPassVK::OnCopyBufferToTextureCommand(
+    std::shared_ptr<DeviceBuffer> source,
+    std::shared_ptr<Texture> destination,
+    IRect destination_region,
+    size_t source_offset,
+    std::string label) {
+  auto command = std::make_unique<BlitCopyBufferToTextureCommandVK>();
+
+  command->source = std::move(source);
+  command->destination = std::move(destination);
+  command->destination_region = destination_region;
+  command->source_offset = source_offset;
+  command->label = std::move(label);
+
+  commands_.push_back(std::move(command));
+  return true;
+}
+
 // |BlitPass|
 bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
                                          std::string label) {
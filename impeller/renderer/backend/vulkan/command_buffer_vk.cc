@@ -47,10 +47,15 @@ const std::shared_ptr<CommandEncoderVK>& CommandBufferVK::GetEncoder() const {
 }
 
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
-  const auto submit = encoder_->Submit();
+  fml::closure on_completed;
   if (callback) {
-    callback(submit ? CommandBuffer::Status::kCompleted
-                    : CommandBuffer::Status::kError);
+    on_completed = [callback]() {
+      callback(CommandBuffer::Status::kCompleted);
+    };
+  }
+  const auto submit = encoder_->Submit(std::move(on_completed));
+  if (!submit && callback) {
+    callback(CommandBuffer::Status::kError);
   }
   return submit;
 }
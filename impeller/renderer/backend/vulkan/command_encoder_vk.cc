@@ -5,31 +5,163 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 
 #include "flutter/fml/closure.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batcher_vk.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 namespace impeller {
 
-CommandEncoderVK::CommandEncoderVK(vk::Device device,
-                                   vk::Queue queue,
-                                   vk::CommandPool pool) {
-  vk::CommandBufferAllocateInfo alloc_info;
-  alloc_info.commandPool = pool;
-  alloc_info.commandBufferCount = 1u;
-  alloc_info.level = vk::CommandBufferLevel::ePrimary;
-  auto [result, buffers] = device.allocateCommandBuffersUnique(alloc_info);
-  if (result != vk::Result::eSuccess) {
+// The number of passes that can be timed in a single command buffer.
+static constexpr uint32_t kMaxTimedScopes = 16u;
+
+class TrackedObjectsVK {
+ public:
+  TrackedObjectsVK(std::shared_ptr<CommandPoolVK> pool,
+                   vk::UniqueCommandBuffer buffer,
+                   std::unique_ptr<DescriptorPoolVK> descriptor_pool)
+      : pool_(std::move(pool)),
+        buffer_(std::move(buffer)),
+        descriptor_pool_(std::move(descriptor_pool)) {}
+
+  ~TrackedObjectsVK() {
+    // Scopes of command buffers that were never submitted can't be timed.
+    for (auto& scope : timed_scopes_) {
+      tracer_->EndTimedWork(scope.frame_number, std::move(scope.label),
+                            std::nullopt);
+    }
+    // The command buffer is either done executing or was never submitted, so
+    // it and the descriptor sets it used can be recycled.
+    if (buffer_) {
+      pool_->CollectGraphicsCommandBuffer(std::move(buffer_));
+    }
+  }
+
+  const vk::CommandBuffer& GetCommandBuffer() const { return *buffer_; }
+
+  DescriptorPoolVK& GetDescriptorPool() { return *descriptor_pool_; }
+
+  void Track(std::shared_ptr<SharedObjectVK> object) {
+    objects_.emplace_back(std::move(object));
+  }
+
+  void Track(std::shared_ptr<const DeviceBuffer> buffer) {
+    buffers_.emplace_back(std::move(buffer));
+  }
+
+  void Track(std::shared_ptr<const Texture> texture) {
+    textures_.emplace_back(std::move(texture));
+  }
+
+  void BeginTimedScope(const vk::Device& device,
+                       std::shared_ptr<GPUTracer> tracer,
+                       std::string label) {
+    FML_DCHECK(!scope_open_);
+    if (timed_scopes_.size() == kMaxTimedScopes) {
+      return;
+    }
+    if (!query_pool_) {
+      auto [result, pool] = device.createQueryPoolUnique(
+          vk::QueryPoolCreateInfo()
+              .setQueryType(vk::QueryType::eTimestamp)
+              .setQueryCount(kMaxTimedScopes * 2u));
+      if (result != vk::Result::eSuccess) {
+        return;
+      }
+      query_pool_ = std::move(pool);
+      buffer_->resetQueryPool(*query_pool_, 0u, kMaxTimedScopes * 2u);
+    }
+    tracer_ = std::move(tracer);
+    const auto query = static_cast<uint32_t>(timed_scopes_.size()) * 2u;
+    buffer_->writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe,
+                            *query_pool_, query);
+    timed_scopes_.push_back({std::move(label), tracer_->BeginTimedWork()});
+    scope_open_ = true;
+  }
+
+  void EndTimedScope() {
+    if (!scope_open_) {
+      return;
+    }
+    const auto query = static_cast<uint32_t>(timed_scopes_.size()) * 2u - 1u;
+    buffer_->writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe,
+                            *query_pool_, query);
+    scope_open_ = false;
+  }
+
+  // Called once the command buffer has completed.
+  void ReportTimings(const vk::Device& device, float timestamp_period) {
+    if (timed_scopes_.empty()) {
+      return;
+    }
+    std::vector<uint64_t> timestamps(timed_scopes_.size() * 2u);
+    const auto result = device.getQueryPoolResults(
+        *query_pool_, 0u, timestamps.size(),
+        timestamps.size() * sizeof(uint64_t), timestamps.data(),
+        sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+    for (size_t i = 0; i < timed_scopes_.size(); i++) {
+      std::optional<fml::TimeDelta> duration;
+      if (result == vk::Result::eSuccess) {
+        const auto ticks = timestamps[i * 2u + 1u] - timestamps[i * 2u];
+        duration = fml::TimeDelta::FromNanoseconds(
+            static_cast<int64_t>(ticks * timestamp_period));
+      }
+      tracer_->EndTimedWork(timed_scopes_[i].frame_number,
+                            std::move(timed_scopes_[i].label), duration);
+    }
+    timed_scopes_.clear();
+  }
+
+ private:
+  struct TimedScope {
+    std::string label;
+    uint64_t frame_number;
+  };
+
+  const std::shared_ptr<CommandPoolVK> pool_;
+  vk::UniqueCommandBuffer buffer_;
+  std::unique_ptr<DescriptorPoolVK> descriptor_pool_;
+  std::vector<std::shared_ptr<SharedObjectVK>> objects_;
+  std::vector<std::shared_ptr<const DeviceBuffer>> buffers_;
+  std::vector<std::shared_ptr<const Texture>> textures_;
+  // Scope i is timed with queries 2i and 2i + 1 of the pool.
+  vk::UniqueQueryPool query_pool_;
+  std::vector<TimedScope> timed_scopes_;
+  std::shared_ptr<GPUTracer> tracer_;
+  bool scope_open_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TrackedObjectsVK);
+};
+
+CommandEncoderVK::CommandEncoderVK(
+    vk::Device device,
+    std::shared_ptr<CommandPoolVK> pool,
+    std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pools,
+    std::shared_ptr<SubmissionBatcherVK> submission_batcher,
+    std::shared_ptr<GPUTracer> gpu_tracer,
+    float timestamp_period)
+    : submission_batcher_(std::move(submission_batcher)),
+      gpu_tracer_(std::move(gpu_tracer)),
+      timestamp_period_(timestamp_period) {
+  if (!pool) {
+    return;
+  }
+  auto buffer = pool->CreateGraphicsCommandBuffer();
+  if (!buffer) {
     VALIDATION_LOG << "Could not create command buffer.";
     return;
   }
   vk::CommandBufferBeginInfo begin_info;
   begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
-  if (buffers[0]->begin(begin_info) != vk::Result::eSuccess) {
+  if (buffer->begin(begin_info) != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not begin command buffer.";
+    pool->CollectGraphicsCommandBuffer(std::move(buffer));
     return;
   }
   device_ = device;
-  queue_ = queue;
-  command_buffer_ = std::move(buffers[0]);
+  tracked_objects_ = std::make_shared<TrackedObjectsVK>(
+      std::move(pool), std::move(buffer),
+      std::make_unique<DescriptorPoolVK>(device, std::move(descriptor_pools)));
   is_valid_ = true;
 }
 
@@ -39,7 +171,7 @@ bool CommandEncoderVK::IsValid() const {
   return is_valid_;
 }
 
-bool CommandEncoderVK::Submit() {
+bool CommandEncoderVK::Submit(fml::closure on_completed) {
   if (!IsValid()) {
     return false;
   }
@@ -47,74 +179,102 @@ bool CommandEncoderVK::Submit() {
   // Success or failure, you only get to submit once.
   fml::ScopedCleanupClosure reset([&]() { Reset(); });
 
-  if (command_buffer_->end() != vk::Result::eSuccess) {
+  const auto& command_buffer = tracked_objects_->GetCommandBuffer();
+  if (command_buffer.end() != vk::Result::eSuccess) {
     return false;
   }
-  auto [fence_result, fence] = device_.createFenceUnique({});
-  if (fence_result != vk::Result::eSuccess) {
-    return false;
-  }
-  vk::SubmitInfo submit_info;
-  submit_info.setCommandBuffers(*command_buffer_);
-  if (queue_.submit(submit_info, *fence) != vk::Result::eSuccess) {
-    return false;
-  }
-  if (device_.waitForFences(
-          *fence,                               // fences
-          true,                                 // wait all
-          std::numeric_limits<uint64_t>::max()  // timeout (ns)
-          ) != vk::Result::eSuccess) {
+  if (!submission_batcher_) {
     return false;
   }
 
-  return true;
+  // The number of frames in flight is limited by the swapchain, which waits
+  // for the frame that last used the image it acquires. So there is no need
+  // to wait for the GPU here.
+  // Someone may be waiting for the callback, so commands that have one are
+  // not held back.
+  const bool flush = static_cast<bool>(on_completed);
+  auto completed = [tracked_objects = tracked_objects_, on_completed,
+                    device = device_, timestamp_period = timestamp_period_]() {
+    tracked_objects->ReportTimings(device, timestamp_period);
+    if (on_completed) {
+      on_completed();
+    }
+  };
+  return submission_batcher_->Enqueue(command_buffer, std::move(completed),
+                                      flush);
 }
 
 const vk::CommandBuffer& CommandEncoderVK::GetCommandBuffer() const {
-  return *command_buffer_;
+  return tracked_objects_->GetCommandBuffer();
 }
 
-void CommandEncoderVK::Reset() {
-  command_buffer_.reset();
+std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout) {
+  if (!IsValid()) {
+    return std::nullopt;
+  }
+  return tracked_objects_->GetDescriptorPool().AllocateDescriptorSet(layout);
+}
 
-  tracked_objects_.clear();
-  tracked_buffers_.clear();
-  tracked_textures_.clear();
+void CommandEncoderVK::Reset() {
+  tracked_objects_.reset();
 
-  queue_ = nullptr;
   device_ = nullptr;
   is_valid_ = false;
 }
 
 bool CommandEncoderVK::Track(std::shared_ptr<SharedObjectVK> object) {
-  tracked_objects_.push_back(std::move(object));
+  if (!IsValid()) {
+    return false;
+  }
+  tracked_objects_->Track(std::move(object));
   return true;
 }
 
 bool CommandEncoderVK::Track(std::shared_ptr<const DeviceBuffer> buffer) {
-  tracked_buffers_.emplace_back(std::move(buffer));
+  if (!IsValid()) {
+    return false;
+  }
+  tracked_objects_->Track(std::move(buffer));
   return true;
 }
 
 bool CommandEncoderVK::Track(std::shared_ptr<const Texture> texture) {
-  tracked_textures_.emplace_back(std::move(texture));
+  if (!IsValid()) {
+    return false;
+  }
+  tracked_objects_->Track(std::move(texture));
   return true;
 }
 
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
-  if (!vk::HasValidationLayers() || !command_buffer_) {
+  if (!vk::HasValidationLayers() || !tracked_objects_) {
     return;
   }
   vk::DebugUtilsLabelEXT label_info;
   label_info.pLabelName = label;
-  command_buffer_->beginDebugUtilsLabelEXT(label_info);
+  tracked_objects_->GetCommandBuffer().beginDebugUtilsLabelEXT(label_info);
+}
+
+void CommandEncoderVK::BeginTimedScope(std::string label) {
+  if (!IsValid() || !gpu_tracer_ || !gpu_tracer_->IsTimingEnabled()) {
+    return;
+  }
+  tracked_objects_->BeginTimedScope(device_, gpu_tracer_, std::move(label));
+}
+
+void CommandEncoderVK::EndTimedScope() {
+  if (!IsValid()) {
+    return;
+  }
+  tracked_objects_->EndTimedScope();
 }
 
 void CommandEncoderVK::PopDebugGroup() const {
-  if (!vk::HasValidationLayers() || !command_buffer_) {
+  if (!vk::HasValidationLayers() || !tracked_objects_) {
     return;
   }
-  command_buffer_->endDebugUtilsLabelEXT();
+  tracked_objects_->GetCommandBuffer().endDebugUtilsLabelEXT();
 }
 
 }  // namespace impeller
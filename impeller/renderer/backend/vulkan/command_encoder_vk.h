@@ -4,17 +4,26 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/shared_object_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
 
+class CommandPoolVK;
 class ContextVK;
 class DeviceBuffer;
+class GPUTracer;
+class SubmissionBatcherVK;
 class Texture;
+class TrackedObjectsVK;
 
 class CommandEncoderVK {
  public:
@@ -22,7 +31,19 @@ class CommandEncoderVK {
 
   bool IsValid() const;
 
-  bool Submit();
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the commands without waiting for them to complete.
+  ///
+  ///             The tracked resources are released once the commands have
+  ///             completed, which is also when the callback is invoked. The
+  ///             callback is invoked on the thread that waits for fences, and
+  ///             is not invoked if the submission fails.
+  ///
+  ///             Commands without a callback are batched with the ones
+  ///             submitted after them, and only reach the queue once the
+  ///             batch is flushed. Commands with a callback flush the batch.
+  ///
+  bool Submit(fml::closure on_completed = nullptr);
 
   bool Track(std::shared_ptr<SharedObjectVK> object);
 
@@ -32,22 +53,48 @@ class CommandEncoderVK {
 
   const vk::CommandBuffer& GetCommandBuffer() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates a descriptor set that lives until the commands of
+  ///             this encoder have completed.
+  ///
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout);
+
   void PushDebugGroup(const char* label) const;
 
   void PopDebugGroup() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Writes timestamps before and after the commands recorded
+  ///             until the matching call to `EndTimedScope`, if GPU timing is
+  ///             enabled. The duration is reported to the GPU tracer once the
+  ///             commands have completed.
+  ///
+  ///             Scopes may not be nested, and must begin outside of render
+  ///             passes.
+  ///
+  void BeginTimedScope(std::string label);
+
+  void EndTimedScope();
+
  private:
   friend class ContextVK;
 
   vk::Device device_ = {};
-  vk::Queue queue_ = {};
-  vk::UniqueCommandBuffer command_buffer_;
-  std::vector<std::shared_ptr<SharedObjectVK>> tracked_objects_;
-  std::vector<std::shared_ptr<const DeviceBuffer>> tracked_buffers_;
-  std::vector<std::shared_ptr<const Texture>> tracked_textures_;
+  std::shared_ptr<SubmissionBatcherVK> submission_batcher_;
+  std::shared_ptr<GPUTracer> gpu_tracer_;
+  float timestamp_period_ = 0.0f;
+  // The command buffer along with everything that must live until the GPU is
+  // done with it.
+  std::shared_ptr<TrackedObjectsVK> tracked_objects_;
   bool is_valid_ = false;
 
-  CommandEncoderVK(vk::Device device, vk::Queue queue, vk::CommandPool pool);
+  CommandEncoderVK(vk::Device device,
+                   std::shared_ptr<CommandPoolVK> pool,
+                   std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pools,
+                   std::shared_ptr<SubmissionBatcherVK> submission_batcher,
+                   std::shared_ptr<GPUTracer> gpu_tracer,
+                   float timestamp_period);
 
   void Reset();
 
@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
+
+#include <map>
+
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+
+namespace impeller {
+
+using CommandPoolMap =
+    std::map<const ContextVK*, std::shared_ptr<CommandPoolVK>>;
+
+// The pools of the calling thread, by context.
+thread_local std::unique_ptr<CommandPoolMap> tls_command_pool;
+
+// The pools of all threads, so that they can be destroyed along with their
+// context regardless of which thread they belong to.
+static Mutex g_all_pools_mutex;
+static std::map<const ContextVK*, std::vector<std::weak_ptr<CommandPoolVK>>>
+    g_all_pools IPLR_GUARDED_BY(g_all_pools_mutex);
+
+std::shared_ptr<CommandPoolVK> CommandPoolVK::GetThreadLocal(
+    const ContextVK* context) {
+  if (!context) {
+    return nullptr;
+  }
+  if (!tls_command_pool) {
+    tls_command_pool = std::make_unique<CommandPoolMap>();
+  }
+  auto found = tls_command_pool->find(context);
+  if (found != tls_command_pool->end() && found->second->IsValid()) {
+    return found->second;
+  }
+  // A pool that is found but invalid belonged to a collected context that
+  // happened to have the same address.
+  auto pool = std::shared_ptr<CommandPoolVK>(new CommandPoolVK(context));
+  if (!pool->IsValid()) {
+    return nullptr;
+  }
+  (*tls_command_pool)[context] = pool;
+  {
+    Lock lock(g_all_pools_mutex);
+    g_all_pools[context].push_back(pool);
+  }
+  return pool;
+}
+
+void CommandPoolVK::ClearAllPools(const ContextVK* context) {
+  Lock lock(g_all_pools_mutex);
+  if (auto found = g_all_pools.find(context); found != g_all_pools.end()) {
+    for (auto& weak_pool : found->second) {
+      if (auto pool = weak_pool.lock()) {
+        pool->Destroy();
+      }
+    }
+    g_all_pools.erase(found);
+  }
+}
+
+CommandPoolVK::CommandPoolVK(const ContextVK* context) {
+  auto queue_family_index = context->GetGraphicsQueueFamilyIndex();
+
+  vk::CommandPoolCreateInfo pool_info;
+  pool_info.queueFamilyIndex = queue_family_index;
+  // Reused command buffers are reset implicitly when they are begun again.
+  pool_info.flags = vk::CommandPoolCreateFlagBits::eTransient |
+                    vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
+  auto pool = context->GetDevice().createCommandPoolUnique(pool_info);
+  if (pool.result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create a command pool.";
+    return;
+  }
+
+  device_ = context->GetDevice();
+  graphics_pool_ = std::move(pool.value);
+  is_valid_ = true;
+}
+
+CommandPoolVK::~CommandPoolVK() = default;
+
+bool CommandPoolVK::IsValid() const {
+  return is_valid_;
+}
+
+void CommandPoolVK::Destroy() {
+  Lock lock(pool_mutex_);
+  recycled_buffers_.clear();
+  graphics_pool_.reset();
+  is_valid_ = false;
+}
+
+vk::UniqueCommandBuffer CommandPoolVK::CreateGraphicsCommandBuffer() {
+  Lock lock(pool_mutex_);
+  if (!graphics_pool_) {
+    return {};
+  }
+  if (outstanding_buffer_count_ == 0u && !recycled_buffers_.empty()) {
+    // None of the command buffers of the pool are in use, so the memory of
+    // all of them can be recycled at once. This is done here rather than
+    // when the buffers are collected, since the pool may only be used on the
+    // thread it belongs to.
+    [[maybe_unused]] auto result = device_.resetCommandPool(
+        graphics_pool_.get(), vk::CommandPoolResetFlags{});
+  }
+  if (!recycled_buffers_.empty()) {
+    auto buffer = std::move(recycled_buffers_.back());
+    recycled_buffers_.pop_back();
+    outstanding_buffer_count_++;
+    return buffer;
+  }
+
+  vk::CommandBufferAllocateInfo alloc_info;
+  alloc_info.commandPool = graphics_pool_.get();
+  alloc_info.commandBufferCount = 1u;
+  alloc_info.level = vk::CommandBufferLevel::ePrimary;
+  auto [result, buffers] = device_.allocateCommandBuffersUnique(alloc_info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not allocate command buffer: "
+                   << vk::to_string(result);
+    return {};
+  }
+  outstanding_buffer_count_++;
+  return std::move(buffers[0]);
+}
+
+void CommandPoolVK::CollectGraphicsCommandBuffer(
+    vk::UniqueCommandBuffer buffer) {
+  Lock lock(pool_mutex_);
+  if (!graphics_pool_) {
+    // The pool was destroyed along with all of its command buffers.
+    buffer.release();
+    return;
+  }
+  if (!buffer) {
+    return;
+  }
+  FML_DCHECK(outstanding_buffer_count_ > 0u);
+  outstanding_buffer_count_--;
+  recycled_buffers_.emplace_back(std::move(buffer));
+}
+
+}  // namespace impeller
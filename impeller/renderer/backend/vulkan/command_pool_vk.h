@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+class ContextVK;
+
+//------------------------------------------------------------------------------
+/// @brief      A command pool that is only used on the thread that created it,
+///             so that command buffers can be encoded on multiple threads.
+///
+///             Command buffers that are done with are returned to the pool to
+///             be reused, which may happen on any thread. Once all of the
+///             command buffers of the pool have been returned, which is
+///             usually once per frame, the pool is reset as a whole instead
+///             of resetting each command buffer.
+///
+class CommandPoolVK {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Gets the command pool of the calling thread for the context,
+  ///             creating it if necessary.
+  ///
+  static std::shared_ptr<CommandPoolVK> GetThreadLocal(
+      const ContextVK* context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the command pools of all threads for the context.
+  ///             Must be called before the device of the context is destroyed.
+  ///
+  static void ClearAllPools(const ContextVK* context);
+
+  ~CommandPoolVK();
+
+  bool IsValid() const;
+
+  vk::UniqueCommandBuffer CreateGraphicsCommandBuffer();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a command buffer that was created by this pool and is
+  ///             no longer in use by the GPU. May be called on any thread.
+  ///
+  void CollectGraphicsCommandBuffer(vk::UniqueCommandBuffer buffer);
+
+ private:
+  vk::Device device_;
+  Mutex pool_mutex_;
+  vk::UniqueCommandPool graphics_pool_ IPLR_GUARDED_BY(pool_mutex_);
+  std::vector<vk::UniqueCommandBuffer> recycled_buffers_
+      IPLR_GUARDED_BY(pool_mutex_);
+  size_t outstanding_buffer_count_ IPLR_GUARDED_BY(pool_mutex_) = 0u;
+  bool is_valid_ = false;
+
+  explicit CommandPoolVK(const ContextVK* context);
+
+  void Destroy();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CommandPoolVK);
+};
+
+}  // namespace impeller
@@ -20,10 +20,16 @@
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/command_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/submission_batcher_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_uploader_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/device_capabilities.h"
+#include "impeller/renderer/gpu_tracer.h"
 
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 
@@ -116,6 +122,16 @@ static bool HasRequiredQueues(const vk::PhysicalDevice& device) {
                                     vk::QueueFlagBits::eTransfer));
 }
 
+static bool HasDeviceExtension(const vk::PhysicalDevice& device,
+                               std::string_view extension) {
+  for (const auto& ext : device.enumerateDeviceExtensionProperties().value) {
+    if (extension == ext.extensionName.data()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static std::vector<std::string> HasRequiredExtensions(
     const vk::PhysicalDevice& device) {
   std::set<std::string> exts;
@@ -148,6 +164,21 @@ static bool HasRequiredProperties(const vk::PhysicalDevice& device) {
   return true;
 }
 
+static std::vector<PixelFormat> GetSupportedCompressedFormats(
+    const vk::PhysicalDevice& device) {
+  std::vector<PixelFormat> formats;
+  for (auto format : {PixelFormat::kETC2R8G8B8A8UNormBlock,
+                      PixelFormat::kASTC4x4UNormBlock,
+                      PixelFormat::kBC3UNormBlock}) {
+    const auto properties = device.getFormatProperties(ToVKImageFormat(format));
+    if (properties.optimalTilingFeatures &
+        vk::FormatFeatureFlagBits::eSampledImage) {
+      formats.push_back(format);
+    }
+  }
+  return formats;
+}
+
 static bool IsPhysicalDeviceCompatible(const vk::PhysicalDevice& device) {
   if (!HasRequiredQueues(device)) {
     FML_LOG(ERROR) << "Device doesn't have required queues.";
@@ -213,16 +244,33 @@ static std::optional<QueueVK> PickQueue(const vk::PhysicalDevice& device,
   return std::nullopt;
 }
 
+static std::optional<QueueVK> PickTransferQueue(
+    const vk::PhysicalDevice& device) {
+  // Prefer a queue family that only does transfers, which usually maps to
+  // the DMA engines of the device, so that uploads don't compete with
+  // rendering.
+  const auto families = device.getQueueFamilyProperties();
+  for (size_t i = 0u; i < families.size(); i++) {
+    const auto flags = families[i].queueFlags;
+    if ((flags & vk::QueueFlagBits::eTransfer) &&
+        !(flags & vk::QueueFlagBits::eGraphics) &&
+        !(flags & vk::QueueFlagBits::eCompute)) {
+      return QueueVK{.family = i, .index = 0};
+    }
+  }
+  return PickQueue(device, vk::QueueFlagBits::eTransfer);
+}
+
 std::shared_ptr<ContextVK> ContextVK::Create(
     PFN_vkGetInstanceProcAddr proc_address_callback,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-    const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+    fml::UniqueFD cache_directory,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
     const std::string& label) {
   auto context = std::shared_ptr<ContextVK>(new ContextVK(
       proc_address_callback,          //
       shader_libraries_data,          //
-      pipeline_cache_data,            //
+      std::move(cache_directory),     //
       std::move(worker_task_runner),  //
       label                           //
       ));
@@ -235,7 +283,7 @@ std::shared_ptr<ContextVK> ContextVK::Create(
 ContextVK::ContextVK(
     PFN_vkGetInstanceProcAddr proc_address_callback,
     const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-    const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+    fml::UniqueFD cache_directory,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
     const std::string& label)
     : worker_task_runner_(std::move(worker_task_runner)) {
@@ -403,8 +451,7 @@ ContextVK::ContextVK(
   ///
   auto graphics_queue =
       PickQueue(physical_device.value(), vk::QueueFlagBits::eGraphics);
-  auto transfer_queue =
-      PickQueue(physical_device.value(), vk::QueueFlagBits::eTransfer);
+  auto transfer_queue = PickTransferQueue(physical_device.value());
   auto compute_queue =
       PickQueue(physical_device.value(), vk::QueueFlagBits::eCompute);
 
@@ -420,6 +467,12 @@ ContextVK::ContextVK(
   for (const auto& ext : kRequiredDeviceExtensions) {
     required_extensions.push_back(ext.data());
   }
+  // Optional. Used to pace presents and to report when images are shown.
+  supports_display_timing_ = HasDeviceExtension(
+      physical_device.value(), VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+  if (supports_display_timing_) {
+    required_extensions.push_back(VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME);
+  }
 
   const auto queue_create_infos = GetQueueCreateInfos(
       {graphics_queue.value(), compute_queue.value(), transfer_queue.value()});
@@ -458,9 +511,10 @@ ContextVK::ContextVK(
   /// Setup the pipeline library.
   ///
   auto pipeline_library = std::shared_ptr<PipelineLibraryVK>(
-      new PipelineLibraryVK(device.value.get(),   //
-                            pipeline_cache_data,  //
-                            worker_task_runner_   //
+      new PipelineLibraryVK(device.value.get(),                //
+                            physical_device->getProperties(),  //
+                            std::move(cache_directory),        //
+                            worker_task_runner_                //
                             ));
 
   if (!pipeline_library->IsValid()) {
@@ -486,51 +540,6 @@ ContextVK::ContextVK(
     return;
   }
 
-  //----------------------------------------------------------------------------
-  /// Setup the command pool.
-  ///
-  vk::CommandPoolCreateInfo graphics_command_pool_info;
-  graphics_command_pool_info.queueFamilyIndex = graphics_queue->index;
-  graphics_command_pool_info.flags = vk::CommandPoolCreateFlagBits::eTransient;
-  auto graphics_command_pool =
-      device.value->createCommandPoolUnique(graphics_command_pool_info);
-  if (graphics_command_pool.result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Could not create graphics command pool.";
-    return;
-  }
-
-  //----------------------------------------------------------------------------
-  /// Setup the descriptor pool. This needs to be dynamic but we just allocate a
-  /// jumbo pool and hope for the best.
-  ///
-  constexpr size_t kPoolSize = 1024 * 3;
-
-  std::vector<vk::DescriptorPoolSize> pool_sizes = {
-      {vk::DescriptorType::eSampler, kPoolSize},
-      {vk::DescriptorType::eCombinedImageSampler, kPoolSize},
-      {vk::DescriptorType::eSampledImage, kPoolSize},
-      {vk::DescriptorType::eStorageImage, kPoolSize},
-      {vk::DescriptorType::eUniformTexelBuffer, kPoolSize},
-      {vk::DescriptorType::eStorageTexelBuffer, kPoolSize},
-      {vk::DescriptorType::eUniformBuffer, kPoolSize},
-      {vk::DescriptorType::eStorageBuffer, kPoolSize},
-      {vk::DescriptorType::eUniformBufferDynamic, kPoolSize},
-      {vk::DescriptorType::eStorageBufferDynamic, kPoolSize},
-      {vk::DescriptorType::eInputAttachment, kPoolSize},
-  };
-  vk::DescriptorPoolCreateInfo pool_info = {
-      vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,  // flags
-      static_cast<uint32_t>(pool_sizes.size() * kPoolSize),  // max sets
-      static_cast<uint32_t>(pool_sizes.size()),              // pool sizes count
-      pool_sizes.data()                                      // pool sizes
-  };
-
-  auto descriptor_pool = device.value->createDescriptorPoolUnique(pool_info);
-  if (descriptor_pool.result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Unable to create a descriptor pool";
-    return;
-  }
-
   //----------------------------------------------------------------------------
   /// All done!
   ///
@@ -559,16 +568,51 @@ ContextVK::ContextVK(
           .SetDefaultStencilFormat(PixelFormat::kS8UInt)
           // TODO(110622): detect this and enable.
           .SetSupportsCompute(false, false)
+          .SetSupportsInstancedRendering(true)
+          .SetSupportedCompressedFormats(
+              GetSupportedCompressedFormats(physical_device_))
           .Build();
-  graphics_command_pool_ = std::move(graphics_command_pool.value);
-  descriptor_pool_ = std::move(descriptor_pool.value);
+  graphics_queue_family_index_ =
+      static_cast<uint32_t>(graphics_queue->family);
+  // Command pools are created lazily for each thread that encodes commands.
+  descriptor_pool_recycler_ =
+      std::make_shared<DescriptorPoolRecyclerVK>(device_.get());
+  fence_waiter_ = std::make_shared<FenceWaiterVK>(device_.get());
+  submission_batcher_ = std::make_shared<SubmissionBatcherVK>(
+      device_.get(), graphics_queue_, fence_waiter_);
+  gpu_tracer_ = std::make_shared<GPUTracer>();
+  const auto queue_families = physical_device_.getQueueFamilyProperties();
+  if (graphics_queue_family_index_ < queue_families.size() &&
+      queue_families[graphics_queue_family_index_].timestampValidBits > 0u) {
+    timestamp_period_ = physical_device_.getProperties().limits.timestampPeriod;
+  }
+  // If the uploader can't be created, textures fall back to mapping their
+  // memory directly.
+  texture_uploader_ = TextureUploaderVK::Create(
+      device_.get(),                                 //
+      allocator_,                                    //
+      fence_waiter_,                                 //
+      graphics_queue_,                               //
+      graphics_queue_family_index_,                  //
+      transfer_queue_,                               //
+      static_cast<uint32_t>(transfer_queue->family)  //
+  );
   is_valid_ = true;
 }
 
 ContextVK::~ContextVK() {
+  if (submission_batcher_) {
+    submission_batcher_->Flush();
+  }
   if (device_) {
     [[maybe_unused]] auto result = device_->waitIdle();
   }
+  // Release the resources of the submissions that are still tracked before
+  // the pools they came from.
+  if (fence_waiter_) {
+    fence_waiter_->Terminate();
+  }
+  CommandPoolVK::ClearAllPools(this);
 }
 
 bool ContextVK::IsValid() const {
@@ -596,6 +640,11 @@ std::shared_ptr<WorkQueue> ContextVK::GetWorkQueue() const {
   return work_queue_;
 }
 
+// |Context|
+std::shared_ptr<GPUTracer> ContextVK::GetGPUTracer() const {
+  return gpu_tracer_;
+}
+
 std::shared_ptr<CommandBuffer> ContextVK::CreateCommandBuffer() const {
   return std::shared_ptr<CommandBufferVK>(
       new CommandBufferVK(shared_from_this(),              //
@@ -612,6 +661,9 @@ vk::Device ContextVK::GetDevice() const {
 }
 
 std::unique_ptr<Surface> ContextVK::AcquireNextSurface() {
+  if (allocator_) {
+    allocator_->DidAcquireSurfaceFrame();
+  }
   return swapchain_ ? swapchain_->AcquireNextDrawable() : nullptr;
 }
 
@@ -637,8 +689,10 @@ vk::UniqueSurfaceKHR ContextVK::CreateAndroidSurface(
 
 #endif  // FML_OS_ANDROID
 
-bool ContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface) {
-  auto swapchain = SwapchainVK::Create(shared_from_this(), std::move(surface));
+bool ContextVK::SetWindowSurface(vk::UniqueSurfaceKHR surface,
+                                 const SwapchainSettingsVK& settings) {
+  auto swapchain =
+      SwapchainVK::Create(shared_from_this(), std::move(surface), settings);
   if (!swapchain) {
     return false;
   }
@@ -659,24 +713,38 @@ vk::Queue ContextVK::GetGraphicsQueue() const {
   return graphics_queue_;
 }
 
-vk::CommandPool ContextVK::GetGraphicsCommandPool() const {
-  return *graphics_command_pool_;
+bool ContextVK::SupportsDisplayTiming() const {
+  return supports_display_timing_;
 }
 
-vk::DescriptorPool ContextVK::GetDescriptorPool() const {
-  return *descriptor_pool_;
+uint32_t ContextVK::GetGraphicsQueueFamilyIndex() const {
+  return graphics_queue_family_index_;
+}
+
+const std::shared_ptr<TextureUploaderVK>& ContextVK::GetTextureUploader()
+    const {
+  return texture_uploader_;
 }
 
 vk::PhysicalDevice ContextVK::GetPhysicalDevice() const {
   return physical_device_;
 }
 
+bool ContextVK::FlushSubmissions() const {
+  return submission_batcher_ && submission_batcher_->Flush();
+}
+
 std::unique_ptr<CommandEncoderVK> ContextVK::CreateGraphicsCommandEncoder()
     const {
+  // Passes are only timed if the graphics queue supports timestamps.
+  auto gpu_tracer = timestamp_period_ > 0.0f ? gpu_tracer_ : nullptr;
   auto encoder = std::unique_ptr<CommandEncoderVK>(new CommandEncoderVK(
-      *device_,                //
-      graphics_queue_,         //
-      *graphics_command_pool_  //
+      *device_,                             //
+      CommandPoolVK::GetThreadLocal(this),  //
+      descriptor_pool_recycler_,            //
+      submission_batcher_,                  //
+      std::move(gpu_tracer),                //
+      timestamp_period_                     //
       ));
   if (!encoder->IsValid()) {
     return nullptr;
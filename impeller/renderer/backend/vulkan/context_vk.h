@@ -9,6 +9,7 @@
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/renderer/backend/vulkan/pipeline_library_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_library_vk.h"
@@ -32,14 +33,23 @@ bool HasValidationLayers();
 
 }  // namespace vk
 
+class AllocatorVK;
 class CommandEncoderVK;
+class SubmissionBatcherVK;
+class DescriptorPoolRecyclerVK;
+class FenceWaiterVK;
+class TextureUploaderVK;
 
 class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a context. If the cache directory is valid, the
+  ///             pipeline cache is loaded from and persisted to it.
+  ///
   static std::shared_ptr<ContextVK> Create(
       PFN_vkGetInstanceProcAddr proc_address_callback,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-      const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+      fml::UniqueFD cache_directory,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
       const std::string& label);
 
@@ -73,6 +83,9 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
   // |Context|
   const IDeviceCapabilities& GetDeviceCapabilities() const override;
 
+  // |Context|
+  std::shared_ptr<GPUTracer> GetGPUTracer() const override;
+
   template <typename T>
   bool SetDebugName(T handle, std::string_view label) const {
     return SetDebugName(*device_, handle, label);
@@ -109,7 +122,9 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
 
   vk::Device GetDevice() const;
 
-  [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
+  [[nodiscard]] bool SetWindowSurface(
+      vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings = {});
 
   std::unique_ptr<Surface> AcquireNextSurface();
 
@@ -119,36 +134,57 @@ class ContextVK final : public Context, public BackendCast<ContextVK, Context> {
 
   vk::Queue GetGraphicsQueue() const;
 
-  vk::CommandPool GetGraphicsCommandPool() const;
+  uint32_t GetGraphicsQueueFamilyIndex() const;
 
-  vk::DescriptorPool GetDescriptorPool() const;
+  //----------------------------------------------------------------------------
+  /// @brief      Whether VK_GOOGLE_display_timing is enabled on the device.
+  ///
+  bool SupportsDisplayTiming() const;
+
+  const std::shared_ptr<TextureUploaderVK>& GetTextureUploader() const;
 
   vk::PhysicalDevice GetPhysicalDevice() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the command buffers that are batched for the
+  ///             graphics queue. Must be called before anything that only
+  ///             makes progress once they have been executed, like presenting
+  ///             a frame.
+  ///
+  bool FlushSubmissions() const;
+
  private:
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   vk::UniqueInstance instance_;
   vk::UniqueDebugUtilsMessengerEXT debug_messenger_;
   vk::PhysicalDevice physical_device_;
   vk::UniqueDevice device_;
-  std::shared_ptr<Allocator> allocator_;
+  std::shared_ptr<AllocatorVK> allocator_;
   std::shared_ptr<ShaderLibraryVK> shader_library_;
   std::shared_ptr<SamplerLibraryVK> sampler_library_;
   std::shared_ptr<PipelineLibraryVK> pipeline_library_;
   vk::Queue graphics_queue_ = {};
+  uint32_t graphics_queue_family_index_ = 0u;
+  bool supports_display_timing_ = false;
   vk::Queue compute_queue_ = {};
   vk::Queue transfer_queue_ = {};
   std::shared_ptr<SwapchainVK> swapchain_;
   std::shared_ptr<WorkQueue> work_queue_;
   std::unique_ptr<IDeviceCapabilities> device_capabilities_;
-  vk::UniqueCommandPool graphics_command_pool_;
-  vk::UniqueDescriptorPool descriptor_pool_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
+  std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::shared_ptr<SubmissionBatcherVK> submission_batcher_;
+  std::shared_ptr<TextureUploaderVK> texture_uploader_;
+  std::shared_ptr<GPUTracer> gpu_tracer_;
+  // The number of nanoseconds per timestamp tick, or zero if the graphics
+  // queue doesn't support timestamps.
+  float timestamp_period_ = 0.0f;
   bool is_valid_ = false;
 
   ContextVK(
       PFN_vkGetInstanceProcAddr proc_address_callback,
       const std::vector<std::shared_ptr<fml::Mapping>>& shader_libraries_data,
-      const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+      fml::UniqueFD cache_directory,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner,
       const std::string& label);
 
@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+// The number of descriptor sets, and of descriptors of each type, that a
+// single pool can hold. Encoders that need more than this get additional
+// pools.
+static constexpr uint32_t kPoolSize = 512u;
+
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(vk::Device device)
+    : device_(device) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() = default;
+
+vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Get() {
+  {
+    Lock lock(recycled_mutex_);
+    if (!recycled_.empty()) {
+      auto pool = std::move(recycled_.back());
+      recycled_.pop_back();
+      return pool;
+    }
+  }
+  return Create();
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool pool) {
+  if (!pool) {
+    return;
+  }
+  if (device_.resetDescriptorPool(pool.get()) != vk::Result::eSuccess) {
+    return;
+  }
+  Lock lock(recycled_mutex_);
+  if (recycled_.size() < kMaxRecycledPools) {
+    recycled_.emplace_back(std::move(pool));
+  }
+}
+
+vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Create() {
+  TRACE_EVENT0("impeller", "DescriptorPoolRecyclerVK::Create");
+  std::vector<vk::DescriptorPoolSize> pool_sizes = {
+      {vk::DescriptorType::eSampler, kPoolSize},
+      {vk::DescriptorType::eCombinedImageSampler, kPoolSize},
+      {vk::DescriptorType::eSampledImage, kPoolSize},
+      {vk::DescriptorType::eStorageImage, kPoolSize},
+      {vk::DescriptorType::eUniformTexelBuffer, kPoolSize},
+      {vk::DescriptorType::eStorageTexelBuffer, kPoolSize},
+      {vk::DescriptorType::eUniformBuffer, kPoolSize},
+      {vk::DescriptorType::eStorageBuffer, kPoolSize},
+      {vk::DescriptorType::eUniformBufferDynamic, kPoolSize},
+      {vk::DescriptorType::eStorageBufferDynamic, kPoolSize},
+      {vk::DescriptorType::eInputAttachment, kPoolSize},
+  };
+  // The sets are released by resetting the pool, so there is no need for
+  // vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet.
+  vk::DescriptorPoolCreateInfo pool_info;
+  pool_info.setMaxSets(kPoolSize);
+  pool_info.setPoolSizes(pool_sizes);
+
+  auto [result, pool] = device_.createDescriptorPoolUnique(pool_info);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Unable to create a descriptor pool: "
+                   << vk::to_string(result);
+    return {};
+  }
+  return std::move(pool);
+}
+
+DescriptorPoolVK::DescriptorPoolVK(
+    vk::Device device,
+    std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_(device), recycler_(std::move(recycler)) {}
+
+DescriptorPoolVK::~DescriptorPoolVK() {
+  auto recycler = recycler_.lock();
+  if (!recycler) {
+    return;
+  }
+  for (auto& pool : pools_) {
+    recycler->Reclaim(std::move(pool));
+  }
+}
+
+std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
+    const vk::DescriptorSetLayout& layout) {
+  if (pools_.empty() && !GrowPool()) {
+    return std::nullopt;
+  }
+
+  vk::DescriptorSetAllocateInfo alloc_info;
+  alloc_info.setSetLayouts(layout);
+
+  alloc_info.setDescriptorPool(pools_.back().get());
+  auto sets = device_.allocateDescriptorSets(alloc_info);
+  if (sets.result == vk::Result::eErrorOutOfPoolMemory ||
+      sets.result == vk::Result::eErrorFragmentedPool) {
+    // The current pool is full. Continue with another one.
+    if (!GrowPool()) {
+      return std::nullopt;
+    }
+    alloc_info.setDescriptorPool(pools_.back().get());
+    sets = device_.allocateDescriptorSets(alloc_info);
+  }
+  if (sets.result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Failed to allocate descriptor sets: "
+                   << vk::to_string(sets.result);
+    return std::nullopt;
+  }
+  return sets.value[0];
+}
+
+bool DescriptorPoolVK::GrowPool() {
+  auto recycler = recycler_.lock();
+  if (!recycler) {
+    return false;
+  }
+  auto pool = recycler->Get();
+  if (!pool) {
+    return false;
+  }
+  pools_.emplace_back(std::move(pool));
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps the descriptor pools that are no longer used so that they
+///             can be handed out again instead of creating new ones.
+///
+///             Pools are reset when they are reclaimed, which releases all of
+///             the descriptor sets allocated from them at once. This object is
+///             thread-safe.
+///
+class DescriptorPoolRecyclerVK {
+ public:
+  explicit DescriptorPoolRecyclerVK(vk::Device device);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Gets a pool that has no descriptor sets allocated from it.
+  ///
+  vk::UniqueDescriptorPool Get();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Resets the pool and keeps it for reuse. The GPU must be done
+  ///             with all of the descriptor sets allocated from it.
+  ///
+  void Reclaim(vk::UniqueDescriptorPool pool);
+
+ private:
+  // The number of pools kept around for reuse. Pools in excess of this are
+  // destroyed when they are reclaimed.
+  static constexpr size_t kMaxRecycledPools = 32u;
+
+  const vk::Device device_;
+  Mutex recycled_mutex_;
+  std::vector<vk::UniqueDescriptorPool> recycled_
+      IPLR_GUARDED_BY(recycled_mutex_);
+
+  vk::UniqueDescriptorPool Create();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Allocates the descriptor sets used by one command encoder.
+///
+///             The sets are never freed individually. Instead, all of the
+///             pools they were allocated from are returned to the recycler
+///             when the descriptor pool is destroyed, which must only happen
+///             once the commands that use the sets have completed.
+///
+class DescriptorPoolVK {
+ public:
+  DescriptorPoolVK(vk::Device device,
+                   std::weak_ptr<DescriptorPoolRecyclerVK> recycler);
+
+  ~DescriptorPoolVK();
+
+  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
+      const vk::DescriptorSetLayout& layout);
+
+ private:
+  const vk::Device device_;
+  const std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
+  // The pools descriptor sets were allocated from, the last being the one
+  // that new sets are allocated from.
+  std::vector<vk::UniqueDescriptorPool> pools_;
+
+  bool GrowPool();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolVK);
+};
+
+}  // namespace impeller
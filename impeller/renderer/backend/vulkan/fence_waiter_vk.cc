@@ -0,0 +1,133 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "flutter/fml/thread.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+// The longest the waiter waits on the fences it knows of. Fences added while
+// it is waiting are only waited on once it wakes up again.
+static constexpr uint64_t kWaitTimeoutNanos =
+    std::chrono::nanoseconds(std::chrono::milliseconds(1)).count();
+
+FenceWaiterVK::FenceWaiterVK(vk::Device device) : device_(device) {
+  waiter_thread_ = std::make_unique<std::thread>([this]() { Main(); });
+  is_valid_ = true;
+}
+
+FenceWaiterVK::~FenceWaiterVK() {
+  Terminate();
+}
+
+bool FenceWaiterVK::IsValid() const {
+  return is_valid_;
+}
+
+bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
+                             const fml::closure& callback) {
+  if (!fence || !callback) {
+    return false;
+  }
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    if (!terminate_) {
+      wait_set_.push_back({std::move(fence), callback});
+    }
+  }
+  if (fence) {
+    // There is no waiter thread anymore, so wait on the calling thread.
+    [[maybe_unused]] auto result = device_.waitForFences(
+        *fence,                               // fences
+        true,                                 // wait all
+        std::numeric_limits<uint64_t>::max()  // timeout (ns)
+    );
+    callback();
+    return true;
+  }
+  wait_set_cv_.notify_one();
+  return true;
+}
+
+void FenceWaiterVK::Main() {
+  fml::Thread::SetCurrentThreadName(
+      fml::Thread::ThreadConfig{"io.flutter.impeller.fence_waiter"});
+
+  while (true) {
+    std::vector<vk::Fence> fences;
+    {
+      std::unique_lock lock(wait_set_mutex_);
+      wait_set_cv_.wait(lock,
+                        [&]() { return !wait_set_.empty() || terminate_; });
+      if (terminate_) {
+        break;
+      }
+      for (const auto& wait_set : wait_set_) {
+        fences.push_back(wait_set.fence.get());
+      }
+    }
+
+    auto result = device_.waitForFences(fences,            // fences
+                                        false,             // wait all
+                                        kWaitTimeoutNanos  // timeout (ns)
+    );
+    if (result == vk::Result::eTimeout) {
+      continue;
+    }
+    if (result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not wait on fences: " << vk::to_string(result);
+      break;
+    }
+
+    std::vector<fml::closure> callbacks;
+    {
+      std::scoped_lock lock(wait_set_mutex_);
+      auto signaled = std::stable_partition(
+          wait_set_.begin(), wait_set_.end(), [&](const WaitSet& wait_set) {
+            return device_.getFenceStatus(wait_set.fence.get()) !=
+                   vk::Result::eSuccess;
+          });
+      for (auto it = signaled; it != wait_set_.end(); ++it) {
+        callbacks.push_back(std::move(it->callback));
+      }
+      wait_set_.erase(signaled, wait_set_.end());
+    }
+
+    TRACE_EVENT0("impeller", "FenceWaiterVK::Callbacks");
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+  }
+}
+
+void FenceWaiterVK::Terminate() {
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    terminate_ = true;
+  }
+  wait_set_cv_.notify_one();
+  if (waiter_thread_) {
+    waiter_thread_->join();
+    waiter_thread_.reset();
+  }
+  // The GPU is idle, so all of the fences have been signaled.
+  std::vector<WaitSet> wait_set;
+  {
+    std::scoped_lock lock(wait_set_mutex_);
+    std::swap(wait_set, wait_set_);
+  }
+  for (const auto& item : wait_set) {
+    item.callback();
+  }
+  is_valid_ = false;
+}
+
+}  // namespace impeller
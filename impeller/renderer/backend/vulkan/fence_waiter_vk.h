@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Waits for fences on a thread of its own and invokes a callback
+///             once each of them is signaled.
+///
+///             This is what lets command buffers be submitted without the
+///             submitting thread waiting for the GPU. The resources used by a
+///             command buffer are kept alive by the callback of its fence and
+///             released once the GPU is done with them.
+///
+class FenceWaiterVK {
+ public:
+  explicit FenceWaiterVK(vk::Device device);
+
+  ~FenceWaiterVK();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Invokes the callback on the waiter thread once the fence is
+  ///             signaled. Once the waiter is terminated, this waits for the
+  ///             fence and invokes the callback on the calling thread.
+  ///
+  bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops the waiter thread, invoking the callbacks of all the
+  ///             fences still pending. The GPU must be idle.
+  ///
+  void Terminate();
+
+ private:
+  struct WaitSet {
+    vk::UniqueFence fence;
+    fml::closure callback;
+  };
+
+  const vk::Device device_;
+  std::unique_ptr<std::thread> waiter_thread_;
+  std::mutex wait_set_mutex_;
+  std::condition_variable wait_set_cv_;
+  std::vector<WaitSet> wait_set_;
+  bool terminate_ = false;
+  bool is_valid_ = false;
+
+  void Main();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
+};
+
+}  // namespace impeller
@@ -164,6 +164,12 @@ constexpr vk::Format ToVKImageFormat(PixelFormat format) {
       return vk::Format::eR8Unorm;
     case PixelFormat::kR8G8UNormInt:
       return vk::Format::eR8G8Unorm;
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+      return vk::Format::eEtc2R8G8B8A8UnormBlock;
+    case PixelFormat::kASTC4x4UNormBlock:
+      return vk::Format::eAstc4x4UnormBlock;
+    case PixelFormat::kBC3UNormBlock:
+      return vk::Format::eBc3UnormBlock;
   }
 
   FML_UNREACHABLE();
@@ -193,6 +199,12 @@ constexpr PixelFormat ToPixelFormat(vk::Format format) {
       return PixelFormat::kR8UNormInt;
     case vk::Format::eR8G8Unorm:
       return PixelFormat::kR8G8UNormInt;
+    case vk::Format::eEtc2R8G8B8A8UnormBlock:
+      return PixelFormat::kETC2R8G8B8A8UNormBlock;
+    case vk::Format::eAstc4x4UnormBlock:
+      return PixelFormat::kASTC4x4UNormBlock;
+    case vk::Format::eBc3UnormBlock:
+      return PixelFormat::kBC3UNormBlock;
     default:
       return PixelFormat::kUnknown;
   }
@@ -367,6 +379,9 @@ constexpr bool PixelFormatIsDepthStencil(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+    case PixelFormat::kASTC4x4UNormBlock:
+    case PixelFormat::kBC3UNormBlock:
       return false;
     case PixelFormat::kS8UInt:
     case PixelFormat::kD32FloatS8UInt:
@@ -525,6 +540,9 @@ constexpr vk::ImageAspectFlags ToVKImageAspectFlags(PixelFormat format) {
     case PixelFormat::kB10G10R10XR:
     case PixelFormat::kB10G10R10XRSRGB:
     case PixelFormat::kB10G10R10A10XR:
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+    case PixelFormat::kASTC4x4UNormBlock:
+    case PixelFormat::kBC3UNormBlock:
       return vk::ImageAspectFlagBits::eColor;
     case PixelFormat::kS8UInt:
       return vk::ImageAspectFlagBits::eStencil;
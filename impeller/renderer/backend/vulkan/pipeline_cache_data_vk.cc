@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+static constexpr const char* kPipelineCacheFileName =
+    "flutter.impeller.vkcache";
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
+
+PipelineCacheHeaderVK::PipelineCacheHeaderVK(
+    const vk::PhysicalDeviceProperties& props,
+    uint64_t p_data_size)
+    : vendor_id(props.vendorID),
+      device_id(props.deviceID),
+      driver_version(props.driverVersion),
+      api_version(props.apiVersion),
+      data_size(p_data_size) {
+  std::copy(std::begin(props.pipelineCacheUUID),
+            std::end(props.pipelineCacheUUID), std::begin(uuid));
+}
+
+bool PipelineCacheHeaderVK::IsCompatibleWith(
+    const PipelineCacheHeaderVK& other) const {
+  return signature == other.signature &&            //
+         version == other.version &&                //
+         vendor_id == other.vendor_id &&            //
+         device_id == other.device_id &&            //
+         driver_version == other.driver_version &&  //
+         api_version == other.api_version &&        //
+         memcmp(uuid, other.uuid, sizeof(uuid)) == 0;
+}
+
+std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const vk::PhysicalDeviceProperties& props) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  TRACE_EVENT0("impeller", "PipelineCacheDataRetrieve");
+  if (!fml::FileExists(cache_directory, kPipelineCacheFileName)) {
+    return nullptr;
+  }
+  auto file = fml::OpenFileReadOnly(cache_directory, kPipelineCacheFileName);
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  if (mapping->GetSize() < sizeof(PipelineCacheHeaderVK)) {
+    return nullptr;
+  }
+
+  PipelineCacheHeaderVK header;
+  memcpy(&header, mapping->GetMapping(), sizeof(header));
+  if (!header.IsCompatibleWith(PipelineCacheHeaderVK{props, 0u}) ||
+      header.data_size != mapping->GetSize() - sizeof(header)) {
+    FML_LOG(INFO) << "Discarding pipeline cache data that is stale or was "
+                     "created for a different device.";
+    return nullptr;
+  }
+
+  return std::make_unique<fml::MallocMapping>(fml::MallocMapping::Copy(
+      mapping->GetMapping() + sizeof(header), header.data_size));
+}
+
+bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
+                              const vk::PhysicalDeviceProperties& props,
+                              const vk::Device& device,
+                              const vk::PipelineCache& cache) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "PipelineCacheDataPersist");
+  auto [result, data] = device.getPipelineCacheData(cache);
+  if (result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get pipeline cache data to persist: "
+                   << vk::to_string(result);
+    return false;
+  }
+
+  const PipelineCacheHeaderVK header(props, data.size());
+  std::vector<uint8_t> contents(sizeof(header) + data.size());
+  memcpy(contents.data(), &header, sizeof(header));
+  memcpy(contents.data() + sizeof(header), data.data(), data.size());
+
+  fml::DataMapping mapping(std::move(contents));
+  if (!fml::WriteAtomically(cache_directory, kPipelineCacheFileName,
+                            mapping)) {
+    FML_LOG(WARNING) << "Could not write the pipeline cache data to disk.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace impeller
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      The header prepended to the pipeline cache data written to
+///             disk.
+///
+///             Drivers are supposed to reject pipeline cache data they did not
+///             create, but not all of them do so reliably. The data is only
+///             handed to the driver if it was written by the same device and
+///             driver version, and is discarded otherwise.
+///
+struct PipelineCacheHeaderVK {
+  // "IPCV" in little endian byte order.
+  static constexpr uint32_t kSignature = 0x56435049;
+  static constexpr uint32_t kVersion = 1u;
+
+  uint32_t signature = kSignature;
+  uint32_t version = kVersion;
+  uint32_t vendor_id = 0u;
+  uint32_t device_id = 0u;
+  uint32_t driver_version = 0u;
+  uint32_t api_version = 0u;
+  uint8_t uuid[VK_UUID_SIZE] = {};
+  uint64_t data_size = 0u;
+
+  PipelineCacheHeaderVK();
+
+  PipelineCacheHeaderVK(const vk::PhysicalDeviceProperties& props,
+                        uint64_t data_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the data following this header can be used to seed
+  ///             a pipeline cache of a device with the given header.
+  ///
+  bool IsCompatibleWith(const PipelineCacheHeaderVK& other) const;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Reads the pipeline cache data persisted in the cache directory,
+///             returning nullptr if there is none or if it was not written
+///             for this device and driver. The mapping does not include the
+///             header.
+///
+std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
+    const fml::UniqueFD& cache_directory,
+    const vk::PhysicalDeviceProperties& props);
+
+//------------------------------------------------------------------------------
+/// @brief      Writes the data of the pipeline cache to the cache directory,
+///             replacing any data persisted previously. This performs file
+///             IO and should only be called on a worker thread.
+///
+bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
+                              const vk::PhysicalDeviceProperties& props,
+                              const vk::Device& device,
+                              const vk::PipelineCache& cache);
+
+}  // namespace impeller
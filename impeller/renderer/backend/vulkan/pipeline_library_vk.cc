@@ -12,6 +12,7 @@
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_cache_data_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/shader_function_vk.h"
 #include "impeller/renderer/backend/vulkan/vertex_descriptor_vk.h"
@@ -20,15 +21,20 @@ namespace impeller {
 
 PipelineLibraryVK::PipelineLibraryVK(
     const vk::Device& device,
-    const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+    const vk::PhysicalDeviceProperties& physical_device_properties,
+    fml::UniqueFD cache_directory,
     std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner)
-    : worker_task_runner_(std::move(worker_task_runner)) {
+    : physical_device_properties_(physical_device_properties),
+      cache_directory_(std::move(cache_directory)),
+      worker_task_runner_(std::move(worker_task_runner)) {
   if (!worker_task_runner_) {
     return;
   }
 
   vk::PipelineCacheCreateInfo cache_info;
 
+  auto pipeline_cache_data =
+      PipelineCacheDataRetrieve(cache_directory_, physical_device_properties_);
   if (pipeline_cache_data) {
     cache_info.pInitialData = pipeline_cache_data->GetMapping();
     cache_info.initialDataSize = pipeline_cache_data->GetSize();
@@ -36,6 +42,14 @@ PipelineLibraryVK::PipelineLibraryVK(
 
   auto cache = device.createPipelineCacheUnique(cache_info);
 
+  if (cache.result != vk::Result::eSuccess && pipeline_cache_data) {
+    // The driver didn't accept the persisted data. Start with an empty cache
+    // instead.
+    cache_info.pInitialData = nullptr;
+    cache_info.initialDataSize = 0u;
+    cache = device.createPipelineCacheUnique(cache_info);
+  }
+
   if (cache.result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Could not create pipeline cache.";
     return;
@@ -72,9 +86,11 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
   auto pipeline_future =
       PipelineFuture<PipelineDescriptor>{descriptor, promise->get_future()};
   pipelines_[descriptor] = pipeline_future;
+  RecordPipelineCompile();
 
   auto weak_this = weak_from_this();
 
+  pending_pipeline_count_++;
   worker_task_runner_->PostTask([descriptor, weak_this, promise]() {
     auto thiz = weak_this.lock();
     if (!thiz) {
@@ -83,10 +99,15 @@ PipelineFuture<PipelineDescriptor> PipelineLibraryVK::GetPipeline(
                         "could be created.";
       return;
     }
-    auto pipeline_create_info =
-        PipelineLibraryVK::Cast(thiz.get())->CreatePipeline(descriptor);
+    auto library = PipelineLibraryVK::Cast(thiz.get());
+    auto pipeline_create_info = library->CreatePipeline(descriptor);
     promise->set_value(std::make_shared<PipelineVK>(
         weak_this, descriptor, std::move(pipeline_create_info)));
+    // Pipelines are mostly requested in bursts, such as at startup. Persist
+    // the cache once per burst instead of once per pipeline.
+    if (--library->pending_pipeline_count_ == 0u) {
+      library->PersistPipelineCacheToDisk();
+    }
   });
 
   return pipeline_future;
@@ -101,6 +122,16 @@ PipelineFuture<ComputePipelineDescriptor> PipelineLibraryVK::GetPipeline(
   return {descriptor, promise->get_future()};
 }
 
+void PipelineLibraryVK::PersistPipelineCacheToDisk() {
+  if (!cache_directory_.is_valid()) {
+    return;
+  }
+  // See the note in the header about why this is a writer lock.
+  WriterLock lock(cache_mutex_);
+  PipelineCacheDataPersist(cache_directory_, physical_device_properties_,
+                           device_, cache_.get());
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Creates an attachment description that does just enough to
 ///             ensure render pass compatibility with the pass associated later
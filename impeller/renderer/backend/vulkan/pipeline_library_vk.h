@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
-#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/base/backend_cast.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
@@ -29,6 +31,8 @@ class PipelineLibraryVK final
   friend ContextVK;
 
   vk::Device device_;
+  const vk::PhysicalDeviceProperties physical_device_properties_;
+  const fml::UniqueFD cache_directory_;
   // On locking around the pipeline cache: The cache is internally synchronized.
   // So there is no need to hold a writer lock around its use when pipelines are
   // being created. The time it takes for implementations to spend within the
@@ -40,11 +44,15 @@ class PipelineLibraryVK final
   std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner_;
   Mutex pipelines_mutex_;
   PipelineMap pipelines_ IPLR_GUARDED_BY(pipelines_mutex_);
+  // The number of pipelines being created on the workers. The pipeline cache
+  // is persisted once all of them have been created.
+  std::atomic_size_t pending_pipeline_count_ = 0u;
   bool is_valid_ = false;
 
   PipelineLibraryVK(
       const vk::Device& device,
-      const std::shared_ptr<const fml::Mapping>& pipeline_cache_data,
+      const vk::PhysicalDeviceProperties& physical_device_properties,
+      fml::UniqueFD cache_directory,
       std::shared_ptr<fml::ConcurrentTaskRunner> worker_task_runner);
 
   // |PipelineLibrary|
@@ -67,6 +75,11 @@ class PipelineLibraryVK final
 
   vk::UniqueRenderPass CreateRenderPass(const PipelineDescriptor& desc);
 
+  // Writes the pipeline cache to the cache directory so that the pipelines
+  // created in this run don't have to be compiled again in the next one.
+  // Performs file IO and must be called on a worker thread.
+  void PersistPipelineCacheToDisk();
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibraryVK);
 };
 
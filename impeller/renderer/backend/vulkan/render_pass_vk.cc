@@ -392,25 +392,9 @@ static bool AllocateAndBindDescriptorSets(
   vk::PipelineLayout pipeline_layout =
       pipeline_create_info->GetPipelineLayout();
 
-  vk::DescriptorSetAllocateInfo alloc_info;
-  std::array<vk::DescriptorSetLayout, 1> dsls = {
-      pipeline_create_info->GetDescriptorSetLayout(),
-  };
-
-  alloc_info.setDescriptorPool(context.GetDescriptorPool());
-  alloc_info.setSetLayouts(dsls);
-
-  auto [sets_result, sets] =
-      context.GetDevice().allocateDescriptorSetsUnique(alloc_info);
-  if (sets_result != vk::Result::eSuccess) {
-    VALIDATION_LOG << "Failed to allocate descriptor sets: "
-                   << vk::to_string(sets_result);
-    return false;
-  }
-
-  const auto set = MakeSharedVK<vk::DescriptorSet>(std::move(sets[0]));
-
-  if (!encoder.Track(set)) {
+  auto set = encoder.AllocateDescriptorSet(
+      pipeline_create_info->GetDescriptorSetLayout());
+  if (!set.has_value()) {
     return false;
   }
 
@@ -616,6 +600,10 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
       static_cast<uint32_t>(target_size.height);
   pass_info.setClearValues(clear_values);
 
+  encoder->BeginTimedScope(debug_label_);
+  fml::ScopedCleanupClosure end_timed_scope(
+      [&encoder]() { encoder->EndTimedScope(); });
+
   {
     cmd_buffer.beginRenderPass(pass_info, vk::SubpassContents::eInline);
 
@@ -14,8 +14,9 @@ SamplerLibraryVK::SamplerLibraryVK(vk::Device device) : device_(device) {}
 SamplerLibraryVK::~SamplerLibraryVK() = default;
 
 std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
-    SamplerDescriptor desc) {
-  auto found = samplers_.find(desc);
+    const SamplerDescriptor& desc) {
+  const auto key = desc.ToKey();
+  auto found = samplers_.find(key);
   if (found != samplers_.end()) {
     return found->second;
   }
@@ -51,7 +52,7 @@ std::shared_ptr<const Sampler> SamplerLibraryVK::GetSampler(
   if (!sampler->IsValid()) {
     return nullptr;
   }
-  samplers_[desc] = sampler;
+  samplers_[key] = sampler;
   return sampler;
 }
 
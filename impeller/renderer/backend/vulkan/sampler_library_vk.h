@@ -30,7 +30,7 @@ class SamplerLibraryVK final
 
   // |SamplerLibrary|
   std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) override;
+      const SamplerDescriptor& descriptor) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SamplerLibraryVK);
 };
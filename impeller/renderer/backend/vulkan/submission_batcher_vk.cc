@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/submission_batcher_vk.h"
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+
+namespace impeller {
+
+// The most command buffers held back before the batch is submitted. This
+// bounds how long the resources of completed work are kept alive, and how
+// long the GPU may sit idle while a frame is being encoded.
+static constexpr size_t kMaxBatchedCommandBuffers = 32u;
+
+SubmissionBatcherVK::SubmissionBatcherVK(
+    vk::Device device,
+    vk::Queue queue,
+    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    : device_(device), queue_(queue), fence_waiter_(std::move(fence_waiter)) {}
+
+SubmissionBatcherVK::~SubmissionBatcherVK() = default;
+
+bool SubmissionBatcherVK::Enqueue(vk::CommandBuffer command_buffer,
+                                  fml::closure on_completed,
+                                  bool flush) {
+  if (!command_buffer) {
+    return false;
+  }
+  std::scoped_lock lock(batch_mutex_);
+  command_buffers_.push_back(command_buffer);
+  if (on_completed) {
+    callbacks_.push_back(std::move(on_completed));
+  }
+  if (flush || command_buffers_.size() >= kMaxBatchedCommandBuffers) {
+    return FlushLocked();
+  }
+  return true;
+}
+
+bool SubmissionBatcherVK::Flush() {
+  std::scoped_lock lock(batch_mutex_);
+  return FlushLocked();
+}
+
+bool SubmissionBatcherVK::FlushLocked() {
+  if (command_buffers_.empty()) {
+    return true;
+  }
+
+  TRACE_EVENT1("impeller", "SubmissionBatcherVK::Flush", "CommandBuffers",
+               std::to_string(command_buffers_.size()).c_str());
+
+  // Whatever happens, the batch is gone. If the submission fails, the
+  // callbacks are destroyed without being invoked, which releases the
+  // resources of the command buffers.
+  auto command_buffers = std::move(command_buffers_);
+  auto callbacks = std::move(callbacks_);
+  command_buffers_.clear();
+  callbacks_.clear();
+
+  auto [fence_result, fence] = device_.createFenceUnique({});
+  if (fence_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create a fence for the submission.";
+    return false;
+  }
+  vk::SubmitInfo submit_info;
+  submit_info.setCommandBuffers(command_buffers);
+  if (auto result = queue_.submit(submit_info, *fence);
+      result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not submit the command buffers: "
+                   << vk::to_string(result);
+    return false;
+  }
+
+  auto completed = [callbacks = std::move(callbacks)]() {
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+  };
+  return fence_waiter_ && fence_waiter_->AddFence(std::move(fence), completed);
+}
+
+}  // namespace impeller
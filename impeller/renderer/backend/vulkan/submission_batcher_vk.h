@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+
+namespace impeller {
+
+class FenceWaiterVK;
+
+//------------------------------------------------------------------------------
+/// @brief      Collects the command buffers submitted to a queue and submits
+///             them together, with a single fence.
+///
+///             Each queue submission is expensive on some drivers, and a
+///             frame may consist of dozens of command buffers. Batching
+///             preserves the order of the command buffers on the queue, so
+///             the barriers recorded into them still apply.
+///
+///             Batched command buffers are submitted once the batch is
+///             flushed. This happens when a command buffer whose completion
+///             is waited on is added, when the batch is full, and when a
+///             frame is presented. Whoever owns the batcher must flush it
+///             before the queue is waited on.
+///
+class SubmissionBatcherVK {
+ public:
+  SubmissionBatcherVK(vk::Device device,
+                      vk::Queue queue,
+                      std::shared_ptr<FenceWaiterVK> fence_waiter);
+
+  ~SubmissionBatcherVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds an ended command buffer to the batch.
+  ///
+  /// @param[in]  command_buffer  The command buffer. It must stay valid until
+  ///                             the callback is invoked or destroyed.
+  /// @param[in]  on_completed    Invoked on the fence waiter thread once the
+  ///                             command buffer has completed. Destroyed
+  ///                             without being invoked if the submission
+  ///                             fails.
+  /// @param[in]  flush           Whether to submit the batch right away.
+  ///
+  /// @return     If the command buffer was batched, and if requested, the
+  ///             batch was submitted.
+  ///
+  bool Enqueue(vk::CommandBuffer command_buffer,
+               fml::closure on_completed,
+               bool flush);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the batched command buffers, if there are any.
+  ///
+  bool Flush();
+
+ private:
+  const vk::Device device_;
+  const vk::Queue queue_;
+  const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  std::mutex batch_mutex_;
+  std::vector<vk::CommandBuffer> command_buffers_;
+  std::vector<fml::closure> callbacks_;
+
+  bool FlushLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SubmissionBatcherVK);
+};
+
+}  // namespace impeller
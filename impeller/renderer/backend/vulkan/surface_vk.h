@@ -17,10 +17,17 @@ class SurfaceVK final : public Surface {
  public:
   using SwapCallback = std::function<bool(void)>;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps a swapchain image into a surface to render to.
+  ///
+  /// @param[in]  buffer_age  The age of the contents of the image, see
+  ///                         `Surface::GetBufferAge`.
+  ///
   static std::unique_ptr<SurfaceVK> WrapSwapchainImage(
       const std::shared_ptr<Context>& context,
       const std::shared_ptr<SwapchainImageVK>& swapchain_image,
-      SwapCallback swap_callback);
+      SwapCallback swap_callback,
+      size_t buffer_age = 0u);
 
   // |Surface|
   ~SurfaceVK() override;
@@ -28,7 +35,9 @@ class SurfaceVK final : public Surface {
  private:
   SwapCallback swap_callback_;
 
-  SurfaceVK(const RenderTarget& target, SwapCallback swap_callback);
+  SurfaceVK(const RenderTarget& target,
+            SwapCallback swap_callback,
+            size_t buffer_age);
 
   // |Surface|
   bool Present() const override;
@@ -100,6 +100,39 @@ static std::optional<vk::CompositeAlphaFlagBitsKHR> ChooseAlphaCompositionMode(
   return std::nullopt;
 }
 
+static vk::PresentModeKHR ToVKPresentMode(PresentModeVK mode) {
+  switch (mode) {
+    case PresentModeVK::kFifo:
+      return vk::PresentModeKHR::eFifo;
+    case PresentModeVK::kFifoRelaxed:
+      return vk::PresentModeKHR::eFifoRelaxed;
+    case PresentModeVK::kMailbox:
+      return vk::PresentModeKHR::eMailbox;
+  }
+  FML_UNREACHABLE();
+}
+
+static vk::PresentModeKHR ChoosePresentMode(
+    const std::vector<vk::PresentModeKHR>& modes,
+    PresentModeVK preference) {
+  const auto vk_preference = ToVKPresentMode(preference);
+  if (std::find(modes.begin(), modes.end(), vk_preference) != modes.end()) {
+    return vk_preference;
+  }
+  // FIFO is the only present mode all surfaces are required to support.
+  return vk::PresentModeKHR::eFifo;
+}
+
+static uint32_t ChooseImageCount(const vk::SurfaceCapabilitiesKHR& caps,
+                                 uint32_t preference) {
+  const auto count = preference == 0u ? caps.minImageCount + 1u : preference;
+  // A maximum of zero means that there is no limit.
+  const auto max_count =
+      caps.maxImageCount == 0u ? std::numeric_limits<uint32_t>::max()
+                               : caps.maxImageCount;
+  return std::clamp(count, caps.minImageCount, max_count);
+}
+
 static std::optional<vk::Queue> ChoosePresentQueue(
     const vk::PhysicalDevice& physical_device,
     const vk::Device& device,
@@ -119,13 +152,15 @@ static std::optional<vk::Queue> ChoosePresentQueue(
 std::shared_ptr<SwapchainImplVK> SwapchainImplVK::Create(
     const std::shared_ptr<Context>& context,
     vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings,
     vk::SwapchainKHR old_swapchain) {
-  return std::shared_ptr<SwapchainImplVK>(
-      new SwapchainImplVK(context, std::move(surface), old_swapchain));
+  return std::shared_ptr<SwapchainImplVK>(new SwapchainImplVK(
+      context, std::move(surface), settings, old_swapchain));
 }
 
 SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
                                  vk::UniqueSurfaceKHR surface,
+                                 const SwapchainSettingsVK& settings,
                                  vk::SwapchainKHR old_swapchain) {
   if (!context) {
     return;
@@ -156,6 +191,14 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
     return;
   }
 
+  auto [modes_result, modes] =
+      vk_context.GetPhysicalDevice().getSurfacePresentModesKHR(*surface);
+  if (modes_result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not get surface present modes: "
+                   << vk::to_string(modes_result);
+    return;
+  }
+
   const auto composite =
       ChooseAlphaCompositionMode(caps.supportedCompositeAlpha);
   if (!composite.has_value()) {
@@ -176,23 +219,31 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
   swapchain_info.surface = *surface;
   swapchain_info.imageFormat = format.value().format;
   swapchain_info.imageColorSpace = format.value().colorSpace;
-  swapchain_info.presentMode = vk::PresentModeKHR::eFifo;
+  swapchain_info.presentMode =
+      ChoosePresentMode(modes, settings.present_mode);
   swapchain_info.imageExtent = vk::Extent2D{
       std::clamp(caps.currentExtent.width, caps.minImageExtent.width,
                  caps.maxImageExtent.width),
       std::clamp(caps.currentExtent.height, caps.minImageExtent.height,
                  caps.maxImageExtent.height),
   };
-  swapchain_info.minImageCount = std::clamp(
-      caps.minImageCount + 1u, caps.minImageCount, caps.maxImageCount);
+  swapchain_info.minImageCount = ChooseImageCount(caps, settings.image_count);
   swapchain_info.imageArrayLayers = 1u;
   swapchain_info.imageUsage = vk::ImageUsageFlagBits::eColorAttachment;
+  // Damaged regions of a frame are rendered offscreen and copied into the image
+  // that retains the rest of the frame, so only images that can be copied to
+  // retain their contents.
+  const bool retains_contents = !!(caps.supportedUsageFlags &
+                                   vk::ImageUsageFlagBits::eTransferDst);
+  if (retains_contents) {
+    swapchain_info.imageUsage |= vk::ImageUsageFlagBits::eTransferDst;
+  }
   swapchain_info.preTransform = caps.currentTransform;
   swapchain_info.compositeAlpha = composite.value();
   // If we set the clipped value to true, Vulkan expects we will never read back
   // from the buffer. This is analogous to [CAMetalLayer framebufferOnly] in
-  // Metal.
-  swapchain_info.clipped = true;
+  // Metal. The obscured parts of clipped images may not be retained.
+  swapchain_info.clipped = !retains_contents;
   // Setting queue family indices is irrelevant since the present mode is
   // exclusive.
   swapchain_info.imageSharingMode = vk::SharingMode::eExclusive;
@@ -240,14 +291,27 @@ SwapchainImplVK::SwapchainImplVK(const std::shared_ptr<Context>& context,
   }
   FML_DCHECK(!synchronizers.empty());
 
+  if (vk_context.SupportsDisplayTiming() &&
+      (settings.pace_presents || settings.on_present_timing)) {
+    auto [refresh_result, refresh] =
+        vk_context.GetDevice().getRefreshCycleDurationGOOGLE(*swapchain);
+    if (refresh_result == vk::Result::eSuccess) {
+      refresh_duration_ = fml::TimeDelta::FromNanoseconds(
+          static_cast<int64_t>(refresh.refreshDuration));
+    }
+  }
+
   context_ = context;
   surface_ = std::move(surface);
   present_queue_ = present_queue.value();
   surface_format_ = swapchain_info.imageFormat;
   swapchain_ = std::move(swapchain);
   images_ = std::move(swapchain_images);
+  image_present_counts_.resize(images_.size(), 0u);
+  retains_contents_ = retains_contents;
   synchronizers_ = std::move(synchronizers);
   current_frame_ = synchronizers_.size() - 1u;
+  settings_ = settings;
   is_valid_ = true;
 }
 
@@ -272,6 +336,7 @@ SwapchainImplVK::DestroySwapchain() {
   is_valid_ = false;
   synchronizers_.clear();
   images_.clear();
+  image_present_counts_.clear();
   context_.reset();
   return {std::move(surface_), std::move(swapchain_)};
 }
@@ -284,6 +349,10 @@ std::shared_ptr<Context> SwapchainImplVK::GetContext() const {
   return context_.lock();
 }
 
+const SwapchainSettingsVK& SwapchainImplVK::GetSettings() const {
+  return settings_;
+}
+
 SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
   auto context_strong = context_.lock();
   if (!context_strong) {
@@ -331,6 +400,13 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
 
   auto image = images_[index % images_.size()];
   uint32_t image_index = index;
+
+  // The image holds the frame it was last presented with, if any.
+  size_t buffer_age = 0u;
+  if (retains_contents_ && image_present_counts_[image_index] != 0u) {
+    buffer_age = present_count_ + 1u - image_present_counts_[image_index];
+  }
+
   return AcquireResult{SurfaceVK::WrapSwapchainImage(
       context_strong,  // context
       image,           // swapchain image
@@ -340,7 +416,8 @@ SwapchainImplVK::AcquireResult SwapchainImplVK::AcquireNextDrawable() {
           return false;
         }
         return swapchain->Present(image, image_index);
-      }  // swap callback
+      },          // swap callback
+      buffer_age  // buffer age
       )};
 }
 
@@ -356,9 +433,12 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   const auto& sync = synchronizers_[current_frame_];
 
   //----------------------------------------------------------------------------
-  /// Transition the image to color-attachment-optimal.
+  /// Transition the image to present-source, from whichever layout the frame
+  /// left it in. A frame that only repainted a region copied it in.
   ///
-  {
+  if (const auto old_layout =
+          image->SetLayout(vk::ImageLayout::ePresentSrcKHR);
+      old_layout != vk::ImageLayout::ePresentSrcKHR) {
     auto cmd_buffer = context.CreateCommandBuffer();
     if (!cmd_buffer) {
       return false;
@@ -367,17 +447,19 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     auto vk_cmd_buffer =
         CommandBufferVK::Cast(*cmd_buffer).GetEncoder()->GetCommandBuffer();
     vk::ImageMemoryBarrier image_barrier;
-    image_barrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite;
+    image_barrier.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite |
+                                  vk::AccessFlagBits::eTransferWrite;
     image_barrier.dstAccessMask = vk::AccessFlagBits::eColorAttachmentRead;
     image_barrier.image = image->GetVKImage();
-    image_barrier.oldLayout = vk::ImageLayout::eColorAttachmentOptimal;
+    image_barrier.oldLayout = old_layout;
     image_barrier.newLayout = vk::ImageLayout::ePresentSrcKHR;
     image_barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
     image_barrier.subresourceRange.baseMipLevel = 0u;
     image_barrier.subresourceRange.levelCount = 1u;
     image_barrier.subresourceRange.baseArrayLayer = 0u;
     image_barrier.subresourceRange.layerCount = 1u;
-    vk_cmd_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllGraphics,  //
+    // The copy of a repainted region is a transfer, not a graphics command.
+    vk_cmd_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,  //
                                   vk::PipelineStageFlagBits::eAllGraphics,  //
                                   {},                                       //
                                   nullptr,                                  //
@@ -389,6 +471,13 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
     }
   }
 
+  //----------------------------------------------------------------------------
+  /// Submit the commands of the frame, which were batched until now.
+  ///
+  if (!context.FlushSubmissions()) {
+    return false;
+  }
+
   //----------------------------------------------------------------------------
   /// Signal that the presentation semaphore is ready.
   ///
@@ -418,15 +507,27 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   present_info.setImageIndices(indices);
   present_info.setWaitSemaphores(*sync->present_ready);
 
+  vk::PresentTimeGOOGLE present_time;
+  vk::PresentTimesInfoGOOGLE present_times;
+  if (refresh_duration_.has_value()) {
+    CollectPresentTimings(context.GetDevice());
+    present_time.presentID = next_present_id_++;
+    present_time.desiredPresentTime =
+        GetDesiredPresentTime(present_time.presentID);
+    present_times.setTimes(present_time);
+    present_info.setPNext(&present_times);
+  }
+
   switch (auto result = present_queue_.presentKHR(present_info)) {
     case vk::Result::eErrorOutOfDateKHR:
       // Caller will recreate the impl on acquisition, not submission.
       [[fallthrough]];
     case vk::Result::eErrorSurfaceLostKHR:
       // Vulkan guarantees that the set of queue operations will still complete
-      // successfully.
-      [[fallthrough]];
+      // successfully. The image may not have been presented though.
+      return true;
     case vk::Result::eSuccess:
+      image_present_counts_[index] = ++present_count_;
       return true;
     default:
       VALIDATION_LOG << "Could not present queue: " << vk::to_string(result);
@@ -436,4 +537,46 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
   return false;
 }
 
+void SwapchainImplVK::CollectPresentTimings(const vk::Device& device) {
+  auto [result, timings] = device.getPastPresentationTimingGOOGLE(*swapchain_);
+  if (result != vk::Result::eSuccess) {
+    return;
+  }
+  for (const auto& timing : timings) {
+    if (timing.presentID <= last_timed_present_id_) {
+      continue;
+    }
+    last_timed_present_id_ = timing.presentID;
+    last_actual_present_time_ = timing.actualPresentTime;
+    if (!settings_.on_present_timing) {
+      continue;
+    }
+    auto to_time_point = [](uint64_t nanoseconds) {
+      return fml::TimePoint::FromEpochDelta(
+          fml::TimeDelta::FromNanoseconds(static_cast<int64_t>(nanoseconds)));
+    };
+    settings_.on_present_timing(PresentTimingVK{
+        .present_id = timing.presentID,
+        .desired_present_time = to_time_point(timing.desiredPresentTime),
+        .actual_present_time = to_time_point(timing.actualPresentTime),
+        .present_margin = fml::TimeDelta::FromNanoseconds(
+            static_cast<int64_t>(timing.presentMargin)),
+    });
+  }
+}
+
+uint64_t SwapchainImplVK::GetDesiredPresentTime(uint32_t present_id) const {
+  if (!settings_.pace_presents || last_actual_present_time_ == 0u) {
+    // Present as soon as possible.
+    return 0u;
+  }
+  // Aim for one refresh cycle after each of the presents since the last one
+  // with a known time. Aiming half a cycle early makes sure that jitter in
+  // the reported times doesn't push the present back by a whole cycle.
+  const auto refresh =
+      static_cast<uint64_t>(refresh_duration_->ToNanoseconds());
+  const auto cycles = present_id - last_timed_present_id_;
+  return last_actual_present_time_ + refresh * cycles - refresh / 2u;
+}
+
 }  // namespace impeller
@@ -5,9 +5,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <variant>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
@@ -31,6 +33,7 @@ class SwapchainImplVK final
   static std::shared_ptr<SwapchainImplVK> Create(
       const std::shared_ptr<Context>& context,
       vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings,
       vk::SwapchainKHR old_swapchain = VK_NULL_HANDLE);
 
   ~SwapchainImplVK();
@@ -53,6 +56,8 @@ class SwapchainImplVK final
 
   std::shared_ptr<Context> GetContext() const;
 
+  const SwapchainSettingsVK& GetSettings() const;
+
   std::pair<vk::UniqueSurfaceKHR, vk::UniqueSwapchainKHR> DestroySwapchain();
 
  private:
@@ -62,16 +67,34 @@ class SwapchainImplVK final
   vk::Format surface_format_ = vk::Format::eUndefined;
   vk::UniqueSwapchainKHR swapchain_;
   std::vector<std::shared_ptr<SwapchainImageVK>> images_;
+  // Whether the images retain their contents between frames, so that a frame
+  // only needs to repaint what changed since the frame its image holds.
+  bool retains_contents_ = false;
+  // The number of frames presented, and for each image the number of frames
+  // that had been presented when it was last presented, or 0 if never.
+  uint64_t present_count_ = 0u;
+  std::vector<uint64_t> image_present_counts_;
   std::vector<std::unique_ptr<FrameSynchronizer>> synchronizers_;
   size_t current_frame_ = 0u;
+  SwapchainSettingsVK settings_;
+  // Only set if VK_GOOGLE_display_timing is enabled and the settings use it.
+  std::optional<fml::TimeDelta> refresh_duration_;
+  uint32_t next_present_id_ = 1u;
+  uint32_t last_timed_present_id_ = 0u;
+  uint64_t last_actual_present_time_ = 0u;
   bool is_valid_ = false;
 
   SwapchainImplVK(const std::shared_ptr<Context>& context,
                   vk::UniqueSurfaceKHR surface,
+                  const SwapchainSettingsVK& settings,
                   vk::SwapchainKHR old_swapchain);
 
   bool Present(const std::shared_ptr<SwapchainImageVK>& image, uint32_t index);
 
+  void CollectPresentTimings(const vk::Device& device);
+
+  uint64_t GetDesiredPresentTime(uint32_t present_id) const;
+
   void WaitIdle() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(SwapchainImplVK);
@@ -11,8 +11,9 @@ namespace impeller {
 
 std::shared_ptr<SwapchainVK> SwapchainVK::Create(
     const std::shared_ptr<Context>& context,
-    vk::UniqueSurfaceKHR surface) {
-  auto impl = SwapchainImplVK::Create(context, std::move(surface));
+    vk::UniqueSurfaceKHR surface,
+    const SwapchainSettingsVK& settings) {
+  auto impl = SwapchainImplVK::Create(context, std::move(surface), settings);
   if (!impl || !impl->IsValid()) {
     return nullptr;
   }
@@ -45,10 +46,12 @@ std::unique_ptr<Surface> SwapchainVK::AcquireNextDrawable() {
   // This swapchain implementation indicates that it is out of date. Tear it
   // down and make a new one.
   auto context = impl_->GetContext();
+  auto settings = impl_->GetSettings();
   auto [surface, old_swapchain] = impl_->DestroySwapchain();
 
   auto new_impl = SwapchainImplVK::Create(context,             //
                                           std::move(surface),  //
+                                          settings,            //
                                           *old_swapchain       //
   );
   if (!new_impl || !new_impl->IsValid()) {
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/surface.h"
@@ -15,6 +17,51 @@ namespace impeller {
 
 class SwapchainImplVK;
 
+enum class PresentModeVK {
+  /// Images are presented at vsync in the order they were queued. Never
+  /// tears, but queued images add latency.
+  kFifo,
+  /// Like |kFifo|, except that an image that misses a vsync is presented
+  /// immediately, which may tear.
+  kFifoRelaxed,
+  /// At each vsync the most recently queued image is presented, and the
+  /// other queued images are discarded. Lowest latency without tearing, but
+  /// frames may be rendered and never shown.
+  kMailbox,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      The presentation timing of an image, as reported by
+///             VK_GOOGLE_display_timing.
+///
+struct PresentTimingVK {
+  /// The sequential identifier of the present.
+  uint32_t present_id = 0u;
+  /// The time that the image was requested to be presented at, or the epoch
+  /// if presents are not paced.
+  fml::TimePoint desired_present_time;
+  /// The time that the image was actually presented at.
+  fml::TimePoint actual_present_time;
+  /// How early the image was ready before it was presented.
+  fml::TimeDelta present_margin;
+};
+
+struct SwapchainSettingsVK {
+  /// The present mode to use if the surface supports it. Surfaces always
+  /// support |PresentModeVK::kFifo|, which is used otherwise.
+  PresentModeVK present_mode = PresentModeVK::kFifo;
+  /// The number of swapchain images to request, clamped to the range
+  /// supported by the surface. Zero requests one more than the minimum.
+  uint32_t image_count = 0u;
+  /// Whether to space presents out by the refresh cycle of the display if
+  /// VK_GOOGLE_display_timing is supported, so that frames are not shown in
+  /// bursts after the GPU catches up with a backlog.
+  bool pace_presents = false;
+  /// If VK_GOOGLE_display_timing is supported, called on the thread that
+  /// presents images as the timings of past presents become available.
+  std::function<void(const PresentTimingVK&)> on_present_timing;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A swapchain that adapts to the underlying surface going out of
 ///             date. If the caller cannot acquire the next drawable, it is due
@@ -25,7 +72,8 @@ class SwapchainVK {
  public:
   static std::shared_ptr<SwapchainVK> Create(
       const std::shared_ptr<Context>& context,
-      vk::UniqueSurfaceKHR surface);
+      vk::UniqueSurfaceKHR surface,
+      const SwapchainSettingsVK& settings = {});
 
   ~SwapchainVK();
 
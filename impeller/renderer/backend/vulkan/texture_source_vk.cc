@@ -13,4 +13,16 @@ bool TextureSourceVK::SetContents(const TextureDescriptor& desc,
   return false;
 }
 
+vk::ImageLayout TextureSourceVK::GetLayout() const {
+  ReaderLock lock(layout_mutex_);
+  return layout_;
+}
+
+vk::ImageLayout TextureSourceVK::SetLayout(vk::ImageLayout layout) const {
+  WriterLock lock(layout_mutex_);
+  const auto old_layout = layout_;
+  layout_ = layout;
+  return old_layout;
+}
+
 }  // namespace impeller
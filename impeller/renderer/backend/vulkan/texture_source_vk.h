@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 #include "impeller/renderer/texture_descriptor.h"
 
@@ -22,6 +23,26 @@ class TextureSourceVK {
   virtual vk::Image GetVKImage() const = 0;
 
   virtual vk::ImageView GetVKImageView() const = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The layout of the image. It belongs to the image rather than
+  ///             to the textures that wrap it, so that the layout of an image
+  ///             that is wrapped again for each frame, like a swapchain image,
+  ///             is known and its contents can be retained.
+  ///
+  vk::ImageLayout GetLayout() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Records the layout of the image after a transition.
+  ///
+  /// @return     The previous layout of the image.
+  ///
+  vk::ImageLayout SetLayout(vk::ImageLayout layout) const;
+
+ private:
+  mutable RWMutex layout_mutex_;
+  mutable vk::ImageLayout layout_ IPLR_GUARDED_BY(layout_mutex_) =
+      vk::ImageLayout::eUndefined;
 };
 
 }  // namespace impeller
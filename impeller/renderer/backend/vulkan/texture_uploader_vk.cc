@@ -0,0 +1,410 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/texture_uploader_vk.h"
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/shared_object_vk.h"
+#include "impeller/renderer/backend/vulkan/texture_vk.h"
+
+namespace impeller {
+
+// The alignment of the regions of the staging ring. Buffer offsets of copies
+// to images must be a multiple of both 4 and the texel size of the image.
+static constexpr size_t kStagingAlignment = 16u;
+
+static size_t AlignTo(size_t value, size_t alignment) {
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+StagingRingVK::StagingRingVK(std::shared_ptr<DeviceBuffer> buffer,
+                             size_t size)
+    : buffer_(std::move(buffer)), size_(size) {}
+
+StagingRingVK::~StagingRingVK() = default;
+
+const std::shared_ptr<DeviceBuffer>& StagingRingVK::GetBuffer() const {
+  return buffer_;
+}
+
+std::optional<size_t> StagingRingVK::Allocate(size_t length) {
+  if (length == 0u || length > size_) {
+    return std::nullopt;
+  }
+  Lock lock(regions_mutex_);
+  size_t offset = 0u;
+  if (!regions_.empty()) {
+    const auto& oldest = regions_.front();
+    const auto& newest = regions_.back();
+    const auto end = AlignTo(newest.offset + newest.length, kStagingAlignment);
+    if (newest.offset >= oldest.offset) {
+      // The allocated regions are contiguous. Allocate after them, or wrap
+      // around to before them.
+      if (end + length <= size_) {
+        offset = end;
+      } else if (length <= oldest.offset) {
+        offset = 0u;
+      } else {
+        return std::nullopt;
+      }
+    } else {
+      // The allocated regions have wrapped around. Allocate in the space
+      // between the newest and the oldest region.
+      if (end + length > oldest.offset) {
+        return std::nullopt;
+      }
+      offset = end;
+    }
+  }
+  regions_.push_back({offset, length, false});
+  return offset;
+}
+
+void StagingRingVK::Release(size_t offset) {
+  Lock lock(regions_mutex_);
+  for (auto& region : regions_) {
+    if (region.offset == offset && !region.released) {
+      region.released = true;
+      break;
+    }
+  }
+  while (!regions_.empty() && regions_.front().released) {
+    regions_.pop_front();
+  }
+}
+
+std::shared_ptr<TextureUploaderVK> TextureUploaderVK::Create(
+    vk::Device device,
+    std::weak_ptr<Allocator> allocator,
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    vk::Queue graphics_queue,
+    uint32_t graphics_queue_family_index,
+    vk::Queue transfer_queue,
+    uint32_t transfer_queue_family_index) {
+  auto uploader = std::shared_ptr<TextureUploaderVK>(new TextureUploaderVK(
+      device,                       //
+      std::move(allocator),         //
+      std::move(fence_waiter),      //
+      graphics_queue,               //
+      graphics_queue_family_index,  //
+      transfer_queue,               //
+      transfer_queue_family_index   //
+      ));
+  if (!uploader->IsValid()) {
+    return nullptr;
+  }
+  return uploader;
+}
+
+TextureUploaderVK::TextureUploaderVK(
+    vk::Device device,
+    std::weak_ptr<Allocator> allocator,
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    vk::Queue graphics_queue,
+    uint32_t graphics_queue_family_index,
+    vk::Queue transfer_queue,
+    uint32_t transfer_queue_family_index)
+    : device_(device),
+      allocator_(std::move(allocator)),
+      fence_waiter_(std::move(fence_waiter)),
+      graphics_queue_(graphics_queue),
+      graphics_queue_family_index_(graphics_queue_family_index),
+      transfer_queue_(transfer_queue),
+      transfer_queue_family_index_(transfer_queue_family_index) {
+  auto strong_allocator = allocator_.lock();
+  if (!strong_allocator || !fence_waiter_) {
+    return;
+  }
+
+  auto ring_buffer = strong_allocator->CreateBuffer(
+      {.storage_mode = StorageMode::kHostVisible, .size = kStagingRingSize});
+  if (!ring_buffer) {
+    VALIDATION_LOG << "Could not create the staging buffer.";
+    return;
+  }
+  ring_buffer->SetLabel("Texture Staging Ring");
+
+  auto create_pool = [&](uint32_t queue_family_index) {
+    vk::CommandPoolCreateInfo pool_info;
+    pool_info.queueFamilyIndex = queue_family_index;
+    pool_info.flags = vk::CommandPoolCreateFlagBits::eTransient;
+    return device_.createCommandPoolUnique(pool_info);
+  };
+  auto graphics_pool = create_pool(graphics_queue_family_index_);
+  if (graphics_pool.result != vk::Result::eSuccess) {
+    VALIDATION_LOG << "Could not create the upload command pool.";
+    return;
+  }
+  Lock lock(pools_mutex_);
+  if (HasDedicatedTransferQueue()) {
+    auto transfer_pool = create_pool(transfer_queue_family_index_);
+    if (transfer_pool.result != vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not create the transfer command pool.";
+      return;
+    }
+    transfer_pool_ = std::move(transfer_pool.value);
+  }
+  graphics_pool_ = std::move(graphics_pool.value);
+  staging_ring_ =
+      std::make_unique<StagingRingVK>(std::move(ring_buffer), kStagingRingSize);
+  is_valid_ = true;
+}
+
+TextureUploaderVK::~TextureUploaderVK() = default;
+
+bool TextureUploaderVK::IsValid() const {
+  return is_valid_;
+}
+
+bool TextureUploaderVK::HasDedicatedTransferQueue() const {
+  return transfer_queue_family_index_ != graphics_queue_family_index_;
+}
+
+static vk::CommandBuffer AllocateCommandBuffer(const vk::Device& device,
+                                               const vk::CommandPool& pool) {
+  vk::CommandBufferAllocateInfo alloc_info;
+  alloc_info.commandPool = pool;
+  alloc_info.commandBufferCount = 1u;
+  alloc_info.level = vk::CommandBufferLevel::ePrimary;
+  auto [result, buffers] = device.allocateCommandBuffers(alloc_info);
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+  vk::CommandBufferBeginInfo begin_info;
+  begin_info.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+  if (buffers[0].begin(begin_info) != vk::Result::eSuccess) {
+    device.freeCommandBuffers(pool, buffers);
+    return {};
+  }
+  return buffers[0];
+}
+
+void TextureUploaderVK::FreeCommandBuffers(vk::CommandBuffer copy_buffer,
+                                           vk::CommandBuffer acquire_buffer) {
+  Lock lock(pools_mutex_);
+  if (copy_buffer) {
+    device_.freeCommandBuffers(
+        HasDedicatedTransferQueue() ? *transfer_pool_ : *graphics_pool_,
+        copy_buffer);
+  }
+  if (acquire_buffer) {
+    device_.freeCommandBuffers(*graphics_pool_, acquire_buffer);
+  }
+}
+
+bool TextureUploaderVK::Upload(const TextureVK& texture,
+                               std::shared_ptr<TextureSourceVK> source,
+                               const uint8_t* contents,
+                               size_t length,
+                               size_t slice) {
+  if (!IsValid() || !source || !contents) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "TextureUploaderVK::Upload");
+
+  //----------------------------------------------------------------------------
+  /// Stage the contents.
+  ///
+  std::shared_ptr<DeviceBuffer> staging_buffer;
+  size_t staging_offset = 0u;
+  fml::ScopedCleanupClosure release_staging;
+  if (auto offset = staging_ring_->Allocate(length); offset.has_value()) {
+    staging_buffer = staging_ring_->GetBuffer();
+    staging_offset = offset.value();
+    release_staging.SetClosure(
+        [weak_this = weak_from_this(), offset = staging_offset]() {
+          if (auto thiz = weak_this.lock()) {
+            thiz->staging_ring_->Release(offset);
+          }
+        });
+  } else {
+    auto allocator = allocator_.lock();
+    if (!allocator) {
+      return false;
+    }
+    staging_buffer = allocator->CreateBuffer(
+        {.storage_mode = StorageMode::kHostVisible, .size = length});
+    if (!staging_buffer) {
+      return false;
+    }
+  }
+  if (!staging_buffer->CopyHostBuffer(contents, Range{0u, length},
+                                      staging_offset)) {
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  /// Record the copy.
+  ///
+  const auto dedicated = HasDedicatedTransferQueue();
+  const auto& desc = texture.GetTextureDescriptor();
+
+  vk::ImageSubresourceRange range;
+  range.aspectMask = vk::ImageAspectFlagBits::eColor;
+  range.baseMipLevel = 0u;
+  range.levelCount = VK_REMAINING_MIP_LEVELS;
+  range.baseArrayLayer = static_cast<uint32_t>(slice);
+  range.layerCount = 1u;
+
+  vk::CommandBuffer copy_buffer;
+  vk::CommandBuffer acquire_buffer;
+  {
+    Lock lock(pools_mutex_);
+    copy_buffer = AllocateCommandBuffer(
+        device_, dedicated ? *transfer_pool_ : *graphics_pool_);
+    if (dedicated && copy_buffer) {
+      acquire_buffer = AllocateCommandBuffer(device_, *graphics_pool_);
+    }
+    if (!copy_buffer || (dedicated && !acquire_buffer)) {
+      VALIDATION_LOG << "Could not allocate the upload command buffers.";
+      if (copy_buffer) {
+        // The acquire buffer is only missing when the copy buffer came from
+        // the transfer pool.
+        device_.freeCommandBuffers(*transfer_pool_, copy_buffer);
+      }
+      return false;
+    }
+
+    // The whole contents of the slice are replaced, so its previous contents
+    // don't need to be preserved.
+    vk::ImageMemoryBarrier to_transfer_dst;
+    to_transfer_dst.srcAccessMask = {};
+    to_transfer_dst.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+    to_transfer_dst.oldLayout = vk::ImageLayout::eUndefined;
+    to_transfer_dst.newLayout = vk::ImageLayout::eTransferDstOptimal;
+    to_transfer_dst.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    to_transfer_dst.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    to_transfer_dst.image = texture.GetImage();
+    to_transfer_dst.subresourceRange = range;
+    copy_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,  //
+                                vk::PipelineStageFlagBits::eTransfer,   //
+                                {},                                     //
+                                nullptr,                                //
+                                nullptr,                                //
+                                to_transfer_dst                         //
+    );
+
+    vk::BufferImageCopy image_copy;
+    image_copy.setBufferOffset(staging_offset);
+    image_copy.setBufferRowLength(0u);
+    image_copy.setBufferImageHeight(0u);
+    image_copy.setImageSubresource(vk::ImageSubresourceLayers(
+        vk::ImageAspectFlagBits::eColor, 0u, range.baseArrayLayer, 1u));
+    image_copy.setImageOffset(vk::Offset3D(0, 0, 0));
+    image_copy.setImageExtent(
+        vk::Extent3D(desc.size.width, desc.size.height, 1u));
+    copy_buffer.copyBufferToImage(
+        DeviceBufferVK::Cast(*staging_buffer).GetVKBufferHandle(),  //
+        texture.GetImage(),                                         //
+        vk::ImageLayout::eTransferDstOptimal,                       //
+        image_copy                                                  //
+    );
+
+    // When the copy is performed on the transfer queue, this barrier
+    // releases the image to the graphics queue family, and an identical one
+    // acquires it there.
+    vk::ImageMemoryBarrier to_shader_read;
+    to_shader_read.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    to_shader_read.dstAccessMask =
+        dedicated ? vk::AccessFlags{} : vk::AccessFlagBits::eShaderRead;
+    to_shader_read.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    to_shader_read.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+    to_shader_read.srcQueueFamilyIndex =
+        dedicated ? transfer_queue_family_index_ : VK_QUEUE_FAMILY_IGNORED;
+    to_shader_read.dstQueueFamilyIndex =
+        dedicated ? graphics_queue_family_index_ : VK_QUEUE_FAMILY_IGNORED;
+    to_shader_read.image = texture.GetImage();
+    to_shader_read.subresourceRange = range;
+    copy_buffer.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,                 //
+        dedicated ? vk::PipelineStageFlagBits::eBottomOfPipe  //
+                  : vk::PipelineStageFlagBits::eAllGraphics,  //
+        {},                                                   //
+        nullptr,                                              //
+        nullptr,                                              //
+        to_shader_read                                        //
+    );
+
+    if (dedicated) {
+      to_shader_read.srcAccessMask = {};
+      to_shader_read.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+      acquire_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
+                                     vk::PipelineStageFlagBits::eAllGraphics,
+                                     {}, nullptr, nullptr, to_shader_read);
+    }
+  }
+
+  texture.SetLayoutWithoutEncoding(vk::ImageLayout::eShaderReadOnlyOptimal);
+
+  //----------------------------------------------------------------------------
+  /// Submit the copy.
+  ///
+  fml::ScopedCleanupClosure free_buffers(
+      [weak_this = weak_from_this(), copy_buffer, acquire_buffer]() {
+        if (auto thiz = weak_this.lock()) {
+          thiz->FreeCommandBuffers(copy_buffer, acquire_buffer);
+        }
+      });
+  if (copy_buffer.end() != vk::Result::eSuccess ||
+      (acquire_buffer && acquire_buffer.end() != vk::Result::eSuccess)) {
+    return false;
+  }
+  auto [fence_result, fence] = device_.createFenceUnique({});
+  if (fence_result != vk::Result::eSuccess) {
+    return false;
+  }
+
+  std::shared_ptr<SharedObjectVK> semaphore;
+  if (dedicated) {
+    auto [semaphore_result, transfer_done] = device_.createSemaphoreUnique({});
+    if (semaphore_result != vk::Result::eSuccess) {
+      return false;
+    }
+    vk::SubmitInfo transfer_submit;
+    transfer_submit.setCommandBuffers(copy_buffer);
+    transfer_submit.setSignalSemaphores(*transfer_done);
+    if (transfer_queue_.submit(transfer_submit, nullptr) !=
+        vk::Result::eSuccess) {
+      return false;
+    }
+    // The copy is now in flight, and the buffers must not be freed until
+    // the fence of the acquisition signals.
+    vk::PipelineStageFlags wait_stage = vk::PipelineStageFlagBits::eAllGraphics;
+    vk::SubmitInfo acquire_submit;
+    acquire_submit.setWaitSemaphores(*transfer_done);
+    acquire_submit.setWaitDstStageMask(wait_stage);
+    acquire_submit.setCommandBuffers(acquire_buffer);
+    if (graphics_queue_.submit(acquire_submit, *fence) !=
+        vk::Result::eSuccess) {
+      VALIDATION_LOG << "Could not submit the upload acquisition.";
+      // The transfer may still be executing.
+      [[maybe_unused]] auto result = transfer_queue_.waitIdle();
+      return false;
+    }
+    semaphore = MakeSharedVK(std::move(transfer_done));
+  } else {
+    vk::SubmitInfo submit;
+    submit.setCommandBuffers(copy_buffer);
+    if (graphics_queue_.submit(submit, *fence) != vk::Result::eSuccess) {
+      return false;
+    }
+  }
+
+  // Everything the copy uses is released once it completes.
+  auto completed = [free_buffers = free_buffers.Release(),
+                    release_staging = release_staging.Release(),
+                    source = std::move(source), staging_buffer, semaphore]() {
+    free_buffers();
+    if (release_staging) {
+      release_staging();
+    }
+  };
+  return fence_waiter_->AddFence(std::move(fence), completed);
+}
+
+}  // namespace impeller
@@ -0,0 +1,143 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/backend/vulkan/vk.h"
+#include "impeller/renderer/device_buffer.h"
+
+namespace impeller {
+
+class FenceWaiterVK;
+class TextureSourceVK;
+class TextureVK;
+
+//------------------------------------------------------------------------------
+/// @brief      A persistently mapped host visible buffer that the contents of
+///             textures are staged in before they are copied to the texture.
+///
+///             Regions are allocated from the buffer as a ring, and are
+///             released once the copies out of them have completed. This
+///             object is thread-safe.
+///
+class StagingRingVK {
+ public:
+  StagingRingVK(std::shared_ptr<DeviceBuffer> buffer, size_t size);
+
+  ~StagingRingVK();
+
+  const std::shared_ptr<DeviceBuffer>& GetBuffer() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates a region of the buffer, returning its offset, or
+  ///             std::nullopt if the ring doesn't have enough free space.
+  ///
+  std::optional<size_t> Allocate(size_t length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the region at the offset returned by |Allocate|.
+  ///             Regions may be released in any order.
+  ///
+  void Release(size_t offset);
+
+ private:
+  struct Region {
+    size_t offset = 0u;
+    size_t length = 0u;
+    bool released = false;
+  };
+
+  const std::shared_ptr<DeviceBuffer> buffer_;
+  const size_t size_;
+  Mutex regions_mutex_;
+  // The allocated regions, oldest first.
+  std::deque<Region> regions_ IPLR_GUARDED_BY(regions_mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StagingRingVK);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Uploads the contents of textures through a staging buffer.
+///
+///             If the device has a queue family dedicated to transfers, the
+///             copies are performed on it, asynchronously with rendering. The
+///             ownership of the textures is then transferred to the graphics
+///             queue family, which waits for the copy with a semaphore.
+///             Otherwise the copies are performed on the graphics queue.
+///
+class TextureUploaderVK
+    : public std::enable_shared_from_this<TextureUploaderVK> {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the staging ring. Uploads larger than this, or
+  ///             that don't fit in the free space of the ring, get a staging
+  ///             buffer of their own.
+  ///
+  static constexpr size_t kStagingRingSize = 16u * 1024u * 1024u;
+
+  static std::shared_ptr<TextureUploaderVK> Create(
+      vk::Device device,
+      std::weak_ptr<Allocator> allocator,
+      std::shared_ptr<FenceWaiterVK> fence_waiter,
+      vk::Queue graphics_queue,
+      uint32_t graphics_queue_family_index,
+      vk::Queue transfer_queue,
+      uint32_t transfer_queue_family_index);
+
+  ~TextureUploaderVK();
+
+  bool IsValid() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the contents to the given slice of the base mip level
+  ///             of the texture, leaving the texture in the shader read only
+  ///             layout. The copy is complete before any commands submitted
+  ///             to the graphics queue after this call are executed.
+  ///
+  bool Upload(const TextureVK& texture,
+              std::shared_ptr<TextureSourceVK> source,
+              const uint8_t* contents,
+              size_t length,
+              size_t slice);
+
+ private:
+  const vk::Device device_;
+  const std::weak_ptr<Allocator> allocator_;
+  const std::shared_ptr<FenceWaiterVK> fence_waiter_;
+  const vk::Queue graphics_queue_;
+  const uint32_t graphics_queue_family_index_;
+  const vk::Queue transfer_queue_;
+  const uint32_t transfer_queue_family_index_;
+  std::unique_ptr<StagingRingVK> staging_ring_;
+  // Command pools may only be used by one thread at a time, which includes
+  // recording and freeing the command buffers allocated from them.
+  Mutex pools_mutex_;
+  vk::UniqueCommandPool graphics_pool_ IPLR_GUARDED_BY(pools_mutex_);
+  vk::UniqueCommandPool transfer_pool_ IPLR_GUARDED_BY(pools_mutex_);
+  bool is_valid_ = false;
+
+  TextureUploaderVK(vk::Device device,
+                    std::weak_ptr<Allocator> allocator,
+                    std::shared_ptr<FenceWaiterVK> fence_waiter,
+                    vk::Queue graphics_queue,
+                    uint32_t graphics_queue_family_index,
+                    vk::Queue transfer_queue,
+                    uint32_t transfer_queue_family_index);
+
+  bool HasDedicatedTransferQueue() const;
+
+  void FreeCommandBuffers(vk::CommandBuffer copy_buffer,
+                          vk::CommandBuffer acquire_buffer);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextureUploaderVK);
+};
+
+}  // namespace impeller
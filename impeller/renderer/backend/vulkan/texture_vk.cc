@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/texture_vk.h"
 
+#include "impeller/renderer/backend/vulkan/texture_uploader_vk.h"
+
 namespace impeller {
 
 TextureVK::TextureVK(TextureDescriptor desc,
@@ -37,6 +39,15 @@ bool TextureVK::OnSetContents(const uint8_t* contents,
     return false;
   }
 
+  // Copy the contents through a staging buffer if possible. Writing to the
+  // memory of the texture directly only works for host visible textures.
+  if (auto context = context_.lock()) {
+    const auto& uploader = ContextVK::Cast(*context).GetTextureUploader();
+    if (uploader && uploader->Upload(*this, source_, contents, length, slice)) {
+      return true;
+    }
+  }
+
   return source_->SetContents(desc, contents, length, slice);
 }
 
@@ -68,6 +79,9 @@ static constexpr vk::ImageAspectFlags ToImageAspectFlags(
   switch (layout) {
     case vk::ImageLayout::eColorAttachmentOptimal:
     case vk::ImageLayout::eShaderReadOnlyOptimal:
+    case vk::ImageLayout::eTransferSrcOptimal:
+    case vk::ImageLayout::eTransferDstOptimal:
+    case vk::ImageLayout::ePresentSrcKHR:
       return vk::ImageAspectFlagBits::eColor;
     case vk::ImageLayout::eDepthAttachmentOptimal:
       return vk::ImageAspectFlagBits::eDepth;
@@ -81,16 +95,12 @@ static constexpr vk::ImageAspectFlags ToImageAspectFlags(
 }
 
 vk::ImageLayout TextureVK::GetLayout() const {
-  ReaderLock lock(layout_mutex_);
-  return layout_;
+  return source_->GetLayout();
 }
 
 vk::ImageLayout TextureVK::SetLayoutWithoutEncoding(
     vk::ImageLayout layout) const {
-  WriterLock lock(layout_mutex_);
-  const auto old_layout = layout_;
-  layout_ = layout;
-  return old_layout;
+  return source_->SetLayout(layout);
 }
 
 bool TextureVK::SetLayout(vk::ImageLayout new_layout,
@@ -84,6 +84,30 @@ class BlitPass {
                size_t destination_offset = 0,
                std::string label = "");
 
+  //----------------------------------------------------------------------------
+  /// @brief      Record a command to copy the contents of the buffer to a
+  ///             region of the texture.
+  ///             No work is encoded into the command buffer at this time.
+  ///
+  /// @param[in]  source              The buffer to read for copying. The rows
+  ///                                 of pixels must be tightly packed.
+  /// @param[in]  destination         The texture to overwrite using the source
+  ///                                 contents.
+  /// @param[in]  destination_region  The region of the destination texture to
+  ///                                 overwrite. Must be within the texture.
+  /// @param[in]  source_offset       The offset to start reading from in the
+  ///                                 source buffer.
+  /// @param[in]  label               The optional debug label to give the
+  ///                                 command.
+  ///
+  /// @return     If the command was valid for subsequent commitment.
+  ///
+  bool AddCopy(std::shared_ptr<DeviceBuffer> source,
+               std::shared_ptr<Texture> destination,
+               IRect destination_region,
+               size_t source_offset = 0,
+               std::string label = "");
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command to generate all mip levels for a texture.
   ///             No work is encoded into the command buffer at this time.
@@ -127,6 +151,13 @@ class BlitPass {
       size_t destination_offset,
       std::string label) = 0;
 
+  virtual bool OnCopyBufferToTextureCommand(
+      std::shared_ptr<DeviceBuffer> source,
+      std::shared_ptr<Texture> destination,
+      IRect destination_region,
+      size_t source_offset,
+      std::string label) = 0;
+
   virtual bool OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
                                        std::string label) = 0;
 
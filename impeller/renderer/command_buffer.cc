@@ -32,6 +32,23 @@ bool CommandBuffer::SubmitCommands() {
   return SubmitCommands(nullptr);
 }
 
+bool CommandBuffer::SubmitCommandsAsync(
+    std::shared_ptr<RenderPass> render_pass) {
+  TRACE_EVENT0("impeller", "CommandBuffer::SubmitCommandsAsync");
+  if (!IsValid() || !render_pass || !render_pass->IsValid()) {
+    return false;
+  }
+  return OnSubmitCommandsAsync(std::move(render_pass));
+}
+
+bool CommandBuffer::OnSubmitCommandsAsync(
+    std::shared_ptr<RenderPass> render_pass) {
+  if (!render_pass->EncodeCommands()) {
+    return false;
+  }
+  return SubmitCommands();
+}
+
 std::shared_ptr<RenderPass> CommandBuffer::CreateRenderPass(
     const RenderTarget& render_target) {
   auto pass = OnCreateRenderPass(render_target);
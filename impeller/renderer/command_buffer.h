@@ -65,6 +65,26 @@ class CommandBuffer {
 
   [[nodiscard]] bool SubmitCommands();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Encode the commands of a render pass created by this command
+  ///             buffer and schedule them on the GPU. Backends that can
+  ///             record command buffers in parallel do so on a worker thread.
+  ///
+  ///             The command buffer is ordered on the GPU before command
+  ///             buffers that are submitted after this call, so later passes
+  ///             may read the results of this one. The render pass must not
+  ///             be modified after this call.
+  ///
+  ///             Like `SubmitCommands`, this may only be called once.
+  ///
+  /// @param[in]  render_pass  The render pass to encode.
+  ///
+  /// @return     If the pass was scheduled. Errors during encoding on a
+  ///             worker thread are only logged.
+  ///
+  [[nodiscard]] bool SubmitCommandsAsync(
+      std::shared_ptr<RenderPass> render_pass);
+
   //----------------------------------------------------------------------------
   /// @brief      Create a render pass to record render commands into.
   ///
@@ -102,6 +122,9 @@ class CommandBuffer {
 
   [[nodiscard]] virtual bool OnSubmitCommands(CompletionCallback callback) = 0;
 
+  [[nodiscard]] virtual bool OnSubmitCommandsAsync(
+      std::shared_ptr<RenderPass> render_pass);
+
   virtual std::shared_ptr<ComputePass> OnCreateComputePass() const = 0;
 
  private:
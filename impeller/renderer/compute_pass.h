@@ -31,8 +31,17 @@ class ComputePass {
 
   void SetLabel(std::string label);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the number of invocations along each axis that the
+  ///             commands in this pass are run for. The grid is rounded up to
+  ///             a whole number of thread groups.
+  ///
   void SetGridSize(const ISize& size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the number of invocations along each axis in a thread
+  ///             group. This must match the local size of the shaders.
+  ///
   void SetThreadGroupSize(const ISize& size);
 
   HostBuffer& GetTransientsBuffer();
@@ -18,4 +18,22 @@ PixelFormat Context::GetColorAttachmentPixelFormat() const {
   return GetDeviceCapabilities().GetDefaultColorFormat();
 }
 
+Context::EncodeStats Context::GetEncodeStats() const {
+  return {.render_pass_count = encoded_render_pass_count_.load(),
+          .draw_count = encoded_draw_count_.load()};
+}
+
+void Context::RecordEncodedRenderPass(size_t draw_count) const {
+  encoded_render_pass_count_++;
+  encoded_draw_count_ += draw_count;
+}
+
+size_t Context::GetGlyphAtlasUploadCount() const {
+  return glyph_atlas_upload_count_.load();
+}
+
+void Context::RecordGlyphAtlasUpload() const {
+  glyph_atlas_upload_count_++;
+}
+
 }  // namespace impeller
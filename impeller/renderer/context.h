@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -51,10 +52,43 @@ class Context : public std::enable_shared_from_this<Context> {
 
   virtual const IDeviceCapabilities& GetDeviceCapabilities() const = 0;
 
+  struct EncodeStats {
+    size_t render_pass_count = 0u;
+    size_t draw_count = 0u;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of render passes, and of draw commands in them,
+  ///             encoded with this context so far. Used by benchmarks to
+  ///             count the work of a frame.
+  ///
+  EncodeStats GetEncodeStats() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by render passes once their commands are encoded.
+  ///
+  void RecordEncodedRenderPass(size_t draw_count) const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of times the contents of a glyph atlas texture
+  ///             have been uploaded with this context so far.
+  ///
+  size_t GetGlyphAtlasUploadCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by text render contexts when they upload the contents
+  ///             of a glyph atlas texture, in whole or in part.
+  ///
+  void RecordGlyphAtlasUpload() const;
+
  protected:
   Context();
 
  private:
+  mutable std::atomic<size_t> encoded_render_pass_count_ = 0u;
+  mutable std::atomic<size_t> encoded_draw_count_ = 0u;
+  mutable std::atomic<size_t> glyph_atlas_upload_count_ = 0u;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Context);
 };
 
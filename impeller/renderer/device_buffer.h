@@ -8,6 +8,7 @@
 #include <string>
 
 #include "flutter/fml/macros.h"
+#include "impeller/renderer/allocation_tracker.h"
 #include "impeller/renderer/allocator.h"
 #include "impeller/renderer/buffer.h"
 #include "impeller/renderer/buffer_view.h"
@@ -55,6 +56,12 @@ class DeviceBuffer : public Buffer,
                                 size_t offset) = 0;
 
  private:
+  friend class Allocator;
+
+  // The accounting of the memory of this allocation, set by the allocator
+  // that created it.
+  std::unique_ptr<AllocationTracker::Record> allocation_record_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(DeviceBuffer);
 };
 
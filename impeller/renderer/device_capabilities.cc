@@ -5,6 +5,8 @@
 #include "impeller/renderer/device_capabilities.h"
 #include "device_capabilities.h"
 
+#include <algorithm>
+
 namespace impeller {
 
 IDeviceCapabilities::IDeviceCapabilities(bool has_threading_restrictions,
@@ -15,7 +17,10 @@ IDeviceCapabilities::IDeviceCapabilities(bool has_threading_restrictions,
                                          PixelFormat default_color_format,
                                          PixelFormat default_stencil_format,
                                          bool supports_compute,
-                                         bool supports_compute_subgroups)
+                                         bool supports_compute_subgroups,
+                                         bool supports_instanced_rendering,
+                                         std::vector<PixelFormat>
+                                             compressed_formats)
     : has_threading_restrictions_(has_threading_restrictions),
       supports_offscreen_msaa_(supports_offscreen_msaa),
       supports_ssbo_(supports_ssbo),
@@ -24,7 +29,9 @@ IDeviceCapabilities::IDeviceCapabilities(bool has_threading_restrictions,
       default_color_format_(default_color_format),
       default_stencil_format_(default_stencil_format),
       supports_compute_(supports_compute),
-      supports_compute_subgroups_(supports_compute_subgroups) {}
+      supports_compute_subgroups_(supports_compute_subgroups),
+      supports_instanced_rendering_(supports_instanced_rendering),
+      compressed_formats_(std::move(compressed_formats)) {}
 
 IDeviceCapabilities::~IDeviceCapabilities() = default;
 
@@ -64,6 +71,15 @@ bool IDeviceCapabilities::SupportsComputeSubgroups() const {
   return supports_compute_subgroups_;
 }
 
+bool IDeviceCapabilities::SupportsInstancedRendering() const {
+  return supports_instanced_rendering_;
+}
+
+bool IDeviceCapabilities::SupportsCompressedFormat(PixelFormat format) const {
+  return std::find(compressed_formats_.begin(), compressed_formats_.end(),
+                   format) != compressed_formats_.end();
+}
+
 DeviceCapabilitiesBuilder::DeviceCapabilitiesBuilder() = default;
 
 DeviceCapabilitiesBuilder::~DeviceCapabilitiesBuilder() = default;
@@ -118,6 +134,19 @@ DeviceCapabilitiesBuilder& DeviceCapabilitiesBuilder::SetSupportsCompute(
   return *this;
 }
 
+DeviceCapabilitiesBuilder&
+DeviceCapabilitiesBuilder::SetSupportsInstancedRendering(bool value) {
+  supports_instanced_rendering_ = value;
+  return *this;
+}
+
+DeviceCapabilitiesBuilder&
+DeviceCapabilitiesBuilder::SetSupportedCompressedFormats(
+    std::vector<PixelFormat> formats) {
+  compressed_formats_ = std::move(formats);
+  return *this;
+}
+
 std::unique_ptr<IDeviceCapabilities> DeviceCapabilitiesBuilder::Build() {
   FML_CHECK(default_color_format_.has_value())
       << "Default color format not set";
@@ -133,7 +162,9 @@ std::unique_ptr<IDeviceCapabilities> DeviceCapabilitiesBuilder::Build() {
       *default_color_format_,                                   //
       *default_stencil_format_,                                 //
       supports_compute_,                                        //
-      supports_compute_subgroups_                               //
+      supports_compute_subgroups_,                              //
+      supports_instanced_rendering_,                            //
+      compressed_formats_                                       //
   );
   return std::unique_ptr<IDeviceCapabilities>(capabilities);
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/formats.h"
@@ -32,6 +33,14 @@ class IDeviceCapabilities {
   bool SupportsCompute() const;
   bool SupportsComputeSubgroups() const;
 
+  /// @brief  Whether commands may draw more than one instance of their
+  ///         vertices.
+  bool SupportsInstancedRendering() const;
+
+  /// @brief  Whether textures of the block compressed `format` can be
+  ///         created and sampled from.
+  bool SupportsCompressedFormat(PixelFormat format) const;
+
  private:
   IDeviceCapabilities(bool has_threading_restrictions,
                       bool supports_offscreen_msaa,
@@ -41,7 +50,9 @@ class IDeviceCapabilities {
                       PixelFormat default_color_format,
                       PixelFormat default_stencil_format,
                       bool supports_compute,
-                      bool supports_compute_subgroups);
+                      bool supports_compute_subgroups,
+                      bool supports_instanced_rendering,
+                      std::vector<PixelFormat> compressed_formats);
 
   friend class DeviceCapabilitiesBuilder;
 
@@ -54,6 +65,8 @@ class IDeviceCapabilities {
   PixelFormat default_stencil_format_;
   bool supports_compute_ = false;
   bool supports_compute_subgroups_ = false;
+  bool supports_instanced_rendering_ = false;
+  std::vector<PixelFormat> compressed_formats_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(IDeviceCapabilities);
 };
@@ -80,6 +93,11 @@ class DeviceCapabilitiesBuilder {
 
   DeviceCapabilitiesBuilder& SetSupportsCompute(bool value, bool subgroups);
 
+  DeviceCapabilitiesBuilder& SetSupportsInstancedRendering(bool value);
+
+  DeviceCapabilitiesBuilder& SetSupportedCompressedFormats(
+      std::vector<PixelFormat> formats);
+
   std::unique_ptr<IDeviceCapabilities> Build();
 
  private:
@@ -90,6 +108,8 @@ class DeviceCapabilitiesBuilder {
   bool supports_framebuffer_fetch_ = false;
   bool supports_compute_ = false;
   bool supports_compute_subgroups_ = false;
+  bool supports_instanced_rendering_ = false;
+  std::vector<PixelFormat> compressed_formats_;
   std::optional<PixelFormat> default_color_format_ = std::nullopt;
   std::optional<PixelFormat> default_stencil_format_ = std::nullopt;
 
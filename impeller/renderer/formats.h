@@ -78,6 +78,11 @@ enum class StorageMode {
 ///             esoteric formats and use blit passes to convert to a
 ///             non-esoteric pass.
 ///
+///             The block compressed formats store blocks of 4x4 pixels in 16
+///             bytes each. They can only be sampled from, and the devices
+///             that support them are listed by
+///             `IDeviceCapabilities::SupportsCompressedFormat`.
+///
 enum class PixelFormat {
   kUnknown,
   kA8UNormInt,
@@ -95,6 +100,10 @@ enum class PixelFormat {
   // Depth and stencil formats.
   kS8UInt,
   kD32FloatS8UInt,
+  // Block compressed formats.
+  kETC2R8G8B8A8UNormBlock,
+  kASTC4x4UNormBlock,
+  kBC3UNormBlock,
 };
 
 enum class BlendFactor {
@@ -274,9 +283,45 @@ enum class ColorWriteMask : uint64_t {
   kAll = kRed | kGreen | kBlue | kAlpha,
 };
 
+constexpr bool IsBlockCompressed(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+    case PixelFormat::kASTC4x4UNormBlock:
+    case PixelFormat::kBC3UNormBlock:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Whether the format can hold colors outside of the [0, 1] range, such as the
+/// wide gamut colors of the extended sRGB color space.
+constexpr bool IsExtendedRangeFormat(PixelFormat format) {
+  switch (format) {
+    case PixelFormat::kR32G32B32A32Float:
+    case PixelFormat::kR16G16B16A16Float:
+    case PixelFormat::kB10G10R10XR:
+    case PixelFormat::kB10G10R10XRSRGB:
+    case PixelFormat::kB10G10R10A10XR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// The width and height of the blocks of pixels of a block compressed format.
+/// 1 for the other formats.
+constexpr size_t BlockSizeForPixelFormat(PixelFormat format) {
+  return IsBlockCompressed(format) ? 4u : 1u;
+}
+
+/// 0 for the block compressed formats, see `BytesPerBlockForPixelFormat`.
 constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
   switch (format) {
     case PixelFormat::kUnknown:
+    case PixelFormat::kETC2R8G8B8A8UNormBlock:
+    case PixelFormat::kASTC4x4UNormBlock:
+    case PixelFormat::kBC3UNormBlock:
       return 0u;
     case PixelFormat::kA8UNormInt:
     case PixelFormat::kR8UNormInt:
@@ -302,6 +347,12 @@ constexpr size_t BytesPerPixelForPixelFormat(PixelFormat format) {
   return 0u;
 }
 
+/// The size of a block of pixels of a block compressed format, or of a pixel
+/// of the other formats.
+constexpr size_t BytesPerBlockForPixelFormat(PixelFormat format) {
+  return IsBlockCompressed(format) ? 16u : BytesPerPixelForPixelFormat(format);
+}
+
 //------------------------------------------------------------------------------
 /// @brief      Describe the color attachment that will be used with this
 ///             pipeline.
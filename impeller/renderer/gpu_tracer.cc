@@ -4,6 +4,9 @@
 
 #include "gpu_tracer.h"
 
+#include "flutter/fml/time/time_point.h"
+#include "flutter/fml/trace_event.h"
+
 namespace impeller {
 
 GPUTracer::GPUTracer() = default;
@@ -18,4 +21,97 @@ bool GPUTracer::StopCapturingFrame() {
   return false;
 }
 
+bool GPUTracer::IsTimingEnabled() const {
+#if FLUTTER_TIMELINE_ENABLED
+  return true;
+#else
+  Lock lock(mutex_);
+  return frame_timing_callback_ != nullptr;
+#endif  // FLUTTER_TIMELINE_ENABLED
+}
+
+void GPUTracer::SetFrameTimingCallback(FrameTimingCallback callback) {
+  Lock lock(mutex_);
+  frame_timing_callback_ =
+      callback ? std::make_shared<FrameTimingCallback>(std::move(callback))
+               : nullptr;
+}
+
+std::optional<fml::TimeDelta> GPUTracer::GetLastFrameGPUTime() const {
+  Lock lock(mutex_);
+  return last_frame_gpu_time_;
+}
+
+void GPUTracer::MarkFrameEnd() {
+  std::function<void()> report;
+  {
+    Lock lock(mutex_);
+    const auto frame_number = current_frame_++;
+    if (auto found = frames_.find(frame_number); found != frames_.end()) {
+      found->second.ended = true;
+      report = MaybeCompleteFrame(frame_number);
+    }
+  }
+  if (report) {
+    report();
+  }
+}
+
+uint64_t GPUTracer::BeginTimedWork() {
+  Lock lock(mutex_);
+  frames_[current_frame_].pending_work++;
+  return current_frame_;
+}
+
+void GPUTracer::EndTimedWork(uint64_t frame_number,
+                             std::string label,
+                             std::optional<fml::TimeDelta> duration) {
+  if (duration.has_value()) {
+    // GPU timestamps are not in the same time domain as the timeline, so the
+    // event ends when the duration was observed.
+    const auto end = fml::TimePoint::Now();
+    fml::tracing::TraceEventAsyncComplete("impeller", "GPUWork",
+                                          end - duration.value(), end,
+                                          "label", label.c_str());
+  }
+
+  std::function<void()> report;
+  {
+    Lock lock(mutex_);
+    auto found = frames_.find(frame_number);
+    if (found == frames_.end() || found->second.pending_work == 0u) {
+      return;
+    }
+    auto& frame = found->second;
+    frame.pending_work--;
+    if (duration.has_value()) {
+      frame.gpu_time = frame.gpu_time + duration.value();
+      frame.work.push_back({std::move(label), duration.value()});
+    }
+    report = MaybeCompleteFrame(frame_number);
+  }
+  if (report) {
+    report();
+  }
+}
+
+std::function<void()> GPUTracer::MaybeCompleteFrame(uint64_t frame_number) {
+  auto found = frames_.find(frame_number);
+  if (found == frames_.end() || !found->second.ended ||
+      found->second.pending_work > 0u) {
+    return nullptr;
+  }
+  auto frame = std::move(found->second);
+  frames_.erase(found);
+  last_frame_gpu_time_ = frame.gpu_time;
+  return [frame = std::move(frame), frame_number,
+          callback = frame_timing_callback_]() {
+    FML_TRACE_COUNTER("impeller", "GPUFrameTime", 0, "Microseconds",
+                      frame.gpu_time.ToMicroseconds());
+    if (callback) {
+      (*callback)(frame_number, frame.gpu_time, frame.work);
+    }
+  };
+}
+
 }  // namespace impeller
@@ -2,7 +2,19 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "impeller/base/thread.h"
 
 namespace impeller {
 
@@ -18,11 +30,33 @@ struct GPUTracerConfiguration {
   bool mtl_frame_capture_save_trace_as_document = false;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      The time the GPU spent on a labeled unit of work, such as a
+///             render, compute or blit pass.
+///
+struct GPUWorkTiming {
+  std::string label;
+  fml::TimeDelta duration;
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A GPU tracer to trace gpu workflow during rendering.
 ///
+///             Backends time the work they submit with timestamp queries (or
+///             their equivalent) and report the durations once the GPU is
+///             done, which is usually a few frames later. Each duration is
+///             emitted as a timeline event, and the total GPU time of each
+///             frame as a timeline counter and to the frame timing callback.
+///
 class GPUTracer {
  public:
+  using FrameTimingCallback =
+      std::function<void(uint64_t frame_number,
+                         fml::TimeDelta gpu_time,
+                         const std::vector<GPUWorkTiming>& work)>;
+
+  GPUTracer();
+
   virtual ~GPUTracer();
 
   //----------------------------------------------------------------------------
@@ -43,10 +77,70 @@ class GPUTracer {
   ///
   virtual bool StopCapturingFrame();
 
- protected:
-  GPUTracer();
+  //----------------------------------------------------------------------------
+  /// @brief      Whether backends should time the work they submit. True when
+  ///             the timeline is enabled or a frame timing callback is set.
+  ///
+  bool IsTimingEnabled() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the callback invoked with the GPU time of each frame
+  ///             once all of its timed work has completed. The callback is
+  ///             invoked on whichever thread reports the last timing of the
+  ///             frame.
+  ///
+  void SetFrameTimingCallback(FrameTimingCallback callback);
+
+  //----------------------------------------------------------------------------
+  /// @return     The GPU time of the most recent frame whose work has all
+  ///             been timed, which is usually a few frames behind the one
+  ///             being rendered, or nothing if no frame has been timed.
+  ///
+  std::optional<fml::TimeDelta> GetLastFrameGPUTime() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Marks the end of the current frame. Work that begins being
+  ///             timed after this call is attributed to the next frame.
+  ///
+  void MarkFrameEnd();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by backends when they start timing a unit of work.
+  ///             Each call must be matched by a call to `EndTimedWork`.
+  ///
+  /// @return     The number of the frame the work is attributed to.
+  ///
+  uint64_t BeginTimedWork();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by backends once the duration of the work is known,
+  ///             or with no duration if it could not be measured.
+  ///
+  void EndTimedWork(uint64_t frame_number,
+                    std::string label,
+                    std::optional<fml::TimeDelta> duration);
 
  private:
+  struct FrameData {
+    size_t pending_work = 0u;
+    bool ended = false;
+    fml::TimeDelta gpu_time;
+    std::vector<GPUWorkTiming> work;
+  };
+
+  mutable Mutex mutex_;
+  uint64_t current_frame_ IPLR_GUARDED_BY(mutex_) = 0u;
+  std::map<uint64_t, FrameData> frames_ IPLR_GUARDED_BY(mutex_);
+  std::shared_ptr<FrameTimingCallback> frame_timing_callback_
+      IPLR_GUARDED_BY(mutex_);
+  std::optional<fml::TimeDelta> last_frame_gpu_time_ IPLR_GUARDED_BY(mutex_);
+
+  // Reports the frame if it has ended and all of its work has been timed.
+  // Called with |mutex_| held, and returns the callback to invoke once it has
+  // been released.
+  std::function<void()> MaybeCompleteFrame(uint64_t frame_number)
+      IPLR_REQUIRES(mutex_);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUTracer);
 };
 
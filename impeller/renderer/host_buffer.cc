@@ -56,19 +56,53 @@ BufferView HostBuffer::Emplace(const void* buffer, size_t length) {
   return BufferView{shared_from_this(), GetBuffer(), Range{old_length, length}};
 }
 
+void HostBuffer::Reset() {
+  // Truncating keeps the reserved memory around for the next frame.
+  if (!Truncate(0u)) {
+    return;
+  }
+  generation_++;
+  arena_index_ = (arena_index_ + 1u) % kHostBufferArenaSize;
+  arenas_[arena_index_].uploaded_length = 0u;
+}
+
 std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
     Allocator& allocator) const {
-  if (generation_ == device_buffer_generation_) {
-    return device_buffer_;
+  auto& arena = arenas_[arena_index_];
+  if (arena.buffer && generation_ == arena.generation) {
+    return arena.buffer;
   }
-  auto new_buffer = allocator.CreateBufferWithCopy(GetBuffer(), GetLength());
-  if (!new_buffer) {
-    return nullptr;
+
+  const auto length = GetLength();
+  FML_DCHECK(arena.uploaded_length <= length);
+  if (arena.buffer &&
+      arena.buffer->GetDeviceBufferDescriptor().size >= length) {
+    // Data is only ever appended, so the part that was uploaded already is
+    // left alone for the commands that were encoded with it.
+    if (!arena.buffer->CopyHostBuffer(
+            GetBuffer(),
+            Range{arena.uploaded_length, length - arena.uploaded_length},
+            arena.uploaded_length)) {
+      return nullptr;
+    }
+  } else {
+    // Size the buffer by the reserved length so that it has room for the
+    // data emplaced after this upload, and in later frames.
+    DeviceBufferDescriptor desc;
+    desc.size = GetReservedLength();
+    desc.storage_mode = StorageMode::kHostVisible;
+    auto new_buffer =
+        allocator.CreateBuffer(desc, AllocationCategory::kHostBuffer);
+    if (!new_buffer ||
+        !new_buffer->CopyHostBuffer(GetBuffer(), Range{0u, length})) {
+      return nullptr;
+    }
+    new_buffer->SetLabel(label_);
+    arena.buffer = std::move(new_buffer);
   }
-  new_buffer->SetLabel(label_);
-  device_buffer_generation_ = generation_;
-  device_buffer_ = std::move(new_buffer);
-  return device_buffer_;
+  arena.uploaded_length = length;
+  arena.generation = generation_;
+  return arena.buffer;
 }
 
 }  // namespace impeller
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -17,6 +18,10 @@
 
 namespace impeller {
 
+/// The number of frames that the device buffers of a host buffer are
+/// recycled across when it is reset every frame.
+static constexpr size_t kHostBufferArenaSize = 3u;
+
 class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                          public Allocation,
                          public Buffer {
@@ -95,9 +100,28 @@ class HostBuffer final : public std::enable_shared_from_this<HostBuffer>,
                                    size_t length,
                                    size_t align);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Discard the emplaced data so that the buffer can be reused
+  ///             by the next frame. The host allocation is kept.
+  ///
+  ///             The device buffers that the data is uploaded to are
+  ///             recycled in a ring of `kHostBufferArenaSize`, so the ones
+  ///             read by the frames still in flight are not written to.
+  ///             Buffer views created before the reset must not be used
+  ///             afterwards.
+  ///
+  void Reset();
+
  private:
-  mutable std::shared_ptr<DeviceBuffer> device_buffer_;
-  mutable size_t device_buffer_generation_ = 0u;
+  struct DeviceBufferArena {
+    std::shared_ptr<DeviceBuffer> buffer;
+    // The length of the host data that has been copied to the buffer.
+    size_t uploaded_length = 0u;
+    size_t generation = 0u;
+  };
+
+  mutable std::array<DeviceBufferArena, kHostBufferArenaSize> arenas_;
+  size_t arena_index_ = 0u;
   size_t generation_ = 1u;
   std::string label_;
 
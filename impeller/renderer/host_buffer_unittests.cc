@@ -75,5 +75,27 @@ TEST(HostBufferTest, CanEmplaceWithAlignment) {
   }
 }
 
+TEST(HostBufferTest, ResetKeepsReservedMemory) {
+  struct Length2 {
+    uint8_t pad[2];
+  };
+
+  auto buffer = HostBuffer::Create();
+  ASSERT_TRUE(buffer);
+  for (size_t i = 0; i < 4096; i++) {
+    ASSERT_TRUE(buffer->Emplace(Length2{}));
+  }
+  ASSERT_EQ(buffer->GetLength(), 8192u);
+  const auto reserved = buffer->GetReservedLength();
+
+  buffer->Reset();
+  ASSERT_EQ(buffer->GetLength(), 0u);
+  ASSERT_EQ(buffer->GetReservedLength(), reserved);
+
+  auto view = buffer->Emplace(Length2{});
+  ASSERT_TRUE(view);
+  ASSERT_EQ(view.range, Range(0u, 2u));
+}
+
 }  // namespace  testing
 }  // namespace impeller
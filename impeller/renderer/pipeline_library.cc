@@ -10,6 +10,14 @@ PipelineLibrary::PipelineLibrary() = default;
 
 PipelineLibrary::~PipelineLibrary() = default;
 
+size_t PipelineLibrary::GetPipelineCompileCount() const {
+  return pipeline_compile_count_.load();
+}
+
+void PipelineLibrary::RecordPipelineCompile() {
+  pipeline_compile_count_++;
+}
+
 PipelineFuture<PipelineDescriptor> PipelineLibrary::GetPipeline(
     std::optional<PipelineDescriptor> descriptor) {
   if (descriptor.has_value()) {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <optional>
 
 #include "compute_pipeline_descriptor.h"
@@ -47,10 +48,24 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @return     The number of pipelines the library has started to create
+  ///             because they weren't in its cache.
+  ///
+  size_t GetPipelineCompileCount() const;
+
  protected:
   PipelineLibrary();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Called by backends when they start creating a pipeline that
+  ///             wasn't in their cache.
+  ///
+  void RecordPipelineCompile();
+
  private:
+  std::atomic<size_t> pipeline_compile_count_ = 0u;
+
   FML_DISALLOW_COPY_AND_ASSIGN(PipelineLibrary);
 };
 
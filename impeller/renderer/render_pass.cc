@@ -4,6 +4,11 @@
 
 #include "impeller/renderer/render_pass.h"
 
+#include "flutter/fml/logging.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/allocator.h"
+#include "impeller/renderer/context.h"
+
 namespace impeller {
 
 RenderPass::RenderPass(std::weak_ptr<const Context> context,
@@ -26,11 +31,23 @@ HostBuffer& RenderPass::GetTransientsBuffer() {
   return *transients_buffer_;
 }
 
+void RenderPass::SetTransientsBuffer(
+    std::shared_ptr<HostBuffer> transients_buffer) {
+  FML_DCHECK(transients_buffer_->GetLength() == 0u);
+  if (!transients_buffer) {
+    return;
+  }
+  transients_buffer_ = std::move(transients_buffer);
+  owns_transients_buffer_ = false;
+}
+
 void RenderPass::SetLabel(std::string label) {
   if (label.empty()) {
     return;
   }
-  transients_buffer_->SetLabel(SPrintF("%s Transients", label.c_str()));
+  if (owns_transients_buffer_) {
+    transients_buffer_->SetLabel(SPrintF("%s Transients", label.c_str()));
+  }
   OnSetLabel(std::move(label));
 }
 
@@ -40,6 +57,17 @@ bool RenderPass::AddCommand(Command command) {
     return false;
   }
 
+  if (scissor_limit_.has_value()) {
+    auto scissor = command.scissor.has_value()
+                       ? command.scissor->Intersection(scissor_limit_.value())
+                       : scissor_limit_;
+    if (!scissor.has_value()) {
+      // Nothing can be rendered within the limit.
+      return true;
+    }
+    command.scissor = scissor;
+  }
+
   if (command.scissor.has_value()) {
     auto target_rect = IRect({}, render_target_.GetRenderTargetSize());
     if (!target_rect.Contains(command.scissor.value())) {
@@ -65,13 +93,59 @@ bool RenderPass::AddCommand(Command command) {
   return true;
 }
 
+void RenderPass::SetScissorLimit(std::optional<IRect> scissor) {
+  scissor_limit_ = scissor;
+}
+
 bool RenderPass::EncodeCommands() const {
   auto context = context_.lock();
   // The context could have been collected in the meantime.
   if (!context) {
     return false;
   }
-  return OnEncodeCommands(*context);
+  if (!OnEncodeCommands(*context)) {
+    return false;
+  }
+  context->RecordEncodedRenderPass(commands_.size());
+  return true;
+}
+
+static bool BindDeviceBufferView(BufferView& view, Allocator& allocator) {
+  if (!view) {
+    return true;
+  }
+  auto device_buffer = view.buffer->GetDeviceBuffer(allocator);
+  if (!device_buffer) {
+    return false;
+  }
+  view.buffer = std::move(device_buffer);
+  return true;
+}
+
+static bool BindDeviceBufferViews(Bindings& bindings, Allocator& allocator) {
+  for (auto& [_, buffer] : bindings.buffers) {
+    if (!BindDeviceBufferView(buffer.resource, allocator)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RenderPass::BindDeviceBuffers() {
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  auto& allocator = *context->GetResourceAllocator();
+  for (auto& command : commands_) {
+    if (!BindDeviceBufferView(command.index_buffer, allocator) ||
+        !BindDeviceBufferViews(command.vertex_bindings, allocator) ||
+        !BindDeviceBufferViews(command.fragment_bindings, allocator)) {
+      VALIDATION_LOG << "Could not upload the buffers of a command.";
+      return false;
+    }
+  }
+  return true;
 }
 
 const std::weak_ptr<const Context>& RenderPass::GetContext() const {
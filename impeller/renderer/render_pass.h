@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "impeller/renderer/command.h"
@@ -37,6 +38,17 @@ class RenderPass {
 
   HostBuffer& GetTransientsBuffer();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Use a host buffer that is shared with other passes for the
+  ///             transient data of the commands, instead of one owned by
+  ///             this pass. It is not renamed by `SetLabel`.
+  ///
+  ///             This must be called before any data is emplaced.
+  ///
+  /// @param[in]  transients_buffer  The host buffer.
+  ///
+  void SetTransientsBuffer(std::shared_ptr<HostBuffer> transients_buffer);
+
   //----------------------------------------------------------------------------
   /// @brief      Record a command for subsequent encoding to the underlying
   ///             command buffer. No work is encoded into the command buffer at
@@ -48,6 +60,16 @@ class RenderPass {
   ///
   bool AddCommand(Command command);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Limit the commands added after this call to the given rect.
+  ///             It is intersected with the scissor of each command, and
+  ///             commands whose scissor ends up empty are dropped.
+  ///
+  /// @param[in]  scissor  The rect, which must lie within the render target,
+  ///                      or `std::nullopt` for no limit.
+  ///
+  void SetScissorLimit(std::optional<IRect> scissor);
+
   //----------------------------------------------------------------------------
   /// @brief      Encode the recorded commands to the underlying command buffer.
   ///
@@ -56,11 +78,23 @@ class RenderPass {
   ///
   bool EncodeCommands() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Upload the host buffers referenced by the recorded commands
+  ///             and bind the device buffers in their place. The commands
+  ///             may then be encoded on another thread while more data is
+  ///             emplaced onto the host buffers.
+  ///
+  /// @return     If all of the buffers could be uploaded.
+  ///
+  [[nodiscard]] bool BindDeviceBuffers();
+
  protected:
   const std::weak_ptr<const Context> context_;
   const RenderTarget render_target_;
   std::shared_ptr<HostBuffer> transients_buffer_;
+  bool owns_transients_buffer_ = true;
   std::vector<Command> commands_;
+  std::optional<IRect> scissor_limit_;
 
   RenderPass(std::weak_ptr<const Context> context, const RenderTarget& target);
 
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 
 #include "flutter/fml/macros.h"
@@ -17,6 +18,32 @@ namespace impeller {
 
 class Context;
 
+/// @brief  Creates the textures of the offscreen render targets made by
+///         `RenderTarget::CreateOffscreen` and
+///         `RenderTarget::CreateOffscreenMSAA`.
+///
+///         The default implementation allocates new textures every time.
+///         Subclasses may reuse textures across frames, in which case
+///         `Start` and `End` mark the beginning and end of each frame.
+class RenderTargetAllocator {
+ public:
+  explicit RenderTargetAllocator(std::shared_ptr<Allocator> allocator);
+
+  virtual ~RenderTargetAllocator();
+
+  virtual std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc);
+
+  virtual void Start();
+
+  virtual void End();
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetAllocator);
+};
+
 class RenderTarget final {
  public:
   struct AttachmentConfig {
@@ -56,6 +83,19 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  /// @param[in]  color_format  The format of the color attachment, or the
+  ///                            color attachment pixel format of the context
+  ///                            if not set.
+  static RenderTarget CreateOffscreen(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen",
+      AttachmentConfig color_attachment_config = kDefaultColorAttachmentConfig,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig,
+      std::optional<PixelFormat> color_format = std::nullopt);
+
   static RenderTarget CreateOffscreenMSAA(
       const Context& context,
       ISize size,
@@ -65,6 +105,20 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  /// @param[in]  color_format  The format of the color attachment, or the
+  ///                            color attachment pixel format of the context
+  ///                            if not set.
+  static RenderTarget CreateOffscreenMSAA(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen MSAA",
+      AttachmentConfigMSAA color_attachment_config =
+          kDefaultColorAttachmentConfigMSAA,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig,
+      std::optional<PixelFormat> color_format = std::nullopt);
+
   RenderTarget();
 
   ~RenderTarget();
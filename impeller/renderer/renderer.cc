@@ -9,7 +9,9 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
+#include "impeller/renderer/allocator.h"
 #include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/gpu_tracer.h"
 #include "impeller/renderer/surface.h"
 
 namespace impeller {
@@ -57,6 +59,11 @@ bool Renderer::Render(std::unique_ptr<Surface> surface,
 
   frames_in_flight_sema_->Signal();
 
+  if (auto tracer = context_->GetGPUTracer()) {
+    tracer->MarkFrameEnd();
+  }
+  context_->GetResourceAllocator()->GetAllocationTracker()->EndFrame();
+
   return present_result;
 }
 
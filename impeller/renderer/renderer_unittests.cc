@@ -30,6 +30,7 @@
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/pipeline_builder.h"
 #include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_target.h"
 #include "impeller/renderer/renderer.h"
 #include "impeller/renderer/sampler.h"
 #include "impeller/renderer/sampler_descriptor.h"
@@ -1036,5 +1037,59 @@ TEST_P(RendererTest, VertexBufferBuilder) {
   ASSERT_EQ(vertex_builder.GetVertexCount(), 4u);
 }
 
+TEST_P(RendererTest, CountsAllocatedBytes) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  const size_t allocated_bytes = allocator->GetTotalAllocatedBytes();
+
+  DeviceBufferDescriptor buffer_descriptor;
+  buffer_descriptor.storage_mode = StorageMode::kHostVisible;
+  buffer_descriptor.size = 1024u;
+  ASSERT_TRUE(allocator->CreateBuffer(buffer_descriptor));
+  ASSERT_EQ(allocator->GetTotalAllocatedBytes(), allocated_bytes + 1024u);
+
+  TextureDescriptor texture_descriptor;
+  texture_descriptor.format = PixelFormat::kR8G8B8A8UNormInt;
+  texture_descriptor.size = {16, 16};
+  ASSERT_TRUE(allocator->CreateTexture(texture_descriptor));
+  ASSERT_EQ(allocator->GetTotalAllocatedBytes(),
+            allocated_bytes + 1024u + 16u * 16u * 4u);
+}
+
+TEST_P(RendererTest, CountsEncodedRenderPasses) {
+  auto context = GetContext();
+  const auto encode_stats = context->GetEncodeStats();
+
+  auto render_target = RenderTarget::CreateOffscreen(*context, {16, 16});
+  auto buffer = context->CreateCommandBuffer();
+  ASSERT_TRUE(buffer);
+  auto pass = buffer->CreateRenderPass(render_target);
+  ASSERT_TRUE(pass);
+  ASSERT_TRUE(pass->EncodeCommands());
+  ASSERT_TRUE(buffer->SubmitCommands());
+
+  const auto frame_encode_stats = context->GetEncodeStats();
+  ASSERT_EQ(frame_encode_stats.render_pass_count,
+            encode_stats.render_pass_count + 1u);
+  ASSERT_EQ(frame_encode_stats.draw_count, encode_stats.draw_count);
+}
+
+TEST_P(RendererTest, CountsPipelineCompiles) {
+  using BoxPipelineBuilder = PipelineBuilder<BoxFadeVertexShader,
+                                             BoxFadeFragmentShader>;
+  auto context = GetContext();
+  auto library = context->GetPipelineLibrary();
+  auto desc = BoxPipelineBuilder::MakeDefaultPipelineDescriptor(*context);
+  ASSERT_TRUE(desc.has_value());
+  desc->SetLabel("CountsPipelineCompiles");
+  const size_t compile_count = library->GetPipelineCompileCount();
+
+  ASSERT_TRUE(library->GetPipeline(desc).Get());
+  ASSERT_EQ(library->GetPipelineCompileCount(), compile_count + 1u);
+
+  // Cached pipelines aren't compiled again.
+  ASSERT_TRUE(library->GetPipeline(desc).Get());
+  ASSERT_EQ(library->GetPipelineCompileCount(), compile_count + 1u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -33,26 +34,28 @@ struct SamplerDescriptor final : public Comparable<SamplerDescriptor> {
                     MinMagFilter mag_filter,
                     MipFilter mip_filter);
 
-  // Comparable<SamplerDescriptor>
-  std::size_t GetHash() const override {
-    return fml::HashCombine(min_filter, mag_filter, mip_filter,
-                            width_address_mode, height_address_mode,
-                            depth_address_mode);
+  /// @brief  A key that is unique to the sampler state of the descriptor.
+  ///         Descriptors that only differ in their labels share a key.
+  uint64_t ToKey() const {
+    return static_cast<uint64_t>(min_filter) |
+           static_cast<uint64_t>(mag_filter) << 8 |
+           static_cast<uint64_t>(mip_filter) << 16 |
+           static_cast<uint64_t>(width_address_mode) << 24 |
+           static_cast<uint64_t>(height_address_mode) << 32 |
+           static_cast<uint64_t>(depth_address_mode) << 40;
   }
 
+  // Comparable<SamplerDescriptor>
+  std::size_t GetHash() const override { return ToKey(); }
+
   // Comparable<SamplerDescriptor>
   bool IsEqual(const SamplerDescriptor& o) const override {
-    return min_filter == o.min_filter && mag_filter == o.mag_filter &&
-           mip_filter == o.mip_filter &&
-           width_address_mode == o.width_address_mode &&
-           height_address_mode == o.height_address_mode &&
-           depth_address_mode == o.depth_address_mode;
+    return ToKey() == o.ToKey();
   }
 };
 
-using SamplerMap = std::unordered_map<SamplerDescriptor,
-                                      std::shared_ptr<const Sampler>,
-                                      ComparableHash<SamplerDescriptor>,
-                                      ComparableEqual<SamplerDescriptor>>;
+/// Samplers by the keys of their descriptors. Looking them up doesn't involve
+/// copying or hashing the descriptors.
+using SamplerMap = std::unordered_map<uint64_t, std::shared_ptr<const Sampler>>;
 
 }  // namespace impeller
@@ -16,7 +16,7 @@ class SamplerLibrary {
   virtual ~SamplerLibrary();
 
   virtual std::shared_ptr<const Sampler> GetSampler(
-      SamplerDescriptor descriptor) = 0;
+      const SamplerDescriptor& descriptor) = 0;
 
  protected:
   SamplerLibrary();
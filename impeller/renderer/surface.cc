@@ -38,4 +38,12 @@ bool Surface::Present() const {
   return false;
 };
 
+size_t Surface::GetBufferAge() const {
+  return buffer_age_;
+}
+
+void Surface::SetBufferAge(size_t buffer_age) {
+  buffer_age_ = buffer_age;
+}
+
 }  // namespace impeller
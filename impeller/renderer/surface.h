@@ -30,9 +30,24 @@ class Surface {
 
   virtual bool Present() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The age of the contents of the color texture of the surface,
+  ///             as with EGL_EXT_buffer_age. An age of 0 means the contents
+  ///             are undefined, and an age of n means they are the contents of
+  ///             the nth previous frame presented to the same destination.
+  ///
+  ///             Surfaces with a non-zero age only need their damage since
+  ///             then to be repainted.
+  ///
+  size_t GetBufferAge() const;
+
+ protected:
+  void SetBufferAge(size_t buffer_age);
+
  private:
   RenderTarget desc_;
   ISize size_;
+  size_t buffer_age_ = 0u;
 
   bool is_valid_ = false;
 
@@ -62,6 +62,13 @@ class MockBlitPass : public BlitPass {
                     size_t destination_offset,
                     std::string label));
 
+  MOCK_METHOD5(OnCopyBufferToTextureCommand,
+               bool(std::shared_ptr<DeviceBuffer> source,
+                    std::shared_ptr<Texture> destination,
+                    IRect destination_region,
+                    size_t source_offset,
+                    std::string label));
+
   MOCK_METHOD2(OnGenerateMipmapCommand,
                bool(std::shared_ptr<Texture> texture, std::string label));
 };
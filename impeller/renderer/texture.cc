@@ -23,6 +23,7 @@ bool Texture::SetContents(const uint8_t* contents,
     return false;
   }
   intent_ = TextureIntent::kUploadFromHost;
+  mipmaps_generated_ = false;
   return true;
 }
 
@@ -39,6 +40,7 @@ bool Texture::SetContents(std::shared_ptr<const fml::Mapping> mapping,
     return false;
   }
   intent_ = TextureIntent::kUploadFromHost;
+  mipmaps_generated_ = false;
   return true;
 }
 
@@ -46,6 +48,10 @@ size_t Texture::GetMipCount() const {
   return GetTextureDescriptor().mip_count;
 }
 
+bool Texture::NeedsMipmapGeneration() const {
+  return GetMipCount() > 1u && !mipmaps_generated_;
+}
+
 const TextureDescriptor& Texture::GetTextureDescriptor() const {
   return desc_;
 }
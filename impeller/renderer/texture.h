@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <string_view>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
 #include "impeller/geometry/size.h"
+#include "impeller/renderer/allocation_tracker.h"
 #include "impeller/renderer/formats.h"
 #include "impeller/renderer/texture_descriptor.h"
 
@@ -33,6 +36,14 @@ class Texture {
 
   size_t GetMipCount() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the texture has mip levels past the base one that
+  ///             haven't been generated from it since its contents were last
+  ///             set. They have to be generated with a blit pass before the
+  ///             texture is sampled with a mip filter.
+  ///
+  bool NeedsMipmapGeneration() const;
+
   const TextureDescriptor& GetTextureDescriptor() const;
 
   void SetIntent(TextureIntent intent);
@@ -58,6 +69,18 @@ class Texture {
 
   bool IsSliceValid(size_t slice) const;
 
+  friend class Allocator;
+  friend class BlitPass;
+
+  // Set by the blit pass that records the generation of the mip levels. This
+  // is read on the raster thread, while the contents of images are set on the
+  // IO thread.
+  std::atomic<bool> mipmaps_generated_ = false;
+
+  // The accounting of the memory of this allocation, set by the allocator
+  // that created it.
+  std::unique_ptr<AllocationTracker::Record> allocation_record_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(Texture);
 };
 
@@ -30,14 +30,18 @@ struct TextureDescriptor {
     if (!IsValid()) {
       return 0u;
     }
-    return size.Area() * BytesPerPixelForPixelFormat(format);
+    const size_t block_size = BlockSizeForPixelFormat(format);
+    return GetBytesPerRow() * ((size.height + block_size - 1) / block_size);
   }
 
+  /// The bytes per row of blocks for block compressed formats.
   constexpr size_t GetBytesPerRow() const {
     if (!IsValid()) {
       return 0u;
     }
-    return size.width * BytesPerPixelForPixelFormat(format);
+    const size_t block_size = BlockSizeForPixelFormat(format);
+    return ((size.width + block_size - 1) / block_size) *
+           BytesPerBlockForPixelFormat(format);
   }
 
   constexpr bool SamplingOptionsAreValid() const {
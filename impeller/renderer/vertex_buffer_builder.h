@@ -67,6 +67,15 @@ class VertexBufferBuilder {
     return *this;
   }
 
+  /// @brief  Calls `iterator` with each vertex, in the order that they were
+  ///         appended.
+  template <class Iterator>
+  void IterateVertices(Iterator iterator) const {
+    for (const auto& vertex : vertices_) {
+      iterator(vertex);
+    }
+  }
+
   VertexBufferBuilder& AppendIndex(IndexType_ index) {
     indices_.emplace_back(index);
     return *this;
@@ -4,7 +4,9 @@
 
 #include "impeller/runtime_stage/runtime_stage.h"
 
+#include <algorithm>
 #include <array>
+#include <optional>
 
 #include "impeller/base/validation.h"
 #include "impeller/runtime_stage/runtime_stage_flatbuffers.h"
@@ -59,6 +61,43 @@ static RuntimeShaderStage ToShaderStage(fb::Stage stage) {
   FML_UNREACHABLE();
 }
 
+static RuntimeStage::UniformLayout ComputeUniformLayout(
+    const std::vector<RuntimeUniformDescription>& uniforms) {
+  RuntimeStage::UniformLayout layout;
+  std::optional<size_t> sampler_base_location;
+  for (size_t i = 0; i < uniforms.size(); i++) {
+    const auto& uniform = uniforms[i];
+    switch (uniform.type) {
+      case kSampledImage:
+        layout.sampled_image_uniforms.push_back(i);
+        sampler_base_location =
+            std::min(sampler_base_location.value_or(uniform.location),
+                     uniform.location);
+        break;
+      case kFloat:
+        layout.float_uniforms.push_back(
+            {.uniform_index = i, .offset = layout.float_data_size});
+        layout.float_data_size += uniform.GetSize();
+        break;
+      case kBoolean:
+      case kSignedByte:
+      case kUnsignedByte:
+      case kSignedShort:
+      case kUnsignedShort:
+      case kSignedInt:
+      case kUnsignedInt:
+      case kSignedInt64:
+      case kUnsignedInt64:
+      case kHalfFloat:
+      case kDouble:
+        layout.has_unsupported_uniforms = true;
+        break;
+    }
+  }
+  layout.sampler_base_location = sampler_base_location.value_or(0u);
+  return layout;
+}
+
 RuntimeStage::RuntimeStage(std::shared_ptr<fml::Mapping> payload)
     : payload_(std::move(payload)) {
   if (payload_ == nullptr || !payload_->GetMapping()) {
@@ -89,6 +128,7 @@ RuntimeStage::RuntimeStage(std::shared_ptr<fml::Mapping> payload)
       uniforms_.emplace_back(std::move(desc));
     }
   }
+  uniform_layout_ = ComputeUniformLayout(uniforms_);
 
   code_mapping_ = std::make_shared<fml::NonOwnedMapping>(
       runtime_stage->shader()->data(),     //
@@ -136,6 +176,10 @@ const RuntimeUniformDescription* RuntimeStage::GetUniform(
   return nullptr;
 }
 
+const RuntimeStage::UniformLayout& RuntimeStage::GetUniformLayout() const {
+  return uniform_layout_;
+}
+
 const std::string& RuntimeStage::GetEntrypoint() const {
   return entrypoint_;
 }
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/mapping.h"
@@ -16,6 +17,31 @@ namespace impeller {
 
 class RuntimeStage {
  public:
+  /// @brief  Where the uniforms of the stage are bound from, worked out once
+  ///         when the stage is loaded instead of on every draw.
+  struct UniformLayout {
+    struct FloatUniform {
+      /// The index of the uniform in `GetUniforms`.
+      size_t uniform_index = 0u;
+      /// The offset of the uniform in the packed uniform data of a draw.
+      size_t offset = 0u;
+    };
+
+    /// The float uniforms, in the order their data is packed.
+    std::vector<FloatUniform> float_uniforms;
+    /// The indices in `GetUniforms` of the sampled images, in the order their
+    /// textures are supplied.
+    std::vector<size_t> sampled_image_uniforms;
+    /// The location of the first sampled image. Sampled image locations
+    /// count the float uniforms before them, so this is subtracted to get the
+    /// texture slot.
+    size_t sampler_base_location = 0u;
+    /// The size of the uniform data a draw must supply.
+    size_t float_data_size = 0u;
+    /// Whether the stage has uniforms of a type that can't be bound.
+    bool has_unsupported_uniforms = false;
+  };
+
   explicit RuntimeStage(std::shared_ptr<fml::Mapping> payload);
 
   ~RuntimeStage();
@@ -32,6 +58,8 @@ class RuntimeStage {
 
   const RuntimeUniformDescription* GetUniform(const std::string& name) const;
 
+  const UniformLayout& GetUniformLayout() const;
+
   const std::shared_ptr<fml::Mapping>& GetCodeMapping() const;
 
   const std::shared_ptr<fml::Mapping>& GetSkSLMapping() const;
@@ -47,6 +75,7 @@ class RuntimeStage {
   std::shared_ptr<fml::Mapping> code_mapping_;
   std::shared_ptr<fml::Mapping> sksl_mapping_;
   std::vector<RuntimeUniformDescription> uniforms_;
+  UniformLayout uniform_layout_;
   bool is_valid_ = false;
   bool is_dirty_ = true;
 
@@ -186,6 +186,29 @@ TEST(RuntimeStageTest, CanReadUniforms) {
   }
 }
 
+TEST(RuntimeStageTest, ComputesUniformLayoutWhenLoaded) {
+  auto fixture =
+      flutter::testing::OpenFixtureAsMapping("ink_sparkle.frag.iplr");
+  ASSERT_TRUE(fixture);
+  RuntimeStage stage(std::move(fixture));
+  ASSERT_TRUE(stage.IsValid());
+
+  const auto& layout = stage.GetUniformLayout();
+  ASSERT_FALSE(layout.has_unsupported_uniforms);
+  ASSERT_TRUE(layout.sampled_image_uniforms.empty());
+  ASSERT_EQ(layout.float_uniforms.size(), stage.GetUniforms().size());
+
+  // The float uniforms are packed in declaration order.
+  size_t offset = 0u;
+  for (size_t i = 0; i < layout.float_uniforms.size(); i++) {
+    ASSERT_EQ(layout.float_uniforms[i].uniform_index, i);
+    ASSERT_EQ(layout.float_uniforms[i].offset, offset);
+    offset += stage.GetUniforms()[i].GetSize();
+  }
+  ASSERT_EQ(layout.float_uniforms[1].offset, 16u);
+  ASSERT_EQ(layout.float_data_size, 128u);
+}
+
 TEST_P(RuntimeStageTest, CanRegisterStage) {
   if (GetParam() != PlaygroundBackend::kMetal) {
     GTEST_SKIP_("Skipped: https://github.com/flutter/flutter/issues/105538");
@@ -12,17 +12,50 @@
 #include "impeller/geometry/vector.h"
 #include "impeller/renderer/device_buffer_descriptor.h"
 #include "impeller/renderer/formats.h"
+#include "impeller/renderer/platform.h"
 #include "impeller/renderer/sampler_descriptor.h"
 #include "impeller/renderer/sampler_library.h"
 #include "impeller/renderer/vertex_buffer.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
+#include "impeller/scene/importer/conversions.h"
 #include "impeller/scene/importer/scene_flatbuffers.h"
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
 
+//------------------------------------------------------------------------------
+/// Aabb
+///
+
+bool Aabb::IsOutsideFrustum(const Matrix& mvp) const {
+  // The box is outside when all of its corners are on the outer side of the
+  // same clip plane:
+  //   -w <= x <= w, -w <= y <= w, 0 <= z <= w.
+  int outside_left = 0;
+  int outside_right = 0;
+  int outside_bottom = 0;
+  int outside_top = 0;
+  int outside_near = 0;
+  int outside_far = 0;
+  for (int i = 0; i < 8; i++) {
+    Vector4 corner = mvp * Vector4(i & 1 ? max.x : min.x,  //
+                                   i & 2 ? max.y : min.y,  //
+                                   i & 4 ? max.z : min.z,  //
+                                   1.0);
+    outside_left += corner.x < -corner.w;
+    outside_right += corner.x > corner.w;
+    outside_bottom += corner.y < -corner.w;
+    outside_top += corner.y > corner.w;
+    outside_near += corner.z < 0;
+    outside_far += corner.z > corner.w;
+  }
+  return outside_left == 8 || outside_right == 8 || outside_bottom == 8 ||
+         outside_top == 8 || outside_near == 8 || outside_far == 8;
+}
+
 //------------------------------------------------------------------------------
 /// Geometry
 ///
@@ -64,6 +97,7 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
   const uint8_t* vertices_start;
   size_t vertices_bytes;
   bool is_skinned;
+  std::optional<Aabb> bounds;
 
   switch (mesh.vertices_type()) {
     case fb::VertexBuffer::UnskinnedVertexBuffer: {
@@ -72,6 +106,15 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       vertices_start = reinterpret_cast<const uint8_t*>(vertices->Get(0));
       vertices_bytes = vertices->size() * sizeof(fb::Vertex);
       is_skinned = false;
+      for (const auto* vertex : *vertices) {
+        Vector3 position = importer::ToVector3(vertex->position());
+        if (!bounds.has_value()) {
+          bounds = Aabb{position, position};
+          continue;
+        }
+        bounds->min = bounds->min.Min(position);
+        bounds->max = bounds->max.Max(position);
+      }
       break;
     }
     case fb::VertexBuffer::SkinnedVertexBuffer: {
@@ -116,11 +159,42 @@ std::shared_ptr<Geometry> Geometry::MakeFromFlatbuffer(
       .index_count = mesh.indices()->count(),
       .index_type = index_type,
   };
-  return MakeVertexBuffer(std::move(vertex_buffer), is_skinned);
+  if (is_skinned) {
+    return MakeVertexBuffer(std::move(vertex_buffer), true);
+  }
+  auto result = std::make_shared<UnskinnedVertexBufferGeometry>();
+  result->SetVertexBuffer(std::move(vertex_buffer));
+  result->SetBounds(bounds);
+  return result;
 }
 
 void Geometry::SetJointsTexture(const std::shared_ptr<Texture>& texture) {}
 
+std::optional<Aabb> Geometry::GetBounds() const {
+  return std::nullopt;
+}
+
+void Geometry::BindInstancesToCommand(const SceneContext& scene_context,
+                                      HostBuffer& buffer,
+                                      const Matrix& view_transform,
+                                      const std::vector<Matrix>& transforms,
+                                      Command& command) const {
+  FML_DCHECK(GetGeometryType() == GeometryType::kUnskinned);
+
+  command.BindVertices(
+      GetVertexBuffer(*scene_context.GetContext()->GetResourceAllocator()));
+
+  UnskinnedInstancedVertexShader::FrameInfo info;
+  info.view_transform = view_transform;
+  UnskinnedInstancedVertexShader::BindFrameInfo(command,
+                                                buffer.EmplaceUniform(info));
+  UnskinnedInstancedVertexShader::BindInstanceData(
+      command,
+      buffer.Emplace(transforms.data(), transforms.size() * sizeof(Matrix),
+                     DefaultUniformAlignment()));
+  command.instance_count = transforms.size();
+}
+
 //------------------------------------------------------------------------------
 /// CuboidGeometry
 ///
@@ -173,6 +247,11 @@ void CuboidGeometry::BindToCommand(const SceneContext& scene_context,
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+std::optional<Aabb> CuboidGeometry::GetBounds() const {
+  return Aabb{Vector3(), size_};
+}
+
 //------------------------------------------------------------------------------
 /// UnskinnedVertexBufferGeometry
 ///
@@ -186,6 +265,10 @@ void UnskinnedVertexBufferGeometry::SetVertexBuffer(
   vertex_buffer_ = std::move(vertex_buffer);
 }
 
+void UnskinnedVertexBufferGeometry::SetBounds(std::optional<Aabb> bounds) {
+  bounds_ = bounds;
+}
+
 // |Geometry|
 GeometryType UnskinnedVertexBufferGeometry::GetGeometryType() const {
   return GeometryType::kUnskinned;
@@ -211,6 +294,11 @@ void UnskinnedVertexBufferGeometry::BindToCommand(
   UnskinnedVertexShader::BindFrameInfo(command, buffer.EmplaceUniform(info));
 }
 
+// |Geometry|
+std::optional<Aabb> UnskinnedVertexBufferGeometry::GetBounds() const {
+  return bounds_;
+}
+
 //------------------------------------------------------------------------------
 /// SkinnedVertexBufferGeometry
 ///
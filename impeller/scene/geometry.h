@@ -5,6 +5,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/matrix.h"
@@ -24,6 +26,22 @@ namespace scene {
 class CuboidGeometry;
 class UnskinnedVertexBufferGeometry;
 
+//------------------------------------------------------------------------------
+/// @brief      An axis-aligned box in the space of the vertices of a geometry.
+///
+struct Aabb {
+  Vector3 min;
+  Vector3 max;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether none of the box can be visible once transformed to
+  ///             clip space, such as a box behind the camera or off to one
+  ///             side of it. Boxes that are only close to the frustum may
+  ///             still be reported as visible.
+  ///
+  bool IsOutsideFrustum(const Matrix& mvp) const;
+};
+
 class Geometry {
  public:
   virtual ~Geometry();
@@ -47,6 +65,24 @@ class Geometry {
                              Command& command) const = 0;
 
   virtual void SetJointsTexture(const std::shared_ptr<Texture>& texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The bounds of the vertices, or std::nullopt if they aren't
+  ///             known. Skinned geometry has no bounds, since its vertices
+  ///             move with the joints.
+  ///
+  virtual std::optional<Aabb> GetBounds() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Bind the vertices and the transform of each instance, to
+  ///             draw all of the instances with one command. Only geometry
+  ///             of GeometryType::kUnskinned can be instanced.
+  ///
+  void BindInstancesToCommand(const SceneContext& scene_context,
+                              HostBuffer& buffer,
+                              const Matrix& view_transform,
+                              const std::vector<Matrix>& transforms,
+                              Command& command) const;
 };
 
 class CuboidGeometry final : public Geometry {
@@ -69,6 +105,9 @@ class CuboidGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  std::optional<Aabb> GetBounds() const override;
+
  private:
   Vector3 size_;
 
@@ -83,6 +122,8 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
 
   void SetVertexBuffer(VertexBuffer vertex_buffer);
 
+  void SetBounds(std::optional<Aabb> bounds);
+
   // |Geometry|
   GeometryType GetGeometryType() const override;
 
@@ -95,8 +136,12 @@ class UnskinnedVertexBufferGeometry final : public Geometry {
                      const Matrix& transform,
                      Command& command) const override;
 
+  // |Geometry|
+  std::optional<Aabb> GetBounds() const override;
+
  private:
   VertexBuffer vertex_buffer_;
+  std::optional<Aabb> bounds_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(UnskinnedVertexBufferGeometry);
 };
@@ -7,6 +7,7 @@
 #include <inttypes.h>
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -58,6 +59,25 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(
                                   allocator);
 }
 
+std::shared_ptr<Node> Node::MakeFromFlatbuffer(
+    std::shared_ptr<const fml::Mapping> ipscene_mapping,
+    Allocator& allocator) {
+  if (!ipscene_mapping) {
+    VALIDATION_LOG << "Failed to unpack scene: The mapping is null.";
+    return nullptr;
+  }
+  flatbuffers::Verifier verifier(ipscene_mapping->GetMapping(),
+                                 ipscene_mapping->GetSize());
+  if (!fb::VerifySceneBuffer(verifier)) {
+    VALIDATION_LOG << "Failed to unpack scene: Scene flatbuffer is invalid.";
+    return nullptr;
+  }
+
+  const fb::Scene& scene = *fb::GetScene(ipscene_mapping->GetMapping());
+  return Unpack(scene, allocator,
+                std::make_shared<LazyScene>(std::move(ipscene_mapping)));
+}
+
 static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
     const fb::Texture* iptexture,
     Allocator& allocator) {
@@ -132,9 +152,9 @@ static std::shared_ptr<Texture> UnpackTextureFromFlatbuffer(
   return texture;
 }
 
-std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
-                                               Allocator& allocator) {
-  // Unpack textures.
+static std::vector<std::shared_ptr<Texture>> UnpackTexturesFromFlatbuffer(
+    const fb::Scene& scene,
+    Allocator& allocator) {
   std::vector<std::shared_ptr<Texture>> textures;
   if (scene.textures()) {
     for (const auto iptexture : *scene.textures()) {
@@ -144,6 +164,64 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
       textures.push_back(UnpackTextureFromFlatbuffer(iptexture, allocator));
     }
   }
+  return textures;
+}
+
+static Mesh UnpackMeshFromFlatbuffer(
+    const fb::Node& source_node,
+    const std::vector<std::shared_ptr<Texture>>& textures,
+    Allocator& allocator) {
+  Mesh mesh;
+  for (const auto* primitives : *source_node.mesh_primitives()) {
+    auto geometry = Geometry::MakeFromFlatbuffer(*primitives, allocator);
+    auto material =
+        primitives->material()
+            ? Material::MakeFromFlatbuffer(*primitives->material(), textures)
+            : Material::MakeUnlit();
+    mesh.AddPrimitive({std::move(geometry), std::move(material)});
+  }
+  return mesh;
+}
+
+//------------------------------------------------------------------------------
+/// @brief      A verified scene mapping whose textures are unpacked by the
+///             first mesh that needs them.
+///
+class Node::LazyScene {
+ public:
+  explicit LazyScene(std::shared_ptr<const fml::Mapping> mapping)
+      : mapping_(std::move(mapping)) {}
+
+  const std::vector<std::shared_ptr<Texture>>& GetTextures(
+      Allocator& allocator) {
+    if (!textures_.has_value()) {
+      textures_ = UnpackTexturesFromFlatbuffer(
+          *fb::GetScene(mapping_->GetMapping()), allocator);
+    }
+    return textures_.value();
+  }
+
+ private:
+  std::shared_ptr<const fml::Mapping> mapping_;
+  std::optional<std::vector<std::shared_ptr<Texture>>> textures_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(LazyScene);
+};
+
+std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
+                                               Allocator& allocator) {
+  return Unpack(scene, allocator, nullptr);
+}
+
+std::shared_ptr<Node> Node::Unpack(
+    const fb::Scene& scene,
+    Allocator& allocator,
+    const std::shared_ptr<LazyScene>& lazy_scene) {
+  // Unpack textures, unless the meshes that use them are deferred.
+  std::vector<std::shared_ptr<Texture>> textures;
+  if (!lazy_scene) {
+    textures = UnpackTexturesFromFlatbuffer(scene, allocator);
+  }
 
   auto result = std::make_shared<Node>();
   result->SetLocalTransform(importer::ToMatrix(*scene.transform()));
@@ -171,7 +249,8 @@ std::shared_ptr<Node> Node::MakeFromFlatbuffer(const fb::Scene& scene,
   // Unpack each node.
   for (size_t node_i = 0; node_i < scene.nodes()->size(); node_i++) {
     scene_nodes[node_i]->UnpackFromFlatbuffer(*scene.nodes()->Get(node_i),
-                                              scene_nodes, textures, allocator);
+                                              scene_nodes, textures, lazy_scene,
+                                              allocator);
   }
 
   // Unpack animations.
@@ -191,6 +270,7 @@ void Node::UnpackFromFlatbuffer(
     const fb::Node& source_node,
     const std::vector<std::shared_ptr<Node>>& scene_nodes,
     const std::vector<std::shared_ptr<Texture>>& textures,
+    const std::shared_ptr<LazyScene>& lazy_scene,
     Allocator& allocator) {
   name_ = source_node.name()->str();
   SetLocalTransform(importer::ToMatrix(*source_node.transform()));
@@ -198,16 +278,11 @@ void Node::UnpackFromFlatbuffer(
   /// Meshes.
 
   if (source_node.mesh_primitives()) {
-    Mesh mesh;
-    for (const auto* primitives : *source_node.mesh_primitives()) {
-      auto geometry = Geometry::MakeFromFlatbuffer(*primitives, allocator);
-      auto material =
-          primitives->material()
-              ? Material::MakeFromFlatbuffer(*primitives->material(), textures)
-              : Material::MakeUnlit();
-      mesh.AddPrimitive({std::move(geometry), std::move(material)});
+    if (lazy_scene) {
+      lazy_mesh_ = LazyMesh{lazy_scene, &source_node};
+    } else {
+      SetMesh(UnpackMeshFromFlatbuffer(source_node, textures, allocator));
     }
-    SetMesh(std::move(mesh));
   }
 
   /// Child nodes.
@@ -337,6 +412,8 @@ std::vector<std::shared_ptr<Node>>& Node::GetChildren() {
 
 void Node::SetMesh(Mesh mesh) {
   mesh_ = std::move(mesh);
+  // A mesh set in the meantime replaces the one that hasn't been unpacked.
+  lazy_mesh_.reset();
 }
 
 Mesh& Node::GetMesh() {
@@ -406,6 +483,12 @@ bool Node::Render(SceneEncoder& encoder,
     animation_player_->Update();
   }
 
+  if (lazy_mesh_.has_value()) {
+    SetMesh(UnpackMeshFromFlatbuffer(*lazy_mesh_->source_node,
+                                     lazy_mesh_->scene->GetTextures(allocator),
+                                     allocator));
+  }
+
   Matrix transform = parent_transform * local_transform_;
   mesh_.Render(encoder, transform,
                skin_ ? skin_->GetJointsTexture(allocator) : nullptr);
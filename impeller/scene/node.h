@@ -68,6 +68,19 @@ class Node final {
   static std::shared_ptr<Node> MakeFromFlatbuffer(const fb::Scene& scene,
                                                   Allocator& allocator);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Unpack a scene without uploading any of its meshes or
+  ///             textures. The mesh of each node is uploaded straight from
+  ///             the mapping when the node is first rendered, so nodes that
+  ///             are never rendered cost no device memory. The nodes keep the
+  ///             mapping alive until all of their meshes are uploaded.
+  ///
+  ///             Until then, the meshes of the nodes are empty.
+  ///
+  static std::shared_ptr<Node> MakeFromFlatbuffer(
+      std::shared_ptr<const fml::Mapping> ipscene_mapping,
+      Allocator& allocator);
+
   Node();
   ~Node();
 
@@ -105,10 +118,25 @@ class Node final {
   void AddMutation(const MutationLog::Entry& entry);
 
  private:
+  class LazyScene;
+
+  // The mesh of a node that is unpacked when the node is first rendered.
+  struct LazyMesh {
+    std::shared_ptr<LazyScene> scene;
+    const fb::Node* source_node = nullptr;
+  };
+
+  // Unpacks the scene, deferring the meshes to |lazy_scene| if there is one.
+  static std::shared_ptr<Node> Unpack(
+      const fb::Scene& scene,
+      Allocator& allocator,
+      const std::shared_ptr<LazyScene>& lazy_scene);
+
   void UnpackFromFlatbuffer(
       const fb::Node& node,
       const std::vector<std::shared_ptr<Node>>& scene_nodes,
       const std::vector<std::shared_ptr<Texture>>& textures,
+      const std::shared_ptr<LazyScene>& lazy_scene,
       Allocator& allocator);
 
   mutable MutationLog mutation_log_;
@@ -121,6 +149,7 @@ class Node final {
   Node* parent_ = nullptr;
   std::vector<std::shared_ptr<Node>> children_;
   Mesh mesh_;
+  std::optional<LazyMesh> lazy_mesh_;
 
   // For convenience purposes, deserialized nodes hang onto an animation library
   std::vector<std::shared_ptr<Animation>> animations_;
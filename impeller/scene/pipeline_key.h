@@ -12,7 +12,9 @@ namespace scene {
 enum class GeometryType {
   kUnskinned = 0,
   kSkinned = 1,
-  kLastType = kSkinned,
+  // Many instances of an unskinned geometry, drawn by a single command.
+  kUnskinnedInstanced = 2,
+  kLastType = kUnskinnedInstanced,
 };
 enum class MaterialType {
   kUnlit = 0,
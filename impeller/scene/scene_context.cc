@@ -8,6 +8,7 @@
 #include "impeller/scene/shaders/skinned.vert.h"
 #include "impeller/scene/shaders/unlit.frag.h"
 #include "impeller/scene/shaders/unskinned.vert.h"
+#include "impeller/scene/shaders/unskinned_instanced.vert.h"
 
 namespace impeller {
 namespace scene {
@@ -45,6 +46,16 @@ SceneContext::SceneContext(std::shared_ptr<Context> context)
   pipelines_[{PipelineKey{GeometryType::kSkinned, MaterialType::kUnlit}}] =
       MakePipelineVariants<SkinnedVertexShader, UnlitFragmentShader>(*context_);
 
+  const auto& capabilities = context_->GetDeviceCapabilities();
+  supports_instancing_ = capabilities.SupportsSSBO() &&
+                         capabilities.SupportsInstancedRendering();
+  if (supports_instancing_) {
+    pipelines_[{PipelineKey{GeometryType::kUnskinnedInstanced,
+                            MaterialType::kUnlit}}] =
+        MakePipelineVariants<UnskinnedInstancedVertexShader,
+                             UnlitFragmentShader>(*context_);
+  }
+
   {
     impeller::TextureDescriptor texture_descriptor;
     texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
@@ -96,5 +107,9 @@ std::shared_ptr<Texture> SceneContext::GetPlaceholderTexture() const {
   return placeholder_texture_;
 }
 
+bool SceneContext::SupportsInstancing() const {
+  return supports_instancing_;
+}
+
 }  // namespace scene
 }  // namespace impeller
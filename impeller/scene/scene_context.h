@@ -51,6 +51,13 @@ class SceneContext {
 
   std::shared_ptr<Texture> GetPlaceholderTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the pipelines of GeometryType::kUnskinnedInstanced
+  ///             are available, which needs instanced rendering and storage
+  ///             buffers.
+  ///
+  bool SupportsInstancing() const;
+
  private:
   class PipelineVariants {
    public:
@@ -118,6 +125,7 @@ class SceneContext {
   std::shared_ptr<Context> context_;
 
   bool is_valid_ = false;
+  bool supports_instancing_ = false;
   // A 1x1 opaque white texture that can be used as a placeholder binding.
   // Available for the lifetime of the scene context
   std::shared_ptr<Texture> placeholder_texture_;
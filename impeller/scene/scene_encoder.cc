@@ -4,6 +4,10 @@
 
 #include "flutter/fml/macros.h"
 
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/render_target.h"
@@ -44,6 +48,50 @@ static void EncodeCommand(const SceneContext& scene_context,
   render_pass.AddCommand(std::move(cmd));
 }
 
+static void EncodeInstancedCommand(const SceneContext& scene_context,
+                                   const Matrix& view_transform,
+                                   RenderPass& render_pass,
+                                   const SceneCommand& scene_command,
+                                   const std::vector<Matrix>& transforms) {
+  auto& host_buffer = render_pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = scene_command.label + " (Instanced)";
+  cmd.stencil_reference = 0;
+
+  cmd.pipeline = scene_context.GetPipeline(
+      PipelineKey{GeometryType::kUnskinnedInstanced,
+                  scene_command.material->GetMaterialType()},
+      scene_command.material->GetContextOptions(render_pass));
+
+  scene_command.geometry->BindInstancesToCommand(
+      scene_context, host_buffer, view_transform, transforms, cmd);
+  scene_command.material->BindToCommand(scene_context, host_buffer, cmd);
+
+  render_pass.AddCommand(std::move(cmd));
+}
+
+namespace {
+
+struct InstanceKey {
+  Geometry* geometry;
+  Material* material;
+
+  struct Hash {
+    std::size_t operator()(const InstanceKey& key) const {
+      return fml::HashCombine(key.geometry, key.material);
+    }
+  };
+
+  struct Equal {
+    bool operator()(const InstanceKey& lhs, const InstanceKey& rhs) const {
+      return lhs.geometry == rhs.geometry && lhs.material == rhs.material;
+    }
+  };
+};
+
+}  // namespace
+
 std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     const SceneContext& scene_context,
     const Matrix& camera_transform,
@@ -90,8 +138,40 @@ std::shared_ptr<CommandBuffer> SceneEncoder::BuildSceneCommandBuffer(
     return nullptr;
   }
 
+  // Skip the commands that can't be visible, and gather the commands that
+  // draw the same unskinned geometry with the same material so that they can
+  // be drawn with one instanced command. The groups are kept in the order of
+  // their first command.
+  const bool supports_instancing = scene_context.SupportsInstancing();
+  std::vector<std::pair<const SceneCommand*, std::vector<Matrix>>> groups;
+  std::unordered_map<InstanceKey, size_t, InstanceKey::Hash, InstanceKey::Equal>
+      group_indices;
   for (auto& command : commands_) {
-    EncodeCommand(scene_context, camera_transform, *render_pass, command);
+    auto bounds = command.geometry->GetBounds();
+    if (bounds.has_value() &&
+        bounds->IsOutsideFrustum(camera_transform * command.transform)) {
+      continue;
+    }
+    if (!supports_instancing ||
+        command.geometry->GetGeometryType() != GeometryType::kUnskinned) {
+      groups.push_back({&command, {command.transform}});
+      continue;
+    }
+    auto [found, inserted] = group_indices.try_emplace(
+        InstanceKey{command.geometry, command.material}, groups.size());
+    if (inserted) {
+      groups.push_back({&command, {}});
+    }
+    groups[found->second].second.push_back(command.transform);
+  }
+
+  for (const auto& [command, transforms] : groups) {
+    if (transforms.size() > 1) {
+      EncodeInstancedCommand(scene_context, camera_transform, *render_pass,
+                             *command, transforms);
+    } else {
+      EncodeCommand(scene_context, camera_transform, *render_pass, *command);
+    }
   }
 
   if (!render_pass->EncodeCommands()) {
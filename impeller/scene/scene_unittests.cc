@@ -34,6 +34,36 @@ namespace testing {
 using SceneTest = PlaygroundTest;
 INSTANTIATE_PLAYGROUND_SUITE(SceneTest);
 
+TEST(SceneBoundsTest, CullsBoxesOutsideFrustum) {
+  Aabb box{Vector3(-1, -1, -1), Vector3(1, 1, 1)};
+  Matrix projection = Matrix::MakePerspective(Degrees(60), 1.0, 0.1, 100);
+
+  ASSERT_FALSE(
+      box.IsOutsideFrustum(projection * Matrix::MakeTranslation({0, 0, 10})));
+  // Behind the camera.
+  ASSERT_TRUE(
+      box.IsOutsideFrustum(projection * Matrix::MakeTranslation({0, 0, -10})));
+  // Beyond the far plane.
+  ASSERT_TRUE(
+      box.IsOutsideFrustum(projection * Matrix::MakeTranslation({0, 0, 200})));
+  // Off to either side.
+  ASSERT_TRUE(
+      box.IsOutsideFrustum(projection * Matrix::MakeTranslation({50, 0, 10})));
+  ASSERT_TRUE(
+      box.IsOutsideFrustum(projection * Matrix::MakeTranslation({0, -50, 10})));
+  // Partly visible boxes are kept.
+  ASSERT_FALSE(
+      box.IsOutsideFrustum(projection * Matrix::MakeTranslation({6, 0, 10})));
+}
+
+TEST(SceneBoundsTest, CuboidBoundsMatchSize) {
+  auto cuboid = Geometry::MakeCuboid(Vector3(1, 2, 3));
+  auto bounds = cuboid->GetBounds();
+  ASSERT_TRUE(bounds.has_value());
+  ASSERT_EQ(bounds->min, Vector3());
+  ASSERT_EQ(bounds->max, Vector3(1, 2, 3));
+}
+
 TEST_P(SceneTest, CuboidUnlit) {
   auto scene_context = std::make_shared<SceneContext>(GetContext());
 
@@ -110,6 +140,32 @@ TEST_P(SceneTest, FlutterLogo) {
   OpenPlaygroundHere(callback);
 }
 
+TEST_P(SceneTest, UnpacksLazyMeshesWhenRendered) {
+  auto allocator = GetContext()->GetResourceAllocator();
+  std::shared_ptr<const fml::Mapping> mapping =
+      flutter::testing::OpenFixtureAsMapping("flutter_logo_baked.glb.ipscene");
+  ASSERT_NE(mapping, nullptr);
+
+  std::shared_ptr<Node> gltf_scene =
+      Node::MakeFromFlatbuffer(mapping, *allocator);
+  ASSERT_NE(gltf_scene, nullptr);
+  ASSERT_EQ(gltf_scene->GetChildren().size(), 1u);
+  Node& logo = *gltf_scene->GetChildren()[0];
+  ASSERT_TRUE(logo.GetMesh().GetPrimitives().empty());
+
+  auto scene_context = std::make_shared<SceneContext>(GetContext());
+  auto scene = Scene(scene_context);
+  scene.GetRoot().AddChild(gltf_scene);
+
+  auto render_target =
+      RenderTarget::CreateOffscreenMSAA(*GetContext(), {100, 100});
+  ASSERT_TRUE(scene.Render(render_target, Matrix()));
+  ASSERT_EQ(logo.GetMesh().GetPrimitives().size(), 1u);
+
+  // The mapping is released once every mesh is unpacked.
+  ASSERT_EQ(mapping.use_count(), 1);
+}
+
 TEST_P(SceneTest, TwoTriangles) {
   auto allocator = GetContext()->GetResourceAllocator();
 
@@ -7,6 +7,7 @@
 #include <cmath>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/fml/logging.h"
@@ -86,6 +87,13 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
   std::vector<Matrix> joints;
   joints.resize(result->GetSize().Area() / 4, Matrix());
   FML_DCHECK(joints.size() >= joints_.size());
+
+  // The model space matrices of the joints computed so far. Joints share most
+  // of their bones with their siblings, so each bone is only multiplied once
+  // rather than once per joint below it.
+  std::unordered_map<const Node*, Matrix> model_transforms;
+  model_transforms.reserve(joints_.size());
+  std::vector<const Node*> chain;
   for (size_t joint_i = 0; joint_i < joints_.size(); joint_i++) {
     const Node* joint = joints_[joint_i].get();
     if (!joint) {
@@ -94,11 +102,23 @@ std::shared_ptr<Texture> Skin::GetJointsTexture(Allocator& allocator) {
     }
 
     // Compute a model space matrix for the joint by walking up the bones to the
-    // skeleton root.
+    // skeleton root, or to the first bone whose matrix is already known.
+    Matrix transform;
+    chain.clear();
     while (joint && joint->IsJoint()) {
-      joints[joint_i] = joint->GetLocalTransform() * joints[joint_i];
+      auto found = model_transforms.find(joint);
+      if (found != model_transforms.end()) {
+        transform = found->second;
+        break;
+      }
+      chain.push_back(joint);
       joint = joint->GetParent();
     }
+    for (auto bone = chain.rbegin(); bone != chain.rend(); bone++) {
+      transform = transform * (*bone)->GetLocalTransform();
+      model_transforms[*bone] = transform;
+    }
+    joints[joint_i] = transform;
 
     // Get the joint transform relative to the default pose of the bone by
     // incorporating the joint's inverse bind matrix. The inverse bind matrix
@@ -4,9 +4,36 @@
 
 #include "tessellator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
 namespace impeller {
+
+// Appends the x and y coordinates of the triangles of |path| to |points|.
+static bool TessellatePath(const Tessellator& tessellator,
+                           const Path& path,
+                           Scalar tolerance,
+                           std::vector<float>& points) {
+  auto polyline = path.CreatePolyline(tolerance);
+  return tessellator.Tessellate(
+             path.GetFillType(), polyline,
+             [&points](const float* vertices, size_t vertices_size,
+                       const uint16_t* indices, size_t indices_size) {
+               // Results are expected to be re-duplicated.
+               points.reserve(points.size() + indices_size * 2);
+               for (auto i = 0u; i < indices_size; i++) {
+                 points.push_back(vertices[indices[i] * 2]);
+                 points.push_back(vertices[indices[i] * 2 + 1]);
+               }
+               return true;
+             }) == Tessellator::Result::kSuccess;
+}
+
 PathBuilder* CreatePathBuilder() {
   return new PathBuilder();
 }
@@ -41,24 +68,9 @@ struct Vertices* Tessellate(PathBuilder* builder,
                             int fill_type,
                             Scalar tolerance) {
   auto path = builder->CopyPath(static_cast<FillType>(fill_type));
-  auto polyline = path.CreatePolyline(tolerance);
   std::vector<float> points;
-  if (Tessellator{}.Tessellate(
-          path.GetFillType(), polyline,
-          [&points](const float* vertices, size_t vertices_size,
-                    const uint16_t* indices, size_t indices_size) {
-            // Results are expected to be re-duplicated.
-            std::vector<Point> raw_points;
-            for (auto i = 0u; i < vertices_size; i += 2) {
-              raw_points.emplace_back(Point{vertices[i], vertices[i + 1]});
-            }
-            for (auto i = 0u; i < indices_size; i++) {
-              auto point = raw_points[indices[i]];
-              points.push_back(point.x);
-              points.push_back(point.y);
-            }
-            return true;
-          }) != Tessellator::Result::kSuccess) {
+  if (!TessellatePath(*Tessellator::GetForCurrentThread(), path, tolerance,
+                      points)) {
     return nullptr;
   }
 
@@ -73,8 +85,144 @@ struct Vertices* Tessellate(PathBuilder* builder,
 }
 
 void DestroyVertices(Vertices* vertices) {
-  delete vertices->points;
+  delete[] vertices->points;
   delete vertices;
 }
 
+// The threads that batches are tessellated on besides the calling thread. They
+// are kept for the next batches rather than started for every batch, and keep
+// their tessellators along with the memory of their last tessellations.
+static const std::shared_ptr<fml::ConcurrentMessageLoop>& GetBatchWorkers() {
+  static const std::shared_ptr<fml::ConcurrentMessageLoop> workers =
+      fml::ConcurrentMessageLoop::Create(
+          std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+  return workers;
+}
+
+// Returns the fill type of the path at |index| of |batch|, or false if it is
+// not one of the fill types.
+static bool GetBatchFillType(const PathBatch& batch,
+                             uint32_t index,
+                             FillType& fill_type) {
+  if (!batch.fill_types) {
+    fill_type = FillType::kNonZero;
+    return true;
+  }
+  if (batch.fill_types[index] > static_cast<uint8_t>(FillType::kAbsGeqTwo)) {
+    return false;
+  }
+  fill_type = static_cast<FillType>(batch.fill_types[index]);
+  return true;
+}
+
+// Builds the path at |index| of |batch|, or returns false if its verbs take
+// more points than it has.
+static bool BuildBatchPath(const PathBatch& batch,
+                           uint32_t index,
+                           PathBuilder& builder) {
+  const float* points = batch.points + batch.point_offsets[index] * 2;
+  const float* points_end = batch.points + batch.point_offsets[index + 1] * 2;
+  auto take_point = [&points, points_end](Point& point) {
+    if (points_end - points < 2) {
+      return false;
+    }
+    point = Point(points[0], points[1]);
+    points += 2;
+    return true;
+  };
+  Point p1, p2, p3;
+  for (auto i = batch.verb_offsets[index]; i < batch.verb_offsets[index + 1];
+       i++) {
+    switch (batch.verbs[i]) {
+      case kPathVerbMoveTo:
+        if (!take_point(p1)) {
+          return false;
+        }
+        builder.MoveTo(p1);
+        break;
+      case kPathVerbLineTo:
+        if (!take_point(p1)) {
+          return false;
+        }
+        builder.LineTo(p1);
+        break;
+      case kPathVerbCubicTo:
+        if (!take_point(p1) || !take_point(p2) || !take_point(p3)) {
+          return false;
+        }
+        builder.CubicCurveTo(p1, p2, p3);
+        break;
+      case kPathVerbClose:
+        builder.Close();
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+uint32_t TessellateBatch(const PathBatch* batch,
+                         Scalar tolerance,
+                         uint32_t thread_count,
+                         float* vertices,
+                         uint32_t vertices_capacity,
+                         uint32_t* vertex_offsets) {
+  const uint32_t path_count = batch->path_count;
+  std::vector<std::vector<float>> results(path_count);
+
+  // Each thread takes the next path that no other thread took yet, so that
+  // the threads stay busy however long the paths take.
+  std::atomic<uint32_t> next_path = 0u;
+  auto tessellate_paths = [batch, tolerance, &results, &next_path]() {
+    const auto& tessellator = Tessellator::GetForCurrentThread();
+    for (auto i = next_path++; i < batch->path_count; i = next_path++) {
+      PathBuilder builder;
+      FillType fill_type;
+      if (!GetBatchFillType(*batch, i, fill_type) ||
+          !BuildBatchPath(*batch, i, builder)) {
+        continue;
+      }
+      if (!TessellatePath(*tessellator, builder.TakePath(fill_type), tolerance,
+                          results[i])) {
+        results[i].clear();
+      }
+    }
+  };
+
+  // The calling thread tessellates paths too.
+  size_t worker_count = 0u;
+  if (thread_count > 1u && path_count > 1u) {
+    const auto& workers = GetBatchWorkers();
+    worker_count = std::min<size_t>(std::min(thread_count, path_count) - 1u,
+                                    workers->GetWorkerCount());
+  }
+  fml::CountDownLatch latch(worker_count);
+  if (worker_count > 0u) {
+    auto runner = GetBatchWorkers()->GetTaskRunner();
+    for (auto i = 0u; i < worker_count; i++) {
+      runner->PostTask([&tessellate_paths, &latch]() {
+        tessellate_paths();
+        latch.CountDown();
+      });
+    }
+  }
+  tessellate_paths();
+  latch.Wait();
+
+  uint32_t size = 0u;
+  for (auto i = 0u; i < path_count; i++) {
+    vertex_offsets[i] = size;
+    size += results[i].size();
+  }
+  vertex_offsets[path_count] = size;
+  if (size <= vertices_capacity) {
+    for (auto i = 0u; i < path_count; i++) {
+      std::copy(results[i].begin(), results[i].end(),
+                vertices + vertex_offsets[i]);
+    }
+  }
+  return size;
+}
+
 }  // namespace impeller
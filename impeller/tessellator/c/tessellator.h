@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "impeller/geometry/path_builder.h"
 #include "impeller/tessellator/tessellator.h"
 
@@ -46,5 +48,59 @@ IMPELLER_API struct Vertices* Tessellate(PathBuilder* builder,
 
 IMPELLER_API void DestroyVertices(Vertices* vertices);
 
+/// The verbs of the paths of a |PathBatch|.
+enum PathVerb : uint8_t {
+  /// Takes one point.
+  kPathVerbMoveTo,
+  /// Takes one point.
+  kPathVerbLineTo,
+  /// Takes the two control points and the end point.
+  kPathVerbCubicTo,
+  /// Takes no points.
+  kPathVerbClose,
+};
+
+/// Paths laid out one after the other, so that many of them can be
+/// tessellated with one call.
+struct IMPELLER_API PathBatch {
+  uint32_t path_count;
+  /// The verbs of all of the paths. The verbs of path i are those from
+  /// verb_offsets[i] to verb_offsets[i + 1], so there are path_count + 1
+  /// verb offsets.
+  const uint8_t* verbs;
+  const uint32_t* verb_offsets;
+  /// The x and y coordinates of the points that the verbs of all of the paths
+  /// take. The points of path i start at the point point_offsets[i] and end
+  /// before point_offsets[i + 1].
+  const float* points;
+  const uint32_t* point_offsets;
+  /// The fill type of each path, as the index of its |FillType|, or null for
+  /// all of them to fill non-zero.
+  const uint8_t* fill_types;
+};
+
+/// Tessellates the paths of |batch| into |vertices|, as the x and y
+/// coordinates of their triangles, like |Tessellate| does.
+///
+/// The paths are tessellated on up to |thread_count| threads, or on the
+/// calling thread if it is 0 or 1. The threads besides the calling thread are
+/// shared by all batches and kept between them, and there are at most as many
+/// of them as the hardware has threads, less one. The vertices of path i are
+/// written from the float vertex_offsets[i] to vertex_offsets[i + 1], so
+/// |vertex_offsets| has room for path_count + 1 offsets. Paths that are
+/// malformed, that have an unknown verb or fill type, or that fail to
+/// tessellate have no vertices.
+///
+/// Returns the number of floats that the vertices of all of the paths take.
+/// The offsets are written regardless, but the vertices are only written if
+/// they fit into the |vertices_capacity| floats of |vertices|. Otherwise the
+/// batch can be tessellated again with at least the returned capacity.
+IMPELLER_API uint32_t TessellateBatch(const PathBatch* batch,
+                                      Scalar tolerance,
+                                      uint32_t thread_count,
+                                      float* vertices,
+                                      uint32_t vertices_capacity,
+                                      uint32_t* vertex_offsets);
+
 }  // namespace impeller
 }
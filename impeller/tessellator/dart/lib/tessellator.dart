@@ -5,8 +5,11 @@
 // ignore_for_file: camel_case_types
 import 'dart:ffi' as ffi;
 import 'dart:io';
+import 'dart:math' as math;
 import 'dart:typed_data';
 
+import 'package:ffi/ffi.dart';
+
 /// Determines the winding rule that decides how the interior of a Path is
 /// calculated.
 ///
@@ -132,6 +135,159 @@ class VerticesBuilder {
   }
 }
 
+/// Creates the vertices of many paths with one native call.
+///
+/// Build up the contours of each path with the [moveTo], [lineTo], [cubicTo],
+/// and [close] methods, like with [VerticesBuilder], and end each path with
+/// [endPath]. Then use the [tessellate] method to create a [Float32List] of
+/// vertex pairs for each path.
+///
+/// Unlike [VerticesBuilder], this class holds no native resources between
+/// calls, and needs no disposing.
+class PathBatchBuilder {
+  final List<int> _verbs = <int>[];
+  final List<int> _verbOffsets = <int>[0];
+  final List<double> _points = <double>[];
+  final List<int> _pointOffsets = <int>[0];
+  final List<int> _fillTypes = <int>[];
+
+  /// The number of paths ended with [endPath] so far.
+  int get pathCount => _fillTypes.length;
+
+  /// Adds a move verb to the absolute coordinates x,y.
+  void moveTo(double x, double y) {
+    _verbs.add(_kPathVerbMoveTo);
+    _points
+      ..add(x)
+      ..add(y);
+  }
+
+  /// Adds a line verb to the absolute coordinates x,y.
+  void lineTo(double x, double y) {
+    _verbs.add(_kPathVerbLineTo);
+    _points
+      ..add(x)
+      ..add(y);
+  }
+
+  /// Adds a cubic Bezier curve with x1,y1 as the first control point, x2,y2 as
+  /// the second control point, and end point x3,y3.
+  void cubicTo(
+    double x1,
+    double y1,
+    double x2,
+    double y2,
+    double x3,
+    double y3,
+  ) {
+    _verbs.add(_kPathVerbCubicTo);
+    _points.addAll(<double>[x1, y1, x2, y2, x3, y3]);
+  }
+
+  /// Adds a close command to the start of the current contour.
+  void close() {
+    _verbs.add(_kPathVerbClose);
+  }
+
+  /// Ends the path created by the method calls since the last path ended,
+  /// which is filled according to [fillType].
+  void endPath({FillType fillType = FillType.nonZero}) {
+    _verbOffsets.add(_verbs.length);
+    _pointOffsets.add(_points.length ~/ 2);
+    _fillTypes.add(fillType.index);
+  }
+
+  /// Tessellates the paths ended so far into a list of vertices for each of
+  /// them, in the order they were ended.
+  ///
+  /// The paths are tessellated on up to [threadCount] threads. Paths that
+  /// fail to tessellate have no vertices.
+  List<Float32List> tessellate({
+    SmoothingApproximation smoothing = const SmoothingApproximation(),
+    int threadCount = 1,
+  }) {
+    final int pathCount = this.pathCount;
+    if (pathCount == 0) {
+      return <Float32List>[];
+    }
+    final ffi.Pointer<_PathBatch> batch = malloc<_PathBatch>();
+    final ffi.Pointer<ffi.Uint8> verbs = malloc<ffi.Uint8>(
+      math.max(_verbs.length, 1),
+    );
+    final ffi.Pointer<ffi.Uint32> verbOffsets =
+        malloc<ffi.Uint32>(pathCount + 1);
+    final ffi.Pointer<ffi.Float> points = malloc<ffi.Float>(
+      math.max(_points.length, 1),
+    );
+    final ffi.Pointer<ffi.Uint32> pointOffsets =
+        malloc<ffi.Uint32>(pathCount + 1);
+    final ffi.Pointer<ffi.Uint8> fillTypes = malloc<ffi.Uint8>(pathCount);
+    final ffi.Pointer<ffi.Uint32> vertexOffsets =
+        malloc<ffi.Uint32>(pathCount + 1);
+    ffi.Pointer<ffi.Float> vertices = ffi.nullptr;
+    try {
+      verbs.asTypedList(_verbs.length).setAll(0, _verbs);
+      verbOffsets.asTypedList(pathCount + 1).setAll(0, _verbOffsets);
+      points.asTypedList(_points.length).setAll(0, _points);
+      pointOffsets.asTypedList(pathCount + 1).setAll(0, _pointOffsets);
+      fillTypes.asTypedList(pathCount).setAll(0, _fillTypes);
+      batch.ref
+        ..pathCount = pathCount
+        ..verbs = verbs
+        ..verbOffsets = verbOffsets
+        ..points = points
+        ..pointOffsets = pointOffsets
+        ..fillTypes = fillTypes;
+
+      // Filled paths usually have a few triangles per point. If they need
+      // more room, the batch is tessellated again with enough of it.
+      int capacity = math.max(_points.length * 3, 1);
+      vertices = malloc<ffi.Float>(capacity);
+      int size = _tessellateBatchFn(
+        batch,
+        smoothing.scale,
+        threadCount,
+        vertices,
+        capacity,
+        vertexOffsets,
+      );
+      if (size > capacity) {
+        malloc.free(vertices);
+        capacity = size;
+        vertices = malloc<ffi.Float>(capacity);
+        size = _tessellateBatchFn(
+          batch,
+          smoothing.scale,
+          threadCount,
+          vertices,
+          capacity,
+          vertexOffsets,
+        );
+      }
+
+      final Float32List allVertices = vertices.asTypedList(size);
+      final Uint32List offsets = vertexOffsets.asTypedList(pathCount + 1);
+      return List<Float32List>.generate(
+        pathCount,
+        (int i) => Float32List.fromList(
+          allVertices.sublist(offsets[i], offsets[i + 1]),
+        ),
+      );
+    } finally {
+      malloc.free(batch);
+      malloc.free(verbs);
+      malloc.free(verbOffsets);
+      malloc.free(points);
+      malloc.free(pointOffsets);
+      malloc.free(fillTypes);
+      malloc.free(vertexOffsets);
+      if (vertices != ffi.nullptr) {
+        malloc.free(vertices);
+      }
+    }
+  }
+}
+
 // TODO(dnfield): Figure out where to put this.
 // https://github.com/flutter/flutter/issues/99563
 final ffi.DynamicLibrary _dylib = () {
@@ -154,6 +310,27 @@ class _Vertices extends ffi.Struct {
 
 class _PathBuilder extends ffi.Opaque {}
 
+// must match PathVerb in c/tessellator.h
+const int _kPathVerbMoveTo = 0;
+const int _kPathVerbLineTo = 1;
+const int _kPathVerbCubicTo = 2;
+const int _kPathVerbClose = 3;
+
+class _PathBatch extends ffi.Struct {
+  @ffi.Uint32()
+  external int pathCount;
+
+  external ffi.Pointer<ffi.Uint8> verbs;
+
+  external ffi.Pointer<ffi.Uint32> verbOffsets;
+
+  external ffi.Pointer<ffi.Float> points;
+
+  external ffi.Pointer<ffi.Uint32> pointOffsets;
+
+  external ffi.Pointer<ffi.Uint8> fillTypes;
+}
+
 typedef _CreatePathBuilderType = ffi.Pointer<_PathBuilder> Function();
 typedef _create_path_builder_type = ffi.Pointer<_PathBuilder> Function();
 
@@ -245,3 +422,25 @@ final _DestroyVerticesType _destroyVerticesFn =
     _dylib.lookupFunction<_destroy_vertices_type, _DestroyVerticesType>(
   'DestroyVertices',
 );
+
+typedef _TessellateBatchType = int Function(
+  ffi.Pointer<_PathBatch>,
+  double,
+  int,
+  ffi.Pointer<ffi.Float>,
+  int,
+  ffi.Pointer<ffi.Uint32>,
+);
+typedef _tessellate_batch_type = ffi.Uint32 Function(
+  ffi.Pointer<_PathBatch>,
+  ffi.Float,
+  ffi.Uint32,
+  ffi.Pointer<ffi.Float>,
+  ffi.Uint32,
+  ffi.Pointer<ffi.Uint32>,
+);
+
+final _TessellateBatchType _tessellateBatchFn =
+    _dylib.lookupFunction<_tessellate_batch_type, _TessellateBatchType>(
+  'TessellateBatch',
+);
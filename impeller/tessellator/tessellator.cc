@@ -4,38 +4,135 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include "impeller/geometry/constants.h"
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
 
-static void* HeapAlloc(void* userData, unsigned int size) {
-  return malloc(size);
-}
+//------------------------------------------------------------------------------
+/// @brief      The memory of the libtess state of one tessellation. It is all
+///             released at once when the next tessellation starts, and the
+///             blocks it was allocated from are kept for the tessellations
+///             after that, so libtess doesn't allocate from the heap once the
+///             blocks are large enough.
+///
+class TessellatorArena {
+ public:
+  TessellatorArena()
+      : alloc_{
+            ArenaAlloc, ArenaRealloc, ArenaFree, this, /* =userData */
+            16,  /* =meshEdgeBucketSize */
+            16,  /* =meshVertexBucketSize */
+            16,  /* =meshFaceBucketSize */
+            16,  /* =dictNodeBucketSize */
+            16,  /* =regionBucketSize */
+            0    /* =extraVertices */
+        } {}
 
-static void* HeapRealloc(void* userData, void* ptr, unsigned int size) {
-  return realloc(ptr, size);
-}
+  TESSalloc* GetAllocator() { return &alloc_; }
 
-static void HeapFree(void* userData, void* ptr) {
-  free(ptr);
-}
+  /// Releases every allocation.
+  void Reset() {
+    if (blocks_.size() > 1) {
+      // Replace the blocks with one that fits all of them, so that the next
+      // tessellation of the same size doesn't need more than one.
+      size_t total_size = 0;
+      for (const auto& block : blocks_) {
+        total_size += block.size;
+      }
+      blocks_.clear();
+      AddBlock(total_size);
+    }
+    current_block_ = 0;
+    offset_ = 0;
+  }
+
+ private:
+  static constexpr size_t kMinBlockSize = 64 * 1024;
+  // Every allocation starts with its size, so that it can be reallocated.
+  static constexpr size_t kHeaderSize = alignof(std::max_align_t);
+
+  struct Block {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size = 0;
+  };
+
+  TESSalloc alloc_;
+  std::vector<Block> blocks_;
+  size_t current_block_ = 0;
+  size_t offset_ = 0;
 
-// Note: these units are "number of entities" for bucket size and not in KB.
-static TESSalloc alloc = {
-    HeapAlloc, HeapRealloc, HeapFree, 0, /* =userData */
-    16,                                  /* =meshEdgeBucketSize */
-    16,                                  /* =meshVertexBucketSize */
-    16,                                  /* =meshFaceBucketSize */
-    16,                                  /* =dictNodeBucketSize */
-    16,                                  /* =regionBucketSize */
-    0                                    /* =extraVertices */
+  void AddBlock(size_t size) {
+    size = std::max(size, kMinBlockSize);
+    blocks_.push_back({std::make_unique<uint8_t[]>(size), size});
+  }
+
+  void* Allocate(size_t size) {
+    const size_t aligned_size =
+        kHeaderSize + (size + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+    while (current_block_ < blocks_.size() &&
+           offset_ + aligned_size > blocks_[current_block_].size) {
+      current_block_++;
+      offset_ = 0;
+    }
+    if (current_block_ == blocks_.size()) {
+      AddBlock(aligned_size);
+      offset_ = 0;
+    }
+    uint8_t* allocation = blocks_[current_block_].data.get() + offset_;
+    offset_ += aligned_size;
+    std::memcpy(allocation, &size, sizeof(size));
+    return allocation + kHeaderSize;
+  }
+
+  void* Reallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+      return Allocate(size);
+    }
+    size_t old_size = 0;
+    std::memcpy(&old_size, static_cast<uint8_t*>(ptr) - kHeaderSize,
+                sizeof(old_size));
+    if (size <= old_size) {
+      return ptr;
+    }
+    void* allocation = Allocate(size);
+    std::memcpy(allocation, ptr, old_size);
+    return allocation;
+  }
+
+  static void* ArenaAlloc(void* user_data, unsigned int size) {
+    return static_cast<TessellatorArena*>(user_data)->Allocate(size);
+  }
+
+  static void* ArenaRealloc(void* user_data, void* ptr, unsigned int size) {
+    return static_cast<TessellatorArena*>(user_data)->Reallocate(ptr, size);
+  }
+
+  static void ArenaFree(void* user_data, void* ptr) {
+    // Everything is released when the arena is reset.
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TessellatorArena);
 };
 
-Tessellator::Tessellator()
-    : c_tessellator_(::tessNewTess(&alloc), &DestroyTessellator) {}
+Tessellator::Tessellator() : arena_(std::make_unique<TessellatorArena>()) {}
 
 Tessellator::~Tessellator() = default;
 
+const std::shared_ptr<Tessellator>& Tessellator::GetForCurrentThread() {
+  thread_local std::shared_ptr<Tessellator> tessellator =
+      std::make_shared<Tessellator>();
+  return tessellator;
+}
+
 static int ToTessWindingRule(FillType fill_type) {
   switch (fill_type) {
     case FillType::kOdd:
@@ -52,6 +149,214 @@ static int ToTessWindingRule(FillType fill_type) {
   return TESS_WINDING_ODD;
 }
 
+/// The points of a polyline with a single contour, without repeated points
+/// or the points that close the contour.
+static void GetSingleContourPoints(const Path::Polyline& polyline,
+                                   std::vector<Point>& points) {
+  points.clear();
+  if (polyline.contours.size() != 1u) {
+    return;
+  }
+  for (const auto& point : polyline.points) {
+    if (points.empty() || points.back() != point) {
+      points.push_back(point);
+    }
+  }
+  while (points.size() > 1 && points.front() == points.back()) {
+    points.pop_back();
+  }
+}
+
+/// Twice the signed area enclosed by the closed contour.
+static Scalar ComputeSignedArea(const std::vector<Point>& points) {
+  Scalar area = 0;
+  for (size_t i = 0; i < points.size(); i++) {
+    area += points[i].Cross(points[(i + 1) % points.size()]);
+  }
+  return area;
+}
+
+/// Whether the closed contour turns in one direction only, and at most once
+/// around.
+static bool IsConvex(const std::vector<Point>& points) {
+  const size_t count = points.size();
+  Scalar direction = 0;
+  Scalar total_turn = 0;
+  for (size_t i = 0; i < count; i++) {
+    auto edge = points[(i + 1) % count] - points[i];
+    auto next_edge = points[(i + 2) % count] - points[(i + 1) % count];
+    auto cross = edge.Cross(next_edge);
+    if (cross != 0) {
+      if (cross * direction < 0) {
+        return false;
+      }
+      direction = cross;
+    }
+    total_turn += std::atan2(cross, edge.Dot(next_edge));
+  }
+  // A star turns in one direction too, but more than once around.
+  return std::abs(total_turn) < kPi * 2 + kEhCloseEnough;
+}
+
+/// Triangulates a closed contour that is monotone in y, which each
+/// horizontal line crosses at most twice, by sweeping it from top to bottom.
+///
+/// Returns false if the contour is not monotone, or if its two chains cross
+/// so that it is not simple.
+static bool TriangulateMonotone(const std::vector<Point>& points,
+                                Scalar area,
+                                std::vector<uint16_t>& indices) {
+  const size_t count = points.size();
+  // Points at the same height are ordered from left to right, so that
+  // horizontal edges don't need special cases.
+  auto is_below = [&points](size_t a, size_t b) {
+    return points[a].y > points[b].y ||
+           (points[a].y == points[b].y && points[a].x > points[b].x);
+  };
+  size_t top = 0;
+  size_t bottom = 0;
+  for (size_t i = 1; i < count; i++) {
+    if (is_below(top, i)) {
+      top = i;
+    }
+    if (is_below(i, bottom)) {
+      bottom = i;
+    }
+  }
+
+  // Merge the chain that follows the contour from the top to the bottom with
+  // the one that goes back around, in the order of the sweep.
+  struct SweepPoint {
+    uint16_t index;
+    bool is_forward_chain;
+  };
+  std::vector<SweepPoint> sweep;
+  sweep.reserve(count);
+  sweep.push_back({static_cast<uint16_t>(top), true});
+  size_t forward = (top + 1) % count;
+  size_t backward = (top + count - 1) % count;
+  size_t last_forward = top;
+  size_t last_backward = top;
+  while (forward != bottom || backward != bottom) {
+    const bool take_forward =
+        backward == bottom ||
+        (forward != bottom && is_below(backward, forward));
+    if (take_forward) {
+      if (!is_below(forward, last_forward)) {
+        return false;
+      }
+      sweep.push_back({static_cast<uint16_t>(forward), true});
+      last_forward = forward;
+      forward = (forward + 1) % count;
+    } else {
+      if (!is_below(backward, last_backward)) {
+        return false;
+      }
+      sweep.push_back({static_cast<uint16_t>(backward), false});
+      last_backward = backward;
+      backward = (backward + count - 1) % count;
+    }
+  }
+  if (!is_below(bottom, last_forward) || !is_below(bottom, last_backward)) {
+    return false;
+  }
+
+  Scalar triangles_area = 0;
+  auto add_triangle = [&](uint16_t a, uint16_t b, uint16_t c) {
+    indices.push_back(a);
+    indices.push_back(b);
+    indices.push_back(c);
+    triangles_area +=
+        std::abs((points[b] - points[a]).Cross(points[c] - points[a]));
+  };
+
+  std::vector<SweepPoint> stack = {sweep[0], sweep[1]};
+  for (size_t i = 2; i < sweep.size(); i++) {
+    const auto& point = sweep[i];
+    if (point.is_forward_chain != stack.back().is_forward_chain) {
+      // Every point on the stack can be seen from a point on the other chain.
+      for (size_t j = 0; j + 1 < stack.size(); j++) {
+        add_triangle(point.index, stack[j].index, stack[j + 1].index);
+      }
+      auto last = stack.back();
+      stack.clear();
+      stack.push_back(last);
+      stack.push_back(point);
+      continue;
+    }
+    // Points on the same chain can be seen for as long as the chain turns
+    // towards the inside of the contour.
+    auto last = stack.back();
+    stack.pop_back();
+    while (!stack.empty()) {
+      const auto& previous = stack.back();
+      Scalar turn = (points[last.index] - points[previous.index])
+                        .Cross(points[point.index] - points[last.index]);
+      if (!point.is_forward_chain) {
+        turn = -turn;
+      }
+      if (turn * area <= 0) {
+        break;
+      }
+      add_triangle(point.index, last.index, previous.index);
+      last = previous;
+      stack.pop_back();
+    }
+    stack.push_back(last);
+    stack.push_back(point);
+  }
+  const auto bottom_index = static_cast<uint16_t>(bottom);
+  for (size_t j = 0; j + 1 < stack.size(); j++) {
+    add_triangle(bottom_index, stack[j].index, stack[j + 1].index);
+  }
+
+  // The triangles of a simple contour exactly cover it. When the chains
+  // cross, the crossing lobes are wound in opposite directions and partly
+  // cancel out in the area of the contour.
+  return triangles_area <= std::abs(area) * (1 + kEhCloseEnough);
+}
+
+/// Fills polylines with a single simple contour, which are by far the most
+/// common ones, without the setup cost of libtess. Returns std::nullopt if
+/// the polyline must be tessellated by libtess.
+static std::optional<Tessellator::Result> TessellateSimpleContour(
+    FillType fill_type,
+    const Path::Polyline& polyline,
+    const Tessellator::BuilderCallback& callback,
+    std::vector<Point>& points,
+    std::vector<uint16_t>& indices) {
+  // Like libtess, which orients contours so that the area they enclose is
+  // positive, a simple contour winds once around its inside.
+  if (fill_type != FillType::kNonZero && fill_type != FillType::kOdd &&
+      fill_type != FillType::kPositive) {
+    return std::nullopt;
+  }
+  GetSingleContourPoints(polyline, points);
+  if (points.size() < 3 ||
+      points.size() > std::numeric_limits<uint16_t>::max()) {
+    return std::nullopt;
+  }
+
+  indices.clear();
+  const auto area = ComputeSignedArea(points);
+  if (IsConvex(points)) {
+    for (size_t i = 1; i + 1 < points.size(); i++) {
+      indices.push_back(0);
+      indices.push_back(static_cast<uint16_t>(i));
+      indices.push_back(static_cast<uint16_t>(i + 1));
+    }
+  } else if (!TriangulateMonotone(points, area, indices)) {
+    return std::nullopt;
+  }
+
+  static_assert(sizeof(Point) == 2 * sizeof(float));
+  if (!callback(reinterpret_cast<const float*>(points.data()),
+                points.size() * 2, indices.data(), indices.size())) {
+    return Tessellator::Result::kInputError;
+  }
+  return Tessellator::Result::kSuccess;
+}
+
 Tessellator::Result Tessellator::Tessellate(
     FillType fill_type,
     const Path::Polyline& polyline,
@@ -64,7 +369,16 @@ Tessellator::Result Tessellator::Tessellate(
     return Result::kInputError;
   }
 
-  auto tessellator = c_tessellator_.get();
+  if (auto result = TessellateSimpleContour(fill_type, polyline, callback,
+                                            points_, indices_);
+      result.has_value()) {
+    return result.value();
+  }
+
+  // The state of the last tessellation is released with the arena, so it
+  // isn't deleted.
+  arena_->Reset();
+  auto tessellator = ::tessNewTess(arena_->GetAllocator());
   if (!tessellator) {
     return Result::kTessellationError;
   }
@@ -111,11 +425,11 @@ Tessellator::Result Tessellator::Tessellate(
   auto elements = tessGetElements(tessellator);
   // libtess uses an int index internally due to usage of -1 as a sentinel
   // value.
-  std::vector<uint16_t> indices(elementItemCount);
+  indices_.resize(elementItemCount);
   for (int i = 0; i < elementItemCount; i++) {
-    indices[i] = static_cast<uint16_t>(elements[i]);
+    indices_[i] = static_cast<uint16_t>(elements[i]);
   }
-  if (!callback(vertices, vertexItemCount, indices.data(), elementItemCount)) {
+  if (!callback(vertices, vertexItemCount, indices_.data(), elementItemCount)) {
     return Result::kInputError;
   }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "flutter/fml/macros.h"
@@ -15,6 +16,8 @@ struct TESStesselator;
 
 namespace impeller {
 
+class TessellatorArena;
+
 void DestroyTessellator(TESStesselator* tessellator);
 
 using CTessellator =
@@ -29,6 +32,11 @@ enum class WindingOrder {
 /// @brief      A utility that generates triangles of the specified fill type
 ///             given a polyline. This happens on the CPU.
 ///
+///             A tessellator keeps the memory of its last tessellation for
+///             the next one, so it must only be used by one thread at a time.
+///             Each thread that prepares geometry can use its own instance
+///             from `GetForCurrentThread`.
+///
 /// @bug        This should just be called a triangulator.
 ///
 class Tessellator {
@@ -43,6 +51,13 @@ class Tessellator {
 
   ~Tessellator();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The tessellator of the calling thread, which is created the
+  ///             first time it is requested. It must not be used by any other
+  ///             thread.
+  ///
+  static const std::shared_ptr<Tessellator>& GetForCurrentThread();
+
   using BuilderCallback = std::function<bool(const float* vertices,
                                              size_t vertices_size,
                                              const uint16_t* indices,
@@ -55,6 +70,8 @@ class Tessellator {
   /// @param[in]  fill_type The fill rule to use when filling.
   /// @param[in]  polyline  The polyline
   /// @param[in]  callback  The callback, return false to indicate failure.
+  ///                       The vertices and indices are only valid until
+  ///                       the callback returns.
   ///
   /// @return The result status of the tessellation.
   ///
@@ -63,7 +80,11 @@ class Tessellator {
                                  const BuilderCallback& callback) const;
 
  private:
-  CTessellator c_tessellator_;
+  std::unique_ptr<TessellatorArena> arena_;
+  // Reused by each tessellation, so that their storage is only allocated
+  // once it needs to grow.
+  mutable std::vector<Point> points_;
+  mutable std::vector<uint16_t> indices_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(Tessellator);
 };
@@ -2,9 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+#include <thread>
+#include <vector>
+
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
 #include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/c/tessellator.h"
 #include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
@@ -84,5 +89,222 @@ TEST(TessellatorTest, TessellatorBuilderReturnsCorrectResultStatus) {
   }
 }
 
+TEST(TessellatorTest, ConvexContoursAreFannedWithoutRepeatedPoints) {
+  Tessellator t;
+  auto polyline = PathBuilder{}
+                      .AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                      .TakePath()
+                      .CreatePolyline(1.0f);
+  size_t vertex_count = 0;
+  std::vector<uint16_t> triangles;
+  Tessellator::Result result = t.Tessellate(
+      FillType::kNonZero, polyline,
+      [&](const float* vertices, size_t vertices_size, const uint16_t* indices,
+          size_t indices_size) {
+        vertex_count = vertices_size / 2;
+        triangles.assign(indices, indices + indices_size);
+        return true;
+      });
+
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  ASSERT_EQ(vertex_count, 4u);
+  ASSERT_EQ(triangles, std::vector<uint16_t>({0, 1, 2, 0, 2, 3}));
+}
+
+TEST(TessellatorTest, MonotoneContoursAreTriangulated) {
+  Tessellator t;
+  // A sawtooth whose teeth point right. Every horizontal line crosses it at
+  // most twice.
+  auto polyline = PathBuilder{}
+                      .MoveTo({0, 0})
+                      .LineTo({10, 0})
+                      .LineTo({6, 3})
+                      .LineTo({10, 6})
+                      .LineTo({6, 9})
+                      .LineTo({10, 12})
+                      .LineTo({0, 12})
+                      .LineTo({3, 6})
+                      .Close()
+                      .TakePath()
+                      .CreatePolyline(1.0f);
+  std::vector<Point> points;
+  std::vector<uint16_t> triangles;
+  Tessellator::Result result = t.Tessellate(
+      FillType::kNonZero, polyline,
+      [&](const float* vertices, size_t vertices_size, const uint16_t* indices,
+          size_t indices_size) {
+        auto first = reinterpret_cast<const Point*>(vertices);
+        points.assign(first, first + vertices_size / 2);
+        triangles.assign(indices, indices + indices_size);
+        return true;
+      });
+
+  ASSERT_EQ(result, Tessellator::Result::kSuccess);
+  ASSERT_EQ(points.size(), 8u);
+  ASSERT_EQ(triangles.size(), 6u * 3u);
+  // The triangles exactly cover the contour.
+  Scalar area = 0;
+  for (size_t i = 0; i < triangles.size(); i += 3) {
+    auto a = points[triangles[i]];
+    auto b = points[triangles[i + 1]];
+    auto c = points[triangles[i + 2]];
+    area += std::abs((b - a).Cross(c - a)) / 2;
+  }
+  ASSERT_FLOAT_EQ(area, 78.0f);
+}
+
+TEST(TessellatorTest, ReusedTessellatorProducesTheSameResults) {
+  Tessellator t;
+  // Two contours are tessellated by libtess, from memory that is reused.
+  auto polyline = PathBuilder{}
+                      .AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                      .AddCircle({20, 20}, 5)
+                      .TakePath()
+                      .CreatePolyline(1.0f);
+  auto tessellate = [&]() {
+    std::vector<float> result;
+    auto status = t.Tessellate(
+        FillType::kNonZero, polyline,
+        [&](const float* vertices, size_t vertices_size,
+            const uint16_t* indices, size_t indices_size) {
+          result.assign(vertices, vertices + vertices_size);
+          for (size_t i = 0; i < indices_size; i++) {
+            result.push_back(indices[i]);
+          }
+          return true;
+        });
+    EXPECT_EQ(status, Tessellator::Result::kSuccess);
+    return result;
+  };
+
+  auto first = tessellate();
+  ASSERT_FALSE(first.empty());
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(tessellate(), first);
+  }
+}
+
+TEST(TessellatorTest, EachThreadHasItsOwnTessellator) {
+  auto tessellator = Tessellator::GetForCurrentThread().get();
+  ASSERT_NE(tessellator, nullptr);
+  ASSERT_EQ(Tessellator::GetForCurrentThread().get(), tessellator);
+
+  Tessellator* other_tessellator = nullptr;
+  std::thread thread(
+      [&]() { other_tessellator = Tessellator::GetForCurrentThread().get(); });
+  thread.join();
+  ASSERT_NE(other_tessellator, nullptr);
+  ASSERT_NE(other_tessellator, tessellator);
+}
+
+// A triangle followed by a square, each closed.
+struct TestPathBatch {
+  std::vector<uint8_t> verbs = {
+      kPathVerbMoveTo, kPathVerbLineTo, kPathVerbLineTo, kPathVerbClose,
+      kPathVerbMoveTo, kPathVerbLineTo, kPathVerbLineTo, kPathVerbLineTo,
+      kPathVerbClose,
+  };
+  std::vector<uint32_t> verb_offsets = {0, 4, 9};
+  std::vector<float> points = {
+      0, 0, 10, 0, 0, 10,               //
+      20, 20, 30, 20, 30, 30, 20, 30,  //
+  };
+  std::vector<uint32_t> point_offsets = {0, 3, 7};
+  std::vector<uint8_t> fill_types = {
+      static_cast<uint8_t>(FillType::kNonZero),
+      static_cast<uint8_t>(FillType::kOdd),
+  };
+
+  PathBatch GetBatch() const {
+    PathBatch batch;
+    batch.path_count = verb_offsets.size() - 1;
+    batch.verbs = verbs.data();
+    batch.verb_offsets = verb_offsets.data();
+    batch.points = points.data();
+    batch.point_offsets = point_offsets.data();
+    batch.fill_types = fill_types.data();
+    return batch;
+  }
+};
+
+TEST(TessellatorTest, TessellateBatchWritesTheVerticesOfEachPathAtItsOffset) {
+  TestPathBatch test_batch;
+  PathBatch batch = test_batch.GetBatch();
+
+  for (uint32_t thread_count : {1u, 4u}) {
+    std::vector<float> vertices(64, -1);
+    std::vector<uint32_t> offsets(3);
+    uint32_t size = TessellateBatch(&batch, 1.0f, thread_count, vertices.data(),
+                                    vertices.size(), offsets.data());
+
+    // One triangle, then the two triangles of the square.
+    ASSERT_EQ(size, 18u);
+    EXPECT_EQ(offsets, (std::vector<uint32_t>{0, 6, 18}));
+
+    PathBuilder square;
+    square.MoveTo({20, 20});
+    square.LineTo({30, 20});
+    square.LineTo({30, 30});
+    square.LineTo({20, 30});
+    square.Close();
+    Vertices* expected =
+        Tessellate(&square, static_cast<int>(FillType::kOdd), 1.0f);
+    ASSERT_NE(expected, nullptr);
+    ASSERT_EQ(expected->length, 12u);
+    for (auto i = 0u; i < expected->length; i++) {
+      EXPECT_EQ(vertices[6 + i], expected->points[i]);
+    }
+    DestroyVertices(expected);
+
+    // Nothing is written past the vertices of the last path.
+    EXPECT_EQ(vertices[18], -1);
+  }
+}
+
+TEST(TessellatorTest, TessellateBatchOnlyWritesVerticesThatFit) {
+  TestPathBatch test_batch;
+  PathBatch batch = test_batch.GetBatch();
+
+  std::vector<float> vertices(17, -1);
+  std::vector<uint32_t> offsets(3);
+  uint32_t size = TessellateBatch(&batch, 1.0f, 1u, vertices.data(),
+                                  vertices.size(), offsets.data());
+
+  ASSERT_EQ(size, 18u);
+  EXPECT_EQ(offsets, (std::vector<uint32_t>{0, 6, 18}));
+  for (float vertex : vertices) {
+    EXPECT_EQ(vertex, -1);
+  }
+}
+
+TEST(TessellatorTest, TessellateBatchSkipsMalformedPaths) {
+  TestPathBatch test_batch;
+  // A verb that doesn't exist.
+  test_batch.verbs[1] = kPathVerbClose + 1;
+  // A line to a point that the path doesn't have.
+  test_batch.point_offsets[2] = 6;
+
+  PathBatch batch = test_batch.GetBatch();
+  std::vector<float> vertices(64, -1);
+  std::vector<uint32_t> offsets(3);
+  EXPECT_EQ(TessellateBatch(&batch, 1.0f, 1u, vertices.data(), vertices.size(),
+                            offsets.data()),
+            0u);
+  EXPECT_EQ(offsets, (std::vector<uint32_t>{0, 0, 0}));
+}
+
+TEST(TessellatorTest, TessellateBatchSkipsPathsWithUnknownFillTypes) {
+  TestPathBatch test_batch;
+  test_batch.fill_types[0] = static_cast<uint8_t>(FillType::kAbsGeqTwo) + 1;
+
+  PathBatch batch = test_batch.GetBatch();
+  std::vector<float> vertices(64, -1);
+  std::vector<uint32_t> offsets(3);
+  EXPECT_EQ(TessellateBatch(&batch, 1.0f, 1u, vertices.data(), vertices.size(),
+                            offsets.data()),
+            12u);
+  EXPECT_EQ(offsets, (std::vector<uint32_t>{0, 0, 12}));
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -0,0 +1,220 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/toolkit/egl/image.h"
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+namespace egl {
+
+bool HasExtension(EGLDisplay display, const char* extension) {
+  const char* extensions = ::eglQueryString(display, EGL_EXTENSIONS);
+  if (extensions == nullptr) {
+    return false;
+  }
+  const size_t length = std::strlen(extension);
+  for (const char* found = std::strstr(extensions, extension);
+       found != nullptr; found = std::strstr(found + length, extension)) {
+    const bool starts_token = found == extensions || found[-1] == ' ';
+    const bool ends_token = found[length] == ' ' || found[length] == '\0';
+    if (starts_token && ends_token) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class Proc>
+static Proc GetProc(const char* name) {
+  return reinterpret_cast<Proc>(::eglGetProcAddress(name));
+}
+
+Image::Image(EGLDisplay display,
+             EGLImageKHR image,
+             PFNEGLDESTROYIMAGEKHRPROC destroy_image)
+    : display_(display), image_(image), destroy_image_(destroy_image) {}
+
+Image::~Image() {
+  if (image_ != EGL_NO_IMAGE_KHR) {
+    if (destroy_image_(display_, image_) != EGL_TRUE) {
+      IMPELLER_LOG_EGL_ERROR;
+    }
+  }
+}
+
+const EGLImageKHR& Image::GetHandle() const {
+  return image_;
+}
+
+std::vector<EGLint> Image::GetDmaBufAttributes(const DmaBufDescriptor& desc) {
+  if (desc.width == 0u || desc.height == 0u || desc.planes.empty() ||
+      desc.planes.size() > kMaxDmaBufPlaneCount) {
+    return {};
+  }
+
+  static constexpr EGLint kPlaneAttributes[kMaxDmaBufPlaneCount][5] = {
+      {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE1_PITCH_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+      {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+       EGL_DMA_BUF_PLANE2_PITCH_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+       EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+  };
+
+  std::vector<EGLint> attributes = {
+      EGL_WIDTH,
+      static_cast<EGLint>(desc.width),
+      EGL_HEIGHT,
+      static_cast<EGLint>(desc.height),
+      EGL_LINUX_DRM_FOURCC_EXT,
+      static_cast<EGLint>(desc.format),
+  };
+  for (size_t i = 0; i < desc.planes.size(); i++) {
+    const auto& plane = desc.planes[i];
+    if (plane.fd < 0) {
+      return {};
+    }
+    attributes.push_back(kPlaneAttributes[i][0]);
+    attributes.push_back(plane.fd);
+    attributes.push_back(kPlaneAttributes[i][1]);
+    attributes.push_back(static_cast<EGLint>(plane.offset));
+    attributes.push_back(kPlaneAttributes[i][2]);
+    attributes.push_back(static_cast<EGLint>(plane.stride));
+    if (desc.modifier.has_value()) {
+      attributes.push_back(kPlaneAttributes[i][3]);
+      attributes.push_back(
+          static_cast<EGLint>(desc.modifier.value() & 0xFFFFFFFFu));
+      attributes.push_back(kPlaneAttributes[i][4]);
+      attributes.push_back(static_cast<EGLint>(desc.modifier.value() >> 32u));
+    }
+  }
+  attributes.push_back(EGL_NONE);
+  return attributes;
+}
+
+std::unique_ptr<Image> Image::CreateFromDmaBuf(EGLDisplay display,
+                                               const DmaBufDescriptor& desc) {
+  if (!HasExtension(display, "EGL_EXT_image_dma_buf_import")) {
+    return nullptr;
+  }
+  if (desc.modifier.has_value() &&
+      !HasExtension(display, "EGL_EXT_image_dma_buf_import_modifiers")) {
+    return nullptr;
+  }
+  const auto attributes = GetDmaBufAttributes(desc);
+  if (attributes.empty()) {
+    return nullptr;
+  }
+  // The client buffer must be null for DMA-BUFs.
+  return Create(display, EGL_LINUX_DMA_BUF_EXT, nullptr, attributes.data());
+}
+
+std::unique_ptr<Image> Image::CreateFromHardwareBuffer(
+    EGLDisplay display,
+    const AHardwareBuffer* buffer) {
+  if (buffer == nullptr ||
+      !HasExtension(display, "EGL_ANDROID_get_native_client_buffer") ||
+      !HasExtension(display, "EGL_ANDROID_image_native_buffer")) {
+    return nullptr;
+  }
+  auto get_native_client_buffer =
+      GetProc<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
+          "eglGetNativeClientBufferANDROID");
+  if (get_native_client_buffer == nullptr) {
+    return nullptr;
+  }
+  EGLClientBuffer client_buffer = get_native_client_buffer(buffer);
+  if (client_buffer == nullptr) {
+    IMPELLER_LOG_EGL_ERROR;
+    return nullptr;
+  }
+  const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  return Create(display, EGL_NATIVE_BUFFER_ANDROID, client_buffer,
+                attributes);
+}
+
+std::unique_ptr<Image> Image::Create(EGLDisplay display,
+                                     EGLenum target,
+                                     EGLClientBuffer buffer,
+                                     const EGLint* attributes) {
+  auto create_image = GetProc<PFNEGLCREATEIMAGEKHRPROC>("eglCreateImageKHR");
+  auto destroy_image =
+      GetProc<PFNEGLDESTROYIMAGEKHRPROC>("eglDestroyImageKHR");
+  if (create_image == nullptr || destroy_image == nullptr) {
+    return nullptr;
+  }
+  EGLImageKHR image =
+      create_image(display, EGL_NO_CONTEXT, target, buffer, attributes);
+  if (image == EGL_NO_IMAGE_KHR) {
+    IMPELLER_LOG_EGL_ERROR;
+    return nullptr;
+  }
+  return std::unique_ptr<Image>(new Image(display, image, destroy_image));
+}
+
+static bool WaitForNativeFenceOnCPU(int fence_fd) {
+  pollfd fd = {};
+  fd.fd = fence_fd;
+  fd.events = POLLIN;
+  int result;
+  do {
+    result = ::poll(&fd, 1, -1);
+  } while (result < 0 && (errno == EINTR || errno == EAGAIN));
+  ::close(fence_fd);
+  if (result < 0) {
+    FML_LOG(ERROR) << "Could not wait for the native fence: "
+                   << std::strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+bool WaitForNativeFence(EGLDisplay display, int fence_fd) {
+  if (fence_fd < 0) {
+    return false;
+  }
+  if (!HasExtension(display, "EGL_ANDROID_native_fence_sync") ||
+      !HasExtension(display, "EGL_KHR_wait_sync")) {
+    return WaitForNativeFenceOnCPU(fence_fd);
+  }
+  auto create_sync = GetProc<PFNEGLCREATESYNCKHRPROC>("eglCreateSyncKHR");
+  auto wait_sync = GetProc<PFNEGLWAITSYNCKHRPROC>("eglWaitSyncKHR");
+  auto destroy_sync = GetProc<PFNEGLDESTROYSYNCKHRPROC>("eglDestroySyncKHR");
+  if (create_sync == nullptr || wait_sync == nullptr ||
+      destroy_sync == nullptr) {
+    return WaitForNativeFenceOnCPU(fence_fd);
+  }
+
+  const EGLint attributes[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fence_fd,
+                               EGL_NONE};
+  EGLSyncKHR sync =
+      create_sync(display, EGL_SYNC_NATIVE_FENCE_ANDROID, attributes);
+  if (sync == EGL_NO_SYNC_KHR) {
+    // The sync only takes ownership of the fence once it is created.
+    IMPELLER_LOG_EGL_ERROR;
+    return WaitForNativeFenceOnCPU(fence_fd);
+  }
+  const bool waited = wait_sync(display, sync, 0) == EGL_TRUE;
+  if (!waited) {
+    IMPELLER_LOG_EGL_ERROR;
+  }
+  // The wait is already queued, the sync is only deleted once it is done.
+  if (destroy_sync(display, sync) != EGL_TRUE) {
+    IMPELLER_LOG_EGL_ERROR;
+  }
+  return waited;
+}
+
+}  // namespace egl
+}  // namespace impeller
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/toolkit/egl/egl.h"
+
+#include <EGL/eglext.h>
+
+struct AHardwareBuffer;
+
+namespace impeller {
+namespace egl {
+
+struct DmaBufPlane {
+  int fd = -1;
+  uint32_t offset = 0u;
+  uint32_t stride = 0u;
+};
+
+struct DmaBufDescriptor {
+  uint32_t width = 0u;
+  uint32_t height = 0u;
+  /// The DRM fourcc code of the format of the buffer.
+  uint32_t format = 0u;
+  /// The DRM format modifier of the buffer, or none if the driver is to
+  /// assume the modifier the buffer was allocated with.
+  std::optional<uint64_t> modifier;
+  std::vector<DmaBufPlane> planes;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      An EGL image of memory shared with another API or process,
+///             which a texture may be bound to and sample from without a
+///             copy.
+///
+class Image {
+ public:
+  /// The number of planes `EGL_EXT_image_dma_buf_import` supports.
+  static constexpr size_t kMaxDmaBufPlaneCount = 3u;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Imports a DMA-BUF with `EGL_EXT_image_dma_buf_import`. The
+  ///             file descriptors of the planes are not closed, and may be
+  ///             closed once this returns.
+  ///
+  /// @return     The image, or nullptr if the display doesn't support
+  ///             importing the buffer.
+  ///
+  static std::unique_ptr<Image> CreateFromDmaBuf(EGLDisplay display,
+                                                 const DmaBufDescriptor& desc);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Imports an Android hardware buffer with
+  ///             `EGL_ANDROID_get_native_client_buffer`. The buffer must
+  ///             outlive the image.
+  ///
+  /// @return     The image, or nullptr if the display doesn't support
+  ///             importing the buffer.
+  ///
+  static std::unique_ptr<Image> CreateFromHardwareBuffer(
+      EGLDisplay display,
+      const AHardwareBuffer* buffer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The attributes of `eglCreateImageKHR` that import the
+  ///             DMA-BUF, terminated by `EGL_NONE`.
+  ///
+  /// @return     The attributes, or an empty list if the descriptor isn't
+  ///             valid.
+  ///
+  static std::vector<EGLint> GetDmaBufAttributes(const DmaBufDescriptor& desc);
+
+  ~Image();
+
+  const EGLImageKHR& GetHandle() const;
+
+ private:
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  EGLImageKHR image_ = EGL_NO_IMAGE_KHR;
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image_ = nullptr;
+
+  Image(EGLDisplay display,
+        EGLImageKHR image,
+        PFNEGLDESTROYIMAGEKHRPROC destroy_image);
+
+  static std::unique_ptr<Image> Create(EGLDisplay display,
+                                       EGLenum target,
+                                       EGLClientBuffer buffer,
+                                       const EGLint* attributes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(Image);
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Makes the commands submitted to the current context after this
+///             call wait for the native fence with
+///             `EGL_ANDROID_native_fence_sync`, without blocking the calling
+///             thread. Displays without the extension block the calling
+///             thread until the fence is signaled instead.
+///
+/// @param[in]  display   The display of the current context.
+/// @param[in]  fence_fd  The file descriptor of the fence, which is closed
+///                       either way.
+///
+/// @return     If the fence was waited for.
+///
+bool WaitForNativeFence(EGLDisplay display, int fence_fd);
+
+bool HasExtension(EGLDisplay display, const char* extension);
+
+}  // namespace egl
+}  // namespace impeller
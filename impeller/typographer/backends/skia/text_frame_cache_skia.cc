@@ -0,0 +1,60 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/backends/skia/text_frame_cache_skia.h"
+
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+
+namespace impeller {
+
+std::size_t TextFrameCacheSkia::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.blob_id, key.scale);
+}
+
+TextFrameCacheSkia::TextFrameCacheSkia(size_t capacity)
+    : capacity_(capacity) {}
+
+TextFrameCacheSkia::~TextFrameCacheSkia() = default;
+
+TextFrame TextFrameCacheSkia::GetTextFrame(const sk_sp<SkTextBlob>& blob,
+                                           Scalar scale) {
+  if (!blob) {
+    return {};
+  }
+  const Key key{.blob_id = blob->uniqueID(), .scale = scale};
+  {
+    Lock lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, found->second);
+      return found->second->frame;
+    }
+  }
+
+  TRACE_EVENT0("impeller", "TextFrameCacheConvert");
+  auto frame = TextFrameFromTextBlob(blob, scale);
+
+  Lock lock(mutex_);
+  if (index_.find(key) != index_.end() || capacity_ == 0u) {
+    return frame;
+  }
+  entries_.push_front(Entry{.key = key, .frame = frame});
+  index_[key] = entries_.begin();
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  return frame;
+}
+
+size_t TextFrameCacheSkia::GetSize() const {
+  Lock lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,78 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "flutter/fml/macros.h"
+#include "impeller/base/thread.h"
+#include "impeller/typographer/text_frame.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Converts text blobs to text frames, and keeps the frames of the
+///             most recently converted blobs so that text that is drawn again
+///             isn't converted again.
+///
+///             Blobs are identified by their unique IDs, which are never
+///             reused, and are not kept alive by the cache. The frames of
+///             blobs that have been destroyed are never looked up again and
+///             are evicted once enough other blobs have been converted.
+///
+class TextFrameCacheSkia {
+ public:
+  static constexpr size_t kDefaultCapacity = 1024u;
+
+  explicit TextFrameCacheSkia(size_t capacity = kDefaultCapacity);
+
+  ~TextFrameCacheSkia();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The text frame of the blob at the scale, as converted by
+  ///             `TextFrameFromTextBlob`.
+  ///
+  TextFrame GetTextFrame(const sk_sp<SkTextBlob>& blob, Scalar scale);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames in the cache.
+  ///
+  size_t GetSize() const;
+
+ private:
+  struct Key {
+    uint32_t blob_id = 0u;
+    Scalar scale = 1.0f;
+
+    struct Hash {
+      std::size_t operator()(const Key& key) const;
+    };
+
+    struct Equal {
+      constexpr bool operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.blob_id == rhs.blob_id && lhs.scale == rhs.scale;
+      }
+    };
+  };
+
+  struct Entry {
+    Key key;
+    TextFrame frame;
+  };
+
+  const size_t capacity_;
+  mutable Mutex mutex_;
+  // The most recently used entries first.
+  std::list<Entry> entries_ IPLR_GUARDED_BY(mutex_);
+  std::unordered_map<Key, std::list<Entry>::iterator, Key::Hash, Key::Equal>
+      index_ IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TextFrameCacheSkia);
+};
+
+}  // namespace impeller
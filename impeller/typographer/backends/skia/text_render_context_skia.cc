@@ -4,12 +4,17 @@
 
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
 #include <utility>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/renderer/allocator.h"
+#include "impeller/renderer/blit_pass.h"
+#include "impeller/renderer/command_buffer.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -27,6 +32,12 @@ namespace impeller {
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
+static constexpr auto kMaxAtlasSize = 4096u;
+
+/// The most pages, each with a texture of up to the maximum size, that an
+/// atlas can have before the least recently used page is evicted.
+static constexpr auto kMaxAtlasPageCount = 4u;
+
 TextRenderContextSkia::TextRenderContextSkia(std::shared_ptr<Context> context)
     : TextRenderContext(std::move(context)) {}
 
@@ -38,12 +49,11 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairsSet(
   FontGlyphPair::Set set;
   while (auto frame = frame_iterator()) {
     for (const auto& run : frame->GetRuns()) {
-      auto font = run.GetFont();
-      // TODO(dnfield): If we're doing SDF here, we should be using a consistent
-      // point size.
-      // https://github.com/flutter/flutter/issues/112016
+      auto font = GlyphAtlas::GetAtlasFont(type, run.GetFont());
       for (const auto& glyph_position : run.GetGlyphPositions()) {
-        set.insert({font, glyph_position.glyph});
+        if (GlyphAtlas::HoldsGlyph(type, glyph_position.glyph)) {
+          set.insert({font, glyph_position.glyph});
+        }
       }
     }
   }
@@ -97,16 +107,25 @@ static size_t PairsFitInAtlasOfSize(
   return 0;
 }
 
-static bool CanAppendToExistingAtlas(
-    const std::shared_ptr<GlyphAtlas>& atlas,
+/// Places the additional glyphs in the rect packers of the open page of the
+/// existing atlas. When they don't fit, the page grows by adding a rect packer
+/// below the existing ones that is as tall as the page, as long as it stays
+/// within the maximum size. The existing glyphs keep their positions either
+/// way.
+///
+/// Returns the new size of the open page, or std::nullopt if the glyphs can't
+/// be appended and other pages are needed.
+static std::optional<ISize> AppendToExistingAtlas(
     const FontGlyphPair::Vector& extra_pairs,
     std::vector<Rect>& glyph_positions,
-    ISize atlas_size,
-    const std::shared_ptr<GrRectanizer>& rect_packer) {
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context) {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
-    return false;
+  auto atlas_size = atlas_context->GetAtlasSize();
+  auto packers = atlas_context->GetRectPackers();
+  if (packers.empty() || atlas_size.IsEmpty()) {
+    return std::nullopt;
   }
+  const size_t existing_packer_count = packers.size();
 
   // We assume that all existing glyphs will fit. After all, they fit before.
   // The glyph_positions only contains the values for the additional glyphs
@@ -119,20 +138,46 @@ static bool CanAppendToExistingAtlas(
     const auto glyph_size =
         ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
     SkIPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return false;
+    int64_t packer_top = 0;
+    bool placed = false;
+    for (const auto& packer : packers) {
+      if (packer->addRect(glyph_size.width + kPadding,   //
+                          glyph_size.height + kPadding,  //
+                          &location_in_atlas             //
+                          )) {
+        placed = true;
+        break;
+      }
+      packer_top += packer->height();
     }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
+    if (!placed) {
+      if (atlas_size.height * 2 > kMaxAtlasSize) {
+        return std::nullopt;
+      }
+      auto packer = std::shared_ptr<GrRectanizer>(
+          GrRectanizer::Factory(atlas_size.width, atlas_size.height));
+      if (!packer->addRect(glyph_size.width + kPadding,   //
+                           glyph_size.height + kPadding,  //
+                           &location_in_atlas             //
+                           )) {
+        return std::nullopt;
+      }
+      packer_top = atlas_size.height;
+      atlas_size.height *= 2;
+      packers.push_back(std::move(packer));
+    }
+    glyph_positions.emplace_back(
+        Rect::MakeXYWH(location_in_atlas.x(),               //
+                       packer_top + location_in_atlas.y(),  //
+                       glyph_size.width,                    //
+                       glyph_size.height                    //
+                       ));
   }
 
-  return true;
+  for (size_t i = existing_packer_count; i < packers.size(); i++) {
+    atlas_context->AddRectPacker(packers[i]);
+  }
+  return atlas_size;
 }
 
 static ISize OptimumAtlasSizeForFontGlyphPairs(
@@ -140,7 +185,6 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<GlyphAtlasContext>& atlas_context) {
   static constexpr auto kMinAtlasSize = 8u;
-  static constexpr auto kMaxAtlasSize = 4096u;
 
   TRACE_EVENT0("impeller", __FUNCTION__);
 
@@ -173,10 +217,15 @@ static ISize OptimumAtlasSizeForFontGlyphPairs(
 /// Compute signed-distance field for an 8-bpp grayscale image (values greater
 /// than 127 are considered "on") For details of this algorithm, see "The 'dead
 /// reckoning' signed distance transform" [Grevera 2004]
+///
+/// The image may be a region of a larger bitmap whose rows are `row_bytes`
+/// apart.
 static void ConvertBitmapToSignedDistanceField(uint8_t* pixels,
                                                uint16_t width,
-                                               uint16_t height) {
-  if (!pixels || width == 0 || height == 0) {
+                                               uint16_t height,
+                                               size_t row_bytes) {
+  // The boundary and dead-reckoning passes skip the outermost pixels.
+  if (!pixels || width < 3 || height < 3) {
     return;
   }
 
@@ -188,7 +237,7 @@ static void ConvertBitmapToSignedDistanceField(uint8_t* pixels,
   std::vector<ShortPoint> boundary_point_map(width * height);
 
   // Some helpers for manipulating the above arrays
-#define image(_x, _y) (pixels[(_y)*width + (_x)] > 0x7f)
+#define image(_x, _y) (pixels[(_y)*row_bytes + (_x)] > 0x7f)
 #define distance(_x, _y) distance_map[(_y)*width + (_x)]
 #define nearestpt(_x, _y) boundary_point_map[(_y)*width + (_x)]
 
@@ -276,7 +325,7 @@ static void ConvertBitmapToSignedDistanceField(uint8_t* pixels,
       float clamped_dist = fmax(-norm_factor, fmin(dist, norm_factor));
       float scaled_dist = clamped_dist / norm_factor;
       uint8_t quantized_value = ((scaled_dist + 1) / 2) * UINT8_MAX;
-      pixels[y * width + x] = quantized_value;
+      pixels[y * row_bytes + x] = quantized_value;
     }
   }
 
@@ -334,6 +383,7 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
   }
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+  bool is_sdf = atlas.GetType() == GlyphAtlas::Type::kSignedDistanceField;
 
   for (const auto& pair : new_pairs) {
     auto pos = atlas.FindFontGlyphPosition(pair);
@@ -341,12 +391,24 @@ static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
       continue;
     }
     DrawGlyph(canvas, pair, pos.value(), has_color);
+    if (is_sdf) {
+      // Convert each glyph on its own, so that glyphs added to an existing
+      // atlas don't convert the fields of the others again.
+      ConvertBitmapToSignedDistanceField(
+          reinterpret_cast<uint8_t*>(
+              bitmap->getAddr(pos->origin.x, pos->origin.y)),
+          pos->size.width, pos->size.height, bitmap->rowBytes());
+    }
   }
   return true;
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+/// Creates a bitmap for a page of the atlas with the pairs, which must all be
+/// on that page, drawn into it.
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const FontGlyphPair::Vector& pairs) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   auto bitmap = std::make_shared<SkBitmap>();
   SkImageInfo image_info;
@@ -365,28 +427,16 @@ static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
   if (!bitmap->tryAllocPixels(image_info)) {
     return nullptr;
   }
+  bitmap->eraseColor(SK_ColorTRANSPARENT);
 
-  auto surface = SkSurface::MakeRasterDirect(bitmap->pixmap());
-  if (!surface) {
+  if (!UpdateAtlasBitmap(atlas, bitmap, pairs)) {
     return nullptr;
   }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return nullptr;
-  }
-
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const FontGlyphPair& font_glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, font_glyph, location, has_color);
-    return true;
-  });
-
   return bitmap;
 }
 
-static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
+static bool UpdateGlyphTextureAtlas(const Context& context,
+                                    std::shared_ptr<SkBitmap> bitmap,
                                     const std::shared_ptr<Texture>& texture) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
@@ -399,15 +449,91 @@ static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
       [bitmap](auto, auto) mutable { bitmap.reset(); }          // proc
   );
 
-  return texture->SetContents(mapping);
+  if (!texture->SetContents(mapping)) {
+    return false;
+  }
+  context.RecordGlyphAtlasUpload();
+  return true;
+}
+
+/// Creates a bitmap of the new size of the atlas with the contents of the
+/// existing bitmap at the top. Pages are only added below the existing ones,
+/// so the width doesn't change.
+static std::shared_ptr<SkBitmap> GrowAtlasBitmap(const SkBitmap& bitmap,
+                                                 const ISize& atlas_size) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap.width() == atlas_size.width);
+  auto grown = std::make_shared<SkBitmap>();
+  if (!grown->tryAllocPixels(
+          bitmap.info().makeWH(atlas_size.width, atlas_size.height))) {
+    return nullptr;
+  }
+  grown->eraseColor(SK_ColorTRANSPARENT);
+  if (!bitmap.readPixels(grown->pixmap())) {
+    return nullptr;
+  }
+  return grown;
+}
+
+/// Uploads the rows of the bitmap that the region spans to the texture with a
+/// blit, rather than uploading the whole bitmap.
+static bool UpdateGlyphTextureAtlasRegion(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<SkBitmap>& bitmap,
+    const std::shared_ptr<Texture>& texture,
+    IRect region) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  FML_DCHECK(bitmap != nullptr);
+
+  // Whole rows are contiguous in the bitmap, so they can be copied without
+  // repacking them.
+  auto rows = IRect::MakeLTRB(0, region.GetTop(), bitmap->width(),
+                              region.GetBottom());
+  auto buffer = context->GetResourceAllocator()->CreateBufferWithCopy(
+      reinterpret_cast<const uint8_t*>(bitmap->getAddr(0, rows.GetTop())),
+      bitmap->rowBytes() * rows.size.height);
+  if (!buffer) {
+    return false;
+  }
+
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!command_buffer) {
+    return false;
+  }
+  command_buffer->SetLabel("GlyphAtlas Update");
+  auto blit_pass = command_buffer->CreateBlitPass();
+  if (!blit_pass) {
+    return false;
+  }
+  if (!blit_pass->AddCopy(std::move(buffer), texture, rows) ||
+      !blit_pass->EncodeCommands(context->GetResourceAllocator())) {
+    return false;
+  }
+  if (!command_buffer->SubmitCommands()) {
+    return false;
+  }
+  context->RecordGlyphAtlasUpload();
+  return true;
+}
+
+static PixelFormat GetAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kSignedDistanceField:
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
 }
 
 static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
-    const std::shared_ptr<Allocator>& allocator,
+    const std::shared_ptr<Context>& context,
     std::shared_ptr<SkBitmap> bitmap,
     const ISize& atlas_size,
     PixelFormat format) {
   TRACE_EVENT0("impeller", __FUNCTION__);
+  const auto& allocator = context->GetResourceAllocator();
   if (!allocator) {
     return nullptr;
   }
@@ -425,7 +551,8 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
     return nullptr;
   }
 
-  auto texture = allocator->CreateTexture(texture_descriptor);
+  auto texture = allocator->CreateTexture(texture_descriptor,
+                                          AllocationCategory::kGlyphAtlas);
   if (!texture || !texture->IsValid()) {
     return nullptr;
   }
@@ -440,9 +567,100 @@ static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
   if (!texture->SetContents(mapping)) {
     return nullptr;
   }
+  context->RecordGlyphAtlasUpload();
   return texture;
 }
 
+/// Creates a page of the atlas with as many of the pairs as fit in a texture
+/// of the maximum size, packed as tightly as possible if they all fit. The
+/// page becomes the open page of the atlas context, which later glyphs are
+/// appended to.
+///
+/// Returns the number of pairs at the front of the vector that were added to
+/// the page, which is zero if the page could not be created.
+static size_t CreateAtlasPage(
+    const std::shared_ptr<Context>& context,
+    const FontGlyphPair::Vector& pairs,
+    size_t page,
+    const std::shared_ptr<GlyphAtlas>& atlas,
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  std::vector<Rect> glyph_positions;
+  auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(pairs, glyph_positions,
+                                                      atlas_context);
+  if (atlas_size.IsEmpty()) {
+    // The pairs don't all fit, so fill a page of the maximum size with as
+    // many of them as possible. The rest go to other pages.
+    atlas_size = ISize(kMaxAtlasSize, kMaxAtlasSize);
+    auto rect_packer = std::shared_ptr<GrRectanizer>(
+        GrRectanizer::Factory(atlas_size.width, atlas_size.height));
+    PairsFitInAtlasOfSize(pairs, atlas_size, glyph_positions, rect_packer);
+    atlas_context->UpdateRectPacker(rect_packer);
+  }
+  if (glyph_positions.empty()) {
+    return 0u;
+  }
+
+  FontGlyphPair::Vector page_pairs(pairs.begin(),
+                                   pairs.begin() + glyph_positions.size());
+  for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
+    atlas->AddTypefaceGlyphPosition(page_pairs[i], glyph_positions[i], page);
+  }
+
+  auto bitmap = CreateAtlasBitmap(*atlas, atlas_size, page_pairs);
+  if (!bitmap) {
+    return 0u;
+  }
+  auto texture = UploadGlyphTextureAtlas(
+      context, bitmap, atlas_size, GetAtlasPixelFormat(atlas->GetType()));
+  if (!texture) {
+    return 0u;
+  }
+  atlas->SetTexture(std::move(texture), page);
+
+  atlas_context->UpdateGlyphAtlas(atlas, atlas_size);
+  atlas_context->UpdateOpenPage(page);
+  atlas_context->UpdateBitmap(std::move(bitmap));
+  return page_pairs.size();
+}
+
+/// Adds pages to the atlas for the pairs, evicting the least recently used
+/// page once the atlas has the maximum number of pages. A page is only
+/// evicted if none of its glyphs were used in the current generation, since
+/// they may still be needed by the text frames of this generation.
+///
+/// Returns the atlas with the pairs, which is a new atlas if a page was
+/// evicted, or nullptr if the pairs could not be added.
+static std::shared_ptr<GlyphAtlas> AddAtlasPages(
+    const std::shared_ptr<Context>& context,
+    FontGlyphPair::Vector pairs,
+    std::shared_ptr<GlyphAtlas> atlas,
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  while (!pairs.empty()) {
+    size_t page = atlas->GetPageCount();
+    if (page >= kMaxAtlasPageCount) {
+      page = 0u;
+      for (size_t i = 1; i < atlas->GetPageCount(); i++) {
+        if (atlas->GetPageLastUsedGeneration(i) <
+            atlas->GetPageLastUsedGeneration(page)) {
+          page = i;
+        }
+      }
+      if (atlas->GetPageLastUsedGeneration(page) >= atlas->GetGeneration()) {
+        return nullptr;
+      }
+      atlas = atlas->CloneWithoutPage(page);
+    }
+    auto added = CreateAtlasPage(context, pairs, page, atlas, atlas_context);
+    if (added == 0u) {
+      return nullptr;
+    }
+    pairs.erase(pairs.begin(), pairs.begin() + added);
+  }
+  return atlas;
+}
+
 std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     GlyphAtlas::Type type,
     std::shared_ptr<GlyphAtlasContext> atlas_context,
@@ -464,8 +682,10 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the atlas type and font glyph pairs are compatible
-  //         with the current atlas and reuse if possible.
+  //         with the current atlas and reuse if possible. This marks the
+  //         glyphs of the atlas that are used in this generation.
   // ---------------------------------------------------------------------------
+  last_atlas->AdvanceGeneration();
   auto new_glyphs = last_atlas->HasSamePairs(font_glyph_pairs);
   if (last_atlas->GetType() == type && new_glyphs.size() == 0) {
     return last_atlas;
@@ -473,14 +693,19 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 3: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas. This requires that
-  //         the type is identical.
+  //         open page of the existing atlas without recreating it, growing
+  //         the page if needed. This requires that the type is identical.
   // ---------------------------------------------------------------------------
+  const bool can_reuse = last_atlas->GetType() == type && last_atlas->IsValid();
+  const auto open_page = atlas_context->GetOpenPage();
   std::vector<Rect> glyph_positions;
-  if (last_atlas->GetType() == type &&
-      CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
-                               atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
+  const auto last_atlas_size = atlas_context->GetAtlasSize();
+  std::optional<ISize> appended_atlas_size;
+  if (can_reuse) {
+    appended_atlas_size =
+        AppendToExistingAtlas(new_glyphs, glyph_positions, atlas_context);
+  }
+  if (appended_atlas_size.has_value()) {
     // The old bitmap will be reused and only the additional glyphs will be
     // added.
 
@@ -488,93 +713,88 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
     // Step 4: Record the positions in the glyph atlas of the newly added
     // glyphs.
     // ---------------------------------------------------------------------------
+    std::optional<Rect> dirty_region;
     for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
-      last_atlas->AddTypefaceGlyphPosition(new_glyphs[i], glyph_positions[i]);
+      last_atlas->AddTypefaceGlyphPosition(new_glyphs[i], glyph_positions[i],
+                                           open_page);
+      dirty_region = dirty_region.has_value()
+                         ? dirty_region->Union(glyph_positions[i])
+                         : glyph_positions[i];
     }
 
     // ---------------------------------------------------------------------------
-    // Step 5: Draw new font-glyph pairs into the existing bitmap.
+    // Step 5: Draw new font-glyph pairs into the existing bitmap, which is
+    // grown first if rect packers were added.
     // ---------------------------------------------------------------------------
     auto bitmap = atlas_context->GetBitmap();
+    const bool grown = appended_atlas_size.value() != last_atlas_size;
+    if (grown) {
+      bitmap = GrowAtlasBitmap(*bitmap, appended_atlas_size.value());
+      if (!bitmap) {
+        return nullptr;
+      }
+      atlas_context->UpdateBitmap(bitmap);
+      atlas_context->UpdateGlyphAtlas(last_atlas, appended_atlas_size.value());
+    }
     if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
       return nullptr;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 6: Update the existing texture with the updated bitmap.
+    // Step 6: Update the existing texture with the rows of the bitmap that
+    // the new glyphs were drawn to. A grown atlas needs a new texture.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
-      return nullptr;
+    const auto& open_texture = last_atlas->GetTexture(open_page);
+    if (grown) {
+      auto texture = UploadGlyphTextureAtlas(
+          GetContext(), bitmap, appended_atlas_size.value(),
+          open_texture->GetTextureDescriptor().format);
+      if (!texture) {
+        return nullptr;
+      }
+      last_atlas->SetTexture(std::move(texture), open_page);
+      return last_atlas;
+    }
+    if (dirty_region.has_value()) {
+      auto region = IRect::MakeLTRB(
+          0, static_cast<int64_t>(std::floor(dirty_region->GetTop())),
+          appended_atlas_size->width,
+          std::min(static_cast<int64_t>(std::ceil(dirty_region->GetBottom())),
+                   appended_atlas_size->height));
+      if (!UpdateGlyphTextureAtlasRegion(GetContext(), bitmap, open_texture,
+                                         region) &&
+          !UpdateGlyphTextureAtlas(*GetContext(), bitmap, open_texture)) {
+        return nullptr;
+      }
     }
     return last_atlas;
   }
-  // A new glyph atlas must be created.
-
-  // ---------------------------------------------------------------------------
-  // Step 4: Get the optimum size of the texture atlas.
-  // ---------------------------------------------------------------------------
-  auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
-  auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
-      font_glyph_pairs, glyph_positions, atlas_context);
-
-  atlas_context->UpdateGlyphAtlas(glyph_atlas, atlas_size);
-  if (atlas_size.IsEmpty()) {
-    return nullptr;
-  }
-  // ---------------------------------------------------------------------------
-  // Step 5: Find location of font-glyph pairs in the atlas. We have this from
-  // the last step. So no need to do create another rect packer. But just do a
-  // sanity check of counts. This could also be just an assertion as only a
-  // construction issue would cause such a failure.
-  // ---------------------------------------------------------------------------
-  if (glyph_positions.size() != font_glyph_pairs.size()) {
-    return nullptr;
-  }
-
-  // ---------------------------------------------------------------------------
-  // Step 6: Record the positions in the glyph atlas.
-  // ---------------------------------------------------------------------------
-  for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
-    glyph_atlas->AddTypefaceGlyphPosition(font_glyph_pairs[i],
-                                          glyph_positions[i]);
-  }
 
   // ---------------------------------------------------------------------------
-  // Step 7: Draw font-glyph pairs in the correct spot in the atlas.
+  // Step 4: The open page is full, so add pages for the missing glyphs,
+  //         evicting pages that were not used recently if needed. The glyphs
+  //         on the other pages keep their positions.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
-  if (!bitmap) {
-    return nullptr;
+  if (can_reuse) {
+    auto paged_atlas =
+        AddAtlasPages(GetContext(), new_glyphs, last_atlas, atlas_context);
+    if (paged_atlas) {
+      return paged_atlas;
+    }
   }
-  atlas_context->UpdateBitmap(bitmap);
 
   // ---------------------------------------------------------------------------
-  // Step 8: Upload the atlas as a texture.
+  // Step 5: A new glyph atlas must be created with only the glyphs of this
+  //         generation, which also compacts the glyphs into as few pages as
+  //         possible.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kSignedDistanceField:
-      ConvertBitmapToSignedDistanceField(
-          reinterpret_cast<uint8_t*>(bitmap->getPixels()), atlas_size.width,
-          atlas_size.height);
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
-  auto texture = UploadGlyphTextureAtlas(GetContext()->GetResourceAllocator(),
-                                         bitmap, atlas_size, format);
-  if (!texture) {
+  auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
+  atlas_context->UpdateGlyphAtlas(glyph_atlas, ISize(0, 0));
+  atlas_context->UpdateRectPacker(nullptr);
+  if (!AddAtlasPages(GetContext(), font_glyph_pairs, glyph_atlas,
+                     atlas_context)) {
     return nullptr;
   }
-
-  // ---------------------------------------------------------------------------
-  // Step 9: Record the texture in the glyph atlas.
-  // ---------------------------------------------------------------------------
-  glyph_atlas->SetTexture(std::move(texture));
-
   return glyph_atlas;
 }
 
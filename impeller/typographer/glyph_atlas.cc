@@ -4,8 +4,12 @@
 
 #include "impeller/typographer/glyph_atlas.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
+#include "flutter/fml/logging.h"
+
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext()
@@ -22,12 +26,24 @@ const ISize& GlyphAtlasContext::GetAtlasSize() const {
   return atlas_size_;
 }
 
+size_t GlyphAtlasContext::GetOpenPage() const {
+  return open_page_;
+}
+
 std::shared_ptr<SkBitmap> GlyphAtlasContext::GetBitmap() const {
   return bitmap_;
 }
 
 std::shared_ptr<skgpu::Rectanizer> GlyphAtlasContext::GetRectPacker() const {
-  return rect_packer_;
+  if (rect_packers_.empty()) {
+    return nullptr;
+  }
+  return rect_packers_.front();
+}
+
+const std::vector<std::shared_ptr<skgpu::Rectanizer>>&
+GlyphAtlasContext::GetRectPackers() const {
+  return rect_packers_;
 }
 
 void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
@@ -36,13 +52,64 @@ void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
   atlas_size_ = size;
 }
 
+void GlyphAtlasContext::UpdateOpenPage(size_t page) {
+  open_page_ = page;
+}
+
 void GlyphAtlasContext::UpdateBitmap(std::shared_ptr<SkBitmap> bitmap) {
   bitmap_ = std::move(bitmap);
 }
 
 void GlyphAtlasContext::UpdateRectPacker(
     std::shared_ptr<skgpu::Rectanizer> rect_packer) {
-  rect_packer_ = std::move(rect_packer);
+  rect_packers_.clear();
+  if (rect_packer) {
+    rect_packers_.push_back(std::move(rect_packer));
+  }
+}
+
+void GlyphAtlasContext::AddRectPacker(
+    std::shared_ptr<skgpu::Rectanizer> rect_packer) {
+  rect_packers_.push_back(std::move(rect_packer));
+}
+
+bool GlyphAtlas::HoldsGlyph(Type type, const Glyph& glyph) {
+  switch (type) {
+    case Type::kSignedDistanceField:
+      return true;
+    case Type::kAlphaBitmap:
+      return glyph.type != Glyph::Type::kBitmap;
+    case Type::kColorBitmap:
+      return glyph.type == Glyph::Type::kBitmap;
+  }
+  FML_UNREACHABLE();
+}
+
+/// The number of scales per power of two that color glyphs are rasterized
+/// at. Color glyphs are magnified by at most the fourth root of two, which
+/// keeps emoji sharp while text sizes that differ by a few points share one
+/// rasterization.
+static constexpr Scalar kColorBitmapScalesPerOctave = 4.0f;
+
+Font GlyphAtlas::GetAtlasFont(Type type, const Font& font) {
+  if (type == Type::kAlphaBitmap) {
+    return font;
+  }
+  auto metrics = font.GetMetrics();
+  if (metrics.scale <= 0.0f) {
+    return font;
+  }
+  if (type == Type::kColorBitmap) {
+    metrics.scale = std::exp2(
+        std::ceil(std::log2(metrics.scale) * kColorBitmapScalesPerOctave) /
+        kColorBitmapScalesPerOctave);
+    return Font(font.GetTypeface(), metrics);
+  }
+  // Round the scale up, so the distance field is never magnified by more
+  // than a factor of two. An animated scale only rasterizes the glyphs again
+  // when it crosses a power of two.
+  metrics.scale = std::exp2(std::ceil(std::log2(metrics.scale)));
+  return Font(font.GetTypeface(), metrics);
 }
 
 GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
@@ -50,24 +117,49 @@ GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
 GlyphAtlas::~GlyphAtlas() = default;
 
 bool GlyphAtlas::IsValid() const {
-  return !!texture_;
+  return !textures_.empty() &&
+         std::all_of(textures_.begin(), textures_.end(),
+                     [](const auto& texture) { return !!texture; });
 }
 
 GlyphAtlas::Type GlyphAtlas::GetType() const {
   return type_;
 }
 
-const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
-  return texture_;
+const std::shared_ptr<Texture>& GlyphAtlas::GetTexture(size_t page) const {
+  static const std::shared_ptr<Texture> kNoTexture;
+  if (page >= textures_.size()) {
+    return kNoTexture;
+  }
+  return textures_[page];
+}
+
+void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture, size_t page) {
+  if (page >= textures_.size()) {
+    textures_.resize(page + 1);
+    page_last_used_generations_.resize(page + 1, generation_);
+  }
+  textures_[page] = std::move(texture);
 }
 
-void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
-  texture_ = std::move(texture);
+size_t GlyphAtlas::GetPageCount() const {
+  return textures_.size();
+}
+
+void GlyphAtlas::MarkPageUsed(size_t page) {
+  if (page >= page_last_used_generations_.size()) {
+    page_last_used_generations_.resize(page + 1, 0u);
+  }
+  page_last_used_generations_[page] = generation_;
 }
 
 void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
-                                          Rect rect) {
-  positions_[pair] = rect;
+                                          Rect rect,
+                                          size_t page) {
+  auto& entry = positions_[pair];
+  entry.location = GlyphLocation{.page = page, .position = rect};
+  entry.last_used_generation = generation_;
+  MarkPageUsed(page);
 }
 
 std::optional<Rect> GlyphAtlas::FindFontGlyphPosition(
@@ -76,7 +168,16 @@ std::optional<Rect> GlyphAtlas::FindFontGlyphPosition(
   if (found == positions_.end()) {
     return std::nullopt;
   }
-  return found->second;
+  return found->second.location.position;
+}
+
+std::optional<GlyphAtlas::GlyphLocation> GlyphAtlas::FindFontGlyphLocation(
+    const FontGlyphPair& pair) const {
+  auto found = positions_.find(pair);
+  if (found == positions_.end()) {
+    return std::nullopt;
+  }
+  return found->second.location;
 }
 
 size_t GlyphAtlas::GetGlyphCount() const {
@@ -93,7 +194,7 @@ size_t GlyphAtlas::IterateGlyphs(
   size_t count = 0u;
   for (const auto& position : positions_) {
     count++;
-    if (!iterator(position.first, position.second)) {
+    if (!iterator(position.first, position.second.location.position)) {
       return count;
     }
   }
@@ -104,11 +205,46 @@ FontGlyphPair::Vector GlyphAtlas::HasSamePairs(
     const FontGlyphPair::Vector& new_glyphs) {
   std::vector<FontGlyphPair> new_pairs;
   for (auto pair : new_glyphs) {
-    if (positions_.find(pair) == positions_.end()) {
+    auto found = positions_.find(pair);
+    if (found == positions_.end()) {
       new_pairs.push_back(pair);
+    } else if (found->second.last_used_generation != generation_) {
+      found->second.last_used_generation = generation_;
+      MarkPageUsed(found->second.location.page);
     }
   }
   return new_pairs;
 }
 
+void GlyphAtlas::AdvanceGeneration() {
+  generation_++;
+}
+
+uint64_t GlyphAtlas::GetGeneration() const {
+  return generation_;
+}
+
+uint64_t GlyphAtlas::GetPageLastUsedGeneration(size_t page) const {
+  if (page >= page_last_used_generations_.size()) {
+    return 0u;
+  }
+  return page_last_used_generations_[page];
+}
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::CloneWithoutPage(size_t page) const {
+  auto atlas = std::make_shared<GlyphAtlas>(type_);
+  atlas->textures_ = textures_;
+  atlas->page_last_used_generations_ = page_last_used_generations_;
+  atlas->generation_ = generation_;
+  if (page < atlas->textures_.size()) {
+    atlas->textures_[page] = nullptr;
+  }
+  for (const auto& position : positions_) {
+    if (position.second.location.page != page) {
+      atlas->positions_.insert(position);
+    }
+  }
+  return atlas;
+}
+
 }  // namespace impeller
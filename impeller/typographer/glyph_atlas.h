@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/geometry/rect.h"
@@ -23,12 +25,25 @@ class Rectanizer;
 namespace impeller {
 
 //------------------------------------------------------------------------------
-/// @brief      A texture containing the bitmap representation of glyphs in
+/// @brief      Textures containing the bitmap representation of glyphs in
 ///             different fonts along with the ability to query the location of
-///             specific font glyphs within the texture.
+///             specific font glyphs within the textures.
+///
+///             When the glyphs don't fit in one texture of the maximum size,
+///             they are spread across several pages, each with its own
+///             texture. Glyphs are drawn with one command per page.
 ///
 class GlyphAtlas {
  public:
+  //----------------------------------------------------------------------------
+  /// @brief      The page of the atlas that a glyph is in, and its location in
+  ///             the texture of that page.
+  ///
+  struct GlyphLocation {
+    size_t page = 0u;
+    Rect position;
+  };
+
   //----------------------------------------------------------------------------
   /// @brief      Describes how the glyphs are represented in the texture.
   enum class Type {
@@ -37,21 +52,48 @@ class GlyphAtlas {
     /// where the value of each pixel represents a signed-distance field that
     /// stores the glyph outlines.
     ///
+    /// Unlike bitmaps, one distance field can be drawn at a range of scales,
+    /// so glyphs are rasterized at the power of two at or above their scale.
+    /// See `GetAtlasFont`.
+    ///
     kSignedDistanceField,
 
     //--------------------------------------------------------------------------
     /// The glyphs are reprsented at their requested size using only an 8-bit
-    /// alpha channel.
+    /// alpha channel. Holds all but color glyphs.
     ///
     kAlphaBitmap,
 
     //--------------------------------------------------------------------------
-    /// The glyphs are reprsented at their requested size using N32 premul
-    /// colors.
+    /// The glyphs are reprsented using N32 premul colors. Only holds color
+    /// glyphs, such as emoji, so the alpha glyphs drawn alongside them keep
+    /// using the smaller alpha atlas.
+    ///
+    /// Color glyphs are rasterized at the closest of a few scales per power of
+    /// two at or above their scale, and are drawn at nearby scales from the
+    /// same rasterization with linear filtering. See `GetAtlasFont`.
     ///
     kColorBitmap,
   };
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the glyph is stored in atlases of the type.
+  ///
+  static bool HoldsGlyph(Type type, const Glyph& glyph);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The font that the glyphs of a font are rasterized with in an
+  ///             atlas of the type. Glyphs are stored in and looked up from
+  ///             the atlas with this font.
+  ///
+  /// @param[in]  type  How the glyphs are represented in the texture.
+  /// @param[in]  font  The font that the glyphs are drawn with.
+  ///
+  /// @return     The font, which only differs from the one that the glyphs
+  ///             are drawn with in its scale.
+  ///
+  static Font GetAtlasFont(Type type, const Font& font);
+
   //----------------------------------------------------------------------------
   /// @brief      Create an empty glyph atlas.
   ///
@@ -69,27 +111,37 @@ class GlyphAtlas {
   Type GetType() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Set the texture for the glyph atlas.
+  /// @brief      Set the texture for a page of the glyph atlas, adding pages
+  ///             up to it if needed.
   ///
   /// @param[in]  texture  The texture
+  /// @param[in]  page     The page
   ///
-  void SetTexture(std::shared_ptr<Texture> texture);
+  void SetTexture(std::shared_ptr<Texture> texture, size_t page = 0u);
 
   //----------------------------------------------------------------------------
-  /// @brief      Get the texture for the glyph atlas.
+  /// @brief      Get the texture for a page of the glyph atlas.
+  ///
+  /// @return     The texture, or nullptr if the page doesn't exist.
   ///
-  /// @return     The texture.
+  const std::shared_ptr<Texture>& GetTexture(size_t page = 0u) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the number of pages, each with its own texture.
   ///
-  const std::shared_ptr<Texture>& GetTexture() const;
+  size_t GetPageCount() const;
 
   //----------------------------------------------------------------------------
   /// @brief      Record the location of a specific font-glyph pair within the
-  ///             atlas.
+  ///             atlas. The glyph is marked as used in the current generation.
   ///
   /// @param[in]  pair  The font-glyph pair
   /// @param[in]  rect  The rectangle
+  /// @param[in]  page  The page of the atlas that the rectangle is in
   ///
-  void AddTypefaceGlyphPosition(const FontGlyphPair& pair, Rect rect);
+  void AddTypefaceGlyphPosition(const FontGlyphPair& pair,
+                                Rect rect,
+                                size_t page = 0u);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -121,9 +173,22 @@ class GlyphAtlas {
   ///
   std::optional<Rect> FindFontGlyphPosition(const FontGlyphPair& pair) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Find the page and the location of a specific font-glyph pair
+  ///             in the atlas.
+  ///
+  /// @param[in]  pair  The font-glyph pair
+  ///
+  /// @return     The location of the font-glyph pair in the atlas.
+  ///             `std::nullopt` of the pair in not in the atlas.
+  ///
+  std::optional<GlyphLocation> FindFontGlyphLocation(
+      const FontGlyphPair& pair) const;
+
   //----------------------------------------------------------------------------
   /// @brief      whether this atlas contains all of the same font-glyph pairs
-  ///             as the vector.
+  ///             as the vector. The pairs that are present are marked as used
+  ///             in the current generation.
   ///
   /// @param[in]  new_glyphs  The full set of new glyphs
   ///
@@ -132,22 +197,65 @@ class GlyphAtlas {
   ///
   FontGlyphPair::Vector HasSamePairs(const FontGlyphPair::Vector& new_glyphs);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Start a new generation for marking the glyphs that are used.
+  ///             Each time the atlas is requested for a set of text frames is
+  ///             a generation.
+  ///
+  void AdvanceGeneration();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the current generation.
+  ///
+  uint64_t GetGeneration() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the latest generation that any glyph of the page was used
+  ///             in.
+  ///
+  uint64_t GetPageLastUsedGeneration(size_t page) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a copy of this atlas without the glyphs of a page,
+  ///             so that the page can be reused for other glyphs. Users of
+  ///             this atlas are unaffected, so the page can be evicted while
+  ///             commands that sample from it are still pending.
+  ///
+  /// @param[in]  page  The page to evict.
+  ///
+  /// @return     The new atlas, in which the page has no texture.
+  ///
+  std::shared_ptr<GlyphAtlas> CloneWithoutPage(size_t page) const;
+
  private:
+  struct GlyphEntry {
+    GlyphLocation location;
+    uint64_t last_used_generation = 0u;
+  };
+
   const Type type_;
-  std::shared_ptr<Texture> texture_;
+  std::vector<std::shared_ptr<Texture>> textures_;
+  std::vector<uint64_t> page_last_used_generations_;
+  uint64_t generation_ = 0u;
 
   std::unordered_map<FontGlyphPair,
-                     Rect,
+                     GlyphEntry,
                      FontGlyphPair::Hash,
                      FontGlyphPair::Equal>
       positions_;
 
+  void MarkPageUsed(size_t page);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlas);
 };
 
 //------------------------------------------------------------------------------
 /// @brief      A container for caching a glyph atlas across frames.
 ///
+///             The bitmap, size and rect packers are those of the open page
+///             of the atlas, which new glyphs are added to. The other pages
+///             are full and only change when they are evicted.
+///
 class GlyphAtlasContext {
  public:
   GlyphAtlasContext();
@@ -159,30 +267,54 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> GetGlyphAtlas() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the size of the current glyph atlas.
+  /// @brief      Retrieve the size of the open page of the current glyph
+  ///             atlas.
   const ISize& GetAtlasSize() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the index of the open page of the current glyph
+  ///             atlas.
+  size_t GetOpenPage() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Retrieve the previous (if any) SkBitmap instance.
   std::shared_ptr<SkBitmap> GetBitmap() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the previous (if any) rect packer.
+  /// @brief      Retrieve the previous (if any) first rect packer of the open
+  ///             page of the atlas.
   std::shared_ptr<skgpu::Rectanizer> GetRectPacker() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the rect packers of the open page of the atlas. The
+  ///             packers span the width of the page and are stacked from top
+  ///             to bottom, each as tall as its region of the page.
+  const std::vector<std::shared_ptr<skgpu::Rectanizer>>& GetRectPackers() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Update the context with a newly constructed glyph atlas.
   void UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas, ISize size);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Update the index of the open page of the glyph atlas.
+  void UpdateOpenPage(size_t page);
+
   void UpdateBitmap(std::shared_ptr<SkBitmap> bitmap);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Replace all rect packers of the open page with one.
   void UpdateRectPacker(std::shared_ptr<skgpu::Rectanizer> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Add a rect packer below the existing ones of the open page.
+  void AddRectPacker(std::shared_ptr<skgpu::Rectanizer> rect_packer);
+
  private:
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
+  size_t open_page_ = 0u;
   std::shared_ptr<SkBitmap> bitmap_;
-  std::shared_ptr<skgpu::Rectanizer> rect_packer_;
+  std::vector<std::shared_ptr<skgpu::Rectanizer>> rect_packers_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContext);
 };
@@ -16,8 +16,13 @@ LazyGlyphAtlas::LazyGlyphAtlas() = default;
 
 LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
-void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame) {
+void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame,
+                                  bool signed_distance_field) {
   FML_DCHECK(atlas_map_.empty());
+  if (signed_distance_field) {
+    sdf_frames_.emplace_back(frame);
+    return;
+  }
   has_color_ |= frame.HasColor();
   frames_.emplace_back(frame);
 }
@@ -41,12 +46,14 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
   if (!text_context || !text_context->IsValid()) {
     return nullptr;
   }
+  const auto& frames =
+      type == GlyphAtlas::Type::kSignedDistanceField ? sdf_frames_ : frames_;
   size_t i = 0;
   TextRenderContext::FrameIterator iterator = [&]() -> const TextFrame* {
-    if (i >= frames_.size()) {
+    if (i >= frames.size()) {
       return nullptr;
     }
-    const auto& result = frames_[i];
+    const auto& result = frames[i];
     i++;
     return &result;
   };
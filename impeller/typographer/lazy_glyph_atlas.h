@@ -19,17 +19,30 @@ class LazyGlyphAtlas {
 
   ~LazyGlyphAtlas();
 
-  void AddTextFrame(const TextFrame& frame);
+  //----------------------------------------------------------------------------
+  /// @brief      Add a text frame whose glyphs the atlases must hold.
+  ///
+  /// @param[in]  frame                  The text frame.
+  /// @param[in]  signed_distance_field  Whether the frame is drawn from the
+  ///                                    signed-distance field atlas rather
+  ///                                    than a bitmap atlas.
+  ///
+  void AddTextFrame(const TextFrame& frame,
+                    bool signed_distance_field = false);
 
   std::shared_ptr<GlyphAtlas> CreateOrGetGlyphAtlas(
       GlyphAtlas::Type type,
       std::shared_ptr<GlyphAtlasContext> atlas_context,
       std::shared_ptr<Context> context) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether any of the frames drawn from a bitmap atlas has
+  ///             color.
   bool HasColor() const;
 
  private:
   std::vector<TextFrame> frames_;
+  std::vector<TextFrame> sdf_frames_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
   bool has_color_ = false;
@@ -4,6 +4,7 @@
 
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/typographer/backends/skia/text_frame_cache_skia.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
@@ -135,6 +136,28 @@ TEST_P(TypographerTest, GlyphAtlasIsRecycledIfUnchanged) {
   ASSERT_EQ(atlas_context->GetGlyphAtlas(), atlas);
 }
 
+TEST_P(TypographerTest, GlyphAtlasCountsUploads) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky skellingtons", sk_font);
+  ASSERT_TRUE(blob);
+  const size_t upload_count = GetContext()->GetGlyphAtlasUploadCount();
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(GetContext()->GetGlyphAtlasUploadCount(), upload_count + 1);
+
+  // Nothing is uploaded when the atlas already has the glyphs.
+  auto next_atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_EQ(GetContext()->GetGlyphAtlasUploadCount(), upload_count + 1);
+}
+
 TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
   auto context = TextRenderContext::Create(GetContext());
   auto atlas_context = std::make_shared<GlyphAtlasContext>();
@@ -168,6 +191,32 @@ TEST_P(TypographerTest, GlyphAtlasWithLotsOfdUniqueGlyphSize) {
             atlas->GetTexture()->GetSize().height);
 }
 
+TEST_P(TypographerTest, SignedDistanceFieldAtlasSharesGlyphsAcrossScales) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas = context->CreateGlyphAtlas(
+      GlyphAtlas::Type::kSignedDistanceField, atlas_context,
+      TextFrameFromTextBlob(blob, 1.2));
+  ASSERT_NE(atlas, nullptr);
+  auto glyph_count = atlas->GetGlyphCount();
+
+  // A scale in the same power of two range reuses the glyphs.
+  auto next_atlas = context->CreateGlyphAtlas(
+      GlyphAtlas::Type::kSignedDistanceField, atlas_context,
+      TextFrameFromTextBlob(blob, 1.9));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_EQ(next_atlas->GetGlyphCount(), glyph_count);
+
+  auto frame = TextFrameFromTextBlob(blob, 1.9);
+  auto font = GlyphAtlas::GetAtlasFont(GlyphAtlas::Type::kSignedDistanceField,
+                                       frame.GetRuns()[0].GetFont());
+  ASSERT_EQ(font.GetMetrics().scale, 2.0f);
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   auto context = TextRenderContext::Create(GetContext());
   auto atlas_context = std::make_shared<GlyphAtlasContext>();
@@ -201,6 +250,49 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecycledIfUnchanged) {
   ASSERT_EQ(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, GlyphAtlasGrowsByAddingPagesForNewGlyphs) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("spooky 1", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(atlas_context->GetRectPackers().size(), 1u);
+  auto first_size = atlas_context->GetAtlasSize();
+
+  std::optional<FontGlyphPair> first_pair;
+  Rect first_position;
+  atlas->IterateGlyphs([&](const FontGlyphPair& pair, const Rect& rect) {
+    first_pair = pair;
+    first_position = rect;
+    return false;
+  });
+  ASSERT_TRUE(first_pair.has_value());
+
+  // Many more glyphs than fit in the first atlas.
+  auto blob2 = SkTextBlob::MakeFromString(
+      "spooky 1 QWERTYUIOPASDFGHJKLZXCVBNMqewrtyuiopasdfghjklzxcvbnm,.<>[]{};':"
+      "2134567890-=!@#$%^&*()_+",
+      sk_font);
+  auto next_atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob2));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_GT(atlas_context->GetRectPackers().size(), 1u);
+
+  // The existing glyphs keep their positions, and the atlas grows downwards.
+  auto next_size = atlas_context->GetAtlasSize();
+  ASSERT_EQ(next_size.width, first_size.width);
+  ASSERT_GT(next_size.height, first_size.height);
+  ASSERT_EQ(next_atlas->GetTexture()->GetSize(), next_size);
+  ASSERT_EQ(next_atlas->FindFontGlyphPosition(first_pair.value()),
+            first_position);
+}
+
 TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   auto context = TextRenderContext::Create(GetContext());
   auto atlas_context = std::make_shared<GlyphAtlasContext>();
@@ -222,7 +314,15 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   // now create a new glyph atlas with an identical blob,
   // but change the type.
 
-  auto blob2 = SkTextBlob::MakeFromString("spooky 1", sk_font);
+#if FML_OS_MACOSX
+  auto mapping = OpenFixtureAsSkData("Apple Color Emoji.ttc");
+#else
+  auto mapping = OpenFixtureAsSkData("NotoColorEmoji.ttf");
+#endif
+  ASSERT_TRUE(mapping);
+  // Color atlases only hold color glyphs.
+  SkFont emoji_font(SkTypeface::MakeFromData(mapping), 50.0);
+  auto blob2 = SkTextBlob::MakeFromString("😀", emoji_font);
   auto next_atlas =
       context->CreateGlyphAtlas(GlyphAtlas::Type::kColorBitmap, atlas_context,
                                 TextFrameFromTextBlob(blob2));
@@ -235,6 +335,59 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   ASSERT_NE(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, ColorGlyphsAreStoredApartAtBucketedScales) {
+  auto color_glyph = Glyph(0, Glyph::Type::kBitmap, Rect::MakeXYWH(0, 0, 1, 1));
+  auto glyph = Glyph(0, Glyph::Type::kPath, Rect::MakeXYWH(0, 0, 1, 1));
+  ASSERT_TRUE(GlyphAtlas::HoldsGlyph(GlyphAtlas::Type::kColorBitmap,
+                                     color_glyph));
+  ASSERT_FALSE(GlyphAtlas::HoldsGlyph(GlyphAtlas::Type::kColorBitmap, glyph));
+  ASSERT_FALSE(GlyphAtlas::HoldsGlyph(GlyphAtlas::Type::kAlphaBitmap,
+                                      color_glyph));
+  ASSERT_TRUE(GlyphAtlas::HoldsGlyph(GlyphAtlas::Type::kAlphaBitmap, glyph));
+
+  // Nearby scales share the rasterization of color glyphs at the next of four
+  // scales per power of two.
+  Font::Metrics metrics;
+  metrics.scale = 1.1f;
+  auto font = GlyphAtlas::GetAtlasFont(GlyphAtlas::Type::kColorBitmap,
+                                       Font(nullptr, metrics));
+  metrics.scale = 1.15f;
+  auto nearby_font = GlyphAtlas::GetAtlasFont(GlyphAtlas::Type::kColorBitmap,
+                                              Font(nullptr, metrics));
+  ASSERT_NEAR(font.GetMetrics().scale, std::exp2(0.25f), kEhCloseEnough);
+  ASSERT_EQ(font.GetMetrics().scale, nearby_font.GetMetrics().scale);
+
+  // Alpha glyphs are rasterized at their scale.
+  ASSERT_EQ(GlyphAtlas::GetAtlasFont(GlyphAtlas::Type::kAlphaBitmap,
+                                     Font(nullptr, metrics))
+                .GetMetrics()
+                .scale,
+            1.15f);
+}
+
+TEST_P(TypographerTest, TextFrameCacheConvertsEachBlobOnce) {
+  TextFrameCacheSkia cache(2u);
+  SkFont sk_font;
+  auto first = SkTextBlob::MakeFromString("spooky", sk_font);
+  auto second = SkTextBlob::MakeFromString("skellingtons", sk_font);
+  auto third = SkTextBlob::MakeFromString("spooky skellingtons", sk_font);
+
+  auto frame = cache.GetTextFrame(first, 1.0f);
+  ASSERT_EQ(frame.GetRunCount(), TextFrameFromTextBlob(first).GetRunCount());
+  cache.GetTextFrame(first, 1.0f);
+  ASSERT_EQ(cache.GetSize(), 1u);
+
+  // The glyphs of a frame are for one scale, so other scales are kept apart.
+  cache.GetTextFrame(first, 2.0f);
+  ASSERT_EQ(cache.GetSize(), 2u);
+
+  // The least recently used frames are evicted.
+  cache.GetTextFrame(first, 1.0f);
+  cache.GetTextFrame(second, 1.0f);
+  cache.GetTextFrame(third, 1.0f);
+  ASSERT_EQ(cache.GetSize(), 2u);
+}
+
 TEST_P(TypographerTest, FontGlyphPairTypeChangesHashAndEquals) {
   Font font = Font(nullptr, {});
   FontGlyphPair pair_1 = {
@@ -253,5 +406,39 @@ TEST_P(TypographerTest, FontGlyphPairTypeChangesHashAndEquals) {
   ASSERT_FALSE(FontGlyphPair::Equal{}(pair_1, pair_3));
 }
 
+TEST_P(TypographerTest, GlyphAtlasTracksPageUseAndEvictsPages) {
+  Font font = Font(nullptr, {});
+  FontGlyphPair pair_1 = {
+      .font = font,
+      .glyph = Glyph(0, Glyph::Type::kPath, Rect::MakeXYWH(0, 0, 1, 1))};
+  FontGlyphPair pair_2 = {
+      .font = font,
+      .glyph = Glyph(1, Glyph::Type::kPath, Rect::MakeXYWH(0, 0, 1, 1))};
+
+  GlyphAtlas atlas(GlyphAtlas::Type::kAlphaBitmap);
+  atlas.AddTypefaceGlyphPosition(pair_1, Rect::MakeXYWH(0, 0, 1, 1), 0u);
+  atlas.AddTypefaceGlyphPosition(pair_2, Rect::MakeXYWH(2, 0, 1, 1), 1u);
+  ASSERT_EQ(atlas.GetPageLastUsedGeneration(0u), 0u);
+  ASSERT_EQ(atlas.GetPageLastUsedGeneration(1u), 0u);
+
+  // Only the page of the glyph that is used again is marked as used.
+  atlas.AdvanceGeneration();
+  ASSERT_TRUE(atlas.HasSamePairs({pair_2}).empty());
+  ASSERT_EQ(atlas.GetPageLastUsedGeneration(0u), 0u);
+  ASSERT_EQ(atlas.GetPageLastUsedGeneration(1u), atlas.GetGeneration());
+
+  auto evicted = atlas.CloneWithoutPage(0u);
+  ASSERT_EQ(evicted->GetGlyphCount(), 1u);
+  ASSERT_FALSE(evicted->FindFontGlyphLocation(pair_1).has_value());
+  auto location = evicted->FindFontGlyphLocation(pair_2);
+  ASSERT_TRUE(location.has_value());
+  ASSERT_EQ(location->page, 1u);
+  ASSERT_EQ(location->position, Rect::MakeXYWH(2, 0, 1, 1));
+
+  // The original atlas is unchanged.
+  ASSERT_EQ(atlas.GetGlyphCount(), 2u);
+  ASSERT_TRUE(atlas.FindFontGlyphLocation(pair_1).has_value());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -718,7 +718,12 @@ class SceneBuilder extends NativeFieldWrapperClass1 {
   ///  - 0x02: visualizeRasterizerStatistics - graph raster thread frame times
   ///  - 0x04: displayEngineStatistics - show UI thread frame time
   ///  - 0x08: visualizeEngineStatistics - graph UI thread frame times
-  /// Set enabledOptions to 0x0F to enable all the currently defined features.
+  ///  - 0x10: displayGpuMemoryStatistics - show the GPU memory used by the
+  ///    renderer, for renderers that account for it
+  ///  - 0x20: visualizeRendererStatistics - graph the GPU time, raster cache
+  ///    hit rate and size, glyph atlas uploads, pipeline compiles and
+  ///    offscreen passes of each frame, for those the renderer reports
+  /// Set enabledOptions to 0x3F to enable all the currently defined features.
   ///
   /// The "UI thread" is the thread that includes all the execution of the main
   /// Dart isolate (the isolate that can call [FlutterView.render]). The UI
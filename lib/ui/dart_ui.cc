@@ -101,6 +101,7 @@ typedef CanvasPath Path;
   V(PlatformConfigurationNativeApi::Render, 1)                        \
   V(PlatformConfigurationNativeApi::UpdateSemantics, 1)               \
   V(PlatformConfigurationNativeApi::SetNeedsReportTimings, 1)         \
+  V(PlatformConfigurationNativeApi::SetChannelPort, 2)                \
   V(PlatformConfigurationNativeApi::SetIsolateDebugName, 1)           \
   V(PlatformConfigurationNativeApi::RequestDartPerformanceMode, 1)    \
   V(PlatformConfigurationNativeApi::GetPersistentIsolateData, 0)      \
@@ -140,6 +141,7 @@ typedef CanvasPath Path;
   V(Canvas, drawArc, 10)                               \
   V(Canvas, drawAtlas, 10)                             \
   V(Canvas, drawCircle, 6)                             \
+  V(Canvas, drawCircles, 4)                            \
   V(Canvas, drawColor, 3)                              \
   V(Canvas, drawDRRect, 5)                             \
   V(Canvas, drawImage, 7)                              \
@@ -153,6 +155,7 @@ typedef CanvasPath Path;
   V(Canvas, drawPoints, 5)                             \
   V(Canvas, drawRRect, 4)                              \
   V(Canvas, drawRect, 7)                               \
+  V(Canvas, drawRects, 4)                              \
   V(Canvas, drawShadow, 5)                             \
   V(Canvas, drawVertices, 5)                           \
   V(Canvas, getDestinationClipBounds, 2)               \
@@ -222,6 +225,7 @@ typedef CanvasPath Path;
   V(Paragraph, height, 1)                              \
   V(Paragraph, ideographicBaseline, 1)                 \
   V(Paragraph, layout, 2)                              \
+  V(Paragraph, layoutAsync, 3)                         \
   V(Paragraph, longestLine, 1)                         \
   V(Paragraph, maxIntrinsicWidth, 1)                   \
   V(Paragraph, minIntrinsicWidth, 1)                   \
@@ -289,6 +289,19 @@ external void _finishCallResponse(bool didPass);
 @pragma('vm:entry-point')
 void messageCallback(dynamic data) {}
 
+@pragma('vm:entry-point')
+void receivesLargePlatformMessagesWithoutCopying() {
+  PlatformDispatcher.instance.onPlatformMessage = (String name, ByteData? data, PlatformMessageResponseCallback? callback) {
+    _validatePlatformMessage(data!);
+  };
+  _sendLargePlatformMessage();
+}
+
+@pragma('vm:external-name', 'SendLargePlatformMessage')
+external void _sendLargePlatformMessage();
+@pragma('vm:external-name', 'ValidatePlatformMessage')
+external void _validatePlatformMessage(ByteData data);
+
 @pragma('vm:entry-point')
 @pragma('vm:external-name', 'ValidateConfiguration')
 external void validateConfiguration();
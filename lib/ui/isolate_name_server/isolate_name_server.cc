@@ -11,38 +11,17 @@ IsolateNameServer::IsolateNameServer() {}
 IsolateNameServer::~IsolateNameServer() = default;
 
 Dart_Port IsolateNameServer::LookupIsolatePortByName(const std::string& name) {
-  std::scoped_lock lock(mutex_);
-  return LookupIsolatePortByNameUnprotected(name);
-}
-
-Dart_Port IsolateNameServer::LookupIsolatePortByNameUnprotected(
-    const std::string& name) {
-  auto port_iterator = port_mapping_.find(name);
-  if (port_iterator != port_mapping_.end()) {
-    return port_iterator->second;
-  }
-  return ILLEGAL_PORT;
+  return port_mapping_.Find(name).value_or(ILLEGAL_PORT);
 }
 
 bool IsolateNameServer::RegisterIsolatePortWithName(Dart_Port port,
                                                     const std::string& name) {
-  std::scoped_lock lock(mutex_);
-  if (LookupIsolatePortByNameUnprotected(name) != ILLEGAL_PORT) {
-    // Name is already registered.
-    return false;
-  }
-  port_mapping_[name] = port;
-  return true;
+  // Fails if the name is already registered.
+  return port_mapping_.Insert(name, port);
 }
 
 bool IsolateNameServer::RemoveIsolateNameMapping(const std::string& name) {
-  std::scoped_lock lock(mutex_);
-  auto port_iterator = port_mapping_.find(name);
-  if (port_iterator == port_mapping_.end()) {
-    return false;
-  }
-  port_mapping_.erase(port_iterator);
-  return true;
+  return port_mapping_.Erase(name);
 }
 
 }  // namespace flutter
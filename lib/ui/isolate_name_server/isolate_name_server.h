@@ -5,11 +5,10 @@
 #ifndef FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_H_
 #define FLUTTER_LIB_UI_ISOLATE_NAME_SERVER_H_
 
-#include <map>
-#include <mutex>
 #include <string>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/sharded_map.h"
 #include "third_party/dart/runtime/include/dart_api.h"
 
 namespace flutter {
@@ -33,10 +32,7 @@ class IsolateNameServer {
   bool RemoveIsolateNameMapping(const std::string& name);
 
  private:
-  Dart_Port LookupIsolatePortByNameUnprotected(const std::string& name);
-
-  mutable std::mutex mutex_;
-  std::map<std::string, Dart_Port> port_mapping_;
+  fml::ShardedMap<std::string, Dart_Port> port_mapping_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(IsolateNameServer);
 };
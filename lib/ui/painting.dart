@@ -5427,6 +5427,7 @@ class Canvas extends NativeFieldWrapperClass1 {
     assert(!paragraph.debugDisposed);
     assert(_offsetIsValid(offset));
     assert(!paragraph._needsLayout);
+    paragraph._checkLayoutNotPending();
     paragraph._paint(this, offset.dx, offset.dy);
   }
 
@@ -5467,6 +5468,56 @@ class Canvas extends NativeFieldWrapperClass1 {
   @Native<Void Function(Pointer<Void>, Handle, Handle, Int32, Handle)>(symbol: 'Canvas::drawPoints')
   external void _drawPoints(List<Object?>? paintObjects, ByteData paintData, int pointMode, Float32List points);
 
+  /// Draws a sequence of rectangles with the given [Paint]. Whether the
+  /// rectangles are filled or stroked (or both) is controlled by
+  /// [Paint.style].
+  ///
+  /// The `rects` argument is interpreted as a list of four floating point
+  /// numbers per rectangle: its left, top, right and bottom edges.
+  ///
+  /// This is equivalent to calling [drawRect] for each rectangle, but is
+  /// faster when drawing many rectangles with the same paint, since the paint
+  /// is only applied once.
+  ///
+  /// See also:
+  ///
+  ///  * [drawRawCircles], which draws a sequence of circles.
+  ///  * [drawRawPoints], which draws a sequence of points or lines.
+  void drawRawRects(Float32List rects, Paint paint) {
+    if (rects.length % 4 != 0) {
+      throw ArgumentError('"rects" must have a multiple of 4 values.');
+    }
+    _drawRects(paint._objects, paint._data, rects);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'Canvas::drawRects')
+  external void _drawRects(List<Object?>? paintObjects, ByteData paintData, Float32List rects);
+
+  /// Draws a sequence of circles with the given [Paint]. Whether the circles
+  /// are filled or stroked (or both) is controlled by [Paint.style].
+  ///
+  /// The `circles` argument is interpreted as a list of three floating point
+  /// numbers per circle: the x and y offsets of its center from the origin,
+  /// and its radius.
+  ///
+  /// This is equivalent to calling [drawCircle] for each circle, but is
+  /// faster when drawing many circles with the same paint, since the paint is
+  /// only applied once.
+  ///
+  /// See also:
+  ///
+  ///  * [drawRawRects], which draws a sequence of rectangles.
+  ///  * [drawRawPoints], which draws a sequence of points or lines.
+  void drawRawCircles(Float32List circles, Paint paint) {
+    if (circles.length % 3 != 0) {
+      throw ArgumentError('"circles" must have a multiple of 3 values.');
+    }
+    _drawCircles(paint._objects, paint._data, circles);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle, Handle, Handle)>(symbol: 'Canvas::drawCircles')
+  external void _drawCircles(List<Object?>? paintObjects, ByteData paintData, Float32List circles);
+
   /// Draws a set of [Vertices] onto the canvas as one or more triangles.
   ///
   /// The [Paint.color] property specifies the default color to use for the
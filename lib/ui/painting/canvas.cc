@@ -509,6 +509,39 @@ void Canvas::drawPoints(Dart_Handle paint_objects,
   }
 }
 
+void Canvas::drawRects(Dart_Handle paint_objects,
+                       Dart_Handle paint_data,
+                       const tonic::Float32List& rects) {
+  Paint paint(paint_objects, paint_data);
+
+  static_assert(sizeof(SkRect) == sizeof(float) * 4,
+                "SkRect doesn't use floats.");
+
+  FML_DCHECK(paint.isNotNull());
+  if (display_list_builder_) {
+    paint.sync_to(builder(), kDrawRectFlags);
+    const SkRect* sk_rects = reinterpret_cast<const SkRect*>(rects.data());
+    for (intptr_t i = 0; i < rects.num_elements() / 4; i++) {
+      builder()->drawRect(sk_rects[i]);
+    }
+  }
+}
+
+void Canvas::drawCircles(Dart_Handle paint_objects,
+                         Dart_Handle paint_data,
+                         const tonic::Float32List& circles) {
+  Paint paint(paint_objects, paint_data);
+
+  FML_DCHECK(paint.isNotNull());
+  if (display_list_builder_) {
+    paint.sync_to(builder(), kDrawCircleFlags);
+    const float* data = circles.data();
+    for (intptr_t i = 0; i + 2 < circles.num_elements(); i += 3) {
+      builder()->drawCircle(SkPoint::Make(data[i], data[i + 1]), data[i + 2]);
+    }
+  }
+}
+
 void Canvas::drawVertices(const Vertices* vertices,
                           DlBlendMode blend_mode,
                           Dart_Handle paint_objects,
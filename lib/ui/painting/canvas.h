@@ -164,6 +164,14 @@ class Canvas : public RefCountedDartWrappable<Canvas>, DisplayListOpFlags {
                   DlCanvas::PointMode point_mode,
                   const tonic::Float32List& points);
 
+  void drawRects(Dart_Handle paint_objects,
+                 Dart_Handle paint_data,
+                 const tonic::Float32List& rects);
+
+  void drawCircles(Dart_Handle paint_objects,
+                   Dart_Handle paint_data,
+                   const tonic::Float32List& circles);
+
   void drawVertices(const Vertices* vertices,
                     DlBlendMode blend_mode,
                     Dart_Handle paint_objects,
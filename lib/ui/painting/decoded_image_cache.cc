@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <iterator>
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+bool DecodedImageCache::Key::operator==(const Key& other) const {
+  return content_hash == other.content_hash &&
+         content_size == other.content_size &&
+         source_size == other.source_size && color_type == other.color_type &&
+         row_bytes == other.row_bytes && target_size == other.target_size;
+}
+
+size_t DecodedImageCache::KeyHash::operator()(const Key& key) const {
+  return fml::HashCombine(key.content_hash, key.content_size,
+                          key.source_size.width(), key.source_size.height(),
+                          key.color_type, key.row_bytes,
+                          key.target_size.width(), key.target_size.height());
+}
+
+DecodedImageCache::Key DecodedImageCache::MakeKey(
+    const SkData& data,
+    const SkImageInfo& source_info,
+    size_t row_bytes,
+    SkISize target_size) {
+  TRACE_EVENT0("flutter", "DecodedImageCache::MakeKey");
+  return {
+      .content_hash = std::hash<std::string_view>{}(std::string_view(
+          static_cast<const char*>(data.data()), data.size())),
+      .content_size = data.size(),
+      .source_size = source_info.dimensions(),
+      .color_type = source_info.colorType(),
+      .row_bytes = row_bytes,
+      .target_size = target_size,
+  };
+}
+
+DecodedImageCache::DecodedImageCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+void DecodedImageCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  EvictToFit(max_bytes_);
+}
+
+sk_sp<DlImage> DecodedImageCache::Find(const Key& key, const SkData& data) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  // Different bytes may have the same hash.
+  if (!found->second->data->equals(&data)) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->image;
+}
+
+void DecodedImageCache::Insert(const Key& key,
+                               sk_sp<SkData> data,
+                               sk_sp<DlImage> image) {
+  if (!data || !image) {
+    return;
+  }
+  const size_t byte_size = data->size() + image->GetApproximateByteSize();
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    Erase(found->second);
+  }
+  if (byte_size > max_bytes_) {
+    return;
+  }
+  EvictToFit(max_bytes_ - byte_size);
+  entries_.push_front({.key = key,
+                       .data = std::move(data),
+                       .image = std::move(image),
+                       .byte_size = byte_size});
+  index_[key] = entries_.begin();
+  byte_size_ += byte_size;
+}
+
+void DecodedImageCache::Purge() {
+  EvictToFit(0);
+}
+
+void DecodedImageCache::Erase(Entries::iterator entry) {
+  byte_size_ -= entry->byte_size;
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+void DecodedImageCache::EvictToFit(size_t max_bytes) {
+  while (!entries_.empty() && byte_size_ > max_bytes) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace flutter
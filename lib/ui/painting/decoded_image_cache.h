@@ -0,0 +1,113 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+#include "flutter/display_list/display_list_image.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+/// @brief  The images decoded by an `ImageDecoder` from the same bytes at the
+///         same target size, so that instantiating codecs for the same bytes
+///         more than once, even from different buffers, hands out the same
+///         image instead of decoding and uploading it again.
+///
+///         The least recently used images are evicted once the images hold
+///         more than the byte budget. Evicted images stay alive for as long
+///         as they are referenced elsewhere, like any other image.
+///
+///         Must be used on the UI thread only.
+class DecodedImageCache {
+ public:
+  /// Identifies the image decoded from some bytes at some size. The bytes
+  /// are hashed, and compared in full when the hashes match.
+  struct Key {
+    uint64_t content_hash = 0;
+    size_t content_size = 0;
+    SkISize source_size = SkISize::MakeEmpty();
+    SkColorType color_type = kUnknown_SkColorType;
+    size_t row_bytes = 0;
+    SkISize target_size = SkISize::MakeEmpty();
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  /// @brief      The key of the image decoded from the data.
+  /// @param[in]  data         The encoded bytes, or the pixels of a raw image.
+  /// @param[in]  source_info  The info of the image that the data describes.
+  /// @param[in]  row_bytes    The row bytes of a raw image, or 0 if the data
+  ///                          is encoded.
+  /// @param[in]  target_size  The size the image is decoded at.
+  static Key MakeKey(const SkData& data,
+                     const SkImageInfo& source_info,
+                     size_t row_bytes,
+                     SkISize target_size);
+
+  explicit DecodedImageCache(size_t max_bytes = 0);
+
+  ~DecodedImageCache();
+
+  /// @brief  The number of bytes the images in the cache may hold. Zero
+  ///         disables the cache.
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t GetMaxBytes() const { return max_bytes_; }
+
+  /// @brief  The image decoded from the data, if it is still cached. Marks
+  ///         the image as recently used.
+  sk_sp<DlImage> Find(const Key& key, const SkData& data);
+
+  /// @brief  Caches an image decoded from the data, and evicts the least
+  ///         recently used images to stay within the byte budget. Images that
+  ///         are larger than the budget are not cached.
+  void Insert(const Key& key, sk_sp<SkData> data, sk_sp<DlImage> image);
+
+  /// @brief  Evicts all images, e.g. when memory is low.
+  void Purge();
+
+  size_t GetCount() const { return entries_.size(); }
+
+  /// @brief  The number of bytes of the cached images and of the data they
+  ///         were decoded from.
+  size_t GetByteSize() const { return byte_size_; }
+
+ private:
+  struct Entry {
+    Key key;
+    sk_sp<SkData> data;
+    sk_sp<DlImage> image;
+    size_t byte_size = 0;
+  };
+
+  using Entries = std::list<Entry>;
+
+  size_t max_bytes_;
+  size_t byte_size_ = 0;
+  // Most recently used first.
+  Entries entries_;
+  std::unordered_map<Key, Entries::iterator, KeyHash> index_;
+
+  void Erase(Entries::iterator entry);
+
+  void EvictToFit(size_t max_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
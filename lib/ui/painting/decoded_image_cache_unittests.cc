@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkImage.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+sk_sp<DlImage> MakeImage(int width, int height) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(width, height);
+  bitmap.eraseColor(SK_ColorRED);
+  bitmap.setImmutable();
+  return DlImage::Make(SkImage::MakeFromBitmap(bitmap));
+}
+
+sk_sp<SkData> MakeData(const std::string& bytes) {
+  return SkData::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+DecodedImageCache::Key MakeKey(const sk_sp<SkData>& data,
+                               SkISize target_size = {10, 10}) {
+  return DecodedImageCache::MakeKey(
+      *data, SkImageInfo::MakeN32Premul(100, 100), 0u, target_size);
+}
+
+}  // namespace
+
+TEST(DecodedImageCacheTest, FindsImagesOfEqualBytes) {
+  DecodedImageCache cache(1024 * 1024);
+  sk_sp<SkData> data = MakeData("encoded");
+  sk_sp<DlImage> image = MakeImage(10, 10);
+  cache.Insert(MakeKey(data), data, image);
+
+  // Equal bytes from a different buffer.
+  sk_sp<SkData> same_data = MakeData("encoded");
+  EXPECT_EQ(cache.Find(MakeKey(same_data), *same_data), image);
+
+  sk_sp<SkData> other_data = MakeData("decoded");
+  EXPECT_EQ(cache.Find(MakeKey(other_data), *other_data), nullptr);
+  EXPECT_EQ(cache.Find(MakeKey(data, {20, 20}), *data), nullptr);
+}
+
+TEST(DecodedImageCacheTest, DoesNotConfuseBytesWithTheSameKey) {
+  DecodedImageCache cache(1024 * 1024);
+  sk_sp<SkData> data = MakeData("encoded");
+  cache.Insert(MakeKey(data), data, MakeImage(10, 10));
+
+  sk_sp<SkData> other_data = MakeData("decoded");
+  EXPECT_EQ(cache.Find(MakeKey(data), *other_data), nullptr);
+}
+
+TEST(DecodedImageCacheTest, EvictsLeastRecentlyUsedImagesOverBudget) {
+  sk_sp<DlImage> image = MakeImage(10, 10);
+  const size_t entry_bytes = image->GetApproximateByteSize() + 1u;
+  DecodedImageCache cache(2 * entry_bytes);
+
+  sk_sp<SkData> a = MakeData("a");
+  sk_sp<SkData> b = MakeData("b");
+  sk_sp<SkData> c = MakeData("c");
+  cache.Insert(MakeKey(a), a, image);
+  cache.Insert(MakeKey(b), b, MakeImage(10, 10));
+  EXPECT_EQ(cache.GetCount(), 2u);
+  EXPECT_EQ(cache.GetByteSize(), 2 * entry_bytes);
+
+  // Using a makes b the least recently used.
+  EXPECT_EQ(cache.Find(MakeKey(a), *a), image);
+  cache.Insert(MakeKey(c), c, MakeImage(10, 10));
+  EXPECT_EQ(cache.GetCount(), 2u);
+  EXPECT_NE(cache.Find(MakeKey(a), *a), nullptr);
+  EXPECT_EQ(cache.Find(MakeKey(b), *b), nullptr);
+  EXPECT_NE(cache.Find(MakeKey(c), *c), nullptr);
+
+  // Images over budget are not cached.
+  sk_sp<SkData> d = MakeData("d");
+  cache.Insert(MakeKey(d), d, MakeImage(100, 100));
+  EXPECT_EQ(cache.Find(MakeKey(d), *d), nullptr);
+
+  cache.SetMaxBytes(entry_bytes);
+  EXPECT_EQ(cache.GetCount(), 1u);
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetCount(), 0u);
+  EXPECT_EQ(cache.GetByteSize(), 0u);
+}
+
+TEST(DecodedImageCacheTest, CachesNothingWithoutBudget) {
+  DecodedImageCache cache;
+  sk_sp<SkData> data = MakeData("encoded");
+  cache.Insert(MakeKey(data), data, MakeImage(10, 10));
+  EXPECT_EQ(cache.GetCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
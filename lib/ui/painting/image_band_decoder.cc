@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_band_decoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+struct Bands {
+  Bands(const SkPixmap& pixmap, size_t count)
+      : pixmap(pixmap),
+        count(count),
+        rows_per_band(
+            static_cast<int>((pixmap.height() + count - 1) / count)),
+        decoded(count) {}
+
+  const SkPixmap pixmap;
+  const size_t count;
+  const int rows_per_band;
+  std::vector<std::unique_ptr<SkCodec>> codecs;
+  std::atomic_size_t next_band{0u};
+  std::atomic_bool failed{false};
+  fml::CountDownLatch decoded;
+};
+
+bool DecodeBand(SkCodec& codec, const SkPixmap& pixmap, int top, int rows) {
+  if (codec.startScanlineDecode(pixmap.info()) != SkCodec::kSuccess) {
+    return false;
+  }
+  if (top > 0 && !codec.skipScanlines(top)) {
+    return false;
+  }
+  return codec.getScanlines(pixmap.writable_addr(0, top), rows,
+                            pixmap.rowBytes()) == rows;
+}
+
+// Decodes the bands that no other thread has claimed yet.
+void DecodeUnclaimedBands(Bands& bands) {
+  for (size_t band = bands.next_band++; band < bands.count;
+       band = bands.next_band++) {
+    TRACE_EVENT0("flutter", "DecodeImageBand");
+    const int top = static_cast<int>(band) * bands.rows_per_band;
+    const int rows = std::min(bands.rows_per_band, bands.pixmap.height() - top);
+    if (!bands.failed && rows > 0 &&
+        !DecodeBand(*bands.codecs[band], bands.pixmap, top, rows)) {
+      bands.failed = true;
+    }
+    bands.decoded.CountDown();
+  }
+}
+
+}  // namespace
+
+size_t ImageBandDecoder::GetBandCount(const SkImageInfo& info) {
+  if (static_cast<int64_t>(info.width()) * info.height() < kMinPixelCount) {
+    return 1u;
+  }
+  size_t count = std::min<size_t>(kMaxBandCount,
+                                  std::thread::hardware_concurrency());
+  return std::min<size_t>(count, info.height());
+}
+
+bool ImageBandDecoder::Decode(
+    ImageGenerator& generator,
+    const SkPixmap& pixmap,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    size_t band_count) {
+  TRACE_EVENT0("flutter", "ImageBandDecoder::Decode");
+  if (!concurrent_task_runner || band_count < 2u || pixmap.height() < 2 ||
+      !pixmap.addr()) {
+    return false;
+  }
+  band_count = std::min<size_t>(band_count, pixmap.height());
+
+  // The codecs are made up front, as the generator may only be used on this
+  // thread.
+  auto bands = std::make_shared<Bands>(pixmap, band_count);
+  for (size_t i = 0; i < band_count; i++) {
+    std::unique_ptr<SkCodec> codec = generator.MakeBandCodec();
+    if (!codec) {
+      return false;
+    }
+    bands->codecs.push_back(std::move(codec));
+  }
+  // Check that the last band can be decoded at all before posting tasks.
+  if (bands->codecs.back()->startScanlineDecode(pixmap.info()) !=
+          SkCodec::kSuccess ||
+      bands->codecs.back()->getScanlineOrder() !=
+          SkCodec::kTopDown_SkScanlineOrder) {
+    return false;
+  }
+
+  for (size_t i = 1; i < band_count; i++) {
+    concurrent_task_runner->PostTask(
+        [bands]() { DecodeUnclaimedBands(*bands); });
+  }
+  DecodeUnclaimedBands(*bands);
+  // All bands have been claimed, so this only waits for bands that workers
+  // are decoding.
+  bands->decoded.Wait();
+  return !bands->failed;
+}
+
+}  // namespace flutter
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_BAND_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_BAND_DECODER_H_
+
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+/// @brief  Decodes large images in horizontal bands of rows on several
+///         threads at once, each band with a codec of its own.
+///
+///         The codec of each band skips the rows above it before decoding
+///         its own. Skipping rows is only cheap for some formats, so only
+///         images whose `ImageGenerator::MakeBandCodec` returns a codec are
+///         decoded in bands.
+/// @see    `ImageGenerator::MakeBandCodec`
+class ImageBandDecoder {
+ public:
+  /// Images with fewer pixels are decoded on one thread, as the time their
+  /// bands spend skipping rows outweighs the time saved.
+  static constexpr int64_t kMinPixelCount = 1024 * 1024;
+
+  /// The number of bands large images are decoded in at most. Bands further
+  /// down skip more rows, which makes more bands pay off less.
+  static constexpr size_t kMaxBandCount = 4u;
+
+  /// @brief      The number of bands an image of the given info should be
+  ///             decoded in. Less than two means it should not be decoded in
+  ///             bands.
+  static size_t GetBandCount(const SkImageInfo& info);
+
+  /// @brief      Decodes the image of the generator into the pixmap in the
+  ///             given number of bands. The calling thread decodes bands
+  ///             itself, and waits for those that are decoded by tasks on the
+  ///             concurrent task runner, so it should be a worker of its own.
+  ///             Bands that no worker has started yet are decoded by the
+  ///             calling thread, so this never waits for a busy runner.
+  /// @param[in]  generator               The generator of the image, used on
+  ///                                     the calling thread only.
+  /// @param[in]  pixmap                  The pixmap to decode into, with the
+  ///                                     dimensions and color info of the
+  ///                                     image to decode.
+  /// @param[in]  concurrent_task_runner  The runner to decode the bands on.
+  /// @param[in]  band_count              The number of bands, at least two.
+  /// @return     Whether the image was decoded. If not, the pixmap may have
+  ///             been partially written and the image should be decoded as
+  ///             usual.
+  static bool Decode(
+      ImageGenerator& generator,
+      const SkPixmap& pixmap,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+      size_t band_count);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(ImageBandDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_BAND_DECODER_H_
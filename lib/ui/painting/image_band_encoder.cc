@@ -0,0 +1,421 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_band_encoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/zlib/zlib.h"
+
+namespace flutter {
+
+namespace {
+
+using EncodeBandCallback = std::function<bool(size_t band, int top, int rows)>;
+
+struct Bands {
+  Bands(int height, size_t count, EncodeBandCallback encode_band)
+      : height(height),
+        count(count),
+        rows_per_band(static_cast<int>((height + count - 1) / count)),
+        encode_band(std::move(encode_band)),
+        encoded(count) {}
+
+  const int height;
+  const size_t count;
+  const int rows_per_band;
+  const EncodeBandCallback encode_band;
+  std::atomic_size_t next_band{0u};
+  std::atomic_bool failed{false};
+  fml::CountDownLatch encoded;
+};
+
+// Encodes the bands that no other thread has claimed yet.
+void EncodeUnclaimedBands(Bands& bands) {
+  for (size_t band = bands.next_band++; band < bands.count;
+       band = bands.next_band++) {
+    TRACE_EVENT0("flutter", "EncodeImageBand");
+    const int top = static_cast<int>(band) * bands.rows_per_band;
+    const int rows = std::min(bands.rows_per_band, bands.height - top);
+    if (!bands.failed && rows > 0 && !bands.encode_band(band, top, rows)) {
+      bands.failed = true;
+    }
+    bands.encoded.CountDown();
+  }
+}
+
+// Encodes the rows of an image of the given height in bands, on the calling
+// thread and the concurrent task runner. Bands that no worker has started
+// yet are encoded by the calling thread, so this never waits for a busy
+// runner.
+bool EncodeBands(
+    int height,
+    size_t band_count,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    EncodeBandCallback encode_band) {
+  if (!concurrent_task_runner) {
+    band_count = 1u;
+  }
+  band_count = std::clamp<size_t>(band_count, 1u, height);
+  auto bands = std::make_shared<Bands>(height, band_count,
+                                       std::move(encode_band));
+  for (size_t i = 1; i < band_count; i++) {
+    concurrent_task_runner->PostTask(
+        [bands]() { EncodeUnclaimedBands(*bands); });
+  }
+  EncodeUnclaimedBands(*bands);
+  // All bands have been claimed, so this only waits for bands that workers
+  // are encoding.
+  bands->encoded.Wait();
+  return !bands->failed;
+}
+
+//------------------------------------------------------------------------------
+/// PNG encoding.
+///
+
+constexpr uint8_t kPngSignature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+constexpr size_t kChunkOverhead = 12u;  // Length, type and CRC.
+constexpr size_t kImageHeaderSize = 13u;
+// The zlib header of a stream deflated with a 32K window at the default
+// level.
+constexpr uint8_t kZlibHeader[2] = {0x78, 0x9C};
+constexpr size_t kAdlerSize = 4u;
+
+enum PngFilter : uint8_t {
+  kNone = 0,
+  kSub = 1,
+  kUp = 2,
+  kAverage = 3,
+  kPaeth = 4,
+  kFilterCount = 5,
+};
+
+struct PngBand {
+  std::vector<uint8_t> deflated;
+  // The checksum and size of the filtered rows, whose checksums are combined
+  // into the checksum of the stream.
+  uLong adler = 0u;
+  size_t filtered_size = 0u;
+};
+
+uint8_t PaethPredictor(int a, int b, int c) {
+  const int p = a + b - c;
+  const int pa = std::abs(p - a);
+  const int pb = std::abs(p - b);
+  const int pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+// Filters the row with the predictor of the given neighbors, the one to the
+// left, above, and above and to the left. Returns the sum of absolute values
+// of the output.
+template <typename Predictor>
+uint64_t ApplyFilter(const uint8_t* row,
+                     const uint8_t* prior,
+                     size_t row_size,
+                     size_t bpp,
+                     Predictor predictor,
+                     uint8_t* out) {
+  uint64_t sum = 0u;
+  for (size_t i = 0; i < row_size; i++) {
+    const int a = i >= bpp ? row[i - bpp] : 0;
+    const int b = prior[i];
+    const int c = i >= bpp ? prior[i - bpp] : 0;
+    const uint8_t value = row[i] - predictor(a, b, c);
+    out[i] = value;
+    sum += std::abs(static_cast<int8_t>(value));
+  }
+  return sum;
+}
+
+// Filters the row with each filter and keeps the one whose output has the
+// smallest sum of absolute values, the heuristic libpng uses.
+void FilterRow(const uint8_t* row,
+               const uint8_t* prior,
+               size_t row_size,
+               size_t bpp,
+               std::vector<uint8_t> (&candidates)[kFilterCount],
+               uint8_t* out) {
+  const uint64_t sums[kFilterCount] = {
+      ApplyFilter(
+          row, prior, row_size, bpp, [](int a, int b, int c) { return 0; },
+          candidates[kNone].data()),
+      ApplyFilter(
+          row, prior, row_size, bpp, [](int a, int b, int c) { return a; },
+          candidates[kSub].data()),
+      ApplyFilter(
+          row, prior, row_size, bpp, [](int a, int b, int c) { return b; },
+          candidates[kUp].data()),
+      ApplyFilter(
+          row, prior, row_size, bpp,
+          [](int a, int b, int c) { return (a + b) / 2; },
+          candidates[kAverage].data()),
+      ApplyFilter(row, prior, row_size, bpp, &PaethPredictor,
+                  candidates[kPaeth].data()),
+  };
+  const size_t filter = std::min_element(sums, sums + kFilterCount) - sums;
+  out[0] = static_cast<uint8_t>(filter);
+  std::memcpy(out + 1, candidates[filter].data(), row_size);
+}
+
+bool EncodePngBand(const SkPixmap& pixmap,
+                   bool is_opaque,
+                   int top,
+                   int rows,
+                   bool is_last,
+                   PngBand& band) {
+  const int width = pixmap.width();
+  const size_t bpp = is_opaque ? 3u : 4u;
+  const size_t row_size = width * bpp;
+
+  // Convert the rows of the band, and the row above it that they are filtered
+  // against, to unpremultiplied RGBA.
+  const int first_row = top > 0 ? top - 1 : top;
+  const int row_count = top + rows - first_row;
+  const SkImageInfo rgba_info = SkImageInfo::Make(
+      width, row_count, kRGBA_8888_SkColorType,
+      is_opaque ? kOpaque_SkAlphaType : kUnpremul_SkAlphaType,
+      pixmap.refColorSpace());
+  std::vector<uint8_t> pixels(rgba_info.computeMinByteSize());
+  SkPixmap band_pixmap;
+  const SkIRect band_rect = SkIRect::MakeXYWH(0, first_row, width, row_count);
+  if (!pixmap.extractSubset(&band_pixmap, band_rect) ||
+      !band_pixmap.readPixels(rgba_info, pixels.data(),
+                              rgba_info.minRowBytes())) {
+    return false;
+  }
+  if (is_opaque) {
+    // Drop the alpha channel in place.
+    const size_t pixel_count = static_cast<size_t>(width) * row_count;
+    for (size_t i = 0; i < pixel_count; i++) {
+      std::memmove(&pixels[i * 3u], &pixels[i * 4u], 3u);
+    }
+  }
+
+  std::vector<uint8_t> filtered((row_size + 1u) * rows);
+  if (filtered.size() > UINT_MAX) {
+    return false;
+  }
+  std::vector<uint8_t> candidates[kFilterCount];
+  for (auto& candidate : candidates) {
+    candidate.resize(row_size);
+  }
+  const std::vector<uint8_t> empty_row(top == 0 ? row_size : 0u);
+  for (int i = 0; i < rows; i++) {
+    const uint8_t* row = &pixels[(top - first_row + i) * row_size];
+    const uint8_t* prior = top + i == 0 ? empty_row.data() : row - row_size;
+    FilterRow(row, prior, row_size, bpp, candidates,
+              &filtered[i * (row_size + 1u)]);
+  }
+  band.filtered_size = filtered.size();
+  band.adler = adler32(adler32(0L, Z_NULL, 0), filtered.data(),
+                       static_cast<uInt>(filtered.size()));
+
+  // Deflate the rows without a zlib header or trailer, which the stream of
+  // the image has once.
+  z_stream stream = {};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+  // The bound is for finishing the stream, a sync flush may take a few more
+  // bytes.
+  band.deflated.resize(deflateBound(&stream, filtered.size()) + 16u);
+  stream.next_in = filtered.data();
+  stream.avail_in = static_cast<uInt>(filtered.size());
+  stream.next_out = band.deflated.data();
+  stream.avail_out = static_cast<uInt>(band.deflated.size());
+  const int result = deflate(&stream, is_last ? Z_FINISH : Z_SYNC_FLUSH);
+  const bool deflated = is_last ? result == Z_STREAM_END
+                                : result == Z_OK && stream.avail_in == 0u &&
+                                      stream.avail_out > 0u;
+  band.deflated.resize(stream.total_out);
+  deflateEnd(&stream);
+  return deflated;
+}
+
+// Writes PNG chunks, computing their checksums.
+class PngWriter {
+ public:
+  explicit PngWriter(uint8_t* out) : out_(out) {}
+
+  void Write(const void* data, size_t size) {
+    std::memcpy(out_, data, size);
+    crc_ = crc32(crc_, out_, static_cast<uInt>(size));
+    out_ += size;
+  }
+
+  void WriteU32(uint32_t value) {
+    const uint8_t bytes[4] = {
+        static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+        static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+    Write(bytes, sizeof(bytes));
+  }
+
+  void BeginChunk(const char type[4], size_t length) {
+    WriteU32(static_cast<uint32_t>(length));
+    crc_ = crc32(0L, Z_NULL, 0);
+    Write(type, 4u);
+  }
+
+  void EndChunk() { WriteU32(static_cast<uint32_t>(crc_)); }
+
+  uint8_t* position() const { return out_; }
+
+ private:
+  uint8_t* out_;
+  uLong crc_ = 0u;
+};
+
+}  // namespace
+
+size_t ImageBandEncoder::GetBandCount(const SkImageInfo& info) {
+  if (static_cast<int64_t>(info.width()) * info.height() < kMinPixelCount) {
+    return 1u;
+  }
+  size_t count = std::min<size_t>(kMaxBandCount,
+                                  std::thread::hardware_concurrency());
+  return std::min<size_t>(count, info.height());
+}
+
+sk_sp<SkData> ImageBandEncoder::EncodePNG(
+    const SkPixmap& pixmap,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    size_t band_count) {
+  TRACE_EVENT0("flutter", "ImageBandEncoder::EncodePNG");
+  if (!pixmap.addr() || pixmap.width() <= 0 || pixmap.height() <= 0 ||
+      (pixmap.colorType() != kRGBA_8888_SkColorType &&
+       pixmap.colorType() != kBGRA_8888_SkColorType) ||
+      pixmap.alphaType() == kUnknown_SkAlphaType ||
+      (pixmap.colorSpace() && !pixmap.colorSpace()->isSRGB())) {
+    return nullptr;
+  }
+  const bool is_opaque = pixmap.alphaType() == kOpaque_SkAlphaType;
+
+  band_count = concurrent_task_runner ? band_count : 1u;
+  band_count = std::clamp<size_t>(band_count, 1u, pixmap.height());
+  std::vector<PngBand> bands(band_count);
+  if (!EncodeBands(pixmap.height(), band_count, concurrent_task_runner,
+                   [&](size_t band, int top, int rows) {
+                     return EncodePngBand(pixmap, is_opaque, top, rows,
+                                          band == band_count - 1u,
+                                          bands[band]);
+                   })) {
+    FML_LOG(ERROR) << "Could not encode the bands of the image.";
+    return nullptr;
+  }
+
+  // Join the bands into the PNG, which is handed out without another copy.
+  const bool is_srgb = pixmap.colorSpace() != nullptr;
+  size_t size = sizeof(kPngSignature) + kChunkOverhead + kImageHeaderSize +
+                (is_srgb ? kChunkOverhead + 1u : 0u) + sizeof(kZlibHeader) +
+                kAdlerSize + kChunkOverhead;
+  uLong adler = adler32(0L, Z_NULL, 0);
+  for (const auto& band : bands) {
+    size += kChunkOverhead + band.deflated.size();
+    adler = adler32_combine(adler, band.adler, band.filtered_size);
+  }
+  sk_sp<SkData> png = SkData::MakeUninitialized(size);
+  PngWriter writer(static_cast<uint8_t*>(png->writable_data()));
+
+  writer.Write(kPngSignature, sizeof(kPngSignature));
+
+  writer.BeginChunk("IHDR", kImageHeaderSize);
+  writer.WriteU32(pixmap.width());
+  writer.WriteU32(pixmap.height());
+  const uint8_t image_header[5] = {
+      8u,                                           // Bit depth.
+      static_cast<uint8_t>(is_opaque ? 2u : 6u),   // Truecolor, with or
+                                                    // without alpha.
+      0u,                                           // Deflate.
+      0u,                                           // Adaptive filtering.
+      0u,                                           // No interlacing.
+  };
+  writer.Write(image_header, sizeof(image_header));
+  writer.EndChunk();
+
+  if (is_srgb) {
+    const uint8_t rendering_intent = 0u;  // Perceptual.
+    writer.BeginChunk("sRGB", 1u);
+    writer.Write(&rendering_intent, 1u);
+    writer.EndChunk();
+  }
+
+  for (size_t i = 0; i < bands.size(); i++) {
+    const bool is_first = i == 0u;
+    const bool is_last = i == bands.size() - 1u;
+    const auto& deflated = bands[i].deflated;
+    const size_t length = (is_first ? sizeof(kZlibHeader) : 0u) +
+                          deflated.size() + (is_last ? kAdlerSize : 0u);
+    writer.BeginChunk("IDAT", length);
+    if (is_first) {
+      writer.Write(kZlibHeader, sizeof(kZlibHeader));
+    }
+    writer.Write(deflated.data(), deflated.size());
+    if (is_last) {
+      writer.WriteU32(static_cast<uint32_t>(adler));
+    }
+    writer.EndChunk();
+  }
+
+  writer.BeginChunk("IEND", 0u);
+  writer.EndChunk();
+  FML_DCHECK(writer.position() == png->bytes() + png->size());
+
+  return png;
+}
+
+sk_sp<SkData> ImageBandEncoder::ConvertPixels(
+    const SkPixmap& pixmap,
+    SkColorType color_type,
+    SkAlphaType alpha_type,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    size_t band_count) {
+  TRACE_EVENT0("flutter", "ImageBandEncoder::ConvertPixels");
+  if (!pixmap.addr() || pixmap.width() <= 0 || pixmap.height() <= 0) {
+    return nullptr;
+  }
+  const SkImageInfo info = SkImageInfo::Make(
+      pixmap.dimensions(), color_type, alpha_type, pixmap.refColorSpace());
+  const size_t row_bytes = info.minRowBytes();
+  const size_t size = info.computeMinByteSize();
+  if (SkImageInfo::ByteSizeOverflowed(size)) {
+    return nullptr;
+  }
+
+  sk_sp<SkData> pixels = SkData::MakeUninitialized(size);
+  auto* bytes = static_cast<uint8_t*>(pixels->writable_data());
+  if (!EncodeBands(pixmap.height(), band_count, concurrent_task_runner,
+                   [&](size_t band, int top, int rows) {
+                     SkPixmap band_pixmap;
+                     return pixmap.extractSubset(
+                                &band_pixmap,
+                                SkIRect::MakeXYWH(0, top, pixmap.width(),
+                                                  rows)) &&
+                            band_pixmap.readPixels(
+                                info.makeWH(pixmap.width(), rows),
+                                bytes + top * row_bytes, row_bytes);
+                   })) {
+    FML_LOG(ERROR) << "Could not convert the pixels of the image.";
+    return nullptr;
+  }
+  return pixels;
+}
+
+}  // namespace flutter
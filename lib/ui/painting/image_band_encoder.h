@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_BAND_ENCODER_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_BAND_ENCODER_H_
+
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+/// @brief  Encodes large images in horizontal bands of rows on several
+///         threads at once, the counterpart of `ImageBandDecoder`.
+///
+///         The rows of each band of a PNG are filtered and deflated on their
+///         own, and the deflated bands are joined into the one zlib stream of
+///         the image, each in an IDAT chunk of its own. Every band but the
+///         last ends on a byte boundary with an empty stored block, which
+///         costs a few bytes per band, and starts without the history of the
+///         band before it, which costs a little compression.
+/// @see    `ImageBandDecoder`
+class ImageBandEncoder {
+ public:
+  /// Images with fewer pixels are encoded on one thread, as the time saved
+  /// doesn't make up for the tasks and the worse compression.
+  static constexpr int64_t kMinPixelCount = 1024 * 1024;
+
+  /// The number of bands large images are encoded in at most.
+  static constexpr size_t kMaxBandCount = 4u;
+
+  /// @brief      The number of bands an image of the given info should be
+  ///             encoded in. Less than two means it should not be encoded in
+  ///             bands.
+  static size_t GetBandCount(const SkImageInfo& info);
+
+  /// @brief      Encodes the pixels to a PNG of 8 bit RGB or RGBA with
+  ///             unpremultiplied alpha, like Skia's encoder does. The calling
+  ///             thread encodes the bands that no worker has started, and
+  ///             only waits for those being encoded, so it may be a worker of
+  ///             the concurrent task runner itself.
+  /// @param[in]  pixmap                  The 8 bit RGBA or BGRA pixels to
+  ///                                     encode, with no color space or sRGB.
+  /// @param[in]  concurrent_task_runner  The runner to encode the bands on.
+  /// @param[in]  band_count              The number of bands, one encodes
+  ///                                     the pixels on the calling thread.
+  /// @return     The PNG, or nullptr if the pixels aren't supported by this
+  ///             encoder and should be encoded by Skia.
+  static sk_sp<SkData> EncodePNG(
+      const SkPixmap& pixmap,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+      size_t band_count);
+
+  /// @brief      Converts the pixels to the color and alpha type in bands,
+  ///             straight into the returned buffer of tightly packed rows.
+  /// @return     The converted pixels, or nullptr if they couldn't be
+  ///             converted.
+  static sk_sp<SkData> ConvertPixels(
+      const SkPixmap& pixmap,
+      SkColorType color_type,
+      SkAlphaType alpha_type,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+      size_t band_count);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(ImageBandEncoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_BAND_ENCODER_H_
@@ -17,20 +17,30 @@ std::unique_ptr<ImageDecoder> ImageDecoder::Make(
     const TaskRunners& runners,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     fml::WeakPtr<IOManager> io_manager) {
+  std::unique_ptr<ImageDecoder> decoder;
 #if IMPELLER_SUPPORTS_RENDERING
   if (settings.enable_impeller) {
-    return std::make_unique<ImageDecoderImpeller>(
+    decoder = std::make_unique<ImageDecoderImpeller>(
         runners,                            //
         std::move(concurrent_task_runner),  //
         std::move(io_manager),              //
         settings.enable_wide_gamut);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
-  return std::make_unique<ImageDecoderSkia>(
-      runners,                            //
-      std::move(concurrent_task_runner),  //
-      std::move(io_manager)               //
-  );
+  if (!decoder) {
+    decoder = std::make_unique<ImageDecoderSkia>(
+        runners,                            //
+        std::move(concurrent_task_runner),  //
+        std::move(io_manager)               //
+    );
+  }
+  decoder->GetDecodedImageCache().SetMaxBytes(
+      settings.decoded_image_cache_max_bytes);
+  decoder->animated_image_decode_ahead_frames_ =
+      settings.animated_image_decode_ahead_frames;
+  decoder->animated_image_frame_cache_max_bytes_ =
+      settings.animated_image_frame_cache_max_bytes;
+  return decoder;
 }
 
 ImageDecoder::ImageDecoder(
@@ -40,13 +50,69 @@ ImageDecoder::ImageDecoder(
     : runners_(runners),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      upload_queue_(
+          std::make_shared<ImageUploadQueue>(runners_.GetIOTaskRunner())),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
       << "The image decoder must be created & collected on the UI thread.";
 }
 
-ImageDecoder::~ImageDecoder() = default;
+ImageDecoder::~ImageDecoder() {
+  // Nobody is waiting for the images that haven't been uploaded yet.
+  upload_queue_->CancelAll();
+}
+
+void ImageDecoder::DecodeShared(fml::RefPtr<ImageDescriptor> descriptor,
+                                uint32_t target_width,
+                                uint32_t target_height,
+                                const ImageResult& result) {
+  FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  sk_sp<SkData> data = descriptor ? descriptor->data() : nullptr;
+  if (decoded_image_cache_.GetMaxBytes() == 0u || !data || data->isEmpty()) {
+    Decode(std::move(descriptor), target_width, target_height, result);
+    return;
+  }
+
+  const DecodedImageCache::Key key = DecodedImageCache::MakeKey(
+      *data, descriptor->image_info(),
+      descriptor->is_compressed() ? 0u : descriptor->row_bytes(),
+      SkISize::Make(target_width, target_height));
+  if (sk_sp<DlImage> image = decoded_image_cache_.Find(key, *data)) {
+    // Callers expect the result after Decode returns, as with a decode.
+    runners_.GetUITaskRunner()->PostTask(
+        [result, image = std::move(image)]() { result(image); });
+    return;
+  }
+  auto found = pending_decodes_.find(key);
+  if (found != pending_decodes_.end()) {
+    // Different bytes may have the same key, those are decoded on their own.
+    if (found->second->data->equals(data.get())) {
+      found->second->results.push_back(result);
+    } else {
+      Decode(std::move(descriptor), target_width, target_height, result);
+    }
+    return;
+  }
+
+  auto pending = std::make_shared<PendingDecode>();
+  pending->data = data;
+  pending_decodes_[key] = pending;
+  Decode(std::move(descriptor), target_width, target_height,
+         [weak_decoder = GetWeakPtr(), key, result,
+          pending](sk_sp<DlImage> image) {
+           // Decode always calls back on the UI thread.
+           if (weak_decoder) {
+             weak_decoder->pending_decodes_.erase(key);
+             weak_decoder->decoded_image_cache_.Insert(key, pending->data,
+                                                       image);
+           }
+           result(image);
+           for (const ImageResult& pending_result : pending->results) {
+             pending_result(image);
+           }
+         });
+}
 
 fml::WeakPtr<ImageDecoder> ImageDecoder::GetWeakPtr() const {
   return weak_factory_.GetWeakPtr();
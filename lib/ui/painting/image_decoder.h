@@ -6,13 +6,17 @@
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODER_H_
 
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/display_list/display_list_image.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/painting/image_upload_queue.h"
 
 namespace flutter {
 
@@ -43,12 +47,35 @@ class ImageDecoder {
                       uint32_t target_height,
                       const ImageResult& result) = 0;
 
+  // Like |Decode|, but returns the image in the |DecodedImageCache| for
+  // descriptors of the same bytes at the same target size, and decodes such
+  // descriptors only once while their decode is pending. Just decodes when
+  // the cache is disabled.
+  void DecodeShared(fml::RefPtr<ImageDescriptor> descriptor,
+                    uint32_t target_width,
+                    uint32_t target_height,
+                    const ImageResult& result);
+
+  DecodedImageCache& GetDecodedImageCache() { return decoded_image_cache_; }
+
+  // How codecs of animated images decode frames ahead, see
+  // |Settings::animated_image_decode_ahead_frames|.
+  size_t GetAnimatedImageDecodeAheadFrames() const {
+    return animated_image_decode_ahead_frames_;
+  }
+
+  size_t GetAnimatedImageFrameCacheMaxBytes() const {
+    return animated_image_frame_cache_max_bytes_;
+  }
+
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
  protected:
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  // Orders the uploads that have to happen on the IO thread.
+  std::shared_ptr<ImageUploadQueue> upload_queue_;
 
   ImageDecoder(
       const TaskRunners& runners,
@@ -56,6 +83,20 @@ class ImageDecoder {
       fml::WeakPtr<IOManager> io_manager);
 
  private:
+  struct PendingDecode {
+    sk_sp<SkData> data;
+    // The results of the descriptors of the same bytes that wait for the
+    // decode.
+    std::vector<ImageResult> results;
+  };
+
+  DecodedImageCache decoded_image_cache_;
+  size_t animated_image_decode_ahead_frames_ = 0;
+  size_t animated_image_frame_cache_max_bytes_ = 0;
+  std::unordered_map<DecodedImageCache::Key,
+                     std::shared_ptr<PendingDecode>,
+                     DecodedImageCache::KeyHash>
+      pending_decodes_;
   fml::WeakPtrFactory<ImageDecoder> weak_factory_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoder);
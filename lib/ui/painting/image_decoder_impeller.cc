@@ -11,12 +11,12 @@
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/display_list/display_list_image_impeller.h"
 #include "flutter/impeller/renderer/allocator.h"
-#include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/impeller/renderer/texture.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 #include "impeller/base/strings.h"
 #include "impeller/geometry/size.h"
+#include "impeller/image/ktx2_image.h"
 #include "include/core/SkSize.h"
 #include "third_party/skia/include/core/SkMallocPixelRef.h"
 #include "third_party/skia/include/core/SkPixmap.h"
@@ -107,11 +107,50 @@ static std::optional<impeller::PixelFormat> ToPixelFormat(SkColorType type) {
   return std::nullopt;
 }
 
+static std::optional<impeller::PixelFormat> ToPixelFormat(
+    impeller::KTX2Image::Format format) {
+  switch (format) {
+    case impeller::KTX2Image::Format::kETC2RGBA8:
+      return impeller::PixelFormat::kETC2R8G8B8A8UNormBlock;
+    case impeller::KTX2Image::Format::kASTC4x4:
+      return impeller::PixelFormat::kASTC4x4UNormBlock;
+    case impeller::KTX2Image::Format::kBC3:
+      return impeller::PixelFormat::kBC3UNormBlock;
+    case impeller::KTX2Image::Format::kInvalid:
+      return std::nullopt;
+  }
+  return std::nullopt;
+}
+
+/// Whether the compressed texture of the descriptor, if any, can be uploaded
+/// as it is for the target size.
+static bool CanUploadCompressedTexture(
+    const std::shared_ptr<impeller::KTX2Image>& image,
+    SkISize target_size,
+    const impeller::Context& context) {
+  if (!image) {
+    return false;
+  }
+  const auto pixel_format = ToPixelFormat(image->GetFormat());
+  if (!pixel_format.has_value() ||
+      !context.GetDeviceCapabilities().SupportsCompressedFormat(
+          pixel_format.value())) {
+    return false;
+  }
+  // Compressed textures can't be resized without decompressing them.
+  const auto& size = image->GetSize();
+  const auto max_size =
+      context.GetResourceAllocator()->GetMaxTextureSizeSupported();
+  return target_size == SkISize::Make(size.width, size.height) &&
+         size.width <= max_size.width && size.height <= max_size.height;
+}
+
 std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
     ImageDescriptor* descriptor,
     SkISize target_size,
     impeller::ISize max_texture_size,
-    bool supports_wide_gamut) {
+    bool supports_wide_gamut,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
   if (!descriptor) {
     FML_DLOG(ERROR) << "Invalid descriptor.";
@@ -172,7 +211,8 @@ std::shared_ptr<SkBitmap> ImageDecoderImpeller::DecompressTexture(
       return nullptr;
     }
     // Decode the image into the image generator's closest supported size.
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    // Large images are decoded in bands on the concurrent runner as well.
+    if (!descriptor->get_pixels(bitmap->pixmap(), concurrent_task_runner)) {
       FML_DLOG(ERROR) << "Could not decompress image.";
       return nullptr;
     }
@@ -229,6 +269,9 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTexture(
   texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
   texture_descriptor.format = pixel_format.value();
   texture_descriptor.size = {image_info.width(), image_info.height()};
+  // The mip levels are only generated by the renderer the first time the
+  // image is drawn downscaled, so that images that never are don't pay for
+  // the blit.
   texture_descriptor.mip_count = texture_descriptor.size.MipCount();
 
   auto texture =
@@ -251,30 +294,52 @@ sk_sp<DlImage> ImageDecoderImpeller::UploadTexture(
 
   texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
 
-  if (texture_descriptor.mip_count > 1u) {
-    auto command_buffer = context->CreateCommandBuffer();
-    if (!command_buffer) {
-      FML_DLOG(ERROR)
-          << "Could not create command buffer for mipmap generation.";
-      return nullptr;
-    }
-    command_buffer->SetLabel("Mipmap Command Buffer");
+  return impeller::DlImageImpeller::Make(std::move(texture));
+}
 
-    auto blit_pass = command_buffer->CreateBlitPass();
-    if (!blit_pass) {
-      FML_DLOG(ERROR) << "Could not create blit pass for mipmap generation.";
-      return nullptr;
-    }
-    blit_pass->SetLabel("Mipmap Blit Pass");
-    blit_pass->GenerateMipmap(texture);
+sk_sp<DlImage> ImageDecoderImpeller::UploadCompressedTexture(
+    const std::shared_ptr<impeller::Context>& context,
+    std::shared_ptr<impeller::KTX2Image> image) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
+  if (!context || !image) {
+    return nullptr;
+  }
+  const auto pixel_format = ToPixelFormat(image->GetFormat());
+  if (!pixel_format.has_value() ||
+      !context->GetDeviceCapabilities().SupportsCompressedFormat(
+          pixel_format.value())) {
+    FML_DLOG(ERROR) << "Compressed pixel format unsupported by the device.";
+    return nullptr;
+  }
 
-    blit_pass->EncodeCommands(context->GetResourceAllocator());
-    if (!command_buffer->SubmitCommands()) {
-      FML_DLOG(ERROR) << "Failed to submit blit pass command buffer.";
-      return nullptr;
-    }
+  impeller::TextureDescriptor texture_descriptor;
+  texture_descriptor.storage_mode = impeller::StorageMode::kHostVisible;
+  texture_descriptor.format = pixel_format.value();
+  texture_descriptor.size = image->GetSize();
+  // Only the base mip level of the container is uploaded, and compressed
+  // textures can't be blitted into mipmaps.
+  texture_descriptor.mip_count = 1u;
+
+  auto texture =
+      context->GetResourceAllocator()->CreateTexture(texture_descriptor);
+  if (!texture) {
+    FML_DLOG(ERROR) << "Could not create Impeller texture.";
+    return nullptr;
   }
 
+  const auto& base_mip_level = image->GetBaseMipLevel();
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      base_mip_level->GetMapping(),                   // data
+      base_mip_level->GetSize(),                      // size
+      [image](auto, auto) mutable { image.reset(); }  // proc
+  );
+
+  if (!texture->SetContents(mapping)) {
+    FML_DLOG(ERROR) << "Could not copy contents into Impeller texture.";
+    return nullptr;
+  }
+
+  texture->SetLabel(impeller::SPrintF("ui.Image(%p)", texture.get()).c_str());
   return impeller::DlImageImpeller::Make(std::move(texture));
 }
 
@@ -303,32 +368,58 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
       [raw_descriptor,                                            //
        context = context_.get(),                                  //
        target_size = SkISize::Make(target_width, target_height),  //
-       io_runner = runners_.GetIOTaskRunner(),                    //
+       upload_queue = upload_queue_,                              //
        result,
-       supports_wide_gamut = supports_wide_gamut_  //
+       supports_wide_gamut = supports_wide_gamut_,                //
+       concurrent_task_runner = concurrent_task_runner_           //
   ]() {
         FML_CHECK(context) << "No valid impeller context";
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
+        // Compressed textures the device can sample from are uploaded
+        // without decompressing them, on the same runner as bitmaps would be.
+        auto compressed_texture = raw_descriptor->compressed_texture();
+        if (CanUploadCompressedTexture(compressed_texture, target_size,
+                                       *context)) {
+          if (context->GetDeviceCapabilities().HasThreadingRestrictions()) {
+            upload_queue->Post(
+                compressed_texture->GetBaseMipLevel()->GetSize(),
+                [result, context, compressed_texture](bool cancelled) {
+                  if (cancelled) {
+                    result(nullptr);
+                    return;
+                  }
+                  result(UploadCompressedTexture(context, compressed_texture));
+                });
+          } else {
+            result(UploadCompressedTexture(context, compressed_texture));
+          }
+          return;
+        }
+
         // Always decompress on the concurrent runner.
         auto bitmap =
             DecompressTexture(raw_descriptor, target_size, max_size_supported,
-                              supports_wide_gamut);
+                              supports_wide_gamut, concurrent_task_runner);
         if (!bitmap) {
           result(nullptr);
           return;
         }
-        auto upload_texture_and_invoke_result = [result, context, bitmap]() {
-          result(UploadTexture(context, bitmap));
-        };
         // Depending on whether the context has threading restrictions, stay on
         // the concurrent runner to perform texture upload or move to an IO
         // runner.
         if (context->GetDeviceCapabilities().HasThreadingRestrictions()) {
-          io_runner->PostTask(upload_texture_and_invoke_result);
+          upload_queue->Post(bitmap->computeByteSize(),
+                             [result, context, bitmap](bool cancelled) {
+                               if (cancelled) {
+                                 result(nullptr);
+                                 return;
+                               }
+                               result(UploadTexture(context, bitmap));
+                             });
         } else {
-          upload_texture_and_invoke_result();
+          result(UploadTexture(context, bitmap));
         }
       });
 }
@@ -13,6 +13,7 @@
 
 namespace impeller {
 class Context;
+class KTX2Image;
 }  // namespace impeller
 
 namespace flutter {
@@ -37,12 +38,21 @@ class ImageDecoderImpeller final : public ImageDecoder {
       ImageDescriptor* descriptor,
       SkISize target_size,
       impeller::ISize max_texture_size,
-      bool supports_wide_gamut);
+      bool supports_wide_gamut,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>&
+          concurrent_task_runner = nullptr);
 
   static sk_sp<DlImage> UploadTexture(
       const std::shared_ptr<impeller::Context>& context,
       std::shared_ptr<SkBitmap> bitmap);
 
+  /// @brief  Uploads the blocks of a compressed texture as they are, which
+  ///         requires the device to support the format of the texture.
+  ///         Returns nullptr if it doesn't.
+  static sk_sp<DlImage> UploadCompressedTexture(
+      const std::shared_ptr<impeller::Context>& context,
+      std::shared_ptr<impeller::KTX2Image> image);
+
  private:
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
   FutureContext context_;
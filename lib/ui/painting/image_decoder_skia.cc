@@ -5,10 +5,12 @@
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
 
 #include <algorithm>
+#include <functional>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
+#include "flutter/lib/ui/painting/image_band_decoder.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImage.h"
 
@@ -100,12 +102,22 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     ImageDescriptor* descriptor,
     uint32_t target_width,
     uint32_t target_height,
-    const fml::tracing::TraceFlow& flow) {
+    const fml::tracing::TraceFlow& flow,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   flow.Step(__FUNCTION__);
 
   if (!descriptor->should_resize(target_width, target_height)) {
-    // No resizing requested. Just decode & rasterize the image.
+    // No resizing requested. Just decode & rasterize the image, in bands on
+    // the concurrent runner as well if it is large.
+    if (ImageBandDecoder::GetBandCount(descriptor->image_info()) > 1u) {
+      SkBitmap bitmap;
+      if (bitmap.tryAllocPixels(descriptor->image_info()) &&
+          descriptor->get_pixels(bitmap.pixmap(), concurrent_task_runner)) {
+        bitmap.setImmutable();
+        return SkImage::MakeFromBitmap(bitmap);
+      }
+    }
     sk_sp<SkImage> image = descriptor->image();
     return image ? image->makeRasterImage() : nullptr;
   }
@@ -134,7 +146,7 @@ sk_sp<SkImage> ImageDecoderSkia::ImageFromCompressedData(
     }
 
     const auto& pixmap = scaled_bitmap.pixmap();
-    if (descriptor->get_pixels(pixmap)) {
+    if (descriptor->get_pixels(pixmap, concurrent_task_runner)) {
       // Marking this as immutable makes the MakeFromBitmap call share
       // the pixels instead of copying.
       scaled_bitmap.setImmutable();
@@ -214,6 +226,103 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
   return result;
 }
 
+using DecodeResult =
+    std::function<void(SkiaGPUObject<SkImage>, fml::tracing::TraceFlow)>;
+
+// Decompresses the image on the calling worker, and uploads it on the IO
+// thread.
+static void DecompressAndUpload(
+    ImageDescriptor* raw_descriptor,
+    const fml::WeakPtr<IOManager>& io_manager,
+    const std::shared_ptr<ImageUploadQueue>& upload_queue,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
+    const DecodeResult& result,
+    uint32_t target_width,
+    uint32_t target_height,
+    fml::tracing::TraceFlow flow) {
+  // Step 1: Decompress the image.
+  // On Worker.
+
+  auto decompressed =
+      raw_descriptor->is_compressed()
+          ? ImageDecoderSkia::ImageFromCompressedData(raw_descriptor,  //
+                                                      target_width,    //
+                                                      target_height,   //
+                                                      flow,            //
+                                                      concurrent_task_runner)
+          : ImageFromDecompressedData(raw_descriptor,  //
+                                      target_width,    //
+                                      target_height,   //
+                                      flow);
+
+  if (!decompressed) {
+    FML_DLOG(ERROR) << "Could not decompress image.";
+    result({}, std::move(flow));
+    return;
+  }
+
+  // Step 2: Update the image to the GPU.
+  // On IO Thread.
+
+  auto byte_size = decompressed->imageInfo().computeMinByteSize();
+  auto upload = [io_manager, decompressed, result,
+                 flow = std::move(flow)](bool cancelled) mutable {
+    if (cancelled) {
+      result({}, std::move(flow));
+      return;
+    }
+
+    if (!io_manager) {
+      FML_DLOG(ERROR) << "Could not acquire IO manager.";
+      result({}, std::move(flow));
+      return;
+    }
+
+    // If the IO manager does not have a resource context, the caller
+    // might not have set one or a software backend could be in use.
+    // Either way, just return the image as-is.
+    if (!io_manager->GetResourceContext()) {
+      result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
+             std::move(flow));
+      return;
+    }
+
+    auto uploaded =
+        UploadRasterImage(std::move(decompressed), io_manager, flow);
+
+    if (!uploaded.skia_object()) {
+      FML_DLOG(ERROR) << "Could not upload image to the GPU.";
+      result({}, std::move(flow));
+      return;
+    }
+
+    // Finally, all done.
+    result(std::move(uploaded), std::move(flow));
+  };
+  upload_queue->Post(byte_size, fml::MakeCopyable(std::move(upload)));
+}
+
+// Makes the texture image of an image that the platform decoded into GPU
+// memory, without decompressing and uploading it. Returns null if the GPU
+// is disabled or the platform memory can't be used by the resource context.
+static sk_sp<SkImage> MakeTextureImage(
+    const ImageGenerator::TextureImageFactory& factory,
+    const fml::WeakPtr<IOManager>& io_manager,
+    const fml::tracing::TraceFlow& flow) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  flow.Step(__FUNCTION__);
+  if (!io_manager || !io_manager->GetResourceContext()) {
+    return nullptr;
+  }
+  sk_sp<SkImage> image;
+  io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse(
+          [&image, &factory, context = io_manager->GetResourceContext()] {
+            image = factory(context.get());
+          }));
+  return image;
+}
+
 // |ImageDecoder|
 void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                               uint32_t target_width,
@@ -242,7 +351,7 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
   // Always service the callback (and cleanup the descriptor) on the UI thread.
-  auto result =
+  DecodeResult result =
       [callback, raw_descriptor, ui_runner = runners_.GetUITaskRunner()](
           SkiaGPUObject<SkImage> image, fml::tracing::TraceFlow flow) {
         ui_runner->PostTask(fml::MakeCopyable(
@@ -262,67 +371,61 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
     return;
   }
 
+  // Only full sized images may be decoded by the platform.
+  const bool full_size =
+      (target_width == 0 && target_height == 0) ||
+      !raw_descriptor->should_resize(target_width, target_height);
+
   concurrent_task_runner_->PostTask(
-      fml::MakeCopyable([raw_descriptor,                          //
-                         io_manager = io_manager_,                //
-                         io_runner = runners_.GetIOTaskRunner(),  //
-                         result,                                  //
-                         target_width = target_width,             //
-                         target_height = target_height,           //
-                         flow = std::move(flow)                   //
+      fml::MakeCopyable([raw_descriptor,                                   //
+                         io_manager = io_manager_,                         //
+                         upload_queue = upload_queue_,                     //
+                         concurrent_task_runner = concurrent_task_runner_,  //
+                         result,                                           //
+                         target_width = target_width,                      //
+                         target_height = target_height,                    //
+                         full_size,                                        //
+                         flow = std::move(flow)                            //
   ]() mutable {
-        // Step 1: Decompress the image.
-        // On Worker.
-
-        auto decompressed = raw_descriptor->is_compressed()
-                                ? ImageFromCompressedData(raw_descriptor,  //
-                                                          target_width,    //
-                                                          target_height,   //
-                                                          flow)
-                                : ImageFromDecompressedData(raw_descriptor,  //
-                                                            target_width,    //
-                                                            target_height,   //
-                                                            flow);
-
-        if (!decompressed) {
-          FML_DLOG(ERROR) << "Could not decompress image.";
-          result({}, std::move(flow));
+        ImageGenerator::TextureImageFactory factory =
+            full_size ? raw_descriptor->decode_to_texture() : nullptr;
+        if (!factory) {
+          DecompressAndUpload(raw_descriptor, io_manager, upload_queue,
+                              concurrent_task_runner, result, target_width,
+                              target_height, std::move(flow));
           return;
         }
 
-        // Step 2: Update the image to the GPU.
-        // On IO Thread.
-
-        io_runner->PostTask(fml::MakeCopyable([io_manager, decompressed, result,
-                                               flow =
-                                                   std::move(flow)]() mutable {
-          if (!io_manager) {
-            FML_DLOG(ERROR) << "Could not acquire IO manager.";
+        // The platform decoded the image into GPU memory, which only has to
+        // be wrapped on the IO thread.
+        const size_t byte_size =
+            raw_descriptor->image_info().computeMinByteSize();
+        auto wrap = [raw_descriptor, io_manager, upload_queue,
+                     concurrent_task_runner, result, target_width,
+                     target_height, factory = std::move(factory),
+                     flow = std::move(flow)](bool cancelled) mutable {
+          if (cancelled) {
             result({}, std::move(flow));
             return;
           }
-
-          // If the IO manager does not have a resource context, the caller
-          // might not have set one or a software backend could be in use.
-          // Either way, just return the image as-is.
-          if (!io_manager->GetResourceContext()) {
-            result({std::move(decompressed), io_manager->GetSkiaUnrefQueue()},
+          if (sk_sp<SkImage> image =
+                  MakeTextureImage(factory, io_manager, flow)) {
+            result({std::move(image), io_manager->GetSkiaUnrefQueue()},
                    std::move(flow));
             return;
           }
-
-          auto uploaded =
-              UploadRasterImage(std::move(decompressed), io_manager, flow);
-
-          if (!uploaded.skia_object()) {
-            FML_DLOG(ERROR) << "Could not upload image to the GPU.";
-            result({}, std::move(flow));
-            return;
-          }
-
-          // Finally, all done.
-          result(std::move(uploaded), std::move(flow));
-        }));
+          // Fall back to decompressing and uploading the image.
+          concurrent_task_runner->PostTask(fml::MakeCopyable(
+              [raw_descriptor, io_manager, upload_queue,
+               concurrent_task_runner, result, target_width, target_height,
+               flow = std::move(flow)]() mutable {
+                DecompressAndUpload(raw_descriptor, io_manager, upload_queue,
+                                    concurrent_task_runner, result,
+                                    target_width, target_height,
+                                    std::move(flow));
+              }));
+        };
+        upload_queue->Post(byte_size, fml::MakeCopyable(std::move(wrap)));
       }));
 }
 
@@ -29,7 +29,9 @@ class ImageDecoderSkia final : public ImageDecoder {
       ImageDescriptor* descriptor,
       uint32_t target_width,
       uint32_t target_height,
-      const fml::tracing::TraceFlow& flow);
+      const fml::tracing::TraceFlow& flow,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>&
+          concurrent_task_runner = nullptr);
 
  private:
   FML_DISALLOW_COPY_AND_ASSIGN(ImageDecoderSkia);
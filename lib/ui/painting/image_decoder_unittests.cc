@@ -2,9 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/mapping.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/painting/image_band_decoder.h"
 #include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
 #include "flutter/lib/ui/painting/image_decoder_skia.h"
@@ -19,6 +24,7 @@
 #include "flutter/testing/test_gl_surface.h"
 #include "flutter/testing/testing.h"
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkEncodedImageFormat.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
@@ -99,6 +105,75 @@ class TestIOManager final : public IOManager {
   FML_DISALLOW_COPY_AND_ASSIGN(TestIOManager);
 };
 
+// Records the frames decoded by a generator, and on which thread.
+class RecordingImageGenerator final : public ImageGenerator {
+ public:
+  struct DecodedFrame {
+    unsigned int frame_index;
+    bool on_io_thread;
+  };
+
+  RecordingImageGenerator(std::shared_ptr<ImageGenerator> generator,
+                          fml::RefPtr<fml::TaskRunner> io_task_runner)
+      : generator_(std::move(generator)),
+        io_task_runner_(std::move(io_task_runner)) {}
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override { return generator_->GetInfo(); }
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override {
+    return generator_->GetFrameCount();
+  }
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override {
+    return generator_->GetPlayCount();
+  }
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override {
+    return generator_->GetFrameInfo(frame_index);
+  }
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override {
+    return generator_->GetScaledDimensions(desired_scale);
+  }
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    bool result = generator_->GetPixels(info, pixels, row_bytes, frame_index,
+                                        prior_frame);
+    {
+      std::scoped_lock lock(mutex_);
+      decoded_frames_.push_back(
+          {frame_index, io_task_runner_->RunsTasksOnCurrentThread()});
+    }
+    decoded_frames_changed_.notify_all();
+    return result;
+  }
+
+  std::vector<DecodedFrame> WaitForDecodedFrames(size_t count) {
+    std::unique_lock lock(mutex_);
+    decoded_frames_changed_.wait(
+        lock, [&]() { return decoded_frames_.size() >= count; });
+    return decoded_frames_;
+  }
+
+ private:
+  const std::shared_ptr<ImageGenerator> generator_;
+  const fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  std::mutex mutex_;
+  std::condition_variable decoded_frames_changed_;
+  std::vector<DecodedFrame> decoded_frames_;
+};
+
 static sk_sp<SkData> OpenFixtureAsSkData(const char* name) {
   auto fixtures_directory =
       fml::OpenDirectory(GetFixturesPath(), false, fml::FilePermission::kRead);
@@ -683,6 +758,45 @@ TEST(ImageDecoderTest, VerifySimpleDecoding) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderTest, DecodingInBandsMatchesDecodingAtOnce) {
+  auto data = OpenFixtureAsSkData("DashInNooglerHat.jpg");
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> generator =
+      registry.CreateCompatibleGenerator(data);
+  ASSERT_TRUE(generator);
+
+  const SkImageInfo info = generator->GetInfo();
+  SkBitmap expected;
+  ASSERT_TRUE(expected.tryAllocPixels(info));
+  ASSERT_TRUE(generator->GetPixels(info, expected.getPixels(),
+                                   expected.rowBytes()));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  for (size_t band_count : {2u, 3u, 7u}) {
+    SkBitmap banded;
+    ASSERT_TRUE(banded.tryAllocPixels(info));
+    ASSERT_TRUE(ImageBandDecoder::Decode(*generator, banded.pixmap(),
+                                         loop->GetTaskRunner(), band_count));
+    for (int y = 0; y < info.height(); y++) {
+      ASSERT_EQ(memcmp(expected.getAddr(0, y), banded.getAddr(0, y),
+                       info.minRowBytes()),
+                0)
+          << "Row " << y << " of " << band_count << " bands differs.";
+    }
+  }
+
+  // Small images are decoded at once.
+  EXPECT_EQ(
+      ImageBandDecoder::GetBandCount(SkImageInfo::MakeN32Premul(600, 200)),
+      1u);
+
+  // Formats that can't skip rows cheaply are not decoded in bands.
+  auto png_generator =
+      registry.CreateCompatibleGenerator(OpenFixtureAsSkData("Horizontal.png"));
+  ASSERT_TRUE(png_generator);
+  EXPECT_EQ(png_generator->MakeBandCodec(), nullptr);
+}
+
 TEST(ImageDecoderTest, VerifySubpixelDecodingPreservesExifOrientation) {
   auto data = OpenFixtureAsSkData("Horizontal.jpg");
 
@@ -871,5 +985,95 @@ TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDidAccessGpuDisabledSyncSwitch) {
   PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
 }
 
+TEST_F(ImageDecoderFixtureTest, MultiFrameCodecDecodesFramesAhead) {
+  auto settings = CreateSettingsForFixture();
+  auto vm_ref = DartVMRef::Create(settings);
+  auto vm_data = vm_ref.GetVMData();
+
+  auto gif_mapping = OpenFixtureAsSkData("hello_loop_2.gif");
+
+  ASSERT_TRUE(gif_mapping);
+
+  ImageGeneratorRegistry registry;
+  std::shared_ptr<ImageGenerator> gif_generator =
+      registry.CreateCompatibleGenerator(gif_mapping);
+  ASSERT_TRUE(gif_generator);
+  const unsigned int frame_count = gif_generator->GetFrameCount();
+  ASSERT_GT(frame_count, 1u);
+
+  TaskRunners runners(GetCurrentTestName(),         // label
+                      CreateNewThread("platform"),  // platform
+                      CreateNewThread("raster"),    // raster
+                      CreateNewThread("ui"),        // ui
+                      CreateNewThread("io")         // io
+  );
+  auto recording_generator = std::make_shared<RecordingImageGenerator>(
+      std::move(gif_generator), runners.GetIOTaskRunner());
+  auto loop = fml::ConcurrentMessageLoop::Create(1);
+
+  std::unique_ptr<TestIOManager> io_manager;
+  fml::RefPtr<MultiFrameCodec> codec;
+
+  // Setup the IO manager.
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() {
+    io_manager = std::make_unique<TestIOManager>(runners.GetIOTaskRunner());
+  });
+
+  auto isolate = RunDartCodeInIsolate(vm_ref, settings, runners, "main", {},
+                                      GetDefaultKernelFilePath(),
+                                      io_manager->GetWeakIOManager());
+
+  auto get_next_frame = [&]() {
+    PostTaskSync(runners.GetUITaskRunner(), [&]() {
+      EXPECT_TRUE(isolate->RunInIsolateScope([&]() -> bool {
+        Dart_Handle closure = Dart_GetField(
+            Dart_RootLibrary(), Dart_NewStringFromCString("frameCallback"));
+        if (Dart_IsError(closure) || !Dart_IsClosure(closure)) {
+          return false;
+        }
+        if (!codec) {
+          // All the frames fit, so they are kept across loops.
+          codec = fml::MakeRefCounted<MultiFrameCodec>(
+              recording_generator,
+              MultiFrameCodec::DecodeAhead{
+                  .frame_count = frame_count,
+                  .max_bytes = 64u * 1024u * 1024u,
+                  .task_runner = loop->GetTaskRunner()});
+        }
+        codec->getNextFrame(closure);
+        return true;
+      }));
+    });
+    // Wait for the frame on the IO task runner.
+    PostTaskSync(runners.GetIOTaskRunner(), []() {});
+  };
+
+  // The first frame is decoded when it's asked for, and the others ahead of
+  // it on the worker.
+  get_next_frame();
+  recording_generator->WaitForDecodedFrames(frame_count);
+  // The other frames come from the cache, and so does the first one when the
+  // animation loops.
+  for (unsigned int i = 0; i < frame_count; i++) {
+    get_next_frame();
+  }
+
+  auto decoded_frames = recording_generator->WaitForDecodedFrames(0u);
+  ASSERT_EQ(decoded_frames.size(), frame_count);
+  for (unsigned int i = 0; i < frame_count; i++) {
+    EXPECT_EQ(decoded_frames[i].frame_index, i);
+    EXPECT_EQ(decoded_frames[i].on_io_thread, i == 0u);
+  }
+
+  // Destroy the Isolate
+  isolate = nullptr;
+
+  // Destroy the MultiFrameCodec
+  PostTaskSync(runners.GetUITaskRunner(), [&]() { codec = nullptr; });
+
+  // Destroy the IO manager
+  PostTaskSync(runners.GetIOTaskRunner(), [&]() { io_manager.reset(); });
+}
+
 }  // namespace testing
 }  // namespace flutter
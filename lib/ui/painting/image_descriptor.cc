@@ -7,6 +7,8 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image_band_decoder.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/lib/ui/painting/single_frame_codec.h"
 #include "flutter/lib/ui/ui_dart_state.h"
@@ -111,7 +113,17 @@ void ImageDescriptor::instantiateCodec(Dart_Handle codec_handle,
         static_cast<fml::RefPtr<ImageDescriptor>>(this), target_width,
         target_height);
   } else {
-    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_);
+    MultiFrameCodec::DecodeAhead decode_ahead;
+    auto* dart_state = UIDartState::Current();
+    if (auto image_decoder = dart_state->GetImageDecoder()) {
+      decode_ahead.frame_count =
+          image_decoder->GetAnimatedImageDecodeAheadFrames();
+      decode_ahead.max_bytes =
+          image_decoder->GetAnimatedImageFrameCacheMaxBytes();
+      decode_ahead.task_runner = dart_state->GetConcurrentTaskRunner();
+    }
+    ui_codec = fml::MakeRefCounted<MultiFrameCodec>(generator_,
+                                                    std::move(decode_ahead));
   }
   ui_codec->AssociateWithDartWrapper(codec_handle);
 }
@@ -126,4 +138,18 @@ bool ImageDescriptor::get_pixels(const SkPixmap& pixmap) const {
                                pixmap.rowBytes());
 }
 
+bool ImageDescriptor::get_pixels(
+    const SkPixmap& pixmap,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner)
+    const {
+  FML_DCHECK(generator_);
+  const size_t band_count = ImageBandDecoder::GetBandCount(pixmap.info());
+  if (band_count > 1u &&
+      ImageBandDecoder::Decode(*generator_, pixmap, concurrent_task_runner,
+                               band_count)) {
+    return true;
+  }
+  return get_pixels(pixmap);
+}
+
 }  // namespace flutter
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
@@ -109,6 +110,28 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
   ///         orientation tag, if applicable.
   bool get_pixels(const SkPixmap& pixmap) const;
 
+  /// @brief  Gets pixels for this image like `get_pixels`, but decodes large
+  ///         images in bands on the concurrent task runner as well as the
+  ///         calling thread, if the `ImageGenerator` supports it.
+  /// @see    `ImageBandDecoder`
+  bool get_pixels(const SkPixmap& pixmap,
+                  const std::shared_ptr<fml::ConcurrentTaskRunner>&
+                      concurrent_task_runner) const;
+
+  /// @brief  Decodes this image with a decoder of the platform into memory
+  ///         that the GPU can sample from directly, if its `ImageGenerator`
+  ///         supports it.
+  /// @see    `ImageGenerator::DecodeToTexture`
+  ImageGenerator::TextureImageFactory decode_to_texture() const {
+    return generator_ ? generator_->DecodeToTexture() : nullptr;
+  }
+
+  /// @brief  The block compressed texture of the image, if it is one.
+  /// @see    `ImageGenerator::GetCompressedTexture`
+  std::shared_ptr<impeller::KTX2Image> compressed_texture() const {
+    return generator_ ? generator_->GetCompressedTexture() : nullptr;
+  }
+
   void dispose() {
     buffer_.reset();
     generator_.reset();
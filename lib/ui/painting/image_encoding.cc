@@ -10,9 +10,11 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/build_config.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_band_encoder.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
 #endif  // IMPELLER_SUPPORTS_RENDERING
@@ -68,9 +70,11 @@ void InvokeDataCallback(std::unique_ptr<DartPersistentValue> callback,
   DartInvoke(callback->value(), {dart_data});
 }
 
-sk_sp<SkData> CopyImageByteData(const sk_sp<SkImage>& raster_image,
-                                SkColorType color_type,
-                                SkAlphaType alpha_type) {
+sk_sp<SkData> CopyImageByteData(
+    const sk_sp<SkImage>& raster_image,
+    SkColorType color_type,
+    SkAlphaType alpha_type,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   FML_DCHECK(raster_image);
 
   SkPixmap pixmap;
@@ -85,7 +89,15 @@ sk_sp<SkData> CopyImageByteData(const sk_sp<SkImage>& raster_image,
     return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
   }
 
-  // Perform swizzle if the type doesnt match the specification.
+  // Perform swizzle if the type doesnt match the specification. Large images
+  // are swizzled in bands on several workers, straight into the buffer that
+  // is handed to Dart.
+  if (auto pixels = ImageBandEncoder::ConvertPixels(
+          pixmap, color_type, alpha_type, concurrent_task_runner,
+          ImageBandEncoder::GetBandCount(pixmap.info()))) {
+    return pixels;
+  }
+
   auto surface = SkSurface::MakeRaster(
       SkImageInfo::Make(raster_image->width(), raster_image->height(),
                         color_type, alpha_type, nullptr));
@@ -105,8 +117,10 @@ sk_sp<SkData> CopyImageByteData(const sk_sp<SkImage>& raster_image,
   return SkData::MakeWithCopy(pixmap.addr(), pixmap.computeByteSize());
 }
 
-sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
-                          ImageByteFormat format) {
+sk_sp<SkData> EncodeImage(
+    const sk_sp<SkImage>& raster_image,
+    ImageByteFormat format,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner) {
   TRACE_EVENT0("flutter", __FUNCTION__);
 
   if (!raster_image) {
@@ -115,6 +129,17 @@ sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
 
   switch (format) {
     case kPNG: {
+      // Large images are encoded in bands on several workers. Pixels that the
+      // band encoder doesn't support are encoded by Skia.
+      SkPixmap pixmap;
+      if (raster_image->peekPixels(&pixmap)) {
+        if (auto png_image = ImageBandEncoder::EncodePNG(
+                pixmap, concurrent_task_runner,
+                ImageBandEncoder::GetBandCount(pixmap.info()))) {
+          return png_image;
+        }
+      }
+
       auto png_image =
           raster_image->encodeToData(SkEncodedImageFormat::kPNG, 0);
 
@@ -126,15 +151,16 @@ sk_sp<SkData> EncodeImage(const sk_sp<SkImage>& raster_image,
     } break;
     case kRawRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType,
-                               kPremul_SkAlphaType);
+                               kPremul_SkAlphaType, concurrent_task_runner);
     } break;
     case kRawStraightRGBA: {
       return CopyImageByteData(raster_image, kRGBA_8888_SkColorType,
-                               kUnpremul_SkAlphaType);
+                               kUnpremul_SkAlphaType, concurrent_task_runner);
     } break;
     case kRawUnmodified: {
       return CopyImageByteData(raster_image, raster_image->colorType(),
-                               raster_image->alphaType());
+                               raster_image->alphaType(),
+                               concurrent_task_runner);
     } break;
   }
 
@@ -149,6 +175,7 @@ void EncodeImageAndInvokeDataCallback(
     const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
     const fml::RefPtr<fml::TaskRunner>& raster_task_runner,
     const fml::RefPtr<fml::TaskRunner>& io_task_runner,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& concurrent_task_runner,
     const fml::WeakPtr<GrDirectContext>& resource_context,
     const fml::TaskRunnerAffineWeakPtr<SnapshotDelegate>& snapshot_delegate,
     const std::shared_ptr<const fml::SyncSwitch>& is_gpu_disabled_sync_switch,
@@ -162,12 +189,24 @@ void EncodeImageAndInvokeDataCallback(
   // EncodeImage.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   auto encode_task = [callback_task = std::move(callback_task), format,
-                      ui_task_runner](const sk_sp<SkImage>& raster_image) {
-    sk_sp<SkData> encoded = EncodeImage(raster_image, format);
-    ui_task_runner->PostTask([callback_task = callback_task,
-                              encoded = std::move(encoded)]() mutable {
-      callback_task(std::move(encoded));
-    });
+                      ui_task_runner, concurrent_task_runner](
+                         const sk_sp<SkImage>& raster_image) {
+    // Encoding large images takes long, so it is done on a worker instead of
+    // the IO thread, which uploads the images being decoded.
+    auto encode = [callback_task, format, ui_task_runner,
+                   concurrent_task_runner, raster_image]() {
+      sk_sp<SkData> encoded =
+          EncodeImage(raster_image, format, concurrent_task_runner);
+      ui_task_runner->PostTask([callback_task = callback_task,
+                                encoded = std::move(encoded)]() mutable {
+        callback_task(std::move(encoded));
+      });
+    };
+    if (concurrent_task_runner) {
+      concurrent_task_runner->PostTask(encode);
+    } else {
+      encode();
+    }
   };
 
   FML_DCHECK(image);
@@ -211,13 +250,15 @@ Dart_Handle EncodeImage(CanvasImage* canvas_image,
        image_format, ui_task_runner = task_runners.GetUITaskRunner(),
        raster_task_runner = task_runners.GetRasterTaskRunner(),
        io_task_runner = task_runners.GetIOTaskRunner(),
+       concurrent_task_runner =
+           UIDartState::Current()->GetConcurrentTaskRunner(),
        io_manager = UIDartState::Current()->GetIOManager(),
        snapshot_delegate = UIDartState::Current()->GetSnapshotDelegate(),
        is_impeller_enabled =
            UIDartState::Current()->IsImpellerEnabled()]() mutable {
         EncodeImageAndInvokeDataCallback(
             image, std::move(callback), image_format, ui_task_runner,
-            raster_task_runner, io_task_runner,
+            raster_task_runner, io_task_runner, concurrent_task_runner,
             io_manager->GetResourceContext(), snapshot_delegate,
             io_manager->GetIsGpuDisabledSyncSwitch(),
             io_manager->GetImpellerContext(), is_impeller_enabled);
@@ -65,6 +65,7 @@ void ConvertImageToRasterSkia(
   // Cross-context images do not support makeRasterImage. Convert these images
   // by drawing them into a surface.  This must be done on the raster thread
   // to prevent concurrent usage of the image on both the IO and raster threads.
+  // The pixels are read back without blocking the raster thread.
   raster_task_runner->PostTask([dl_image, encode_task = std::move(encode_task),
                                 resource_context, snapshot_delegate,
                                 io_task_runner, is_gpu_disabled_sync_switch,
@@ -76,26 +77,30 @@ void ConvertImageToRasterSkia(
       return;
     }
 
-    sk_sp<SkImage> raster_image =
-        snapshot_delegate->ConvertToRasterImage(image);
-
-    io_task_runner->PostTask([image, encode_task = encode_task,
-                              raster_image = std::move(raster_image),
-                              resource_context, is_gpu_disabled_sync_switch,
-                              owning_context = dl_image->owning_context(),
-                              raster_task_runner]() mutable {
-      if (!raster_image) {
-        // The rasterizer was unable to render the cross-context image
-        // (presumably because it does not have a GrContext).  In that case,
-        // convert the image on the IO thread using the resource context.
-        raster_image = ConvertToRasterUsingResourceContext(
-            image, resource_context, is_gpu_disabled_sync_switch);
-      }
-      encode_task(raster_image);
-      if (owning_context == DlImage::OwningContext::kRaster) {
-        raster_task_runner->PostTask([image = std::move(image)]() {});
-      }
-    });
+    snapshot_delegate->ConvertToRasterImageAsync(
+        image, [image, encode_task = encode_task, resource_context,
+                io_task_runner, is_gpu_disabled_sync_switch,
+                owning_context = dl_image->owning_context(),
+                raster_task_runner](sk_sp<SkImage> raster_image) {
+          io_task_runner->PostTask([image, encode_task = encode_task,
+                                    raster_image = std::move(raster_image),
+                                    resource_context,
+                                    is_gpu_disabled_sync_switch, owning_context,
+                                    raster_task_runner]() mutable {
+            if (!raster_image) {
+              // The rasterizer was unable to render the cross-context image
+              // (presumably because it does not have a GrContext).  In that
+              // case, convert the image on the IO thread using the resource
+              // context.
+              raster_image = ConvertToRasterUsingResourceContext(
+                  image, resource_context, is_gpu_disabled_sync_switch);
+            }
+            encode_task(raster_image);
+            if (owning_context == DlImage::OwningContext::kRaster) {
+              raster_task_runner->PostTask([image = std::move(image)]() {});
+            }
+          });
+        });
   });
 }
 
@@ -6,14 +6,17 @@
 #include "flutter/lib/ui/painting/image_encoding_impl.h"
 
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_band_encoder.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
@@ -273,6 +276,53 @@ TEST(ImageEncodingImpellerTest, ConvertDlImageToSkImage10XR) {
 }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
+TEST(ImageEncodingTest, EncodingInBandsMatchesThePixels) {
+  SkBitmap bitmap;
+  ASSERT_TRUE(bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(301, 203)));
+  for (int y = 0; y < bitmap.height(); y++) {
+    for (int x = 0; x < bitmap.width(); x++) {
+      *bitmap.getAddr32(x, y) = SkPreMultiplyARGB(
+          (x * y) % 256, x % 256, y % 256, (x + y) % 256);
+    }
+  }
+  const SkImageInfo unpremul_info =
+      bitmap.info().makeColorType(kRGBA_8888_SkColorType).makeAlphaType(
+          kUnpremul_SkAlphaType);
+  SkBitmap expected;
+  ASSERT_TRUE(expected.tryAllocPixels(unpremul_info));
+  ASSERT_TRUE(bitmap.pixmap().readPixels(expected.pixmap()));
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  for (size_t band_count : {1u, 3u, 4u}) {
+    auto png = ImageBandEncoder::EncodePNG(bitmap.pixmap(),
+                                           loop->GetTaskRunner(), band_count);
+    ASSERT_TRUE(png);
+    auto decoded = SkImage::MakeFromEncoded(png);
+    ASSERT_TRUE(decoded);
+    SkBitmap actual;
+    ASSERT_TRUE(actual.tryAllocPixels(unpremul_info));
+    ASSERT_TRUE(decoded->readPixels(actual.pixmap(), 0, 0));
+    for (int y = 0; y < bitmap.height(); y++) {
+      ASSERT_EQ(memcmp(expected.getAddr(0, y), actual.getAddr(0, y),
+                       unpremul_info.minRowBytes()),
+                0)
+          << "Row " << y << " of " << band_count << " bands differs.";
+    }
+
+    auto converted = ImageBandEncoder::ConvertPixels(
+        bitmap.pixmap(), kRGBA_8888_SkColorType, kUnpremul_SkAlphaType,
+        loop->GetTaskRunner(), band_count);
+    ASSERT_TRUE(converted);
+    ASSERT_EQ(converted->size(), expected.computeByteSize());
+    ASSERT_EQ(memcmp(converted->data(), expected.getPixels(),
+                     converted->size()),
+              0);
+  }
+
+  // Small images are encoded at once.
+  EXPECT_EQ(ImageBandEncoder::GetBandCount(bitmap.info()), 1u);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -13,6 +13,19 @@ namespace flutter {
 
 ImageGenerator::~ImageGenerator() = default;
 
+std::unique_ptr<SkCodec> ImageGenerator::MakeBandCodec() const {
+  return nullptr;
+}
+
+ImageGenerator::TextureImageFactory ImageGenerator::DecodeToTexture() {
+  return nullptr;
+}
+
+std::shared_ptr<impeller::KTX2Image> ImageGenerator::GetCompressedTexture()
+    const {
+  return nullptr;
+}
+
 sk_sp<SkImage> ImageGenerator::GetImage() {
   SkImageInfo info = GetInfo();
 
@@ -135,6 +148,25 @@ bool BuiltinSkiaCodecImageGenerator::GetPixels(
   return codec_generator_->getPixels(info, pixels, row_bytes, &options);
 }
 
+std::unique_ptr<SkCodec> BuiltinSkiaCodecImageGenerator::MakeBandCodec()
+    const {
+  // Only JPEG decoders skip rows without decoding them fully. PNG rows have
+  // to be inflated and unfiltered to be skipped, and WebP decoders can't
+  // decode rows at all.
+  std::unique_ptr<SkCodec> codec =
+      SkCodec::MakeFromData(codec_generator_->refEncodedData());
+  if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG ||
+      codec->getFrameCount() > 1) {
+    return nullptr;
+  }
+  // The generator applies the EXIF orientation, which turns the rows of the
+  // codec into columns or flips their order.
+  if (codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return nullptr;
+  }
+  return codec;
+}
+
 std::unique_ptr<ImageGenerator> BuiltinSkiaCodecImageGenerator::MakeFromData(
     sk_sp<SkData> data) {
   auto codec = SkCodec::MakeFromData(std::move(data));
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 #define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_H_
 
+#include <functional>
 #include <optional>
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/codec/SkCodec.h"
@@ -15,6 +16,12 @@
 #include "third_party/skia/include/core/SkSize.h"
 #include "third_party/skia/src/codec/SkCodecImageGenerator.h"  // nogncheck
 
+class GrDirectContext;
+
+namespace impeller {
+class KTX2Image;
+}  // namespace impeller
+
 namespace flutter {
 
 /// @brief  The minimal interface necessary for defining a decoder that can be
@@ -132,6 +139,41 @@ class ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) = 0;
 
+  /// @brief      Creates a new codec for the image that can decode any band of
+  ///             its rows by skipping the rows above it cheaply, so that large
+  ///             images can be decoded in bands on several threads at once.
+  ///             The codec must decode the same pixels as `GetPixels`.
+  /// @return     The codec, or nullptr if the image should not be decoded in
+  ///             bands, which is the default.
+  /// @see        `ImageBandDecoder`
+  virtual std::unique_ptr<SkCodec> MakeBandCodec() const;
+
+  /// @brief  Makes a texture image of the decoded image on the IO thread,
+  ///         with the resource context current.
+  using TextureImageFactory =
+      std::function<sk_sp<SkImage>(GrDirectContext* resource_context)>;
+
+  /// @brief      Decodes the full sized image with a decoder of the platform
+  ///             into memory that the GPU can sample from directly, so that
+  ///             the image doesn't have to be decoded with `GetPixels` and
+  ///             uploaded.
+  /// @return     The factory of the texture image, or nullptr if the image
+  ///             should be decoded with `GetPixels` instead, which is the
+  ///             default. The factory may also return nullptr, e.g. when the
+  ///             resource context is of a backend the platform decoder can't
+  ///             share memory with, in which case the image is decoded with
+  ///             `GetPixels` after all.
+  /// @note       This method is executed on a worker thread, like
+  ///             `GetPixels`.
+  virtual TextureImageFactory DecodeToTexture();
+
+  /// @brief      The block compressed texture of the image, which is sampled
+  ///             from without decoding it when the image is drawn at its
+  ///             full size by a device that supports its format.
+  /// @return     The texture, or nullptr if the image isn't a compressed
+  ///             texture, which is the default.
+  virtual std::shared_ptr<impeller::KTX2Image> GetCompressedTexture() const;
+
   /// @brief   Creates an `SkImage` based on the current `ImageInfo` of this
   ///          `ImageGenerator`.
   /// @return  A new `SkImage` containing the decoded image data.
@@ -209,6 +251,9 @@ class BuiltinSkiaCodecImageGenerator : public ImageGenerator {
       unsigned int frame_index = 0,
       std::optional<unsigned int> prior_frame = std::nullopt) override;
 
+  // |ImageGenerator|
+  std::unique_ptr<SkCodec> MakeBandCodec() const override;
+
   static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
 
  private:
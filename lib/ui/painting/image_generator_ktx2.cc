@@ -0,0 +1,90 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/image/ktx2_image.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+KTX2ImageGenerator::KTX2ImageGenerator(
+    std::shared_ptr<impeller::KTX2Image> image)
+    : image_(std::move(image)),
+      image_info_(SkImageInfo::Make(image_->GetSize().width,
+                                    image_->GetSize().height,
+                                    kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType)) {}
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  return image_info_.dimensions();
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  TRACE_EVENT0("flutter", "KTX2ImageGenerator::GetPixels");
+  auto decoded = image_->Decode();
+  if (!decoded.IsValid()) {
+    FML_LOG(ERROR) << "The KTX2 texture could not be decompressed.";
+    return false;
+  }
+
+  // The decompressed pixels are taken as premultiplied, like the texture is
+  // when it's sampled directly.
+  SkPixmap decoded_pixmap(image_info_, decoded.GetAllocation()->GetMapping(),
+                          image_info_.minRowBytes());
+  return decoded_pixmap.readPixels(info, pixels, row_bytes);
+}
+
+std::shared_ptr<impeller::KTX2Image> KTX2ImageGenerator::GetCompressedTexture()
+    const {
+  return image_;
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data) {
+    return nullptr;
+  }
+  auto mapping = std::make_shared<fml::NonOwnedMapping>(
+      data->bytes(), data->size(),
+      [data](const uint8_t* bytes, size_t size) mutable { data.reset(); });
+  if (!impeller::KTX2Image::IsKTX2(*mapping)) {
+    return nullptr;
+  }
+  auto image = impeller::KTX2Image::Create(std::move(mapping));
+  if (!image) {
+    return nullptr;
+  }
+  return std::unique_ptr<KTX2ImageGenerator>(
+      new KTX2ImageGenerator(std::move(image)));
+}
+
+}  // namespace flutter
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+/// @brief  `ImageGenerator` for KTX2 containers of block compressed textures.
+///
+///         Impeller uploads the compressed blocks as they are on devices that
+///         support the format of the texture, see `GetCompressedTexture`.
+///         Everywhere else the texture is decompressed by `GetPixels`, which
+///         isn't possible for ASTC.
+///
+///         The texture is sampled without any conversion, so the colors of
+///         the containers must be premultiplied by their alpha, or be opaque.
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  ~KTX2ImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  std::shared_ptr<impeller::KTX2Image> GetCompressedTexture() const override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  const std::shared_ptr<impeller::KTX2Image> image_;
+  const SkImageInfo image_info_;
+
+  explicit KTX2ImageGenerator(std::shared_ptr<impeller::KTX2Image> image);
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
@@ -15,6 +15,7 @@
 #endif
 
 #include "image_generator_apng.h"
+#include "image_generator_ktx2.h"
 
 namespace flutter {
 
@@ -25,6 +26,12 @@ ImageGeneratorRegistry::ImageGeneratorRegistry() : weak_factory_(this) {
       },
       0);
 
+  AddFactory(
+      [](sk_sp<SkData> buffer) {
+        return KTX2ImageGenerator::MakeFromData(std::move(buffer));
+      },
+      0);
+
   AddFactory(
       [](sk_sp<SkData> buffer) {
         return BuiltinSkiaCodecImageGenerator::MakeFromData(std::move(buffer));
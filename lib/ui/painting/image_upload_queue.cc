@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_upload_queue.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ImageUploadQueue::ImageUploadQueue(fml::RefPtr<fml::TaskRunner> io_task_runner)
+    : io_task_runner_(std::move(io_task_runner)) {}
+
+ImageUploadQueue::~ImageUploadQueue() = default;
+
+void ImageUploadQueue::Post(size_t byte_size, Upload upload) {
+  {
+    std::scoped_lock lock(mutex_);
+    uploads_.push_back({
+        .byte_size = byte_size,
+        .upload = std::move(upload),
+    });
+  }
+  // Every upload posts one task, which runs whichever upload is next when it
+  // gets to run. The tasks keep the queue alive so that every upload is
+  // either run or cancelled.
+  io_task_runner_->PostTask(
+      [queue = shared_from_this()]() { queue->RunNextUpload(); });
+}
+
+void ImageUploadQueue::CancelAll() {
+  std::scoped_lock lock(mutex_);
+  // The uploads stay in the queue so that the tasks that were posted for them
+  // still have uploads to run, which clean up after them.
+  for (auto& upload : uploads_) {
+    upload.cancelled = true;
+  }
+}
+
+size_t ImageUploadQueue::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  size_t count = 0u;
+  for (const auto& upload : uploads_) {
+    if (!upload.cancelled) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void ImageUploadQueue::RunNextUpload() {
+  FML_DCHECK(io_task_runner_->RunsTasksOnCurrentThread());
+  PendingUpload next;
+  {
+    std::scoped_lock lock(mutex_);
+    if (uploads_.empty()) {
+      return;
+    }
+    // Cancelled uploads are cheap to retire, so they go first. Otherwise the
+    // oldest upload goes first if it has waited long enough, and the smallest
+    // one if not.
+    auto selected = uploads_.begin();
+    if (!selected->cancelled && selected->skip_count < kMaxSkipCount) {
+      for (auto it = uploads_.begin(); it != uploads_.end(); ++it) {
+        if (it->cancelled) {
+          selected = it;
+          break;
+        }
+        if (it->byte_size < selected->byte_size) {
+          selected = it;
+        }
+      }
+    }
+    for (auto it = uploads_.begin(); it != selected; ++it) {
+      it->skip_count++;
+    }
+    next = std::move(*selected);
+    uploads_.erase(selected);
+  }
+  TRACE_EVENT0("flutter", "ImageUploadQueue::RunNextUpload");
+  next.upload(next.cancelled);
+}
+
+}  // namespace flutter
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_UPLOAD_QUEUE_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_UPLOAD_QUEUE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Orders the texture uploads of decoded images on the IO thread
+///             so that small images aren't stuck behind large ones.
+///
+///             Each upload runs in its own task on the IO task runner, so
+///             other IO tasks can run between uploads. When a task runs, it
+///             performs the smallest pending upload rather than the oldest.
+///             An upload that has been passed over `kMaxSkipCount` times
+///             runs next regardless of its size, so large images are
+///             delayed, not starved.
+///
+///             Pending uploads are cancelled when their results are no
+///             longer wanted, such as when the image decoder of an isolate
+///             that is shutting down is collected.
+///
+///             This class is thread safe, and must be owned by a
+///             `std::shared_ptr`.
+///
+class ImageUploadQueue : public std::enable_shared_from_this<ImageUploadQueue> {
+ public:
+  static constexpr size_t kMaxSkipCount = 8u;
+
+  /// Performs an upload on the IO thread, or cleans up after it if it was
+  /// cancelled.
+  using Upload = std::function<void(bool cancelled)>;
+
+  explicit ImageUploadQueue(fml::RefPtr<fml::TaskRunner> io_task_runner);
+
+  ~ImageUploadQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queues an upload of the size in bytes.
+  ///
+  /// @param[in]  byte_size  The size of the image, which orders the upload.
+  /// @param[in]  upload     Invoked exactly once on the IO thread, with
+  ///                        whether the upload was cancelled.
+  ///
+  void Post(size_t byte_size, Upload upload);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Cancels the uploads that haven't started yet.
+  ///
+  void CancelAll();
+
+  /// The number of uploads that haven't started yet.
+  size_t GetPendingCount() const;
+
+ private:
+  struct PendingUpload {
+    size_t byte_size;
+    Upload upload;
+    bool cancelled = false;
+    size_t skip_count = 0u;
+  };
+
+  const fml::RefPtr<fml::TaskRunner> io_task_runner_;
+  mutable std::mutex mutex_;
+  // Oldest first.
+  std::list<PendingUpload> uploads_;
+
+  void RunNextUpload();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageUploadQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_UPLOAD_QUEUE_H_
@@ -0,0 +1,71 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_upload_queue.h"
+
+#include <vector>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Posts the uploads from a task on the IO thread, so that they are all
+// pending before the first of them runs, and waits for all of them to run.
+std::vector<size_t> RunUploads(const std::vector<size_t>& byte_sizes,
+                               bool cancel = false) {
+  fml::Thread io_thread("io");
+  auto queue = std::make_shared<ImageUploadQueue>(io_thread.GetTaskRunner());
+  std::vector<size_t> order;
+  fml::AutoResetWaitableEvent latch;
+  io_thread.GetTaskRunner()->PostTask([&]() {
+    for (size_t byte_size : byte_sizes) {
+      queue->Post(byte_size, [&, byte_size](bool cancelled) {
+        EXPECT_EQ(cancelled, cancel);
+        order.push_back(byte_size);
+        if (order.size() == byte_sizes.size()) {
+          latch.Signal();
+        }
+      });
+    }
+    EXPECT_EQ(queue->GetPendingCount(), byte_sizes.size());
+    if (cancel) {
+      queue->CancelAll();
+      EXPECT_EQ(queue->GetPendingCount(), 0u);
+    }
+  });
+  latch.Wait();
+  return order;
+}
+
+}  // namespace
+
+TEST(ImageUploadQueueTest, RunsSmallerUploadsFirst) {
+  EXPECT_EQ(RunUploads({300u, 100u, 200u}),
+            (std::vector<size_t>{100u, 200u, 300u}));
+}
+
+TEST(ImageUploadQueueTest, DoesNotStarveLargeUploads) {
+  std::vector<size_t> byte_sizes = {1000u};
+  for (size_t i = 0; i < ImageUploadQueue::kMaxSkipCount + 2; i++) {
+    byte_sizes.push_back(1u);
+  }
+
+  auto order = RunUploads(byte_sizes);
+
+  ASSERT_EQ(order.size(), byte_sizes.size());
+  EXPECT_EQ(order[ImageUploadQueue::kMaxSkipCount], 1000u);
+}
+
+TEST(ImageUploadQueueTest, CancelsPendingUploads) {
+  EXPECT_EQ(RunUploads({100u, 200u}, /*cancel=*/true),
+            (std::vector<size_t>{100u, 200u}));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,9 +4,11 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <string>
 #include <utility>
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image.h"
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_decoder_impeller.h"
@@ -18,12 +20,23 @@
 
 namespace flutter {
 
-MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                                 DecodeAhead decode_ahead)
+    : state_(new State(std::move(generator), std::move(decode_ahead))) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+static SkImageInfo GetFrameImageInfo(ImageGenerator& generator) {
+  SkImageInfo info = generator.GetInfo().makeColorType(kN32_SkColorType);
+  if (info.alphaType() == kUnpremul_SkAlphaType) {
+    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
+    info = updated;
+  }
+  return info;
+}
+
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              DecodeAhead decode_ahead)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
@@ -31,6 +44,13 @@ MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
                            ? -1
                            : generator_->GetPlayCount() - 1),
       is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()),
+      decodeAhead_(decode_ahead.task_runner ? std::move(decode_ahead)
+                                            : DecodeAhead{}),
+      frameByteSize_(GetFrameImageInfo(*generator_).computeMinByteSize()),
+      keepAllFrames_(decodeAhead_.frame_count > 0 && frameCount_ > 0 &&
+                     frameByteSize_ > 0 &&
+                     static_cast<size_t>(frameCount_) <=
+                         decodeAhead_.max_bytes / frameByteSize_),
       nextFrameIndex_(0) {}
 
 static void InvokeNextFrameCallback(
@@ -82,25 +102,19 @@ static bool CopyToBitmap(SkBitmap* dst,
   return true;
 }
 
-sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    std::shared_ptr<impeller::Context> impeller_context_,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
-  SkBitmap bitmap = SkBitmap();
-  SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
-  if (info.alphaType() == kUnpremul_SkAlphaType) {
-    SkImageInfo updated = info.makeAlphaType(kPremul_SkAlphaType);
-    info = updated;
-  }
-  if (!bitmap.tryAllocPixels(info)) {
+std::shared_ptr<SkBitmap> MultiFrameCodec::State::DecodeNextFrameLocked() {
+  TRACE_EVENT1("flutter", "MultiFrameCodec::DecodeFrame", "frame",
+               std::to_string(nextDecodeIndex_).c_str());
+  auto bitmap = std::make_shared<SkBitmap>();
+  SkImageInfo info = GetFrameImageInfo(*generator_);
+  if (!bitmap->tryAllocPixels(info)) {
     FML_LOG(ERROR) << "Failed to allocate memory for bitmap of size "
                    << info.computeMinByteSize() << "B";
     return nullptr;
   }
 
   ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+      generator_->GetFrameInfo(nextDecodeIndex_);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -112,14 +126,14 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
     // `DisposalMethod::kRestorePrevious` is not supported.
     if (lastRequiredFrame_ == nullptr) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << nextDecodeIndex_ << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
       // Copy the previous frame's output buffer into the current frame as the
       // starting point.
       if (lastRequiredFrame_->getPixels() &&
-          CopyToBitmap(&bitmap, lastRequiredFrame_->colorType(),
+          CopyToBitmap(bitmap.get(), lastRequiredFrame_->colorType(),
                        *lastRequiredFrame_)) {
         prior_frame_index = requiredFrameIndex;
       }
@@ -128,27 +142,136 @@ sk_sp<DlImage> MultiFrameCodec::State::GetNextFrameImage(
 
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
-  if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
-    FML_LOG(ERROR) << "Could not getPixels for frame " << nextFrameIndex_;
+  if (!generator_->GetPixels(info, bitmap->getPixels(), bitmap->rowBytes(),
+                             nextDecodeIndex_, requiredFrameIndex)) {
+    FML_LOG(ERROR) << "Could not getPixels for frame " << nextDecodeIndex_;
     return nullptr;
   }
+  // The pixels may be shared with |lastRequiredFrame_| and with the cache,
+  // later frames are decoded into copies.
+  bitmap->setImmutable();
 
   // Hold onto this if we need it to decode future frames.
   if (frameInfo.disposal_method == SkCodecAnimation::DisposalMethod::kKeep ||
       lastRequiredFrame_) {
-    lastRequiredFrame_ = std::make_unique<SkBitmap>(bitmap);
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrame_ = std::make_unique<SkBitmap>(*bitmap);
+    lastRequiredFrameIndex_ = nextDecodeIndex_;
+  }
+
+  nextDecodeIndex_ = (nextDecodeIndex_ + 1) % frameCount_;
+  return bitmap;
+}
+
+bool MultiFrameCodec::State::ShouldDecodeAheadLocked() const {
+  // Once every frame is kept, the frame to decode is cached again after a
+  // loop.
+  if (decodeAhead_.frame_count == 0 ||
+      decodedFrames_.count(nextDecodeIndex_) > 0) {
+    return false;
+  }
+  const size_t frames_ahead =
+      (nextDecodeIndex_ - nextFrameIndex_ + frameCount_) % frameCount_;
+  if (frames_ahead >= decodeAhead_.frame_count) {
+    return false;
+  }
+  // Every frame fits when they are all kept.
+  return keepAllFrames_ || (decodedFrames_.size() + 1) * frameByteSize_ <=
+                               decodeAhead_.max_bytes;
+}
+
+bool MultiFrameCodec::State::DecodeAheadFrame() {
+  std::scoped_lock lock(decodeMutex_);
+  if (!ShouldDecodeAheadLocked()) {
+    isDecodingAhead_ = false;
+    return false;
   }
+  const int frame_index = nextDecodeIndex_;
+  auto bitmap = DecodeNextFrameLocked();
+  if (!bitmap) {
+    // Leave the frame to be decoded when it's asked for.
+    isDecodingAhead_ = false;
+    return false;
+  }
+  decodedFrames_[frame_index] = {
+      .bitmap = std::move(bitmap),
+      .duration = static_cast<int>(
+          generator_->GetFrameInfo(frame_index).duration)};
+  return true;
+}
+
+void MultiFrameCodec::State::ScheduleDecodeAhead() {
+  {
+    std::scoped_lock lock(decodeMutex_);
+    if (isDecodingAhead_ || !ShouldDecodeAheadLocked()) {
+      return;
+    }
+    isDecodingAhead_ = true;
+  }
+  // Each frame is decoded with a strong reference to the state, so frames
+  // stop being decoded ahead soon after the codec is collected.
+  decodeAhead_.task_runner->PostTask(
+      [weak_state = std::weak_ptr<State>(shared_from_this())]() {
+        while (auto state = weak_state.lock()) {
+          if (!state->DecodeAheadFrame()) {
+            return;
+          }
+        }
+      });
+}
+
+MultiFrameCodec::State::DecodedFrame MultiFrameCodec::State::TakeNextFrame() {
+  std::scoped_lock lock(decodeMutex_);
+  const int frame_index = nextFrameIndex_;
+  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+
+  auto found = decodedFrames_.find(frame_index);
+  if (found != decodedFrames_.end()) {
+    DecodedFrame frame = found->second;
+    if (!keepAllFrames_) {
+      decodedFrames_.erase(found);
+    }
+    return frame;
+  }
+
+  // The frame hasn't been decoded ahead, and because frames are decoded in
+  // order, it's the next one to decode.
+  FML_DCHECK(nextDecodeIndex_ == frame_index);
+  if (nextDecodeIndex_ != frame_index) {
+    decodedFrames_.clear();
+    lastRequiredFrame_ = nullptr;
+    lastRequiredFrameIndex_ = -1;
+    nextDecodeIndex_ = frame_index;
+  }
+  DecodedFrame frame;
+  frame.bitmap = DecodeNextFrameLocked();
+  if (!frame.bitmap) {
+    nextDecodeIndex_ = nextFrameIndex_;
+    return frame;
+  }
+  frame.duration =
+      static_cast<int>(generator_->GetFrameInfo(frame_index).duration);
+  if (keepAllFrames_) {
+    decodedFrames_[frame_index] = frame;
+  }
+  return frame;
+}
+
+sk_sp<DlImage> MultiFrameCodec::State::UploadFrame(
+    const std::shared_ptr<SkBitmap>& frame,
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    std::shared_ptr<impeller::Context> impeller_context_,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+  const SkBitmap& bitmap = *frame;
 
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     sk_sp<DlImage> result;
     // impeller, transfer to DlImageImpeller
     gpu_disable_sync_switch->Execute(fml::SyncSwitch::Handlers().SetIfFalse(
-        [&result, &bitmap, &impeller_context_] {
-          result = ImageDecoderImpeller::UploadTexture(
-              impeller_context_, std::make_shared<SkBitmap>(bitmap));
+        [&result, &frame, &impeller_context_] {
+          result = ImageDecoderImpeller::UploadTexture(impeller_context_,
+                                                       frame);
         }));
 
     return result;
@@ -191,17 +314,20 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     std::shared_ptr<impeller::Context> impeller_context) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
+  DecodedFrame frame = TakeNextFrame();
+  // Decode the following frames while this one is uploaded and shown.
+  ScheduleDecodeAhead();
   sk_sp<DlImage> dlImage =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        std::move(impeller_context), std::move(unref_queue));
+      frame.bitmap
+          ? UploadFrame(frame.bitmap, std::move(resourceContext),
+                        gpu_disable_sync_switch, std::move(impeller_context),
+                        std::move(unref_queue))
+          : nullptr;
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
+    duration = frame.duration;
   }
-  nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -5,6 +5,10 @@
 #ifndef FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 #define FLUTTER_LIB_UI_PAINTING_MUTLI_FRAME_CODEC_H_
 
+#include <map>
+#include <mutex>
+
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
@@ -15,7 +19,21 @@ namespace flutter {
 
 class MultiFrameCodec : public Codec {
  public:
-  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator);
+  // Decoding frames ahead of the frames that are asked for.
+  //
+  // Frames are decoded in order, each from the previous one, on the task
+  // runner, and cached until they are asked for. The cache holds at most
+  // |frame_count| frames and |max_bytes| bytes. Animations whose frames
+  // all fit in |max_bytes| keep every frame, and stop decoding once they
+  // have looped once.
+  struct DecodeAhead {
+    size_t frame_count = 0;
+    size_t max_bytes = 0;
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner;
+  };
+
+  explicit MultiFrameCodec(std::shared_ptr<ImageGenerator> generator,
+                           DecodeAhead decode_ahead = {});
 
   ~MultiFrameCodec() override;
 
@@ -38,25 +56,67 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  //
+  // Frames decoded ahead are decoded on the decode-ahead task runner, which
+  // is why the state that decoding uses is guarded by |decodeMutex_|.
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, DecodeAhead decode_ahead);
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
-
-    // The non-const members and functions below here are only read or written
-    // to on the IO thread. They are not safe to access or write on the UI
-    // thread.
+    const DecodeAhead decodeAhead_;
+    // The size of the bitmap of each frame.
+    const size_t frameByteSize_;
+    // Whether every frame is kept once decoded, because they all fit in the
+    // decode-ahead cache.
+    const bool keepAllFrames_;
+
+    struct DecodedFrame {
+      std::shared_ptr<SkBitmap> bitmap;
+      int duration = 0;
+    };
+
+    std::mutex decodeMutex_;
+    // The non-const members below here are guarded by |decodeMutex_|, and so
+    // are the calls to the generator that decode frames.
+    //
+    // The index of the next frame to hand out.
     int nextFrameIndex_;
+    // The index of the next frame to decode, which is ahead of
+    // |nextFrameIndex_| while frames are decoded ahead.
+    int nextDecodeIndex_ = 0;
     // The last decoded frame that's required to decode any subsequent frames.
     std::unique_ptr<SkBitmap> lastRequiredFrame_;
 
     // The index of the last decoded required frame.
     int lastRequiredFrameIndex_ = -1;
 
-    sk_sp<DlImage> GetNextFrameImage(
+    // The frames that were decoded ahead, or every decoded frame when
+    // |keepAllFrames_|.
+    std::map<int, DecodedFrame> decodedFrames_;
+    bool isDecodingAhead_ = false;
+
+    // Decodes the frame at |nextDecodeIndex_| and moves on to the next one.
+    // Returns nullptr and stays at the frame if it can't be decoded.
+    std::shared_ptr<SkBitmap> DecodeNextFrameLocked();
+
+    // Whether the frame at |nextDecodeIndex_| should be decoded ahead.
+    bool ShouldDecodeAheadLocked() const;
+
+    // Decodes one frame ahead into the cache. Returns false once no more
+    // frames should be decoded ahead.
+    bool DecodeAheadFrame();
+
+    void ScheduleDecodeAhead();
+
+    // Returns the frame at |nextFrameIndex_| from the cache, or decodes it,
+    // and moves on to the next frame.
+    DecodedFrame TakeNextFrame();
+
+    sk_sp<DlImage> UploadFrame(
+        const std::shared_ptr<SkBitmap>& frame,
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         std::shared_ptr<impeller::Context> impeller_context_,
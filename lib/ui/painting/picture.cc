@@ -80,6 +80,29 @@ static sk_sp<DlImage> CreateDeferredImage(
       raster_task_runner, std::move(unref_queue));
 }
 
+static sk_sp<DlImage> CreateDeferredImage(
+    bool impeller,
+    std::shared_ptr<LayerTree> layer_tree,
+    uint32_t width,
+    uint32_t height,
+    fml::TaskRunnerAffineWeakPtr<SnapshotDelegate> snapshot_delegate,
+    fml::RefPtr<fml::TaskRunner> raster_task_runner,
+    fml::RefPtr<SkiaUnrefQueue> unref_queue) {
+#if IMPELLER_SUPPORTS_RENDERING
+  if (impeller) {
+    return DlDeferredImageGPUImpeller::Make(
+        std::move(layer_tree), SkISize::Make(width, height),
+        std::move(snapshot_delegate), std::move(raster_task_runner));
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  const SkImageInfo image_info = SkImageInfo::Make(
+      width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+  return DlDeferredImageGPUSkia::MakeFromLayerTree(
+      image_info, std::move(layer_tree), std::move(snapshot_delegate),
+      raster_task_runner, std::move(unref_queue));
+}
+
 // static
 void Picture::RasterizeToImageSync(sk_sp<DisplayList> display_list,
                                    uint32_t width,
@@ -177,7 +200,10 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
           return;
         }
 
-        if (image->skia_image()) {
+        // Images owned by the raster context are already released on the
+        // raster thread, and can't be accessed on this one.
+        if (image->owning_context() != DlImage::OwningContext::kRaster &&
+            image->skia_image()) {
           image =
               DlImageGPU::Make({image->skia_image(), std::move(unref_queue)});
         }
@@ -194,6 +220,32 @@ Dart_Handle Picture::RasterizeToImage(const sk_sp<DisplayList>& display_list,
         image_callback.reset();
       });
 
+  if (dart_state->ArePipelinedSnapshotsEnabled()) {
+    // The deferred image records its commands in a task on the raster task
+    // runner, without waiting for the GPU. The image is handed out once that
+    // task has run, which is after the commands of all of the snapshots that
+    // were requested before it have been recorded as well, so that they are
+    // submitted to the GPU together.
+    sk_sp<DlImage> deferred_image =
+        layer_tree
+            ? CreateDeferredImage(dart_state->IsImpellerEnabled(),
+                                  std::move(layer_tree), width, height,
+                                  snapshot_delegate, raster_task_runner,
+                                  unref_queue)
+            : CreateDeferredImage(dart_state->IsImpellerEnabled(),
+                                  display_list, width, height,
+                                  snapshot_delegate, raster_task_runner,
+                                  unref_queue);
+    fml::TaskRunner::RunNowOrPostTask(
+        raster_task_runner,
+        [ui_task_runner, ui_task, image = std::move(deferred_image)]() {
+          sk_sp<DlImage> result = image->get_error() ? nullptr : image;
+          fml::TaskRunner::RunNowOrPostTask(
+              ui_task_runner, [ui_task, result]() { ui_task(result); });
+        });
+    return Dart_Null();
+  }
+
   // Kick things off on the raster rask runner.
   fml::TaskRunner::RunNowOrPostTask(
       raster_task_runner,
@@ -88,9 +88,12 @@ std::string SceneNode::initFromAsset(const std::string& asset_name,
   task_runners.GetRasterTaskRunner()->PostTask(
       fml::MakeCopyable([ui_task = std::move(ui_task), task_runners,
                          impeller_context = impeller_context_promise.get(),
-                         data = std::move(data)]() {
+                         data = std::move(data)]() mutable {
+        // The meshes are uploaded from the asset mapping as their nodes are
+        // first rendered.
         auto node = impeller::scene::Node::MakeFromFlatbuffer(
-            *data, *impeller_context->GetResourceAllocator());
+            std::shared_ptr<const fml::Mapping>(std::move(data)),
+            *impeller_context->GetResourceAllocator());
 
         task_runners.GetUITaskRunner()->PostTask(
             [ui_task, node = std::move(node)]() { ui_task(node); });
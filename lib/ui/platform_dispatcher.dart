@@ -614,6 +614,31 @@ class PlatformDispatcher {
   @Native<Void Function(Int64)>(symbol: 'PlatformConfigurationNativeApi::RegisterBackgroundIsolate')
   external static void __registerBackgroundIsolate(int rootIsolateId);
 
+  /// Delivers the messages that platform-specific plugins send on the channel
+  /// named [name] to [port], rather than to [onPlatformMessage] or
+  /// [channelBuffers].
+  ///
+  /// The messages are posted to the port as they arrive, without being
+  /// scheduled on the thread of this isolate, so that a background isolate
+  /// can handle a busy channel, such as that of a sensor, without contending
+  /// with the building of frames. Each message is a list of the name of the
+  /// channel and a [Uint8List] of the payload, or null.
+  ///
+  /// Messages delivered to a port can't be replied to. The plugin receives an
+  /// empty reply as soon as a message is posted. If the port is closed, the
+  /// messages of the channel are delivered to this isolate again.
+  ///
+  /// Passing a null [port] delivers the messages of the channel to this
+  /// isolate again.
+  ///
+  /// This can only be called on the root isolate.
+  void setChannelPort(String name, SendPort? port) {
+    __setChannelPort(name, port?.nativePort ?? 0);
+  }
+
+  @Native<Void Function(Handle, Int64)>(symbol: 'PlatformConfigurationNativeApi::SetChannelPort')
+  external static void __setChannelPort(String name, int port);
+
   /// Called whenever this platform dispatcher receives a message from a
   /// platform-specific plugin.
   ///
@@ -1481,6 +1506,10 @@ enum _FrameTimingInfo {
   /// The number of bytes used to cache pictures during the frame.
   pictureCacheBytes,
 
+  /// The number of frames that were replaced by the frame before they were
+  /// rasterized.
+  discardedFrameCount,
+
   /// The frame number of the frame.
   frameNumber,
 }
@@ -1516,6 +1545,7 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int discardedFrameCount = 0,
     int frameNumber = -1,
   }) {
     return FrameTiming._(<int>[
@@ -1529,6 +1559,7 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      discardedFrameCount,
       frameNumber,
     ]);
   }
@@ -1619,6 +1650,13 @@ class FrameTiming {
   /// See also [layerCacheCount], [layerCacheBytes], [pictureCacheCount] and [pictureCacheBytes].
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  /// The number of frames that were built before this frame but were never
+  /// rasterized, because this frame replaced them while the raster thread was
+  /// falling behind.
+  ///
+  /// This is always zero unless the engine only rasterizes the latest frame.
+  int get discardedFrameCount => _rawInfo(_FrameTimingInfo.discardedFrameCount);
+
   /// The frame key associated with this frame measurement.
   int get frameNumber => _data.last;
 
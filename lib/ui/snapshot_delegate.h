@@ -5,6 +5,7 @@
 #ifndef FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 #define FLUTTER_LIB_UI_SNAPSHOT_DELEGATE_H_
 
+#include <functional>
 #include <string>
 
 #include "flutter/common/graphics/texture.h"
@@ -73,6 +74,19 @@ class SnapshotDelegate {
                                             SkISize picture_size) = 0;
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Like `ConvertToRasterImage`, but reads the pixels of the image
+  ///             back from the GPU asynchronously, so that the raster thread
+  ///             doesn't wait for them.
+  ///
+  /// @param[in]  image     The image to convert.
+  /// @param[in]  callback  Invoked on the raster thread with the raster image,
+  ///                       or with nullptr if the image couldn't be converted.
+  ///
+  virtual void ConvertToRasterImageAsync(
+      sk_sp<SkImage> image,
+      std::function<void(sk_sp<SkImage>)> callback) = 0;
 };
 
 }  // namespace flutter
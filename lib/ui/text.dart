@@ -2688,48 +2688,86 @@ class Paragraph extends NativeFieldWrapperClass1 {
 
   bool _needsLayout = true;
 
+  // Whether the paragraph is being laid out by [layoutAsync], during which it
+  // can only be disposed.
+  bool _layoutPending = false;
+
+  void _checkLayoutNotPending() {
+    if (_layoutPending) {
+      throw StateError('The paragraph is used before its layoutAsync completed.');
+    }
+  }
+
   /// The amount of horizontal space this paragraph occupies.
   ///
   /// Valid only after [layout] has been called.
+  double get width {
+    _checkLayoutNotPending();
+    return _width;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::width', isLeaf: true)
-  external double get width;
+  external double get _width;
 
   /// The amount of vertical space this paragraph occupies.
   ///
   /// Valid only after [layout] has been called.
+  double get height {
+    _checkLayoutNotPending();
+    return _height;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::height', isLeaf: true)
-  external double get height;
+  external double get _height;
 
   /// The distance from the left edge of the leftmost glyph to the right edge of
   /// the rightmost glyph in the paragraph.
   ///
   /// Valid only after [layout] has been called.
+  double get longestLine {
+    _checkLayoutNotPending();
+    return _longestLine;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::longestLine', isLeaf: true)
-  external double get longestLine;
+  external double get _longestLine;
 
   /// The minimum width that this paragraph could be without failing to paint
   /// its contents within itself.
   ///
   /// Valid only after [layout] has been called.
+  double get minIntrinsicWidth {
+    _checkLayoutNotPending();
+    return _minIntrinsicWidth;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::minIntrinsicWidth', isLeaf: true)
-  external double get minIntrinsicWidth;
+  external double get _minIntrinsicWidth;
 
   /// Returns the smallest width beyond which increasing the width never
   /// decreases the height.
   ///
   /// Valid only after [layout] has been called.
+  double get maxIntrinsicWidth {
+    _checkLayoutNotPending();
+    return _maxIntrinsicWidth;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::maxIntrinsicWidth', isLeaf: true)
-  external double get maxIntrinsicWidth;
+  external double get _maxIntrinsicWidth;
 
   /// The distance from the top of the paragraph to the alphabetic
   /// baseline of the first line, in logical pixels.
+  double get alphabeticBaseline {
+    _checkLayoutNotPending();
+    return _alphabeticBaseline;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::alphabeticBaseline', isLeaf: true)
-  external double get alphabeticBaseline;
+  external double get _alphabeticBaseline;
 
   /// The distance from the top of the paragraph to the ideographic
   /// baseline of the first line, in logical pixels.
+  double get ideographicBaseline {
+    _checkLayoutNotPending();
+    return _ideographicBaseline;
+  }
   @Native<Double Function(Pointer<Void>)>(symbol: 'Paragraph::ideographicBaseline', isLeaf: true)
-  external double get ideographicBaseline;
+  external double get _ideographicBaseline;
 
   /// True if there is more vertical content, but the text was truncated, either
   /// because we reached `maxLines` lines of text or because the `maxLines` was
@@ -2738,13 +2776,18 @@ class Paragraph extends NativeFieldWrapperClass1 {
   ///
   /// See the discussion of the `maxLines` and `ellipsis` arguments at
   /// [ParagraphStyle.new].
+  bool get didExceedMaxLines {
+    _checkLayoutNotPending();
+    return _didExceedMaxLines;
+  }
   @Native<Bool Function(Pointer<Void>)>(symbol: 'Paragraph::didExceedMaxLines', isLeaf: true)
-  external bool get didExceedMaxLines;
+  external bool get _didExceedMaxLines;
 
   /// Computes the size and position of each glyph in the paragraph.
   ///
   /// The [ParagraphConstraints] control how wide the text is allowed to be.
   void layout(ParagraphConstraints constraints) {
+    _checkLayoutNotPending();
     _layout(constraints.width);
     assert(() {
       _needsLayout = false;
@@ -2754,6 +2797,45 @@ class Paragraph extends NativeFieldWrapperClass1 {
   @Native<Void Function(Pointer<Void>, Double)>(symbol: 'Paragraph::layout', isLeaf: true)
   external void _layout(double width);
 
+  /// Computes the size and position of each glyph in the paragraph on a worker
+  /// thread, rather than on the thread that calls this method.
+  ///
+  /// The paragraph must not be used, other than to [dispose] it, until the
+  /// returned future completes. Its other methods and getters throw a
+  /// [StateError] in the meantime.
+  ///
+  /// The layouts of paragraphs built with the same fonts are serialized,
+  /// since they share font caches, so laying out several paragraphs this way,
+  /// for instance the text of list items ahead of them being scrolled into
+  /// view, lays them out one after the other, but in parallel with the work
+  /// of the calling thread:
+  ///
+  /// ```dart
+  /// Future<void> layoutAll(List<Paragraph> paragraphs, double width) {
+  ///   final ParagraphConstraints constraints = ParagraphConstraints(width: width);
+  ///   return Future.wait(paragraphs.map(
+  ///     (Paragraph paragraph) => paragraph.layoutAsync(constraints),
+  ///   ));
+  /// }
+  /// ```
+  Future<void> layoutAsync(ParagraphConstraints constraints) {
+    _checkLayoutNotPending();
+    final Future<void> layout = _futurize((_Callback<void> callback) {
+      return _layoutAsync(constraints.width, callback);
+    });
+    _layoutPending = true;
+    return layout.whenComplete(() {
+      _layoutPending = false;
+    }).then((_) {
+      assert(() {
+        _needsLayout = false;
+        return true;
+      }());
+    });
+  }
+  @Native<Handle Function(Pointer<Void>, Double, Handle)>(symbol: 'Paragraph::layoutAsync')
+  external String? _layoutAsync(double width, _Callback<void> callback);
+
   List<TextBox> _decodeTextBoxes(Float32List encoded) {
     final int count = encoded.length ~/ 5;
     final List<TextBox> boxes = <TextBox>[];
@@ -2784,6 +2866,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   ///
   /// See [BoxHeightStyle] and [BoxWidthStyle] for full descriptions of each option.
   List<TextBox> getBoxesForRange(int start, int end, {BoxHeightStyle boxHeightStyle = BoxHeightStyle.tight, BoxWidthStyle boxWidthStyle = BoxWidthStyle.tight}) {
+    _checkLayoutNotPending();
     return _decodeTextBoxes(_getBoxesForRange(start, end, boxHeightStyle.index, boxWidthStyle.index));
   }
 
@@ -2799,6 +2882,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   /// Coordinates of the [TextBox] are relative to the upper-left corner of the paragraph,
   /// where positive y values indicate down.
   List<TextBox> getBoxesForPlaceholders() {
+    _checkLayoutNotPending();
     return _decodeTextBoxes(_getBoxesForPlaceholders());
   }
 
@@ -2807,6 +2891,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
 
   /// Returns the text position closest to the given offset.
   TextPosition getPositionForOffset(Offset offset) {
+    _checkLayoutNotPending();
     final List<int> encoded = _getPositionForOffset(offset.dx, offset.dy);
     return TextPosition(offset: encoded[0], affinity: TextAffinity.values[encoded[1]]);
   }
@@ -2827,6 +2912,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   /// of the `string = 'Hello word'` will return range (0, 5) because the position
   /// points to the character 'o' instead of the space.
   TextRange getWordBoundary(TextPosition position) {
+    _checkLayoutNotPending();
     final int characterPosition;
     switch (position.affinity) {
       case TextAffinity.upstream:
@@ -2852,6 +2938,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   /// This can potentially be expensive, since it needs to compute the line
   /// metrics, so use it sparingly.
   TextRange getLineBoundary(TextPosition position) {
+    _checkLayoutNotPending();
     final List<int> boundary = _getLineBoundary(position.offset);
     final TextRange line = TextRange(start: boundary[0], end: boundary[1]);
 
@@ -2889,6 +2976,7 @@ class Paragraph extends NativeFieldWrapperClass1 {
   /// This can potentially return a large amount of data, so it is not recommended
   /// to repeatedly call this. Instead, cache the results.
   List<LineMetrics> computeLineMetrics() {
+    _checkLayoutNotPending();
     final Float64List encoded = _computeLineMetrics();
     final int count = encoded.length ~/ 9;
     int position = 0;
@@ -3200,7 +3288,7 @@ class ParagraphBuilder extends NativeFieldWrapperClass1 {
     _placeholderScales.add(scale);
   }
 
-  @Native<Void Function(Pointer<Void>, Double, Double, Uint32, Double, Uint32)>(symbol: 'ParagraphBuilder::addPlaceholder')
+  @Native<Void Function(Pointer<Void>, Double, Double, Uint32, Double, Uint32)>(symbol: 'ParagraphBuilder::addPlaceholder', isLeaf: true)
   external void _addPlaceholder(double width, double height, int alignment, double baselineOffset, int baseline);
 
   /// Applies the given paragraph style and returns a [Paragraph] containing the
@@ -50,6 +50,13 @@ SkFontStyleSet* AssetManagerFontProvider::MatchFamily(
   return font_style_set.release();
 }
 
+// |FontAssetProvider|
+void AssetManagerFontProvider::ReleaseUnusedTypefaces() {
+  for (const auto& family : registered_families_) {
+    family.second->releaseUnusedTypefaces();
+  }
+}
+
 void AssetManagerFontProvider::RegisterAsset(const std::string& family_name,
                                              const std::string& asset) {
   std::string canonical_name = CanonicalFamilyName(family_name);
@@ -78,6 +85,14 @@ void AssetManagerFontStyleSet::registerAsset(const std::string& asset) {
   assets_.emplace_back(asset);
 }
 
+void AssetManagerFontStyleSet::releaseUnusedTypefaces() {
+  for (TypefaceAsset& asset : assets_) {
+    if (asset.typeface && asset.typeface->unique()) {
+      asset.typeface.reset();
+    }
+  }
+}
+
 int AssetManagerFontStyleSet::count() {
   return assets_.size();
 }
@@ -87,9 +102,19 @@ void AssetManagerFontStyleSet::getStyle(int index,
                                         SkString* name) {
   FML_DCHECK(index < static_cast<int>(assets_.size()));
   if (style) {
-    sk_sp<SkTypeface> typeface(createTypeface(index));
-    if (typeface) {
-      *style = typeface->fontStyle();
+    // Matching a style reads the styles of all faces of the family. Faces
+    // that aren't created are only loaded to read their style once, and
+    // aren't kept loaded.
+    TypefaceAsset& asset = assets_[index];
+    if (!asset.style.has_value()) {
+      sk_sp<SkTypeface> typeface =
+          asset.typeface ? asset.typeface : loadTypeface(asset);
+      if (typeface) {
+        asset.style = typeface->fontStyle();
+      }
+    }
+    if (asset.style.has_value()) {
+      *style = asset.style.value();
     }
   }
   if (name) {
@@ -105,30 +130,39 @@ SkTypeface* AssetManagerFontStyleSet::createTypeface(int i) {
 
   TypefaceAsset& asset = assets_[index];
   if (!asset.typeface) {
-    std::unique_ptr<fml::Mapping> asset_mapping =
-        asset_manager_->GetAsMapping(asset.asset);
-    if (asset_mapping == nullptr) {
-      return nullptr;
-    }
-
-    fml::Mapping* asset_mapping_ptr = asset_mapping.release();
-    sk_sp<SkData> asset_data = SkData::MakeWithProc(
-        asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
-        MappingReleaseProc, asset_mapping_ptr);
-    std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
-
-    // Ownership of the stream is transferred.
-    asset.typeface = SkTypeface::MakeFromStream(std::move(stream));
+    asset.typeface = loadTypeface(asset);
     if (!asset.typeface) {
-      FML_DLOG(ERROR) << "Unable to load font asset for family: "
-                      << family_name_;
       return nullptr;
     }
+    asset.style = asset.typeface->fontStyle();
   }
 
   return SkRef(asset.typeface.get());
 }
 
+sk_sp<SkTypeface> AssetManagerFontStyleSet::loadTypeface(
+    const TypefaceAsset& asset) const {
+  std::unique_ptr<fml::Mapping> asset_mapping =
+      asset_manager_->GetAsMapping(asset.asset);
+  if (asset_mapping == nullptr) {
+    return nullptr;
+  }
+
+  fml::Mapping* asset_mapping_ptr = asset_mapping.release();
+  sk_sp<SkData> asset_data = SkData::MakeWithProc(
+      asset_mapping_ptr->GetMapping(), asset_mapping_ptr->GetSize(),
+      MappingReleaseProc, asset_mapping_ptr);
+  std::unique_ptr<SkMemoryStream> stream = SkMemoryStream::Make(asset_data);
+
+  // Ownership of the stream is transferred.
+  sk_sp<SkTypeface> typeface = SkTypeface::MakeFromStream(std::move(stream));
+  if (!typeface) {
+    FML_DLOG(ERROR) << "Unable to load font asset for family: "
+                    << family_name_;
+  }
+  return typeface;
+}
+
 SkTypeface* AssetManagerFontStyleSet::matchStyle(const SkFontStyle& pattern) {
   return matchStyleCSS3(pattern);
 }
@@ -6,6 +6,7 @@
 #define FLUTTER_LIB_UI_TEXT_ASSET_MANAGER_FONT_PROVIDER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +28,9 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
 
   void registerAsset(const std::string& asset);
 
+  // Drops the typefaces that nothing but this set refers to.
+  void releaseUnusedTypefaces();
+
   // |SkFontStyleSet|
   int count() override;
 
@@ -51,10 +55,18 @@ class AssetManagerFontStyleSet : public SkFontStyleSet {
     ~TypefaceAsset();
 
     std::string asset;
+    // Loaded when the typeface is first created, and dropped again by
+    // |releaseUnusedTypefaces|.
     sk_sp<SkTypeface> typeface;
+    // The style of the typeface, which stays known after it is dropped.
+    std::optional<SkFontStyle> style;
   };
   std::vector<TypefaceAsset> assets_;
 
+  // Creates the typeface of the asset from a mapping of the asset, which is
+  // only paged in as the typeface is read.
+  sk_sp<SkTypeface> loadTypeface(const TypefaceAsset& asset) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AssetManagerFontStyleSet);
 };
 
@@ -76,6 +88,9 @@ class AssetManagerFontProvider : public txt::FontAssetProvider {
   // |FontAssetProvider|
   SkFontStyleSet* MatchFamily(const std::string& family_name) override;
 
+  // |FontAssetProvider|
+  void ReleaseUnusedTypefaces() override;
+
  private:
   std::shared_ptr<AssetManager> asset_manager_;
   std::unordered_map<std::string, sk_sp<AssetManagerFontStyleSet>>
@@ -116,8 +116,23 @@ void FontCollection::RegisterFonts(
     }
   }
 
-  collection_->SetAssetFontManager(
-      sk_make_sp<txt::AssetFontManager>(std::move(font_provider)));
+  asset_font_manager_ =
+      sk_make_sp<txt::AssetFontManager>(std::move(font_provider));
+  collection_->SetAssetFontManager(asset_font_manager_);
+}
+
+void FontCollection::ReleaseUnusedFonts() {
+  if (!asset_font_manager_) {
+    return;
+  }
+  // Paragraphs may be laid out on worker threads, which load typefaces and
+  // use the caches that are cleared here.
+  std::scoped_lock lock(*collection_->GetLayoutMutex());
+  // Typefaces are referenced by the font caches of Skia as long as they are
+  // cached, so the caches are emptied first.
+  collection_->ClearFontFamilyCache();
+  SkGraphics::PurgeFontCache();
+  asset_font_manager_->ReleaseUnusedTypefaces();
 }
 
 void FontCollection::RegisterTestFonts() {
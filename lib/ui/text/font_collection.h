@@ -30,6 +30,10 @@ class FontCollection {
 
   void RegisterTestFonts();
 
+  // Drops the font data of asset fonts that are not in use. Called when the
+  // system is low on memory.
+  void ReleaseUnusedFonts();
+
   static void LoadFontFromList(Dart_Handle font_data_handle,
                                Dart_Handle callback,
                                const std::string& family_name);
@@ -37,6 +41,7 @@ class FontCollection {
  private:
   std::shared_ptr<txt::FontCollection> collection_;
   sk_sp<txt::DynamicFontManager> dynamic_font_manager_;
+  sk_sp<txt::AssetFontManager> asset_font_manager_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(FontCollection);
 };
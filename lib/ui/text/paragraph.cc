@@ -7,11 +7,14 @@
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/lib/ui/ui_dart_state.h"
 #include "third_party/tonic/converter/dart_converter.h"
 #include "third_party/tonic/dart_args.h"
 #include "third_party/tonic/dart_binding_macros.h"
 #include "third_party/tonic/dart_library_natives.h"
+#include "third_party/tonic/dart_persistent_value.h"
 
 namespace flutter {
 
@@ -58,6 +61,49 @@ void Paragraph::layout(double width) {
   m_paragraph->Layout(width);
 }
 
+Dart_Handle Paragraph::layoutAsync(double width, Dart_Handle callback_handle) {
+  if (!Dart_IsClosure(callback_handle)) {
+    return tonic::ToDart("Callback must be a function");
+  }
+  if (!m_paragraph) {
+    return tonic::ToDart("Paragraph is disposed or already being laid out");
+  }
+
+  auto* dart_state = UIDartState::Current();
+  auto ui_task_runner = dart_state->GetTaskRunners().GetUITaskRunner();
+  // The callback is owned by the tasks, and released along with them if they
+  // are dropped without running.
+  auto callback =
+      std::make_unique<tonic::DartPersistentValue>(dart_state, callback_handle);
+
+  // The paragraph is handed to the worker for the duration of the layout and
+  // handed back on the UI thread, so it is never used by both at once.
+  auto ui_task = fml::MakeCopyable(
+      [paragraph = fml::Ref(this), callback = std::move(callback)](
+          std::unique_ptr<txt::Paragraph> txt_paragraph) mutable {
+        if (!paragraph->m_disposed) {
+          paragraph->m_paragraph = std::move(txt_paragraph);
+        }
+        auto dart_state = callback->dart_state().lock();
+        if (!dart_state) {
+          return;
+        }
+        tonic::DartState::Scope scope(dart_state);
+        tonic::DartInvoke(callback->Get(), {Dart_TypeVoid()});
+      });
+
+  dart_state->GetConcurrentTaskRunner()->PostTask(fml::MakeCopyable(
+      [txt_paragraph = std::move(m_paragraph), width,
+       ui_task_runner = std::move(ui_task_runner), ui_task]() mutable {
+        txt_paragraph->Layout(width);
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [txt_paragraph = std::move(txt_paragraph), ui_task]() mutable {
+              ui_task(std::move(txt_paragraph));
+            }));
+      }));
+  return Dart_Null();
+}
+
 void Paragraph::paint(Canvas* canvas, double x, double y) {
   if (!m_paragraph || !canvas) {
     // disposed.
@@ -166,6 +212,7 @@ tonic::Float64List Paragraph::computeLineMetrics() {
 }
 
 void Paragraph::dispose() {
+  m_disposed = true;
   m_paragraph.reset();
   ClearDartWrapper();
 }
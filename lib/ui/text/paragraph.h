@@ -37,6 +37,7 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   bool didExceedMaxLines();
 
   void layout(double width);
+  Dart_Handle layoutAsync(double width, Dart_Handle callback_handle);
   void paint(Canvas* canvas, double x, double y);
 
   tonic::Float32List getRectsForRange(unsigned start,
@@ -52,7 +53,10 @@ class Paragraph : public RefCountedDartWrappable<Paragraph> {
   void dispose();
 
  private:
+  // Null after the paragraph has been disposed and while it is being laid out
+  // by |layoutAsync| on a worker thread.
   std::unique_ptr<txt::Paragraph> m_paragraph;
+  bool m_disposed = false;
 
   explicit Paragraph(std::unique_ptr<txt::Paragraph> paragraph);
 };
@@ -39,7 +39,8 @@ UIDartState::Context::Context(
     std::string advisory_script_entrypoint,
     std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-    bool enable_impeller)
+    bool enable_impeller,
+    bool enable_pipelined_snapshots)
     : task_runners(task_runners),
       snapshot_delegate(std::move(snapshot_delegate)),
       io_manager(std::move(io_manager)),
@@ -50,7 +51,8 @@ UIDartState::Context::Context(
       advisory_script_entrypoint(std::move(advisory_script_entrypoint)),
       volatile_path_tracker(std::move(volatile_path_tracker)),
       concurrent_task_runner(std::move(concurrent_task_runner)),
-      enable_impeller(enable_impeller) {}
+      enable_impeller(enable_impeller),
+      enable_pipelined_snapshots(enable_pipelined_snapshots) {}
 
 UIDartState::UIDartState(
     TaskObserverAdd add_callback,
@@ -84,6 +86,10 @@ bool UIDartState::IsImpellerEnabled() const {
   return context_.enable_impeller;
 }
 
+bool UIDartState::ArePipelinedSnapshotsEnabled() const {
+  return context_.enable_pipelined_snapshots;
+}
+
 void UIDartState::DidSetIsolate() {
   main_port_ = Dart_GetMainPortId();
   std::ostringstream debug_name;
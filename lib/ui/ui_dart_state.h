@@ -55,7 +55,8 @@ class UIDartState : public tonic::DartState {
             std::string advisory_script_entrypoint,
             std::shared_ptr<VolatilePathTracker> volatile_path_tracker,
             std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
-            bool enable_impeller);
+            bool enable_impeller,
+            bool enable_pipelined_snapshots);
 
     /// The task runners used by the shell hosting this runtime controller. This
     /// may be used by the isolate to scheduled asynchronous texture uploads or
@@ -100,6 +101,10 @@ class UIDartState : public tonic::DartState {
 
     /// Whether Impeller is enabled or not.
     bool enable_impeller = false;
+
+    /// Whether asynchronous snapshots are left on the GPU, see
+    /// |Settings::enable_pipelined_snapshots|.
+    bool enable_pipelined_snapshots = false;
   };
 
   Dart_Port main_port() const { return main_port_; }
@@ -175,6 +180,8 @@ class UIDartState : public tonic::DartState {
   /// Whether Impeller is enabled for this application.
   bool IsImpellerEnabled() const;
 
+  bool ArePipelinedSnapshotsEnabled() const;
+
  protected:
   UIDartState(TaskObserverAdd add_callback,
               TaskObserverRemove remove_callback,
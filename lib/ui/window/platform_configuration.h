@@ -159,6 +159,22 @@ class PlatformConfigurationClient {
   ///
   virtual void SetNeedsReportTimings(bool value) = 0;
 
+  //--------------------------------------------------------------------------
+  /// @brief      Delivers the platform messages on the channel to the Dart
+  ///             port, without posting them to the UI task runner, rather
+  ///             than to the root isolate.
+  ///
+  ///             This option is engine counterpart of the
+  ///             `PlatformDispatcher.setChannelPort` in
+  ///             `platform_dispatcher.dart`.
+  ///
+  /// @param[in]  channel  The name of the channel.
+  /// @param[in]  port     The port to deliver the messages to, or
+  ///                      `ILLEGAL_PORT` to deliver them to the root isolate
+  ///                      again.
+  ///
+  virtual void SetChannelPort(const std::string& channel, int64_t port) = 0;
+
   //--------------------------------------------------------------------------
   /// @brief      The embedder can specify data that the isolate can request
   ///             synchronously on launch. This accessor fetches that data.
@@ -491,6 +507,8 @@ class PlatformConfigurationNativeApi {
 
   static void SetNeedsReportTimings(bool value);
 
+  static void SetChannelPort(const std::string& name, int64_t port);
+
   static Dart_Handle GetPersistentIsolateData();
 
   static Dart_Handle ComputePlatformResolvedLocale(
@@ -11,10 +11,12 @@
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/lib/ui/painting/vertices.h"
+#include "flutter/lib/ui/window/platform_message.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/testing.h"
+#include "third_party/tonic/typed_data/dart_byte_data.h"
 
 namespace flutter {
 namespace testing {
@@ -300,5 +302,61 @@ TEST_F(ShellTest, PlatformConfigurationSetDartPerformanceMode) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, PlatformConfigurationDispatchesLargeMessagesWithoutCopying) {
+  auto message_latch = std::make_shared<fml::AutoResetWaitableEvent>();
+  const size_t size = tonic::DartByteData::kExternalSizeThreshold * 2;
+  uint8_t* data = static_cast<uint8_t*>(malloc(size));
+  memset(data, 0xAB, size);
+
+  auto send_message = [data, size](Dart_NativeArguments args) {
+    auto message = std::make_unique<PlatformMessage>(
+        "test", fml::MallocMapping(data, size), nullptr);
+    UIDartState::Current()->platform_configuration()->DispatchPlatformMessage(
+        std::move(message));
+  };
+  auto validate_message = [message_latch, data,
+                           size](Dart_NativeArguments args) {
+    Dart_Handle handle = Dart_GetNativeArgument(args, 0);
+    EXPECT_EQ(Dart_GetTypeOfExternalTypedData(handle),
+              Dart_TypedData_kByteData);
+    Dart_TypedData_Type type;
+    void* message_data = nullptr;
+    intptr_t message_size = 0;
+    ASSERT_FALSE(Dart_IsError(Dart_TypedDataAcquireData(
+        handle, &type, &message_data, &message_size)));
+    EXPECT_EQ(message_data, data);
+    EXPECT_EQ(static_cast<size_t>(message_size), size);
+    Dart_TypedDataReleaseData(handle);
+    message_latch->Signal();
+  };
+  AddNativeCallback("SendLargePlatformMessage",
+                    CREATE_NATIVE_ENTRY(send_message));
+  AddNativeCallback("ValidatePlatformMessage",
+                    CREATE_NATIVE_ENTRY(validate_message));
+
+  Settings settings = CreateSettingsForFixture();
+
+  TaskRunners task_runners("test",                  // label
+                           GetCurrentTaskRunner(),  // platform
+                           CreateNewThread(),       // raster
+                           CreateNewThread(),       // ui
+                           CreateNewThread()        // io
+  );
+
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(shell->IsSetup());
+  auto run_configuration = RunConfiguration::InferFromSettings(settings);
+  run_configuration.SetEntrypoint(
+      "receivesLargePlatformMessagesWithoutCopying");
+
+  shell->RunEngine(std::move(run_configuration), [&](auto result) {
+    ASSERT_EQ(result, Engine::RunStatus::Success);
+  });
+
+  message_latch->Wait();
+  DestroyShell(std::move(shell), task_runners);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -85,7 +85,9 @@ bool operator==(const ViewportMetrics& a, const ViewportMetrics& b) {
          a.physical_display_features_bounds ==
              b.physical_display_features_bounds &&
          a.physical_display_features_type == b.physical_display_features_type &&
-         a.physical_display_features_state == b.physical_display_features_state;
+         a.physical_display_features_state ==
+             b.physical_display_features_state &&
+         a.display_id == b.display_id;
 }
 
 std::ostream& operator<<(std::ostream& os, const ViewportMetrics& a) {
@@ -102,6 +104,9 @@ std::ostream& operator<<(std::ostream& os, const ViewportMetrics& a) {
      << a.physical_system_gesture_inset_bottom << "B "
      << a.physical_system_gesture_inset_left << "L] "
      << "Display Features: " << a.physical_display_features_type.size();
+  if (a.display_id.has_value()) {
+    os << " Display: " << a.display_id.value();
+  }
   return os;
 }
 
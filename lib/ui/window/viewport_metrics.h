@@ -5,6 +5,8 @@
 #ifndef FLUTTER_LIB_UI_WINDOW_VIEWPORT_METRICS_H_
 #define FLUTTER_LIB_UI_WINDOW_VIEWPORT_METRICS_H_
 
+#include <cstdint>
+#include <optional>
 #include <ostream>
 #include <vector>
 
@@ -55,6 +57,9 @@ struct ViewportMetrics {
   std::vector<double> physical_display_features_bounds;
   std::vector<int> physical_display_features_type;
   std::vector<int> physical_display_features_state;
+  // The display the view is presented on, whose refresh rate frames are
+  // scheduled at, see |DisplayManager::SetViewDisplayId|. Unknown if empty.
+  std::optional<uint64_t> display_id;
 };
 
 bool operator==(const ViewportMetrics& a, const ViewportMetrics& b);
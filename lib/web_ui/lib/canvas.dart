@@ -97,6 +97,8 @@ abstract class Canvas {
   void drawParagraph(Paragraph paragraph, Offset offset);
   void drawPoints(PointMode pointMode, List<Offset> points, Paint paint);
   void drawRawPoints(PointMode pointMode, Float32List points, Paint paint);
+  void drawRawRects(Float32List rects, Paint paint);
+  void drawRawCircles(Float32List circles, Paint paint);
 
   void drawVertices(Vertices vertices, BlendMode blendMode, Paint paint);
   void drawAtlas(
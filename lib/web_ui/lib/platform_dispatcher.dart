@@ -65,6 +65,8 @@ abstract class PlatformDispatcher {
 
   void registerBackgroundIsolate(RootIsolateToken token);
 
+  void setChannelPort(String name, Object? port);
+
   PlatformMessageCallback? get onPlatformMessage;
   set onPlatformMessage(PlatformMessageCallback? callback);
 
@@ -158,6 +160,7 @@ enum _FrameTimingInfo {
   layerCacheBytes,
   pictureCacheCount,
   pictureCacheBytes,
+  discardedFrameCount,
   frameNumber,
 }
 
@@ -173,6 +176,7 @@ class FrameTiming {
     int layerCacheBytes = 0,
     int pictureCacheCount = 0,
     int pictureCacheBytes = 0,
+    int discardedFrameCount = 0,
     int frameNumber = 1,
   }) {
     return FrameTiming._(<int>[
@@ -186,6 +190,7 @@ class FrameTiming {
       layerCacheBytes,
       pictureCacheCount,
       pictureCacheBytes,
+      discardedFrameCount,
       frameNumber,
     ]);
   }
@@ -224,6 +229,8 @@ class FrameTiming {
 
   double get pictureCacheMegabytes => pictureCacheBytes / 1024.0 / 1024.0;
 
+  int get discardedFrameCount => _rawInfo(_FrameTimingInfo.discardedFrameCount);
+
   int get frameNumber => _data.last;
 
   final List<int> _data;  // some elements in microseconds, some in bytes, some are counts
@@ -16,6 +16,7 @@ import '../window.dart';
 import 'canvas.dart';
 import 'embedded_views_diff.dart';
 import 'path.dart';
+import 'picture.dart';
 import 'picture_recorder.dart';
 import 'renderer.dart';
 import 'surface.dart';
@@ -425,17 +426,20 @@ class HtmlViewEmbedder {
       if (_overlays[viewId] != null) {
         final SurfaceFrame frame = _overlays[viewId]!.acquireFrame(_frameSize);
         final CkCanvas canvas = frame.skiaCanvas;
-        canvas.drawPicture(
-          _context.pictureRecorders[pictureRecorderIndex].endRecording(),
-        );
+        final CkPicture picture =
+            _context.pictureRecorders[pictureRecorderIndex].endRecording();
+        canvas.drawPicture(picture);
         pictureRecorderIndex++;
         frame.submit();
+        // The overlay pictures are recorded anew each frame, so delete them
+        // right away rather than leaving them to the garbage collector.
+        picture.dispose();
       }
     }
     for (final CkPictureRecorder recorder
         in _context.pictureRecordersCreatedDuringPreroll) {
       if (recorder.isRecording) {
-        recorder.endRecording();
+        recorder.endRecording().dispose();
       }
     }
     // Reset the context.
@@ -690,7 +694,7 @@ class HtmlViewEmbedder {
     assert(!_overlays.containsKey(viewId));
 
     // Try reusing a cached overlay created for another platform view.
-    final Surface overlay = SurfaceFactory.instance.getSurface()!;
+    final Surface overlay = SurfaceFactory.instance.getSurface(_frameSize)!;
     overlay.createOrUpdateSurface(_frameSize);
     _overlays[viewId] = overlay;
   }
@@ -139,6 +139,16 @@ class Surface {
   ui.Size? _currentSurfaceSize;
   double _currentDevicePixelRatio = -1;
 
+  /// Whether a frame of the given [size] can be acquired from this surface
+  /// without creating a new, larger, canvas.
+  bool canFitWithoutResizing(ui.Size size) {
+    final ui.Size? canvasSize = _currentCanvasPhysicalSize;
+    return !_forceNewContext &&
+        canvasSize != null &&
+        size.width <= canvasSize.width &&
+        size.height <= canvasSize.height;
+  }
+
   /// This is only valid after the first frame or if [ensureSurface] has been
   /// called
   bool get usingSoftwareBackend => _glContext == null ||
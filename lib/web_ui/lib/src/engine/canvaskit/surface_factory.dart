@@ -4,6 +4,7 @@
 import 'dart:math' as math show max;
 
 import 'package:meta/meta.dart';
+import 'package:ui/ui.dart' as ui;
 
 import '../../engine.dart';
 
@@ -85,9 +86,21 @@ class SurfaceFactory {
 
   /// Gets an overlay surface from the cache or creates a new one if it wouldn't
   /// exceed the maximum. If there are no available surfaces, returns `null`.
-  Surface? getSurface() {
+  ///
+  /// If [size] is given, a cached surface whose canvas is already large enough
+  /// for frames of that size is preferred, since resizing the canvas of a
+  /// surface recreates its Skia surface.
+  Surface? getSurface([ui.Size? size]) {
     if (_cache.isNotEmpty) {
-      final Surface surface = _cache.removeLast();
+      int index = _cache.length - 1;
+      if (size != null) {
+        final int fittingIndex = _cache.lastIndexWhere(
+            (Surface surface) => surface.canFitWithoutResizing(size));
+        if (fittingIndex != -1) {
+          index = fittingIndex;
+        }
+      }
+      final Surface surface = _cache.removeAt(index);
       _liveSurfaces.add(surface);
       return surface;
     } else if (debugSurfaceCount < maximumSurfaces) {
@@ -807,6 +807,13 @@ class CkParagraph extends SkiaObject<SkParagraph> implements ui.Paragraph {
     markUsed();
   }
 
+  @override
+  Future<void> layoutAsync(ui.ParagraphConstraints constraints) {
+    // There are no worker threads to lay out on, so the layout is done now.
+    layout(constraints);
+    return Future<void>.value();
+  }
+
   @override
   ui.TextRange getLineBoundary(ui.TextPosition position) {
     final SkParagraph paragraph = _ensureInitialized(_lastLayoutConstraints!);
@@ -114,6 +114,11 @@ class SkwasmParagraph implements ui.Paragraph {
     throw UnimplementedError();
   }
 
+  @override
+  Future<void> layoutAsync(ui.ParagraphConstraints constraints) {
+    throw UnimplementedError();
+  }
+
   @override
   List<ui.TextBox> getBoxesForRange(int start, int end,
       {ui.BoxHeightStyle boxHeightStyle = ui.BoxHeightStyle.tight,
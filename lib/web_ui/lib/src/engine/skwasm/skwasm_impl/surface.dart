@@ -21,6 +21,11 @@ class Surface {
   void setSize(int width, int height) =>
     surfaceSetCanvasSize(_handle, width, height);
 
+  /// Renders [picture] on the worker thread that owns the canvas.
+  ///
+  /// This doesn't wait for the picture to be rendered. If the worker is still
+  /// busy with a previous picture, only the latest of the pictures submitted
+  /// in the meantime is rendered.
   void renderPicture(SkwasmPicture picture) =>
     surfaceRenderPicture(_handle, picture.handle);
 }
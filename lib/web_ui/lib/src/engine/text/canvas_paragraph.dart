@@ -121,6 +121,13 @@ class CanvasParagraph implements ui.Paragraph {
     _cachedDomElement = null;
   }
 
+  @override
+  Future<void> layoutAsync(ui.ParagraphConstraints constraints) {
+    // There are no worker threads to lay out on, so the layout is done now.
+    layout(constraints);
+    return Future<void>.value();
+  }
+
   // TODO(mdebbar): Returning true means we always require a bitmap canvas. Revisit
   // this decision once `CanvasParagraph` is fully implemented.
   /// Whether this paragraph is doing arbitrary paint operations that require
@@ -8,6 +8,7 @@
 #include <emscripten/html5_webgl.h>
 #include <emscripten/threading.h>
 #include <webgl/webgl1.h>
+#include <mutex>
 #include "export.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkColorSpace.h"
@@ -25,7 +26,7 @@ namespace {
 class Surface;
 void fDispose(Surface* surface);
 void fSetCanvasSize(Surface* surface, int width, int height);
-void fRenderPicture(Surface* surface, SkPicture* picture);
+void fRenderPendingPicture(Surface* surface);
 
 class Surface {
  public:
@@ -56,11 +57,22 @@ class Surface {
                                   nullptr, this, width, height);
   }
 
+  // The pictures are handed to the worker one at a time. If the worker is
+  // still busy with a frame when the next ones are submitted, only the latest
+  // of them is rendered, so that the main thread never queues up work behind a
+  // slow frame.
   void renderPicture(SkPicture* picture) {
-    picture->ref();
-    emscripten_dispatch_to_thread(_thread, EM_FUNC_SIG_VII,
-                                  reinterpret_cast<void*>(fRenderPicture),
-                                  nullptr, this, picture);
+    bool needsDispatch = false;
+    {
+      std::lock_guard<std::mutex> lock(_pendingPictureMutex);
+      needsDispatch = !_pendingPicture;
+      _pendingPicture = sk_ref_sp(picture);
+    }
+    if (needsDispatch) {
+      emscripten_dispatch_to_thread(
+          _thread, EM_FUNC_SIG_VI,
+          reinterpret_cast<void*>(fRenderPendingPicture), nullptr, this);
+    }
   }
 
  private:
@@ -133,6 +145,17 @@ class Surface {
         kRGBA_8888_SkColorType, SkColorSpace::MakeSRGB(), nullptr);
   }
 
+  void _renderPendingPicture() {
+    sk_sp<SkPicture> picture;
+    {
+      std::lock_guard<std::mutex> lock(_pendingPictureMutex);
+      picture = std::move(_pendingPicture);
+    }
+    if (picture) {
+      _renderPicture(picture.get());
+    }
+  }
+
   void _renderPicture(const SkPicture* picture) {
     if (!_surface) {
       printf("Can't render picture with no surface.\n");
@@ -158,9 +181,12 @@ class Surface {
 
   pthread_t _thread;
 
+  std::mutex _pendingPictureMutex;
+  sk_sp<SkPicture> _pendingPicture;
+
   friend void fDispose(Surface* surface);
   friend void fSetCanvasSize(Surface* surface, int width, int height);
-  friend void fRenderPicture(Surface* surface, SkPicture* picture);
+  friend void fRenderPendingPicture(Surface* surface);
 };
 
 void fDispose(Surface* surface) {
@@ -171,9 +197,8 @@ void fSetCanvasSize(Surface* surface, int width, int height) {
   surface->_setCanvasSize(width, height);
 }
 
-void fRenderPicture(Surface* surface, SkPicture* picture) {
-  surface->_renderPicture(picture);
-  picture->unref();
+void fRenderPendingPicture(Surface* surface) {
+  surface->_renderPendingPicture();
 }
 
 }  // namespace
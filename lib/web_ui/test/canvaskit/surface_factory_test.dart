@@ -45,6 +45,22 @@ void testMain() {
       expect(factory.debugSurfaceCount, equals(3));
     });
 
+    test('getSurface prefers cached surfaces that fit the frame', () {
+      final SurfaceFactory factory = SurfaceFactory(3);
+
+      final Surface large = factory.getSurface()!;
+      large.createOrUpdateSurface(const ui.Size(100, 100));
+      final Surface small = factory.getSurface()!;
+      small.createOrUpdateSurface(const ui.Size(10, 10));
+      factory.releaseSurfaces();
+
+      expect(large.canFitWithoutResizing(const ui.Size(50, 50)), isTrue);
+      expect(small.canFitWithoutResizing(const ui.Size(50, 50)), isFalse);
+      expect(factory.getSurface(const ui.Size(50, 50)), equals(large));
+      expect(factory.getSurface(const ui.Size(50, 50)), equals(small));
+      expect(factory.debugSurfaceCount, equals(3));
+    });
+
     test('releaseSurface', () {
       final SurfaceFactory factory = SurfaceFactory(3);
 
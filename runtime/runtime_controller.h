@@ -512,7 +512,7 @@ class RuntimeController : public PlatformConfigurationClient {
   /// @param[in]  snapshot_data    Dart snapshot instructions of the loading
   ///                              unit's shared library.
   ///
-  void LoadDartDeferredLibrary(
+  virtual void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
       std::unique_ptr<const fml::Mapping> snapshot_data,
       std::unique_ptr<const fml::Mapping> snapshot_instructions);
@@ -641,6 +641,9 @@ class RuntimeController : public PlatformConfigurationClient {
   // |PlatformConfigurationClient|
   void SetNeedsReportTimings(bool value) override;
 
+  // |PlatformConfigurationClient|
+  void SetChannelPort(const std::string& channel, int64_t port) override;
+
   // |PlatformConfigurationClient|
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
@@ -42,6 +42,20 @@ const std::string_view
         "_flutter.renderFrameWithRasterStats";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view
+    ServiceProtocol::kGetFramePhaseHistogramsExtensionName =
+        "_flutter.getFramePhaseHistograms";
+const std::string_view ServiceProtocol::kGetResidentCacheBytesExtensionName =
+    "_flutter.getResidentCacheBytes";
+const std::string_view ServiceProtocol::kGetGpuMemoryUsageExtensionName =
+    "_flutter.getGpuMemoryUsage";
+const std::string_view
+    ServiceProtocol::kGetLayerCanvasStatisticsExtensionName =
+        "_flutter.getLayerCanvasStatistics";
+const std::string_view ServiceProtocol::kGetLayerTimingsExtensionName =
+    "_flutter.getLayerTimings";
+const std::string_view ServiceProtocol::kDumpTraceRingBufferExtensionName =
+    "_flutter.dumpTraceRingBuffer";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -63,6 +77,12 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
+          kGetFramePhaseHistogramsExtensionName,
+          kGetResidentCacheBytesExtensionName,
+          kGetGpuMemoryUsageExtensionName,
+          kGetLayerCanvasStatisticsExtensionName,
+          kGetLayerTimingsExtensionName,
+          kDumpTraceRingBufferExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
@@ -31,6 +31,12 @@ class ServiceProtocol {
   static const std::string_view kEstimateRasterCacheMemoryExtensionName;
   static const std::string_view kRenderFrameWithRasterStatsExtensionName;
   static const std::string_view kReloadAssetFonts;
+  static const std::string_view kGetFramePhaseHistogramsExtensionName;
+  static const std::string_view kGetResidentCacheBytesExtensionName;
+  static const std::string_view kGetGpuMemoryUsageExtensionName;
+  static const std::string_view kGetLayerCanvasStatisticsExtensionName;
+  static const std::string_view kGetLayerTimingsExtensionName;
+  static const std::string_view kDumpTraceRingBufferExtensionName;
 
   class Handler {
    public:
@@ -4,7 +4,10 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <optional>
+
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -19,6 +22,12 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+void RecordReplacedFrames(LayerTreeItem& latest, const LayerTreeItem& stale) {
+  // The stale frame may have replaced earlier frames itself.
+  latest.frame_timings_recorder->RecordDiscardedFrames(
+      1 + stale.frame_timings_recorder->GetDiscardedFrameCount());
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -45,6 +54,10 @@ Animator::Animator(Delegate& delegate,
 
 Animator::~Animator() = default;
 
+void Animator::SetFramePacer(std::shared_ptr<FramePacer> frame_pacer) {
+  frame_pacer_ = std::move(frame_pacer);
+}
+
 void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
@@ -57,6 +70,10 @@ void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
       });
 }
 
+void Animator::SetRasterizeLatestFrameOnly(bool rasterize_latest_frame_only) {
+  rasterize_latest_frame_only_ = rasterize_latest_frame_only;
+}
+
 void Animator::BeginFrame(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
   TRACE_EVENT_ASYNC_END0("flutter", "Frame Request Pending",
@@ -65,6 +82,8 @@ void Animator::BeginFrame(
 
   frame_timings_recorder_ = std::move(frame_timings_recorder);
   frame_timings_recorder_->RecordBuildStart(fml::TimePoint::Now());
+  idle_scheduler_.RecordFrame(frame_timings_recorder_->GetVsyncStartTime(),
+                              frame_timings_recorder_->GetVsyncTargetTime());
 
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder_, "flutter",
                                 "Animator::BeginFrame");
@@ -82,7 +101,17 @@ void Animator::BeginFrame(
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animator::Render. Simply reuse that
     // instead of asking the pipeline for a fresh continuation.
-    producer_continuation_ = layer_tree_pipeline_->Produce();
+    //
+    // The pacer may allow fewer frames in flight than the pipeline holds.
+    const bool paced_out =
+        frame_pacer_ && layer_tree_pipeline_->GetInflightCount() >=
+                            static_cast<int>(frame_pacer_->GetPipelineDepth());
+    if (!paced_out) {
+      producer_continuation_ =
+          rasterize_latest_frame_only_
+              ? layer_tree_pipeline_->ProduceLatest(&RecordReplacedFrames)
+              : layer_tree_pipeline_->Produce();
+    }
 
     if (!producer_continuation_) {
       // If we still don't have valid continuation, the pipeline is currently
@@ -109,25 +138,43 @@ void Animator::BeginFrame(
     // VM when we are about to schedule a frame in the next vsync, the idea
     // being that if there have been three vsyncs with no frames it's a good
     // time to start doing GC work.
-    task_runners_.GetUITaskRunner()->PostDelayedTask(
-        [self = weak_factory_.GetWeakPtr()]() {
-          if (!self) {
-            return;
-          }
-          auto now = fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
-          // If there's a frame scheduled, bail.
-          // If there's no frame scheduled, but we're not yet past the last
-          // vsync deadline, bail.
-          if (!self->frame_scheduled_ && now > self->dart_frame_deadline_) {
-            TRACE_EVENT0("flutter", "BeginFrame idle callback");
-            self->delegate_.OnAnimatorNotifyIdle(
-                now + fml::TimeDelta::FromMilliseconds(100));
-          }
-        },
-        kNotifyIdleTaskWaitTime);
+    ScheduleLongIdleNotification(fml::TimePoint::Now() +
+                                 kNotifyIdleTaskWaitTime);
   }
 }
 
+void Animator::ScheduleLongIdleNotification(fml::TimePoint time) {
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+      [self = weak_factory_.GetWeakPtr(),
+       frame_request_number = frame_request_number_]() {
+        if (!self) {
+          return;
+        }
+        auto now = fml::TimeDelta::FromMicroseconds(Dart_TimelineGetMicros());
+        // If there's a frame scheduled or a frame began since, bail.
+        // If there's no frame scheduled, but we're not yet past the last
+        // vsync deadline, bail.
+        if (self->frame_scheduled_ ||
+            self->frame_request_number_ != frame_request_number ||
+            now <= self->dart_frame_deadline_) {
+          return;
+        }
+        // Hand the VM longer deadlines the longer it stays idle, so that it
+        // can fit in a full collection that compacts the heap.
+        std::optional<fml::TimeDelta> duration =
+            self->idle_scheduler_.NextLongIdleDuration();
+        if (!duration.has_value()) {
+          return;
+        }
+        TRACE_EVENT0("flutter", "BeginFrame idle callback");
+        self->delegate_.OnAnimatorNotifyIdle(now + duration.value());
+        self->ScheduleLongIdleNotification(fml::TimePoint::Now() +
+                                           duration.value());
+      },
+      fml::TaskPriority::kHousekeeping, time,
+      time + fml::kHousekeepingTaskMaxDelay);
+}
+
 void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
   has_rendered_ = true;
   last_layer_tree_size_ = layer_tree->frame_size();
@@ -168,6 +215,29 @@ void Animator::Render(std::shared_ptr<flutter::LayerTree> layer_tree) {
   delegate_.OnAnimatorDraw(layer_tree_pipeline_);
 }
 
+void Animator::BeginPacedFrame(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  const fml::TimeDelta delay =
+      frame_pacer_ ? frame_pacer_->GetBeginFrameDelay() : fml::TimeDelta();
+  if (delay <= fml::TimeDelta::Zero()) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+  // Building the frame later samples more recent input, and the frame is
+  // still expected to be rasterized before the next vsync.
+  const fml::TimePoint begin_time =
+      frame_timings_recorder->GetVsyncStartTime() + delay;
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+      fml::MakeCopyable([self = weak_factory_.GetWeakPtr(),
+                         frame_timings_recorder =
+                             std::move(frame_timings_recorder)]() mutable {
+        if (self) {
+          self->BeginFrame(std::move(frame_timings_recorder));
+        }
+      }),
+      fml::TaskPriority::kFrameCritical, begin_time);
+}
+
 const std::weak_ptr<VsyncWaiter> Animator::GetVsyncWaiter() const {
   std::weak_ptr<VsyncWaiter> weak = waiter_;
   return weak;
@@ -236,12 +306,18 @@ void Animator::AwaitVSync() {
           if (self->CanReuseLastLayerTree()) {
             self->DrawLastLayerTree(std::move(frame_timings_recorder));
           } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
+            self->BeginPacedFrame(std::move(frame_timings_recorder));
           }
         }
       });
   if (has_rendered_) {
-    delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
+    // The time until the next frame starts is idle. Frames that are rendered
+    // without beginning one leave only their target time to go by.
+    std::optional<fml::TimePoint> deadline =
+        idle_scheduler_.GetFrameIdleDeadline(fml::TimePoint::Now());
+    delegate_.OnAnimatorNotifyIdle(deadline.has_value()
+                                       ? deadline->ToEpochDelta()
+                                       : dart_frame_deadline_);
   }
 }
 
@@ -13,6 +13,8 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_pacer.h"
+#include "flutter/shell/common/idle_scheduler.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -81,9 +83,30 @@ class Animator final {
   // rendering.
   void EnqueueTraceFlowId(uint64_t trace_flow_id);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Limits the number of frames in flight and delays the
+  ///           beginning of frames after vsync as decided by the pacer, see
+  ///           |Settings::enable_adaptive_frame_pacing|.
+  ///
+  ///           Without a pacer, frames begin at vsync and as many frames are
+  ///           kept in flight as the pipeline allows.
+  void SetFramePacer(std::shared_ptr<FramePacer> frame_pacer);
+
+  //--------------------------------------------------------------------------
+  /// @brief    Whether a new frame replaces the frames that are still
+  ///           waiting to be rasterized, instead of waiting for them to be
+  ///           rasterized first, see
+  ///           |Settings::rasterize_latest_frame_only|.
+  void SetRasterizeLatestFrameOnly(bool rasterize_latest_frame_only);
+
  private:
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  // Begins the frame once the delay after vsync chosen by the
+  // |frame_pacer_| has passed.
+  void BeginPacedFrame(
+      std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   bool CanReuseLastLayerTree();
 
   void DrawLastLayerTree(
@@ -91,6 +114,11 @@ class Animator final {
 
   void AwaitVSync();
 
+  // Notifies the delegate of a long idle period at |time| if no frame has
+  // been scheduled by then, and of a longer one at the end of that period,
+  // as decided by the |idle_scheduler_|.
+  void ScheduleLongIdleNotification(fml::TimePoint time);
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
@@ -102,6 +130,7 @@ class Animator final {
   uint64_t frame_request_number_ = 1;
   fml::TimeDelta dart_frame_deadline_;
   std::shared_ptr<LayerTreePipeline> layer_tree_pipeline_;
+  std::shared_ptr<FramePacer> frame_pacer_;
   fml::Semaphore pending_frame_semaphore_;
   LayerTreePipeline::ProducerContinuation producer_continuation_;
   bool regenerate_layer_tree_ = false;
@@ -109,6 +138,8 @@ class Animator final {
   SkISize last_layer_tree_size_ = {0, 0};
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  bool rasterize_latest_frame_only_ = false;
+  IdleScheduler idle_scheduler_;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
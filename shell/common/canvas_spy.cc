@@ -4,15 +4,24 @@
 
 #include "flutter/shell/common/canvas_spy.h"
 
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
 namespace flutter {
 
-CanvasSpy::CanvasSpy(SkCanvas* target_canvas) {
-  SkISize canvas_size = target_canvas->getBaseLayerSize();
+CanvasSpy::CanvasSpy(SkCanvas* target_canvas)
+    : CanvasSpy(target_canvas, target_canvas->getBaseLayerSize()) {}
+
+CanvasSpy::CanvasSpy(SkCanvas* target_canvas, SkISize canvas_size) {
   n_way_canvas_ =
       std::make_unique<SkNWayCanvas>(canvas_size.width(), canvas_size.height());
   did_draw_canvas_ = std::make_unique<DidDrawCanvas>(canvas_size.width(),
                                                      canvas_size.height());
-  n_way_canvas_->addCanvas(target_canvas);
+  if (target_canvas) {
+    n_way_canvas_->addCanvas(target_canvas);
+  }
   n_way_canvas_->addCanvas(did_draw_canvas_.get());
   adapter_.set_canvas(n_way_canvas_.get());
 }
@@ -43,10 +52,89 @@ bool DidDrawCanvas::DidDrawIntoCanvas() {
   return did_draw_;
 }
 
+const char* CanvasOpToString(CanvasOp op) {
+  switch (op) {
+    case CanvasOp::kDrawPaint:
+      return "drawPaint";
+    case CanvasOp::kDrawBehind:
+      return "drawBehind";
+    case CanvasOp::kDrawPoints:
+      return "drawPoints";
+    case CanvasOp::kDrawRect:
+      return "drawRect";
+    case CanvasOp::kDrawRegion:
+      return "drawRegion";
+    case CanvasOp::kDrawOval:
+      return "drawOval";
+    case CanvasOp::kDrawArc:
+      return "drawArc";
+    case CanvasOp::kDrawRRect:
+      return "drawRRect";
+    case CanvasOp::kDrawDRRect:
+      return "drawDRRect";
+    case CanvasOp::kDrawPath:
+      return "drawPath";
+    case CanvasOp::kDrawImage:
+      return "drawImage";
+    case CanvasOp::kDrawImageRect:
+      return "drawImageRect";
+    case CanvasOp::kDrawImageLattice:
+      return "drawImageLattice";
+    case CanvasOp::kDrawAtlas:
+      return "drawAtlas";
+    case CanvasOp::kDrawEdgeAAImageSet:
+      return "drawEdgeAAImageSet";
+    case CanvasOp::kDrawTextBlob:
+      return "drawTextBlob";
+    case CanvasOp::kDrawPicture:
+      return "drawPicture";
+    case CanvasOp::kDrawDrawable:
+      return "drawDrawable";
+    case CanvasOp::kDrawVertices:
+      return "drawVertices";
+    case CanvasOp::kDrawPatch:
+      return "drawPatch";
+    case CanvasOp::kDrawShadow:
+      return "drawShadow";
+    case CanvasOp::kDrawAnnotation:
+      return "drawAnnotation";
+    case CanvasOp::kDrawEdgeAAQuad:
+      return "drawEdgeAAQuad";
+  }
+  FML_UNREACHABLE();
+}
+
+size_t CanvasStatistics::GetDrawCount() const {
+  size_t count = 0;
+  for (size_t op_count : op_counts) {
+    count += op_count;
+  }
+  return count;
+}
+
+const CanvasStatistics& CanvasSpy::GetStatistics() const {
+  return did_draw_canvas_->GetStatistics();
+}
+
+const CanvasStatistics& DidDrawCanvas::GetStatistics() const {
+  return statistics_;
+}
+
+void DidDrawCanvas::RecordDraw(CanvasOp op) {
+  statistics_.op_counts[static_cast<size_t>(op)]++;
+}
+
+void DidDrawCanvas::RecordImage(const SkImage* image) {
+  if (image) {
+    statistics_.image_bytes += image->imageInfo().computeMinByteSize();
+  }
+}
+
 void DidDrawCanvas::willSave() {}
 
 SkCanvas::SaveLayerStrategy DidDrawCanvas::getSaveLayerStrategy(
     const SaveLayerRec& rec) {
+  statistics_.save_layer_count++;
   return kNoLayer_SaveLayerStrategy;
 }
 
@@ -64,23 +152,34 @@ void DidDrawCanvas::didTranslate(SkScalar, SkScalar) {}
 
 void DidDrawCanvas::onClipRect(const SkRect& rect,
                                SkClipOp op,
-                               ClipEdgeStyle edgeStyle) {}
+                               ClipEdgeStyle edgeStyle) {
+  statistics_.rect_clip_count++;
+}
 
 void DidDrawCanvas::onClipRRect(const SkRRect& rrect,
                                 SkClipOp op,
-                                ClipEdgeStyle edgeStyle) {}
+                                ClipEdgeStyle edgeStyle) {
+  statistics_.rrect_clip_count++;
+}
 
 void DidDrawCanvas::onClipPath(const SkPath& path,
                                SkClipOp op,
-                               ClipEdgeStyle edgeStyle) {}
+                               ClipEdgeStyle edgeStyle) {
+  statistics_.path_clip_count++;
+  statistics_.clip_path_verb_count += path.countVerbs();
+}
 
-void DidDrawCanvas::onClipRegion(const SkRegion& deviceRgn, SkClipOp op) {}
+void DidDrawCanvas::onClipRegion(const SkRegion& deviceRgn, SkClipOp op) {
+  statistics_.path_clip_count++;
+}
 
 void DidDrawCanvas::onDrawPaint(const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawPaint);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawBehind(const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawBehind);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
@@ -88,18 +187,22 @@ void DidDrawCanvas::onDrawPoints(PointMode mode,
                                  size_t count,
                                  const SkPoint pts[],
                                  const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawPoints);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawRect);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawRegion);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawOval(const SkRect& rect, const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawOval);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
@@ -108,20 +211,25 @@ void DidDrawCanvas::onDrawArc(const SkRect& rect,
                               SkScalar sweepAngle,
                               bool useCenter,
                               const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawArc);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawRRect);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawDRRect(const SkRRect& outer,
                                  const SkRRect& inner,
                                  const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawDRRect);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawPath);
+  statistics_.path_verb_count += path.countVerbs();
   MarkDrawIfNonTransparentPaint(paint);
 }
 
@@ -130,6 +238,8 @@ void DidDrawCanvas::onDrawImage(const SkImage* image,
                                 SkScalar left,
                                 SkScalar top,
                                 const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawImage);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -138,6 +248,8 @@ void DidDrawCanvas::onDrawImageRect(const SkImage* image,
                                     const SkRect& dst,
                                     const SkPaint* paint,
                                     SrcRectConstraint constraint) {
+  RecordDraw(CanvasOp::kDrawImageRect);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -145,6 +257,8 @@ void DidDrawCanvas::onDrawImageLattice(const SkImage* image,
                                        const Lattice& lattice,
                                        const SkRect& dst,
                                        const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawImageLattice);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -156,6 +270,8 @@ void DidDrawCanvas::onDrawAtlas(const SkImage* image,
                                 SkBlendMode bmode,
                                 const SkRect* cull,
                                 const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawAtlas);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -165,6 +281,10 @@ void DidDrawCanvas::onDrawEdgeAAImageSet(const ImageSetEntry set[],
                                          const SkMatrix preViewMatrices[],
                                          const SkPaint* paint,
                                          SrcRectConstraint constraint) {
+  RecordDraw(CanvasOp::kDrawEdgeAAImageSet);
+  for (int i = 0; i < count; i++) {
+    RecordImage(set[i].fImage.get());
+  }
   did_draw_ = true;
 }
 #endif
@@ -174,6 +294,8 @@ void DidDrawCanvas::onDrawImage2(const SkImage* image,
                                  SkScalar top,
                                  const SkSamplingOptions&,
                                  const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawImage);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -183,6 +305,8 @@ void DidDrawCanvas::onDrawImageRect2(const SkImage* image,
                                      const SkSamplingOptions&,
                                      const SkPaint* paint,
                                      SrcRectConstraint constraint) {
+  RecordDraw(CanvasOp::kDrawImageRect);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -191,6 +315,8 @@ void DidDrawCanvas::onDrawImageLattice2(const SkImage* image,
                                         const SkRect& dst,
                                         SkFilterMode,
                                         const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawImageLattice);
+  RecordImage(image);
   did_draw_ = true;
 }
 
@@ -198,23 +324,32 @@ void DidDrawCanvas::onDrawTextBlob(const SkTextBlob* blob,
                                    SkScalar x,
                                    SkScalar y,
                                    const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawTextBlob);
+  SkTextBlob::Iter iter(*blob);
+  SkTextBlob::Iter::Run run;
+  while (iter.next(&run)) {
+    statistics_.text_run_count++;
+  }
   MarkDrawIfNonTransparentPaint(paint);
 }
 
 void DidDrawCanvas::onDrawPicture(const SkPicture* picture,
                                   const SkMatrix* matrix,
                                   const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawPicture);
   did_draw_ = true;
 }
 
 void DidDrawCanvas::onDrawDrawable(SkDrawable* drawable,
                                    const SkMatrix* matrix) {
+  RecordDraw(CanvasOp::kDrawDrawable);
   did_draw_ = true;
 }
 
 void DidDrawCanvas::onDrawVerticesObject(const SkVertices* vertices,
                                          SkBlendMode bmode,
                                          const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawVertices);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
@@ -223,6 +358,7 @@ void DidDrawCanvas::onDrawPatch(const SkPoint cubics[12],
                                 const SkPoint texCoords[4],
                                 SkBlendMode bmode,
                                 const SkPaint& paint) {
+  RecordDraw(CanvasOp::kDrawPatch);
   MarkDrawIfNonTransparentPaint(paint);
 }
 
@@ -235,17 +371,22 @@ void DidDrawCanvas::onDrawAtlas2(const SkImage* image,
                                  const SkSamplingOptions&,
                                  const SkRect* cull,
                                  const SkPaint* paint) {
+  RecordDraw(CanvasOp::kDrawAtlas);
+  RecordImage(image);
   did_draw_ = true;
 }
 
 void DidDrawCanvas::onDrawShadowRec(const SkPath& path,
                                     const SkDrawShadowRec& rec) {
+  RecordDraw(CanvasOp::kDrawShadow);
+  statistics_.path_verb_count += path.countVerbs();
   did_draw_ = true;
 }
 
 void DidDrawCanvas::onDrawAnnotation(const SkRect& rect,
                                      const char key[],
                                      SkData* data) {
+  RecordDraw(CanvasOp::kDrawAnnotation);
   did_draw_ = true;
 }
 
@@ -254,6 +395,7 @@ void DidDrawCanvas::onDrawEdgeAAQuad(const SkRect& rect,
                                      SkCanvas::QuadAAFlags aa,
                                      const SkColor4f& color,
                                      SkBlendMode mode) {
+  RecordDraw(CanvasOp::kDrawEdgeAAQuad);
   did_draw_ = true;
 }
 
@@ -264,6 +406,10 @@ void DidDrawCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry set[],
                                           const SkSamplingOptions&,
                                           const SkPaint* paint,
                                           SrcRectConstraint constraint) {
+  RecordDraw(CanvasOp::kDrawEdgeAAImageSet);
+  for (int i = 0; i < count; i++) {
+    RecordImage(set[i].fImage.get());
+  }
   did_draw_ = true;
 }
 
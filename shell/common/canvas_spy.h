@@ -3,6 +3,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 //
+#include <array>
+
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -17,16 +19,84 @@ namespace flutter {
 
 class DidDrawCanvas;
 
+//------------------------------------------------------------------------------
+/// The types of drawing operations counted by |CanvasStatistics|.
+enum class CanvasOp {
+  kDrawPaint,
+  kDrawBehind,
+  kDrawPoints,
+  kDrawRect,
+  kDrawRegion,
+  kDrawOval,
+  kDrawArc,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageLattice,
+  kDrawAtlas,
+  kDrawEdgeAAImageSet,
+  kDrawTextBlob,
+  kDrawPicture,
+  kDrawDrawable,
+  kDrawVertices,
+  kDrawPatch,
+  kDrawShadow,
+  kDrawAnnotation,
+  kDrawEdgeAAQuad,
+  kLast = kDrawEdgeAAQuad,
+};
+
+const char* CanvasOpToString(CanvasOp op);
+
+//------------------------------------------------------------------------------
+/// The drawing operations made on a spying canvas, and how expensive
+/// they are likely to be.
+struct CanvasStatistics {
+  static constexpr size_t kOpCount = static_cast<size_t>(CanvasOp::kLast) + 1;
+
+  /// The number of operations of each type, indexed by |CanvasOp|.
+  std::array<size_t, kOpCount> op_counts = {};
+  size_t save_layer_count = 0;
+  size_t rect_clip_count = 0;
+  size_t rrect_clip_count = 0;
+  /// Clips to paths and to regions.
+  size_t path_clip_count = 0;
+  /// The verbs of the paths clipped to, which the clips get more expensive
+  /// with.
+  size_t clip_path_verb_count = 0;
+  /// The verbs of the paths drawn, including the paths of shadows.
+  size_t path_verb_count = 0;
+  /// The bytes of the images drawn, counted again each time an image is
+  /// drawn.
+  size_t image_bytes = 0;
+  size_t text_run_count = 0;
+
+  /// The number of operations of all types.
+  size_t GetDrawCount() const;
+};
+
 //------------------------------------------------------------------------------
 /// Facilitates spying on drawing commands to an SkCanvas.
 ///
 /// This is used to determine whether anything was drawn into
 /// a canvas so it is possible to implement optimizations that
-/// are specific to empty canvases.
+/// are specific to empty canvases, and to collect statistics on
+/// the drawing commands to find the ones that are expensive.
 class CanvasSpy {
  public:
   explicit CanvasSpy(SkCanvas* target_canvas);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Spies on the operations made on a canvas of the given size,
+  ///             forwarding them to the target canvas if there is one.
+  ///
+  /// @param[in]  target_canvas  The canvas the operations are forwarded to,
+  ///                            or null to only collect statistics.
+  ///
+  CanvasSpy(SkCanvas* target_canvas, SkISize canvas_size);
+
   //----------------------------------------------------------------------------
   /// @brief      Returns true if any non transparent content has been drawn
   /// into
@@ -36,6 +106,10 @@ class CanvasSpy {
   ///             canvas).
   bool DidDrawIntoCanvas();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The operations made on the spying canvas so far.
+  const CanvasStatistics& GetStatistics() const;
+
   //----------------------------------------------------------------------------
   /// @brief      The returned canvas delegate all operations to the target
   /// canvas
@@ -60,9 +134,11 @@ class DidDrawCanvas final : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
   DidDrawCanvas(int width, int height);
   ~DidDrawCanvas() override;
   bool DidDrawIntoCanvas();
+  const CanvasStatistics& GetStatistics() const;
 
  private:
   bool did_draw_ = false;
+  CanvasStatistics statistics_;
 
   // |SkCanvasVirtualEnforcer<SkNoDrawCanvas>|
   void willSave() override;
@@ -253,6 +329,10 @@ class DidDrawCanvas final : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
 
   void MarkDrawIfNonTransparentPaint(const SkPaint& paint);
 
+  void RecordDraw(CanvasOp op);
+
+  void RecordImage(const SkImage* image);
+
   FML_DISALLOW_COPY_AND_ASSIGN(DidDrawCanvas);
 };
 
@@ -63,5 +63,37 @@ TEST(CanvasSpyTest, SpiedCanvasIsDrawing) {
 
   ASSERT_EQ(::memcmp(actual.addr(), expected.addr(), size), 0);
 }
+
+TEST(CanvasSpyTest, CollectsStatistics) {
+  CanvasSpy canvas_spy = CanvasSpy(nullptr, SkISize::Make(100, 100));
+  DlCanvas* spy = canvas_spy.GetSpyingCanvas();
+  DlPaint paint;
+
+  spy->SaveLayer(nullptr, &paint);
+  spy->ClipRect(SkRect::MakeWH(50, 50));
+  spy->ClipPath(SkPath().moveTo(0, 0).lineTo(40, 40).lineTo(0, 40).close());
+  spy->DrawRect(SkRect::MakeWH(10, 10), paint);
+  spy->DrawRect(SkRect::MakeXYWH(10, 10, 10, 10), paint);
+  spy->DrawPath(SkPath().moveTo(0, 0).lineTo(10, 10).lineTo(0, 10).close(),
+                paint);
+  spy->Restore();
+
+  const CanvasStatistics& statistics = canvas_spy.GetStatistics();
+  ASSERT_TRUE(canvas_spy.DidDrawIntoCanvas());
+  EXPECT_EQ(statistics.op_counts[static_cast<size_t>(CanvasOp::kDrawRect)],
+            2u);
+  EXPECT_EQ(statistics.op_counts[static_cast<size_t>(CanvasOp::kDrawPath)],
+            1u);
+  EXPECT_EQ(statistics.GetDrawCount(), 3u);
+  EXPECT_EQ(statistics.save_layer_count, 1u);
+  EXPECT_EQ(statistics.rect_clip_count, 1u);
+  EXPECT_EQ(statistics.path_clip_count, 1u);
+  EXPECT_EQ(statistics.clip_path_verb_count, 4u);
+  // Move, two lines and close.
+  EXPECT_EQ(statistics.path_verb_count, 4u);
+  EXPECT_EQ(statistics.image_bytes, 0u);
+  EXPECT_EQ(statistics.text_run_count, 0u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -103,6 +103,80 @@ BENCHMARK_F(DartNativeBenchmarks, MultipleDartToNativeMessages)
   }
 }
 
+BENCHMARK_F(DartNativeBenchmarks, ThousandDrawRectCalls)
+(benchmark::State& st) {
+  while (st.KeepRunning()) {
+    fml::AutoResetWaitableEvent latch;
+    st.PauseTiming();
+    ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+    AddNativeCallback("NotifyNative",
+                      CREATE_NATIVE_ENTRY(([&latch](Dart_NativeArguments args) {
+                        latch.Signal();
+                      })));
+
+    const auto settings = CreateSettingsForFixture();
+    DartVMRef vm_ref = DartVMRef::Create(settings);
+
+    ThreadHost thread_host("io.flutter.test.DartNativeBenchmarks.",
+                           ThreadHost::Type::Platform | ThreadHost::Type::IO |
+                               ThreadHost::Type::UI);
+    TaskRunners task_runners(
+        "test",
+        thread_host.platform_thread->GetTaskRunner(),  // platform
+        thread_host.platform_thread->GetTaskRunner(),  // raster
+        thread_host.ui_thread->GetTaskRunner(),        // ui
+        thread_host.io_thread->GetTaskRunner()         // io
+    );
+
+    {
+      st.ResumeTiming();
+      auto isolate = RunDartCodeInIsolate(vm_ref, settings, task_runners,
+                                          "thousandDrawRectCalls", {},
+                                          GetDefaultKernelFilePath());
+      ASSERT_TRUE(isolate);
+      ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+      latch.Wait();
+    }
+  }
+}
+
+BENCHMARK_F(DartNativeBenchmarks, ThousandRectsInOneDrawRawRectsCall)
+(benchmark::State& st) {
+  while (st.KeepRunning()) {
+    fml::AutoResetWaitableEvent latch;
+    st.PauseTiming();
+    ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+    AddNativeCallback("NotifyNative",
+                      CREATE_NATIVE_ENTRY(([&latch](Dart_NativeArguments args) {
+                        latch.Signal();
+                      })));
+
+    const auto settings = CreateSettingsForFixture();
+    DartVMRef vm_ref = DartVMRef::Create(settings);
+
+    ThreadHost thread_host("io.flutter.test.DartNativeBenchmarks.",
+                           ThreadHost::Type::Platform | ThreadHost::Type::IO |
+                               ThreadHost::Type::UI);
+    TaskRunners task_runners(
+        "test",
+        thread_host.platform_thread->GetTaskRunner(),  // platform
+        thread_host.platform_thread->GetTaskRunner(),  // raster
+        thread_host.ui_thread->GetTaskRunner(),        // ui
+        thread_host.io_thread->GetTaskRunner()         // io
+    );
+
+    {
+      st.ResumeTiming();
+      auto isolate = RunDartCodeInIsolate(
+          vm_ref, settings, task_runners, "thousandRectsInOneDrawRawRectsCall",
+          {}, GetDefaultKernelFilePath());
+      ASSERT_TRUE(isolate);
+      ASSERT_EQ(isolate->get()->GetPhase(), DartIsolate::Phase::Running);
+      latch.Wait();
+    }
+  }
+}
+
 }  // namespace flutter::testing
 
 // NOLINTEND(clang-analyzer-core.StackAddressEscape)
@@ -22,6 +22,26 @@ double DisplayManager::GetMainDisplayRefreshRate() const {
   }
 }
 
+double DisplayManager::GetViewDisplayRefreshRate() const {
+  std::scoped_lock lock(displays_mutex_);
+  if (displays_.empty()) {
+    return kUnknownDisplayRefreshRate;
+  }
+  if (view_display_id_.has_value()) {
+    for (const auto& display : displays_) {
+      if (display->GetDisplayId() == view_display_id_) {
+        return display->GetRefreshRate();
+      }
+    }
+  }
+  return displays_[0]->GetRefreshRate();
+}
+
+void DisplayManager::SetViewDisplayId(DisplayId display_id) {
+  std::scoped_lock lock(displays_mutex_);
+  view_display_id_ = display_id;
+}
+
 void DisplayManager::HandleDisplayUpdates(
     DisplayUpdateType update_type,
     std::vector<std::unique_ptr<Display>> displays) {
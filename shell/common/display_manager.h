@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_COMMON_DISPLAY_MANAGER_H_
 
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include "flutter/shell/common/display.h"
@@ -38,6 +39,16 @@ class DisplayManager {
   /// `kUnknownDisplayRefreshRate`.
   double GetMainDisplayRefreshRate() const;
 
+  /// Returns the refresh rate of the display the view is presented on, which
+  /// frames are scheduled at. Falls back to the refresh rate of the main
+  /// display if the display of the view isn't known.
+  double GetViewDisplayRefreshRate() const;
+
+  /// Sets the display the view is presented on, for example after the window
+  /// of the view moved to another display. Displays that haven't been
+  /// registered are ignored until they are.
+  void SetViewDisplayId(DisplayId display_id);
+
   /// Handles the display updates.
   void HandleDisplayUpdates(DisplayUpdateType update_type,
                             std::vector<std::unique_ptr<Display>> displays);
@@ -46,6 +57,7 @@ class DisplayManager {
   /// Guards `displays_` vector.
   mutable std::mutex displays_mutex_;
   std::vector<std::unique_ptr<Display>> displays_;
+  std::optional<DisplayId> view_display_id_;
 
   /// Checks that the provided display configuration is valid. Currently this
   /// ensures that all the displays have an id in the case there are multiple
@@ -0,0 +1,48 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/display_manager.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+static std::vector<std::unique_ptr<Display>> CreateDisplays() {
+  std::vector<std::unique_ptr<Display>> displays;
+  displays.push_back(std::make_unique<Display>(1, 60.0));
+  displays.push_back(std::make_unique<Display>(2, 120.0));
+  return displays;
+}
+
+TEST(DisplayManagerTest, ViewDisplayDefaultsToMainDisplay) {
+  DisplayManager display_manager;
+  EXPECT_EQ(display_manager.GetViewDisplayRefreshRate(),
+            kUnknownDisplayRefreshRate);
+
+  display_manager.HandleDisplayUpdates(DisplayUpdateType::kStartup,
+                                       CreateDisplays());
+  EXPECT_EQ(display_manager.GetMainDisplayRefreshRate(), 60.0);
+  EXPECT_EQ(display_manager.GetViewDisplayRefreshRate(), 60.0);
+}
+
+TEST(DisplayManagerTest, ViewDisplayFollowsTheView) {
+  DisplayManager display_manager;
+  // The display of the view may be known before the displays are.
+  display_manager.SetViewDisplayId(2);
+  display_manager.HandleDisplayUpdates(DisplayUpdateType::kStartup,
+                                       CreateDisplays());
+  EXPECT_EQ(display_manager.GetViewDisplayRefreshRate(), 120.0);
+  EXPECT_EQ(display_manager.GetMainDisplayRefreshRate(), 60.0);
+
+  display_manager.SetViewDisplayId(1);
+  EXPECT_EQ(display_manager.GetViewDisplayRefreshRate(), 60.0);
+
+  // Unknown displays fall back to the main display.
+  display_manager.SetViewDisplayId(3);
+  EXPECT_EQ(display_manager.GetViewDisplayRefreshRate(), 60.0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -102,6 +102,7 @@ Engine::Engine(Delegate& delegate,
           std::move(volatile_path_tracker),        // volatile path tracker
           vm.GetConcurrentWorkerTaskRunner(),      // concurrent task runner
           settings_.enable_impeller,               // enable impeller
+          settings_.enable_pipelined_snapshots,    // pipelined snapshots
       });
 }
 
@@ -495,6 +496,10 @@ void Engine::SetNeedsReportTimings(bool needs_reporting) {
   delegate_.SetNeedsReportTimings(needs_reporting);
 }
 
+void Engine::SetChannelPort(const std::string& channel, int64_t port) {
+  delegate_.SetChannelPort(channel, port);
+}
+
 FontCollection& Engine::GetFontCollection() {
   return *font_collection_;
 }
@@ -548,7 +553,24 @@ const std::vector<std::string>& Engine::GetLastEntrypointArgs() const {
 
 // |RuntimeDelegate|
 void Engine::RequestDartDeferredLibrary(intptr_t loading_unit_id) {
-  return delegate_.RequestDartDeferredLibrary(loading_unit_id);
+  auto prefetched = prefetched_loading_units_.find(loading_unit_id);
+  if (prefetched == prefetched_loading_units_.end()) {
+    delegate_.RequestDartDeferredLibrary(loading_unit_id);
+    return;
+  }
+  // The VM is in the middle of requesting the loading unit, so complete the
+  // load in a separate task.
+  task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = GetWeakPtr(), loading_unit_id,
+       loading_unit = std::move(prefetched->second)]() mutable {
+        if (engine) {
+          TRACE_EVENT0("flutter", "Engine::LoadPrefetchedDartDeferredLibrary");
+          engine->LoadDartDeferredLibrary(
+              loading_unit_id, std::move(loading_unit.snapshot_data),
+              std::move(loading_unit.snapshot_instructions));
+        }
+      }));
+  prefetched_loading_units_.erase(prefetched);
 }
 
 std::weak_ptr<PlatformMessageHandler> Engine::GetPlatformMessageHandler()
@@ -560,6 +582,7 @@ void Engine::LoadDartDeferredLibrary(
     intptr_t loading_unit_id,
     std::unique_ptr<const fml::Mapping> snapshot_data,
     std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  prefetched_loading_units_.erase(loading_unit_id);
   if (runtime_controller_->IsRootIsolateRunning()) {
     runtime_controller_->LoadDartDeferredLibrary(
         loading_unit_id, std::move(snapshot_data),
@@ -579,6 +602,18 @@ void Engine::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
   }
 }
 
+void Engine::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  if (!snapshot_data || !snapshot_instructions) {
+    return;
+  }
+  prefetched_loading_units_.try_emplace(
+      loading_unit_id, PrefetchedLoadingUnit{std::move(snapshot_data),
+                                             std::move(snapshot_instructions)});
+}
+
 const std::weak_ptr<VsyncWaiter> Engine::GetVsyncWaiter() const {
   return animator_->GetVsyncWaiter();
 }
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "flutter/assets/asset_manager.h"
 #include "flutter/common/task_runners.h"
@@ -243,6 +244,22 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
     ///
     virtual void SetNeedsReportTimings(bool needs_reporting) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Delivers the platform messages on the channel to the Dart
+    ///             port, without posting them to the UI task runner, rather
+    ///             than to the root isolate.
+    ///
+    ///             This option is engine counterpart of the
+    ///             `PlatformDispatcher.setChannelPort` in
+    ///             `platform_dispatcher.dart`.
+    ///
+    /// @param[in]  channel  The name of the channel.
+    /// @param[in]  port     The port to deliver the messages to, or
+    ///                      `ILLEGAL_PORT` to deliver them to the root
+    ///                      isolate again.
+    ///
+    virtual void SetChannelPort(const std::string& channel, int64_t port) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Directly invokes platform-specific APIs to compute the
     ///             locale the platform would have natively resolved to.
@@ -878,6 +895,31 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
                                     const std::string& error_message,
                                     bool transient);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Keeps the mappings of a loading unit that the embedder loaded
+  ///             ahead of time, before the Dart VM requested it. When the VM
+  ///             requests the loading unit, it is loaded from these mappings
+  ///             instead of asking the embedder for it, so loading it only
+  ///             involves registering it with the VM.
+  ///
+  ///             The mappings are released once the embedder loads the
+  ///             loading unit itself, for example because it was already
+  ///             requested when it was prefetched.
+  ///
+  /// @param[in]  loading_unit_id  The unique id of the deferred library's
+  ///                              loading unit.
+  ///
+  /// @param[in]  snapshot_data    Dart snapshot data of the loading unit's
+  ///                              shared library.
+  ///
+  /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+  ///                                    loading unit's shared library.
+  ///
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
   //--------------------------------------------------------------------------
   /// @brief      Accessor for the RuntimeController.
   ///
@@ -924,6 +966,9 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
 
   void SetNeedsReportTimings(bool value) override;
 
+  // |RuntimeDelegate|
+  void SetChannelPort(const std::string& channel, int64_t port) override;
+
   bool HandleLifecyclePlatformMessage(PlatformMessage* message);
 
   bool HandleNavigationPlatformMessage(
@@ -955,6 +1000,13 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string initial_route_;
   std::shared_ptr<AssetManager> asset_manager_;
   std::shared_ptr<FontCollection> font_collection_;
+  struct PrefetchedLoadingUnit {
+    std::unique_ptr<const fml::Mapping> snapshot_data;
+    std::unique_ptr<const fml::Mapping> snapshot_instructions;
+  };
+  // The loading units prefetched by the embedder that the Dart VM hasn't
+  // requested yet, by loading unit id.
+  std::unordered_map<intptr_t, PrefetchedLoadingUnit> prefetched_loading_units_;
   const std::unique_ptr<ImageDecoder> image_decoder_;
   ImageGeneratorRegistry image_generator_registry_;
   TaskRunners task_runners_;
@@ -31,6 +31,7 @@ class MockDelegate : public Engine::Delegate {
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
   MOCK_METHOD1(SetNeedsReportTimings, void(bool));
+  MOCK_METHOD2(SetChannelPort, void(const std::string&, int64_t));
   MOCK_METHOD1(ComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    const std::vector<std::string>&));
@@ -60,6 +61,7 @@ class MockRuntimeDelegate : public RuntimeDelegate {
   MOCK_METHOD0(OnRootIsolateCreated, void());
   MOCK_METHOD2(UpdateIsolateDescription, void(const std::string, int64_t));
   MOCK_METHOD1(SetNeedsReportTimings, void(bool));
+  MOCK_METHOD2(SetChannelPort, void(const std::string&, int64_t));
   MOCK_METHOD1(ComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    const std::vector<std::string>&));
@@ -75,6 +77,10 @@ class MockRuntimeController : public RuntimeController {
       : RuntimeController(client, p_task_runners) {}
   MOCK_METHOD0(IsRootIsolateRunning, bool());
   MOCK_METHOD1(DispatchPlatformMessage, bool(std::unique_ptr<PlatformMessage>));
+  MOCK_METHOD3(LoadDartDeferredLibrary,
+               void(intptr_t,
+                    std::unique_ptr<const fml::Mapping>,
+                    std::unique_ptr<const fml::Mapping>));
   MOCK_METHOD3(LoadDartDeferredLibraryError,
                void(intptr_t, const std::string, bool));
   MOCK_CONST_METHOD0(GetDartVM, DartVM*());
@@ -411,4 +417,42 @@ TEST_F(EngineTest, PassesLoadDartDeferredLibraryErrorToRuntime) {
   });
 }
 
+TEST_F(EngineTest, LoadsPrefetchedDartDeferredLibraryWithoutRequestingIt) {
+  const intptr_t prefetched_id = 7;
+  const intptr_t other_id = 8;
+  MockRuntimeDelegate client;
+  std::unique_ptr<Engine> engine;
+  PostUITaskSync([this, &client, &engine, prefetched_id, other_id] {
+    auto mock_runtime_controller =
+        std::make_unique<MockRuntimeController>(client, task_runners_);
+    EXPECT_CALL(*mock_runtime_controller, IsRootIsolateRunning())
+        .WillRepeatedly(::testing::Return(true));
+    EXPECT_CALL(*mock_runtime_controller,
+                LoadDartDeferredLibrary(prefetched_id, ::testing::_,
+                                        ::testing::_))
+        .Times(1);
+    EXPECT_CALL(delegate_, RequestDartDeferredLibrary(prefetched_id)).Times(0);
+    EXPECT_CALL(delegate_, RequestDartDeferredLibrary(other_id)).Times(1);
+    engine = std::make_unique<Engine>(
+        /*delegate=*/delegate_,
+        /*dispatcher_maker=*/dispatcher_maker_,
+        /*image_decoder_task_runner=*/image_decoder_task_runner_,
+        /*task_runners=*/task_runners_,
+        /*settings=*/settings_,
+        /*animator=*/std::move(animator_),
+        /*io_manager=*/io_manager_,
+        /*font_collection=*/std::make_shared<FontCollection>(),
+        /*runtime_controller=*/std::move(mock_runtime_controller));
+
+    engine->PrefetchDartDeferredLibrary(
+        prefetched_id, std::make_unique<fml::DataMapping>("data"),
+        std::make_unique<fml::DataMapping>("instructions"));
+    RuntimeDelegate& runtime_delegate = *engine;
+    runtime_delegate.RequestDartDeferredLibrary(prefetched_id);
+    runtime_delegate.RequestDartDeferredLibrary(other_id);
+  });
+  // The prefetched loading unit is loaded in a separate UI task.
+  PostUITaskSync([&engine] { engine.reset(); });
+}
+
 }  // namespace flutter
@@ -137,6 +137,34 @@ void thousandCallsToNative() {
   }
 }
 
+@pragma('vm:entry-point')
+void thousandDrawRectCalls() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint()..color = const Color(0xFF00FF00);
+  for (int i = 0; i < 1000; i++) {
+    canvas.drawRect(Rect.fromLTWH(i.toDouble(), 0, 1, 1), paint);
+  }
+  recorder.endRecording().dispose();
+  notifyNative();
+}
+
+@pragma('vm:entry-point')
+void thousandRectsInOneDrawRawRectsCall() {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  final Paint paint = Paint()..color = const Color(0xFF00FF00);
+  final Float32List rects = Float32List(4000);
+  for (int i = 0; i < 1000; i++) {
+    rects[i * 4] = i.toDouble();
+    rects[i * 4 + 2] = i + 1.0;
+    rects[i * 4 + 3] = 1.0;
+  }
+  canvas.drawRawRects(rects, paint);
+  recorder.endRecording().dispose();
+  notifyNative();
+}
+
 void secondaryIsolateMain(String message) {
   print('Secondary isolate got message: ' + message);
   notifyNative();
@@ -220,6 +248,19 @@ void callNotifyDestroyed() {
 @pragma('vm:external-name', 'NotifyMessage')
 external void notifyMessage(String string);
 
+@pragma('vm:entry-point')
+void postsChannelMessagesToPort() {
+  final ReceivePort port = ReceivePort();
+  port.listen((dynamic message) {
+    final List<Object?> list = message as List<Object?>;
+    final Uint8List data = list[1]! as Uint8List;
+    notifyMessage('${list[0]}:${utf8.decode(data)}');
+    port.close();
+  });
+  PlatformDispatcher.instance.setChannelPort('test/channel', port.sendPort);
+  notifyNative();
+}
+
 @pragma('vm:entry-point')
 void canConvertMappings() {
   sendFixtureMapping(getFixtureMapping());
@@ -401,6 +442,29 @@ Future<void> toImageSync() async {
   notifyNative();
 }
 
+@pragma('vm:entry-point')
+Future<void> toImagePipelined() async {
+  final PictureRecorder recorder = PictureRecorder();
+  final Canvas canvas = Canvas(recorder);
+  canvas.drawPaint(Paint()..color = const Color(0xFFAAAAAA));
+  final Picture picture = recorder.endRecording();
+
+  final List<Image> images = await Future.wait(<Future<Image>>[
+    for (int i = 0; i < 4; i++) picture.toImage(20, 25),
+  ]);
+  bool passed = true;
+  for (final Image image in images) {
+    final ByteData data = (await image.toByteData())!;
+    passed = passed &&
+        image.width == 20 &&
+        image.height == 25 &&
+        data.buffer.asUint32List().every((int byte) => byte == 0xFFAAAAAA);
+    image.dispose();
+  }
+  picture.dispose();
+  notifyNativeBool(passed);
+}
+
 @pragma('vm:entry-point')
 Future<void> included() async {
 
@@ -0,0 +1,151 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Counts the heap allocations made by each stage of producing a frame from a
+// layer tree, so that allocations can be eliminated from the stages that run
+// every frame and regressions are caught. For each stage, the benchmark
+// reports the allocations and bytes allocated per frame as the counters
+// <stage>.allocs and <stage>.bytes.
+
+#include "flutter/benchmarking/allocation_counter.h"
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/display_list/display_list_builder.h"
+#include "flutter/flow/compositor_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/opacity_layer.h"
+#include "flutter/flow/layers/transform_layer.h"
+#include "flutter/fml/logging.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/display_list/display_list_dispatcher.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+namespace flutter {
+
+namespace {
+
+constexpr SkScalar kFrameSize = 1000;
+constexpr int kDrawsPerPicture = 10;
+
+benchmarking::AllocationSubsystem kDisplayListRecording("DisplayList");
+benchmarking::AllocationSubsystem kLayerTreeBuilding("LayerTree");
+benchmarking::AllocationSubsystem kPreroll("Preroll");
+benchmarking::AllocationSubsystem kPaint("Paint");
+#if IMPELLER_SUPPORTS_RENDERING
+benchmarking::AllocationSubsystem kImpellerRecording("Impeller");
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+sk_sp<DisplayList> RecordPicture(int index) {
+  DisplayListBuilder builder;
+  DlPaint paint(DlColor(0xFF000000 | (index * 0x10203)));
+  for (int i = 0; i < kDrawsPerPicture; i++) {
+    builder.DrawRect(SkRect::MakeXYWH(i * 8, i * 4, 40, 20), paint);
+  }
+  builder.DrawCircle(SkPoint::Make(50, 50), 20, paint);
+  return builder.Build();
+}
+
+// The layers of a typical list of items, each of which is translated and
+// faded in.
+std::shared_ptr<Layer> BuildLayerTree(
+    const std::vector<sk_sp<DisplayList>>& pictures) {
+  auto root = std::make_shared<ContainerLayer>();
+  for (size_t i = 0; i < pictures.size(); i++) {
+    auto transform = std::make_shared<TransformLayer>(
+        SkMatrix::Translate(0, (i * 50) % static_cast<size_t>(kFrameSize)));
+    auto opacity = std::make_shared<OpacityLayer>(
+        static_cast<SkAlpha>(128 + i % 128), SkPoint::Make(10, 0));
+    opacity->Add(std::make_shared<DisplayListLayer>(
+        SkPoint::Make(0, 0), SkiaGPUObject<DisplayList>(pictures[i], nullptr),
+        false, false));
+    transform->Add(opacity);
+    root->Add(transform);
+  }
+  return root;
+}
+
+void BM_FrameAllocations(benchmark::State& state) {
+  const size_t item_count = static_cast<size_t>(state.range(0));
+  CompositorContext compositor_context;
+  LayerTree layer_tree(SkISize::Make(kFrameSize, kFrameSize), 1.0f);
+
+  auto display_list_start = kDisplayListRecording.GetCounts();
+  auto layer_tree_start = kLayerTreeBuilding.GetCounts();
+  auto preroll_start = kPreroll.GetCounts();
+  auto paint_start = kPaint.GetCounts();
+#if IMPELLER_SUPPORTS_RENDERING
+  auto impeller_start = kImpellerRecording.GetCounts();
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  auto total_start = benchmarking::AllocationSubsystem::GetTotalCounts();
+
+  while (state.KeepRunning()) {
+    // The framework records the pictures and builds the layers of each frame
+    // again.
+    std::vector<sk_sp<DisplayList>> pictures;
+    {
+      benchmarking::ScopedAllocationSubsystem scope(kDisplayListRecording);
+      pictures.reserve(item_count);
+      for (size_t i = 0; i < item_count; i++) {
+        pictures.push_back(RecordPicture(static_cast<int>(i)));
+      }
+    }
+    {
+      benchmarking::ScopedAllocationSubsystem scope(kLayerTreeBuilding);
+      layer_tree.set_root_layer(BuildLayerTree(pictures));
+    }
+
+    // The rasterizer paints the layer tree into a display list, which is
+    // what is drawn by Impeller.
+    sk_sp<DisplayList> frame_display_list;
+    {
+      DisplayListBuilder builder(SkRect::MakeWH(kFrameSize, kFrameSize));
+      auto frame = compositor_context.AcquireFrame(
+          nullptr, &builder, nullptr, SkMatrix::I(), false, true, nullptr,
+          &builder, nullptr);
+      {
+        benchmarking::ScopedAllocationSubsystem scope(kPreroll);
+        layer_tree.Preroll(*frame);
+      }
+      {
+        benchmarking::ScopedAllocationSubsystem scope(kPaint);
+        layer_tree.Paint(*frame);
+        frame_display_list = builder.Build();
+      }
+    }
+    FML_CHECK(frame_display_list);
+
+#if IMPELLER_SUPPORTS_RENDERING
+    {
+      benchmarking::ScopedAllocationSubsystem scope(kImpellerRecording);
+      impeller::DisplayListDispatcher dispatcher;
+      frame_display_list->Dispatch(dispatcher);
+      auto picture = dispatcher.EndRecordingAsPicture();
+      benchmark::DoNotOptimize(picture.pass);
+    }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  }
+
+  kDisplayListRecording.ReportCounts(state, display_list_start);
+  kLayerTreeBuilding.ReportCounts(state, layer_tree_start);
+  kPreroll.ReportCounts(state, preroll_start);
+  kPaint.ReportCounts(state, paint_start);
+#if IMPELLER_SUPPORTS_RENDERING
+  kImpellerRecording.ReportCounts(state, impeller_start);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  // Includes the allocations of the frame itself, and of any other threads.
+  auto total =
+      benchmarking::AllocationSubsystem::GetTotalCounts() - total_start;
+  state.counters["Total.allocs"] = benchmark::Counter(
+      total.allocations, benchmark::Counter::kAvgIterations);
+  state.counters["Total.bytes"] =
+      benchmark::Counter(total.bytes, benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+BENCHMARK(BM_FrameAllocations)->Arg(10)->Arg(100)->Arg(1000);
+
+}  // namespace flutter
@@ -0,0 +1,69 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_pacer.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+FramePacer::FramePacer(size_t window_size, double work_budget_fraction)
+    : window_size_(window_size), work_budget_fraction_(work_budget_fraction) {
+  FML_DCHECK(window_size_ > 0);
+  FML_DCHECK(work_budget_fraction_ > 0 && work_budget_fraction_ <= 1);
+}
+
+void FramePacer::RecordFrame(fml::TimeDelta build_duration,
+                             fml::TimeDelta raster_duration,
+                             fml::Milliseconds frame_budget) {
+  const double work_millis =
+      build_duration.ToMillisecondsF() + raster_duration.ToMillisecondsF();
+  const double work_budget_millis =
+      frame_budget.count() * work_budget_fraction_;
+
+  std::scoped_lock lock(mutex_);
+  work_millis_.push_back(work_millis);
+  if (work_millis_.size() > window_size_) {
+    work_millis_.pop_front();
+  }
+
+  if (work_millis > work_budget_millis) {
+    // Fall back to the deeper pipeline right away, and only go back to the
+    // shallow one once a whole window of frames has fit the budget again.
+    if (pipeline_depth_ != 2) {
+      TRACE_EVENT_INSTANT0("flutter", "FramePacerDepth2");
+    }
+    pipeline_depth_ = 2;
+    begin_frame_delay_ = fml::TimeDelta::Zero();
+    work_millis_.clear();
+    return;
+  }
+  if (work_millis_.size() < window_size_) {
+    return;
+  }
+
+  if (pipeline_depth_ != 1) {
+    TRACE_EVENT_INSTANT0("flutter", "FramePacerDepth1");
+  }
+  pipeline_depth_ = 1;
+  const double slowest_millis =
+      *std::max_element(work_millis_.begin(), work_millis_.end());
+  begin_frame_delay_ =
+      fml::TimeDelta::FromMillisecondsF(work_budget_millis - slowest_millis);
+}
+
+size_t FramePacer::GetPipelineDepth() const {
+  std::scoped_lock lock(mutex_);
+  return pipeline_depth_;
+}
+
+fml::TimeDelta FramePacer::GetBeginFrameDelay() const {
+  std::scoped_lock lock(mutex_);
+  return begin_frame_delay_;
+}
+
+}  // namespace flutter
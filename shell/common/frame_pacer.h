@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_PACER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_PACER_H_
+
+#include <deque>
+#include <mutex>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+/// Decides how many frames the |Animator| may have in flight and how long
+/// after vsync it begins building a frame, based on how long the previous
+/// frames took to build and rasterize.
+///
+/// When the slowest of the last |window_size| frames was built and
+/// rasterized in less than |work_budget_fraction| of the frame budget, a
+/// frame can be built and rasterized within a single vsync interval, so
+/// only one frame is kept in flight, which removes a frame of latency. The
+/// beginning of the frame is then delayed by the headroom that is left, so
+/// that it samples the input as late as possible and is rasterized just in
+/// time. As soon as a frame misses that budget, two frames are kept in
+/// flight again so that the UI and raster threads can work in parallel.
+///
+/// Frames are recorded on the raster thread and the pacing is read on the
+/// UI thread.
+class FramePacer {
+ public:
+  explicit FramePacer(size_t window_size = 30,
+                      double work_budget_fraction = 0.75);
+
+  void RecordFrame(fml::TimeDelta build_duration,
+                   fml::TimeDelta raster_duration,
+                   fml::Milliseconds frame_budget);
+
+  /// The maximum number of frames that should be in flight, either 1 or 2.
+  size_t GetPipelineDepth() const;
+
+  /// How long after the vsync the next frame should begin to be built.
+  fml::TimeDelta GetBeginFrameDelay() const;
+
+ private:
+  const size_t window_size_;
+  const double work_budget_fraction_;
+
+  mutable std::mutex mutex_;
+  // The build and raster durations of the most recent frames, in
+  // milliseconds, oldest first.
+  std::deque<double> work_millis_;
+  size_t pipeline_depth_ = 2;
+  fml::TimeDelta begin_frame_delay_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramePacer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_PACER_H_
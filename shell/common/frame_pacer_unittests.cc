@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_pacer.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+const fml::Milliseconds kBudget = fml::Milliseconds(16);
+
+fml::TimeDelta Millis(int64_t millis) {
+  return fml::TimeDelta::FromMilliseconds(millis);
+}
+
+}  // namespace
+
+TEST(FramePacer, KeepsTwoFramesInFlightUntilAWindowOfFramesIsCheap) {
+  FramePacer pacer(3, 0.75);
+  EXPECT_EQ(pacer.GetPipelineDepth(), 2u);
+  EXPECT_EQ(pacer.GetBeginFrameDelay(), fml::TimeDelta::Zero());
+
+  pacer.RecordFrame(Millis(2), Millis(4), kBudget);
+  pacer.RecordFrame(Millis(2), Millis(4), kBudget);
+  EXPECT_EQ(pacer.GetPipelineDepth(), 2u);
+
+  pacer.RecordFrame(Millis(2), Millis(6), kBudget);
+  EXPECT_EQ(pacer.GetPipelineDepth(), 1u);
+  // 12ms of the budget is available for work, and the slowest frame took
+  // 8ms.
+  EXPECT_EQ(pacer.GetBeginFrameDelay(), Millis(4));
+}
+
+TEST(FramePacer, FallsBackToTwoFramesInFlightAfterAnExpensiveFrame) {
+  FramePacer pacer(2, 0.75);
+  pacer.RecordFrame(Millis(2), Millis(4), kBudget);
+  pacer.RecordFrame(Millis(2), Millis(4), kBudget);
+  ASSERT_EQ(pacer.GetPipelineDepth(), 1u);
+
+  // Each phase fits the budget, but not both of them after each other.
+  pacer.RecordFrame(Millis(8), Millis(8), kBudget);
+  EXPECT_EQ(pacer.GetPipelineDepth(), 2u);
+  EXPECT_EQ(pacer.GetBeginFrameDelay(), fml::TimeDelta::Zero());
+
+  // The window starts again after the expensive frame.
+  pacer.RecordFrame(Millis(2), Millis(4), kBudget);
+  EXPECT_EQ(pacer.GetPipelineDepth(), 2u);
+  pacer.RecordFrame(Millis(2), Millis(4), kBudget);
+  EXPECT_EQ(pacer.GetPipelineDepth(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,101 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_phase_histograms.h"
+
+#include <algorithm>
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+double ToMillis(fml::TimeDelta duration) {
+  return std::max(duration.ToMillisecondsF(), 0.0);
+}
+
+}  // namespace
+
+const char* FramePhaseHistograms::GetPhaseName(Phase phase) {
+  switch (phase) {
+    case kBuild:
+      return "build";
+    case kDiff:
+      return "diff";
+    case kPreroll:
+      return "preroll";
+    case kPaint:
+      return "paint";
+    case kSubmit:
+      return "submit";
+    case kRaster:
+      return "raster";
+    case kPhaseCount:
+      break;
+  }
+  FML_UNREACHABLE();
+}
+
+FramePhaseHistograms::FramePhaseHistograms(size_t window_size)
+    : window_size_(window_size) {
+  FML_DCHECK(window_size_ > 0u);
+}
+
+void FramePhaseHistograms::RecordFrame(const FrameTiming& timing) {
+  std::array<double, kPhaseCount> millis;
+  millis[kBuild] = ToMillis(timing.Get(FrameTiming::kBuildFinish) -
+                            timing.Get(FrameTiming::kBuildStart));
+  millis[kDiff] = ToMillis(timing.GetRasterPhaseDuration(FrameTiming::kDiff));
+  millis[kPreroll] =
+      ToMillis(timing.GetRasterPhaseDuration(FrameTiming::kPreroll));
+  millis[kPaint] = ToMillis(timing.GetRasterPhaseDuration(FrameTiming::kPaint));
+  millis[kSubmit] =
+      ToMillis(timing.GetRasterPhaseDuration(FrameTiming::kSubmit));
+  millis[kRaster] = ToMillis(timing.Get(FrameTiming::kRasterFinish) -
+                             timing.Get(FrameTiming::kRasterStart));
+  frame_millis_.push_back(millis);
+  if (frame_millis_.size() > window_size_) {
+    frame_millis_.pop_front();
+  }
+}
+
+size_t FramePhaseHistograms::GetFrameCount() const {
+  return frame_millis_.size();
+}
+
+FramePhaseHistograms::Histogram FramePhaseHistograms::GetHistogram(
+    Phase phase) const {
+  Histogram histogram;
+  histogram.bucket_counts.resize(kBucketCount, 0u);
+  if (frame_millis_.empty()) {
+    return histogram;
+  }
+
+  std::vector<double> durations;
+  durations.reserve(frame_millis_.size());
+  double total_millis = 0;
+  for (const auto& frame : frame_millis_) {
+    double millis = frame[phase];
+    const double* bound =
+        std::lower_bound(std::begin(kBucketBoundsMillis),
+                         std::end(kBucketBoundsMillis), millis);
+    histogram.bucket_counts[bound - std::begin(kBucketBoundsMillis)]++;
+    total_millis += millis;
+    durations.push_back(millis);
+  }
+  histogram.average_millis = total_millis / durations.size();
+
+  size_t p90_index = (durations.size() * 9) / 10;
+  if (p90_index == durations.size()) {
+    p90_index--;
+  }
+  std::nth_element(durations.begin(), durations.begin() + p90_index,
+                   durations.end());
+  histogram.p90_millis = durations[p90_index];
+  histogram.max_millis = *std::max_element(durations.begin(), durations.end());
+  return histogram;
+}
+
+}  // namespace flutter
@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_PHASE_HISTOGRAMS_H_
+#define FLUTTER_SHELL_COMMON_FRAME_PHASE_HISTOGRAMS_H_
+
+#include <array>
+#include <deque>
+#include <vector>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+/// Aggregates how long each phase of the most recent |window_size| frames
+/// took into histograms, so that tools can see which phase of the frame is
+/// responsible for jank without capturing a timeline.
+///
+/// Frames are recorded and the histograms are read on the raster thread.
+class FramePhaseHistograms {
+ public:
+  enum Phase {
+    kBuild,
+    kDiff,
+    kPreroll,
+    kPaint,
+    kSubmit,
+    kRaster,
+    kPhaseCount,
+  };
+
+  /// The upper bounds of the buckets of the histograms, in milliseconds. The
+  /// last bucket counts the durations above the last bound.
+  static constexpr double kBucketBoundsMillis[] = {1,  2,  4,  8,  12,
+                                                   16, 24, 33, 50, 100};
+  static constexpr size_t kBucketCount =
+      sizeof(kBucketBoundsMillis) / sizeof(kBucketBoundsMillis[0]) + 1;
+
+  struct Histogram {
+    std::vector<size_t> bucket_counts;
+    double average_millis = 0;
+    double p90_millis = 0;
+    double max_millis = 0;
+  };
+
+  static const char* GetPhaseName(Phase phase);
+
+  explicit FramePhaseHistograms(size_t window_size = 600);
+
+  void RecordFrame(const FrameTiming& timing);
+
+  /// The number of frames that the histograms are computed from.
+  size_t GetFrameCount() const;
+
+  Histogram GetHistogram(Phase phase) const;
+
+ private:
+  const size_t window_size_;
+  // The durations of the phases of the most recent frames, in milliseconds,
+  // oldest first.
+  std::deque<std::array<double, kPhaseCount>> frame_millis_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FramePhaseHistograms);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_PHASE_HISTOGRAMS_H_
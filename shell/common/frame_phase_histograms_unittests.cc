@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_phase_histograms.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+FrameTiming MakeTiming(int64_t build_millis, int64_t paint_millis) {
+  FrameTiming timing;
+  fml::TimePoint start = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(1000));
+  timing.Set(FrameTiming::kBuildStart, start);
+  timing.Set(FrameTiming::kBuildFinish,
+             start + fml::TimeDelta::FromMilliseconds(build_millis));
+  timing.Set(FrameTiming::kRasterStart, start);
+  timing.Set(FrameTiming::kRasterFinish,
+             start + fml::TimeDelta::FromMilliseconds(paint_millis + 1));
+  timing.SetRasterPhaseDuration(FrameTiming::kPaint,
+                                fml::TimeDelta::FromMilliseconds(paint_millis));
+  return timing;
+}
+
+}  // namespace
+
+TEST(FramePhaseHistograms, CountsFramesIntoBuckets) {
+  FramePhaseHistograms histograms;
+  histograms.RecordFrame(MakeTiming(3, 10));
+  histograms.RecordFrame(MakeTiming(3, 20));
+  histograms.RecordFrame(MakeTiming(200, 20));
+  EXPECT_EQ(histograms.GetFrameCount(), 3u);
+
+  auto build = histograms.GetHistogram(FramePhaseHistograms::kBuild);
+  ASSERT_EQ(build.bucket_counts.size(), FramePhaseHistograms::kBucketCount);
+  // (2, 4]
+  EXPECT_EQ(build.bucket_counts[2], 2u);
+  // Above the last bound.
+  EXPECT_EQ(build.bucket_counts.back(), 1u);
+  EXPECT_DOUBLE_EQ(build.max_millis, 200);
+  EXPECT_DOUBLE_EQ(build.p90_millis, 200);
+
+  auto paint = histograms.GetHistogram(FramePhaseHistograms::kPaint);
+  // (8, 12] and (16, 24]
+  EXPECT_EQ(paint.bucket_counts[4], 1u);
+  EXPECT_EQ(paint.bucket_counts[6], 2u);
+  EXPECT_NEAR(paint.average_millis, 50.0 / 3.0, 1e-9);
+
+  auto diff = histograms.GetHistogram(FramePhaseHistograms::kDiff);
+  EXPECT_EQ(diff.bucket_counts[0], 3u);
+  EXPECT_DOUBLE_EQ(diff.max_millis, 0);
+}
+
+TEST(FramePhaseHistograms, OnlyKeepsTheMostRecentFrames) {
+  FramePhaseHistograms histograms(2);
+  histograms.RecordFrame(MakeTiming(200, 1));
+  histograms.RecordFrame(MakeTiming(3, 1));
+  histograms.RecordFrame(MakeTiming(3, 1));
+  EXPECT_EQ(histograms.GetFrameCount(), 2u);
+
+  auto build = histograms.GetHistogram(FramePhaseHistograms::kBuild);
+  EXPECT_EQ(build.bucket_counts.back(), 0u);
+  EXPECT_EQ(build.bucket_counts[2], 2u);
+  EXPECT_DOUBLE_EQ(build.max_millis, 3);
+}
+
+TEST(FramePhaseHistograms, IsEmptyBeforeAnyFrame) {
+  FramePhaseHistograms histograms;
+  EXPECT_EQ(histograms.GetFrameCount(), 0u);
+  auto raster = histograms.GetHistogram(FramePhaseHistograms::kRaster);
+  EXPECT_EQ(raster.bucket_counts.size(), FramePhaseHistograms::kBucketCount);
+  EXPECT_DOUBLE_EQ(raster.max_millis, 0);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_scheduler.h"
+
+namespace flutter {
+
+IdleScheduler::IdleScheduler() = default;
+
+IdleScheduler::~IdleScheduler() = default;
+
+void IdleScheduler::RecordFrame(fml::TimePoint vsync_start,
+                                fml::TimePoint vsync_target) {
+  // Keep the last known interval when the vsync times don't tell it, e.g.
+  // for frames that are scheduled without a vsync.
+  if (vsync_target > vsync_start) {
+    frame_interval_ = vsync_target - vsync_start;
+  }
+  last_vsync_target_ = vsync_target;
+  long_idle_count_ = 0;
+}
+
+std::optional<fml::TimePoint> IdleScheduler::PredictNextFrameStart(
+    fml::TimePoint now) const {
+  if (!last_vsync_target_.has_value()) {
+    return std::nullopt;
+  }
+  const fml::TimePoint target = last_vsync_target_.value();
+  if (now <= target || frame_interval_ <= fml::TimeDelta::Zero()) {
+    return target;
+  }
+  // Vsyncs keep ticking at the same interval while no frames are built.
+  const int64_t interval = frame_interval_.ToMicroseconds();
+  const int64_t intervals =
+      ((now - target).ToMicroseconds() + interval - 1) / interval;
+  return target + fml::TimeDelta::FromMicroseconds(intervals * interval);
+}
+
+std::optional<fml::TimePoint> IdleScheduler::GetFrameIdleDeadline(
+    fml::TimePoint now) const {
+  std::optional<fml::TimePoint> next_frame_start = PredictNextFrameStart(now);
+  if (!next_frame_start.has_value()) {
+    return std::nullopt;
+  }
+  if (frame_interval_ <= fml::TimeDelta::Zero()) {
+    return next_frame_start;
+  }
+  return next_frame_start.value() - kFrameStartMargin;
+}
+
+std::optional<fml::TimeDelta> IdleScheduler::NextLongIdleDuration() {
+  if (long_idle_count_ >= kMaxLongIdleNotifications) {
+    return std::nullopt;
+  }
+  return kLongIdleDuration * static_cast<int64_t>(1 << long_idle_count_++);
+}
+
+}  // namespace flutter
@@ -0,0 +1,75 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_IDLE_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_IDLE_SCHEDULER_H_
+
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Decides the deadlines of the idle notifications the |Animator| sends to
+/// the Dart VM, so that garbage collections started in idle time end before
+/// the next frame has to be built.
+///
+/// Between frames, the deadline is the predicted start of the next frame,
+/// as extrapolated from the vsync times of the last frame. Once no frames
+/// have been built for a while, the VM is handed a few increasingly long
+/// deadlines, which leave it enough time for full (compacting) collections.
+///
+/// Not thread safe, the |Animator| uses it on the UI thread.
+class IdleScheduler {
+ public:
+  /// How long before the predicted start of the next frame the idle time
+  /// between frames ends, to absorb vsync jitter and the time it takes the
+  /// VM to stop.
+  static constexpr fml::TimeDelta kFrameStartMargin =
+      fml::TimeDelta::FromMilliseconds(1);
+
+  /// The length of the first long idle period, each one after it is twice
+  /// as long.
+  static constexpr fml::TimeDelta kLongIdleDuration =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  /// The number of long idle periods the VM is notified of while no frames
+  /// are built. The VM has little left to collect after those.
+  static constexpr int kMaxLongIdleNotifications = 3;
+
+  IdleScheduler();
+
+  ~IdleScheduler();
+
+  /// Records the vsync times of a frame that begins, which also ends any
+  /// long idle period.
+  void RecordFrame(fml::TimePoint vsync_start, fml::TimePoint vsync_target);
+
+  /// The predicted start of the first frame after |now|, or std::nullopt if
+  /// no frame has been recorded. Without a known frame interval, this is the
+  /// vsync target time of the last frame.
+  std::optional<fml::TimePoint> PredictNextFrameStart(fml::TimePoint now) const;
+
+  /// The deadline of the idle time until the next frame, or std::nullopt if
+  /// no frame has been recorded. The deadline may have passed already, in
+  /// which case there is no idle time.
+  std::optional<fml::TimePoint> GetFrameIdleDeadline(fml::TimePoint now) const;
+
+  /// The length of the next long idle period, or std::nullopt once the VM
+  /// has been notified of |kMaxLongIdleNotifications| of them since the last
+  /// frame.
+  std::optional<fml::TimeDelta> NextLongIdleDuration();
+
+ private:
+  std::optional<fml::TimePoint> last_vsync_target_;
+  fml::TimeDelta frame_interval_;
+  int long_idle_count_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IdleScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_IDLE_SCHEDULER_H_
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/idle_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::TimePoint Ms(int64_t milliseconds) {
+  return fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(milliseconds));
+}
+
+}  // namespace
+
+TEST(IdleSchedulerTest, HasNoDeadlinesBeforeTheFirstFrame) {
+  IdleScheduler scheduler;
+  EXPECT_FALSE(scheduler.PredictNextFrameStart(Ms(10)).has_value());
+  EXPECT_FALSE(scheduler.GetFrameIdleDeadline(Ms(10)).has_value());
+}
+
+TEST(IdleSchedulerTest, PredictsTheNextVsync) {
+  IdleScheduler scheduler;
+  scheduler.RecordFrame(Ms(100), Ms(116));
+
+  EXPECT_EQ(scheduler.PredictNextFrameStart(Ms(105)), Ms(116));
+  EXPECT_EQ(scheduler.PredictNextFrameStart(Ms(116)), Ms(116));
+  EXPECT_EQ(scheduler.PredictNextFrameStart(Ms(117)), Ms(132));
+  EXPECT_EQ(scheduler.PredictNextFrameStart(Ms(150)), Ms(164));
+
+  EXPECT_EQ(scheduler.GetFrameIdleDeadline(Ms(105)),
+            Ms(116) - IdleScheduler::kFrameStartMargin);
+  EXPECT_EQ(scheduler.GetFrameIdleDeadline(Ms(150)),
+            Ms(164) - IdleScheduler::kFrameStartMargin);
+}
+
+TEST(IdleSchedulerTest, KeepsTheIntervalOfFramesWithoutVsync) {
+  IdleScheduler scheduler;
+  scheduler.RecordFrame(Ms(100), Ms(100));
+  EXPECT_EQ(scheduler.GetFrameIdleDeadline(Ms(120)), Ms(100));
+
+  scheduler.RecordFrame(Ms(100), Ms(108));
+  scheduler.RecordFrame(Ms(200), Ms(200));
+  EXPECT_EQ(scheduler.PredictNextFrameStart(Ms(203)), Ms(208));
+}
+
+TEST(IdleSchedulerTest, LongIdlePeriodsGrowUntilTheNextFrame) {
+  IdleScheduler scheduler;
+  EXPECT_EQ(scheduler.NextLongIdleDuration(),
+            IdleScheduler::kLongIdleDuration);
+  EXPECT_EQ(scheduler.NextLongIdleDuration(),
+            IdleScheduler::kLongIdleDuration * 2);
+  EXPECT_EQ(scheduler.NextLongIdleDuration(),
+            IdleScheduler::kLongIdleDuration * 4);
+  EXPECT_FALSE(scheduler.NextLongIdleDuration().has_value());
+
+  scheduler.RecordFrame(Ms(100), Ms(116));
+  EXPECT_EQ(scheduler.NextLongIdleDuration(),
+            IdleScheduler::kLongIdleDuration);
+}
+
+}  // namespace testing
+}  // namespace flutter
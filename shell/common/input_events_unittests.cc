@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -418,6 +419,111 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   DestroyShell(std::move(shell));
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
+namespace {
+
+class FakePointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void FireVsync() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  fml::closure vsync_callback;
+};
+
+std::unique_ptr<PointerDataPacket> CreateSimulatedPacket(
+    PointerData::Change change,
+    int64_t time_stamp,
+    double x,
+    double y) {
+  auto packet = std::make_unique<PointerDataPacket>(1);
+  PointerData data;
+  CreateSimulatedPointerData(data, change, x, y);
+  data.time_stamp = time_stamp;
+  packet->SetPointerData(0, data);
+  return packet;
+}
+
+}  // namespace
+
+TEST(ResamplingPointerDataDispatcherTest, CoalescesMovesIntoOnePacketPerFrame) {
+  FakePointerDataDispatcherDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(delegate, fml::TimeDelta::Zero());
+
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kDown, 0, 0.0, 0.0), 1);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kMove, 4000, 2.0, 0.0), 2);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kMove, 8000, 4.0, 1.0), 3);
+  ASSERT_TRUE(delegate.packets.empty());
+
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  ASSERT_EQ(delegate.packets[0]->GetLength(), 2u);
+  PointerData down = delegate.packets[0]->GetPointerData(0);
+  PointerData move = delegate.packets[0]->GetPointerData(1);
+  EXPECT_EQ(down.change, PointerData::Change::kDown);
+  EXPECT_EQ(move.change, PointerData::Change::kMove);
+  EXPECT_EQ(move.time_stamp, 8000);
+  EXPECT_EQ(move.physical_x, 4.0);
+  EXPECT_EQ(move.physical_delta_x, 4.0);
+  EXPECT_EQ(move.physical_delta_y, 1.0);
+
+  // Nothing is dispatched in frames without events.
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+}
+
+TEST(ResamplingPointerDataDispatcherTest, PredictsTheLastPositionOfAFrame) {
+  FakePointerDataDispatcherDelegate delegate;
+  ResamplingPointerDataDispatcher dispatcher(
+      delegate, fml::TimeDelta::FromMilliseconds(4));
+
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kDown, 0, 0.0, 0.0), 1);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kMove, 4000, 2.0, 0.0), 2);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kMove, 8000, 4.0, 0.0), 3);
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  PointerData move = delegate.packets[0]->GetPointerData(1);
+  EXPECT_EQ(move.time_stamp, 12000);
+  EXPECT_EQ(move.physical_x, 6.0);
+  EXPECT_EQ(move.physical_delta_x, 6.0);
+
+  // The up event isn't predicted, and the next frame's move is relative to
+  // the predicted position.
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kMove, 12000, 5.0, 0.0), 4);
+  dispatcher.DispatchPacket(
+      CreateSimulatedPacket(PointerData::Change::kUp, 12000, 5.0, 0.0), 5);
+  delegate.FireVsync();
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  ASSERT_EQ(delegate.packets[1]->GetLength(), 2u);
+  move = delegate.packets[1]->GetPointerData(0);
+  PointerData up = delegate.packets[1]->GetPointerData(1);
+  EXPECT_EQ(move.physical_x, 5.0);
+  EXPECT_EQ(move.physical_delta_x, -1.0);
+  EXPECT_EQ(up.change, PointerData::Change::kUp);
+  EXPECT_EQ(up.physical_x, 5.0);
+}
 
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,45 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_H_
+#define FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_H_
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace flutter {
+
+/// How much memory the owners of caches should release, from least to most.
+enum class MemoryPressureLevel {
+  /// The system is starting to run low on memory. Caches release what wasn't
+  /// used to render the last frame.
+  kModerate,
+  /// The system is about to kill processes to reclaim memory. Caches release
+  /// everything that isn't in use, and the Dart VM collects garbage.
+  kCritical,
+  /// The application is in the background, where it is among the first to
+  /// be killed. Caches release everything they can, even if it must be
+  /// recreated for the next frame.
+  kBackground,
+};
+
+/// The approximate number of bytes held by each cache, keyed by its name.
+using ResidentCacheBytes = std::map<std::string, size_t>;
+
+/// An owner of caches that release memory in proportion to the memory
+/// pressure.
+class MemoryPressureListener {
+ public:
+  virtual ~MemoryPressureListener() = default;
+
+  virtual void TrimMemory(MemoryPressureLevel level) = 0;
+
+  /// Adds the approximate size of each of its caches to |report|.
+  virtual void ReportResidentCacheBytes(ResidentCacheBytes& report) const = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_MEMORY_PRESSURE_H_
@@ -4,6 +4,7 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <map>
 #include <memory>
 
 #include "flutter/assets/directory_asset_bundle.h"
@@ -13,6 +14,8 @@
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/thread.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/switches.h"
@@ -362,5 +365,100 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+static std::string ToString(const fml::Mapping& mapping) {
+  return std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                     mapping.GetSize());
+}
+
+TEST(PersistentCachePackTest, BatchesStoresIntoOneFile) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  fml::Thread worker("worker");
+
+  auto pack = std::make_shared<PersistentCachePack>(directory, false);
+  pack->Store("a", std::make_unique<fml::DataMapping>("first"),
+              worker.GetTaskRunner());
+  pack->Store("b", std::make_unique<fml::DataMapping>("second"),
+              worker.GetTaskRunner());
+  pack->Store("a", std::make_unique<fml::DataMapping>("third"),
+              worker.GetTaskRunner());
+
+  // Stored objects are loaded before the pack is written.
+  ASSERT_FALSE(fml::FileExists(*directory, PersistentCachePack::kFileName));
+  ASSERT_EQ(ToString(*pack->Load("a")), "third");
+  ASSERT_EQ(pack->Load("c"), nullptr);
+
+  ASSERT_TRUE(pack->Write());
+  ASSERT_TRUE(fml::FileExists(*directory, PersistentCachePack::kFileName));
+  pack->Store("c", std::make_unique<fml::DataMapping>("fourth"), nullptr);
+
+  auto loaded = std::make_shared<PersistentCachePack>(directory, false);
+  std::map<std::string, std::string> objects;
+  loaded->Visit([&](const std::string& name, const fml::Mapping& object) {
+    objects[name] = ToString(object);
+  });
+  ASSERT_EQ(objects, (std::map<std::string, std::string>{
+                         {"a", "third"}, {"b", "second"}, {"c", "fourth"}}));
+
+  loaded->Clear();
+  ASSERT_EQ(loaded->Load("a"), nullptr);
+}
+
+TEST(PersistentCachePackTest, IgnoresTruncatedObjects) {
+  fml::ScopedTemporaryDirectory dir;
+  auto directory = std::make_shared<fml::UniqueFD>(
+      fml::OpenDirectory(dir.path().c_str(), false,
+                         fml::FilePermission::kReadWrite));
+  {
+    auto pack = std::make_shared<PersistentCachePack>(directory, false);
+    pack->Store("a", std::make_unique<fml::DataMapping>("first"), nullptr);
+  }
+  auto file = fml::FileMapping::CreateReadOnly(*directory,
+                                               PersistentCachePack::kFileName);
+  ASSERT_NE(file, nullptr);
+  std::vector<uint8_t> contents(file->GetMapping(),
+                                file->GetMapping() + file->GetSize());
+  file.reset();
+
+  // The second object is cut short, as if writing it was interrupted.
+  std::vector<uint8_t> truncated = contents;
+  truncated.insert(truncated.end(), contents.begin() + 8, contents.end() - 2);
+  ASSERT_TRUE(fml::WriteAtomically(*directory, PersistentCachePack::kFileName,
+                                   fml::DataMapping(truncated)));
+  auto pack = std::make_shared<PersistentCachePack>(directory, false);
+  ASSERT_EQ(ToString(*pack->Load("a")), "first");
+
+  ASSERT_TRUE(fml::WriteAtomically(*directory, PersistentCachePack::kFileName,
+                                   fml::DataMapping("not a pack")));
+  pack = std::make_shared<PersistentCachePack>(directory, false);
+  ASSERT_EQ(pack->Load("a"), nullptr);
+}
+
+TEST_F(PersistentCacheTest, StoresAssetPrefetchManifest) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  ASSERT_TRUE(persistent_cache->LoadAssetPrefetchManifest().empty());
+
+  // Without workers, the manifest is written on this thread.
+  persistent_cache->StoreAssetPrefetchManifest(
+      {"FontManifest.json", "fonts/Roboto.ttf", "invalid\nname", "a/b.png"});
+  ASSERT_EQ(persistent_cache->LoadAssetPrefetchManifest(),
+            (std::vector<std::string>{"FontManifest.json", "fonts/Roboto.ttf",
+                                      "a/b.png"}));
+
+  persistent_cache->StoreAssetPrefetchManifest({});
+  ASSERT_TRUE(persistent_cache->LoadAssetPrefetchManifest().empty());
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+  PersistentCache::ResetCacheForProcess();
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -144,6 +144,35 @@ class Pipeline {
         GetNextPipelineTraceID()};         // trace id
   }
 
+  /// The number of resources that are being produced or that have been
+  /// produced but not consumed yet.
+  int GetInflightCount() const { return inflight_.load(); }
+
+  using Replacer = std::function<void(Resource& latest, const Resource& stale)>;
+
+  // Create a `ProducerContinuation` whose resource replaces all of the
+  // resources that are still waiting to be consumed when it is completed, so
+  // that the consumer always gets the latest resource. Unlike |Produce|, this
+  // succeeds even when the pipeline is full.
+  // |replacer| is called with the completed resource and each of the stale
+  // resources it replaces, oldest first, before they are dropped.
+  ProducerContinuation ProduceLatest(const Replacer& replacer) {
+    // Without a free spot, the resource takes over the spot of a stale one.
+    const bool has_spot = empty_.TryWait();
+    ++inflight_;
+    FML_TRACE_COUNTER("flutter", "Pipeline Depth",
+                      reinterpret_cast<int64_t>(this),      //
+                      "frames in flight", inflight_.load()  //
+    );
+
+    return ProducerContinuation{
+        [this, has_spot, replacer](ResourcePtr resource, size_t trace_id) {
+          return ProducerCommitLatest(std::move(resource), trace_id, has_spot,
+                                      replacer);
+        },                          // continuation
+        GetNextPipelineTraceID()};  // trace id
+  }
+
   using Consumer = std::function<void(ResourcePtr)>;
 
   /// @note Procedure doesn't copy all closures.
@@ -217,6 +246,68 @@ class Pipeline {
     return {.success = true, .is_first_item = true};
   }
 
+  PipelineProduceResult ProducerCommitLatest(ResourcePtr resource,
+                                             size_t trace_id,
+                                             bool has_spot,
+                                             const Replacer& replacer) {
+    if (!resource) {
+      // The continuation was dropped, so there is nothing to replace the
+      // waiting resources with.
+      --inflight_;
+      if (has_spot) {
+        empty_.Signal();
+      }
+      return {.success = false, .is_first_item = false};
+    }
+
+    std::deque<std::pair<ResourcePtr, size_t>> stale;
+    {
+      std::scoped_lock lock(queue_mutex_);
+      stale.swap(queue_);
+      for (const auto& [stale_resource, stale_trace_id] : stale) {
+        if (stale_resource) {
+          replacer(*resource, *stale_resource);
+        }
+      }
+      queue_.emplace_back(std::move(resource), trace_id);
+    }
+
+    const size_t stale_count = stale.size();
+    size_t freed_spots = stale_count;
+    if (!has_spot) {
+      if (stale_count > 0) {
+        freed_spots--;
+      } else {
+        // The resources that filled the pipeline have all been consumed in
+        // the meantime, which freed up their spots.
+        [[maybe_unused]] bool has_freed_spot = empty_.TryWait();
+        FML_DCHECK(has_freed_spot);
+      }
+    }
+    for (size_t i = 0; i < freed_spots; i++) {
+      empty_.Signal();
+    }
+    inflight_ -= stale_count;
+
+    if (stale_count == 0) {
+      available_.Signal();
+    } else {
+      // The consumer was told about each stale resource, but there is only a
+      // single resource left for it.
+      for (size_t i = 1; i < stale_count; i++) {
+        [[maybe_unused]] bool was_available = available_.TryWait();
+        FML_DCHECK(was_available);
+      }
+    }
+
+    for (const auto& [stale_resource, stale_trace_id] : stale) {
+      TRACE_EVENT_INSTANT0("flutter", "PipelineItemReplaced");
+      TRACE_FLOW_END("flutter", "PipelineItem", stale_trace_id);
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", stale_trace_id);
+    }
+    return {.success = true, .is_first_item = stale_count == 0};
+  }
+
   FML_DISALLOW_COPY_AND_ASSIGN(Pipeline);
 };
 
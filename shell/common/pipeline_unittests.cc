@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -144,5 +145,42 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ProduceLatestReplacesResourcesWaitingToBeConsumed) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  std::vector<int> replaced;
+  auto replacer = [&replaced](int& /*latest*/, const int& stale) {
+    replaced.push_back(stale);
+  };
+
+  const int test_val_1 = 1, test_val_2 = 2, test_val_3 = 3;
+  PipelineProduceResult result =
+      pipeline->Produce().Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, true);
+  result = pipeline->Produce().Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result.success, true);
+
+  // The pipeline is full, but the latest resource can still be produced.
+  ASSERT_FALSE(pipeline->Produce());
+  Continuation continuation_3 = pipeline->ProduceLatest(replacer);
+  ASSERT_TRUE(continuation_3);
+  result = continuation_3.Complete(std::make_unique<int>(test_val_3));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, false);
+  ASSERT_EQ(replaced, std::vector<int>({test_val_1, test_val_2}));
+  ASSERT_EQ(pipeline->GetInflightCount(), 1);
+
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [&test_val_3](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_3); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  consume_result = pipeline->Consume([](std::unique_ptr<int> v) { FAIL(); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::NoneAvailable);
+
+  // The spots of the replaced resources are free again.
+  ASSERT_TRUE(pipeline->Produce());
+}
+
 }  // namespace testing
 }  // namespace flutter
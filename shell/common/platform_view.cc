@@ -22,7 +22,10 @@ std::unique_ptr<VsyncWaiter> PlatformView::CreateVSyncWaiter() {
   FML_DLOG(WARNING)
       << "This platform does not provide a Vsync waiter implementation. A "
          "simple timer based fallback is being used.";
-  return std::make_unique<VsyncWaiterFallback>(task_runners_);
+  return std::make_unique<VsyncWaiterFallback>(
+      task_runners_, /*for_testing=*/false, [&delegate = delegate_]() {
+        return delegate.OnPlatformViewGetDisplayRefreshRate();
+      });
 }
 
 void PlatformView::DispatchPlatformMessage(
@@ -99,6 +102,11 @@ std::shared_ptr<impeller::Context> PlatformView::GetImpellerContext() const {
 void PlatformView::ReleaseResourceContext() const {}
 
 PointerDataDispatcherMaker PlatformView::GetDispatcherMaker() {
+  if (delegate_.OnPlatformViewGetSettings().enable_pointer_resampling) {
+    return [](DefaultPointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<ResamplingPointerDataDispatcher>(delegate);
+    };
+  }
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<DefaultPointerDataDispatcher>(delegate);
   };
@@ -157,6 +165,10 @@ void PlatformView::SetNextFrameCallback(const fml::closure& closure) {
   delegate_.OnPlatformViewSetNextFrameCallback(closure);
 }
 
+void PlatformView::NotifyMemoryPressure(MemoryPressureLevel level) {
+  delegate_.OnPlatformViewNotifyMemoryPressure(level);
+}
+
 std::unique_ptr<std::vector<std::string>>
 PlatformView::ComputePlatformResolvedLocales(
     const std::vector<std::string>& supported_locale_data) {
@@ -178,6 +190,15 @@ void PlatformView::LoadDartDeferredLibraryError(
         error_message,  // NOLINT(performance-unnecessary-value-param)
     bool transient) {}
 
+void PlatformView::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  delegate_.PrefetchDartDeferredLibrary(loading_unit_id,
+                                        std::move(snapshot_data),
+                                        std::move(snapshot_instructions));
+}
+
 void PlatformView::UpdateAssetResolverByType(
     std::unique_ptr<AssetResolver> updated_asset_resolver,
     AssetResolver::AssetResolverType type) {
@@ -22,6 +22,8 @@
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/lib/ui/window/pointer_data_packet_converter.h"
 #include "flutter/lib/ui/window/viewport_metrics.h"
+#include "flutter/shell/common/display.h"
+#include "flutter/shell/common/memory_pressure.h"
 #include "flutter/shell/common/platform_message_handler.h"
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -103,6 +105,16 @@ class PlatformView {
     virtual void OnPlatformViewSetNextFrameCallback(
         const fml::closure& closure) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Notifies the delegate that the system is low on memory.
+    ///             The caches of the engine release memory in proportion to
+    ///             the level.
+    ///
+    /// @param[in]  level  How much memory should be released.
+    ///
+    virtual void OnPlatformViewNotifyMemoryPressure(
+        MemoryPressureLevel level) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Notifies the delegate the viewport metrics of the platform
     ///             view have been updated. The rasterizer will need to be
@@ -286,6 +298,18 @@ class PlatformView {
                                               const std::string error_message,
                                               bool transient) = 0;
 
+    //--------------------------------------------------------------------------
+    /// @brief      Faults in the pages of a loading unit in the background and
+    ///             keeps it ready, so that it is loaded without a round trip
+    ///             to the embedder once the Dart VM requests it.
+    ///
+    /// @see        `PlatformView::PrefetchDartDeferredLibrary`
+    ///
+    virtual void PrefetchDartDeferredLibrary(
+        intptr_t loading_unit_id,
+        std::unique_ptr<const fml::Mapping> snapshot_data,
+        std::unique_ptr<const fml::Mapping> snapshot_instructions) = 0;
+
     //--------------------------------------------------------------------------
     /// @brief      Replaces the asset resolver handled by the engine's
     ///             AssetManager of the specified `type` with
@@ -323,6 +347,17 @@ class PlatformView {
     /// @return     The settings.
     ///
     virtual const Settings& OnPlatformViewGetSettings() const = 0;
+
+    //--------------------------------------------------------------------------
+    /// @brief      Called by the vsync waiters that time frames themselves to
+    ///             get the refresh rate of the display the view is presented
+    ///             on, which may be called on any thread.
+    ///
+    /// @return     The refresh rate, or `kUnknownDisplayRefreshRate`.
+    ///
+    virtual double OnPlatformViewGetDisplayRefreshRate() const {
+      return kUnknownDisplayRefreshRate;
+    }
   };
 
   //----------------------------------------------------------------------------
@@ -595,6 +630,17 @@ class PlatformView {
   ///
   void SetNextFrameCallback(const fml::closure& closure);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify the shell that the system is low
+  ///             on memory, for instance when the application moves to the
+  ///             background or the operating system warns that it is about
+  ///             to kill processes. The caches of the engine release memory
+  ///             in proportion to the level.
+  ///
+  /// @param[in]  level  How much memory should be released.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level);
+
   //----------------------------------------------------------------------------
   /// @brief      Dispatches pointer events from the embedder to the
   ///             framework. Each pointer data packet may contain multiple
@@ -768,6 +814,32 @@ class PlatformView {
                                             const std::string error_message,
                                             bool transient);
 
+  //--------------------------------------------------------------------------
+  /// @brief      Hints that a deferred library is going to be loaded soon.
+  ///             The pages of its snapshot are faulted in on a background
+  ///             thread, and the mappings are kept ready. When the Dart VM
+  ///             then requests the loading unit with
+  ///             `RequestDartDeferredLibrary`, it is loaded from these
+  ///             mappings without being requested from the embedder.
+  ///
+  ///             Embedders open and resolve the mappings the same way as for
+  ///             `LoadDartDeferredLibrary`, ideally off of the platform
+  ///             thread.
+  ///
+  /// @param[in]  loading_unit_id  The unique id of the deferred library's
+  ///                              loading unit.
+  ///
+  /// @param[in]  snapshot_data    Dart snapshot data of the loading unit's
+  ///                              shared library.
+  ///
+  /// @param[in]  snapshot_instructions  Dart snapshot instructions of the
+  ///                                    loading unit's shared library.
+  ///
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions);
+
   //--------------------------------------------------------------------------
   /// @brief      Replaces the asset resolver handled by the engine's
   ///             AssetManager of the specified `type` with
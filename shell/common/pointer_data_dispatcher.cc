@@ -4,6 +4,9 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+#include <string>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +18,14 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+ResamplingPointerDataDispatcher::ResamplingPointerDataDispatcher(
+    Delegate& delegate,
+    fml::TimeDelta prediction)
+    : DefaultPointerDataDispatcher(delegate),
+      prediction_(prediction),
+      weak_factory_(this) {}
+ResamplingPointerDataDispatcher::~ResamplingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -68,4 +79,129 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+namespace {
+
+bool CanCoalesce(const PointerData& data) {
+  return (data.change == PointerData::Change::kHover ||
+          data.change == PointerData::Change::kMove) &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+}  // namespace
+
+void ResamplingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "ResamplingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  if (pending_events_.empty()) {
+    ScheduleSecondaryVsyncCallback();
+  }
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    pending_events_.push_back(packet->GetPointerData(i));
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->DispatchPendingEvents();
+        }
+      });
+}
+
+void ResamplingPointerDataDispatcher::DispatchPendingEvents() {
+  if (pending_events_.empty()) {
+    return;
+  }
+  TRACE_EVENT1("flutter",
+               "ResamplingPointerDataDispatcher::DispatchPendingEvents",
+               "events", std::to_string(pending_events_.size()).c_str());
+
+  std::vector<PointerData> events;
+  events.reserve(pending_events_.size());
+  // The index in |events| of the event that the next hover or move event of
+  // each pointer is coalesced into.
+  std::unordered_map<int64_t, size_t> coalesced_indices;
+  for (const PointerData& data : pending_events_) {
+    PointerState& state = pointer_states_[data.device];
+    if (!CanCoalesce(data)) {
+      coalesced_indices.erase(data.device);
+      state.sample_count = 0;
+      events.push_back(data);
+      continue;
+    }
+
+    state.samples[1] = state.samples[0];
+    state.samples[0] = {data.time_stamp, data.physical_x, data.physical_y};
+    state.sample_count = std::min<size_t>(state.sample_count + 1, 2);
+
+    auto found = coalesced_indices.find(data.device);
+    if (found != coalesced_indices.end() &&
+        events[found->second].change == data.change) {
+      events[found->second] = data;
+    } else {
+      coalesced_indices[data.device] = events.size();
+      events.push_back(data);
+    }
+  }
+
+  for (const auto& [device, index] : coalesced_indices) {
+    PredictPosition(pointer_states_[device], events[index]);
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    PointerData& data = events[i];
+    PointerState& state = pointer_states_[data.device];
+    if (CanCoalesce(data) && state.has_dispatched_position) {
+      // Cover the coalesced events, and undo the previous prediction.
+      data.physical_delta_x = data.physical_x - state.dispatched_x;
+      data.physical_delta_y = data.physical_y - state.dispatched_y;
+    }
+    state.has_dispatched_position = true;
+    state.dispatched_x = data.physical_x;
+    state.dispatched_y = data.physical_y;
+    if (data.change == PointerData::Change::kRemove) {
+      pointer_states_.erase(data.device);
+    }
+    packet->SetPointerData(i, data);
+  }
+
+  // The coalesced packets end their flows here, the last one is dispatched.
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t coalesced_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", coalesced_trace_flow_id);
+  }
+  pending_events_.clear();
+  pending_trace_flow_ids_.clear();
+
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+void ResamplingPointerDataDispatcher::PredictPosition(
+    const PointerState& state,
+    PointerData& data) const {
+  if (state.sample_count < 2 || prediction_ <= fml::TimeDelta::Zero()) {
+    return;
+  }
+  const Sample& newest = state.samples[0];
+  const Sample& previous = state.samples[1];
+  const int64_t interval = newest.time_stamp - previous.time_stamp;
+  if (interval <= 0 || interval > kMaxSampleInterval.ToMicroseconds()) {
+    return;
+  }
+  const int64_t prediction = prediction_.ToMicroseconds();
+  const double scale = static_cast<double>(prediction) / interval;
+  data.physical_x = newest.x + (newest.x - previous.x) * scale;
+  data.physical_y = newest.y + (newest.y - previous.y) * scale;
+  data.time_stamp = newest.time_stamp + prediction;
+}
+
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -163,6 +166,73 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that buffers the events it receives and dispatches them in a
+/// single packet at the next VSYNC, which keeps high rate (240Hz and more)
+/// touch and stylus input from flooding the UI thread with packets.
+///
+/// Consecutive hover or move events of a pointer are coalesced into the last
+/// of them, whose delta covers all of them. The position of the last
+/// coalesced event of each pointer is then predicted |prediction| ahead of
+/// its time stamp from the velocity of its two most recent samples, which
+/// makes up for the time that the event spends waiting to be dispatched and
+/// for the time until the frame is presented. All other events, such as down
+/// and up events, are dispatched as they are and in order.
+///
+/// The dispatcher doesn't know the target time of the frame in the clock of
+/// the event time stamps, so the prediction is a fixed duration. Samples
+/// further apart than |kMaxSampleInterval| aren't used for predictions, since
+/// the pointer has likely changed its speed since then.
+class ResamplingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  static constexpr fml::TimeDelta kDefaultPrediction =
+      fml::TimeDelta::FromMilliseconds(8);
+  static constexpr fml::TimeDelta kMaxSampleInterval =
+      fml::TimeDelta::FromMilliseconds(20);
+
+  explicit ResamplingPointerDataDispatcher(
+      Delegate& delegate,
+      fml::TimeDelta prediction = kDefaultPrediction);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~ResamplingPointerDataDispatcher();
+
+ private:
+  struct Sample {
+    int64_t time_stamp = 0;
+    double x = 0;
+    double y = 0;
+  };
+
+  struct PointerState {
+    // The two most recent samples of a hovering or moving pointer, newest
+    // first.
+    Sample samples[2];
+    size_t sample_count = 0;
+    // The position of the last event that was dispatched for the pointer,
+    // which the delta of the next coalesced event is relative to.
+    bool has_dispatched_position = false;
+    double dispatched_x = 0;
+    double dispatched_y = 0;
+  };
+
+  void DispatchPendingEvents();
+  void ScheduleSecondaryVsyncCallback();
+  void PredictPosition(const PointerState& state, PointerData& data) const;
+
+  const fml::TimeDelta prediction_;
+  std::vector<PointerData> pending_events_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  std::unordered_map<int64_t, PointerState> pointer_states_;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<ResamplingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(ResamplingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
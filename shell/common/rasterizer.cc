@@ -9,11 +9,22 @@
 #include <utility>
 
 #include "flow/frame_timings.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/offscreen_surface.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/serialization_callbacks.h"
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/aiks/aiks_context.h"
+#include "flutter/impeller/entity/contents/content_context.h"
+#include "flutter/impeller/renderer/allocator.h"
+#include "flutter/impeller/renderer/gpu_tracer.h"
+#include "flutter/impeller/renderer/pipeline_library.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 #include "fml/make_copyable.h"
 #include "third_party/skia/include/core/SkImageEncoder.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
@@ -28,6 +39,17 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// How often pending asynchronous raster image conversions are checked on.
+static constexpr fml::TimeDelta kRasterImageConversionCheckInterval =
+    fml::TimeDelta::FromMilliseconds(1);
+// The external view embedder repaints its layers in at most this many rects,
+// which saves the overdraw of a bounding rect around damage far apart.
+static constexpr size_t kMaxExternalViewEmbedderDamageRects = 4u;
+// Under moderate memory pressure, resources that weren't used for the last
+// frames are released.
+static constexpr std::chrono::milliseconds kModeratePressureCleanupExpiration(
+    1000);
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -64,8 +86,44 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->GetContentContext().SetEntityBatchingEnabled(
+        delegate_.GetSettings().impeller_enable_entity_batching);
+
+    // Like the SkSLs of Skia, the pipeline variants drawn in previous runs
+    // start compiling before the first frame needs them.
+    std::vector<impeller::ContentContext::PipelineVariant> variants;
+    if (auto manifest = PersistentCache::GetCacheForProcess()
+                            ->LoadImpellerPipelineManifest()) {
+      variants =
+          impeller::ContentContext::DeserializePipelineVariants(*manifest);
+    }
+    aiks_context->GetContentContext().PrewarmPipelineVariants(variants);
+    stored_pipeline_variant_count_ = variants.size();
+    last_pipeline_variant_count_ = 0;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+  if (surface_->GetAiksContext()) {
+    // Impeller renders the images of the raster cache into textures of its
+    // own, the same way that it renders snapshots.
+    compositor_context_->raster_cache().SetDisplayListRasterizer(
+        [this](sk_sp<DisplayList> display_list, const SkISize& size) {
+          return snapshot_controller_->MakeRasterSnapshot(
+              std::move(display_list), size);
+        });
+  } else {
+    compositor_context_->raster_cache().SetDisplayListRasterizer(nullptr);
+    if (delegate_.GetSettings().enable_raster_cache_atlasing &&
+        !compositor_context_->raster_cache().atlasing_enabled()) {
+      compositor_context_->raster_cache().EnableAtlasing();
+    }
+  }
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
+      !external_view_embedder_->SupportsAsyncComposition() &&
       !raster_thread_merger_) {
     const auto platform_id =
         delegate_.GetTaskRunners().GetPlatformTaskRunner()->GetTaskQueueId();
@@ -124,23 +182,155 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
   }
 }
 
-void Rasterizer::NotifyLowMemoryWarning() const {
+void Rasterizer::NotifyLowMemoryWarning() {
+  TrimMemory(MemoryPressureLevel::kCritical);
+}
+
+void Rasterizer::TrimMemory(MemoryPressureLevel level) {
+  auto& raster_cache = compositor_context_->raster_cache();
+  if (level == MemoryPressureLevel::kBackground) {
+    raster_cache.Clear();
+  } else {
+    // Entries that were rasterized for the last frame are likely to be drawn
+    // again, and rasterizing them again would cost a janky frame.
+    raster_cache.EvictUnusedCacheEntries();
+  }
+
   if (!surface_) {
-    FML_DLOG(INFO)
-        << "Rasterizer::NotifyLowMemoryWarning called with no surface.";
+    FML_DLOG(INFO) << "Rasterizer::TrimMemory called with no surface.";
+    return;
+  }
+
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    if (level != MemoryPressureLevel::kModerate) {
+      aiks_context->GetContentContext().ReleaseCachedResources();
+    }
     return;
   }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   auto context = surface_->GetContext();
   if (!context) {
-    FML_DLOG(INFO)
-        << "Rasterizer::NotifyLowMemoryWarning called with no GrContext.";
+    FML_DLOG(INFO) << "Rasterizer::TrimMemory called with no GrContext.";
     return;
   }
   auto context_switch = surface_->MakeRenderContextCurrent();
   if (!context_switch->GetResult()) {
     return;
   }
-  context->performDeferredCleanup(std::chrono::milliseconds(0));
+  switch (level) {
+    case MemoryPressureLevel::kModerate:
+      context->performDeferredCleanup(kModeratePressureCleanupExpiration);
+      break;
+    case MemoryPressureLevel::kCritical:
+      context->performDeferredCleanup(std::chrono::milliseconds(0));
+      break;
+    case MemoryPressureLevel::kBackground:
+      context->freeGpuResources();
+      break;
+  }
+}
+
+void Rasterizer::ReportResidentCacheBytes(ResidentCacheBytes& report) const {
+  const auto& raster_cache = compositor_context_->raster_cache();
+  report["rasterCache"] = raster_cache.EstimateLayerCacheByteSize() +
+                          raster_cache.EstimatePictureCacheByteSize();
+  if (!surface_) {
+    return;
+  }
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    report["impellerCaches"] =
+        aiks_context->GetContentContext().GetCachedResourceBytes();
+    return;
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  if (auto context = surface_->GetContext()) {
+    size_t resource_bytes = 0;
+    context->getResourceCacheUsage(nullptr, &resource_bytes);
+    report["skiaResources"] = resource_bytes;
+  }
+}
+
+#if IMPELLER_SUPPORTS_RENDERING
+static GpuMemoryUsage ToGpuMemoryUsage(
+    const impeller::AllocationTracker::Stats& stats) {
+  return {
+      .live_bytes = stats.live_bytes,
+      .frame_peak_bytes = stats.last_frame_peak_bytes,
+      .peak_bytes = stats.peak_bytes,
+  };
+}
+
+static impeller::AllocationTracker* GetAllocationTracker(
+    impeller::AiksContext* aiks_context) {
+  if (!aiks_context) {
+    return nullptr;
+  }
+  return aiks_context->GetContext()
+      ->GetResourceAllocator()
+      ->GetAllocationTracker()
+      .get();
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+std::map<std::string, GpuMemoryUsage> Rasterizer::GetGpuMemoryUsage() const {
+  std::map<std::string, GpuMemoryUsage> usage;
+#if IMPELLER_SUPPORTS_RENDERING
+  if (!surface_) {
+    return usage;
+  }
+  if (auto tracker = GetAllocationTracker(surface_->GetAiksContext())) {
+    for (size_t i = 0; i < impeller::AllocationTracker::kCategoryCount; i++) {
+      auto category = static_cast<impeller::AllocationCategory>(i);
+      usage[impeller::AllocationCategoryToString(category)] =
+          ToGpuMemoryUsage(tracker->GetStats(category));
+    }
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  return usage;
+}
+
+static void CollectLayerCanvasStatistics(
+    const Layer* layer,
+    std::vector<Rasterizer::LayerCanvasStatistics>& layer_statistics) {
+  if (auto container = layer->as_container_layer()) {
+    for (const auto& child : container->layers()) {
+      CollectLayerCanvasStatistics(child.get(), layer_statistics);
+    }
+    return;
+  }
+  auto display_list_layer = layer->as_display_list_layer();
+  if (!display_list_layer || !display_list_layer->display_list()) {
+    return;
+  }
+  const DisplayList* display_list = display_list_layer->display_list();
+  SkIRect bounds = display_list->bounds().roundOut();
+  if (bounds.isEmpty()) {
+    return;
+  }
+  // Skia skips the operations that are outside of the canvas, so the canvas
+  // covers all of the display list.
+  CanvasSpy spy(nullptr, bounds.size());
+  SkCanvas* canvas = spy.GetRawSpyingCanvas();
+  canvas->translate(-bounds.left(), -bounds.top());
+  display_list->RenderTo(canvas);
+  Rasterizer::LayerCanvasStatistics statistics;
+  statistics.layer_id = layer->original_layer_id();
+  statistics.paint_bounds = layer->paint_bounds();
+  statistics.statistics = spy.GetStatistics();
+  layer_statistics.push_back(statistics);
+}
+
+std::vector<Rasterizer::LayerCanvasStatistics>
+Rasterizer::GetLastLayerTreeCanvasStatistics() const {
+  std::vector<LayerCanvasStatistics> layer_statistics;
+  if (last_layer_tree_ && last_layer_tree_->root_layer()) {
+    CollectLayerCanvasStatistics(last_layer_tree_->root_layer(),
+                                 layer_statistics);
+  }
+  return layer_statistics;
 }
 
 std::shared_ptr<flutter::TextureRegistry> Rasterizer::GetTextureRegistry() {
@@ -362,10 +552,61 @@ sk_sp<SkImage> Rasterizer::ConvertToRasterImage(sk_sp<SkImage> image) {
   return snapshot_controller_->ConvertToRasterImage(image);
 }
 
+// |SnapshotDelegate|
+void Rasterizer::ConvertToRasterImageAsync(
+    sk_sp<SkImage> image,
+    std::function<void(sk_sp<SkImage>)> callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  snapshot_controller_->ConvertToRasterImageAsync(std::move(image),
+                                                  std::move(callback));
+  ScheduleRasterImageConversionCheck();
+}
+
+void Rasterizer::ScheduleRasterImageConversionCheck() {
+  if (raster_image_conversion_check_scheduled_) {
+    return;
+  }
+  raster_image_conversion_check_scheduled_ = true;
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (!weak_this) {
+          return;
+        }
+        weak_this->raster_image_conversion_check_scheduled_ = false;
+        if (weak_this->snapshot_controller_->CheckRasterImageConversions()) {
+          weak_this->ScheduleRasterImageConversionCheck();
+        }
+      },
+      kRasterImageConversionCheckInterval);
+}
+
 fml::Milliseconds Rasterizer::GetFrameBudget() const {
   return delegate_.GetFrameBudget();
 };
 
+void Rasterizer::StoreImpellerPipelineManifestIfNeeded() {
+#if IMPELLER_SUPPORTS_RENDERING
+  auto aiks_context = surface_->GetAiksContext();
+  if (!aiks_context) {
+    return;
+  }
+  const auto& content_context = aiks_context->GetContentContext();
+  size_t count = content_context.GetRequestedPipelineVariantCount();
+  // Frames that draw new variants are usually followed by more of them, so
+  // the manifest is only written once they settle. It isn't replaced by one
+  // of fewer variants, such as early in a run that prewarmed them.
+  bool settled = count == last_pipeline_variant_count_;
+  last_pipeline_variant_count_ = count;
+  if (!settled || count <= stored_pipeline_variant_count_) {
+    return;
+  }
+  PersistentCache::GetCacheForProcess()->StoreImpellerPipelineManifest(
+      impeller::ContentContext::SerializePipelineVariants(
+          content_context.GetRequestedPipelineVariants()));
+  stored_pipeline_variant_count_ = count;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 RasterStatus Rasterizer::DoDraw(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
     std::shared_ptr<flutter::LayerTree> layer_tree) {
@@ -382,10 +623,36 @@ RasterStatus Rasterizer::DoDraw(
   PersistentCache* persistent_cache = PersistentCache::GetCacheForProcess();
   persistent_cache->ResetStoredNewShaders();
 
-  RasterStatus raster_status =
-      DrawToSurface(*frame_timings_recorder, *layer_tree);
-  if (raster_status == RasterStatus::kSuccess) {
+  const bool adaptive_raster_quality =
+      delegate_.GetSettings().enable_adaptive_raster_quality;
+  compositor_context_->set_reduce_raster_quality(
+      adaptive_raster_quality && raster_quality_policy_.reduces_quality());
+
+  RasterStatus raster_status;
+  if (delegate_.GetSettings().skip_unchanged_frames &&
+      IsUnchangedFromLastLayerTree(*layer_tree)) {
+    TRACE_EVENT0("flutter", "Rasterizer::SkipUnchangedFrame");
+    frame_timings_recorder->RecordRasterStart(fml::TimePoint::Now());
+    frame_timings_recorder->RecordRasterEnd(
+        &compositor_context_->raster_cache());
+    FireNextFrameCallbackIfPresent();
+    raster_status = RasterStatus::kSkipped;
+  } else {
+    raster_status = DrawToSurface(*frame_timings_recorder, *layer_tree);
+  }
+  diffed_frame_damage_.reset();
+  if (raster_status == RasterStatus::kSkipped) {
+    // The next layer tree is diffed against this one, whose paint regions
+    // match the pixels on screen.
+    last_layer_tree_ = std::move(layer_tree);
+  } else if (raster_status == RasterStatus::kSuccess) {
     last_layer_tree_ = std::move(layer_tree);
+    if (adaptive_raster_quality) {
+      raster_quality_policy_.RecordFrame(
+          frame_timings_recorder->GetRasterEndTime() -
+              frame_timings_recorder->GetRasterStartTime(),
+          delegate_.GetFrameBudget());
+    }
   } else if (ShouldResubmitFrame(raster_status)) {
     resubmitted_layer_tree_ = std::move(layer_tree);
     resubmitted_recorder_ = frame_timings_recorder->CloneUntil(
@@ -395,6 +662,11 @@ RasterStatus Rasterizer::DoDraw(
     return raster_status;
   }
 
+  StoreImpellerPipelineManifestIfNeeded();
+  if (raster_status == RasterStatus::kSuccess) {
+    CaptureLastLayerTreeIfNeeded();
+  }
+
   if (persistent_cache->IsDumpingSkp() &&
       persistent_cache->StoredNewShaders()) {
     auto screenshot =
@@ -467,6 +739,41 @@ RasterStatus Rasterizer::DoDraw(
   return raster_status;
 }
 
+bool Rasterizer::IsUnchangedFromLastLayerTree(flutter::LayerTree& layer_tree) {
+  if (!layer_tree.root_layer() || layer_tree.is_leaf_layer_tracing_enabled()) {
+    return false;
+  }
+  // Layer trees that were not diffed have no paint regions to diff against.
+  // Platform views are composited by the embedder, and may change while
+  // their layers don't.
+  const bool can_diff_last_layer_tree =
+      last_layer_tree_ && last_layer_tree_->root_layer() &&
+      !last_layer_tree_->paint_region_map().empty() &&
+      !last_layer_tree_->root_layer()->subtree_has_platform_view() &&
+      last_layer_tree_->frame_size() == layer_tree.frame_size() &&
+      last_layer_tree_->device_pixel_ratio() ==
+          layer_tree.device_pixel_ratio();
+
+  // The diff also covers a retained root layer cheaply, since the subtrees
+  // of retained layers are only diffed when they contain textures. It is
+  // made with the options that the damage of the frame is likely to use, so
+  // that the frame doesn't diff the layer trees again.
+  diffed_frame_damage_ = std::make_unique<FrameDamage>();
+  if (can_diff_last_layer_tree) {
+    diffed_frame_damage_->SetPreviousLayerTree(last_layer_tree_.get());
+  }
+  if (external_view_embedder_ &&
+      external_view_embedder_->SupportsPartialRepaint()) {
+    diffed_frame_damage_->SetMaxDamageRects(
+        kMaxExternalViewEmbedderDamageRects);
+  }
+  diffed_frame_damage_->ComputeClipRect(layer_tree,
+                                        surface_->EnableRasterCache());
+  std::optional<SkIRect> frame_damage = diffed_frame_damage_->GetFrameDamage();
+  return can_diff_last_layer_tree && frame_damage.has_value() &&
+         frame_damage->isEmpty();
+}
+
 RasterStatus Rasterizer::DrawToSurface(
     FrameTimingsRecorder& frame_timings_recorder,
     flutter::LayerTree& layer_tree) {
@@ -532,6 +839,15 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   auto root_surface_canvas =
       embedder_root_canvas ? embedder_root_canvas : frame->Canvas();
 
+#if IMPELLER_SUPPORTS_RENDERING
+  // The allocations of this frame are yet to be made, so the performance
+  // overlay shows those of the last frame.
+  if (auto tracker = GetAllocationTracker(surface_->GetAiksContext())) {
+    compositor_context_->set_gpu_memory_usage(
+        ToGpuMemoryUsage(tracker->GetTotalStats()));
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   auto compositor_frame = compositor_context_->AcquireFrame(
       surface_->GetContext(),         // skia GrContext
       root_surface_canvas,            // root surface canvas
@@ -547,18 +863,44 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   if (compositor_frame) {
     compositor_context_->raster_cache().BeginFrame();
 
+    bool ignore_raster_cache = true;
+    if (surface_->EnableRasterCache() &&
+        !layer_tree.is_leaf_layer_tracing_enabled()) {
+      ignore_raster_cache = false;
+    }
+
     std::unique_ptr<FrameDamage> damage;
+    const bool submits_to_external_view_embedder =
+        external_view_embedder_ &&
+        (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
     // when leaf layer tracing is enabled we wish to repaint the whole frame
     // for accurate performance metrics.
-    if (frame->framebuffer_info().supports_partial_repaint &&
+    if (submits_to_external_view_embedder &&
+        external_view_embedder_->SupportsPartialRepaint() &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
+      // The embedder repaints the damaged parts of each of its layers, so the
+      // frame is recorded in full and it is told what changed.
+      FrameDamage embedder_damage;
+      if (last_layer_tree_ && !last_layer_tree_->paint_region_map().empty()) {
+        embedder_damage.SetPreviousLayerTree(last_layer_tree_.get());
+      }
+      embedder_damage.SetMaxDamageRects(kMaxExternalViewEmbedderDamageRects);
+      if (diffed_frame_damage_) {
+        embedder_damage.ReuseDiff(*diffed_frame_damage_);
+      }
+      embedder_damage.ComputeClipRect(layer_tree, !ignore_raster_cache);
+      std::optional<std::vector<SkIRect>> frame_damage_rects;
+      if (embedder_damage.GetFrameDamage().has_value()) {
+        frame_damage_rects = embedder_damage.GetFrameDamageRects();
+      }
+      external_view_embedder_->SetFrameDamage(std::move(frame_damage_rects));
+    } else if (frame->framebuffer_info().supports_partial_repaint &&
+               !layer_tree.is_leaf_layer_tracing_enabled()) {
       // Disable partial repaint if external_view_embedder_ SubmitFrame is
       // involved - ExternalViewEmbedder unconditionally clears the entire
       // surface and also partial repaint with platform view present is
       // something that still need to be figured out.
-      bool force_full_repaint =
-          external_view_embedder_ &&
-          (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
+      bool force_full_repaint = submits_to_external_view_embedder;
 
       damage = std::make_unique<FrameDamage>();
       if (frame->framebuffer_info().existing_damage && !force_full_repaint) {
@@ -567,13 +909,14 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
             frame->framebuffer_info().vertical_clip_alignment);
+        damage->SetMaxDamageRects(frame->framebuffer_info().max_damage_rects);
+      }
+      if (delegate_.GetSettings().visualize_frame_damage) {
+        damage->EnableDamageVisualization(last_visualized_damage_);
+      }
+      if (diffed_frame_damage_) {
+        damage->ReuseDiff(*diffed_frame_damage_);
       }
-    }
-
-    bool ignore_raster_cache = true;
-    if (surface_->EnableRasterCache() &&
-        !layer_tree.is_leaf_layer_tracing_enabled()) {
-      ignore_raster_cache = false;
     }
 
     RasterStatus raster_status =
@@ -585,6 +928,11 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
         raster_status == RasterStatus::kSkipAndRetry) {
       return raster_status;
     }
+    for (auto phase : {FrameTiming::kDiff, FrameTiming::kPreroll,
+                       FrameTiming::kPaint}) {
+      frame_timings_recorder.RecordRasterPhase(
+          phase, compositor_frame->GetRasterPhaseDuration(phase));
+    }
 
     SurfaceFrame::SubmitInfo submit_info;
     // TODO (https://github.com/flutter/flutter/issues/105596): this can be in
@@ -595,34 +943,49 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     if (presentation_time > fml::TimePoint::Now()) {
       submit_info.presentation_time = presentation_time;
     }
+    submit_info.frame_target_time = presentation_time;
     if (damage) {
       submit_info.frame_damage = damage->GetFrameDamage();
       submit_info.buffer_damage = damage->GetBufferDamage();
+      submit_info.frame_damage_rects = damage->GetFrameDamageRects();
+      submit_info.buffer_damage_rects = damage->GetBufferDamageRects();
+      last_visualized_damage_ = damage->GetVisualizedDamage();
     }
 
     frame->set_submit_info(submit_info);
 
-    if (external_view_embedder_ &&
-        (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
+    fml::TimePoint submit_start = fml::TimePoint::Now();
+    if (submits_to_external_view_embedder) {
       FML_DCHECK(!frame->IsSubmitted());
       external_view_embedder_->SubmitFrame(surface_->GetContext(),
                                            std::move(frame));
     } else {
       frame->Submit();
     }
+    frame_timings_recorder.RecordRasterPhase(
+        FrameTiming::kSubmit, fml::TimePoint::Now() - submit_start);
 
     // Do not update raster cache metrics for kResubmit because that status
     // indicates that the frame was not actually painted.
     if (raster_status != RasterStatus::kResubmit) {
       compositor_context_->raster_cache().EndFrame();
+      RecordFrameStatistics();
     }
 
     frame_timings_recorder.RecordRasterEnd(
         &compositor_context_->raster_cache());
     FireNextFrameCallbackIfPresent();
 
-    if (surface_->GetContext()) {
-      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+    if (auto context = surface_->GetContext()) {
+      context->performDeferredCleanup(kSkiaCleanupExpiration);
+
+      size_t resource_bytes = 0;
+      context->getResourceCacheUsage(nullptr, &resource_bytes);
+      size_t purgeable_bytes = context->getResourceCachePurgeableBytes();
+      size_t working_set_bytes =
+          resource_bytes - std::min(resource_bytes, purgeable_bytes);
+      peak_resource_cache_working_set_bytes_ = std::max(
+          peak_resource_cache_working_set_bytes_, working_set_bytes);
     }
 
     return raster_status;
@@ -662,6 +1025,92 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
   return recorder.finishRecordingAsPicture()->serialize(&procs);
 }
 
+void Rasterizer::RecordFrameStatistics() {
+  auto& statistics = compositor_context_->frame_statistics();
+  const auto& raster_cache = compositor_context_->raster_cache();
+  const auto& layer_metrics = raster_cache.layer_metrics();
+  const auto& picture_metrics = raster_cache.picture_metrics();
+  const size_t hits = layer_metrics.in_use_count + picture_metrics.in_use_count;
+  const size_t misses =
+      layer_metrics.uncached_count + picture_metrics.uncached_count;
+  if (hits + misses > 0) {
+    statistics.raster_cache_hit_percent.AddSample(100.0 * hits /
+                                                  (hits + misses));
+  }
+  statistics.raster_cache_bytes.AddSample(
+      static_cast<double>(layer_metrics.total_bytes() +
+                          picture_metrics.total_bytes()) /
+      kMegaByteSizeInBytes);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  auto aiks_context = surface_ ? surface_->GetAiksContext() : nullptr;
+  if (!aiks_context) {
+    return;
+  }
+  const auto& context = aiks_context->GetContext();
+  if (auto tracer = context->GetGPUTracer()) {
+    // GPU times are only known a few frames later.
+    if (auto gpu_time = tracer->GetLastFrameGPUTime()) {
+      statistics.gpu_time_ms.AddSample(gpu_time->ToMillisecondsF());
+    }
+  }
+  const RendererWorkCounts counts = {
+      .render_pass_count = context->GetEncodeStats().render_pass_count,
+      .glyph_atlas_upload_count = context->GetGlyphAtlasUploadCount(),
+      .pipeline_compile_count =
+          context->GetPipelineLibrary()->GetPipelineCompileCount(),
+  };
+  const auto& last = last_renderer_work_counts_;
+  // One of the passes of each frame renders to the surface.
+  const size_t pass_count = counts.render_pass_count - last.render_pass_count;
+  statistics.offscreen_passes.AddSample(pass_count > 0 ? pass_count - 1 : 0);
+  statistics.glyph_atlas_uploads.AddSample(counts.glyph_atlas_upload_count -
+                                           last.glyph_atlas_upload_count);
+  statistics.pipeline_compiles.AddSample(counts.pipeline_compile_count -
+                                         last.pipeline_compile_count);
+  last_renderer_work_counts_ = counts;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void Rasterizer::CaptureLastLayerTreeIfNeeded() {
+  const std::string& path = delegate_.GetSettings().frame_capture_path;
+  if (path.empty() || !last_layer_tree_) {
+    return;
+  }
+  if (!frame_capture_directory_) {
+    frame_capture_directory_ =
+        std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+            path.c_str(), true, fml::FilePermission::kReadWrite));
+    if (!frame_capture_directory_->is_valid()) {
+      FML_LOG(ERROR) << "Could not open the frame capture directory " << path;
+    }
+  }
+  if (!frame_capture_directory_->is_valid()) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "Rasterizer::CaptureLastLayerTree");
+
+  sk_sp<SkData> picture = ScreenshotLayerTreeAsPicture(last_layer_tree_.get(),
+                                                       *compositor_context_);
+  if (!picture) {
+    return;
+  }
+  // Zero padded so that the frames sort in the order they were drawn.
+  std::string number = std::to_string(captured_frame_count_++);
+  std::string file_name =
+      "frame_" + std::string(number.size() < 6 ? 6 - number.size() : 0, '0') +
+      number + ".skp";
+  auto mapping = std::make_unique<fml::DataMapping>(std::vector<uint8_t>{
+      picture->bytes(), picture->bytes() + picture->size()});
+  delegate_.GetTaskRunners().GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [directory = frame_capture_directory_, file_name = std::move(file_name),
+       mapping = std::move(mapping)]() {
+        if (!fml::WriteAtomically(*directory, file_name.c_str(), *mapping)) {
+          FML_LOG(ERROR) << "Could not write the captured frame " << file_name;
+        }
+      }));
+}
+
 sk_sp<SkData> Rasterizer::ScreenshotLayerTreeAsImage(
     flutter::LayerTree* tree,
     flutter::CompositorContext& compositor_context,
@@ -819,6 +1268,10 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 }
 
+size_t Rasterizer::TakePeakResourceCacheWorkingSetBytes() {
+  return std::exchange(peak_resource_cache_working_set_bytes_, 0);
+}
+
 std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   if (!surface_) {
     return std::nullopt;
@@ -5,8 +5,11 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -15,6 +18,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/raster_quality_policy.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -23,7 +27,10 @@
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/fml/unique_fd.h"
 #include "flutter/lib/ui/snapshot_delegate.h"
+#include "flutter/shell/common/canvas_spy.h"
+#include "flutter/shell/common/memory_pressure.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
@@ -48,7 +55,8 @@ namespace flutter {
 ///
 class Rasterizer final : public SnapshotDelegate,
                          public Stopwatch::RefreshRateUpdater,
-                         public SnapshotController::Delegate {
+                         public SnapshotController::Delegate,
+                         public MemoryPressureListener {
  public:
   //----------------------------------------------------------------------------
   /// @brief      Used to forward events from the rasterizer to interested
@@ -175,7 +183,59 @@ class Rasterizer final : public SnapshotDelegate,
   ///             Currently, the Skia context associated with onscreen rendering
   ///             is told to free GPU resources.
   ///
-  void NotifyLowMemoryWarning() const;
+  ///             This is equivalent to trimming memory with
+  ///             `MemoryPressureLevel::kCritical`.
+  ///
+  void NotifyLowMemoryWarning();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the layers and pictures cached for rasterization
+  ///             and the resources cached by the GPU context in proportion
+  ///             to the memory pressure.
+  ///
+  ///             At `kModerate`, only what was not used to render the last
+  ///             frame is released. At `kCritical`, all of the resources that
+  ///             are not in use are released, and at `kBackground` the raster
+  ///             cache is cleared as well.
+  ///
+  // |MemoryPressureListener|
+  void TrimMemory(MemoryPressureLevel level) override;
+
+  // |MemoryPressureListener|
+  void ReportResidentCacheBytes(ResidentCacheBytes& report) const override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The GPU memory used by each category of the allocations of
+  ///             the renderer, keyed by the name of the category.
+  ///
+  /// @return     The usage of each category, or nothing if the renderer
+  ///             doesn't account for its allocations, as is the case for
+  ///             Skia.
+  ///
+  std::map<std::string, GpuMemoryUsage> GetGpuMemoryUsage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The drawing operations of a picture layer of the last layer
+  ///             tree.
+  ///
+  struct LayerCanvasStatistics {
+    /// The id of the layer, which is kept by the layers that replace it in
+    /// later frames.
+    uint64_t layer_id = 0;
+    SkRect paint_bounds = SkRect::MakeEmpty();
+    CanvasStatistics statistics;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collects the drawing operations of each of the picture layers
+  ///             of the last layer tree by playing their display lists back
+  ///             into a |CanvasSpy|, so that the layers that are expensive to
+  ///             draw can be found.
+  ///
+  /// @return     The statistics of each picture layer, in paint order, or
+  ///             nothing if this rasterizer has never rendered a frame.
+  ///
+  std::vector<LayerCanvasStatistics> GetLastLayerTreeCanvasStatistics() const;
 
   //----------------------------------------------------------------------------
   /// @brief      Gets a weak pointer to the rasterizer. The rasterizer may only
@@ -458,6 +518,17 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The largest number of bytes of resources in Skia's resource
+  ///             cache that were in use at the end of a frame, rather than
+  ///             purgeable, since the last call. A cache limit below this
+  ///             makes Skia evict and recreate resources every frame.
+  ///
+  /// @return     The peak working set of the resource cache, or zero if no
+  ///             frame was rendered with a GrContext since the last call.
+  ///
+  size_t TakePeakResourceCacheWorkingSetBytes();
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -495,6 +566,15 @@ class Rasterizer final : public SnapshotDelegate,
   // |SnapshotDelegate|
   sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  // |SnapshotDelegate|
+  void ConvertToRasterImageAsync(
+      sk_sp<SkImage> image,
+      std::function<void(sk_sp<SkImage>)> callback) override;
+
+  // Checks on the pending asynchronous raster image conversions until they
+  // have all completed.
+  void ScheduleRasterImageConversionCheck();
+
   // |Stopwatch::Delegate|
   /// Time limit for a smooth frame.
   ///
@@ -528,6 +608,12 @@ class Rasterizer final : public SnapshotDelegate,
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
       std::shared_ptr<flutter::LayerTree> layer_tree);
 
+  // Whether the layer tree renders the same pixels as the last layer tree,
+  // according to a diff of the two, see |Settings::skip_unchanged_frames|.
+  // Records the paint regions of the layer tree for diffing the next one,
+  // and keeps the diff in |diffed_frame_damage_| for drawing the layer tree.
+  bool IsUnchangedFromLastLayerTree(flutter::LayerTree& layer_tree);
+
   RasterStatus DrawToSurface(FrameTimingsRecorder& frame_timings_recorder,
                              flutter::LayerTree& layer_tree);
 
@@ -536,6 +622,18 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  // Stores the manifest of the Impeller pipeline variants drawn so far once
+  // a frame draws no new ones, if there are more of them than stored.
+  void StoreImpellerPipelineManifestIfNeeded();
+
+  // Writes the last layer tree to the frame capture directory as an SKP, see
+  // |Settings::frame_capture_path|.
+  void CaptureLastLayerTreeIfNeeded();
+
+  // Adds the statistics of the frame that was just submitted to the
+  // histories the performance overlay graphs.
+  void RecordFrameStatistics();
+
   static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
@@ -546,6 +644,15 @@ class Rasterizer final : public SnapshotDelegate,
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
   // This is the last successfully rasterized layer tree.
   std::shared_ptr<flutter::LayerTree> last_layer_tree_;
+  // The damage computed by |IsUnchangedFromLastLayerTree| for the layer tree
+  // being drawn, whose diff is reused by the damage of the frame.
+  std::unique_ptr<FrameDamage> diffed_frame_damage_;
+  // The area outlined by the damage visualization of the last frame, see
+  // |Settings::visualize_frame_damage|.
+  SkIRect last_visualized_damage_ = SkIRect::MakeEmpty();
+  // Decides when frames are rendered at a reduced quality, see
+  // |Settings::enable_adaptive_raster_quality|.
+  RasterQualityPolicy raster_quality_policy_;
   // Set when we need attempt to rasterize the layer tree again. This layer_tree
   // has not successfully rasterized. This can happen due to the change in the
   // thread configuration. This will be inserted to the front of the pipeline.
@@ -553,10 +660,27 @@ class Rasterizer final : public SnapshotDelegate,
   std::unique_ptr<FrameTimingsRecorder> resubmitted_recorder_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
+  size_t peak_resource_cache_working_set_bytes_ = 0;
   std::optional<size_t> max_cache_bytes_;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
+  bool raster_image_conversion_check_scheduled_ = false;
+  // The number of Impeller pipeline variants in the stored manifest, and
+  // that had been drawn as of the last frame.
+  size_t stored_pipeline_variant_count_ = 0;
+  size_t last_pipeline_variant_count_ = 0;
+  // The directory frames are captured to, and the number of frames captured.
+  std::shared_ptr<fml::UniqueFD> frame_capture_directory_;
+  size_t captured_frame_count_ = 0;
+  // The counts of the work of the Impeller renderer so far as of the last
+  // frame, so that the work of each frame can be graphed.
+  struct RendererWorkCounts {
+    size_t render_pass_count = 0;
+    size_t glyph_atlas_upload_count = 0;
+    size_t pipeline_compile_count = 0;
+  };
+  RendererWorkCounts last_renderer_work_counts_;
 
   // WeakPtrFactory must be the last member.
   fml::TaskRunnerAffineWeakPtrFactory<Rasterizer> weak_factory_;
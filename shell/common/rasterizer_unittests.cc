@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "flutter/flow/frame_timings.h"
+#include "flutter/flow/layers/container_layer.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/common/thread_host.h"
@@ -77,6 +78,7 @@ class MockExternalViewEmbedder : public ExternalViewEmbedder {
                void(bool should_resubmit_frame,
                     fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger));
   MOCK_METHOD0(SupportsDynamicThreadMerging, bool());
+  MOCK_METHOD0(SupportsAsyncComposition, bool());
 };
 }  // namespace
 
@@ -264,6 +266,77 @@ TEST(
   latch.Wait();
 }
 
+TEST(RasterizerTest,
+     drawWithAsyncCompositionExternalViewEmbedderDoesNotCreateThreadMerger) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  EXPECT_CALL(delegate, GetTaskRunners())
+      .WillRepeatedly(ReturnRef(task_runners));
+  EXPECT_CALL(delegate, OnFrameRasterized(_));
+  auto rasterizer = std::make_unique<Rasterizer>(delegate);
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  std::shared_ptr<NiceMock<MockExternalViewEmbedder>> external_view_embedder =
+      std::make_shared<NiceMock<MockExternalViewEmbedder>>();
+  rasterizer->SetExternalViewEmbedder(external_view_embedder);
+  EXPECT_CALL(*external_view_embedder, SupportsDynamicThreadMerging)
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*external_view_embedder, SupportsAsyncComposition)
+      .WillRepeatedly(Return(true));
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_readback = true;
+  auto surface_frame = std::make_unique<SurfaceFrame>(
+      /*surface=*/nullptr, framebuffer_info,
+      /*submit_callback=*/[](const SurfaceFrame&, DlCanvas*) { return true; },
+      /*frame_size=*/SkISize::Make(800, 600));
+  EXPECT_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillOnce(Return(true));
+  EXPECT_CALL(*surface, AcquireFrame(SkISize()))
+      .WillOnce(Return(ByMove(std::move(surface_frame))));
+  EXPECT_CALL(*surface, MakeRenderContextCurrent())
+      .WillOnce(Return(ByMove(std::make_unique<GLContextDefaultResult>(true))));
+
+  // Without a merger the frame is submitted right away on the raster thread.
+  EXPECT_CALL(*external_view_embedder,
+              BeginFrame(/*frame_size=*/SkISize(), /*context=*/nullptr,
+                         /*device_pixel_ratio=*/2.0,
+                         /*raster_thread_merger=*/
+                         fml::RefPtr<fml::RasterThreadMerger>(nullptr)))
+      .Times(1);
+  EXPECT_CALL(*external_view_embedder, SubmitFrame).Times(1);
+  EXPECT_CALL(*external_view_embedder,
+              EndFrame(/*should_resubmit_frame=*/false,
+                       /*raster_thread_merger=*/
+                       fml::RefPtr<fml::RasterThreadMerger>(nullptr)))
+      .Times(1);
+
+  rasterizer->Setup(std::move(surface));
+  EXPECT_FALSE(rasterizer->GetRasterThreadMerger());
+  fml::AutoResetWaitableEvent latch;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
+    auto layer_tree = std::make_shared<LayerTree>(/*frame_size=*/SkISize(),
+                                                  /*device_pixel_ratio=*/2.0f);
+    auto layer_tree_item = std::make_unique<LayerTreeItem>(
+        std::move(layer_tree), CreateFinishedBuildRecorder());
+    PipelineProduceResult result =
+        pipeline->Produce().Complete(std::move(layer_tree_item));
+    EXPECT_TRUE(result.success);
+    auto no_discard = [](LayerTree&) { return false; };
+    rasterizer->Draw(pipeline, no_discard);
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 TEST(
     RasterizerTest,
     drawWithExternalViewEmbedderAndThreadsMergedExternalViewEmbedderSubmitFrameCalled) {
@@ -1175,4 +1248,82 @@ TEST(RasterizerTest, presentationTimeNotSetWhenVsyncTargetInPast) {
   latch.Wait();
 }
 
+TEST(RasterizerTest, skipsLayerTreesThatAreUnchanged) {
+  std::string test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  ThreadHost thread_host("io.flutter.test." + test_name + ".",
+                         ThreadHost::Type::Platform | ThreadHost::Type::RASTER |
+                             ThreadHost::Type::IO | ThreadHost::Type::UI);
+  TaskRunners task_runners("test", thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  NiceMock<MockDelegate> delegate;
+  Settings settings;
+  settings.skip_unchanged_frames = true;
+  ON_CALL(delegate, GetSettings()).WillByDefault(ReturnRef(settings));
+  ON_CALL(delegate, GetTaskRunners()).WillByDefault(ReturnRef(task_runners));
+  fml::CountDownLatch rasterized_latch(2);
+  ON_CALL(delegate, OnFrameRasterized(_))
+      .WillByDefault(::testing::Invoke(
+          [&](const FrameTiming&) { rasterized_latch.CountDown(); }));
+
+  fml::AutoResetWaitableEvent latch;
+  std::unique_ptr<Rasterizer> rasterizer;
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer = std::make_unique<Rasterizer>(delegate);
+    latch.Signal();
+  });
+  latch.Wait();
+
+  auto surface = std::make_unique<NiceMock<MockSurface>>();
+  ON_CALL(*surface, AllowsDrawingWhenGpuDisabled()).WillByDefault(Return(true));
+  ON_CALL(*surface, MakeRenderContextCurrent())
+      .WillByDefault(::testing::Invoke(
+          [] { return std::make_unique<GLContextDefaultResult>(true); }));
+  // Only the first of the two identical layer trees is rasterized.
+  EXPECT_CALL(*surface, AcquireFrame(SkISize::Make(800, 600)))
+      .WillOnce(::testing::Invoke([] {
+        SurfaceFrame::FramebufferInfo framebuffer_info;
+        framebuffer_info.supports_readback = true;
+        return std::make_unique<SurfaceFrame>(
+            /*surface=*/nullptr, framebuffer_info,
+            /*submit_callback=*/
+            [](const SurfaceFrame&, DlCanvas*) { return true; },
+            /*frame_size=*/SkISize::Make(800, 600),
+            /*context_result=*/nullptr, /*display_list_fallback=*/true);
+      }));
+
+  std::vector<RasterStatus> raster_statuses;
+  auto root_layer = std::make_shared<ContainerLayer>();
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    rasterizer->Setup(std::move(surface));
+    auto no_discard = [](LayerTree&) { return false; };
+    for (int i = 0; i < 2; i++) {
+      auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/1);
+      auto layer_tree =
+          std::make_shared<LayerTree>(/*frame_size=*/SkISize::Make(800, 600),
+                                      /*device_pixel_ratio=*/2.0f);
+      layer_tree->set_root_layer(root_layer);
+      auto layer_tree_item = std::make_unique<LayerTreeItem>(
+          std::move(layer_tree), CreateFinishedBuildRecorder());
+      PipelineProduceResult result =
+          pipeline->Produce().Complete(std::move(layer_tree_item));
+      EXPECT_TRUE(result.success);
+      raster_statuses.push_back(rasterizer->Draw(pipeline, no_discard));
+    }
+  });
+
+  rasterized_latch.Wait();
+  thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
+    EXPECT_EQ(raster_statuses,
+              std::vector<RasterStatus>(
+                  {RasterStatus::kSuccess, RasterStatus::kSkipped}));
+    rasterizer.reset();
+    latch.Signal();
+  });
+  latch.Wait();
+}
+
 }  // namespace flutter
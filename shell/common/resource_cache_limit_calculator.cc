@@ -4,8 +4,54 @@
 
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 
+#include <algorithm>
+#include <limits>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+#include <unistd.h>
+#include <cstdio>
+#endif
+
 namespace flutter {
 
+ResourceCacheLimitCalculator::MemoryStats
+ResourceCacheLimitCalculator::GetProcessMemoryStats() {
+  MemoryStats stats;
+#if defined(FML_OS_ANDROID) || defined(FML_OS_LINUX)
+  long page_size = sysconf(_SC_PAGESIZE);
+  long page_count = sysconf(_SC_PHYS_PAGES);
+  if (page_size <= 0 || page_count <= 0) {
+    return stats;
+  }
+  stats.physical_bytes =
+      static_cast<size_t>(page_size) * static_cast<size_t>(page_count);
+
+  if (FILE* statm = fopen("/proc/self/statm", "r")) {
+    unsigned long size_pages = 0;
+    unsigned long resident_pages = 0;
+    if (fscanf(statm, "%lu %lu", &size_pages, &resident_pages) == 2) {
+      stats.resident_bytes = static_cast<size_t>(page_size) * resident_pages;
+    }
+    fclose(statm);
+  }
+#endif
+  return stats;
+}
+
+size_t ResourceCacheLimitCalculator::GetMemoryBudget(const MemoryStats& stats) {
+  if (stats.physical_bytes == 0) {
+    return std::numeric_limits<size_t>::max();
+  }
+  double budget = stats.physical_bytes / 16.0;
+  double comfortable_resident_bytes = stats.physical_bytes / 4.0;
+  if (stats.resident_bytes > comfortable_resident_bytes) {
+    budget *= comfortable_resident_bytes / stats.resident_bytes;
+  }
+  return std::max(static_cast<size_t>(budget), kMinMemoryBudgetBytes);
+}
+
 size_t ResourceCacheLimitCalculator::GetResourceCacheMaxBytes() {
   size_t max_bytes = 0;
   size_t max_bytes_threshold = max_bytes_threshold_ > 0
@@ -19,7 +65,10 @@ size_t ResourceCacheLimitCalculator::GetResourceCacheMaxBytes() {
     }
   }
   items_ = std::move(live_items);
-  return std::min(max_bytes, max_bytes_threshold);
+  size_t memory_budget = memory_stats_provider_
+                             ? GetMemoryBudget(memory_stats_provider_())
+                             : std::numeric_limits<size_t>::max();
+  return std::min({max_bytes, max_bytes_threshold, memory_budget});
 }
 
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_COMMON_RESOURCE_CACHE_LIMIT_CALCULATOR_
 
 #include <cstdint>
+#include <functional>
 #include <unordered_map>
 
 #include "flutter/fml/macros.h"
@@ -24,8 +25,27 @@ class ResourceCacheLimitItem {
 
 class ResourceCacheLimitCalculator {
  public:
-  ResourceCacheLimitCalculator(size_t max_bytes_threshold)
-      : max_bytes_threshold_(max_bytes_threshold) {}
+  struct MemoryStats {
+    // The physical memory of the device, or 0 if it is unknown.
+    size_t physical_bytes = 0;
+    // The resident set size of the process, or 0 if it is unknown.
+    size_t resident_bytes = 0;
+  };
+
+  using MemoryStatsProvider = std::function<MemoryStats()>;
+
+  // The limit is never reduced below this by the memory of the device.
+  static constexpr size_t kMinMemoryBudgetBytes = 16 * 1024 * 1024;
+
+  // Reads the memory stats of the current process, where the platform
+  // exposes them.
+  static MemoryStats GetProcessMemoryStats();
+
+  explicit ResourceCacheLimitCalculator(
+      size_t max_bytes_threshold,
+      MemoryStatsProvider memory_stats_provider = &GetProcessMemoryStats)
+      : max_bytes_threshold_(max_bytes_threshold),
+        memory_stats_provider_(std::move(memory_stats_provider)) {}
 
   ~ResourceCacheLimitCalculator() = default;
 
@@ -35,12 +55,25 @@ class ResourceCacheLimitCalculator {
   }
 
   // The maximum GPU resource cache limit in bytes calculated by
-  // 'ResourceCacheLimitItem's. This will be called on the platform thread.
+  // 'ResourceCacheLimitItem's, clamped to the memory budget of the device.
+  // This will be called on the platform thread, whenever the limits of the
+  // items change.
   size_t GetResourceCacheMaxBytes();
 
+  // How much memory the GPU resource caches may use on this device, given
+  // how much memory it has and how much of it the process already uses.
+  //
+  // The budget is a sixteenth of the physical memory, which is about what
+  // the display size formula yields for the phones of each memory class. It
+  // is reduced in proportion once the process uses more than a quarter of
+  // the physical memory, since the system starts to reclaim memory from it
+  // well before it runs out.
+  static size_t GetMemoryBudget(const MemoryStats& stats);
+
  private:
   std::vector<fml::WeakPtr<ResourceCacheLimitItem>> items_;
   size_t max_bytes_threshold_;
+  MemoryStatsProvider memory_stats_provider_;
   FML_DISALLOW_COPY_AND_ASSIGN(ResourceCacheLimitCalculator);
 };
 }  // namespace flutter
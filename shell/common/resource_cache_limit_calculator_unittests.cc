@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 
+#include <limits>
+
 #include "gtest/gtest.h"
 
 namespace flutter {
@@ -50,5 +52,50 @@ TEST(ResourceCacheLimitCalculatorTest, GetResourceCacheMaxBytes) {
   EXPECT_EQ(calculator.GetResourceCacheMaxBytes(), static_cast<size_t>(500U));
 }
 
+TEST(ResourceCacheLimitCalculatorTest, GetMemoryBudget) {
+  constexpr size_t kGigabyte = 1024 * 1024 * 1024;
+  using MemoryStats = ResourceCacheLimitCalculator::MemoryStats;
+
+  // The memory of the device is unknown.
+  EXPECT_EQ(ResourceCacheLimitCalculator::GetMemoryBudget(MemoryStats{}),
+            std::numeric_limits<size_t>::max());
+
+  EXPECT_EQ(ResourceCacheLimitCalculator::GetMemoryBudget(
+                MemoryStats{.physical_bytes = 4 * kGigabyte}),
+            kGigabyte / 4);
+  EXPECT_EQ(ResourceCacheLimitCalculator::GetMemoryBudget(MemoryStats{
+                .physical_bytes = 4 * kGigabyte, .resident_bytes = kGigabyte}),
+            kGigabyte / 4);
+
+  // The process uses twice the comfortable amount of memory.
+  EXPECT_EQ(
+      ResourceCacheLimitCalculator::GetMemoryBudget(MemoryStats{
+          .physical_bytes = 4 * kGigabyte, .resident_bytes = 2 * kGigabyte}),
+      kGigabyte / 8);
+
+  EXPECT_EQ(ResourceCacheLimitCalculator::GetMemoryBudget(
+                MemoryStats{.physical_bytes = 64 * 1024 * 1024}),
+            ResourceCacheLimitCalculator::kMinMemoryBudgetBytes);
+}
+
+TEST(ResourceCacheLimitCalculatorTest, ClampsToMemoryBudget) {
+  ResourceCacheLimitCalculator::MemoryStats stats{
+      .physical_bytes = 1024 * 1024 * 1024};
+  ResourceCacheLimitCalculator calculator(0U, [&stats]() { return stats; });
+  auto item1 = std::make_unique<TestResourceCacheLimitItem>(48 * 1024 * 1024);
+  calculator.AddResourceCacheLimitItem(item1->GetWeakPtr());
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(),
+            static_cast<size_t>(48 * 1024 * 1024));
+
+  auto item2 = std::make_unique<TestResourceCacheLimitItem>(48 * 1024 * 1024);
+  calculator.AddResourceCacheLimitItem(item2->GetWeakPtr());
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(),
+            static_cast<size_t>(64 * 1024 * 1024));
+
+  stats.resident_bytes = 512 * 1024 * 1024;
+  EXPECT_EQ(calculator.GetResourceCacheMaxBytes(),
+            static_cast<size_t>(32 * 1024 * 1024));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -5,6 +5,10 @@
 #define RAPIDJSON_HAS_STDSTRING 1
 #include "flutter/shell/common/shell.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -12,6 +16,7 @@
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/persistent_cache.h"
+#include "flutter/flow/raster_cache_disk_store.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/icu_util.h"
@@ -20,16 +25,23 @@
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/synchronization/sync_switch.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
+#include "flutter/lib/ui/painting/display_list_image_gpu.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
+#include "flutter/shell/version/version.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "third_party/dart/runtime/include/dart_native_api.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
 #include "third_party/skia/include/core/SkGraphics.h"
+#include "third_party/skia/include/core/SkImage.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
 
@@ -96,6 +108,10 @@ void PerformInitializationTasks(Settings& settings) {
       fml::tracing::TraceSetAllowlist(settings.trace_allowlist);
     }
 
+    if (settings.trace_to_ring_buffer) {
+      fml::tracing::TraceRingBufferSetEnabled(true);
+    }
+
     if (!settings.skia_deterministic_rendering_on_cpu) {
       SkGraphics::Init();
     } else {
@@ -130,12 +146,56 @@ std::unique_ptr<Shell> Shell::Create(
 
   TRACE_EVENT0("flutter", "Shell::Create");
 
+  auto startup_profiler = std::make_shared<StartupProfiler>();
+
+  // The default font manager doesn't depend on the VM, so warm it up on the
+  // UI thread while the VM is being created. This leaves the font manager
+  // setup of the engine little left to do. The embedder may have already
+  // done so, and fonts provided by the embedder can't be prefetched.
+  if (task_runners.IsValid() && !settings.prefetched_default_font_manager &&
+      settings.font_initialization_data == 0) {
+    task_runners.GetUITaskRunner()->PostTask([startup_profiler]() {
+      StartupProfiler::ScopedPhase phase(startup_profiler.get(),
+                                         "DefaultFontManagerPrefetch");
+      SkFontMgr::RefDefault();
+    });
+  }
+
   // Always use the `vm_snapshot` and `isolate_snapshot` provided by the
   // settings to launch the VM.  If the VM is already running, the snapshot
-  // arguments are ignored.
-  auto vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
-  auto isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
-  auto vm = DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  // arguments are ignored. The snapshots are independent, so the isolate
+  // snapshot is resolved on the IO thread meanwhile.
+  fml::RefPtr<const DartSnapshot> vm_snapshot;
+  fml::RefPtr<const DartSnapshot> isolate_snapshot;
+  {
+    StartupProfiler::ScopedPhase phase(startup_profiler.get(),
+                                       "SnapshotMapping");
+    fml::AutoResetWaitableEvent isolate_snapshot_latch;
+    auto map_isolate_snapshot = [&isolate_snapshot, &isolate_snapshot_latch,
+                                 &settings, &startup_profiler]() {
+      StartupProfiler::ScopedPhase phase(startup_profiler.get(),
+                                         "IsolateSnapshotMapping");
+      isolate_snapshot = DartSnapshot::IsolateSnapshotFromSettings(settings);
+      isolate_snapshot_latch.Signal();
+    };
+    if (task_runners.IsValid()) {
+      fml::TaskRunner::RunNowOrPostTask(task_runners.GetIOTaskRunner(),
+                                        map_isolate_snapshot);
+    } else {
+      map_isolate_snapshot();
+    }
+    {
+      StartupProfiler::ScopedPhase phase(startup_profiler.get(),
+                                         "VMSnapshotMapping");
+      vm_snapshot = DartSnapshot::VMSnapshotFromSettings(settings);
+    }
+    isolate_snapshot_latch.Wait();
+  }
+
+  auto vm = [&settings, &vm_snapshot, &isolate_snapshot, &startup_profiler]() {
+    StartupProfiler::ScopedPhase phase(startup_profiler.get(), "VMCreation");
+    return DartVMRef::Create(settings, vm_snapshot, isolate_snapshot);
+  }();
   FML_CHECK(vm) << "Must be able to initialize the VM.";
 
   // If the settings did not specify an `isolate_snapshot`, fall back to the
@@ -151,6 +211,7 @@ std::unique_ptr<Shell> Shell::Create(
                             /*parent_merger=*/nullptr,        //
                             /*parent_io_manager=*/nullptr,    //
                             resource_cache_limit_calculator,  //
+                            startup_profiler,                 //
                             settings,                         //
                             std::move(vm),                    //
                             std::move(isolate_snapshot),      //
@@ -165,6 +226,7 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
     std::shared_ptr<ShellIOManager> parent_io_manager,
     const std::shared_ptr<ResourceCacheLimitCalculator>&
         resource_cache_limit_calculator,
+    const std::shared_ptr<StartupProfiler>& startup_profiler,
     const TaskRunners& task_runners,
     const PlatformData& platform_data,
     const Settings& settings,
@@ -185,6 +247,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     task_runners.GetUITaskRunner(),
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
+  shell->startup_profiler_ = startup_profiler;
+  StartupProfiler* profiler = startup_profiler.get();
 
   // Create the rasterizer on the raster thread.
   std::promise<std::unique_ptr<Rasterizer>> rasterizer_promise;
@@ -196,25 +260,32 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
       task_runners.GetRasterTaskRunner(), [&rasterizer_promise,  //
                                            &snapshot_delegate_promise,
                                            on_create_rasterizer,  //
-                                           shell = shell.get()    //
+                                           shell = shell.get(),   //
+                                           profiler               //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        StartupProfiler::ScopedPhase phase(profiler, "RasterizerSetup");
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
-  if (!platform_view || !platform_view->GetWeakPtr()) {
-    return nullptr;
-  }
+  std::unique_ptr<PlatformView> platform_view;
+  std::unique_ptr<VsyncWaiter> vsync_waiter;
+  {
+    StartupProfiler::ScopedPhase phase(profiler, "PlatformViewSetup");
+    platform_view = on_create_platform_view(*shell.get());
+    if (!platform_view || !platform_view->GetWeakPtr()) {
+      return nullptr;
+    }
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
+    // Ask the platform view for the vsync waiter. This will be used by the
+    // engine to create the animator.
+    vsync_waiter = platform_view->CreateVSyncWaiter();
+    if (!vsync_waiter) {
+      return nullptr;
+    }
   }
 
   // Create the IO manager on the IO thread. The IO manager must be initialized
@@ -240,9 +311,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &unref_queue_promise,                                              //
        platform_view_ptr,                                                 //
        io_task_runner,                                                    //
-       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
+       is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch(), //
+       profiler                                                           //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        StartupProfiler::ScopedPhase phase(profiler, "IOManagerSetup");
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -277,14 +350,19 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
                          &unref_queue_future,                             //
-                         &on_create_engine]() mutable {
+                         &on_create_engine,                               //
+                         profiler]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
+        StartupProfiler::ScopedPhase phase(profiler, "EngineSetup");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        animator->SetFramePacer(shell->frame_pacer_);
+        animator->SetRasterizeLatestFrameOnly(
+            shell->GetSettings().rasterize_latest_frame_only);
 
         engine_promise.set_value(
             on_create_engine(*shell,                          //
@@ -319,6 +397,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
     const std::shared_ptr<ShellIOManager>& parent_io_manager,
     const std::shared_ptr<ResourceCacheLimitCalculator>&
         resource_cache_limit_calculator,
+    const std::shared_ptr<StartupProfiler>& startup_profiler,
     Settings settings,
     DartVMRef vm,
     fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -347,6 +426,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                          parent_thread_merger,                               //
                          parent_io_manager,                                  //
                          resource_cache_limit_calculator,                    //
+                         startup_profiler,                                   //
                          task_runners = task_runners,                        //
                          platform_data = platform_data,                      //
                          settings = settings,                                //
@@ -360,6 +440,7 @@ std::unique_ptr<Shell> Shell::CreateWithSnapshot(
                                             parent_thread_merger,             //
                                             parent_io_manager,                //
                                             resource_cache_limit_calculator,  //
+                                            startup_profiler,                 //
                                             task_runners,                     //
                                             platform_data,                    //
                                             settings,                         //
@@ -395,6 +476,10 @@ Shell::Shell(DartVMRef vm,
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
   display_manager_ = std::make_unique<DisplayManager>();
+  if (settings_.enable_adaptive_frame_pacing) {
+    frame_pacer_ = std::make_shared<FramePacer>();
+  }
+  frame_phase_histograms_ = std::make_unique<FramePhaseHistograms>();
   resource_cache_limit_calculator->AddResourceCacheLimitItem(
       weak_factory_.GetWeakPtr());
 
@@ -454,6 +539,35 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetResidentCacheBytesExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetResidentCacheBytes, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetGpuMemoryUsageExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetGpuMemoryUsage, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetLayerCanvasStatisticsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetLayerCanvasStatistics, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_[ServiceProtocol::kGetLayerTimingsExtensionName] = {
+      task_runners_.GetRasterTaskRunner(),
+      std::bind(&Shell::OnServiceProtocolGetLayerTimings, this,
+                std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetFramePhaseHistogramsExtensionName] = {
+          task_runners_.GetRasterTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetFramePhaseHistograms, this,
+                    std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kDumpTraceRingBufferExtensionName] = {
+          task_runners_.GetIOTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolDumpTraceRingBuffer, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -523,7 +637,8 @@ std::unique_ptr<Shell> Shell::Spawn(
           .SetIfTrue([&is_gpu_disabled] { is_gpu_disabled = true; }));
   std::unique_ptr<Shell> result = CreateWithSnapshot(
       PlatformData{}, task_runners_, rasterizer_->GetRasterThreadMerger(),
-      io_manager_, resource_cache_limit_calculator_, GetSettings(), vm_,
+      io_manager_, resource_cache_limit_calculator_,
+      std::make_shared<StartupProfiler>(), GetSettings(), vm_,
       vm_->GetVMData()->GetIsolateSnapshot(), on_create_platform_view,
       on_create_rasterizer,
       [engine = this->engine_.get(), initial_route](
@@ -551,21 +666,36 @@ std::unique_ptr<Shell> Shell::Spawn(
 }
 
 void Shell::NotifyLowMemoryWarning() const {
+  NotifyMemoryPressure(MemoryPressureLevel::kCritical);
+}
+
+void Shell::NotifyMemoryPressure(MemoryPressureLevel level) const {
   auto trace_id = fml::tracing::TraceNonce();
-  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyLowMemoryWarning",
+  TRACE_EVENT_ASYNC_BEGIN0("flutter", "Shell::NotifyMemoryPressure",
                            trace_id);
-  // This does not require a current isolate but does require a running VM.
-  // Since a valid shell will not be returned to the embedder without a valid
-  // DartVMRef, we can be certain that this is a safe spot to assume a VM is
-  // running.
-  ::Dart_NotifyLowMemory();
+  if (level != MemoryPressureLevel::kModerate) {
+    // This does not require a current isolate but does require a running VM.
+    // Since a valid shell will not be returned to the embedder without a
+    // valid DartVMRef, we can be certain that this is a safe spot to assume a
+    // VM is running.
+    ::Dart_NotifyLowMemory();
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask([engine = weak_engine_]() {
+    if (engine) {
+      engine->GetFontCollection().ReleaseUnusedFonts();
+      if (auto image_decoder = engine->GetImageDecoderWeakPtr()) {
+        image_decoder->GetDecodedImageCache().Purge();
+      }
+    }
+  });
 
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), trace_id = trace_id]() {
+      [rasterizer = rasterizer_->GetWeakPtr(), level, trace_id = trace_id]() {
         if (rasterizer) {
-          rasterizer->NotifyLowMemoryWarning();
+          rasterizer->TrimMemory(level);
         }
-        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyLowMemoryWarning",
+        TRACE_EVENT_ASYNC_END0("flutter", "Shell::NotifyMemoryPressure",
                                trace_id);
       });
   // The IO Manager uses resource cache limits of 0, so it is not necessary
@@ -590,6 +720,10 @@ void Shell::RunEngine(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (settings_.enable_asset_prefetch && run_configuration.IsValid()) {
+    PrefetchAssets(run_configuration.GetAssetManager());
+  }
+
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
       fml::MakeCopyable(
@@ -610,6 +744,26 @@ void Shell::RunEngine(
           }));
 }
 
+void Shell::PrefetchAssets(
+    const std::shared_ptr<AssetManager>& asset_manager) {
+  // Assets are read on a worker while the isolate launches, before the
+  // framework asks for them.
+  asset_manager->StartRecordingAccesses();
+  vm_->GetConcurrentWorkerTaskRunner()->PostTask([asset_manager]() {
+    TRACE_EVENT0("flutter", "Shell::PrefetchAssets");
+    asset_manager->PrefetchAssets(
+        PersistentCache::GetCacheForProcess()->LoadAssetPrefetchManifest());
+  });
+
+  task_runners_.GetIOTaskRunner()->PostDelayedTask(
+      [asset_manager]() {
+        PersistentCache::GetCacheForProcess()->StoreAssetPrefetchManifest(
+            asset_manager->StopRecordingAccesses());
+      },
+      fml::TimeDelta::FromMilliseconds(
+          settings_.asset_prefetch_recording_duration.count()));
+}
+
 std::optional<DartErrorCode> Shell::GetUIIsolateLastError() const {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
@@ -684,14 +838,48 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
 
   // Setup the time-consuming default font manager right after engine created.
   if (!settings_.prefetched_default_font_manager) {
-    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetUITaskRunner(),
-                                      [engine = weak_engine_] {
-                                        if (engine) {
-                                          engine->SetupDefaultFontManager();
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetUITaskRunner(),
+        [engine = weak_engine_, startup_profiler = startup_profiler_] {
+          if (engine) {
+            StartupProfiler::ScopedPhase phase(startup_profiler.get(),
+                                               "DefaultFontManagerSetup");
+            engine->SetupDefaultFontManager();
+          }
+        });
+  }
+
+  if (settings_.enable_async_raster_cache_generation) {
+    EnableAsyncRasterCacheGeneration();
+  }
+
+  if (settings_.enable_raster_cache_disk_store) {
+    EnableRasterCacheDiskStore();
+  }
+
+  if (settings_.enable_retained_layer_preroll) {
+    fml::TaskRunner::RunNowOrPostTask(task_runners_.GetRasterTaskRunner(),
+                                      [rasterizer = weak_rasterizer_]() {
+                                        if (rasterizer) {
+                                          rasterizer->compositor_context()
+                                              ->set_reuse_retained_preroll(
+                                                  true);
                                         }
                                       });
   }
 
+  if (settings_.enable_concurrent_preroll) {
+    fml::TaskRunner::RunNowOrPostTask(
+        task_runners_.GetRasterTaskRunner(),
+        [rasterizer = weak_rasterizer_,
+         worker_task_runner = vm_->GetConcurrentWorkerTaskRunner()]() {
+          if (rasterizer) {
+            rasterizer->compositor_context()->set_preroll_task_runner(
+                worker_task_runner);
+          }
+        });
+  }
+
   is_setup_ = true;
 
   PersistentCache::GetCacheForProcess()->AddWorkerTaskRunner(
@@ -707,6 +895,81 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   return true;
 }
 
+void Shell::EnableAsyncRasterCacheGeneration() {
+  // The images are rendered in CPU memory on the IO thread and uploaded with
+  // the resource context there. If the resource context is unavailable the
+  // image is left in CPU memory to be uploaded when it is first drawn.
+  auto uploader = [io_manager = io_manager_->GetWeakPtr()](
+                      sk_sp<SkImage> image) -> sk_sp<DlImage> {
+    sk_sp<DlImage> result;
+    if (io_manager) {
+      io_manager->GetIsGpuDisabledSyncSwitch()->Execute(
+          fml::SyncSwitch::Handlers().SetIfFalse([&result, &io_manager,
+                                                  &image] {
+            auto context = io_manager->GetResourceContext();
+            SkPixmap pixmap;
+            if (!context || !image->peekPixels(&pixmap)) {
+              return;
+            }
+            TRACE_EVENT0("flutter", "MakeCrossContextImageFromPixmap");
+            sk_sp<SkImage> texture_image = SkImage::MakeCrossContextFromPixmap(
+                context.get(),  // context
+                pixmap,         // pixmap
+                false,          // buildMips,
+                false           // limitToMaxTextureSize
+            );
+            if (texture_image) {
+              result = DlImageGPU::Make(
+                  {std::move(texture_image), io_manager->GetSkiaUnrefQueue()});
+            }
+          }));
+    }
+    return result ? result : DlImage::Make(std::move(image));
+  };
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = weak_rasterizer_,
+       io_task_runner = task_runners_.GetIOTaskRunner(),
+       uploader = std::move(uploader)]() {
+        if (rasterizer) {
+          rasterizer->compositor_context()
+              ->raster_cache()
+              .EnableAsyncGeneration(io_task_runner, uploader);
+        }
+      });
+}
+
+void Shell::EnableRasterCacheDiskStore() {
+  fml::UniqueFD directory = fml::CreateDirectory(
+      fml::paths::GetCachesDirectory(),
+      {"flutter_engine", GetFlutterEngineVersion(), "raster_cache"},
+      fml::FilePermission::kReadWrite);
+  if (!directory.is_valid()) {
+    FML_LOG(WARNING) << "Could not create the raster cache disk store.";
+    return;
+  }
+  // Opening the store reads the sizes of the files already in it, so it is
+  // done on the IO thread which then also writes the new files.
+  task_runners_.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [directory = std::move(directory),
+       max_bytes = settings_.raster_cache_disk_store_max_bytes,
+       raster_task_runner = task_runners_.GetRasterTaskRunner(),
+       io_task_runner = task_runners_.GetIOTaskRunner(),
+       rasterizer = weak_rasterizer_]() mutable {
+        auto disk_store = std::make_shared<RasterCacheDiskStore>(
+            std::move(directory), max_bytes);
+        raster_task_runner->PostTask(
+            [disk_store = std::move(disk_store),
+             io_task_runner = std::move(io_task_runner), rasterizer]() {
+              if (rasterizer) {
+                rasterizer->compositor_context()
+                    ->raster_cache()
+                    .EnableDiskStore(disk_store, io_task_runner);
+              }
+            });
+      }));
+}
+
 const Settings& Shell::GetSettings() const {
   return settings_;
 }
@@ -735,6 +998,10 @@ fml::WeakPtr<PlatformView> Shell::GetPlatformView() {
   return weak_platform_view_;
 }
 
+fml::WeakPtr<Shell> Shell::GetWeakPtr() const {
+  return weak_factory_.GetWeakPtr();
+}
+
 fml::WeakPtr<ShellIOManager> Shell::GetIOManager() {
   FML_DCHECK(is_setup_);
   return io_manager_->GetWeakPtr();
@@ -922,6 +1189,23 @@ void Shell::OnPlatformViewScheduleFrame() {
   });
 }
 
+size_t Shell::GetResourceCacheLimit() {
+  return std::max(resource_cache_limit_,
+                  resource_cache_working_set_bytes_ / 2 * 3);
+}
+
+void Shell::UpdateResourceCacheMaxBytes() {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  size_t resource_cache_max_bytes =
+      resource_cache_limit_calculator_->GetResourceCacheMaxBytes();
+  task_runners_.GetRasterTaskRunner()->PostTask(
+      [rasterizer = rasterizer_->GetWeakPtr(), resource_cache_max_bytes] {
+        if (rasterizer) {
+          rasterizer->SetResourceCacheMaxBytes(resource_cache_max_bytes, false);
+        }
+      });
+}
+
 // |PlatformView::Delegate|
 void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
   FML_DCHECK(is_setup_);
@@ -937,14 +1221,13 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
   // https://android.googlesource.com/platform/frameworks/base/+/39ae5bac216757bc201490f4c7b8c0f63006c6cd/libs/hwui/renderthread/CacheManager.cpp#45
   resource_cache_limit_ =
       metrics.physical_width * metrics.physical_height * 12 * 4;
-  size_t resource_cache_max_bytes =
-      resource_cache_limit_calculator_->GetResourceCacheMaxBytes();
-  task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), resource_cache_max_bytes] {
-        if (rasterizer) {
-          rasterizer->SetResourceCacheMaxBytes(resource_cache_max_bytes, false);
-        }
-      });
+  UpdateResourceCacheMaxBytes();
+
+  // Frames are budgeted, and timed by the fallback vsync waiter, at the
+  // refresh rate of the display the view moved to.
+  if (metrics.display_id.has_value()) {
+    display_manager_->SetViewDisplayId(metrics.display_id.value());
+  }
 
   task_runners_.GetUITaskRunner()->PostTask(
       [engine = engine_->GetWeakPtr(), metrics]() {
@@ -967,6 +1250,10 @@ void Shell::OnPlatformViewDispatchPlatformMessage(
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
+  if (PostPlatformMessageToChannelPort(message)) {
+    return;
+  }
+
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
@@ -1072,22 +1359,44 @@ void Shell::OnPlatformViewMarkTextureFrameAvailable(int64_t texture_id) {
   FML_DCHECK(is_setup_);
   FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
 
-  // Tell the rasterizer that one of its textures has a new frame available.
+  {
+    std::scoped_lock lock(pending_texture_frames_->mutex);
+    bool drain_pending = !pending_texture_frames_->texture_ids.empty();
+    pending_texture_frames_->texture_ids.insert(texture_id);
+    if (drain_pending) {
+      // The raster thread will pick this texture up along with the ones that
+      // were marked before it, and a frame has already been requested.
+      return;
+    }
+  }
+
+  // Tell the rasterizer which of its textures have a new frame available.
+  // Textures marked several times before this runs are only told once, and
+  // only import the newest of their frames when they are next painted.
   task_runners_.GetRasterTaskRunner()->PostTask(
-      [rasterizer = rasterizer_->GetWeakPtr(), texture_id]() {
-        auto registry = rasterizer->GetTextureRegistry();
+      [rasterizer = rasterizer_->GetWeakPtr(),
+       pending_texture_frames = pending_texture_frames_]() {
+        std::unordered_set<int64_t> texture_ids;
+        {
+          std::scoped_lock lock(pending_texture_frames->mutex);
+          texture_ids.swap(pending_texture_frames->texture_ids);
+        }
 
-        if (!registry) {
+        if (!rasterizer) {
           return;
         }
 
-        auto texture = registry->GetTexture(texture_id);
+        auto registry = rasterizer->GetTextureRegistry();
 
-        if (!texture) {
+        if (!registry) {
           return;
         }
 
-        texture->MarkNewFrameAvailable();
+        for (int64_t texture_id : texture_ids) {
+          if (auto texture = registry->GetTexture(texture_id)) {
+            texture->MarkNewFrameAvailable();
+          }
+        }
       });
 
   // Schedule a new frame without having to rebuild the layer tree.
@@ -1111,11 +1420,24 @@ void Shell::OnPlatformViewSetNextFrameCallback(const fml::closure& closure) {
       });
 }
 
+// |PlatformView::Delegate|
+void Shell::OnPlatformViewNotifyMemoryPressure(MemoryPressureLevel level) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  NotifyMemoryPressure(level);
+}
+
 // |PlatformView::Delegate|
 const Settings& Shell::OnPlatformViewGetSettings() const {
   return settings_;
 }
 
+// |PlatformView::Delegate|
+double Shell::OnPlatformViewGetDisplayRefreshRate() const {
+  return display_manager_->GetViewDisplayRefreshRate();
+}
+
 // |Animator::Delegate|
 void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time,
                                  uint64_t frame_number) {
@@ -1168,9 +1490,11 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
            tree.frame_size() != expected_frame_size_;
   };
 
-  task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
+  auto task = fml::MakeCopyable(
       [&waiting_for_first_frame = waiting_for_first_frame_,
        &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
+       startup_profiler = startup_profiler_.get(),
+       log_startup_phases = settings_.trace_startup,
        rasterizer = rasterizer_->GetWeakPtr(),
        weak_pipeline = std::weak_ptr<LayerTreePipeline>(pipeline),
        discard_callback = std::move(discard_callback)]() mutable {
@@ -1181,11 +1505,19 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
           }
 
           if (waiting_for_first_frame.load()) {
+            if (startup_profiler->MarkFirstFrame() && log_startup_phases) {
+              FML_LOG(INFO) << "Startup phases:\n"
+                            << startup_profiler->GetSummary();
+            }
             waiting_for_first_frame.store(false);
             waiting_for_first_frame_condition.notify_all();
           }
         }
-      }));
+      });
+
+  // Posted at the normal priority like the rasterizer setup and teardown
+  // tasks, so that frames are never drawn before or after those.
+  task_runners_.GetRasterTaskRunner()->PostTask(task);
 }
 
 // |Animator::Delegate|
@@ -1362,6 +1694,86 @@ void Shell::SetNeedsReportTimings(bool value) {
   needs_report_timings_ = value;
 }
 
+// |Engine::Delegate|
+void Shell::SetChannelPort(const std::string& channel, int64_t port) {
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+  std::scoped_lock lock(channel_ports_mutex_);
+  if (port == ILLEGAL_PORT) {
+    channel_ports_.erase(channel);
+  } else {
+    channel_ports_[channel] = port;
+  }
+}
+
+bool Shell::PostPlatformMessageToChannelPort(
+    std::unique_ptr<PlatformMessage>& message) {
+  int64_t port = ILLEGAL_PORT;
+  {
+    std::scoped_lock lock(channel_ports_mutex_);
+    auto found = channel_ports_.find(message->channel());
+    if (found == channel_ports_.end()) {
+      return false;
+    }
+    port = found->second;
+  }
+  TRACE_EVENT1("flutter", "Shell::PostPlatformMessageToChannelPort", "channel",
+               message->channel().c_str());
+
+  Dart_CObject name = {
+      .type = Dart_CObject_kString,
+  };
+  name.value.as_string = message->channel().c_str();
+
+  // The data is handed to the receiving isolate without copying, and freed
+  // when it is collected there.
+  size_t size = message->data().GetSize();
+  uint8_t* data = message->hasData() ? message->releaseData().Release()
+                                     : nullptr;
+  Dart_CObject payload = {
+      .type = Dart_CObject_kNull,
+  };
+  if (data) {
+    payload.type = Dart_CObject_kExternalTypedData;
+    payload.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+    payload.value.as_external_typed_data.length = size;
+    payload.value.as_external_typed_data.data = data;
+    payload.value.as_external_typed_data.peer = data;
+    payload.value.as_external_typed_data.callback =
+        [](void* isolate_callback_data, void* peer) { free(peer); };
+  }
+
+  std::array<Dart_CObject*, 2> values = {&name, &payload};
+  Dart_CObject array = {
+      .type = Dart_CObject_kArray,
+  };
+  array.value.as_array.length = values.size();
+  array.value.as_array.values = values.data();
+
+  if (!Dart_PostCObject(port, &array)) {
+    // The port was closed. Deliver the messages of the channel to the root
+    // isolate instead, starting with this one.
+    FML_LOG(ERROR) << "Could not post a platform message to the port of the "
+                      "channel: "
+                   << message->channel();
+    {
+      std::scoped_lock lock(channel_ports_mutex_);
+      channel_ports_.erase(message->channel());
+    }
+    if (data) {
+      message = std::make_unique<PlatformMessage>(
+          message->channel(), fml::MallocMapping(data, size),
+          message->response());
+    }
+    return false;
+  }
+
+  // Messages delivered to a port can't be replied to.
+  if (auto response = message->response()) {
+    response->CompleteEmpty();
+  }
+  return true;
+}
+
 // |Engine::Delegate|
 std::unique_ptr<std::vector<std::string>> Shell::ComputePlatformResolvedLocale(
     const std::vector<std::string>& supported_locale_data) {
@@ -1396,6 +1808,37 @@ void Shell::LoadDartDeferredLibraryError(intptr_t loading_unit_id,
       });
 }
 
+void Shell::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::unique_ptr<const fml::Mapping> snapshot_data,
+    std::unique_ptr<const fml::Mapping> snapshot_instructions) {
+  // Fault the pages in on a worker, so that neither the platform nor the UI
+  // thread wait for storage when the loading unit is registered with the VM.
+  vm_->GetConcurrentWorkerTaskRunner()->PostTask(fml::MakeCopyable(
+      [engine = weak_engine_, ui_task_runner = task_runners_.GetUITaskRunner(),
+       loading_unit_id, data = std::move(snapshot_data),
+       instructions = std::move(snapshot_instructions)]() mutable {
+        TRACE_EVENT0("flutter", "Shell::PrefetchDartDeferredLibrary");
+        if (!data || !instructions || data->GetMapping() == nullptr ||
+            instructions->GetMapping() == nullptr) {
+          FML_LOG(ERROR) << "Could not prefetch the invalid loading unit "
+                         << loading_unit_id << ".";
+          return;
+        }
+        data->TouchPages();
+        instructions->TouchPages();
+        ui_task_runner->PostTask(fml::MakeCopyable(
+            [engine, loading_unit_id, data = std::move(data),
+             instructions = std::move(instructions)]() mutable {
+              if (engine) {
+                engine->PrefetchDartDeferredLibrary(loading_unit_id,
+                                                    std::move(data),
+                                                    std::move(instructions));
+              }
+            }));
+      }));
+}
+
 void Shell::UpdateAssetResolverByType(
     std::unique_ptr<AssetResolver> updated_asset_resolver,
     AssetResolver::AssetResolverType type) {
@@ -1427,11 +1870,15 @@ void Shell::ReportTimings() {
 
   auto timings = std::move(unreported_timings_);
   unreported_timings_ = {};
-  task_runners_.GetUITaskRunner()->PostTask([timings, engine = weak_engine_] {
-    if (engine) {
-      engine->ReportTimings(timings);
-    }
-  });
+  const auto now = fml::TimePoint::Now();
+  task_runners_.GetUITaskRunner()->PostTaskWithPriority(
+      [timings, engine = weak_engine_] {
+        if (engine) {
+          engine->ReportTimings(timings);
+        }
+      },
+      fml::TaskPriority::kHousekeeping, now,
+      now + fml::kHousekeepingTaskMaxDelay);
 }
 
 size_t Shell::UnreportedFramesCount() const {
@@ -1451,6 +1898,36 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (frame_pacer_) {
+    frame_pacer_->RecordFrame(
+        timing.Get(FrameTiming::kBuildFinish) -
+            timing.Get(FrameTiming::kBuildStart),
+        timing.Get(FrameTiming::kRasterFinish) -
+            timing.Get(FrameTiming::kRasterStart),
+        GetFrameBudget());
+  }
+  frame_phase_histograms_->RecordFrame(timing);
+
+  // The limit of the resource cache follows the working set of the frames,
+  // as well as the memory that is left on the device.
+  if (++frames_since_resource_cache_update_ >= kResourceCacheUpdateInterval) {
+    frames_since_resource_cache_update_ = 0;
+    size_t working_set_bytes =
+        rasterizer_->TakePeakResourceCacheWorkingSetBytes();
+    task_runners_.GetPlatformTaskRunner()->PostTask(
+        [shell = weak_factory_.GetWeakPtr(), working_set_bytes]() {
+          if (!shell) {
+            return;
+          }
+          shell->resource_cache_working_set_bytes_ = working_set_bytes;
+          // Until the viewport metrics are known, the rasterizer keeps the
+          // default limit of the context.
+          if (shell->resource_cache_limit_ > 0) {
+            shell->UpdateResourceCacheMaxBytes();
+          }
+        });
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1465,6 +1942,7 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
   unreported_timings_.push_back(timing.GetLayerCacheBytes());
   unreported_timings_.push_back(timing.GetPictureCacheCount());
   unreported_timings_.push_back(timing.GetPictureCacheBytes());
+  unreported_timings_.push_back(timing.GetDiscardedFrameCount());
   unreported_timings_.push_back(timing.GetFrameNumber());
   FML_DCHECK(unreported_timings_.size() ==
              old_count + FrameTiming::kStatisticsCount);
@@ -1510,7 +1988,7 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
 }
 
 fml::Milliseconds Shell::GetFrameBudget() {
-  double display_refresh_rate = display_manager_->GetMainDisplayRefreshRate();
+  double display_refresh_rate = display_manager_->GetViewDisplayRefreshRate();
   if (display_refresh_rate > 0) {
     return fml::RefreshRateToFrameBudget(display_refresh_rate);
   } else {
@@ -1794,6 +2272,241 @@ bool Shell::OnServiceProtocolEstimateRasterCacheMemory(
   return true;
 }
 
+bool Shell::OnServiceProtocolGetResidentCacheBytes(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  ResidentCacheBytes report;
+  if (rasterizer_) {
+    rasterizer_->ReportResidentCacheBytes(report);
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "ResidentCacheBytes", allocator);
+  rapidjson::Value caches(rapidjson::kObjectType);
+  uint64_t total_bytes = 0;
+  for (const auto& [name, bytes] : report) {
+    caches.AddMember(rapidjson::Value(name.c_str(), allocator),
+                     static_cast<uint64_t>(bytes), allocator);
+    total_bytes += bytes;
+  }
+  response->AddMember("caches", caches, allocator);
+  response->AddMember<uint64_t>("totalBytes", total_bytes, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetGpuMemoryUsage(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  std::map<std::string, GpuMemoryUsage> usage;
+  if (rasterizer_) {
+    usage = rasterizer_->GetGpuMemoryUsage();
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "GpuMemoryUsage", allocator);
+  rapidjson::Value categories(rapidjson::kObjectType);
+  uint64_t live_bytes = 0;
+  for (const auto& [name, category_usage] : usage) {
+    rapidjson::Value category(rapidjson::kObjectType);
+    category.AddMember<uint64_t>("liveBytes", category_usage.live_bytes,
+                                 allocator);
+    category.AddMember<uint64_t>("framePeakBytes",
+                                 category_usage.frame_peak_bytes, allocator);
+    category.AddMember<uint64_t>("peakBytes", category_usage.peak_bytes,
+                                 allocator);
+    categories.AddMember(rapidjson::Value(name.c_str(), allocator), category,
+                         allocator);
+    live_bytes += category_usage.live_bytes;
+  }
+  response->AddMember("categories", categories, allocator);
+  response->AddMember<uint64_t>("liveBytes", live_bytes, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetLayerCanvasStatistics(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  std::vector<Rasterizer::LayerCanvasStatistics> layer_statistics;
+  if (rasterizer_) {
+    layer_statistics = rasterizer_->GetLastLayerTreeCanvasStatistics();
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "LayerCanvasStatistics", allocator);
+  rapidjson::Value layers(rapidjson::kArrayType);
+  for (const auto& layer : layer_statistics) {
+    const CanvasStatistics& statistics = layer.statistics;
+    rapidjson::Value layer_json(rapidjson::kObjectType);
+    layer_json.AddMember<uint64_t>("layerId", layer.layer_id, allocator);
+    rapidjson::Value bounds(rapidjson::kArrayType);
+    bounds.PushBack(layer.paint_bounds.left(), allocator);
+    bounds.PushBack(layer.paint_bounds.top(), allocator);
+    bounds.PushBack(layer.paint_bounds.right(), allocator);
+    bounds.PushBack(layer.paint_bounds.bottom(), allocator);
+    layer_json.AddMember("paintBounds", bounds, allocator);
+    // Only the types of operations the layer made.
+    rapidjson::Value ops(rapidjson::kObjectType);
+    for (size_t i = 0; i < CanvasStatistics::kOpCount; i++) {
+      if (statistics.op_counts[i] == 0) {
+        continue;
+      }
+      const char* name = CanvasOpToString(static_cast<CanvasOp>(i));
+      ops.AddMember<uint64_t>(rapidjson::StringRef(name),
+                              statistics.op_counts[i], allocator);
+    }
+    layer_json.AddMember("ops", ops, allocator);
+    layer_json.AddMember<uint64_t>("saveLayers", statistics.save_layer_count,
+                                   allocator);
+    layer_json.AddMember<uint64_t>("rectClips", statistics.rect_clip_count,
+                                   allocator);
+    layer_json.AddMember<uint64_t>("rrectClips", statistics.rrect_clip_count,
+                                   allocator);
+    layer_json.AddMember<uint64_t>("pathClips", statistics.path_clip_count,
+                                   allocator);
+    layer_json.AddMember<uint64_t>("clipPathVerbs",
+                                   statistics.clip_path_verb_count, allocator);
+    layer_json.AddMember<uint64_t>("pathVerbs", statistics.path_verb_count,
+                                   allocator);
+    layer_json.AddMember<uint64_t>("imageBytes", statistics.image_bytes,
+                                   allocator);
+    layer_json.AddMember<uint64_t>("textRuns", statistics.text_run_count,
+                                   allocator);
+    layers.PushBack(layer_json, allocator);
+  }
+  response->AddMember("layers", layers, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetLayerTimings(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  CompositorContext* compositor_context =
+      rasterizer_ ? rasterizer_->compositor_context() : nullptr;
+  if (!compositor_context) {
+    ServiceProtocolFailureError(response, "The rasterizer is not available.");
+    return false;
+  }
+
+  auto interval_param = params.find("sampleInterval");
+  if (interval_param != params.end()) {
+    const std::string interval_string(interval_param->second);
+    const bool is_number =
+        !interval_string.empty() &&
+        interval_string.find_first_not_of("0123456789") == std::string::npos;
+    const unsigned long long interval =
+        is_number ? std::strtoull(interval_string.c_str(), nullptr, 10) : 0u;
+    if (!is_number || interval > std::numeric_limits<uint32_t>::max()) {
+      ServiceProtocolParameterError(
+          response, "'sampleInterval' must be a non-negative integer.");
+      return false;
+    }
+    compositor_context->set_layer_timing_sample_interval(
+        static_cast<uint32_t>(interval));
+  }
+
+  std::vector<const LayerSnapshotData*> timings;
+  for (const LayerSnapshotData& data :
+       compositor_context->layer_timing_store()) {
+    timings.push_back(&data);
+  }
+  std::stable_sort(timings.begin(), timings.end(),
+                   [](const LayerSnapshotData* a, const LayerSnapshotData* b) {
+                     return a->GetDuration() > b->GetDuration();
+                   });
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "LayerTimings", allocator);
+  response->AddMember<uint64_t>(
+      "sampleInterval", compositor_context->layer_timing_sample_interval(),
+      allocator);
+  rapidjson::Value layers(rapidjson::kArrayType);
+  for (const LayerSnapshotData* data : timings) {
+    rapidjson::Value layer_json(rapidjson::kObjectType);
+    layer_json.AddMember<int64_t>("layerId", data->GetLayerUniqueId(),
+                                  allocator);
+    layer_json.AddMember<int64_t>(
+        "durationMicros", data->GetDuration().ToMicroseconds(), allocator);
+    const SkRect bounds = data->GetBounds();
+    rapidjson::Value bounds_json(rapidjson::kArrayType);
+    bounds_json.PushBack(bounds.left(), allocator);
+    bounds_json.PushBack(bounds.top(), allocator);
+    bounds_json.PushBack(bounds.right(), allocator);
+    bounds_json.PushBack(bounds.bottom(), allocator);
+    layer_json.AddMember("bounds", bounds_json, allocator);
+    layers.PushBack(layer_json, allocator);
+  }
+  response->AddMember("layers", layers, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolGetFramePhaseHistograms(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "FramePhaseHistograms", allocator);
+  response->AddMember<uint64_t>(
+      "frameCount", frame_phase_histograms_->GetFrameCount(), allocator);
+
+  rapidjson::Value bucket_bounds(rapidjson::kArrayType);
+  for (double bound : FramePhaseHistograms::kBucketBoundsMillis) {
+    bucket_bounds.PushBack(bound, allocator);
+  }
+  response->AddMember("bucketBoundsMillis", bucket_bounds, allocator);
+
+  rapidjson::Value phases(rapidjson::kObjectType);
+  for (int i = 0; i < FramePhaseHistograms::kPhaseCount; i++) {
+    auto phase = static_cast<FramePhaseHistograms::Phase>(i);
+    FramePhaseHistograms::Histogram histogram =
+        frame_phase_histograms_->GetHistogram(phase);
+    rapidjson::Value counts(rapidjson::kArrayType);
+    for (size_t count : histogram.bucket_counts) {
+      counts.PushBack<uint64_t>(count, allocator);
+    }
+    rapidjson::Value phase_json(rapidjson::kObjectType);
+    phase_json.AddMember("bucketCounts", counts, allocator);
+    phase_json.AddMember("averageMillis", histogram.average_millis,
+                         allocator);
+    phase_json.AddMember("p90Millis", histogram.p90_millis, allocator);
+    phase_json.AddMember("maxMillis", histogram.max_millis, allocator);
+    phases.AddMember(rapidjson::StringRef(
+                         FramePhaseHistograms::GetPhaseName(phase)),
+                     phase_json, allocator);
+  }
+  response->AddMember("phases", phases, allocator);
+  return true;
+}
+
+bool Shell::OnServiceProtocolDumpTraceRingBuffer(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TraceRingBuffer", allocator);
+  response->AddMember("enabled", fml::tracing::TraceRingBufferIsEnabled(),
+                      allocator);
+
+  std::string dump = fml::tracing::TraceRingBufferDump();
+  rapidjson::Document trace(&allocator);
+  trace.Parse(dump.c_str());
+  if (trace.HasParseError() || !trace.HasMember("traceEvents")) {
+    ServiceProtocolFailureError(response, "Could not dump the trace events.");
+    return false;
+  }
+  response->AddMember("traceEvents", trace["traceEvents"], allocator);
+  return true;
+}
+
 // Service protocol handler
 bool Shell::OnServiceProtocolSetAssetBundlePath(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
@@ -1995,6 +2708,10 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+std::vector<StartupProfiler::Phase> Shell::GetStartupPhases() const {
+  return startup_profiler_->GetPhases();
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -9,6 +9,7 @@
 #include <mutex>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "flutter/assets/directory_asset_bundle.h"
 #include "flutter/common/graphics/texture.h"
@@ -36,10 +37,13 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_pacer.h"
+#include "flutter/shell/common/frame_phase_histograms.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/common/startup_profiler.h"
 
 namespace flutter {
 
@@ -266,6 +270,14 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::WeakPtr<PlatformView> GetPlatformView();
 
+  //----------------------------------------------------------------------------
+  /// @brief      The shell is destroyed on the platform task runner, so the
+  ///             pointer may only be checked and used there.
+  ///
+  /// @return     A weak pointer to the shell.
+  ///
+  fml::WeakPtr<Shell> GetWeakPtr() const;
+
   //----------------------------------------------------------------------------
   /// @brief      The IO Manager may only be accessed on the IO task runner.
   ///
@@ -281,10 +293,19 @@ class Shell final : public PlatformView::Delegate,
 
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify that there is a low memory
-  ///             warning. The shell will attempt to purge caches. Current, only
-  ///             the rasterizer cache is purged.
+  ///             warning. The shell will attempt to purge caches. This is
+  ///             equivalent to `MemoryPressureLevel::kCritical`.
   void NotifyLowMemoryWarning() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to notify that the system is low on
+  ///             memory. The Dart VM, the font collection and the caches of
+  ///             the rasterizer release memory in proportion to the level.
+  ///
+  /// @param[in]  level  How much memory should be released.
+  ///
+  void NotifyMemoryPressure(MemoryPressureLevel level) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to check if all shell subcomponents are
   ///             initialized. It is the embedder's responsibility to make this
@@ -325,6 +346,14 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::Status WaitForFirstFrame(fml::TimeDelta timeout);
 
+  //----------------------------------------------------------------------------
+  /// @brief      The phases of the startup of this shell that have completed so
+  ///             far, such as VM creation and the setup of its subsystems on
+  ///             their threads, ending with the first frame. May be called
+  ///             from any thread.
+  ///
+  std::vector<StartupProfiler::Phase> GetStartupPhases() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to reload the system fonts in
   ///             FontCollection.
@@ -412,7 +441,15 @@ class Shell final : public PlatformView::Delegate,
   const fml::RefPtr<fml::RasterThreadMerger> parent_raster_thread_merger_;
   std::shared_ptr<ResourceCacheLimitCalculator>
       resource_cache_limit_calculator_;
-  size_t resource_cache_limit_;
+  // The limit derived from the size of the view, zero until the viewport
+  // metrics are known.
+  size_t resource_cache_limit_ = 0;
+  // The peak working set of the resource cache of the rasterizer over the
+  // last |kResourceCacheUpdateInterval| frames, on the platform task runner.
+  size_t resource_cache_working_set_bytes_ = 0;
+  // The number of frames rasterized since the working set was last sampled,
+  // on the raster task runner.
+  size_t frames_since_resource_cache_update_ = 0;
   const Settings settings_;
   DartVMRef vm_;
   mutable std::mutex time_recorder_mutex_;
@@ -423,6 +460,13 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
+  // Shared by the animator on the UI task runner and the raster task runner,
+  // see |Settings::enable_adaptive_frame_pacing|.
+  std::shared_ptr<FramePacer> frame_pacer_;
+  // The durations of the phases of the recent frames, on the raster task
+  // runner.
+  std::unique_ptr<FramePhaseHistograms> frame_phase_histograms_;
+  std::shared_ptr<StartupProfiler> startup_profiler_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
@@ -460,6 +504,23 @@ class Shell final : public PlatformView::Delegate,
   // here for easier conversions to Dart objects.
   std::vector<int64_t> unreported_timings_;
 
+  // The ports that the platform messages on each channel are delivered to,
+  // instead of the root isolate. Set on the UI thread and read on the
+  // platform thread.
+  std::mutex channel_ports_mutex_;
+  std::unordered_map<std::string, int64_t> channel_ports_;
+
+  // The textures marked as having a new frame available on the platform
+  // thread that the raster thread hasn't been told about yet. A single raster
+  // task and frame request are posted for all of the textures marked until the
+  // raster thread drains them, however many textures or frames there are.
+  struct PendingTextureFrames {
+    std::mutex mutex;
+    std::unordered_set<int64_t> texture_ids;
+  };
+  std::shared_ptr<PendingTextureFrames> pending_texture_frames_ =
+      std::make_shared<PendingTextureFrames>();
+
   /// Manages the displays. This class is thread safe, can be accessed from any
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
@@ -477,6 +538,11 @@ class Shell final : public PlatformView::Delegate,
   // How many frames have been timed since last report.
   size_t UnreportedFramesCount() const;
 
+  // Prefetches the assets that were loaded shortly after the previous launch,
+  // and records the assets loaded shortly after this one for the next. See
+  // |Settings::enable_asset_prefetch|.
+  void PrefetchAssets(const std::shared_ptr<AssetManager>& asset_manager);
+
   Shell(DartVMRef vm,
         const TaskRunners& task_runners,
         fml::RefPtr<fml::RasterThreadMerger> parent_merger,
@@ -492,6 +558,7 @@ class Shell final : public PlatformView::Delegate,
       std::shared_ptr<ShellIOManager> parent_io_manager,
       const std::shared_ptr<ResourceCacheLimitCalculator>&
           resource_cache_limit_calculator,
+      const std::shared_ptr<StartupProfiler>& startup_profiler,
       const TaskRunners& task_runners,
       const PlatformData& platform_data,
       const Settings& settings,
@@ -508,6 +575,7 @@ class Shell final : public PlatformView::Delegate,
       const std::shared_ptr<ShellIOManager>& parent_io_manager,
       const std::shared_ptr<ResourceCacheLimitCalculator>&
           resource_cache_limit_calculator,
+      const std::shared_ptr<StartupProfiler>& startup_profiler,
       Settings settings,
       DartVMRef vm,
       fml::RefPtr<const DartSnapshot> isolate_snapshot,
@@ -521,6 +589,14 @@ class Shell final : public PlatformView::Delegate,
              std::unique_ptr<Rasterizer> rasterizer,
              const std::shared_ptr<ShellIOManager>& io_manager);
 
+  // Makes the raster cache render its DisplayList images on the IO thread,
+  // see |Settings::enable_async_raster_cache_generation|.
+  void EnableAsyncRasterCacheGeneration();
+
+  // Makes the raster cache keep its DisplayList images on disk, see
+  // |Settings::enable_raster_cache_disk_store|.
+  void EnableRasterCacheDiskStore();
+
   void ReportTimings();
 
   // |PlatformView::Delegate|
@@ -568,9 +644,15 @@ class Shell final : public PlatformView::Delegate,
   // |PlatformView::Delegate|
   void OnPlatformViewSetNextFrameCallback(const fml::closure& closure) override;
 
+  // |PlatformView::Delegate|
+  void OnPlatformViewNotifyMemoryPressure(MemoryPressureLevel level) override;
+
   // |PlatformView::Delegate|
   const Settings& OnPlatformViewGetSettings() const override;
 
+  // |PlatformView::Delegate|
+  double OnPlatformViewGetDisplayRefreshRate() const override;
+
   // |PlatformView::Delegate|
   void LoadDartDeferredLibrary(
       intptr_t loading_unit_id,
@@ -581,6 +663,12 @@ class Shell final : public PlatformView::Delegate,
                                     const std::string error_message,
                                     bool transient) override;
 
+  // |PlatformView::Delegate|
+  void PrefetchDartDeferredLibrary(
+      intptr_t loading_unit_id,
+      std::unique_ptr<const fml::Mapping> snapshot_data,
+      std::unique_ptr<const fml::Mapping> snapshot_instructions) override;
+
   // |PlatformView::Delegate|
   void UpdateAssetResolverByType(
       std::unique_ptr<AssetResolver> updated_asset_resolver,
@@ -628,6 +716,14 @@ class Shell final : public PlatformView::Delegate,
   // |Engine::Delegate|
   void SetNeedsReportTimings(bool value) override;
 
+  // |Engine::Delegate|
+  void SetChannelPort(const std::string& channel, int64_t port) override;
+
+  // Posts the message to the port registered for its channel, if there is
+  // one. Returns false, leaving the message alone, if it wasn't posted.
+  bool PostPlatformMessageToChannelPort(
+      std::unique_ptr<PlatformMessage>& message);
+
   // |Engine::Delegate|
   std::unique_ptr<std::vector<std::string>> ComputePlatformResolvedLocale(
       const std::vector<std::string>& supported_locale_data) override;
@@ -703,6 +799,58 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the approximate number of bytes held by each of the caches
+  // that are trimmed under memory pressure.
+  bool OnServiceProtocolGetResidentCacheBytes(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the live, last frame peak and overall peak bytes of each
+  // category of GPU allocations, for renderers that account for them.
+  bool OnServiceProtocolGetGpuMemoryUsage(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the drawing operations of each picture layer of the last
+  // frame, such as the number of operations of each type, save layers, clips
+  // and the complexity of the paths drawn.
+  bool OnServiceProtocolGetLayerCanvasStatistics(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with how long painting each picture layer of the last sampled
+  // frame took and its bounds, costliest first. The optional 'sampleInterval'
+  // parameter samples one in every that many frames from now on, or none if
+  // it is 0. Unlike |OnServiceProtocolRenderFrameWithRasterStats|, this
+  // doesn't render additional frames or snapshots of the layers.
+  bool OnServiceProtocolGetLayerTimings(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with a histogram of the durations of each phase of the recent
+  // frames, from building them to submitting them to the surface.
+  bool OnServiceProtocolGetFramePhaseHistograms(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
+  // Service protocol handler
+  //
+  // Responds with the events in the trace ring buffers of all threads, in the
+  // JSON trace event format. See `fml/trace_ring_buffer.h`.
+  bool OnServiceProtocolDumpTraceRingBuffer(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Service protocol handler
   //
   // Renders a frame and responds with various statistics pertaining to the
@@ -724,7 +872,18 @@ class Shell final : public PlatformView::Delegate,
   void SendFontChangeNotification();
 
   // |ResourceCacheLimitItem|
-  size_t GetResourceCacheLimit() override { return resource_cache_limit_; };
+  //
+  // The limit derived from the size of the view, raised to leave headroom
+  // above the working set that was observed, so that the resources of a
+  // frame are not evicted while it is rendered.
+  size_t GetResourceCacheLimit() override;
+
+  // Recomputes the limit of the resource cache of the rasterizer from all of
+  // the shells that share the calculator.
+  void UpdateResourceCacheMaxBytes();
+
+  // How often the working set of the resource cache is sampled, in frames.
+  static constexpr size_t kResourceCacheUpdateInterval = 240;
 
   // Creates an asset bundle from the original settings asset path or
   // directory.
@@ -0,0 +1,107 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/shell_pool.h"
+
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ShellPool::ShellPool(
+    const Shell& spawner,
+    size_t capacity,
+    fml::TimeDelta replacement_delay,
+    RunConfigurationFactory run_configuration_factory,
+    std::string initial_route,
+    Shell::CreateCallback<PlatformView> on_create_platform_view,
+    Shell::CreateCallback<Rasterizer> on_create_rasterizer)
+    : spawner_(spawner.GetWeakPtr()),
+      platform_task_runner_(spawner.GetTaskRunners().GetPlatformTaskRunner()),
+      capacity_(capacity),
+      replacement_delay_(replacement_delay),
+      run_configuration_factory_(std::move(run_configuration_factory)),
+      initial_route_(std::move(initial_route)),
+      on_create_platform_view_(std::move(on_create_platform_view)),
+      on_create_rasterizer_(std::move(on_create_rasterizer)),
+      weak_factory_(this) {
+  FML_DCHECK(run_configuration_factory_);
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+  SchedulePrewarm();
+}
+
+ShellPool::~ShellPool() = default;
+
+std::unique_ptr<Shell> ShellPool::Take() {
+  TRACE_EVENT0("flutter", "ShellPool::Take");
+  std::unique_ptr<Shell> shell;
+  if (shells_.empty()) {
+    shell = Spawn();
+  } else {
+    shell = std::move(shells_.front());
+    shells_.pop_front();
+  }
+  earliest_prewarm_time_ = fml::TimePoint::Now() + replacement_delay_;
+  SchedulePrewarm();
+  return shell;
+}
+
+size_t ShellPool::GetPrewarmedCount() const {
+  return shells_.size();
+}
+
+void ShellPool::Clear() {
+  shells_.clear();
+}
+
+std::unique_ptr<Shell> ShellPool::Spawn() const {
+  FML_DCHECK(platform_task_runner_->RunsTasksOnCurrentThread());
+  if (!spawner_) {
+    return nullptr;
+  }
+  RunConfiguration run_configuration = run_configuration_factory_();
+  if (!run_configuration.IsValid()) {
+    FML_LOG(ERROR) << "Could not create a configuration for a pooled shell.";
+    return nullptr;
+  }
+  return spawner_->Spawn(std::move(run_configuration), initial_route_,
+                         on_create_platform_view_, on_create_rasterizer_);
+}
+
+void ShellPool::SchedulePrewarm() {
+  if (prewarm_pending_ || !spawner_ || shells_.size() >= capacity_) {
+    return;
+  }
+  prewarm_pending_ = true;
+  platform_task_runner_->PostTaskForTime(
+      [weak_pool = weak_factory_.GetWeakPtr()]() {
+        if (weak_pool) {
+          weak_pool->Prewarm();
+        }
+      },
+      earliest_prewarm_time_);
+}
+
+void ShellPool::Prewarm() {
+  TRACE_EVENT0("flutter", "ShellPool::Prewarm");
+  prewarm_pending_ = false;
+  if (fml::TimePoint::Now() < earliest_prewarm_time_) {
+    // A shell was taken since this prewarm was scheduled.
+    SchedulePrewarm();
+    return;
+  }
+  if (shells_.size() >= capacity_) {
+    return;
+  }
+  std::unique_ptr<Shell> shell = Spawn();
+  if (!shell) {
+    // Spawning is retried the next time a shell is taken.
+    return;
+  }
+  shells_.push_back(std::move(shell));
+  SchedulePrewarm();
+}
+
+}  // namespace flutter
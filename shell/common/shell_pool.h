@@ -0,0 +1,108 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SHELL_POOL_H_
+#define FLUTTER_SHELL_COMMON_SHELL_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/run_configuration.h"
+#include "flutter/shell/common/shell.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Keeps a number of shells spawned from another shell ready to be
+///             handed out.
+///
+///             Spawning a shell creates its engine and launches its root
+///             isolate synchronously, which is visible as latency when screens
+///             are opened on demand. The pool instead spawns shells ahead of
+///             time, one per platform task so that it doesn't hold up the
+///             platform thread, and hands them out as they are needed.
+///
+///             Pooled shells are run with configurations from the
+///             configuration factory. As the entrypoint of a shell can't be
+///             changed once it is running, this is usually a standby
+///             entrypoint that waits for the embedder to tell it what to show,
+///             for example over a platform channel.
+///
+///             Spawning still happens on the platform thread, so a shell that
+///             is taken is only replaced once the replacement delay has
+///             passed. This keeps the spawn from janking the first frames of
+///             the screen the taken shell is shown in.
+///
+///             The pool must be created, used and destroyed on the platform
+///             thread of the spawning shell. If the spawning shell is
+///             destroyed first, the pool stops spawning shells.
+///
+class ShellPool {
+ public:
+  using RunConfigurationFactory = std::function<RunConfiguration()>;
+
+  ShellPool(const Shell& spawner,
+            size_t capacity,
+            fml::TimeDelta replacement_delay,
+            RunConfigurationFactory run_configuration_factory,
+            std::string initial_route,
+            Shell::CreateCallback<PlatformView> on_create_platform_view,
+            Shell::CreateCallback<Rasterizer> on_create_rasterizer);
+
+  ~ShellPool();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands out a running shell. If no shell has been spawned ahead
+  ///             of time, one is spawned synchronously. In either case, the
+  ///             pool spawns a replacement after the replacement delay.
+  ///
+  /// @return     The shell, or nullptr if it could not be spawned or the
+  ///             spawning shell has been destroyed.
+  ///
+  std::unique_ptr<Shell> Take();
+
+  //----------------------------------------------------------------------------
+  /// @return     The number of shells that are ready to be handed out.
+  ///
+  size_t GetPrewarmedCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the shells that are ready to be handed out. The pool
+  ///             spawns them again once a shell is taken.
+  ///
+  void Clear();
+
+ private:
+  const fml::WeakPtr<Shell> spawner_;
+  const fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  const size_t capacity_;
+  const fml::TimeDelta replacement_delay_;
+  const RunConfigurationFactory run_configuration_factory_;
+  const std::string initial_route_;
+  const Shell::CreateCallback<PlatformView> on_create_platform_view_;
+  const Shell::CreateCallback<Rasterizer> on_create_rasterizer_;
+  std::deque<std::unique_ptr<Shell>> shells_;
+  bool prewarm_pending_ = false;
+  fml::TimePoint earliest_prewarm_time_;
+  fml::WeakPtrFactory<ShellPool> weak_factory_;
+
+  std::unique_ptr<Shell> Spawn() const;
+
+  void SchedulePrewarm();
+
+  void Prewarm();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ShellPool);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SHELL_POOL_H_
@@ -274,6 +274,21 @@ void ShellTest::OnServiceProtocol(
       case ServiceProtocolEnum::kRenderFrameWithRasterStats:
         shell->OnServiceProtocolRenderFrameWithRasterStats(params, response);
         break;
+      case ServiceProtocolEnum::kGetResidentCacheBytes:
+        shell->OnServiceProtocolGetResidentCacheBytes(params, response);
+        break;
+      case ServiceProtocolEnum::kGetGpuMemoryUsage:
+        shell->OnServiceProtocolGetGpuMemoryUsage(params, response);
+        break;
+      case ServiceProtocolEnum::kGetLayerCanvasStatistics:
+        shell->OnServiceProtocolGetLayerCanvasStatistics(params, response);
+        break;
+      case ServiceProtocolEnum::kGetLayerTimings:
+        shell->OnServiceProtocolGetLayerTimings(params, response);
+        break;
+      case ServiceProtocolEnum::kDumpTraceRingBuffer:
+        shell->OnServiceProtocolDumpTraceRingBuffer(params, response);
+        break;
     }
     finished.set_value(true);
   });
@@ -108,6 +108,11 @@ class ShellTest : public FixtureTest {
     kSetAssetBundlePath,
     kRunInView,
     kRenderFrameWithRasterStats,
+    kGetResidentCacheBytes,
+    kGetGpuMemoryUsage,
+    kGetLayerCanvasStatistics,
+    kGetLayerTimings,
+    kDumpTraceRingBuffer,
   };
 
   // Helper method to test private method Shell::OnServiceProtocolGetSkSLs.
@@ -30,9 +30,11 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
+#include "flutter/shell/common/shell_pool.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_external_view_embedder.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -71,6 +73,9 @@ class MockPlatformViewDelegate : public PlatformView::Delegate {
   MOCK_METHOD1(OnPlatformViewSetNextFrameCallback,
                void(const fml::closure& closure));
 
+  MOCK_METHOD1(OnPlatformViewNotifyMemoryPressure,
+               void(MemoryPressureLevel level));
+
   MOCK_METHOD1(OnPlatformViewSetViewportMetrics,
                void(const ViewportMetrics& metrics));
 
@@ -111,6 +116,10 @@ class MockPlatformViewDelegate : public PlatformView::Delegate {
                void(intptr_t loading_unit_id,
                     const std::string error_message,
                     bool transient));
+  MOCK_METHOD3(PrefetchDartDeferredLibrary,
+               void(intptr_t loading_unit_id,
+                    std::unique_ptr<const fml::Mapping> snapshot_data,
+                    std::unique_ptr<const fml::Mapping> snapshot_instructions));
 
   MOCK_METHOD2(UpdateAssetResolverByType,
                void(std::unique_ptr<AssetResolver> updated_asset_resolver,
@@ -1484,6 +1493,39 @@ TEST_F(ShellTest, WaitForFirstFrame) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, RecordsStartupPhasesUntilTheFirstFrame) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  PlatformViewNotifyCreated(shell.get());
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  ASSERT_TRUE(shell->WaitForFirstFrame(fml::TimeDelta::Max()).ok());
+
+  std::vector<StartupProfiler::Phase> phases = shell->GetStartupPhases();
+  auto find_phase = [&phases](const std::string& name) {
+    return std::find_if(
+        phases.begin(), phases.end(),
+        [&name](const StartupProfiler::Phase& phase) {
+          return phase.name == name;
+        });
+  };
+  for (const char* name :
+       {"SnapshotMapping", "VMCreation", "PlatformViewSetup", "RasterizerSetup",
+        "IOManagerSetup", "EngineSetup"}) {
+    auto phase = find_phase(name);
+    ASSERT_NE(phase, phases.end()) << name;
+    EXPECT_LE(phase->start, phase->end);
+  }
+  auto first_frame = find_phase(StartupProfiler::kTimeToFirstFramePhase);
+  ASSERT_NE(first_frame, phases.end());
+  EXPECT_GE(first_frame->end, find_phase("EngineSetup")->end);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, WaitForFirstFrameZeroSizeFrame) {
   auto settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell = CreateShell(settings);
@@ -1831,6 +1873,50 @@ TEST_F(ShellTest, SetResourceCacheSizeNotifiesDart) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, PostsPlatformMessagesToChannelPort) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("postsChannelMessagesToPort");
+
+  fml::AutoResetWaitableEvent ready_latch;
+  AddNativeCallback("NotifyNative",
+                    CREATE_NATIVE_ENTRY([&ready_latch](auto args) {
+                      ready_latch.Signal();
+                    }));
+  fml::AutoResetWaitableEvent message_latch;
+  std::string message_from_dart;
+  AddNativeCallback("NotifyMessage",
+                    CREATE_NATIVE_ENTRY([&](Dart_NativeArguments args) {
+                      message_from_dart =
+                          tonic::DartConverter<std::string>::FromDart(
+                              Dart_GetNativeArgument(args, 0));
+                      message_latch.Signal();
+                    }));
+
+  RunEngine(shell.get(), std::move(configuration));
+  ready_latch.Wait();
+
+  fml::RefPtr<MockPlatformMessageResponse> response =
+      MockPlatformMessageResponse::Create();
+  EXPECT_CALL(*response, CompleteEmpty());
+  std::string payload = "hello";
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetPlatformTaskRunner(),
+      [&shell, &payload, response]() {
+        auto message = std::make_unique<PlatformMessage>(
+            "test/channel",
+            fml::MallocMapping::Copy(payload.c_str(), payload.length()),
+            response);
+        shell->GetPlatformView()->DispatchPlatformMessage(std::move(message));
+      });
+  message_latch.Wait();
+
+  EXPECT_EQ(message_from_dart, "test/channel:hello");
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, CanCreateImagefromDecompressedBytes) {
   Settings settings = CreateSettingsForFixture();
   auto task_runner = CreateNewThread();
@@ -1938,6 +2024,57 @@ TEST_F(ShellTest, TextureFrameMarkedAvailableAndUnregister) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, TextureFramesMarkedAvailableAreCoalesced) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  std::shared_ptr<fml::AutoResetWaitableEvent> latch =
+      std::make_shared<fml::AutoResetWaitableEvent>();
+
+  std::shared_ptr<MockTexture> first_texture =
+      std::make_shared<MockTexture>(0, latch);
+  std::shared_ptr<MockTexture> second_texture =
+      std::make_shared<MockTexture>(1, latch);
+
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(), [&]() {
+        shell->GetPlatformView()->RegisterTexture(first_texture);
+        shell->GetPlatformView()->RegisterTexture(second_texture);
+        // All of these are marked before the raster thread gets to them.
+        shell->GetPlatformView()->MarkTextureFrameAvailable(0);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(1);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(0);
+        shell->GetPlatformView()->MarkTextureFrameAvailable(0);
+      });
+  latch->Wait();
+  PostSync(shell->GetTaskRunners().GetRasterTaskRunner(), [] {});
+
+  EXPECT_EQ(first_texture->frames_available(), 1);
+  EXPECT_EQ(second_texture->frames_available(), 1);
+  latch->Reset();
+
+  // Frames marked after the raster thread drained the others are delivered.
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetRasterTaskRunner(),
+      [&]() { shell->GetPlatformView()->MarkTextureFrameAvailable(0); });
+  latch->Wait();
+  PostSync(shell->GetTaskRunners().GetRasterTaskRunner(), [] {});
+
+  EXPECT_EQ(first_texture->frames_available(), 2);
+  EXPECT_EQ(second_texture->frames_available(), 1);
+
+  DestroyShell(std::move(shell), task_runners);
+}
+
 TEST_F(ShellTest, IsolateCanAccessPersistentIsolateData) {
   const std::string message = "dummy isolate launch data.";
 
@@ -2545,6 +2682,144 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, NotifyMemoryPressureTrimsResidentCaches) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  fml::AutoResetWaitableEvent notified;
+  fml::TaskRunner::RunNowOrPostTask(
+      shell->GetTaskRunners().GetPlatformTaskRunner(), [&shell, &notified]() {
+        shell->NotifyMemoryPressure(MemoryPressureLevel::kBackground);
+        notified.Signal();
+      });
+  notified.Wait();
+
+  // The caches are trimmed on the raster task runner before the report is
+  // made there.
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetResidentCacheBytes,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"ResidentCacheBytes\",\"caches\":{\"rasterCache\":0},"
+      "\"totalBytes\":0}";
+  ASSERT_EQ(std::string(buffer.GetString()), expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, GetGpuMemoryUsageIsEmptyWithoutImpeller) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  // Skia doesn't account for its allocations by category.
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetGpuMemoryUsage,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"GpuMemoryUsage\",\"categories\":{},\"liveBytes\":0}";
+  ASSERT_EQ(std::string(buffer.GetString()), expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, GetLayerCanvasStatisticsIsEmptyWithoutFrames) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetLayerCanvasStatistics,
+                    shell->GetTaskRunners().GetRasterTaskRunner(),
+                    empty_params, &document);
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  document.Accept(writer);
+  std::string expected_json =
+      "{\"type\":\"LayerCanvasStatistics\",\"layers\":[]}";
+  ASSERT_EQ(std::string(buffer.GetString()), expected_json);
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, GetLayerTimingsSetsTheSampleInterval) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  auto get_layer_timings =
+      [&shell](const ServiceProtocol::Handler::ServiceProtocolMap& params) {
+        rapidjson::Document document;
+        OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetLayerTimings,
+                          shell->GetTaskRunners().GetRasterTaskRunner(),
+                          params, &document);
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        document.Accept(writer);
+        return std::string(buffer.GetString());
+      };
+
+  ASSERT_EQ(get_layer_timings({}),
+            "{\"type\":\"LayerTimings\",\"sampleInterval\":0,"
+            "\"layers\":[]}");
+  ASSERT_EQ(get_layer_timings({{"sampleInterval", "60"}}),
+            "{\"type\":\"LayerTimings\",\"sampleInterval\":60,"
+            "\"layers\":[]}");
+  ASSERT_EQ(get_layer_timings({}),
+            "{\"type\":\"LayerTimings\",\"sampleInterval\":60,"
+            "\"layers\":[]}");
+  ASSERT_THAT(get_layer_timings({{"sampleInterval", "-1"}}),
+              ::testing::HasSubstr("sampleInterval"));
+
+  DestroyShell(std::move(shell));
+}
+
+TEST_F(ShellTest, DumpTraceRingBufferRespondsWithTraceEvents) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+
+  fml::tracing::TraceRingBufferSetEnabled(true);
+  fml::tracing::TraceRingBufferClear();
+  const char* names[] = {"frame"};
+  const char* values[] = {"1"};
+  fml::tracing::TraceRingBufferRecord("RingBufferTestEvent", 5, 0,
+                                      Dart_Timeline_Event_Instant, 1, names,
+                                      values);
+
+  ServiceProtocol::Handler::ServiceProtocolMap empty_params;
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kDumpTraceRingBuffer,
+                    shell->GetTaskRunners().GetIOTaskRunner(), empty_params,
+                    &document);
+  fml::tracing::TraceRingBufferSetEnabled(false);
+  fml::tracing::TraceRingBufferClear();
+
+  ASSERT_TRUE(document.IsObject());
+  ASSERT_EQ(std::string(document["type"].GetString()), "TraceRingBuffer");
+  ASSERT_TRUE(document["enabled"].GetBool());
+  ASSERT_TRUE(document["traceEvents"].IsArray());
+  bool found = false;
+  for (const auto& event : document["traceEvents"].GetArray()) {
+    if (std::string(event["name"].GetString()) == "RingBufferTestEvent") {
+      found = true;
+      EXPECT_EQ(std::string(event["ph"].GetString()), "i");
+      EXPECT_EQ(event["ts"].GetInt64(), 5);
+      EXPECT_EQ(std::string(event["args"]["frame"].GetString()), "1");
+    }
+  }
+  ASSERT_TRUE(found);
+
+  DestroyShell(std::move(shell));
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -3104,6 +3379,106 @@ TEST_F(ShellTest, Spawn) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+TEST_F(ShellTest, ShellPoolHandsOutPrewarmedShells) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  ASSERT_TRUE(configuration.IsValid());
+  configuration.SetEntrypoint("fixturesAreFunctionalMain");
+  fml::AutoResetWaitableEvent main_latch;
+  AddNativeCallback(
+      "SayHiFromFixturesAreFunctionalMain",
+      CREATE_NATIVE_ENTRY([&main_latch](auto args) { main_latch.Signal(); }));
+  RunEngine(shell.get(), std::move(configuration));
+  main_latch.Wait();
+
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+  MockPlatformViewDelegate platform_view_delegate;
+  std::unique_ptr<ShellPool> pool;
+  PostSync(platform_task_runner, [&pool, &shell, &settings,
+                                  &platform_view_delegate]() {
+    pool = std::make_unique<ShellPool>(
+        *shell, 2u, fml::TimeDelta::FromMilliseconds(10),
+        [settings]() {
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("emptyMain");
+          return configuration;
+        },
+        "/standby",
+        [&platform_view_delegate](Shell& shell) {
+          auto result = std::make_unique<MockPlatformView>(
+              platform_view_delegate, shell.GetTaskRunners());
+          ON_CALL(*result, CreateRenderingSurface())
+              .WillByDefault(::testing::Invoke(
+                  [] { return std::make_unique<MockSurface>(); }));
+          return result;
+        },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  });
+
+  // Prewarming happens in tasks posted to the platform thread, so each of
+  // these waits gives it the chance to make progress.
+  auto wait_for_prewarmed_shells = [&platform_task_runner, &pool]() {
+    size_t prewarmed_count = 0u;
+    while (prewarmed_count < 2u) {
+      PostSync(platform_task_runner, [&pool, &prewarmed_count]() {
+        prewarmed_count = pool->GetPrewarmedCount();
+      });
+    }
+  };
+  wait_for_prewarmed_shells();
+
+  std::unique_ptr<Shell> taken;
+  PostSync(platform_task_runner, [&pool, &taken]() {
+    taken = pool->Take();
+    EXPECT_EQ(pool->GetPrewarmedCount(), 1u);
+  });
+  ASSERT_TRUE(ValidateShell(taken.get()));
+  PostSync(taken->GetTaskRunners().GetUITaskRunner(), [&taken]() {
+    EXPECT_EQ(taken->GetEngine()->GetLastEntrypoint(), "emptyMain");
+    EXPECT_EQ(taken->GetEngine()->InitialRoute(), "/standby");
+  });
+
+  // The pool replaces the shell that was taken.
+  wait_for_prewarmed_shells();
+
+  PostSync(platform_task_runner, [&pool, &taken]() {
+    pool->Clear();
+    EXPECT_EQ(pool->GetPrewarmedCount(), 0u);
+    pool.reset();
+    taken.reset();
+  });
+  DestroyShell(std::move(shell));
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
+TEST_F(ShellTest, ShellPoolStopsSpawningOnceTheSpawnerIsDestroyed) {
+  auto settings = CreateSettingsForFixture();
+  auto shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+  std::unique_ptr<ShellPool> pool;
+  PostSync(platform_task_runner, [&pool, &shell, &settings]() {
+    // With no capacity, the pool only spawns when a shell is taken.
+    pool = std::make_unique<ShellPool>(
+        *shell, 0u, fml::TimeDelta::Zero(),
+        [settings]() { return RunConfiguration::InferFromSettings(settings); },
+        "/", [](Shell& shell) { return nullptr; },
+        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+  });
+  DestroyShell(std::move(shell));
+
+  PostSync(platform_task_runner, [&pool]() {
+    EXPECT_EQ(pool->Take(), nullptr);
+    EXPECT_EQ(pool->GetPrewarmedCount(), 0u);
+    pool.reset();
+  });
+  ASSERT_FALSE(DartVMRef::IsInstanceRunning());
+}
+
 TEST_F(ShellTest, SpawnWithDartEntrypointArgs) {
   auto settings = CreateSettingsForFixture();
   auto shell = CreateShell(settings);
@@ -3973,6 +4348,44 @@ TEST_F(ShellTest, PictureToImageSyncWithTrampledContext) {
 }
 #endif  // SHELL_ENABLE_GL
 
+TEST_F(ShellTest, PictureToImagePipelined) {
+#if !SHELL_ENABLE_GL
+  // This test uses the GL backend.
+  GTEST_SKIP();
+#endif  // !SHELL_ENABLE_GL
+  auto settings = CreateSettingsForFixture();
+  settings.enable_pipelined_snapshots = true;
+  std::unique_ptr<Shell> shell =
+      CreateShell(settings,                                       //
+                  GetTaskRunnersForFixture(),                     //
+                  false,                                          //
+                  nullptr,                                        //
+                  false,                                          //
+                  ShellTestPlatformView::BackendType::kGLBackend  //
+      );
+
+  fml::AutoResetWaitableEvent latch;
+  bool passed = false;
+  AddNativeCallback("NotifyNativeBool", CREATE_NATIVE_ENTRY([&](auto args) {
+                      passed = tonic::DartConverter<bool>::FromDart(
+                          Dart_GetNativeArgument(args, 0));
+                      latch.Signal();
+                    }));
+
+  ASSERT_NE(shell, nullptr);
+  ASSERT_TRUE(shell->IsSetup());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  PlatformViewNotifyCreated(shell.get());
+  configuration.SetEntrypoint("toImagePipelined");
+  RunEngine(shell.get(), std::move(configuration));
+
+  latch.Wait();
+  EXPECT_TRUE(passed);
+
+  PlatformViewNotifyDestroyed(shell.get());
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, PluginUtilitiesCallbackHandleErrorHandling) {
   auto settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell =
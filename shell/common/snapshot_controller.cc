@@ -26,4 +26,14 @@ std::unique_ptr<SnapshotController> SnapshotController::Make(
 SnapshotController::SnapshotController(const Delegate& delegate)
     : delegate_(delegate) {}
 
+void SnapshotController::ConvertToRasterImageAsync(
+    sk_sp<SkImage> image,
+    std::function<void(sk_sp<SkImage>)> callback) {
+  callback(ConvertToRasterImage(std::move(image)));
+}
+
+bool SnapshotController::CheckRasterImageConversions() {
+  return false;
+}
+
 }  // namespace flutter
@@ -36,6 +36,18 @@ class SnapshotController {
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) = 0;
 
+  /// Converts the image to a raster image without waiting for the GPU, see
+  /// |SnapshotDelegate::ConvertToRasterImageAsync|. Controllers that can't
+  /// read back asynchronously convert the image right away.
+  virtual void ConvertToRasterImageAsync(
+      sk_sp<SkImage> image,
+      std::function<void(sk_sp<SkImage>)> callback);
+
+  /// Invokes the callbacks of the asynchronous conversions whose pixels have
+  /// been read back. Returns whether any conversions are still pending, in
+  /// which case this should be called again later.
+  virtual bool CheckRasterImageConversions();
+
  protected:
   explicit SnapshotController(const Delegate& delegate);
   const Delegate& GetDelegate() { return delegate_; }
@@ -4,10 +4,13 @@
 
 #include "flutter/shell/common/snapshot_controller_skia.h"
 
+#include <algorithm>
+
 #include "display_list/display_list_image.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/shell/common/snapshot_controller.h"
+#include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
@@ -153,4 +156,125 @@ sk_sp<SkImage> SnapshotControllerSkia::ConvertToRasterImage(
   return result->skia_image();
 }
 
+SnapshotControllerSkia::~SnapshotControllerSkia() {
+  // The pixels of these won't be read back anymore.
+  for (const auto& conversion : pending_conversions_) {
+    conversion->callback(nullptr);
+  }
+}
+
+void SnapshotControllerSkia::OnPixelsRead(
+    SkImage::ReadPixelsContext context,
+    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+  std::unique_ptr<std::shared_ptr<PendingConversion>> conversion(
+      static_cast<std::shared_ptr<PendingConversion>*>(context));
+  (*conversion)->is_read = true;
+  if (!result || result->count() != 1) {
+    FML_LOG(ERROR) << "Could not read back the pixels of the image.";
+    return;
+  }
+
+  // The raster image uses the transfer buffer of the result, which Skia
+  // allows releasing on any thread.
+  const SkImageInfo& image_info = (*conversion)->image_info;
+  const size_t row_bytes = result->rowBytes(0);
+  const void* pixels = result->data(0);
+  auto data = SkData::MakeWithProc(
+      pixels, row_bytes * image_info.height(),
+      [](const void* pixels, void* result) {
+        delete static_cast<const SkImage::AsyncReadResult*>(result);
+      },
+      const_cast<SkImage::AsyncReadResult*>(result.release()));
+  (*conversion)->raster_image =
+      SkImage::MakeRasterData(image_info, std::move(data), row_bytes);
+}
+
+void SnapshotControllerSkia::ConvertToRasterImageAsync(
+    sk_sp<SkImage> image,
+    std::function<void(sk_sp<SkImage>)> callback) {
+  TRACE_EVENT0("flutter", __FUNCTION__);
+  const auto& surface = GetDelegate().GetSurface();
+  if (image == nullptr || surface == nullptr ||
+      surface->GetContext() == nullptr) {
+    callback(ConvertToRasterImage(std::move(image)));
+    return;
+  }
+
+  auto conversion = std::make_shared<PendingConversion>();
+  conversion->callback = std::move(callback);
+  conversion->image_info = SkImageInfo::MakeN32Premul(image->dimensions(),
+                                                      SkColorSpace::MakeSRGB());
+  bool is_reading = false;
+  GetDelegate().GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        auto context_switch = surface->MakeRenderContextCurrent();
+        if (!context_switch->GetResult()) {
+          return;
+        }
+        GrDirectContext* context = surface->GetContext();
+        const SkImageInfo& image_info = conversion->image_info;
+        // Images larger than a render target are scaled down by the
+        // synchronous conversion.
+        if (std::max(image_info.width(), image_info.height()) >
+            context->maxRenderTargetSize()) {
+          return;
+        }
+        sk_sp<SkSurface> sk_surface = SkSurface::MakeRenderTarget(
+            context, skgpu::Budgeted::kNo, image_info);
+        if (!sk_surface) {
+          return;
+        }
+        sk_surface->getCanvas()->drawImage(image, 0, 0);
+        sk_surface->asyncRescaleAndReadPixels(
+            image_info, image_info.bounds(), SkImage::RescaleGamma::kSrc,
+            SkImage::RescaleMode::kNearest, &OnPixelsRead,
+            new std::shared_ptr<PendingConversion>(conversion));
+        context->flushAndSubmit();
+        is_reading = true;
+      }));
+
+  if (!is_reading) {
+    conversion->callback(ConvertToRasterImage(std::move(image)));
+    return;
+  }
+  pending_conversions_.push_back(std::move(conversion));
+}
+
+bool SnapshotControllerSkia::CheckRasterImageConversions() {
+  if (pending_conversions_.empty()) {
+    return false;
+  }
+
+  const auto& surface = GetDelegate().GetSurface();
+  if (surface == nullptr || surface->GetContext() == nullptr) {
+    // The context that reads the pixels back is gone.
+    auto conversions = std::move(pending_conversions_);
+    pending_conversions_.clear();
+    for (const auto& conversion : conversions) {
+      conversion->callback(nullptr);
+    }
+    return false;
+  }
+
+  GetDelegate().GetIsGpuDisabledSyncSwitch()->Execute(
+      fml::SyncSwitch::Handlers().SetIfFalse([&] {
+        auto context_switch = surface->MakeRenderContextCurrent();
+        if (context_switch->GetResult()) {
+          surface->GetContext()->checkAsyncWorkCompletion();
+        }
+      }));
+
+  auto read = std::stable_partition(
+      pending_conversions_.begin(), pending_conversions_.end(),
+      [](const auto& conversion) { return !conversion->is_read; });
+  std::vector<std::shared_ptr<PendingConversion>> read_conversions(
+      std::make_move_iterator(read),
+      std::make_move_iterator(pending_conversions_.end()));
+  pending_conversions_.erase(read, pending_conversions_.end());
+  for (const auto& conversion : read_conversions) {
+    conversion->callback(std::move(conversion->raster_image));
+  }
+  return !pending_conversions_.empty();
+}
+
 }  // namespace flutter
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_SKIA_H_
 #define FLUTTER_SHELL_COMMON_SNAPSHOT_CONTROLLER_SKIA_H_
 
+#include <memory>
+#include <vector>
+
 #include "flutter/shell/common/snapshot_controller.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -15,12 +18,35 @@ class SnapshotControllerSkia : public SnapshotController {
   explicit SnapshotControllerSkia(const SnapshotController::Delegate& delegate)
       : SnapshotController(delegate) {}
 
+  ~SnapshotControllerSkia() override;
+
   sk_sp<DlImage> MakeRasterSnapshot(sk_sp<DisplayList> display_list,
                                     SkISize size) override;
 
   virtual sk_sp<SkImage> ConvertToRasterImage(sk_sp<SkImage> image) override;
 
+  void ConvertToRasterImageAsync(
+      sk_sp<SkImage> image,
+      std::function<void(sk_sp<SkImage>)> callback) override;
+
+  bool CheckRasterImageConversions() override;
+
  private:
+  // A conversion whose pixels are being read back into a transfer buffer.
+  struct PendingConversion {
+    std::function<void(sk_sp<SkImage>)> callback;
+    SkImageInfo image_info;
+    // Set by the read back, which may fail and leave |raster_image| unset.
+    bool is_read = false;
+    sk_sp<SkImage> raster_image;
+  };
+
+  std::vector<std::shared_ptr<PendingConversion>> pending_conversions_;
+
+  static void OnPixelsRead(
+      SkImage::ReadPixelsContext context,
+      std::unique_ptr<const SkImage::AsyncReadResult> result);
+
   sk_sp<DlImage> DoMakeRasterSnapshot(
       SkISize size,
       std::function<void(SkCanvas*)> draw_callback);
@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+StartupProfiler::StartupProfiler() : start_time_(fml::TimePoint::Now()) {}
+
+StartupProfiler::~StartupProfiler() = default;
+
+StartupProfiler::ScopedPhase::ScopedPhase(StartupProfiler* profiler,
+                                          const char* name)
+    : profiler_(profiler), name_(name), start_(fml::TimePoint::Now()) {
+  if (profiler_) {
+    fml::tracing::TraceEvent0("flutter", name_);
+  }
+}
+
+StartupProfiler::ScopedPhase::~ScopedPhase() {
+  if (profiler_) {
+    fml::tracing::TraceEventEnd(name_);
+    profiler_->AddPhase(name_, start_, fml::TimePoint::Now());
+  }
+}
+
+void StartupProfiler::AddPhase(const char* name,
+                               fml::TimePoint start,
+                               fml::TimePoint end) {
+  std::scoped_lock lock(mutex_);
+  phases_.push_back({name, start, end});
+}
+
+bool StartupProfiler::MarkFirstFrame() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (first_frame_marked_) {
+      return false;
+    }
+    first_frame_marked_ = true;
+  }
+  AddPhase(kTimeToFirstFramePhase, start_time_, fml::TimePoint::Now());
+  return true;
+}
+
+fml::TimePoint StartupProfiler::GetStartTime() const {
+  return start_time_;
+}
+
+std::vector<StartupProfiler::Phase> StartupProfiler::GetPhases() const {
+  std::vector<Phase> phases;
+  {
+    std::scoped_lock lock(mutex_);
+    phases = phases_;
+  }
+  std::stable_sort(phases.begin(), phases.end(),
+                   [](const Phase& a, const Phase& b) {
+                     return a.start < b.start;
+                   });
+  return phases;
+}
+
+std::string StartupProfiler::GetSummary() const {
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(2);
+  for (const auto& phase : GetPhases()) {
+    stream << phase.name << ": +"
+           << (phase.start - start_time_).ToMillisecondsF() << "ms, took "
+           << (phase.end - phase.start).ToMillisecondsF() << "ms\n";
+  }
+  return stream.str();
+}
+
+}  // namespace flutter
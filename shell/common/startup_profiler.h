@@ -0,0 +1,83 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_PROFILER_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_PROFILER_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+/// Records how long each phase of the startup of a shell took, from the
+/// moment the shell started being created to its first frame. Phases that
+/// run on different threads may overlap. Each phase is also emitted to the
+/// timeline as it happens.
+///
+/// Phases may be recorded from any thread.
+class StartupProfiler {
+ public:
+  struct Phase {
+    std::string name;
+    fml::TimePoint start;
+    fml::TimePoint end;
+  };
+
+  /// The name of the phase from the start of the creation of the shell to
+  /// the end of its first frame.
+  static constexpr const char* kTimeToFirstFramePhase = "TimeToFirstFrame";
+
+  /// Records the time it happens in as the start of the startup.
+  StartupProfiler();
+
+  ~StartupProfiler();
+
+  /// Records a phase while it is in scope. The
+  /// profiler may be null, in which case nothing is recorded. The name must
+  /// outlive the phase.
+  class ScopedPhase {
+   public:
+    ScopedPhase(StartupProfiler* profiler, const char* name);
+
+    ~ScopedPhase();
+
+   private:
+    StartupProfiler* const profiler_;
+    const char* const name_;
+    const fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedPhase);
+  };
+
+  void AddPhase(const char* name, fml::TimePoint start, fml::TimePoint end);
+
+  /// Records the |kTimeToFirstFramePhase| phase, if it hasn't been recorded
+  /// yet. Returns whether it was recorded.
+  bool MarkFirstFrame();
+
+  fml::TimePoint GetStartTime() const;
+
+  /// The phases that have been recorded, in the order they started.
+  std::vector<Phase> GetPhases() const;
+
+  /// A human readable breakdown of the phases, one per line, with their
+  /// offsets from the start of the startup.
+  std::string GetSummary() const;
+
+ private:
+  const fml::TimePoint start_time_;
+  mutable std::mutex mutex_;
+  std::vector<Phase> phases_;
+  bool first_frame_marked_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupProfiler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_PROFILER_H_
@@ -0,0 +1,65 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_profiler.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(StartupProfilerTest, RecordsScopedPhases) {
+  StartupProfiler profiler;
+  {
+    StartupProfiler::ScopedPhase phase(&profiler, "First");
+  }
+  std::thread thread([&profiler]() {
+    StartupProfiler::ScopedPhase phase(&profiler, "Second");
+  });
+  thread.join();
+
+  std::vector<StartupProfiler::Phase> phases = profiler.GetPhases();
+  ASSERT_EQ(phases.size(), 2u);
+  EXPECT_EQ(phases[0].name, "First");
+  EXPECT_EQ(phases[1].name, "Second");
+  EXPECT_LE(profiler.GetStartTime(), phases[0].start);
+  EXPECT_LE(phases[0].start, phases[0].end);
+  EXPECT_LE(phases[0].start, phases[1].start);
+}
+
+TEST(StartupProfilerTest, OrdersPhasesByStartTime) {
+  StartupProfiler profiler;
+  fml::TimePoint start = profiler.GetStartTime();
+  profiler.AddPhase("Late", start + fml::TimeDelta::FromMilliseconds(5),
+                    start + fml::TimeDelta::FromMilliseconds(6));
+  profiler.AddPhase("Early", start + fml::TimeDelta::FromMilliseconds(1),
+                    start + fml::TimeDelta::FromMilliseconds(8));
+
+  std::vector<StartupProfiler::Phase> phases = profiler.GetPhases();
+  ASSERT_EQ(phases.size(), 2u);
+  EXPECT_EQ(phases[0].name, "Early");
+  EXPECT_EQ(phases[1].name, "Late");
+  EXPECT_EQ(profiler.GetSummary(),
+            "Early: +1.00ms, took 7.00ms\nLate: +5.00ms, took 1.00ms\n");
+}
+
+TEST(StartupProfilerTest, MarksTheFirstFrameOnce) {
+  StartupProfiler profiler;
+  EXPECT_TRUE(profiler.MarkFirstFrame());
+  EXPECT_FALSE(profiler.MarkFirstFrame());
+
+  std::vector<StartupProfiler::Phase> phases = profiler.GetPhases();
+  ASSERT_EQ(phases.size(), 1u);
+  EXPECT_EQ(phases[0].name, StartupProfiler::kTimeToFirstFramePhase);
+  EXPECT_EQ(phases[0].start, profiler.GetStartTime());
+}
+
+TEST(StartupProfilerTest, NullProfilerRecordsNothing) {
+  StartupProfiler::ScopedPhase phase(nullptr, "Ignored");
+}
+
+}  // namespace testing
+}  // namespace flutter
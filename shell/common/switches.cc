@@ -354,6 +354,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.trace_systrace =
       command_line.HasOption(FlagForSwitch(Switch::TraceSystrace));
 
+  settings.trace_to_ring_buffer =
+      command_line.HasOption(FlagForSwitch(Switch::TraceToRingBuffer));
+
   settings.skia_deterministic_rendering_on_cpu =
       command_line.HasOption(FlagForSwitch(Switch::SkiaDeterministicRendering));
 
@@ -446,9 +449,119 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_impeller =
       command_line.HasOption(FlagForSwitch(Switch::EnableImpeller));
 
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::ImpellerVulkanPresentMode))) {
+    std::string present_mode;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::ImpellerVulkanPresentMode), &present_mode);
+    if (present_mode == "fifo" || present_mode == "fifo_relaxed" ||
+        present_mode == "mailbox") {
+      settings.impeller_vulkan_present_mode = present_mode;
+    } else {
+      FML_DLOG(ERROR) << "Invalid value for --impeller-vulkan-present-mode: '"
+                      << present_mode << "'.";
+    }
+  }
+
+  std::string swapchain_image_count;
+  if (command_line.GetOptionValue(
+          FlagForSwitch(Switch::ImpellerVulkanSwapchainImageCount),
+          &swapchain_image_count)) {
+    settings.impeller_vulkan_swapchain_image_count =
+        std::stoi(swapchain_image_count);
+  }
+
+  settings.impeller_vulkan_pace_presents =
+      command_line.HasOption(FlagForSwitch(Switch::ImpellerVulkanPacePresents));
+
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
 
+  settings.enable_async_raster_cache_generation = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAsyncRasterCacheGeneration));
+
+  settings.enable_raster_cache_atlasing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheAtlasing));
+
+  settings.enable_raster_cache_disk_store =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheDiskStore));
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::RasterCacheDiskStoreMaxBytes))) {
+    std::string max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::RasterCacheDiskStoreMaxBytes), &max_bytes);
+    settings.raster_cache_disk_store_max_bytes = std::stoull(max_bytes);
+  }
+
+  settings.enable_concurrent_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableConcurrentPreroll));
+
+  settings.enable_retained_layer_preroll =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRetainedLayerPreroll));
+
+  settings.visualize_frame_damage =
+      command_line.HasOption(FlagForSwitch(Switch::VisualizeFrameDamage));
+
+  settings.enable_adaptive_raster_quality = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptiveRasterQuality));
+
+  settings.impeller_enable_entity_batching = command_line.HasOption(
+      FlagForSwitch(Switch::ImpellerEnableEntityBatching));
+
+  settings.enable_adaptive_frame_pacing =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAdaptiveFramePacing));
+
+  settings.rasterize_latest_frame_only =
+      command_line.HasOption(FlagForSwitch(Switch::RasterizeLatestFrameOnly));
+
+  settings.enable_pointer_resampling =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerResampling));
+
+  settings.skip_unchanged_frames =
+      command_line.HasOption(FlagForSwitch(Switch::SkipUnchangedFrames));
+
+  settings.enable_performance_hints =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePerformanceHints));
+
+  settings.enable_pipelined_snapshots =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePipelinedSnapshots));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxBytes))) {
+    std::string max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DecodedImageCacheMaxBytes), &max_bytes);
+    settings.decoded_image_cache_max_bytes = std::stoull(max_bytes);
+  }
+
+  settings.enable_hardware_image_decoding = command_line.HasOption(
+      FlagForSwitch(Switch::EnableHardwareImageDecoding));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageDecodeAheadFrames))) {
+    std::string frames;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageDecodeAheadFrames), &frames);
+    settings.animated_image_decode_ahead_frames = std::stoull(frames);
+  }
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::AnimatedImageFrameCacheMaxBytes))) {
+    std::string max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::AnimatedImageFrameCacheMaxBytes), &max_bytes);
+    settings.animated_image_frame_cache_max_bytes = std::stoull(max_bytes);
+  }
+
+  settings.enable_surface_control_overlays = command_line.HasOption(
+      FlagForSwitch(Switch::EnableSurfaceControlOverlays));
+
+  settings.enable_asset_prefetch =
+      command_line.HasOption(FlagForSwitch(Switch::EnableAssetPrefetch));
+
+  settings.pin_threads_to_cpu_cores =
+      command_line.HasOption(FlagForSwitch(Switch::PinThreadsToCpuCores));
+
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
@@ -472,6 +585,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.dump_skp_on_shader_compilation =
       command_line.HasOption(FlagForSwitch(Switch::DumpSkpOnShaderCompilation));
 
+  command_line.GetOptionValue(FlagForSwitch(Switch::CaptureFramesTo),
+                              &settings.frame_capture_path);
+
   settings.cache_sksl =
       command_line.HasOption(FlagForSwitch(Switch::CacheSkSL));
 
@@ -181,6 +181,12 @@ DEF_SWITCH(DumpSkpOnShaderCompilation,
            "Automatically dump the skp that triggers new shader compilations. "
            "This is useful for writing custom ShaderWarmUp to reduce jank. "
            "By default, this is not enabled to reduce the overhead. ")
+DEF_SWITCH(CaptureFramesTo,
+           "capture-frames-to",
+           "Writes each rasterized frame to the given directory as an SKP, so "
+           "that the sequence of frames can be replayed by the "
+           "frame_replay_benchmarks. This slows down rasterization and is "
+           "meant for collecting benchmark inputs only.")
 DEF_SWITCH(CacheSkSL,
            "cache-sksl",
            "Only cache the shader in SkSL instead of binary or GLSL. This "
@@ -197,6 +203,11 @@ DEF_SWITCH(
     "Trace to the system tracer (instead of the timeline) on platforms where "
     "such a tracer is available. Currently only supported on Android and "
     "Fuchsia.")
+DEF_SWITCH(TraceToRingBuffer,
+           "trace-to-ring-buffer",
+           "Keep the most recent trace events of each thread in ring buffers, "
+           "even when the timeline is not recording. The ring buffers can be "
+           "dumped with the _flutter.dumpTraceRingBuffer service extension.")
 DEF_SWITCH(UseTestFonts,
            "use-test-fonts",
            "Running tests that layout and measure text will not yield "
@@ -261,6 +272,20 @@ DEF_SWITCH(EnableImpeller,
            "enable-impeller",
            "Enable the Impeller renderer on supported platforms. Ignored if "
            "Impeller is not supported on the platform.")
+DEF_SWITCH(ImpellerVulkanPresentMode,
+           "impeller-vulkan-present-mode",
+           "The present mode of the swapchain of the Impeller Vulkan backend. "
+           "One of 'fifo' (the default), 'fifo_relaxed', or 'mailbox'. "
+           "'mailbox' has the lowest latency, 'fifo' the smoothest output.")
+DEF_SWITCH(ImpellerVulkanSwapchainImageCount,
+           "impeller-vulkan-swapchain-image-count",
+           "The number of swapchain images of the Impeller Vulkan backend. "
+           "Clamped to the range supported by the surface.")
+DEF_SWITCH(ImpellerVulkanPacePresents,
+           "impeller-vulkan-pace-presents",
+           "Pace the presents of the Impeller Vulkan backend to the refresh "
+           "cycle of the display, on devices that support "
+           "VK_GOOGLE_display_timing.")
 DEF_SWITCH(LeakVM,
            "leak-vm",
            "When the last shell shuts down, the shared VM is leaked by default "
@@ -276,6 +301,111 @@ DEF_SWITCH(
 DEF_SWITCH(EnableEmbedderAPI,
            "enable-embedder-api",
            "Enable the embedder api. Defaults to false. iOS only.")
+DEF_SWITCH(EnableAsyncRasterCacheGeneration,
+           "enable-async-raster-cache-generation",
+           "Render the raster cache images of display lists on the IO thread "
+           "instead of in the frame that decides to cache them. Display lists "
+           "that draw images are still cached in the frame.")
+DEF_SWITCH(EnableRasterCacheAtlasing,
+           "enable-raster-cache-atlasing",
+           "Pack the small images of the raster cache into shared texture "
+           "pages. Only used by the Skia backend.")
+DEF_SWITCH(EnableRasterCacheDiskStore,
+           "enable-raster-cache-disk-store",
+           "Keep the raster cache images of display lists in the caches "
+           "directory so that they can be reused on the next launch instead "
+           "of rendered again.")
+DEF_SWITCH(RasterCacheDiskStoreMaxBytes,
+           "raster-cache-disk-store-max-bytes",
+           "The most bytes of disk used by the images kept by "
+           "--enable-raster-cache-disk-store.")
+DEF_SWITCH(EnableConcurrentPreroll,
+           "enable-concurrent-preroll",
+           "Preroll large independent layer subtrees on the concurrent "
+           "worker threads of the VM instead of only on the raster thread.")
+DEF_SWITCH(EnableRetainedLayerPreroll,
+           "enable-retained-layer-preroll",
+           "Skip the preroll of layer subtrees that the framework retained "
+           "from the previous frame when nothing that affects their preroll "
+           "has changed.")
+DEF_SWITCH(VisualizeFrameDamage,
+           "visualize-frame-damage",
+           "Outline the areas of each frame that are repainted because of "
+           "partial repaint, colored by the reason they were damaged, along "
+           "with the percentage of the frame that is damaged.")
+DEF_SWITCH(EnableAdaptiveRasterQuality,
+           "enable-adaptive-raster-quality",
+           "Render expensive effects at a reduced quality while the previous "
+           "frames took longer than the frame budget to rasterize, until "
+           "there is enough headroom to restore the full quality.")
+DEF_SWITCH(ImpellerEnableEntityBatching,
+           "impeller-enable-entity-batching",
+           "Reorder the entities of Impeller passes that do not overlap to "
+           "group the ones drawn with the same pipeline and texture, and "
+           "merge adjacent solid color fills into a single draw.")
+DEF_SWITCH(EnableAdaptiveFramePacing,
+           "enable-adaptive-frame-pacing",
+           "Keep only one frame in flight, and begin building each frame as "
+           "late after vsync as the recent build and raster times allow, "
+           "while frames are cheap enough to be built and rasterized within "
+           "one vsync interval.")
+DEF_SWITCH(RasterizeLatestFrameOnly,
+           "rasterize-latest-frame-only",
+           "When the raster thread falls behind, replace the frames that are "
+           "still waiting to be rasterized with the latest frame instead of "
+           "rasterizing every frame in order.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Dispatch pointer events once per frame, coalescing the hover and "
+           "move events of each pointer and predicting its position.")
+DEF_SWITCH(SkipUnchangedFrames,
+           "skip-unchanged-frames",
+           "Do not rasterize or present layer trees that are diffed to "
+           "render the same pixels as the last layer tree, such as the "
+           "frames of an animation that is hidden.")
+DEF_SWITCH(EnablePerformanceHints,
+           "enable-performance-hints",
+           "Report the build and raster durations of each frame to the "
+           "performance hint API of the platform, where there is one.")
+DEF_SWITCH(EnablePipelinedSnapshots,
+           "enable-pipelined-snapshots",
+           "Complete Picture.toImage and Scene.toImage with an image that "
+           "stays on the GPU once its commands are recorded, instead of "
+           "waiting for the GPU and copying the pixels back.")
+DEF_SWITCH(DecodedImageCacheMaxBytes,
+           "decoded-image-cache-max-bytes",
+           "The most bytes of recently decoded images kept alive to be "
+           "handed out again for codecs instantiated from the same bytes at "
+           "the same target size. 0, the default, disables the cache.")
+DEF_SWITCH(EnableHardwareImageDecoding,
+           "enable-hardware-image-decoding",
+           "Decode full sized images with the decoders of the platform into "
+           "memory that the GPU samples from directly, where the platform "
+           "supports it.")
+DEF_SWITCH(AnimatedImageDecodeAheadFrames,
+           "animated-image-decode-ahead-frames",
+           "Decode this many frames of animated images on the worker threads "
+           "ahead of the frames the framework asks for. 0, the default, "
+           "decodes each frame when it is asked for.")
+DEF_SWITCH(AnimatedImageFrameCacheMaxBytes,
+           "animated-image-frame-cache-max-bytes",
+           "The most bytes of frames each animated image keeps decoded ahead "
+           "with --animated-image-decode-ahead-frames. Defaults to 8 MiB.")
+DEF_SWITCH(EnableSurfaceControlOverlays,
+           "enable-surface-control-overlays",
+           "Render the Flutter UI above platform views into surface controls "
+           "that the compositor can place on hardware planes of their own, "
+           "where the platform supports it.")
+DEF_SWITCH(EnableAssetPrefetch,
+           "enable-asset-prefetch",
+           "Prefetch the assets the application loaded shortly after its "
+           "previous launch on a worker thread when the engine runs, and "
+           "record the assets loaded for the next launch.")
+DEF_SWITCH(PinThreadsToCpuCores,
+           "pin-threads-to-cpu-cores",
+           "On devices with cores of different speeds, pin the UI and raster "
+           "threads to the fastest cores, and keep the IO and worker threads "
+           "off of them.")
 DEF_SWITCHES_END
 
 void PrintUsage(const std::string& executable_name);
@@ -93,5 +93,248 @@ TEST(SwitchesTest, EnableEmbedderAPI) {
   }
 }
 
+TEST(SwitchesTest, CaptureFramesTo) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--capture-frames-to=/tmp/frames"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.frame_capture_path, "/tmp/frames");
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.frame_capture_path.empty());
+}
+
+TEST(SwitchesTest, EnableAsyncRasterCacheGeneration) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-async-raster-cache-generation"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_async_raster_cache_generation);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_async_raster_cache_generation);
+}
+
+TEST(SwitchesTest, EnableRasterCacheAtlasing) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-raster-cache-atlasing"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_raster_cache_atlasing);
+  EXPECT_FALSE(SettingsFromCommandLine(fml::CommandLine())
+                   .enable_raster_cache_atlasing);
+}
+
+TEST(SwitchesTest, EnableRasterCacheDiskStore) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-raster-cache-disk-store",
+       "--raster-cache-disk-store-max-bytes=1024"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_raster_cache_disk_store);
+  EXPECT_EQ(settings.raster_cache_disk_store_max_bytes, 1024u);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_raster_cache_disk_store);
+  EXPECT_EQ(settings.raster_cache_disk_store_max_bytes, 64u * 1024 * 1024);
+}
+
+TEST(SwitchesTest, EnableConcurrentPreroll) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-concurrent-preroll"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_concurrent_preroll);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_concurrent_preroll);
+}
+
+TEST(SwitchesTest, EnableRetainedLayerPreroll) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-retained-layer-preroll"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_retained_layer_preroll);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_retained_layer_preroll);
+}
+
+TEST(SwitchesTest, VisualizeFrameDamage) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--visualize-frame-damage"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.visualize_frame_damage);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.visualize_frame_damage);
+}
+
+TEST(SwitchesTest, EnableAdaptiveRasterQuality) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-adaptive-raster-quality"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_adaptive_raster_quality);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_adaptive_raster_quality);
+}
+
+TEST(SwitchesTest, ImpellerEnableEntityBatching) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--impeller-enable-entity-batching"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.impeller_enable_entity_batching);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.impeller_enable_entity_batching);
+}
+
+TEST(SwitchesTest, EnableAdaptiveFramePacing) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-adaptive-frame-pacing"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_adaptive_frame_pacing);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_adaptive_frame_pacing);
+}
+
+TEST(SwitchesTest, RasterizeLatestFrameOnly) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--rasterize-latest-frame-only"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.rasterize_latest_frame_only);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.rasterize_latest_frame_only);
+}
+
+TEST(SwitchesTest, EnablePointerResampling) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-pointer-resampling"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_pointer_resampling);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_pointer_resampling);
+}
+
+TEST(SwitchesTest, SkipUnchangedFrames) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--skip-unchanged-frames"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.skip_unchanged_frames);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.skip_unchanged_frames);
+}
+
+TEST(SwitchesTest, EnablePerformanceHints) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-performance-hints"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_performance_hints);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_performance_hints);
+}
+
+TEST(SwitchesTest, EnablePipelinedSnapshots) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-pipelined-snapshots"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_pipelined_snapshots);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_pipelined_snapshots);
+}
+
+TEST(SwitchesTest, DecodedImageCacheMaxBytes) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--decoded-image-cache-max-bytes=1024"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.decoded_image_cache_max_bytes, 1024u);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.decoded_image_cache_max_bytes, 0u);
+}
+
+TEST(SwitchesTest, EnableHardwareImageDecoding) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-hardware-image-decoding"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_hardware_image_decoding);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_hardware_image_decoding);
+}
+
+TEST(SwitchesTest, AnimatedImageDecodeAheadFrames) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--animated-image-decode-ahead-frames=3"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.animated_image_decode_ahead_frames, 3u);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.animated_image_decode_ahead_frames, 0u);
+}
+
+TEST(SwitchesTest, AnimatedImageFrameCacheMaxBytes) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--animated-image-frame-cache-max-bytes=1024"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.animated_image_frame_cache_max_bytes, 1024u);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_EQ(settings.animated_image_frame_cache_max_bytes, 8u * 1024 * 1024);
+}
+
+TEST(SwitchesTest, EnableSurfaceControlOverlays) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-surface-control-overlays"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_surface_control_overlays);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_surface_control_overlays);
+}
+
+TEST(SwitchesTest, EnableAssetPrefetch) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--enable-asset-prefetch"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.enable_asset_prefetch);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.enable_asset_prefetch);
+}
+
+TEST(SwitchesTest, PinThreadsToCpuCores) {
+  fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+      {"command", "--pin-threads-to-cpu-cores"});
+  Settings settings = SettingsFromCommandLine(command_line);
+  EXPECT_TRUE(settings.pin_threads_to_cpu_cores);
+
+  command_line = fml::CommandLineFromInitializerList({"command"});
+  settings = SettingsFromCommandLine(command_line);
+  EXPECT_FALSE(settings.pin_threads_to_cpu_cores);
+}
+
 }  // namespace testing
 }  // namespace flutter
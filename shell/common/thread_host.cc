@@ -29,6 +29,28 @@ std::string ThreadHost::ThreadHostConfig::MakeThreadName(
   }
 }
 
+fml::CpuAffinity ThreadHost::ThreadHostConfig::GetCpuAffinity(
+    fml::Thread::ThreadPriority priority) {
+  switch (priority) {
+    case fml::Thread::ThreadPriority::BACKGROUND:
+      return fml::CpuAffinity::kEfficiency;
+    case fml::Thread::ThreadPriority::NORMAL:
+      return fml::CpuAffinity::kNotPerformance;
+    case fml::Thread::ThreadPriority::DISPLAY:
+    case fml::Thread::ThreadPriority::RASTER:
+      return fml::CpuAffinity::kPerformance;
+  }
+  return fml::CpuAffinity::kNotPerformance;
+}
+
+ThreadConfigSetter ThreadHost::ThreadHostConfig::WithCpuAffinity(
+    const ThreadConfigSetter& setter) {
+  return [setter](const ThreadConfig& config) {
+    setter(config);
+    fml::RequestAffinity(GetCpuAffinity(config.priority));
+  };
+}
+
 void ThreadHost::ThreadHostConfig::SetIOConfig(const ThreadConfig& config) {
   type_mask |= ThreadHost::Type::IO;
   io_config = config;
@@ -9,6 +9,7 @@
 #include <optional>
 #include <string>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/thread.h"
 
@@ -51,6 +52,16 @@ struct ThreadHost {
     /// Use the prefix and thread type to generator a thread name.
     static std::string MakeThreadName(Type type, const std::string& prefix);
 
+    /// The cores that threads of the priority are pinned to by
+    /// |WithCpuAffinity|. Threads that produce frames run on the fastest
+    /// cores, and the rest are kept off of them.
+    static fml::CpuAffinity GetCpuAffinity(fml::Thread::ThreadPriority);
+
+    /// Wraps the setter so that it also pins each thread to the cores for its
+    /// priority. This has no effect on devices whose cores all run at the
+    /// same speed.
+    static ThreadConfigSetter WithCpuAffinity(const ThreadConfigSetter& setter);
+
     /// Specified the UI Thread Config, meanwhile set the mask.
     void SetUIConfig(const ThreadConfig&);
 
@@ -25,21 +25,32 @@ static fml::TimePoint SnapToNextTick(fml::TimePoint value,
 
 }  // namespace
 
-VsyncWaiterFallback::VsyncWaiterFallback(const TaskRunners& task_runners,
-                                         bool for_testing)
+VsyncWaiterFallback::VsyncWaiterFallback(
+    const TaskRunners& task_runners,
+    bool for_testing,
+    RefreshRateCallback refresh_rate_callback)
     : VsyncWaiter(task_runners),
       phase_(fml::TimePoint::Now()),
-      for_testing_(for_testing) {}
+      for_testing_(for_testing),
+      refresh_rate_callback_(std::move(refresh_rate_callback)) {}
 
 VsyncWaiterFallback::~VsyncWaiterFallback() = default;
 
+fml::TimeDelta VsyncWaiterFallback::GetFrameInterval() const {
+  double refresh_rate =
+      refresh_rate_callback_ ? refresh_rate_callback_() : 0.0;
+  if (refresh_rate <= 0.0) {
+    refresh_rate = 60.0;
+  }
+  return fml::TimeDelta::FromSecondsF(1.0 / refresh_rate);
+}
+
 // |VsyncWaiter|
 void VsyncWaiterFallback::AwaitVSync() {
-  constexpr fml::TimeDelta kSingleFrameInterval =
-      fml::TimeDelta::FromSecondsF(1.0 / 60.0);
+  const fml::TimeDelta frame_interval = GetFrameInterval();
   auto frame_start_time =
-      SnapToNextTick(fml::TimePoint::Now(), phase_, kSingleFrameInterval);
-  auto frame_target_time = frame_start_time + kSingleFrameInterval;
+      SnapToNextTick(fml::TimePoint::Now(), phase_, frame_interval);
+  auto frame_target_time = frame_start_time + frame_interval;
 
   TRACE_EVENT2_INT("flutter", "PlatformVsync", "frame_start_time",
                    frame_start_time.ToEpochDelta().ToMicroseconds(),
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_SHELL_COMMON_VSYNC_WAITER_FALLBACK_H_
 #define FLUTTER_SHELL_COMMON_VSYNC_WAITER_FALLBACK_H_
 
+#include <functional>
+
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/time/time_point.h"
@@ -12,17 +14,27 @@
 
 namespace flutter {
 
-/// A |VsyncWaiter| that will fire at 60 fps irrespective of the vsync.
+/// A |VsyncWaiter| that will fire at the refresh rate of the display the view
+/// is presented on irrespective of the vsync, or at 60 fps if the refresh
+/// rate isn't known.
 class VsyncWaiterFallback final : public VsyncWaiter {
  public:
+  /// Returns the refresh rate of the display of the view, or
+  /// `kUnknownDisplayRefreshRate`.
+  using RefreshRateCallback = std::function<double()>;
+
   explicit VsyncWaiterFallback(const TaskRunners& task_runners,
-                               bool for_testing = false);
+                               bool for_testing = false,
+                               RefreshRateCallback refresh_rate_callback = {});
 
   ~VsyncWaiterFallback() override;
 
  private:
   fml::TimePoint phase_;
   const bool for_testing_;
+  const RefreshRateCallback refresh_rate_callback_;
+
+  fml::TimeDelta GetFrameInterval() const;
 
   // |VsyncWaiter|
   void AwaitVSync() override;
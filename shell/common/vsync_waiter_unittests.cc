@@ -4,11 +4,13 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/shell/common/display.h"
 #include "flutter/shell/common/switches.h"
 
 #include "gtest/gtest.h"
 #include "thread_host.h"
 #include "vsync_waiter.h"
+#include "vsync_waiter_fallback.h"
 
 namespace flutter {
 namespace testing {
@@ -43,5 +45,40 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+TEST(VsyncWaiterTest, FallbackTicksAtDisplayRefreshRate) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+
+  double refresh_rate = 120.0;
+  auto vsync_waiter = std::make_shared<VsyncWaiterFallback>(
+      task_runners, /*for_testing=*/true,
+      [&refresh_rate]() { return refresh_rate; });
+
+  std::vector<fml::TimeDelta> frame_intervals;
+  std::function<void()> await_vsync = [&]() {
+    vsync_waiter->AsyncWaitForVsync(
+        [&](std::unique_ptr<FrameTimingsRecorder> recorder) {
+          frame_intervals.push_back(recorder->GetVsyncTargetTime() -
+                                    recorder->GetVsyncStartTime());
+          if (frame_intervals.size() == 2u) {
+            fml::MessageLoop::GetCurrent().Terminate();
+            return;
+          }
+          // The view moved to a display of an unknown refresh rate.
+          refresh_rate = kUnknownDisplayRefreshRate;
+          await_vsync();
+        });
+  };
+  await_vsync();
+  fml::MessageLoop::GetCurrent().Run();
+
+  ASSERT_EQ(frame_intervals.size(), 2u);
+  EXPECT_EQ(frame_intervals[0], fml::TimeDelta::FromSecondsF(1.0 / 120.0));
+  EXPECT_EQ(frame_intervals[1], fml::TimeDelta::FromSecondsF(1.0 / 60.0));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_GL_DELEGATE_H_
 
 #include <optional>
+#include <vector>
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/flow/embedded_views.h"
@@ -48,6 +49,11 @@ struct GLPresentInfo {
   // The buffer damage refers to the region that needs to be set as damaged
   // within the frame buffer.
   const std::optional<SkIRect>& buffer_damage;
+
+  // Disjoint rects within frame_damage and buffer_damage that cover all of
+  // the damage. Empty if the damage is only known as a single rect.
+  std::vector<SkIRect> frame_damage_rects = {};
+  std::vector<SkIRect> buffer_damage_rects = {};
 };
 
 class GPUSurfaceGLDelegate {
@@ -65,6 +71,14 @@ class GPUSurfaceGLDelegate {
   // the specified region
   virtual void GLContextSetDamageRegion(const std::optional<SkIRect>& region) {}
 
+  // Inform the GL Context that there's going to be no writing outside of the
+  // specified disjoint rects, all of which are within |region|. Delegates
+  // that can only restrict writing to a single rect use |region|.
+  virtual void GLContextSetDamageRects(const std::optional<SkIRect>& region,
+                                       const std::vector<SkIRect>& rects) {
+    GLContextSetDamageRegion(region);
+  }
+
   // Called to present the main GL surface. This is only called for the main GL
   // context and not any of the contexts dedicated for IO.
   virtual bool GLContextPresent(const GLPresentInfo& present_info) = 0;
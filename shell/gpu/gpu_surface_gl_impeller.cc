@@ -11,6 +11,17 @@
 
 namespace flutter {
 
+// The region of the frame to repaint, if not all of it.
+static std::optional<impeller::IRect> ToRepaintRegion(
+    const std::optional<SkIRect>& buffer_damage) {
+  if (!buffer_damage.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(buffer_damage->left(), buffer_damage->top(),
+                                   buffer_damage->right(),
+                                   buffer_damage->bottom());
+}
+
 GPUSurfaceGLImpeller::GPUSurfaceGLImpeller(
     GPUSurfaceGLDelegate* delegate,
     std::shared_ptr<impeller::Context> context)
@@ -57,16 +68,20 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
     return nullptr;
   }
 
+  // The damage of the frame is only known once it is submitted.
+  auto submit_info = std::make_shared<SurfaceFrame::SubmitInfo>();
   auto swap_callback = [weak = weak_factory_.GetWeakPtr(),
-                        delegate = delegate_]() -> bool {
+                        delegate = delegate_, submit_info]() -> bool {
     if (weak) {
       GLPresentInfo present_info = {
           .fbo_id = 0,
-          .frame_damage = std::nullopt,
+          .frame_damage = submit_info->frame_damage,
           // TODO (https://github.com/flutter/flutter/issues/105597): wire-up
           // presentation time to impeller backend.
           .presentation_time = std::nullopt,
-          .buffer_damage = std::nullopt,
+          .buffer_damage = submit_info->buffer_damage,
+          .frame_damage_rects = submit_info->frame_damage_rects,
+          .buffer_damage_rects = submit_info->buffer_damage_rects,
       };
       delegate->GLContextPresent(present_info);
     }
@@ -88,10 +103,36 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
       impeller::ISize{size.width(), size.height()}  // fbo_size
   );
 
+  // The default framebuffer retains its contents as far as the delegate
+  // reports existing damage, e.g. from the age of the EGL back buffer.
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  const auto delegate_info = delegate_->GLContextFramebufferInfo();
+  if (delegate_info.supports_partial_repaint && surface &&
+      aiks_context_->CanRenderRegion(
+          surface->GetTargetRenderPassDescriptor())) {
+    framebuffer_info.supports_partial_repaint = true;
+    framebuffer_info.existing_damage = delegate_info.existing_damage;
+    if (!framebuffer_info.existing_damage.has_value()) {
+      GLFrameInfo frame_info = {static_cast<uint32_t>(size.width()),
+                                static_cast<uint32_t>(size.height())};
+      const GLFBOInfo fbo_info = delegate_->GLContextFBO(frame_info);
+      if (fbo_info.partial_repaint_enabled) {
+        framebuffer_info.existing_damage = fbo_info.existing_damage;
+      }
+    }
+    framebuffer_info.horizontal_clip_alignment =
+        delegate_info.horizontal_clip_alignment;
+    framebuffer_info.vertical_clip_alignment =
+        delegate_info.vertical_clip_alignment;
+    framebuffer_info.max_damage_rects = delegate_info.max_damage_rects;
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
       fml::MakeCopyable([renderer = impeller_renderer_,  //
                          aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+                         surface = std::move(surface),   //
+                         delegate = delegate_,           //
+                         submit_info                     //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -107,18 +148,28 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
+        *submit_info = surface_frame.submit_info();
+        // The damage region must be set before drawing to the back buffer.
+        delegate->GLContextSetDamageRects(submit_info->buffer_damage,
+                                          submit_info->buffer_damage_rects);
+        auto region = ToRepaintRegion(submit_info->buffer_damage);
+
         return renderer->Render(
             std::move(surface),
             fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
+                [aiks_context, picture = std::move(picture), region](
                     impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target);
+                  return region.has_value()
+                             ? aiks_context->RenderRegion(
+                                   picture, render_target, *region, true)
+                             : aiks_context->Render(picture, render_target,
+                                                    true);
                 }));
       });
 
   return std::make_unique<SurfaceFrame>(
       nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
+      framebuffer_info,                 // framebuffer info
       submit_callback,                  // submit callback
       size,                             // frame size
       std::move(context_switch),        // context result
@@ -156,7 +207,7 @@ bool GPUSurfaceGLImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceGLImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
@@ -28,6 +28,16 @@ static std::shared_ptr<impeller::Renderer> CreateImpellerRenderer(
   return renderer;
 }
 
+// The region of the frame to repaint, if not all of it.
+static std::optional<impeller::IRect> ToRepaintRegion(
+    const std::optional<SkIRect>& buffer_damage) {
+  if (!buffer_damage.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(buffer_damage->left(), buffer_damage->top(),
+                                   buffer_damage->right(), buffer_damage->bottom());
+}
+
 GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delegate,
                                                  const std::shared_ptr<impeller::Context>& context)
     : delegate_(delegate),
@@ -61,14 +71,43 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrame(const SkISiz
 
   auto surface = impeller::SurfaceMTL::WrapCurrentMetalLayerDrawable(
       impeller_renderer_->GetContext(), mtl_layer);
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not wrap the drawable of the CAMetalLayer.";
+    return nullptr;
+  }
   if (Settings::kSurfaceDataAccessible) {
     last_drawable_.reset([surface->drawable() retain]);
   }
 
+  id<MTLTexture> drawable_texture =
+      static_cast<id<CAMetalDrawable>>(surface->drawable()).texture;
+  uintptr_t texture = reinterpret_cast<uintptr_t>(drawable_texture);
+
+  // The contents of a drawable texture can only be retained across frames and
+  // partially repainted if it can be written to with blits.
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  if (!mtl_layer.framebufferOnly &&
+      aiks_context_->CanRenderRegion(surface->GetTargetRenderPassDescriptor())) {
+    if (damage_frame_size_ != frame_info) {
+      damage_.clear();
+      damage_frame_size_ = frame_info;
+    }
+    // Provide accumulated damage to rasterizer (area in current framebuffer that lags behind
+    // front buffer)
+    auto i = damage_.find(texture);
+    if (i != damage_.end()) {
+      framebuffer_info.existing_damage = i->second;
+    }
+    framebuffer_info.supports_partial_repaint = true;
+  }
+
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([this,                                                        //
+                         renderer = impeller_renderer_,                               //
+                         aiks_context = aiks_context_,                                //
+                         surface = std::move(surface),                                //
+                         texture,                                                     //
+                         partial_repaint = framebuffer_info.supports_partial_repaint  //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -84,16 +123,36 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrame(const SkISiz
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
-        return renderer->Render(
+        const auto& submit_info = surface_frame.submit_info();
+        auto region = ToRepaintRegion(submit_info.buffer_damage);
+        bool rendered = renderer->Render(
             std::move(surface),
-            fml::MakeCopyable([aiks_context, picture = std::move(picture)](
+            fml::MakeCopyable([aiks_context, picture = std::move(picture), region](
                                   impeller::RenderTarget& render_target) -> bool {
-              return aiks_context->Render(picture, render_target);
+              return region.has_value()
+                         ? aiks_context->RenderRegion(picture, render_target, *region, true)
+                         : aiks_context->Render(picture, render_target, true);
             }));
+
+        if (rendered && partial_repaint) {
+          for (auto& entry : damage_) {
+            if (entry.first != texture) {
+              // Accumulate damage for other framebuffers
+              if (submit_info.frame_damage) {
+                entry.second.join(*submit_info.frame_damage);
+              } else {
+                entry.second = SkIRect::MakeSize(damage_frame_size_);
+              }
+            }
+          }
+          // Reset accumulated damage for current framebuffer
+          damage_[texture] = SkIRect::MakeEmpty();
+        }
+        return rendered;
       });
 
   return std::make_unique<SurfaceFrame>(nullptr,                          // surface
-                                        SurfaceFrame::FramebufferInfo{},  // framebuffer info
+                                        framebuffer_info,                 // framebuffer info
                                         submit_callback,                  // submit callback
                                         frame_info,                       // frame size
                                         nullptr,                          // context result
@@ -125,7 +184,7 @@ bool GPUSurfaceMetalImpeller::AllowsDrawingWhenGpuDisabled() const {
 
 // |Surface|
 bool GPUSurfaceMetalImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
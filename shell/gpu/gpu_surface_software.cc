@@ -4,14 +4,111 @@
 
 #include "flutter/shell/gpu/gpu_surface_software.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <vector>
 
+#include "flutter/display_list/display_list_tiler.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
 namespace flutter {
 
+namespace {
+
+// Tiles span the damaged columns of the frame, so that each tile is one
+// contiguous range of rows of the backing store.
+constexpr int kTileRowCount = 64;
+
+void RenderTile(const DisplayListTiler::Tile& tile, const SkPixmap& pixmap) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RenderTile");
+  SkPixmap tile_pixmap;
+  if (!tile.display_list || !pixmap.extractSubset(&tile_pixmap, tile.bounds)) {
+    return;
+  }
+  // The canvas only covers the tile, so tiles never touch the pixels of one
+  // another.
+  auto canvas = SkCanvas::MakeRasterDirect(
+      tile_pixmap.info(), tile_pixmap.writable_addr(), tile_pixmap.rowBytes());
+  if (!canvas) {
+    return;
+  }
+  canvas->translate(-tile.bounds.left(), -tile.bounds.top());
+  tile.display_list->RenderTo(canvas.get());
+}
+
+struct Tiles {
+  Tiles(std::vector<DisplayListTiler::Tile> tiles, const SkPixmap& pixmap)
+      : tiles(std::move(tiles)), pixmap(pixmap), rendered(this->tiles.size()) {}
+
+  // Only accessed while a tile is claimed, which the thread that renders the
+  // frame waits for.
+  const std::vector<DisplayListTiler::Tile> tiles;
+  const SkPixmap& pixmap;
+  std::atomic_size_t next_tile{0u};
+  fml::CountDownLatch rendered;
+};
+
+// Renders the tiles that no other thread has claimed yet.
+void RenderUnclaimedTiles(Tiles& tiles) {
+  for (size_t tile = tiles.next_tile++; tile < tiles.tiles.size();
+       tile = tiles.next_tile++) {
+    RenderTile(tiles.tiles[tile], tiles.pixmap);
+    tiles.rendered.CountDown();
+  }
+}
+
+// Renders the display list into the damaged part of the backing store in
+// tiles. The ops of each tile are first recorded into a display list of their
+// own on the task runner, culled with the RTree of the display list. The tiles
+// are then rendered on the calling thread and the task runner at once. Tiles
+// that no worker has started yet are rendered by the calling thread, so this
+// never waits for a busy runner to render.
+bool RenderTiles(const sk_sp<DisplayList>& display_list,
+                 SkSurface& backing_store,
+                 const SkIRect& damage,
+                 const std::shared_ptr<fml::ConcurrentTaskRunner>& runner) {
+  TRACE_EVENT0("flutter", "GPUSurfaceSoftware::RenderTiles");
+  // The pixels are written to directly, so any snapshot of them must be
+  // copied first.
+  backing_store.notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+  SkPixmap pixmap;
+  if (!backing_store.peekPixels(&pixmap)) {
+    return false;
+  }
+  SkIRect bounds = damage;
+  if (!bounds.intersect(pixmap.bounds())) {
+    return true;
+  }
+
+  // A backdrop filter must see the content of the tiles around it.
+  if (display_list->ReadsBackdrop()) {
+    RenderTile({bounds, display_list}, pixmap);
+    return true;
+  }
+
+  const SkISize tile_size = SkISize::Make(bounds.width(), kTileRowCount);
+  auto tiles = std::make_shared<Tiles>(
+      DisplayListTiler::RecordTiles(display_list, bounds, tile_size, runner),
+      pixmap);
+  for (size_t i = 1; i < tiles->tiles.size(); i++) {
+    runner->PostTask([tiles]() { RenderUnclaimedTiles(*tiles); });
+  }
+  RenderUnclaimedTiles(*tiles);
+  // All tiles have been claimed, so this only waits for tiles that workers
+  // are rendering.
+  tiles->rendered.Wait();
+  return true;
+}
+
+}  // namespace
+
 GPUSurfaceSoftware::GPUSurfaceSoftware(GPUSurfaceSoftwareDelegate* delegate,
                                        bool render_to_surface)
     : delegate_(delegate),
@@ -58,6 +155,44 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
     return nullptr;
   }
 
+  // Only the damage of a frame is rendered into the backing store that holds
+  // the last frame presented from it. The chain is broken by frames that
+  // aren't presented, as they may have been rendered in part.
+  const bool holds_last_frame = backing_store == last_presented_backing_store_;
+  last_presented_backing_store_ = nullptr;
+  if (delegate_->SupportsPartialPresent()) {
+    framebuffer_info.supports_partial_repaint = true;
+    if (holds_last_frame) {
+      framebuffer_info.existing_damage = SkIRect::MakeEmpty();
+    }
+  }
+
+  if (auto tile_task_runner = delegate_->GetTileTaskRunner()) {
+    // The frame is recorded, and rendered in tiles once it is submitted.
+    SurfaceFrame::SubmitCallback on_submit =
+        [self = weak_factory_.GetWeakPtr(), backing_store, tile_task_runner](
+            SurfaceFrame& surface_frame, DlCanvas* canvas) -> bool {
+      if (!self || !self->IsValid() || canvas == nullptr) {
+        return false;
+      }
+      auto display_list = surface_frame.BuildDisplayList();
+      if (!display_list) {
+        return false;
+      }
+      const SkIRect damage = surface_frame.submit_info().buffer_damage.value_or(
+          SkIRect::MakeWH(backing_store->width(), backing_store->height()));
+      if (!RenderTiles(display_list, *backing_store, damage,
+                       tile_task_runner)) {
+        return false;
+      }
+      return self->PresentBackingStore(surface_frame, backing_store);
+    };
+    return std::make_unique<SurfaceFrame>(nullptr, framebuffer_info, on_submit,
+                                          logical_size, nullptr,
+                                          /*display_list_fallback=*/true,
+                                          /*display_list_rtree=*/true);
+  }
+
   // If the surface has been scaled, we need to apply the inverse scaling to the
   // underlying canvas so that coordinates are mapped to the same spot
   // irrespective of surface scaling.
@@ -74,13 +209,25 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceSoftware::AcquireFrame(
 
     canvas->Flush();
 
-    return self->delegate_->PresentBackingStore(surface_frame.SkiaSurface());
+    return self->PresentBackingStore(surface_frame,
+                                     surface_frame.SkiaSurface());
   };
 
   return std::make_unique<SurfaceFrame>(backing_store, framebuffer_info,
                                         on_submit, logical_size);
 }
 
+bool GPUSurfaceSoftware::PresentBackingStore(
+    const SurfaceFrame& surface_frame,
+    const sk_sp<SkSurface>& backing_store) {
+  const bool presented = delegate_->PresentBackingStoreFrame(
+      backing_store, surface_frame.submit_info());
+  if (presented) {
+    last_presented_backing_store_ = backing_store;
+  }
+  return presented;
+}
+
 // |Surface|
 SkMatrix GPUSurfaceSoftware::GetRootTransformation() const {
   // This backend does not currently support root surface transformations. Just
@@ -38,7 +38,14 @@ class GPUSurfaceSoftware : public Surface {
   // hack to make avoid allocating resources for the root surface when an
   // external view embedder is present.
   const bool render_to_surface_;
+  // The backing store that holds the last frame presented, which the delegate
+  // keeps the contents of if it supports partial presents.
+  sk_sp<SkSurface> last_presented_backing_store_;
   fml::TaskRunnerAffineWeakPtrFactory<GPUSurfaceSoftware> weak_factory_;
+
+  bool PresentBackingStore(const SurfaceFrame& surface_frame,
+                           const sk_sp<SkSurface>& backing_store);
+
   FML_DISALLOW_COPY_AND_ASSIGN(GPUSurfaceSoftware);
 };
 
@@ -8,4 +8,30 @@ namespace flutter {
 
 GPUSurfaceSoftwareDelegate::~GPUSurfaceSoftwareDelegate() = default;
 
+bool GPUSurfaceSoftwareDelegate::SupportsPartialPresent() const {
+  return false;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreDamage(
+    sk_sp<SkSurface> backing_store,
+    const SkIRect& damage) {
+  return PresentBackingStore(std::move(backing_store));
+}
+
+std::shared_ptr<fml::ConcurrentTaskRunner>
+GPUSurfaceSoftwareDelegate::GetTileTaskRunner() {
+  return nullptr;
+}
+
+bool GPUSurfaceSoftwareDelegate::PresentBackingStoreFrame(
+    sk_sp<SkSurface> backing_store,
+    const SurfaceFrame::SubmitInfo& submit_info) {
+  if (!SupportsPartialPresent()) {
+    return PresentBackingStore(std::move(backing_store));
+  }
+  const SkIRect damage = submit_info.frame_damage.value_or(
+      SkIRect::MakeWH(backing_store->width(), backing_store->height()));
+  return PresentBackingStoreDamage(std::move(backing_store), damage);
+}
+
 }  // namespace flutter
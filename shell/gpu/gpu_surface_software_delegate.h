@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_GPU_GPU_SURFACE_SOFTWARE_DELEGATE_H_
 
 #include "flutter/flow/embedded_views.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -48,6 +49,51 @@ class GPUSurfaceSoftwareDelegate {
   ///             the screen.
   ///
   virtual bool PresentBackingStore(sk_sp<SkSurface> backing_store) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the platform keeps the contents of the backing store
+  ///             it presented, so that only the parts of the next frame that
+  ///             changed need to be rendered into it again and presented
+  ///             with `PresentBackingStoreDamage`. Defaults to false.
+  ///
+  virtual bool SupportsPartialPresent() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called instead of `PresentBackingStore` if the platform
+  ///             supports partial presents, with the part of the backing
+  ///             store that changed since the last present. Presents the
+  ///             whole backing store by default.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  damage         The part of the backing store that changed.
+  ///
+  /// @return     Returns if the platform could present the backing store onto
+  ///             the screen.
+  ///
+  virtual bool PresentBackingStoreDamage(sk_sp<SkSurface> backing_store,
+                                         const SkIRect& damage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The task runner the frame is rendered on in tiles, instead
+  ///             of on the raster thread alone. Defaults to none.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner> GetTileTaskRunner();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Called by the surface to present a frame that has been
+  ///             rendered into the backing store. By default, this presents
+  ///             the damage of the frame with `PresentBackingStoreDamage` if
+  ///             the platform supports partial presents, and the whole
+  ///             backing store with `PresentBackingStore` otherwise.
+  ///
+  /// @param[in]  backing_store  The software backing store to present.
+  /// @param[in]  submit_info    The damage and timing of the frame.
+  ///
+  /// @return     Returns if the frame could be presented.
+  ///
+  virtual bool PresentBackingStoreFrame(
+      sk_sp<SkSurface> backing_store,
+      const SurfaceFrame::SubmitInfo& submit_info);
 };
 
 }  // namespace flutter
@@ -11,6 +11,17 @@
 
 namespace flutter {
 
+// The region of the frame to repaint, if not all of it.
+static std::optional<impeller::IRect> ToRepaintRegion(
+    const std::optional<SkIRect>& buffer_damage) {
+  if (!buffer_damage.has_value()) {
+    return std::nullopt;
+  }
+  return impeller::IRect::MakeLTRB(buffer_damage->left(), buffer_damage->top(),
+                                   buffer_damage->right(),
+                                   buffer_damage->bottom());
+}
+
 GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
     std::shared_ptr<impeller::Context> context)
     : weak_factory_(this) {
@@ -57,11 +68,28 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
 
   auto& context_vk = impeller::ContextVK::Cast(*impeller_context_);
   std::unique_ptr<impeller::Surface> surface = context_vk.AcquireNextSurface();
+  if (!surface) {
+    FML_LOG(ERROR) << "Could not acquire the next Vulkan surface.";
+    return nullptr;
+  }
+
+  // Swapchain images that retain their contents only need to be repainted
+  // where they lag behind the last frame.
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  framebuffer_info.supports_partial_repaint =
+      surface->GetBufferAge() != 0u &&
+      aiks_context_->CanRenderRegion(surface->GetTargetRenderPassDescriptor());
+  if (framebuffer_info.supports_partial_repaint) {
+    framebuffer_info.existing_damage =
+        damage_history_.GetExistingDamage(surface->GetBufferAge(), size);
+  }
 
   SurfaceFrame::SubmitCallback submit_callback =
-      fml::MakeCopyable([renderer = impeller_renderer_,  //
-                         aiks_context = aiks_context_,   //
-                         surface = std::move(surface)    //
+      fml::MakeCopyable([weak = weak_factory_.GetWeakPtr(),  //
+                         renderer = impeller_renderer_,      //
+                         aiks_context = aiks_context_,       //
+                         surface = std::move(surface),       //
+                         size                                //
   ](SurfaceFrame& surface_frame, DlCanvas* canvas) mutable -> bool {
         if (!aiks_context) {
           return false;
@@ -77,22 +105,35 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
         display_list->Dispatch(impeller_dispatcher);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
-        return renderer->Render(
-            std::move(surface),
-            fml::MakeCopyable(
-                [aiks_context, picture = std::move(picture)](
-                    impeller::RenderTarget& render_target) -> bool {
-                  return aiks_context->Render(picture, render_target);
-                }));
+        const auto& submit_info = surface_frame.submit_info();
+        auto region = ToRepaintRegion(submit_info.buffer_damage);
+        if (!renderer->Render(
+                std::move(surface),
+                fml::MakeCopyable(
+                    [aiks_context, picture = std::move(picture), region](
+                        impeller::RenderTarget& render_target) -> bool {
+                      return region.has_value()
+                                 ? aiks_context->RenderRegion(
+                                       picture, render_target, *region, true)
+                                 : aiks_context->Render(picture,
+                                                        render_target, true);
+                    }))) {
+          return false;
+        }
+        if (weak) {
+          weak->damage_history_.AddFrameDamage(submit_info.frame_damage,
+                                               size);
+        }
+        return true;
       });
 
   return std::make_unique<SurfaceFrame>(
-      nullptr,                          // surface
-      SurfaceFrame::FramebufferInfo{},  // framebuffer info
-      submit_callback,                  // submit callback
-      size,                             // frame size
-      nullptr,                          // context result
-      true                              // display list fallback
+      nullptr,           // surface
+      framebuffer_info,  // framebuffer info
+      submit_callback,   // submit callback
+      size,              // frame size
+      nullptr,           // context result
+      true               // display list fallback
   );
 }
 
@@ -118,7 +159,7 @@ GPUSurfaceVulkanImpeller::MakeRenderContextCurrent() {
 
 // |Surface|
 bool GPUSurfaceVulkanImpeller::EnableRasterCache() const {
-  return false;
+  return true;
 }
 
 // |Surface|
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "flutter/common/graphics/gl_context_switch.h"
+#include "flutter/flow/frame_damage_history.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
@@ -28,6 +29,7 @@ class GPUSurfaceVulkanImpeller final : public Surface {
   std::shared_ptr<impeller::Context> impeller_context_;
   std::shared_ptr<impeller::Renderer> impeller_renderer_;
   std::shared_ptr<impeller::AiksContext> aiks_context_;
+  FrameDamageHistory damage_history_;
   bool is_valid_ = false;
   fml::WeakPtrFactory<GPUSurfaceVulkanImpeller> weak_factory_;
 
@@ -4,15 +4,285 @@
 
 #include "flutter/shell/platform/android/android_context_gl_impeller.h"
 
+#include <map>
+#include <thread>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/paths.h"
+#include "flutter/impeller/renderer/backend/gles/context_gles.h"
+#include "flutter/impeller/renderer/backend/gles/proc_table_gles.h"
+#include "flutter/shell/version/version.h"
+#include "impeller/entity/gles/entity_shaders_gles.h"
+#include "impeller/entity/gles/framebuffer_blend_shaders_gles.h"
+#include "impeller/scene/shaders/gles/scene_shaders_gles.h"
+
 namespace flutter {
 
+class AndroidContextGLImpeller::ReactorWorker final
+    : public impeller::ReactorGLES::Worker {
+ public:
+  ReactorWorker() = default;
+
+  // |impeller::ReactorGLES::Worker|
+  ~ReactorWorker() override = default;
+
+  // |impeller::ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const impeller::ReactorGLES& reactor) const override {
+    impeller::ReaderLock lock(mutex_);
+    auto found = reactions_allowed_.find(std::this_thread::get_id());
+    if (found == reactions_allowed_.end()) {
+      return false;
+    }
+    return found->second;
+  }
+
+  // |impeller::ReactorGLES::Worker|
+  bool CanReactorPerformResourceOperationsOnCurrentThreadNow(
+      const impeller::ReactorGLES& reactor) const override {
+    impeller::ReaderLock lock(mutex_);
+    auto found = resource_reactions_allowed_.find(std::this_thread::get_id());
+    if (found == resource_reactions_allowed_.end()) {
+      return false;
+    }
+    return found->second;
+  }
+
+  void SetReactionsAllowedOnCurrentThread(bool allowed) {
+    impeller::WriterLock lock(mutex_);
+    reactions_allowed_[std::this_thread::get_id()] = allowed;
+  }
+
+  void SetResourceReactionsAllowedOnCurrentThread(bool allowed) {
+    impeller::WriterLock lock(mutex_);
+    resource_reactions_allowed_[std::this_thread::get_id()] = allowed;
+  }
+
+ private:
+  mutable impeller::RWMutex mutex_;
+  std::map<std::thread::id, bool> reactions_allowed_ IPLR_GUARDED_BY(mutex_);
+  std::map<std::thread::id, bool> resource_reactions_allowed_
+      IPLR_GUARDED_BY(mutex_);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ReactorWorker);
+};
+
+static std::shared_ptr<impeller::Context> CreateImpellerContext(
+    const std::shared_ptr<impeller::ReactorGLES::Worker>& worker) {
+  auto proc_table = std::make_unique<impeller::ProcTableGLES>(
+      impeller::egl::CreateProcAddressResolver());
+
+  if (!proc_table->IsValid()) {
+    FML_LOG(ERROR) << "Could not create OpenGL proc table.";
+    return nullptr;
+  }
+
+  std::vector<std::shared_ptr<fml::Mapping>> shader_mappings = {
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_entity_shaders_gles_data,
+          impeller_entity_shaders_gles_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_framebuffer_blend_shaders_gles_data,
+          impeller_framebuffer_blend_shaders_gles_length),
+      std::make_shared<fml::NonOwnedMapping>(
+          impeller_scene_shaders_gles_data, impeller_scene_shaders_gles_length),
+  };
+
+  // Program binaries are versioned by the engine version, like the Skia
+  // shader cache, since the programs depend on the shaders in the engine.
+  auto cache_directory = fml::CreateDirectory(
+      fml::paths::GetCachesDirectory(),
+      {"flutter_engine", GetFlutterEngineVersion(), "impeller"},
+      fml::FilePermission::kReadWrite);
+
+  auto context = impeller::ContextGLES::Create(
+      std::move(proc_table), shader_mappings, std::move(cache_directory));
+  if (!context) {
+    FML_LOG(ERROR) << "Could not create OpenGLES Impeller Context.";
+    return nullptr;
+  }
+
+  if (!context->AddReactorWorker(worker).has_value()) {
+    FML_LOG(ERROR) << "Could not add reactor worker.";
+    return nullptr;
+  }
+  FML_LOG(ERROR) << "Using the Impeller rendering backend.";
+  return context;
+}
+
 AndroidContextGLImpeller::AndroidContextGLImpeller()
-    : AndroidContext(AndroidRenderingAPI::kOpenGLES) {}
+    : AndroidContext(AndroidRenderingAPI::kOpenGLES),
+      reactor_worker_(std::shared_ptr<ReactorWorker>(new ReactorWorker())) {
+  auto display = std::make_unique<impeller::egl::Display>();
+  if (!display->IsValid()) {
+    FML_DLOG(ERROR) << "Could not create EGL display.";
+    return;
+  }
+
+  impeller::egl::ConfigDescriptor desc;
+  desc.api = impeller::egl::API::kOpenGLES2;
+  desc.color_format = impeller::egl::ColorFormat::kRGBA8888;
+  desc.depth_bits = impeller::egl::DepthBits::kZero;
+  desc.stencil_bits = impeller::egl::StencilBits::kEight;
+  desc.samples = impeller::egl::Samples::kFour;
+
+  desc.surface_type = impeller::egl::SurfaceType::kWindow;
+  auto onscreen_config = display->ChooseConfig(desc);
+  if (!onscreen_config) {
+    FML_DLOG(ERROR) << "Could not choose onscreen config.";
+    return;
+  }
+
+  desc.surface_type = impeller::egl::SurfaceType::kPBuffer;
+  auto offscreen_config = display->ChooseConfig(desc);
+  if (!offscreen_config) {
+    FML_DLOG(ERROR) << "Could not choose offscreen config.";
+    return;
+  }
+
+  auto onscreen_context = display->CreateContext(*onscreen_config, nullptr);
+  if (!onscreen_context) {
+    FML_DLOG(ERROR) << "Could not create onscreen context.";
+    return;
+  }
+
+  auto offscreen_context =
+      display->CreateContext(*offscreen_config, onscreen_context.get());
+  if (!offscreen_context) {
+    FML_DLOG(ERROR) << "Could not create offscreen context.";
+    return;
+  }
+
+  // The Impeller context is created with the offscreen context current, on
+  // a surface that is only needed for that.
+  auto offscreen_surface =
+      display->CreatePixelBufferSurface(*offscreen_config, 1u, 1u);
+  if (!offscreen_surface) {
+    FML_DLOG(ERROR) << "Could not create offscreen surface.";
+    return;
+  }
+
+  if (!offscreen_context->MakeCurrent(*offscreen_surface)) {
+    FML_DLOG(ERROR) << "Could not make offscreen context current.";
+    return;
+  }
+
+  auto impeller_context = CreateImpellerContext(reactor_worker_);
 
-AndroidContextGLImpeller::~AndroidContextGLImpeller() = default;
+  if (!offscreen_context->ClearCurrent()) {
+    FML_DLOG(ERROR) << "Could not clear offscreen context.";
+    return;
+  }
+
+  if (!impeller_context) {
+    FML_DLOG(ERROR) << "Could not create Impeller context.";
+    return;
+  }
+
+  // Setup context listeners. The offscreen context is current on the IO
+  // thread, which only uploads resources so it doesn't contend with the
+  // rendering on the raster thread.
+  impeller::egl::Context::LifecycleListener listener =
+      [worker =
+           reactor_worker_](impeller::egl ::Context::LifecycleEvent event) {
+        switch (event) {
+          case impeller::egl::Context::LifecycleEvent::kDidMakeCurrent:
+            worker->SetReactionsAllowedOnCurrentThread(true);
+            break;
+          case impeller::egl::Context::LifecycleEvent::kWillClearCurrent:
+            worker->SetReactionsAllowedOnCurrentThread(false);
+            break;
+        }
+      };
+  impeller::egl::Context::LifecycleListener resource_listener =
+      [worker =
+           reactor_worker_](impeller::egl ::Context::LifecycleEvent event) {
+        switch (event) {
+          case impeller::egl::Context::LifecycleEvent::kDidMakeCurrent:
+            worker->SetResourceReactionsAllowedOnCurrentThread(true);
+            break;
+          case impeller::egl::Context::LifecycleEvent::kWillClearCurrent:
+            worker->SetResourceReactionsAllowedOnCurrentThread(false);
+            break;
+        }
+      };
+  if (!onscreen_context->AddLifecycleListener(listener).has_value() ||
+      !offscreen_context->AddLifecycleListener(resource_listener)
+           .has_value()) {
+    FML_DLOG(ERROR) << "Could not add lifecycle listeners";
+  }
+
+  display_ = std::move(display);
+  onscreen_config_ = std::move(onscreen_config);
+  offscreen_config_ = std::move(offscreen_config);
+  onscreen_context_ = std::move(onscreen_context);
+  offscreen_context_ = std::move(offscreen_context);
+  SetImpellerContext(impeller_context);
+
+  is_valid_ = true;
+}
+
+AndroidContextGLImpeller::~AndroidContextGLImpeller() {
+  // The Impeller context must not outlive the EGL contexts it was created
+  // with, as far as this AndroidContext is concerned.
+  SetImpellerContext(nullptr);
+}
 
 bool AndroidContextGLImpeller::IsValid() const {
-  return true;
+  return is_valid_;
+}
+
+bool AndroidContextGLImpeller::ResourceContextMakeCurrent(
+    const impeller::egl::Surface& surface) {
+  if (!offscreen_context_) {
+    return false;
+  }
+
+  return offscreen_context_->MakeCurrent(surface);
+}
+
+bool AndroidContextGLImpeller::ResourceContextClearCurrent() {
+  if (!offscreen_context_) {
+    return false;
+  }
+
+  return offscreen_context_->ClearCurrent();
+}
+
+bool AndroidContextGLImpeller::OnscreenContextMakeCurrent(
+    const impeller::egl::Surface& surface) {
+  if (!onscreen_context_) {
+    return false;
+  }
+
+  return onscreen_context_->MakeCurrent(surface);
+}
+
+bool AndroidContextGLImpeller::OnscreenContextClearCurrent() {
+  if (!onscreen_context_) {
+    return false;
+  }
+
+  return onscreen_context_->ClearCurrent();
+}
+
+std::unique_ptr<impeller::egl::Surface>
+AndroidContextGLImpeller::CreateOffscreenSurface() {
+  if (!display_ || !offscreen_config_) {
+    return nullptr;
+  }
+
+  return display_->CreatePixelBufferSurface(*offscreen_config_, 1u, 1u);
+}
+
+std::unique_ptr<impeller::egl::Surface>
+AndroidContextGLImpeller::CreateOnscreenSurface(EGLNativeWindowType window) {
+  if (!display_ || !onscreen_config_) {
+    return nullptr;
+  }
+
+  return display_->CreateWindowSurface(*onscreen_config_, window);
 }
 
 }  // namespace flutter
@@ -6,10 +6,23 @@
 #define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_CONTEXT_GL_IMPELLER_H_
 
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/toolkit/egl/context.h"
+#include "flutter/impeller/toolkit/egl/display.h"
+#include "flutter/impeller/toolkit/egl/surface.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 
 namespace flutter {
 
+//------------------------------------------------------------------------------
+/// @brief      Holds the EGL contexts and the Impeller context that are shared
+///             by the AndroidSurfaceGLImpellers of the engines that share this
+///             AndroidContext.
+///
+///             Spawned engines share their task runners, so the onscreen
+///             context is only ever made current on the raster thread and the
+///             offscreen context on the IO thread, each with the EGL surface
+///             of whichever engine is rendering or uploading.
+///
 class AndroidContextGLImpeller : public AndroidContext {
  public:
   AndroidContextGLImpeller();
@@ -19,7 +32,38 @@ class AndroidContextGLImpeller : public AndroidContext {
   // |AndroidContext|
   bool IsValid() const override;
 
+  bool ResourceContextMakeCurrent(const impeller::egl::Surface& surface);
+
+  bool ResourceContextClearCurrent();
+
+  bool OnscreenContextMakeCurrent(const impeller::egl::Surface& surface);
+
+  bool OnscreenContextClearCurrent();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the 1x1 pixel buffer surface that the offscreen
+  ///             context is made current with.
+  ///
+  std::unique_ptr<impeller::egl::Surface> CreateOffscreenSurface();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the surface of a window that the onscreen context
+  ///             renders to.
+  ///
+  std::unique_ptr<impeller::egl::Surface> CreateOnscreenSurface(
+      EGLNativeWindowType window);
+
  private:
+  class ReactorWorker;
+
+  std::shared_ptr<ReactorWorker> reactor_worker_;
+  std::unique_ptr<impeller::egl::Display> display_;
+  std::unique_ptr<impeller::egl::Config> onscreen_config_;
+  std::unique_ptr<impeller::egl::Config> offscreen_config_;
+  std::unique_ptr<impeller::egl::Context> onscreen_context_;
+  std::unique_ptr<impeller::egl::Context> offscreen_context_;
+  bool is_valid_ = false;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContextGLImpeller);
 };
 
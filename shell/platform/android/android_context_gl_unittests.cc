@@ -2,9 +2,11 @@
 
 #include <memory>
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/platform/android/android_context_gl_impeller.h"
 #include "flutter/shell/platform/android/android_context_gl_skia.h"
 #include "flutter/shell/platform/android/android_egl_surface.h"
 #include "flutter/shell/platform/android/android_environment_gl.h"
+#include "flutter/shell/platform/android/android_surface_gl_impeller.h"
 #include "flutter/shell/platform/android/android_surface_gl_skia.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "gmock/gmock.h"
@@ -54,6 +56,8 @@ class MockPlatformViewAndroidJNI : public PlatformViewAndroidJNI {
   MOCK_METHOD0(FlutterViewCreateOverlaySurface,
                std::unique_ptr<PlatformViewAndroidJNI::OverlayMetadata>());
   MOCK_METHOD0(FlutterViewDestroyOverlaySurfaces, void());
+  MOCK_METHOD0(FlutterViewCreateOverlaySurfaceControl, JavaLocalRef());
+  MOCK_METHOD0(FlutterViewDestroyOverlaySurfaceControl, void());
   MOCK_METHOD1(FlutterViewComputePlatformResolvedLocale,
                std::unique_ptr<std::vector<std::string>>(
                    std::vector<std::string> supported_locales_data));
@@ -210,6 +214,28 @@ TEST(AndroidContextGl, EnsureMakeCurrentChecksCurrentContextStatus) {
   status = pbuffer_surface->MakeCurrent();
   EXPECT_EQ(AndroidEGLSurfaceMakeCurrentStatus::kSuccessAlreadyCurrent, status);
 }
+
+TEST(AndroidContextGLImpeller, SurfacesShareTheImpellerContext) {
+  auto android_context = std::make_shared<AndroidContextGLImpeller>();
+  ASSERT_TRUE(android_context->IsValid());
+  ASSERT_TRUE(android_context->GetImpellerContext());
+
+  auto jni = std::make_shared<MockPlatformViewAndroidJNI>();
+  auto first = std::make_unique<AndroidSurfaceGLImpeller>(android_context, jni);
+  auto second =
+      std::make_unique<AndroidSurfaceGLImpeller>(android_context, jni);
+  ASSERT_TRUE(first->IsValid());
+  ASSERT_TRUE(second->IsValid());
+  EXPECT_EQ(first->GetImpellerContext(), android_context->GetImpellerContext());
+  EXPECT_EQ(second->GetImpellerContext(),
+            android_context->GetImpellerContext());
+
+  // Each surface has its own offscreen surface for the shared resource
+  // context.
+  EXPECT_TRUE(first->ResourceContextMakeCurrent());
+  EXPECT_TRUE(second->ResourceContextMakeCurrent());
+  EXPECT_TRUE(second->ResourceContextClearCurrent());
+}
 }  // namespace android
 }  // namespace testing
 }  // namespace flutter
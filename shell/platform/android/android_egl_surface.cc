@@ -7,8 +7,8 @@
 #include <EGL/eglext.h>
 #include <sys/system_properties.h>
 
-#include <array>
 #include <list>
+#include <vector>
 
 #include "flutter/fml/trace_event.h"
 
@@ -112,10 +112,11 @@ class AndroidEGLSurfaceDamage {
 
   void SetDamageRegion(EGLDisplay display,
                        EGLSurface surface,
-                       const std::optional<SkIRect>& region) {
+                       const std::optional<SkIRect>& region,
+                       const std::vector<SkIRect>& region_rects) {
     if (set_damage_region_ && region) {
-      auto rects = RectToInts(display, surface, *region);
-      set_damage_region_(display, surface, rects.data(), 1);
+      auto rects = RectsToInts(display, surface, *region, region_rects);
+      set_damage_region_(display, surface, rects.data(), rects.size() / 4);
     }
   }
 
@@ -149,28 +150,44 @@ class AndroidEGLSurfaceDamage {
 
   bool SwapBuffersWithDamage(EGLDisplay display,
                              EGLSurface surface,
-                             const std::optional<SkIRect>& damage) {
+                             const std::optional<SkIRect>& damage,
+                             const std::vector<SkIRect>& damage_rects) {
     if (swap_buffers_with_damage_ && damage) {
+      // The existing damage of a buffer is only tracked as a single rect.
       damage_history_.push_back(*damage);
       if (damage_history_.size() > kMaxHistorySize) {
         damage_history_.pop_front();
       }
-      auto rects = RectToInts(display, surface, *damage);
-      return swap_buffers_with_damage_(display, surface, rects.data(), 1);
+      auto rects = RectsToInts(display, surface, *damage, damage_rects);
+      return swap_buffers_with_damage_(display, surface, rects.data(),
+                                       rects.size() / 4);
     } else {
       return eglSwapBuffers(display, surface);
     }
   }
 
  private:
-  std::array<EGLint, 4> static RectToInts(EGLDisplay display,
-                                          EGLSurface surface,
-                                          const SkIRect& rect) {
+  // Converts |rects|, or |bounds| if there are none, to the bottom-left
+  // origin x, y, width, height quadruples that EGL expects.
+  std::vector<EGLint> static RectsToInts(EGLDisplay display,
+                                         EGLSurface surface,
+                                         const SkIRect& bounds,
+                                         const std::vector<SkIRect>& rects) {
     EGLint height;
     eglQuerySurface(display, surface, EGL_HEIGHT, &height);
 
-    std::array<EGLint, 4> res{rect.left(), height - rect.bottom(), rect.width(),
-                              rect.height()};
+    std::vector<EGLint> res;
+    auto add_rect = [&res, height](const SkIRect& rect) {
+      res.insert(res.end(), {rect.left(), height - rect.bottom(), rect.width(),
+                             rect.height()});
+    };
+    if (rects.empty()) {
+      add_rect(bounds);
+    } else {
+      for (const SkIRect& rect : rects) {
+        add_rect(rect);
+      }
+    }
     return res;
   }
 
@@ -239,8 +256,10 @@ AndroidEGLSurfaceMakeCurrentStatus AndroidEGLSurface::MakeCurrent() const {
 }
 
 void AndroidEGLSurface::SetDamageRegion(
-    const std::optional<SkIRect>& buffer_damage) {
-  damage_->SetDamageRegion(display_, surface_, buffer_damage);
+    const std::optional<SkIRect>& buffer_damage,
+    const std::vector<SkIRect>& buffer_damage_rects) {
+  damage_->SetDamageRegion(display_, surface_, buffer_damage,
+                           buffer_damage_rects);
 }
 
 bool AndroidEGLSurface::SetPresentationTime(
@@ -254,9 +273,11 @@ bool AndroidEGLSurface::SetPresentationTime(
 }
 
 bool AndroidEGLSurface::SwapBuffers(
-    const std::optional<SkIRect>& surface_damage) {
+    const std::optional<SkIRect>& surface_damage,
+    const std::vector<SkIRect>& surface_damage_rects) {
   TRACE_EVENT0("flutter", "AndroidContextGL::SwapBuffers");
-  return damage_->SwapBuffersWithDamage(display_, surface_, surface_damage);
+  return damage_->SwapBuffersWithDamage(display_, surface_, surface_damage,
+                                        surface_damage_rects);
 }
 
 bool AndroidEGLSurface::SupportsPartialRepaint() const {
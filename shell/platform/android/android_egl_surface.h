@@ -9,6 +9,7 @@
 #include <EGL/eglext.h>
 #include <KHR/khrplatform.h>
 #include <optional>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
@@ -79,7 +80,12 @@ class AndroidEGLSurface {
   //----------------------------------------------------------------------------
   /// @brief      Sets the damage region for current surface. Corresponds to
   //              eglSetDamageRegionKHR
-  void SetDamageRegion(const std::optional<SkIRect>& buffer_damage);
+  ///
+  /// @param[in]  buffer_damage_rects  Disjoint rects within buffer_damage
+  ///                                  that are set instead of it if not
+  ///                                  empty.
+  void SetDamageRegion(const std::optional<SkIRect>& buffer_damage,
+                       const std::vector<SkIRect>& buffer_damage_rects = {});
 
   //----------------------------------------------------------------------------
   /// @brief      Sets the presentation time for the current surface. This
@@ -91,9 +97,14 @@ class AndroidEGLSurface {
   /// @brief      This only applies to on-screen surfaces such as those created
   ///             by `AndroidContextGL::CreateOnscreenSurface`.
   ///
+  /// @param[in]  surface_damage_rects  Disjoint rects within surface_damage
+  ///                                   that are passed instead of it if not
+  ///                                   empty.
+  ///
   /// @return     Whether the EGL surface color buffer was swapped.
   ///
-  bool SwapBuffers(const std::optional<SkIRect>& surface_damage);
+  bool SwapBuffers(const std::optional<SkIRect>& surface_damage,
+                   const std::vector<SkIRect>& surface_damage_rects = {});
 
   //----------------------------------------------------------------------------
   /// @return     The size of an `EGLSurface`.
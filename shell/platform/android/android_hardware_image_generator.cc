@@ -0,0 +1,289 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_hardware_image_generator.h"
+
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <android/bitmap.h>
+#include <android/hardware_buffer.h>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/platform/android/jni_util.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLTypes.h"
+
+// Only available on API 30+
+typedef int (*AndroidBitmap_getHardwareBuffer_FPN)(
+    JNIEnv* env,
+    jobject bitmap,
+    AHardwareBuffer** out_buffer);
+// Only available on API 26+
+typedef void (*AHardwareBuffer_release_FPN)(AHardwareBuffer* buffer);
+static AndroidBitmap_getHardwareBuffer_FPN AndroidBitmap_getHardwareBuffer;
+static AHardwareBuffer_release_FPN AHardwareBuffer_release;
+
+namespace flutter {
+
+static fml::jni::ScopedJavaGlobalRef<jclass>* g_flutter_jni_class = nullptr;
+static jmethodID g_decode_image_to_hardware_bitmap_method = nullptr;
+
+namespace {
+
+struct HardwareBufferReleaser {
+  void operator()(AHardwareBuffer* buffer) const {
+    AHardwareBuffer_release(buffer);
+  }
+};
+
+using UniqueHardwareBuffer =
+    std::unique_ptr<AHardwareBuffer, HardwareBufferReleaser>;
+
+// The GL objects that a texture image of a hardware buffer is made of, which
+// are released once Skia is done with the image.
+struct HardwareBufferTexture {
+  std::shared_ptr<UniqueHardwareBuffer> buffer;
+  EGLDisplay display = EGL_NO_DISPLAY;
+  EGLImageKHR egl_image = EGL_NO_IMAGE_KHR;
+  GLuint texture = 0;
+  PFNEGLDESTROYIMAGEKHRPROC destroy_image = nullptr;
+
+  ~HardwareBufferTexture() {
+    if (texture != 0) {
+      glDeleteTextures(1, &texture);
+    }
+    if (egl_image != EGL_NO_IMAGE_KHR) {
+      destroy_image(display, egl_image);
+    }
+  }
+};
+
+sk_sp<SkImage> MakeTextureImage(GrDirectContext* context,
+                                AHardwareBuffer* buffer,
+                                const SkImageInfo& info) {
+  if (!context || context->backend() != GrBackendApi::kOpenGL) {
+    return nullptr;
+  }
+
+  auto get_native_client_buffer =
+      reinterpret_cast<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
+          eglGetProcAddress("eglGetNativeClientBufferANDROID"));
+  auto create_image = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(
+      eglGetProcAddress("eglCreateImageKHR"));
+  auto destroy_image = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(
+      eglGetProcAddress("eglDestroyImageKHR"));
+  auto image_target_texture =
+      reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+          eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+  if (!get_native_client_buffer || !create_image || !destroy_image ||
+      !image_target_texture) {
+    return nullptr;
+  }
+
+  EGLDisplay display = eglGetCurrentDisplay();
+  EGLClientBuffer client_buffer = get_native_client_buffer(buffer);
+  if (display == EGL_NO_DISPLAY || !client_buffer) {
+    return nullptr;
+  }
+
+  EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  EGLImageKHR egl_image =
+      create_image(display, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID,
+                   client_buffer, attributes);
+  if (egl_image == EGL_NO_IMAGE_KHR) {
+    FML_DLOG(ERROR) << "Failed to create an EGL image of a hardware buffer.";
+    return nullptr;
+  }
+
+  auto texture = std::make_unique<HardwareBufferTexture>();
+  texture->display = display;
+  texture->egl_image = egl_image;
+  texture->destroy_image = destroy_image;
+
+  glGenTextures(1, &texture->texture);
+  glBindTexture(GL_TEXTURE_2D, texture->texture);
+  image_target_texture(GL_TEXTURE_2D, egl_image);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_2D, texture->texture,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(info.width(), info.height(),
+                                   GrMipMapped::kNo, texture_info);
+  SkImage::TextureReleaseProc release_proc = [](void* context) {
+    delete reinterpret_cast<HardwareBufferTexture*>(context);
+  };
+  return SkImage::MakeFromTexture(
+      context, backend_texture, kTopLeft_GrSurfaceOrigin,
+      kRGBA_8888_SkColorType, info.alphaType(), info.refColorSpace(),
+      release_proc, texture.release());
+}
+
+}  // namespace
+
+AndroidHardwareImageGenerator::~AndroidHardwareImageGenerator() = default;
+
+AndroidHardwareImageGenerator::AndroidHardwareImageGenerator(
+    sk_sp<SkData> data,
+    std::unique_ptr<ImageGenerator> software)
+    : data_(std::move(data)), software_(std::move(software)) {}
+
+const SkImageInfo& AndroidHardwareImageGenerator::GetInfo() {
+  return software_->GetInfo();
+}
+
+unsigned int AndroidHardwareImageGenerator::GetFrameCount() const {
+  return software_->GetFrameCount();
+}
+
+unsigned int AndroidHardwareImageGenerator::GetPlayCount() const {
+  return software_->GetPlayCount();
+}
+
+const ImageGenerator::FrameInfo AndroidHardwareImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return software_->GetFrameInfo(frame_index);
+}
+
+SkISize AndroidHardwareImageGenerator::GetScaledDimensions(
+    float desired_scale) {
+  return software_->GetScaledDimensions(desired_scale);
+}
+
+bool AndroidHardwareImageGenerator::GetPixels(
+    const SkImageInfo& info,
+    void* pixels,
+    size_t row_bytes,
+    unsigned int frame_index,
+    std::optional<unsigned int> prior_frame) {
+  return software_->GetPixels(info, pixels, row_bytes, frame_index,
+                              prior_frame);
+}
+
+std::unique_ptr<SkCodec> AndroidHardwareImageGenerator::MakeBandCodec() const {
+  return software_->MakeBandCodec();
+}
+
+ImageGenerator::TextureImageFactory
+AndroidHardwareImageGenerator::DecodeToTexture() {
+  FML_DCHECK(g_flutter_jni_class);
+  FML_DCHECK(g_decode_image_to_hardware_bitmap_method);
+
+  // Call FlutterJNI.decodeImageToHardwareBitmap
+
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  // This task is run on a worker thread.  Create a frame to ensure that all
+  // local JNI references used here are freed.
+  fml::jni::ScopedJavaLocalFrame scoped_local_reference_frame(env);
+
+  jobject direct_buffer =
+      env->NewDirectByteBuffer(const_cast<void*>(data_->data()), data_->size());
+
+  jobject bitmap =
+      env->CallStaticObjectMethod(g_flutter_jni_class->obj(),
+                                  g_decode_image_to_hardware_bitmap_method,
+                                  direct_buffer);
+  if (!fml::jni::CheckException(env) || bitmap == nullptr) {
+    return nullptr;
+  }
+
+  const SkImageInfo& image_info = GetInfo();
+  AndroidBitmapInfo info;
+  [[maybe_unused]] int status;
+  if ((status = AndroidBitmap_getInfo(env, bitmap, &info)) < 0) {
+    FML_DLOG(ERROR) << "Failed to get bitmap info, status=" << status;
+    return nullptr;
+  }
+  if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888 ||
+      static_cast<int>(info.width) != image_info.width() ||
+      static_cast<int>(info.height) != image_info.height()) {
+    return nullptr;
+  }
+
+  // The buffer is acquired for the caller and outlives the bitmap.
+  AHardwareBuffer* raw_buffer = nullptr;
+  if ((status = AndroidBitmap_getHardwareBuffer(env, bitmap, &raw_buffer)) <
+          0 ||
+      !raw_buffer) {
+    FML_DLOG(ERROR) << "Failed to get the hardware buffer, status=" << status;
+    return nullptr;
+  }
+  auto buffer = std::make_shared<UniqueHardwareBuffer>(raw_buffer);
+
+  return [buffer, image_info](GrDirectContext* context) -> sk_sp<SkImage> {
+    return MakeTextureImage(context, buffer->get(), image_info);
+  };
+}
+
+bool AndroidHardwareImageGenerator::Register(JNIEnv* env) {
+  g_flutter_jni_class = new fml::jni::ScopedJavaGlobalRef<jclass>(
+      env, env->FindClass("io/flutter/embedding/engine/FlutterJNI"));
+  FML_DCHECK(!g_flutter_jni_class->is_null());
+
+  g_decode_image_to_hardware_bitmap_method = env->GetStaticMethodID(
+      g_flutter_jni_class->obj(), "decodeImageToHardwareBitmap",
+      "(Ljava/nio/ByteBuffer;)Landroid/graphics/Bitmap;");
+  if (g_decode_image_to_hardware_bitmap_method == nullptr) {
+    FML_LOG(ERROR)
+        << "Could not locate FlutterJNI.decodeImageToHardwareBitmap method";
+    return false;
+  }
+
+  return true;
+}
+
+bool AndroidHardwareImageGenerator::IsAvailable() {
+  static std::optional<bool> is_available;
+  if (is_available) {
+    return is_available.value();
+  }
+  auto libjnigraphics = fml::NativeLibrary::Create("libjnigraphics.so");
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  if (!libjnigraphics || !libandroid) {
+    is_available = false;
+    return false;
+  }
+  auto get_hardware_buffer_fn =
+      libjnigraphics->ResolveFunction<AndroidBitmap_getHardwareBuffer_FPN>(
+          "AndroidBitmap_getHardwareBuffer");
+  auto release_fn = libandroid->ResolveFunction<AHardwareBuffer_release_FPN>(
+      "AHardwareBuffer_release");
+  if (get_hardware_buffer_fn && release_fn) {
+    AndroidBitmap_getHardwareBuffer = get_hardware_buffer_fn.value();
+    AHardwareBuffer_release = release_fn.value();
+    is_available = true;
+  } else {
+    is_available = false;
+  }
+  return is_available.value();
+}
+
+std::shared_ptr<ImageGenerator> AndroidHardwareImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  // Only JPEGs that aren't rotated by their EXIF data are decoded into
+  // hardware buffers, as the dimensions of the bitmap can't tell whether the
+  // platform decoder applied the orientation the same way as the Skia codec.
+  std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+  if (!codec || codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG ||
+      codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+    return nullptr;
+  }
+  auto software =
+      std::make_unique<BuiltinSkiaCodecImageGenerator>(std::move(codec));
+  return std::shared_ptr<AndroidHardwareImageGenerator>(
+      new AndroidHardwareImageGenerator(std::move(data), std::move(software)));
+}
+
+}  // namespace flutter
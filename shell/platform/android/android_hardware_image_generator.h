@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
+
+#include <jni.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "flutter/lib/ui/painting/image_generator.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes JPEG images with the `ImageDecoder` of the Android SDK
+///             into hardware bitmaps, whose `AHardwareBuffer`s are bound to
+///             textures of the GL resource context without uploading the
+///             pixels, see `Settings::enable_hardware_image_decoding`.
+///
+///             Everything else is delegated to the builtin Skia codec
+///             generator, which also decodes the images that have to be
+///             resized, and the images that can't be decoded into hardware
+///             buffers on the device.
+///
+class AndroidHardwareImageGenerator : public ImageGenerator {
+ public:
+  ~AndroidHardwareImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  // |ImageGenerator|
+  std::unique_ptr<SkCodec> MakeBandCodec() const override;
+
+  // |ImageGenerator|
+  TextureImageFactory DecodeToTexture() override;
+
+  static bool Register(JNIEnv* env);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the device has the APIs to decode images into
+  ///             hardware buffers and bind them to textures.
+  ///
+  static bool IsAvailable();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a generator for JPEG data. Returns nullptr for other
+  ///             formats, which are left to the other generators.
+  ///
+  static std::shared_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  AndroidHardwareImageGenerator(sk_sp<SkData> data,
+                                std::unique_ptr<ImageGenerator> software);
+
+  sk_sp<SkData> data_;
+  std::unique_ptr<ImageGenerator> software_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(AndroidHardwareImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_HARDWARE_IMAGE_GENERATOR_H_
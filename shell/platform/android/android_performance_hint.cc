@@ -0,0 +1,117 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_performance_hint.h"
+
+#include <optional>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+
+// Only available on API 33+
+typedef void APerformanceHintManager;
+typedef void APerformanceHintSession;
+typedef APerformanceHintManager* (*APerformanceHint_getManager_FPN)();
+typedef APerformanceHintSession* (*APerformanceHint_createSession_FPN)(
+    APerformanceHintManager* manager,
+    const int32_t* thread_ids,
+    size_t size,
+    int64_t initial_target_work_duration_nanos);
+typedef int (*APerformanceHint_reportActualWorkDuration_FPN)(
+    APerformanceHintSession* session,
+    int64_t actual_duration_nanos);
+typedef void (*APerformanceHint_closeSession_FPN)(
+    APerformanceHintSession* session);
+static APerformanceHint_getManager_FPN APerformanceHint_getManager;
+static APerformanceHint_createSession_FPN APerformanceHint_createSession;
+static APerformanceHint_reportActualWorkDuration_FPN
+    APerformanceHint_reportActualWorkDuration;
+static APerformanceHint_closeSession_FPN APerformanceHint_closeSession;
+
+namespace flutter {
+
+bool AndroidPerformanceHint::IsAvailable() {
+  static std::optional<bool> is_available;
+  if (is_available) {
+    return is_available.value();
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  auto get_manager_fn =
+      libandroid->ResolveFunction<APerformanceHint_getManager_FPN>(
+          "APerformanceHint_getManager");
+  auto create_session_fn =
+      libandroid->ResolveFunction<APerformanceHint_createSession_FPN>(
+          "APerformanceHint_createSession");
+  auto report_fn =
+      libandroid
+          ->ResolveFunction<APerformanceHint_reportActualWorkDuration_FPN>(
+              "APerformanceHint_reportActualWorkDuration");
+  auto close_session_fn =
+      libandroid->ResolveFunction<APerformanceHint_closeSession_FPN>(
+          "APerformanceHint_closeSession");
+  if (get_manager_fn && create_session_fn && report_fn && close_session_fn) {
+    APerformanceHint_getManager = get_manager_fn.value();
+    APerformanceHint_createSession = create_session_fn.value();
+    APerformanceHint_reportActualWorkDuration = report_fn.value();
+    APerformanceHint_closeSession = close_session_fn.value();
+    is_available = true;
+  } else {
+    is_available = false;
+  }
+  return is_available.value();
+}
+
+AndroidPerformanceHint::AndroidPerformanceHint() = default;
+
+AndroidPerformanceHint::~AndroidPerformanceHint() {
+  std::scoped_lock lock(sessions_mutex_);
+  if (ui_session_) {
+    APerformanceHint_closeSession(ui_session_);
+  }
+  if (raster_session_) {
+    APerformanceHint_closeSession(raster_session_);
+  }
+}
+
+void AndroidPerformanceHint::CreateSessions(pid_t ui_thread_id,
+                                            pid_t raster_thread_id,
+                                            fml::TimeDelta target_duration) {
+  if (!IsAvailable()) {
+    return;
+  }
+  APerformanceHintManager* manager = APerformanceHint_getManager();
+  if (!manager) {
+    // Devices without a hint HAL have no manager.
+    return;
+  }
+  std::scoped_lock lock(sessions_mutex_);
+  FML_DCHECK(!ui_session_ && !raster_session_);
+  int32_t ui_thread_ids[] = {static_cast<int32_t>(ui_thread_id)};
+  ui_session_ = APerformanceHint_createSession(
+      manager, ui_thread_ids, 1, target_duration.ToNanoseconds());
+  int32_t raster_thread_ids[] = {static_cast<int32_t>(raster_thread_id)};
+  raster_session_ = APerformanceHint_createSession(
+      manager, raster_thread_ids, 1, target_duration.ToNanoseconds());
+  if (!ui_session_ || !raster_session_) {
+    FML_LOG(ERROR) << "Failed to create performance hint sessions.";
+  }
+}
+
+void AndroidPerformanceHint::ReportFrame(const FrameTiming& timing) {
+  std::scoped_lock lock(sessions_mutex_);
+  auto report = [](APerformanceHintSession* session, fml::TimeDelta duration) {
+    // The sessions reject durations that aren't positive.
+    if (session && duration.ToNanoseconds() > 0) {
+      APerformanceHint_reportActualWorkDuration(session,
+                                                duration.ToNanoseconds());
+    }
+  };
+  report(ui_session_, timing.Get(FrameTiming::kBuildFinish) -
+                          timing.Get(FrameTiming::kBuildStart));
+  report(raster_session_, timing.Get(FrameTiming::kRasterFinish) -
+                              timing.Get(FrameTiming::kRasterStart));
+}
+
+}  // namespace flutter
@@ -0,0 +1,58 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
+
+#include <sys/types.h>
+
+#include <mutex>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Reports how long the UI and raster threads took to build and rasterize
+/// each frame to the performance hint sessions of the NDK, so that the CPU
+/// governor can raise the clocks before frames start missing their deadline
+/// rather than after. The sessions are only available on API 33+.
+///
+class AndroidPerformanceHint {
+ public:
+  static bool IsAvailable();
+
+  AndroidPerformanceHint();
+
+  ~AndroidPerformanceHint();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens a session for each of the threads, with the duration
+  ///             that the work of a frame should fit in.
+  ///
+  void CreateSessions(pid_t ui_thread_id,
+                      pid_t raster_thread_id,
+                      fml::TimeDelta target_duration);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Reports the build and raster durations of the frame to the
+  ///             sessions, if they have been created.
+  ///
+  void ReportFrame(const FrameTiming& timing);
+
+ private:
+  std::mutex sessions_mutex_;
+  // These are |APerformanceHintSession|s, which the NDK headers of this tree
+  // don't declare.
+  void* ui_session_ = nullptr;
+  void* raster_session_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidPerformanceHint);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_PERFORMANCE_HINT_H_
@@ -6,6 +6,7 @@
 
 #include "flutter/shell/platform/android/android_shell_holder.h"
 
+#include <dlfcn.h>
 #include <pthread.h>
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -16,16 +17,21 @@
 #include <string>
 #include <utility>
 
+#include "flutter/fml/cpu_affinity.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/native_library.h"
 #include "flutter/fml/platform/android/jni_util.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/runtime/dart_snapshot.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/android/android_display.h"
+#include "flutter/shell/platform/android/android_hardware_image_generator.h"
 #include "flutter/shell/platform/android/android_image_generator.h"
 #include "flutter/shell/platform/android/context/android_context.h"
 #include "flutter/shell/platform/android/platform_view_android.h"
@@ -88,7 +94,11 @@ AndroidShellHolder::AndroidShellHolder(
       ThreadHost::Type::UI | ThreadHost::Type::RASTER | ThreadHost::Type::IO;
 
   flutter::ThreadHost::ThreadHostConfig host_config(
-      thread_label, mask, AndroidPlatformThreadConfigSetter);
+      thread_label, mask,
+      settings_.pin_threads_to_cpu_cores
+          ? ThreadHost::ThreadHostConfig::WithCpuAffinity(
+                AndroidPlatformThreadConfigSetter)
+          : AndroidPlatformThreadConfigSetter);
   host_config.ui_config = fml::Thread::ThreadConfig(
       flutter::ThreadHost::ThreadHostConfig::MakeThreadName(
           flutter::ThreadHost::Type::UI, thread_label),
@@ -147,20 +157,38 @@ AndroidShellHolder::AndroidShellHolder(
                                     io_runner         // io
   );
 
+  Settings shell_settings = settings_;
+  if (settings_.enable_performance_hints &&
+      AndroidPerformanceHint::IsAvailable()) {
+    performance_hint_ = std::make_shared<AndroidPerformanceHint>();
+    shell_settings.frame_rasterized_callback =
+        [callback = settings_.frame_rasterized_callback,
+         performance_hint = performance_hint_](const FrameTiming& timing) {
+          if (callback) {
+            callback(timing);
+          }
+          performance_hint->ReportFrame(timing);
+        };
+  }
+
   shell_ =
       Shell::Create(GetDefaultPlatformData(),  // window data
                     task_runners,              // task runners
-                    settings_,                 // settings
+                    shell_settings,            // settings
                     on_create_platform_view,   // platform view create callback
                     on_create_rasterizer       // rasterizer create callback
       );
 
   if (shell_) {
-    shell_->GetDartVM()->GetConcurrentMessageLoop()->PostTaskToAllWorkers([]() {
-      if (::setpriority(PRIO_PROCESS, gettid(), 1) != 0) {
-        FML_LOG(ERROR) << "Failed to set Workers task runner priority";
-      }
-    });
+    shell_->GetDartVM()->GetConcurrentMessageLoop()->PostTaskToAllWorkers(
+        [pin_to_cpu_cores = settings_.pin_threads_to_cpu_cores]() {
+          if (::setpriority(PRIO_PROCESS, gettid(), 1) != 0) {
+            FML_LOG(ERROR) << "Failed to set Workers task runner priority";
+          }
+          if (pin_to_cpu_cores) {
+            fml::RequestAffinity(fml::CpuAffinity::kNotPerformance);
+          }
+        });
 
     shell_->RegisterImageDecoder(
         [runner = task_runners.GetIOTaskRunner()](sk_sp<SkData> buffer) {
@@ -168,6 +196,41 @@ AndroidShellHolder::AndroidShellHolder(
         },
         -1);
     FML_DLOG(INFO) << "Registered Android SDK image decoder (API level 28+)";
+
+    if (settings_.enable_hardware_image_decoding &&
+        !settings_.enable_impeller &&
+        AndroidHardwareImageGenerator::IsAvailable()) {
+      shell_->RegisterImageDecoder(
+          [](sk_sp<SkData> buffer) {
+            return AndroidHardwareImageGenerator::MakeFromData(
+                std::move(buffer));
+          },
+          1);
+      FML_DLOG(INFO) << "Registered Android hardware image decoder (API level "
+                        "30+)";
+    }
+  }
+
+  if (shell_ && performance_hint_) {
+    pid_t ui_thread_id = 0;
+    pid_t raster_thread_id = 0;
+    fml::CountDownLatch latch(2);
+    ui_runner->PostTask([&ui_thread_id, &latch]() {
+      ui_thread_id = gettid();
+      latch.CountDown();
+    });
+    raster_runner->PostTask([&raster_thread_id, &latch]() {
+      raster_thread_id = gettid();
+      latch.CountDown();
+    });
+    latch.Wait();
+    double refresh_rate = shell_->GetMainDisplayRefreshRate();
+    fml::Milliseconds frame_budget =
+        refresh_rate > 0 ? fml::RefreshRateToFrameBudget(refresh_rate)
+                         : fml::kDefaultFrameBudget;
+    performance_hint_->CreateSessions(
+        ui_thread_id, raster_thread_id,
+        fml::TimeDelta::FromMillisecondsF(frame_budget.count()));
   }
 
   platform_view_ = weak_platform_view;
@@ -311,6 +374,43 @@ void AndroidShellHolder::NotifyLowMemoryWarning() {
   shell_->NotifyLowMemoryWarning();
 }
 
+void AndroidShellHolder::PrefetchDartDeferredLibrary(
+    intptr_t loading_unit_id,
+    std::vector<std::string> search_paths) {
+  FML_DCHECK(shell_);
+  const auto& task_runners = shell_->GetTaskRunners();
+  // Opening the library relocates it, which is too slow for the platform
+  // thread.
+  task_runners.GetIOTaskRunner()->PostTask(fml::MakeCopyable(
+      [platform_view = platform_view_,
+       platform_task_runner = task_runners.GetPlatformTaskRunner(),
+       loading_unit_id, search_paths = std::move(search_paths)]() mutable {
+        TRACE_EVENT0("flutter", "AndroidShellHolder::PrefetchLoadingUnit");
+        void* handle = nullptr;
+        while (handle == nullptr && !search_paths.empty()) {
+          handle = ::dlopen(search_paths.back().c_str(), RTLD_NOW);
+          search_paths.pop_back();
+        }
+        if (handle == nullptr) {
+          return;
+        }
+        fml::RefPtr<fml::NativeLibrary> native_lib =
+            fml::NativeLibrary::CreateWithHandle(handle, false);
+        auto data = std::make_unique<const fml::SymbolMapping>(
+            native_lib, DartSnapshot::kIsolateDataSymbol);
+        auto instructions = std::make_unique<const fml::SymbolMapping>(
+            native_lib, DartSnapshot::kIsolateInstructionsSymbol);
+        platform_task_runner->PostTask(fml::MakeCopyable(
+            [platform_view, loading_unit_id, data = std::move(data),
+             instructions = std::move(instructions)]() mutable {
+              if (platform_view) {
+                platform_view->PrefetchDartDeferredLibrary(
+                    loading_unit_id, std::move(data), std::move(instructions));
+              }
+            }));
+      }));
+}
+
 std::optional<RunConfiguration> AndroidShellHolder::BuildRunConfiguration(
     const std::string& entrypoint,
     const std::string& libraryUrl,
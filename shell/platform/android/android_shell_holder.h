@@ -15,6 +15,7 @@
 #include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/shell.h"
 #include "flutter/shell/common/thread_host.h"
+#include "flutter/shell/platform/android/android_performance_hint.h"
 #include "flutter/shell/platform/android/apk_asset_provider.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "flutter/shell/platform/android/platform_message_handler_android.h"
@@ -98,6 +99,17 @@ class AndroidShellHolder {
 
   void NotifyLowMemoryWarning();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Opens the shared library of a loading unit from the first of
+  ///             the search paths that has one on the IO thread, and
+  ///             prefetches it with
+  ///             `PlatformView::PrefetchDartDeferredLibrary`. Failures are
+  ///             ignored, as the loading unit is then loaded as usual once
+  ///             it is requested.
+  ///
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id,
+                                   std::vector<std::string> search_paths);
+
   const std::shared_ptr<PlatformMessageHandler>& GetPlatformMessageHandler()
       const {
     return shell_->GetPlatformMessageHandler();
@@ -112,6 +124,7 @@ class AndroidShellHolder {
   bool is_valid_ = false;
   uint64_t next_pointer_flow_id_ = 0;
   std::unique_ptr<APKAssetProvider> apk_asset_provider_;
+  std::shared_ptr<AndroidPerformanceHint> performance_hint_;
 
   //----------------------------------------------------------------------------
   /// @brief      Constructor with its components injected.
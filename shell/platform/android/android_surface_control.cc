@@ -0,0 +1,285 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/android_surface_control.h"
+
+#include <android/hardware_buffer.h>
+#include <android/rect.h>
+
+#include <optional>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/native_library.h"
+
+// Only available on API 29+, except for |ASurfaceControl_fromJava| on API 34+
+// and |ASurfaceTransaction_setPosition| on API 31+.
+typedef void (*ASurfaceTransaction_OnComplete)(void* context,
+                                               ASurfaceTransactionStats* stats);
+typedef ASurfaceControl* (*ASurfaceControl_fromJava_FPN)(JNIEnv* env,
+                                                        jobject object);
+typedef ASurfaceControl* (*ASurfaceControl_create_FPN)(ASurfaceControl* parent,
+                                                      const char* debug_name);
+typedef void (*ASurfaceControl_release_FPN)(ASurfaceControl* control);
+typedef ASurfaceTransaction* (*ASurfaceTransaction_create_FPN)();
+typedef void (*ASurfaceTransaction_delete_FPN)(
+    ASurfaceTransaction* transaction);
+typedef void (*ASurfaceTransaction_apply_FPN)(ASurfaceTransaction* transaction);
+typedef void (*ASurfaceTransaction_setBuffer_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* control,
+    AHardwareBuffer* buffer,
+    int acquire_fence_fd);
+typedef void (*ASurfaceTransaction_setDamageRegion_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* control,
+    const ARect* rects,
+    uint32_t count);
+typedef void (*ASurfaceTransaction_setPosition_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* control,
+    int32_t x,
+    int32_t y);
+typedef void (*ASurfaceTransaction_setVisibility_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* control,
+    int8_t visibility);
+typedef void (*ASurfaceTransaction_setZOrder_FPN)(
+    ASurfaceTransaction* transaction,
+    ASurfaceControl* control,
+    int32_t z_order);
+typedef void (*ASurfaceTransaction_setOnComplete_FPN)(
+    ASurfaceTransaction* transaction,
+    void* context,
+    ASurfaceTransaction_OnComplete callback);
+typedef int (*ASurfaceTransactionStats_getPreviousReleaseFenceFd_FPN)(
+    ASurfaceTransactionStats* stats,
+    ASurfaceControl* control);
+// Only available on API 26+
+typedef int (*AHardwareBuffer_allocate_FPN)(const AHardwareBuffer_Desc* desc,
+                                            AHardwareBuffer** out_buffer);
+typedef void (*AHardwareBuffer_release_FPN)(AHardwareBuffer* buffer);
+
+static ASurfaceControl_fromJava_FPN ASurfaceControl_fromJava;
+static ASurfaceControl_create_FPN ASurfaceControl_create;
+static ASurfaceControl_release_FPN ASurfaceControl_release;
+static ASurfaceTransaction_create_FPN ASurfaceTransaction_create;
+static ASurfaceTransaction_delete_FPN ASurfaceTransaction_delete;
+static ASurfaceTransaction_apply_FPN ASurfaceTransaction_apply;
+static ASurfaceTransaction_setBuffer_FPN ASurfaceTransaction_setBuffer;
+static ASurfaceTransaction_setDamageRegion_FPN
+    ASurfaceTransaction_setDamageRegion;
+static ASurfaceTransaction_setPosition_FPN ASurfaceTransaction_setPosition;
+static ASurfaceTransaction_setVisibility_FPN ASurfaceTransaction_setVisibility;
+static ASurfaceTransaction_setZOrder_FPN ASurfaceTransaction_setZOrder;
+static ASurfaceTransaction_setOnComplete_FPN ASurfaceTransaction_setOnComplete;
+static ASurfaceTransactionStats_getPreviousReleaseFenceFd_FPN
+    ASurfaceTransactionStats_getPreviousReleaseFenceFd;
+static AHardwareBuffer_allocate_FPN AHardwareBuffer_allocate;
+static AHardwareBuffer_release_FPN AHardwareBuffer_release;
+
+namespace flutter {
+
+namespace {
+
+template <typename T>
+bool Resolve(const fml::RefPtr<fml::NativeLibrary>& library,
+             const char* symbol,
+             T* out_function) {
+  auto function = library->ResolveFunction<T>(symbol);
+  if (!function) {
+    return false;
+  }
+  *out_function = function.value();
+  return true;
+}
+
+constexpr int8_t kVisibilityHide = 0;
+constexpr int8_t kVisibilityShow = 1;
+
+}  // namespace
+
+bool AndroidSurfaceControl::IsAvailable() {
+  static std::optional<bool> is_available;
+  if (is_available) {
+    return is_available.value();
+  }
+  auto libandroid = fml::NativeLibrary::Create("libandroid.so");
+  FML_DCHECK(libandroid);
+  is_available =
+      Resolve(libandroid, "ASurfaceControl_fromJava",
+              &ASurfaceControl_fromJava) &&
+      Resolve(libandroid, "ASurfaceControl_create", &ASurfaceControl_create) &&
+      Resolve(libandroid, "ASurfaceControl_release",
+              &ASurfaceControl_release) &&
+      Resolve(libandroid, "ASurfaceTransaction_create",
+              &ASurfaceTransaction_create) &&
+      Resolve(libandroid, "ASurfaceTransaction_delete",
+              &ASurfaceTransaction_delete) &&
+      Resolve(libandroid, "ASurfaceTransaction_apply",
+              &ASurfaceTransaction_apply) &&
+      Resolve(libandroid, "ASurfaceTransaction_setBuffer",
+              &ASurfaceTransaction_setBuffer) &&
+      Resolve(libandroid, "ASurfaceTransaction_setDamageRegion",
+              &ASurfaceTransaction_setDamageRegion) &&
+      Resolve(libandroid, "ASurfaceTransaction_setPosition",
+              &ASurfaceTransaction_setPosition) &&
+      Resolve(libandroid, "ASurfaceTransaction_setVisibility",
+              &ASurfaceTransaction_setVisibility) &&
+      Resolve(libandroid, "ASurfaceTransaction_setZOrder",
+              &ASurfaceTransaction_setZOrder) &&
+      Resolve(libandroid, "ASurfaceTransaction_setOnComplete",
+              &ASurfaceTransaction_setOnComplete) &&
+      Resolve(libandroid, "ASurfaceTransactionStats_getPreviousReleaseFenceFd",
+              &ASurfaceTransactionStats_getPreviousReleaseFenceFd) &&
+      Resolve(libandroid, "AHardwareBuffer_allocate",
+              &AHardwareBuffer_allocate) &&
+      Resolve(libandroid, "AHardwareBuffer_release", &AHardwareBuffer_release);
+  return is_available.value();
+}
+
+std::unique_ptr<AndroidSurfaceControl> AndroidSurfaceControl::CreateFromJava(
+    JNIEnv* env,
+    jobject surface_control) {
+  if (!IsAvailable() || surface_control == nullptr) {
+    return nullptr;
+  }
+  ASurfaceControl* handle = ASurfaceControl_fromJava(env, surface_control);
+  if (!handle) {
+    return nullptr;
+  }
+  return std::unique_ptr<AndroidSurfaceControl>(
+      new AndroidSurfaceControl(handle));
+}
+
+AndroidSurfaceControl::AndroidSurfaceControl(ASurfaceControl* handle)
+    : handle_(handle) {}
+
+AndroidSurfaceControl::~AndroidSurfaceControl() {
+  ASurfaceControl_release(handle_);
+}
+
+std::unique_ptr<AndroidSurfaceControl> AndroidSurfaceControl::CreateChild(
+    const char* debug_name) const {
+  ASurfaceControl* handle = ASurfaceControl_create(handle_, debug_name);
+  if (!handle) {
+    FML_LOG(ERROR) << "Could not create a surface control.";
+    return nullptr;
+  }
+  return std::unique_ptr<AndroidSurfaceControl>(
+      new AndroidSurfaceControl(handle));
+}
+
+ASurfaceControl* AndroidSurfaceControl::GetHandle() const {
+  return handle_;
+}
+
+AndroidSurfaceTransaction::AndroidSurfaceTransaction()
+    : handle_(ASurfaceTransaction_create()) {
+  FML_DCHECK(AndroidSurfaceControl::IsAvailable());
+}
+
+AndroidSurfaceTransaction::~AndroidSurfaceTransaction() {
+  ASurfaceTransaction_delete(handle_);
+}
+
+void AndroidSurfaceTransaction::SetBuffer(const AndroidSurfaceControl& control,
+                                          AHardwareBuffer* buffer,
+                                          int acquire_fence_fd) {
+  ASurfaceTransaction_setBuffer(handle_, control.GetHandle(), buffer,
+                                acquire_fence_fd);
+}
+
+void AndroidSurfaceTransaction::SetDamageRegion(
+    const AndroidSurfaceControl& control,
+    const SkIRect& damage) {
+  const ARect rect = {damage.left(), damage.top(), damage.right(),
+                      damage.bottom()};
+  ASurfaceTransaction_setDamageRegion(handle_, control.GetHandle(), &rect, 1u);
+}
+
+void AndroidSurfaceTransaction::SetPosition(
+    const AndroidSurfaceControl& control,
+    const SkIPoint& position) {
+  ASurfaceTransaction_setPosition(handle_, control.GetHandle(), position.x(),
+                                  position.y());
+}
+
+void AndroidSurfaceTransaction::SetVisible(const AndroidSurfaceControl& control,
+                                           bool visible) {
+  ASurfaceTransaction_setVisibility(
+      handle_, control.GetHandle(),
+      visible ? kVisibilityShow : kVisibilityHide);
+}
+
+void AndroidSurfaceTransaction::SetZOrder(const AndroidSurfaceControl& control,
+                                          int32_t z_order) {
+  ASurfaceTransaction_setZOrder(handle_, control.GetHandle(), z_order);
+}
+
+void AndroidSurfaceTransaction::SetOnComplete(CompleteCallback callback) {
+  complete_callback_ = std::make_unique<CompleteCallback>(std::move(callback));
+  ASurfaceTransaction_setOnComplete(
+      handle_, complete_callback_.get(),
+      [](void* context, ASurfaceTransactionStats* stats) {
+        std::unique_ptr<CompleteCallback> callback(
+            reinterpret_cast<CompleteCallback*>(context));
+        (*callback)(stats);
+      });
+}
+
+void AndroidSurfaceTransaction::Apply() {
+  ASurfaceTransaction_apply(handle_);
+  // The callback is collected once it has been called.
+  if (complete_callback_) {
+    complete_callback_.release();
+  }
+}
+
+// static
+int AndroidSurfaceTransaction::GetPreviousReleaseFence(
+    ASurfaceTransactionStats* stats,
+    const AndroidSurfaceControl& control) {
+  return ASurfaceTransactionStats_getPreviousReleaseFenceFd(
+      stats, control.GetHandle());
+}
+
+std::unique_ptr<AndroidHardwareBuffer> AndroidHardwareBuffer::Create(
+    const SkISize& size) {
+  if (!AndroidSurfaceControl::IsAvailable() || size.isEmpty()) {
+    return nullptr;
+  }
+  AHardwareBuffer_Desc desc = {};
+  desc.width = size.width();
+  desc.height = size.height();
+  desc.layers = 1u;
+  desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+  desc.usage = AHARDWAREBUFFER_USAGE_GPU_COLOR_OUTPUT |
+               AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+               AHARDWAREBUFFER_USAGE_COMPOSER_OVERLAY;
+  AHardwareBuffer* handle = nullptr;
+  if (AHardwareBuffer_allocate(&desc, &handle) != 0 || !handle) {
+    FML_LOG(ERROR) << "Could not allocate a hardware buffer.";
+    return nullptr;
+  }
+  return std::unique_ptr<AndroidHardwareBuffer>(
+      new AndroidHardwareBuffer(handle, size));
+}
+
+AndroidHardwareBuffer::AndroidHardwareBuffer(AHardwareBuffer* handle,
+                                             const SkISize& size)
+    : handle_(handle), size_(size) {}
+
+AndroidHardwareBuffer::~AndroidHardwareBuffer() {
+  AHardwareBuffer_release(handle_);
+}
+
+AHardwareBuffer* AndroidHardwareBuffer::GetHandle() const {
+  return handle_;
+}
+
+const SkISize& AndroidHardwareBuffer::GetSize() const {
+  return size_;
+}
+
+}  // namespace flutter
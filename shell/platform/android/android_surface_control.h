@@ -0,0 +1,149 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_H_
+
+#include <jni.h>
+
+#include <functional>
+#include <memory>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+// The NDK headers of this tree don't declare the surface control APIs.
+struct ASurfaceControl;
+struct ASurfaceTransaction;
+struct ASurfaceTransactionStats;
+struct AHardwareBuffer;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// A layer of the compositor of the system, `SurfaceFlinger`, whose buffers
+/// it can scan out on a hardware plane of its own. The APIs are resolved at
+/// runtime, and are only used on API 34+, which can wrap the surface controls
+/// of Java.
+///
+class AndroidSurfaceControl {
+ public:
+  static bool IsAvailable();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Wraps a `android.view.SurfaceControl`, which must be kept
+  ///             alive by Java for as long as its children are used.
+  ///
+  static std::unique_ptr<AndroidSurfaceControl> CreateFromJava(
+      JNIEnv* env,
+      jobject surface_control);
+
+  ~AndroidSurfaceControl();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a layer that is composed on top of this one, and
+  ///             removed once the returned object is destroyed.
+  ///
+  std::unique_ptr<AndroidSurfaceControl> CreateChild(
+      const char* debug_name) const;
+
+  ASurfaceControl* GetHandle() const;
+
+ private:
+  ASurfaceControl* handle_;
+
+  explicit AndroidSurfaceControl(ASurfaceControl* handle);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceControl);
+};
+
+//------------------------------------------------------------------------------
+/// Changes to surface controls that are applied atomically, in the same
+/// composition of `SurfaceFlinger`.
+///
+class AndroidSurfaceTransaction {
+ public:
+  //----------------------------------------------------------------------------
+  /// Called on a binder thread once the transaction has been composed. The
+  /// stats are only valid during the call.
+  ///
+  using CompleteCallback = std::function<void(ASurfaceTransactionStats*)>;
+
+  AndroidSurfaceTransaction();
+
+  ~AndroidSurfaceTransaction();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the buffer that holds the content of the layer, which
+  ///             is composed once the fence has been signaled. Takes
+  ///             ownership of the fence, which may be -1 if the buffer is
+  ///             ready.
+  ///
+  void SetBuffer(const AndroidSurfaceControl& control,
+                 AHardwareBuffer* buffer,
+                 int acquire_fence_fd);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the part of the buffer that changed since the last
+  ///             buffer of the layer.
+  ///
+  void SetDamageRegion(const AndroidSurfaceControl& control,
+                       const SkIRect& damage);
+
+  void SetPosition(const AndroidSurfaceControl& control,
+                   const SkIPoint& position);
+
+  void SetVisible(const AndroidSurfaceControl& control, bool visible);
+
+  void SetZOrder(const AndroidSurfaceControl& control, int32_t z_order);
+
+  void SetOnComplete(CompleteCallback callback);
+
+  void Apply();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The fence that signals once the buffer the transaction
+  ///             replaced on the layer is no longer read by the compositor.
+  ///             The caller owns the fence, which is -1 if there is none.
+  ///
+  static int GetPreviousReleaseFence(ASurfaceTransactionStats* stats,
+                                     const AndroidSurfaceControl& control);
+
+ private:
+  ASurfaceTransaction* handle_;
+  std::unique_ptr<CompleteCallback> complete_callback_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceTransaction);
+};
+
+//------------------------------------------------------------------------------
+/// A buffer that the GPU renders into, and that surface controls compose.
+///
+class AndroidHardwareBuffer {
+ public:
+  //----------------------------------------------------------------------------
+  /// @brief      Allocates a RGBA buffer that can be rendered into and
+  ///             composed.
+  ///
+  static std::unique_ptr<AndroidHardwareBuffer> Create(const SkISize& size);
+
+  ~AndroidHardwareBuffer();
+
+  AHardwareBuffer* GetHandle() const;
+
+  const SkISize& GetSize() const;
+
+ private:
+  AHardwareBuffer* handle_;
+  const SkISize size_;
+
+  AndroidHardwareBuffer(AHardwareBuffer* handle, const SkISize& size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(AndroidHardwareBuffer);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_ANDROID_SURFACE_CONTROL_H_
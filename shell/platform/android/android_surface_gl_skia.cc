@@ -143,6 +143,10 @@ SurfaceFrame::FramebufferInfo AndroidSurfaceGLSkia::GLContextFramebufferInfo()
   // Larger alignment might also be beneficial for tile base renderers.
   res.horizontal_clip_alignment = 32;
   res.vertical_clip_alignment = 32;
+  // Both eglSetDamageRegionKHR and eglSwapBuffersWithDamageKHR take a list
+  // of rects. Allowing a few keeps small updates in different parts of the
+  // screen cheap without fragmenting the damage into many tiny rects.
+  res.max_damage_rects = 4;
 
   return res;
 }
@@ -153,13 +157,21 @@ void AndroidSurfaceGLSkia::GLContextSetDamageRegion(
   onscreen_surface_->SetDamageRegion(region);
 }
 
+void AndroidSurfaceGLSkia::GLContextSetDamageRects(
+    const std::optional<SkIRect>& region,
+    const std::vector<SkIRect>& rects) {
+  FML_DCHECK(IsValid());
+  onscreen_surface_->SetDamageRegion(region, rects);
+}
+
 bool AndroidSurfaceGLSkia::GLContextPresent(const GLPresentInfo& present_info) {
   FML_DCHECK(IsValid());
   FML_DCHECK(onscreen_surface_);
   if (present_info.presentation_time) {
     onscreen_surface_->SetPresentationTime(*present_info.presentation_time);
   }
-  return onscreen_surface_->SwapBuffers(present_info.frame_damage);
+  return onscreen_surface_->SwapBuffers(present_info.frame_damage,
+                                        present_info.frame_damage_rects);
 }
 
 GLFBOInfo AndroidSurfaceGLSkia::GLContextFBO(GLFrameInfo frame_info) const {
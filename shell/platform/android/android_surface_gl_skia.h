@@ -64,6 +64,10 @@ class AndroidSurfaceGLSkia final : public GPUSurfaceGLDelegate,
   // |GPUSurfaceGLDelegate|
   void GLContextSetDamageRegion(const std::optional<SkIRect>& region) override;
 
+  // |GPUSurfaceGLDelegate|
+  void GLContextSetDamageRects(const std::optional<SkIRect>& region,
+                               const std::vector<SkIRect>& rects) override;
+
   // |GPUSurfaceGLDelegate|
   bool GLContextPresent(const GLPresentInfo& present_info) override;
 
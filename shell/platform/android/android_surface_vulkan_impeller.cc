@@ -8,10 +8,14 @@
 #include <utility>
 
 #include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/file.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/memory/ref_ptr.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
 #include "flutter/impeller/renderer/backend/vulkan/context_vk.h"
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
+#include "flutter/shell/version/version.h"
 #include "flutter/vulkan/vulkan_native_surface_android.h"
 #include "impeller/entity/vk/entity_shaders_vk.h"
 #include "impeller/entity/vk/modern_shaders_vk.h"
@@ -34,10 +38,17 @@ std::shared_ptr<impeller::Context> CreateImpellerContext(
   PFN_vkGetInstanceProcAddr instance_proc_addr =
       proc_table->NativeGetInstanceProcAddr();
 
+  // The pipeline cache is versioned by the engine version, like the Skia
+  // shader cache, since the pipelines depend on the shaders in the engine.
+  auto cache_directory = fml::CreateDirectory(
+      fml::paths::GetCachesDirectory(),
+      {"flutter_engine", GetFlutterEngineVersion(), "impeller"},
+      fml::FilePermission::kReadWrite);
+
   auto context =
       impeller::ContextVK::Create(instance_proc_addr,                //
                                   shader_mappings,                   //
-                                  nullptr,                           //
+                                  std::move(cache_directory),        //
                                   concurrent_loop->GetTaskRunner(),  //
                                   "Android Impeller Vulkan Lib"      //
       );
@@ -45,12 +56,35 @@ std::shared_ptr<impeller::Context> CreateImpellerContext(
   return context;
 }
 
+static impeller::SwapchainSettingsVK CreateSwapchainSettings(
+    const Settings& settings) {
+  impeller::SwapchainSettingsVK swapchain_settings;
+  if (settings.impeller_vulkan_present_mode == "mailbox") {
+    swapchain_settings.present_mode = impeller::PresentModeVK::kMailbox;
+  } else if (settings.impeller_vulkan_present_mode == "fifo_relaxed") {
+    swapchain_settings.present_mode = impeller::PresentModeVK::kFifoRelaxed;
+  }
+  swapchain_settings.image_count =
+      settings.impeller_vulkan_swapchain_image_count;
+  swapchain_settings.pace_presents = settings.impeller_vulkan_pace_presents;
+  // The times are reported a few frames late, after the frame timings of the
+  // frame have been sent, so they are only traced.
+  swapchain_settings.on_present_timing =
+      [](const impeller::PresentTimingVK& timing) {
+        FML_TRACE_COUNTER("flutter", "VulkanPresentMargin", 0, "Microseconds",
+                          timing.present_margin.ToMicroseconds());
+      };
+  return swapchain_settings;
+}
+
 AndroidSurfaceVulkanImpeller::AndroidSurfaceVulkanImpeller(
     const std::shared_ptr<AndroidContext>& android_context,
-    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade)
+    const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
+    const Settings& settings)
     : AndroidSurface(android_context),
       proc_table_(fml::MakeRefCounted<vulkan::VulkanProcTable>()),
-      workers_(fml::ConcurrentMessageLoop::Create()) {
+      workers_(fml::ConcurrentMessageLoop::Create()),
+      swapchain_settings_(CreateSwapchainSettings(settings)) {
   impeller_context_ = CreateImpellerContext(proc_table_, workers_);
   is_valid_ =
       proc_table_->HasAcquiredMandatoryProcAddresses() && impeller_context_;
@@ -113,7 +147,8 @@ bool AndroidSurfaceVulkanImpeller::SetNativeWindow(
       return false;
     }
 
-    return context_vk.SetWindowSurface(std::move(surface));
+    return context_vk.SetWindowSurface(std::move(surface),
+                                       swapchain_settings_);
   }
 
   native_window_ = nullptr;
@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
+#include "flutter/impeller/renderer/backend/vulkan/swapchain_vk.h"
 #include "flutter/impeller/renderer/context.h"
 #include "flutter/shell/platform/android/surface/android_native_window.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
@@ -17,7 +19,8 @@ class AndroidSurfaceVulkanImpeller : public AndroidSurface {
  public:
   AndroidSurfaceVulkanImpeller(
       const std::shared_ptr<AndroidContext>& android_context,
-      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade);
+      const std::shared_ptr<PlatformViewAndroidJNI>& jni_facade,
+      const Settings& settings);
 
   ~AndroidSurfaceVulkanImpeller() override;
 
@@ -51,6 +54,7 @@ class AndroidSurfaceVulkanImpeller : public AndroidSurface {
   fml::RefPtr<AndroidNativeWindow> native_window_;
   std::shared_ptr<fml::ConcurrentMessageLoop> workers_;
   std::shared_ptr<impeller::Context> impeller_context_;
+  impeller::SwapchainSettingsVK swapchain_settings_;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidSurfaceVulkanImpeller);
@@ -32,4 +32,13 @@ sk_sp<GrDirectContext> AndroidContext::GetMainSkiaContext() const {
   return main_context_;
 }
 
+void AndroidContext::SetImpellerContext(
+    const std::shared_ptr<impeller::Context>& impeller_context) {
+  impeller_context_ = impeller_context;
+}
+
+std::shared_ptr<impeller::Context> AndroidContext::GetImpellerContext() const {
+  return impeller_context_;
+}
+
 }  // namespace flutter
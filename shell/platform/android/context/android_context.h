@@ -7,6 +7,7 @@
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
+#include "flutter/impeller/renderer/context.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
 namespace flutter {
@@ -54,12 +55,34 @@ class AndroidContext {
   ///
   sk_sp<GrDirectContext> GetMainSkiaContext() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Setter for the Impeller context to be used by the
+  ///             AndroidSurfaces of this AndroidContext.
+  /// @details    Engines spawned from one another share their AndroidContext,
+  ///             so setting the Impeller context here rather than on each
+  ///             surface lets them share its pipelines, shaders and glyph
+  ///             atlases instead of creating their own.
+  ///
+  void SetImpellerContext(
+      const std::shared_ptr<impeller::Context>& impeller_context);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Accessor for the Impeller context shared by the
+  ///             AndroidSurfaces of this AndroidContext.
+  /// @returns    `nullptr` when no Impeller context has been set yet via
+  ///             SetImpellerContext, as is the case when Impeller isn't
+  ///             enabled.
+  ///
+  std::shared_ptr<impeller::Context> GetImpellerContext() const;
+
  private:
   const AndroidRenderingAPI rendering_api_;
 
   // This is the Skia context used for on-screen rendering.
   sk_sp<GrDirectContext> main_context_;
 
+  std::shared_ptr<impeller::Context> impeller_context_;
+
   FML_DISALLOW_COPY_AND_ASSIGN(AndroidContext);
 };
 
@@ -12,13 +12,15 @@ AndroidExternalViewEmbedder::AndroidExternalViewEmbedder(
     const AndroidContext& android_context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
     std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-    const TaskRunners& task_runners)
+    const TaskRunners& task_runners,
+    std::unique_ptr<HardwareOverlayLayers> hardware_overlay_layers)
     : ExternalViewEmbedder(),
       android_context_(android_context),
       jni_facade_(std::move(jni_facade)),
       surface_factory_(std::move(surface_factory)),
       surface_pool_(std::make_unique<SurfacePool>()),
-      task_runners_(task_runners) {}
+      task_runners_(task_runners),
+      hardware_overlay_layers_(std::move(hardware_overlay_layers)) {}
 
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::PrerollCompositeEmbeddedView(
@@ -69,6 +71,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
 
   if (!FrameHasPlatformLayers()) {
     frame->Submit();
+    HideHardwareOverlayLayers(context);
     return;
   }
 
@@ -149,6 +152,12 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     frame->Submit();
   }
 
+  // The overlay layers are presented with the platform views, and aren't
+  // rendered into the overlay surfaces if they are on hardware planes.
+  const bool use_hardware_overlay_layers =
+      should_submit_current_frame &&
+      SubmitHardwareOverlayLayers(context, overlay_layers);
+
   for (int64_t view_id : composition_order_) {
     SkRect view_rect = GetViewRect(view_id);
     const EmbeddedViewParams& params = view_params_.at(view_id);
@@ -166,7 +175,7 @@ void AndroidExternalViewEmbedder::SubmitFrame(
     );
     std::unordered_map<int64_t, SkRect>::const_iterator overlay =
         overlay_layers.find(view_id);
-    if (overlay == overlay_layers.end()) {
+    if (overlay == overlay_layers.end() || use_hardware_overlay_layers) {
       continue;
     }
     std::unique_ptr<SurfaceFrame> frame =
@@ -181,6 +190,62 @@ void AndroidExternalViewEmbedder::SubmitFrame(
   }
 }
 
+bool AndroidExternalViewEmbedder::CanComposeOverlaysAbovePlatformViews(
+    const std::unordered_map<int64_t, SkRect>& overlay_layers) const {
+  for (size_t i = 0; i < composition_order_.size(); i++) {
+    auto overlay = overlay_layers.find(composition_order_[i]);
+    if (overlay == overlay_layers.end()) {
+      continue;
+    }
+    for (size_t j = i + 1; j < composition_order_.size(); j++) {
+      if (GetViewRect(composition_order_[j]).intersects(overlay->second)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool AndroidExternalViewEmbedder::SubmitHardwareOverlayLayers(
+    GrDirectContext* context,
+    const std::unordered_map<int64_t, SkRect>& overlay_layers) {
+  if (!hardware_overlay_layers_) {
+    return false;
+  }
+  TRACE_EVENT0("flutter",
+               "AndroidExternalViewEmbedder::SubmitHardwareOverlayLayers");
+  const bool can_use_layers =
+      CanComposeOverlaysAbovePlatformViews(overlay_layers) &&
+      hardware_overlay_layers_->BeginFrame(context, frame_size_);
+  if (!can_use_layers) {
+    // The overlay surfaces replace the layers of the previous frame.
+    HideHardwareOverlayLayers(context);
+    return false;
+  }
+  for (int64_t view_id : composition_order_) {
+    auto overlay = overlay_layers.find(view_id);
+    if (overlay != overlay_layers.end()) {
+      hardware_overlay_layers_->DrawLayer(slices_.at(view_id).get(),
+                                          overlay->second);
+    }
+  }
+  hardware_overlay_layers_->SubmitFrame();
+  hardware_overlay_layers_presented_ = true;
+  return true;
+}
+
+void AndroidExternalViewEmbedder::HideHardwareOverlayLayers(
+    GrDirectContext* context) {
+  if (!hardware_overlay_layers_presented_) {
+    return;
+  }
+  // A frame without any layer hides the layers of the previous frame.
+  if (hardware_overlay_layers_->BeginFrame(context, frame_size_)) {
+    hardware_overlay_layers_->SubmitFrame();
+  }
+  hardware_overlay_layers_presented_ = false;
+}
+
 // |ExternalViewEmbedder|
 std::unique_ptr<SurfaceFrame>
 AndroidExternalViewEmbedder::CreateSurfaceIfNeeded(GrDirectContext* context,
@@ -301,6 +366,10 @@ bool AndroidExternalViewEmbedder::SupportsDynamicThreadMerging() {
 // |ExternalViewEmbedder|
 void AndroidExternalViewEmbedder::Teardown() {
   DestroySurfaces();
+  if (hardware_overlay_layers_) {
+    hardware_overlay_layers_->Destroy();
+    hardware_overlay_layers_presented_ = false;
+  }
 }
 
 // |ExternalViewEmbedder|
@@ -11,6 +11,7 @@
 #include "flutter/flow/embedded_views.h"
 #include "flutter/flow/rtree.h"
 #include "flutter/shell/platform/android/context/android_context.h"
+#include "flutter/shell/platform/android/external_view_embedder/hardware_overlay_layers.h"
 #include "flutter/shell/platform/android/external_view_embedder/surface_pool.h"
 #include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
@@ -28,13 +29,17 @@ namespace flutter {
 /// that render above (by Z order) the Android view corresponding to
 /// |flutter::PlatformViewLayer|.
 ///
+/// If |HardwareOverlayLayers| are given, they're used instead of the overlay
+/// surfaces in the frames they can be used in.
+///
 class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
  public:
   AndroidExternalViewEmbedder(
       const AndroidContext& android_context,
       std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
       std::shared_ptr<AndroidSurfaceFactory> surface_factory,
-      const TaskRunners& task_runners);
+      const TaskRunners& task_runners,
+      std::unique_ptr<HardwareOverlayLayers> hardware_overlay_layers = nullptr);
 
   // |ExternalViewEmbedder|
   void PrerollCompositeEmbeddedView(
@@ -101,6 +106,12 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // The task runners.
   const TaskRunners task_runners_;
 
+  // Renders the overlays into layers on hardware planes, if supported.
+  const std::unique_ptr<HardwareOverlayLayers> hardware_overlay_layers_;
+
+  // Whether the previous frame presented |hardware_overlay_layers_|.
+  bool hardware_overlay_layers_presented_ = false;
+
   // The size of the root canvas.
   SkISize frame_size_;
 
@@ -135,6 +146,23 @@ class AndroidExternalViewEmbedder final : public ExternalViewEmbedder {
   // Whether the layer tree in the current frame has platform layers.
   bool FrameHasPlatformLayers();
 
+  // Whether the overlay layers can be composed above all the platform views,
+  // which is the case if none of them overlaps a platform view above the one
+  // it belongs to.
+  bool CanComposeOverlaysAbovePlatformViews(
+      const std::unordered_map<int64_t, SkRect>& overlay_layers) const;
+
+  // Renders the overlay layers into |hardware_overlay_layers_|.
+  //
+  // Returns false if they can't be used for this frame.
+  bool SubmitHardwareOverlayLayers(
+      GrDirectContext* context,
+      const std::unordered_map<int64_t, SkRect>& overlay_layers);
+
+  // Hides the layers of |hardware_overlay_layers_| if the previous frame
+  // presented them.
+  void HideHardwareOverlayLayers(GrDirectContext* context);
+
   // Creates a Surface when needed or recycles an existing one.
   // Finally, draws the picture on the frame's canvas.
   std::unique_ptr<SurfaceFrame> CreateSurfaceIfNeeded(GrDirectContext* context,
@@ -24,6 +24,7 @@
 namespace flutter {
 namespace testing {
 
+using ::testing::_;
 using ::testing::ByMove;
 using ::testing::Return;
 
@@ -64,6 +65,23 @@ class SurfaceMock : public Surface {
               (override));
 };
 
+class HardwareOverlayLayersMock : public HardwareOverlayLayers {
+ public:
+  MOCK_METHOD(bool,
+              BeginFrame,
+              (GrDirectContext * context, const SkISize& frame_size),
+              (override));
+
+  MOCK_METHOD(void,
+              DrawLayer,
+              (EmbedderViewSlice * slice, const SkRect& rect),
+              (override));
+
+  MOCK_METHOD(void, SubmitFrame, (), (override));
+
+  MOCK_METHOD(void, Destroy, (), (override));
+};
+
 fml::RefPtr<fml::RasterThreadMerger> GetThreadMergerFromPlatformThread(
     fml::Thread* rasterizer_thread = nullptr) {
   // Assume the current thread is the platform thread.
@@ -1039,6 +1057,89 @@ TEST(AndroidExternalViewEmbedder, Teardown) {
   embedder->Teardown();
 }
 
+TEST(AndroidExternalViewEmbedder, SubmitFrameHardwareOverlayLayers) {
+  auto jni_mock = std::make_shared<JNIMock>();
+  auto android_context =
+      std::make_shared<AndroidContext>(AndroidRenderingAPI::kSoftware);
+  auto gr_context = GrDirectContext::MakeMock(nullptr);
+  auto frame_size = SkISize::Make(1000, 1000);
+  auto surface_factory =
+      std::make_shared<TestAndroidSurfaceFactory>(
+          []() -> std::unique_ptr<AndroidSurface> {
+            ADD_FAILURE() << "The overlay surfaces shouldn't be used.";
+            return nullptr;
+          });
+  auto hardware_overlay_layers = std::make_unique<HardwareOverlayLayersMock>();
+  auto* layers_mock = hardware_overlay_layers.get();
+  auto embedder = std::make_unique<AndroidExternalViewEmbedder>(
+      *android_context, jni_mock, surface_factory, GetTaskRunnersForFixture(),
+      std::move(hardware_overlay_layers));
+
+  auto raster_thread_merger = GetThreadMergerFromPlatformThread();
+  SurfaceFrame::FramebufferInfo framebuffer_info;
+  auto make_surface_frame = [&framebuffer_info]() {
+    return std::make_unique<SurfaceFrame>(
+        SkSurface::MakeNull(1000, 1000), framebuffer_info,
+        [](const SurfaceFrame& surface_frame, DlCanvas* canvas) {
+          return true;
+        },
+        /*frame_size=*/SkISize::Make(800, 600));
+  };
+  SkMatrix matrix;
+  MutatorsStack stack;
+  stack.PushTransform(SkMatrix::Translate(0, 0));
+  auto rect_paint = DlPaint();
+  rect_paint.setColor(DlColor::kCyan());
+
+  EXPECT_CALL(*jni_mock, FlutterViewCreateOverlaySurface()).Times(0);
+  EXPECT_CALL(*jni_mock, FlutterViewDisplayOverlaySurface(_, _, _, _, _))
+      .Times(0);
+  EXPECT_CALL(*jni_mock, FlutterViewBeginFrame()).Times(3);
+  EXPECT_CALL(*jni_mock, FlutterViewEndFrame()).Times(3);
+  EXPECT_CALL(*jni_mock, FlutterViewOnDisplayPlatformView(0, 0, 0, 200, 200,
+                                                          300, 300, stack))
+      .Times(2);
+
+  // The first frame with a platform view isn't submitted, since the
+  // embedding switches surfaces.
+  EXPECT_CALL(*layers_mock, BeginFrame(_, _)).Times(0);
+  embedder->BeginFrame(frame_size, nullptr, 1.5, raster_thread_merger);
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(200, 200),
+                                              stack));
+  embedder->SubmitFrame(gr_context.get(), make_surface_frame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+  ::testing::Mock::VerifyAndClearExpectations(layers_mock);
+
+  // The Flutter UI above the platform view is drawn into a layer.
+  EXPECT_CALL(*layers_mock, BeginFrame(gr_context.get(), frame_size))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*layers_mock, DrawLayer(_, SkRect::MakeXYWH(25, 25, 80, 150)));
+  EXPECT_CALL(*layers_mock, SubmitFrame());
+  embedder->BeginFrame(frame_size, nullptr, 1.5, raster_thread_merger);
+  embedder->PrerollCompositeEmbeddedView(
+      0, std::make_unique<EmbeddedViewParams>(matrix, SkSize::Make(200, 200),
+                                              stack));
+  embedder->CompositeEmbeddedView(0)->DrawRect(
+      SkRect::MakeXYWH(25, 25, 80, 150), rect_paint);
+  embedder->SubmitFrame(gr_context.get(), make_surface_frame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+  ::testing::Mock::VerifyAndClearExpectations(layers_mock);
+
+  // The layers are hidden once there are no platform views.
+  EXPECT_CALL(*layers_mock, BeginFrame(gr_context.get(), frame_size))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*layers_mock, DrawLayer(_, _)).Times(0);
+  EXPECT_CALL(*layers_mock, SubmitFrame());
+  embedder->BeginFrame(frame_size, nullptr, 1.5, raster_thread_merger);
+  embedder->SubmitFrame(gr_context.get(), make_surface_frame());
+  embedder->EndFrame(/*should_resubmit_frame=*/false, raster_thread_merger);
+  ::testing::Mock::VerifyAndClearExpectations(layers_mock);
+
+  EXPECT_CALL(*layers_mock, Destroy());
+  embedder->Teardown();
+}
+
 TEST(AndroidExternalViewEmbedder, TeardownDoesNotCallJNIMethod) {
   auto jni_mock = std::make_shared<JNIMock>();
   auto android_context =
@@ -0,0 +1,64 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_HARDWARE_OVERLAY_LAYERS_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_HARDWARE_OVERLAY_LAYERS_H_
+
+#include "flutter/flow/embedded_views.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+class GrDirectContext;
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// The Flutter UI above the platform views, rendered in layers that the
+/// compositor of the system can place on hardware planes of their own instead
+/// of in overlay surfaces of the view hierarchy.
+///
+/// The layers are composed above all the platform views, so they're only used
+/// for frames where no layer overlaps a platform view above the one it
+/// belongs to.
+///
+/// All methods are called on the raster thread, while it's merged with the
+/// platform thread.
+///
+class HardwareOverlayLayers {
+ public:
+  virtual ~HardwareOverlayLayers() = default;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Starts the layers of a frame.
+  ///
+  /// @return     Whether the layers can be used for the frame. If not, the
+  ///             overlay surfaces are used instead, and the layers of the
+  ///             previous frames are hidden.
+  ///
+  virtual bool BeginFrame(GrDirectContext* context,
+                          const SkISize& frame_size) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the part of the slice in the rect, in the
+  ///             coordinates of the frame, into the next layer. The layer
+  ///             keeps its buffer, and isn't redrawn, if the slice and the
+  ///             rect are the same as in the previous frame.
+  ///
+  virtual void DrawLayer(EmbedderViewSlice* slice, const SkRect& rect) = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Presents the layers drawn since |BeginFrame| in one
+  ///             transaction, which hides the layers that weren't drawn.
+  ///
+  virtual void SubmitFrame() = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the layers and their buffers.
+  ///
+  virtual void Destroy() = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_EXTERNAL_VIEW_EMBEDDER_HARDWARE_OVERLAY_LAYERS_H_
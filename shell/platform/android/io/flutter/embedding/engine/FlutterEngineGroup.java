@@ -5,6 +5,9 @@
 package io.flutter.embedding.engine;
 
 import android.content.Context;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.SystemClock;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 import androidx.annotation.VisibleForTesting;
@@ -37,6 +40,21 @@ public class FlutterEngineGroup {
 
   /* package */ @VisibleForTesting final List<FlutterEngine> activeEngines = new ArrayList<>();
 
+  /* package */ @VisibleForTesting final List<FlutterEngine> prewarmedEngines = new ArrayList<>();
+
+  /**
+   * How long after an engine is taken with {@link #takePrewarmedEngine()} its replacement is
+   * spawned at the earliest, so that the spawn doesn't jank the first frames of the screen the
+   * taken engine is shown in.
+   */
+  private static final long PREWARM_REPLACEMENT_DELAY_MS = 1000;
+
+  @NonNull private final Handler handler = new Handler(Looper.getMainLooper());
+  @Nullable private Options prewarmOptions;
+  private int prewarmCount = 0;
+  private boolean prewarmPending = false;
+  private long earliestPrewarmUptimeMs = 0;
+
   /**
    * Create a FlutterEngineGroup whose child engines will share resources.
    *
@@ -192,11 +210,101 @@ public class FlutterEngineGroup {
           @Override
           public void onEngineWillDestroy() {
             activeEngines.remove(engineToCleanUpOnDestroy);
+            prewarmedEngines.remove(engineToCleanUpOnDestroy);
           }
         });
     return engine;
   }
 
+  /**
+   * Keeps {@code count} {@link io.flutter.embedding.engine.FlutterEngine}s created with the
+   * specified {@link Options} running in this group, to be handed out by {@link
+   * #takePrewarmedEngine()} without the latency of creating them.
+   *
+   * <p>The engines are created one at a time on the main thread while it is idle. As an engine's
+   * entrypoint can't be changed once it is running, the options usually specify a standby
+   * entrypoint that waits to be told what to show, for example over a platform channel. Each
+   * prewarmed engine gets its own {@link PlatformViewsController}, the one of the options is not
+   * used.
+   *
+   * <p>Calling this again replaces the options for engines that are prewarmed from then on, and
+   * destroys the prewarmed engines that exceed the new {@code count}. A {@code count} of 0 stops
+   * prewarming.
+   */
+  public void prewarmEngines(@NonNull Options options, int count) {
+    prewarmOptions = options;
+    prewarmCount = count;
+    while (prewarmedEngines.size() > prewarmCount) {
+      prewarmedEngines.remove(prewarmedEngines.size() - 1).destroy();
+    }
+    schedulePrewarm();
+  }
+
+  /**
+   * Hands out a running {@link io.flutter.embedding.engine.FlutterEngine} created with the options
+   * of {@link #prewarmEngines(Options, int)}. If no engine has been prewarmed, one is created
+   * synchronously. In either case, a replacement is prewarmed once the main thread is idle again,
+   * but no sooner than a second later.
+   *
+   * @throws IllegalStateException if {@link #prewarmEngines(Options, int)} hasn't been called.
+   */
+  @NonNull
+  public FlutterEngine takePrewarmedEngine() {
+    if (prewarmOptions == null) {
+      throw new IllegalStateException("prewarmEngines must be called before taking an engine.");
+    }
+    FlutterEngine engine;
+    if (prewarmedEngines.isEmpty()) {
+      engine = createAndRunEngine(createPrewarmOptions());
+    } else {
+      engine = prewarmedEngines.remove(0);
+    }
+    earliestPrewarmUptimeMs = SystemClock.uptimeMillis() + PREWARM_REPLACEMENT_DELAY_MS;
+    schedulePrewarm();
+    return engine;
+  }
+
+  private void schedulePrewarm() {
+    if (prewarmPending || prewarmOptions == null || prewarmedEngines.size() >= prewarmCount) {
+      return;
+    }
+    prewarmPending = true;
+    long delayMs = Math.max(0, earliestPrewarmUptimeMs - SystemClock.uptimeMillis());
+    handler.postDelayed(
+        () ->
+            Looper.myQueue()
+                .addIdleHandler(
+                    () -> {
+                      prewarmPending = false;
+                      prewarm();
+                      return false;
+                    }),
+        delayMs);
+  }
+
+  private void prewarm() {
+    if (SystemClock.uptimeMillis() < earliestPrewarmUptimeMs) {
+      // An engine was taken since this prewarm was scheduled.
+      schedulePrewarm();
+      return;
+    }
+    if (prewarmOptions == null || prewarmedEngines.size() >= prewarmCount) {
+      return;
+    }
+    prewarmedEngines.add(createAndRunEngine(createPrewarmOptions()));
+    schedulePrewarm();
+  }
+
+  @NonNull
+  private Options createPrewarmOptions() {
+    return new Options(prewarmOptions.getContext())
+        .setDartEntrypoint(prewarmOptions.getDartEntrypoint())
+        .setInitialRoute(prewarmOptions.getInitialRoute())
+        .setDartEntrypointArgs(prewarmOptions.getDartEntrypointArgs())
+        .setAutomaticallyRegisterPlugins(prewarmOptions.getAutomaticallyRegisterPlugins())
+        .setWaitForRestorationData(prewarmOptions.getWaitForRestorationData());
+  }
+
   @VisibleForTesting
   /* package */ FlutterEngine createEngine(
       Context context,
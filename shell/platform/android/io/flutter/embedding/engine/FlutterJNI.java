@@ -14,6 +14,7 @@ import android.os.Build;
 import android.os.Looper;
 import android.util.Size;
 import android.view.Surface;
+import android.view.SurfaceControl;
 import android.view.SurfaceHolder;
 import androidx.annotation.Keep;
 import androidx.annotation.NonNull;
@@ -557,6 +558,34 @@ public class FlutterJNI {
     return null;
   }
 
+  /**
+   * Decodes the full sized {@code buffer} into a {@link Bitmap.Config#HARDWARE} bitmap, whose
+   * hardware buffer is bound to a texture by the engine without uploading the pixels.
+   *
+   * <p>Returns null if the image can't be decoded into a hardware bitmap, in which case the engine
+   * decodes it as usual.
+   */
+  @SuppressWarnings("unused")
+  @VisibleForTesting
+  @Nullable
+  public static Bitmap decodeImageToHardwareBitmap(@NonNull ByteBuffer buffer) {
+    if (Build.VERSION.SDK_INT >= 30) {
+      ImageDecoder.Source source = ImageDecoder.createSource(buffer);
+      try {
+        return ImageDecoder.decodeBitmap(
+            source,
+            (decoder, info, src) -> {
+              decoder.setTargetColorSpace(ColorSpace.get(ColorSpace.Named.SRGB));
+              decoder.setAllocator(ImageDecoder.ALLOCATOR_HARDWARE);
+            });
+      } catch (IOException e) {
+        Log.e(TAG, "Failed to decode image into a hardware bitmap", e);
+        return null;
+      }
+    }
+    return null;
+  }
+
   // Called by native to notify first Flutter frame rendered.
   @SuppressWarnings("unused")
   @VisibleForTesting
@@ -1206,6 +1235,29 @@ public class FlutterJNI {
     }
     platformViewsController.destroyOverlaySurfaces();
   }
+
+  @SuppressWarnings("unused")
+  @UiThread
+  @Nullable
+  public SurfaceControl createOverlaySurfaceControl() {
+    ensureRunningOnMainThread();
+    if (platformViewsController == null) {
+      throw new RuntimeException(
+          "platformViewsController must be set before attempting to create an overlay surface control");
+    }
+    return platformViewsController.createOverlaySurfaceControl();
+  }
+
+  @SuppressWarnings("unused")
+  @UiThread
+  public void destroyOverlaySurfaceControl() {
+    ensureRunningOnMainThread();
+    if (platformViewsController == null) {
+      throw new RuntimeException(
+          "platformViewsController must be set before attempting to destroy an overlay surface control");
+    }
+    platformViewsController.destroyOverlaySurfaceControl();
+  }
   // ----- End Engine Lifecycle Support ----
 
   // ----- Start Localization Support ----
@@ -1329,6 +1381,30 @@ public class FlutterJNI {
   private native void nativeLoadDartDeferredLibrary(
       long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
 
+  /**
+   * Hints that the Dart deferred library of the loading unit is going to be loaded soon.
+   *
+   * <p>The shared library is searched for in the same way as by {@link
+   * #loadDartDeferredLibrary(int, String[])}, but it is opened and its pages are faulted in on a
+   * background thread. When Dart then calls loadLibrary() for it, it is loaded without a call to
+   * {@link DeferredComponentManager#loadDartLibrary(int, String)}. If no valid library is found,
+   * the hint is ignored.
+   *
+   * <p>The deferred component that contains the loading unit must already be installed.
+   *
+   * @param loadingUnitId The loadingUnitId of the Dart deferred library.
+   * @param searchPaths An array of paths in which to look for valid dart shared libraries.
+   */
+  @UiThread
+  public void prefetchDartDeferredLibrary(int loadingUnitId, @NonNull String[] searchPaths) {
+    ensureRunningOnMainThread();
+    ensureAttachedToNative();
+    nativePrefetchDartDeferredLibrary(nativeShellHolderId, loadingUnitId, searchPaths);
+  }
+
+  private native void nativePrefetchDartDeferredLibrary(
+      long nativeShellHolderId, int loadingUnitId, @NonNull String[] searchPaths);
+
   /**
    * Adds the specified AssetManager as an APKAssetResolver in the Flutter Engine's AssetManager.
    *
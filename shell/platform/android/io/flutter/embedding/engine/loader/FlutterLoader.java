@@ -41,6 +41,22 @@ public class FlutterLoader {
       "io.flutter.embedding.android.OldGenHeapSize";
   private static final String ENABLE_IMPELLER_META_DATA_KEY =
       "io.flutter.embedding.android.EnableImpeller";
+  private static final String IMPELLER_VULKAN_PRESENT_MODE_META_DATA_KEY =
+      "io.flutter.embedding.android.ImpellerVulkanPresentMode";
+  private static final String IMPELLER_VULKAN_SWAPCHAIN_IMAGE_COUNT_META_DATA_KEY =
+      "io.flutter.embedding.android.ImpellerVulkanSwapchainImageCount";
+  private static final String IMPELLER_VULKAN_PACE_PRESENTS_META_DATA_KEY =
+      "io.flutter.embedding.android.ImpellerVulkanPacePresents";
+  private static final String ENABLE_POINTER_RESAMPLING_META_DATA_KEY =
+      "io.flutter.embedding.android.EnablePointerResampling";
+  private static final String ENABLE_PERFORMANCE_HINTS_META_DATA_KEY =
+      "io.flutter.embedding.android.EnablePerformanceHints";
+  private static final String ENABLE_HARDWARE_IMAGE_DECODING_META_DATA_KEY =
+      "io.flutter.embedding.android.EnableHardwareImageDecoding";
+  private static final String ENABLE_SURFACE_CONTROL_OVERLAYS_META_DATA_KEY =
+      "io.flutter.embedding.android.EnableSurfaceControlOverlays";
+  private static final String PIN_THREADS_TO_CPU_CORES_META_DATA_KEY =
+      "io.flutter.embedding.android.PinThreadsToCpuCores";
 
   /**
    * Set whether leave or clean up the VM after the last shell shuts down. It can be set from app's
@@ -319,6 +335,35 @@ public class FlutterLoader {
       if (metaData != null && metaData.getBoolean(ENABLE_IMPELLER_META_DATA_KEY, false)) {
         shellArgs.add("--enable-impeller");
       }
+      if (metaData != null) {
+        String presentMode = metaData.getString(IMPELLER_VULKAN_PRESENT_MODE_META_DATA_KEY);
+        if (presentMode != null) {
+          shellArgs.add("--impeller-vulkan-present-mode=" + presentMode);
+        }
+        int swapchainImageCount =
+            metaData.getInt(IMPELLER_VULKAN_SWAPCHAIN_IMAGE_COUNT_META_DATA_KEY, 0);
+        if (swapchainImageCount > 0) {
+          shellArgs.add("--impeller-vulkan-swapchain-image-count=" + swapchainImageCount);
+        }
+        if (metaData.getBoolean(IMPELLER_VULKAN_PACE_PRESENTS_META_DATA_KEY, false)) {
+          shellArgs.add("--impeller-vulkan-pace-presents");
+        }
+        if (metaData.getBoolean(ENABLE_POINTER_RESAMPLING_META_DATA_KEY, false)) {
+          shellArgs.add("--enable-pointer-resampling");
+        }
+        if (metaData.getBoolean(ENABLE_PERFORMANCE_HINTS_META_DATA_KEY, false)) {
+          shellArgs.add("--enable-performance-hints");
+        }
+        if (metaData.getBoolean(ENABLE_HARDWARE_IMAGE_DECODING_META_DATA_KEY, false)) {
+          shellArgs.add("--enable-hardware-image-decoding");
+        }
+        if (metaData.getBoolean(ENABLE_SURFACE_CONTROL_OVERLAYS_META_DATA_KEY, false)) {
+          shellArgs.add("--enable-surface-control-overlays");
+        }
+        if (metaData.getBoolean(PIN_THREADS_TO_CPU_CORES_META_DATA_KEY, false)) {
+          shellArgs.add("--pin-threads-to-cpu-cores");
+        }
+      }
 
       final String leakVM = isLeakVM(metaData) ? "true" : "false";
       shellArgs.add("--leak-vm=" + leakVM);
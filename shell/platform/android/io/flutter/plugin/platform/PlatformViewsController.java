@@ -12,7 +12,9 @@ import android.content.Context;
 import android.content.MutableContextWrapper;
 import android.os.Build;
 import android.util.SparseArray;
+import android.view.AttachedSurfaceControl;
 import android.view.MotionEvent;
+import android.view.SurfaceControl;
 import android.view.SurfaceView;
 import android.view.View;
 import android.view.ViewGroup;
@@ -72,6 +74,9 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
   // The View currently rendering the Flutter UI associated with these platform views.
   private FlutterView flutterView;
 
+  // The layer the engine composes the overlay layers in when they're placed on hardware planes.
+  @Nullable private SurfaceControl overlaySurfaceControl;
+
   // The texture registry maintaining the textures into which the embedded views will be rendered.
   @Nullable private TextureRegistry textureRegistry;
 
@@ -830,6 +835,7 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
 
     destroyOverlaySurfaces();
     removeOverlaySurfaces();
+    destroyOverlaySurfaceControl();
     flutterView = null;
     flutterViewConvertedToImageView = false;
 
@@ -1298,6 +1304,66 @@ public class PlatformViewsController implements PlatformViewsAccessibilityDelega
     }
   }
 
+  /**
+   * Creates the surface control that the engine composes the overlay layers in when they're
+   * placed on hardware planes, or returns the existing one. It's composed above the views of the
+   * window, and therefore above the platform views.
+   *
+   * <p>This method is used only internally by {@code FlutterJNI}.
+   *
+   * @return the surface control, or null below API 34 or if the view isn't attached to a window.
+   */
+  @Nullable
+  public SurfaceControl createOverlaySurfaceControl() {
+    if (overlaySurfaceControl != null) {
+      return overlaySurfaceControl;
+    }
+    if (Build.VERSION.SDK_INT < 34 || flutterView == null) {
+      return null;
+    }
+    return createOverlaySurfaceControlApi34();
+  }
+
+  @TargetApi(34)
+  @Nullable
+  private SurfaceControl createOverlaySurfaceControlApi34() {
+    final AttachedSurfaceControl rootSurfaceControl = flutterView.getRootSurfaceControl();
+    if (rootSurfaceControl == null) {
+      return null;
+    }
+    final SurfaceControl surfaceControl =
+        new SurfaceControl.Builder().setName("Flutter overlay layers").build();
+    final SurfaceControl.Transaction transaction =
+        rootSurfaceControl.buildReparentTransaction(surfaceControl);
+    if (transaction == null) {
+      surfaceControl.release();
+      return null;
+    }
+    final int[] location = new int[2];
+    flutterView.getLocationInWindow(location);
+    transaction
+        .setLayer(surfaceControl, 1)
+        .setPosition(surfaceControl, location[0], location[1])
+        .setVisibility(surfaceControl, true);
+    rootSurfaceControl.applyTransactionOnDraw(transaction);
+    overlaySurfaceControl = surfaceControl;
+    return surfaceControl;
+  }
+
+  /**
+   * Removes the surface control of the overlay layers, and with it the layers, from the window.
+   *
+   * <p>This method is used only internally by {@code FlutterJNI}.
+   */
+  public void destroyOverlaySurfaceControl() {
+    if (overlaySurfaceControl == null || Build.VERSION.SDK_INT < 34) {
+      return;
+    }
+    new SurfaceControl.Transaction().reparent(overlaySurfaceControl, null).apply();
+    overlaySurfaceControl.release();
+    overlaySurfaceControl = null;
+  }
+
   private void removeOverlaySurfaces() {
     if (flutterView == null) {
       Log.e(TAG, "removeOverlaySurfaces called while flutter view is null");
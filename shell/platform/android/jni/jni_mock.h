@@ -92,6 +92,13 @@ class JNIMock final : public PlatformViewAndroidJNI {
 
   MOCK_METHOD(void, FlutterViewDestroyOverlaySurfaces, (), (override));
 
+  MOCK_METHOD(JavaLocalRef,
+              FlutterViewCreateOverlaySurfaceControl,
+              (),
+              (override));
+
+  MOCK_METHOD(void, FlutterViewDestroyOverlaySurfaceControl, (), (override));
+
   MOCK_METHOD(std::unique_ptr<std::vector<std::string>>,
               FlutterViewComputePlatformResolvedLocale,
               (std::vector<std::string> supported_locales_data),
@@ -186,6 +186,25 @@ class PlatformViewAndroidJNI {
   ///
   virtual void FlutterViewDestroyOverlaySurfaces() = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates the `android.view.SurfaceControl` that the overlay
+  ///             layers are composed in when they're placed on hardware
+  ///             planes, which is composed above the platform views.
+  ///
+  /// @note       Must be called from the platform thread.
+  ///
+  /// @return     The surface control, or null if the view doesn't support
+  ///             one, such as below API 34.
+  ///
+  virtual JavaLocalRef FlutterViewCreateOverlaySurfaceControl() = 0;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Destroys the surface control of the overlay layers.
+  ///
+  /// @note       Must be called from the platform thread.
+  ///
+  virtual void FlutterViewDestroyOverlaySurfaceControl() = 0;
+
   //----------------------------------------------------------------------------
   /// @brief      Computes the locale Android would select.
   ///
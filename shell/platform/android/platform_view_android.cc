@@ -25,6 +25,7 @@
 #include "flutter/shell/platform/android/platform_message_response_android.h"
 #include "flutter/shell/platform/android/surface/android_surface.h"
 #include "flutter/shell/platform/android/surface/snapshot_surface_producer.h"
+#include "flutter/shell/platform/android/surface_control_overlay_layers.h"
 #include "flutter/shell/platform/android/vsync_waiter_android.h"
 
 namespace flutter {
@@ -32,10 +33,10 @@ namespace flutter {
 AndroidSurfaceFactoryImpl::AndroidSurfaceFactoryImpl(
     const std::shared_ptr<AndroidContext>& context,
     std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-    bool enable_impeller)
+    const Settings& settings)
     : android_context_(context),
       jni_facade_(std::move(jni_facade)),
-      enable_impeller_(enable_impeller) {}
+      settings_(settings) {}
 
 AndroidSurfaceFactoryImpl::~AndroidSurfaceFactoryImpl() = default;
 
@@ -45,11 +46,11 @@ std::unique_ptr<AndroidSurface> AndroidSurfaceFactoryImpl::CreateSurface() {
       return std::make_unique<AndroidSurfaceSoftware>(android_context_,
                                                       jni_facade_);
     case AndroidRenderingAPI::kOpenGLES:
-      if (enable_impeller_) {
+      if (settings_.enable_impeller) {
 // TODO(kaushikiska@): Enable this after wiring a preference for Vulkan backend.
 #if false
-        return std::make_unique<AndroidSurfaceVulkanImpeller>(android_context_,
-                                                              jni_facade_);
+        return std::make_unique<AndroidSurfaceVulkanImpeller>(
+            android_context_, jni_facade_, settings_);
 
 #else
         return std::make_unique<AndroidSurfaceGLImpeller>(android_context_,
@@ -114,8 +115,7 @@ PlatformViewAndroid::PlatformViewAndroid(
     FML_CHECK(android_context_->IsValid())
         << "Could not create surface from invalid Android context.";
     surface_factory_ = std::make_shared<AndroidSurfaceFactoryImpl>(
-        android_context_, jni_facade_,
-        delegate.OnPlatformViewGetSettings().enable_impeller);
+        android_context_, jni_facade_, delegate.OnPlatformViewGetSettings());
     android_surface_ = surface_factory_->CreateSurface();
 
     FML_CHECK(android_surface_ && android_surface_->IsValid())
@@ -292,8 +292,17 @@ std::unique_ptr<Surface> PlatformViewAndroid::CreateRenderingSurface() {
 // |PlatformView|
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewAndroid::CreateExternalViewEmbedder() {
+  std::unique_ptr<HardwareOverlayLayers> hardware_overlay_layers;
+  const Settings& settings = GetSettings();
+  if (settings.enable_surface_control_overlays && !settings.enable_impeller &&
+      android_context_->RenderingApi() == AndroidRenderingAPI::kOpenGLES &&
+      SurfaceControlOverlayLayers::IsAvailable()) {
+    hardware_overlay_layers =
+        std::make_unique<SurfaceControlOverlayLayers>(jni_facade_);
+  }
   return std::make_shared<AndroidExternalViewEmbedder>(
-      *android_context_, jni_facade_, surface_factory_, task_runners_);
+      *android_context_, jni_facade_, surface_factory_, task_runners_,
+      std::move(hardware_overlay_layers));
 }
 
 // |PlatformView|
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "flutter/common/settings.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/platform/android/scoped_java_ref.h"
 #include "flutter/lib/ui/window/platform_message.h"
@@ -28,7 +29,7 @@ class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  public:
   AndroidSurfaceFactoryImpl(const std::shared_ptr<AndroidContext>& context,
                             std::shared_ptr<PlatformViewAndroidJNI> jni_facade,
-                            bool enable_impeller);
+                            const Settings& settings);
 
   ~AndroidSurfaceFactoryImpl() override;
 
@@ -37,7 +38,7 @@ class AndroidSurfaceFactoryImpl : public AndroidSurfaceFactory {
  private:
   const std::shared_ptr<AndroidContext>& android_context_;
   std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
-  const bool enable_impeller_;
+  const Settings settings_;
 };
 
 class PlatformViewAndroid final : public PlatformView {
@@ -90,6 +90,10 @@ static jmethodID g_create_overlay_surface_method = nullptr;
 
 static jmethodID g_destroy_overlay_surfaces_method = nullptr;
 
+static jmethodID g_create_overlay_surface_control_method = nullptr;
+
+static jmethodID g_destroy_overlay_surface_control_method = nullptr;
+
 static jmethodID g_on_begin_frame_method = nullptr;
 
 static jmethodID g_on_end_frame_method = nullptr;
@@ -595,6 +599,16 @@ static void LoadDartDeferredLibrary(JNIEnv* env,
       std::move(instructions_mapping));
 }
 
+static void PrefetchDartDeferredLibrary(JNIEnv* env,
+                                        jobject obj,
+                                        jlong shell_holder,
+                                        jint jLoadingUnitId,
+                                        jobjectArray jSearchPaths) {
+  ANDROID_SHELL_HOLDER->PrefetchDartDeferredLibrary(
+      static_cast<intptr_t>(jLoadingUnitId),
+      fml::jni::StringArrayToVector(env, jSearchPaths));
+}
+
 static void UpdateJavaAssetManager(JNIEnv* env,
                                    jobject obj,
                                    jlong shell_holder,
@@ -784,6 +798,11 @@ bool RegisterApi(JNIEnv* env) {
           .signature = "(JI[Ljava/lang/String;)V",
           .fnPtr = reinterpret_cast<void*>(&LoadDartDeferredLibrary),
       },
+      {
+          .name = "nativePrefetchDartDeferredLibrary",
+          .signature = "(JI[Ljava/lang/String;)V",
+          .fnPtr = reinterpret_cast<void*>(&PrefetchDartDeferredLibrary),
+      },
       {
           .name = "nativeUpdateJavaAssetManager",
           .signature =
@@ -896,6 +915,23 @@ bool RegisterApi(JNIEnv* env) {
     return false;
   }
 
+  g_create_overlay_surface_control_method = env->GetMethodID(
+      g_flutter_jni_class->obj(), "createOverlaySurfaceControl",
+      "()Landroid/view/SurfaceControl;");
+
+  if (g_create_overlay_surface_control_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate createOverlaySurfaceControl method";
+    return false;
+  }
+
+  g_destroy_overlay_surface_control_method = env->GetMethodID(
+      g_flutter_jni_class->obj(), "destroyOverlaySurfaceControl", "()V");
+
+  if (g_destroy_overlay_surface_control_method == nullptr) {
+    FML_LOG(ERROR) << "Could not locate destroyOverlaySurfaceControl method";
+    return false;
+  }
+
   fml::jni::ScopedJavaLocalRef<jclass> overlay_surface_class(
       env, env->FindClass("io/flutter/embedding/engine/FlutterOverlaySurface"));
   if (overlay_surface_class.is_null()) {
@@ -1576,6 +1612,36 @@ void PlatformViewAndroidJNIImpl::FlutterViewDestroyOverlaySurfaces() {
   FML_CHECK(fml::jni::CheckException(env));
 }
 
+JavaLocalRef
+PlatformViewAndroidJNIImpl::FlutterViewCreateOverlaySurfaceControl() {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  auto java_object = java_object_.get(env);
+  if (java_object.is_null()) {
+    return JavaLocalRef();
+  }
+
+  JavaLocalRef surface_control(
+      env, env->CallObjectMethod(java_object.obj(),
+                                 g_create_overlay_surface_control_method));
+  FML_CHECK(fml::jni::CheckException(env));
+  return surface_control;
+}
+
+void PlatformViewAndroidJNIImpl::FlutterViewDestroyOverlaySurfaceControl() {
+  JNIEnv* env = fml::jni::AttachCurrentThread();
+
+  auto java_object = java_object_.get(env);
+  if (java_object.is_null()) {
+    return;
+  }
+
+  env->CallVoidMethod(java_object.obj(),
+                      g_destroy_overlay_surface_control_method);
+
+  FML_CHECK(fml::jni::CheckException(env));
+}
+
 std::unique_ptr<std::vector<std::string>>
 PlatformViewAndroidJNIImpl::FlutterViewComputePlatformResolvedLocale(
     std::vector<std::string> supported_locales_data) {
@@ -76,6 +76,10 @@ class PlatformViewAndroidJNIImpl final : public PlatformViewAndroidJNI {
 
   void FlutterViewDestroyOverlaySurfaces() override;
 
+  JavaLocalRef FlutterViewCreateOverlaySurfaceControl() override;
+
+  void FlutterViewDestroyOverlaySurfaceControl() override;
+
   std::unique_ptr<std::vector<std::string>>
   FlutterViewComputePlatformResolvedLocale(
       std::vector<std::string> supported_locales_data) override;
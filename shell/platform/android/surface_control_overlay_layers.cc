@@ -0,0 +1,338 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/android/surface_control_overlay_layers.h"
+
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/platform/android/jni_util.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/toolkit/egl/image.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrBackendSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/gl/GrGLTypes.h"
+
+namespace flutter {
+
+namespace {
+
+// How long to wait for the compositor to release a buffer before the layer
+// keeps its content of the previous frame instead.
+constexpr std::chrono::milliseconds kBufferReleaseTimeout(100);
+
+// Returns a fence that is signaled once the commands submitted so far have
+// completed, or -1 once they have completed if the display can't create
+// one.
+int CreateNativeFence(EGLDisplay display) {
+  static auto create_sync = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(
+      eglGetProcAddress("eglCreateSyncKHR"));
+  static auto destroy_sync = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(
+      eglGetProcAddress("eglDestroySyncKHR"));
+  static auto dup_native_fence =
+      reinterpret_cast<PFNEGLDUPNATIVEFENCEFDANDROIDPROC>(
+          eglGetProcAddress("eglDupNativeFenceFDANDROID"));
+  if (!create_sync || !destroy_sync || !dup_native_fence ||
+      !impeller::egl::HasExtension(display, "EGL_ANDROID_native_fence_sync")) {
+    glFinish();
+    return -1;
+  }
+  EGLSyncKHR sync =
+      create_sync(display, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
+  if (sync == EGL_NO_SYNC_KHR) {
+    glFinish();
+    return -1;
+  }
+  // The fence of the sync is only created once it's flushed.
+  glFlush();
+  int fence_fd = dup_native_fence(display, sync);
+  destroy_sync(display, sync);
+  if (fence_fd == EGL_NO_NATIVE_FENCE_FD_ANDROID) {
+    glFinish();
+    return -1;
+  }
+  return fence_fd;
+}
+
+}  // namespace
+
+// Whether the compositor still reads a buffer, which is updated on a binder
+// thread once the transaction that replaced the buffer has been composed.
+struct SurfaceControlOverlayLayers::ReleaseState {
+  std::mutex mutex;
+  std::condition_variable released;
+  bool in_use = false;
+  int release_fence = -1;
+
+  ~ReleaseState() {
+    if (release_fence >= 0) {
+      close(release_fence);
+    }
+  }
+
+  void Release(int fence_fd) {
+    std::scoped_lock lock(mutex);
+    if (release_fence >= 0) {
+      close(release_fence);
+    }
+    release_fence = fence_fd;
+    in_use = false;
+    released.notify_all();
+  }
+};
+
+// A hardware buffer and the surface that renders into it, which are only
+// used and collected on the raster thread.
+struct SurfaceControlOverlayLayers::Buffer {
+  std::unique_ptr<AndroidHardwareBuffer> hardware_buffer;
+  std::unique_ptr<impeller::egl::Image> image;
+  GLuint texture = 0;
+  sk_sp<SkSurface> surface;
+  std::shared_ptr<ReleaseState> release_state =
+      std::make_shared<ReleaseState>();
+
+  ~Buffer() {
+    surface.reset();
+    if (texture != 0) {
+      glDeleteTextures(1, &texture);
+    }
+  }
+};
+
+struct SurfaceControlOverlayLayers::Layer {
+  explicit Layer(std::shared_ptr<AndroidSurfaceControl> control)
+      : control(std::move(control)) {}
+
+  // Shared with the callbacks of the transactions that are still pending.
+  const std::shared_ptr<AndroidSurfaceControl> control;
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  size_t next_buffer = 0u;
+  std::shared_ptr<Buffer> presented_buffer;
+  sk_sp<DisplayList> display_list;
+  SkIRect rect = SkIRect::MakeEmpty();
+};
+
+// The buffer a transaction replaces on a layer, which the compositor
+// releases once the transaction has been composed.
+struct SurfaceControlOverlayLayers::PendingRelease {
+  std::shared_ptr<AndroidSurfaceControl> control;
+  std::shared_ptr<ReleaseState> release_state;
+};
+
+bool SurfaceControlOverlayLayers::IsAvailable() {
+  return AndroidSurfaceControl::IsAvailable();
+}
+
+SurfaceControlOverlayLayers::SurfaceControlOverlayLayers(
+    std::shared_ptr<PlatformViewAndroidJNI> jni_facade)
+    : jni_facade_(std::move(jni_facade)) {}
+
+SurfaceControlOverlayLayers::~SurfaceControlOverlayLayers() = default;
+
+// |HardwareOverlayLayers|
+bool SurfaceControlOverlayLayers::BeginFrame(GrDirectContext* context,
+                                             const SkISize& frame_size) {
+  if (!context || context->backend() != GrBackendApi::kOpenGL) {
+    return false;
+  }
+  // The onscreen context that the background was just rendered with.
+  EGLDisplay display = eglGetCurrentDisplay();
+  if (display == EGL_NO_DISPLAY) {
+    return false;
+  }
+  if (!parent_) {
+    JNIEnv* env = fml::jni::AttachCurrentThread();
+    JavaLocalRef surface_control =
+        jni_facade_->FlutterViewCreateOverlaySurfaceControl();
+    if (surface_control.is_null()) {
+      return false;
+    }
+    parent_ = AndroidSurfaceControl::CreateFromJava(env, surface_control.obj());
+    if (!parent_) {
+      return false;
+    }
+  }
+  context_ = context;
+  display_ = display;
+  transaction_ = std::make_unique<AndroidSurfaceTransaction>();
+  layer_count_ = 0u;
+  return true;
+}
+
+// |HardwareOverlayLayers|
+void SurfaceControlOverlayLayers::DrawLayer(EmbedderViewSlice* slice,
+                                            const SkRect& rect) {
+  FML_DCHECK(transaction_);
+  TRACE_EVENT0("flutter", "SurfaceControlOverlayLayers::DrawLayer");
+  if (layer_count_ == layers_.size()) {
+    std::shared_ptr<AndroidSurfaceControl> control =
+        parent_->CreateChild("Flutter overlay layer");
+    if (!control) {
+      return;
+    }
+    layers_.push_back(std::make_unique<Layer>(std::move(control)));
+  }
+  Layer& layer = *layers_[layer_count_++];
+  const AndroidSurfaceControl& control = *layer.control;
+  const SkIRect layer_rect = rect.roundOut();
+  transaction_->SetZOrder(control, static_cast<int32_t>(layer_count_));
+  transaction_->SetPosition(control, layer_rect.topLeft());
+  transaction_->SetVisible(control, true);
+
+  // Layers whose content didn't change keep their buffer, which the
+  // compositor doesn't compose again.
+  sk_sp<DisplayList> display_list = slice->display_list();
+  if (layer.presented_buffer && layer.rect == layer_rect && display_list &&
+      layer.display_list && layer.display_list->Equals(display_list)) {
+    return;
+  }
+
+  std::shared_ptr<Buffer> buffer = AcquireBuffer(layer, layer_rect.size());
+  if (!buffer) {
+    return;
+  }
+  DlSkCanvasAdapter canvas(buffer->surface->getCanvas());
+  {
+    DlAutoCanvasRestore save(&canvas, /*doSave=*/true);
+    canvas.Clear(DlColor::kTransparent());
+    // Offset the slice since the position of the layer on the screen is set
+    // by the transaction.
+    canvas.Translate(-layer_rect.x(), -layer_rect.y());
+    slice->render_into(&canvas);
+  }
+  buffer->surface->flushAndSubmit();
+
+  transaction_->SetBuffer(control, buffer->hardware_buffer->GetHandle(),
+                          CreateNativeFence(display_));
+  transaction_->SetDamageRegion(control, SkIRect::MakeSize(layer_rect.size()));
+  if (layer.presented_buffer) {
+    pending_releases_.push_back(
+        {layer.control, layer.presented_buffer->release_state});
+  }
+  layer.presented_buffer = std::move(buffer);
+  layer.display_list = std::move(display_list);
+  layer.rect = layer_rect;
+}
+
+// |HardwareOverlayLayers|
+void SurfaceControlOverlayLayers::SubmitFrame() {
+  FML_DCHECK(transaction_);
+  TRACE_EVENT0("flutter", "SurfaceControlOverlayLayers::SubmitFrame");
+  for (size_t i = layer_count_; i < layers_.size(); i++) {
+    transaction_->SetVisible(*layers_[i]->control, false);
+  }
+  transaction_->SetOnComplete(
+      [releases = std::move(pending_releases_)](
+          ASurfaceTransactionStats* stats) {
+        for (const PendingRelease& release : releases) {
+          release.release_state->Release(
+              AndroidSurfaceTransaction::GetPreviousReleaseFence(
+                  stats, *release.control));
+        }
+      });
+  pending_releases_.clear();
+  transaction_->Apply();
+  transaction_.reset();
+}
+
+// |HardwareOverlayLayers|
+void SurfaceControlOverlayLayers::Destroy() {
+  transaction_.reset();
+  pending_releases_.clear();
+  // The compositor keeps the buffers it still reads alive.
+  layers_.clear();
+  if (!parent_) {
+    return;
+  }
+  parent_.reset();
+  jni_facade_->FlutterViewDestroyOverlaySurfaceControl();
+}
+
+std::shared_ptr<SurfaceControlOverlayLayers::Buffer>
+SurfaceControlOverlayLayers::AcquireBuffer(Layer& layer, const SkISize& size) {
+  if (!layer.buffers.empty() &&
+      layer.buffers.front()->hardware_buffer->GetSize() != size) {
+    layer.buffers.clear();
+    layer.next_buffer = 0u;
+  }
+  while (layer.buffers.size() < kBufferCount) {
+    std::shared_ptr<Buffer> buffer = CreateBuffer(size);
+    if (!buffer) {
+      layer.buffers.clear();
+      return nullptr;
+    }
+    layer.buffers.push_back(std::move(buffer));
+  }
+
+  std::shared_ptr<Buffer> buffer = layer.buffers[layer.next_buffer];
+  layer.next_buffer = (layer.next_buffer + 1u) % kBufferCount;
+
+  ReleaseState& release_state = *buffer->release_state;
+  int release_fence = -1;
+  {
+    std::unique_lock lock(release_state.mutex);
+    if (!release_state.released.wait_for(lock, kBufferReleaseTimeout, [&] {
+          return !release_state.in_use;
+        })) {
+      FML_LOG(ERROR) << "The compositor didn't release an overlay buffer.";
+      return nullptr;
+    }
+    std::swap(release_fence, release_state.release_fence);
+    release_state.in_use = true;
+  }
+  if (release_fence >= 0) {
+    impeller::egl::WaitForNativeFence(display_, release_fence);
+  }
+  return buffer;
+}
+
+std::shared_ptr<SurfaceControlOverlayLayers::Buffer>
+SurfaceControlOverlayLayers::CreateBuffer(const SkISize& size) {
+  static auto image_target_texture =
+      reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+          eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+  if (!image_target_texture) {
+    return nullptr;
+  }
+  auto buffer = std::make_shared<Buffer>();
+  buffer->hardware_buffer = AndroidHardwareBuffer::Create(size);
+  if (!buffer->hardware_buffer) {
+    return nullptr;
+  }
+  buffer->image = impeller::egl::Image::CreateFromHardwareBuffer(
+      display_, buffer->hardware_buffer->GetHandle());
+  if (!buffer->image) {
+    return nullptr;
+  }
+
+  glGenTextures(1, &buffer->texture);
+  glBindTexture(GL_TEXTURE_2D, buffer->texture);
+  image_target_texture(GL_TEXTURE_2D, buffer->image->GetHandle());
+  glBindTexture(GL_TEXTURE_2D, 0);
+  context_->resetContext(kTextureBinding_GrGLBackendState);
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_2D, buffer->texture,
+                                  GL_RGBA8_OES};
+  GrBackendTexture backend_texture(size.width(), size.height(),
+                                   GrMipMapped::kNo, texture_info);
+  buffer->surface = SkSurface::MakeFromBackendTexture(
+      context_, backend_texture, kTopLeft_GrSurfaceOrigin, 0,
+      kRGBA_8888_SkColorType, nullptr, nullptr);
+  if (!buffer->surface) {
+    FML_LOG(ERROR) << "Could not wrap an overlay buffer in a surface.";
+    return nullptr;
+  }
+  return buffer;
+}
+
+}  // namespace flutter
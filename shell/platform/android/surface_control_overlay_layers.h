@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_OVERLAY_LAYERS_H_
+#define FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_OVERLAY_LAYERS_H_
+
+#include <EGL/egl.h>
+
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/shell/platform/android/android_surface_control.h"
+#include "flutter/shell/platform/android/external_view_embedder/hardware_overlay_layers.h"
+#include "flutter/shell/platform/android/jni/platform_view_android_jni.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// Renders the overlay layers of platform views with Skia's OpenGL backend
+/// into hardware buffers, and presents them in child surface controls of the
+/// surface control that Java composes above the window, so that the
+/// compositor can scan them out on hardware planes of their own. Only
+/// available on API 34+.
+///
+class SurfaceControlOverlayLayers final : public HardwareOverlayLayers {
+ public:
+  static bool IsAvailable();
+
+  explicit SurfaceControlOverlayLayers(
+      std::shared_ptr<PlatformViewAndroidJNI> jni_facade);
+
+  ~SurfaceControlOverlayLayers() override;
+
+  // |HardwareOverlayLayers|
+  bool BeginFrame(GrDirectContext* context, const SkISize& frame_size) override;
+
+  // |HardwareOverlayLayers|
+  void DrawLayer(EmbedderViewSlice* slice, const SkRect& rect) override;
+
+  // |HardwareOverlayLayers|
+  void SubmitFrame() override;
+
+  // |HardwareOverlayLayers|
+  void Destroy() override;
+
+ private:
+  // The buffers each layer cycles through, one of which is composed while
+  // another may wait to be composed and the third is rendered into.
+  static constexpr size_t kBufferCount = 3u;
+
+  struct ReleaseState;
+  struct Buffer;
+  struct Layer;
+  struct PendingRelease;
+
+  const std::shared_ptr<PlatformViewAndroidJNI> jni_facade_;
+  std::unique_ptr<AndroidSurfaceControl> parent_;
+  std::vector<std::unique_ptr<Layer>> layers_;
+  GrDirectContext* context_ = nullptr;
+  EGLDisplay display_ = EGL_NO_DISPLAY;
+  std::unique_ptr<AndroidSurfaceTransaction> transaction_;
+  std::vector<PendingRelease> pending_releases_;
+  size_t layer_count_ = 0u;
+
+  std::shared_ptr<Buffer> AcquireBuffer(Layer& layer, const SkISize& size);
+
+  std::shared_ptr<Buffer> CreateBuffer(const SkISize& size);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(SurfaceControlOverlayLayers);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_ANDROID_SURFACE_CONTROL_OVERLAY_LAYERS_H_
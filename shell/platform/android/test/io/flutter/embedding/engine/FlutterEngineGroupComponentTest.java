@@ -17,9 +17,11 @@ import static org.mockito.Mockito.spy;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
 import static org.mockito.Mockito.when;
+import static org.robolectric.Shadows.shadowOf;
 
 import android.content.Context;
 import android.content.res.AssetManager;
+import android.os.Looper;
 import androidx.test.core.app.ApplicationProvider;
 import androidx.test.ext.junit.runners.AndroidJUnit4;
 import io.flutter.FlutterInjector;
@@ -28,6 +30,7 @@ import io.flutter.embedding.engine.loader.FlutterLoader;
 import io.flutter.embedding.engine.systemchannels.NavigationChannel;
 import io.flutter.plugin.platform.PlatformViewsController;
 import io.flutter.plugins.GeneratedPluginRegistrant;
+import java.time.Duration;
 import java.util.ArrayList;
 import java.util.List;
 import org.junit.After;
@@ -175,6 +178,40 @@ public class FlutterEngineGroupComponentTest {
     assertEquals(2, engineGroupUnderTest.activeEngines.size());
   }
 
+  @Test
+  public void prewarmsEnginesWhileIdleAndReplacesTakenOnesLater() {
+    engineGroupUnderTest.prewarmEngines(
+        new FlutterEngineGroup.Options(ctx).setDartEntrypoint(mock(DartEntrypoint.class)), 1);
+    assertEquals(0, engineGroupUnderTest.prewarmedEngines.size());
+
+    shadowOf(Looper.getMainLooper()).idle();
+    assertEquals(1, engineGroupUnderTest.prewarmedEngines.size());
+    assertEquals(1, engineGroupUnderTest.activeEngines.size());
+
+    doReturn(mock(FlutterEngine.class))
+        .when(firstEngineUnderTest)
+        .spawn(
+            any(Context.class),
+            any(DartEntrypoint.class),
+            nullable(String.class),
+            nullable(List.class),
+            any(PlatformViewsController.class),
+            any(Boolean.class),
+            any(Boolean.class));
+
+    FlutterEngine takenEngine = engineGroupUnderTest.takePrewarmedEngine();
+    assertEquals(firstEngineUnderTest, takenEngine);
+    assertEquals(0, engineGroupUnderTest.prewarmedEngines.size());
+
+    // The replacement isn't spawned right after the engine is taken.
+    shadowOf(Looper.getMainLooper()).idle();
+    assertEquals(0, engineGroupUnderTest.prewarmedEngines.size());
+
+    shadowOf(Looper.getMainLooper()).idleFor(Duration.ofSeconds(1));
+    assertEquals(1, engineGroupUnderTest.prewarmedEngines.size());
+    assertEquals(2, engineGroupUnderTest.activeEngines.size());
+  }
+
   @Test
   public void canCreateAndRunCustomEntrypoints() {
     FlutterEngine firstEngine =
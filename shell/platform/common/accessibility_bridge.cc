@@ -4,6 +4,7 @@
 
 #include "accessibility_bridge.h"
 
+#include <cstring>
 #include <functional>
 #include <utility>
 
@@ -68,6 +69,18 @@ void AccessibilityBridge::CommitUpdates() {
     }
   }
 
+  // Skip the updates that don't change their node. The framework sends every
+  // node it marks dirty, and ui::AXTree would otherwise rebuild the data of
+  // each one.
+  for (auto iter = pending_semantics_node_updates_.begin();
+       iter != pending_semantics_node_updates_.end();) {
+    if (IsUnchanged(iter->second)) {
+      iter = pending_semantics_node_updates_.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+
   // Second, apply the pending node updates. This also moves reparented nodes to
   // their new parents if needed.
   ui::AXTreeUpdate update{.tree_data = tree_->data()};
@@ -83,15 +96,15 @@ void AccessibilityBridge::CommitUpdates() {
   std::vector<std::vector<SemanticsNode>> results;
   while (!pending_semantics_node_updates_.empty()) {
     auto begin = pending_semantics_node_updates_.begin();
-    SemanticsNode target = begin->second;
+    SemanticsNode target = std::move(begin->second);
+    pending_semantics_node_updates_.erase(begin);
     std::vector<SemanticsNode> sub_tree_list;
     GetSubTreeList(target, sub_tree_list);
-    results.push_back(sub_tree_list);
-    pending_semantics_node_updates_.erase(begin);
+    results.push_back(std::move(sub_tree_list));
   }
 
   for (size_t i = results.size(); i > 0; i--) {
-    for (SemanticsNode node : results[i - 1]) {
+    for (const SemanticsNode& node : results[i - 1]) {
       ConvertFlutterUpdate(node, update);
     }
   }
@@ -114,6 +127,13 @@ void AccessibilityBridge::CommitUpdates() {
     FML_LOG(ERROR) << "Failed to update ui::AXTree, error: " << error;
     return;
   }
+  for (std::vector<SemanticsNode>& sub_tree_list : results) {
+    for (SemanticsNode& node : sub_tree_list) {
+      int32_t id = node.id;
+      committed_semantics_nodes_[id] = std::move(node);
+    }
+  }
+
   // Handles accessibility events as the result of the semantics update.
   for (const auto& targeted_event : event_generator_) {
     auto event_target =
@@ -190,6 +210,7 @@ void AccessibilityBridge::OnNodeDeleted(ui::AXTree* tree,
   if (id_wrapper_map_.find(node_id) != id_wrapper_map_.end()) {
     id_wrapper_map_.erase(node_id);
   }
+  committed_semantics_nodes_.erase(node_id);
 }
 
 void AccessibilityBridge::OnAtomicUpdateFinished(
@@ -215,7 +236,7 @@ std::optional<ui::AXTreeUpdate>
 AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
   std::unordered_map<int32_t, ui::AXNodeData> updates;
 
-  for (auto node_update : pending_semantics_node_updates_) {
+  for (const auto& node_update : pending_semantics_node_updates_) {
     for (int32_t child_id : node_update.second.children_in_traversal_order) {
       // Skip nodes that don't exist or have a parent in the current tree.
       ui::AXNode* child = tree_->GetFromId(child_id);
@@ -260,7 +281,7 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
       .nodes = std::vector<ui::AXNodeData>(),
   };
 
-  for (std::pair<int32_t, ui::AXNodeData> data : updates) {
+  for (auto& data : updates) {
     update.nodes.push_back(std::move(data.second));
   }
 
@@ -268,15 +289,54 @@ AccessibilityBridge::CreateRemoveReparentedNodesUpdate() {
 }
 
 // Private method.
+bool AccessibilityBridge::IsUnchanged(const SemanticsNode& node) const {
+  // The descriptions of custom actions are read from the pending custom action
+  // updates, which may have changed even if the node hasn't.
+  if (!node.custom_accessibility_actions.empty()) {
+    return false;
+  }
+  // Nodes that aren't in the tree, such as the ones removed from their old
+  // parent when reparented, must be added back.
+  if (!tree_->GetFromId(node.id)) {
+    return false;
+  }
+  auto found = committed_semantics_nodes_.find(node.id);
+  if (found == committed_semantics_nodes_.end()) {
+    return false;
+  }
+  const SemanticsNode& committed = found->second;
+  return node.flags == committed.flags && node.actions == committed.actions &&
+         node.text_selection_base == committed.text_selection_base &&
+         node.text_selection_extent == committed.text_selection_extent &&
+         node.scroll_child_count == committed.scroll_child_count &&
+         node.scroll_index == committed.scroll_index &&
+         node.scroll_position == committed.scroll_position &&
+         node.scroll_extent_max == committed.scroll_extent_max &&
+         node.scroll_extent_min == committed.scroll_extent_min &&
+         node.elevation == committed.elevation &&
+         node.thickness == committed.thickness &&
+         node.label == committed.label && node.hint == committed.hint &&
+         node.value == committed.value &&
+         node.increased_value == committed.increased_value &&
+         node.decreased_value == committed.decreased_value &&
+         node.tooltip == committed.tooltip &&
+         node.text_direction == committed.text_direction &&
+         std::memcmp(&node.rect, &committed.rect, sizeof(FlutterRect)) == 0 &&
+         std::memcmp(&node.transform, &committed.transform,
+                     sizeof(FlutterTransformation)) == 0 &&
+         node.children_in_traversal_order ==
+             committed.children_in_traversal_order;
+}
+
 void AccessibilityBridge::GetSubTreeList(const SemanticsNode& target,
                                          std::vector<SemanticsNode>& result) {
   result.push_back(target);
   for (int32_t child : target.children_in_traversal_order) {
     auto iter = pending_semantics_node_updates_.find(child);
     if (iter != pending_semantics_node_updates_.end()) {
-      SemanticsNode node = iter->second;
-      GetSubTreeList(node, result);
+      SemanticsNode node = std::move(iter->second);
       pending_semantics_node_updates_.erase(iter);
+      GetSubTreeList(node, result);
     }
   }
 }
@@ -31,6 +31,15 @@ class StandardMessageCodec : public MessageCodec<EncodableValue> {
 
   ~StandardMessageCodec();
 
+  // Encodes |message| into |buffer|, replacing its contents.
+  //
+  // Unlike EncodeMessage, this doesn't allocate a new buffer for each
+  // message; a buffer that is reused keeps its capacity, so that encoding
+  // messages of similar sizes into it stops allocating. The encoded message
+  // can then be sent with BinaryMessenger::Send.
+  void EncodeMessageInto(const EncodableValue& message,
+                         std::vector<uint8_t>* buffer) const;
+
   // Prevent copying.
   StandardMessageCodec(StandardMessageCodec const&) = delete;
   StandardMessageCodec& operator=(StandardMessageCodec const&) = delete;
@@ -0,0 +1,162 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_MESSAGE_VIEW_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_MESSAGE_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace flutter {
+
+// A non-owning view of a list of fixed-size values within an encoded message.
+//
+// The values are aligned to their size relative to the start of the message,
+// so |data| is suitably aligned as long as the message buffer is aligned to 8
+// bytes, which is the case for the messages that the engine delivers.
+template <typename T>
+class TypedDataView {
+ public:
+  TypedDataView() = default;
+
+  TypedDataView(const uint8_t* bytes, size_t size)
+      : bytes_(bytes), size_(size) {}
+
+  const T* data() const { return reinterpret_cast<const T*>(bytes_); }
+
+  // The number of values in the list.
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  const T* begin() const { return data(); }
+
+  const T* end() const { return data() + size_; }
+
+  const T& operator[](size_t index) const { return data()[index]; }
+
+ private:
+  const uint8_t* bytes_ = nullptr;
+  size_t size_ = 0;
+};
+
+// A non-owning view of a value in a message encoded with the standard codec.
+//
+// Unlike StandardMessageCodec, which decodes a message into an EncodableValue
+// tree that copies every string and typed list, a view reads the values from
+// the message buffer as they are accessed. Strings and typed lists are
+// returned as views of the buffer, which must outlive the view and anything
+// returned from it.
+//
+// Only the types of the standard codec are supported; values of the custom
+// types of serializer extensions are invalid, as are malformed values.
+class StandardMessageView {
+ public:
+  enum class Type {
+    kInvalid,
+    kNull,
+    kBool,
+    kInt32,
+    kInt64,
+    kDouble,
+    kString,
+    kUInt8List,
+    kInt32List,
+    kInt64List,
+    kFloat32List,
+    kFloat64List,
+    kList,
+    kMap,
+  };
+
+  // Creates a view of the value that |message| encodes. As with
+  // StandardMessageCodec, an empty message encodes null.
+  StandardMessageView(const uint8_t* message, size_t message_size);
+
+  Type type() const { return type_; }
+
+  bool IsValid() const { return type_ != Type::kInvalid; }
+
+  bool IsNull() const { return type_ == Type::kNull; }
+
+  // Returns the value of a bool, or false for any other type.
+  bool GetBool() const;
+
+  // Returns the value of an int32 or int64, or 0 for any other type.
+  int64_t GetInt() const;
+
+  // Returns the value of a double, or 0 for any other type.
+  double GetDouble() const;
+
+  // Returns the bytes of a string, or an empty view for any other type.
+  std::string_view GetString() const;
+
+  // Return the values of a typed list, or an empty view for any other type.
+  TypedDataView<uint8_t> GetUInt8List() const;
+  TypedDataView<int32_t> GetInt32List() const;
+  TypedDataView<int64_t> GetInt64List() const;
+  TypedDataView<float> GetFloat32List() const;
+  TypedDataView<double> GetFloat64List() const;
+
+  // Returns the number of bytes of a string, of values of a typed list, of
+  // elements of a list or of entries of a map, or 0 for any other type.
+  size_t GetLength() const { return length_; }
+
+  // Calls |visitor| with each element of a list, in order.
+  //
+  // Returns false if the value isn't a list, or if one of its elements is
+  // invalid, in which case the elements after it aren't visited.
+  bool ForEachListElement(
+      const std::function<void(const StandardMessageView& element)>& visitor)
+      const;
+
+  // Calls |visitor| with the key and value of each entry of a map, in the
+  // order they were encoded in.
+  //
+  // Returns false if the value isn't a map, or if one of its keys or values
+  // is invalid, in which case the entries after it aren't visited.
+  bool ForEachMapEntry(
+      const std::function<void(const StandardMessageView& key,
+                               const StandardMessageView& value)>& visitor)
+      const;
+
+ private:
+  // The message the value is in.
+  const uint8_t* message_ = nullptr;
+  size_t message_size_ = 0;
+  Type type_ = Type::kInvalid;
+  // Whether a bool is true.
+  bool bool_value_ = false;
+  // The offset in the message of the value, past its type, size and padding.
+  size_t payload_offset_ = 0;
+  size_t length_ = 0;
+
+  // Creates a view of the value that starts at |offset| in |message|.
+  StandardMessageView(const uint8_t* message,
+                      size_t message_size,
+                      size_t offset);
+
+  void ReadValue(size_t offset);
+
+  // Returns the offset in the message right after the value, or 0 if the
+  // value or one of its elements is invalid.
+  size_t GetEndOffset() const;
+
+  // Calls |visitor|, if any, with each of the |count| values that follow each
+  // other from the payload of the value. Returns the offset right after the
+  // last one, or 0 if one of them is invalid.
+  size_t VisitValues(
+      size_t count,
+      const std::function<void(const StandardMessageView& value)>& visitor)
+      const;
+
+  template <typename T>
+  TypedDataView<T> GetTypedData(Type type) const;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_CLIENT_WRAPPER_INCLUDE_FLUTTER_STANDARD_MESSAGE_VIEW_H_
@@ -3,9 +3,10 @@
 // found in the LICENSE file.
 
 // This file contains what would normally be standard_codec_serializer.cc,
-// standard_message_codec.cc, and standard_method_codec.cc. They are grouped
-// together to simplify use of the client wrapper, since the common case is
-// that any client that needs one of these files needs all three.
+// standard_message_codec.cc, standard_message_view.cc, and
+// standard_method_codec.cc. They are grouped together to simplify use of the
+// client wrapper, since the common case is that any client that needs one of
+// these files needs all of them.
 
 #include <cassert>
 #include <cstring>
@@ -17,6 +18,7 @@
 #include "byte_buffer_streams.h"
 #include "include/flutter/standard_codec_serializer.h"
 #include "include/flutter/standard_message_codec.h"
+#include "include/flutter/standard_message_view.h"
 #include "include/flutter/standard_method_codec.h"
 
 namespace flutter {
@@ -329,11 +331,322 @@ std::unique_ptr<std::vector<uint8_t>>
 StandardMessageCodec::EncodeMessageInternal(
     const EncodableValue& message) const {
   auto encoded = std::make_unique<std::vector<uint8_t>>();
-  ByteBufferStreamWriter stream(encoded.get());
-  serializer_->WriteValue(message, &stream);
+  EncodeMessageInto(message, encoded.get());
   return encoded;
 }
 
+void StandardMessageCodec::EncodeMessageInto(
+    const EncodableValue& message,
+    std::vector<uint8_t>* buffer) const {
+  assert(buffer);
+  buffer->clear();
+  ByteBufferStreamWriter stream(buffer);
+  serializer_->WriteValue(message, &stream);
+}
+
+// ===== standard_message_view.h =====
+
+namespace {
+
+// Reads the variable-length size at |*offset| in |message| into |size|, and
+// advances |*offset| past it. Returns false if the message is too short.
+bool ReadViewSize(const uint8_t* message,
+                  size_t message_size,
+                  size_t* offset,
+                  size_t* size) {
+  if (*offset >= message_size) {
+    return false;
+  }
+  uint8_t byte = message[(*offset)++];
+  if (byte < 254) {
+    *size = byte;
+    return true;
+  }
+  size_t byte_count = byte == 254 ? 2 : 4;
+  if (message_size - *offset < byte_count) {
+    return false;
+  }
+  if (byte == 254) {
+    uint16_t value = 0;
+    std::memcpy(&value, &message[*offset], 2);
+    *size = value;
+  } else {
+    uint32_t value = 0;
+    std::memcpy(&value, &message[*offset], 4);
+    *size = value;
+  }
+  *offset += byte_count;
+  return true;
+}
+
+// Returns |offset| rounded up to a multiple of |alignment|.
+size_t AlignViewOffset(size_t offset, size_t alignment) {
+  size_t mod = offset % alignment;
+  return mod ? offset + alignment - mod : offset;
+}
+
+// The size of the values of a typed list of type |type|, or 0 if it isn't
+// one.
+size_t TypedListElementSize(StandardMessageView::Type type) {
+  switch (type) {
+    case StandardMessageView::Type::kUInt8List:
+      return 1;
+    case StandardMessageView::Type::kInt32List:
+    case StandardMessageView::Type::kFloat32List:
+      return 4;
+    case StandardMessageView::Type::kInt64List:
+    case StandardMessageView::Type::kFloat64List:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+StandardMessageView::StandardMessageView(const uint8_t* message,
+                                         size_t message_size)
+    : message_(message), message_size_(message_size) {
+  if (!message || message_size == 0) {
+    type_ = Type::kNull;
+    return;
+  }
+  ReadValue(0);
+}
+
+StandardMessageView::StandardMessageView(const uint8_t* message,
+                                         size_t message_size,
+                                         size_t offset)
+    : message_(message), message_size_(message_size) {
+  ReadValue(offset);
+}
+
+void StandardMessageView::ReadValue(size_t offset) {
+  if (offset >= message_size_) {
+    return;
+  }
+  size_t position = offset + 1;
+  Type type = Type::kInvalid;
+  size_t fixed_size = 0;
+  switch (static_cast<EncodedType>(message_[offset])) {
+    case EncodedType::kNull:
+      type = Type::kNull;
+      break;
+    case EncodedType::kTrue:
+    case EncodedType::kFalse:
+      type = Type::kBool;
+      bool_value_ =
+          static_cast<EncodedType>(message_[offset]) == EncodedType::kTrue;
+      break;
+    case EncodedType::kInt32:
+      type = Type::kInt32;
+      fixed_size = 4;
+      break;
+    case EncodedType::kInt64:
+      type = Type::kInt64;
+      fixed_size = 8;
+      break;
+    case EncodedType::kFloat64:
+      type = Type::kDouble;
+      position = AlignViewOffset(position, 8);
+      fixed_size = 8;
+      break;
+    case EncodedType::kLargeInt:
+    case EncodedType::kString:
+      type = Type::kString;
+      break;
+    case EncodedType::kUInt8List:
+      type = Type::kUInt8List;
+      break;
+    case EncodedType::kInt32List:
+      type = Type::kInt32List;
+      break;
+    case EncodedType::kInt64List:
+      type = Type::kInt64List;
+      break;
+    case EncodedType::kFloat32List:
+      type = Type::kFloat32List;
+      break;
+    case EncodedType::kFloat64List:
+      type = Type::kFloat64List;
+      break;
+    case EncodedType::kList:
+      type = Type::kList;
+      break;
+    case EncodedType::kMap:
+      type = Type::kMap;
+      break;
+  }
+  if (type == Type::kInvalid) {
+    return;
+  }
+
+  size_t length = 0;
+  size_t element_size = TypedListElementSize(type);
+  if (type == Type::kString) {
+    element_size = 1;
+  }
+  if (element_size > 0 || type == Type::kList || type == Type::kMap) {
+    if (!ReadViewSize(message_, message_size_, &position, &length)) {
+      return;
+    }
+    if (element_size > 1) {
+      position = AlignViewOffset(position, element_size);
+    }
+  }
+  if (position > message_size_) {
+    return;
+  }
+  // The elements of lists and maps are only read as they are visited.
+  size_t available = message_size_ - position;
+  if (available < fixed_size ||
+      (element_size > 0 && length > available / element_size)) {
+    return;
+  }
+  payload_offset_ = position;
+  length_ = length;
+  type_ = type;
+}
+
+bool StandardMessageView::GetBool() const {
+  return type_ == Type::kBool && bool_value_;
+}
+
+int64_t StandardMessageView::GetInt() const {
+  if (type_ == Type::kInt32) {
+    int32_t value = 0;
+    std::memcpy(&value, &message_[payload_offset_], 4);
+    return value;
+  }
+  if (type_ == Type::kInt64) {
+    int64_t value = 0;
+    std::memcpy(&value, &message_[payload_offset_], 8);
+    return value;
+  }
+  return 0;
+}
+
+double StandardMessageView::GetDouble() const {
+  if (type_ != Type::kDouble) {
+    return 0;
+  }
+  double value = 0;
+  std::memcpy(&value, &message_[payload_offset_], 8);
+  return value;
+}
+
+std::string_view StandardMessageView::GetString() const {
+  if (type_ != Type::kString) {
+    return std::string_view();
+  }
+  return std::string_view(
+      reinterpret_cast<const char*>(&message_[payload_offset_]), length_);
+}
+
+template <typename T>
+TypedDataView<T> StandardMessageView::GetTypedData(Type type) const {
+  if (type_ != type) {
+    return TypedDataView<T>();
+  }
+  return TypedDataView<T>(&message_[payload_offset_], length_);
+}
+
+TypedDataView<uint8_t> StandardMessageView::GetUInt8List() const {
+  return GetTypedData<uint8_t>(Type::kUInt8List);
+}
+
+TypedDataView<int32_t> StandardMessageView::GetInt32List() const {
+  return GetTypedData<int32_t>(Type::kInt32List);
+}
+
+TypedDataView<int64_t> StandardMessageView::GetInt64List() const {
+  return GetTypedData<int64_t>(Type::kInt64List);
+}
+
+TypedDataView<float> StandardMessageView::GetFloat32List() const {
+  return GetTypedData<float>(Type::kFloat32List);
+}
+
+TypedDataView<double> StandardMessageView::GetFloat64List() const {
+  return GetTypedData<double>(Type::kFloat64List);
+}
+
+bool StandardMessageView::ForEachListElement(
+    const std::function<void(const StandardMessageView& element)>& visitor)
+    const {
+  if (type_ != Type::kList) {
+    return false;
+  }
+  return VisitValues(length_, visitor) != 0;
+}
+
+bool StandardMessageView::ForEachMapEntry(
+    const std::function<void(const StandardMessageView& key,
+                             const StandardMessageView& value)>& visitor)
+    const {
+  if (type_ != Type::kMap) {
+    return false;
+  }
+  // The keys and values alternate.
+  StandardMessageView key(nullptr, 0);
+  bool is_key = true;
+  auto visit = [&](const StandardMessageView& value) {
+    if (is_key) {
+      key = value;
+    } else {
+      visitor(key, value);
+    }
+    is_key = !is_key;
+  };
+  return VisitValues(length_ * 2, visit) != 0;
+}
+
+size_t StandardMessageView::VisitValues(
+    size_t count,
+    const std::function<void(const StandardMessageView& value)>& visitor)
+    const {
+  size_t offset = payload_offset_;
+  for (size_t i = 0; i < count; ++i) {
+    StandardMessageView value(message_, message_size_, offset);
+    offset = value.GetEndOffset();
+    if (offset == 0) {
+      return 0;
+    }
+    if (visitor) {
+      visitor(value);
+    }
+  }
+  return offset;
+}
+
+size_t StandardMessageView::GetEndOffset() const {
+  switch (type_) {
+    case Type::kInvalid:
+      return 0;
+    case Type::kNull:
+    case Type::kBool:
+      return payload_offset_;
+    case Type::kInt32:
+      return payload_offset_ + 4;
+    case Type::kInt64:
+    case Type::kDouble:
+      return payload_offset_ + 8;
+    case Type::kString:
+      return payload_offset_ + length_;
+    case Type::kUInt8List:
+    case Type::kInt32List:
+    case Type::kInt64List:
+    case Type::kFloat32List:
+    case Type::kFloat64List:
+      return payload_offset_ + length_ * TypedListElementSize(type_);
+    case Type::kList:
+      return VisitValues(length_, nullptr);
+    case Type::kMap:
+      return VisitValues(length_ * 2, nullptr);
+  }
+  return 0;
+}
+
 // ===== standard_method_codec.h =====
 
 // static
@@ -0,0 +1,150 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_view.h"
+
+#include <string>
+#include <vector>
+
+#include "flutter/shell/platform/common/client_wrapper/include/flutter/standard_message_codec.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+namespace {
+
+// Encodes |value| with the standard message codec.
+std::vector<uint8_t> Encode(const EncodableValue& value) {
+  return *StandardMessageCodec::GetInstance().EncodeMessage(value);
+}
+
+}  // namespace
+
+TEST(StandardMessageView, EmptyMessageIsNull) {
+  StandardMessageView view(nullptr, 0);
+  EXPECT_TRUE(view.IsValid());
+  EXPECT_TRUE(view.IsNull());
+}
+
+TEST(StandardMessageView, CanViewScalars) {
+  auto encoded = Encode(EncodableValue(true));
+  StandardMessageView bool_view(encoded.data(), encoded.size());
+  EXPECT_EQ(bool_view.type(), StandardMessageView::Type::kBool);
+  EXPECT_TRUE(bool_view.GetBool());
+
+  encoded = Encode(EncodableValue(47));
+  StandardMessageView int32_view(encoded.data(), encoded.size());
+  EXPECT_EQ(int32_view.type(), StandardMessageView::Type::kInt32);
+  EXPECT_EQ(int32_view.GetInt(), 47);
+
+  encoded = Encode(EncodableValue(int64_t{0x1234567890abcdef}));
+  StandardMessageView int64_view(encoded.data(), encoded.size());
+  EXPECT_EQ(int64_view.type(), StandardMessageView::Type::kInt64);
+  EXPECT_EQ(int64_view.GetInt(), 0x1234567890abcdef);
+
+  encoded = Encode(EncodableValue(3.14));
+  StandardMessageView double_view(encoded.data(), encoded.size());
+  EXPECT_EQ(double_view.type(), StandardMessageView::Type::kDouble);
+  EXPECT_EQ(double_view.GetDouble(), 3.14);
+  EXPECT_EQ(double_view.GetInt(), 0);
+}
+
+TEST(StandardMessageView, StringsAndTypedListsPointIntoTheMessage) {
+  auto encoded = Encode(EncodableValue("hello"));
+  StandardMessageView string_view(encoded.data(), encoded.size());
+  EXPECT_EQ(string_view.type(), StandardMessageView::Type::kString);
+  EXPECT_EQ(string_view.GetString(), "hello");
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(string_view.GetString().data()),
+            encoded.data() + 2);
+
+  std::vector<double> doubles = {3.14, 1000.0, -1.0};
+  encoded = Encode(EncodableValue(doubles));
+  StandardMessageView list_view(encoded.data(), encoded.size());
+  EXPECT_EQ(list_view.type(), StandardMessageView::Type::kFloat64List);
+  auto values = list_view.GetFloat64List();
+  ASSERT_EQ(values.size(), doubles.size());
+  EXPECT_EQ(std::vector<double>(values.begin(), values.end()), doubles);
+  // The values are aligned to 8 bytes after the type and size.
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(values.data()),
+            encoded.data() + 8);
+  EXPECT_TRUE(list_view.GetInt32List().empty());
+}
+
+TEST(StandardMessageView, CanVisitListsAndMaps) {
+  EncodableValue value(EncodableList{
+      EncodableValue(),
+      EncodableValue("hello"),
+      EncodableValue(EncodableMap{
+          {EncodableValue("a"), EncodableValue(std::vector<int32_t>{1, 2})},
+          {EncodableValue("b"), EncodableValue(EncodableList{
+                                    EncodableValue(42),
+                                })},
+      }),
+      EncodableValue(3.14),
+  });
+  auto encoded = Encode(value);
+  StandardMessageView view(encoded.data(), encoded.size());
+  ASSERT_EQ(view.type(), StandardMessageView::Type::kList);
+  EXPECT_EQ(view.GetLength(), 4u);
+
+  std::vector<StandardMessageView::Type> types;
+  std::vector<std::string> keys;
+  std::vector<int32_t> ints;
+  double last_double = 0;
+  EXPECT_TRUE(view.ForEachListElement([&](const StandardMessageView& element) {
+    types.push_back(element.type());
+    last_double = element.GetDouble();
+    element.ForEachMapEntry([&](const StandardMessageView& key,
+                                const StandardMessageView& value) {
+      keys.emplace_back(key.GetString());
+      for (int32_t i : value.GetInt32List()) {
+        ints.push_back(i);
+      }
+      value.ForEachListElement([&](const StandardMessageView& nested) {
+        ints.push_back(static_cast<int32_t>(nested.GetInt()));
+      });
+    });
+  }));
+  EXPECT_EQ(types, (std::vector<StandardMessageView::Type>{
+                       StandardMessageView::Type::kNull,
+                       StandardMessageView::Type::kString,
+                       StandardMessageView::Type::kMap,
+                       StandardMessageView::Type::kDouble,
+                   }));
+  EXPECT_EQ(keys, (std::vector<std::string>{"a", "b"}));
+  EXPECT_EQ(ints, (std::vector<int32_t>{1, 2, 42}));
+  EXPECT_EQ(last_double, 3.14);
+}
+
+TEST(StandardMessageView, TruncatedMessagesAreInvalid) {
+  auto encoded = Encode(EncodableValue(std::vector<int64_t>{1, 2, 3}));
+  StandardMessageView truncated(encoded.data(), encoded.size() - 1);
+  EXPECT_FALSE(truncated.IsValid());
+  EXPECT_TRUE(truncated.GetInt64List().empty());
+
+  encoded = Encode(EncodableValue(EncodableList{
+      EncodableValue(1),
+      EncodableValue("truncated"),
+  }));
+  StandardMessageView list(encoded.data(), encoded.size() - 1);
+  ASSERT_TRUE(list.IsValid());
+  size_t visited = 0;
+  EXPECT_FALSE(list.ForEachListElement(
+      [&visited](const StandardMessageView& element) { visited++; }));
+  EXPECT_EQ(visited, 1u);
+}
+
+TEST(StandardMessageCodec, EncodeMessageIntoReusesTheBuffer) {
+  const StandardMessageCodec& codec = StandardMessageCodec::GetInstance();
+  std::vector<uint8_t> buffer;
+  codec.EncodeMessageInto(EncodableValue(std::vector<uint8_t>(1000)), &buffer);
+  EXPECT_EQ(buffer, Encode(EncodableValue(std::vector<uint8_t>(1000))));
+  auto* data = buffer.data();
+
+  codec.EncodeMessageInto(EncodableValue("hello"), &buffer);
+  EXPECT_EQ(buffer, Encode(EncodableValue("hello")));
+  EXPECT_EQ(buffer.data(), data);
+}
+
+}  // namespace flutter
@@ -13,12 +13,90 @@
 
 namespace flutter {
 
+namespace {
+
+// A SAX handler that looks for a bool member of the top-level object, and
+// stops the parse as soon as it finds the member.
+class BoolMemberHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>,
+                                          BoolMemberHandler> {
+ public:
+  explicit BoolMemberHandler(std::string_view key) : key_(key) {}
+
+  std::optional<bool> value() const { return value_; }
+
+  // Called for every other scalar.
+  bool Default() { return !IsMember(); }
+
+  bool Bool(bool b) {
+    if (IsMember()) {
+      value_ = b;
+      return false;
+    }
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    is_key_ = depth_ == 1 && key_ == std::string_view(str, length);
+    return true;
+  }
+
+  bool StartObject() { return StartContainer(); }
+
+  bool EndObject(rapidjson::SizeType member_count) { return EndContainer(); }
+
+  bool StartArray() { return StartContainer(); }
+
+  bool EndArray(rapidjson::SizeType element_count) { return EndContainer(); }
+
+ private:
+  std::string_view key_;
+  std::optional<bool> value_;
+  // The nesting of the containers the parse is in.
+  size_t depth_ = 0;
+  // Whether the last key of the top-level object was |key_|.
+  bool is_key_ = false;
+
+  // Whether the value being parsed is the member. Any value other than a bool
+  // means there is no bool member for the key, so the parse can stop.
+  bool IsMember() const { return depth_ == 1 && is_key_; }
+
+  bool StartContainer() {
+    if (IsMember()) {
+      return false;
+    }
+    depth_++;
+    return true;
+  }
+
+  bool EndContainer() {
+    depth_--;
+    return true;
+  }
+};
+
+}  // namespace
+
 // static
 const JsonMessageCodec& JsonMessageCodec::GetInstance() {
   static JsonMessageCodec sInstance;
   return sInstance;
 }
 
+// static
+std::optional<bool> JsonMessageCodec::DecodeBoolMember(const uint8_t* message,
+                                                       size_t message_size,
+                                                       std::string_view key) {
+  if (!message) {
+    return std::nullopt;
+  }
+  BoolMemberHandler handler(key);
+  if (!ParseMessage(message, message_size, handler)) {
+    return std::nullopt;
+  }
+  return handler.value();
+}
+
 std::unique_ptr<std::vector<uint8_t>> JsonMessageCodec::EncodeMessageInternal(
     const rapidjson::Document& message) const {
   rapidjson::StringBuffer buffer;
@@ -6,6 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_JSON_MESSAGE_CODEC_H_
 
 #include <rapidjson/document.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <optional>
+#include <string_view>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/message_codec.h"
 
@@ -24,6 +29,31 @@ class JsonMessageCodec : public MessageCodec<rapidjson::Document> {
   JsonMessageCodec(JsonMessageCodec const&) = delete;
   JsonMessageCodec& operator=(JsonMessageCodec const&) = delete;
 
+  // Parses |message| with |handler|, which must implement the rapidjson SAX
+  // Handler concept, instead of decoding it into a document.
+  //
+  // The parse stops as soon as a callback of |handler| returns false, so
+  // handlers that only need a few values can skip the rest of the message.
+  // Returns false if the message isn't valid JSON up to that point.
+  template <typename Handler>
+  static bool ParseMessage(const uint8_t* message,
+                           size_t message_size,
+                           Handler& handler) {
+    rapidjson::Reader reader;
+    rapidjson::MemoryStream stream(reinterpret_cast<const char*>(message),
+                                   message_size);
+    rapidjson::ParseResult result = reader.Parse(stream, handler);
+    return !result.IsError() ||
+           result.Code() == rapidjson::kParseErrorTermination;
+  }
+
+  // Returns the bool member |key| of the object that |message| encodes,
+  // without decoding the rest of the message into a document, or nullopt if
+  // the message isn't an object with a bool member named |key|.
+  static std::optional<bool> DecodeBoolMember(const uint8_t* message,
+                                              size_t message_size,
+                                              std::string_view key);
+
  protected:
   // Instances should be obtained via GetInstance.
   JsonMessageCodec() = default;
@@ -6,6 +6,7 @@
 
 #include <limits>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -44,4 +45,56 @@ TEST(JsonMessageCodec, EncodeDecode) {
   CheckEncodeDecode(array);
 }
 
+namespace {
+
+std::optional<bool> DecodeBoolMember(const std::string& json,
+                                     std::string_view key) {
+  return JsonMessageCodec::DecodeBoolMember(
+      reinterpret_cast<const uint8_t*>(json.data()), json.size(), key);
+}
+
+// Counts the values of a message, and stops after |limit| of them.
+struct CountingHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, CountingHandler> {
+  size_t limit = 0;
+  size_t count = 0;
+
+  bool Default() { return ++count < limit; }
+};
+
+}  // namespace
+
+TEST(JsonMessageCodec, DecodesBoolMember) {
+  EXPECT_EQ(DecodeBoolMember(R"({"handled":true})", "handled"), true);
+  EXPECT_EQ(DecodeBoolMember(R"({"handled":false})", "handled"), false);
+  // Nested members with the same key are skipped.
+  EXPECT_EQ(DecodeBoolMember(
+                R"({"a":{"handled":false},"b":[1,"x"],"handled":true})",
+                "handled"),
+            true);
+  EXPECT_EQ(DecodeBoolMember(R"({"a":{"handled":false}})", "handled"),
+            std::nullopt);
+  EXPECT_EQ(DecodeBoolMember(R"({"handled":1})", "handled"), std::nullopt);
+  EXPECT_EQ(DecodeBoolMember(R"([true])", "handled"), std::nullopt);
+  EXPECT_EQ(DecodeBoolMember(R"({"handled":)", "handled"), std::nullopt);
+  // The rest of the message isn't parsed once the member is found.
+  EXPECT_EQ(DecodeBoolMember(R"({"handled":true,)", "handled"), true);
+}
+
+TEST(JsonMessageCodec, ParseMessageStopsWhenTheHandlerDoes) {
+  std::string json = R"([1,2,3,4])";
+  CountingHandler handler;
+  handler.limit = 2;
+  EXPECT_TRUE(JsonMessageCodec::ParseMessage(
+      reinterpret_cast<const uint8_t*>(json.data()), json.size(), handler));
+  EXPECT_EQ(handler.count, 2u);
+
+  std::string invalid = R"([1,)";
+  CountingHandler invalid_handler;
+  invalid_handler.limit = 10;
+  EXPECT_FALSE(JsonMessageCodec::ParseMessage(
+      reinterpret_cast<const uint8_t*>(invalid.data()), invalid.size(),
+      invalid_handler));
+}
+
 }  // namespace flutter
@@ -22,6 +22,9 @@ bool IsTrailingSurrogate(char32_t code_point) {
   return (code_point & 0xFFFFFC00) == 0xDC00;
 }
 
+// The least number of code units the gap of the text grows by.
+constexpr size_t kMinGapLength = 64;
+
 }  // namespace
 
 TextInputModel::TextInputModel() = default;
@@ -32,6 +35,9 @@ bool TextInputModel::SetText(const std::string& text,
                              const TextRange& selection,
                              const TextRange& composing_range) {
   text_ = fml::Utf8ToUtf16(text);
+  gap_start_ = text_.length();
+  gap_length_ = 0;
+  utf8_text_ = text;
   if (!text_range().Contains(selection) ||
       !text_range().Contains(composing_range)) {
     return false;
@@ -75,7 +81,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text) {
     return;
   }
   DeleteSelected();
-  text_.replace(composing_range_.start(), composing_range_.length(), text);
+  Replace(composing_range_.start(), composing_range_.length(), text);
   composing_range_.set_end(composing_range_.start() + text.length());
   selection_ = TextRange(composing_range_.end());
 }
@@ -103,7 +109,7 @@ bool TextInputModel::DeleteSelected() {
     return false;
   }
   size_t start = selection_.start();
-  text_.erase(start, selection_.length());
+  Replace(start, selection_.length(), u"");
   selection_ = TextRange(start);
   if (composing_) {
     // This occurs only immediately after composing has begun with a selection.
@@ -130,12 +136,12 @@ void TextInputModel::AddText(const std::u16string& text) {
   DeleteSelected();
   if (composing_) {
     // Delete the current composing text, set the cursor to composing start.
-    text_.erase(composing_range_.start(), composing_range_.length());
+    Replace(composing_range_.start(), composing_range_.length(), u"");
     selection_ = TextRange(composing_range_.start());
     composing_range_.set_end(composing_range_.start() + text.length());
   }
   size_t position = selection_.position();
-  text_.insert(position, text);
+  Replace(position, 0, text);
   selection_ = TextRange(position + text.length());
 }
 
@@ -150,8 +156,8 @@ bool TextInputModel::Backspace() {
   // There is no selection. Delete the preceding codepoint.
   size_t position = selection_.position();
   if (position != editable_range().start()) {
-    int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
-    text_.erase(position - count, count);
+    int count = IsTrailingSurrogate(at(position - 1)) ? 2 : 1;
+    Replace(position - count, count, u"");
     selection_ = TextRange(position - count);
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
@@ -168,8 +174,8 @@ bool TextInputModel::Delete() {
   // There is no selection. Delete the preceding codepoint.
   size_t position = selection_.position();
   if (position < editable_range().end()) {
-    int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
-    text_.erase(position, count);
+    int count = IsLeadingSurrogate(at(position)) ? 2 : 1;
+    Replace(position, count, u"");
     if (composing_) {
       composing_range_.set_end(composing_range_.end() - count);
     }
@@ -189,17 +195,17 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
         count = i;
         break;
       }
-      start -= IsTrailingSurrogate(text_.at(start - 1)) ? 2 : 1;
+      start -= IsTrailingSurrogate(at(start - 1)) ? 2 : 1;
     }
   } else {
     for (int i = 0; i < offset_from_cursor && start != max_pos; i++) {
-      start += IsLeadingSurrogate(text_.at(start)) ? 2 : 1;
+      start += IsLeadingSurrogate(at(start)) ? 2 : 1;
     }
   }
 
   auto end = start;
   for (int i = 0; i < count && end != max_pos; i++) {
-    end += IsLeadingSurrogate(text_.at(start)) ? 2 : 1;
+    end += IsLeadingSurrogate(at(start)) ? 2 : 1;
   }
 
   if (start == end) {
@@ -207,7 +213,7 @@ bool TextInputModel::DeleteSurrounding(int offset_from_cursor, int count) {
   }
 
   auto deleted_length = end - start;
-  text_.erase(start, deleted_length);
+  Replace(start, deleted_length, u"");
 
   // Cursor moves only if deleted area is before it.
   selection_ = TextRange(offset_from_cursor <= 0 ? start : selection_.start());
@@ -264,7 +270,7 @@ bool TextInputModel::MoveCursorForward() {
   // Otherwise, move the cursor forward.
   size_t position = selection_.position();
   if (position != editable_range().end()) {
-    int count = IsLeadingSurrogate(text_.at(position)) ? 2 : 1;
+    int count = IsLeadingSurrogate(at(position)) ? 2 : 1;
     selection_ = TextRange(position + count);
     return true;
   }
@@ -280,22 +286,75 @@ bool TextInputModel::MoveCursorBack() {
   // Otherwise, move the cursor backward.
   size_t position = selection_.position();
   if (position != editable_range().start()) {
-    int count = IsTrailingSurrogate(text_.at(position - 1)) ? 2 : 1;
+    int count = IsTrailingSurrogate(at(position - 1)) ? 2 : 1;
     selection_ = TextRange(position - count);
     return true;
   }
   return false;
 }
 
-std::string TextInputModel::GetText() const {
-  return fml::Utf16ToUtf8(text_);
+const std::string& TextInputModel::GetText() const {
+  if (!utf8_text_) {
+    std::u16string text;
+    text.reserve(length());
+    text.append(text_, 0, gap_start_);
+    text.append(text_, gap_start_ + gap_length_, std::u16string::npos);
+    utf8_text_ = fml::Utf16ToUtf8(text);
+  }
+  return *utf8_text_;
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  return fml::Utf16ToUtf8(leading_text).size();
+  // Measure the UTF-8 length of the current text up to the selection extent.
+  size_t extent = selection_.extent();
+  int offset = 0;
+  for (size_t i = 0; i < extent; i++) {
+    char16_t code_unit = at(i);
+    if (code_unit < 0x80) {
+      offset += 1;
+    } else if (code_unit < 0x800) {
+      offset += 2;
+    } else if (IsLeadingSurrogate(code_unit) && i + 1 < extent &&
+               IsTrailingSurrogate(at(i + 1))) {
+      offset += 4;
+      i++;
+    } else {
+      offset += 3;
+    }
+  }
+  return offset;
+}
+
+void TextInputModel::Replace(size_t start,
+                             size_t length,
+                             const std::u16string& text) {
+  utf8_text_.reset();
+  MoveGap(start);
+  // The replaced text is right after the gap.
+  gap_length_ += length;
+  if (text.length() > gap_length_) {
+    // Grow the gap in proportion to the text, so that typing doesn't have to
+    // grow it again for a while.
+    size_t growth = std::max({text.length() - gap_length_, kMinGapLength,
+                              text_.length() / 8});
+    text_.insert(gap_start_, growth, u'\0');
+    gap_length_ += growth;
+  }
+  std::copy(text.begin(), text.end(), text_.begin() + gap_start_);
+  gap_start_ += text.length();
+  gap_length_ -= text.length();
+}
+
+void TextInputModel::MoveGap(size_t position) {
+  if (position < gap_start_) {
+    std::copy_backward(text_.begin() + position, text_.begin() + gap_start_,
+                       text_.begin() + gap_start_ + gap_length_);
+  } else if (position > gap_start_) {
+    std::copy(text_.begin() + gap_start_ + gap_length_,
+              text_.begin() + position + gap_length_,
+              text_.begin() + gap_start_);
+  }
+  gap_start_ = position;
 }
 
 }  // namespace flutter
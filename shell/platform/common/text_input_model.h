@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_COMMON_TEXT_INPUT_MODEL_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "flutter/shell/platform/common/text_range.h"
@@ -183,14 +184,18 @@ class TextInputModel {
   bool SelectToEnd();
 
   // Gets the current text as UTF-8.
-  std::string GetText() const;
+  //
+  // The conversion is kept until the text changes, so getting the text again
+  // without editing it doesn't convert or copy it again. The returned
+  // reference is only valid until the text changes.
+  const std::string& GetText() const;
 
   // Gets the cursor position as a byte offset in UTF-8 string returned from
   // GetText().
   int GetCursorOffset() const;
 
   // Returns a range covering the entire text.
-  TextRange text_range() const { return TextRange(0, text_.length()); }
+  TextRange text_range() const { return TextRange(0, length()); }
 
   // The current selection.
   TextRange selection() const { return selection_; }
@@ -218,7 +223,30 @@ class TextInputModel {
     return composing_ ? composing_range_ : text_range();
   }
 
+  // The number of UTF-16 code units of the text.
+  size_t length() const { return text_.length() - gap_length_; }
+
+  // Returns the UTF-16 code unit at |index| of the text.
+  char16_t at(size_t index) const {
+    return text_[index < gap_start_ ? index : index + gap_length_];
+  }
+
+  // Replaces |length| code units of the text from |start| with |text|.
+  void Replace(size_t start, size_t length, const std::u16string& text);
+
+  // Moves the gap of |text_| to |position| of the text.
+  void MoveGap(size_t position);
+
+  // The text, stored as a gap buffer: the text before the gap, |gap_length_|
+  // unused code units, and the text after the gap. The gap is moved to where
+  // the text is edited, so that typing and deleting at the cursor only moves
+  // the code units between the cursor and the previous edit instead of all of
+  // the text after the cursor.
   std::u16string text_;
+  size_t gap_start_ = 0;
+  size_t gap_length_ = 0;
+  // The text as UTF-8, if it was converted since the text last changed.
+  mutable std::optional<std::string> utf8_text_;
   TextRange selection_ = TextRange(0);
   TextRange composing_range_ = TextRange(0);
   bool composing_ = false;
@@ -1718,4 +1718,48 @@ TEST(TextInputModel, GetCursorOffsetReverseSelection) {
   EXPECT_EQ(model->GetCursorOffset(), 1);
 }
 
+TEST(TextInputModel, EditsAtDifferentPositions) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDE");
+  EXPECT_TRUE(model->SetSelection(TextRange(5)));
+  model->AddText("FG");
+  EXPECT_TRUE(model->SetSelection(TextRange(1)));
+  model->AddText("xy");
+  EXPECT_TRUE(model->Delete());
+  EXPECT_TRUE(model->SetSelection(TextRange(8)));
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_TRUE(model->SetSelection(TextRange(0)));
+  model->AddText(std::string(200, 'z'));
+  EXPECT_TRUE(model->SetSelection(TextRange(200, 202)));
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_EQ(model->GetText(), std::string(200, 'z') + "yCDEF");
+  EXPECT_EQ(model->GetCursorOffset(), 200);
+}
+
+TEST(TextInputModel, SurrogatePairAcrossEdits) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("A😄B");
+  EXPECT_TRUE(model->SetSelection(TextRange(2)));
+  // Split the pair by editing between its surrogates, then join it again.
+  model->AddText("x");
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_EQ(model->GetText(), "A😄B");
+  EXPECT_TRUE(model->SetSelection(TextRange(3)));
+  EXPECT_EQ(model->GetCursorOffset(), 5);
+  EXPECT_TRUE(model->Backspace());
+  EXPECT_EQ(model->GetText(), "AB");
+  EXPECT_EQ(model->GetCursorOffset(), 1);
+}
+
+TEST(TextInputModel, GetTextIsKeptUntilTheTextChanges) {
+  auto model = std::make_unique<TextInputModel>();
+  model->SetText("ABCDE");
+  const char* text = model->GetText().data();
+  EXPECT_TRUE(model->SetSelection(TextRange(1, 3)));
+  EXPECT_TRUE(model->MoveCursorForward());
+  EXPECT_EQ(model->GetText().data(), text);
+  model->AddText("x");
+  EXPECT_EQ(model->GetText(), "ABCxDE");
+}
+
 }  // namespace flutter
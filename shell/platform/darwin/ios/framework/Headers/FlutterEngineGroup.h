@@ -105,6 +105,32 @@ FLUTTER_DARWIN_EXPORT
  * @see FlutterEngineGroupOptions
  */
 - (FlutterEngine*)makeEngineWithOptions:(nullable FlutterEngineGroupOptions*)options;
+
+/**
+ * Keeps `count` running `FlutterEngine`s created with `options` in this group, to be handed out by
+ * `takePrewarmedEngine` without the latency of creating them.
+ *
+ * The engines are created one at a time on the main thread, in the default run loop mode so that
+ * they aren't created while the user is scrolling. As the entrypoint of an engine can't be changed
+ * once it is running, `options` usually specify a standby entrypoint that waits to be told what to
+ * show, for example over a platform channel.
+ *
+ * Calling this again replaces the options for engines that are prewarmed from then on, and releases
+ * the prewarmed engines that exceed the new `count`. A `count` of 0 stops prewarming.
+ *
+ * @param options Options that control how the prewarmed FlutterEngines should be created.
+ * @param count The number of FlutterEngines to keep prewarmed.
+ */
+- (void)prewarmEnginesWithOptions:(nullable FlutterEngineGroupOptions*)options
+                            count:(NSUInteger)count;
+
+/**
+ * Hands out a running `FlutterEngine` created with the options of
+ * `prewarmEnginesWithOptions:count:`. If no engine has been prewarmed, one is created
+ * synchronously. In either case, a replacement is prewarmed no sooner than a second later, so that
+ * it doesn't jank the first frames of the screen the taken engine is shown in.
+ */
+- (FlutterEngine*)takePrewarmedEngine;
 @end
 
 NS_ASSUME_NONNULL_END
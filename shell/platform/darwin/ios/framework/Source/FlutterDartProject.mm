@@ -213,6 +213,14 @@ flutter::Settings FLTDefaultSettingsForBundle(NSBundle* bundle) {
     settings.enable_impeller = enableImpeller.boolValue;
   }
 
+  // Whether to dispatch pointer events once per frame, resampled to the frame.
+  NSNumber* enablePointerResampling =
+      [mainBundle objectForInfoDictionaryKey:@"FLTEnablePointerResampling"];
+  // Change the default only if the option is present.
+  if (enablePointerResampling != nil) {
+    settings.enable_pointer_resampling = enablePointerResampling.boolValue;
+  }
+
   NSNumber* enableTraceSystrace = [mainBundle objectForInfoDictionaryKey:@"FLTTraceSystrace"];
   // Change the default only if the option is present.
   if (enableTraceSystrace != nil) {
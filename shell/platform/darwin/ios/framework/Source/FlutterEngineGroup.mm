@@ -5,6 +5,9 @@
 #import "flutter/shell/platform/darwin/ios/framework/Headers/FlutterEngineGroup.h"
 #import "flutter/shell/platform/darwin/ios/framework/Source/FlutterEngine_Internal.h"
 
+// How long after an engine is taken its replacement is prewarmed at the earliest.
+static const NSTimeInterval kPrewarmReplacementDelay = 1.0;
+
 @implementation FlutterEngineGroupOptions
 
 - (void)dealloc {
@@ -21,10 +24,15 @@
 @property(nonatomic, copy) NSString* name;
 @property(nonatomic, retain) NSMutableArray<NSValue*>* engines;
 @property(nonatomic, retain) FlutterDartProject* project;
+@property(nonatomic, retain) FlutterEngineGroupOptions* prewarmOptions;
+@property(nonatomic, retain) NSMutableArray<FlutterEngine*>* prewarmedEngines;
 @end
 
 @implementation FlutterEngineGroup {
   int _enginesCreatedCount;
+  NSUInteger _prewarmCount;
+  BOOL _prewarmPending;
+  CFAbsoluteTime _earliestPrewarmTime;
 }
 
 - (instancetype)initWithName:(NSString*)name project:(nullable FlutterDartProject*)project {
@@ -33,6 +41,7 @@
     _name = [name copy];
     _engines = [[NSMutableArray<NSValue*> alloc] init];
     _project = [project retain];
+    _prewarmedEngines = [[NSMutableArray<FlutterEngine*> alloc] init];
   }
   return self;
 }
@@ -43,6 +52,8 @@
   [_name release];
   [_engines release];
   [_project release];
+  [_prewarmOptions release];
+  [_prewarmedEngines release];
   [super dealloc];
 }
 
@@ -92,6 +103,55 @@
   return engine;
 }
 
+- (void)prewarmEnginesWithOptions:(nullable FlutterEngineGroupOptions*)options
+                            count:(NSUInteger)count {
+  self.prewarmOptions = options;
+  _prewarmCount = count;
+  while (self.prewarmedEngines.count > count) {
+    [self.prewarmedEngines removeLastObject];
+  }
+  [self schedulePrewarm];
+}
+
+- (FlutterEngine*)takePrewarmedEngine {
+  FlutterEngine* engine;
+  if (self.prewarmedEngines.count == 0) {
+    engine = [self makeEngineWithOptions:self.prewarmOptions];
+  } else {
+    engine = [[self.prewarmedEngines[0] retain] autorelease];
+    [self.prewarmedEngines removeObjectAtIndex:0];
+  }
+  _earliestPrewarmTime = CFAbsoluteTimeGetCurrent() + kPrewarmReplacementDelay;
+  [self schedulePrewarm];
+  return engine;
+}
+
+- (void)schedulePrewarm {
+  if (_prewarmPending || self.prewarmedEngines.count >= _prewarmCount) {
+    return;
+  }
+  _prewarmPending = YES;
+  NSTimeInterval delay = MAX(0, _earliestPrewarmTime - CFAbsoluteTimeGetCurrent());
+  [self performSelector:@selector(prewarm)
+             withObject:nil
+             afterDelay:delay
+                inModes:@[ NSDefaultRunLoopMode ]];
+}
+
+- (void)prewarm {
+  _prewarmPending = NO;
+  if (CFAbsoluteTimeGetCurrent() < _earliestPrewarmTime) {
+    // An engine was taken since this prewarm was scheduled.
+    [self schedulePrewarm];
+    return;
+  }
+  if (self.prewarmedEngines.count >= _prewarmCount) {
+    return;
+  }
+  [self.prewarmedEngines addObject:[self makeEngineWithOptions:self.prewarmOptions]];
+  [self schedulePrewarm];
+}
+
 - (FlutterEngine*)makeEngine {
   NSString* engineName = [NSString stringWithFormat:@"%@.%d", self.name, ++_enginesCreatedCount];
   FlutterEngine* result = [[FlutterEngine alloc] initWithName:engineName project:self.project];
@@ -11,6 +11,7 @@
 FLUTTER_ASSERT_ARC
 
 @interface FlutterEngineGroup ()
+@property(nonatomic, retain) NSMutableArray<FlutterEngine*>* prewarmedEngines;
 - (FlutterEngine*)makeEngine;
 @end
 
@@ -36,6 +37,24 @@ FLUTTER_ASSERT_ARC
   XCTAssertEqual(spawner.isGpuDisabled, spawnee.isGpuDisabled);
 }
 
+- (void)testPrewarm {
+  FlutterEngineGroup* group = [[FlutterEngineGroup alloc] initWithName:@"foo" project:nil];
+  [group prewarmEnginesWithOptions:nil count:1];
+  XCTAssertEqual(group.prewarmedEngines.count, 0u);
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+  XCTAssertEqual(group.prewarmedEngines.count, 1u);
+
+  FlutterEngine* prewarmed = group.prewarmedEngines[0];
+  FlutterEngine* taken = [group takePrewarmedEngine];
+  XCTAssertEqual(taken, prewarmed);
+  // The replacement isn't prewarmed right after the engine is taken.
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+  XCTAssertEqual(group.prewarmedEngines.count, 0u);
+  [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1.5]];
+  XCTAssertEqual(group.prewarmedEngines.count, 1u);
+  XCTAssertEqual(&taken.threadHost, &group.prewarmedEngines[0].threadHost);
+}
+
 - (void)testDeleteLastEngine {
   FlutterEngineGroup* group = [[FlutterEngineGroup alloc] initWithName:@"foo" project:nil];
   @autoreleasepool {
@@ -24,6 +24,7 @@ class FakeDelegate : public PlatformView::Delegate {
   void OnPlatformViewDestroyed() override {}
   void OnPlatformViewScheduleFrame() override {}
   void OnPlatformViewSetNextFrameCallback(const fml::closure& closure) override {}
+  void OnPlatformViewNotifyMemoryPressure(MemoryPressureLevel level) override {}
   void OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) override {}
   const flutter::Settings& OnPlatformViewGetSettings() const override { return settings_; }
   void OnPlatformViewDispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) override {}
@@ -45,6 +46,10 @@ class FakeDelegate : public PlatformView::Delegate {
   void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                     const std::string error_message,
                                     bool transient) override {}
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id,
+                                   std::unique_ptr<const fml::Mapping> snapshot_data,
+                                   std::unique_ptr<const fml::Mapping> snapshot_instructions) override {
+  }
   void UpdateAssetResolverByType(std::unique_ptr<AssetResolver> updated_asset_resolver,
                                  AssetResolver::AssetResolverType type) override {}
 
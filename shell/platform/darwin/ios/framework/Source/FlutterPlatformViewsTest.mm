@@ -93,6 +93,7 @@ class FlutterPlatformViewsTestMockPlatformViewDelegate : public PlatformView::De
   void OnPlatformViewDestroyed() override {}
   void OnPlatformViewScheduleFrame() override {}
   void OnPlatformViewSetNextFrameCallback(const fml::closure& closure) override {}
+  void OnPlatformViewNotifyMemoryPressure(MemoryPressureLevel level) override {}
   void OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) override {}
   const flutter::Settings& OnPlatformViewGetSettings() const override { return settings_; }
   void OnPlatformViewDispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) override {}
@@ -114,6 +115,10 @@ class FlutterPlatformViewsTestMockPlatformViewDelegate : public PlatformView::De
   void LoadDartDeferredLibraryError(intptr_t loading_unit_id,
                                     const std::string error_message,
                                     bool transient) override {}
+  void PrefetchDartDeferredLibrary(intptr_t loading_unit_id,
+                                   std::unique_ptr<const fml::Mapping> snapshot_data,
+                                   std::unique_ptr<const fml::Mapping> snapshot_instructions) override {
+  }
   void UpdateAssetResolverByType(std::unique_ptr<flutter::AssetResolver> updated_asset_resolver,
                                  flutter::AssetResolver::AssetResolverType type) override {}
 
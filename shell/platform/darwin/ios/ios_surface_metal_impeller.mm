@@ -116,6 +116,10 @@ std::unique_ptr<Surface> IOSSurfaceMetalImpeller::CreateGPUSurface(GrDirectConte
 // |GPUSurfaceMetalDelegate|
 GPUCAMetalLayerHandle IOSSurfaceMetalImpeller::GetCAMetalLayer(const SkISize& frame_info) const {
   CAMetalLayer* layer = layer_.get();
+  // The damaged regions of a frame are blitted into the drawable so that the
+  // rest of its contents can be retained.
+  layer.framebufferOnly = NO;
+
   const auto drawable_size = CGSizeMake(frame_info.width(), frame_info.height());
   if (!CGSizeEqualToSize(drawable_size, layer.drawableSize)) {
     layer.drawableSize = drawable_size;
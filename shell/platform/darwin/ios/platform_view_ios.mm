@@ -126,6 +126,9 @@ void PlatformViewIOS::attachView() {
 }
 
 PointerDataDispatcherMaker PlatformViewIOS::GetDispatcherMaker() {
+  if (delegate_.OnPlatformViewGetSettings().enable_pointer_resampling) {
+    return PlatformView::GetDispatcherMaker();
+  }
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<SmoothPointerDataDispatcher>(delegate);
   };
@@ -46,11 +46,13 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/fml/trace_ring_buffer.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
+#include "flutter/shell/platform/embedder/embedder_headless_frame_ring.h"
 #include "flutter/shell/platform/embedder/embedder_platform_message_response.h"
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "flutter/shell/platform/embedder/embedder_struct_macros.h"
@@ -271,18 +273,25 @@ InferOpenGLPlatformViewCreationCallback(
     if (present) {
       return present(user_data);
     } else {
-      // Format the frame and buffer damages accordingly. Note that, since the
-      // current compute damage algorithm only returns one rectangle for damage
-      // we are assuming the number of rectangles provided in frame and buffer
-      // damage are always 1. Once the function that computes damage implements
-      // support for multiple damage rectangles, GLPresentInfo should also
-      // contain the number of damage rectangles.
-      const size_t num_rects = 1;
-
-      std::array<FlutterRect, num_rects> frame_damage_rect = {
-          SkIRectToFlutterRect(*(gl_present_info.frame_damage))};
-      std::array<FlutterRect, num_rects> buffer_damage_rect = {
-          SkIRectToFlutterRect(*(gl_present_info.buffer_damage))};
+      // Format the frame and buffer damages accordingly. The damage is split
+      // into multiple rects only if the embedder allowed it, otherwise it is
+      // the single rect of the GLPresentInfo.
+      auto to_flutter_rects = [](const std::optional<SkIRect>& damage,
+                                 const std::vector<SkIRect>& damage_rects) {
+        std::vector<FlutterRect> rects;
+        if (!damage_rects.empty()) {
+          for (const SkIRect& rect : damage_rects) {
+            rects.push_back(SkIRectToFlutterRect(rect));
+          }
+        } else {
+          rects.push_back(SkIRectToFlutterRect(*damage));
+        }
+        return rects;
+      };
+      std::vector<FlutterRect> frame_damage_rect = to_flutter_rects(
+          gl_present_info.frame_damage, gl_present_info.frame_damage_rects);
+      std::vector<FlutterRect> buffer_damage_rect = to_flutter_rects(
+          gl_present_info.buffer_damage, gl_present_info.buffer_damage_rects);
 
       FlutterDamage frame_damage{
           .struct_size = sizeof(FlutterDamage),
@@ -612,32 +621,70 @@ InferSoftwarePlatformViewCreationCallback(
     const flutter::PlatformViewEmbedder::PlatformDispatchTable&
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+        external_view_embedder,
+    const std::shared_ptr<flutter::EmbedderHeadlessFrameRing>&
+        headless_frame_ring) {
   if (config->type != kSoftware) {
     return nullptr;
   }
 
-  auto software_present_backing_store =
-      [ptr = config->software.surface_present_callback, user_data](
-          const void* allocation, size_t row_bytes, size_t height) -> bool {
-    return ptr(user_data, allocation, row_bytes, height);
-  };
+  std::function<bool(const void*, size_t, size_t)>
+      software_present_backing_store = nullptr;
+  if (auto ptr = SAFE_ACCESS(&config->software, surface_present_callback,
+                             nullptr)) {
+    software_present_backing_store =
+        [ptr, user_data](const void* allocation, size_t row_bytes,
+                         size_t height) -> bool {
+      return ptr(user_data, allocation, row_bytes, height);
+    };
+  }
+
+  std::function<bool(const void*, size_t, size_t, size_t, size_t)>
+      software_present_backing_store_rows = nullptr;
+  if (auto rows_ptr = SAFE_ACCESS(&config->software,
+                                  surface_present_rows_callback, nullptr)) {
+    software_present_backing_store_rows =
+        [rows_ptr, user_data](const void* allocation, size_t row_bytes,
+                              size_t height, size_t first_row,
+                              size_t row_count) -> bool {
+      return rows_ptr(user_data, allocation, row_bytes, height, first_row,
+                      row_count);
+    };
+  }
+
+  std::function<bool(const void*, size_t, size_t, fml::TimePoint)>
+      software_stream_backing_store = nullptr;
+  if (headless_frame_ring) {
+    software_stream_backing_store =
+        [headless_frame_ring](const void* allocation, size_t row_bytes,
+                              size_t height,
+                              fml::TimePoint frame_target_time) -> bool {
+      return headless_frame_ring->PresentFrame(allocation, row_bytes, height,
+                                               frame_target_time);
+    };
+  }
 
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,       // required unless headless
+          software_present_backing_store_rows,  // optional
+          software_stream_backing_store,        // optional
       };
 
+  const size_t raster_thread_count =
+      SAFE_ACCESS(&config->software, raster_thread_count, 0u);
+
   return fml::MakeCopyable(
-      [software_dispatch_table, platform_dispatch_table,
+      [software_dispatch_table, platform_dispatch_table, raster_thread_count,
        external_view_embedder =
            std::move(external_view_embedder)](flutter::Shell& shell) mutable {
         return std::make_unique<flutter::PlatformViewEmbedder>(
-            shell,                             // delegate
-            shell.GetTaskRunners(),            // task runners
-            software_dispatch_table,           // software dispatch table
-            platform_dispatch_table,           // platform dispatch table
-            std::move(external_view_embedder)  // external view embedder
+            shell,                              // delegate
+            shell.GetTaskRunners(),             // task runners
+            software_dispatch_table,            // software dispatch table
+            platform_dispatch_table,            // platform dispatch table
+            std::move(external_view_embedder),  // external view embedder
+            raster_thread_count                 // raster thread count
         );
       });
 }
@@ -649,7 +696,9 @@ InferPlatformViewCreationCallback(
     const flutter::PlatformViewEmbedder::PlatformDispatchTable&
         platform_dispatch_table,
     std::unique_ptr<flutter::EmbedderExternalViewEmbedder>
-        external_view_embedder) {
+        external_view_embedder,
+    const std::shared_ptr<flutter::EmbedderHeadlessFrameRing>&
+        headless_frame_ring) {
   if (config == nullptr) {
     return nullptr;
   }
@@ -662,7 +711,7 @@ InferPlatformViewCreationCallback(
     case kSoftware:
       return InferSoftwarePlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
-          std::move(external_view_embedder));
+          std::move(external_view_embedder), headless_frame_ring);
     case kMetal:
       return InferMetalPlatformViewCreationCallback(
           config, user_data, platform_dispatch_table,
@@ -1046,6 +1095,16 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
       SAFE_ACCESS(compositor, present_layers_callback, nullptr);
   bool avoid_backing_store_cache =
       SAFE_ACCESS(compositor, avoid_backing_store_cache, false);
+  bool backing_stores_preserve_contents =
+      SAFE_ACCESS(compositor, backing_stores_preserve_contents, false);
+  size_t backing_store_size_granularity =
+      SAFE_ACCESS(compositor, backing_store_size_granularity, 0u);
+  size_t backing_store_cache_pixel_budget =
+      SAFE_ACCESS(compositor, backing_store_cache_pixel_budget, 0u);
+  bool flatten_platform_view_mutations =
+      SAFE_ACCESS(compositor, flatten_platform_view_mutations, false);
+  bool present_layers_on_platform_thread =
+      SAFE_ACCESS(compositor, present_layers_on_platform_thread, false);
 
   // Make sure the required callbacks are present
   if (!c_create_callback || !c_collect_callback || !c_present_callback) {
@@ -1071,10 +1130,16 @@ InferExternalViewEmbedderFromArgs(const FlutterCompositor* compositor) {
             user_data);
       };
 
-  return {std::make_unique<flutter::EmbedderExternalViewEmbedder>(
-              avoid_backing_store_cache, create_render_target_callback,
-              present_callback),
-          false};
+  auto external_view_embedder =
+      std::make_unique<flutter::EmbedderExternalViewEmbedder>(
+          avoid_backing_store_cache, backing_stores_preserve_contents,
+          backing_store_size_granularity, backing_store_cache_pixel_budget,
+          create_render_target_callback, present_callback);
+  external_view_embedder->SetFlattenPlatformViewMutations(
+      flatten_platform_view_mutations);
+  external_view_embedder->SetPresentLayersOnPlatformThread(
+      present_layers_on_platform_thread);
+  return {std::move(external_view_embedder), false};
 }
 
 struct _FlutterPlatformMessageResponseHandle {
@@ -1499,7 +1564,50 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
                         "should be set null.";
   }
 
-  if (!IsRendererValid(config)) {
+  // Headless engines stream their frames instead of presenting them, so the
+  // software renderer needs no present callback.
+  std::shared_ptr<flutter::EmbedderHeadlessFrameRing> headless_frame_ring;
+  if (SAFE_ACCESS(args, headless_config, nullptr) != nullptr) {
+    const FlutterHeadlessConfig* headless_config = args->headless_config;
+    if (config == nullptr || config->type != kSoftware) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "Only the software renderer can run the engine headless.");
+    }
+    if (SAFE_ACCESS(args, compositor, nullptr) != nullptr) {
+      return LOG_EMBEDDER_ERROR(
+          kInvalidArguments,
+          "A compositor can't be used with an engine that runs headless.");
+    }
+    const double frame_rate = SAFE_ACCESS(headless_config, frame_rate, 0.0);
+    if (!(frame_rate > 0.0)) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "The headless frame rate must be positive.");
+    }
+    auto frame_callback =
+        SAFE_ACCESS(headless_config, frame_callback, nullptr);
+    if (frame_callback == nullptr) {
+      return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                "The headless frame callback was missing.");
+    }
+    headless_frame_ring = std::make_shared<flutter::EmbedderHeadlessFrameRing>(
+        SAFE_ACCESS(headless_config, target_count, 0u),
+        fml::TimeDelta::FromSecondsF(1.0 / frame_rate),
+        SAFE_ACCESS(headless_config, faster_than_real_time, false),
+        [frame_callback,
+         user_data](const flutter::EmbedderHeadlessFrameRing::Frame& frame) {
+          FlutterHeadlessFrame headless_frame = {};
+          headless_frame.struct_size = sizeof(FlutterHeadlessFrame);
+          headless_frame.target_index = frame.target_index;
+          headless_frame.frame_number = frame.frame_number;
+          headless_frame.frame_time_nanos =
+              frame.frame_target_time.ToEpochDelta().ToNanoseconds();
+          headless_frame.allocation = frame.allocation;
+          headless_frame.row_bytes = frame.row_bytes;
+          headless_frame.height = frame.height;
+          frame_callback(&headless_frame, user_data);
+        });
+  } else if (!IsRendererValid(config)) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
                               "The renderer configuration was invalid.");
   }
@@ -1630,6 +1738,16 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
       return ptr(user_data, baton);
     };
   }
+  if (headless_frame_ring) {
+    // Vsyncs are awaited on the UI thread, which they are fired on too.
+    vsync_callback = [headless_frame_ring](intptr_t baton) {
+      const auto [frame_start_time, frame_target_time] =
+          headless_frame_ring->GetNextFrameTimes();
+      flutter::VsyncWaiterEmbedder::OnEmbedderVsync(
+          fml::MessageLoop::GetCurrent().GetTaskRunner(), baton,
+          frame_start_time, frame_target_time);
+    };
+  }
 
   flutter::PlatformViewEmbedder::ComputePlatformResolvedLocaleCallback
       compute_platform_resolved_locale_callback = nullptr;
@@ -1705,7 +1823,7 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
 
   auto on_create_platform_view = InferPlatformViewCreationCallback(
       config, user_data, platform_dispatch_table,
-      std::move(external_view_embedder_result.first));
+      std::move(external_view_embedder_result.first), headless_frame_ring);
 
   if (!on_create_platform_view) {
     return LOG_EMBEDDER_ERROR(
@@ -1792,9 +1910,15 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     }
     custom_task_runners->thread_priority_setter(priority);
   };
+  settings.pin_threads_to_cpu_cores =
+      SAFE_ACCESS(args, pin_threads_to_cpu_cores, false);
   auto thread_host =
       flutter::EmbedderThreadHost::CreateEmbedderOrEngineManagedThreadHost(
-          custom_task_runners, thread_config_callback);
+          custom_task_runners,
+          settings.pin_threads_to_cpu_cores
+              ? flutter::ThreadHost::ThreadHostConfig::WithCpuAffinity(
+                    thread_config_callback)
+              : flutter::ThreadConfigSetter(thread_config_callback));
 
   if (!thread_host || !thread_host->IsValid()) {
     return LOG_EMBEDDER_ERROR(kInvalidArguments,
@@ -1847,7 +1971,10 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
       std::move(run_configuration),         //
       on_create_platform_view,              //
       on_create_rasterizer,                 //
-      std::move(external_texture_resolver)  //
+      std::move(external_texture_resolver),  //
+      fml::TimeDelta::FromMicroseconds(
+          SAFE_ACCESS(args, pointer_event_coalescing_interval_us, 0)),  //
+      std::move(headless_frame_ring)                                    //
   );
 
   // Release the ownership of the embedder engine to the caller.
@@ -1938,6 +2065,9 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
       SAFE_ACCESS(flutter_metrics, physical_view_inset_bottom, 0.0);
   metrics.physical_view_inset_left =
       SAFE_ACCESS(flutter_metrics, physical_view_inset_left, 0.0);
+  if (STRUCT_HAS_MEMBER(flutter_metrics, display_id)) {
+    metrics.display_id = flutter_metrics->display_id;
+  }
 
   if (metrics.device_pixel_ratio <= 0.0) {
     return LOG_EMBEDDER_ERROR(
@@ -2057,6 +2187,62 @@ inline int64_t PointerDataButtonsForLegacyEvent(
   return 0;
 }
 
+// Converts the pointer event of the embedder API to the pointer data of the
+// engine.
+static flutter::PointerData ToPointerData(const FlutterPointerEvent* current) {
+  flutter::PointerData pointer_data;
+  pointer_data.Clear();
+  // this is currely in use only on android embedding.
+  pointer_data.embedder_id = 0;
+  pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
+  pointer_data.change = ToPointerDataChange(
+      SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
+  pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
+  pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
+  // Delta will be generated in pointer_data_packet_converter.cc.
+  pointer_data.physical_delta_x = 0.0;
+  pointer_data.physical_delta_y = 0.0;
+  pointer_data.device = SAFE_ACCESS(current, device, 0);
+  // Pointer identifier will be generated in
+  // pointer_data_packet_converter.cc.
+  pointer_data.pointer_identifier = 0;
+  pointer_data.signal_kind = ToPointerDataSignalKind(
+      SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
+  pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
+  pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
+  FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
+  // For backwards compatibility with embedders written before the device
+  // kind and buttons were exposed, if the device kind is not set treat it
+  // as a mouse, with a synthesized primary button state based on the phase.
+  if (device_kind == 0) {
+    pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
+    pointer_data.buttons =
+        PointerDataButtonsForLegacyEvent(pointer_data.change);
+
+  } else {
+    pointer_data.kind = ToPointerDataKind(device_kind);
+    if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
+      // For touch events, set the button internally rather than requiring
+      // it at the API level, since it's a confusing construction to expose.
+      if (pointer_data.change == flutter::PointerData::Change::kDown ||
+          pointer_data.change == flutter::PointerData::Change::kMove) {
+        pointer_data.buttons = flutter::kPointerButtonTouchContact;
+      }
+    } else {
+      // Buttons use the same mask values, so pass them through directly.
+      pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
+    }
+  }
+  pointer_data.pan_x = SAFE_ACCESS(current, pan_x, 0.0);
+  pointer_data.pan_y = SAFE_ACCESS(current, pan_y, 0.0);
+  // Delta will be generated in pointer_data_packet_converter.cc.
+  pointer_data.pan_delta_x = 0.0;
+  pointer_data.pan_delta_y = 0.0;
+  pointer_data.scale = SAFE_ACCESS(current, scale, 0.0);
+  pointer_data.rotation = SAFE_ACCESS(current, rotation, 0.0);
+  return pointer_data;
+}
+
 FlutterEngineResult FlutterEngineSendPointerEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterPointerEvent* pointers,
@@ -2074,57 +2260,7 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
   const FlutterPointerEvent* current = pointers;
 
   for (size_t i = 0; i < events_count; ++i) {
-    flutter::PointerData pointer_data;
-    pointer_data.Clear();
-    // this is currely in use only on android embedding.
-    pointer_data.embedder_id = 0;
-    pointer_data.time_stamp = SAFE_ACCESS(current, timestamp, 0);
-    pointer_data.change = ToPointerDataChange(
-        SAFE_ACCESS(current, phase, FlutterPointerPhase::kCancel));
-    pointer_data.physical_x = SAFE_ACCESS(current, x, 0.0);
-    pointer_data.physical_y = SAFE_ACCESS(current, y, 0.0);
-    // Delta will be generated in pointer_data_packet_converter.cc.
-    pointer_data.physical_delta_x = 0.0;
-    pointer_data.physical_delta_y = 0.0;
-    pointer_data.device = SAFE_ACCESS(current, device, 0);
-    // Pointer identifier will be generated in
-    // pointer_data_packet_converter.cc.
-    pointer_data.pointer_identifier = 0;
-    pointer_data.signal_kind = ToPointerDataSignalKind(
-        SAFE_ACCESS(current, signal_kind, kFlutterPointerSignalKindNone));
-    pointer_data.scroll_delta_x = SAFE_ACCESS(current, scroll_delta_x, 0.0);
-    pointer_data.scroll_delta_y = SAFE_ACCESS(current, scroll_delta_y, 0.0);
-    FlutterPointerDeviceKind device_kind = SAFE_ACCESS(current, device_kind, 0);
-    // For backwards compatibility with embedders written before the device
-    // kind and buttons were exposed, if the device kind is not set treat it
-    // as a mouse, with a synthesized primary button state based on the phase.
-    if (device_kind == 0) {
-      pointer_data.kind = flutter::PointerData::DeviceKind::kMouse;
-      pointer_data.buttons =
-          PointerDataButtonsForLegacyEvent(pointer_data.change);
-
-    } else {
-      pointer_data.kind = ToPointerDataKind(device_kind);
-      if (pointer_data.kind == flutter::PointerData::DeviceKind::kTouch) {
-        // For touch events, set the button internally rather than requiring
-        // it at the API level, since it's a confusing construction to expose.
-        if (pointer_data.change == flutter::PointerData::Change::kDown ||
-            pointer_data.change == flutter::PointerData::Change::kMove) {
-          pointer_data.buttons = flutter::kPointerButtonTouchContact;
-        }
-      } else {
-        // Buttons use the same mask values, so pass them through directly.
-        pointer_data.buttons = SAFE_ACCESS(current, buttons, 0);
-      }
-    }
-    pointer_data.pan_x = SAFE_ACCESS(current, pan_x, 0.0);
-    pointer_data.pan_y = SAFE_ACCESS(current, pan_y, 0.0);
-    // Delta will be generated in pointer_data_packet_converter.cc.
-    pointer_data.pan_delta_x = 0.0;
-    pointer_data.pan_delta_y = 0.0;
-    pointer_data.scale = SAFE_ACCESS(current, scale, 0.0);
-    pointer_data.rotation = SAFE_ACCESS(current, rotation, 0.0);
-    packet->SetPointerData(i, pointer_data);
+    packet->SetPointerData(i, ToPointerData(current));
     current = reinterpret_cast<const FlutterPointerEvent*>(
         reinterpret_cast<const uint8_t*>(current) + current->struct_size);
   }
@@ -2137,6 +2273,54 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
                                   "running Flutter application.");
 }
 
+FlutterEngineResult FlutterEngineQueuePointerEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* pointers,
+    size_t events_count) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (pointers == nullptr || events_count == 0) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Invalid pointer events.");
+  }
+
+  auto embedder_engine = reinterpret_cast<flutter::EmbedderEngine*>(engine);
+  const FlutterPointerEvent* current = pointers;
+  bool queued = true;
+  for (size_t i = 0; i < events_count && queued; ++i) {
+    queued = embedder_engine->QueuePointerData(ToPointerData(current));
+    current = reinterpret_cast<const FlutterPointerEvent*>(
+        reinterpret_cast<const uint8_t*>(current) + current->struct_size);
+  }
+
+  // Dispatch the events that were queued even if some didn't fit.
+  if (!embedder_engine->ScheduleQueuedPointerDataDispatch()) {
+    return LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                              "Could not dispatch pointer events to the "
+                              "running Flutter application.");
+  }
+  return queued ? kSuccess
+                : LOG_EMBEDDER_ERROR(kInternalInconsistency,
+                                     "The pointer event queue is full.");
+}
+
+FlutterEngineResult FlutterEngineReleaseHeadlessFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t target_index) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  if (!reinterpret_cast<flutter::EmbedderEngine*>(engine)
+           ->ReleaseHeadlessFrame(target_index)) {
+    return LOG_EMBEDDER_ERROR(
+        kInvalidArguments,
+        "The target of the headless frame wasn't owned by the embedder.");
+  }
+  return kSuccess;
+}
+
 static inline flutter::KeyEventType MapKeyEventType(
     FlutterKeyEventType event_kind) {
   switch (event_kind) {
@@ -2536,6 +2720,20 @@ void FlutterEngineTraceEventInstant(const char* name) {
   fml::tracing::TraceEventInstant0("flutter", name);
 }
 
+FlutterEngineResult FlutterEngineDumpTraceRingBuffer(
+    FlutterDataCallback callback,
+    void* user_data) {
+  if (callback == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Trace ring buffer callback was null.");
+  }
+
+  std::string dump = fml::tracing::TraceRingBufferDump();
+  callback(reinterpret_cast<const uint8_t*>(dump.data()), dump.size(),
+           user_data);
+  return kSuccess;
+}
+
 FlutterEngineResult FlutterEnginePostRenderThreadTask(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
@@ -2990,6 +3188,9 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(DumpTraceRingBuffer, FlutterEngineDumpTraceRingBuffer);
+  SET_PROC(QueuePointerEvents, FlutterEngineQueuePointerEvents);
+  SET_PROC(ReleaseHeadlessFrame, FlutterEngineReleaseHeadlessFrame);
 #undef SET_PROC
 
   return kSuccess;
@@ -350,6 +350,50 @@ typedef enum {
   kFlutterSoftwarePixelFormatNative32,
 } FlutterSoftwarePixelFormat;
 
+typedef enum {
+  /// A Linux DMA-BUF, imported with `EGL_EXT_image_dma_buf_import`.
+  kFlutterOpenGLExternalBufferTypeDmaBuf,
+  /// An Android `AHardwareBuffer`, imported with
+  /// `EGL_ANDROID_get_native_client_buffer`.
+  kFlutterOpenGLExternalBufferTypeHardwareBuffer,
+} FlutterOpenGLExternalBufferType;
+
+typedef struct {
+  /// The file descriptor of the DMA-BUF of the plane. The engine doesn't take
+  /// ownership of it.
+  int32_t fd;
+  /// The offset of the plane in the DMA-BUF, in bytes.
+  uint32_t offset;
+  /// The number of bytes between the rows of the plane.
+  uint32_t stride;
+} FlutterOpenGLDmaBufPlane;
+
+/// A buffer the engine imports into a texture with an `EGLImage` and samples
+/// in place, without a copy. Only supported on EGL.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterOpenGLExternalBuffer).
+  size_t struct_size;
+  FlutterOpenGLExternalBufferType type;
+  /// The DRM fourcc code of the format of the DMA-BUF, for example
+  /// DRM_FORMAT_ABGR8888.
+  uint32_t dma_buf_format;
+  /// The DRM format modifier of the DMA-BUF, or DRM_FORMAT_MOD_INVALID if the
+  /// driver should assume the modifier the buffer was allocated with.
+  uint64_t dma_buf_modifier;
+  /// The number of planes of the DMA-BUF, at most 3.
+  size_t dma_buf_plane_count;
+  /// The planes of the DMA-BUF.
+  const FlutterOpenGLDmaBufPlane* dma_buf_planes;
+  /// The `AHardwareBuffer*` to import. It must stay valid until the
+  /// destruction callback of the texture is invoked.
+  void* hardware_buffer;
+  /// The file descriptor of a native fence that is signaled once the
+  /// producer is done writing to the buffer, or -1 if the buffer may be read
+  /// from right away. The engine takes ownership of the fence, and makes the
+  /// GPU wait for it before sampling the buffer.
+  int32_t acquire_fence_fd;
+} FlutterOpenGLExternalBuffer;
+
 typedef struct {
   /// Target texture of the active texture unit (example GL_TEXTURE_2D or
   /// GL_TEXTURE_RECTANGLE).
@@ -371,6 +415,13 @@ typedef struct {
   size_t width;
   /// Height of the texture.
   size_t height;
+  /// Optional buffer to import instead of the texture, only read for the
+  /// textures of `gl_external_texture_frame_callback`. When set, `target`,
+  /// `name` and `format` are ignored, `width` and `height` must be the size
+  /// of the buffer, and the destruction callback is invoked once the engine
+  /// no longer samples the buffer. The buffer description must stay valid
+  /// until then too.
+  const FlutterOpenGLExternalBuffer* external_buffer;
 } FlutterOpenGLTexture;
 
 typedef struct {
@@ -397,6 +448,13 @@ typedef bool (*SoftwareSurfacePresentCallback)(void* /* user data */,
                                                const void* /* allocation */,
                                                size_t /* row bytes */,
                                                size_t /* height */);
+typedef bool (*SoftwareSurfacePresentRowsCallback)(
+    void* /* user data */,
+    const void* /* allocation */,
+    size_t /* row bytes */,
+    size_t /* height */,
+    size_t /* first changed row */,
+    size_t /* changed row count */);
 typedef void* (*ProcResolver)(void* /* user data */, const char* /* name */);
 typedef bool (*TextureFrameCallback)(void* /* user data */,
                                      int64_t /* texture identifier */,
@@ -793,6 +851,15 @@ typedef struct {
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The number of threads frames are rendered on at once, in tiles. Zero or
+  /// one renders frames on the raster thread alone.
+  size_t raster_thread_count;
+  /// The callback invoked instead of `surface_present_callback` to present
+  /// only the rows of the buffer that changed since the last present. The
+  /// buffer holds the whole frame, but the embedder may keep its copy of the
+  /// last frame and copy only the changed rows into it.
+  /// This field is optional; `nullptr` may be specified.
+  SoftwareSurfacePresentRowsCallback surface_present_rows_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -805,6 +872,11 @@ typedef struct {
   };
 } FlutterRendererConfig;
 
+/// Display refers to a graphics hardware system consisting of a framebuffer,
+/// typically a monitor or a screen. This ID is unique per display and is
+/// stable until the Flutter application restarts.
+typedef uint64_t FlutterEngineDisplayId;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterWindowMetricsEvent).
   size_t struct_size;
@@ -826,6 +898,12 @@ typedef struct {
   double physical_view_inset_bottom;
   /// Left inset of window.
   double physical_view_inset_left;
+  /// The display the window is on, one of the displays given to
+  /// `FlutterEngineNotifyDisplayUpdate`. Frames are budgeted at the refresh
+  /// rate of this display, and scheduled at it if the embedder doesn't
+  /// specify a `vsync_callback`. Embedders that specify one should signal the
+  /// vsync of this display. This field is ignored for a single display.
+  FlutterEngineDisplayId display_id;
 } FlutterWindowMetricsEvent;
 
 /// The phase of the pointer event.
@@ -1443,6 +1521,15 @@ typedef struct {
   FlutterPoint offset;
   /// The size of the layer (in physical pixels).
   FlutterSize size;
+  /// The area of the backing store that changed since it was last presented,
+  /// in physical pixels of the backing store. Only backing store layers of
+  /// compositors that set `backing_stores_preserve_contents` have damage, and
+  /// only when the backing store was reused. NULL means the whole backing
+  /// store changed.
+  ///
+  /// On ABI stability: Embedders must check `FlutterLayer::struct_size` before
+  /// accessing this field when they may be used with older engines.
+  const FlutterDamage* backing_store_damage;
 } FlutterLayer;
 
 typedef bool (*FlutterBackingStoreCreateCallback)(
@@ -1482,6 +1569,42 @@ typedef struct {
   FlutterLayersPresentCallback present_layers_callback;
   /// Avoid caching backing stores provided by this compositor.
   bool avoid_backing_store_cache;
+  /// Whether the backing stores keep their contents after they are presented,
+  /// until the engine renders into them again. If set, the engine only
+  /// repaints the parts of a reused backing store that changed since it was
+  /// last presented, and passes them to the embedder as the
+  /// `backing_store_damage` of the layer, for it to limit its composition to
+  /// them as well. Has no effect if `avoid_backing_store_cache` is set.
+  bool backing_stores_preserve_contents;
+  /// If not zero, the width and height of the backing stores the engine asks
+  /// for are rounded up to a multiple of this, so that a backing store may
+  /// be reused while the size of the window changes. The contents of a
+  /// backing store layer are then in the top left `FlutterLayer::size` of
+  /// its backing store, and the rest of it must not be composited.
+  size_t backing_store_size_granularity;
+  /// The number of pixels of the backing stores that were not used in a
+  /// frame that the engine keeps for later frames instead of collecting them,
+  /// the most recently used ones first. Backing stores are shared by all
+  /// layers of the same size. Zero collects the unused backing stores after
+  /// every frame. Has no effect if `avoid_backing_store_cache` is set.
+  size_t backing_store_cache_pixel_budget;
+  /// If set, the mutations of each platform view are reduced to fewer
+  /// equivalent ones before they are passed to the embedder. Consecutive
+  /// transformations are composed into one, and clip rects under
+  /// transformations that keep rects rects are mapped through them and
+  /// intersected, so the clip rects and transformations no longer have a one
+  /// to one correspondence with the layers of the scene.
+  bool flatten_platform_view_mutations;
+  /// If set, `present_layers_callback` is invoked on the platform thread
+  /// instead of the raster thread, without blocking the raster thread. The
+  /// engine keeps rendering the next frame on the raster thread, and only
+  /// waits for the platform thread to present the previous frame before it
+  /// renders into its backing stores again. The raster thread is then never
+  /// merged into the platform thread for platform views. The embedder must
+  /// be able to present backing stores rendered on the raster thread from
+  /// the platform thread, and backing stores that aren't cached may also be
+  /// collected there.
+  bool present_layers_on_platform_thread;
 } FlutterCompositor;
 
 typedef struct {
@@ -1520,11 +1643,6 @@ typedef const FlutterLocale* (*FlutterComputePlatformResolvedLocaleCallback)(
     const FlutterLocale** /* supported_locales*/,
     size_t /* Number of locales*/);
 
-/// Display refers to a graphics hardware system consisting of a framebuffer,
-/// typically a monitor or a screen. This ID is unique per display and is
-/// stable until the Flutter application restarts.
-typedef uint64_t FlutterEngineDisplayId;
-
 typedef struct {
   /// This size of this struct. Must be sizeof(FlutterDisplay).
   size_t struct_size;
@@ -1682,6 +1800,57 @@ typedef void (*FlutterLogMessageCallback)(const char* /* tag */,
 /// FlutterEngine instance in AOT mode.
 typedef struct _FlutterEngineAOTData* FlutterEngineAOTData;
 
+/// A frame rendered by an engine that runs headless.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterHeadlessFrame).
+  size_t struct_size;
+  /// The index of the offscreen target that holds the frame. The target is
+  /// owned by the embedder until it is handed back with
+  /// `FlutterEngineReleaseHeadlessFrame`.
+  size_t target_index;
+  /// The number of the frame, counting up from zero.
+  uint64_t frame_number;
+  /// The time the frame was rendered for, on the clock of
+  /// `FlutterEngineGetCurrentTime`. For engines that render faster than real
+  /// time, this is the time the frame shows in the timeline of the
+  /// application, not the time it was rendered at.
+  uint64_t frame_time_nanos;
+  /// The pixels of the frame in the native 32-bit RGBA format.
+  const void* allocation;
+  /// The number of bytes in a row of pixels.
+  size_t row_bytes;
+  /// The number of rows of pixels.
+  size_t height;
+} FlutterHeadlessFrame;
+
+/// The callback invoked on the raster thread with each frame rendered by an
+/// engine that runs headless. The frame is only valid during this call, but
+/// its target isn't reused until the embedder releases it.
+typedef void (*FlutterHeadlessFrameCallback)(
+    const FlutterHeadlessFrame* /* frame */,
+    void* /* user data */);
+
+/// The configuration of an engine that renders offscreen without presenting,
+/// for example, to render on a server. Only the software renderer can run
+/// headless, and the `vsync_callback` of `FlutterProjectArgs` is not used, as
+/// the engine keeps the frame clock itself.
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterHeadlessConfig).
+  size_t struct_size;
+  /// The number of frames a second the engine renders. Must be positive.
+  double frame_rate;
+  /// The number of offscreen targets in the ring frames are streamed from.
+  /// Once the embedder owns all of them, the engine waits for one to be
+  /// released before it streams the next frame. Zero uses three targets.
+  size_t target_count;
+  /// If true, frames are rendered as soon as the engine is ready for them,
+  /// rather than once their time has come. The clock of the application then
+  /// advances by one frame interval a frame, however long the frame took.
+  bool faster_than_real_time;
+  /// The callback frames are streamed to. Required.
+  FlutterHeadlessFrameCallback frame_callback;
+} FlutterHeadlessConfig;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterProjectArgs).
   size_t struct_size;
@@ -1945,6 +2114,24 @@ typedef struct {
   /// If this callback is provided, update_semantics_node_callback and
   /// update_semantics_custom_action_callback must not be provided.
   FlutterUpdateSemanticsCallback update_semantics_callback;
+
+  /// On devices with cores of different speeds, pin the engine managed UI and
+  /// raster threads to the fastest cores, and keep the IO thread off of them.
+  /// Threads of embedder supplied task runners are left alone.
+  bool pin_threads_to_cpu_cores;
+
+  /// The interval in microseconds that the moves and hovers of a device
+  /// queued with `FlutterEngineQueuePointerEvents` are coalesced over. Of the
+  /// events of a device that are dispatched together and are closer to each
+  /// other than this, only the latest is dispatched. Zero, the default,
+  /// dispatches all of them.
+  int64_t pointer_event_coalescing_interval_us;
+
+  /// If specified, the engine runs headless, and streams the frames it
+  /// renders through the callback of the configuration instead of presenting
+  /// them. Requires the software renderer, and can't be used with a
+  /// compositor.
+  const FlutterHeadlessConfig* headless_config;
 } FlutterProjectArgs;
 
 #ifndef FLUTTER_ENGINE_NO_PROTOTYPES
@@ -2101,6 +2288,52 @@ FlutterEngineResult FlutterEngineSendPointerEvent(
     const FlutterPointerEvent* events,
     size_t events_count);
 
+//------------------------------------------------------------------------------
+/// @brief      Queues pointer events to be dispatched with the other queued
+///             events in one packet, at most once a frame. Unlike
+///             `FlutterEngineSendPointerEvent`, this can be called on any
+///             thread, and is meant for input devices that report events one
+///             at a time at a high rate, which would otherwise flood the UI
+///             task runner. The moves and hovers of a device can also be
+///             coalesced, see `pointer_event_coalescing_interval_us` in
+///             `FlutterProjectArgs`.
+///
+///             Events queued from several threads are dispatched in the order
+///             they were queued in. Events sent with
+///             `FlutterEngineSendPointerEvent` aren't ordered with respect to
+///             queued ones, so embedders should use one or the other.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  events        The pointer events to queue.
+/// @param[in]  events_count  The number of pointer events.
+///
+/// @return     The result of the call. If the queue is full, the events that
+///             didn't fit are dropped and `kInternalInconsistency` is
+///             returned.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineQueuePointerEvents(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* events,
+    size_t events_count);
+
+//------------------------------------------------------------------------------
+/// @brief      Hands the offscreen target of a frame streamed by an engine that
+///             runs headless back to the engine, so that it can render into
+///             it again. Can be called on any thread, including from the
+///             frame callback.
+///
+/// @param[in]  engine        A running engine instance.
+/// @param[in]  target_index  The `target_index` of the streamed frame.
+///
+/// @return     The result of the call. If the target isn't owned by the
+///             embedder, `kInvalidArguments` is returned.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineReleaseHeadlessFrame(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t target_index);
+
 //------------------------------------------------------------------------------
 /// @brief      Sends a key event to the engine. The framework will decide
 ///             whether to handle this event in a synchronous fashion, although
@@ -2418,6 +2651,28 @@ void FlutterEngineTraceEventDurationEnd(const char* name);
 FLUTTER_EXPORT
 void FlutterEngineTraceEventInstant(const char* name);
 
+//-----------------------------------------------------------------------------
+/// @brief      A profiling utility. Dumps the most recent trace events of each
+///             thread, which are recorded into ring buffers when the engine is
+///             launched with the `--trace-to-ring-buffer` switch, whether or
+///             not the timeline is recording. This allows embedders to capture
+///             the events leading up to a janky frame after it was detected.
+///             Can be called on any thread.
+///
+/// @param[in]  callback   The callback that is called synchronously with the
+///                        trace events in the JSON trace event format, as a
+///                        UTF-8 string that is not NULL terminated. The data
+///                        is only valid for the duration of the callback.
+/// @param[in]  user_data  A baton passed by the engine to the callback. This
+///                        baton is not interpreted by the engine in any way.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineDumpTraceRingBuffer(
+    FlutterDataCallback callback,
+    void* user_data);
+
 //------------------------------------------------------------------------------
 /// @brief      Posts a task onto the Flutter render thread. Typically, this may
 ///             be called from any thread as long as a `FlutterEngineShutdown`
@@ -2760,6 +3015,16 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineDumpTraceRingBufferFnPtr)(
+    FlutterDataCallback callback,
+    void* user_data);
+typedef FlutterEngineResult (*FlutterEngineQueuePointerEventsFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterPointerEvent* events,
+    size_t events_count);
+typedef FlutterEngineResult (*FlutterEngineReleaseHeadlessFrameFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    size_t target_index);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2806,6 +3071,9 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineDumpTraceRingBufferFnPtr DumpTraceRingBuffer;
+  FlutterEngineQueuePointerEventsFnPtr QueuePointerEvents;
+  FlutterEngineReleaseHeadlessFrameFnPtr ReleaseHeadlessFrame;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
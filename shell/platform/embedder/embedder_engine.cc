@@ -28,16 +28,28 @@ EmbedderEngine::EmbedderEngine(
     RunConfiguration run_configuration,
     const Shell::CreateCallback<PlatformView>& on_create_platform_view,
     const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
-    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver)
+    std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver,
+    fml::TimeDelta pointer_event_coalescing_interval,
+    std::shared_ptr<EmbedderHeadlessFrameRing> headless_frame_ring)
     : thread_host_(std::move(thread_host)),
       task_runners_(task_runners),
       run_configuration_(std::move(run_configuration)),
       shell_args_(std::make_unique<ShellArgs>(settings,
                                               on_create_platform_view,
                                               on_create_rasterizer)),
-      external_texture_resolver_(std::move(external_texture_resolver)) {}
-
-EmbedderEngine::~EmbedderEngine() = default;
+      external_texture_resolver_(std::move(external_texture_resolver)),
+      pointer_event_queue_(std::make_shared<EmbedderPointerEventQueue>(
+          EmbedderPointerEventQueue::kDefaultCapacity,
+          pointer_event_coalescing_interval)),
+      headless_frame_ring_(std::move(headless_frame_ring)) {}
+
+EmbedderEngine::~EmbedderEngine() {
+  // The raster thread may wait for the embedder to release a target, which it
+  // never will once it collects the engine.
+  if (headless_frame_ring_) {
+    headless_frame_ring_->Shutdown();
+  }
+}
 
 bool EmbedderEngine::LaunchShell() {
   if (!shell_args_) {
@@ -61,6 +73,9 @@ bool EmbedderEngine::LaunchShell() {
 }
 
 bool EmbedderEngine::CollectShell() {
+  if (headless_frame_ring_) {
+    headless_frame_ring_->Shutdown();
+  }
   shell_.reset();
   return IsValid();
 }
@@ -128,6 +143,40 @@ bool EmbedderEngine::DispatchPointerDataPacket(
   return true;
 }
 
+bool EmbedderEngine::QueuePointerData(const flutter::PointerData& data) {
+  if (!IsValid()) {
+    return false;
+  }
+  return pointer_event_queue_->Push(data);
+}
+
+bool EmbedderEngine::ScheduleQueuedPointerDataDispatch() {
+  if (!IsValid()) {
+    return false;
+  }
+
+  if (!pointer_event_queue_->ClaimDrain()) {
+    // The dispatch is already scheduled and will pick up the queued data.
+    return true;
+  }
+
+  const double refresh_rate = shell_->GetMainDisplayRefreshRate();
+  const fml::TimeDelta frame_interval = fml::TimeDelta::FromMillisecondsF(
+      (refresh_rate > 0 ? fml::RefreshRateToFrameBudget(refresh_rate)
+                        : fml::kDefaultFrameBudget)
+          .count());
+  task_runners_.GetPlatformTaskRunner()->PostTaskForTime(
+      [queue = pointer_event_queue_,
+       platform_view = shell_->GetPlatformView()]() {
+        auto packet = queue->Drain();
+        if (packet && platform_view) {
+          platform_view->DispatchPointerDataPacket(std::move(packet));
+        }
+      },
+      pointer_event_queue_->GetLastDrainTime() + frame_interval);
+  return true;
+}
+
 bool EmbedderEngine::SendPlatformMessage(
     std::unique_ptr<PlatformMessage> message) {
   if (!IsValid() || !message) {
@@ -288,6 +337,13 @@ bool EmbedderEngine::ScheduleFrame() {
   return true;
 }
 
+bool EmbedderEngine::ReleaseHeadlessFrame(size_t target_index) {
+  if (!headless_frame_ring_) {
+    return false;
+  }
+  return headless_frame_ring_->ReleaseTarget(target_index);
+}
+
 Shell& EmbedderEngine::GetShell() {
   FML_DCHECK(shell_);
   return *shell_.get();
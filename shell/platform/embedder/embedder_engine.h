@@ -13,6 +13,8 @@
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/embedder/embedder_external_texture_resolver.h"
+#include "flutter/shell/platform/embedder/embedder_headless_frame_ring.h"
+#include "flutter/shell/platform/embedder/embedder_pointer_event_queue.h"
 #include "flutter/shell/platform/embedder/embedder_thread_host.h"
 namespace flutter {
 
@@ -30,7 +32,9 @@ class EmbedderEngine {
       const Shell::CreateCallback<PlatformView>& on_create_platform_view,
       const Shell::CreateCallback<Rasterizer>& on_create_rasterizer,
       std::unique_ptr<EmbedderExternalTextureResolver>
-          external_texture_resolver);
+          external_texture_resolver,
+      fml::TimeDelta pointer_event_coalescing_interval,
+      std::shared_ptr<EmbedderHeadlessFrameRing> headless_frame_ring = nullptr);
 
   ~EmbedderEngine();
 
@@ -53,6 +57,24 @@ class EmbedderEngine {
   bool DispatchPointerDataPacket(
       std::unique_ptr<flutter::PointerDataPacket> packet);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Queues the pointer data to be dispatched with the other
+  ///             queued data in one packet. Can be called on any thread.
+  ///
+  /// @return     Whether the data was queued, which it isn't if the queue is
+  ///             full.
+  ///
+  bool QueuePointerData(const flutter::PointerData& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedules the dispatch of the queued pointer data on the
+  ///             platform task runner, unless it has been scheduled already.
+  ///             The queue is drained at most once a frame, so that high rate
+  ///             input devices are dispatched one packet a frame. Can be
+  ///             called on any thread.
+  ///
+  bool ScheduleQueuedPointerDataDispatch();
+
   bool SendPlatformMessage(std::unique_ptr<PlatformMessage> message);
 
   bool RegisterTexture(int64_t texture);
@@ -84,6 +106,15 @@ class EmbedderEngine {
 
   bool ScheduleFrame();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Hands the target of a frame streamed by a headless engine
+  ///             back to its ring. Can be called on any thread.
+  ///
+  /// @return     Whether the engine runs headless and the target was owned by
+  ///             the embedder.
+  ///
+  bool ReleaseHeadlessFrame(size_t target_index);
+
   Shell& GetShell();
 
  private:
@@ -93,6 +124,8 @@ class EmbedderEngine {
   std::unique_ptr<ShellArgs> shell_args_;
   std::unique_ptr<Shell> shell_;
   std::unique_ptr<EmbedderExternalTextureResolver> external_texture_resolver_;
+  const std::shared_ptr<EmbedderPointerEventQueue> pointer_event_queue_;
+  const std::shared_ptr<EmbedderHeadlessFrameRing> headless_frame_ring_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderEngine);
 };
@@ -5,6 +5,7 @@
 #include "flutter/shell/platform/embedder/embedder_external_texture_gl.h"
 
 #include "flutter/fml/logging.h"
+#include "flutter/shell/platform/embedder/embedder_struct_macros.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
 #include "third_party/skia/include/core/SkAlphaType.h"
@@ -15,8 +16,152 @@
 #include "third_party/skia/include/gpu/GrBackendSurface.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
+#ifdef EMBEDDER_ENABLE_EGL_IMAGE_IMPORT
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+
+#include "impeller/toolkit/egl/image.h"
+#endif  // EMBEDDER_ENABLE_EGL_IMAGE_IMPORT
+
 namespace flutter {
 
+#ifdef EMBEDDER_ENABLE_EGL_IMAGE_IMPORT
+namespace {
+
+constexpr uint64_t kDRMFormatModInvalid = 0x00ffffffffffffffull;
+
+// The texture an external buffer is imported into. It is collected along with
+// the image that samples it, which is when the embedder is told that the
+// buffer is no longer used.
+struct ExternalBufferTexture {
+  VoidCallback destruction_callback = nullptr;
+  void* user_data = nullptr;
+  std::unique_ptr<impeller::egl::Image> image;
+  GLuint name = 0u;
+  PFNGLDELETETEXTURESPROC delete_textures = nullptr;
+
+  ~ExternalBufferTexture() {
+    if (name != 0u) {
+      delete_textures(1, &name);
+    }
+    image.reset();
+    if (destruction_callback) {
+      destruction_callback(user_data);
+    }
+  }
+};
+
+void ReleaseExternalBufferTexture(void* external_texture) {
+  delete static_cast<ExternalBufferTexture*>(external_texture);
+}
+
+std::unique_ptr<impeller::egl::Image> ImportExternalBuffer(
+    EGLDisplay display,
+    const FlutterOpenGLExternalBuffer* buffer,
+    size_t width,
+    size_t height) {
+  switch (buffer->type) {
+    case kFlutterOpenGLExternalBufferTypeDmaBuf: {
+      const auto* planes = SAFE_ACCESS(buffer, dma_buf_planes, nullptr);
+      if (planes == nullptr) {
+        return nullptr;
+      }
+      impeller::egl::DmaBufDescriptor desc;
+      desc.width = width;
+      desc.height = height;
+      desc.format = SAFE_ACCESS(buffer, dma_buf_format, 0u);
+      const uint64_t modifier =
+          SAFE_ACCESS(buffer, dma_buf_modifier, kDRMFormatModInvalid);
+      if (modifier != kDRMFormatModInvalid) {
+        desc.modifier = modifier;
+      }
+      const size_t plane_count = SAFE_ACCESS(buffer, dma_buf_plane_count, 0u);
+      for (size_t i = 0; i < plane_count; i++) {
+        desc.planes.push_back(
+            {planes[i].fd, planes[i].offset, planes[i].stride});
+      }
+      return impeller::egl::Image::CreateFromDmaBuf(display, desc);
+    }
+    case kFlutterOpenGLExternalBufferTypeHardwareBuffer:
+      return impeller::egl::Image::CreateFromHardwareBuffer(
+          display, static_cast<const AHardwareBuffer*>(
+                       SAFE_ACCESS(buffer, hardware_buffer, nullptr)));
+  }
+  return nullptr;
+}
+
+// Imports the external buffer of the texture into a texture of its own, which
+// samples the memory of the buffer.
+sk_sp<SkImage> MakeExternalBufferImage(GrDirectContext* context,
+                                       const FlutterOpenGLTexture& texture) {
+  // The embedder is told that the buffer is no longer used once this is
+  // collected, even if the buffer couldn't be imported.
+  auto external_texture = std::make_unique<ExternalBufferTexture>();
+  external_texture->destruction_callback = texture.destruction_callback;
+  external_texture->user_data = texture.user_data;
+
+  const FlutterOpenGLExternalBuffer* buffer = texture.external_buffer;
+  EGLDisplay display = ::eglGetCurrentDisplay();
+
+  // The fence must be waited for, or at least closed, either way.
+  const int32_t fence_fd = SAFE_ACCESS(buffer, acquire_fence_fd, -1);
+  if (fence_fd >= 0 && !impeller::egl::WaitForNativeFence(display, fence_fd)) {
+    return nullptr;
+  }
+
+  if (display == EGL_NO_DISPLAY || texture.width == 0 || texture.height == 0) {
+    return nullptr;
+  }
+
+  external_texture->image =
+      ImportExternalBuffer(display, buffer, texture.width, texture.height);
+  if (!external_texture->image) {
+    FML_LOG(ERROR) << "Could not import the external buffer of the texture.";
+    return nullptr;
+  }
+
+  auto resolver = impeller::egl::CreateProcAddressResolver();
+  auto gen_textures =
+      reinterpret_cast<PFNGLGENTEXTURESPROC>(resolver("glGenTextures"));
+  auto bind_texture =
+      reinterpret_cast<PFNGLBINDTEXTUREPROC>(resolver("glBindTexture"));
+  auto image_target_texture =
+      reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+          resolver("glEGLImageTargetTexture2DOES"));
+  external_texture->delete_textures =
+      reinterpret_cast<PFNGLDELETETEXTURESPROC>(resolver("glDeleteTextures"));
+  if (!gen_textures || !bind_texture || !image_target_texture ||
+      !external_texture->delete_textures) {
+    return nullptr;
+  }
+
+  gen_textures(1, &external_texture->name);
+  bind_texture(GL_TEXTURE_EXTERNAL_OES, external_texture->name);
+  image_target_texture(GL_TEXTURE_EXTERNAL_OES,
+                       external_texture->image->GetHandle());
+  bind_texture(GL_TEXTURE_EXTERNAL_OES, 0);
+  context->resetContext(kTextureBinding_GrGLBackendState);
+
+  GrGLTextureInfo texture_info = {GL_TEXTURE_EXTERNAL_OES,
+                                  external_texture->name, GL_RGBA8_OES};
+  GrBackendTexture backend_texture(texture.width, texture.height,
+                                   GrMipMapped::kNo, texture_info);
+  // Skia invokes the release proc even if it rejects the texture.
+  return SkImage::MakeFromTexture(
+      context,                       // context
+      backend_texture,               // texture handle
+      kTopLeft_GrSurfaceOrigin,      // origin
+      kRGBA_8888_SkColorType,        // color type
+      kPremul_SkAlphaType,           // alpha type
+      nullptr,                       // colorspace
+      ReleaseExternalBufferTexture,  // texture release proc
+      external_texture.release()     // texture release context
+  );
+}
+
+}  // namespace
+#endif  // EMBEDDER_ENABLE_EGL_IMAGE_IMPORT
+
 EmbedderExternalTextureGL::EmbedderExternalTextureGL(
     int64_t texture_identifier,
     const ExternalTextureCallback& callback)
@@ -65,6 +210,23 @@ sk_sp<DlImage> EmbedderExternalTextureGL::ResolveTexture(
     return nullptr;
   }
 
+  if (texture->external_buffer != nullptr) {
+#ifdef EMBEDDER_ENABLE_EGL_IMAGE_IMPORT
+    auto image = MakeExternalBufferImage(context, *texture);
+    if (!image) {
+      FML_LOG(ERROR) << "Could not create external texture from buffer.";
+      return nullptr;
+    }
+    return DlImage::Make(std::move(image));
+#else
+    FML_LOG(ERROR) << "External buffers are not supported on this platform.";
+    if (texture->destruction_callback) {
+      texture->destruction_callback(texture->user_data);
+    }
+    return nullptr;
+#endif  // EMBEDDER_ENABLE_EGL_IMAGE_IMPORT
+  }
+
   GrGLTextureInfo gr_texture_info = {texture->target, texture->name,
                                      texture->format};
 
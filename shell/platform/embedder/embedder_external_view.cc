@@ -71,13 +71,35 @@ const EmbeddedViewParams* EmbedderExternalView::GetEmbeddedViewParams() const {
   return embedded_view_params_.get();
 }
 
-bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
+std::vector<SkIRect> EmbedderExternalView::GetRenderSurfaceRects(
+    const std::vector<SkIRect>& frame_rects) const {
+  const SkIRect surface_bounds = SkIRect::MakeSize(render_surface_size_);
+  std::vector<SkIRect> surface_rects;
+  surface_rects.reserve(frame_rects.size());
+  for (const SkIRect& frame_rect : frame_rects) {
+    SkIRect surface_rect =
+        surface_transformation_.mapRect(SkRect::Make(frame_rect)).roundOut();
+    if (surface_rect.intersect(surface_bounds)) {
+      surface_rects.push_back(surface_rect);
+    }
+  }
+  return surface_rects;
+}
+
+bool EmbedderExternalView::Render(
+    const EmbedderRenderTarget& render_target,
+    const std::optional<std::vector<SkIRect>>& frame_damage) {
   TRACE_EVENT0("flutter", "EmbedderExternalView::Render");
 
   FML_DCHECK(HasEngineRenderedContents())
       << "Unnecessarily asked to render into a render target when there was "
          "nothing to render.";
 
+  if (frame_damage.has_value() && frame_damage->empty()) {
+    // The render target already holds the contents.
+    return true;
+  }
+
   auto picture = recorder_->finishRecordingAsPicture();
   if (!picture) {
     return false;
@@ -88,15 +110,27 @@ bool EmbedderExternalView::Render(const EmbedderRenderTarget& render_target) {
     return false;
   }
 
-  FML_DCHECK(SkISize::Make(surface->width(), surface->height()) ==
-             render_surface_size_);
+  // The render target may be larger than the view, which is rendered into
+  // its top left.
+  FML_DCHECK(surface->width() >= render_surface_size_.width() &&
+             surface->height() >= render_surface_size_.height());
 
   auto canvas = surface->getCanvas();
   if (!canvas) {
     return false;
   }
 
+  // The canvas of a render target is reused across frames, so the clip must
+  // not outlive this frame.
+  SkAutoCanvasRestore auto_restore(canvas, true);
   canvas->setMatrix(surface_transformation_);
+  if (frame_damage.has_value()) {
+    SkPath damage_path;
+    for (const SkIRect& rect : *frame_damage) {
+      damage_path.addRect(SkRect::Make(rect));
+    }
+    canvas->clipPath(damage_path);
+  }
   canvas->clear(SK_ColorTRANSPARENT);
   canvas->drawPicture(picture);
   canvas->flush();
@@ -8,6 +8,7 @@
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/hash_combine.h"
@@ -109,7 +110,28 @@ class EmbedderExternalView {
 
   SkISize GetRenderSurfaceSize() const;
 
-  bool Render(const EmbedderRenderTarget& render_target);
+  //----------------------------------------------------------------------------
+  /// @brief      Renders the contents of the view into the render target.
+  ///
+  /// @param[in]  render_target  The render target to render into.
+  /// @param[in]  frame_damage   The rects of the frame that changed since the
+  ///                            previous frame, in frame coordinates, or
+  ///                            nullopt to render all of the contents. Only
+  ///                            the damaged rects are repainted, so the
+  ///                            render target must hold the contents of this
+  ///                            view in the previous frame.
+  ///
+  /// @return     Whether the contents were rendered.
+  ///
+  bool Render(const EmbedderRenderTarget& render_target,
+              const std::optional<std::vector<SkIRect>>& frame_damage);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Maps rects of the frame to the rects of the render surface
+  ///             they cover.
+  ///
+  std::vector<SkIRect> GetRenderSurfaceRects(
+      const std::vector<SkIRect>& frame_rects) const;
 
  private:
   const SkISize render_surface_size_;
@@ -13,24 +13,68 @@
 
 namespace flutter {
 
+// How long the raster thread waits for the platform thread to present the
+// previous frame before it renders into its render targets again.
+static constexpr fml::TimeDelta kPresentationFenceTimeout =
+    fml::TimeDelta::FromMilliseconds(100);
+
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
     bool avoid_backing_store_cache,
+    bool backing_stores_preserve_contents,
+    size_t backing_store_size_granularity,
+    size_t backing_store_cache_pixel_budget,
     const CreateRenderTargetCallback& create_render_target_callback,
     const PresentCallback& present_callback)
     : avoid_backing_store_cache_(avoid_backing_store_cache),
+      backing_stores_preserve_contents_(backing_stores_preserve_contents),
       create_render_target_callback_(create_render_target_callback),
-      present_callback_(present_callback) {
+      present_callback_(present_callback),
+      render_target_cache_(backing_store_size_granularity,
+                           backing_store_cache_pixel_budget) {
   FML_DCHECK(create_render_target_callback_);
   FML_DCHECK(present_callback_);
 }
 
-EmbedderExternalViewEmbedder::~EmbedderExternalViewEmbedder() = default;
+EmbedderExternalViewEmbedder::~EmbedderExternalViewEmbedder() {
+  // The presentations that are still pending skip the render targets
+  // collected here, but one that is running may still need them.
+  alive_.reset();
+  if (transaction_queue_ &&
+      !platform_task_runner_->RunsTasksOnCurrentThread()) {
+    transaction_queue_->WaitUntilApplied(kPresentationFenceTimeout);
+  }
+}
 
 void EmbedderExternalViewEmbedder::SetSurfaceTransformationCallback(
     SurfaceTransformationCallback surface_transformation_callback) {
   surface_transformation_callback_ = std::move(surface_transformation_callback);
 }
 
+void EmbedderExternalViewEmbedder::SetFlattenPlatformViewMutations(
+    bool flatten) {
+  if (!flatten) {
+    mutators_stack_flattener_.reset();
+  } else if (!mutators_stack_flattener_) {
+    mutators_stack_flattener_ = std::make_unique<MutatorsStackFlattener>();
+  }
+}
+
+void EmbedderExternalViewEmbedder::SetPresentLayersOnPlatformThread(
+    bool present_on_platform_thread) {
+  present_layers_on_platform_thread_ = present_on_platform_thread;
+}
+
+void EmbedderExternalViewEmbedder::SetPlatformTaskRunner(
+    fml::RefPtr<fml::TaskRunner> platform_task_runner) {
+  platform_task_runner_ = std::move(platform_task_runner);
+  if (present_layers_on_platform_thread_ && platform_task_runner_) {
+    transaction_queue_ =
+        std::make_unique<PlatformViewTransactionQueue>(platform_task_runner_);
+  } else {
+    transaction_queue_.reset();
+  }
+}
+
 SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
   if (!surface_transformation_callback_) {
     return SkMatrix{};
@@ -42,6 +86,34 @@ SkMatrix EmbedderExternalViewEmbedder::GetSurfaceTransformation() const {
 void EmbedderExternalViewEmbedder::Reset() {
   pending_views_.clear();
   composition_order_.clear();
+  pending_frame_damage_.reset();
+}
+
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::SupportsPartialRepaint() {
+  return backing_stores_preserve_contents_ && !avoid_backing_store_cache_;
+}
+
+// |ExternalViewEmbedder|
+bool EmbedderExternalViewEmbedder::SupportsAsyncComposition() {
+  return transaction_queue_ != nullptr;
+}
+
+// |ExternalViewEmbedder|
+void EmbedderExternalViewEmbedder::SetFrameDamage(
+    std::optional<std::vector<SkIRect>> frame_damage_rects) {
+  pending_frame_damage_ = std::move(frame_damage_rects);
+}
+
+bool EmbedderExternalViewEmbedder::IsCompositionUnchanged() const {
+  // The contents of each view depend on the platform views they are painted
+  // after, so they can only be repainted in part if those are the same.
+  return pending_frame_size_ == last_frame_size_ &&
+         pending_surface_transformation_ == last_surface_transformation_ &&
+         std::equal(composition_order_.begin(), composition_order_.end(),
+                    last_composition_order_.begin(),
+                    last_composition_order_.end(),
+                    EmbedderExternalView::ViewIdentifier::Equal{});
 }
 
 // |ExternalViewEmbedder|
@@ -126,9 +198,36 @@ static FlutterBackingStoreConfig MakeBackingStoreConfig(
 void EmbedderExternalViewEmbedder::SubmitFrame(
     GrDirectContext* context,
     std::unique_ptr<SurfaceFrame> frame) {
-  auto [matched_render_targets, pending_keys] =
+  // The render targets of the previous frame may still be presented by the
+  // platform thread, so they can't be collected or rendered into yet.
+  if (transaction_queue_ &&
+      !transaction_queue_->WaitUntilApplied(kPresentationFenceTimeout)) {
+    FML_DLOG(WARNING) << "The previous frame is still being presented.";
+  }
+
+  auto [matched_render_targets, pending_keys, reused_keys] =
       render_target_cache_.GetExistingTargetsInCache(pending_views_);
 
+  // The render targets that the views were rendered into in the previous
+  // frame still hold those contents, so only the damage needs to be repainted
+  // into them. Newly created ones and the ones of other views are rendered in
+  // full.
+  const bool repaint_damage_only = pending_frame_damage_.has_value() &&
+                                   SupportsPartialRepaint() &&
+                                   IsCompositionUnchanged();
+  EmbedderExternalView::ViewIdentifierSet reused_render_targets;
+  if (repaint_damage_only) {
+    reused_render_targets = std::move(reused_keys);
+  }
+  auto frame_damage_for_view =
+      [&](const EmbedderExternalView::ViewIdentifier& view_id)
+      -> std::optional<std::vector<SkIRect>> {
+    if (reused_render_targets.count(view_id) == 0) {
+      return std::nullopt;
+    }
+    return pending_frame_damage_;
+  };
+
   // This is where unused render targets will be collected. Control may flow to
   // the embedder. Here, the embedder has the opportunity to trample on the
   // OpenGL context.
@@ -142,7 +241,7 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   auto deferred_cleanup_render_targets =
-      render_target_cache_.ClearAllRenderTargetsInCache();
+      render_target_cache_.ClearRenderTargetsOverBudget();
 
   for (const auto& pending_key : pending_keys) {
     const auto& external_view = pending_views_.at(pending_key);
@@ -163,8 +262,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
     // directly.
     const auto render_surface_size = external_view->GetRenderSurfaceSize();
 
-    const auto backing_store_config =
-        MakeBackingStoreConfig(render_surface_size);
+    const auto backing_store_config = MakeBackingStoreConfig(
+        render_target_cache_.GetRenderTargetSize(render_surface_size));
 
     // This is where the embedder will create render targets for us. Control
     // flow to the embedder makes the engine susceptible to having the embedder
@@ -193,7 +292,8 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   // into the buffers is irrelevant to the presentation order.
   for (const auto& render_target : matched_render_targets) {
     if (!pending_views_.at(render_target.first)
-             ->Render(*render_target.second)) {
+             ->Render(*render_target.second,
+                      frame_damage_for_view(render_target.first))) {
       FML_LOG(ERROR)
           << "Could not render into the embedder supplied render target.";
       return;
@@ -213,9 +313,9 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
   //
   // @warning: Embedder may trample on our OpenGL context here.
   {
-    EmbedderLayers presented_layers(pending_frame_size_,
-                                    pending_device_pixel_ratio_,
-                                    pending_surface_transformation_);
+    auto presented_layers = std::make_shared<EmbedderLayers>(
+        pending_frame_size_, pending_device_pixel_ratio_,
+        pending_surface_transformation_);
     // In composition order, submit backing stores and platform views to the
     // embedder.
     for (const auto& view_id : composition_order_) {
@@ -223,10 +323,16 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       // before the Flutter rendered contents for that interleaving level.
       const auto& external_view = pending_views_.at(view_id);
       if (external_view->HasPlatformView()) {
-        presented_layers.PushPlatformViewLayer(
-            external_view->GetViewIdentifier()
-                .platform_view_id.value(),           // view id
-            *external_view->GetEmbeddedViewParams()  // view params
+        const auto platform_view_id =
+            external_view->GetViewIdentifier().platform_view_id.value();
+        const auto& params = *external_view->GetEmbeddedViewParams();
+        presented_layers->PushPlatformViewLayer(
+            platform_view_id,  // view id
+            params,            // view params
+            mutators_stack_flattener_
+                ? mutators_stack_flattener_->Flatten(platform_view_id,
+                                                     params.mutatorsStack())
+                : params.mutatorsStack()  // mutators
         );
       }
 
@@ -235,17 +341,51 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
       // platform view.
       if (external_view->HasEngineRenderedContents()) {
         const auto& exteral_render_target = matched_render_targets.at(view_id);
-        presented_layers.PushBackingStoreLayer(
-            exteral_render_target->GetBackingStore());
+        std::optional<std::vector<SkIRect>> damage;
+        if (auto frame_damage = frame_damage_for_view(view_id)) {
+          damage = external_view->GetRenderSurfaceRects(*frame_damage);
+        }
+        presented_layers->PushBackingStoreLayer(
+            exteral_render_target->GetBackingStore(), damage);
       }
     }
 
     // Flush the layer description down to the embedder for presentation.
     //
     // @warning: Embedder may trample on our OpenGL context here.
-    presented_layers.InvokePresentCallback(present_callback_);
+    if (transaction_queue_) {
+      // The render targets that aren't cached are collected once they are
+      // presented.
+      std::shared_ptr<EmbedderRenderTargetCache::RenderTargets>
+          uncached_render_targets;
+      if (avoid_backing_store_cache_) {
+        uncached_render_targets =
+            std::make_shared<EmbedderRenderTargetCache::RenderTargets>(
+                std::move(matched_render_targets));
+        matched_render_targets.clear();
+      }
+      transaction_queue_->AddChange(
+          [alive = std::weak_ptr<bool>(alive_), presented_layers,
+           render_targets = std::move(uncached_render_targets),
+           present_callback = present_callback_]() {
+            if (alive.lock()) {
+              presented_layers->InvokePresentCallback(present_callback);
+            }
+          });
+      transaction_queue_->Commit();
+    } else {
+      presented_layers->InvokePresentCallback(present_callback_);
+    }
+  }
+
+  if (mutators_stack_flattener_) {
+    mutators_stack_flattener_->EndFrame();
   }
 
+  last_composition_order_ = composition_order_;
+  last_surface_transformation_ = pending_surface_transformation_;
+  last_frame_size_ = pending_frame_size_;
+
   // See why this is necessary in the comment where this collection in realized.
   //
   // @warning: Embedder may trample on our OpenGL context here.
@@ -9,8 +9,10 @@
 #include <unordered_map>
 
 #include "flutter/flow/embedded_views.h"
+#include "flutter/flow/platform_view_transaction_queue.h"
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
 #include "flutter/shell/platform/embedder/embedder_external_view.h"
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
@@ -44,7 +46,20 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///                                      will beinvoked every frame for every
   ///                                      engine composited layer. The result
   ///                                      will not cached.
-  ///
+  /// @param[in] backing_stores_preserve_contents
+  ///                                     If set, cached render targets keep
+  ///                                     the contents they were last rendered
+  ///                                     with, so only the damaged parts of
+  ///                                     them are repainted.
+  /// @param[in]  backing_store_size_granularity
+  ///                                     If not zero, backing stores are
+  ///                                     sized up to a multiple of it, so
+  ///                                     that they may be reused when the
+  ///                                     size of the frame changes by less.
+  /// @param[in]  backing_store_cache_pixel_budget
+  ///                                     The number of pixels of the backing
+  ///                                     stores unused by a frame that are
+  ///                                     kept for later frames.
   /// @param[in]  create_render_target_callback
   ///                                     The render target callback used to
   ///                                     request the render target for a layer.
@@ -55,6 +70,9 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   ///
   EmbedderExternalViewEmbedder(
       bool avoid_backing_store_cache,
+      bool backing_stores_preserve_contents,
+      size_t backing_store_size_granularity,
+      size_t backing_store_cache_pixel_budget,
       const CreateRenderTargetCallback& create_render_target_callback,
       const PresentCallback& present_callback);
 
@@ -74,6 +92,29 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   void SetSurfaceTransformationCallback(
       SurfaceTransformationCallback surface_transformation_callback);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the mutators stacks of the platform views are
+  ///             flattened before they are converted to the mutations passed
+  ///             to the embedder, see `MutatorsStack::Flattened`.
+  ///
+  void SetFlattenPlatformViewMutations(bool flatten);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets whether the layers are presented on the platform thread
+  ///             instead of the raster thread, see
+  ///             `FlutterCompositor.present_layers_on_platform_thread`. This
+  ///             takes effect once the platform task runner is set.
+  ///
+  void SetPresentLayersOnPlatformThread(bool present_on_platform_thread);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner of the platform thread that the layers
+  ///             are presented on if `SetPresentLayersOnPlatformThread` is
+  ///             set. Must be called before the rasterizer is set up with this
+  ///             external view embedder.
+  ///
+  void SetPlatformTaskRunner(fml::RefPtr<fml::TaskRunner> platform_task_runner);
+
  private:
   // |ExternalViewEmbedder|
   void CancelFrame() override;
@@ -100,8 +141,19 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   // |ExternalViewEmbedder|
   DlCanvas* GetRootCanvas() override;
 
+  // |ExternalViewEmbedder|
+  bool SupportsPartialRepaint() override;
+
+  // |ExternalViewEmbedder|
+  bool SupportsAsyncComposition() override;
+
+  // |ExternalViewEmbedder|
+  void SetFrameDamage(
+      std::optional<std::vector<SkIRect>> frame_damage_rects) override;
+
  private:
   const bool avoid_backing_store_cache_;
+  const bool backing_stores_preserve_contents_;
   const CreateRenderTargetCallback create_render_target_callback_;
   const PresentCallback present_callback_;
   SurfaceTransformationCallback surface_transformation_callback_;
@@ -111,9 +163,27 @@ class EmbedderExternalViewEmbedder final : public ExternalViewEmbedder {
   EmbedderExternalView::PendingViews pending_views_;
   std::vector<EmbedderExternalView::ViewIdentifier> composition_order_;
   EmbedderRenderTargetCache render_target_cache_;
+  std::optional<std::vector<SkIRect>> pending_frame_damage_;
+  // The composition of the last presented frame, which the contents of the
+  // cached render targets belong to.
+  std::vector<EmbedderExternalView::ViewIdentifier> last_composition_order_;
+  SkMatrix last_surface_transformation_;
+  SkISize last_frame_size_ = SkISize::Make(0, 0);
+  // Set if the mutators stacks of the platform views are flattened.
+  std::unique_ptr<MutatorsStackFlattener> mutators_stack_flattener_;
+  bool present_layers_on_platform_thread_ = false;
+  fml::RefPtr<fml::TaskRunner> platform_task_runner_;
+  // Set if the layers are presented on the platform thread.
+  std::unique_ptr<PlatformViewTransactionQueue> transaction_queue_;
+  // Checked by the presentations on the platform thread, which may run after
+  // this external view embedder and the render targets it presents are
+  // collected.
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
 
   void Reset();
 
+  bool IsCompositionUnchanged() const;
+
   SkMatrix GetSurfaceTransformation() const;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderExternalViewEmbedder);
@@ -0,0 +1,285 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+struct PresentedLayer {
+  std::optional<std::vector<FlutterRect>> damage;
+};
+
+SkColor GetPixel(const sk_sp<SkSurface>& surface, int x, int y) {
+  SkPixmap pixmap;
+  FML_CHECK(surface->peekPixels(&pixmap));
+  return pixmap.getColor(x, y);
+}
+
+}  // namespace
+
+TEST(EmbedderExternalViewEmbedderTest, RepaintsTheDamageOfReusedTargets) {
+  const SkISize frame_size = SkISize::Make(100, 100);
+  std::vector<sk_sp<SkSurface>> surfaces;
+  std::vector<PresentedLayer> presented;
+  EmbedderExternalViewEmbedder view_embedder(
+      /*avoid_backing_store_cache=*/false,
+      /*backing_stores_preserve_contents=*/true,
+      /*backing_store_size_granularity=*/0u,
+      /*backing_store_cache_pixel_budget=*/0u,
+      [&](GrDirectContext* context, const FlutterBackingStoreConfig& config) {
+        auto surface = SkSurface::MakeRasterN32Premul(config.size.width,
+                                                      config.size.height);
+        surfaces.push_back(surface);
+        FlutterBackingStore backing_store = {};
+        backing_store.struct_size = sizeof(backing_store);
+        backing_store.type = kFlutterBackingStoreTypeSoftware;
+        return std::make_unique<EmbedderRenderTarget>(backing_store, surface,
+                                                      []() {});
+      },
+      [&](const std::vector<const FlutterLayer*>& layers) {
+        EXPECT_EQ(layers.size(), 1u);
+        PresentedLayer layer;
+        if (const FlutterDamage* damage = layers[0]->backing_store_damage) {
+          layer.damage = std::vector<FlutterRect>(
+              damage->damage, damage->damage + damage->num_rects);
+        }
+        presented.push_back(layer);
+        return true;
+      });
+  ExternalViewEmbedder& embedder = view_embedder;
+  ASSERT_TRUE(embedder.SupportsPartialRepaint());
+
+  auto draw_frame = [&](DlColor background, DlColor square,
+                        std::optional<std::vector<SkIRect>> damage) {
+    embedder.BeginFrame(frame_size, nullptr, 1.0, nullptr);
+    DlCanvas* canvas = embedder.GetRootCanvas();
+    canvas->DrawRect(SkRect::Make(frame_size), DlPaint(background));
+    canvas->DrawRect(SkRect::MakeLTRB(10, 10, 20, 20), DlPaint(square));
+    embedder.SetFrameDamage(std::move(damage));
+    embedder.SubmitFrame(
+        nullptr, std::make_unique<SurfaceFrame>(
+                     nullptr, SurfaceFrame::FramebufferInfo{},
+                     [](const SurfaceFrame&, DlCanvas*) { return true; },
+                     frame_size));
+  };
+
+  // The first frame is rendered in full.
+  draw_frame(DlColor::kRed(), DlColor::kRed(),
+             std::vector<SkIRect>{SkIRect::MakeSize(frame_size)});
+  ASSERT_EQ(surfaces.size(), 1u);
+  ASSERT_EQ(presented.size(), 1u);
+  EXPECT_FALSE(presented[0].damage.has_value());
+  EXPECT_EQ(GetPixel(surfaces[0], 50, 50), SK_ColorRED);
+
+  // Only the damage is repainted into the reused target, even though the
+  // background was recorded in another color.
+  draw_frame(DlColor::kGreen(), DlColor::kBlue(),
+             std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 20, 20)});
+  ASSERT_EQ(surfaces.size(), 1u);
+  ASSERT_EQ(presented.size(), 2u);
+  ASSERT_TRUE(presented[1].damage.has_value());
+  ASSERT_EQ(presented[1].damage->size(), 1u);
+  EXPECT_EQ(presented[1].damage->at(0).left, 10.0);
+  EXPECT_EQ(presented[1].damage->at(0).bottom, 20.0);
+  EXPECT_EQ(GetPixel(surfaces[0], 15, 15), SK_ColorBLUE);
+  EXPECT_EQ(GetPixel(surfaces[0], 50, 50), SK_ColorRED);
+
+  // Nothing is repainted without damage.
+  draw_frame(DlColor::kGreen(), DlColor::kGreen(), std::vector<SkIRect>{});
+  ASSERT_EQ(presented.size(), 3u);
+  ASSERT_TRUE(presented[2].damage.has_value());
+  EXPECT_TRUE(presented[2].damage->empty());
+  EXPECT_EQ(GetPixel(surfaces[0], 15, 15), SK_ColorBLUE);
+
+  // Unknown damage repaints everything.
+  draw_frame(DlColor::kGreen(), DlColor::kGreen(), std::nullopt);
+  ASSERT_EQ(presented.size(), 4u);
+  EXPECT_FALSE(presented[3].damage.has_value());
+  EXPECT_EQ(GetPixel(surfaces[0], 15, 15), SK_ColorGREEN);
+  EXPECT_EQ(GetPixel(surfaces[0], 50, 50), SK_ColorGREEN);
+}
+
+TEST(EmbedderExternalViewEmbedderTest, SizesBackingStoresUpToGranularity) {
+  std::vector<SkISize> created_sizes;
+  size_t collect_count = 0u;
+  std::vector<FlutterSize> layer_sizes;
+  EmbedderExternalViewEmbedder view_embedder(
+      /*avoid_backing_store_cache=*/false,
+      /*backing_stores_preserve_contents=*/false,
+      /*backing_store_size_granularity=*/64u,
+      /*backing_store_cache_pixel_budget=*/0u,
+      [&](GrDirectContext* context, const FlutterBackingStoreConfig& config) {
+        const SkISize size =
+            SkISize::Make(config.size.width, config.size.height);
+        created_sizes.push_back(size);
+        FlutterBackingStore backing_store = {};
+        backing_store.struct_size = sizeof(backing_store);
+        backing_store.type = kFlutterBackingStoreTypeSoftware;
+        return std::make_unique<EmbedderRenderTarget>(
+            backing_store,
+            SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+            [&collect_count]() { collect_count++; });
+      },
+      [&](const std::vector<const FlutterLayer*>& layers) {
+        EXPECT_EQ(layers.size(), 1u);
+        layer_sizes.push_back(layers[0]->size);
+        return true;
+      });
+  ExternalViewEmbedder& embedder = view_embedder;
+
+  auto draw_frame = [&](const SkISize& frame_size) {
+    embedder.BeginFrame(frame_size, nullptr, 1.0, nullptr);
+    embedder.GetRootCanvas()->DrawRect(SkRect::Make(frame_size),
+                                       DlPaint(DlColor::kRed()));
+    embedder.SubmitFrame(
+        nullptr, std::make_unique<SurfaceFrame>(
+                     nullptr, SurfaceFrame::FramebufferInfo{},
+                     [](const SurfaceFrame&, DlCanvas*) { return true; },
+                     frame_size));
+  };
+
+  draw_frame(SkISize::Make(100, 100));
+  draw_frame(SkISize::Make(110, 120));
+  ASSERT_EQ(created_sizes.size(), 1u);
+  EXPECT_EQ(created_sizes[0], SkISize::Make(128, 128));
+  ASSERT_EQ(layer_sizes.size(), 2u);
+  EXPECT_EQ(layer_sizes[1].width, 110.0);
+  EXPECT_EQ(layer_sizes[1].height, 120.0);
+
+  // Outgrowing the backing store replaces it.
+  draw_frame(SkISize::Make(130, 120));
+  ASSERT_EQ(created_sizes.size(), 2u);
+  EXPECT_EQ(created_sizes[1], SkISize::Make(192, 128));
+  EXPECT_EQ(collect_count, 1u);
+}
+
+TEST(EmbedderExternalViewEmbedderTest, PresentsOnThePlatformThreadIfAsked) {
+  const SkISize frame_size = SkISize::Make(100, 100);
+  fml::Thread platform_thread("platform");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+  fml::CountDownLatch presented_latch(2u);
+  std::atomic_size_t presented_on_platform_thread = 0u;
+  EmbedderExternalViewEmbedder view_embedder(
+      /*avoid_backing_store_cache=*/true,
+      /*backing_stores_preserve_contents=*/false,
+      /*backing_store_size_granularity=*/0u,
+      /*backing_store_cache_pixel_budget=*/0u,
+      [&](GrDirectContext* context, const FlutterBackingStoreConfig& config) {
+        FlutterBackingStore backing_store = {};
+        backing_store.struct_size = sizeof(backing_store);
+        backing_store.type = kFlutterBackingStoreTypeSoftware;
+        return std::make_unique<EmbedderRenderTarget>(
+            backing_store,
+            SkSurface::MakeRasterN32Premul(config.size.width,
+                                           config.size.height),
+            []() {});
+      },
+      [&](const std::vector<const FlutterLayer*>& layers) {
+        EXPECT_EQ(layers.size(), 1u);
+        if (platform_task_runner->RunsTasksOnCurrentThread()) {
+          presented_on_platform_thread++;
+        }
+        presented_latch.CountDown();
+        return true;
+      });
+  ExternalViewEmbedder& embedder = view_embedder;
+
+  // The platform task runner alone doesn't make the composition async.
+  view_embedder.SetPlatformTaskRunner(platform_task_runner);
+  EXPECT_FALSE(embedder.SupportsAsyncComposition());
+  view_embedder.SetPresentLayersOnPlatformThread(true);
+  view_embedder.SetPlatformTaskRunner(platform_task_runner);
+  ASSERT_TRUE(embedder.SupportsAsyncComposition());
+
+  auto draw_frame = [&]() {
+    embedder.BeginFrame(frame_size, nullptr, 1.0, nullptr);
+    embedder.GetRootCanvas()->DrawRect(SkRect::Make(frame_size),
+                                       DlPaint(DlColor::kRed()));
+    embedder.SubmitFrame(
+        nullptr, std::make_unique<SurfaceFrame>(
+                     nullptr, SurfaceFrame::FramebufferInfo{},
+                     [](const SurfaceFrame&, DlCanvas*) { return true; },
+                     frame_size));
+  };
+  draw_frame();
+  draw_frame();
+  presented_latch.Wait();
+  EXPECT_EQ(presented_on_platform_thread, 2u);
+}
+
+TEST(EmbedderExternalViewEmbedderTest, PendingPresentationsOutliveTheEmbedder) {
+  const SkISize frame_size = SkISize::Make(100, 100);
+  fml::Thread platform_thread("platform");
+  auto platform_task_runner = platform_thread.GetTaskRunner();
+  fml::AutoResetWaitableEvent platform_blocked;
+  fml::AutoResetWaitableEvent unblock_platform;
+  size_t present_count = 0u;
+  size_t collect_count = 0u;
+  {
+    EmbedderExternalViewEmbedder view_embedder(
+        /*avoid_backing_store_cache=*/true,
+        /*backing_stores_preserve_contents=*/false,
+        /*backing_store_size_granularity=*/0u,
+        /*backing_store_cache_pixel_budget=*/0u,
+        [&](GrDirectContext* context,
+            const FlutterBackingStoreConfig& config) {
+          FlutterBackingStore backing_store = {};
+          backing_store.struct_size = sizeof(backing_store);
+          backing_store.type = kFlutterBackingStoreTypeSoftware;
+          return std::make_unique<EmbedderRenderTarget>(
+              backing_store,
+              SkSurface::MakeRasterN32Premul(config.size.width,
+                                             config.size.height),
+              [&collect_count]() { collect_count++; });
+        },
+        [&present_count](const std::vector<const FlutterLayer*>& layers) {
+          present_count++;
+          return true;
+        });
+    view_embedder.SetPresentLayersOnPlatformThread(true);
+    view_embedder.SetPlatformTaskRunner(platform_task_runner);
+    ExternalViewEmbedder& embedder = view_embedder;
+
+    // Keep the platform thread from presenting until the embedder is gone.
+    platform_task_runner->PostTask([&]() {
+      platform_blocked.Signal();
+      unblock_platform.Wait();
+    });
+    platform_blocked.Wait();
+
+    embedder.BeginFrame(frame_size, nullptr, 1.0, nullptr);
+    embedder.GetRootCanvas()->DrawRect(SkRect::Make(frame_size),
+                                       DlPaint(DlColor::kRed()));
+    embedder.SubmitFrame(
+        nullptr, std::make_unique<SurfaceFrame>(
+                     nullptr, SurfaceFrame::FramebufferInfo{},
+                     [](const SurfaceFrame&, DlCanvas*) { return true; },
+                     frame_size));
+    // The uncached render target is kept for the pending presentation.
+    EXPECT_EQ(collect_count, 0u);
+  }
+  unblock_platform.Signal();
+
+  fml::AutoResetWaitableEvent flushed;
+  platform_task_runner->PostTask([&flushed]() { flushed.Signal(); });
+  flushed.Wait();
+  EXPECT_EQ(present_count, 0u);
+  EXPECT_EQ(collect_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_headless_frame_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+EmbedderHeadlessFrameRing::EmbedderHeadlessFrameRing(
+    size_t target_count,
+    fml::TimeDelta frame_interval,
+    bool faster_than_real_time,
+    FrameCallback frame_callback)
+    : frame_interval_(frame_interval),
+      faster_than_real_time_(faster_than_real_time),
+      frame_callback_(std::move(frame_callback)),
+      targets_(target_count > 0u ? target_count : kDefaultTargetCount),
+      next_frame_start_time_(fml::TimePoint::Now()) {
+  FML_DCHECK(frame_interval_ > fml::TimeDelta::Zero());
+  FML_DCHECK(frame_callback_);
+}
+
+EmbedderHeadlessFrameRing::~EmbedderHeadlessFrameRing() = default;
+
+std::pair<fml::TimePoint, fml::TimePoint>
+EmbedderHeadlessFrameRing::GetNextFrameTimes() {
+  std::scoped_lock lock(mutex_);
+  if (!faster_than_real_time_) {
+    const auto now = fml::TimePoint::Now();
+    if (next_frame_start_time_ < now) {
+      const int64_t missed_frames =
+          (now - next_frame_start_time_).ToNanoseconds() /
+          frame_interval_.ToNanoseconds();
+      next_frame_start_time_ =
+          next_frame_start_time_ + frame_interval_ * missed_frames;
+    }
+  }
+  const auto frame_start_time = next_frame_start_time_;
+  next_frame_start_time_ = frame_start_time + frame_interval_;
+  return {frame_start_time, next_frame_start_time_};
+}
+
+bool EmbedderHeadlessFrameRing::PresentFrame(
+    const void* allocation,
+    size_t row_bytes,
+    size_t height,
+    fml::TimePoint frame_target_time) {
+  TRACE_EVENT0("flutter", "EmbedderHeadlessFrameRing::PresentFrame");
+  Frame frame;
+  Target* target = nullptr;
+  {
+    std::unique_lock lock(mutex_);
+    auto free_target = targets_.end();
+    target_released_.wait(lock, [&]() {
+      free_target = std::find_if(
+          targets_.begin(), targets_.end(),
+          [](const Target& target) { return !target.owned_by_embedder; });
+      return shutdown_ || free_target != targets_.end();
+    });
+    if (shutdown_) {
+      return false;
+    }
+    target = &*free_target;
+    target->owned_by_embedder = true;
+    frame.target_index = free_target - targets_.begin();
+    frame.frame_number = next_frame_number_++;
+  }
+
+  // Only the owner of a target touches its pixels, so it is filled in without
+  // holding the lock.
+  target->pixels.resize(row_bytes * height);
+  std::memcpy(target->pixels.data(), allocation, target->pixels.size());
+
+  frame.frame_target_time = frame_target_time;
+  frame.allocation = target->pixels.data();
+  frame.row_bytes = row_bytes;
+  frame.height = height;
+  frame_callback_(frame);
+  return true;
+}
+
+bool EmbedderHeadlessFrameRing::ReleaseTarget(size_t target_index) {
+  {
+    std::scoped_lock lock(mutex_);
+    if (target_index >= targets_.size() ||
+        !targets_[target_index].owned_by_embedder) {
+      return false;
+    }
+    targets_[target_index].owned_by_embedder = false;
+  }
+  target_released_.notify_all();
+  return true;
+}
+
+void EmbedderHeadlessFrameRing::Shutdown() {
+  {
+    std::scoped_lock lock(mutex_);
+    shutdown_ = true;
+  }
+  target_released_.notify_all();
+}
+
+}  // namespace flutter
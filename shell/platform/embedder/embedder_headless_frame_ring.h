@@ -0,0 +1,124 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_HEADLESS_FRAME_RING_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_HEADLESS_FRAME_RING_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The clock and the offscreen targets of an engine that renders
+///             without presenting, for use as a rendering service.
+///
+///             Frames are paced by a clock of their own at the requested
+///             rate, which can run ahead of real time. Each frame the engine
+///             renders is copied into a free target of the ring and streamed
+///             to the embedder, which owns the target until it releases it.
+///             If all targets are owned by the embedder, the raster thread
+///             waits for one to be released, which in turn holds back the
+///             frames of the UI thread.
+///
+class EmbedderHeadlessFrameRing {
+ public:
+  //----------------------------------------------------------------------------
+  /// The number of targets used if none is specified.
+  ///
+  static constexpr size_t kDefaultTargetCount = 3u;
+
+  struct Frame {
+    size_t target_index = 0u;
+    uint64_t frame_number = 0u;
+    fml::TimePoint frame_target_time;
+    const void* allocation = nullptr;
+    size_t row_bytes = 0u;
+    size_t height = 0u;
+  };
+
+  using FrameCallback = std::function<void(const Frame& frame)>;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  target_count           The number of targets, the default if
+  ///                                    zero.
+  /// @param[in]  frame_interval         The time between two frames.
+  /// @param[in]  faster_than_real_time  Whether frames are begun as soon as
+  ///                                    the engine is ready for them, instead
+  ///                                    of once their time has come.
+  /// @param[in]  frame_callback         Called on the raster thread with
+  ///                                    each frame once it has been copied
+  ///                                    into its target.
+  ///
+  EmbedderHeadlessFrameRing(size_t target_count,
+                            fml::TimeDelta frame_interval,
+                            bool faster_than_real_time,
+                            FrameCallback frame_callback);
+
+  ~EmbedderHeadlessFrameRing();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The start and target time of the next frame. Frames follow
+  ///             each other one interval apart. Frames that are paced by real
+  ///             time skip the intervals that have passed already.
+  ///
+  std::pair<fml::TimePoint, fml::TimePoint> GetNextFrameTimes();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Copies the frame into a free target and streams it to the
+  ///             embedder, waiting for a target to be released if none is
+  ///             free.
+  ///
+  /// @return     Whether the frame was streamed, which it isn't once the ring
+  ///             has been shut down.
+  ///
+  bool PresentFrame(const void* allocation,
+                    size_t row_bytes,
+                    size_t height,
+                    fml::TimePoint frame_target_time);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Hands the target of a streamed frame back to the ring. Can be
+  ///             called on any thread.
+  ///
+  /// @return     Whether the target was owned by the embedder.
+  ///
+  bool ReleaseTarget(size_t target_index);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Stops streaming frames, and wakes up the raster thread if it
+  ///             waits for a target, so that the engine can shut down while
+  ///             the embedder still owns targets.
+  ///
+  void Shutdown();
+
+ private:
+  struct Target {
+    std::vector<uint8_t> pixels;
+    bool owned_by_embedder = false;
+  };
+
+  const fml::TimeDelta frame_interval_;
+  const bool faster_than_real_time_;
+  const FrameCallback frame_callback_;
+  std::mutex mutex_;
+  std::condition_variable target_released_;
+  std::vector<Target> targets_;
+  fml::TimePoint next_frame_start_time_;
+  uint64_t next_frame_number_ = 0u;
+  bool shutdown_ = false;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderHeadlessFrameRing);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_HEADLESS_FRAME_RING_H_
@@ -0,0 +1,89 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_headless_frame_ring.h"
+
+#include <thread>
+
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(EmbedderHeadlessFrameRingTest, RunsAheadOfRealTime) {
+  const auto interval = fml::TimeDelta::FromSeconds(1);
+  EmbedderHeadlessFrameRing ring(0u, interval, true, [](const auto& frame) {});
+
+  const auto [first_start, first_target] = ring.GetNextFrameTimes();
+  EXPECT_EQ(first_target - first_start, interval);
+  for (int i = 1; i < 10; i++) {
+    const auto [start, target] = ring.GetNextFrameTimes();
+    EXPECT_EQ(start, first_start + interval * i);
+    EXPECT_EQ(target, start + interval);
+  }
+  // Ten seconds of frames didn't take ten seconds.
+  EXPECT_GT(first_start + interval * 9, fml::TimePoint::Now());
+}
+
+TEST(EmbedderHeadlessFrameRingTest, StreamsFramesIntoFreeTargets) {
+  std::vector<EmbedderHeadlessFrameRing::Frame> frames;
+  std::vector<uint32_t> first_pixels;
+  EmbedderHeadlessFrameRing ring(
+      2u, fml::TimeDelta::FromMilliseconds(16), true,
+      [&](const EmbedderHeadlessFrameRing::Frame& frame) {
+        frames.push_back(frame);
+        first_pixels.push_back(
+            *static_cast<const uint32_t*>(frame.allocation));
+      });
+
+  const uint32_t pixels[] = {1u, 2u, 3u, 4u};
+  const auto frame_time = fml::TimePoint::FromEpochDelta(
+      fml::TimeDelta::FromMilliseconds(32));
+  ASSERT_TRUE(ring.PresentFrame(&pixels[0], 8u, 1u, frame_time));
+  ASSERT_TRUE(ring.PresentFrame(&pixels[2], 8u, 1u, frame_time));
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0].target_index, 0u);
+  EXPECT_EQ(frames[1].target_index, 1u);
+  EXPECT_EQ(frames[1].frame_number, 1u);
+  EXPECT_EQ(frames[1].frame_target_time, frame_time);
+  EXPECT_EQ(first_pixels, (std::vector<uint32_t>{1u, 3u}));
+  // The frames were copied out of the backing store.
+  EXPECT_NE(frames[0].allocation, &pixels[0]);
+
+  // The third frame waits for a target to be released.
+  fml::AutoResetWaitableEvent presented;
+  std::thread raster_thread([&]() {
+    EXPECT_TRUE(ring.PresentFrame(&pixels[1], 4u, 1u, frame_time));
+    presented.Signal();
+  });
+  EXPECT_TRUE(presented.WaitWithTimeout(fml::TimeDelta::FromMilliseconds(50)));
+  EXPECT_TRUE(ring.ReleaseTarget(1u));
+  presented.Wait();
+  raster_thread.join();
+  ASSERT_EQ(frames.size(), 3u);
+  EXPECT_EQ(frames[2].target_index, 1u);
+  EXPECT_EQ(first_pixels[2], 2u);
+
+  EXPECT_TRUE(ring.ReleaseTarget(1u));
+  EXPECT_FALSE(ring.ReleaseTarget(1u));
+  EXPECT_FALSE(ring.ReleaseTarget(2u));
+}
+
+TEST(EmbedderHeadlessFrameRingTest, ShutdownStopsWaitingForTargets) {
+  EmbedderHeadlessFrameRing ring(1u, fml::TimeDelta::FromMilliseconds(16),
+                                 true, [](const auto& frame) {});
+  const uint32_t pixel = 0u;
+  ASSERT_TRUE(ring.PresentFrame(&pixel, 4u, 1u, fml::TimePoint::Now()));
+
+  std::thread raster_thread([&]() {
+    EXPECT_FALSE(ring.PresentFrame(&pixel, 4u, 1u, fml::TimePoint::Now()));
+  });
+  ring.Shutdown();
+  raster_thread.join();
+  EXPECT_FALSE(ring.PresentFrame(&pixel, 4u, 1u, fml::TimePoint::Now()));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -17,7 +17,9 @@ EmbedderLayers::EmbedderLayers(SkISize frame_size,
 
 EmbedderLayers::~EmbedderLayers() = default;
 
-void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
+void EmbedderLayers::PushBackingStoreLayer(
+    const FlutterBackingStore* store,
+    const std::optional<std::vector<SkIRect>>& damage) {
   FlutterLayer layer = {};
 
   layer.struct_size = sizeof(FlutterLayer);
@@ -35,6 +37,24 @@ void EmbedderLayers::PushBackingStoreLayer(const FlutterBackingStore* store) {
   layer.size.width = transformed_layer_bounds.width();
   layer.size.height = transformed_layer_bounds.height();
 
+  if (damage.has_value()) {
+    auto rects = std::make_unique<std::vector<FlutterRect>>();
+    rects->reserve(damage->size());
+    for (const SkIRect& rect : *damage) {
+      rects->push_back({static_cast<double>(rect.left()),
+                        static_cast<double>(rect.top()),
+                        static_cast<double>(rect.right()),
+                        static_cast<double>(rect.bottom())});
+    }
+    auto layer_damage = std::make_unique<FlutterDamage>();
+    layer_damage->struct_size = sizeof(FlutterDamage);
+    layer_damage->num_rects = rects->size();
+    layer_damage->damage = rects->data();
+    layer.backing_store_damage = layer_damage.get();
+    damage_rects_referenced_.push_back(std::move(rects));
+    damage_referenced_.push_back(std::move(layer_damage));
+  }
+
   presented_layers_.push_back(layer);
 }
 
@@ -102,14 +122,13 @@ static std::unique_ptr<FlutterPlatformViewMutation> ConvertMutation(
 
 void EmbedderLayers::PushPlatformViewLayer(
     FlutterPlatformViewIdentifier identifier,
-    const EmbeddedViewParams& params) {
+    const EmbeddedViewParams& params,
+    const MutatorsStack& mutators) {
   {
     FlutterPlatformView view = {};
     view.struct_size = sizeof(FlutterPlatformView);
     view.identifier = identifier;
 
-    const auto& mutators = params.mutatorsStack();
-
     std::vector<const FlutterPlatformViewMutation*> mutations_array;
 
     for (auto i = mutators.Bottom(); i != mutators.Top(); ++i) {
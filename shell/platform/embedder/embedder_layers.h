@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_FLUTTER_LAYERS_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "flutter/flow/embedded_views.h"
@@ -24,10 +25,23 @@ class EmbedderLayers {
 
   ~EmbedderLayers();
 
-  void PushBackingStoreLayer(const FlutterBackingStore* store);
+  //----------------------------------------------------------------------------
+  /// @param[in]  store   The backing store the layer was rendered into.
+  /// @param[in]  damage  The rects of the backing store that changed since it
+  ///                     was last presented, or nullopt if all of it changed.
+  ///
+  void PushBackingStoreLayer(
+      const FlutterBackingStore* store,
+      const std::optional<std::vector<SkIRect>>& damage);
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  mutators  The mutators to convert to the mutations of the
+  ///                       platform view, which are those of `params` unless
+  ///                       they were flattened.
+  ///
   void PushPlatformViewLayer(FlutterPlatformViewIdentifier identifier,
-                             const EmbeddedViewParams& params);
+                             const EmbeddedViewParams& params,
+                             const MutatorsStack& mutators);
 
   using PresentCallback =
       std::function<bool(const std::vector<const FlutterLayer*>& layers)>;
@@ -42,6 +56,9 @@ class EmbedderLayers {
       mutations_referenced_;
   std::vector<std::unique_ptr<std::vector<const FlutterPlatformViewMutation*>>>
       mutations_arrays_referenced_;
+  std::vector<std::unique_ptr<std::vector<FlutterRect>>>
+      damage_rects_referenced_;
+  std::vector<std::unique_ptr<FlutterDamage>> damage_referenced_;
   std::vector<FlutterLayer> presented_layers_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderLayers);
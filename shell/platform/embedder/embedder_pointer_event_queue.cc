@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_pointer_event_queue.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1u;
+  while (result < value) {
+    result <<= 1u;
+  }
+  return result;
+}
+
+// Whether the event only updates the position of a device, so that it can be
+// replaced by a later one. The deltas are computed from the positions after
+// the events are drained.
+bool IsCoalescable(const PointerData& data) {
+  if (data.signal_kind != PointerData::SignalKind::kNone) {
+    return false;
+  }
+  switch (data.change) {
+    case PointerData::Change::kMove:
+    case PointerData::Change::kHover:
+    case PointerData::Change::kPanZoomUpdate:
+      return true;
+    case PointerData::Change::kCancel:
+    case PointerData::Change::kAdd:
+    case PointerData::Change::kRemove:
+    case PointerData::Change::kDown:
+    case PointerData::Change::kUp:
+    case PointerData::Change::kPanZoomStart:
+    case PointerData::Change::kPanZoomEnd:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace
+
+EmbedderPointerEventQueue::EmbedderPointerEventQueue(
+    size_t capacity,
+    fml::TimeDelta coalescing_interval)
+    : mask_(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2u)) - 1u),
+      coalescing_interval_us_(coalescing_interval.ToMicroseconds()),
+      cells_(std::make_unique<Cell[]>(mask_ + 1u)) {
+  for (size_t i = 0; i <= mask_; i++) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+EmbedderPointerEventQueue::~EmbedderPointerEventQueue() = default;
+
+bool EmbedderPointerEventQueue::Push(const PointerData& data) {
+  // Claim the next cell whose previous event has been popped, and publish the
+  // event by bumping the sequence of the cell once it has been written.
+  size_t position = push_position_.load(std::memory_order_relaxed);
+  Cell* cell = nullptr;
+  for (;;) {
+    cell = &cells_[position & mask_];
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<intptr_t>(sequence) -
+                            static_cast<intptr_t>(position);
+    if (difference == 0) {
+      if (push_position_.compare_exchange_weak(position, position + 1u,
+                                               std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      // The queue is full.
+      return false;
+    } else {
+      position = push_position_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->data = data;
+  cell->sequence.store(position + 1u, std::memory_order_release);
+  return true;
+}
+
+bool EmbedderPointerEventQueue::ClaimDrain() {
+  return !drain_claimed_.exchange(true, std::memory_order_acq_rel);
+}
+
+bool EmbedderPointerEventQueue::Pop(PointerData& data) {
+  Cell& cell = cells_[pop_position_ & mask_];
+  if (cell.sequence.load(std::memory_order_acquire) != pop_position_ + 1u) {
+    // The queue is empty, or the next event is still being written, in which
+    // case it is popped by the next drain.
+    return false;
+  }
+  data = cell.data;
+  cell.sequence.store(pop_position_ + mask_ + 1u, std::memory_order_release);
+  pop_position_++;
+  return true;
+}
+
+std::unique_ptr<PointerDataPacket> EmbedderPointerEventQueue::Drain() {
+  TRACE_EVENT0("flutter", "EmbedderPointerEventQueue::Drain");
+  // Events pushed from here on claim another drain, so none are left behind.
+  drain_claimed_.store(false, std::memory_order_release);
+  last_drain_time_.store(fml::TimePoint::Now().ToEpochDelta().ToNanoseconds(),
+                         std::memory_order_relaxed);
+
+  std::vector<PointerData> events;
+  PointerData data;
+  while (Pop(data)) {
+    events.push_back(data);
+  }
+  if (events.empty()) {
+    return nullptr;
+  }
+  if (coalescing_interval_us_ > 0) {
+    Coalesce(events);
+  }
+
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+fml::TimePoint EmbedderPointerEventQueue::GetLastDrainTime() const {
+  return fml::TimePoint::FromEpochDelta(fml::TimeDelta::FromNanoseconds(
+      last_drain_time_.load(std::memory_order_relaxed)));
+}
+
+void EmbedderPointerEventQueue::Coalesce(
+    std::vector<PointerData>& events) const {
+  struct Run {
+    size_t index;
+    int64_t start_time_stamp;
+  };
+  // The coalescable event of each device that later ones may replace.
+  std::unordered_map<int64_t, Run> runs;
+  size_t count = 0u;
+  for (size_t i = 0; i < events.size(); i++) {
+    const PointerData event = events[i];
+    auto run = runs.find(event.device);
+    if (!IsCoalescable(event)) {
+      if (run != runs.end()) {
+        runs.erase(run);
+      }
+      events[count++] = event;
+      continue;
+    }
+    if (run != runs.end()) {
+      PointerData& last = events[run->second.index];
+      if (last.change == event.change && last.kind == event.kind &&
+          last.buttons == event.buttons &&
+          event.time_stamp - run->second.start_time_stamp <
+              coalescing_interval_us_) {
+        last = event;
+        continue;
+      }
+    }
+    runs[event.device] = {count, event.time_stamp};
+    events[count++] = event;
+  }
+  FML_DCHECK(count <= events.size());
+  events.resize(count);
+}
+
+}  // namespace flutter
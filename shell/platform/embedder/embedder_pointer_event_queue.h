@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_POINTER_EVENT_QUEUE_H_
+#define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_POINTER_EVENT_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/window/pointer_data.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A bounded queue of pointer events that embedders may push to
+///             from any thread without taking locks. The events are drained
+///             by a single thread into one packet, which saves posting a
+///             packet and a UI task for every event of high rate input
+///             devices.
+///
+///             Moves and hovers of a device that arrive in quick succession
+///             can be coalesced into the latest one of them, so that the
+///             framework sees at most one every coalescing interval.
+///
+class EmbedderPointerEventQueue {
+ public:
+  static constexpr size_t kDefaultCapacity = 4096u;
+
+  //----------------------------------------------------------------------------
+  /// @param[in]  capacity              The number of events the queue holds,
+  ///                                   rounded up to a power of two.
+  /// @param[in]  coalescing_interval   The time that coalesced events of a
+  ///                                   device span at most. Events aren't
+  ///                                   coalesced if it is zero.
+  ///
+  EmbedderPointerEventQueue(size_t capacity,
+                            fml::TimeDelta coalescing_interval);
+
+  ~EmbedderPointerEventQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pushes the event. Can be called on any thread.
+  ///
+  /// @return     Whether the event was pushed, which it isn't if the queue
+  ///             is full.
+  ///
+  bool Push(const PointerData& data);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Claims the drain of the events pushed since the last drain.
+  ///             Can be called on any thread.
+  ///
+  /// @return     Whether the caller should schedule a drain, which only one
+  ///             caller is told until the drain has started.
+  ///
+  bool ClaimDrain();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Pops all of the queued events into one packet, coalescing
+  ///             them if requested. Must only be called on one thread at a
+  ///             time.
+  ///
+  /// @return     The packet, or nullptr if the queue was empty.
+  ///
+  std::unique_ptr<PointerDataPacket> Drain();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The time the last drain started at. Can be called on any
+  ///             thread.
+  ///
+  fml::TimePoint GetLastDrainTime() const;
+
+ private:
+  struct Cell {
+    std::atomic_size_t sequence;
+    PointerData data;
+  };
+
+  const size_t mask_;
+  const int64_t coalescing_interval_us_;
+  std::unique_ptr<Cell[]> cells_;
+  std::atomic_size_t push_position_{0u};
+  size_t pop_position_ = 0u;
+  std::atomic_bool drain_claimed_{false};
+  std::atomic<int64_t> last_drain_time_{0};
+
+  bool Pop(PointerData& data);
+
+  void Coalesce(std::vector<PointerData>& events) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EmbedderPointerEventQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_POINTER_EVENT_QUEUE_H_
@@ -0,0 +1,135 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_pointer_event_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+PointerData CreatePointerData(int64_t device,
+                              PointerData::Change change,
+                              int64_t time_stamp,
+                              double x = 0.0) {
+  PointerData data;
+  data.Clear();
+  data.device = device;
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.time_stamp = time_stamp;
+  data.physical_x = x;
+  return data;
+}
+
+std::vector<PointerData> Unpack(const PointerDataPacket& packet) {
+  std::vector<PointerData> events(packet.GetLength());
+  for (size_t i = 0; i < events.size(); i++) {
+    events[i] = packet.GetPointerData(i);
+  }
+  return events;
+}
+
+}  // namespace
+
+TEST(EmbedderPointerEventQueueTest, DrainsEventsInOrder) {
+  EmbedderPointerEventQueue queue(4u, fml::TimeDelta::Zero());
+  ASSERT_EQ(queue.Drain(), nullptr);
+
+  ASSERT_TRUE(queue.ClaimDrain());
+  for (int64_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.Push(
+        CreatePointerData(0, PointerData::Change::kMove, i, i * 10.0)));
+  }
+  // The queue is full, and the drain has been claimed already.
+  ASSERT_FALSE(queue.Push(CreatePointerData(0, PointerData::Change::kUp, 4)));
+  ASSERT_FALSE(queue.ClaimDrain());
+
+  auto packet = queue.Drain();
+  ASSERT_NE(packet, nullptr);
+  auto events = Unpack(*packet);
+  ASSERT_EQ(events.size(), 4u);
+  for (int64_t i = 0; i < 4; i++) {
+    EXPECT_EQ(events[i].time_stamp, i);
+    EXPECT_EQ(events[i].physical_x, i * 10.0);
+  }
+
+  // The cells are reused once drained.
+  ASSERT_TRUE(queue.ClaimDrain());
+  ASSERT_TRUE(queue.Push(CreatePointerData(0, PointerData::Change::kUp, 4)));
+  packet = queue.Drain();
+  ASSERT_NE(packet, nullptr);
+  ASSERT_EQ(packet->GetLength(), 1u);
+  ASSERT_EQ(packet->GetPointerData(0).change, PointerData::Change::kUp);
+}
+
+TEST(EmbedderPointerEventQueueTest, AcceptsEventsFromManyThreads) {
+  constexpr int64_t kThreadCount = 4;
+  constexpr int64_t kEventCount = 1000;
+  EmbedderPointerEventQueue queue(kThreadCount * kEventCount,
+                                  fml::TimeDelta::Zero());
+  std::vector<std::thread> threads;
+  for (int64_t device = 0; device < kThreadCount; device++) {
+    threads.emplace_back([&queue, device]() {
+      for (int64_t i = 0; i < kEventCount; i++) {
+        ASSERT_TRUE(queue.Push(
+            CreatePointerData(device, PointerData::Change::kMove, i)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto packet = queue.Drain();
+  ASSERT_NE(packet, nullptr);
+  auto events = Unpack(*packet);
+  ASSERT_EQ(events.size(), static_cast<size_t>(kThreadCount * kEventCount));
+  // The events of each thread keep their order.
+  std::vector<int64_t> next_time_stamps(kThreadCount, 0);
+  for (const auto& event : events) {
+    ASSERT_EQ(event.time_stamp, next_time_stamps[event.device]++);
+  }
+}
+
+TEST(EmbedderPointerEventQueueTest, CoalescesMovesWithinTheInterval) {
+  EmbedderPointerEventQueue queue(64u, fml::TimeDelta::FromMicroseconds(4));
+  const std::vector<PointerData> pushed = {
+      CreatePointerData(0, PointerData::Change::kDown, 0, 0.0),
+      CreatePointerData(0, PointerData::Change::kMove, 1, 1.0),
+      CreatePointerData(1, PointerData::Change::kMove, 1, 100.0),
+      CreatePointerData(0, PointerData::Change::kMove, 2, 2.0),
+      CreatePointerData(0, PointerData::Change::kMove, 4, 4.0),
+      // Outside of the interval of the coalesced move at 1.
+      CreatePointerData(0, PointerData::Change::kMove, 5, 5.0),
+      CreatePointerData(1, PointerData::Change::kMove, 3, 103.0),
+      CreatePointerData(0, PointerData::Change::kMove, 6, 6.0),
+      // Up isn't coalesced, and ends the run of moves.
+      CreatePointerData(0, PointerData::Change::kUp, 7, 7.0),
+      CreatePointerData(0, PointerData::Change::kHover, 8, 8.0),
+  };
+  for (const auto& data : pushed) {
+    ASSERT_TRUE(queue.Push(data));
+  }
+
+  auto packet = queue.Drain();
+  ASSERT_NE(packet, nullptr);
+  auto events = Unpack(*packet);
+  const std::vector<std::pair<int64_t, double>> expected = {
+      {0, 0.0}, {0, 4.0}, {1, 103.0}, {0, 6.0}, {0, 7.0}, {0, 8.0},
+  };
+  ASSERT_EQ(events.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(events[i].device, expected[i].first) << "Event " << i;
+    EXPECT_EQ(events[i].physical_x, expected[i].second) << "Event " << i;
+  }
+}
+
+}  // namespace testing
+}  // namespace flutter
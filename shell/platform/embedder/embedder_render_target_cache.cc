@@ -4,70 +4,142 @@
 
 #include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
 
+#include <iterator>
+
 namespace flutter {
 
-EmbedderRenderTargetCache::EmbedderRenderTargetCache() = default;
+static SkISize GetSurfaceSize(const EmbedderRenderTarget& target) {
+  auto surface = target.GetRenderSurface();
+  return SkISize::Make(surface->width(), surface->height());
+}
+
+EmbedderRenderTargetCache::EmbedderRenderTargetCache()
+    : EmbedderRenderTargetCache(0u, 0u) {}
+
+EmbedderRenderTargetCache::EmbedderRenderTargetCache(
+    size_t size_granularity,
+    size_t retained_pixel_budget)
+    : size_granularity_(size_granularity),
+      retained_pixel_budget_(retained_pixel_budget) {}
 
 EmbedderRenderTargetCache::~EmbedderRenderTargetCache() = default;
 
-std::pair<EmbedderRenderTargetCache::RenderTargets,
-          EmbedderExternalView::ViewIdentifierSet>
+SkISize EmbedderRenderTargetCache::GetRenderTargetSize(
+    const SkISize& render_surface_size) const {
+  if (size_granularity_ == 0u) {
+    return render_surface_size;
+  }
+  const auto round_up = [granularity = static_cast<int64_t>(
+                             size_granularity_)](int32_t length) {
+    return static_cast<int32_t>((length + granularity - 1) / granularity *
+                                granularity);
+  };
+  return SkISize::Make(round_up(render_surface_size.width()),
+                       round_up(render_surface_size.height()));
+}
+
+std::tuple<EmbedderRenderTargetCache::RenderTargets,
+           EmbedderExternalView::ViewIdentifierSet,
+           EmbedderExternalView::ViewIdentifierSet>
 EmbedderRenderTargetCache::GetExistingTargetsInCache(
     const EmbedderExternalView::PendingViews& pending_views) {
   RenderTargets resolved_render_targets;
   EmbedderExternalView::ViewIdentifierSet unmatched_identifiers;
+  EmbedderExternalView::ViewIdentifierSet reused_identifiers;
+
+  auto take_target = [&](const EmbedderExternalView::ViewIdentifier& view_id,
+                         const SkISize& size, bool same_view_only) -> bool {
+    // The most recently cached targets are preferred, as the least recently
+    // cached ones are the first to go over the budget.
+    for (auto it = cached_render_targets_.rbegin();
+         it != cached_render_targets_.rend(); ++it) {
+      if (same_view_only && !EmbedderExternalView::ViewIdentifier::Equal{}(
+                                it->view_identifier, view_id)) {
+        continue;
+      }
+      if (GetSurfaceSize(*it->target) != size) {
+        continue;
+      }
+      resolved_render_targets[view_id] = std::move(it->target);
+      cached_render_targets_.erase(std::next(it).base());
+      return true;
+    }
+    return false;
+  };
 
+  // Views first take back the targets they were rendered into, so that the
+  // targets that still hold their contents aren't handed to other views.
   for (const auto& view : pending_views) {
     const auto& external_view = view.second;
     if (!external_view->HasEngineRenderedContents()) {
       continue;
     }
-    auto& compatible_targets =
-        cached_render_targets_[external_view->CreateRenderTargetDescriptor()];
-    if (compatible_targets.empty()) {
+    const auto size =
+        GetRenderTargetSize(external_view->GetRenderSurfaceSize());
+    if (take_target(view.first, size, true)) {
+      reused_identifiers.insert(view.first);
+    } else {
       unmatched_identifiers.insert(view.first);
+    }
+  }
+
+  // The remaining views may use the target of any view of the same size.
+  for (auto it = unmatched_identifiers.begin();
+       it != unmatched_identifiers.end();) {
+    const auto size =
+        GetRenderTargetSize(pending_views.at(*it)->GetRenderSurfaceSize());
+    if (take_target(*it, size, false)) {
+      it = unmatched_identifiers.erase(it);
     } else {
-      std::unique_ptr<EmbedderRenderTarget> target =
-          std::move(compatible_targets.top());
-      compatible_targets.pop();
-      resolved_render_targets[view.first] = std::move(target);
+      ++it;
     }
   }
-  return {std::move(resolved_render_targets), std::move(unmatched_identifiers)};
+
+  return {std::move(resolved_render_targets), std::move(unmatched_identifiers),
+          std::move(reused_identifiers)};
 }
 
 std::set<std::unique_ptr<EmbedderRenderTarget>>
 EmbedderRenderTargetCache::ClearAllRenderTargetsInCache() {
   std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
-  for (auto& targets : cached_render_targets_) {
-    auto& targets_stack = targets.second;
-    while (!targets_stack.empty()) {
-      cleared_targets.emplace(std::move(targets_stack.top()));
-      targets_stack.pop();
-    }
+  for (auto& cached : cached_render_targets_) {
+    cleared_targets.emplace(std::move(cached.target));
   }
   cached_render_targets_.clear();
   return cleared_targets;
 }
 
+std::set<std::unique_ptr<EmbedderRenderTarget>>
+EmbedderRenderTargetCache::ClearRenderTargetsOverBudget() {
+  std::set<std::unique_ptr<EmbedderRenderTarget>> cleared_targets;
+  size_t retained_pixels = 0u;
+  for (auto it = cached_render_targets_.rbegin();
+       it != cached_render_targets_.rend();) {
+    const auto size = GetSurfaceSize(*it->target);
+    const size_t pixels = static_cast<size_t>(size.width()) * size.height();
+    if (retained_pixels + pixels <= retained_pixel_budget_) {
+      retained_pixels += pixels;
+      ++it;
+      continue;
+    }
+    cleared_targets.emplace(std::move(it->target));
+    it = std::make_reverse_iterator(
+        cached_render_targets_.erase(std::next(it).base()));
+  }
+  return cleared_targets;
+}
+
 void EmbedderRenderTargetCache::CacheRenderTarget(
     EmbedderExternalView::ViewIdentifier view_identifier,
     std::unique_ptr<EmbedderRenderTarget> target) {
   if (target == nullptr) {
     return;
   }
-  auto surface = target->GetRenderSurface();
-  auto desc = EmbedderExternalView::RenderTargetDescriptor{
-      view_identifier, SkISize::Make(surface->width(), surface->height())};
-  cached_render_targets_[desc].push(std::move(target));
+  cached_render_targets_.push_back({view_identifier, std::move(target)});
 }
 
 size_t EmbedderRenderTargetCache::GetCachedTargetsCount() const {
-  size_t count = 0;
-  for (const auto& targets : cached_render_targets_) {
-    count += targets.second.size();
-  }
-  return count;
+  return cached_render_targets_.size();
 }
 
 }  // namespace flutter
@@ -5,8 +5,8 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_RENDER_TARGET_CACHE_H_
 
+#include <list>
 #include <set>
-#include <stack>
 #include <tuple>
 #include <unordered_map>
 
@@ -19,10 +19,30 @@ namespace flutter {
 /// @brief      A cache used to reference render targets that are owned by the
 ///             embedder but needed by th engine to render a frame.
 ///
+///             Render targets are shared by all views of the same render
+///             target size, though a view gets the target it was rendered
+///             into before if that is still cached.
+///
 class EmbedderRenderTargetCache {
  public:
   EmbedderRenderTargetCache();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Creates a render target cache.
+  ///
+  /// @param[in]  size_granularity       If not zero, render targets are sized
+  ///                                    up to a multiple of it, so that views
+  ///                                    whose size changes by less keep their
+  ///                                    targets. Views are rendered into the
+  ///                                    top left of their targets.
+  /// @param[in]  retained_pixel_budget  The number of pixels of the render
+  ///                                    targets unused by a frame that are
+  ///                                    kept for the frames after it, most
+  ///                                    recently used first.
+  ///
+  EmbedderRenderTargetCache(size_t size_granularity,
+                            size_t retained_pixel_budget);
+
   ~EmbedderRenderTargetCache();
 
   using RenderTargets =
@@ -31,26 +51,51 @@ class EmbedderRenderTargetCache {
                          EmbedderExternalView::ViewIdentifier::Hash,
                          EmbedderExternalView::ViewIdentifier::Equal>;
 
-  std::pair<RenderTargets, EmbedderExternalView::ViewIdentifierSet>
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the cached render targets the pending views can be
+  ///             rendered into out of the cache.
+  ///
+  /// @return     The render targets of the views, the views no target was
+  ///             found for, and the views whose target is the one they were
+  ///             last rendered into, which still holds those contents.
+  ///
+  std::tuple<RenderTargets,
+             EmbedderExternalView::ViewIdentifierSet,
+             EmbedderExternalView::ViewIdentifierSet>
   GetExistingTargetsInCache(
       const EmbedderExternalView::PendingViews& pending_views);
 
   std::set<std::unique_ptr<EmbedderRenderTarget>>
   ClearAllRenderTargetsInCache();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Takes the render targets that don't fit the retained pixel
+  ///             budget out of the cache, least recently used first.
+  ///
+  std::set<std::unique_ptr<EmbedderRenderTarget>>
+  ClearRenderTargetsOverBudget();
+
   void CacheRenderTarget(EmbedderExternalView::ViewIdentifier view_identifier,
                          std::unique_ptr<EmbedderRenderTarget> target);
 
   size_t GetCachedTargetsCount() const;
 
- private:
-  using CachedRenderTargets =
-      std::unordered_map<EmbedderExternalView::RenderTargetDescriptor,
-                         std::stack<std::unique_ptr<EmbedderRenderTarget>>,
-                         EmbedderExternalView::RenderTargetDescriptor::Hash,
-                         EmbedderExternalView::RenderTargetDescriptor::Equal>;
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the render target a view of the given render
+  ///             surface size is rendered into.
+  ///
+  SkISize GetRenderTargetSize(const SkISize& render_surface_size) const;
 
-  CachedRenderTargets cached_render_targets_;
+ private:
+  struct CachedRenderTarget {
+    EmbedderExternalView::ViewIdentifier view_identifier;
+    std::unique_ptr<EmbedderRenderTarget> target;
+  };
+
+  const size_t size_granularity_ = 0u;
+  const size_t retained_pixel_budget_ = 0u;
+  // The least recently cached targets come first.
+  std::list<CachedRenderTarget> cached_render_targets_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderRenderTargetCache);
 };
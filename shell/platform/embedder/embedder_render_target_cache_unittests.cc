@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_render_target_cache.h"
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using ViewIdentifier = EmbedderExternalView::ViewIdentifier;
+
+std::unique_ptr<EmbedderRenderTarget> CreateRenderTarget(
+    const SkISize& size,
+    size_t* collect_count) {
+  FlutterBackingStore backing_store = {};
+  backing_store.struct_size = sizeof(backing_store);
+  backing_store.type = kFlutterBackingStoreTypeSoftware;
+  return std::make_unique<EmbedderRenderTarget>(
+      backing_store,
+      SkSurface::MakeRasterN32Premul(size.width(), size.height()),
+      [collect_count]() { (*collect_count)++; });
+}
+
+std::unique_ptr<EmbedderExternalView> CreateView(
+    const SkISize& frame_size,
+    std::optional<int64_t> platform_view_id) {
+  std::unique_ptr<EmbedderExternalView> view;
+  if (platform_view_id.has_value()) {
+    view = std::make_unique<EmbedderExternalView>(
+        frame_size, SkMatrix{}, ViewIdentifier(platform_view_id.value()),
+        std::make_unique<EmbeddedViewParams>());
+  } else {
+    view = std::make_unique<EmbedderExternalView>(frame_size, SkMatrix{});
+  }
+  view->GetCanvas()->DrawRect(SkRect::MakeWH(10, 10), DlPaint());
+  return view;
+}
+
+}  // namespace
+
+TEST(EmbedderRenderTargetCacheTest, SharesTargetsAcrossViews) {
+  EmbedderRenderTargetCache cache(64u, 0u);
+  const SkISize frame_size = SkISize::Make(100, 90);
+  ASSERT_EQ(cache.GetRenderTargetSize(frame_size), SkISize::Make(128, 128));
+
+  size_t collect_count = 0u;
+  cache.CacheRenderTarget(ViewIdentifier(1),
+                          CreateRenderTarget({128, 128}, &collect_count));
+  cache.CacheRenderTarget(ViewIdentifier(2),
+                          CreateRenderTarget({128, 128}, &collect_count));
+
+  // The view 2 gets its own target back, the root view the one of view 1,
+  // and there is none of the size of view 3.
+  EmbedderExternalView::PendingViews pending_views;
+  pending_views[ViewIdentifier()] = CreateView(frame_size, std::nullopt);
+  pending_views[ViewIdentifier(2)] = CreateView(frame_size, 2);
+  pending_views[ViewIdentifier(3)] = CreateView({200, 200}, 3);
+  auto [targets, unmatched, reused] =
+      cache.GetExistingTargetsInCache(pending_views);
+  EXPECT_EQ(targets.size(), 2u);
+  EXPECT_EQ(targets.count(ViewIdentifier()), 1u);
+  EXPECT_EQ(targets.count(ViewIdentifier(2)), 1u);
+  EXPECT_EQ(unmatched.size(), 1u);
+  EXPECT_EQ(unmatched.count(ViewIdentifier(3)), 1u);
+  EXPECT_EQ(reused.size(), 1u);
+  EXPECT_EQ(reused.count(ViewIdentifier(2)), 1u);
+  EXPECT_EQ(cache.GetCachedTargetsCount(), 0u);
+  EXPECT_EQ(collect_count, 0u);
+}
+
+TEST(EmbedderRenderTargetCacheTest, RetainsUnusedTargetsWithinBudget) {
+  EmbedderRenderTargetCache cache(0u, 150u * 100u);
+
+  size_t collect_count = 0u;
+  cache.CacheRenderTarget(ViewIdentifier(1),
+                          CreateRenderTarget({100, 100}, &collect_count));
+  cache.CacheRenderTarget(ViewIdentifier(2),
+                          CreateRenderTarget({100, 100}, &collect_count));
+  cache.CacheRenderTarget(ViewIdentifier(3),
+                          CreateRenderTarget({50, 100}, &collect_count));
+
+  // The least recently cached target doesn't fit the budget.
+  ASSERT_EQ(cache.ClearRenderTargetsOverBudget().size(), 1u);
+  EXPECT_EQ(collect_count, 1u);
+  ASSERT_EQ(cache.GetCachedTargetsCount(), 2u);
+
+  EmbedderExternalView::PendingViews pending_views;
+  pending_views[ViewIdentifier(1)] = CreateView({100, 100}, 1);
+  auto [targets, unmatched, reused] =
+      cache.GetExistingTargetsInCache(pending_views);
+  EXPECT_EQ(targets.size(), 1u);
+  EXPECT_TRUE(reused.empty());
+
+  ASSERT_EQ(cache.ClearAllRenderTargetsInCache().size(), 1u);
+  EXPECT_EQ(collect_count, 2u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -17,12 +17,18 @@ namespace flutter {
 
 EmbedderSurfaceSoftware::EmbedderSurfaceSoftware(
     SoftwareDispatchTable software_dispatch_table,
-    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder)
+    std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+    size_t raster_thread_count)
     : software_dispatch_table_(std::move(software_dispatch_table)),
       external_view_embedder_(std::move(external_view_embedder)) {
-  if (!software_dispatch_table_.software_present_backing_store) {
+  if (!software_dispatch_table_.software_present_backing_store &&
+      !software_dispatch_table_.software_stream_backing_store) {
     return;
   }
+  // The raster thread renders tiles too, so one fewer worker is needed.
+  if (raster_thread_count > 1u) {
+    tile_loop_ = fml::ConcurrentMessageLoop::Create(raster_thread_count - 1u);
+  }
   valid_ = true;
 }
 
@@ -84,32 +90,108 @@ sk_sp<SkSurface> EmbedderSurfaceSoftware::AcquireBackingStore(
 // |GPUSurfaceSoftwareDelegate|
 bool EmbedderSurfaceSoftware::PresentBackingStore(
     sk_sp<SkSurface> backing_store) {
+  if (software_dispatch_table_.software_stream_backing_store) {
+    return PresentBackingStoreFrame(std::move(backing_store), {});
+  }
+
+  SkPixmap pixmap;
+  if (!PeekBackingStore(backing_store, &pixmap)) {
+    return false;
+  }
+
+  return software_dispatch_table_.software_present_backing_store(
+      pixmap.addr(),      //
+      pixmap.rowBytes(),  //
+      pixmap.height()     //
+  );
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::SupportsPartialPresent() const {
+  return static_cast<bool>(
+      software_dispatch_table_.software_present_backing_store_rows);
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreDamage(
+    sk_sp<SkSurface> backing_store,
+    const SkIRect& damage) {
+  if (!SupportsPartialPresent()) {
+    return PresentBackingStore(std::move(backing_store));
+  }
+
+  SkPixmap pixmap;
+  if (!PeekBackingStore(backing_store, &pixmap)) {
+    return false;
+  }
+
+  // The embedder copies whole rows, so only the rows of the damage matter.
+  SkIRect rows = damage;
+  if (!rows.intersect(pixmap.bounds())) {
+    rows.setEmpty();
+  }
+
+  return software_dispatch_table_.software_present_backing_store_rows(
+      pixmap.addr(),      //
+      pixmap.rowBytes(),  //
+      pixmap.height(),    //
+      rows.top(),         //
+      rows.height()       //
+  );
+}
+
+// |GPUSurfaceSoftwareDelegate|
+std::shared_ptr<fml::ConcurrentTaskRunner>
+EmbedderSurfaceSoftware::GetTileTaskRunner() {
+  return tile_loop_ ? tile_loop_->GetTaskRunner() : nullptr;
+}
+
+// |GPUSurfaceSoftwareDelegate|
+bool EmbedderSurfaceSoftware::PresentBackingStoreFrame(
+    sk_sp<SkSurface> backing_store,
+    const SurfaceFrame::SubmitInfo& submit_info) {
+  if (!software_dispatch_table_.software_stream_backing_store) {
+    return GPUSurfaceSoftwareDelegate::PresentBackingStoreFrame(
+        std::move(backing_store), submit_info);
+  }
+
+  SkPixmap pixmap;
+  if (!PeekBackingStore(backing_store, &pixmap)) {
+    return false;
+  }
+
+  return software_dispatch_table_.software_stream_backing_store(
+      pixmap.addr(),                  //
+      pixmap.rowBytes(),              //
+      pixmap.height(),                //
+      submit_info.frame_target_time  //
+  );
+}
+
+bool EmbedderSurfaceSoftware::PeekBackingStore(
+    const sk_sp<SkSurface>& backing_store,
+    SkPixmap* pixmap) const {
   if (!IsValid()) {
     FML_LOG(ERROR) << "Tried to present an invalid software surface.";
     return false;
   }
 
-  SkPixmap pixmap;
-  if (!backing_store->peekPixels(&pixmap)) {
+  if (!backing_store->peekPixels(pixmap)) {
     FML_LOG(ERROR) << "Could not peek the pixels of the backing store.";
     return false;
   }
 
   // Some basic sanity checking.
-  uint64_t expected_pixmap_data_size = pixmap.width() * pixmap.height() * 4;
+  uint64_t expected_pixmap_data_size = pixmap->width() * pixmap->height() * 4;
 
-  const size_t pixmap_size = pixmap.computeByteSize();
+  const size_t pixmap_size = pixmap->computeByteSize();
 
   if (expected_pixmap_data_size != pixmap_size) {
     FML_LOG(ERROR) << "Software backing store had unexpected size.";
     return false;
   }
 
-  return software_dispatch_table_.software_present_backing_store(
-      pixmap.addr(),      //
-      pixmap.rowBytes(),  //
-      pixmap.height()     //
-  );
+  return true;
 }
 
 }  // namespace flutter
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_EMBEDDER_SURFACE_SOFTWARE_H_
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "flutter/shell/gpu/gpu_surface_software.h"
 #include "flutter/shell/platform/embedder/embedder_external_view_embedder.h"
@@ -19,12 +20,25 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
  public:
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
-        software_present_backing_store;  // required
+        software_present_backing_store;  // required unless streaming
+    std::function<bool(const void* allocation,
+                       size_t row_bytes,
+                       size_t height,
+                       size_t first_row,
+                       size_t row_count)>
+        software_present_backing_store_rows;  // optional
+    // Streams frames with their target time instead of presenting them.
+    std::function<bool(const void* allocation,
+                       size_t row_bytes,
+                       size_t height,
+                       fml::TimePoint frame_target_time)>
+        software_stream_backing_store;  // optional
   };
 
   EmbedderSurfaceSoftware(
       SoftwareDispatchTable software_dispatch_table,
-      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder);
+      std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder,
+      size_t raster_thread_count = 0u);
 
   ~EmbedderSurfaceSoftware() override;
 
@@ -33,6 +47,9 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   SoftwareDispatchTable software_dispatch_table_;
   sk_sp<SkSurface> sk_surface_;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
+  // Renders frames in tiles if the embedder asked for more than one raster
+  // thread.
+  std::shared_ptr<fml::ConcurrentMessageLoop> tile_loop_;
 
   // |EmbedderSurface|
   bool IsValid() const override;
@@ -49,6 +66,24 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   // |GPUSurfaceSoftwareDelegate|
   bool PresentBackingStore(sk_sp<SkSurface> backing_store) override;
 
+  // |GPUSurfaceSoftwareDelegate|
+  bool SupportsPartialPresent() const override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreDamage(sk_sp<SkSurface> backing_store,
+                                 const SkIRect& damage) override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetTileTaskRunner() override;
+
+  // |GPUSurfaceSoftwareDelegate|
+  bool PresentBackingStoreFrame(
+      sk_sp<SkSurface> backing_store,
+      const SurfaceFrame::SubmitInfo& submit_info) override;
+
+  bool PeekBackingStore(const sk_sp<SkSurface>& backing_store,
+                        SkPixmap* pixmap) const;
+
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderSurfaceSoftware);
 };
 
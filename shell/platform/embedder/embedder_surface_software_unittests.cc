@@ -0,0 +1,70 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/embedder/embedder_surface_software.h"
+
+#include "flutter/display_list/display_list_paint.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkColor.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(EmbedderSurfaceSoftwareTest, RendersTilesAndPresentsChangedRows) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+
+  size_t full_present_count = 0u;
+  size_t first_row = 0u;
+  size_t row_count = 0u;
+  bool rendered_frame = false;
+  EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table;
+  software_dispatch_table.software_present_backing_store =
+      [&](const void* allocation, size_t row_bytes, size_t height) {
+        full_present_count++;
+        return true;
+      };
+  software_dispatch_table.software_present_backing_store_rows =
+      [&](const void* allocation, size_t row_bytes, size_t height,
+          size_t first, size_t count) {
+        first_row = first;
+        row_count = count;
+        rendered_frame = true;
+        // Every tile of the frame was rendered.
+        for (size_t y = 0; y < height; y++) {
+          const auto* row = reinterpret_cast<const SkPMColor*>(
+              static_cast<const uint8_t*>(allocation) + y * row_bytes);
+          for (size_t x = 0; x < row_bytes / sizeof(SkPMColor); x++) {
+            rendered_frame &= row[x] == SkPreMultiplyColor(SK_ColorRED);
+          }
+        }
+        return true;
+      };
+
+  std::unique_ptr<EmbedderSurface> embedder_surface =
+      std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table,
+                                                nullptr, 4u);
+  ASSERT_TRUE(embedder_surface->IsValid());
+  auto surface = embedder_surface->CreateGPUSurface();
+  ASSERT_NE(surface, nullptr);
+
+  auto frame = surface->AcquireFrame(SkISize::Make(100, 300));
+  ASSERT_NE(frame, nullptr);
+  ASSERT_TRUE(frame->framebuffer_info().supports_partial_repaint);
+  frame->Canvas()->DrawRect(SkRect::MakeWH(100, 300),
+                            DlPaint(DlColor::kRed()));
+
+  SurfaceFrame::SubmitInfo submit_info;
+  submit_info.frame_damage = SkIRect::MakeXYWH(10, 100, 20, 50);
+  frame->set_submit_info(submit_info);
+  ASSERT_TRUE(frame->Submit());
+
+  EXPECT_EQ(full_present_count, 0u);
+  EXPECT_TRUE(rendered_frame);
+  EXPECT_EQ(first_row, 100u);
+  EXPECT_EQ(row_count, 50u);
+}
+
+}  // namespace testing
+}  // namespace flutter
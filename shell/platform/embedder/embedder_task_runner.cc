@@ -53,6 +53,15 @@ void EmbedderTaskRunner::PostDelayedTask(const fml::closure& task,
   PostTaskForTime(task, fml::TimePoint::Now() + delay);
 }
 
+void EmbedderTaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                              fml::TaskPriority priority,
+                                              fml::TimePoint target_time,
+                                              fml::TimePoint deadline) {
+  // The embedder API has no notion of priorities, the embedder decides when
+  // tasks run.
+  PostTaskForTime(task, target_time);
+}
+
 bool EmbedderTaskRunner::RunsTasksOnCurrentThread() {
   return dispatch_table_.runs_task_on_current_thread_callback();
 }
@@ -89,6 +89,12 @@ class EmbedderTaskRunner final : public fml::TaskRunner {
   // |fml::TaskRunner|
   void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay) override;
 
+  // |fml::TaskRunner|
+  void PostTaskWithPriority(const fml::closure& task,
+                            fml::TaskPriority priority,
+                            fml::TimePoint target_time,
+                            fml::TimePoint deadline) override;
+
   // |fml::TaskRunner|
   bool RunsTasksOnCurrentThread() override;
 
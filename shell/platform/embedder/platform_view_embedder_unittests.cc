@@ -21,6 +21,8 @@ class MockDelegate : public PlatformView::Delegate {
   MOCK_METHOD0(OnPlatformViewScheduleFrame, void());
   MOCK_METHOD1(OnPlatformViewSetNextFrameCallback,
                void(const fml::closure& closure));
+  MOCK_METHOD1(OnPlatformViewNotifyMemoryPressure,
+               void(MemoryPressureLevel level));
   MOCK_METHOD1(OnPlatformViewSetViewportMetrics,
                void(const ViewportMetrics& metrics));
   MOCK_METHOD1(OnPlatformViewDispatchPlatformMessage,
@@ -46,6 +48,10 @@ class MockDelegate : public PlatformView::Delegate {
                void(intptr_t loading_unit_id,
                     const std::string error_message,
                     bool transient));
+  MOCK_METHOD3(PrefetchDartDeferredLibrary,
+               void(intptr_t loading_unit_id,
+                    std::unique_ptr<const fml::Mapping> snapshot_data,
+                    std::unique_ptr<const fml::Mapping> snapshot_instructions));
   MOCK_METHOD2(UpdateAssetResolverByType,
                void(std::unique_ptr<AssetResolver> updated_asset_resolver,
                     AssetResolver::AssetResolverType type));
@@ -2631,6 +2631,69 @@ TEST_F(EmbedderTest, ComplexClipsAreCorrectlyCalculated) {
   latch.Wait();
 }
 
+TEST_F(EmbedderTest, ComplexClipsAreFlattenedIfRequested) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
+
+  EmbedderConfigBuilder builder(context);
+  builder.SetOpenGLRendererConfig(SkISize::Make(1024, 600));
+  builder.SetCompositor();
+  builder.GetCompositor().flatten_platform_view_mutations = true;
+  builder.SetDartEntrypoint("scene_builder_with_complex_clips");
+  builder.SetRenderTargetType(
+      EmbedderTestBackingStoreProducer::RenderTargetType::kOpenGLFramebuffer);
+
+  const auto root_surface_transformation =
+      SkMatrix().preTranslate(0, 1024).preRotate(-90, 0, 0);
+
+  context.SetRootSurfaceTransformation(root_surface_transformation);
+
+  fml::AutoResetWaitableEvent latch;
+  context.GetCompositor().SetNextPresentCallback(
+      [&](const FlutterLayer** layers, size_t layers_count) {
+        ASSERT_EQ(layers_count, 2u);
+
+        {
+          const FlutterPlatformView& platform_view = *layers[0]->platform_view;
+          ASSERT_EQ(platform_view.identifier, 42);
+          ASSERT_EQ(platform_view.mutations_count, 3u);
+
+          const auto** mutations = platform_view.mutations;
+
+          ASSERT_EQ(mutations[0]->type,
+                    kFlutterPlatformViewMutationTypeTransformation);
+          ASSERT_EQ(SkMatrixMake(mutations[0]->transformation),
+                    root_surface_transformation);
+
+          // The three clips of the scene, in the coordinates of the first.
+          ASSERT_EQ(mutations[1]->type,
+                    kFlutterPlatformViewMutationTypeClipRect);
+          ASSERT_EQ(SkRectMake(mutations[1]->clip_rect),
+                    SkRect::MakeLTRB(512.0, 0.0, 1024.0, 600.0));
+
+          // The two offsets of the scene.
+          ASSERT_EQ(mutations[2]->type,
+                    kFlutterPlatformViewMutationTypeTransformation);
+          ASSERT_EQ(SkMatrixMake(mutations[2]->transformation),
+                    SkMatrix::Translate(256.0, 0.0));
+        }
+
+        latch.Signal();
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 1024;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  latch.Wait();
+}
+
 TEST_F(EmbedderTest, ObjectsCanBePostedViaPorts) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
   EmbedderConfigBuilder builder(context);
@@ -4069,6 +4132,50 @@ TEST_F(EmbedderTest, ExternalTextureGLRefreshedTooOften) {
   EXPECT_TRUE(resolve_called);
 }
 
+TEST_F(EmbedderTest, ExternalTextureGLCollectsBufferThatCannotBeImported) {
+  TestGLSurface surface(SkISize::Make(100, 100));
+  auto context = surface.GetGrContext();
+
+  // A DMA-BUF without a valid file descriptor is never imported.
+  FlutterOpenGLDmaBufPlane plane = {};
+  plane.fd = -1;
+  plane.stride = 400;
+  FlutterOpenGLExternalBuffer buffer = {};
+  buffer.struct_size = sizeof(FlutterOpenGLExternalBuffer);
+  buffer.type = kFlutterOpenGLExternalBufferTypeDmaBuf;
+  buffer.dma_buf_modifier = 0x00ffffffffffffffull;
+  buffer.dma_buf_plane_count = 1u;
+  buffer.dma_buf_planes = &plane;
+  buffer.acquire_fence_fd = -1;
+
+  size_t collect_count = 0u;
+  EmbedderExternalTextureGL::ExternalTextureCallback callback(
+      [&](int64_t, size_t, size_t) {
+        auto res = std::make_unique<FlutterOpenGLTexture>();
+        res->user_data = &collect_count;
+        res->destruction_callback = [](void* user_data) {
+          (*static_cast<size_t*>(user_data))++;
+        };
+        res->width = res->height = 100;
+        res->external_buffer = &buffer;
+        return res;
+      });
+  EmbedderExternalTextureGL texture(1, callback);
+
+  auto skia_surface = surface.GetOnscreenSurface();
+  DlSkCanvasAdapter canvas(skia_surface->getCanvas());
+
+  Texture* texture_ = &texture;
+  Texture::PaintContext ctx{
+      .canvas = &canvas,
+      .gr_context = context.get(),
+  };
+  texture_->Paint(ctx, SkRect::MakeXYWH(0, 0, 100, 100), false,
+                  DlImageSampling::kLinear);
+
+  EXPECT_EQ(collect_count, 1u);
+}
+
 TEST_F(EmbedderTest,
        PresentInfoReceivesNoDamageWhenPopulateExistingDamageIsUndefined) {
   auto& context = GetEmbedderContext(EmbedderTestContextType::kOpenGLContext);
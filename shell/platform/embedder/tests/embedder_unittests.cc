@@ -2226,6 +2226,20 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST(EmbedderTestNoFixture, CanDumpTraceRingBuffer) {
+  ASSERT_EQ(FlutterEngineDumpTraceRingBuffer(nullptr, nullptr),
+            kInvalidArguments);
+
+  std::string dump;
+  FlutterDataCallback callback = [](const uint8_t* data, size_t size,
+                                    void* user_data) {
+    reinterpret_cast<std::string*>(user_data)->assign(
+        reinterpret_cast<const char*>(data), size);
+  };
+  ASSERT_EQ(FlutterEngineDumpTraceRingBuffer(callback, &dump), kSuccess);
+  ASSERT_EQ(dump.find("{\"traceEvents\":["), 0u);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {
@@ -28,6 +28,16 @@ bool VsyncWaiterEmbedder::OnEmbedderVsync(
     intptr_t baton,
     fml::TimePoint frame_start_time,
     fml::TimePoint frame_target_time) {
+  return OnEmbedderVsync(task_runners.GetUITaskRunner(), baton,
+                         frame_start_time, frame_target_time);
+}
+
+// static
+bool VsyncWaiterEmbedder::OnEmbedderVsync(
+    const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+    intptr_t baton,
+    fml::TimePoint frame_start_time,
+    fml::TimePoint frame_target_time) {
   if (baton == 0) {
     return false;
   }
@@ -35,7 +45,7 @@ bool VsyncWaiterEmbedder::OnEmbedderVsync(
   // If the time here is in the future, the contract for `FlutterEngineOnVsync`
   // says that the engine will only process the frame when the time becomes
   // current.
-  task_runners.GetUITaskRunner()->PostTaskForTime(
+  ui_task_runner->PostTaskForTime(
       [frame_start_time, frame_target_time, baton]() {
         std::weak_ptr<VsyncWaiter>* weak_waiter =
             reinterpret_cast<std::weak_ptr<VsyncWaiter>*>(baton);
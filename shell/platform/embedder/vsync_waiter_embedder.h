@@ -24,6 +24,12 @@ class VsyncWaiterEmbedder final : public VsyncWaiter {
                               fml::TimePoint frame_start_time,
                               fml::TimePoint frame_target_time);
 
+  static bool OnEmbedderVsync(
+      const fml::RefPtr<fml::TaskRunner>& ui_task_runner,
+      intptr_t baton,
+      fml::TimePoint frame_start_time,
+      fml::TimePoint frame_target_time);
+
  private:
   const VsyncCallback vsync_callback_;
 
@@ -4,9 +4,11 @@
 
 #include "flutter/shell/platform/glfw/text_input_plugin.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 
+#include "flutter/fml/string_conversion.h"
 #include "flutter/shell/platform/common/json_method_codec.h"
 
 static constexpr char kSetEditingStateMethod[] = "TextInput.setEditingState";
@@ -19,8 +21,17 @@ static constexpr char kMultilineInputType[] = "TextInputType.multiline";
 
 static constexpr char kUpdateEditingStateMethod[] =
     "TextInputClient.updateEditingState";
+static constexpr char kUpdateEditingStateWithDeltasMethod[] =
+    "TextInputClient.updateEditingStateWithDeltas";
 static constexpr char kPerformActionMethod[] = "TextInputClient.performAction";
 
+static constexpr char kDeltaOldTextKey[] = "oldText";
+static constexpr char kDeltaTextKey[] = "deltaText";
+static constexpr char kDeltaStartKey[] = "deltaStart";
+static constexpr char kDeltaEndKey[] = "deltaEnd";
+static constexpr char kDeltasKey[] = "deltas";
+static constexpr char kEnableDeltaModel[] = "enableDeltaModel";
+
 static constexpr char kTextInputAction[] = "inputAction";
 static constexpr char kTextInputType[] = "inputType";
 static constexpr char kTextInputTypeName[] = "name";
@@ -45,8 +56,11 @@ void TextInputPlugin::CharHook(GLFWwindow* window, unsigned int code_point) {
   if (active_model_ == nullptr) {
     return;
   }
+  std::u16string text_before_change =
+      fml::Utf8ToUtf16(active_model_->GetText());
+  TextRange selection_before_change = active_model_->selection();
   active_model_->AddCodePoint(code_point);
-  SendStateUpdate(*active_model_);
+  SendStateUpdate(*active_model_, text_before_change, selection_before_change);
 }
 
 void TextInputPlugin::KeyboardHook(GLFWwindow* window,
@@ -58,6 +72,11 @@ void TextInputPlugin::KeyboardHook(GLFWwindow* window,
     return;
   }
   if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+    std::u16string text_before_change;
+    TextRange selection_before_change = active_model_->selection();
+    if (key == GLFW_KEY_BACKSPACE || key == GLFW_KEY_DELETE) {
+      text_before_change = fml::Utf8ToUtf16(active_model_->GetText());
+    }
     switch (key) {
       case GLFW_KEY_LEFT:
         if (active_model_->MoveCursorBack()) {
@@ -79,12 +98,14 @@ void TextInputPlugin::KeyboardHook(GLFWwindow* window,
         break;
       case GLFW_KEY_BACKSPACE:
         if (active_model_->Backspace()) {
-          SendStateUpdate(*active_model_);
+          SendStateUpdate(*active_model_, text_before_change,
+                          selection_before_change);
         }
         break;
       case GLFW_KEY_DELETE:
         if (active_model_->Delete()) {
-          SendStateUpdate(*active_model_);
+          SendStateUpdate(*active_model_, text_before_change,
+                          selection_before_change);
         }
         break;
       case GLFW_KEY_ENTER:
@@ -159,6 +180,12 @@ void TextInputPlugin::HandleMethodCall(
         input_type_ = input_type_json->value.GetString();
       }
     }
+    enable_delta_model_ = false;
+    auto enable_delta_model_json = client_config.FindMember(kEnableDeltaModel);
+    if (enable_delta_model_json != client_config.MemberEnd() &&
+        enable_delta_model_json->value.IsBool()) {
+      enable_delta_model_ = enable_delta_model_json->value.GetBool();
+    }
     active_model_ = std::make_unique<TextInputModel>();
   } else if (method.compare(kSetEditingStateMethod) == 0) {
     if (!method_call.arguments() || method_call.arguments()->IsNull()) {
@@ -206,6 +233,10 @@ void TextInputPlugin::HandleMethodCall(
 }
 
 void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
+  if (enable_delta_model_) {
+    SendStateUpdateWithDelta(model, TextEditingDelta(model.GetText()));
+    return;
+  }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
   args->PushBack(client_id_, allocator);
@@ -226,10 +257,61 @@ void TextInputPlugin::SendStateUpdate(const TextInputModel& model) {
   channel_->InvokeMethod(kUpdateEditingStateMethod, std::move(args));
 }
 
+void TextInputPlugin::SendStateUpdate(
+    const TextInputModel& model,
+    const std::u16string& text_before_change,
+    const TextRange& selection_before_change) {
+  if (!enable_delta_model_) {
+    SendStateUpdate(model);
+    return;
+  }
+  // Every edit replaces a range that starts at or before the new cursor and
+  // ends where the text after the new cursor began before the edit.
+  std::u16string text = fml::Utf8ToUtf16(model.GetText());
+  size_t cursor = model.selection().position();
+  size_t start = std::min(selection_before_change.start(), cursor);
+  size_t end = text_before_change.length() - text.length() + cursor;
+  SendStateUpdateWithDelta(
+      model, TextEditingDelta(text_before_change, TextRange(start, end),
+                              text.substr(start, cursor - start)));
+}
+
+void TextInputPlugin::SendStateUpdateWithDelta(const TextInputModel& model,
+                                               const TextEditingDelta& delta) {
+  auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
+  auto& allocator = args->GetAllocator();
+  args->PushBack(client_id_, allocator);
+
+  rapidjson::Value object(rapidjson::kObjectType);
+  rapidjson::Value deltas(rapidjson::kArrayType);
+  rapidjson::Value delta_json(rapidjson::kObjectType);
+
+  delta_json.AddMember(kDeltaOldTextKey, delta.old_text(), allocator);
+  delta_json.AddMember(kDeltaTextKey, delta.delta_text(), allocator);
+  delta_json.AddMember(kDeltaStartKey, delta.delta_start(), allocator);
+  delta_json.AddMember(kDeltaEndKey, delta.delta_end(), allocator);
+
+  TextRange selection = model.selection();
+  delta_json.AddMember(kSelectionAffinityKey, kAffinityDownstream, allocator);
+  delta_json.AddMember(kSelectionBaseKey, selection.base(), allocator);
+  delta_json.AddMember(kSelectionExtentKey, selection.extent(), allocator);
+  delta_json.AddMember(kSelectionIsDirectionalKey, false, allocator);
+  delta_json.AddMember(kComposingBaseKey, -1, allocator);
+  delta_json.AddMember(kComposingExtentKey, -1, allocator);
+
+  deltas.PushBack(delta_json, allocator);
+  object.AddMember(kDeltasKey, deltas, allocator);
+  args->PushBack(object, allocator);
+
+  channel_->InvokeMethod(kUpdateEditingStateWithDeltasMethod, std::move(args));
+}
+
 void TextInputPlugin::EnterPressed(TextInputModel* model) {
   if (input_type_ == kMultilineInputType) {
+    std::u16string text_before_change = fml::Utf8ToUtf16(model->GetText());
+    TextRange selection_before_change = model->selection();
     model->AddCodePoint('\n');
-    SendStateUpdate(*model);
+    SendStateUpdate(*model, text_before_change, selection_before_change);
   }
   auto args = std::make_unique<rapidjson::Document>(rapidjson::kArrayType);
   auto& allocator = args->GetAllocator();
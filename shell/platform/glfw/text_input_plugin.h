@@ -7,9 +7,11 @@
 
 #include <map>
 #include <memory>
+#include <string>
 
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/binary_messenger.h"
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/method_channel.h"
+#include "flutter/shell/platform/common/text_editing_delta.h"
 #include "flutter/shell/platform/common/text_input_model.h"
 #include "flutter/shell/platform/glfw/keyboard_hook_handler.h"
 #include "flutter/shell/platform/glfw/public/flutter_glfw.h"
@@ -41,6 +43,19 @@ class TextInputPlugin : public KeyboardHookHandler {
   // Sends the current state of the given model to the Flutter engine.
   void SendStateUpdate(const TextInputModel& model);
 
+  // Sends the current state of the given model to the Flutter engine after an
+  // edit that replaced |selection_before_change| of |text_before_change|.
+  //
+  // Sends the edit as a delta if the client enabled the delta model.
+  void SendStateUpdate(const TextInputModel& model,
+                       const std::u16string& text_before_change,
+                       const TextRange& selection_before_change);
+
+  // Sends the current state of the given model and the delta that produced it
+  // to the Flutter engine.
+  void SendStateUpdateWithDelta(const TextInputModel& model,
+                                const TextEditingDelta& delta);
+
   // Sends an action triggered by the Enter key to the Flutter engine.
   void EnterPressed(TextInputModel* model);
 
@@ -65,6 +80,9 @@ class TextInputPlugin : public KeyboardHookHandler {
   // An action requested by the user on the input client. See available options:
   // https://api.flutter.dev/flutter/services/TextInputAction-class.html
   std::string input_action_;
+
+  // Whether the client wants text changes reported as deltas.
+  bool enable_delta_model_ = false;
 };
 
 }  // namespace flutter
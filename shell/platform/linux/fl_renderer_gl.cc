@@ -6,13 +6,60 @@
 
 #include "flutter/shell/platform/linux/fl_backing_store_provider.h"
 #include "flutter/shell/platform/linux/fl_view_private.h"
+#include "flutter/shell/platform/linux/fl_wayland_subsurface.h"
 
 struct _FlRendererGL {
   FlRenderer parent_instance;
+
+  // Subsurface frames are presented to directly, or %NULL if they are drawn by
+  // the view.
+  FlWaylandSubsurface* subsurface;
+
+  // TRUE if frames can't be presented to a subsurface.
+  gboolean subsurface_unsupported;
 };
 
 G_DEFINE_TYPE(FlRendererGL, fl_renderer_gl, fl_renderer_get_type())
 
+static void fl_renderer_gl_dispose(GObject* object) {
+  FlRendererGL* self = FL_RENDERER_GL(object);
+
+  g_clear_object(&self->subsurface);
+
+  G_OBJECT_CLASS(fl_renderer_gl_parent_class)->dispose(object);
+}
+
+// Presents a layer covering the whole view to a subsurface, skipping the
+// redraw of the view by GTK.
+static gboolean fl_renderer_gl_present_to_subsurface(
+    FlRendererGL* self,
+    FlView* view,
+    const FlutterLayer* layer) {
+  if (self->subsurface_unsupported ||
+      layer->type != kFlutterLayerContentTypeBackingStore ||
+      layer->offset.x != 0 || layer->offset.y != 0 ||
+      !gtk_widget_get_mapped(GTK_WIDGET(view))) {
+    return FALSE;
+  }
+
+  if (self->subsurface == nullptr) {
+    self->subsurface = fl_wayland_subsurface_new(GTK_WIDGET(view));
+    if (self->subsurface == nullptr) {
+      self->subsurface_unsupported = TRUE;
+      return FALSE;
+    }
+  }
+
+  FlBackingStoreProvider* provider = reinterpret_cast<FlBackingStoreProvider*>(
+      layer->backing_store->open_gl.framebuffer.user_data);
+  if (!fl_wayland_subsurface_present(self->subsurface, provider)) {
+    self->subsurface_unsupported = TRUE;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 // Implements FlRenderer::create_contexts.
 static gboolean fl_renderer_gl_create_contexts(FlRenderer* renderer,
                                                GtkWidget* widget,
@@ -99,6 +146,13 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
     return FALSE;
   }
 
+  FlRendererGL* self = FL_RENDERER_GL(renderer);
+  if (layers_count == 1 &&
+      fl_renderer_gl_present_to_subsurface(self, view, layers[0])) {
+    return TRUE;
+  }
+  g_clear_object(&self->subsurface);
+
   g_autoptr(GPtrArray) textures = g_ptr_array_new();
   for (size_t i = 0; i < layers_count; ++i) {
     const FlutterLayer* layer = layers[i];
@@ -121,6 +175,8 @@ static gboolean fl_renderer_gl_present_layers(FlRenderer* renderer,
 }
 
 static void fl_renderer_gl_class_init(FlRendererGLClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_renderer_gl_dispose;
+
   FL_RENDERER_CLASS(klass)->create_contexts = fl_renderer_gl_create_contexts;
   FL_RENDERER_CLASS(klass)->create_backing_store =
       fl_renderer_gl_create_backing_store;
@@ -0,0 +1,280 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux/fl_wayland_subsurface.h"
+
+#include <epoxy/egl.h>
+#include <epoxy/gl.h>
+
+#include <cstring>
+
+#ifdef GDK_WINDOWING_WAYLAND
+#include <gdk/gdkwayland.h>
+#include <wayland-egl.h>
+#endif
+
+struct _FlWaylandSubsurface {
+  GObject parent_instance;
+
+  // Widget the subsurface is placed over.
+  GtkWidget* widget;
+
+#ifdef GDK_WINDOWING_WAYLAND
+  struct wl_surface* surface;
+  struct wl_subsurface* subsurface;
+  struct wl_egl_window* egl_window;
+#endif
+
+  EGLDisplay egl_display;
+  EGLSurface egl_surface;
+
+  // Position of the subsurface in the window, in logical pixels.
+  int x;
+  int y;
+
+  // Size of the buffers of the subsurface, in physical pixels.
+  int width;
+  int height;
+
+  // TRUE once the swap interval of the surface was set.
+  gboolean swap_interval_set;
+};
+
+G_DEFINE_TYPE(FlWaylandSubsurface, fl_wayland_subsurface, G_TYPE_OBJECT)
+
+#ifdef GDK_WINDOWING_WAYLAND
+
+static void registry_global_cb(void* data,
+                               struct wl_registry* registry,
+                               uint32_t name,
+                               const char* interface,
+                               uint32_t version) {
+  struct wl_subcompositor** subcompositor =
+      static_cast<struct wl_subcompositor**>(data);
+  if (strcmp(interface, wl_subcompositor_interface.name) == 0) {
+    *subcompositor = static_cast<struct wl_subcompositor*>(
+        wl_registry_bind(registry, name, &wl_subcompositor_interface, 1));
+  }
+}
+
+static void registry_global_remove_cb(void* data,
+                                      struct wl_registry* registry,
+                                      uint32_t name) {}
+
+static const struct wl_registry_listener registry_listener = {
+    .global = registry_global_cb,
+    .global_remove = registry_global_remove_cb,
+};
+
+// Binds the subcompositor of the display. The registry is read on a queue of
+// its own, so the events GDK is waiting for aren't dispatched here.
+static struct wl_subcompositor* get_subcompositor(struct wl_display* display) {
+  struct wl_event_queue* queue = wl_display_create_queue(display);
+  struct wl_display* wrapper =
+      static_cast<struct wl_display*>(wl_proxy_create_wrapper(display));
+  wl_proxy_set_queue(reinterpret_cast<struct wl_proxy*>(wrapper), queue);
+
+  struct wl_subcompositor* subcompositor = nullptr;
+  struct wl_registry* registry = wl_display_get_registry(wrapper);
+  wl_registry_add_listener(registry, &registry_listener, &subcompositor);
+  wl_display_roundtrip_queue(display, queue);
+  wl_registry_destroy(registry);
+
+  if (subcompositor != nullptr) {
+    wl_proxy_set_queue(reinterpret_cast<struct wl_proxy*>(subcompositor),
+                       nullptr);
+  }
+  wl_proxy_wrapper_destroy(wrapper);
+  wl_event_queue_destroy(queue);
+
+  return subcompositor;
+}
+
+#endif
+
+static void fl_wayland_subsurface_dispose(GObject* object) {
+  FlWaylandSubsurface* self = FL_WAYLAND_SUBSURFACE(object);
+
+  if (self->egl_surface != EGL_NO_SURFACE) {
+    eglDestroySurface(self->egl_display, self->egl_surface);
+    self->egl_surface = EGL_NO_SURFACE;
+  }
+
+#ifdef GDK_WINDOWING_WAYLAND
+  // Destroying the subsurface unmaps it, showing the widget again.
+  g_clear_pointer(&self->egl_window, wl_egl_window_destroy);
+  g_clear_pointer(&self->subsurface, wl_subsurface_destroy);
+  g_clear_pointer(&self->surface, wl_surface_destroy);
+#endif
+
+  G_OBJECT_CLASS(fl_wayland_subsurface_parent_class)->dispose(object);
+}
+
+static void fl_wayland_subsurface_class_init(FlWaylandSubsurfaceClass* klass) {
+  G_OBJECT_CLASS(klass)->dispose = fl_wayland_subsurface_dispose;
+}
+
+static void fl_wayland_subsurface_init(FlWaylandSubsurface* self) {
+  self->egl_display = EGL_NO_DISPLAY;
+  self->egl_surface = EGL_NO_SURFACE;
+}
+
+FlWaylandSubsurface* fl_wayland_subsurface_new(GtkWidget* widget) {
+  g_return_val_if_fail(GTK_IS_WIDGET(widget), nullptr);
+
+#ifdef GDK_WINDOWING_WAYLAND
+  GdkWindow* window = gtk_widget_get_window(widget);
+  if (window == nullptr || !gtk_widget_get_mapped(widget)) {
+    return nullptr;
+  }
+  window = gdk_window_get_toplevel(window);
+  GdkDisplay* display = gdk_window_get_display(window);
+  if (!GDK_IS_WAYLAND_DISPLAY(display)) {
+    return nullptr;
+  }
+
+  // GDK renders with EGL on Wayland, so the surface is created for the config
+  // of its context.
+  EGLDisplay egl_display = eglGetCurrentDisplay();
+  EGLContext egl_context = eglGetCurrentContext();
+  if (egl_display == EGL_NO_DISPLAY || egl_context == EGL_NO_CONTEXT) {
+    return nullptr;
+  }
+  EGLint config_id = 0;
+  if (!eglQueryContext(egl_display, egl_context, EGL_CONFIG_ID, &config_id)) {
+    return nullptr;
+  }
+  const EGLint config_attributes[] = {EGL_CONFIG_ID, config_id, EGL_NONE};
+  EGLConfig config = nullptr;
+  EGLint config_count = 0;
+  EGLint surface_type = 0;
+  if (!eglChooseConfig(egl_display, config_attributes, &config, 1,
+                       &config_count) ||
+      config_count != 1 ||
+      !eglGetConfigAttrib(egl_display, config, EGL_SURFACE_TYPE,
+                          &surface_type) ||
+      (surface_type & EGL_WINDOW_BIT) == 0) {
+    return nullptr;
+  }
+
+  struct wl_display* wl_display = gdk_wayland_display_get_wl_display(display);
+  struct wl_compositor* compositor =
+      gdk_wayland_display_get_wl_compositor(display);
+  struct wl_surface* parent = gdk_wayland_window_get_wl_surface(window);
+  if (compositor == nullptr || parent == nullptr) {
+    return nullptr;
+  }
+  struct wl_subcompositor* subcompositor = get_subcompositor(wl_display);
+  if (subcompositor == nullptr) {
+    return nullptr;
+  }
+
+  FlWaylandSubsurface* self = FL_WAYLAND_SUBSURFACE(
+      g_object_new(fl_wayland_subsurface_get_type(), nullptr));
+  self->widget = widget;
+  self->egl_display = egl_display;
+  self->surface = wl_compositor_create_surface(compositor);
+  self->subsurface =
+      wl_subcompositor_get_subsurface(subcompositor, self->surface, parent);
+  wl_subcompositor_destroy(subcompositor);
+
+  // Frames are committed as they are rendered rather than with the window.
+  wl_subsurface_set_desync(self->subsurface);
+
+  // Input still goes to the widget underneath.
+  struct wl_region* region = wl_compositor_create_region(compositor);
+  wl_surface_set_input_region(self->surface, region);
+  wl_region_destroy(region);
+
+  self->egl_window = wl_egl_window_create(self->surface, 1, 1);
+  self->egl_surface = eglCreateWindowSurface(
+      egl_display, config,
+      reinterpret_cast<EGLNativeWindowType>(self->egl_window), nullptr);
+  if (self->egl_surface == EGL_NO_SURFACE) {
+    g_warning("Failed to create EGL surface for subsurface: 0x%x",
+              eglGetError());
+    g_object_unref(self);
+    return nullptr;
+  }
+
+  // The position of the subsurface is applied when the window is next
+  // committed.
+  self->x = G_MININT;
+  self->y = G_MININT;
+
+  return self;
+#else
+  return nullptr;
+#endif
+}
+
+gboolean fl_wayland_subsurface_present(FlWaylandSubsurface* self,
+                                       FlBackingStoreProvider* provider) {
+  g_return_val_if_fail(FL_IS_WAYLAND_SUBSURFACE(self), FALSE);
+
+#ifdef GDK_WINDOWING_WAYLAND
+  GtkWidget* toplevel = gtk_widget_get_toplevel(self->widget);
+  int x = 0, y = 0;
+  if (!gtk_widget_translate_coordinates(self->widget, toplevel, 0, 0, &x,
+                                        &y)) {
+    return FALSE;
+  }
+  if (x != self->x || y != self->y) {
+    self->x = x;
+    self->y = y;
+    wl_subsurface_set_position(self->subsurface, x, y);
+    gtk_widget_queue_draw(toplevel);
+  }
+
+  GdkRectangle geometry = fl_backing_store_provider_get_geometry(provider);
+  if (geometry.width != self->width || geometry.height != self->height) {
+    self->width = geometry.width;
+    self->height = geometry.height;
+    wl_egl_window_resize(self->egl_window, geometry.width, geometry.height, 0,
+                         0);
+    wl_surface_set_buffer_scale(self->surface,
+                                gtk_widget_get_scale_factor(self->widget));
+  }
+
+  EGLContext context = eglGetCurrentContext();
+  EGLSurface draw_surface = eglGetCurrentSurface(EGL_DRAW);
+  EGLSurface read_surface = eglGetCurrentSurface(EGL_READ);
+  if (!eglMakeCurrent(self->egl_display, self->egl_surface, self->egl_surface,
+                      context)) {
+    g_warning("Failed to make subsurface current: 0x%x", eglGetError());
+    return FALSE;
+  }
+
+  // The engine already paces frames to the display, so the swap mustn't wait
+  // for the compositor as well.
+  if (!self->swap_interval_set) {
+    eglSwapInterval(self->egl_display, 0);
+    self->swap_interval_set = TRUE;
+  }
+
+  // Both framebuffers have their origin at the bottom left, so the copy stays
+  // on the GPU.
+  glBindFramebuffer(
+      GL_READ_FRAMEBUFFER,
+      fl_backing_store_provider_get_gl_framebuffer_id(provider));
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glBlitFramebuffer(0, 0, geometry.width, geometry.height, 0, 0,
+                    geometry.width, geometry.height, GL_COLOR_BUFFER_BIT,
+                    GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  // The swap synchronizes with the compositor through the buffer, so no fence
+  // is waited on here.
+  gboolean result = eglSwapBuffers(self->egl_display, self->egl_surface);
+  if (!result) {
+    g_warning("Failed to present subsurface: 0x%x", eglGetError());
+  }
+
+  eglMakeCurrent(self->egl_display, draw_surface, read_surface, context);
+
+  return result;
+#else
+  return FALSE;
+#endif
+}
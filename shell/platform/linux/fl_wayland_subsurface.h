@@ -0,0 +1,57 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_FL_WAYLAND_SUBSURFACE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_FL_WAYLAND_SUBSURFACE_H_
+
+#include <gtk/gtk.h>
+
+#include "flutter/shell/platform/linux/fl_backing_store_provider.h"
+
+G_BEGIN_DECLS
+
+G_DECLARE_FINAL_TYPE(FlWaylandSubsurface,
+                     fl_wayland_subsurface,
+                     FL,
+                     WAYLAND_SUBSURFACE,
+                     GObject)
+
+/**
+ * FlWaylandSubsurface:
+ *
+ * #FlWaylandSubsurface is a Wayland subsurface placed over a widget that
+ * frames are presented to directly. The buffers of the subsurface are handed
+ * to the compositor as they are, so it may scan them out without GTK redrawing
+ * the window or reading the frame back.
+ */
+
+/**
+ * fl_wayland_subsurface_new:
+ * @widget: the mapped widget to cover.
+ *
+ * Creates a subsurface over @widget. The EGL context the frames are rendered
+ * with must be current.
+ *
+ * Returns: a new #FlWaylandSubsurface or %NULL if the display isn't Wayland or
+ * the context can't render to a Wayland surface.
+ */
+FlWaylandSubsurface* fl_wayland_subsurface_new(GtkWidget* widget);
+
+/**
+ * fl_wayland_subsurface_present:
+ * @subsurface: an #FlWaylandSubsurface.
+ * @provider: the backing store to present.
+ *
+ * Copies the backing store into the next buffer of the subsurface and commits
+ * it. The EGL context the subsurface was created with must be current and is
+ * current again on return.
+ *
+ * Returns: %TRUE if the backing store was presented.
+ */
+gboolean fl_wayland_subsurface_present(FlWaylandSubsurface* subsurface,
+                                       FlBackingStoreProvider* provider);
+
+G_END_DECLS
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_FL_WAYLAND_SUBSURFACE_H_
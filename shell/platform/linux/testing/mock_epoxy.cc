@@ -158,6 +158,14 @@ EGLSurface _eglCreateWindowSurface(EGLDisplay dpy,
   return &mock_surface;
 }
 
+EGLBoolean _eglDestroySurface(EGLDisplay dpy, EGLSurface surface) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
 EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
                                EGLConfig config,
                                EGLint attribute,
@@ -254,6 +262,18 @@ EGLBoolean _eglGetConfigAttrib(EGLDisplay dpy,
   }
 }
 
+EGLContext _eglGetCurrentContext() {
+  return EGL_NO_CONTEXT;
+}
+
+EGLDisplay _eglGetCurrentDisplay() {
+  return EGL_NO_DISPLAY;
+}
+
+EGLSurface _eglGetCurrentSurface(EGLint readdraw) {
+  return EGL_NO_SURFACE;
+}
+
 EGLDisplay _eglGetDisplay(EGLNativeDisplayType display_id) {
   return &mock_display;
 }
@@ -326,6 +346,17 @@ EGLBoolean _eglMakeCurrent(EGLDisplay dpy,
   return bool_success();
 }
 
+EGLBoolean _eglQueryContext(EGLDisplay dpy,
+                            EGLContext ctx,
+                            EGLint attribute,
+                            EGLint* value) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_failure(EGL_BAD_CONTEXT);
+}
+
 EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   if (!check_display(dpy) || !check_initialized(dpy)) {
     return EGL_FALSE;
@@ -334,10 +365,29 @@ EGLBoolean _eglSwapBuffers(EGLDisplay dpy, EGLSurface surface) {
   return bool_success();
 }
 
+EGLBoolean _eglSwapInterval(EGLDisplay dpy, EGLint interval) {
+  if (!check_display(dpy) || !check_initialized(dpy)) {
+    return EGL_FALSE;
+  }
+
+  return bool_success();
+}
+
 static void _glBindFramebuffer(GLenum target, GLuint framebuffer) {}
 
 static void _glBindTexture(GLenum target, GLuint texture) {}
 
+static void _glBlitFramebuffer(GLint srcX0,
+                               GLint srcY0,
+                               GLint srcX1,
+                               GLint srcY1,
+                               GLint dstX0,
+                               GLint dstY0,
+                               GLint dstX1,
+                               GLint dstY1,
+                               GLbitfield mask,
+                               GLenum filter) {}
+
 void _glDeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {}
 
 void _glDeleteTextures(GLsizei n, const GLuint* textures) {}
@@ -426,10 +476,14 @@ EGLSurface (*epoxy_eglCreateWindowSurface)(EGLDisplay dpy,
                                            EGLConfig config,
                                            EGLNativeWindowType win,
                                            const EGLint* attrib_list);
+EGLBoolean (*epoxy_eglDestroySurface)(EGLDisplay dpy, EGLSurface surface);
 EGLBoolean (*epoxy_eglGetConfigAttrib)(EGLDisplay dpy,
                                        EGLConfig config,
                                        EGLint attribute,
                                        EGLint* value);
+EGLContext (*epoxy_eglGetCurrentContext)();
+EGLDisplay (*epoxy_eglGetCurrentDisplay)();
+EGLSurface (*epoxy_eglGetCurrentSurface)(EGLint readdraw);
 EGLDisplay (*epoxy_eglGetDisplay)(EGLNativeDisplayType display_id);
 EGLint (*epoxy_eglGetError)();
 void (*(*epoxy_eglGetProcAddress)(const char* procname))(void);
@@ -438,10 +492,25 @@ EGLBoolean (*epoxy_eglMakeCurrent)(EGLDisplay dpy,
                                    EGLSurface draw,
                                    EGLSurface read,
                                    EGLContext ctx);
+EGLBoolean (*epoxy_eglQueryContext)(EGLDisplay dpy,
+                                    EGLContext ctx,
+                                    EGLint attribute,
+                                    EGLint* value);
 EGLBoolean (*epoxy_eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
+EGLBoolean (*epoxy_eglSwapInterval)(EGLDisplay dpy, EGLint interval);
 
 void (*epoxy_glBindFramebuffer)(GLenum target, GLuint framebuffer);
 void (*epoxy_glBindTexture)(GLenum target, GLuint texture);
+void (*epoxy_glBlitFramebuffer)(GLint srcX0,
+                                GLint srcY0,
+                                GLint srcX1,
+                                GLint srcY1,
+                                GLint dstX0,
+                                GLint dstY0,
+                                GLint dstX1,
+                                GLint dstY1,
+                                GLbitfield mask,
+                                GLenum filter);
 void (*epoxy_glDeleteFramebuffers)(GLsizei n, const GLuint* framebuffers);
 void (*epoxy_glDeleteTextures)(GLsizei n, const GLuint* textures);
 void (*epoxy_glFramebufferTexture2D)(GLenum target,
@@ -470,16 +539,23 @@ static void library_init() {
   epoxy_eglCreateContext = _eglCreateContext;
   epoxy_eglCreatePbufferSurface = _eglCreatePbufferSurface;
   epoxy_eglCreateWindowSurface = _eglCreateWindowSurface;
+  epoxy_eglDestroySurface = _eglDestroySurface;
   epoxy_eglGetConfigAttrib = _eglGetConfigAttrib;
+  epoxy_eglGetCurrentContext = _eglGetCurrentContext;
+  epoxy_eglGetCurrentDisplay = _eglGetCurrentDisplay;
+  epoxy_eglGetCurrentSurface = _eglGetCurrentSurface;
   epoxy_eglGetDisplay = _eglGetDisplay;
   epoxy_eglGetError = _eglGetError;
   epoxy_eglGetProcAddress = _eglGetProcAddress;
   epoxy_eglInitialize = _eglInitialize;
   epoxy_eglMakeCurrent = _eglMakeCurrent;
+  epoxy_eglQueryContext = _eglQueryContext;
   epoxy_eglSwapBuffers = _eglSwapBuffers;
+  epoxy_eglSwapInterval = _eglSwapInterval;
 
   epoxy_glBindFramebuffer = _glBindFramebuffer;
   epoxy_glBindTexture = _glBindTexture;
+  epoxy_glBlitFramebuffer = _glBlitFramebuffer;
   epoxy_glDeleteFramebuffers = _glDeleteFramebuffers;
   epoxy_glDeleteTextures = _glDeleteTextures;
   epoxy_glFramebufferTexture2D = _glFramebufferTexture2D;
@@ -214,26 +214,83 @@ bool AngleSurfaceManager::CreateSurface(WindowsRenderTarget* render_target,
     return false;
   }
 
+  surface_width_ = width;
+  surface_height_ = height;
+
+  HWND window = std::get<HWND>(*render_target);
+  if (CreateSwapChainSurface(window, width, height)) {
+    return true;
+  }
+
   EGLSurface surface = EGL_NO_SURFACE;
 
   const EGLint surfaceAttributes[] = {
       EGL_FIXED_SIZE_ANGLE, EGL_TRUE, EGL_WIDTH, width,
       EGL_HEIGHT,           height,   EGL_NONE};
 
-  surface = eglCreateWindowSurface(
-      egl_display_, egl_config_,
-      static_cast<EGLNativeWindowType>(std::get<HWND>(*render_target)),
-      surfaceAttributes);
+  surface = eglCreateWindowSurface(egl_display_, egl_config_,
+                                   static_cast<EGLNativeWindowType>(window),
+                                   surfaceAttributes);
   if (surface == EGL_NO_SURFACE) {
     LogEglError("Surface creation failed.");
   }
 
-  surface_width_ = width;
-  surface_height_ = height;
   render_surface_ = surface;
   return true;
 }
 
+bool AngleSurfaceManager::CreateSwapChainSurface(HWND window,
+                                                 EGLint width,
+                                                 EGLint height) {
+  Microsoft::WRL::ComPtr<ID3D11Device> device;
+  if (!GetDevice(device.GetAddressOf())) {
+    return false;
+  }
+
+  swap_chain_ = DxgiSwapChain::Create(device.Get(), window, width, height);
+  if (!swap_chain_) {
+    return false;
+  }
+
+  render_surface_ = CreateSwapChainBufferSurface();
+  if (render_surface_ == EGL_NO_SURFACE) {
+    swap_chain_.reset();
+    return false;
+  }
+  return true;
+}
+
+bool AngleSurfaceManager::ResizeSwapChainSurface(EGLint width,
+                                                 EGLint height) {
+  // The swap chain can only be resized once ANGLE released its back buffer.
+  if (render_surface_ != EGL_NO_SURFACE) {
+    eglDestroySurface(egl_display_, render_surface_);
+    render_surface_ = EGL_NO_SURFACE;
+  }
+
+  if (!swap_chain_->Resize(width, height)) {
+    return false;
+  }
+  render_surface_ = CreateSwapChainBufferSurface();
+  return render_surface_ != EGL_NO_SURFACE;
+}
+
+EGLSurface AngleSurfaceManager::CreateSwapChainBufferSurface() {
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> buffer;
+  if (!swap_chain_->GetBackBuffer(buffer.GetAddressOf())) {
+    return EGL_NO_SURFACE;
+  }
+
+  const EGLint attributes[] = {EGL_NONE};
+  EGLSurface surface = CreateSurfaceFromHandle(
+      EGL_D3D_TEXTURE_ANGLE, static_cast<EGLClientBuffer>(buffer.Get()),
+      attributes);
+  if (surface == EGL_NO_SURFACE) {
+    LogEglError("Failed to create surface for swap chain buffer.");
+  }
+  return surface;
+}
+
 void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
                                         EGLint width,
                                         EGLint height) {
@@ -244,6 +301,9 @@ void AngleSurfaceManager::ResizeSurface(WindowsRenderTarget* render_target,
     surface_height_ = height;
 
     ClearContext();
+    if (swap_chain_ && ResizeSwapChainSurface(width, height)) {
+      return;
+    }
     DestroySurface();
     if (!CreateSurface(render_target, width, height)) {
       FML_LOG(ERROR)
@@ -271,6 +331,7 @@ void AngleSurfaceManager::DestroySurface() {
     eglDestroySurface(egl_display_, render_surface_);
   }
   render_surface_ = EGL_NO_SURFACE;
+  swap_chain_.reset();
 }
 
 bool AngleSurfaceManager::MakeCurrent() {
@@ -289,9 +350,21 @@ bool AngleSurfaceManager::MakeResourceCurrent() {
 }
 
 EGLBoolean AngleSurfaceManager::SwapBuffers() {
+  if (swap_chain_) {
+    // ANGLE renders with the device of the swap chain, so flushing submits the
+    // frame ahead of the present.
+    glFlush();
+    return swap_chain_->Present() ? EGL_TRUE : EGL_FALSE;
+  }
   return (eglSwapBuffers(egl_display_, render_surface_));
 }
 
+void AngleSurfaceManager::WaitForFrame() {
+  if (swap_chain_) {
+    swap_chain_->WaitForFrame();
+  }
+}
+
 EGLSurface AngleSurfaceManager::CreateSurfaceFromHandle(
     EGLenum handle_type,
     EGLClientBuffer handle,
@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/shell/platform/windows/dxgi_swap_chain.h"
 #include "flutter/shell/platform/windows/window_binding_handler.h"
 
 namespace flutter {
@@ -34,6 +35,10 @@ class AngleSurfaceManager {
   // associated with window, in the appropriate format for display.
   // Target represents the visual entity to bind to.  Width and
   // height represent dimensions surface is created at.
+  //
+  // Where the system supports them, the surface wraps the back buffer of a
+  // waitable flip model swap chain presented by the manager. Otherwise ANGLE
+  // creates and presents the swap chain of a window surface.
   bool CreateSurface(WindowsRenderTarget* render_target,
                      EGLint width,
                      EGLint height);
@@ -68,6 +73,16 @@ class AngleSurfaceManager {
   // not null.
   EGLBoolean SwapBuffers();
 
+  // Blocks until the swapchain backing surface is ready for another frame, so
+  // that swapping the buffers of the frame doesn't wait for vsync. Returns
+  // immediately if ANGLE presents the surface.
+  void WaitForFrame();
+
+  // Whether the surface is rendered upside down. GL puts the origin of a
+  // surface wrapping a swap chain buffer at its bottom left, while DXGI shows
+  // the buffer from its top left.
+  bool IsSurfaceFlipped() const { return swap_chain_ != nullptr; }
+
   // Creates a |EGLSurface| from the provided handle.
   EGLSurface CreateSurfaceFromHandle(EGLenum handle_type,
                                      EGLClientBuffer handle,
@@ -87,6 +102,16 @@ class AngleSurfaceManager {
   bool Initialize();
   void CleanUp();
 
+  // Creates a flip model swap chain for the window and wraps its back buffer
+  // in render_surface_.
+  bool CreateSwapChainSurface(HWND window, EGLint width, EGLint height);
+
+  // Resizes the swap chain, wrapping its new back buffer in render_surface_.
+  bool ResizeSwapChainSurface(EGLint width, EGLint height);
+
+  // Creates a |EGLSurface| rendering to the back buffer of swap_chain_.
+  EGLSurface CreateSwapChainBufferSurface();
+
   // Attempts to initialize EGL using ANGLE.
   bool InitializeEGL(
       PFNEGLGETPLATFORMDISPLAYEXTPROC egl_get_platform_display_EXT,
@@ -113,6 +138,10 @@ class AngleSurfaceManager {
   // Current render_surface that engine will draw into.
   EGLSurface render_surface_ = EGL_NO_SURFACE;
 
+  // Swap chain render_surface_ wraps the back buffer of, or nullptr if
+  // render_surface_ is a window surface presented by ANGLE.
+  std::unique_ptr<DxgiSwapChain> swap_chain_;
+
   // Requested dimensions for current surface
   EGLint surface_width_ = 0;
   EGLint surface_height_ = 0;
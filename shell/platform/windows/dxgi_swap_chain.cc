@@ -0,0 +1,122 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/windows/dxgi_swap_chain.h"
+
+#include "flutter/fml/logging.h"
+
+namespace flutter {
+
+namespace {
+
+// Swap chains are created and resized with these flags.
+constexpr UINT kSwapChainFlags =
+    DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
+}  // namespace
+
+std::unique_ptr<DxgiSwapChain> DxgiSwapChain::Create(ID3D11Device* device,
+                                                     HWND window,
+                                                     UINT width,
+                                                     UINT height) {
+  if (!device || !window) {
+    return nullptr;
+  }
+
+  Microsoft::WRL::ComPtr<IDXGIDevice> dxgi_device;
+  Microsoft::WRL::ComPtr<IDXGIAdapter> adapter;
+  Microsoft::WRL::ComPtr<IDXGIFactory2> factory;
+  if (FAILED(device->QueryInterface(IID_PPV_ARGS(&dxgi_device))) ||
+      FAILED(dxgi_device->GetAdapter(&adapter)) ||
+      FAILED(adapter->GetParent(IID_PPV_ARGS(&factory)))) {
+    return nullptr;
+  }
+
+  DXGI_SWAP_CHAIN_DESC1 desc = {};
+  desc.Width = width;
+  desc.Height = height;
+  desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+  desc.SampleDesc.Count = 1;
+  desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+  desc.BufferCount = 2;
+  desc.Scaling = DXGI_SCALING_STRETCH;
+  desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+  desc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+  desc.Flags = kSwapChainFlags;
+
+  Microsoft::WRL::ComPtr<IDXGISwapChain1> swap_chain;
+  HRESULT result = factory->CreateSwapChainForHwnd(device, window, &desc,
+                                                   nullptr, nullptr,
+                                                   &swap_chain);
+  if (FAILED(result)) {
+    // Discarding flips are only available since Windows 10.
+    desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL;
+    result = factory->CreateSwapChainForHwnd(device, window, &desc, nullptr,
+                                             nullptr, &swap_chain);
+  }
+  if (FAILED(result)) {
+    FML_LOG(WARNING) << "Failed to create a flip model swap chain: 0x"
+                     << std::hex << result;
+    return nullptr;
+  }
+
+  // Waitable swap chains are only available since Windows 8.1.
+  Microsoft::WRL::ComPtr<IDXGISwapChain2> waitable_swap_chain;
+  if (FAILED(swap_chain.As(&waitable_swap_chain)) ||
+      FAILED(waitable_swap_chain->SetMaximumFrameLatency(1))) {
+    return nullptr;
+  }
+  HANDLE frame_latency_waitable =
+      waitable_swap_chain->GetFrameLatencyWaitableObject();
+  if (!frame_latency_waitable) {
+    return nullptr;
+  }
+
+  // The window handles Alt+Enter itself.
+  factory->MakeWindowAssociation(window, DXGI_MWA_NO_ALT_ENTER);
+
+  return std::unique_ptr<DxgiSwapChain>(new DxgiSwapChain(
+      std::move(waitable_swap_chain), frame_latency_waitable));
+}
+
+DxgiSwapChain::DxgiSwapChain(
+    Microsoft::WRL::ComPtr<IDXGISwapChain2> swap_chain,
+    HANDLE frame_latency_waitable)
+    : swap_chain_(std::move(swap_chain)),
+      frame_latency_waitable_(frame_latency_waitable) {}
+
+DxgiSwapChain::~DxgiSwapChain() {
+  CloseHandle(frame_latency_waitable_);
+}
+
+bool DxgiSwapChain::Resize(UINT width, UINT height) {
+  HRESULT result = swap_chain_->ResizeBuffers(0, width, height,
+                                              DXGI_FORMAT_UNKNOWN,
+                                              kSwapChainFlags);
+  if (FAILED(result)) {
+    FML_LOG(ERROR) << "Failed to resize swap chain: 0x" << std::hex << result;
+    return false;
+  }
+  return true;
+}
+
+bool DxgiSwapChain::GetBackBuffer(ID3D11Texture2D** buffer) {
+  return SUCCEEDED(swap_chain_->GetBuffer(0, IID_PPV_ARGS(buffer)));
+}
+
+void DxgiSwapChain::WaitForFrame() {
+  WaitForSingleObjectEx(frame_latency_waitable_, kFrameWaitTimeoutMs, TRUE);
+}
+
+bool DxgiSwapChain::Present() {
+  HRESULT result = swap_chain_->Present(1, 0);
+  // Presents to an occluded window succeed without showing anything.
+  if (FAILED(result)) {
+    FML_LOG(ERROR) << "Failed to present swap chain: 0x" << std::hex << result;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
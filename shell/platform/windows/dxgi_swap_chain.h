@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_WINDOWS_DXGI_SWAP_CHAIN_H_
+#define FLUTTER_SHELL_PLATFORM_WINDOWS_DXGI_SWAP_CHAIN_H_
+
+#include <d3d11.h>
+#include <dxgi1_3.h>
+#include <windows.h>
+#include <wrl/client.h>
+
+#include <memory>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+// A flip model DXGI swap chain for a window, paced by its frame latency
+// waitable object.
+//
+// Presents of a flip model swap chain hand the back buffer to DWM rather than
+// copying it, and waiting on the waitable object before rendering a frame
+// keeps at most one frame queued, so presents don't block on vsync.
+class DxgiSwapChain {
+ public:
+  // The longest a frame waits for the swap chain before it is rendered anyway.
+  static constexpr DWORD kFrameWaitTimeoutMs = 100;
+
+  // Creates a swap chain of the given size in physical pixels for |window| on
+  // |device|. Returns nullptr if the system doesn't support waitable flip
+  // model swap chains.
+  static std::unique_ptr<DxgiSwapChain> Create(ID3D11Device* device,
+                                               HWND window,
+                                               UINT width,
+                                               UINT height);
+
+  ~DxgiSwapChain();
+
+  // Resizes the buffers of the swap chain. All references to the back buffer
+  // must have been released.
+  bool Resize(UINT width, UINT height);
+
+  // Gets the back buffer frames are rendered to. It stays the back buffer
+  // across presents.
+  bool GetBackBuffer(ID3D11Texture2D** buffer);
+
+  // Blocks until the swap chain is ready for another frame.
+  void WaitForFrame();
+
+  // Presents the back buffer at the next vsync.
+  bool Present();
+
+ private:
+  DxgiSwapChain(Microsoft::WRL::ComPtr<IDXGISwapChain2> swap_chain,
+                HANDLE frame_latency_waitable);
+
+  Microsoft::WRL::ComPtr<IDXGISwapChain2> swap_chain_;
+
+  // Signaled when the swap chain can queue another frame.
+  HANDLE frame_latency_waitable_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DxgiSwapChain);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_WINDOWS_DXGI_SWAP_CHAIN_H_
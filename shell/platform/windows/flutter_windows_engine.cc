@@ -72,6 +72,18 @@ FlutterRendererConfig GetOpenGLRendererConfig() {
     return host->view()->SwapBuffers();
   };
   config.open_gl.fbo_reset_after_present = true;
+  config.open_gl.surface_transformation =
+      [](void* user_data) -> FlutterTransformation {
+    auto host = static_cast<FlutterWindowsEngine*>(user_data);
+    if (!host->view()) {
+      FlutterTransformation identity = {};
+      identity.scaleX = 1;
+      identity.scaleY = 1;
+      identity.pers2 = 1;
+      return identity;
+    }
+    return host->view()->GetSurfaceTransformation();
+  };
   config.open_gl.fbo_with_frame_info_callback =
       [](void* user_data, const FlutterFrameInfo* info) -> uint32_t {
     auto host = static_cast<FlutterWindowsEngine*>(user_data);
@@ -69,6 +69,10 @@ void FlutterWindowsView::SetEngine(
 
 uint32_t FlutterWindowsView::GetFrameBufferId(size_t width, size_t height) {
   // Called on an engine-controlled (non-platform) thread.
+  // Wait for the swap chain before taking the lock, so that a resize on the
+  // platform thread isn't held up by the wait.
+  engine_->surface_manager()->WaitForFrame();
+
   std::unique_lock<std::mutex> lock(resize_mutex_);
 
   if (resize_status_ != ResizeState::kResizeStarted) {
@@ -573,6 +577,29 @@ bool FlutterWindowsView::SwapBuffers() {
   }
 }
 
+FlutterTransformation FlutterWindowsView::GetSurfaceTransformation() {
+  // Called on an engine-controlled (non-platform) thread.
+  FlutterTransformation transformation = {};
+  transformation.scaleX = 1;
+  transformation.scaleY = 1;
+  transformation.pers2 = 1;
+  if (!engine_->surface_manager()->IsSurfaceFlipped()) {
+    return transformation;
+  }
+
+  std::unique_lock<std::mutex> lock(resize_mutex_);
+  EGLint surface_width, surface_height;
+  engine_->surface_manager()->GetSurfaceDimensions(&surface_width,
+                                                   &surface_height);
+  // The frame of a resize is rendered before the surface is resized.
+  if (resize_status_ == ResizeState::kResizeStarted) {
+    surface_height = resize_target_height_;
+  }
+  transformation.scaleY = -1;
+  transformation.transY = surface_height;
+  return transformation;
+}
+
 bool FlutterWindowsView::PresentSoftwareBitmap(const void* allocation,
                                                size_t row_bytes,
                                                size_t height) {
@@ -73,6 +73,11 @@ class FlutterWindowsView : public WindowBindingHandlerDelegate,
   bool MakeResourceCurrent();
   bool SwapBuffers();
 
+  // Callback for the transformation of the render surface, typically called on
+  // an engine-controlled (non-platform) thread. Flips surfaces that are
+  // rendered upside down.
+  FlutterTransformation GetSurfaceTransformation();
+
   // Callback for presenting a software bitmap.
   bool PresentSoftwareBitmap(const void* allocation,
                              size_t row_bytes,
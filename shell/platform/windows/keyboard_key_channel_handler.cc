@@ -148,10 +148,11 @@ void KeyboardKeyChannelHandler::KeyboardHook(
   }
   channel_->Send(event, [callback = std::move(callback)](const uint8_t* reply,
                                                          size_t reply_size) {
-    auto decoded = flutter::JsonMessageCodec::GetInstance().DecodeMessage(
-        reply, reply_size);
-    bool handled = decoded ? (*decoded)[kHandledKey].GetBool() : false;
-    callback(handled);
+    // Only the handled member of the reply is needed, so it isn't decoded
+    // into a document.
+    auto handled = flutter::JsonMessageCodec::DecodeBoolMember(
+        reply, reply_size, kHandledKey);
+    callback(handled.value_or(false));
   });
 }
 
@@ -12,6 +12,7 @@ set -ex
 ./txt_benchmarks --benchmark_format=json > txt_benchmarks.json
 ./fml_benchmarks --benchmark_format=json > fml_benchmarks.json
 ./shell_benchmarks --benchmark_format=json > shell_benchmarks.json
+./frame_allocation_benchmarks --benchmark_format=json > frame_allocation_benchmarks.json
 ./ui_benchmarks --benchmark_format=json > ui_benchmarks.json
 ./display_list_builder_benchmarks --benchmark_format=json > display_list_builder_benchmarks.json
 ./geometry_benchmarks --benchmark_format=json > geometry_benchmarks.json
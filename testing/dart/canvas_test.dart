@@ -92,6 +92,8 @@ void testNoCrashes() {
     testCanvas((Canvas canvas) => canvas.drawPoints(PointMode.points, <Offset>[], paint));
     testCanvas((Canvas canvas) => canvas.drawRawAtlas(image, Float32List(0), Float32List(0), Int32List(0), BlendMode.src, rect, paint));
     testCanvas((Canvas canvas) => canvas.drawRawPoints(PointMode.points, Float32List(0), paint));
+    testCanvas((Canvas canvas) => canvas.drawRawRects(Float32List(0), paint));
+    testCanvas((Canvas canvas) => canvas.drawRawCircles(Float32List(0), paint));
     testCanvas((Canvas canvas) => canvas.drawRect(rect, paint));
     testCanvas((Canvas canvas) => canvas.drawRRect(rrect, paint));
     testCanvas((Canvas canvas) => canvas.drawShadow(path, color, double.nan, false));
@@ -550,6 +552,40 @@ void main() {
     expect(data, listEquals(dataSync));
   });
 
+  test('drawRawRects and drawRawCircles match drawRect and drawCircle', () async {
+    final Paint paint = Paint()..color = const Color(0xFF00FF00);
+    final Float32List rects = Float32List.fromList(<double>[
+      10, 10, 30, 40,
+      50, 20, 90, 30,
+    ]);
+    final Float32List circles = Float32List.fromList(<double>[
+      20, 70, 10,
+      70, 70, 15,
+    ]);
+
+    final Image batched = await toImage((Canvas canvas) {
+      canvas.drawRawRects(rects, paint);
+      canvas.drawRawCircles(circles, paint);
+    }, 100, 100);
+    final Image individual = await toImage((Canvas canvas) {
+      canvas.drawRect(const Rect.fromLTRB(10, 10, 30, 40), paint);
+      canvas.drawRect(const Rect.fromLTRB(50, 20, 90, 30), paint);
+      canvas.drawCircle(const Offset(20, 70), 10, paint);
+      canvas.drawCircle(const Offset(70, 70), 15, paint);
+    }, 100, 100);
+
+    final ByteData batchedData = (await batched.toByteData())!;
+    final ByteData individualData = (await individual.toByteData())!;
+    expect(batchedData.buffer.asUint8List(), listEquals(individualData.buffer.asUint8List()));
+  });
+
+  test('drawRawRects and drawRawCircles check their data lengths', () async {
+    final Canvas canvas = Canvas(PictureRecorder());
+    final Paint paint = Paint();
+    expectArgumentError(() => canvas.drawRawRects(Float32List(3), paint));
+    expectArgumentError(() => canvas.drawRawCircles(Float32List(4), paint));
+  });
+
   test('Canvas.drawParagraph throws when Paragraph.layout was not called', () async {
     // Regression test for https://github.com/flutter/flutter/issues/97172
     bool assertsEnabled = false;
@@ -55,6 +55,46 @@ void main() {
     }
   });
 
+  test('lays out paragraphs on worker threads', () async {
+    final List<Paragraph> paragraphs = <Paragraph>[
+      for (final double fontSize in <double>[10.0, 20.0, 30.0, 40.0])
+        (ParagraphBuilder(ParagraphStyle(
+          fontFamily: 'FlutterTest',
+          fontSize: fontSize,
+        ))..addText('Test')).build(),
+    ];
+    await Future.wait(paragraphs.map(
+      (Paragraph paragraph) =>
+          paragraph.layoutAsync(const ParagraphConstraints(width: 400.0)),
+    ));
+
+    expect(paragraphs.map((Paragraph paragraph) => paragraph.height).toList(),
+        <double>[10.0, 20.0, 30.0, 40.0]);
+    for (final Paragraph paragraph in paragraphs) {
+      expect(paragraph.width, 400.0);
+      expect(paragraph.maxIntrinsicWidth, paragraph.height * 4.0);
+      paragraph.dispose();
+    }
+  });
+
+  test('throws when a paragraph is used while it is laid out asynchronously', () async {
+    final Paragraph paragraph = (ParagraphBuilder(ParagraphStyle(
+      fontFamily: 'FlutterTest',
+      fontSize: 10.0,
+    ))..addText('Test')).build();
+    final Future<void> layout =
+        paragraph.layoutAsync(const ParagraphConstraints(width: 400.0));
+
+    expect(() => paragraph.height, throwsA(isInstanceOf<StateError>()));
+    expect(() => paragraph.layout(const ParagraphConstraints(width: 400.0)),
+        throwsA(isInstanceOf<StateError>()));
+    expect(paragraph.computeLineMetrics, throwsA(isInstanceOf<StateError>()));
+
+    await layout;
+    expect(paragraph.height, 10.0);
+    paragraph.dispose();
+  });
+
   test('predictably lays out a multi-line paragraph', () {
     for (final double fontSize in <double>[10.0, 20.0, 30.0, 40.0]) {
       final ParagraphBuilder builder = ParagraphBuilder(ParagraphStyle(
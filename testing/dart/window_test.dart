@@ -68,6 +68,21 @@ void main() {
             'frameNumber: 29)');
   });
 
+  test('FrameTiming reports discarded frames', () {
+    final FrameTiming timing = FrameTiming(
+      vsyncStart: 500,
+      buildStart: 1000,
+      buildFinish: 8000,
+      rasterStart: 9000,
+      rasterFinish: 19500,
+      rasterFinishWallTime: 19501,
+      discardedFrameCount: 2,
+      frameNumber: 31,
+    );
+    expect(timing.discardedFrameCount, 2);
+    expect(timing.frameNumber, 31);
+  });
+
   test('computePlatformResolvedLocale basic', () {
     final List<Locale> supportedLocales = <Locale>[
       const Locale.fromSubtags(languageCode: 'zh', scriptCode: 'Hans', countryCode: 'CN'),
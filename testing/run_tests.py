@@ -351,6 +351,7 @@ def run_cc_tests(build_dir, executable_filter, coverage, capture_core_dump):
     return (name, flags, extra_env)
 
   unittests = [
+      make_test('assets_unittests'),
       make_test('client_wrapper_glfw_unittests'),
       make_test('client_wrapper_unittests'),
       make_test('common_cpp_core_unittests'),
@@ -490,6 +491,10 @@ def run_engine_benchmarks(build_dir, executable_filter):
       build_dir, 'shell_benchmarks', executable_filter, icu_flags
   )
 
+  run_engine_executable(
+      build_dir, 'frame_allocation_benchmarks', executable_filter, icu_flags
+  )
+
   run_engine_executable(
       build_dir, 'fml_benchmarks', executable_filter, icu_flags
   )
@@ -47,7 +47,8 @@ SkFontStyle MakeSkFontStyle(txt::FontWeight font_weight,
 ParagraphBuilderSkia::ParagraphBuilderSkia(
     const ParagraphStyle& style,
     std::shared_ptr<FontCollection> font_collection)
-    : base_style_(style.GetTextStyle()) {
+    : layout_mutex_(font_collection->GetLayoutMutex()),
+      base_style_(style.GetTextStyle()) {
   builder_ = skt::ParagraphBuilder::make(
       TxtToSkia(style), font_collection->CreateSktFontCollection());
 }
@@ -85,8 +86,8 @@ void ParagraphBuilderSkia::AddPlaceholder(PlaceholderRun& span) {
 }
 
 std::unique_ptr<Paragraph> ParagraphBuilderSkia::Build() {
-  return std::make_unique<ParagraphSkia>(builder_->Build(),
-                                         std::move(dl_paints_));
+  return std::make_unique<ParagraphSkia>(
+      builder_->Build(), std::move(dl_paints_), layout_mutex_);
 }
 
 skt::ParagraphPainter::PaintID ParagraphBuilderSkia::CreatePaintID(
@@ -46,6 +46,7 @@ class ParagraphBuilderSkia : public ParagraphBuilder {
   skia::textlayout::TextStyle TxtToSkia(const TextStyle& txt);
 
   std::shared_ptr<skia::textlayout::ParagraphBuilder> builder_;
+  std::shared_ptr<std::mutex> layout_mutex_;
   TextStyle base_style_;
   std::stack<TextStyle> txt_style_stack_;
   std::vector<flutter::DlPaint> dl_paints_;
@@ -143,8 +143,11 @@ class DisplayListParagraphPainter : public skt::ParagraphPainter {
 }  // anonymous namespace
 
 ParagraphSkia::ParagraphSkia(std::unique_ptr<skt::Paragraph> paragraph,
-                             std::vector<flutter::DlPaint>&& dl_paints)
-    : paragraph_(std::move(paragraph)), dl_paints_(dl_paints) {}
+                             std::vector<flutter::DlPaint>&& dl_paints,
+                             std::shared_ptr<std::mutex> layout_mutex)
+    : paragraph_(std::move(paragraph)),
+      dl_paints_(dl_paints),
+      layout_mutex_(std::move(layout_mutex)) {}
 
 double ParagraphSkia::GetMaxWidth() {
   return SkScalarToDouble(paragraph_->getMaxWidth());
@@ -218,8 +221,17 @@ bool ParagraphSkia::DidExceedMaxLines() {
 }
 
 void ParagraphSkia::Layout(double width) {
+  // The shaped runs of the paragraph are reused when it is laid out at a new
+  // width, so only line breaking depends on the width. The text and styles
+  // of a built paragraph never change, so laying it out at the same width
+  // again keeps the lines and their cached metrics.
+  if (layout_width_ == width) {
+    return;
+  }
+  layout_width_ = width;
   line_metrics_.reset();
   line_metrics_styles_.clear();
+  std::scoped_lock lock(*layout_mutex_);
   paragraph_->layout(width);
 }
 
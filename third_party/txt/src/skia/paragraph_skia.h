@@ -17,6 +17,8 @@
 #ifndef LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 #define LIB_TXT_SRC_PARAGRAPH_SKIA_H_
 
+#include <memory>
+#include <mutex>
 #include <optional>
 
 #include "txt/paragraph.h"
@@ -28,8 +30,11 @@ namespace txt {
 // Implementation of Paragraph based on Skia's text layout module.
 class ParagraphSkia : public Paragraph {
  public:
+  // The layout mutex is shared by the paragraphs of a font collection, see
+  // |FontCollection::GetLayoutMutex|.
   ParagraphSkia(std::unique_ptr<skia::textlayout::Paragraph> paragraph,
-                std::vector<flutter::DlPaint>&& dl_paints);
+                std::vector<flutter::DlPaint>&& dl_paints,
+                std::shared_ptr<std::mutex> layout_mutex);
 
   virtual ~ParagraphSkia() = default;
 
@@ -73,6 +78,9 @@ class ParagraphSkia : public Paragraph {
 
   std::unique_ptr<skia::textlayout::Paragraph> paragraph_;
   std::vector<flutter::DlPaint> dl_paints_;
+  std::shared_ptr<std::mutex> layout_mutex_;
+  // The width of the last layout, if any.
+  std::optional<double> layout_width_;
   std::optional<std::vector<LineMetrics>> line_metrics_;
   std::vector<TextStyle> line_metrics_styles_;
 };
@@ -32,6 +32,10 @@ AssetFontManager::AssetFontManager(
 
 AssetFontManager::~AssetFontManager() = default;
 
+void AssetFontManager::ReleaseUnusedTypefaces() {
+  font_provider_->ReleaseUnusedTypefaces();
+}
+
 int AssetFontManager::onCountFamilies() const {
   return font_provider_->GetFamilyCount();
 }
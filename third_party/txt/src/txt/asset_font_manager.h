@@ -33,6 +33,9 @@ class AssetFontManager : public SkFontMgr {
 
   ~AssetFontManager() override;
 
+  // See |FontAssetProvider::ReleaseUnusedTypefaces|.
+  void ReleaseUnusedTypefaces();
+
  protected:
   // |SkFontMgr|
   SkFontStyleSet* onMatchFamily(const char familyName[]) const override;
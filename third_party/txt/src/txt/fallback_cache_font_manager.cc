@@ -0,0 +1,146 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "txt/fallback_cache_font_manager.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/core/SkString.h"
+
+namespace txt {
+
+FallbackCacheFontManager::FallbackCacheFontManager(
+    sk_sp<SkFontMgr> font_manager,
+    size_t max_fallbacks)
+    : font_manager_(std::move(font_manager)),
+      max_fallbacks_(std::max<size_t>(max_fallbacks, 1u)) {
+  FML_DCHECK(font_manager_ != nullptr);
+}
+
+FallbackCacheFontManager::~FallbackCacheFontManager() = default;
+
+const sk_sp<SkFontMgr>& FallbackCacheFontManager::GetFontManager() const {
+  return font_manager_;
+}
+
+bool FallbackCacheFontManager::FallbackKey::operator==(
+    const FallbackKey& other) const {
+  return character == other.character && weight == other.weight &&
+         width == other.width && slant == other.slant &&
+         family_name == other.family_name && locales == other.locales;
+}
+
+size_t FallbackCacheFontManager::FallbackKeyHash::operator()(
+    const FallbackKey& key) const {
+  return fml::HashCombine(key.family_name, key.weight, key.width,
+                          static_cast<int>(key.slant), key.locales,
+                          key.character);
+}
+
+int FallbackCacheFontManager::onCountFamilies() const {
+  return font_manager_->countFamilies();
+}
+
+void FallbackCacheFontManager::onGetFamilyName(int index,
+                                               SkString* familyName) const {
+  font_manager_->getFamilyName(index, familyName);
+}
+
+SkFontStyleSet* FallbackCacheFontManager::onCreateStyleSet(int index) const {
+  return font_manager_->createStyleSet(index);
+}
+
+SkFontStyleSet* FallbackCacheFontManager::onMatchFamily(
+    const char familyName[]) const {
+  return font_manager_->matchFamily(familyName);
+}
+
+SkTypeface* FallbackCacheFontManager::onMatchFamilyStyle(
+    const char familyName[],
+    const SkFontStyle& style) const {
+  return font_manager_->matchFamilyStyle(familyName, style);
+}
+
+SkTypeface* FallbackCacheFontManager::onMatchFamilyStyleCharacter(
+    const char familyName[],
+    const SkFontStyle& style,
+    const char* bcp47[],
+    int bcp47Count,
+    SkUnichar character) const {
+  FallbackKey key{
+      .family_name = familyName ? familyName : "",
+      .weight = style.weight(),
+      .width = style.width(),
+      .slant = style.slant(),
+      .character = character,
+  };
+  // The locales are ordered by preference, so their order is part of the key.
+  for (int i = 0; i < bcp47Count; i++) {
+    key.locales.append(bcp47[i]);
+    key.locales.push_back(',');
+  }
+
+  {
+    std::scoped_lock lock(fallback_mutex_);
+    auto found = fallback_index_.find(key);
+    if (found != fallback_index_.end()) {
+      fallbacks_.splice(fallbacks_.begin(), fallbacks_, found->second);
+      return SkSafeRef(found->second->second.get());
+    }
+  }
+
+  // Other threads may look up the same character in the meantime, but the
+  // lookup is not done while holding the lock so that lookups of different
+  // characters aren't serialized.
+  sk_sp<SkTypeface> typeface(font_manager_->matchFamilyStyleCharacter(
+      familyName, style, bcp47, bcp47Count, character));
+
+  std::scoped_lock lock(fallback_mutex_);
+  if (fallback_index_.find(key) == fallback_index_.end()) {
+    fallbacks_.emplace_front(key, typeface);
+    fallback_index_.emplace(std::move(key), fallbacks_.begin());
+    if (fallbacks_.size() > max_fallbacks_) {
+      fallback_index_.erase(fallbacks_.back().first);
+      fallbacks_.pop_back();
+    }
+  }
+  return typeface.release();
+}
+
+sk_sp<SkTypeface> FallbackCacheFontManager::onMakeFromData(
+    sk_sp<SkData> data,
+    int ttcIndex) const {
+  return font_manager_->makeFromData(std::move(data), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCacheFontManager::onMakeFromStreamIndex(
+    std::unique_ptr<SkStreamAsset> stream,
+    int ttcIndex) const {
+  return font_manager_->makeFromStream(std::move(stream), ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCacheFontManager::onMakeFromStreamArgs(
+    std::unique_ptr<SkStreamAsset> stream,
+    const SkFontArguments& args) const {
+  return font_manager_->makeFromStream(std::move(stream), args);
+}
+
+sk_sp<SkTypeface> FallbackCacheFontManager::onMakeFromFile(
+    const char path[],
+    int ttcIndex) const {
+  return font_manager_->makeFromFile(path, ttcIndex);
+}
+
+sk_sp<SkTypeface> FallbackCacheFontManager::onLegacyMakeTypeface(
+    const char familyName[],
+    SkFontStyle style) const {
+  return font_manager_->legacyMakeTypeface(familyName, style);
+}
+
+}  // namespace txt
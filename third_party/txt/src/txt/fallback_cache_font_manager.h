@@ -0,0 +1,120 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TXT_FALLBACK_CACHE_FONT_MANAGER_H_
+#define TXT_FALLBACK_CACHE_FONT_MANAGER_H_
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+
+namespace txt {
+
+// A font manager that forwards to another font manager, but remembers the
+// fallback typeface it found for each character, so that the wrapped manager
+// is only asked once per character, family, style and list of locales.
+//
+// Looking up fallback fonts is expensive for system font managers, and text
+// with emoji or CJK characters needs a fallback for many of its characters.
+// The results are kept for as long as the wrapped font manager, which is
+// replaced whenever the fonts it provides change. Only the most recently used
+// results are kept, so that text with many different characters doesn't grow
+// the cache without bound.
+class FallbackCacheFontManager : public SkFontMgr {
+ public:
+  // Enough for the characters of a few screens of CJK text.
+  static constexpr size_t kDefaultMaxFallbacks = 4096;
+
+  explicit FallbackCacheFontManager(
+      sk_sp<SkFontMgr> font_manager,
+      size_t max_fallbacks = kDefaultMaxFallbacks);
+
+  ~FallbackCacheFontManager() override;
+
+  const sk_sp<SkFontMgr>& GetFontManager() const;
+
+ private:
+  struct FallbackKey {
+    std::string family_name;
+    int weight;
+    int width;
+    SkFontStyle::Slant slant;
+    std::string locales;
+    SkUnichar character;
+
+    bool operator==(const FallbackKey& other) const;
+  };
+
+  struct FallbackKeyHash {
+    size_t operator()(const FallbackKey& key) const;
+  };
+
+  using Fallback = std::pair<FallbackKey, sk_sp<SkTypeface>>;
+
+  const sk_sp<SkFontMgr> font_manager_;
+  const size_t max_fallbacks_;
+  mutable std::mutex fallback_mutex_;
+  // The fallbacks from the most to the least recently used. Characters that
+  // the wrapped font manager has no fallback for are kept with a null
+  // typeface.
+  mutable std::list<Fallback> fallbacks_;
+  mutable std::unordered_map<FallbackKey,
+                             std::list<Fallback>::iterator,
+                             FallbackKeyHash>
+      fallback_index_;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override;
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override;
+
+  // |SkFontMgr|
+  SkFontStyleSet* onCreateStyleSet(int index) const override;
+
+  // |SkFontMgr|
+  SkFontStyleSet* onMatchFamily(const char familyName[]) const override;
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyle(const char familyName[],
+                                 const SkFontStyle&) const override;
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                          const SkFontStyle&,
+                                          const char* bcp47[],
+                                          int bcp47Count,
+                                          SkUnichar character) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset>,
+                                         const SkFontArguments&) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override;
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FallbackCacheFontManager);
+};
+
+}  // namespace txt
+
+#endif  // TXT_FALLBACK_CACHE_FONT_MANAGER_H_
@@ -31,6 +31,10 @@ class FontAssetProvider {
   virtual std::string GetFamilyName(int index) const = 0;
   virtual SkFontStyleSet* MatchFamily(const std::string& family_name) = 0;
 
+  // Drops the typefaces that are loaded from assets and not in use, so that
+  // they don't stay resident. They are loaded again when they are next used.
+  virtual void ReleaseUnusedTypefaces() {}
+
  protected:
   static std::string CanonicalFamilyName(std::string family_name);
 };
@@ -26,12 +26,15 @@
 #include <vector>
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
+#include "txt/fallback_cache_font_manager.h"
 #include "txt/platform.h"
 #include "txt/text_style.h"
 
 namespace txt {
 
-FontCollection::FontCollection() : enable_font_fallback_(true) {}
+FontCollection::FontCollection()
+    : enable_font_fallback_(true),
+      layout_mutex_(std::make_shared<std::mutex>()) {}
 
 FontCollection::~FontCollection() {
   if (skt_collection_) {
@@ -43,13 +46,25 @@ size_t FontCollection::GetFontManagersCount() const {
   return GetFontManagerOrder().size();
 }
 
+// Fallback fonts for missing characters are found by the default font
+// manager, so the fallbacks it finds are cached for as long as it is in use.
+static sk_sp<SkFontMgr> MakeFallbackCacheFontManager(
+    sk_sp<SkFontMgr> font_manager) {
+  if (!font_manager) {
+    return nullptr;
+  }
+  return sk_make_sp<FallbackCacheFontManager>(std::move(font_manager));
+}
+
 void FontCollection::SetupDefaultFontManager(
     uint32_t font_initialization_data) {
-  default_font_manager_ = GetDefaultFontManager(font_initialization_data);
+  default_font_manager_ = MakeFallbackCacheFontManager(
+      GetDefaultFontManager(font_initialization_data));
+  skt_collection_.reset();
 }
 
 void FontCollection::SetDefaultFontManager(sk_sp<SkFontMgr> font_manager) {
-  default_font_manager_ = font_manager;
+  default_font_manager_ = MakeFallbackCacheFontManager(std::move(font_manager));
   skt_collection_.reset();
 }
 
@@ -82,6 +97,10 @@ std::vector<sk_sp<SkFontMgr>> FontCollection::GetFontManagerOrder() const {
   return order;
 }
 
+std::shared_ptr<std::mutex> FontCollection::GetLayoutMutex() const {
+  return layout_mutex_;
+}
+
 void FontCollection::DisableFontFallback() {
   enable_font_fallback_ = false;
   if (skt_collection_) {
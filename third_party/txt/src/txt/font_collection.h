@@ -18,6 +18,7 @@
 #define LIB_TXT_SRC_FONT_COLLECTION_H_
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -51,17 +52,26 @@ class FontCollection : public std::enable_shared_from_this<FontCollection> {
   void DisableFontFallback();
 
   // Remove all entries in the font family cache.
+  //
+  // The fallback fonts found for missing characters are kept until the default
+  // font manager is replaced.
   void ClearFontFamilyCache();
 
   // Construct a Skia text layout FontCollection based on this collection.
   sk_sp<skia::textlayout::FontCollection> CreateSktFontCollection();
 
+  // A mutex that serializes the layouts of paragraphs built from this
+  // collection, which may happen on different threads. The font caches of the
+  // Skia text layout FontCollection are not thread safe.
+  std::shared_ptr<std::mutex> GetLayoutMutex() const;
+
  private:
   sk_sp<SkFontMgr> default_font_manager_;
   sk_sp<SkFontMgr> asset_font_manager_;
   sk_sp<SkFontMgr> dynamic_font_manager_;
   sk_sp<SkFontMgr> test_font_manager_;
   bool enable_font_fallback_;
+  std::shared_ptr<std::mutex> layout_mutex_;
 
   // An equivalent font collection usable by the Skia text shaper library.
   sk_sp<skia::textlayout::FontCollection> skt_collection_;
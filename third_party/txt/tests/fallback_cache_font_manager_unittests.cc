@@ -0,0 +1,170 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "flutter/fml/paths.h"
+#include "flutter/testing/testing.h"
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "third_party/skia/include/core/SkFontMgr.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+#include "third_party/skia/modules/skparagraph/include/FontCollection.h"
+#include "txt/fallback_cache_font_manager.h"
+#include "txt/font_collection.h"
+
+namespace txt {
+namespace testing {
+
+// Only has a fallback for 'a', and counts the fallbacks it is asked for.
+class MockFallbackFontManager : public SkFontMgr {
+ public:
+  MockFallbackFontManager()
+      : typeface_(SkTypeface::MakeFromFile(
+            fml::paths::JoinPaths({GetFontDir(), "Roboto-Regular.ttf"})
+                .c_str())) {}
+
+  const sk_sp<SkTypeface>& GetTypeface() const { return typeface_; }
+
+  int GetFallbackLookupCount() const { return fallback_lookup_count_; }
+
+ private:
+  sk_sp<SkTypeface> typeface_;
+  mutable int fallback_lookup_count_ = 0;
+
+  // |SkFontMgr|
+  int onCountFamilies() const override { return 0; }
+
+  // |SkFontMgr|
+  void onGetFamilyName(int index, SkString* familyName) const override {}
+
+  // |SkFontMgr|
+  SkFontStyleSet* onCreateStyleSet(int index) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  SkFontStyleSet* onMatchFamily(const char familyName[]) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyle(const char familyName[],
+                                 const SkFontStyle&) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  SkTypeface* onMatchFamilyStyleCharacter(const char familyName[],
+                                          const SkFontStyle&,
+                                          const char* bcp47[],
+                                          int bcp47Count,
+                                          SkUnichar character) const override {
+    fallback_lookup_count_++;
+    return character == 'a' ? SkSafeRef(typeface_.get()) : nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int ttcIndex) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>,
+                                          int ttcIndex) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromStreamArgs(
+      std::unique_ptr<SkStreamAsset>,
+      const SkFontArguments&) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onMakeFromFile(const char path[],
+                                   int ttcIndex) const override {
+    return nullptr;
+  }
+
+  // |SkFontMgr|
+  sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[],
+                                         SkFontStyle) const override {
+    return nullptr;
+  }
+};
+
+static sk_sp<SkTypeface> MatchFallback(const sk_sp<SkFontMgr>& font_manager,
+                                       SkUnichar character) {
+  const char* locales[] = {"en-US"};
+  return sk_sp<SkTypeface>(font_manager->matchFamilyStyleCharacter(
+      "Roboto", SkFontStyle(), locales, 1, character));
+}
+
+TEST(FallbackCacheFontManagerTest, LooksUpEachFallbackOnce) {
+  auto mock = sk_make_sp<MockFallbackFontManager>();
+  ASSERT_NE(mock->GetTypeface(), nullptr);
+  sk_sp<SkFontMgr> font_manager = sk_make_sp<FallbackCacheFontManager>(mock);
+
+  EXPECT_EQ(MatchFallback(font_manager, 'a'), mock->GetTypeface());
+  EXPECT_EQ(MatchFallback(font_manager, 'a'), mock->GetTypeface());
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 1);
+
+  // Other styles have fallbacks of their own.
+  const char* locales[] = {"en-US"};
+  sk_sp<SkTypeface> bold(font_manager->matchFamilyStyleCharacter(
+      "Roboto", SkFontStyle::Bold(), locales, 1, 'a'));
+  EXPECT_EQ(bold, mock->GetTypeface());
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 2);
+}
+
+TEST(FallbackCacheFontManagerTest, RemembersCharactersWithoutFallbacks) {
+  auto mock = sk_make_sp<MockFallbackFontManager>();
+  sk_sp<SkFontMgr> font_manager = sk_make_sp<FallbackCacheFontManager>(mock);
+
+  EXPECT_EQ(MatchFallback(font_manager, 'b'), nullptr);
+  EXPECT_EQ(MatchFallback(font_manager, 'b'), nullptr);
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 1);
+}
+
+TEST(FallbackCacheFontManagerTest, ForgetsTheLeastRecentlyUsedFallbacks) {
+  auto mock = sk_make_sp<MockFallbackFontManager>();
+  sk_sp<SkFontMgr> font_manager =
+      sk_make_sp<FallbackCacheFontManager>(mock, 2u);
+
+  MatchFallback(font_manager, 'a');
+  MatchFallback(font_manager, 'b');
+  MatchFallback(font_manager, 'a');
+  // Replaces the fallback of 'b', which was used less recently than 'a'.
+  MatchFallback(font_manager, 'c');
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 3);
+
+  EXPECT_EQ(MatchFallback(font_manager, 'a'), mock->GetTypeface());
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 3);
+  EXPECT_EQ(MatchFallback(font_manager, 'b'), nullptr);
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 4);
+}
+
+TEST(FallbackCacheFontManagerTest, FallbacksAreForgottenWhenTheFontsChange) {
+  auto mock = sk_make_sp<MockFallbackFontManager>();
+  FontCollection font_collection;
+  font_collection.SetDefaultFontManager(mock);
+
+  sk_sp<SkFontMgr> font_manager =
+      font_collection.CreateSktFontCollection()->getFallbackManager();
+  MatchFallback(font_manager, 'a');
+  MatchFallback(font_manager, 'a');
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 1);
+
+  // The default font manager is set again whenever the system fonts change.
+  font_collection.SetDefaultFontManager(mock);
+  font_manager =
+      font_collection.CreateSktFontCollection()->getFallbackManager();
+  EXPECT_EQ(MatchFallback(font_manager, 'a'), mock->GetTypeface());
+  EXPECT_EQ(mock->GetFallbackLookupCount(), 2);
+}
+
+}  // namespace testing
+}  // namespace txt
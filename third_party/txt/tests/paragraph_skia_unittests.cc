@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/paths.h"
+#include "flutter/testing/testing.h"
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
+#include "third_party/skia/include/core/SkTypeface.h"
+#include "txt/font_collection.h"
+#include "txt/paragraph.h"
+#include "txt/paragraph_builder.h"
+#include "txt/test_font_manager.h"
+#include "txt/typeface_font_asset_provider.h"
+
+namespace txt {
+namespace testing {
+
+class ParagraphSkiaTest : public ::testing::Test {
+ public:
+  ParagraphSkiaTest() : font_collection_(std::make_shared<FontCollection>()) {
+    auto font_provider = std::make_unique<TypefaceFontAssetProvider>();
+    font_provider->RegisterTypeface(
+        SkTypeface::MakeFromFile(
+            fml::paths::JoinPaths({GetFontDir(), "Roboto-Regular.ttf"})
+                .c_str()),
+        "Roboto");
+    font_collection_->SetTestFontManager(sk_make_sp<TestFontManager>(
+        std::move(font_provider), std::vector<std::string>{"Roboto"}));
+    font_collection_->DisableFontFallback();
+  }
+
+  std::unique_ptr<Paragraph> BuildParagraph(const std::u16string& text) {
+    auto builder =
+        ParagraphBuilder::CreateSkiaBuilder(ParagraphStyle(), font_collection_);
+    TextStyle text_style;
+    text_style.font_families = {"Roboto"};
+    builder->PushStyle(text_style);
+    builder->AddText(text);
+    builder->Pop();
+    return builder->Build();
+  }
+
+ private:
+  std::shared_ptr<FontCollection> font_collection_;
+};
+
+TEST_F(ParagraphSkiaTest, LayoutAtTheSameWidthKeepsTheLines) {
+  auto paragraph = BuildParagraph(u"Hello World");
+  paragraph->Layout(300);
+  std::vector<LineMetrics>& line_metrics = paragraph->GetLineMetrics();
+  ASSERT_EQ(line_metrics.size(), 1u);
+
+  // Only survives if the paragraph is not laid out again.
+  line_metrics[0].line_number = 42;
+  paragraph->Layout(300);
+  ASSERT_EQ(paragraph->GetLineMetrics().size(), 1u);
+  EXPECT_EQ(paragraph->GetLineMetrics()[0].line_number, 42u);
+}
+
+TEST_F(ParagraphSkiaTest, LayoutAtANewWidthBreaksTheLinesAgain) {
+  auto paragraph = BuildParagraph(u"Hello World");
+  paragraph->Layout(300);
+  std::vector<LineMetrics>& line_metrics = paragraph->GetLineMetrics();
+  ASSERT_EQ(line_metrics.size(), 1u);
+  line_metrics[0].line_number = 42;
+  double max_intrinsic_width = paragraph->GetMaxIntrinsicWidth();
+
+  paragraph->Layout(max_intrinsic_width / 2);
+  EXPECT_EQ(paragraph->GetMaxWidth(), max_intrinsic_width / 2);
+  ASSERT_EQ(paragraph->GetLineMetrics().size(), 2u);
+  EXPECT_EQ(paragraph->GetLineMetrics()[0].line_number, 0u);
+  EXPECT_EQ(paragraph->GetLineMetrics()[1].line_number, 1u);
+
+  paragraph->Layout(300);
+  ASSERT_EQ(paragraph->GetLineMetrics().size(), 1u);
+  EXPECT_EQ(paragraph->GetLineMetrics()[0].line_number, 0u);
+}
+
+}  // namespace testing
+}  // namespace txt
@@ -16,12 +16,24 @@
 
 #include "flutter/fml/backtrace.h"
 #include "flutter/fml/command_line.h"
+#include "flutter/fml/icu_util.h"
 #include "flutter/fml/logging.h"
 #include "flutter/testing/testing.h"
+#include "flutter/third_party/txt/tests/txt_test_utils.h"
 
 int main(int argc, char** argv) {
   fml::InstallCrashHandler();
   fml::CommandLine cmd = fml::CommandLineFromPlatformOrArgcArgv(argc, argv);
+  txt::SetFontDir(flutter::testing::GetFixturesPath());
+  if (txt::GetFontDir().length() <= 0) {
+    FML_LOG(ERROR) << "Font directory not set via txt::SetFontDir.";
+    return EXIT_FAILURE;
+  }
+
+  std::string icudtl_path =
+      cmd.GetOptionValueWithDefault("icu-data-file-path", "icudtl.dat");
+  fml::icu::InitializeICU(icudtl_path);
+
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }